@@ -0,0 +1,666 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_benchmarks_benchmark_driver_h
+#define dealii_benchmarks_benchmark_driver_h
+
+// Common infrastructure of the benchmarks: command line handling, the setup
+// of a Cartesian mesh of a prescribed size, the timing of an operator
+// evaluation over a range of thread counts, a STREAM triad measurement
+// serving as the roofline reference, and the output of machine-readable
+// results together with the comparison against a baseline from a previous
+// run.
+//
+// All results are written as JSON lines, i.e., one self-contained JSON
+// object per line. The first record of type "system" describes the
+// configuration, followed by one record of type "measurement" per operator,
+// polynomial degree, vectorization width, and thread count, or one record of
+// type "timing" per section of a TimerOutput object for benchmarks of whole
+// program phases. When a baseline file is given, a record of type
+// "regression" is added for every measurement whose throughput dropped, or
+// every timing that increased, by more than the given tolerance and the
+// program returns with a non-zero exit code.
+
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Benchmarks
+{
+  using namespace dealii;
+
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+  /**
+   * Settings of a benchmark run, filled from the command line.
+   */
+  struct Parameters
+  {
+    Parameters()
+      : min_dofs(8000000)
+      , repetitions(20)
+      , weak_scaling(false)
+      , tolerance(0.05)
+    {}
+
+    void
+    parse(const int argc, char **argv)
+    {
+      for (int i = 1; i < argc; ++i)
+        {
+          const std::string arg = argv[i];
+          AssertThrow(i + 1 < argc || arg == "--help",
+                      ExcMessage("Missing value for argument " + arg));
+          if (arg == "--help")
+            {
+              std::cout
+                << "Usage: " << argv[0] << " [options]\n"
+                << "  --threads <n1,n2,...>  thread counts per process\n"
+                << "  --degrees <k1,k2,...>  polynomial degrees to run\n"
+                << "  --min-dofs <n>         minimal global problem size\n"
+                << "  --scaling <weak|strong> with weak scaling, the\n"
+                << "                         problem size is per process\n"
+                << "  --repetitions <n>      timed repetitions\n"
+                << "  --output <file>        write JSON lines to file\n"
+                << "  --baseline <file>      compare against previous run\n"
+                << "  --tolerance <t>        allowed relative slowdown\n";
+              std::exit(0);
+            }
+          else if (arg == "--threads")
+            for (const int t : Utilities::string_to_int(
+                   Utilities::split_string_list(argv[++i])))
+              threads.push_back(t);
+          else if (arg == "--degrees")
+            for (const int k : Utilities::string_to_int(
+                   Utilities::split_string_list(argv[++i])))
+              degrees.push_back(k);
+          else if (arg == "--min-dofs")
+            min_dofs = static_cast<types::global_dof_index>(
+              Utilities::string_to_double(argv[++i]));
+          else if (arg == "--scaling")
+            {
+              const std::string scaling = argv[++i];
+              AssertThrow(scaling == "weak" || scaling == "strong",
+                          ExcMessage("Unknown scaling " + scaling));
+              weak_scaling = (scaling == "weak");
+            }
+          else if (arg == "--repetitions")
+            repetitions = Utilities::string_to_int(argv[++i]);
+          else if (arg == "--output")
+            output_file = argv[++i];
+          else if (arg == "--baseline")
+            baseline_file = argv[++i];
+          else if (arg == "--tolerance")
+            tolerance = Utilities::string_to_double(argv[++i]);
+          else
+            AssertThrow(false, ExcMessage("Unknown argument " + arg));
+        }
+
+      AssertThrow(repetitions > 0,
+                  ExcMessage("At least one repetition is needed"));
+
+      if (weak_scaling)
+        min_dofs *= Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+      // default: a single thread and all cores available to this process
+      if (threads.empty())
+        {
+          threads.push_back(1);
+          const unsigned int n_cores = MultithreadInfo::n_cores();
+          if (n_cores > 1)
+            threads.push_back(n_cores);
+        }
+    }
+
+    std::vector<unsigned int> threads;
+    std::vector<unsigned int> degrees;
+    types::global_dof_index   min_dofs;
+    unsigned int              repetitions;
+    bool                      weak_scaling;
+    std::string               output_file;
+    std::string               baseline_file;
+    double                    tolerance;
+  };
+
+
+
+  /**
+   * Result of the timing of one operator configuration.
+   */
+  struct Measurement
+  {
+    std::string             operator_name;
+    unsigned int            degree;
+    unsigned int            n_lanes;
+    unsigned int            n_threads;
+    types::global_dof_index n_dofs;
+    double                  bytes_per_dof;
+    double                  time_min;
+    double                  time_avg;
+    double                  dofs_per_second;
+    double                  gbytes_per_second;
+    double                  roofline_ratio;
+  };
+
+
+
+  /**
+   * Extract the value of the field @p key from a JSON line as written by
+   * Driver, returning an empty string if the key is not present. This is
+   * not a general JSON parser but only reads back the flat records of this
+   * file.
+   */
+  inline std::string
+  extract_json_field(const std::string &line, const std::string &key)
+  {
+    const std::string pattern = "\"" + key + "\": ";
+    const std::size_t start   = line.find(pattern);
+    if (start == std::string::npos)
+      return "";
+    std::size_t begin = start + pattern.size();
+    std::size_t end   = 0;
+    if (line[begin] == '"')
+      end = line.find('"', ++begin);
+    else
+      end = line.find_first_of(",}", begin);
+    return line.substr(begin, end - begin);
+  }
+
+
+
+  /**
+   * Set up a Cartesian mesh of the unit cube with at least @p min_dofs
+   * degrees of freedom for an element with @p dofs_per_cell_1d unknowns per
+   * direction (shared vertices are ignored in this estimate). The mesh is
+   * built by a coarse mesh of 2 to 4 cells per direction that is refined
+   * globally, which keeps the coarse mesh small also for distributed
+   * triangulations.
+   */
+  template <int dim>
+  void
+  create_mesh(Triangulation<dim> &          tria,
+              const unsigned int            dofs_per_cell_1d,
+              const types::global_dof_index min_dofs)
+  {
+    const unsigned int n_cells_1d = std::max<unsigned int>(
+      2,
+      static_cast<unsigned int>(std::ceil(
+        std::pow(static_cast<double>(min_dofs), 1. / dim) / dofs_per_cell_1d)));
+    unsigned int n_refinements = 0;
+    while ((4U << n_refinements) < n_cells_1d)
+      ++n_refinements;
+    const unsigned int n_subdivisions =
+      (n_cells_1d + (1U << n_refinements) - 1) >> n_refinements;
+
+    GridGenerator::subdivided_hyper_cube(tria, n_subdivisions);
+    tria.refine_global(n_refinements);
+  }
+
+
+
+  /**
+   * Driver class running the given operator for all thread counts and
+   * recording the results.
+   */
+  class Driver
+  {
+  public:
+    Driver(const std::string &benchmark_name,
+           const int          argc,
+           char **            argv,
+           const unsigned int default_repetitions = 20)
+      : benchmark_name(benchmark_name)
+      , pcout(std::cout,
+              Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+      , n_regressions(0)
+    {
+      parameters.repetitions = default_repetitions;
+      parameters.parse(argc, argv);
+      if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0 &&
+          !parameters.output_file.empty())
+        {
+          output.reset(new std::ofstream(parameters.output_file));
+          AssertThrow(*output,
+                      ExcMessage("Could not open output file " +
+                                 parameters.output_file));
+        }
+      if (!parameters.baseline_file.empty())
+        read_baseline();
+
+      // the roofline reference is the STREAM triad with all threads that
+      // will be used in the benchmark, on a vector eight times larger than
+      // the default problem size to measure the bandwidth from main memory
+      MultithreadInfo::set_thread_limit(
+        *std::max_element(parameters.threads.begin(),
+                          parameters.threads.end()));
+      stream_bandwidth = measure_stream_triad();
+
+      std::ostringstream record;
+      record << "{\"record\": \"system\", \"benchmark\": \"" << benchmark_name
+             << "\", \"n_mpi_processes\": "
+             << Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD)
+             << ", \"scaling\": \""
+             << (parameters.weak_scaling ? "weak" : "strong")
+             << "\", \"n_cores\": " << MultithreadInfo::n_cores()
+             << ", \"vectorization_level\": "
+             << DEAL_II_COMPILER_VECTORIZATION_LEVEL
+             << ", \"stream_triad_gbytes_per_second\": " << stream_bandwidth
+             << "}";
+      write_record(record.str());
+    }
+
+    /**
+     * Return whether the given degree was selected on the command line.
+     */
+    bool
+    run_degree(const unsigned int degree) const
+    {
+      return parameters.degrees.empty() ||
+             std::find(parameters.degrees.begin(),
+                       parameters.degrees.end(),
+                       degree) != parameters.degrees.end();
+    }
+
+    const Parameters &
+    get_parameters() const
+    {
+      return parameters;
+    }
+
+    /**
+     * Run the operator set up by @p create_operator for every thread count.
+     * As the partitioning of MatrixFree depends on the number of threads,
+     * the operator is re-created after changing the thread limit. The
+     * operator type must provide the functions initialize_dof_vector(),
+     * vmult(), and bytes_per_dof().
+     */
+    template <typename Operator, typename CreateOperator>
+    void
+    run(const std::string &   operator_name,
+        const unsigned int    degree,
+        const unsigned int    n_lanes,
+        const CreateOperator &create_operator)
+    {
+      for (const unsigned int n_threads : parameters.threads)
+        {
+          MultithreadInfo::set_thread_limit(n_threads);
+
+          std::unique_ptr<Operator> op = create_operator();
+          VectorType                src, dst;
+          op->initialize_dof_vector(src);
+          op->initialize_dof_vector(dst);
+          for (unsigned int i = 0; i < src.local_size(); ++i)
+            src.local_element(i) = static_cast<double>(i % 7) / 7.;
+
+          // warm-up runs also touch all memory
+          for (unsigned int i = 0; i < 2; ++i)
+            op->vmult(dst, src);
+
+          Measurement result;
+          result.operator_name = operator_name;
+          result.degree        = degree;
+          result.n_lanes       = n_lanes;
+          result.n_threads     = MultithreadInfo::n_threads();
+          result.n_dofs        = src.size();
+          result.bytes_per_dof = op->bytes_per_dof();
+          time(result, [&]() { op->vmult(dst, src); });
+          result.roofline_ratio = result.gbytes_per_second / stream_bandwidth;
+          add_measurement(result);
+        }
+    }
+
+    /**
+     * Record the average wall time of every section of @p timer, which
+     * needs to be set up with the MPI_COMM_WORLD communicator such that the
+     * times are the maxima over all processes. The sections are expected to
+     * be entered once per repetition of the benchmark.
+     */
+    void
+    add_timings(const std::string &           benchmark_case,
+                const unsigned int            degree,
+                const types::global_dof_index n_dofs,
+                const TimerOutput &           timer)
+    {
+      const std::map<std::string, double> wall_times =
+        timer.get_summary_data(TimerOutput::total_wall_time);
+      const std::map<std::string, double> n_calls =
+        timer.get_summary_data(TimerOutput::n_calls);
+      const std::string n_threads =
+        std::to_string(MultithreadInfo::n_threads());
+      for (const auto &section : wall_times)
+        {
+          const double time_avg =
+            section.second / std::max(n_calls.at(section.first), 1.);
+
+          std::ostringstream record;
+          record << "{\"record\": \"timing\", \"benchmark\": \""
+                 << benchmark_name << "\", \"case\": \"" << benchmark_case
+                 << "\", \"phase\": \"" << section.first
+                 << "\", \"degree\": " << degree
+                 << ", \"threads\": " << n_threads
+                 << ", \"n_mpi_processes\": "
+                 << Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD)
+                 << ", \"n_dofs\": " << n_dofs
+                 << ", \"n_calls\": " << n_calls.at(section.first)
+                 << ", \"time_avg\": " << time_avg << "}";
+          write_record(record.str());
+
+          const auto base =
+            baseline_timings.find(key(benchmark_case + ":" + section.first,
+                                      std::to_string(degree),
+                                      "",
+                                      n_threads));
+          if (base != baseline_timings.end() &&
+              time_avg > (1. + parameters.tolerance) * base->second)
+            {
+              ++n_regressions;
+              std::ostringstream regression;
+              regression << "{\"record\": \"regression\", "
+                         << "\"benchmark\": \"" << benchmark_name
+                         << "\", \"case\": \"" << benchmark_case
+                         << "\", \"phase\": \"" << section.first
+                         << "\", \"degree\": " << degree
+                         << ", \"threads\": " << n_threads
+                         << ", \"time_avg\": " << time_avg
+                         << ", \"baseline_time_avg\": " << base->second
+                         << ", \"relative_change\": "
+                         << time_avg / base->second - 1. << "}";
+              write_record(regression.str());
+            }
+        }
+    }
+
+    /**
+     * Print a summary and return the exit code of the program.
+     */
+    int
+    finalize()
+    {
+      pcout << "Benchmark " << benchmark_name << " finished, STREAM triad "
+            << stream_bandwidth << " GB/s";
+      if (!parameters.baseline_file.empty())
+        pcout << ", " << n_regressions << " regression(s) against "
+              << parameters.baseline_file;
+      pcout << std::endl;
+      return n_regressions > 0 ? 1 : 0;
+    }
+
+  private:
+    template <typename Function>
+    void
+    time(Measurement &result, const Function &function) const
+    {
+      double time_min = std::numeric_limits<double>::max();
+      double time_sum = 0.;
+      for (unsigned int r = 0; r < parameters.repetitions; ++r)
+        {
+#ifdef DEAL_II_WITH_MPI
+          MPI_Barrier(MPI_COMM_WORLD);
+#endif
+          const auto start = std::chrono::steady_clock::now();
+          function();
+          const double elapsed =
+            Utilities::MPI::max(std::chrono::duration<double>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count(),
+                                MPI_COMM_WORLD);
+          time_min = std::min(time_min, elapsed);
+          time_sum += elapsed;
+        }
+      result.time_min        = time_min;
+      result.time_avg        = time_sum / parameters.repetitions;
+      result.dofs_per_second = result.n_dofs / time_min;
+      result.gbytes_per_second =
+        1e-9 * result.bytes_per_dof * result.dofs_per_second;
+    }
+
+    double
+    measure_stream_triad() const
+    {
+      const unsigned int n_procs =
+        Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+      const types::global_dof_index local_size =
+        std::max<types::global_dof_index>(8 * parameters.min_dofs / n_procs,
+                                          1);
+      IndexSet locally_owned(local_size * n_procs);
+      const unsigned int my_proc =
+        Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+      locally_owned.add_range(my_proc * local_size,
+                              (my_proc + 1) * local_size);
+      VectorType x(locally_owned, MPI_COMM_WORLD);
+      VectorType y(x);
+      x = 1.;
+      y = 2.;
+
+      // y = y + 0.5 * x reads two and writes one vector
+      Measurement triad;
+      triad.n_dofs        = x.size();
+      triad.bytes_per_dof = 3 * sizeof(double);
+      x.sadd(1., 0.5, y);
+      time(triad, [&]() { y.sadd(1., 0.5, x); });
+      return triad.gbytes_per_second;
+    }
+
+    void
+    add_measurement(const Measurement &result)
+    {
+      std::ostringstream record;
+      record << "{\"record\": \"measurement\", \"benchmark\": \""
+             << benchmark_name << "\", \"operator\": \""
+             << result.operator_name << "\", \"degree\": " << result.degree
+             << ", \"n_lanes\": " << result.n_lanes
+             << ", \"threads\": " << result.n_threads
+             << ", \"n_dofs\": " << result.n_dofs
+             << ", \"bytes_per_dof\": " << result.bytes_per_dof
+             << ", \"time_min\": " << result.time_min
+             << ", \"time_avg\": " << result.time_avg
+             << ", \"dofs_per_second\": " << result.dofs_per_second
+             << ", \"gbytes_per_second\": " << result.gbytes_per_second
+             << ", \"roofline_ratio\": " << result.roofline_ratio << "}";
+      write_record(record.str());
+
+      const auto base = baseline.find(key(result));
+      if (base != baseline.end() &&
+          result.dofs_per_second < (1. - parameters.tolerance) * base->second)
+        {
+          ++n_regressions;
+          std::ostringstream regression;
+          regression << "{\"record\": \"regression\", \"benchmark\": \""
+                     << benchmark_name << "\", \"operator\": \""
+                     << result.operator_name
+                     << "\", \"degree\": " << result.degree
+                     << ", \"n_lanes\": " << result.n_lanes
+                     << ", \"threads\": " << result.n_threads
+                     << ", \"dofs_per_second\": " << result.dofs_per_second
+                     << ", \"baseline_dofs_per_second\": " << base->second
+                     << ", \"relative_change\": "
+                     << result.dofs_per_second / base->second - 1. << "}";
+          write_record(regression.str());
+        }
+    }
+
+    void
+    write_record(const std::string &record)
+    {
+      pcout << record << std::endl;
+      if (output)
+        *output << record << std::endl;
+    }
+
+    static std::string
+    key(const std::string &operator_name,
+        const std::string &degree,
+        const std::string &n_lanes,
+        const std::string &n_threads)
+    {
+      return operator_name + "/" + degree + "/" + n_lanes + "/" + n_threads;
+    }
+
+    static std::string
+    key(const Measurement &result)
+    {
+      return key(result.operator_name,
+                 std::to_string(result.degree),
+                 std::to_string(result.n_lanes),
+                 std::to_string(result.n_threads));
+    }
+
+    void
+    read_baseline()
+    {
+      std::ifstream file(parameters.baseline_file);
+      AssertThrow(file,
+                  ExcMessage("Could not open baseline file " +
+                             parameters.baseline_file));
+      std::string line;
+      while (std::getline(file, line))
+        if (extract_json_field(line, "benchmark") != benchmark_name)
+          continue;
+        else if (extract_json_field(line, "record") == "measurement")
+          baseline[key(extract_json_field(line, "operator"),
+                       extract_json_field(line, "degree"),
+                       extract_json_field(line, "n_lanes"),
+                       extract_json_field(line, "threads"))] =
+            Utilities::string_to_double(
+              extract_json_field(line, "dofs_per_second"));
+        else if (extract_json_field(line, "record") == "timing")
+          baseline_timings[key(extract_json_field(line, "case") + ":" +
+                                 extract_json_field(line, "phase"),
+                               extract_json_field(line, "degree"),
+                               "",
+                               extract_json_field(line, "threads"))] =
+            Utilities::string_to_double(extract_json_field(line, "time_avg"));
+    }
+
+    const std::string              benchmark_name;
+    Parameters                     parameters;
+    ConditionalOStream             pcout;
+    std::unique_ptr<std::ofstream> output;
+    std::map<std::string, double>  baseline;
+    std::map<std::string, double>  baseline_timings;
+    double                         stream_bandwidth;
+    unsigned int                   n_regressions;
+  };
+
+
+
+  /**
+   * Create a triangulation suitable for the current parallel setup.
+   */
+  template <int dim>
+  std::unique_ptr<Triangulation<dim>>
+  create_triangulation()
+  {
+#ifdef DEAL_II_WITH_P4EST
+    return std::unique_ptr<Triangulation<dim>>(
+      new parallel::distributed::Triangulation<dim>(MPI_COMM_WORLD));
+#else
+    AssertThrow(Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD) == 1,
+                ExcMessage("Running the benchmarks on several MPI processes "
+                           "requires deal.II to be configured with p4est"));
+    return std::unique_ptr<Triangulation<dim>>(new Triangulation<dim>());
+#endif
+  }
+
+
+
+  /**
+   * Loop over the polynomial degrees from @p degree to @p max_degree for a
+   * given vectorization type, calling Benchmark<degree,
+   * VectorizedArrayType>::run(driver) for each degree.
+   */
+  template <template <int, typename> class Benchmark,
+            int degree,
+            int max_degree,
+            typename VectorizedArrayType>
+  struct DegreeLoop
+  {
+    static void
+    run(Driver &driver)
+    {
+      if (driver.run_degree(degree))
+        Benchmark<degree, VectorizedArrayType>::run(driver);
+      DegreeLoop<Benchmark, degree + 1, max_degree, VectorizedArrayType>::run(
+        driver);
+    }
+  };
+
+  template <template <int, typename> class Benchmark,
+            int max_degree,
+            typename VectorizedArrayType>
+  struct DegreeLoop<Benchmark, max_degree, max_degree, VectorizedArrayType>
+  {
+    static void
+    run(Driver &driver)
+    {
+      if (driver.run_degree(max_degree))
+        Benchmark<max_degree, VectorizedArrayType>::run(driver);
+    }
+  };
+
+
+
+  /**
+   * Run the benchmark for degrees 1 to @p max_degree and all vectorization
+   * widths of double variables available in the current configuration,
+   * i.e., the same widths MatrixFree gets instantiated for in the library.
+   */
+  template <template <int, typename> class Benchmark, int max_degree>
+  void
+  run_all_widths(Driver &driver)
+  {
+    DegreeLoop<Benchmark, 1, max_degree, VectorizedArray<double, 1>>::run(
+      driver);
+#if DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && \
+  (defined(__SSE2__) || defined(__ALTIVEC__))
+    DegreeLoop<Benchmark, 1, max_degree, VectorizedArray<double, 2>>::run(
+      driver);
+#endif
+#if DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 2 && defined(__AVX__)
+    DegreeLoop<Benchmark, 1, max_degree, VectorizedArray<double, 4>>::run(
+      driver);
+#endif
+#if DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 3 && defined(__AVX512F__)
+    DegreeLoop<Benchmark, 1, max_degree, VectorizedArray<double, 8>>::run(
+      driver);
+#endif
+  }
+} // namespace Benchmarks
+
+#endif
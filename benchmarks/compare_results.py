@@ -0,0 +1,150 @@
+#!/usr/bin/env python
+## ---------------------------------------------------------------------
+##
+## Copyright (C) 2019 by the deal.II authors
+##
+## This file is part of the deal.II library.
+##
+## The deal.II library is free software; you can use it, redistribute
+## it, and/or modify it under the terms of the GNU Lesser General
+## Public License as published by the Free Software Foundation; either
+## version 2.1 of the License, or (at your option) any later version.
+## The full text of the license can be found in the file LICENSE.md at
+## the top level directory of deal.II.
+##
+## ---------------------------------------------------------------------
+
+# Compare the JSON lines written by the benchmarks in this directory.
+#
+# With two files, the records of the second file are compared against the
+# ones of the first file, e.g. to compare two versions of the library:
+#
+#   compare_results.py old/setup_phases.json new/setup_phases.json
+#
+# The throughput of "measurement" records and the time of "timing" records
+# are listed together with their relative change, and the script returns
+# with a non-zero exit code if any of them got worse by more than the
+# tolerance given with --tolerance (default: 0.05).
+#
+# With the option --scaling, the files are instead taken to be runs of the
+# same benchmark on different numbers of MPI processes, and the parallel
+# efficiency of every phase is listed relative to the run with the fewest
+# processes, for weak or strong scaling as recorded by the benchmark:
+#
+#   compare_results.py --scaling np1.json np2.json np4.json np8.json
+
+from __future__ import print_function
+
+import argparse
+import json
+import sys
+
+
+def read_records(file_name):
+    """Return the system record and a dictionary of the measurement and
+    timing records of a file, keyed by the parameters that identify them."""
+    system = {}
+    records = {}
+    with open(file_name) as results:
+        for line in results:
+            line = line.strip()
+            if not line:
+                continue
+            record = json.loads(line)
+            if record["record"] == "system":
+                system = record
+            elif record["record"] == "measurement":
+                key = (record["benchmark"], record["operator"],
+                       "degree %d" % record["degree"],
+                       "lanes %d" % record["n_lanes"],
+                       "threads %d" % record["threads"])
+                # a larger throughput is better
+                records[key] = (record["dofs_per_second"], 1.)
+            elif record["record"] == "timing":
+                key = (record["benchmark"], record["case"], record["phase"],
+                       "degree %d" % record["degree"],
+                       "threads %d" % record["threads"])
+                # a smaller time is better
+                records[key] = (record["time_avg"], -1.)
+    return system, records
+
+
+def compare(baseline_file, current_file, tolerance):
+    _, baseline = read_records(baseline_file)
+    _, current = read_records(current_file)
+
+    n_regressions = 0
+    print("%-70s %12s %12s %8s" % ("case", "baseline", "current", "change"))
+    for key in sorted(current):
+        if key not in baseline:
+            continue
+        value, sign = current[key]
+        base_value = baseline[key][0]
+        change = value / base_value - 1.
+        regression = sign * change < -tolerance
+        if regression:
+            n_regressions += 1
+        print("%-70s %12.4g %12.4g %7.1f%%%s" %
+              (" / ".join(key), base_value, value, 100. * change,
+               "  <-- regression" if regression else ""))
+
+    print("%d regression(s) with tolerance %g" % (n_regressions, tolerance))
+    return 1 if n_regressions > 0 else 0
+
+
+def scaling(files):
+    runs = []
+    for file_name in files:
+        system, records = read_records(file_name)
+        runs.append((system.get("n_mpi_processes", 1),
+                     system.get("scaling", "strong"), records))
+    runs.sort(key=lambda run: run[0])
+
+    weak = runs[0][1] == "weak"
+    print("%s scaling, parallel efficiency relative to %d process(es)" %
+          ("weak" if weak else "strong", runs[0][0]))
+    print("%-70s" % "case" +
+          "".join(" %10s" % ("np=%d" % run[0]) for run in runs))
+    for key in sorted(runs[0][2]):
+        base_value, sign = runs[0][2][key]
+        line = "%-70s" % " / ".join(key)
+        for n_processes, _, records in runs:
+            if key not in records:
+                line += " %10s" % "-"
+                continue
+            value = records[key][0]
+            # the throughput should grow with the number of processes for
+            # both kinds of scaling, whereas the time should only decrease
+            # for strong scaling
+            if sign > 0:
+                ratio = value / base_value * float(runs[0][0]) / n_processes
+            else:
+                ratio = base_value / value
+                if not weak:
+                    ratio *= float(runs[0][0]) / n_processes
+            line += " %9.1f%%" % (100. * ratio)
+        print(line)
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare the results of deal.II benchmarks.")
+    parser.add_argument("files", nargs="+",
+                        help="files with the JSON lines of benchmark runs")
+    parser.add_argument("--tolerance", type=float, default=0.05,
+                        help="allowed relative slowdown")
+    parser.add_argument("--scaling", action="store_true",
+                        help="compute the parallel efficiency of runs on "
+                        "different numbers of MPI processes")
+    args = parser.parse_args()
+
+    if args.scaling:
+        return scaling(args.files)
+    if len(args.files) != 2:
+        parser.error("Exactly two files are needed for a comparison")
+    return compare(args.files[0], args.files[1], args.tolerance)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
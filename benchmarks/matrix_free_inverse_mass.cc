@@ -0,0 +1,165 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Throughput of the application of the inverse mass matrix with discontinuous
+// FE_DGQ elements in 3D via MatrixFreeOperators::CellwiseInverseMassMatrix,
+// as done in explicit time integration of DG schemes.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/operators.h>
+
+#include "benchmark_driver.h"
+
+namespace Benchmarks
+{
+  template <int dim, int fe_degree, typename VectorizedArrayType>
+  class InverseMassOperator
+  {
+  public:
+    InverseMassOperator(const types::global_dof_index min_dofs)
+      : triangulation(create_triangulation<dim>())
+      , fe(fe_degree)
+      , dof_handler(*triangulation)
+    {
+      create_mesh(*triangulation, fe_degree + 1, min_dofs);
+      dof_handler.distribute_dofs(fe);
+      constraints.close();
+
+      typename MatrixFree<dim, double, VectorizedArrayType>::AdditionalData
+        additional_data;
+      additional_data.mapping_update_flags = update_JxW_values;
+      matrix_free.reinit(dof_handler,
+                         constraints,
+                         QGauss<1>(fe_degree + 1),
+                         additional_data);
+    }
+
+    void
+    initialize_dof_vector(VectorType &vector) const
+    {
+      matrix_free.initialize_dof_vector(vector);
+    }
+
+    void
+    vmult(VectorType &dst, const VectorType &src) const
+    {
+      matrix_free.cell_loop(&InverseMassOperator::local_apply, this, dst, src);
+    }
+
+    double
+    bytes_per_dof() const
+    {
+      // read of the source vector, read and write of the destination vector
+      return 3 * sizeof(double);
+    }
+
+  private:
+    void
+    local_apply(const MatrixFree<dim, double, VectorizedArrayType> &data,
+                VectorType &                                        dst,
+                const VectorType &                                  src,
+                const std::pair<unsigned int, unsigned int> &cell_range) const
+    {
+      FEEvaluation<dim,
+                   fe_degree,
+                   fe_degree + 1,
+                   1,
+                   double,
+                   VectorizedArrayType>
+        phi(data);
+      MatrixFreeOperators::CellwiseInverseMassMatrix<dim,
+                                                     fe_degree,
+                                                     1,
+                                                     double,
+                                                     VectorizedArrayType>
+                                         inverse_mass(phi);
+      AlignedVector<VectorizedArrayType> inverse_jxw(phi.n_q_points);
+      for (unsigned int cell = cell_range.first; cell < cell_range.second;
+           ++cell)
+        {
+          phi.reinit(cell);
+          phi.read_dof_values(src);
+          inverse_mass.fill_inverse_JxW_values(inverse_jxw);
+          inverse_mass.apply(inverse_jxw,
+                             1,
+                             phi.begin_dof_values(),
+                             phi.begin_dof_values());
+          phi.set_dof_values(dst);
+        }
+    }
+
+    std::unique_ptr<Triangulation<dim>>          triangulation;
+    FE_DGQ<dim>                                  fe;
+    DoFHandler<dim>                              dof_handler;
+    AffineConstraints<double>                    constraints;
+    MatrixFree<dim, double, VectorizedArrayType> matrix_free;
+  };
+
+
+
+  template <int fe_degree, typename VectorizedArrayType>
+  struct InverseMassBenchmark
+  {
+    static void
+    run(Driver &driver)
+    {
+      using Operator = InverseMassOperator<3, fe_degree, VectorizedArrayType>;
+      driver.run<Operator>("inverse_mass",
+                           fe_degree,
+                           VectorizedArrayType::n_array_elements,
+                           [&]() {
+                             return std::unique_ptr<Operator>(new Operator(
+                               driver.get_parameters().min_dofs));
+                           });
+    }
+  };
+} // namespace Benchmarks
+
+
+
+int
+main(int argc, char **argv)
+{
+  try
+    {
+      dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv, 1);
+
+      Benchmarks::Driver driver("matrix_free_inverse_mass", argc, argv);
+      Benchmarks::run_all_widths<Benchmarks::InverseMassBenchmark, 8>(driver);
+      return driver.finalize();
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+}
@@ -0,0 +1,158 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Throughput of the matrix-free evaluation of the mass operator with
+// continuous FE_Q elements in 3D, using the same cell kernel as
+// MatrixFreeOperators::MassOperator. The kernel is spelled out here because
+// MatrixFreeOperators::MassOperator always uses the default vectorization
+// width, whereas this benchmark runs all widths available in the
+// configuration.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "benchmark_driver.h"
+
+namespace Benchmarks
+{
+  template <int dim, int fe_degree, typename VectorizedArrayType>
+  class MassOperator
+  {
+  public:
+    MassOperator(const types::global_dof_index min_dofs)
+      : triangulation(create_triangulation<dim>())
+      , fe(fe_degree)
+      , dof_handler(*triangulation)
+    {
+      create_mesh(*triangulation, fe_degree, min_dofs);
+      dof_handler.distribute_dofs(fe);
+      constraints.close();
+
+      typename MatrixFree<dim, double, VectorizedArrayType>::AdditionalData
+        additional_data;
+      additional_data.mapping_update_flags =
+        update_values | update_JxW_values;
+      matrix_free.reinit(dof_handler,
+                         constraints,
+                         QGauss<1>(fe_degree + 1),
+                         additional_data);
+    }
+
+    void
+    initialize_dof_vector(VectorType &vector) const
+    {
+      matrix_free.initialize_dof_vector(vector);
+    }
+
+    void
+    vmult(VectorType &dst, const VectorType &src) const
+    {
+      matrix_free.cell_loop(&MassOperator::local_apply, this, dst, src, true);
+    }
+
+    double
+    bytes_per_dof() const
+    {
+      // read of the source vector, read and write of the destination vector
+      return 3 * sizeof(double);
+    }
+
+  private:
+    void
+    local_apply(const MatrixFree<dim, double, VectorizedArrayType> &data,
+                VectorType &                                        dst,
+                const VectorType &                                  src,
+                const std::pair<unsigned int, unsigned int> &cell_range) const
+    {
+      FEEvaluation<dim,
+                   fe_degree,
+                   fe_degree + 1,
+                   1,
+                   double,
+                   VectorizedArrayType>
+        phi(data);
+      for (unsigned int cell = cell_range.first; cell < cell_range.second;
+           ++cell)
+        {
+          phi.reinit(cell);
+          phi.gather_evaluate(src, true, false);
+          for (unsigned int q = 0; q < phi.n_q_points; ++q)
+            phi.submit_value(phi.get_value(q), q);
+          phi.integrate_scatter(true, false, dst);
+        }
+    }
+
+    std::unique_ptr<Triangulation<dim>>          triangulation;
+    FE_Q<dim>                                    fe;
+    DoFHandler<dim>                              dof_handler;
+    AffineConstraints<double>                    constraints;
+    MatrixFree<dim, double, VectorizedArrayType> matrix_free;
+  };
+
+
+
+  template <int fe_degree, typename VectorizedArrayType>
+  struct MassBenchmark
+  {
+    static void
+    run(Driver &driver)
+    {
+      using Operator = MassOperator<3, fe_degree, VectorizedArrayType>;
+      driver.run<Operator>("mass",
+                           fe_degree,
+                           VectorizedArrayType::n_array_elements,
+                           [&]() {
+                             return std::unique_ptr<Operator>(new Operator(
+                               driver.get_parameters().min_dofs));
+                           });
+    }
+  };
+} // namespace Benchmarks
+
+
+
+int
+main(int argc, char **argv)
+{
+  try
+    {
+      dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv, 1);
+
+      Benchmarks::Driver driver("matrix_free_mass", argc, argv);
+      Benchmarks::run_all_widths<Benchmarks::MassBenchmark, 8>(driver);
+      return driver.finalize();
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+}
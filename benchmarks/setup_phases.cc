@@ -0,0 +1,250 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Wall times of the setup phases of a typical parallel finite element
+// program in 3D, following the structure of step-40 and step-37: the
+// creation and adaptive refinement of the mesh, the distribution of the
+// degrees of freedom, the computation of the hanging node and boundary
+// constraints, the construction and exchange of the sparsity pattern, the
+// setup of MatrixFree, the transfer of a solution vector to a refined mesh,
+// and the parallel output of the solution in VTU format. Each phase is
+// timed as a section of a TimerOutput object and reported as one "timing"
+// record per phase and polynomial degree.
+//
+// For strong scaling, run the program with the same --min-dofs on an
+// increasing number of MPI processes; for weak scaling, add the option
+// "--scaling weak", in which case --min-dofs is the problem size per
+// process.
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/distributed/solution_transfer.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_tools.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <deal.II/numerics/data_out.h>
+#include <deal.II/numerics/solution_transfer.h>
+
+#include "benchmark_driver.h"
+
+namespace Benchmarks
+{
+  /**
+   * Mark the cells within the given distance of @p center for refinement
+   * and refine the mesh.
+   */
+  template <int dim>
+  void
+  refine_around(Triangulation<dim> &tria,
+                const Point<dim> &  center,
+                const double        radius)
+  {
+    for (const auto &cell : tria.active_cell_iterators())
+      if (cell->is_locally_owned() && cell->center().distance(center) < radius)
+        cell->set_refine_flag();
+    tria.execute_coarsening_and_refinement();
+  }
+
+
+
+  /**
+   * Run all setup phases once, entering one section of @p timer per phase,
+   * and return the number of degrees of freedom before the solution
+   * transfer.
+   */
+  template <int dim>
+  types::global_dof_index
+  run_setup_phases(const unsigned int            degree,
+                   const types::global_dof_index min_dofs,
+                   TimerOutput &                 timer)
+  {
+    std::unique_ptr<Triangulation<dim>> triangulation =
+      create_triangulation<dim>();
+    {
+      // the mesh is refined once more around a corner, which adds about 10
+      // percent of cells and creates hanging nodes
+      TimerOutput::Scope scope(timer, "create and refine mesh");
+      create_mesh(*triangulation, degree, min_dofs);
+      refine_around(*triangulation, Point<dim>(), 0.3);
+    }
+
+    const FE_Q<dim> fe(degree);
+    DoFHandler<dim> dof_handler(*triangulation);
+    {
+      TimerOutput::Scope scope(timer, "distribute dofs");
+      dof_handler.distribute_dofs(fe);
+    }
+    const types::global_dof_index n_dofs = dof_handler.n_dofs();
+
+    IndexSet                  locally_relevant_dofs;
+    AffineConstraints<double> constraints;
+    {
+      TimerOutput::Scope scope(timer, "constraints");
+      DoFTools::extract_locally_relevant_dofs(dof_handler,
+                                              locally_relevant_dofs);
+      constraints.reinit(locally_relevant_dofs);
+      DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+      DoFTools::make_zero_boundary_constraints(dof_handler, 0, constraints);
+      constraints.close();
+    }
+
+    {
+      TimerOutput::Scope     scope(timer, "sparsity pattern");
+      DynamicSparsityPattern dsp(locally_relevant_dofs);
+      DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints, false);
+#ifdef DEAL_II_WITH_MPI
+      SparsityTools::distribute_sparsity_pattern(
+        dsp,
+        dof_handler.compute_n_locally_owned_dofs_per_processor(),
+        MPI_COMM_WORLD,
+        locally_relevant_dofs);
+#endif
+    }
+
+    MatrixFree<dim, double> matrix_free;
+    {
+      TimerOutput::Scope scope(timer, "matrix-free setup");
+      typename MatrixFree<dim, double>::AdditionalData additional_data;
+      additional_data.mapping_update_flags =
+        update_gradients | update_JxW_values | update_quadrature_points;
+      matrix_free.reinit(dof_handler,
+                         constraints,
+                         QGauss<1>(degree + 1),
+                         additional_data);
+    }
+
+    VectorType solution;
+    matrix_free.initialize_dof_vector(solution);
+    for (unsigned int i = 0; i < solution.local_size(); ++i)
+      solution.local_element(i) = static_cast<double>(i % 7) / 7.;
+    constraints.distribute(solution);
+    solution.update_ghost_values();
+
+    VectorType transferred_solution;
+    {
+      TimerOutput::Scope scope(timer, "solution transfer");
+      for (const auto &cell : triangulation->active_cell_iterators())
+        if (cell->is_locally_owned() &&
+            cell->center().distance(Point<dim>::unit_vector(0)) < 0.3)
+          cell->set_refine_flag();
+#ifdef DEAL_II_WITH_P4EST
+      parallel::distributed::SolutionTransfer<dim, VectorType> transfer(
+        dof_handler);
+      transfer.prepare_for_coarsening_and_refinement(solution);
+      triangulation->execute_coarsening_and_refinement();
+      dof_handler.distribute_dofs(fe);
+
+      transferred_solution.reinit(dof_handler.locally_owned_dofs(),
+                                  MPI_COMM_WORLD);
+      transfer.interpolate(transferred_solution);
+#else
+      SolutionTransfer<dim, VectorType> transfer(dof_handler);
+      transfer.prepare_for_coarsening_and_refinement(solution);
+      triangulation->execute_coarsening_and_refinement();
+      dof_handler.distribute_dofs(fe);
+
+      transferred_solution.reinit(dof_handler.n_dofs());
+      transfer.interpolate(solution, transferred_solution);
+#endif
+    }
+
+    {
+      TimerOutput::Scope scope(timer, "output");
+      IndexSet           relevant_dofs_after_transfer;
+      DoFTools::extract_locally_relevant_dofs(dof_handler,
+                                              relevant_dofs_after_transfer);
+      VectorType ghosted_solution(dof_handler.locally_owned_dofs(),
+                                  relevant_dofs_after_transfer,
+                                  MPI_COMM_WORLD);
+      ghosted_solution.copy_locally_owned_data_from(transferred_solution);
+      ghosted_solution.update_ghost_values();
+
+      DataOut<dim> data_out;
+      data_out.attach_dof_handler(dof_handler);
+      data_out.add_data_vector(ghosted_solution, "solution");
+      data_out.build_patches(degree);
+      data_out.write_vtu_in_parallel("setup_phases_solution.vtu",
+                                     MPI_COMM_WORLD);
+    }
+
+    return n_dofs;
+  }
+
+
+
+  void
+  run(Driver &driver)
+  {
+    const Parameters &parameters = driver.get_parameters();
+    for (unsigned int degree = 1; degree <= 4; ++degree)
+      if (driver.run_degree(degree))
+        for (const unsigned int n_threads : parameters.threads)
+          {
+            MultithreadInfo::set_thread_limit(n_threads);
+
+            TimerOutput timer(MPI_COMM_WORLD,
+                              std::cout,
+                              TimerOutput::never,
+                              TimerOutput::wall_times);
+
+            types::global_dof_index n_dofs = 0;
+            for (unsigned int r = 0; r < parameters.repetitions; ++r)
+              n_dofs = run_setup_phases<3>(degree, parameters.min_dofs, timer);
+
+            driver.add_timings("FE_Q", degree, n_dofs, timer);
+          }
+  }
+} // namespace Benchmarks
+
+
+
+int
+main(int argc, char **argv)
+{
+  try
+    {
+      dealii::Utilities::MPI::MPI_InitFinalize mpi(argc, argv, 1);
+
+      // the setup phases are expensive, so only repeat them a few times
+      // unless requested otherwise on the command line
+      Benchmarks::Driver driver("setup_phases", argc, argv, 3);
+      Benchmarks::run(driver);
+      return driver.finalize();
+    }
+  catch (std::exception &exc)
+    {
+      std::cerr << std::endl
+                << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      std::cerr << "Exception on processing: " << std::endl
+                << exc.what() << std::endl
+                << "Aborting!" << std::endl
+                << "----------------------------------------------------"
+                << std::endl;
+      return 1;
+    }
+}
@@ -18,6 +18,7 @@
 #
 #   DEAL_II_HAVE_GETHOSTNAME
 #   DEAL_II_HAVE_GETPID
+#   DEAL_II_HAVE_LINUX_PERF_EVENT_H
 #   DEAL_II_HAVE_SYS_RESOURCE_H
 #   DEAL_II_HAVE_UNISTD_H
 #   DEAL_II_MSVC
@@ -39,6 +40,8 @@ CHECK_INCLUDE_FILE_CXX("unistd.h" DEAL_II_HAVE_UNISTD_H)
 CHECK_CXX_SYMBOL_EXISTS("gethostname" "unistd.h" DEAL_II_HAVE_GETHOSTNAME)
 CHECK_CXX_SYMBOL_EXISTS("getpid" "unistd.h" DEAL_II_HAVE_GETPID)
 
+CHECK_INCLUDE_FILE_CXX("linux/perf_event.h" DEAL_II_HAVE_LINUX_PERF_EVENT_H)
+
 ########################################################################
 #                                                                      #
 #                        Mac OSX specific setup:                       #
@@ -201,6 +201,74 @@ MACRO(FEATURE_TRILINOS_FIND_EXTERNAL var)
       ENDIF()
     ENDIF()
 
+    IF(${DEAL_II_TRILINOS_WITH_TPETRA})
+      #
+      # LinearAlgebra::TpetraWrappers::SparseMatrix builds its matrix on a
+      # static graph and adds entries atomically. Check that the graph
+      # constructor it uses for this Trilinos version and the atomic
+      # sumIntoLocalValues() are available for our index types, and only
+      # provide the class if they are.
+      #
+      LIST(APPEND CMAKE_REQUIRED_INCLUDES ${Trilinos_INCLUDE_DIRS})
+      LIST(APPEND CMAKE_REQUIRED_INCLUDES ${MPI_CXX_INCLUDE_PATH})
+      ADD_FLAGS(CMAKE_REQUIRED_FLAGS "${DEAL_II_CXX_VERSION_FLAG}")
+      IF(${DEAL_II_KOKKOS_LAMBDA_EXISTS})
+        ADD_FLAGS(CMAKE_REQUIRED_FLAGS "--expt-extended-lambda")
+      ENDIF()
+      LIST(APPEND CMAKE_REQUIRED_LIBRARIES "${Trilinos_LIBRARIES}")
+      CHECK_CXX_SOURCE_COMPILES(
+        "
+        #include <Tpetra_CrsGraph.hpp>
+        #include <Tpetra_CrsGraph_def.hpp>
+        #include <Tpetra_CrsMatrix.hpp>
+        #include <Tpetra_CrsMatrix_def.hpp>
+        #include <Trilinos_version.h>
+        int
+        main()
+        {
+          using LO          = int;
+          using GO          = unsigned int;
+          using map_type    = Tpetra::Map<LO, GO>;
+          using graph_type  = Tpetra::CrsGraph<LO, GO>;
+          using matrix_type = Tpetra::CrsMatrix<double, LO, GO>;
+          Teuchos::RCP<const map_type> map = Teuchos::rcp(new map_type());
+        #if TRILINOS_MAJOR_MINOR_VERSION >= 130000
+          std::vector<std::size_t> entries_per_row(1, 1);
+          Teuchos::RCP<graph_type> graph = Teuchos::rcp(new graph_type(
+            map, Teuchos::ArrayView<const std::size_t>(entries_per_row)));
+        #else
+          Teuchos::ArrayRCP<std::size_t> entries_per_row(1, 1);
+          Teuchos::RCP<graph_type> graph = Teuchos::rcp(new graph_type(
+            map,
+            Teuchos::ArrayRCP<const std::size_t>(entries_per_row),
+            Tpetra::StaticProfile));
+        #endif
+          graph->fillComplete(map, map);
+          matrix_type  matrix(graph);
+          const LO     column = 0;
+          const double value  = 0.;
+          matrix.sumIntoLocalValues(0,
+                                    Teuchos::ArrayView<const LO>(&column, 1),
+                                    Teuchos::ArrayView<const double>(&value, 1),
+                                    true);
+        #if TRILINOS_MAJOR_MINOR_VERSION >= 130200
+          return matrix.getLocalNumEntries() + matrix.getLocalNumRows();
+        #else
+          return matrix.getNodeNumEntries() + matrix.getNodeNumRows();
+        #endif
+        }
+        "
+        TRILINOS_TPETRA_SPARSE_MATRIX_IS_FUNCTIONAL
+        )
+      RESET_CMAKE_REQUIRED()
+      IF(NOT TRILINOS_TPETRA_SPARSE_MATRIX_IS_FUNCTIONAL)
+        MESSAGE(
+          STATUS
+          "Tpetra does not support the static graph interface needed by TpetraWrappers::SparseMatrix! Disabling this class."
+          )
+      ENDIF()
+    ENDIF()
+
     IF(${DEAL_II_TRILINOS_WITH_SACADO})
       #
       # Look for Sacado_config.h - we'll query it to determine C++11 support:
@@ -277,6 +345,9 @@ MACRO(FEATURE_TRILINOS_CONFIGURE_EXTERNAL)
         SET(DEAL_II_EXPAND_TPETRA_VECTOR_COMPLEX_DOUBLE "LinearAlgebra::TpetraWrappers::Vector<std::complex<double>>")
         SET(DEAL_II_EXPAND_TPETRA_VECTOR_COMPLEX_FLOAT "LinearAlgebra::TpetraWrappers::Vector<std::complex<float>>")
       ENDIF()
+      IF (TRILINOS_TPETRA_SPARSE_MATRIX_IS_FUNCTIONAL)
+        SET(DEAL_II_TRILINOS_TPETRA_SPARSE_MATRIX_IS_FUNCTIONAL TRUE)
+      ENDIF()
     ENDIF()
   ENDIF()
   IF(${DEAL_II_TRILINOS_WITH_SACADO})
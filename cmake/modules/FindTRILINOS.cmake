@@ -165,4 +165,5 @@ DEAL_II_PACKAGE_HANDLE(TRILINOS
     TRILINOS_CONFIG_DIR EPETRA_CONFIG_H SACADO_CMATH_HPP ${_libraries}
     SACADO_CONFIG_H
     TRILINOS_CXX_SUPPORTS_SACADO_COMPLEX_RAD
+    TRILINOS_TPETRA_SPARSE_MATRIX_IS_FUNCTIONAL
   )
@@ -33,6 +33,16 @@ namespace CUDAWrappers
    * changed depending on the architecture the code is running on.
    */
   constexpr int chunk_size = 1;
+
+  /**
+   * Define the number of threads that execute in lockstep on the device, i.e.
+   * the size of a warp. This is 32 on all NVIDIA architectures; devices
+   * executing wider groups of threads, like the 64-wide wavefronts of AMD
+   * GPUs, need a different value. The reduction kernels rely on this number
+   * for the last steps of a reduction, which are done without
+   * synchronization.
+   */
+  constexpr int warp_size = 32;
 } // namespace CUDAWrappers
 
 DEAL_II_NAMESPACE_CLOSE
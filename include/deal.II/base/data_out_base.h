@@ -1261,6 +1261,54 @@ namespace DataOutBase
     static const unsigned int format_version;
   };
 
+  /**
+   * Flags controlling the layout of the datasets written in HDF5 format.
+   *
+   * @ingroup output
+   */
+  struct Hdf5Flags : public OutputFlagsBase<Hdf5Flags>
+  {
+    /**
+     * The number of rows, i.e., nodes or cells, per chunk of the datasets
+     * written. If zero, the datasets are stored contiguously, which is the
+     * default of HDF5. Chunked storage is required for compression and
+     * allows to read parts of large datasets efficiently.
+     */
+    unsigned int chunk_size;
+
+    /**
+     * The level of the deflate (gzip) compression of the chunks, between 0
+     * (no compression) and 9 (best compression). Compression is only applied
+     * to chunked datasets, i.e., if @p chunk_size is positive. Parallel
+     * output of compressed datasets requires HDF5 1.10.2 or later.
+     */
+    unsigned int compression_level;
+
+    /**
+     * Whether the data sets, i.e., the solution fields, are stored in single
+     * instead of double precision. Since the patches store their data in
+     * single precision anyway, this halves the size of these datasets without
+     * losing any information.
+     */
+    bool single_precision_data;
+
+    /**
+     * Whether the node locations are stored in single instead of double
+     * precision. This halves the size of the node dataset, at the cost of
+     * an accuracy of about seven digits relative to the size of the
+     * coordinates, which is usually sufficient for visualization.
+     */
+    bool single_precision_nodes;
+
+    /**
+     * Constructor.
+     */
+    Hdf5Flags(const unsigned int chunk_size             = 0,
+              const unsigned int compression_level      = 0,
+              const bool         single_precision_data  = false,
+              const bool         single_precision_nodes = false);
+  };
+
   /**
    * Flags controlling the DataOutFilter.
    *
@@ -2631,6 +2679,20 @@ namespace DataOutBase
                       const std::string &solution_filename,
                       MPI_Comm           comm);
 
+  /**
+   * Same as above, but the layout of the datasets, i.e., whether they are
+   * chunked and compressed, is determined by @p flags.
+   */
+  template <int dim, int spacedim>
+  void
+  write_hdf5_parallel(const std::vector<Patch<dim, spacedim>> &patches,
+                      const DataOutFilter &                    data_filter,
+                      const bool                               write_mesh_file,
+                      const std::string &                      mesh_filename,
+                      const std::string &solution_filename,
+                      MPI_Comm           comm,
+                      const Hdf5Flags &  flags);
+
   /**
    * DataOutFilter is an intermediate data format that reduces the amount of
    * data that will be written to files. The object filled by this function
@@ -2987,10 +3049,47 @@ public:
    * one used by the computation.  This routine uses MPI I/O to achieve high
    * performance on parallel filesystems. Also see
    * DataOutInterface::write_vtu().
+   *
+   * Each process writes its own data at an offset computed in advance, using
+   * a single collective write operation. This is the same as calling the
+   * function below with <tt>n_ranks_per_writer = 1</tt>.
    */
   void
   write_vtu_in_parallel(const std::string &filename, MPI_Comm comm) const;
 
+  /**
+   * Same as above, but the data is first collected on a subset of the
+   * processes that then write it to the file. This reduces the number of
+   * processes accessing the file system, which is often the limiting factor
+   * for large numbers of processes.
+   *
+   * The processes of @p comm are split into groups of @p n_ranks_per_writer
+   * consecutive ranks. If @p n_ranks_per_writer is zero, each group
+   * consists of the processes that share memory, i.e., there is one writer
+   * per compute node (this requires MPI 3.0; with older MPI versions, every
+   * process writes its own data). The first process of each group receives
+   * the data of all other processes of its group and writes it to the file.
+   *
+   * The pairs of strings in @p mpi_io_hints are passed as hints to
+   * MPI_File_open(), which allows to tune the MPI I/O implementation to
+   * the file system. For example, on Lustre file systems, the hints
+   * <tt>{"striping_factor", "64"}</tt> and
+   * <tt>{"striping_unit", "4194304"}</tt> request that the file is
+   * striped over 64 storage targets in blocks of 4 MB. Hints that are not
+   * understood by the MPI implementation are ignored.
+   *
+   * The file written by this function is the same for all values of
+   * @p n_ranks_per_writer, except for the order of the data of the
+   * processes if the groups do not consist of consecutive ranks.
+   */
+  void
+  write_vtu_in_parallel(
+    const std::string &                                     filename,
+    MPI_Comm                                                comm,
+    const unsigned int                                      n_ranks_per_writer,
+    const std::vector<std::pair<std::string, std::string>> &mpi_io_hints =
+      {}) const;
+
   /**
    * Some visualization programs, such as ParaView, can read several separate
    * VTU files that all form part of the same simulation, in order to
@@ -3125,6 +3224,9 @@ public:
    * contain only the solution values. If write_mesh_file is true and the
    * filenames are the same, the resulting file will contain both mesh data
    * and solution values.
+   *
+   * Whether the datasets are chunked and compressed is determined by the
+   * DataOutBase::Hdf5Flags set through set_flags().
    */
   void
   write_hdf5_parallel(const DataOutBase::DataOutFilter &data_filter,
@@ -3282,6 +3384,14 @@ protected:
   void
   validate_dataset_names() const;
 
+  /**
+   * Return the flags that are used for output in the VTK and VTU formats.
+   * This is useful for derived classes that write these formats without
+   * going through write_vtk() or write_vtu().
+   */
+  const DataOutBase::VtkFlags &
+  get_vtk_flags() const;
+
 
   /**
    * The default number of subdivisions for patches. This is filled by
@@ -3357,6 +3467,12 @@ private:
    * dimension. Can be changed by using the <tt>set_flags</tt> function.
    */
   DataOutBase::Deal_II_IntermediateFlags deal_II_intermediate_flags;
+
+  /**
+   * Flags to be used upon output of HDF5 data. Can be changed by using the
+   * <tt>set_flags</tt> function.
+   */
+  DataOutBase::Hdf5Flags hdf5_flags;
 };
 
 
@@ -3594,6 +3710,15 @@ public:
   void
   add_attribute(const std::string &attr_name, const unsigned int dimension);
 
+  /**
+   * Set the size in bytes of the floating point numbers stored in the HDF5
+   * files for the node locations and for the attributes, i.e., 8 for double
+   * and 4 for single precision. The default is 8 for both.
+   */
+  void
+  set_precision(const unsigned int node_precision,
+                const unsigned int attribute_precision);
+
   /**
    * Read or write the data of this object for serialization
    */
@@ -3602,7 +3727,8 @@ public:
   serialize(Archive &ar, const unsigned int /*version*/)
   {
     ar &valid &h5_sol_filename &h5_mesh_filename &entry_time &num_nodes
-      &num_cells &dimension &space_dimension &attribute_dims;
+      &num_cells &dimension &space_dimension &attribute_dims &node_precision
+        &attribute_precision;
   }
 
   /**
@@ -3658,6 +3784,114 @@ private:
    * The attributes associated with this entry and their dimension.
    */
   std::map<std::string, unsigned int> attribute_dims;
+
+  /**
+   * The size in bytes of the floating point numbers of the node locations.
+   */
+  unsigned int node_precision;
+
+  /**
+   * The size in bytes of the floating point numbers of the attributes.
+   */
+  unsigned int attribute_precision;
+};
+
+
+
+/**
+ * A class that writes the output of a time dependent simulation as a series
+ * of HDF5 files together with an XDMF file that describes the whole series.
+ * The mesh, i.e., the node locations and the cells, is written to a separate
+ * HDF5 file only for the first time step and whenever the user indicates
+ * that the mesh has changed, and the XDMF entries of all following time
+ * steps refer to this file. For the other time steps, only the solution
+ * fields are written, so that the amount of output of a simulation on a
+ * fixed mesh is roughly halved.
+ *
+ * The files are named after the base name given to the constructor:
+ * <tt>basename_mesh-NNNN.h5</tt> for the mesh with generation number
+ * <tt>NNNN</tt>, <tt>basename_solution-NNNNN.h5</tt> for the solution of
+ * the time step with number <tt>NNNNN</tt>, and <tt>basename.xdmf</tt> for
+ * the XDMF file, which is rewritten after each time step so that it can be
+ * opened while the simulation is running. Whether the datasets are chunked
+ * and compressed is determined by the DataOutBase::Hdf5Flags of the
+ * DataOutInterface object passed to write_time_step().
+ *
+ * A typical use would look like this:
+ * @code
+ * XDMFTimeSeries time_series("solution", MPI_COMM_WORLD);
+ * for (unsigned int step = 0; step < n_steps; ++step)
+ *   {
+ *     ... // solve, possibly refine the mesh
+ *
+ *     DataOut<dim> data_out;
+ *     data_out.attach_dof_handler(dof_handler);
+ *     data_out.add_data_vector(solution, "u");
+ *     data_out.build_patches();
+ *     time_series.write_time_step(data_out, time, mesh_was_refined);
+ *   }
+ * @endcode
+ */
+class XDMFTimeSeries
+{
+public:
+  /**
+   * Constructor. All files are written by the processes of the communicator
+   * @p comm, using the DataOutFilter with the given @p filter_flags.
+   */
+  XDMFTimeSeries(const std::string &                    basename,
+                 MPI_Comm                               comm,
+                 const DataOutBase::DataOutFilterFlags &filter_flags =
+                   DataOutBase::DataOutFilterFlags(true, true));
+
+  /**
+   * Write the patches of @p data_out as the time step at time @p time. The
+   * mesh is written to a new file if @p mesh_changed is true or if this is
+   * the first time step; otherwise, the mesh file of the previous time step
+   * is referenced.
+   */
+  template <int dim, int spacedim>
+  void
+  write_time_step(const DataOutInterface<dim, spacedim> &data_out,
+                  const double                           time,
+                  const bool                             mesh_changed);
+
+  /**
+   * Return the XDMF entries of the time steps written so far.
+   */
+  const std::vector<XDMFEntry> &
+  get_entries() const;
+
+private:
+  /**
+   * The base name of all files.
+   */
+  const std::string basename;
+
+  /**
+   * The communicator of the processes that write the files.
+   */
+  const MPI_Comm comm;
+
+  /**
+   * The flags used to filter the data before writing it.
+   */
+  const DataOutBase::DataOutFilterFlags filter_flags;
+
+  /**
+   * The number of meshes written so far.
+   */
+  unsigned int n_mesh_generations;
+
+  /**
+   * The name of the file the current mesh has been written to.
+   */
+  std::string mesh_filename;
+
+  /**
+   * The XDMF entries of all time steps written so far.
+   */
+  std::vector<XDMFEntry> entries;
 };
 
 
@@ -1471,6 +1471,47 @@ namespace Functions
     gradient(const Point<dim> & p,
              const unsigned int component = 0) const override;
 
+    /**
+     * Compute the values of the function at all @p points. Rather than
+     * searching the coordinate arrays anew for every point, the rectangle
+     * found for the previous point is tested first, which for points that
+     * lie close to each other, such as the quadrature points of a cell,
+     * avoids most of the searches.
+     */
+    virtual void
+    value_list(const std::vector<Point<dim>> &points,
+               std::vector<double> &          values,
+               const unsigned int             component = 0) const override;
+
+    /**
+     * Compute the gradients of the function at all @p points, with the same
+     * search strategy as value_list().
+     */
+    virtual void
+    gradient_list(const std::vector<Point<dim>> &points,
+                  std::vector<Tensor<1, dim>> &  gradients,
+                  const unsigned int             component = 0) const override;
+
+    /**
+     * Return the values of the function at the points given by the lanes of
+     * @p p, as needed in the quadrature point loops of FEEvaluation where
+     * the quadrature points of several cells are stored in a
+     * VectorizedArray. The data of the rectangles containing the points are
+     * collected lane by lane, and the interpolation is then done in
+     * vectorized arithmetic.
+     */
+    VectorizedArray<double>
+    value(const Point<dim, VectorizedArray<double>> &p,
+          const unsigned int                         component = 0) const;
+
+    /**
+     * Return the gradients of the function at the points given by the lanes
+     * of @p p, in the same way as the vectorized value() function.
+     */
+    Tensor<1, dim, VectorizedArray<double>>
+    gradient(const Point<dim, VectorizedArray<double>> &p,
+             const unsigned int                         component = 0) const;
+
   protected:
     /**
      * Find the index in the table of the rectangle containing an input point
@@ -1478,6 +1519,15 @@ namespace Functions
     TableIndices<dim>
     table_index_of_point(const Point<dim> &p) const;
 
+    /**
+     * Find the index in the table of the rectangle containing an input
+     * point, testing the rectangle @p guess and its neighbors before
+     * searching the coordinate arrays.
+     */
+    TableIndices<dim>
+    table_index_of_point(const Point<dim> &       p,
+                         const TableIndices<dim> &guess) const;
+
     /**
      * The set of coordinate values in each of the coordinate directions.
      */
@@ -1577,7 +1627,57 @@ namespace Functions
     gradient(const Point<dim> & p,
              const unsigned int component = 0) const override;
 
+    /**
+     * Compute the values of the function at all @p points.
+     */
+    virtual void
+    value_list(const std::vector<Point<dim>> &points,
+               std::vector<double> &          values,
+               const unsigned int             component = 0) const override;
+
+    /**
+     * Compute the gradients of the function at all @p points.
+     */
+    virtual void
+    gradient_list(const std::vector<Point<dim>> &points,
+                  std::vector<Tensor<1, dim>> &  gradients,
+                  const unsigned int             component = 0) const override;
+
+    /**
+     * Return the values of the function at the points given by the lanes of
+     * @p p, as needed in the quadrature point loops of FEEvaluation where
+     * the quadrature points of several cells are stored in a
+     * VectorizedArray.
+     */
+    VectorizedArray<double>
+    value(const Point<dim, VectorizedArray<double>> &p,
+          const unsigned int                         component = 0) const;
+
+    /**
+     * Return the gradients of the function at the points given by the lanes
+     * of @p p.
+     */
+    Tensor<1, dim, VectorizedArray<double>>
+    gradient(const Point<dim, VectorizedArray<double>> &p,
+             const unsigned int                         component = 0) const;
+
   private:
+    /**
+     * Find the index in the table of the rectangle containing an input point
+     * and the coordinates of the point relative to that rectangle, truncated
+     * to the unit box. @p delta_x are the interval_sizes().
+     */
+    TableIndices<dim>
+    table_index_of_point(const Point<dim> &p,
+                         const Point<dim> &delta_x,
+                         Point<dim> &      p_unit) const;
+
+    /**
+     * The size of the subintervals in each of the coordinate directions.
+     */
+    Point<dim>
+    interval_sizes() const;
+
     /**
      * The set of interval endpoints in each of the coordinate directions.
      */
@@ -341,6 +341,36 @@ public:
   virtual void
   vector_value(const Point<dim> &p, Vector<double> &values) const override;
 
+  /**
+   * Set <tt>values</tt> to the point values of the specified component of
+   * the function at the <tt>points</tt>. In contrast to calling value() for
+   * each point, the parser of the current thread is looked up only once for
+   * all points, which makes a noticeable difference for expressions that
+   * are cheap to evaluate.
+   */
+  virtual void
+  value_list(const std::vector<Point<dim>> &points,
+             std::vector<double> &          values,
+             const unsigned int             component = 0) const override;
+
+  /**
+   * Set <tt>values</tt> to the values of all components of the function at
+   * the <tt>points</tt>, in the same way as value_list().
+   */
+  virtual void
+  vector_value_list(const std::vector<Point<dim>> &points,
+                    std::vector<Vector<double>> &  values) const override;
+
+  /**
+   * Return the values of the function at the points given by the lanes of
+   * @p p, as needed in the quadrature point loops of FEEvaluation where
+   * the quadrature points of several cells are stored in a
+   * VectorizedArray.
+   */
+  VectorizedArray<double>
+  value(const Point<dim, VectorizedArray<double>> &p,
+        const unsigned int                         component = 0) const;
+
   /**
    * Return an array of function expressions (one per component), used to
    * initialize this function.
@@ -20,11 +20,15 @@
 
 #  include <deal.II/base/config.h>
 
+#  include <deal.II/base/parallel.h>
 #  include <deal.II/base/thread_management.h>
 
 #  include <deal.II/lac/sparsity_tools.h>
 
+#  include <algorithm>
+#  include <cstdint>
 #  include <functional>
+#  include <numeric>
 #  include <set>
 #  include <unordered_map>
 #  include <unordered_set>
@@ -454,6 +458,231 @@ namespace GraphColoring
 
       return coloring;
     }
+
+
+
+    /**
+     * Return a reproducible pseudo-random number for the vertex with index
+     * @p i, used by make_parallel_graph_coloring() to break ties between
+     * vertices of the same degree. This is the finalizer of the SplitMix64
+     * generator.
+     */
+    inline std::uint64_t
+    vertex_hash(const std::uint64_t i)
+    {
+      std::uint64_t z = i + 0x9e3779b97f4a7c15ULL;
+      z               = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z               = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      return z ^ (z >> 31);
+    }
+
+
+
+    /**
+     * Compute the conflict graph of the iterators in @p elements, i.e., for
+     * each iterator the list of the positions in @p elements of the
+     * iterators whose conflict indices have a nonempty intersection with its
+     * own. Instead of comparing all pairs of iterators as in
+     * make_dsatur_coloring(), the pairs of conflict index and iterator
+     * position are sorted, so that the iterators sharing an index can be
+     * found by a binary search. The conflict indices and the lists of
+     * neighbors are computed in parallel.
+     */
+    template <typename Iterator>
+    std::vector<std::vector<unsigned int>>
+    make_conflict_graph(
+      const std::vector<Iterator> &elements,
+      const std::function<std::vector<types::global_dof_index>(
+        const Iterator &)> &       get_conflict_indices)
+    {
+      const unsigned int n_elements = elements.size();
+
+      std::vector<std::vector<types::global_dof_index>> conflict_indices(
+        n_elements);
+      parallel::apply_to_subranges(
+        0U,
+        n_elements,
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int i = begin; i < end; ++i)
+            conflict_indices[i] = get_conflict_indices(elements[i]);
+        },
+        32);
+
+      std::vector<std::pair<types::global_dof_index, unsigned int>>
+        index_to_element;
+      for (unsigned int i = 0; i < n_elements; ++i)
+        for (const types::global_dof_index index : conflict_indices[i])
+          index_to_element.emplace_back(index, i);
+      std::sort(index_to_element.begin(), index_to_element.end());
+
+      std::vector<std::vector<unsigned int>> graph(n_elements);
+      parallel::apply_to_subranges(
+        0U,
+        n_elements,
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int i = begin; i < end; ++i)
+            {
+              for (const types::global_dof_index index : conflict_indices[i])
+                for (auto p = std::lower_bound(
+                       index_to_element.begin(),
+                       index_to_element.end(),
+                       std::make_pair(index, 0U));
+                     p != index_to_element.end() && p->first == index;
+                     ++p)
+                  if (p->second != i)
+                    graph[i].push_back(p->second);
+              std::sort(graph[i].begin(), graph[i].end());
+              graph[i].erase(std::unique(graph[i].begin(), graph[i].end()),
+                             graph[i].end());
+            }
+        },
+        32);
+
+      return graph;
+    }
+
+
+
+    /**
+     * Color the vertices of @p graph with the algorithm of Jones and
+     * Plassmann. Each vertex gets a priority given by its degree, with ties
+     * broken by vertex_hash(). In each round, all uncolored vertices whose
+     * priority is larger than the one of all their uncolored neighbors form
+     * an independent set and are assigned, in parallel, the smallest color
+     * not used by any of their neighbors. The number of colors is at most one
+     * larger than the maximal degree, as for a sequential greedy coloring in
+     * order of decreasing degree.
+     *
+     * @return The color of each vertex.
+     */
+    inline std::vector<unsigned int>
+    make_jones_plassmann_coloring(
+      const std::vector<std::vector<unsigned int>> &graph)
+    {
+      const unsigned int n_vertices = graph.size();
+
+      std::vector<std::uint64_t> priority(n_vertices);
+      for (unsigned int i = 0; i < n_vertices; ++i)
+        priority[i] = (static_cast<std::uint64_t>(graph[i].size()) << 32) |
+                      (vertex_hash(i) & 0xffffffffULL);
+      const auto has_higher_priority = [&](const unsigned int a,
+                                           const unsigned int b) {
+        return priority[a] > priority[b] ||
+               (priority[a] == priority[b] && a > b);
+      };
+
+      std::vector<unsigned int> color(n_vertices,
+                                      numbers::invalid_unsigned_int);
+      std::vector<unsigned char> selected(n_vertices, 0);
+      std::vector<unsigned int>  uncolored(n_vertices);
+      std::iota(uncolored.begin(), uncolored.end(), 0U);
+
+      while (uncolored.empty() == false)
+        {
+          // select the vertices that are local maxima of the priority among
+          // the uncolored vertices
+          parallel::apply_to_subranges(
+            0U,
+            uncolored.size(),
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int j = begin; j < end; ++j)
+                {
+                  const unsigned int v = uncolored[j];
+                  selected[v]          = 1;
+                  for (const unsigned int u : graph[v])
+                    if (color[u] == numbers::invalid_unsigned_int &&
+                        has_higher_priority(u, v))
+                      {
+                        selected[v] = 0;
+                        break;
+                      }
+                }
+            },
+            64);
+
+          // color the selected vertices. no two selected vertices are
+          // neighbors, so the colors read here are not modified concurrently
+          parallel::apply_to_subranges(
+            0U,
+            uncolored.size(),
+            [&](const unsigned int begin, const unsigned int end) {
+              std::vector<bool> color_is_used;
+              for (unsigned int j = begin; j < end; ++j)
+                {
+                  const unsigned int v = uncolored[j];
+                  if (selected[v] == 0)
+                    continue;
+                  color_is_used.assign(graph[v].size() + 1, false);
+                  for (const unsigned int u : graph[v])
+                    if (color[u] < color_is_used.size())
+                      color_is_used[color[u]] = true;
+                  color[v] = std::find(color_is_used.begin(),
+                                       color_is_used.end(),
+                                       false) -
+                             color_is_used.begin();
+                }
+            },
+            64);
+
+          const auto is_colored = [&](const unsigned int v) {
+            return color[v] != numbers::invalid_unsigned_int;
+          };
+          uncolored.erase(
+            std::remove_if(uncolored.begin(), uncolored.end(), is_colored),
+            uncolored.end());
+        }
+
+      return color;
+    }
+
+
+
+    /**
+     * Balance the sizes of the colors given in @p color for the vertices of
+     * @p graph: each vertex of a color with more than the average number of
+     * vertices is moved to the smallest color with less than the average
+     * number of vertices that is not used by any of its neighbors, if there
+     * is one. The number of colors is not changed.
+     */
+    inline void
+    balance_coloring(const std::vector<std::vector<unsigned int>> &graph,
+                     std::vector<unsigned int> &                   color)
+    {
+      if (color.empty())
+        return;
+
+      const unsigned int n_colors =
+        *std::max_element(color.begin(), color.end()) + 1;
+      const unsigned int target_size =
+        (color.size() + n_colors - 1) / n_colors;
+
+      std::vector<unsigned int> color_size(n_colors, 0);
+      for (const unsigned int c : color)
+        ++color_size[c];
+
+      std::vector<unsigned int> neighbor_marker(n_colors,
+                                                numbers::invalid_unsigned_int);
+      for (unsigned int v = 0; v < color.size(); ++v)
+        if (color_size[color[v]] > target_size)
+          {
+            for (const unsigned int u : graph[v])
+              neighbor_marker[color[u]] = v;
+
+            unsigned int best_color = numbers::invalid_unsigned_int;
+            for (unsigned int c = 0; c < n_colors; ++c)
+              if (color_size[c] < target_size && neighbor_marker[c] != v &&
+                  (best_color == numbers::invalid_unsigned_int ||
+                   color_size[c] < color_size[best_color]))
+                best_color = c;
+
+            if (best_color != numbers::invalid_unsigned_int)
+              {
+                --color_size[color[v]];
+                ++color_size[best_color];
+                color[v] = best_color;
+              }
+          }
+    }
   } // namespace internal
 
 
@@ -570,6 +799,83 @@ namespace GraphColoring
     return internal::gather_colors(partition_coloring);
   }
 
+
+
+  /**
+   * Create a coloring of the given range of iterators such that iterators
+   * with conflicting indices are assigned different colors, like
+   * make_graph_coloring(), but with an algorithm whose steps run in
+   * parallel and whose cost grows only linearly with the number of
+   * iterators. This makes it suitable for large meshes, where
+   * make_graph_coloring() spends a considerable time in comparing the
+   * conflict indices of all pairs of iterators within each zone of its
+   * partitioning.
+   *
+   * The function proceeds in three steps:
+   * <ol>
+   * <li> The conflict graph is built by sorting the pairs of conflict index
+   * and iterator, so that all iterators sharing an index are found by a
+   * binary search. Seen on the graph that connects each iterator with its
+   * conflict indices, this graph describes a distance-2 coloring problem,
+   * which is reduced to a distance-1 coloring of the conflict graph.
+   * <li> The conflict graph is colored with the algorithm of Jones and
+   * Plassmann (M. T. Jones, P. E. Plassmann: A parallel graph coloring
+   * heuristic, SIAM J. Sci. Comput. 14:654-669, 1993). Vertices are
+   * prioritized by their degree, with ties broken by a reproducible
+   * pseudo-random number, and in each round all vertices with a larger
+   * priority than their uncolored neighbors are colored concurrently. The
+   * result does not depend on the number of threads.
+   * <li> The sizes of the colors are balanced by moving iterators from
+   * colors larger than the average to smaller colors that do not conflict,
+   * which helps the load balance of WorkStream::run(), since the iterators
+   * of one color are worked on in parallel, and a color that is much larger
+   * than the others adds to the time spent in the last tasks of each color.
+   * </ol>
+   *
+   * The arguments and the returned object have the same meaning as for
+   * make_graph_coloring(), and the result can be passed to
+   * WorkStream::run() in the same way. The coloring found by this function
+   * may use a few more colors than the one of make_graph_coloring(), but the
+   * colors are of similar size.
+   *
+   * @note Since the conflict indices of the iterators are computed in
+   * parallel, the function @p get_conflict_indices must be safe to be
+   * called from several threads at once. This is the case for functions
+   * that only query the degrees of freedom of a cell, such as
+   * DoFCellAccessor::get_dof_indices().
+   */
+  template <typename Iterator>
+  std::vector<std::vector<Iterator>>
+  make_parallel_graph_coloring(
+    const Iterator &                               begin,
+    const typename identity<Iterator>::type &      end,
+    const std::function<std::vector<types::global_dof_index>(
+      const typename identity<Iterator>::type &)> &get_conflict_indices)
+  {
+    Assert(begin != end,
+           ExcMessage(
+             "GraphColoring is not prepared to deal with empty ranges!"));
+
+    std::vector<Iterator> elements;
+    for (Iterator it = begin; it != end; ++it)
+      elements.push_back(it);
+
+    const std::vector<std::vector<unsigned int>> graph =
+      internal::make_conflict_graph(elements, get_conflict_indices);
+
+    std::vector<unsigned int> color =
+      internal::make_jones_plassmann_coloring(graph);
+    internal::balance_coloring(graph, color);
+
+    const unsigned int n_colors =
+      *std::max_element(color.begin(), color.end()) + 1;
+    std::vector<std::vector<Iterator>> coloring(n_colors);
+    for (unsigned int i = 0; i < elements.size(); ++i)
+      coloring[color[i]].push_back(elements[i]);
+
+    return coloring;
+  }
+
   /**
    * GraphColoring::color_sparsity_pattern, a wrapper function for
    * SparsityTools::color_sparsity_pattern, is an alternate method for
@@ -943,6 +943,29 @@ private:
    */
   mutable size_type largest_range;
 
+  /**
+   * A lookup table that accelerates the search for the range containing a
+   * given index in index sets with many ranges, such as the sets of ghost
+   * indices of unstructured meshes, where the binary search over all ranges
+   * is slow. The part of the index space between the first and the last
+   * element of the set is divided into buckets of
+   * <tt>2^range_lookup_shift</tt> indices each, with about an eighth as many
+   * buckets as there are ranges. The entry @p b of the table is the number of the first
+   * range that ends after the start of bucket @p b, so that the search for an
+   * index is restricted to the ranges between the entries of its bucket and
+   * of the next one.
+   *
+   * The table is set up by do_compress() if there are sufficiently many
+   * ranges and is empty otherwise.
+   */
+  mutable std::vector<unsigned int> range_lookup;
+
+  /**
+   * The binary logarithm of the number of indices per bucket of
+   * @p range_lookup.
+   */
+  mutable unsigned int range_lookup_shift;
+
   /**
    * A mutex that is used to synchronize operations of the do_compress()
    * function that is called from many 'const' functions via compress().
@@ -954,6 +977,17 @@ private:
    */
   void
   do_compress() const;
+
+  /**
+   * Return in @p range_begin and @p range_end the part of @p ranges that
+   * contains the first range whose end is larger than @p index, using either
+   * @p range_lookup or the position relative to the largest range. The
+   * index set must be compressed and not empty.
+   */
+  void
+  get_search_interval(const size_type                     index,
+                      std::vector<Range>::const_iterator &range_begin,
+                      std::vector<Range>::const_iterator &range_end) const;
 };
 
 
@@ -1431,6 +1465,7 @@ inline IndexSet::IndexSet()
   : is_compressed(true)
   , index_space_size(0)
   , largest_range(numbers::invalid_unsigned_int)
+  , range_lookup_shift(0)
 {}
 
 
@@ -1439,6 +1474,7 @@ inline IndexSet::IndexSet(const size_type size)
   : is_compressed(true)
   , index_space_size(size)
   , largest_range(numbers::invalid_unsigned_int)
+  , range_lookup_shift(0)
 {}
 
 
@@ -1448,11 +1484,14 @@ inline IndexSet::IndexSet(IndexSet &&is) noexcept
   , is_compressed(is.is_compressed)
   , index_space_size(is.index_space_size)
   , largest_range(is.largest_range)
+  , range_lookup(std::move(is.range_lookup))
+  , range_lookup_shift(is.range_lookup_shift)
 {
   is.ranges.clear();
   is.is_compressed    = true;
   is.index_space_size = 0;
   is.largest_range    = numbers::invalid_unsigned_int;
+  is.range_lookup.clear();
 
   compress();
 }
@@ -1462,15 +1501,18 @@ inline IndexSet::IndexSet(IndexSet &&is) noexcept
 inline IndexSet &
 IndexSet::operator=(IndexSet &&is) noexcept
 {
-  ranges           = std::move(is.ranges);
-  is_compressed    = is.is_compressed;
-  index_space_size = is.index_space_size;
-  largest_range    = is.largest_range;
+  ranges             = std::move(is.ranges);
+  is_compressed      = is.is_compressed;
+  index_space_size   = is.index_space_size;
+  largest_range      = is.largest_range;
+  range_lookup       = std::move(is.range_lookup);
+  range_lookup_shift = is.range_lookup_shift;
 
   is.ranges.clear();
   is.is_compressed    = true;
   is.index_space_size = 0;
   is.largest_range    = numbers::invalid_unsigned_int;
+  is.range_lookup.clear();
 
   compress();
 
@@ -1501,32 +1543,20 @@ IndexSet::at(const size_type global_index) const
   if (ranges.empty())
     return end();
 
-  std::vector<Range>::const_iterator main_range =
-    ranges.begin() + largest_range;
-
   Range r(global_index, global_index + 1);
-  // This optimization makes the bounds for lower_bound smaller by checking
-  // the largest range first.
+  // This optimization makes the bounds for lower_bound smaller by using the
+  // lookup table or checking the largest range first.
   std::vector<Range>::const_iterator range_begin, range_end;
-  if (global_index < main_range->begin)
-    {
-      range_begin = ranges.begin();
-      range_end   = main_range;
-    }
-  else
-    {
-      range_begin = main_range;
-      range_end   = ranges.end();
-    }
+  get_search_interval(global_index, range_begin, range_end);
 
-  // This will give us the first range p=[a,b[ with b>=global_index using
+  // This will give us the first range p=[a,b[ with b>global_index using
   // a binary search
   const std::vector<Range>::const_iterator p =
     Utilities::lower_bound(range_begin, range_end, r, Range::end_compare);
 
   // We couldn't find a range, which means we have no range that contains
   // global_index and also no range behind it, meaning we need to return end().
-  if (p == ranges.end())
+  if (p == range_end)
     return end();
 
   // Finally, we can have two cases: Either global_index is not in [a,b[,
@@ -1580,6 +1610,7 @@ IndexSet::clear()
   ranges.clear();
   is_compressed = true;
   largest_range = numbers::invalid_unsigned_int;
+  range_lookup.clear();
 }
 
 
@@ -1674,35 +1705,20 @@ IndexSet::is_element(const size_type index) const
           index < ranges[largest_range].end)
         return true;
 
-      // get the element after which we would have to insert a range that
-      // consists of all elements from this element to the end of the index
-      // range plus one. after this call we know that if p!=end() then
-      // p->begin<=index unless there is no such range at all
-      //
-      // if the searched for element is an element of this range, then we're
-      // done. otherwise, the element can't be in one of the following ranges
-      // because otherwise p would be a different iterator
-      //
-      // since we already know the position relative to the largest range (we
-      // called compress!), we can perform the binary search on ranges with
-      // lower/higher number compared to the largest range
-      std::vector<Range>::const_iterator p = std::upper_bound(
-        ranges.begin() +
-          (index < ranges[largest_range].begin ? 0 : largest_range + 1),
-        index < ranges[largest_range].begin ? ranges.begin() + largest_range :
-                                              ranges.end(),
-        Range(index, size() + 1));
-
-      if (p == ranges.begin())
-        return ((index >= p->begin) && (index < p->end));
-
-      Assert((p == ranges.end()) || (p->begin > index), ExcInternalError());
-
-      // now move to that previous range
-      --p;
-      Assert(p->begin <= index, ExcInternalError());
-
-      return (p->end > index);
+      // get the first range whose end is larger than the index. if the index
+      // is an element of the set, then it is an element of this range.
+      // otherwise, the element can't be in one of the following ranges
+      // because they all start after the end of this range
+      std::vector<Range>::const_iterator range_begin, range_end;
+      get_search_interval(index, range_begin, range_end);
+
+      const std::vector<Range>::const_iterator p =
+        Utilities::lower_bound(range_begin,
+                               range_end,
+                               Range(index, index + 1),
+                               Range::end_compare);
+
+      return (p != range_end && p->begin <= index);
     }
 
   // didn't find this index, so it's not in the set
@@ -1829,8 +1845,9 @@ IndexSet::index_within_set(const size_type n) const
   if (is_empty())
     return numbers::invalid_dof_index;
 
-  // check whether the index is in the largest range. use the result to
-  // perform a one-sided binary search afterward
+  // check whether the index is in the largest range. if not, use the lookup
+  // table or the position relative to the largest range to restrict the
+  // binary search afterward
   Assert(largest_range < ranges.size(), ExcInternalError());
   std::vector<Range>::const_iterator main_range =
     ranges.begin() + largest_range;
@@ -1839,16 +1856,7 @@ IndexSet::index_within_set(const size_type n) const
 
   Range                              r(n, n);
   std::vector<Range>::const_iterator range_begin, range_end;
-  if (n < main_range->begin)
-    {
-      range_begin = ranges.begin();
-      range_end   = main_range;
-    }
-  else
-    {
-      range_begin = main_range + 1;
-      range_end   = ranges.end();
-    }
+  get_search_interval(n, range_begin, range_end);
 
   std::vector<Range>::const_iterator p =
     Utilities::lower_bound(range_begin, range_end, r, Range::end_compare);
@@ -1865,6 +1873,55 @@ IndexSet::index_within_set(const size_type n) const
 
 
 
+inline void
+IndexSet::get_search_interval(
+  const size_type                     index,
+  std::vector<Range>::const_iterator &range_begin,
+  std::vector<Range>::const_iterator &range_end) const
+{
+  Assert(is_compressed == true, ExcMessage("IndexSet must be compressed."));
+  Assert(ranges.empty() == false, ExcInternalError());
+
+  if (range_lookup.empty() == false && index >= ranges.front().begin)
+    {
+      const size_type bucket =
+        (index - ranges.front().begin) >> range_lookup_shift;
+      if (bucket + 1 < range_lookup.size())
+        {
+          // the first range ending after the index is at most the first
+          // range ending after the start of the next bucket, so include that
+          // one in the search
+          range_begin =
+            ranges.begin() +
+            std::min<std::size_t>(range_lookup[bucket], ranges.size());
+          range_end =
+            ranges.begin() +
+            std::min<std::size_t>(range_lookup[bucket + 1] + 1, ranges.size());
+          return;
+        }
+    }
+
+  // without lookup table, the first range ending after the index lies
+  // before the largest range (or is the largest range itself) if the index
+  // is smaller than the beginning of the largest range, and not before the
+  // largest range otherwise
+  Assert(largest_range < ranges.size(), ExcInternalError());
+  const std::vector<Range>::const_iterator main_range =
+    ranges.begin() + largest_range;
+  if (index < main_range->begin)
+    {
+      range_begin = ranges.begin();
+      range_end   = main_range + 1;
+    }
+  else
+    {
+      range_begin = main_range;
+      range_end   = ranges.end();
+    }
+}
+
+
+
 inline bool
 IndexSet::operator==(const IndexSet &is) const
 {
@@ -1946,6 +2003,10 @@ inline void
 IndexSet::serialize(Archive &ar, const unsigned int)
 {
   ar &ranges &is_compressed &index_space_size &largest_range;
+
+  // the lookup table for the ranges is not stored, but set up again
+  if (Archive::is_loading::value && is_compressed)
+    do_compress();
 }
 
 DEAL_II_NAMESPACE_CLOSE
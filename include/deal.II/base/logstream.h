@@ -244,6 +244,18 @@ public:
   depth_file(const unsigned int n);
 
 
+  /**
+   * Return whether output written at the current depth, i.e., with the
+   * prefixes currently on the stack, reaches the console or the attached
+   * file according to the limits set by depth_console() and depth_file().
+   * Code that produces many lines of output, e.g., the convergence
+   * history of an iterative solver, can use this function to skip
+   * formatting the output altogether if it would be discarded anyway.
+   */
+  bool
+  is_output_enabled() const;
+
+
   /**
    * Log the thread id.
    */
@@ -529,6 +529,182 @@ namespace Utilities
     MinMaxAvg
     min_max_avg(const double my_value, const MPI_Comm &mpi_communicator);
 
+    /**
+     * A class that represents the result of a reduction over all processors
+     * that has been started by one of the functions isum(), imax(), or
+     * imin(), but that has possibly not yet completed. This corresponds to
+     * the <code>MPI_Iallreduce</code> function: the reduction proceeds in the
+     * background while the calling process does other work, for example a
+     * local computation that does not depend on the result, and the result
+     * is only waited for when it is actually needed:
+     * @code
+     *   Utilities::MPI::ReductionFuture<double> norm_sqr =
+     *     Utilities::MPI::isum(local_norm_sqr, mpi_communicator);
+     *   ... // other work
+     *   const double norm = std::sqrt(norm_sqr.get());
+     * @endcode
+     *
+     * A reduction over several values, as started by the functions taking an
+     * ArrayView argument, is sent in a single message. Combining several
+     * scalar reductions in this way (say, the two inner products computed in
+     * one iteration of an iterative solver) therefore only incurs the latency
+     * of one reduction.
+     *
+     * All processes of the communicator must start the same reductions in
+     * the same order, as for all collective operations. If the destructor is
+     * called while the reduction has not completed yet, it waits for its
+     * completion.
+     *
+     * If deal.II is not configured for use of MPI, or if the MPI installation
+     * does not support MPI 3.0, the reduction is completed already when the
+     * object is created.
+     *
+     * @note This class is only implemented for the template arguments
+     * <code>T</code> for which the sum() function is implemented.
+     */
+    template <typename T>
+    class ReductionFuture
+    {
+    public:
+      /**
+       * Default constructor. Creates an object that does not represent any
+       * reduction.
+       */
+      ReductionFuture();
+
+      /**
+       * Start the reduction of @p values over all processes of
+       * @p mpi_communicator with the operation @p mpi_op. The values are
+       * copied, i.e., @p values need not stay alive until the reduction has
+       * completed.
+       */
+      ReductionFuture(const MPI_Op &            mpi_op,
+                      const ArrayView<const T> &values,
+                      const MPI_Comm &          mpi_communicator);
+
+      /**
+       * Move constructor. The reduction represented by @p other, if any, is
+       * now represented by this object.
+       */
+      ReductionFuture(ReductionFuture<T> &&other) noexcept;
+
+      /**
+       * Move assignment. Waits for the reduction represented by this object,
+       * if any, before taking over the one of @p other.
+       */
+      ReductionFuture<T> &
+      operator=(ReductionFuture<T> &&other);
+
+      /**
+       * Destructor. Waits for the reduction to complete.
+       */
+      ~ReductionFuture();
+
+      /**
+       * Return whether the reduction has completed, without blocking. This
+       * corresponds to the <code>MPI_Test</code> function and also helps
+       * MPI implementations without a progress thread to advance the
+       * reduction.
+       */
+      bool
+      is_ready();
+
+      /**
+       * Wait for the reduction to complete.
+       */
+      void
+      wait();
+
+      /**
+       * Wait for the reduction to complete and return the result for the
+       * value with index @p index.
+       */
+      const T &
+      get(const unsigned int index = 0);
+
+      /**
+       * Wait for the reduction to complete and return the results for all
+       * values.
+       */
+      ArrayView<const T>
+      get_all();
+
+      /**
+       * Return the number of values that are reduced.
+       */
+      unsigned int
+      size() const;
+
+    private:
+      /**
+       * The values contributed by the present process before the reduction
+       * has completed, and the reduced values afterwards.
+       */
+      std::vector<T> values;
+
+#ifdef DEAL_II_WITH_MPI
+      /**
+       * The request of the non-blocking reduction, or MPI_REQUEST_NULL if
+       * there is no reduction in flight.
+       */
+      MPI_Request request;
+#endif
+    };
+
+    /**
+     * Start computing the sum over all processors of the value @p t and
+     * return an object through which the result can be obtained once it is
+     * needed. This is the non-blocking variant of the sum() function; see the
+     * ReductionFuture class for details.
+     */
+    template <typename T>
+    ReductionFuture<T>
+    isum(const T &t, const MPI_Comm &mpi_communicator);
+
+    /**
+     * Like the previous function, but start computing the sums over each of
+     * the elements of @p values. All sums are computed in a single
+     * reduction, and their results are obtained through
+     * ReductionFuture::get() with the respective index.
+     */
+    template <typename T>
+    ReductionFuture<T>
+    isum(const ArrayView<const T> &values, const MPI_Comm &mpi_communicator);
+
+    /**
+     * Start computing the maximum over all processors of the value @p t. This
+     * is the non-blocking variant of the max() function; see the
+     * ReductionFuture class for details.
+     */
+    template <typename T>
+    ReductionFuture<T>
+    imax(const T &t, const MPI_Comm &mpi_communicator);
+
+    /**
+     * Like the previous function, but start computing the maxima over each
+     * of the elements of @p values in a single reduction.
+     */
+    template <typename T>
+    ReductionFuture<T>
+    imax(const ArrayView<const T> &values, const MPI_Comm &mpi_communicator);
+
+    /**
+     * Start computing the minimum over all processors of the value @p t. This
+     * is the non-blocking variant of the min() function; see the
+     * ReductionFuture class for details.
+     */
+    template <typename T>
+    ReductionFuture<T>
+    imin(const T &t, const MPI_Comm &mpi_communicator);
+
+    /**
+     * Like the previous function, but start computing the minima over each
+     * of the elements of @p values in a single reduction.
+     */
+    template <typename T>
+    ReductionFuture<T>
+    imin(const ArrayView<const T> &values, const MPI_Comm &mpi_communicator);
+
     /**
      * A class that is used to initialize the MPI system at the beginning of a
      * program and to shut it down again at the end. It also allows you to
@@ -878,18 +1054,29 @@ namespace Utilities
     class ConsensusAlgorithm_NBX : public ConsensusAlgorithm<T1, T2>
     {
     public:
-      // Unique tags to be used during Isend and Irecv
-      static const unsigned int tag_request  = 12;
-      static const unsigned int tag_delivery = 13;
+      // Unique tags to be used during Isend and Irecv, unless
+      // different ones are given to the constructor
+      static const unsigned int default_tag_request  = 12;
+      static const unsigned int default_tag_delivery = 13;
 
       /**
        * Constructor.
        *
        * @param process Process to be run during consensus algorithm.
        * @param comm MPI Communicator
+       * @param tag_request Tag of the messages containing the requests.
+       * @param tag_delivery Tag of the messages containing the answers.
+       *
+       * Algorithms that may run concurrently on the same communicator, e.g.,
+       * one process has already started the next exchange while another one
+       * is still answering requests of the previous one, need to use
+       * different tags to keep their messages apart.
        */
-      ConsensusAlgorithm_NBX(ConsensusAlgorithmProcess<T1, T2> &process,
-                             const MPI_Comm &                   comm);
+      ConsensusAlgorithm_NBX(
+        ConsensusAlgorithmProcess<T1, T2> &process,
+        const MPI_Comm &                   comm,
+        const unsigned int                 tag_request  = default_tag_request,
+        const unsigned int                 tag_delivery = default_tag_delivery);
 
       /**
        * Destructor.
@@ -903,6 +1090,16 @@ namespace Utilities
       run() override;
 
     private:
+      /**
+       * Tag of the messages containing the requests.
+       */
+      const unsigned int tag_request;
+
+      /**
+       * Tag of the messages containing the answers.
+       */
+      const unsigned int tag_delivery;
+
 #ifdef DEAL_II_WITH_MPI
       /**
        * List of processes this process wants to send requests to.
@@ -1020,18 +1217,27 @@ namespace Utilities
     class ConsensusAlgorithm_PEX : public ConsensusAlgorithm<T1, T2>
     {
     public:
-      // Unique tags to be used during Isend and Irecv
-      static const unsigned int tag_request  = 14;
-      static const unsigned int tag_delivery = 15;
+      // Unique tags to be used during Isend and Irecv, unless
+      // different ones are given to the constructor
+      static const unsigned int default_tag_request  = 14;
+      static const unsigned int default_tag_delivery = 15;
 
       /**
        * Constructor.
        *
        * @param process Process to be run during consensus algorithm.
        * @param comm MPI Communicator
+       * @param tag_request Tag of the messages containing the requests.
+       * @param tag_delivery Tag of the messages containing the answers.
+       *
+       * See the constructor of ConsensusAlgorithm_NBX for when to use
+       * tags other than the default ones.
        */
-      ConsensusAlgorithm_PEX(ConsensusAlgorithmProcess<T1, T2> &process,
-                             const MPI_Comm &                   comm);
+      ConsensusAlgorithm_PEX(
+        ConsensusAlgorithmProcess<T1, T2> &process,
+        const MPI_Comm &                   comm,
+        const unsigned int                 tag_request  = default_tag_request,
+        const unsigned int                 tag_delivery = default_tag_delivery);
 
       /**
        * Destructor.
@@ -1045,6 +1251,16 @@ namespace Utilities
       run() override;
 
     private:
+      /**
+       * Tag of the messages containing the requests.
+       */
+      const unsigned int tag_request;
+
+      /**
+       * Tag of the messages containing the answers.
+       */
+      const unsigned int tag_delivery;
+
 #ifdef DEAL_II_WITH_MPI
       /**
        * List of ranks of processes this processes wants to send a request to.
@@ -1106,13 +1322,108 @@ namespace Utilities
       clean_up_and_end_communication();
     };
 
+    /**
+     * This class implements ConsensusAlgorithm with a two-level approach
+     * that is aware of the compute nodes the processes run on. Rather than
+     * sending one message from each process to each of its targets, the
+     * requests of all processes of a node are collected by one process of
+     * the node (the node leader), which combines the requests addressed to
+     * processes of the same destination node into a single message. The
+     * destination node leader distributes the requests to the processes of
+     * its node, and the answers travel back along the same way.
+     *
+     * The algorithm proceeds in the following steps:
+     * - The communicator is split into one communicator per shared-memory
+     *   node (<code>MPI_Comm_split_type</code>) and a communicator of the
+     *   node leaders. This is only done the first time the algorithm is run
+     *   on a communicator; the resulting communicators are attached to it
+     *   and freed together with it.
+     * - The requests of all processes are gathered on their node leader.
+     * - The node leaders determine which other node leaders they receive
+     *   requests from, with compute_point_to_point_communication_pattern(),
+     *   and exchange the combined requests.
+     * - Each node leader scatters the received requests to the processes of
+     *   its node, which answer them.
+     * - The answers are collected, exchanged, and scattered in the same way.
+     *
+     * As a consequence, the number of messages sent across the network
+     * scales with the number of pairs of communicating nodes rather than the
+     * number of pairs of communicating processes, which reduces the latency
+     * of the many small messages sent, for example, during the ownership
+     * lookup of compute_index_owner() on large numbers of processes. The
+     * price is the additional copying through the node leaders, which is why
+     * ConsensusAlgorithmSelector only uses this class for large numbers of
+     * processes.
+     *
+     * @note Since the answers to requests arrive with their size, the
+     *       function ConsensusAlgorithmProcess::prepare_recv_buffer() is not
+     *       called by this class.
+     *
+     * @note The elements of type @p T1 and @p T2 are sent as raw bytes, so
+     *       these types need to be trivially copyable.
+     *
+     * @note This class uses MPI 3.0 features.
+     *
+     * @tparam T1 the type of the elements of the vector to sent
+     * @tparam T2 the type of the elements of the vector to received
+     */
+    template <typename T1, typename T2>
+    class ConsensusAlgorithm_NodeAware : public ConsensusAlgorithm<T1, T2>
+    {
+    public:
+      // Unique tags to be used for the messages between node leaders, unless
+      // different ones are given to the constructor
+      static const unsigned int default_tag_request  = 16;
+      static const unsigned int default_tag_delivery = 17;
+
+      /**
+       * Constructor.
+       *
+       * @param process Process to be run during consensus algorithm.
+       * @param comm MPI Communicator
+       * @param tag_request Tag of the messages containing the requests.
+       * @param tag_delivery Tag of the messages containing the answers.
+       *
+       * See the constructor of ConsensusAlgorithm_NBX for when to use
+       * tags other than the default ones.
+       */
+      ConsensusAlgorithm_NodeAware(
+        ConsensusAlgorithmProcess<T1, T2> &process,
+        const MPI_Comm &                   comm,
+        const unsigned int                 tag_request  = default_tag_request,
+        const unsigned int                 tag_delivery = default_tag_delivery);
+
+      /**
+       * Destructor.
+       */
+      virtual ~ConsensusAlgorithm_NodeAware() = default;
+
+      /**
+       * Run consensus algorithm.
+       */
+      virtual void
+      run() override;
+
+    private:
+      /**
+       * Tag of the messages containing the requests.
+       */
+      const unsigned int tag_request;
+
+      /**
+       * Tag of the messages containing the answers.
+       */
+      const unsigned int tag_delivery;
+    };
+
     /**
      * A class which delegates its task to other ConsensusAlgorithm
      * implementations depending on the number of processes in the
      * MPI communicator. For a small number of processes it uses
-     * ConsensusAlgorithm_PEX and for large number of processes
-     * ConsensusAlgorithm_NBX. The threshold depends if the program is
-     * compiled in debug or release mode.
+     * ConsensusAlgorithm_PEX, for a large number of processes
+     * ConsensusAlgorithm_NBX, and for a very large number of processes
+     * ConsensusAlgorithm_NodeAware. The thresholds depend on whether the
+     * program is compiled in debug or release mode.
      *
      * @tparam T1 the type of the elements of the vector to sent
      * @tparam T2 the type of the elements of the vector to received
@@ -1128,9 +1439,16 @@ namespace Utilities
        *
        * @param process Process to be run during consensus algorithm.
        * @param comm MPI Communicator.
+       * @param tag_request Tag of the messages containing the requests. If
+       *   not given, the default tag of the selected implementation is used.
+       * @param tag_delivery Tag of the messages containing the answers. If
+       *   not given, the default tag of the selected implementation is used.
        */
-      ConsensusAlgorithmSelector(ConsensusAlgorithmProcess<T1, T2> &process,
-                                 const MPI_Comm &                   comm);
+      ConsensusAlgorithmSelector(
+        ConsensusAlgorithmProcess<T1, T2> &process,
+        const MPI_Comm &                   comm,
+        const unsigned int tag_request  = numbers::invalid_unsigned_int,
+        const unsigned int tag_delivery = numbers::invalid_unsigned_int);
 
       /**
        * Destructor.
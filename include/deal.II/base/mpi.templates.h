@@ -42,6 +42,14 @@ namespace Utilities
       /**
        * Return the corresponding MPI data type id for the argument given.
        */
+      inline MPI_Datatype
+      mpi_type_id(const char *)
+      {
+        return MPI_CHAR;
+      }
+
+
+
       inline MPI_Datatype
       mpi_type_id(const int *)
       {
@@ -412,6 +420,223 @@ namespace Utilities
     {
       internal::all_reduce(MPI_MIN, values, mpi_communicator, minima);
     }
+
+
+
+    template <typename T>
+    ReductionFuture<T>::ReductionFuture()
+#ifdef DEAL_II_WITH_MPI
+      : request(MPI_REQUEST_NULL)
+#endif
+    {}
+
+
+
+    template <typename T>
+    ReductionFuture<T>::ReductionFuture(const MPI_Op &            mpi_op,
+                                        const ArrayView<const T> &values,
+                                        const MPI_Comm &mpi_communicator)
+      : values(values.begin(), values.end())
+#ifdef DEAL_II_WITH_MPI
+      , request(MPI_REQUEST_NULL)
+#endif
+    {
+#ifdef DEAL_II_WITH_MPI
+      if (job_supports_mpi())
+        {
+#  if DEAL_II_MPI_VERSION_GTE(3, 0)
+          const int ierr =
+            MPI_Iallreduce(MPI_IN_PLACE,
+                           static_cast<void *>(this->values.data()),
+                           static_cast<int>(this->values.size()),
+                           internal::mpi_type_id(this->values.data()),
+                           mpi_op,
+                           mpi_communicator,
+                           &request);
+          AssertThrowMPI(ierr);
+#  else
+          internal::all_reduce(mpi_op,
+                               ArrayView<const T>(this->values.data(),
+                                                  this->values.size()),
+                               mpi_communicator,
+                               make_array_view(this->values));
+#  endif
+        }
+#else
+      (void)mpi_op;
+      (void)mpi_communicator;
+#endif
+    }
+
+
+
+    template <typename T>
+    ReductionFuture<T>::ReductionFuture(ReductionFuture<T> &&other) noexcept
+      : values(std::move(other.values))
+#ifdef DEAL_II_WITH_MPI
+      , request(other.request)
+#endif
+    {
+      // moving a std::vector keeps its memory, so the reduction in flight
+      // can continue to write into it
+#ifdef DEAL_II_WITH_MPI
+      other.request = MPI_REQUEST_NULL;
+#endif
+    }
+
+
+
+    template <typename T>
+    ReductionFuture<T> &
+    ReductionFuture<T>::operator=(ReductionFuture<T> &&other)
+    {
+      if (this != &other)
+        {
+          wait();
+          values = std::move(other.values);
+#ifdef DEAL_II_WITH_MPI
+          request       = other.request;
+          other.request = MPI_REQUEST_NULL;
+#endif
+        }
+      return *this;
+    }
+
+
+
+    template <typename T>
+    ReductionFuture<T>::~ReductionFuture()
+    {
+#ifdef DEAL_II_WITH_MPI
+      // do not throw from the destructor; a failure shows up in the MPI
+      // library anyway
+      if (request != MPI_REQUEST_NULL)
+        MPI_Wait(&request, MPI_STATUS_IGNORE);
+#endif
+    }
+
+
+
+    template <typename T>
+    bool
+    ReductionFuture<T>::is_ready()
+    {
+#ifdef DEAL_II_WITH_MPI
+      if (request != MPI_REQUEST_NULL)
+        {
+          int       flag = 0;
+          const int ierr = MPI_Test(&request, &flag, MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+          return flag != 0;
+        }
+#endif
+      return true;
+    }
+
+
+
+    template <typename T>
+    void
+    ReductionFuture<T>::wait()
+    {
+#ifdef DEAL_II_WITH_MPI
+      if (request != MPI_REQUEST_NULL)
+        {
+          const int ierr = MPI_Wait(&request, MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+#endif
+    }
+
+
+
+    template <typename T>
+    const T &
+    ReductionFuture<T>::get(const unsigned int index)
+    {
+      AssertIndexRange(index, values.size());
+      wait();
+      return values[index];
+    }
+
+
+
+    template <typename T>
+    ArrayView<const T>
+    ReductionFuture<T>::get_all()
+    {
+      wait();
+      return ArrayView<const T>(values.data(), values.size());
+    }
+
+
+
+    template <typename T>
+    unsigned int
+    ReductionFuture<T>::size() const
+    {
+      return values.size();
+    }
+
+
+
+    template <typename T>
+    ReductionFuture<T>
+    isum(const T &t, const MPI_Comm &mpi_communicator)
+    {
+      return ReductionFuture<T>(MPI_SUM,
+                                ArrayView<const T>(&t, 1),
+                                mpi_communicator);
+    }
+
+
+
+    template <typename T>
+    ReductionFuture<T>
+    isum(const ArrayView<const T> &values, const MPI_Comm &mpi_communicator)
+    {
+      return ReductionFuture<T>(MPI_SUM, values, mpi_communicator);
+    }
+
+
+
+    template <typename T>
+    ReductionFuture<T>
+    imax(const T &t, const MPI_Comm &mpi_communicator)
+    {
+      return ReductionFuture<T>(MPI_MAX,
+                                ArrayView<const T>(&t, 1),
+                                mpi_communicator);
+    }
+
+
+
+    template <typename T>
+    ReductionFuture<T>
+    imax(const ArrayView<const T> &values, const MPI_Comm &mpi_communicator)
+    {
+      return ReductionFuture<T>(MPI_MAX, values, mpi_communicator);
+    }
+
+
+
+    template <typename T>
+    ReductionFuture<T>
+    imin(const T &t, const MPI_Comm &mpi_communicator)
+    {
+      return ReductionFuture<T>(MPI_MIN,
+                                ArrayView<const T>(&t, 1),
+                                mpi_communicator);
+    }
+
+
+
+    template <typename T>
+    ReductionFuture<T>
+    imin(const ArrayView<const T> &values, const MPI_Comm &mpi_communicator)
+    {
+      return ReductionFuture<T>(MPI_MIN, values, mpi_communicator);
+    }
   } // end of namespace MPI
 } // end of namespace Utilities
 
@@ -0,0 +1,403 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_mpi_remote_point_evaluation_h
+#define dealii_mpi_remote_point_evaluation_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/template_constraints.h>
+
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Utilities
+{
+  namespace MPI
+  {
+    /**
+     * A class for the repeated evaluation of quantities at a fixed set of
+     * points that are distributed arbitrarily among the processes of a
+     * parallel triangulation, e.g., the locations of probes that monitor a
+     * solution in every time step. Each process provides its own list of
+     * points in reinit(), which locates the points on the processes owning
+     * the surrounding cells with
+     * GridTools::distributed_compute_point_locations() and sets up the
+     * communication pattern. Each subsequent call to
+     * evaluate_and_process() only evaluates the quantity at the points on
+     * the owning processes and sends the values back to the processes that
+     * asked for them, without repeating the search.
+     *
+     * The evaluation itself is done by a user function that receives the
+     * reference locations of all points found in the locally owned cells,
+     * grouped by cells as described in CellData, and fills the values in the
+     * given order, for instance with FEPointEvaluation:
+     * @code
+     * std::vector<double> values, buffer;
+     * remote_evaluation.evaluate_and_process(
+     *   values,
+     *   buffer,
+     *   [&](const ArrayView<double> &                       values,
+     *       const Utilities::MPI::RemotePointEvaluation<dim>::CellData
+     *         &cell_data) {
+     *     std::vector<double> local_values(fe.dofs_per_cell);
+     *     for (unsigned int i = 0; i < cell_data.cells.size(); ++i)
+     *       {
+     *         typename DoFHandler<dim>::active_cell_iterator cell(
+     *           &tria,
+     *           cell_data.cells[i].first,
+     *           cell_data.cells[i].second,
+     *           &dof_handler);
+     *         const ArrayView<const Point<dim>> unit_points(
+     *           cell_data.reference_point_values.data() +
+     *             cell_data.reference_point_ptrs[i],
+     *           cell_data.reference_point_ptrs[i + 1] -
+     *             cell_data.reference_point_ptrs[i]);
+     *
+     *         cell->get_dof_values(solution,
+     *                              local_values.begin(),
+     *                              local_values.end());
+     *         evaluator.reinit(cell, unit_points);
+     *         evaluator.evaluate(local_values, true, false);
+     *         for (unsigned int q = 0; q < unit_points.size(); ++q)
+     *           values[cell_data.reference_point_ptrs[i] + q] =
+     *             evaluator.get_value(q);
+     *       }
+     *   });
+     * @endcode
+     *
+     * A point that lies on the interface between the subdomains of several
+     * processes might be found by each of them. In that case, all values
+     * are returned, and get_point_ptrs() gives the range of values that
+     * belong to each point.
+     */
+    template <int dim, int spacedim = dim>
+    class RemotePointEvaluation
+    {
+    public:
+      /**
+       * The points found in the locally owned cells, grouped by cells.
+       */
+      struct CellData
+      {
+        /**
+         * The level and index of the cells, which can be used to construct
+         * a cell iterator of the triangulation or of a DoFHandler.
+         */
+        std::vector<std::pair<int, int>> cells;
+
+        /**
+         * The points of the cell with number @p i are stored in the range
+         * from <code>reference_point_ptrs[i]</code> to
+         * <code>reference_point_ptrs[i+1]</code> of reference_point_values.
+         * The values are expected in the same order.
+         */
+        std::vector<unsigned int> reference_point_ptrs;
+
+        /**
+         * The locations of the points in the coordinates of the reference
+         * cell.
+         */
+        std::vector<Point<dim>> reference_point_values;
+      };
+
+      /**
+       * Constructor. The object is unusable until reinit() is called.
+       */
+      RemotePointEvaluation();
+
+      /**
+       * Locate the points @p points of this process on the triangulation
+       * @p tria with the mapping @p mapping and set up the communication
+       * pattern. For a parallel::Triangulation, this is a collective
+       * operation on its communicator.
+       */
+      void
+      reinit(const std::vector<Point<spacedim>> &points,
+             const Triangulation<dim, spacedim> &tria,
+             const Mapping<dim, spacedim> &      mapping);
+
+      /**
+       * Evaluate a quantity at the points passed to reinit() by calling
+       * @p evaluation_function on the points found in the locally owned
+       * cells, and send the values back to the processes that requested
+       * them. On return, @p output holds the values of the points of this
+       * process, in the order given by get_point_ptrs(). The vector
+       * @p buffer holds the intermediate results of the evaluation and the
+       * transfer. Both vectors are only resized if necessary, so the values
+       * are written directly into the memory of @p output without any
+       * allocation if the same vectors are passed to subsequent calls.
+       *
+       * The type @p T must be trivially copyable, as the values are
+       * transferred as raw bytes.
+       */
+      template <typename T>
+      void
+      evaluate_and_process(
+        std::vector<T> &output,
+        std::vector<T> &buffer,
+        const typename identity<
+          std::function<void(const ArrayView<T> &, const CellData &)>>::type
+          &evaluation_function) const;
+
+      /**
+       * Same as above, but allocate and return the output.
+       */
+      template <typename T>
+      std::vector<T>
+      evaluate_and_process(
+        const typename identity<
+          std::function<void(const ArrayView<T> &, const CellData &)>>::type
+          &evaluation_function) const;
+
+      /**
+       * Return the pointers into the output of evaluate_and_process(): the
+       * values of the point with index @p i are stored in the range from
+       * <code>get_point_ptrs()[i]</code> to <code>get_point_ptrs()[i+1]</code>.
+       */
+      const std::vector<unsigned int> &
+      get_point_ptrs() const;
+
+      /**
+       * Return whether each point of this process has been found on exactly
+       * one process, in which case the output of evaluate_and_process()
+       * holds one value per point in the order of the points.
+       */
+      bool
+      is_map_unique() const;
+
+      /**
+       * Return whether each point of this process has been found on at
+       * least one process.
+       */
+      bool
+      all_points_found() const;
+
+      /**
+       * Return the triangulation passed to reinit().
+       */
+      const Triangulation<dim, spacedim> &
+      get_triangulation() const;
+
+      /**
+       * Return the mapping passed to reinit().
+       */
+      const Mapping<dim, spacedim> &
+      get_mapping() const;
+
+    private:
+      /**
+       * The communicator of the triangulation.
+       */
+      MPI_Comm communicator;
+
+      /**
+       * The triangulation passed to reinit().
+       */
+      SmartPointer<const Triangulation<dim, spacedim>> tria;
+
+      /**
+       * The mapping passed to reinit().
+       */
+      SmartPointer<const Mapping<dim, spacedim>> mapping;
+
+      /**
+       * The points to evaluate on this process.
+       */
+      CellData cell_data;
+
+      /**
+       * Pointers into the output for each point of this process.
+       */
+      std::vector<unsigned int> point_ptrs;
+
+      /**
+       * Whether each point of this process has been found exactly once.
+       */
+      bool unique_mapping;
+
+      /**
+       * Whether each point of this process has been found at least once.
+       */
+      bool all_found;
+
+      /**
+       * The ranks the evaluated values are sent to, including this process.
+       */
+      std::vector<unsigned int> send_ranks;
+
+      /**
+       * The values for the rank <code>send_ranks[i]</code> are stored in the
+       * range from <code>send_ptrs[i]</code> to <code>send_ptrs[i+1]</code>
+       * of the send buffer.
+       */
+      std::vector<unsigned int> send_ptrs;
+
+      /**
+       * The position in the evaluation order of each entry of the send
+       * buffer.
+       */
+      std::vector<unsigned int> send_permutation;
+
+      /**
+       * The ranks values are received from, including this process.
+       */
+      std::vector<unsigned int> recv_ranks;
+
+      /**
+       * The values from the rank <code>recv_ranks[i]</code> are stored in
+       * the range from <code>recv_ptrs[i]</code> to <code>recv_ptrs[i+1]</code>
+       * of the receive buffer.
+       */
+      std::vector<unsigned int> recv_ptrs;
+
+      /**
+       * The position in the output of each entry of the receive buffer.
+       */
+      std::vector<unsigned int> recv_permutation;
+    };
+
+
+
+    template <int dim, int spacedim>
+    template <typename T>
+    void
+    RemotePointEvaluation<dim, spacedim>::evaluate_and_process(
+      std::vector<T> &output,
+      std::vector<T> &buffer,
+      const typename identity<
+        std::function<void(const ArrayView<T> &, const CellData &)>>::type
+        &evaluation_function) const
+    {
+      static_assert(std::is_trivially_copyable<T>::value,
+                    "The values must be trivially copyable.");
+      Assert(tria != nullptr, ExcMessage("reinit() has not been called."));
+
+      const unsigned int n_evaluation_points = send_permutation.size();
+      const unsigned int my_rank = this_mpi_process(communicator);
+
+      // The buffer holds the evaluated values in the order of the cells,
+      // then the same values sorted by destination rank, and finally the
+      // received values
+      output.resize(point_ptrs.back());
+      buffer.resize(2 * n_evaluation_points + recv_permutation.size());
+      T *const evaluation_values = buffer.data();
+      T *const send_values       = evaluation_values + n_evaluation_points;
+      T *const recv_values       = send_values + n_evaluation_points;
+
+      evaluation_function(ArrayView<T>(evaluation_values, n_evaluation_points),
+                          cell_data);
+
+      for (unsigned int i = 0; i < n_evaluation_points; ++i)
+        send_values[i] = evaluation_values[send_permutation[i]];
+
+#ifdef DEAL_II_WITH_MPI
+      const int                mpi_tag = 109;
+      std::vector<MPI_Request> requests;
+      requests.reserve(send_ranks.size() + recv_ranks.size());
+      for (unsigned int i = 0; i < recv_ranks.size(); ++i)
+        if (recv_ranks[i] != my_rank)
+          {
+            requests.emplace_back();
+            const int ierr =
+              MPI_Irecv(recv_values + recv_ptrs[i],
+                        (recv_ptrs[i + 1] - recv_ptrs[i]) * sizeof(T),
+                        MPI_BYTE,
+                        recv_ranks[i],
+                        mpi_tag,
+                        communicator,
+                        &requests.back());
+            AssertThrowMPI(ierr);
+          }
+      for (unsigned int i = 0; i < send_ranks.size(); ++i)
+        if (send_ranks[i] != my_rank)
+          {
+            requests.emplace_back();
+            const int ierr =
+              MPI_Isend(send_values + send_ptrs[i],
+                        (send_ptrs[i + 1] - send_ptrs[i]) * sizeof(T),
+                        MPI_BYTE,
+                        send_ranks[i],
+                        mpi_tag,
+                        communicator,
+                        &requests.back());
+            AssertThrowMPI(ierr);
+          }
+#endif
+
+      // The values of the points of this process found locally do not need
+      // to be communicated
+      for (unsigned int i = 0; i < send_ranks.size(); ++i)
+        if (send_ranks[i] == my_rank)
+          for (unsigned int j = 0; j < recv_ranks.size(); ++j)
+            if (recv_ranks[j] == my_rank)
+              {
+                AssertDimension(send_ptrs[i + 1] - send_ptrs[i],
+                                recv_ptrs[j + 1] - recv_ptrs[j]);
+                for (unsigned int k = 0; k < send_ptrs[i + 1] - send_ptrs[i];
+                     ++k)
+                  output[recv_permutation[recv_ptrs[j] + k]] =
+                    send_values[send_ptrs[i] + k];
+              }
+
+#ifdef DEAL_II_WITH_MPI
+      if (!requests.empty())
+        {
+          const int ierr = MPI_Waitall(requests.size(),
+                                       requests.data(),
+                                       MPI_STATUSES_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+#endif
+
+      for (unsigned int i = 0; i < recv_ranks.size(); ++i)
+        if (recv_ranks[i] != my_rank)
+          for (unsigned int k = recv_ptrs[i]; k < recv_ptrs[i + 1]; ++k)
+            output[recv_permutation[k]] = recv_values[k];
+    }
+
+
+
+    template <int dim, int spacedim>
+    template <typename T>
+    std::vector<T>
+    RemotePointEvaluation<dim, spacedim>::evaluate_and_process(
+      const typename identity<
+        std::function<void(const ArrayView<T> &, const CellData &)>>::type
+        &evaluation_function) const
+    {
+      std::vector<T> output, buffer;
+      evaluate_and_process(output, buffer, evaluation_function);
+      return output;
+    }
+  } // namespace MPI
+} // namespace Utilities
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
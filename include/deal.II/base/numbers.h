@@ -83,6 +83,9 @@ namespace internal
     constexpr static unsigned int max_width =
 #if DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__ALTIVEC__)
       2;
+#elif DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__ARM_NEON) && \
+  defined(__aarch64__)
+      2;
 #elif DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 3 && defined(__AVX512F__)
       8;
 #elif DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 2 && defined(__AVX__)
@@ -111,6 +114,9 @@ namespace internal
     constexpr static unsigned int max_width =
 #if DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__ALTIVEC__)
       4;
+#elif DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__ARM_NEON) && \
+  defined(__aarch64__)
+      4;
 #elif DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 3 && defined(__AVX512F__)
       16;
 #elif DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 2 && defined(__AVX__)
@@ -20,6 +20,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/patterns.h>
 #include <deal.II/base/subscriptor.h>
 
@@ -31,6 +32,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -999,6 +1001,25 @@ public:
               const std::string &last_line      = "",
               const bool         skip_undefined = false);
 
+  /**
+   * Same as the previous function, but only the process with rank zero in
+   * @p mpi_communicator reads the file. Its content is then broadcast to all
+   * other processes, which parse it from memory. This avoids that all
+   * processes of a large parallel computation access the file system at the
+   * same time. Files named in <tt>include</tt> statements are still read by
+   * every process.
+   *
+   * If the file can not be found, all processes throw an exception of type
+   * PathSearch::ExcFileNotFound.
+   *
+   * This function must be called on all processes of @p mpi_communicator.
+   */
+  void
+  parse_input(const std::string &filename,
+              const MPI_Comm &   mpi_communicator,
+              const std::string &last_line      = "",
+              const bool         skip_undefined = false);
+
   /**
    * Parse input from a string to populate known parameter fields. The lines
    * in the string must be separated by <tt>@\n</tt> characters.
@@ -1624,6 +1645,17 @@ private:
    */
   std::unique_ptr<boost::property_tree::ptree> entries;
 
+  /**
+   * A map from the full path of each declared entry, as returned by
+   * get_current_full_path(), to the node in #entries that stores its value.
+   * This allows get() to find a value by a single hash lookup rather than by
+   * walking the property tree along the path. The nodes of a property tree
+   * do not move when other nodes are added, so these pointers stay valid
+   * until clear() is called.
+   */
+  std::unordered_map<std::string, const boost::property_tree::ptree *>
+    value_nodes;
+
   /**
    * A list of patterns that are used to describe the parameters of this
    * object. Every nodes in the property tree corresponding to a parameter
@@ -2170,6 +2202,9 @@ ParameterHandler::load(Archive &ar, const unsigned int)
   ar &static_cast<Subscriptor &>(*this);
 
   ar &*entries.get();
+  // the nodes of the tree have been replaced, so the pointers into it are no
+  // longer valid. get() falls back to searching the tree
+  value_nodes.clear();
 
   std::vector<std::string> descriptions;
   ar &                     descriptions;
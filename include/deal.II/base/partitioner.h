@@ -23,6 +23,7 @@
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/memory_space.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/thread_management.h>
 #include <deal.II/base/types.h>
 #include <deal.II/base/utilities.h>
 
@@ -30,7 +31,11 @@
 #include <deal.II/lac/vector.h>
 #include <deal.II/lac/vector_operation.h>
 
+#include <functional>
 #include <limits>
+#include <map>
+#include <memory>
+#include <tuple>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -159,6 +164,28 @@ namespace Utilities
       Partitioner(const IndexSet &locally_owned_indices,
                   const MPI_Comm  communicator_in);
 
+      /**
+       * Destructor. Frees the persistent MPI requests set up by the data
+       * exchange functions.
+       */
+      virtual ~Partitioner() override;
+
+      /**
+       * Copy constructor. This constructor is deleted since the persistent
+       * MPI requests cached by this class can not be shared between two
+       * objects, and each of them would free the requests on destruction.
+       * Partitioner objects are meant to be shared through a std::shared_ptr
+       * instead.
+       */
+      Partitioner(const Partitioner &) = delete;
+
+      /**
+       * Copy operator. This operator is deleted for the same reason as the
+       * copy constructor.
+       */
+      Partitioner &
+      operator=(const Partitioner &) = delete;
+
       /**
        * Reinitialize the communication pattern. The first argument @p
        * vector_space_vector_index_set is the index set associated to a
@@ -191,6 +218,29 @@ namespace Utilities
       set_ghost_indices(const IndexSet &ghost_indices,
                         const IndexSet &larger_ghost_index_set = IndexSet());
 
+      /**
+       * Return a partitioner with the given locally owned indices, ghost
+       * indices, and communicator, set up as by the constructor followed by
+       * set_ghost_indices(). If a partitioner with the same layout has been
+       * created by this function before and is still in use somewhere, that
+       * object is returned instead of a new one. This avoids repeating the
+       * global communication of the setup and storing the same communication
+       * pattern several times, e.g., when several MatrixFree objects are
+       * built on the same DoFHandler.
+       *
+       * This function must be called by all processors of @p communicator,
+       * since they need to agree on whether an existing partitioner can be
+       * reused. An existing partitioner is only returned if all processors
+       * find the same one, i.e., one that was created by the same call on
+       * all of them, since its import indices depend on the ghost indices
+       * all processors had at that time.
+       */
+      static std::shared_ptr<const Partitioner>
+      create_shared(const IndexSet &locally_owned_indices,
+                    const IndexSet &ghost_indices,
+                    const MPI_Comm  communicator,
+                    const IndexSet &larger_ghost_index_set = IndexSet());
+
       /**
        * Return the global size.
        */
@@ -417,6 +467,16 @@ namespace Utilities
        * communication that will be finalized in the
        * export_to_ghosted_array_finish() call.
        *
+       * @param shared_arrays If non-empty, the arrays of all processes in
+       * the shared-memory communicator given to
+       * initialize_shared_memory_exchange(), indexed by the rank within that
+       * communicator. Each array holds the locally owned entries of the
+       * respective process followed by its ghost entries. The data of the
+       * processes on the same node is then not sent through MPI but read
+       * directly from these arrays in export_to_ghosted_array_finish(), and
+       * the locally owned array must not be modified until that call has
+       * returned. All processes must either pass or not pass these arrays.
+       *
        * This functionality is used in
        * LinearAlgebra::distributed::Vector::update_ghost_values().
        */
@@ -427,7 +487,9 @@ namespace Utilities
         const ArrayView<const Number, MemorySpaceType> &locally_owned_array,
         const ArrayView<Number, MemorySpaceType> &      temporary_storage,
         const ArrayView<Number, MemorySpaceType> &      ghost_array,
-        std::vector<MPI_Request> &                      requests) const;
+        std::vector<MPI_Request> &                      requests,
+        const std::vector<ArrayView<const Number, MemorySpaceType>>
+          &shared_arrays = {}) const;
 
       /**
        * Finish the exports of the data in a locally owned array to the range
@@ -443,6 +505,9 @@ namespace Utilities
        * export_to_ghosted_array_start() call. This must be the same array as
        * passed to that function, otherwise MPI will likely throw an error.
        *
+       * @param shared_arrays The same arrays as passed to
+       * export_to_ghosted_array_start().
+       *
        * This functionality is used in
        * LinearAlgebra::distributed::Vector::update_ghost_values().
        */
@@ -450,7 +515,55 @@ namespace Utilities
       void
       export_to_ghosted_array_finish(
         const ArrayView<Number, MemorySpaceType> &ghost_array,
-        std::vector<MPI_Request> &                requests) const;
+        std::vector<MPI_Request> &                requests,
+        const std::vector<ArrayView<const Number, MemorySpaceType>>
+          &shared_arrays = {}) const;
+
+      /**
+       * Copy the entries of @p locally_owned_array, which lives on the
+       * device, that are sent to other processes by
+       * export_to_ghosted_array_start() to the same positions of
+       * @p locally_owned_array_host. The entries are first gathered on the
+       * device into @p temporary_storage, and only these are transferred to
+       * the host through @p temporary_storage_host. Both temporary arrays
+       * must have n_import_indices() entries.
+       *
+       * This is used by LinearAlgebra::distributed::Vector with
+       * MemorySpace::CUDA when MPI is not CUDA-aware: The exchange then runs
+       * on the host with export_to_ghosted_array_start(), which only reads
+       * the positions of @p locally_owned_array_host set by this function,
+       * such that the whole vector does not need to be copied to the host.
+       */
+      template <typename Number>
+      void
+      copy_import_entries_to_host(
+        const ArrayView<const Number, MemorySpace::CUDA> &locally_owned_array,
+        const ArrayView<Number, MemorySpace::CUDA> &      temporary_storage,
+        const ArrayView<Number, MemorySpace::Host> &temporary_storage_host,
+        const ArrayView<Number, MemorySpace::Host> &locally_owned_array_host)
+        const;
+
+      /**
+       * Wait until the data of one more process has arrived in an export
+       * started with export_to_ghosted_array_start() and return the index of
+       * that process within ghost_targets(). Once the data of all processes
+       * has arrived, numbers::invalid_unsigned_int is returned. This allows
+       * to work on the ghost entries of some processes while the data of
+       * other processes is still in flight. The exchange must still be
+       * completed with export_to_ghosted_array_finish().
+       *
+       * The data is only in its final position if the ghost array passed to
+       * export_to_ghosted_array_start() holds exactly n_ghost_indices()
+       * entries (or the ghost indices are not a subset of a larger set), and
+       * the exchange does not use shared arrays; the latter is not supported
+       * by this function.
+       *
+       * @param requests The list of MPI requests of the ongoing exchange as
+       * passed to export_to_ghosted_array_start().
+       */
+      unsigned int
+      export_to_ghosted_array_wait_any(
+        std::vector<MPI_Request> &requests) const;
 
       /**
        * Start importing the data on an array indexed by the ghost indices of
@@ -485,6 +598,11 @@ namespace Utilities
        * communication that will be finalized in the
        * export_to_ghosted_array_finish() call.
        *
+       * @param shared_arrays If non-empty, the arrays of all processes in
+       * the shared-memory communicator, see export_to_ghosted_array_start().
+       * The owners on the same node then read the ghost data directly from
+       * @p ghost_array in import_from_ghosted_array_finish().
+       *
        * This functionality is used in
        * LinearAlgebra::distributed::Vector::compress().
        */
@@ -495,7 +613,9 @@ namespace Utilities
         const unsigned int                        communication_channel,
         const ArrayView<Number, MemorySpaceType> &ghost_array,
         const ArrayView<Number, MemorySpaceType> &temporary_storage,
-        std::vector<MPI_Request> &                requests) const;
+        std::vector<MPI_Request> &                requests,
+        const std::vector<ArrayView<const Number, MemorySpaceType>>
+          &shared_arrays = {}) const;
 
       /**
        * Finish importing the data from an array indexed by the ghost
@@ -528,6 +648,9 @@ namespace Utilities
        * import_to_ghosted_array_finish() call. This must be the same array as
        * passed to that function, otherwise MPI will likely throw an error.
        *
+       * @param shared_arrays The same arrays as passed to
+       * import_from_ghosted_array_start().
+       *
        * This functionality is used in
        * LinearAlgebra::distributed::Vector::compress().
        */
@@ -538,7 +661,34 @@ namespace Utilities
         const ArrayView<const Number, MemorySpaceType> &temporary_storage,
         const ArrayView<Number, MemorySpaceType> &      locally_owned_storage,
         const ArrayView<Number, MemorySpaceType> &      ghost_array,
-        std::vector<MPI_Request> &                      requests) const;
+        std::vector<MPI_Request> &                      requests,
+        const std::vector<ArrayView<const Number, MemorySpaceType>>
+          &shared_arrays = {}) const;
+
+      /**
+       * Set up the data structures for a data exchange where the processes
+       * that share memory with the calling process, as given by the
+       * sub-communicator @p communicator_sm of the communicator of this
+       * class (e.g. obtained from MPI_Comm_split_type() with
+       * MPI_COMM_TYPE_SHARED), access each other's arrays directly instead
+       * of sending through MPI. This is a collective operation on @p
+       * communicator_sm that needs to be called before passing
+       * `shared_arrays` to the functions above. Calls with the same
+       * communicator as before return immediately.
+       */
+      void
+      initialize_shared_memory_exchange(const MPI_Comm &communicator_sm) const;
+
+      /**
+       * Release the MPI requests of a data exchange started by
+       * export_to_ghosted_array_start() or import_from_ghosted_array_start()
+       * that is not going to be finished, e.g. because the owning vector is
+       * destroyed. Persistent requests that are kept by this class for reuse
+       * are removed from the cache and freed, and all other requests are
+       * freed with MPI_Request_free(). On exit, @p requests is empty.
+       */
+      void
+      free_requests(std::vector<MPI_Request> &requests) const;
 #endif
 
       /**
@@ -578,6 +728,35 @@ namespace Utilities
       void
       initialize_import_indices_plain_dev() const;
 
+#ifdef DEAL_II_WITH_MPI
+      /**
+       * Fill @p requests with the persistent MPI requests for a data
+       * exchange from @p send_buffer into @p receive_buffer on the given
+       * channel, with entries of @p bytes_per_entry bytes. On first use of a
+       * combination of these arguments, the requests are created by @p
+       * setup_requests with MPI_Send_init() and MPI_Recv_init() and stored
+       * for later calls. The size of @p requests on entry determines the
+       * number of requests. If the cache is full, nothing is done and the
+       * function returns `false`, in which case the caller should use
+       * non-persistent communication.
+       */
+      bool
+      get_persistent_requests(
+        const void *                                         receive_buffer,
+        const void *                                         send_buffer,
+        const unsigned int                                   channel,
+        const unsigned int                                   bytes_per_entry,
+        const std::function<void(std::vector<MPI_Request> &)> &setup_requests,
+        std::vector<MPI_Request> &                           requests) const;
+
+      /**
+       * Free all persistent MPI requests and clear the cache. Called
+       * whenever the communication pattern changes.
+       */
+      void
+      free_persistent_requests();
+#endif
+
       /**
        * The global size of the vector over all processors
        */
@@ -692,6 +871,77 @@ namespace Utilities
        * A variable storing whether the ghost indices have been explicitly set.
        */
       bool have_ghost_indices;
+
+#ifdef DEAL_II_WITH_MPI
+      /**
+       * The persistent MPI requests used by export_to_ghosted_array_start()
+       * and import_from_ghosted_array_start(), set up on first use. The key
+       * consists of the addresses of the receive and send buffers, the
+       * communication channel and the size of an entry in bytes, which
+       * together determine the arguments to MPI_Recv_init() and
+       * MPI_Send_init().
+       */
+      mutable std::map<
+        std::tuple<const void *, const void *, unsigned int, unsigned int>,
+        std::vector<MPI_Request>>
+        persistent_requests;
+
+      /**
+       * A mutex to guard the access to @p persistent_requests from several
+       * threads.
+       */
+      mutable Threads::Mutex persistent_requests_mutex;
+
+      /**
+       * The shared-memory communicator given to
+       * initialize_shared_memory_exchange().
+       */
+      mutable MPI_Comm communicator_sm;
+
+      /**
+       * The rank of each entry in @p ghost_targets_data within @p
+       * communicator_sm, or numbers::invalid_unsigned_int if the process
+       * does not share memory with the calling process.
+       */
+      mutable std::vector<unsigned int> ghost_targets_sm_rank;
+
+      /**
+       * For the ghost targets that share memory with the calling process,
+       * the ranges of entries in the locally owned array of the owner that
+       * make up the ghost data of the calling process, numbered in the
+       * local index space of the owner. The ranges of ghost target @p i are
+       * given by the entries @p ghost_indices_sm_ranges_by_target[i] to @p
+       * ghost_indices_sm_ranges_by_target[i+1].
+       */
+      mutable std::vector<std::pair<unsigned int, unsigned int>>
+        ghost_indices_sm_ranges;
+
+      /**
+       * Start of the ranges of each ghost target in @p
+       * ghost_indices_sm_ranges.
+       */
+      mutable std::vector<unsigned int> ghost_indices_sm_ranges_by_target;
+
+      /**
+       * The rank of each entry in @p import_targets_data within @p
+       * communicator_sm, or numbers::invalid_unsigned_int if the process
+       * does not share memory with the calling process.
+       */
+      mutable std::vector<unsigned int> import_targets_sm_rank;
+
+      /**
+       * For the import targets that share memory with the calling process,
+       * the position in the array of that process where the ghost data
+       * on the entries owned by the calling process starts.
+       */
+      mutable std::vector<unsigned int> import_targets_sm_offset;
+#endif
+
+      /**
+       * A variable storing whether initialize_shared_memory_exchange() has
+       * been called since the last change of the index sets.
+       */
+      mutable bool shared_memory_exchange_is_initialized;
     };
 
 
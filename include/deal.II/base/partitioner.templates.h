@@ -20,10 +20,12 @@
 
 #include <deal.II/base/cuda_size.h>
 #include <deal.II/base/partitioner.h>
+#include <deal.II/base/tracing.h>
 
 #include <deal.II/lac/cuda_kernels.templates.h>
 #include <deal.II/lac/la_parallel_vector.h>
 
+#include <algorithm>
 #include <type_traits>
 
 
@@ -44,8 +46,12 @@ namespace Utilities
       const ArrayView<const Number, MemorySpaceType> &locally_owned_array,
       const ArrayView<Number, MemorySpaceType> &      temporary_storage,
       const ArrayView<Number, MemorySpaceType> &      ghost_array,
-      std::vector<MPI_Request> &                      requests) const
+      std::vector<MPI_Request> &                      requests,
+      const std::vector<ArrayView<const Number, MemorySpaceType>>
+        &shared_arrays) const
     {
+      Tracing::Scope trace("Partitioner::export_to_ghosted_array_start");
+
       AssertDimension(temporary_storage.size(), n_import_indices());
       Assert(ghost_array.size() == n_ghost_indices() ||
                ghost_array.size() == n_ghost_indices_in_larger_set,
@@ -63,10 +69,38 @@ namespace Utilities
              ExcMessage("Another operation seems to still be running. "
                         "Call update_ghost_values_finish() first."));
 
+      const bool use_shared_memory = shared_arrays.size() > 0;
+      Assert(!use_shared_memory || shared_memory_exchange_is_initialized,
+             ExcMessage("Call initialize_shared_memory_exchange() before "
+                        "passing shared arrays."));
+      Assert(!use_shared_memory ||
+               (std::is_same<MemorySpaceType, MemorySpace::Host>::value),
+             ExcNotImplemented());
+      const unsigned int n_shared_import_targets =
+        use_shared_memory ?
+          std::count_if(import_targets_sm_rank.begin(),
+                        import_targets_sm_rank.end(),
+                        [](const unsigned int rank) {
+                          return rank != numbers::invalid_unsigned_int;
+                        }) :
+          0;
+      const unsigned int n_shared_ghost_targets =
+        use_shared_memory ?
+          std::count_if(ghost_targets_sm_rank.begin(),
+                        ghost_targets_sm_rank.end(),
+                        [](const unsigned int rank) {
+                          return rank != numbers::invalid_unsigned_int;
+                        }) :
+          0;
+
       // Need to send and receive the data. Use non-blocking communication,
       // where it is usually less overhead to first initiate the receive and
-      // then actually send the data
-      requests.resize(n_import_targets + n_ghost_targets);
+      // then actually send the data. For the processes on the same node, we
+      // only exchange zero-byte messages to signal that the data is ready
+      // to be read in export_to_ghosted_array_finish(), plus another set of
+      // messages that signal that the reading is done.
+      requests.resize(n_import_targets + n_ghost_targets +
+                      n_shared_import_targets + n_shared_ghost_targets);
 
       // as a ghost array pointer, put the data at the end of the given ghost
       // array in case we want to fill only a subset of the ghosts so that we
@@ -81,18 +115,69 @@ namespace Utilities
                            n_ghost_indices() :
                          ghost_array.data();
 
+      // The same vector typically exchanges its data many times with the
+      // same buffers, so we set up persistent requests on first use and only
+      // start them afterwards
+      const auto setup_persistent_requests =
+        [&](std::vector<MPI_Request> &persistent) {
+          Number *recv_ptr = ghost_array_ptr;
+          for (unsigned int i = 0; i < n_ghost_targets; i++)
+            {
+              const int ierr =
+                MPI_Recv_init(recv_ptr,
+                              ghost_targets_data[i].second * sizeof(Number),
+                              MPI_BYTE,
+                              ghost_targets_data[i].first,
+                              ghost_targets_data[i].first +
+                                communication_channel,
+                              communicator,
+                              &persistent[i]);
+              AssertThrowMPI(ierr);
+              recv_ptr += ghost_targets_data[i].second;
+            }
+          Number *send_ptr = temporary_storage.data();
+          for (unsigned int i = 0; i < n_import_targets; i++)
+            {
+              const int ierr =
+                MPI_Send_init(send_ptr,
+                              import_targets_data[i].second * sizeof(Number),
+                              MPI_BYTE,
+                              import_targets_data[i].first,
+                              my_pid + communication_channel,
+                              communicator,
+                              &persistent[n_ghost_targets + i]);
+              AssertThrowMPI(ierr);
+              send_ptr += import_targets_data[i].second;
+            }
+        };
+      const bool use_persistent_requests =
+        !use_shared_memory && requests.size() > 0 &&
+        get_persistent_requests(ghost_array_ptr,
+                                temporary_storage.data(),
+                                communication_channel,
+                                sizeof(Number),
+                                setup_persistent_requests,
+                                requests);
+
       for (unsigned int i = 0; i < n_ghost_targets; i++)
         {
+          const bool target_is_shared =
+            use_shared_memory &&
+            ghost_targets_sm_rank[i] != numbers::invalid_unsigned_int;
+
           // allow writing into ghost indices even though we are in a
           // const function
           const int ierr =
-            MPI_Irecv(ghost_array_ptr,
-                      ghost_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      ghost_targets_data[i].first,
-                      ghost_targets_data[i].first + communication_channel,
-                      communicator,
-                      &requests[i]);
+            use_persistent_requests ?
+              MPI_Start(&requests[i]) :
+              MPI_Irecv(ghost_array_ptr,
+                        (target_is_shared ? 0 : ghost_targets_data[i].second) *
+                          sizeof(Number),
+                        MPI_BYTE,
+                        ghost_targets_data[i].first,
+                        ghost_targets_data[i].first + communication_channel,
+                        communicator,
+                        &requests[i]);
           AssertThrowMPI(ierr);
           ghost_array_ptr += ghost_targets_data[i].second;
         }
@@ -112,6 +197,10 @@ namespace Utilities
 
       for (unsigned int i = 0; i < n_import_targets; i++)
         {
+          const bool target_is_shared =
+            use_shared_memory &&
+            import_targets_sm_rank[i] != numbers::invalid_unsigned_int;
+
 #    if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
       defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
           if (std::is_same<MemorySpaceType, MemorySpace::CUDA>::value)
@@ -129,6 +218,7 @@ namespace Utilities
             }
           else
 #    endif
+            if (!target_is_shared)
             {
               // copy the data to be sent to the import_data field
               std::vector<std::pair<unsigned int, unsigned int>>::const_iterator
@@ -154,16 +244,55 @@ namespace Utilities
 
           // start the send operations
           const int ierr =
-            MPI_Isend(temp_array_ptr,
-                      import_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      import_targets_data[i].first,
-                      my_pid + communication_channel,
-                      communicator,
-                      &requests[n_ghost_targets + i]);
+            use_persistent_requests ?
+              MPI_Start(&requests[n_ghost_targets + i]) :
+              MPI_Isend(temp_array_ptr,
+                        (target_is_shared ? 0 : import_targets_data[i].second) *
+                          sizeof(Number),
+                        MPI_BYTE,
+                        import_targets_data[i].first,
+                        my_pid + communication_channel,
+                        communicator,
+                        &requests[n_ghost_targets + i]);
           AssertThrowMPI(ierr);
           temp_array_ptr += import_targets_data[i].second;
         }
+
+      // the processes on the same node tell us when they have read our data,
+      // and we tell them the same in export_to_ghosted_array_finish(). The
+      // latter messages use persistent requests that are only started there
+      // because the finish function does not know the communication channel
+      if (use_shared_memory)
+        {
+          unsigned int k = n_ghost_targets + n_import_targets;
+          for (unsigned int i = 0; i < n_import_targets; i++)
+            if (import_targets_sm_rank[i] != numbers::invalid_unsigned_int)
+              {
+                const int ierr = MPI_Irecv(nullptr,
+                                           0,
+                                           MPI_BYTE,
+                                           import_targets_data[i].first,
+                                           import_targets_data[i].first +
+                                             communication_channel + 802,
+                                           communicator,
+                                           &requests[k++]);
+                AssertThrowMPI(ierr);
+              }
+          for (unsigned int i = 0; i < n_ghost_targets; i++)
+            if (ghost_targets_sm_rank[i] != numbers::invalid_unsigned_int)
+              {
+                const int ierr =
+                  MPI_Send_init(nullptr,
+                                0,
+                                MPI_BYTE,
+                                ghost_targets_data[i].first,
+                                my_pid + communication_channel + 802,
+                                communicator,
+                                &requests[k++]);
+                AssertThrowMPI(ierr);
+              }
+          AssertDimension(k, requests.size());
+        }
     }
 
 
@@ -172,8 +301,12 @@ namespace Utilities
     void
     Partitioner::export_to_ghosted_array_finish(
       const ArrayView<Number, MemorySpaceType> &ghost_array,
-      std::vector<MPI_Request> &                requests) const
+      std::vector<MPI_Request> &                requests,
+      const std::vector<ArrayView<const Number, MemorySpaceType>>
+        &shared_arrays) const
     {
+      Tracing::Scope trace("Partitioner::export_to_ghosted_array_finish");
+
       Assert(ghost_array.size() == n_ghost_indices() ||
                ghost_array.size() == n_ghost_indices_in_larger_set,
              ExcGhostIndexArrayHasWrongSize(ghost_array.size(),
@@ -182,14 +315,68 @@ namespace Utilities
 
       // wait for both sends and receives to complete, even though only
       // receives are really necessary. this gives (much) better performance
-      AssertDimension(ghost_targets().size() + import_targets().size(),
-                      requests.size());
-      if (requests.size() > 0)
+      const unsigned int n_exchange_requests =
+        ghost_targets().size() + import_targets().size();
+      Assert(shared_arrays.size() > 0 ||
+               n_exchange_requests == requests.size(),
+             ExcDimensionMismatch(n_exchange_requests, requests.size()));
+      AssertIndexRange(n_exchange_requests, requests.size() + 1);
+      if (n_exchange_requests > 0)
         {
-          const int ierr =
-            MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+          const int ierr = MPI_Waitall(n_exchange_requests,
+                                       requests.data(),
+                                       MPI_STATUSES_IGNORE);
           AssertThrowMPI(ierr);
         }
+
+      // read the data of the processes on the same node directly from their
+      // arrays, then tell them that we are done and wait until they have
+      // read our data
+      if (requests.size() > n_exchange_requests)
+        {
+          Number *ghost_array_ptr =
+            (n_ghost_indices_in_larger_set > n_ghost_indices() &&
+             ghost_array.size() == n_ghost_indices_in_larger_set) ?
+              ghost_array.data() + n_ghost_indices_in_larger_set -
+                n_ghost_indices() :
+              ghost_array.data();
+          unsigned int n_shared_ghost_targets = 0;
+          for (unsigned int i = 0; i < ghost_targets_data.size(); ++i)
+            {
+              const unsigned int rank_sm = ghost_targets_sm_rank[i];
+              if (rank_sm != numbers::invalid_unsigned_int)
+                {
+                  const Number *owned_array = shared_arrays[rank_sm].data();
+                  Number *      write_position = ghost_array_ptr;
+                  for (unsigned int r = ghost_indices_sm_ranges_by_target[i];
+                       r < ghost_indices_sm_ranges_by_target[i + 1];
+                       ++r)
+                    write_position =
+                      std::copy(owned_array + ghost_indices_sm_ranges[r].first,
+                                owned_array +
+                                  ghost_indices_sm_ranges[r].second,
+                                write_position);
+                  AssertDimension(write_position - ghost_array_ptr,
+                                  ghost_targets_data[i].second);
+                  ++n_shared_ghost_targets;
+                }
+              ghost_array_ptr += ghost_targets_data[i].second;
+            }
+
+          MPI_Request *done_requests =
+            requests.data() + requests.size() - n_shared_ghost_targets;
+          int ierr = MPI_Startall(n_shared_ghost_targets, done_requests);
+          AssertThrowMPI(ierr);
+          ierr = MPI_Waitall(requests.size() - n_exchange_requests,
+                             requests.data() + n_exchange_requests,
+                             MPI_STATUSES_IGNORE);
+          AssertThrowMPI(ierr);
+          for (unsigned int i = 0; i < n_shared_ghost_targets; ++i)
+            {
+              ierr = MPI_Request_free(done_requests + i);
+              AssertThrowMPI(ierr);
+            }
+        }
       requests.resize(0);
 
       // in case we only sent a subset of indices, we now need to move the data
@@ -260,8 +447,12 @@ namespace Utilities
       const unsigned int                        communication_channel,
       const ArrayView<Number, MemorySpaceType> &ghost_array,
       const ArrayView<Number, MemorySpaceType> &temporary_storage,
-      std::vector<MPI_Request> &                requests) const
+      std::vector<MPI_Request> &                requests,
+      const std::vector<ArrayView<const Number, MemorySpaceType>>
+        &shared_arrays) const
     {
+      Tracing::Scope trace("Partitioner::import_from_ghosted_array_start");
+
       AssertDimension(temporary_storage.size(), n_import_indices());
       Assert(ghost_array.size() == n_ghost_indices() ||
                ghost_array.size() == n_ghost_indices_in_larger_set,
@@ -293,13 +484,82 @@ namespace Utilities
              ExcMessage("Another compress operation seems to still be running. "
                         "Call compress_finish() first."));
 
+      const bool use_shared_memory = shared_arrays.size() > 0;
+      Assert(!use_shared_memory || shared_memory_exchange_is_initialized,
+             ExcMessage("Call initialize_shared_memory_exchange() before "
+                        "passing shared arrays."));
+      Assert(!use_shared_memory ||
+               (std::is_same<MemorySpaceType, MemorySpace::Host>::value),
+             ExcNotImplemented());
+      const unsigned int n_shared_import_targets =
+        use_shared_memory ?
+          std::count_if(import_targets_sm_rank.begin(),
+                        import_targets_sm_rank.end(),
+                        [](const unsigned int rank) {
+                          return rank != numbers::invalid_unsigned_int;
+                        }) :
+          0;
+      const unsigned int n_shared_ghost_targets =
+        use_shared_memory ?
+          std::count_if(ghost_targets_sm_rank.begin(),
+                        ghost_targets_sm_rank.end(),
+                        [](const unsigned int rank) {
+                          return rank != numbers::invalid_unsigned_int;
+                        }) :
+          0;
+
       // Need to send and receive the data. Use non-blocking communication,
       // where it is generally less overhead to first initiate the receive and
-      // then actually send the data
+      // then actually send the data. As in export_to_ghosted_array_start(),
+      // only zero-byte messages are exchanged with the processes on the same
+      // node.
 
       // set channels in different range from update_ghost_values channels
       const unsigned int channel = communication_channel + 401;
-      requests.resize(n_import_targets + n_ghost_targets);
+      requests.resize(n_import_targets + n_ghost_targets +
+                      n_shared_ghost_targets + n_shared_import_targets);
+
+      // as in export_to_ghosted_array_start(), set up persistent requests on
+      // first use
+      const auto setup_persistent_requests =
+        [&](std::vector<MPI_Request> &persistent) {
+          Number *recv_ptr = temporary_storage.data();
+          for (unsigned int i = 0; i < n_import_targets; i++)
+            {
+              const int ierr =
+                MPI_Recv_init(recv_ptr,
+                              import_targets_data[i].second * sizeof(Number),
+                              MPI_BYTE,
+                              import_targets_data[i].first,
+                              import_targets_data[i].first + channel,
+                              communicator,
+                              &persistent[i]);
+              AssertThrowMPI(ierr);
+              recv_ptr += import_targets_data[i].second;
+            }
+          Number *send_ptr = ghost_array.data();
+          for (unsigned int i = 0; i < n_ghost_targets; i++)
+            {
+              const int ierr =
+                MPI_Send_init(send_ptr,
+                              ghost_targets_data[i].second * sizeof(Number),
+                              MPI_BYTE,
+                              ghost_targets_data[i].first,
+                              this_mpi_process() + channel,
+                              communicator,
+                              &persistent[n_import_targets + i]);
+              AssertThrowMPI(ierr);
+              send_ptr += ghost_targets_data[i].second;
+            }
+        };
+      const bool use_persistent_requests =
+        !use_shared_memory && requests.size() > 0 &&
+        get_persistent_requests(temporary_storage.data(),
+                                ghost_array.data(),
+                                channel,
+                                sizeof(Number),
+                                setup_persistent_requests,
+                                requests);
 
       // initiate the receive operations
       Number *temp_array_ptr = temporary_storage.data();
@@ -312,14 +572,20 @@ namespace Utilities
             ExcMessage("Index overflow: Maximum message size in MPI is 2GB. "
                        "The number of ghost entries times the size of 'Number' "
                        "exceeds this value. This is not supported."));
+          const bool target_is_shared =
+            use_shared_memory &&
+            import_targets_sm_rank[i] != numbers::invalid_unsigned_int;
           const int ierr =
-            MPI_Irecv(temp_array_ptr,
-                      import_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      import_targets_data[i].first,
-                      import_targets_data[i].first + channel,
-                      communicator,
-                      &requests[i]);
+            use_persistent_requests ?
+              MPI_Start(&requests[i]) :
+              MPI_Irecv(temp_array_ptr,
+                        (target_is_shared ? 0 : import_targets_data[i].second) *
+                          sizeof(Number),
+                        MPI_BYTE,
+                        import_targets_data[i].first,
+                        import_targets_data[i].first + channel,
+                        communicator,
+                        &requests[i]);
           AssertThrowMPI(ierr);
           temp_array_ptr += import_targets_data[i].second;
         }
@@ -400,18 +666,59 @@ namespace Utilities
             ExcMessage("Index overflow: Maximum message size in MPI is 2GB. "
                        "The number of ghost entries times the size of 'Number' "
                        "exceeds this value. This is not supported."));
+          const bool target_is_shared =
+            use_shared_memory &&
+            ghost_targets_sm_rank[i] != numbers::invalid_unsigned_int;
           const int ierr =
-            MPI_Isend(ghost_array_ptr,
-                      ghost_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      ghost_targets_data[i].first,
-                      this_mpi_process() + channel,
-                      communicator,
-                      &requests[n_import_targets + i]);
+            use_persistent_requests ?
+              MPI_Start(&requests[n_import_targets + i]) :
+              MPI_Isend(ghost_array_ptr,
+                        (target_is_shared ? 0 : ghost_targets_data[i].second) *
+                          sizeof(Number),
+                        MPI_BYTE,
+                        ghost_targets_data[i].first,
+                        this_mpi_process() + channel,
+                        communicator,
+                        &requests[n_import_targets + i]);
           AssertThrowMPI(ierr);
 
           ghost_array_ptr += ghost_targets_data[i].second;
         }
+
+      // the owners on the same node tell us when they have read our ghost
+      // data, so that we do not clear it earlier, and we tell them the same
+      // in import_from_ghosted_array_finish()
+      if (use_shared_memory)
+        {
+          unsigned int k = n_import_targets + n_ghost_targets;
+          for (unsigned int i = 0; i < n_ghost_targets; i++)
+            if (ghost_targets_sm_rank[i] != numbers::invalid_unsigned_int)
+              {
+                const int ierr = MPI_Irecv(nullptr,
+                                           0,
+                                           MPI_BYTE,
+                                           ghost_targets_data[i].first,
+                                           ghost_targets_data[i].first +
+                                             channel + 802,
+                                           communicator,
+                                           &requests[k++]);
+                AssertThrowMPI(ierr);
+              }
+          for (unsigned int i = 0; i < n_import_targets; i++)
+            if (import_targets_sm_rank[i] != numbers::invalid_unsigned_int)
+              {
+                const int ierr =
+                  MPI_Send_init(nullptr,
+                                0,
+                                MPI_BYTE,
+                                import_targets_data[i].first,
+                                this_mpi_process() + channel + 802,
+                                communicator,
+                                &requests[k++]);
+                AssertThrowMPI(ierr);
+              }
+          AssertDimension(k, requests.size());
+        }
     }
 
 
@@ -486,8 +793,12 @@ namespace Utilities
       const ArrayView<const Number, MemorySpaceType> &temporary_storage,
       const ArrayView<Number, MemorySpaceType> &      locally_owned_array,
       const ArrayView<Number, MemorySpaceType> &      ghost_array,
-      std::vector<MPI_Request> &                      requests) const
+      std::vector<MPI_Request> &                      requests,
+      const std::vector<ArrayView<const Number, MemorySpaceType>>
+        &shared_arrays) const
     {
+      Tracing::Scope trace("Partitioner::import_from_ghosted_array_finish");
+
       AssertDimension(temporary_storage.size(), n_import_indices());
       Assert(ghost_array.size() == n_ghost_indices() ||
                ghost_array.size() == n_ghost_indices_in_larger_set,
@@ -542,8 +853,17 @@ namespace Utilities
         initialize_import_indices_plain_dev();
 #    endif
 
+      const unsigned int n_exchange_requests =
+        n_ghost_targets + n_import_targets;
+      const bool use_shared_memory =
+        shared_arrays.size() > 0 && requests.size() > n_exchange_requests;
       if (vector_operation != dealii::VectorOperation::insert)
-        AssertDimension(n_ghost_targets + n_import_targets, requests.size());
+        {
+          Assert(shared_arrays.size() > 0 ||
+                   n_exchange_requests == requests.size(),
+                 ExcDimensionMismatch(n_exchange_requests, requests.size()));
+          AssertIndexRange(n_exchange_requests, requests.size() + 1);
+        }
       // first wait for the receive to complete
       if (requests.size() > 0 && n_import_targets > 0)
         {
@@ -552,6 +872,29 @@ namespace Utilities
             MPI_Waitall(n_import_targets, requests.data(), MPI_STATUSES_IGNORE);
           AssertThrowMPI(ierr);
 
+          // collect the ghost data of the processes on the same node from
+          // their arrays. The temporary storage is the array passed to
+          // import_from_ghosted_array_start(), where it is not const
+          if (use_shared_memory)
+            {
+              Number *write_position =
+                const_cast<Number *>(temporary_storage.data());
+              for (unsigned int i = 0; i < n_import_targets; ++i)
+                {
+                  const unsigned int rank_sm = import_targets_sm_rank[i];
+                  if (rank_sm != numbers::invalid_unsigned_int)
+                    {
+                      const Number *ghost_data =
+                        shared_arrays[rank_sm].data() +
+                        import_targets_sm_offset[i];
+                      std::copy(ghost_data,
+                                ghost_data + import_targets_data[i].second,
+                                write_position);
+                    }
+                  write_position += import_targets_data[i].second;
+                }
+            }
+
           const Number *read_position = temporary_storage.data();
 #    if !(defined(DEAL_II_COMPILER_CUDA_AWARE) && \
           defined(DEAL_II_MPI_WITH_CUDA_SUPPORT))
@@ -699,6 +1042,31 @@ namespace Utilities
       else
         AssertDimension(n_ghost_indices(), 0);
 
+      // tell the processes on the same node that we have read their ghost
+      // data and wait until they have read ours
+      if (use_shared_memory)
+        {
+          const unsigned int n_shared_import_targets =
+            std::count_if(import_targets_sm_rank.begin(),
+                          import_targets_sm_rank.end(),
+                          [](const unsigned int rank) {
+                            return rank != numbers::invalid_unsigned_int;
+                          });
+          MPI_Request *done_requests =
+            requests.data() + requests.size() - n_shared_import_targets;
+          int ierr = MPI_Startall(n_shared_import_targets, done_requests);
+          AssertThrowMPI(ierr);
+          ierr = MPI_Waitall(requests.size() - n_exchange_requests,
+                             requests.data() + n_exchange_requests,
+                             MPI_STATUSES_IGNORE);
+          AssertThrowMPI(ierr);
+          for (unsigned int i = 0; i < n_shared_import_targets; ++i)
+            {
+              ierr = MPI_Request_free(done_requests + i);
+              AssertThrowMPI(ierr);
+            }
+        }
+
       // clear the ghost array in case we did not yet do that in the _start
       // function
       if (ghost_array.size() > 0)
@@ -739,6 +1107,63 @@ namespace Utilities
     }
 
 
+
+#    ifdef DEAL_II_COMPILER_CUDA_AWARE
+    template <typename Number>
+    void
+    Partitioner::copy_import_entries_to_host(
+      const ArrayView<const Number, MemorySpace::CUDA> &locally_owned_array,
+      const ArrayView<Number, MemorySpace::CUDA> &      temporary_storage,
+      const ArrayView<Number, MemorySpace::Host> &      temporary_storage_host,
+      const ArrayView<Number, MemorySpace::Host> &locally_owned_array_host)
+      const
+    {
+      AssertDimension(temporary_storage.size(), n_import_indices());
+      AssertDimension(temporary_storage_host.size(), n_import_indices());
+      AssertDimension(locally_owned_array.size(), local_size());
+      AssertDimension(locally_owned_array_host.size(), local_size());
+      if (n_import_indices() == 0)
+        return;
+
+      if (import_indices_plain_dev.size() == 0)
+        initialize_import_indices_plain_dev();
+
+      // pack the entries on the device, in the same order as the chunks of
+      // import_indices_data
+      Number *temp_array_ptr = temporary_storage.data();
+      for (const auto &import_indices_plain : import_indices_plain_dev)
+        {
+          const auto chunk_size = import_indices_plain.second;
+          const int  n_blocks =
+            1 + chunk_size / (::dealii::CUDAWrappers::chunk_size *
+                              ::dealii::CUDAWrappers::block_size);
+          ::dealii::LinearAlgebra::CUDAWrappers::kernel::
+            gather<<<n_blocks, ::dealii::CUDAWrappers::block_size>>>(
+              temp_array_ptr,
+              import_indices_plain.first.get(),
+              locally_owned_array.data(),
+              chunk_size);
+          temp_array_ptr += chunk_size;
+        }
+
+      const cudaError_t cuda_error_code =
+        cudaMemcpy(temporary_storage_host.data(),
+                   temporary_storage.data(),
+                   n_import_indices() * sizeof(Number),
+                   cudaMemcpyDeviceToHost);
+      AssertCuda(cuda_error_code);
+
+      // unpack into the locally owned array on the host
+      const Number *read_position = temporary_storage_host.data();
+      for (const auto &import_range : import_indices_data)
+        for (unsigned int i = import_range.first; i < import_range.second;
+             ++i, ++read_position)
+          locally_owned_array_host[i] = *read_position;
+    }
+#    endif
+
+
+
 #  endif // ifdef DEAL_II_WITH_MPI
 #endif   // ifndef DOXYGEN
 
@@ -29,6 +29,10 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// Forward declarations
+template <int N, typename T>
+class Table;
+
 /**
  * Representation of the space of polynomials of degree at most n in higher
  * dimensions.
@@ -149,6 +153,30 @@ public:
           std::vector<Tensor<3, dim>> &third_derivatives,
           std::vector<Tensor<4, dim>> &fourth_derivatives) const;
 
+  /**
+   * Compute the values and the first and second derivatives of each polynomial
+   * at all the given @p unit_points, in one sweep. The results are stored
+   * as <tt>values(i,q)</tt> for polynomial <tt>i</tt> at point
+   * <tt>q</tt>, which is the layout of the shape function tables of
+   * FE_Poly.
+   *
+   * Each table must either be empty or have the size n() times
+   * <tt>unit_points.size()</tt>. In the first case, the function will not
+   * compute these values.
+   *
+   * The points are processed in batches of the width of
+   * VectorizedArray<double>: the one-dimensional polynomials are evaluated
+   * for all points of a batch first, and the products that form the
+   * polynomials of the space are then computed for all points of the batch
+   * at once. For a larger number of points and higher degrees, this is
+   * considerably faster than calling compute() point by point.
+   */
+  void
+  evaluate(const std::vector<Point<dim>> &unit_points,
+           Table<2, double> &             values,
+           Table<2, Tensor<1, dim>> &     grads,
+           Table<2, Tensor<2, dim>> &     grad_grads) const;
+
   /**
    * Compute the value of the <tt>i</tt>th polynomial at unit point
    * <tt>p</tt>.
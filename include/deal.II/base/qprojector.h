@@ -100,6 +100,22 @@ public:
   static Quadrature<dim>
   project_to_face(const SubQuadrature &quadrature, const unsigned int face_no);
 
+  /**
+   * Compute the cell quadrature formula corresponding to using
+   * <tt>quadrature</tt> on face <tt>face_no</tt> that has the given
+   * orientation, flip and rotation. The result is the same as the
+   * data set of project_to_all_faces() identified by
+   * DataSetDescriptor::face(), but only the points of the one requested
+   * face and orientation are computed. The orientation flags are ignored if
+   * <tt>dim<3</tt>.
+   */
+  static Quadrature<dim>
+  project_to_oriented_face(const SubQuadrature &quadrature,
+                           const unsigned int   face_no,
+                           const bool           face_orientation,
+                           const bool           face_flip,
+                           const bool           face_rotation);
+
   /**
    * Compute the quadrature points on the cell if the given quadrature formula
    * is used on face <tt>face_no</tt>, subface number <tt>subface_no</tt>
@@ -148,6 +164,10 @@ public:
    *
    * @note In 3D, this function produces eight sets of quadrature points for
    * each face, in order to cope possibly different orientations of the mesh.
+   * Since every FEFaceValues object (and the mapping and finite element it
+   * uses) calls this function at construction, the result is computed only
+   * once per face quadrature formula in 3D and kept in a cache shared by all
+   * callers.
    */
   static Quadrature<dim>
   project_to_all_faces(const SubQuadrature &quadrature);
@@ -380,6 +400,14 @@ template <>
 Quadrature<1>
 QProjector<1>::project_to_all_faces(const Quadrature<0> &quadrature);
 
+template <>
+Quadrature<3>
+QProjector<3>::project_to_oriented_face(const Quadrature<2> &quadrature,
+                                        const unsigned int   face_no,
+                                        const bool           face_orientation,
+                                        const bool           face_flip,
+                                        const bool           face_rotation);
+
 
 template <>
 void
@@ -25,6 +25,7 @@
 #include <algorithm>
 #include <array>
 #include <functional>
+#include <limits>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -1437,6 +1438,65 @@ namespace internal
       }
     };
 
+
+
+    /**
+     * Specialization of the inverse of a rank-4 tensor in 3d for
+     * VectorizedArray. The pivot search of the general variant would need to
+     * select different rows in different lanes, so the Gauss-Jordan
+     * algorithm is run without pivoting here. This is stable for the
+     * positive definite tensors that appear as tangent moduli of constitutive
+     * models, and avoids all data-dependent branches.
+     */
+    template <typename Number, int width>
+    struct Inverse<4, 3, VectorizedArray<Number, width>>
+    {
+      static dealii::SymmetricTensor<4, 3, VectorizedArray<Number, width>>
+      value(const dealii::SymmetricTensor<4, 3, VectorizedArray<Number, width>>
+              &t)
+      {
+        dealii::SymmetricTensor<4, 3, VectorizedArray<Number, width>> tmp = t;
+
+        const unsigned int N = 6;
+        for (unsigned int j = 0; j < N; ++j)
+          {
+            const VectorizedArray<Number, width> hr =
+              Number(1.) / tmp.data[j][j];
+            for (unsigned int k = 0; k < N; ++k)
+              {
+                if (k == j)
+                  continue;
+                const VectorizedArray<Number, width> factor =
+                  tmp.data[j][k] * hr;
+                for (unsigned int i = 0; i < N; ++i)
+                  if (i != j)
+                    tmp.data[i][k] -= tmp.data[i][j] * factor;
+              }
+            for (unsigned int i = 0; i < N; ++i)
+              {
+                tmp.data[i][j] *= hr;
+                tmp.data[j][i] *= -hr;
+              }
+            tmp.data[j][j] = hr;
+          }
+
+        // Scale rows and columns as in the general variant
+        for (unsigned int i = 3; i < 6; ++i)
+          for (unsigned int j = 0; j < 3; ++j)
+            tmp.data[i][j] *= Number(0.5);
+
+        for (unsigned int i = 0; i < 3; ++i)
+          for (unsigned int j = 3; j < 6; ++j)
+            tmp.data[i][j] *= Number(0.5);
+
+        for (unsigned int i = 3; i < 6; ++i)
+          for (unsigned int j = 3; j < 6; ++j)
+            tmp.data[i][j] *= Number(0.25);
+
+        return tmp;
+      }
+    };
+
   } // namespace SymmetricTensorImplementation
 } // namespace internal
 
@@ -1679,14 +1739,18 @@ namespace internal
     for (unsigned int i = 0; i < data_dim; ++i)
       for (unsigned int j = 0; j < data_dim; ++j)
         {
-          // Start with the non-diagonal part
+          // Accumulate into a local variable rather than into tmp[i][j], which
+          // the compiler cannot keep in a register across the loop. Start
+          // with the non-diagonal part
+          value_type sum = value_type();
           for (unsigned int d = dim; d < (dim * (dim + 1) / 2); ++d)
-            tmp[i][j] += data[i][d] * sdata[d][j];
-          tmp[i][j] += tmp[i][j]; // tmp[i][j] = tmp[i][j] * 2;
+            sum += data[i][d] * sdata[d][j];
+          sum += sum; // sum = sum * 2.;
 
           // Now add the contributions from the diagonal
           for (unsigned int d = 0; d < dim; ++d)
-            tmp[i][j] += data[i][d] * sdata[d][j];
+            sum += data[i][d] * sdata[d][j];
+          tmp[i][j] = sum;
         }
     return tmp;
   }
@@ -2793,6 +2857,99 @@ eigenvalues(const SymmetricTensor<2, 3, Number> &T);
 
 
 
+/**
+ * Return the eigenvalues of a symmetric 2x2 tensor of rank 2 whose entries
+ * are VectorizedArray objects, sorted in descending order in each lane.
+ *
+ * This overload evaluates the closed-form expression
+ * $\lambda = \frac{T_{00}+T_{11}}{2} \pm \sqrt{\left(\frac{T_{00}-T_{11}}{2}
+ * \right)^2 + T_{01}^2}$ for all lanes at once. In contrast to the general
+ * variant it does not need to distinguish diagonal tensors, so it does not
+ * contain branches that depend on the data and is hence suitable for
+ * constitutive models evaluated on a batch of quadrature points of
+ * FEEvaluation.
+ *
+ * @relatesalso SymmetricTensor
+ */
+template <typename Number, int width>
+inline std::array<VectorizedArray<Number, width>, 2>
+eigenvalues(const SymmetricTensor<2, 2, VectorizedArray<Number, width>> &T)
+{
+  const VectorizedArray<Number, width> half_trace =
+    Number(0.5) * (T[0][0] + T[1][1]);
+  const VectorizedArray<Number, width> half_difference =
+    Number(0.5) * (T[0][0] - T[1][1]);
+  const VectorizedArray<Number, width> radius = std::sqrt(
+    half_difference * half_difference + T[0][1] * T[0][1]);
+  return {{half_trace + radius, half_trace - radius}};
+}
+
+
+
+/**
+ * Return the eigenvalues of a symmetric 3x3 tensor of rank 2 whose entries
+ * are VectorizedArray objects, sorted in descending order in each lane.
+ *
+ * This overload uses the same trigonometric solution of the characteristic
+ * polynomial as the general variant, but evaluates it for all lanes at once.
+ * Tensors that are a multiple of the identity, for which the scaled
+ * deviatoric part is undefined, are handled by bounding the denominator from
+ * below rather than by a branch. Only the arc cosine is evaluated lane by
+ * lane.
+ *
+ * @relatesalso SymmetricTensor
+ */
+template <typename Number, int width>
+inline std::array<VectorizedArray<Number, width>, 3>
+eigenvalues(const SymmetricTensor<2, 3, VectorizedArray<Number, width>> &T)
+{
+  using VectorizedArrayType = VectorizedArray<Number, width>;
+
+  // Decompose T = p*B + q*I with q = tr(T)/3 and
+  // p = (tr((T - q.I)^{2})/6)^{1/2} as in the general variant and express
+  // det(B) by the entries of T - q*I
+  const VectorizedArrayType q   = (T[0][0] + T[1][1] + T[2][2]) / Number(3.);
+  const VectorizedArrayType a00 = T[0][0] - q;
+  const VectorizedArrayType a11 = T[1][1] - q;
+  const VectorizedArrayType a22 = T[2][2] - q;
+  const VectorizedArrayType a01 = T[0][1];
+  const VectorizedArrayType a02 = T[0][2];
+  const VectorizedArrayType a12 = T[1][2];
+
+  const VectorizedArrayType p_square =
+    (a00 * a00 + a11 * a11 + a22 * a22 +
+     Number(2.) * (a01 * a01 + a02 * a02 + a12 * a12)) /
+    Number(6.);
+  const VectorizedArrayType p = std::sqrt(p_square);
+  const VectorizedArrayType det_a =
+    a00 * (a11 * a22 - a12 * a12) - a01 * (a01 * a22 - a12 * a02) +
+    a02 * (a01 * a12 - a11 * a02);
+
+  // For p = 0, det_a is zero as well and the bounded denominator yields r = 0
+  // and hence three eigenvalues equal to q. The value of r should be within
+  // [-1,1], but floating point errors might place it slightly outside.
+  VectorizedArrayType r =
+    det_a /
+    std::max(Number(2.) * p_square * p,
+             VectorizedArrayType(std::numeric_limits<Number>::min()));
+  r = std::min(std::max(r, VectorizedArrayType(Number(-1.))),
+               VectorizedArrayType(Number(1.)));
+
+  VectorizedArrayType phi;
+  for (unsigned int v = 0; v < VectorizedArrayType::n_array_elements; ++v)
+    phi[v] = std::acos(r[v]) / Number(3.);
+
+  std::array<VectorizedArrayType, 3> eig_vals;
+  eig_vals[0] = q + Number(2.) * p * std::cos(phi);
+  eig_vals[2] =
+    q + Number(2.) * p * std::cos(phi + Number(2.0 / 3.0 * numbers::PI));
+  // Use the identity tr(T) = eig1 + eig2 + eig3
+  eig_vals[1] = Number(3.) * q - eig_vals[0] - eig_vals[2];
+  return eig_vals;
+}
+
+
+
 namespace internal
 {
   namespace SymmetricTensorImplementation
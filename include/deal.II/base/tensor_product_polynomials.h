@@ -29,6 +29,10 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// Forward declarations
+template <int N, typename T>
+class Table;
+
 /**
  * @addtogroup Polynomials
  * @{
@@ -105,6 +109,13 @@ public:
   const std::vector<unsigned int> &
   get_numbering_inverse() const;
 
+  /**
+   * Give read access to the one-dimensional polynomials given to the
+   * constructor.
+   */
+  const std::vector<PolynomialType> &
+  get_underlying_polynomials() const;
+
   /**
    * Compute the value and the first and second derivatives of each tensor
    * product polynomial at <tt>unit_point</tt>.
@@ -125,6 +136,30 @@ public:
           std::vector<Tensor<3, dim>> &third_derivatives,
           std::vector<Tensor<4, dim>> &fourth_derivatives) const;
 
+  /**
+   * Compute the values and the first and second derivatives of each tensor
+   * product polynomial at all the given @p unit_points, in one sweep. The
+   * results are stored as <tt>values(i,q)</tt> for polynomial <tt>i</tt> at
+   * point <tt>q</tt>, which is the layout of the shape function tables of
+   * FE_Poly.
+   *
+   * Each table must either be empty or have the size n() times
+   * <tt>unit_points.size()</tt>. In the first case, the function will not
+   * compute these values.
+   *
+   * The points are processed in batches of the width of
+   * VectorizedArray<double>: the one-dimensional polynomials are evaluated
+   * for all points of a batch first, and the products that form the
+   * tensor product polynomials are then computed for all points of the
+   * batch at once. For a larger number of points and higher degrees, this is
+   * considerably faster than calling compute() point by point.
+   */
+  void
+  evaluate(const std::vector<Point<dim>> &unit_points,
+           Table<2, double> &             values,
+           Table<2, Tensor<1, dim>> &     grads,
+           Table<2, Tensor<2, dim>> &     grad_grads) const;
+
   /**
    * Compute the value of the <tt>i</tt>th tensor product polynomial at
    * <tt>unit_point</tt>. Here <tt>i</tt> is given in tensor product
@@ -453,6 +488,15 @@ TensorProductPolynomials<dim, PolynomialType>::get_numbering_inverse() const
   return index_map_inverse;
 }
 
+
+template <int dim, typename PolynomialType>
+inline const std::vector<PolynomialType> &
+TensorProductPolynomials<dim, PolynomialType>::get_underlying_polynomials()
+  const
+{
+  return polynomials;
+}
+
 template <int dim, typename PolynomialType>
 template <int order>
 Tensor<order, dim>
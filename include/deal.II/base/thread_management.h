@@ -23,6 +23,8 @@
 #  include <deal.II/base/multithread_info.h>
 #  include <deal.II/base/template_constraints.h>
 
+#  include <atomic>
+#  include <complex>
 #  include <condition_variable>
 #  include <functional>
 #  include <iterator>
@@ -379,6 +381,38 @@ namespace Threads
                  const unsigned int end,
                  const unsigned int n_intervals);
 
+  /**
+   * Add @p value to @p target as one indivisible operation, i.e., such that
+   * several threads may add to the same memory location concurrently without
+   * losing updates. For types of up to eight bytes, this is implemented by a
+   * compare-and-swap loop on the memory location itself; larger types are
+   * protected by a mutex. Complex numbers are updated one component at a
+   * time, so other threads may observe a state where only the real part has
+   * been updated.
+   *
+   * Apart from the fact that such an update is considerably more expensive
+   * than a plain <code>target += value</code>, the order in which concurrent
+   * updates are applied is not specified, so results may differ in the last
+   * digits between runs.
+   *
+   * If deal.II has not been configured for multithreading, this function
+   * simply performs <code>target += value</code>.
+   *
+   * @ingroup threads
+   */
+  template <typename Number>
+  void
+  atomic_add(Number &target, const Number value);
+
+  /**
+   * Same as the function above, but for complex numbers.
+   *
+   * @ingroup threads
+   */
+  template <typename Number>
+  void
+  atomic_add(std::complex<Number> &target, const std::complex<Number> &value);
+
   /**
    * @cond internal
    */
@@ -497,6 +531,79 @@ namespace Threads
       }
     return return_values;
   }
+
+
+
+  namespace internal
+  {
+    // compare-and-swap loop for types that fit into a single machine word
+    template <typename Number>
+    inline void
+    atomic_add(Number &target, const Number value, std::true_type)
+    {
+#    if defined(__GNUC__)
+      Number expected;
+      __atomic_load(&target, &expected, __ATOMIC_RELAXED);
+      Number desired = expected + value;
+      while (!__atomic_compare_exchange(&target,
+                                        &expected,
+                                        &desired,
+                                        true,
+                                        __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED))
+        desired = expected + value;
+#    else
+      static_assert(sizeof(std::atomic<Number>) == sizeof(Number),
+                    "std::atomic<Number> must have the layout of Number.");
+      std::atomic<Number> &atomic_target =
+        reinterpret_cast<std::atomic<Number> &>(target);
+      Number expected = atomic_target.load(std::memory_order_relaxed);
+      while (!atomic_target.compare_exchange_weak(expected,
+                                                  expected + value,
+                                                  std::memory_order_relaxed))
+        ;
+#    endif
+    }
+
+
+
+    // fallback for larger types such as long double
+    template <typename Number>
+    inline void
+    atomic_add(Number &target, const Number value, std::false_type)
+    {
+      static std::mutex           mutex;
+      std::lock_guard<std::mutex> lock(mutex);
+      target += value;
+    }
+  } // namespace internal
+
+
+
+  template <typename Number>
+  inline void
+  atomic_add(Number &target, const Number value)
+  {
+#    ifdef DEAL_II_WITH_THREADS
+    internal::atomic_add(target,
+                         value,
+                         std::integral_constant<bool, sizeof(Number) <= 8>());
+#    else
+    target += value;
+#    endif
+  }
+
+
+
+  template <typename Number>
+  inline void
+  atomic_add(std::complex<Number> &target, const std::complex<Number> &value)
+  {
+    // std::complex is guaranteed to be laid out as an array of two numbers
+    Number *components = reinterpret_cast<Number *>(&target);
+    atomic_add(components[0], value.real());
+    atomic_add(components[1], value.imag());
+  }
 } // namespace Threads
 
 #  endif // DOXYGEN
@@ -1843,6 +1950,87 @@ namespace Threads
     std::list<Task<RT>> tasks;
   };
 
+
+
+  // ------------------------ TaskGraph -------------------------------------
+
+  /**
+   * A collection of tasks with dependencies between them. In contrast to
+   * TaskGroup, where all tasks are started right away and only the end of
+   * all of them is waited for, the tasks added to an object of this class
+   * are only started by run(), and each task is started as soon as all the
+   * tasks it depends on have finished. This allows to express setup phases
+   * that consist of several steps, some of which depend on each other while
+   * others do not, such that independent steps overlap:
+   * @code
+   *   Threads::TaskGraph graph;
+   *   const auto a = graph.add_task([&]() { setup_a(); });
+   *   const auto b = graph.add_task([&]() { setup_b(); });
+   *   graph.add_task([&]() { setup_c(); }, {a, b});
+   *   graph.run();
+   * @endcode
+   * Here, the first two functions may run concurrently, whereas the third
+   * one is only started once both of them are done.
+   *
+   * A task can only depend on tasks that have been added before it, which
+   * guarantees that the dependencies do not form cycles. Consequently, the
+   * order in which the tasks have been added is always a valid order to run
+   * them in, and that is what run() does if only one thread is available.
+   *
+   * If one of the tasks throws an exception, the tasks depending on it are
+   * not started, and run() rethrows the exception once all other tasks are
+   * done.
+   *
+   * @ingroup tasks
+   */
+  class TaskGraph
+  {
+  public:
+    /**
+     * The type used to refer to the tasks of a graph.
+     */
+    using TaskIndex = unsigned int;
+
+    /**
+     * Add a task running @p function that is started only once all tasks
+     * in @p dependencies have finished, and return the index by which later
+     * tasks can refer to it.
+     */
+    TaskIndex
+    add_task(const std::function<void()> & function,
+             const std::vector<TaskIndex> &dependencies = {});
+
+    /**
+     * Return the number of tasks in this graph.
+     */
+    unsigned int
+    n_tasks() const;
+
+    /**
+     * Run all tasks of the graph, respecting their dependencies, and wait
+     * for all of them to finish. The function may be called more than once,
+     * in which case all tasks are run again.
+     */
+    void
+    run() const;
+
+  private:
+    /**
+     * The functions to be run by the tasks.
+     */
+    std::vector<std::function<void()>> functions;
+
+    /**
+     * For each task, the tasks that depend on it.
+     */
+    std::vector<std::vector<TaskIndex>> successors;
+
+    /**
+     * For each task, the number of tasks it depends on.
+     */
+    std::vector<unsigned int> n_dependencies;
+  };
+
 } // namespace Threads
 
 /**
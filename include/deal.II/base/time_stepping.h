@@ -22,6 +22,7 @@
 #include <deal.II/base/signaling_nan.h>
 
 #include <functional>
+#include <memory>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -41,11 +42,21 @@ namespace TimeStepping
    *   - FORWARD_EULER (first order)
    *   - RK_THIRD_ORDER (third order Runge-Kutta)
    *   - RK_CLASSIC_FOURTH_ORDER (classical fourth order Runge-Kutta)
+   * - Low-storage explicit methods (see LowStorageRungeKutta::initialize):
+   *   - LOW_STORAGE_RK_STAGE3_ORDER3 (three stages, third order)
+   *   - LOW_STORAGE_RK_STAGE5_ORDER4 (five stages, fourth order)
+   *   - LOW_STORAGE_RK_STAGE7_ORDER4 (seven stages, fourth order)
+   *   - LOW_STORAGE_RK_STAGE9_ORDER5 (nine stages, fifth order)
    * - Implicit methods (see ImplicitRungeKutta::initialize):
    *   - BACKWARD_EULER (first order)
    *   - IMPLICIT_MIDPOINT (second order)
    *   - CRANK_NICOLSON (second order)
    *   - SDIRK_TWO_STAGES (second order)
+   * - Implicit-explicit (IMEX) additive methods (see
+   *   ImplicitExplicitRungeKutta::initialize):
+   *   - IMEX_EULER (first order forward-backward Euler)
+   *   - IMEX_ARS_222 (second order, Ascher-Ruuth-Spiteri (2,2,2))
+   *   - IMEX_ARS_443 (third order, Ascher-Ruuth-Spiteri (4,4,3))
    * - Embedded explicit methods (see EmbeddedExplicitRungeKutta::initialize):
    *   - HEUN_EULER (second order)
    *   - BOGACKI_SHAMPINE (third order)
@@ -59,10 +70,17 @@ namespace TimeStepping
     FORWARD_EULER,
     RK_THIRD_ORDER,
     RK_CLASSIC_FOURTH_ORDER,
+    LOW_STORAGE_RK_STAGE3_ORDER3,
+    LOW_STORAGE_RK_STAGE5_ORDER4,
+    LOW_STORAGE_RK_STAGE7_ORDER4,
+    LOW_STORAGE_RK_STAGE9_ORDER5,
     BACKWARD_EULER,
     IMPLICIT_MIDPOINT,
     CRANK_NICOLSON,
     SDIRK_TWO_STAGES,
+    IMEX_EULER,
+    IMEX_ARS_222,
+    IMEX_ARS_443,
     HEUN_EULER,
     BOGACKI_SHAMPINE,
     DOPRI,
@@ -324,6 +342,185 @@ namespace TimeStepping
 
 
 
+  /**
+   * The LowStorageRungeKutta class is derived from RungeKutta and implements
+   * explicit Runge-Kutta methods in the low-storage form of Kennedy,
+   * Carpenter, and Lewis (Appl. Numer. Math. 35:177-219, 2000). In these
+   * methods, the Butcher tableau is restricted such that all entries below
+   * the subdiagonal coincide with the weights $b_j$ of the final
+   * combination. A time step then only needs three vectors, namely the
+   * solution and two registers, independently of the number of stages:
+   * @f{align*}{
+   *   k_i &= f(t + c_i \Delta t, r_i), \
+   *   r_{i+1} &= y + a_i \Delta t\, k_i, \
+   *   y &\leftarrow y + b_i \Delta t\, k_i,
+   * @f}
+   * starting from $r_1 = y^n$. This makes the methods particularly suited for
+   * explicit time integration of large systems, where the memory for and the
+   * bandwidth of accessing all stage vectors of ExplicitRungeKutta are the
+   * limiting factor.
+   *
+   * The update of the solution and the next register can additionally be
+   * fused with the evaluation of $f$ by the caller, see the second
+   * evolve_one_time_step() function below, e.g. to apply them within the
+   * same loop over the cells of a matrix-free operator evaluation.
+   *
+   * The three- and nine-stage methods are taken from Kennedy et al.
+   * (schemes RK3(2)3[2R+] and RK5(4)9[2R+]S), the five-stage method is their
+   * RK4(3)5[2R+]C scheme, and the seven-stage method is the fourth order
+   * scheme by Tselios and Simos (J. Comput. Appl. Math. 175:173-181, 2005),
+   * which is optimized for wave propagation problems.
+   */
+  template <typename VectorType>
+  class LowStorageRungeKutta : public RungeKutta<VectorType>
+  {
+  public:
+    using RungeKutta<VectorType>::evolve_one_time_step;
+
+    /**
+     * Default constructor. This constructor creates an object for which
+     * you will want to call <code>initialize(runge_kutta_method)</code>
+     * before it can be used.
+     */
+    LowStorageRungeKutta() = default;
+
+    /**
+     * Constructor. This function calls initialize(runge_kutta_method).
+     */
+    LowStorageRungeKutta(const runge_kutta_method method);
+
+    /**
+     * Initialize the low-storage explicit Runge-Kutta method.
+     */
+    void
+    initialize(const runge_kutta_method method) override;
+
+    /**
+     * This function is used to advance from time @p t to t+ @p delta_t. This
+     * function is the one derived from RungeKutta and allocates the two
+     * registers needed internally. @p id_minus_tau_J_inverse is not used
+     * for explicit methods. evolve_one_time_step returns the time at the end
+     * of the time step.
+     */
+    double
+    evolve_one_time_step(
+      const std::function<VectorType(const double, const VectorType &)> &f,
+      const std::function<
+        VectorType(const double, const double, const VectorType &)>
+        &         id_minus_tau_J_inverse,
+      double      t,
+      double      delta_t,
+      VectorType &y) override;
+
+    /**
+     * This function is used to advance from time @p t to t+ @p delta_t,
+     * using the vectors @p vec_ri and @p vec_ki provided by the caller as
+     * the two registers of the method. They need to have the same layout as
+     * @p solution, but their content is overwritten. Providing them
+     * avoids any allocation of vectors during the time step. @p f is the
+     * function $ f(t,y) $ that should be integrated.
+     * evolve_one_time_step returns the time at the end of the time step.
+     */
+    double
+    evolve_one_time_step(
+      const std::function<VectorType(const double, const VectorType &)> &f,
+      double                                                             t,
+      double      delta_t,
+      VectorType &solution,
+      VectorType &vec_ri,
+      VectorType &vec_ki);
+
+    /**
+     * Same as the function above, but the caller performs each stage as a
+     * whole through @p stage_update, which allows fusing the evaluation of
+     * $f$ with the vector updates. The function @p stage_update is called
+     * with the arguments
+     * <code>(time, factor_solution, factor_ai, current_ri, next_ri,
+     * solution)</code> and needs to compute $k = f(time, current\_ri)$,
+     * set <code>next_ri = solution + factor_ai * k</code>, and then add
+     * <code>factor_solution * k</code> to <code>solution</code>. The three
+     * vectors passed are always distinct, so the stage vector $k$ never
+     * needs to be stored as a whole. To this end, the solution is copied
+     * into @p vec_ri at the beginning of the time step, and the roles of
+     * @p vec_ri and @p vec_ki alternate between stages. In the last stage,
+     * <code>factor_ai</code> is zero and <code>next_ri</code> is not used
+     * afterwards.
+     */
+    double
+    evolve_one_time_step(
+      const std::function<void(const double,
+                               const double,
+                               const double,
+                               const VectorType &,
+                               VectorType &,
+                               VectorType &)> &stage_update,
+      double                                   t,
+      double                                   delta_t,
+      VectorType &                             solution,
+      VectorType &                             vec_ri,
+      VectorType &                             vec_ki);
+
+    /**
+     * Get the coefficients of the scheme: @p a contains the subdiagonal
+     * entries $a_i$ of the Butcher tableau, @p b the weights $b_i$, and
+     * @p c the nodes $c_i$.
+     */
+    void
+    get_coefficients(std::vector<double> &a,
+                     std::vector<double> &b,
+                     std::vector<double> &c) const;
+
+    /**
+     * This structure stores the name of the method used.
+     */
+    struct Status : public TimeStepping<VectorType>::Status
+    {
+      Status()
+        : method(invalid)
+      {}
+
+      runge_kutta_method method;
+    };
+
+    /**
+     * Return the status of the current object.
+     */
+    const Status &
+    get_status() const override;
+
+  private:
+    /**
+     * Compute one stage of the low-storage scheme: evaluate @p f at
+     * @p current_ri into @p vec_ki, update @p solution with
+     * @p factor_solution and write the argument of the next stage into
+     * @p next_ri. Since @p vec_ki is computed before @p next_ri is
+     * written, @p next_ri may be the same vector as @p current_ri.
+     */
+    void
+    compute_one_stage(
+      const std::function<VectorType(const double, const VectorType &)> &f,
+      const double                                                       t,
+      const double      factor_solution,
+      const double      factor_ai,
+      const VectorType &current_ri,
+      VectorType &      vec_ki,
+      VectorType &      solution,
+      VectorType &      next_ri) const;
+
+    /**
+     * Subdiagonal entries $a_i$ of the Butcher tableau. The weights and
+     * nodes are stored in RungeKutta::b and RungeKutta::c.
+     */
+    std::vector<double> ai;
+
+    /**
+     * Status structure of the object.
+     */
+    Status status;
+  };
+
+
+
   /**
    * This class is derived from RungeKutta and implement the implicit methods.
    * This class works only for Diagonal Implicit Runge-Kutta (DIRK) methods.
@@ -471,6 +668,215 @@ namespace TimeStepping
 
 
 
+  /**
+   * This class implements implicit-explicit (IMEX) additive Runge-Kutta
+   * methods for equations of the form
+   * $ \frac{\partial y}{\partial t} = f_E(t,y) + f_I(t,y) $, where the
+   * non-stiff part $f_E$ (e.g. advection) is integrated explicitly and the
+   * stiff part $f_I$ (e.g. diffusion) implicitly. The methods are those of
+   * Ascher, Ruuth, and Spiteri (Appl. Numer. Math. 25:151-167, 1997), whose
+   * implicit tableaux are singly diagonally implicit and stiffly accurate.
+   *
+   * Each implicit stage requires the solution of
+   * $ Y - \tau f_I(t_i, Y) = r_i $ for a stage-dependent $\tau$, which is
+   * done by Newton's method with the user-provided function
+   * <code>id_minus_tau_J_inverse</code> that applies
+   * $(I-\tau J_I)^{-1}$, where $J_I$ is the Jacobian of $f_I$. For a linear
+   * $f_I$, the first Newton step already yields the solution, so that each
+   * implicit stage amounts to one application of this function, e.g. a
+   * matrix-free iterative solve. All operations work directly on the
+   * given vector type, and the stage vectors are kept between time steps.
+   */
+  template <typename VectorType>
+  class ImplicitExplicitRungeKutta : public TimeStepping<VectorType>
+  {
+  public:
+    /**
+     * Default constructor. initialize(runge_kutta_method) needs to be called
+     * before the object can be used.
+     */
+    ImplicitExplicitRungeKutta() = default;
+
+    /**
+     * Constructor. This function calls initialize(runge_kutta_method) and
+     * initializes the maximum number of iterations and the tolerance of the
+     * Newton solver used in the implicit stages.
+     */
+    ImplicitExplicitRungeKutta(const runge_kutta_method method,
+                               const unsigned int       max_it    = 100,
+                               const double             tolerance = 1e-6);
+
+    /**
+     * Initialize the IMEX Runge-Kutta method.
+     */
+    void
+    initialize(const runge_kutta_method method);
+
+    /**
+     * This function is used to advance from time @p t to t+ @p delta_t.
+     * @p F needs to contain exactly two functions, namely the explicitly
+     * treated part $f_E$ followed by the implicitly treated part $f_I$.
+     * @p J_inverse needs to contain exactly one function that computes
+     * $(I-\tau J_I)^{-1}$ applied to a vector, see the function below.
+     * This function returns the time at the end of the time step.
+     */
+    double
+    evolve_one_time_step(
+      std::vector<std::function<VectorType(const double, const VectorType &)>>
+        &                                                             F,
+      std::vector<std::function<
+        VectorType(const double, const double, const VectorType &)>> &J_inverse,
+      double                                                          t,
+      double                                                          delta_t,
+      VectorType &y) override;
+
+    /**
+     * This function is used to advance from time @p t to t+ @p delta_t.
+     * @p f_explicit and @p f_implicit are the functions $f_E(t,y)$ and
+     * $f_I(t,y)$, whose input parameters are the time t and the vector y and
+     * whose output is the value of the function at this point.
+     * @p id_minus_tau_J_inverse is a function that computes
+     * $(I-\tau J_I)^{-1}$ applied to a vector, where $I$ is the identity
+     * matrix, $\tau$ is given, and $J_I$ is the Jacobian of $f_I$. Its
+     * input parameters are the time, $\tau$, and the vector. This function
+     * returns the time at the end of the time step.
+     */
+    double
+    evolve_one_time_step(
+      const std::function<VectorType(const double, const VectorType &)>
+        &f_explicit,
+      const std::function<VectorType(const double, const VectorType &)>
+        &f_implicit,
+      const std::function<
+        VectorType(const double, const double, const VectorType &)>
+        &         id_minus_tau_J_inverse,
+      double      t,
+      double      delta_t,
+      VectorType &y);
+
+    /**
+     * Set the maximum number of iterations and the tolerance used by the
+     * Newton solver.
+     */
+    void
+    set_newton_solver_parameters(const unsigned int max_it,
+                                 const double       tolerance);
+
+    /**
+     * Deallocate the stage vectors that the object keeps between time steps.
+     * This function needs to be called if the layout of the solution vector
+     * changes without a change of its size.
+     */
+    void
+    free_memory();
+
+    /**
+     * Structure that stores the name of the method, and the largest number
+     * of Newton iterations and the largest norm of the residual when exiting
+     * the Newton solver over all implicit stages of the last time step.
+     */
+    struct Status : public TimeStepping<VectorType>::Status
+    {
+      Status()
+        : method(invalid)
+        , n_iterations(numbers::invalid_unsigned_int)
+        , norm_residual(numbers::signaling_nan<double>())
+      {}
+
+      runge_kutta_method method;
+      unsigned int       n_iterations;
+      double             norm_residual;
+    };
+
+    /**
+     * Return the status of the current object.
+     */
+    const Status &
+    get_status() const override;
+
+  private:
+    /**
+     * Solve the equation $ Y - \tau f_I(t, Y) = r $ of an implicit stage by
+     * Newton's method, starting from $Y = r$. On return, @p y contains the
+     * solution and @p f_implicit_stage the value $f_I(t, Y)$.
+     */
+    void
+    newton_solve(
+      const std::function<VectorType(const double, const VectorType &)>
+        &f_implicit,
+      const std::function<
+        VectorType(const double, const double, const VectorType &)>
+        &               id_minus_tau_J_inverse,
+      const double      t,
+      const double      tau,
+      const VectorType &r,
+      VectorType &      y,
+      VectorType &      f_implicit_stage);
+
+    /**
+     * Number of stages of the method.
+     */
+    unsigned int n_stages;
+
+    /**
+     * Butcher tableau of the explicit part, strictly lower triangular.
+     */
+    std::vector<std::vector<double>> a_explicit;
+
+    /**
+     * Butcher tableau of the implicit part, lower triangular.
+     */
+    std::vector<std::vector<double>> a_implicit;
+
+    /**
+     * Weights of the explicit part.
+     */
+    std::vector<double> b_explicit;
+
+    /**
+     * Weights of the implicit part.
+     */
+    std::vector<double> b_implicit;
+
+    /**
+     * Nodes, which coincide for both parts.
+     */
+    std::vector<double> c;
+
+    /**
+     * Maximum number of iterations of the Newton solver.
+     */
+    unsigned int max_it;
+
+    /**
+     * Tolerance of the Newton solver.
+     */
+    double tolerance;
+
+    /**
+     * The values of $f_E$ in each stage, kept between time steps.
+     */
+    std::vector<VectorType> f_explicit_stages;
+
+    /**
+     * The values of $f_I$ in each stage, kept between time steps.
+     */
+    std::vector<VectorType> f_implicit_stages;
+
+    /**
+     * Work vectors for the right hand side and the solution of each stage,
+     * and for the residual of the Newton solver.
+     */
+    std::vector<VectorType> work_vectors;
+
+    /**
+     * Status structure of the object.
+     */
+    Status status;
+  };
+
+
+
   /**
    * This is class is derived from RungeKutta and implement embedded explicit
    * methods.
@@ -509,7 +915,14 @@ namespace TimeStepping
     }
 
     /**
-     * If necessary, deallocate memory allocated by the object.
+     * Deallocate the vectors that the object keeps between time steps.
+     *
+     * To avoid allocating memory in every call of evolve_one_time_step(),
+     * the stage vectors and the auxiliary vectors of the method are kept and
+     * reused as long as the size of the solution vector does not change. If
+     * the layout of the solution vector changes without a change of its
+     * size, e.g. after repartitioning a distributed mesh, this function
+     * needs to be called before the next time step.
      */
     void
     free_memory();
@@ -595,9 +1008,16 @@ namespace TimeStepping
     compute_stages(
       const std::function<VectorType(const double, const VectorType &)> &f,
       const double                                                       t,
-      const double             delta_t,
-      const VectorType &       y,
-      std::vector<VectorType> &f_stages);
+      const double      delta_t,
+      const VectorType &y,
+      const bool        first_stage_available);
+
+    /**
+     * Set up the vectors kept between time steps, unless they are already
+     * compatible with @p y.
+     */
+    void
+    reinit_work_vectors(const VectorType &y);
 
     /**
      * This parameter is the factor (>1) by which the time step is multiplied
@@ -650,10 +1070,29 @@ namespace TimeStepping
     std::vector<double> b2;
 
     /**
-     * If the last_same_as_first flag is set to true, the last stage is saved
-     * and reused as the first stage of the next time step.
+     * The stage vectors, kept between time steps. If the last_same_as_first
+     * flag is set to true, the last stage of a time step is moved to the
+     * front and reused as the first stage of the next time step.
+     */
+    std::vector<std::unique_ptr<VectorType>> f_stages;
+
+    /**
+     * Copy of the solution at the beginning of the time step, needed to
+     * restart the time step with a smaller step size.
+     */
+    std::unique_ptr<VectorType> old_y;
+
+    /**
+     * Work vector holding the argument of each stage, which is afterwards
+     * reused to accumulate the error estimate.
+     */
+    std::unique_ptr<VectorType> stage_argument;
+
+    /**
+     * Whether the first entry of f_stages holds the last stage of the
+     * previous time step, which is only used if last_same_as_first is true.
      */
-    VectorType *last_stage;
+    bool last_stage_available = false;
 
     /**
      * Status structure of the object.
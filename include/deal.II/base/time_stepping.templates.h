@@ -17,9 +17,13 @@
 #define dealii_time_stepping_templates_h
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/std_cxx14/memory.h>
 #include <deal.II/base/time_stepping.h>
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <utility>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -216,6 +220,270 @@ namespace TimeStepping
 
 
 
+  // ----------------------------------------------------------------------
+  // LowStorageRungeKutta
+  // ----------------------------------------------------------------------
+
+  template <typename VectorType>
+  LowStorageRungeKutta<VectorType>::LowStorageRungeKutta(
+    const runge_kutta_method method)
+  {
+    // virtual functions called in constructors and destructors never use the
+    // override in a derived class
+    // for clarity be explicit on which function is called
+    LowStorageRungeKutta<VectorType>::initialize(method);
+  }
+
+
+
+  template <typename VectorType>
+  void
+  LowStorageRungeKutta<VectorType>::initialize(const runge_kutta_method method)
+  {
+    status.method = method;
+
+    switch (method)
+      {
+        case (LOW_STORAGE_RK_STAGE3_ORDER3):
+          {
+            this->n_stages = 3;
+
+            this->b = {0.245170287303492,
+                       0.184896052186740,
+                       0.569933660509768};
+
+            ai = {0.755726351946097, 0.386954477304099};
+
+            break;
+          }
+        case (LOW_STORAGE_RK_STAGE5_ORDER4):
+          {
+            this->n_stages = 5;
+
+            this->b = {1153189308089. / 22510343858157.,
+                       1772645290293. / 4653164025191.,
+                       -1672844663538. / 4480602732383.,
+                       2114624349019. / 3568978502595.,
+                       5198255086312. / 14908931495163.};
+
+            ai = {970286171893. / 4311952581923.,
+                  6584761158862. / 12103376702013.,
+                  2251764453980. / 15575788980749.,
+                  26877169314380. / 34165994151039.};
+
+            break;
+          }
+        case (LOW_STORAGE_RK_STAGE7_ORDER4):
+          {
+            this->n_stages = 7;
+
+            this->b = {0.0941840925477795334,
+                       0.149683694803496998,
+                       0.285204742060440058,
+                       -0.122201846148053668,
+                       0.0605151571191401122,
+                       0.345986987898399296,
+                       0.186627171718797670};
+            // the scheme is given in terms of the differences between the
+            // subdiagonal entries and the weights
+            ai = {0.241566650129646868 + this->b[0],
+                  0.0423866513027719953 + this->b[1],
+                  0.215602732678803776 + this->b[2],
+                  0.232328007537583987 + this->b[3],
+                  0.256223412574146438 + this->b[4],
+                  0.0978694102142697230 + this->b[5]};
+
+            break;
+          }
+        case (LOW_STORAGE_RK_STAGE9_ORDER5):
+          {
+            this->n_stages = 9;
+
+            this->b = {2274579626619. / 23610510767302.,
+                       693987741272. / 12394497460941.,
+                       -347131529483. / 15096185902911.,
+                       1144057200723. / 32081666971178.,
+                       1562491064753. / 11797114684756.,
+                       13113619727965. / 44346030145118.,
+                       393957816125. / 7825732611452.,
+                       720647959663. / 6565743875477.,
+                       3559252274877. / 14424734981077.};
+
+            ai = {1107026461565. / 5417078080134.,
+                  38141181049399. / 41724347789894.,
+                  493273079041. / 11940823631197.,
+                  1851571280403. / 6147804934346.,
+                  11782306865191. / 62590030070788.,
+                  9452544825720. / 13648368537481.,
+                  4435885630781. / 26285702406235.,
+                  2357909744247. / 11371140753790.};
+
+            break;
+          }
+        default:
+          {
+            AssertThrow(false,
+                        ExcMessage(
+                          "Unimplemented low-storage Runge-Kutta method."));
+          }
+      }
+
+    // the nodes are the row sums of the Butcher tableau, in which stage i
+    // uses the weights b_j for all j < i-1 and a_{i-1} on the subdiagonal
+    this->c.assign(this->n_stages, 0.);
+    double sum_b = 0.;
+    for (unsigned int i = 1; i < this->n_stages; ++i)
+      {
+        this->c[i] = sum_b + ai[i - 1];
+        sum_b += this->b[i - 1];
+      }
+  }
+
+
+
+  template <typename VectorType>
+  double
+  LowStorageRungeKutta<VectorType>::evolve_one_time_step(
+    const std::function<VectorType(const double, const VectorType &)> &f,
+    const std::function<
+      VectorType(const double, const double, const VectorType &)>
+      & /*id_minus_tau_J_inverse*/,
+    double      t,
+    double      delta_t,
+    VectorType &y)
+  {
+    VectorType vec_ri(y), vec_ki(y);
+    return evolve_one_time_step(f, t, delta_t, y, vec_ri, vec_ki);
+  }
+
+
+
+  template <typename VectorType>
+  double
+  LowStorageRungeKutta<VectorType>::evolve_one_time_step(
+    const std::function<VectorType(const double, const VectorType &)> &f,
+    double                                                             t,
+    double                                                             delta_t,
+    VectorType &solution,
+    VectorType &vec_ri,
+    VectorType &vec_ki)
+  {
+    // The first stage is evaluated at the solution itself. In all other
+    // stages, vec_ri holds the argument of the current stage and is then
+    // overwritten by the argument of the next one.
+    compute_one_stage(f,
+                      t,
+                      this->b[0] * delta_t,
+                      ai[0] * delta_t,
+                      solution,
+                      vec_ki,
+                      solution,
+                      vec_ri);
+    for (unsigned int stage = 1; stage < this->n_stages; ++stage)
+      {
+        const double factor_ai =
+          (stage == this->n_stages - 1) ? 0. : ai[stage] * delta_t;
+        compute_one_stage(f,
+                          t + this->c[stage] * delta_t,
+                          this->b[stage] * delta_t,
+                          factor_ai,
+                          vec_ri,
+                          vec_ki,
+                          solution,
+                          vec_ri);
+      }
+
+    return (t + delta_t);
+  }
+
+
+
+  template <typename VectorType>
+  double
+  LowStorageRungeKutta<VectorType>::evolve_one_time_step(
+    const std::function<void(const double,
+                             const double,
+                             const double,
+                             const VectorType &,
+                             VectorType &,
+                             VectorType &)> &stage_update,
+    double                                   t,
+    double                                   delta_t,
+    VectorType &                             solution,
+    VectorType &                             vec_ri,
+    VectorType &                             vec_ki)
+  {
+    vec_ri = solution;
+
+    VectorType *current_ri = &vec_ri;
+    VectorType *next_ri    = &vec_ki;
+    for (unsigned int stage = 0; stage < this->n_stages; ++stage)
+      {
+        const double factor_ai =
+          (stage == this->n_stages - 1) ? 0. : ai[stage] * delta_t;
+        stage_update(t + this->c[stage] * delta_t,
+                     this->b[stage] * delta_t,
+                     factor_ai,
+                     *current_ri,
+                     *next_ri,
+                     solution);
+        std::swap(current_ri, next_ri);
+      }
+
+    return (t + delta_t);
+  }
+
+
+
+  template <typename VectorType>
+  void
+  LowStorageRungeKutta<VectorType>::get_coefficients(
+    std::vector<double> &a,
+    std::vector<double> &b,
+    std::vector<double> &c) const
+  {
+    a = ai;
+    b = this->b;
+    c = this->c;
+  }
+
+
+
+  template <typename VectorType>
+  const typename LowStorageRungeKutta<VectorType>::Status &
+  LowStorageRungeKutta<VectorType>::get_status() const
+  {
+    return status;
+  }
+
+
+
+  template <typename VectorType>
+  void
+  LowStorageRungeKutta<VectorType>::compute_one_stage(
+    const std::function<VectorType(const double, const VectorType &)> &f,
+    const double                                                       t,
+    const double      factor_solution,
+    const double      factor_ai,
+    const VectorType &current_ri,
+    VectorType &      vec_ki,
+    VectorType &      solution,
+    VectorType &      next_ri) const
+  {
+    vec_ki = f(t, current_ri);
+
+    // write the next argument before updating the solution, since it is
+    // based on the solution without the contribution of this stage
+    if (factor_ai != 0.)
+      {
+        next_ri = solution;
+        next_ri.sadd(1., factor_ai, vec_ki);
+      }
+    solution.sadd(1., factor_solution, vec_ki);
+  }
+
+
+
   // ----------------------------------------------------------------------
   // ImplicitRungeKutta
   // ----------------------------------------------------------------------
@@ -440,6 +708,284 @@ namespace TimeStepping
 
 
 
+  // ----------------------------------------------------------------------
+  // ImplicitExplicitRungeKutta
+  // ----------------------------------------------------------------------
+
+  template <typename VectorType>
+  ImplicitExplicitRungeKutta<VectorType>::ImplicitExplicitRungeKutta(
+    const runge_kutta_method method,
+    const unsigned int       max_it,
+    const double             tolerance)
+    : max_it(max_it)
+    , tolerance(tolerance)
+  {
+    initialize(method);
+  }
+
+
+
+  template <typename VectorType>
+  void
+  ImplicitExplicitRungeKutta<VectorType>::initialize(
+    const runge_kutta_method method)
+  {
+    status.method = method;
+
+    switch (method)
+      {
+        case (IMEX_EULER):
+          {
+            // forward Euler for the explicit part, backward Euler for the
+            // implicit part, with an explicit first stage
+            n_stages   = 2;
+            a_explicit = {{0., 0.}, {1., 0.}};
+            a_implicit = {{0., 0.}, {0., 1.}};
+            b_explicit = {1., 0.};
+            b_implicit = {0., 1.};
+
+            break;
+          }
+        case (IMEX_ARS_222):
+          {
+            const double gamma = 1. - 1. / std::sqrt(2.);
+            const double delta = 1. - 1. / (2. * gamma);
+
+            n_stages   = 3;
+            a_explicit = {{0., 0., 0.},
+                          {gamma, 0., 0.},
+                          {delta, 1. - delta, 0.}};
+            a_implicit = {{0., 0., 0.},
+                          {0., gamma, 0.},
+                          {0., 1. - gamma, gamma}};
+            b_explicit = {delta, 1. - delta, 0.};
+            b_implicit = {0., 1. - gamma, gamma};
+
+            break;
+          }
+        case (IMEX_ARS_443):
+          {
+            n_stages   = 5;
+            a_explicit = {{0., 0., 0., 0., 0.},
+                          {1. / 2., 0., 0., 0., 0.},
+                          {11. / 18., 1. / 18., 0., 0., 0.},
+                          {5. / 6., -5. / 6., 1. / 2., 0., 0.},
+                          {1. / 4., 7. / 4., 3. / 4., -7. / 4., 0.}};
+            a_implicit = {{0., 0., 0., 0., 0.},
+                          {0., 1. / 2., 0., 0., 0.},
+                          {0., 1. / 6., 1. / 2., 0., 0.},
+                          {0., -1. / 2., 1. / 2., 1. / 2., 0.},
+                          {0., 3. / 2., -3. / 2., 1. / 2., 1. / 2.}};
+            b_explicit = {1. / 4., 7. / 4., 3. / 4., -7. / 4., 0.};
+            b_implicit = {0., 3. / 2., -3. / 2., 1. / 2., 1. / 2.};
+
+            break;
+          }
+        default:
+          {
+            AssertThrow(false,
+                        ExcMessage("Unimplemented IMEX Runge-Kutta method."));
+          }
+      }
+
+    // the nodes are the row sums of the tableaux, which coincide for the
+    // explicit and the implicit part of the methods above
+    c.resize(n_stages);
+    for (unsigned int i = 0; i < n_stages; ++i)
+      {
+        c[i] = 0.;
+        for (unsigned int j = 0; j < n_stages; ++j)
+          c[i] += a_explicit[i][j];
+      }
+
+    free_memory();
+  }
+
+
+
+  template <typename VectorType>
+  double
+  ImplicitExplicitRungeKutta<VectorType>::evolve_one_time_step(
+    std::vector<std::function<VectorType(const double, const VectorType &)>> &F,
+    std::vector<
+      std::function<VectorType(const double, const double, const VectorType &)>>
+      &         J_inverse,
+    double      t,
+    double      delta_t,
+    VectorType &y)
+  {
+    AssertThrow(F.size() == 2,
+                ExcMessage("IMEX Runge-Kutta methods require two functions, "
+                           "the explicit and the implicit part."));
+    AssertThrow(J_inverse.size() == 1,
+                ExcMessage("IMEX Runge-Kutta methods require one function to "
+                           "solve the implicit stages."));
+
+    return evolve_one_time_step(F[0], F[1], J_inverse[0], t, delta_t, y);
+  }
+
+
+
+  template <typename VectorType>
+  double
+  ImplicitExplicitRungeKutta<VectorType>::evolve_one_time_step(
+    const std::function<VectorType(const double, const VectorType &)>
+      &f_explicit,
+    const std::function<VectorType(const double, const VectorType &)>
+      &f_implicit,
+    const std::function<
+      VectorType(const double, const double, const VectorType &)>
+      &         id_minus_tau_J_inverse,
+    double      t,
+    double      delta_t,
+    VectorType &y)
+  {
+    if (f_explicit_stages.size() != n_stages ||
+        f_explicit_stages[0].size() != y.size())
+      {
+        f_explicit_stages.assign(n_stages, y);
+        f_implicit_stages.assign(n_stages, y);
+        work_vectors.assign(3, y);
+      }
+    VectorType &stage_rhs      = work_vectors[0];
+    VectorType &stage_solution = work_vectors[1];
+
+    status.n_iterations  = 0;
+    status.norm_residual = 0.;
+
+    for (unsigned int i = 0; i < n_stages; ++i)
+      {
+        const double stage_t = t + c[i] * delta_t;
+
+        // The right hand side of the stage is built from the solution at
+        // the beginning of the time step and the previous stages.
+        stage_rhs = y;
+        for (unsigned int j = 0; j < i; ++j)
+          {
+            if (a_explicit[i][j] != 0.)
+              stage_rhs.sadd(1.,
+                             delta_t * a_explicit[i][j],
+                             f_explicit_stages[j]);
+            if (a_implicit[i][j] != 0.)
+              stage_rhs.sadd(1.,
+                             delta_t * a_implicit[i][j],
+                             f_implicit_stages[j]);
+          }
+
+        const VectorType *stage_value = &stage_rhs;
+        if (a_implicit[i][i] != 0.)
+          {
+            newton_solve(f_implicit,
+                         id_minus_tau_J_inverse,
+                         stage_t,
+                         delta_t * a_implicit[i][i],
+                         stage_rhs,
+                         stage_solution,
+                         f_implicit_stages[i]);
+            stage_value = &stage_solution;
+          }
+        else
+          f_implicit_stages[i] = f_implicit(stage_t, stage_rhs);
+
+        // Only evaluate the explicit part if it is used later on. This
+        // skips the last stage of the stiffly accurate methods.
+        bool explicit_stage_needed = (b_explicit[i] != 0.);
+        for (unsigned int k = i + 1; k < n_stages; ++k)
+          explicit_stage_needed |= (a_explicit[k][i] != 0.);
+        if (explicit_stage_needed)
+          f_explicit_stages[i] = f_explicit(stage_t, *stage_value);
+      }
+
+    // Linear combinations of the stages.
+    for (unsigned int i = 0; i < n_stages; ++i)
+      {
+        if (b_explicit[i] != 0.)
+          y.sadd(1., delta_t * b_explicit[i], f_explicit_stages[i]);
+        if (b_implicit[i] != 0.)
+          y.sadd(1., delta_t * b_implicit[i], f_implicit_stages[i]);
+      }
+
+    return (t + delta_t);
+  }
+
+
+
+  template <typename VectorType>
+  void
+  ImplicitExplicitRungeKutta<VectorType>::newton_solve(
+    const std::function<VectorType(const double, const VectorType &)>
+      &f_implicit,
+    const std::function<
+      VectorType(const double, const double, const VectorType &)>
+      &               id_minus_tau_J_inverse,
+    const double      t,
+    const double      tau,
+    const VectorType &r,
+    VectorType &      y,
+    VectorType &      f_implicit_stage)
+  {
+    // Starting from y = r, the residual y - r - tau f_I(t,y) reduces to
+    // -tau f_I(t,r), so the first step does not need the residual vector.
+    y                = r;
+    f_implicit_stage = f_implicit(t, y);
+    y.sadd(1., tau, id_minus_tau_J_inverse(t, tau, f_implicit_stage));
+
+    VectorType & residual      = work_vectors[2];
+    unsigned int n_iterations  = 1;
+    double       norm_residual = 0.;
+    while (true)
+      {
+        f_implicit_stage = f_implicit(t, y);
+
+        residual = y;
+        residual.sadd(1., -1., r);
+        residual.sadd(1., -tau, f_implicit_stage);
+        norm_residual = residual.l2_norm();
+        if (norm_residual < tolerance || n_iterations >= max_it)
+          break;
+
+        y.sadd(1., -1., id_minus_tau_J_inverse(t, tau, residual));
+        ++n_iterations;
+      }
+
+    status.n_iterations  = std::max(status.n_iterations, n_iterations);
+    status.norm_residual = std::max(status.norm_residual, norm_residual);
+  }
+
+
+
+  template <typename VectorType>
+  void
+  ImplicitExplicitRungeKutta<VectorType>::set_newton_solver_parameters(
+    const unsigned int max_it_,
+    const double       tolerance_)
+  {
+    max_it    = max_it_;
+    tolerance = tolerance_;
+  }
+
+
+
+  template <typename VectorType>
+  void
+  ImplicitExplicitRungeKutta<VectorType>::free_memory()
+  {
+    f_explicit_stages.clear();
+    f_implicit_stages.clear();
+    work_vectors.clear();
+  }
+
+
+
+  template <typename VectorType>
+  const typename ImplicitExplicitRungeKutta<VectorType>::Status &
+  ImplicitExplicitRungeKutta<VectorType>::get_status() const
+  {
+    return status;
+  }
+
+
+
   // ----------------------------------------------------------------------
   // EmbeddedExplicitRungeKutta
   // ----------------------------------------------------------------------
@@ -460,7 +1006,7 @@ namespace TimeStepping
     , refine_tol(refine_tol)
     , coarsen_tol(coarsen_tol)
     , last_same_as_first(false)
-    , last_stage(nullptr)
+    , last_stage_available(false)
     , status{}
   {
     // virtual functions called in constructors and destructors never use the
@@ -478,6 +1024,9 @@ namespace TimeStepping
   {
     status.method = method;
 
+    // the vectors kept from a previous method can not be reused
+    free_memory();
+
     switch (method)
       {
         case (HEUN_EULER):
@@ -718,10 +1267,29 @@ namespace TimeStepping
   void
   EmbeddedExplicitRungeKutta<VectorType>::free_memory()
   {
-    if (last_stage != nullptr)
-      delete last_stage;
+    f_stages.clear();
+    old_y.reset();
+    stage_argument.reset();
+    last_stage_available = false;
+  }
 
-    last_stage = nullptr;
+
+
+  template <typename VectorType>
+  void
+  EmbeddedExplicitRungeKutta<VectorType>::reinit_work_vectors(
+    const VectorType &y)
+  {
+    if (f_stages.size() == this->n_stages && old_y != nullptr &&
+        old_y->size() == y.size())
+      return;
+
+    f_stages.resize(this->n_stages);
+    for (auto &stage : f_stages)
+      stage = std_cxx14::make_unique<VectorType>(y);
+    old_y                = std_cxx14::make_unique<VectorType>(y);
+    stage_argument       = std_cxx14::make_unique<VectorType>(y);
+    last_stage_available = false;
   }
 
 
@@ -750,27 +1318,39 @@ namespace TimeStepping
     double                                                             delta_t,
     VectorType &                                                       y)
   {
-    bool                    done       = false;
-    unsigned int            count      = 0;
-    double                  error_norm = 0.;
-    VectorType              old_y(y);
-    VectorType              error(y);
-    std::vector<VectorType> f_stages(this->n_stages, y);
+    reinit_work_vectors(y);
+
+    bool         done       = false;
+    unsigned int count      = 0;
+    double       error_norm = 0.;
+    *old_y                  = y;
+
+    // The first stage only depends on the solution at the beginning of the
+    // time step, so it needs to be computed at most once, even if the time
+    // step is repeated with a smaller step size.
+    bool first_stage_available = last_same_as_first && last_stage_available;
 
     while (!done)
       {
-        error = 0.;
-        y     = old_y;
+        y = *old_y;
         // Compute the different stages needed.
-        compute_stages(f, t, delta_t, y, f_stages);
-
-        for (unsigned int i = 0; i < this->n_stages; ++i)
+        compute_stages(f, t, delta_t, y, first_stage_available);
+        first_stage_available = true;
+
+        // Update the solution and accumulate the difference to the embedded
+        // solution in the stage argument that is not needed anymore. The
+        // norm of the error is computed together with the last update.
+        VectorType &error = *stage_argument;
+        error             = 0.;
+        for (unsigned int i = 0; i + 1 < this->n_stages; ++i)
           {
-            y.sadd(1., delta_t * this->b1[i], f_stages[i]);
-            error.sadd(1., delta_t * (b2[i] - b1[i]), f_stages[i]);
+            y.sadd(1., delta_t * this->b1[i], *f_stages[i]);
+            error.sadd(1., delta_t * (b2[i] - b1[i]), *f_stages[i]);
           }
-
-        error_norm = error.l2_norm();
+        const unsigned int last = this->n_stages - 1;
+        y.sadd(1., delta_t * this->b1[last], *f_stages[last]);
+        error_norm = std::sqrt(std::abs(error.add_and_dot(
+          delta_t * (b2[last] - b1[last]), *f_stages[last], error)));
         // Check if the norm of error is less than the coarsening tolerance
         if (error_norm < coarsen_tol)
           {
@@ -818,13 +1398,12 @@ namespace TimeStepping
         ++count;
       }
 
-    // Save the last stage if necessary
+    // Keep the last stage as the first one of the next time step, which
+    // only requires exchanging the pointers
     if (last_same_as_first == true)
       {
-        if (last_stage == nullptr)
-          last_stage = new VectorType(f_stages.back());
-        else
-          *last_stage = f_stages.back();
+        std::swap(f_stages.front(), f_stages.back());
+        last_stage_available = true;
       }
 
     status.n_iterations = count;
@@ -870,28 +1449,20 @@ namespace TimeStepping
     const double                                                       t,
     const double                                                       delta_t,
     const VectorType &                                                 y,
-    std::vector<VectorType> &                                          f_stages)
+    const bool first_stage_available)
   {
-    VectorType   Y(y);
-    unsigned int i = 0;
-
-    // If the last stage is the same as the first, we can skip the evaluation
-    // of the first stage.
-    if (last_same_as_first == true)
-      {
-        if (last_stage != nullptr)
-          {
-            f_stages[0] = *last_stage;
-            i           = 1;
-          }
-      }
+    VectorType &Y = *stage_argument;
 
-    for (; i < this->n_stages; ++i)
+    // If the first stage is already known, e.g. because the last stage of
+    // the previous time step is the same as the first, we can skip its
+    // evaluation.
+    for (unsigned int i = (first_stage_available ? 1 : 0); i < this->n_stages;
+         ++i)
       {
         Y = y;
         for (unsigned int j = 0; j < i; ++j)
-          Y.sadd(1.0, delta_t * this->a[i][j], f_stages[j]);
-        f_stages[i] = f(t + this->c[i] * delta_t, Y);
+          Y.sadd(1.0, delta_t * this->a[i][j], *f_stages[j]);
+        *f_stages[i] = f(t + this->c[i] * delta_t, Y);
       }
   }
 } // namespace TimeStepping
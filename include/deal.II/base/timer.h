@@ -20,16 +20,30 @@
 
 #include <deal.II/base/conditional_ostream.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/thread_local_storage.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
 
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
+// forward declaration
+namespace internal
+{
+  namespace TimerImplementation
+  {
+    class HardwareCounters;
+  }
+} // namespace internal
+
 /**
  * A clock, compatible with the <code>std::chrono</code> notion of a clock,
  * whose now() method returns a time point indicating the amount of CPU time
@@ -420,7 +434,6 @@ private:
 
 
 
-// TODO: The following class is not thread-safe
 /**
  * This class can be used to generate formatted output from time measurements
  * of different subsections in a program. It is possible to create several
@@ -574,6 +587,31 @@ private:
  * sure that we only generate output on a single processor. See the step-32,
  * step-40, and step-42 tutorial programs for this kind of usage of this class.
  *
+ *
+ * <h3>Nested sections and multithreading</h3>
+ *
+ * A section that is entered while another section is active is recorded as a
+ * child of the most recently entered active section, such that the sections
+ * form a tree. For example, if a multigrid solver times its smoother on each
+ * level within the section of the solver, the time spent in the smoother on
+ * each level can be seen in relation to the time of the whole solver. While
+ * print_summary() and get_summary_data() list the sections by name
+ * regardless of where they were entered, print_tree_summary() and
+ * get_tree_summary_data() show the tree.
+ *
+ * Each thread keeps its own list of active sections and accumulates its own
+ * times, so that entering and leaving sections from several threads at the
+ * same time does not need any synchronization, and the same section can be
+ * entered by several threads at the same time. Since the sections are nested
+ * per thread, a section entered by a worker thread, for example within
+ * WorkStream::run(), appears on the outermost level of the tree rather than
+ * within the section of the thread that started the work. The data of all
+ * threads is merged when printing the summary, with the times of the threads
+ * added up. Consequently, the summaries should only be generated while no
+ * other thread is within a section of this object. The timers using an MPI communicator
+ * (see above) must only be used from one thread on each process, since they
+ * communicate when a section is entered and left.
+ *
  * @ingroup utilities
  * @author M. Kronbichler, 2009.
  */
@@ -691,6 +729,36 @@ public:
     cpu_and_wall_times_grouped
   };
 
+  /**
+   * An enumeration of the hardware performance counters that can be
+   * recorded for each section, see enable_hardware_counters().
+   */
+  enum HardwareCounter
+  {
+    /**
+     * The number of CPU cycles.
+     */
+    cpu_cycles,
+    /**
+     * The number of instructions retired.
+     */
+    instructions,
+    /**
+     * The number of accesses to the last level cache.
+     */
+    cache_references,
+    /**
+     * The number of misses in the last level cache, i.e., the number of
+     * cache lines that had to be loaded from main memory.
+     */
+    cache_misses
+  };
+
+  /**
+   * The number of counters in the HardwareCounter enumeration.
+   */
+  static constexpr unsigned int n_hardware_counters = 4;
+
   /**
    * Constructor.
    *
@@ -816,6 +884,14 @@ public:
   std::map<std::string, double>
   get_summary_data(const OutputData kind) const;
 
+  /**
+   * Get a map with the collected data of the specified type for each node of
+   * the tree of nested sections, identified by the names of the sections on
+   * the path from the root of the tree to the node.
+   */
+  std::map<std::vector<std::string>, double>
+  get_tree_summary_data(const OutputData kind) const;
+
   /**
    * Print a formatted table that summarizes the time consumed in the various
    * sections.
@@ -823,6 +899,65 @@ public:
   void
   print_summary() const;
 
+  /**
+   * Print a formatted table that summarizes the wall time consumed in the
+   * tree of nested sections. Each section is listed below the section it
+   * was entered in, and its time is given relative to the time of that
+   * section.
+   */
+  void
+  print_tree_summary() const;
+
+  /**
+   * Start recording the hardware performance counters listed in the
+   * HardwareCounter enumeration for all sections entered from now on. The
+   * counters are read when entering and leaving a section, and the
+   * differences are accumulated per section, in the same way as the times.
+   *
+   * The counters are obtained from the perf_event interface of the Linux
+   * kernel and count the events of the thread that calls this function, as
+   * well as of the threads that it creates afterwards. They are not
+   * available on other operating systems, or if the kernel does not permit
+   * access to them (see the file
+   * <code>/proc/sys/kernel/perf_event_paranoid</code>). In these cases, the
+   * function returns false and no counters are recorded.
+   *
+   * @return Whether the counters could be set up.
+   */
+  bool
+  enable_hardware_counters();
+
+  /**
+   * Return whether hardware performance counters are being recorded, i.e.,
+   * whether enable_hardware_counters() has been called successfully.
+   */
+  bool
+  hardware_counters_enabled() const;
+
+  /**
+   * Get a map with the accumulated value of the given hardware counter for
+   * each subsection. The values are zero if no counters are recorded.
+   */
+  std::map<std::string, double>
+  get_hardware_counter_data(const HardwareCounter counter) const;
+
+  /**
+   * Print a table with the minimum, average, and maximum values over all
+   * processes in @p mpi_comm of the hardware counters recorded for each
+   * section, in the same style as the summary of print_summary(). In
+   * addition, the table lists the number of instructions per cycle and an
+   * estimate of the bandwidth from main memory, computed from the number of
+   * last level cache misses times the size of a cache line of 64 bytes
+   * divided by the wall time of the section. Since hardware prefetching is
+   * not seen by this counter on all architectures, the estimate is a lower
+   * bound of the actual memory traffic.
+   *
+   * This function has to be called on all processes in @p mpi_comm, and all
+   * of them need to have the same sections.
+   */
+  void
+  print_hardware_counter_statistics(const MPI_Comm mpi_comm) const;
+
   /**
    * By calling this function, all output can be disabled. This function
    * together with enable_output() can be useful if one wants to control the
@@ -875,12 +1010,65 @@ private:
     double       total_cpu_time;
     double       total_wall_time;
     unsigned int n_calls;
+
+    /**
+     * The values of the hardware counters when the section was entered last.
+     */
+    std::array<std::uint64_t, n_hardware_counters> counters_at_start;
+
+    /**
+     * The accumulated hardware counter values of all calls.
+     */
+    std::array<std::uint64_t, n_hardware_counters> total_counters;
+
+    /**
+     * Add the accumulated times, calls, and counter values of @p other to
+     * the ones of this object.
+     */
+    void
+    accumulate(const Section &other);
   };
 
   /**
-   * A list of all the sections and their information.
+   * The sections entered and timed by one thread.
    */
-  std::map<std::string, Section> sections;
+  struct ThreadData
+  {
+    /**
+     * The sections that have been entered and not left, each given by its
+     * path, i.e., the names of the sections that were active when the
+     * section was entered followed by its own name. The list is kept in the
+     * order in which sections have been entered, but elements may be removed
+     * in the middle if an argument is given to the leave_subsection()
+     * function.
+     */
+    std::list<std::vector<std::string>> active_sections;
+
+    /**
+     * The information about each node of the tree of sections, identified
+     * by its path.
+     */
+    std::map<std::vector<std::string>, Section> sections;
+  };
+
+  /**
+   * The sections of each thread. The object is mutable since the summary
+   * functions need to merge the data of all threads.
+   */
+  mutable Threads::ThreadLocalStorage<ThreadData> thread_data;
+
+  /**
+   * Return the tree of sections with the data of all threads added up.
+   */
+  std::map<std::vector<std::string>, Section>
+  merged_section_tree() const;
+
+  /**
+   * Return the sections by their name, with the data of all nodes of the
+   * tree of sections with the same name and of all threads added up.
+   */
+  std::map<std::string, Section>
+  merged_sections() const;
 
   /**
    * The stream object to which we are to output.
@@ -894,21 +1082,19 @@ private:
   bool output_is_enabled;
 
   /**
-   * A list of the sections that have been entered and not exited. The list is
-   * kept in the order in which sections have been entered, but elements may
-   * be removed in the middle if an argument is given to the exit_section()
-   * function.
+   * mpi communicator
    */
-  std::list<std::string> active_sections;
+  MPI_Comm mpi_communicator;
 
   /**
-   * mpi communicator
+   * The hardware performance counters, if enabled.
    */
-  MPI_Comm mpi_communicator;
+  std::unique_ptr<internal::TimerImplementation::HardwareCounters>
+    hardware_counters;
 
   /**
-   * A lock that makes sure that this class gives reasonable results even when
-   * used with several threads.
+   * A lock that serializes the output generated when leaving a section and
+   * the setup of the hardware counters.
    */
   Threads::Mutex mutex;
 };
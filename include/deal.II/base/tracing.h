@@ -0,0 +1,203 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_tracing_h
+#define dealii_tracing_h
+
+#include <deal.II/base/config.h>
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * A namespace for a lightweight event tracer that records when the hot paths
+ * of the library (such as MatrixFree loops, the vector exchange of
+ * Utilities::MPI::Partitioner, iterations of SolverCG, WorkStream::run(), or
+ * the output functions of DataOutInterface) are entered and left. The
+ * recorded events can be written in the JSON trace format understood by the
+ * Chrome trace viewer (<code>chrome://tracing</code>) and by Perfetto
+ * (<code>ui.perfetto.dev</code>), which shows them on a time line per thread
+ * and per MPI process. This helps to diagnose, for example, load imbalance
+ * or communication stalls in production runs without the need to rebuild
+ * the program for an external profiler.
+ *
+ * Tracing is disabled by default, in which case an instrumentation point
+ * costs a single check of an atomic flag. It is switched on at run time by
+ * calling enable():
+ * @code
+ *   Tracing::enable();
+ *   ... // run the program
+ *   std::ofstream out("trace-" +
+ *                     std::to_string(Utilities::MPI::this_mpi_process(
+ *                       MPI_COMM_WORLD)) + ".json");
+ *   Tracing::write_chrome_trace(out);
+ * @endcode
+ * Each thread records its events into a ring buffer of its own, so that
+ * recording does not need any synchronization between threads, and only the
+ * most recent events are kept if a thread records more events than the
+ * buffer holds.
+ *
+ * User code can add its own instrumentation points with the Scope class.
+ *
+ * @ingroup threads
+ */
+namespace Tracing
+{
+  /**
+   * Start recording events. Each thread keeps the most recent
+   * @p events_per_thread events. The capacity applies to the buffers of
+   * threads that record their first event after this call; buffers that
+   * already exist keep their size.
+   */
+  void
+  enable(const unsigned int events_per_thread = 65536);
+
+  /**
+   * Stop recording events. The events recorded so far are kept and can
+   * still be written by write_chrome_trace().
+   */
+  void
+  disable();
+
+  /**
+   * Return whether events are currently recorded.
+   */
+  inline bool
+  is_enabled();
+
+  /**
+   * Delete all recorded events.
+   *
+   * This function must not be called while other threads record events.
+   */
+  void
+  clear();
+
+  /**
+   * Write all recorded events of the current process to @p out in the JSON
+   * trace event format of the Chrome trace viewer. The events are tagged
+   * with the rank of the current process in MPI_COMM_WORLD as the process
+   * id, so that the traces written by the individual processes of a
+   * parallel program can be combined into a single trace.
+   *
+   * This function must not be called while other threads record events.
+   */
+  void
+  write_chrome_trace(std::ostream &out);
+
+  /**
+   * A class that records an event that starts when the object is created
+   * and ends when it is destroyed, i.e., the duration of the enclosing
+   * scope:
+   * @code
+   *   void my_function()
+   *   {
+   *     Tracing::Scope trace("my_function");
+   *     ...
+   *   }
+   * @endcode
+   * If tracing is disabled when the object is created, nothing is recorded.
+   */
+  class Scope
+  {
+  public:
+    /**
+     * Constructor. The @p name must point to a string with static storage
+     * duration, such as a string literal, since only the pointer is stored
+     * with the event.
+     */
+    explicit Scope(const char *name);
+
+    /**
+     * Destructor. Records the event.
+     */
+    ~Scope();
+
+    Scope(const Scope &) = delete;
+
+    Scope &
+    operator=(const Scope &) = delete;
+
+  private:
+    /**
+     * The name of the event, or nullptr if tracing was disabled when this
+     * object was created.
+     */
+    const char *const name;
+
+    /**
+     * The time stamp of the beginning of the event.
+     */
+    const std::uint64_t begin;
+  };
+
+
+
+  namespace internal
+  {
+    /**
+     * The flag queried by is_enabled().
+     */
+    extern std::atomic<bool> enabled;
+
+    /**
+     * Return a time stamp in nanoseconds.
+     */
+    std::uint64_t
+    now();
+
+    /**
+     * Record an event with the given name and time stamps in the buffer of
+     * the calling thread.
+     */
+    void
+    record_event(const char *        name,
+                 const std::uint64_t begin,
+                 const std::uint64_t end);
+  } // namespace internal
+
+
+
+  /* ---------------------- inline functions ------------------------ */
+
+
+  inline bool
+  is_enabled()
+  {
+    return internal::enabled.load(std::memory_order_relaxed);
+  }
+
+
+
+  inline Scope::Scope(const char *name)
+    : name(is_enabled() ? name : nullptr)
+    , begin(this->name != nullptr ? internal::now() : 0)
+  {}
+
+
+
+  inline Scope::~Scope()
+  {
+    if (name != nullptr)
+      internal::record_event(name, begin, internal::now());
+  }
+} // namespace Tracing
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
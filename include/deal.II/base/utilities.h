@@ -871,11 +871,32 @@ namespace Utilities
      * @param alignment The minimal alignment of the memory block, in bytes.
      * @param size The size of the memory block to be allocated, in bytes.
      *
+     * If huge pages have been enabled through use_huge_pages() and the
+     * requested block is at least as large as a huge page (2 MB), the block
+     * is aligned to the huge page size instead and the operating system is
+     * advised to back it by huge pages. This reduces the number of TLB misses
+     * when streaming through large vectors.
+     *
      * @note This function checks internally for error codes, rather than
      * leaving this task to the calling site.
      */
     void
     posix_memalign(void **memptr, std::size_t alignment, std::size_t size);
+
+    /**
+     * Set whether large memory blocks allocated through posix_memalign() (and
+     * therefore the memory of AlignedVector, Vector, and
+     * LinearAlgebra::distributed::Vector) should be backed by huge pages. The
+     * default is not to do so.
+     *
+     * Huge pages are currently only supported on Linux, where they are
+     * requested by calling <code>madvise()</code> with
+     * <code>MADV_HUGEPAGE</code>; this has an effect only if transparent huge
+     * pages are enabled in the kernel (in either the "always" or the
+     * "madvise" mode). On other systems, this setting is ignored.
+     */
+    void
+    use_huge_pages(const bool flag);
   } // namespace System
 
 
@@ -1169,6 +1190,118 @@ namespace Utilities
 
   // --------------------- non-inline functions
 
+  namespace internal
+  {
+    /**
+     * A type trait that checks whether a type is a std::vector of trivially
+     * copyable objects. The content of such vectors is packed by
+     * Utilities::pack() by a single call to std::memcpy, rather than through
+     * boost serialization.
+     */
+    template <typename T>
+    struct IsVectorOfTriviallyCopyable
+    {
+      static constexpr bool value = false;
+    };
+
+    template <typename T, typename Allocator>
+    struct IsVectorOfTriviallyCopyable<std::vector<T, Allocator>>
+    {
+      // std::vector<bool> does not store its elements contiguously
+      static constexpr bool value =
+#if __GNUG__ && __GNUC__ < 5
+        __has_trivial_copy(T)
+#else
+        std::is_trivially_copyable<T>::value
+#endif
+        && !std::is_same<T, bool>::value;
+    };
+
+
+
+    /**
+     * Append the size and the elements of the vector @p object to
+     * @p dest_buffer.
+     */
+    template <typename T, typename Allocator>
+    inline typename std::enable_if<
+      IsVectorOfTriviallyCopyable<std::vector<T, Allocator>>::value>::type
+    append_vector_of_trivially_copyable(const std::vector<T, Allocator> &object,
+                                        std::vector<char> &dest_buffer)
+    {
+      const std::size_t previous_size = dest_buffer.size();
+      const std::size_t vector_size   = object.size();
+      dest_buffer.resize(previous_size + sizeof(std::size_t) +
+                         vector_size * sizeof(T));
+
+      std::memcpy(dest_buffer.data() + previous_size,
+                  &vector_size,
+                  sizeof(std::size_t));
+      if (vector_size > 0)
+        std::memcpy(dest_buffer.data() + previous_size + sizeof(std::size_t),
+                    object.data(),
+                    vector_size * sizeof(T));
+    }
+
+
+
+    /**
+     * Fallback for types that are not vectors of trivially copyable
+     * objects. This function is never called, but needs to exist for
+     * compilers without support for <tt>if constexpr</tt>.
+     */
+    template <typename T>
+    inline typename std::enable_if<!IsVectorOfTriviallyCopyable<T>::value>::type
+    append_vector_of_trivially_copyable(const T &, std::vector<char> &)
+    {
+      Assert(false, ExcInternalError());
+    }
+
+
+
+    /**
+     * Restore the vector @p object from the characters in the range
+     * [@p begin, @p end) written by append_vector_of_trivially_copyable().
+     */
+    template <typename T, typename Allocator>
+    inline typename std::enable_if<
+      IsVectorOfTriviallyCopyable<std::vector<T, Allocator>>::value>::type
+    extract_vector_of_trivially_copyable(const char *               begin,
+                                         const char *               end,
+                                         std::vector<T, Allocator> &object)
+    {
+      std::size_t vector_size;
+      Assert(static_cast<std::size_t>(end - begin) >= sizeof(std::size_t),
+             ExcInternalError());
+      std::memcpy(&vector_size, begin, sizeof(std::size_t));
+      Assert(static_cast<std::size_t>(end - begin) ==
+               sizeof(std::size_t) + vector_size * sizeof(T),
+             ExcInternalError());
+      (void)end;
+
+      object.resize(vector_size);
+      if (vector_size > 0)
+        std::memcpy(object.data(),
+                    begin + sizeof(std::size_t),
+                    vector_size * sizeof(T));
+    }
+
+
+
+    /**
+     * Fallback for types that are not vectors of trivially copyable
+     * objects, see above.
+     */
+    template <typename T>
+    inline typename std::enable_if<!IsVectorOfTriviallyCopyable<T>::value>::type
+    extract_vector_of_trivially_copyable(const char *, const char *, T &)
+    {
+      Assert(false, ExcInternalError());
+    }
+  } // namespace internal
+
+
+
   template <typename T>
   size_t
   pack(const T &          object,
@@ -1204,6 +1337,33 @@ namespace Utilities
 
         size = sizeof(T);
       }
+    else if (internal::IsVectorOfTriviallyCopyable<T>::value)
+      {
+        // vectors of copyable objects are stored as their size followed by
+        // the raw bytes of their elements, compressed as a whole if
+        // requested
+        const std::size_t previous_size = dest_buffer.size();
+#ifdef DEAL_II_WITH_ZLIB
+        if (allow_compression)
+          {
+            std::vector<char> uncompressed_buffer;
+            internal::append_vector_of_trivially_copyable(object,
+                                                          uncompressed_buffer);
+
+            boost::iostreams::filtering_ostream out;
+            out.push(
+              boost::iostreams::gzip_compressor(boost::iostreams::gzip_params(
+                boost::iostreams::gzip::best_compression)));
+            out.push(boost::iostreams::back_inserter(dest_buffer));
+            out.write(uncompressed_buffer.data(), uncompressed_buffer.size());
+            out.flush();
+          }
+        else
+#endif
+          internal::append_vector_of_trivially_copyable(object, dest_buffer);
+
+        size = dest_buffer.size() - previous_size;
+      }
     else
       {
         // use buffer as the target of a compressing
@@ -1282,6 +1442,31 @@ namespace Utilities
         Assert(std::distance(cbegin, cend) == sizeof(T), ExcInternalError());
         std::memcpy(&object, &*cbegin, sizeof(T));
       }
+    else if (internal::IsVectorOfTriviallyCopyable<T>::value)
+      {
+#ifdef DEAL_II_WITH_ZLIB
+        if (allow_compression)
+          {
+            std::string decompressed_buffer;
+            {
+              boost::iostreams::filtering_ostream decompressing_stream;
+              decompressing_stream.push(boost::iostreams::gzip_decompressor());
+              decompressing_stream.push(
+                boost::iostreams::back_inserter(decompressed_buffer));
+              decompressing_stream.write(&*cbegin,
+                                         std::distance(cbegin, cend));
+            }
+
+            internal::extract_vector_of_trivially_copyable(
+              decompressed_buffer.data(),
+              decompressed_buffer.data() + decompressed_buffer.size(),
+              object);
+          }
+        else
+#endif
+          internal::extract_vector_of_trivially_copyable(
+            &*cbegin, &*cbegin + std::distance(cbegin, cend), object);
+      }
     else
       {
         std::string decompressed_buffer;
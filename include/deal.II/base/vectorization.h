@@ -63,6 +63,8 @@
 #    undef vector
 #    undef pixel
 #    undef bool
+#  elif defined(__ARM_NEON)
+#    include <arm_neon.h>
 #  else
 #    include <x86intrin.h>
 #  endif
@@ -152,6 +154,10 @@ struct EnableIfScalar<VectorizedArray<Number, width>>
  *  - VectorizedArray<double, 1>
  *  - VectorizedArray<double, 2>
  *
+ * and for 64-bit ARM processors with NEON (Advanced SIMD) support:
+ *  - VectorizedArray<double, 1>
+ *  - VectorizedArray<double, 2>
+ *
  * for older x86 processors or in case no processor-specific compilation flags
  * were added (i.e., without `-D CMAKE_CXX_FLAGS=-march=native` or similar
  * flags):
@@ -627,6 +633,107 @@ vectorized_transpose_and_store(const bool                            add_into,
 }
 
 
+/**
+ * Load the first @p n_lanes lanes of @p out from the positions
+ * <tt>base_ptr + offsets[v]</tt> and set the remaining lanes to zero. This is
+ * a variant of VectorizedArray::gather() for partially filled vectorized
+ * arrays, e.g. the last cell batch in a loop of MatrixFree. Only the first
+ * @p n_lanes entries of @p offsets are read.
+ *
+ * This operation corresponds to the following code:
+ * @code
+ * for (unsigned int v=0; v<n_lanes; ++v)
+ *   out[v] = base_ptr[offsets[v]];
+ * for (unsigned int v=n_lanes; v<VectorizedArray<Number>::n_array_elements;
+ *      ++v)
+ *   out[v] = 0;
+ * @endcode
+ *
+ * A more optimized version of this code will be used for supported types.
+ *
+ * @relatesalso VectorizedArray
+ */
+template <typename Number, int width>
+inline DEAL_II_ALWAYS_INLINE void
+masked_gather(const unsigned int              n_lanes,
+              const Number *                  base_ptr,
+              const unsigned int *            offsets,
+              VectorizedArray<Number, width> &out)
+{
+  AssertIndexRange(n_lanes, width + 1);
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    out[v] = base_ptr[offsets[v]];
+  for (unsigned int v = n_lanes;
+       v < VectorizedArray<Number, width>::n_array_elements;
+       ++v)
+    out[v] = Number();
+}
+
+
+
+/**
+ * Write the first @p n_lanes lanes of @p in to the positions
+ * <tt>base_ptr + offsets[v]</tt>. This is a variant of
+ * VectorizedArray::scatter() for partially filled vectorized arrays. If
+ * several offsets point to the same position, the lane with the highest
+ * index wins.
+ *
+ * This operation corresponds to the following code:
+ * @code
+ * for (unsigned int v=0; v<n_lanes; ++v)
+ *   base_ptr[offsets[v]] = in[v];
+ * @endcode
+ *
+ * A more optimized version of this code will be used for supported types.
+ *
+ * @relatesalso VectorizedArray
+ */
+template <typename Number, int width>
+inline DEAL_II_ALWAYS_INLINE void
+masked_scatter(const unsigned int                    n_lanes,
+               const VectorizedArray<Number, width> &in,
+               const unsigned int *                  offsets,
+               Number *                              base_ptr)
+{
+  AssertIndexRange(n_lanes, width + 1);
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    base_ptr[offsets[v]] = in[v];
+}
+
+
+
+/**
+ * Add the first @p n_lanes lanes of @p in into the positions
+ * <tt>base_ptr + offsets[v]</tt>. Unlike a combination of gather(),
+ * addition, and scatter(), several offsets may point to the same position,
+ * in which case all of these lanes are added into it. This is the case when
+ * adding the contributions of several cells of a batch that share a degree
+ * of freedom.
+ *
+ * This operation corresponds to the following code:
+ * @code
+ * for (unsigned int v=0; v<n_lanes; ++v)
+ *   base_ptr[offsets[v]] += in[v];
+ * @endcode
+ *
+ * A more optimized version of this code will be used for supported types.
+ *
+ * @relatesalso VectorizedArray
+ */
+template <typename Number, int width>
+inline DEAL_II_ALWAYS_INLINE void
+masked_scatter_add(const unsigned int                    n_lanes,
+                   const VectorizedArray<Number, width> &in,
+                   const unsigned int *                  offsets,
+                   Number *                              base_ptr)
+{
+  AssertIndexRange(n_lanes, width + 1);
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    base_ptr[offsets[v]] += in[v];
+}
+
+
+
 // for safety, also check that __AVX512F__ is defined in case the user manually
 // set some conflicting compile flags which prevent compilation
 
@@ -1065,6 +1172,98 @@ vectorized_transpose_and_store(const bool                        add_into,
 
 
 
+/**
+ * Specialization for double and AVX-512.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+masked_gather(const unsigned int          n_lanes,
+              const double *              base_ptr,
+              const unsigned int *        offsets,
+              VectorizedArray<double, 8> &out)
+{
+  AssertIndexRange(n_lanes, 9);
+  const __mmask8 mask = (1U << n_lanes) - 1;
+
+  // only the first n_lanes offsets may be read, so load the indices from a
+  // padded copy
+  unsigned int padded_offsets[8] = {};
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    padded_offsets[v] = offsets[v];
+  const __m256i index = _mm256_loadu_si256(
+    reinterpret_cast<const __m256i *>(padded_offsets));
+  out.data = _mm512_mask_i32gather_pd(
+    _mm512_setzero_pd(), mask, index, base_ptr, 8);
+}
+
+
+
+/**
+ * Specialization for double and AVX-512.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+masked_scatter(const unsigned int                n_lanes,
+               const VectorizedArray<double, 8> &in,
+               const unsigned int *              offsets,
+               double *                          base_ptr)
+{
+  AssertIndexRange(n_lanes, 9);
+  const __mmask8 mask = (1U << n_lanes) - 1;
+
+  unsigned int padded_offsets[8] = {};
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    padded_offsets[v] = offsets[v];
+  const __m256i index = _mm256_loadu_si256(
+    reinterpret_cast<const __m256i *>(padded_offsets));
+  // the lanes are written in ascending order, so the lane with the highest
+  // index wins in case of equal offsets as in the generic implementation
+  _mm512_mask_i32scatter_pd(base_ptr, mask, index, in.data, 8);
+}
+
+
+
+/**
+ * Specialization for double and AVX-512.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+masked_scatter_add(const unsigned int                n_lanes,
+                   const VectorizedArray<double, 8> &in,
+                   const unsigned int *              offsets,
+                   double *                          base_ptr)
+{
+  AssertIndexRange(n_lanes, 9);
+#  ifdef __AVX512CD__
+  const __mmask8 mask = (1U << n_lanes) - 1;
+
+  unsigned int padded_offsets[8] = {};
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    padded_offsets[v] = offsets[v];
+  const __m256i index = _mm256_loadu_si256(
+    reinterpret_cast<const __m256i *>(padded_offsets));
+
+  // find out with the conflict detection instruction whether any of the
+  // active lanes points to the same position as a lane with lower index. if
+  // not, which is the common case, gather, add and scatter the whole array
+  const __m512i conflicts =
+    _mm512_maskz_conflict_epi32(mask, _mm512_castsi256_si512(index));
+  if (_mm512_test_epi32_mask(conflicts, conflicts) == 0)
+    {
+      __m512d result = _mm512_mask_i32gather_pd(
+        _mm512_setzero_pd(), mask, index, base_ptr, 8);
+      result = _mm512_add_pd(result, in.data);
+      _mm512_mask_i32scatter_pd(base_ptr, mask, index, result, 8);
+      return;
+    }
+#  endif
+
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    base_ptr[offsets[v]] += in[v];
+}
+
+
+
 /**
  * Specialization for float and AVX512.
  */
@@ -1545,6 +1744,94 @@ vectorized_transpose_and_store(const bool                        add_into,
         out[offsets[v] + i] = in[i][v];
 }
 
+
+
+/**
+ * Specialization for float and AVX-512.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+masked_gather(const unsigned int          n_lanes,
+              const float *               base_ptr,
+              const unsigned int *        offsets,
+              VectorizedArray<float, 16> &out)
+{
+  AssertIndexRange(n_lanes, 17);
+  const __mmask16 mask = (1U << n_lanes) - 1;
+
+  // only the first n_lanes offsets may be read, so load the indices from a
+  // padded copy
+  unsigned int padded_offsets[16] = {};
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    padded_offsets[v] = offsets[v];
+  const __m512i index = _mm512_loadu_si512(padded_offsets);
+  out.data = _mm512_mask_i32gather_ps(
+    _mm512_setzero_ps(), mask, index, base_ptr, 4);
+}
+
+
+
+/**
+ * Specialization for float and AVX-512.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+masked_scatter(const unsigned int                n_lanes,
+               const VectorizedArray<float, 16> &in,
+               const unsigned int *              offsets,
+               float *                           base_ptr)
+{
+  AssertIndexRange(n_lanes, 17);
+  const __mmask16 mask = (1U << n_lanes) - 1;
+
+  unsigned int padded_offsets[16] = {};
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    padded_offsets[v] = offsets[v];
+  const __m512i index = _mm512_loadu_si512(padded_offsets);
+  // the lanes are written in ascending order, so the lane with the highest
+  // index wins in case of equal offsets as in the generic implementation
+  _mm512_mask_i32scatter_ps(base_ptr, mask, index, in.data, 4);
+}
+
+
+
+/**
+ * Specialization for float and AVX-512.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+masked_scatter_add(const unsigned int                n_lanes,
+                   const VectorizedArray<float, 16> &in,
+                   const unsigned int *              offsets,
+                   float *                           base_ptr)
+{
+  AssertIndexRange(n_lanes, 17);
+#  ifdef __AVX512CD__
+  const __mmask16 mask = (1U << n_lanes) - 1;
+
+  unsigned int padded_offsets[16] = {};
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    padded_offsets[v] = offsets[v];
+  const __m512i index = _mm512_loadu_si512(padded_offsets);
+
+  // find out with the conflict detection instruction whether any of the
+  // active lanes points to the same position as a lane with lower index. if
+  // not, which is the common case, gather, add and scatter the whole array
+  const __m512i conflicts = _mm512_maskz_conflict_epi32(mask, index);
+  if (_mm512_test_epi32_mask(conflicts, conflicts) == 0)
+    {
+      __m512 result = _mm512_mask_i32gather_ps(
+        _mm512_setzero_ps(), mask, index, base_ptr, 4);
+      result = _mm512_add_ps(result, in.data);
+      _mm512_mask_i32scatter_ps(base_ptr, mask, index, result, 4);
+      return;
+    }
+#  endif
+
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    base_ptr[offsets[v]] += in[v];
+}
+
 #endif
 
 #if DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 2 && defined(__AVX__)
@@ -1951,6 +2238,36 @@ vectorized_transpose_and_store(const bool                        add_into,
 
 
 
+#  ifdef __AVX2__
+/**
+ * Specialization for double and AVX2.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+masked_gather(const unsigned int          n_lanes,
+              const double *              base_ptr,
+              const unsigned int *        offsets,
+              VectorizedArray<double, 4> &out)
+{
+  AssertIndexRange(n_lanes, 5);
+
+  // only the first n_lanes offsets may be read, so load the indices from a
+  // padded copy
+  unsigned int padded_offsets[4] = {};
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    padded_offsets[v] = offsets[v];
+  const __m128i index =
+    _mm_loadu_si128(reinterpret_cast<const __m128i *>(padded_offsets));
+  const __m256d mask = _mm256_castsi256_pd(
+    _mm256_cmpgt_epi64(_mm256_set1_epi64x(n_lanes),
+                       _mm256_set_epi64x(3, 2, 1, 0)));
+  out.data = _mm256_mask_i32gather_pd(
+    _mm256_setzero_pd(), base_ptr, index, mask, 8);
+}
+#  endif
+
+
+
 /**
  * Specialization for float and AVX.
  */
@@ -2370,6 +2687,36 @@ vectorized_transpose_and_store(const bool                       add_into,
         out[offsets[v] + i] = in[i][v];
 }
 
+
+
+#  ifdef __AVX2__
+/**
+ * Specialization for float and AVX2.
+ */
+template <>
+inline DEAL_II_ALWAYS_INLINE void
+masked_gather(const unsigned int         n_lanes,
+              const float *              base_ptr,
+              const unsigned int *       offsets,
+              VectorizedArray<float, 8> &out)
+{
+  AssertIndexRange(n_lanes, 9);
+
+  // only the first n_lanes offsets may be read, so load the indices from a
+  // padded copy
+  unsigned int padded_offsets[8] = {};
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    padded_offsets[v] = offsets[v];
+  const __m256i index = _mm256_loadu_si256(
+    reinterpret_cast<const __m256i *>(padded_offsets));
+  const __m256 mask = _mm256_castsi256_ps(
+    _mm256_cmpgt_epi32(_mm256_set1_epi32(n_lanes),
+                       _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0)));
+  out.data = _mm256_mask_i32gather_ps(
+    _mm256_setzero_ps(), base_ptr, index, mask, 4);
+}
+#  endif
+
 #endif
 
 #if DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__SSE2__)
@@ -3586,6 +3933,475 @@ private:
        // defined(__VSX__)
 
 
+#if DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__ARM_NEON) && \
+  defined(__aarch64__)
+
+template <>
+class VectorizedArray<double, 2>
+{
+public:
+  /**
+   * This gives the type of the array elements.
+   */
+  using value_type = double;
+
+  /**
+   * This gives the number of vectors collected in this class.
+   */
+  static const unsigned int n_array_elements = 2;
+
+  /**
+   * Default empty constructor, leaving the data in an uninitialized state
+   * similar to float/double.
+   */
+  VectorizedArray() = default;
+
+  /**
+   * Construct an array with the given scalar broadcast to all lanes.
+   */
+  VectorizedArray(const double scalar)
+  {
+    this->operator=(scalar);
+  }
+
+  /**
+   * This function assigns a scalar to this class.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator=(const double x)
+  {
+    data = vdupq_n_f64(x);
+    return *this;
+  }
+
+  /**
+   * Access operator. The component must be either 0 or 1.
+   */
+  DEAL_II_ALWAYS_INLINE
+  double &operator[](const unsigned int comp)
+  {
+    AssertIndexRange(comp, 2);
+    return *(reinterpret_cast<double *>(&data) + comp);
+  }
+
+  /**
+   * Constant access operator.
+   */
+  DEAL_II_ALWAYS_INLINE
+  const double &operator[](const unsigned int comp) const
+  {
+    AssertIndexRange(comp, 2);
+    return *(reinterpret_cast<const double *>(&data) + comp);
+  }
+
+  /**
+   * Addition.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator+=(const VectorizedArray &vec)
+  {
+    data = vaddq_f64(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Subtraction.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator-=(const VectorizedArray &vec)
+  {
+    data = vsubq_f64(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Multiplication.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator*=(const VectorizedArray &vec)
+  {
+    data = vmulq_f64(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Division.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator/=(const VectorizedArray &vec)
+  {
+    data = vdivq_f64(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Load @p n_array_elements from memory into the calling class, starting at
+   * the given address.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  load(const double *ptr)
+  {
+    data = vld1q_f64(ptr);
+  }
+
+  /**
+   * Write the content of the calling class into memory in form of @p
+   * n_array_elements to the given address.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  store(double *ptr) const
+  {
+    vst1q_f64(ptr, data);
+  }
+
+  /** @copydoc VectorizedArray<Number>::streaming_store()
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  streaming_store(double *ptr) const
+  {
+    store(ptr);
+  }
+
+  /** @copydoc VectorizedArray<Number>::gather()
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  gather(const double *base_ptr, const unsigned int *offsets)
+  {
+    for (unsigned int i = 0; i < 2; ++i)
+      *(reinterpret_cast<double *>(&data) + i) = base_ptr[offsets[i]];
+  }
+
+  /** @copydoc VectorizedArray<Number>::scatter
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  scatter(const unsigned int *offsets, double *base_ptr) const
+  {
+    for (unsigned int i = 0; i < 2; ++i)
+      base_ptr[offsets[i]] = *(reinterpret_cast<const double *>(&data) + i);
+  }
+
+  /**
+   * Actual data field. Since this class represents a POD data type, it
+   * remains public.
+   */
+  float64x2_t data;
+
+private:
+  /**
+   * Return the square root of this field. Not for use in user code. Use
+   * sqrt(x) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_sqrt() const
+  {
+    VectorizedArray res;
+    res.data = vsqrtq_f64(data);
+    return res;
+  }
+
+  /**
+   * Return the absolute value of this field. Not for use in user code. Use
+   * abs(x) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_abs() const
+  {
+    VectorizedArray res;
+    res.data = vabsq_f64(data);
+    return res;
+  }
+
+  /**
+   * Return the component-wise maximum of this field and another one. Not for
+   * use in user code. Use max(x,y) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_max(const VectorizedArray &other) const
+  {
+    VectorizedArray res;
+    res.data = vmaxq_f64(data, other.data);
+    return res;
+  }
+
+  /**
+   * Return the component-wise minimum of this field and another one. Not for
+   * use in user code. Use min(x,y) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_min(const VectorizedArray &other) const
+  {
+    VectorizedArray res;
+    res.data = vminq_f64(data, other.data);
+    return res;
+  }
+
+  // Make a few functions friends.
+  template <typename Number2, int width2>
+  friend VectorizedArray<Number2, width2>
+  std::sqrt(const VectorizedArray<Number2, width2> &);
+  template <typename Number2, int width2>
+  friend VectorizedArray<Number2, width2>
+  std::abs(const VectorizedArray<Number2, width2> &);
+  template <typename Number2, int width2>
+  friend VectorizedArray<Number2, width2>
+  std::max(const VectorizedArray<Number2, width2> &,
+           const VectorizedArray<Number2, width2> &);
+  template <typename Number2, int width2>
+  friend VectorizedArray<Number2, width2>
+  std::min(const VectorizedArray<Number2, width2> &,
+           const VectorizedArray<Number2, width2> &);
+};
+
+
+
+template <>
+class VectorizedArray<float, 4>
+{
+public:
+  /**
+   * This gives the type of the array elements.
+   */
+  using value_type = float;
+
+  /**
+   * This gives the number of vectors collected in this class.
+   */
+  static const unsigned int n_array_elements = 4;
+
+  /**
+   * Default empty constructor, leaving the data in an uninitialized state
+   * similar to float/double.
+   */
+  VectorizedArray() = default;
+
+  /**
+   * Construct an array with the given scalar broadcast to all lanes.
+   */
+  VectorizedArray(const float scalar)
+  {
+    this->operator=(scalar);
+  }
+
+  /**
+   * This function assigns a scalar to this class.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator=(const float x)
+  {
+    data = vdupq_n_f32(x);
+    return *this;
+  }
+
+  /**
+   * Access operator. The component must be between 0 and 3.
+   */
+  DEAL_II_ALWAYS_INLINE
+  float &operator[](const unsigned int comp)
+  {
+    AssertIndexRange(comp, 4);
+    return *(reinterpret_cast<float *>(&data) + comp);
+  }
+
+  /**
+   * Constant access operator.
+   */
+  DEAL_II_ALWAYS_INLINE
+  const float &operator[](const unsigned int comp) const
+  {
+    AssertIndexRange(comp, 4);
+    return *(reinterpret_cast<const float *>(&data) + comp);
+  }
+
+  /**
+   * Addition.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator+=(const VectorizedArray &vec)
+  {
+    data = vaddq_f32(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Subtraction.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator-=(const VectorizedArray &vec)
+  {
+    data = vsubq_f32(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Multiplication.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator*=(const VectorizedArray &vec)
+  {
+    data = vmulq_f32(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Division.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray &
+  operator/=(const VectorizedArray &vec)
+  {
+    data = vdivq_f32(data, vec.data);
+    return *this;
+  }
+
+  /**
+   * Load @p n_array_elements from memory into the calling class, starting at
+   * the given address.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  load(const float *ptr)
+  {
+    data = vld1q_f32(ptr);
+  }
+
+  /**
+   * Write the content of the calling class into memory in form of @p
+   * n_array_elements to the given address.
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  store(float *ptr) const
+  {
+    vst1q_f32(ptr, data);
+  }
+
+  /** @copydoc VectorizedArray<Number>::streaming_store()
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  streaming_store(float *ptr) const
+  {
+    store(ptr);
+  }
+
+  /** @copydoc VectorizedArray<Number>::gather()
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  gather(const float *base_ptr, const unsigned int *offsets)
+  {
+    for (unsigned int i = 0; i < 4; ++i)
+      *(reinterpret_cast<float *>(&data) + i) = base_ptr[offsets[i]];
+  }
+
+  /** @copydoc VectorizedArray<Number>::scatter
+   */
+  DEAL_II_ALWAYS_INLINE
+  void
+  scatter(const unsigned int *offsets, float *base_ptr) const
+  {
+    for (unsigned int i = 0; i < 4; ++i)
+      base_ptr[offsets[i]] = *(reinterpret_cast<const float *>(&data) + i);
+  }
+
+  /**
+   * Actual data field. Since this class represents a POD data type, it
+   * remains public.
+   */
+  float32x4_t data;
+
+private:
+  /**
+   * Return the square root of this field. Not for use in user code. Use
+   * sqrt(x) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_sqrt() const
+  {
+    VectorizedArray res;
+    res.data = vsqrtq_f32(data);
+    return res;
+  }
+
+  /**
+   * Return the absolute value of this field. Not for use in user code. Use
+   * abs(x) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_abs() const
+  {
+    VectorizedArray res;
+    res.data = vabsq_f32(data);
+    return res;
+  }
+
+  /**
+   * Return the component-wise maximum of this field and another one. Not for
+   * use in user code. Use max(x,y) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_max(const VectorizedArray &other) const
+  {
+    VectorizedArray res;
+    res.data = vmaxq_f32(data, other.data);
+    return res;
+  }
+
+  /**
+   * Return the component-wise minimum of this field and another one. Not for
+   * use in user code. Use min(x,y) instead.
+   */
+  DEAL_II_ALWAYS_INLINE
+  VectorizedArray
+  get_min(const VectorizedArray &other) const
+  {
+    VectorizedArray res;
+    res.data = vminq_f32(data, other.data);
+    return res;
+  }
+
+  // Make a few functions friends.
+  template <typename Number2, int width2>
+  friend VectorizedArray<Number2, width2>
+  std::sqrt(const VectorizedArray<Number2, width2> &);
+  template <typename Number2, int width2>
+  friend VectorizedArray<Number2, width2>
+  std::abs(const VectorizedArray<Number2, width2> &);
+  template <typename Number2, int width2>
+  friend VectorizedArray<Number2, width2>
+  std::max(const VectorizedArray<Number2, width2> &,
+           const VectorizedArray<Number2, width2> &);
+  template <typename Number2, int width2>
+  friend VectorizedArray<Number2, width2>
+  std::min(const VectorizedArray<Number2, width2> &,
+           const VectorizedArray<Number2, width2> &);
+};
+
+#endif // if DEAL_II_VECTORIZATION_LEVEL >=1 && defined(__ARM_NEON) &&
+       // defined(__aarch64__)
+
+
 
 /**
  * Relational operator == for VectorizedArray
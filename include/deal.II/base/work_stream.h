@@ -26,16 +26,21 @@
 #  include <deal.II/base/template_constraints.h>
 #  include <deal.II/base/thread_local_storage.h>
 #  include <deal.II/base/thread_management.h>
+#  include <deal.II/base/tracing.h>
 
 #  ifdef DEAL_II_WITH_THREADS
 #    include <deal.II/base/thread_management.h>
 
+#    include <tbb/parallel_do.h>
 #    include <tbb/pipeline.h>
 #  endif
 
+#  include <algorithm>
+#  include <atomic>
 #  include <functional>
 #  include <iterator>
 #  include <memory>
+#  include <unordered_map>
 #  include <utility>
 #  include <vector>
 
@@ -999,6 +1004,8 @@ namespace WorkStream
     Assert(chunk_size > 0, ExcMessage("The chunk_size must be at least one."));
     (void)chunk_size; // removes -Wunused-parameter warning in optimized mode
 
+    Tracing::Scope trace("WorkStream::run");
+
     // if no work then skip. (only use operator!= for iterators since we may
     // not have an equality comparison operator)
     if (!(begin != end))
@@ -1179,6 +1186,8 @@ namespace WorkStream
     Assert(chunk_size > 0, ExcMessage("The chunk_size must be at least one."));
     (void)chunk_size; // removes -Wunused-parameter warning in optimized mode
 
+    Tracing::Scope trace("WorkStream::run");
+
     // we want to use TBB if we have support and if it is not disabled at
     // runtime:
 #  ifdef DEAL_II_WITH_THREADS
@@ -1236,6 +1245,226 @@ namespace WorkStream
 
 
 
+  /**
+   * A variant of the WorkStream::run() function for colored iterators that
+   * does not wait for all cells of one color to be finished before starting
+   * with the next color. The variant above runs one parallel loop per color;
+   * if some colors contain only a few cells, most threads are idle until the
+   * last chunk of such a color is done. Instead, this function splits each
+   * color into chunks of @p chunk_size cells and uses @p get_conflict_indices
+   * (the same function that was given to
+   * GraphColoring::make_graph_coloring() to create @p colored_iterators) to
+   * determine which chunks of earlier colors a chunk conflicts with. A chunk
+   * is started as soon as all of these are finished, and idle threads steal
+   * ready chunks from each other.
+   *
+   * As in the variant above, the worker and the copier are called one after
+   * the other on the same thread, and chunks that run concurrently never
+   * share a conflict index. Since the dependencies are determined from the
+   * conflict indices themselves, the result is correct even if the coloring
+   * is not a valid one; the coloring only determines how much parallelism is
+   * available.
+   *
+   * Setting up the dependencies requires calling @p get_conflict_indices on
+   * every cell once more, which is in general considerably cheaper than the
+   * work done by the worker.
+   */
+  template <typename Worker,
+            typename Copier,
+            typename Iterator,
+            typename ScratchData,
+            typename CopyData>
+  void
+  run_dependency_driven(
+    const std::vector<std::vector<Iterator>> &colored_iterators,
+    const std::function<std::vector<types::global_dof_index>(
+      const Iterator &)> &                    get_conflict_indices,
+    Worker                                    worker,
+    Copier                                    copier,
+    const ScratchData &                       sample_scratch_data,
+    const CopyData &                          sample_copy_data,
+    const unsigned int                        chunk_size = 8)
+  {
+    Assert(chunk_size > 0, ExcMessage("The chunk_size must be at least one."));
+
+    Tracing::Scope trace("WorkStream::run_dependency_driven");
+
+#  ifdef DEAL_II_WITH_THREADS
+    if (MultithreadInfo::n_threads() > 1)
+      {
+        using RangeType = typename std::vector<Iterator>::const_iterator;
+
+        // split the colors into chunks. for every conflict index, remember
+        // the chunk that touched it last, which the next chunk touching it
+        // has to wait for. this makes all chunks sharing an index run one
+        // after the other, in the order of the colors
+        std::vector<std::pair<RangeType, RangeType>> chunks;
+        std::vector<std::vector<unsigned int>>       successors;
+        std::vector<unsigned int>                    n_predecessors;
+        std::unordered_map<types::global_dof_index, unsigned int>
+          last_chunk_of_index;
+
+        std::vector<types::global_dof_index> chunk_indices;
+        std::vector<unsigned int>            predecessors;
+        for (const std::vector<Iterator> &color : colored_iterators)
+          for (RangeType chunk_begin = color.begin();
+               chunk_begin != color.end();)
+            {
+              const RangeType chunk_end =
+                chunk_begin +
+                std::min<std::size_t>(chunk_size, color.end() - chunk_begin);
+              const unsigned int chunk = chunks.size();
+
+              chunk_indices.clear();
+              for (RangeType p = chunk_begin; p != chunk_end; ++p)
+                {
+                  const std::vector<types::global_dof_index> indices =
+                    get_conflict_indices(*p);
+                  chunk_indices.insert(chunk_indices.end(),
+                                       indices.begin(),
+                                       indices.end());
+                }
+              std::sort(chunk_indices.begin(), chunk_indices.end());
+              chunk_indices.erase(std::unique(chunk_indices.begin(),
+                                              chunk_indices.end()),
+                                  chunk_indices.end());
+
+              predecessors.clear();
+              for (const types::global_dof_index index : chunk_indices)
+                {
+                  const auto it =
+                    last_chunk_of_index.emplace(index, chunk).first;
+                  if (it->second != chunk)
+                    {
+                      predecessors.push_back(it->second);
+                      it->second = chunk;
+                    }
+                }
+              std::sort(predecessors.begin(), predecessors.end());
+              predecessors.erase(std::unique(predecessors.begin(),
+                                             predecessors.end()),
+                                 predecessors.end());
+
+              chunks.emplace_back(chunk_begin, chunk_end);
+              successors.emplace_back();
+              n_predecessors.push_back(predecessors.size());
+              for (const unsigned int predecessor : predecessors)
+                successors[predecessor].push_back(chunk);
+
+              chunk_begin = chunk_end;
+            }
+
+        // then start with all chunks that do not depend on anything, and
+        // release the successors of a chunk once it is done
+        std::unique_ptr<std::atomic<unsigned int>[]> n_pending(
+          new std::atomic<unsigned int>[chunks.size()]);
+        std::vector<unsigned int> ready_chunks;
+        for (unsigned int chunk = 0; chunk < chunks.size(); ++chunk)
+          {
+            n_pending[chunk] = n_predecessors[chunk];
+            if (n_predecessors[chunk] == 0)
+              ready_chunks.push_back(chunk);
+          }
+
+        using WorkerAndCopier = internal::Implementation3::
+          WorkerAndCopier<Iterator, ScratchData, CopyData>;
+        WorkerAndCopier worker_and_copier(worker,
+                                          copier,
+                                          sample_scratch_data,
+                                          sample_copy_data);
+
+        tbb::parallel_do(
+          ready_chunks.begin(),
+          ready_chunks.end(),
+          [&](const unsigned int                      chunk,
+              tbb::parallel_do_feeder<unsigned int> &feeder) {
+            worker_and_copier(tbb::blocked_range<RangeType>(
+              chunks[chunk].first, chunks[chunk].second));
+
+            for (const unsigned int successor : successors[chunk])
+              if (--n_pending[successor] == 0)
+                feeder.add(successor);
+          });
+
+        return;
+      }
+#  else
+    (void)get_conflict_indices;
+#  endif
+
+    // without threads, there is nothing to schedule, and the variant above
+    // simply works through the colors one after the other
+    run(colored_iterators,
+        worker,
+        copier,
+        sample_scratch_data,
+        sample_copy_data,
+        1,
+        chunk_size);
+  }
+
+
+
+  /**
+   * A variant of the WorkStream::run() function for a range of iterators for
+   * the case where the copier may run concurrently on several threads, i.e.,
+   * where the global objects the copier writes into support concurrent
+   * additions. In this case, there is no reason to funnel all local
+   * contributions through a single thread, which becomes the limiting stage
+   * of the pipeline used by WorkStream::run() for large numbers of threads.
+   * Rather, each thread calls the copier right after the worker on the same
+   * CopyData object, much like the colored variant of WorkStream::run() does
+   * within each color.
+   *
+   * Examples of targets the copier may write into are SparseMatrix and Vector
+   * objects after calling SparseMatrix::set_thread_safe_add() and
+   * Vector::set_thread_safe_add(), respectively. With those,
+   * AffineConstraints::distribute_local_to_global() for a matrix and a
+   * vector may be called from the copier, as long as inhomogeneities are not
+   * used for the right hand side. It is the responsibility of the caller to
+   * make sure that everything else the copier does is thread-safe as well:
+   * this function only declares that this is the case.
+   *
+   * In contrast to WorkStream::run(), the order in which the copier is called
+   * on the items is not specified. In connection with atomic additions, this
+   * means that results can differ in the last digits from run to run.
+   *
+   * The @p chunk_size argument indicates how many consecutive elements of the
+   * range are processed by one thread at a time. Since the iterators are
+   * first collected into a vector, the range must not be too expensive to
+   * traverse.
+   */
+  template <typename Worker,
+            typename Copier,
+            typename Iterator,
+            typename ScratchData,
+            typename CopyData>
+  void
+  run_with_concurrent_copier(const Iterator &                         begin,
+                             const typename identity<Iterator>::type &end,
+                             Worker                                   worker,
+                             Copier                                   copier,
+                             const ScratchData &sample_scratch_data,
+                             const CopyData &   sample_copy_data,
+                             const unsigned int chunk_size = 8)
+  {
+    // collect all iterators into a single color and defer to the colored
+    // variant, which runs worker and copier on the same thread
+    std::vector<std::vector<Iterator>> all_iterators(1);
+    for (Iterator p = begin; p != end; ++p)
+      all_iterators[0].push_back(p);
+
+    run(all_iterators,
+        worker,
+        copier,
+        sample_scratch_data,
+        sample_copy_data,
+        2 * MultithreadInfo::n_threads(),
+        chunk_size);
+  }
+
+
+
   /**
    * This is a variant of one of the two main functions of the WorkStream
    * concept, doing work as described in the introduction to this namespace.
@@ -18,6 +18,7 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/numbers.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/differentiation/ad/ad_number_types.h>
 
@@ -400,6 +401,45 @@ namespace Differentiation
       };
 
 
+      /**
+       * A dummy specialization for vectorized floating point numbers, which
+       * terminates the recursive marking of tapeless AD numbers that are
+       * built on top of a VectorizedArray.
+       */
+      template <typename Number, int width>
+      struct Marking<VectorizedArray<Number, width>,
+                     typename std::enable_if<
+                       std::is_floating_point<Number>::value>::type>
+      {
+        /**
+         * Initialize the state of an independent variable.
+         */
+        template <typename ADNumberType>
+        static void
+        independent_variable(const VectorizedArray<Number, width> &in,
+                             const unsigned int,
+                             const unsigned int,
+                             ADNumberType &out)
+        {
+          out = in;
+        }
+
+        /*
+         * Initialize the state of a dependent variable.
+         */
+        template <typename ADNumberType>
+        static void
+        dependent_variable(ADNumberType &,
+                           const VectorizedArray<Number, width> &)
+        {
+          AssertThrow(
+            false,
+            ExcMessage(
+              "Floating point numbers cannot be marked as dependent variables."));
+        }
+      };
+
+
       /**
        * A specialization of the marking strategy for complex numbers.
        */
@@ -594,6 +634,48 @@ namespace Differentiation
       };
 
 
+      /**
+       * A dummy specialization for vectorized floating point numbers, which
+       * terminates the recursive data extraction from tapeless AD numbers
+       * that are built on top of a VectorizedArray.
+       */
+      template <typename Number, int width>
+      struct ExtractData<VectorizedArray<Number, width>,
+                         typename std::enable_if<
+                           std::is_floating_point<Number>::value>::type>
+      {
+        /**
+         * Extract the vectorized floating point value.
+         */
+        static const VectorizedArray<Number, width> &
+        value(const VectorizedArray<Number, width> &x)
+        {
+          return x;
+        }
+
+
+        /**
+         * Extract the number of directional derivatives.
+         */
+        static unsigned int
+        n_directional_derivatives(const VectorizedArray<Number, width> &)
+        {
+          return 0;
+        }
+
+
+        /**
+         * Extract the directional derivative in the specified @p direction.
+         */
+        static VectorizedArray<Number, width>
+        directional_derivative(const VectorizedArray<Number, width> &,
+                               const unsigned int)
+        {
+          return VectorizedArray<Number, width>(0.0);
+        }
+      };
+
+
 
       /**
        * A struct specialization to help extract certain information associated
@@ -1093,6 +1175,267 @@ namespace Differentiation
 
 
 
+    /**
+     * Specialization of the general NumberTraits class for the case where
+     * @p ScalarType is a VectorizedArray of floating point numbers. The
+     * resulting tapeless auto-differentiable numbers, e.g.
+     * Sacado::Fad::DFad<VectorizedArray<double>>, evaluate a function and
+     * its derivatives for all lanes of the vectorized array at once. They can
+     * therefore be used to linearize a constitutive law for a batch of
+     * quadrature points, such as those processed by FEEvaluation, at the
+     * cost of a single scalar evaluation.
+     *
+     * Only real-valued tapeless number types are supported.
+     */
+    template <typename Number, int width, enum NumberTypes ADNumberTypeCode>
+    struct NumberTraits<
+      VectorizedArray<Number, width>,
+      ADNumberTypeCode,
+      typename std::enable_if<std::is_floating_point<Number>::value>::type>
+    {
+      /**
+       * The type of taping used
+       */
+      static constexpr enum NumberTypes type_code = ADNumberTypeCode;
+
+#  ifdef __clang__
+
+      /**
+       * A flag to indicate whether the number is of
+       * the taped variety or not
+       */
+      static const bool is_taped;
+
+
+      /**
+       * A flag to indicate whether the number is of
+       * the tapeless variety or not
+       */
+      static const bool is_tapeless;
+
+
+      /**
+       * A flag to indicate whether the number represents
+       * a real value
+       */
+      static const bool is_real_valued;
+
+
+      /**
+       * A flag to indicate whether the number represents
+       * a complex value
+       */
+      static const bool is_complex_valued;
+
+
+      /**
+       * The number of directional derivatives that can be
+       * taken with this auto-differentiable number
+       */
+      static const unsigned int n_supported_derivative_levels;
+
+#  else
+
+      /**
+       * A flag to indicate whether the number is of
+       * the taped variety or not
+       */
+      static constexpr bool is_taped =
+        internal::ADNumberInfoFromEnum<VectorizedArray<Number, width>,
+                                       ADNumberTypeCode>::is_taped;
+
+
+      /**
+       * A flag to indicate whether the number is of
+       * the tapeless variety or not
+       */
+      static constexpr bool is_tapeless = !is_taped;
+
+
+      /**
+       * A flag to indicate whether the number represents
+       * a real value
+       */
+      static constexpr bool is_real_valued = true;
+
+
+      /**
+       * A flag to indicate whether the number represents
+       * a complex value
+       */
+      static constexpr bool is_complex_valued = false;
+
+
+      /**
+       * The number of directional derivatives that can be
+       * taken with this auto-differentiable number
+       */
+      static constexpr unsigned int n_supported_derivative_levels =
+        internal::ADNumberInfoFromEnum<VectorizedArray<Number, width>,
+                                       ADNumberTypeCode>::
+          n_supported_derivative_levels;
+
+#  endif
+
+
+      /**
+       * Underlying vectorized floating point value type.
+       */
+      using scalar_type = VectorizedArray<Number, width>;
+
+
+      /**
+       * Type for real numbers
+       */
+      using real_type =
+        typename internal::ADNumberInfoFromEnum<VectorizedArray<Number, width>,
+                                                ADNumberTypeCode>::real_type;
+
+
+      /**
+       * Type for complex numbers
+       */
+      using complex_type = std::complex<real_type>;
+
+
+      /**
+       * The actual auto-differentiable number type
+       */
+      using ad_type = real_type;
+
+      /**
+       * The actual auto-differentiable number directional derivative type
+       */
+      using derivative_type = typename internal::ADNumberInfoFromEnum<
+        VectorizedArray<Number, width>,
+        ADNumberTypeCode>::derivative_type;
+
+
+      /**
+       * Extract the value of an auto-differentiable number
+       */
+      static scalar_type
+      get_scalar_value(const ad_type &x)
+      {
+        return internal::ExtractData<ad_type>::value(x);
+      }
+
+
+      /**
+       * Extract the derivative value of an auto-differentiable number
+       */
+      static derivative_type
+      get_directional_derivative(const ad_type &x, const unsigned int direction)
+      {
+        return internal::ExtractData<ad_type>::directional_derivative(
+          x, direction);
+      }
+
+
+      /**
+       * Extract the number of directional derivatives value tracked by
+       * an auto-differentiable number
+       */
+      static unsigned int
+      n_directional_derivatives(const ad_type &x)
+      {
+        return internal::ExtractData<ad_type>::n_directional_derivatives(x);
+      }
+    };
+
+#  ifdef __clang__
+
+    template <typename Number, int width, enum NumberTypes ADNumberTypeCode>
+    const bool NumberTraits<
+      VectorizedArray<Number, width>,
+      ADNumberTypeCode,
+      typename std::enable_if<std::is_floating_point<Number>::value>::type>::
+      is_taped =
+        internal::ADNumberInfoFromEnum<VectorizedArray<Number, width>,
+                                       ADNumberTypeCode>::is_taped;
+
+
+    template <typename Number, int width, enum NumberTypes ADNumberTypeCode>
+    const bool NumberTraits<
+      VectorizedArray<Number, width>,
+      ADNumberTypeCode,
+      typename std::enable_if<std::is_floating_point<Number>::value>::type>::
+      is_tapeless =
+        !(NumberTraits<VectorizedArray<Number, width>,
+                       ADNumberTypeCode>::is_taped);
+
+
+    template <typename Number, int width, enum NumberTypes ADNumberTypeCode>
+    const bool NumberTraits<
+      VectorizedArray<Number, width>,
+      ADNumberTypeCode,
+      typename std::enable_if<std::is_floating_point<Number>::value>::type>::
+      is_real_valued = true;
+
+
+    template <typename Number, int width, enum NumberTypes ADNumberTypeCode>
+    const bool NumberTraits<
+      VectorizedArray<Number, width>,
+      ADNumberTypeCode,
+      typename std::enable_if<std::is_floating_point<Number>::value>::type>::
+      is_complex_valued = false;
+
+
+    template <typename Number, int width, enum NumberTypes ADNumberTypeCode>
+    const unsigned int NumberTraits<
+      VectorizedArray<Number, width>,
+      ADNumberTypeCode,
+      typename std::enable_if<std::is_floating_point<Number>::value>::type>::
+      n_supported_derivative_levels =
+        internal::ADNumberInfoFromEnum<VectorizedArray<Number, width>,
+                                       ADNumberTypeCode>::
+          n_supported_derivative_levels;
+
+#  else
+
+    template <typename Number, int width, enum NumberTypes ADNumberTypeCode>
+    constexpr bool NumberTraits<
+      VectorizedArray<Number, width>,
+      ADNumberTypeCode,
+      typename std::enable_if<std::is_floating_point<Number>::value>::type>::
+      is_taped;
+
+
+    template <typename Number, int width, enum NumberTypes ADNumberTypeCode>
+    constexpr bool NumberTraits<
+      VectorizedArray<Number, width>,
+      ADNumberTypeCode,
+      typename std::enable_if<std::is_floating_point<Number>::value>::type>::
+      is_tapeless;
+
+
+    template <typename Number, int width, enum NumberTypes ADNumberTypeCode>
+    constexpr bool NumberTraits<
+      VectorizedArray<Number, width>,
+      ADNumberTypeCode,
+      typename std::enable_if<std::is_floating_point<Number>::value>::type>::
+      is_real_valued;
+
+
+    template <typename Number, int width, enum NumberTypes ADNumberTypeCode>
+    constexpr bool NumberTraits<
+      VectorizedArray<Number, width>,
+      ADNumberTypeCode,
+      typename std::enable_if<std::is_floating_point<Number>::value>::type>::
+      is_complex_valued;
+
+
+    template <typename Number, int width, enum NumberTypes ADNumberTypeCode>
+    constexpr unsigned int NumberTraits<
+      VectorizedArray<Number, width>,
+      ADNumberTypeCode,
+      typename std::enable_if<std::is_floating_point<Number>::value>::type>::
+      n_supported_derivative_levels;
+
+#  endif
+
+
+
     /**
      * A dummy specialization for floating point numbers. This is necessary to
      * deal with the special case of the ADNumberTypeCode that represents a
@@ -86,13 +86,58 @@ DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 
 #  include <deal.II/base/exceptions.h>
 #  include <deal.II/base/numbers.h>
+#  include <deal.II/base/vectorization.h>
 
 #  include <deal.II/differentiation/ad/ad_number_traits.h>
 #  include <deal.II/differentiation/ad/ad_number_types.h>
 
 #  include <complex>
+#  include <string>
 #  include <type_traits>
 
+
+// Make Sacado treat a VectorizedArray as a passive scalar type, so that
+// Sacado::Fad::DFad<VectorizedArray<double>> can be used to differentiate a
+// function for all lanes of the vectorized array at once.
+namespace Sacado
+{
+  template <typename Number, int width>
+  struct IsScalarType<dealii::VectorizedArray<Number, width>>
+  {
+    static const bool value = true;
+  };
+
+
+  template <typename Number, int width>
+  struct IsEqual<dealii::VectorizedArray<Number, width>>
+  {
+    static bool
+    eval(const dealii::VectorizedArray<Number, width> &x,
+         const dealii::VectorizedArray<Number, width> &y)
+    {
+      for (unsigned int v = 0;
+           v < dealii::VectorizedArray<Number, width>::n_array_elements;
+           ++v)
+        if (x[v] != y[v])
+          return false;
+      return true;
+    }
+  };
+
+
+  template <typename Number, int width>
+  struct StringName<dealii::VectorizedArray<Number, width>>
+  {
+    static std::string
+    eval()
+    {
+      return "dealii::VectorizedArray<" + StringName<Number>::eval() + ", " +
+             std::to_string(width) + ">";
+    }
+  };
+} // namespace Sacado
+
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -206,6 +251,22 @@ namespace Differentiation
       };
 
 
+      /**
+       * Specialization for vectorized floating point numbers.
+       *
+       * This is required as a termination point for the recursive
+       * templates used in the above specializations, when the Sacado
+       * numbers are built on top of a VectorizedArray.
+       */
+      template <typename Number, int width>
+      struct SacadoNumberInfo<
+        VectorizedArray<Number, width>,
+        typename std::enable_if<std::is_floating_point<Number>::value>::type>
+      {
+        static const unsigned int n_supported_derivative_levels = 0;
+      };
+
+
       /**
        * A specialization for the information struct for Sacado dynamic forward
        * auto-differentiable numbers.
@@ -246,6 +307,47 @@ namespace Differentiation
       };
 
 
+      /**
+       * A specialization for the information struct for Sacado dynamic forward
+       * auto-differentiable numbers that operate on all lanes of a
+       * VectorizedArray at once.
+       */
+      template <typename Number, int width>
+      struct ADNumberInfoFromEnum<
+        VectorizedArray<Number, width>,
+        Differentiation::AD::NumberTypes::sacado_dfad,
+        typename std::enable_if<std::is_floating_point<Number>::value>::type>
+      {
+        static const bool is_taped = false;
+        using real_type = Sacado::Fad::DFad<VectorizedArray<Number, width>>;
+        using derivative_type =
+          typename SacadoNumberInfo<real_type>::derivative_type;
+        static const unsigned int n_supported_derivative_levels =
+          SacadoNumberInfo<real_type>::n_supported_derivative_levels;
+      };
+
+
+      /**
+       * A specialization for the information struct for nested Sacado dynamic
+       * forward auto-differentiable numbers that operate on all lanes of a
+       * VectorizedArray at once.
+       */
+      template <typename Number, int width>
+      struct ADNumberInfoFromEnum<
+        VectorizedArray<Number, width>,
+        Differentiation::AD::NumberTypes::sacado_dfad_dfad,
+        typename std::enable_if<std::is_floating_point<Number>::value>::type>
+      {
+        static const bool is_taped = false;
+        using real_type =
+          Sacado::Fad::DFad<Sacado::Fad::DFad<VectorizedArray<Number, width>>>;
+        using derivative_type =
+          typename SacadoNumberInfo<real_type>::derivative_type;
+        static const unsigned int n_supported_derivative_levels =
+          SacadoNumberInfo<real_type>::n_supported_derivative_levels;
+      };
+
+
       /**
        * A specialization for the information struct for Sacado dynamic reverse
        * auto-differentiable numbers.
@@ -0,0 +1,608 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_differentiation_sd_symengine_optimizer_h
+#define dealii_differentiation_sd_symengine_optimizer_h
+
+#include <deal.II/base/config.h>
+
+#ifdef DEAL_II_WITH_SYMENGINE
+
+#  include <deal.II/base/exceptions.h>
+
+#  include <deal.II/differentiation/sd/symengine_number_types.h>
+#  include <deal.II/differentiation/sd/symengine_types.h>
+
+#  include <symengine/lambda_double.h>
+#  ifdef DEAL_II_SYMENGINE_WITH_LLVM
+#    include <symengine/llvm_double.h>
+#  endif
+
+#  include <boost/serialization/split_member.hpp>
+#  include <boost/serialization/string.hpp>
+#  include <boost/serialization/vector.hpp>
+
+#  include <map>
+#  include <memory>
+#  include <string>
+#  include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Differentiation
+{
+  namespace SD
+  {
+    /**
+     * An enumeration of the methods with which a BatchOptimizer evaluates
+     * its registered functions.
+     */
+    enum class OptimizerType
+    {
+      /**
+       * Perform a dictionary-based substitution of the symbols into the
+       * functions. No optimization is performed.
+       */
+      dictionary,
+      /**
+       * Convert the functions into a set of std::function objects that
+       * evaluate them directly.
+       */
+      lambda,
+      /**
+       * Compile the functions to native machine code using the LLVM JIT
+       * compiler.
+       *
+       * @note This option is only available if SymEngine was built with LLVM
+       * support.
+       */
+      llvm
+    };
+
+
+    /**
+     * Flags that control the optimizations performed by a BatchOptimizer.
+     * The flags can be combined with the bitwise OR operator.
+     */
+    enum class OptimizationFlags : unsigned char
+    {
+      /**
+       * Use the default settings of the chosen optimizer.
+       */
+      optimize_default = 0,
+      /**
+       * Eliminate common subexpressions across all registered functions
+       * before they are converted into an evaluator.
+       */
+      optimize_cse = 0x0001,
+      /**
+       * Use the highest optimization level that the LLVM compiler offers.
+       * This increases the compilation time, and is ignored by all other
+       * optimizers.
+       */
+      optimize_aggressive = 0x0002,
+      /**
+       * Apply all of the above.
+       */
+      optimize_all = optimize_cse | optimize_aggressive
+    };
+
+
+    /**
+     * Global operator which returns an object in which all bits are set
+     * which are either set in the first or the second argument.
+     */
+    inline OptimizationFlags
+    operator|(const OptimizationFlags f1, const OptimizationFlags f2)
+    {
+      return static_cast<OptimizationFlags>(static_cast<unsigned char>(f1) |
+                                            static_cast<unsigned char>(f2));
+    }
+
+
+    /**
+     * Global operator which sets the bits from the second argument also in
+     * the first one.
+     */
+    inline OptimizationFlags &
+    operator|=(OptimizationFlags &f1, const OptimizationFlags f2)
+    {
+      f1 = f1 | f2;
+      return f1;
+    }
+
+
+    /**
+     * Global operator which returns an object in which all bits are set
+     * which are set in the first as well as the second argument.
+     */
+    inline OptimizationFlags operator&(const OptimizationFlags f1,
+                                       const OptimizationFlags f2)
+    {
+      return static_cast<OptimizationFlags>(static_cast<unsigned char>(f1) &
+                                            static_cast<unsigned char>(f2));
+    }
+
+
+
+    /**
+     * A class that evaluates a collection of symbolic functions for many
+     * different values of a fixed set of independent symbols in an efficient
+     * manner.
+     *
+     * Substituting values into a symbolic expression with a dictionary, as
+     * done by Expression::substitute_and_evaluate(), is expensive. This
+     * class instead converts all registered functions once, upon a call to
+     * optimize(), into an evaluator that takes the values of the independent
+     * symbols as a plain array and returns the values of all functions at
+     * once. Optionally, common subexpressions are shared between all
+     * functions, and the functions are compiled to machine code using LLVM.
+     * The cost of the optimization is incurred once, after which the
+     * evaluator can be used for any number of parameter sets, for example
+     * for each quadrature point of each cell during assembly:
+     *
+     * @code
+     *   BatchOptimizer<double> optimizer(OptimizerType::llvm,
+     *                                    OptimizationFlags::optimize_all);
+     *   optimizer.register_symbols(symbols);
+     *   optimizer.register_functions(functions);
+     *   optimizer.optimize();
+     *
+     *   // For each cell: evaluate all functions for all quadrature points
+     *   // in a single call
+     *   optimizer.evaluate_batch(values_at_q_points, results_at_q_points);
+     * @endcode
+     *
+     * Since compiling the functions with LLVM can be expensive, an optimizer
+     * can be serialized after the call to optimize() and loaded in a later
+     * run. If the SymEngine library supports it, the compiled LLVM object is
+     * stored in the archive, so that no compilation is necessary upon
+     * loading. Otherwise, the functions are optimized anew when the object is
+     * loaded.
+     *
+     * @tparam ReturnType The number type of the values of the independent
+     *         symbols and the functions. Either <tt>double</tt> or
+     *         <tt>float</tt>.
+     */
+    template <typename ReturnType>
+    class BatchOptimizer
+    {
+    public:
+      /**
+       * Constructor. OptimizerType::llvm can only be chosen as the
+       * @p optimization_method if SymEngine was built with LLVM support.
+       */
+      BatchOptimizer(const OptimizerType     optimization_method =
+                       OptimizerType::lambda,
+                     const OptimizationFlags optimization_flags =
+                       OptimizationFlags::optimize_cse);
+
+      /**
+       * Copying an optimizer is not supported.
+       */
+      BatchOptimizer(const BatchOptimizer &) = delete;
+
+      /**
+       * Copying an optimizer is not supported.
+       */
+      BatchOptimizer &
+      operator=(const BatchOptimizer &) = delete;
+
+      /**
+       * Select the optimization method and flags. This is only possible
+       * before optimize() has been called.
+       */
+      void
+      set_optimization_method(const OptimizerType     optimization_method,
+                              const OptimizationFlags optimization_flags =
+                                OptimizationFlags::optimize_cse);
+
+      /**
+       * Return the optimization method.
+       */
+      OptimizerType
+      optimization_method() const;
+
+      /**
+       * Return the optimization flags.
+       */
+      OptimizationFlags
+      optimization_flags() const;
+
+      /**
+       * @name Independent variables
+       */
+      //@{
+
+      /**
+       * Register the keys of @p substitution_map as independent symbols.
+       * The values stored in the map are ignored.
+       */
+      void
+      register_symbols(const types::substitution_map &substitution_map);
+
+      /**
+       * Register the entries of @p symbols as independent symbols, in the
+       * given order. This order defines the layout of the values passed to
+       * substitute() and evaluate_batch().
+       */
+      void
+      register_symbols(const types::symbol_vector &symbols);
+
+      /**
+       * Return the independent symbols in the order in which their values
+       * are expected.
+       */
+      const types::symbol_vector &
+      get_independent_symbols() const;
+
+      /**
+       * Return the number of independent symbols.
+       */
+      std::size_t
+      n_independent_variables() const;
+
+      //@}
+
+      /**
+       * @name Dependent variables
+       */
+      //@{
+
+      /**
+       * Register a function that is to be evaluated.
+       */
+      void
+      register_function(const Expression &function);
+
+      /**
+       * Register a set of functions that are to be evaluated, in the given
+       * order. This order defines the layout of the values returned by
+       * evaluate() and evaluate_batch().
+       */
+      void
+      register_functions(const types::symbol_vector &functions);
+
+      /**
+       * Return the registered functions.
+       */
+      const types::symbol_vector &
+      get_dependent_functions() const;
+
+      /**
+       * Return the number of registered functions.
+       */
+      std::size_t
+      n_dependent_variables() const;
+
+      //@}
+
+      /**
+       * @name Optimization and evaluation
+       */
+      //@{
+
+      /**
+       * Convert the registered functions into an evaluator. After this call,
+       * no further symbols or functions can be registered.
+       */
+      void
+      optimize();
+
+      /**
+       * Return whether optimize() has been called.
+       */
+      bool
+      optimized() const;
+
+      /**
+       * Evaluate all functions for the values of the independent symbols
+       * given by @p substitution_map. The map must contain all independent
+       * symbols.
+       */
+      void
+      substitute(const types::substitution_map &substitution_map);
+
+      /**
+       * Evaluate all functions for the @p values of the independent symbols,
+       * which are given in the order returned by get_independent_symbols().
+       */
+      void
+      substitute(const std::vector<ReturnType> &values);
+
+      /**
+       * Return whether values have been substituted since the last call to
+       * optimize().
+       */
+      bool
+      values_substituted() const;
+
+      /**
+       * Return the values of all functions computed by the last call to
+       * substitute(), in the order in which they were registered.
+       */
+      const std::vector<ReturnType> &
+      evaluate() const;
+
+      /**
+       * Return the value of the registered @p function computed by the last
+       * call to substitute().
+       */
+      ReturnType
+      evaluate(const Expression &function) const;
+
+      /**
+       * Evaluate all functions for a whole batch of parameter sets, such as
+       * one per quadrature point, in a single call.
+       *
+       * @p values stores the values of the independent symbols for each
+       * parameter set contiguously, i.e., its size must be a multiple of
+       * n_independent_variables(). Upon return, @p results stores the values
+       * of all functions for each parameter set in the same fashion, and is
+       * resized accordingly. For the lambda and LLVM optimizers, the whole
+       * batch is evaluated directly on these arrays without any intermediate
+       * copies. This function does not change the values returned by
+       * evaluate().
+       */
+      void
+      evaluate_batch(const std::vector<ReturnType> &values,
+                     std::vector<ReturnType> &      results);
+
+      //@}
+
+      /**
+       * @name Serialization
+       */
+      //@{
+
+      /**
+       * Write the data of this object to a stream for the purpose of
+       * serialization.
+       */
+      template <class Archive>
+      void
+      save(Archive &archive, const unsigned int version) const;
+
+      /**
+       * Read the data of this object from a stream for the purpose of
+       * serialization. If the optimizer had been optimized when it was
+       * saved, it is ready for evaluation again afterwards.
+       */
+      template <class Archive>
+      void
+      load(Archive &archive, const unsigned int version);
+
+#  ifdef DOXYGEN
+      /**
+       * Write and read the data of this object from a stream for the purpose
+       * of serialization.
+       */
+      template <class Archive>
+      void
+      serialize(Archive &archive, const unsigned int version);
+#  else
+      // This macro defines the serialize() method that is compatible with
+      // the templated save() and load() method that have been implemented.
+      BOOST_SERIALIZATION_SPLIT_MEMBER()
+#  endif
+
+      //@}
+
+    private:
+      /**
+       * Evaluate all functions for the values given in @p values, and write
+       * the results into @p results.
+       */
+      void
+      evaluate_functions(const ReturnType *values, ReturnType *results);
+
+      /**
+       * Return the compiled LLVM object, or an empty string if it cannot be
+       * serialized.
+       */
+      std::string
+      dump_compiled_object() const;
+
+      /**
+       * Restore the evaluator from a compiled LLVM object previously
+       * returned by dump_compiled_object(). Return whether this was
+       * possible.
+       */
+      bool
+      load_compiled_object(const std::string &object);
+
+      /**
+       * The optimization method.
+       */
+      OptimizerType method;
+
+      /**
+       * The optimization flags.
+       */
+      OptimizationFlags flags;
+
+      /**
+       * The independent symbols.
+       */
+      types::symbol_vector independent_symbols;
+
+      /**
+       * The registered functions.
+       */
+      types::symbol_vector dependent_functions;
+
+      /**
+       * A map from the registered functions to their position in
+       * @p dependent_functions.
+       */
+      std::map<Expression, std::size_t, types::internal::ExpressionKeyLess>
+        function_indices;
+
+      /**
+       * The values of the registered functions computed by the last call to
+       * substitute().
+       */
+      std::vector<ReturnType> function_values;
+
+      /**
+       * Whether optimize() has been called.
+       */
+      bool is_optimized;
+
+      /**
+       * Whether substitute() has been called since optimize().
+       */
+      bool has_substituted_values;
+
+      /**
+       * The evaluator used by the lambda optimizer.
+       */
+      std::unique_ptr<SymEngine::LambdaRealDoubleVisitor> lambda_visitor;
+
+#  ifdef DEAL_II_SYMENGINE_WITH_LLVM
+      /**
+       * The evaluator used by the LLVM optimizer.
+       */
+      std::unique_ptr<SymEngine::LLVMDoubleVisitor> llvm_visitor;
+#  endif
+
+      /**
+       * Scratch arrays used to convert between @p ReturnType and the
+       * double precision values the evaluators operate on.
+       */
+      std::vector<double> double_values;
+      std::vector<double> double_results;
+    };
+
+
+
+    /**
+     * @addtogroup Exceptions
+     * @{
+     */
+
+    /**
+     * Exception denoting that the optimizer has already been optimized.
+     */
+    DeclExceptionMsg(ExcAlreadyOptimized,
+                     "The optimizer has already been optimized, and can "
+                     "therefore not be modified anymore.");
+
+    /**
+     * Exception denoting that the optimizer has not yet been optimized.
+     */
+    DeclExceptionMsg(ExcNotOptimized,
+                     "The optimizer has not yet been optimized. Call "
+                     "optimize() first.");
+
+    //@}
+
+  } // namespace SD
+} // namespace Differentiation
+
+
+/* -------------------- inline and template functions ------------------ */
+
+
+#  ifndef DOXYGEN
+
+
+namespace Differentiation
+{
+  namespace SD
+  {
+    template <typename ReturnType>
+    template <class Archive>
+    void
+    BatchOptimizer<ReturnType>::save(Archive &ar,
+                                     const unsigned int /*version*/) const
+    {
+      const int method_as_int = static_cast<int>(method);
+      const int flags_as_int  = static_cast<int>(flags);
+
+      ar &method_as_int;
+      ar &flags_as_int;
+
+      // Symbols have to be stored before the functions that depend on them.
+      ar &independent_symbols;
+      ar &dependent_functions;
+      ar &is_optimized;
+
+      std::string compiled_object;
+      if (is_optimized)
+        compiled_object = dump_compiled_object();
+      ar &compiled_object;
+    }
+
+
+    template <typename ReturnType>
+    template <class Archive>
+    void
+    BatchOptimizer<ReturnType>::load(Archive &ar,
+                                     const unsigned int /*version*/)
+    {
+      int method_as_int;
+      int flags_as_int;
+      ar &method_as_int;
+      ar &flags_as_int;
+
+      types::symbol_vector symbols;
+      types::symbol_vector functions;
+      bool                 was_optimized;
+      std::string          compiled_object;
+
+      ar &symbols;
+      ar &functions;
+      ar &was_optimized;
+      ar &compiled_object;
+
+      // Reset this object to its initial state, and rebuild it from the
+      // stored data.
+      independent_symbols.clear();
+      dependent_functions.clear();
+      function_indices.clear();
+      function_values.clear();
+      is_optimized           = false;
+      has_substituted_values = false;
+      lambda_visitor.reset();
+#    ifdef DEAL_II_SYMENGINE_WITH_LLVM
+      llvm_visitor.reset();
+#    endif
+
+      set_optimization_method(static_cast<OptimizerType>(method_as_int),
+                              static_cast<OptimizationFlags>(flags_as_int));
+      register_symbols(symbols);
+      register_functions(functions);
+
+      if (was_optimized)
+        {
+          // Avoid the compilation if the compiled object could be stored.
+          if (compiled_object.empty() ||
+              load_compiled_object(compiled_object) == false)
+            optimize();
+        }
+    }
+
+  } // namespace SD
+} // namespace Differentiation
+
+
+#  endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // DEAL_II_WITH_SYMENGINE
+
+#endif
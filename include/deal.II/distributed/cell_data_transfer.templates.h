@@ -327,13 +327,24 @@ namespace parallel
             }
         }
 
+      // If the data of all cells has the same size, the values are written
+      // into the buffer one after the other, without the size information a
+      // packed container carries, which unpack_callback() can then recover
+      // from the size of the buffer.
+      if (transfer_variable_size_data == false)
+        {
+          std::vector<char> buffer;
+          buffer.reserve(cell_data.size() * sizeof(value_type));
+          for (const value_type &value : cell_data)
+            Utilities::pack(value, buffer, /*allow_compression=*/false);
+          return buffer;
+        }
+
       // We don't have to pack the whole container if there is just one entry.
       if (input_vectors.size() == 1)
-        return Utilities::pack(
-          cell_data[0], /*allow_compression=*/transfer_variable_size_data);
+        return Utilities::pack(cell_data[0], /*allow_compression=*/true);
       else
-        return Utilities::pack(
-          cell_data, /*allow_compression=*/transfer_variable_size_data);
+        return Utilities::pack(cell_data, /*allow_compression=*/true);
     }
 
 
@@ -354,16 +365,30 @@ namespace parallel
 
       // We have to unpack the corresponding datatype that has been packed
       // beforehand.
-      if (all_out.size() == 1)
-        cell_data.push_back(Utilities::unpack<value_type>(
-          data_range.begin(),
-          data_range.end(),
-          /*allow_compression=*/transfer_variable_size_data));
+      if (transfer_variable_size_data == false)
+        {
+          // the values of all vectors have been packed one after the other,
+          // and all have the same size
+          Assert(all_out.size() > 0 && data_range.size() % all_out.size() == 0,
+                 ExcInternalError());
+          const std::size_t value_size = data_range.size() / all_out.size();
+          cell_data.reserve(all_out.size());
+          for (unsigned int i = 0; i < all_out.size(); ++i)
+            cell_data.push_back(Utilities::unpack<value_type>(
+              data_range.begin() + i * value_size,
+              data_range.begin() + (i + 1) * value_size,
+              /*allow_compression=*/false));
+        }
+      else if (all_out.size() == 1)
+        cell_data.push_back(
+          Utilities::unpack<value_type>(data_range.begin(),
+                                        data_range.end(),
+                                        /*allow_compression=*/true));
       else
         cell_data = Utilities::unpack<std::vector<value_type>>(
           data_range.begin(),
           data_range.end(),
-          /*allow_compression=*/transfer_variable_size_data);
+          /*allow_compression=*/true);
 
       // Check if sizes match.
       Assert(cell_data.size() == all_out.size(), ExcInternalError());
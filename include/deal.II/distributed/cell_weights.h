@@ -22,9 +22,18 @@
 
 #include <deal.II/hp/dof_handler.h>
 
+#include <vector>
+
 
 DEAL_II_NAMESPACE_OPEN
 
+// forward declarations
+namespace Particles
+{
+  template <int, int>
+  class ParticleHandler;
+}
+
 namespace parallel
 {
   /**
@@ -67,6 +76,48 @@ namespace parallel
    * of each cell. See Triangulation::Signals::cell_weight for a discussion on
    * this topic.
    *
+   * Besides the finite element based weight chosen above, two further
+   * contributions can be added to the weight of each cell. First, the
+   * particles of a Particles::ParticleHandler can be taken into account via
+   * register_particle_weighting(). Second, the weight can be based on the
+   * cost of each cell that has actually been measured, e.g., during operator
+   * evaluations with MatrixFree::cell_loop(). These costs are reported with
+   * record_cell_cost() and are normalized by their global mean once right
+   * before each repartitioning, so that a cell with average cost receives
+   * the weight @p factor passed to register_measured_cost_weighting():
+   * @code
+   * cell_weights.register_measured_cost_weighting();
+   *
+   * matrix_free.cell_loop(
+   *   [&](const MatrixFree<dim, double> &data,
+   *       VectorType &                   dst,
+   *       const VectorType &             src,
+   *       const std::pair<unsigned int, unsigned int> &cell_range) {
+   *     Timer timer;
+   *     local_apply(data, dst, src, cell_range);
+   *     const double time = timer.wall_time();
+   *
+   *     unsigned int n_cells = 0;
+   *     for (unsigned int cell = cell_range.first; cell < cell_range.second;
+   *          ++cell)
+   *       n_cells += data.n_active_entries_per_cell_batch(cell);
+   *     for (unsigned int cell = cell_range.first; cell < cell_range.second;
+   *          ++cell)
+   *       for (unsigned int v = 0;
+   *            v < data.n_active_entries_per_cell_batch(cell);
+   *            ++v)
+   *         cell_weights.record_cell_cost(data.get_cell_iterator(cell, v),
+   *                                       time / n_cells);
+   *   },
+   *   dst,
+   *   src);
+   * @endcode
+   * Recorded costs refer to the current mesh and are discarded automatically
+   * whenever the Triangulation changes. All contributions are evaluated
+   * on-the-fly in the weight callback, which only touches locally stored
+   * data: no weights are precomputed and no communication takes place
+   * except for the single reduction determining the mean cost.
+   *
    * @note Be aware that this class connects the weight function to the
    * Triangulation during its construction. If the Triangulation
    * associated with the DoFHandler changes during the lifetime of the
@@ -133,6 +184,55 @@ namespace parallel
         const typename hp::DoFHandler<dim, spacedim>::cell_iterator &)>
         custom_function);
 
+    /**
+     * Additionally to the weighting function chosen above, add a weight of
+     * @p weight_per_particle for each particle of @p particle_handler that is
+     * located in a cell.
+     *
+     * If a cell is going to be refined, the particles of the parent cell are
+     * distributed evenly among its children. If cells are going to be
+     * coarsened, the particles of all children are accumulated on the parent.
+     *
+     * The @p particle_handler has to remain alive as long as this object is
+     * used for repartitioning.
+     */
+    void
+    register_particle_weighting(
+      const Particles::ParticleHandler<dim, spacedim> &particle_handler,
+      const unsigned int                               weight_per_particle = 10);
+
+    /**
+     * Additionally to the weighting function chosen above, add a weight
+     * proportional to the cost recorded on each cell via record_cell_cost().
+     * A cell whose cost equals the global mean of all recorded costs will be
+     * assigned a weight of @p factor.
+     *
+     * Passing a @p factor of zero disables this contribution.
+     */
+    void
+    register_measured_cost_weighting(const unsigned int factor = 1000);
+
+    /**
+     * Add @p cost to the cost recorded on the locally owned active @p cell.
+     * The unit of @p cost is arbitrary (e.g., seconds of wall time), as long
+     * as it is used consistently on all processes. Costs of subsequent calls
+     * on the same cell are accumulated.
+     *
+     * This function is not thread-safe if called concurrently on the same
+     * cell.
+     */
+    void
+    record_cell_cost(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+      const double                                                cost);
+
+    /**
+     * Discard all costs recorded with record_cell_cost() so far. This
+     * happens automatically whenever the Triangulation changes.
+     */
+    void
+    clear_cell_costs();
+
   private:
     /**
      * Pointer to the degree of freedom handler.
@@ -166,11 +266,63 @@ namespace parallel
       const typename hp::DoFHandler<dim, spacedim>::cell_iterator &)>
       weighting_function;
 
+    /**
+     * Pointer to the particle handler registered via
+     * register_particle_weighting(), if any.
+     */
+    const Particles::ParticleHandler<dim, spacedim> *particle_handler;
+
+    /**
+     * Weight added for each particle of the registered particle handler.
+     */
+    unsigned int weight_per_particle;
+
+    /**
+     * Weight assigned to a cell with average measured cost. Zero if measured
+     * costs are not taken into account.
+     */
+    unsigned int measured_cost_factor;
+
+    /**
+     * Costs recorded on each locally owned active cell, indexed by
+     * CellAccessor::active_cell_index(). Empty if no costs have been
+     * recorded on the current mesh.
+     */
+    std::vector<double> cell_costs;
+
+    /**
+     * Global mean of the recorded cell costs, determined right before each
+     * repartitioning.
+     */
+    double average_cell_cost;
+
     /**
      * A connection to the Triangulation of the DoFHandler.
      */
     boost::signals2::connection tria_listener;
 
+    /**
+     * Connections to the Triangulation to determine the average cell cost
+     * before, and to discard recorded costs after each change of the mesh.
+     */
+    std::vector<boost::signals2::connection> cost_listeners;
+
+    /**
+     * Compute the global mean of all recorded cell costs and store it in
+     * average_cell_cost. This is a collective operation.
+     */
+    void
+    update_average_cell_cost();
+
+    /**
+     * Return the additional weight of @p cell due to particles and measured
+     * costs, depending on its future @p status.
+     */
+    unsigned int
+    additional_weight(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+      const typename Triangulation<dim, spacedim>::CellStatus     status) const;
+
     /**
      * A callback function that will be attached to the cell_weight signal of
      * the Triangulation, that is a member of the DoFHandler. Ultimately
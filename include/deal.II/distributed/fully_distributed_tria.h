@@ -0,0 +1,436 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_distributed_fully_distributed_tria_h
+#define dealii_distributed_fully_distributed_tria_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/point.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <boost/serialization/array.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#ifdef DEAL_II_WITH_MPI
+#  include <mpi.h>
+#endif
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace parallel
+{
+  /**
+   * A namespace for the fully distributed triangulation, in which each
+   * process only stores the part of the mesh it needs, including the coarse
+   * mesh, and the data structures used to describe such a part.
+   */
+  namespace fullydistributed
+  {
+    /**
+     * The data of a coarse cell of the part of a mesh stored by one process.
+     */
+    template <int dim>
+    struct CoarseCellData
+    {
+      /**
+       * Constructor. Set all manifold ids to numbers::flat_manifold_id.
+       */
+      CoarseCellData();
+
+      /**
+       * The indices of the vertices of the cell into
+       * ConstructionData::coarse_cell_vertices.
+       */
+      std::array<unsigned int, GeometryInfo<dim>::vertices_per_cell> vertices;
+
+      /**
+       * The manifold ids of the faces of the cell. Not used in 1d.
+       */
+      std::array<types::manifold_id, GeometryInfo<dim>::faces_per_cell>
+        face_manifold_ids;
+
+      /**
+       * The manifold ids of the lines of the cell. Only used in 3d.
+       */
+      std::array<types::manifold_id, GeometryInfo<dim>::lines_per_cell>
+        line_manifold_ids;
+
+      /**
+       * Read or write the data of this object to or from a stream for the
+       * purpose of serialization.
+       */
+      template <class Archive>
+      void
+      serialize(Archive &ar, const unsigned int version);
+    };
+
+
+
+    /**
+     * The data of a cell, on any level, of the part of a mesh stored by one
+     * process.
+     */
+    template <int dim>
+    struct CellData
+    {
+      /**
+       * Constructor.
+       */
+      CellData();
+
+      /**
+       * The index of the coarse cell this cell descends from, within
+       * ConstructionData::coarse_cells.
+       */
+      unsigned int coarse_cell_index;
+
+      /**
+       * The child indices leading from the coarse cell to this cell, as for
+       * a CellId.
+       */
+      std::vector<std::uint8_t> child_indices;
+
+      /**
+       * The refinement case of the cell, which is
+       * RefinementCase::no_refinement for active cells.
+       */
+      std::uint8_t refinement_case;
+
+      /**
+       * The subdomain id of the cell if it is active, or
+       * numbers::artificial_subdomain_id otherwise.
+       */
+      types::subdomain_id subdomain_id;
+
+      /**
+       * The material id of the cell.
+       */
+      types::material_id material_id;
+
+      /**
+       * The manifold id of the cell.
+       */
+      types::manifold_id manifold_id;
+
+      /**
+       * The boundary ids of the faces of the cell, with
+       * numbers::internal_face_boundary_id for faces in the interior of the
+       * mesh.
+       */
+      std::array<types::boundary_id, GeometryInfo<dim>::faces_per_cell>
+        boundary_ids;
+
+      /**
+       * Read or write the data of this object to or from a stream for the
+       * purpose of serialization.
+       */
+      template <class Archive>
+      void
+      serialize(Archive &ar, const unsigned int version);
+    };
+
+
+
+    /**
+     * The description of the part of a mesh stored by one process of a
+     * parallel::fullydistributed::Triangulation: the coarse cells this part
+     * descends from, with their vertices, and the cells on all levels that
+     * are either locally owned, ghost cells, or ancestors of such cells.
+     *
+     * Objects of this type are usually created by
+     * create_construction_data() from a partitioned mesh. Since they can be
+     * serialized, this can be done once, with the data for each process
+     * written to a separate file, which the processes then read in parallel
+     * at the start of each simulation.
+     */
+    template <int dim, int spacedim = dim>
+    struct ConstructionData
+    {
+      /**
+       * The vertices of the coarse cells.
+       */
+      std::vector<Point<spacedim>> coarse_cell_vertices;
+
+      /**
+       * The coarse cells.
+       */
+      std::vector<CoarseCellData<dim>> coarse_cells;
+
+      /**
+       * The index of each of the coarse cells in the coarse mesh of the
+       * triangulation the data were extracted from.
+       */
+      std::vector<unsigned int> coarse_cell_index_to_coarse_cell_id;
+
+      /**
+       * The cells on each level, with all cells on a level given after its
+       * parents.
+       */
+      std::vector<std::vector<CellData<dim>>> cell_infos;
+
+      /**
+       * Read or write the data of this object to or from a stream for the
+       * purpose of serialization.
+       */
+      template <class Archive>
+      void
+      serialize(Archive &ar, const unsigned int version);
+    };
+
+
+
+    /**
+     * Extract the part of @p tria that the process with the subdomain id
+     * @p subdomain needs to store in a parallel::fullydistributed
+     * ::Triangulation. The active cells of @p tria need to have been
+     * partitioned, e.g. by GridTools::partition_triangulation(), so that the
+     * subdomain id of each active cell denotes the process owning it.
+     *
+     * The returned data contain the locally owned cells, all active cells
+     * that share a vertex with one of them as ghost cells, all ancestors of
+     * these cells, and the coarse cells they descend from.
+     */
+    template <int dim, int spacedim>
+    ConstructionData<dim, spacedim>
+    create_construction_data(const dealii::Triangulation<dim, spacedim> &tria,
+                             const types::subdomain_id subdomain);
+
+
+
+    /**
+     * Create the part of the mesh GridGenerator::subdivided_hyper_rectangle()
+     * creates for the given @p repetitions, @p p1, @p p2, and @p colorize
+     * that partition @p partition out of @p n_partitions needs to store in a
+     * parallel::fullydistributed::Triangulation, without ever creating the
+     * whole mesh. This function therefore works for meshes with far more
+     * cells than a single process could hold, and its cost only depends on
+     * the size of the part it returns.
+     *
+     * The cells are partitioned by recursive coordinate bisection of the
+     * brick of cells: the brick is split in the direction of its largest
+     * extent into two bricks whose numbers of cells are proportional to the
+     * numbers of partitions assigned to them, and so on until each brick
+     * belongs to one partition. The returned data contain the cells of the
+     * brick of @p partition, the cells sharing a vertex with them as ghost
+     * cells, and a coarse cell for each of these cells. The index of each
+     * coarse cell in ConstructionData::coarse_cell_index_to_coarse_cell_id is
+     * the one of the respective cell in the mesh created by
+     * GridGenerator::subdivided_hyper_rectangle().
+     *
+     * Typically, each process calls this function with its rank in the
+     * communicator of the triangulation as @p partition and the size of
+     * the communicator as @p n_partitions:
+     * @code
+     * parallel::fullydistributed::Triangulation<3> tria(mpi_communicator);
+     * tria.create_triangulation(
+     *   parallel::fullydistributed::
+     *     create_subdivided_hyper_rectangle_construction_data<3>(
+     *       {1000, 1000, 1000},
+     *       Point<3>(),
+     *       Point<3>(1, 1, 1),
+     *       Utilities::MPI::n_mpi_processes(mpi_communicator),
+     *       Utilities::MPI::this_mpi_process(mpi_communicator)));
+     * @endcode
+     *
+     * Since the coarse cells are identified by an <code>unsigned int</code>,
+     * the mesh may have at most 2<sup>32</sup>-1 cells. Each partition needs
+     * to receive at least one cell.
+     */
+    template <int dim>
+    ConstructionData<dim>
+    create_subdivided_hyper_rectangle_construction_data(
+      const std::vector<unsigned int> &repetitions,
+      const Point<dim> &               p1,
+      const Point<dim> &               p2,
+      const unsigned int               n_partitions,
+      const unsigned int               partition,
+      const bool                       colorize = false);
+
+
+
+#ifdef DEAL_II_WITH_MPI
+
+    /**
+     * A distributed triangulation in which each process only stores the
+     * locally owned cells, a layer of ghost cells around them, and their
+     * ancestors, including only those coarse cells they descend from. In
+     * contrast to parallel::distributed::Triangulation, the coarse mesh is
+     * therefore not replicated on all processes, so that meshes with very
+     * many coarse cells can be used.
+     *
+     * The triangulation is not created from a coarse mesh that is then
+     * partitioned, but from a ConstructionData object with the part of the
+     * mesh of this process, see create_construction_data(). Since only the
+     * vertices of the coarse cells are stored, the manifolds of the mesh need
+     * to be attached before calling create_triangulation(), so that the
+     * vertices of the refined cells are placed as in the original mesh.
+     *
+     * The partitioning is fixed: the mesh can neither be refined nor
+     * coarsened.
+     *
+     * @note Creating a DoFHandler and enumerating degrees of freedom on this
+     * triangulation is not supported yet: the parallel algorithms of
+     * DoFHandler are specific to parallel::shared::Triangulation and
+     * parallel::distributed::Triangulation.
+     */
+    template <int dim, int spacedim = dim>
+    class Triangulation : public dealii::parallel::Triangulation<dim, spacedim>
+    {
+    public:
+      /**
+       * Constructor.
+       */
+      explicit Triangulation(MPI_Comm mpi_communicator);
+
+      /**
+       * Destructor.
+       */
+      virtual ~Triangulation() override = default;
+
+      /**
+       * Create the part of the mesh of this process from
+       * @p construction_data.
+       */
+      void
+      create_triangulation(
+        const ConstructionData<dim, spacedim> &construction_data);
+
+      /**
+       * This function is not supported for this class, since the mesh needs
+       * to be created from a ConstructionData object.
+       */
+      virtual void
+      create_triangulation(const std::vector<Point<spacedim>> &vertices,
+                           const std::vector<dealii::CellData<dim>> &cells,
+                           const SubCellData &subcelldata) override;
+
+      /**
+       * This function is not supported for this class.
+       */
+      virtual void
+      copy_triangulation(
+        const dealii::Triangulation<dim, spacedim> &other_tria) override;
+
+      /**
+       * This function is not supported for this class, since the
+       * partitioning of the mesh cannot change.
+       */
+      virtual void
+      execute_coarsening_and_refinement() override;
+
+      /**
+       * Return the index of the coarse cell with the given local @p index in
+       * the coarse mesh of the triangulation the mesh was extracted from.
+       */
+      unsigned int
+      coarse_cell_index_to_coarse_cell_id(const unsigned int index) const;
+
+      /**
+       * Return an estimate for the memory consumption, in bytes, of this
+       * object.
+       */
+      virtual std::size_t
+      memory_consumption() const override;
+
+    private:
+      /**
+       * The global index of each local coarse cell.
+       */
+      std::vector<unsigned int> coarse_cell_ids;
+    };
+
+#else
+
+    /**
+     * Dummy class the compiler chooses for fully distributed triangulations
+     * if we didn't actually configure deal.II with the MPI library. The
+     * existence of this class allows us to refer to
+     * parallel::fullydistributed::Triangulation objects throughout the
+     * library even if it is disabled.
+     *
+     * Since the constructor of this class is deleted, no such objects
+     * can actually be created as this would be pointless given that
+     * MPI is not available.
+     */
+    template <int dim, int spacedim = dim>
+    class Triangulation : public dealii::parallel::Triangulation<dim, spacedim>
+    {
+    public:
+      /**
+       * Constructor. Deleted to make sure that objects of this type cannot be
+       * constructed (see also the class documentation).
+       */
+      Triangulation() = delete;
+    };
+
+#endif
+
+
+
+    /* ---------------------- inline functions --------------------- */
+
+#ifndef DOXYGEN
+
+    template <int dim>
+    template <class Archive>
+    void
+    CoarseCellData<dim>::serialize(Archive &ar, const unsigned int)
+    {
+      ar &vertices &face_manifold_ids &line_manifold_ids;
+    }
+
+
+
+    template <int dim>
+    template <class Archive>
+    void
+    CellData<dim>::serialize(Archive &ar, const unsigned int)
+    {
+      ar &coarse_cell_index &child_indices &refinement_case;
+      ar &subdomain_id &material_id &manifold_id;
+      ar &boundary_ids;
+    }
+
+
+
+    template <int dim, int spacedim>
+    template <class Archive>
+    void
+    ConstructionData<dim, spacedim>::serialize(Archive &ar,
+                                               const unsigned int)
+    {
+      ar &coarse_cell_vertices &coarse_cells;
+      ar &coarse_cell_index_to_coarse_cell_id;
+      ar &cell_infos;
+    }
+
+#endif // DOXYGEN
+  } // namespace fullydistributed
+} // namespace parallel
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -22,6 +22,7 @@
 
 #include <deal.II/dofs/dof_handler.h>
 
+#include <string>
 #include <vector>
 
 
@@ -344,6 +345,121 @@ namespace parallel
       void
       deserialize(std::vector<VectorType *> &all_in);
 
+      /**
+       * Write the values of the vectors in @p all_in directly into the file
+       * @p filename, bypassing the machinery of Triangulation::save().
+       *
+       * The values are written, for each locally owned active cell, as
+       * obtained by DoFCellAccessor::get_dof_values(). The cells are ordered
+       * in the canonical order in which p4est enumerates all active cells of
+       * the forest, which does not depend on the partitioning of the mesh.
+       * Each process writes its contiguous part of the file with collective
+       * MPI-IO calls, without packing the data of each cell into a separate
+       * buffer. As a consequence, the file can be read by load() on a
+       * different number of processes, as long as the triangulation has been
+       * recreated with the same sequence of refinements (e.g. by
+       * Triangulation::save() and Triangulation::load()).
+       *
+       * The given vectors need all information on the locally active DoFs
+       * (they must be ghosted). All cells need to have the same number of
+       * degrees of freedom, so for hp::DoFHandler objects only a single
+       * finite element is supported.
+       *
+       * This is a collective operation on the communicator of the
+       * triangulation.
+       */
+      void
+      save(const std::vector<const VectorType *> &all_in,
+           const std::string &                    filename) const;
+
+      /**
+       * Same as the function above, only for a single vector.
+       */
+      void
+      save(const VectorType &in, const std::string &filename) const;
+
+      /**
+       * Read the values of the vectors in @p all_out from the file
+       * @p filename previously written by save(), possibly on a different
+       * number of processes. The given vectors must be fully distributed
+       * vectors without ghost elements, and there must be as many vectors as
+       * have been written.
+       *
+       * This is a collective operation on the communicator of the
+       * triangulation.
+       */
+      void
+      load(std::vector<VectorType *> &all_out,
+           const std::string &        filename) const;
+
+      /**
+       * Same as the function above, only for a single vector.
+       */
+      void
+      load(VectorType &out, const std::string &filename) const;
+
+      /**
+       * Prepare the transfer of the vectors in @p all_in across a call of
+       * parallel::distributed::Triangulation::repartition() that does not
+       * change the mesh itself, but only moves cells between processes.
+       *
+       * In contrast to prepare_for_coarsening_and_refinement(), the values
+       * are not attached to each cell and shipped via p4est. Instead, the
+       * values of all locally owned cells are copied into one contiguous
+       * buffer in the order in which p4est enumerates the active cells of the
+       * forest (see save()). Since repartitioning moves contiguous ranges of
+       * this order between processes, interpolate_after_repartitioning() can
+       * then send the buffer in at most one point-to-point message per pair
+       * of processes whose old and new ranges overlap, and write the values
+       * directly without any interpolation.
+       *
+       * The given vectors need all information on the locally active DoFs
+       * (they must be ghosted). All cells need to have the same number of
+       * degrees of freedom, so for hp::DoFHandler objects only a single
+       * finite element is supported.
+       *
+       * This is a collective operation on the communicator of the
+       * triangulation. A typical use looks as follows:
+       * @code
+       * SolutionTransfer<dim, VectorType> soltrans(dof_handler);
+       * soltrans.prepare_for_repartitioning(ghosted_solution);
+       *
+       * triangulation.repartition();
+       * dof_handler.distribute_dofs(fe);
+       *
+       * VectorType solution(...);
+       * soltrans.interpolate_after_repartitioning(solution);
+       * @endcode
+       */
+      void
+      prepare_for_repartitioning(const std::vector<const VectorType *> &all_in);
+
+      /**
+       * Same as the function above, only for a single vector.
+       */
+      void
+      prepare_for_repartitioning(const VectorType &in);
+
+      /**
+       * Distribute the values stored by prepare_for_repartitioning() onto the
+       * repartitioned mesh and write them into @p all_out. The
+       * triangulation must have been repartitioned without refinement or
+       * coarsening, and the DoFHandler must have been redistributed. The
+       * given vectors must be fully distributed vectors without ghost
+       * elements, and there must be as many vectors as have been prepared.
+       *
+       * This is a collective operation on the communicator of the
+       * triangulation.
+       */
+      void
+      interpolate_after_repartitioning(std::vector<VectorType *> &all_out);
+
+      /**
+       * Same as the function above, only for a single vector.
+       */
+      void
+      interpolate_after_repartitioning(VectorType &out);
+
     private:
       /**
        * Pointer to the degree of freedom handler to work with.
@@ -364,6 +480,24 @@ namespace parallel
        */
       unsigned int handle;
 
+      /**
+       * The values of all vectors on the locally owned cells stored by
+       * prepare_for_repartitioning(), in the layout [cell][vector][dof] with
+       * the cells in p4est order.
+       */
+      std::vector<typename VectorType::value_type> repartition_data;
+
+      /**
+       * The number of vectors stored in repartition_data.
+       */
+      unsigned int repartition_n_vectors;
+
+      /**
+       * The position of the first locally owned cell in p4est order before
+       * repartitioning.
+       */
+      unsigned long long int repartition_first_cell;
+
       /**
        * A callback function used to pack the data on the current mesh into
        * objects that can later be retrieved after refinement, coarsening and
@@ -391,6 +525,14 @@ namespace parallel
           &                        data_range,
         std::vector<VectorType *> &all_out);
 
+      /**
+       * Return the locally owned active cells in the order in which p4est
+       * enumerates the active cells of the forest. This is the order used
+       * by save() and load().
+       */
+      std::vector<typename DoFHandlerType::active_cell_iterator>
+      get_locally_owned_cells_in_p4est_order() const;
+
 
       /**
        * Registers the pack_callback() function to the
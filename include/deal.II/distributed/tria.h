@@ -539,6 +539,15 @@ namespace parallel
        * Triangulation::n_vertices() and must be a subset of those vertices
        * flagged by GridTools::get_locally_owned_vertices().
        *
+       * The first call determines, cell by cell, which vertices need to be
+       * sent to which process and which local vertices the received
+       * coordinates belong to. These lists are kept, and subsequent calls
+       * with the same @p vertex_locally_moved argument on all processes, as
+       * is typical for moving meshes where the same vertices move in every
+       * time step, only exchange the coordinates of the vertices in one
+       * contiguous message per pair of processes. The lists are rebuilt
+       * after the mesh has been refined, coarsened, or repartitioned.
+       *
        * @see This function is used, for example, in
        * GridTools::distort_random().
        */
@@ -1129,6 +1138,50 @@ namespace parallel
 
       DataTransfer data_transfer;
 
+      /**
+       * The vertices exchanged by communicate_locally_moved_vertices() with
+       * other processes, kept so that later calls for the same set of moved
+       * vertices only need to send coordinates. Reset in clear() and
+       * copy_local_forest_to_triangulation(), i.e., whenever the local part
+       * of the mesh changes.
+       */
+      struct MovedVerticesExchange
+      {
+        /**
+         * Constructor.
+         */
+        MovedVerticesExchange();
+
+        /**
+         * Whether the lists below have been set up.
+         */
+        bool is_valid;
+
+        /**
+         * The argument of the call of communicate_locally_moved_vertices()
+         * the lists below were set up for.
+         */
+        std::vector<bool> vertex_locally_moved;
+
+        /**
+         * The processes vertices are sent to, and for each of them the
+         * indices of the vertices sent in the order they are sent in.
+         */
+        std::vector<types::subdomain_id>       send_to;
+        std::vector<std::vector<unsigned int>> send_vertices;
+
+        /**
+         * The processes vertices are received from, and for each of them the
+         * cells and vertex numbers within the cell the received coordinates
+         * are written to, in the order they are received in.
+         */
+        std::vector<types::subdomain_id> receive_from;
+        std::vector<std::vector<std::pair<cell_iterator, unsigned int>>>
+          receive_vertices;
+      };
+
+      MovedVerticesExchange moved_vertices_exchange;
+
       /**
        * Two arrays that store which p4est tree corresponds to which coarse
        * grid cell and vice versa. We need these arrays because p4est goes
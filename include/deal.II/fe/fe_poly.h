@@ -19,9 +19,13 @@
 
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/std_cxx14/memory.h>
+#include <deal.II/base/thread_management.h>
 
 #include <deal.II/fe/fe.h>
 
+#include <memory>
+#include <vector>
+
 DEAL_II_NAMESPACE_OPEN
 
 /*!@addtogroup febase */
@@ -106,6 +110,12 @@ public:
   std::vector<unsigned int>
   get_poly_space_numbering_inverse() const;
 
+  /**
+   * Return the underlying polynomial space.
+   */
+  const PolynomialType &
+  get_poly_space() const;
+
   /**
    * Return the value of the <tt>i</tt>th shape function at the point
    * <tt>p</tt>. See the FiniteElement base class for more information about
@@ -250,97 +260,26 @@ protected:
 
     const unsigned int n_q_points = quadrature.size();
 
-    // initialize some scratch arrays. we need them for the underlying
-    // polynomial to put the values and derivatives of shape functions
-    // to put there, depending on what the user requested
-    std::vector<double> values(
-      update_flags & update_values ? this->dofs_per_cell : 0);
-    std::vector<Tensor<1, dim>> grads(
-      update_flags & update_gradients ? this->dofs_per_cell : 0);
-    std::vector<Tensor<2, dim>> grad_grads(
-      update_flags & update_hessians ? this->dofs_per_cell : 0);
-    std::vector<Tensor<3, dim>> third_derivatives(
-      update_flags & update_3rd_derivatives ? this->dofs_per_cell : 0);
-    std::vector<Tensor<4, dim>>
-      fourth_derivatives; // won't be needed, so leave empty
-
-    // now also initialize fields the fields of this class's own
-    // temporary storage, depending on what we need for the given
-    // update flags.
-    //
-    // there is one exception from the rule: if we are dealing with
-    // cells (i.e., if this function is not called via
-    // get_(sub)face_data()), then we can already store things in the
-    // final location where FEValues::reinit() later wants to see
-    // things. we then don't need the intermediate space. we determine
-    // whether we are on a cell by asking whether the number of
-    // elements in the output array equals the number of quadrature
-    // points (yes, it's a cell) or not (because in that case the
-    // number of quadrature points we use here equals the number of
-    // quadrature points summed over *all* faces or subfaces, whereas
-    // the number of output slots equals the number of quadrature
-    // points on only *one* face)
+    // the values and derivatives of the shape functions on the unit cell
+    // only depend on the quadrature formula and the update flags, so we
+    // share them between all FEValues objects that use the same
+    // combination (e.g., the copies of a FEValues object in the scratch
+    // data of WorkStream), rather than computing and storing them once
+    // per object
+    data.shape_tables = get_shape_tables(update_flags, quadrature);
+
+    // the values of shape functions at quadrature points don't change.
+    // consequently, write these values right into the output array if we
+    // can, i.e., if the output array has the correct size. this is the case
+    // on cells. on faces, we precompute data on *all* faces and subfaces,
+    // but later on copy only a portion of it into the output object; in
+    // that case, fill_fe_face_values() and fill_fe_subface_values() take
+    // the values from the shared tables
     if ((update_flags & update_values) &&
-        !((output_data.shape_values.n_rows() > 0) &&
-          (output_data.shape_values.n_cols() == n_q_points)))
-      data.shape_values.reinit(this->dofs_per_cell, n_q_points);
-
-    if (update_flags & update_gradients)
-      data.shape_gradients.reinit(this->dofs_per_cell, n_q_points);
-
-    if (update_flags & update_hessians)
-      data.shape_hessians.reinit(this->dofs_per_cell, n_q_points);
-
-    if (update_flags & update_3rd_derivatives)
-      data.shape_3rd_derivatives.reinit(this->dofs_per_cell, n_q_points);
-
-    // next already fill those fields of which we have information by
-    // now. note that the shape gradients are only those on the unit
-    // cell, and need to be transformed when visiting an actual cell
-    if (update_flags & (update_values | update_gradients | update_hessians |
-                        update_3rd_derivatives))
-      for (unsigned int i = 0; i < n_q_points; ++i)
-        {
-          poly_space.compute(quadrature.point(i),
-                             values,
-                             grads,
-                             grad_grads,
-                             third_derivatives,
-                             fourth_derivatives);
-
-          // the values of shape functions at quadrature points don't change.
-          // consequently, write these values right into the output array if
-          // we can, i.e., if the output array has the correct size. this is
-          // the case on cells. on faces, we already precompute data on *all*
-          // faces and subfaces, but we later on copy only a portion of it
-          // into the output object; in that case, copy the data from all
-          // faces into the scratch object
-          if (update_flags & update_values)
-            if (output_data.shape_values.n_rows() > 0)
-              {
-                if (output_data.shape_values.n_cols() == n_q_points)
-                  for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-                    output_data.shape_values[k][i] = values[k];
-                else
-                  for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-                    data.shape_values[k][i] = values[k];
-              }
-
-          // for everything else, derivatives need to be transformed,
-          // so we write them into our scratch space and only later
-          // copy stuff into where FEValues wants it
-          if (update_flags & update_gradients)
-            for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-              data.shape_gradients[k][i] = grads[k];
-
-          if (update_flags & update_hessians)
-            for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-              data.shape_hessians[k][i] = grad_grads[k];
-
-          if (update_flags & update_3rd_derivatives)
-            for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-              data.shape_3rd_derivatives[k][i] = third_derivatives[k];
-        }
+        (output_data.shape_values.n_rows() > 0) &&
+        (output_data.shape_values.n_cols() == n_q_points))
+      output_data.shape_values = data.shape_tables->shape_values;
+
     return data_ptr;
   }
 
@@ -391,14 +330,15 @@ protected:
       &output_data) const override;
 
   /**
-   * Fields of cell-independent data.
-   *
-   * For information about the general purpose of this class, see the
-   * documentation of the base class.
+   * Values and derivatives of the shape functions in the quadrature points
+   * of the unit cell. These do not depend on the cell an FEValues object is
+   * reinitialized with, and are therefore computed only once for each
+   * combination of quadrature formula and update flags and then shared
+   * (without further modification) between all InternalData objects that
+   * need them.
    */
-  class InternalData : public FiniteElement<dim, spacedim>::InternalDataBase
+  struct ShapeTables
   {
-  public:
     /**
      * Array with shape function values in quadrature points. There is one row
      * for each shape function, containing values for each quadrature point.
@@ -444,6 +384,36 @@ protected:
     Table<2, Tensor<3, dim>> shape_3rd_derivatives;
   };
 
+  /**
+   * Fields of cell-independent data.
+   *
+   * For information about the general purpose of this class, see the
+   * documentation of the base class.
+   */
+  class InternalData : public FiniteElement<dim, spacedim>::InternalDataBase
+  {
+  public:
+    /**
+     * Values and derivatives of the shape functions on the unit cell. This
+     * object is shared with all other InternalData objects created for the
+     * same quadrature formula and update flags, and must therefore not be
+     * changed.
+     */
+    std::shared_ptr<const ShapeTables> shape_tables;
+  };
+
+  /**
+   * Return the values and derivatives of the shape functions in the points
+   * of @p quadrature, as requested by @p update_flags. If another object
+   * previously asked for the same combination and still holds on to the
+   * result, the existing tables are returned; otherwise, they are computed
+   * and recorded for later calls. This function can be called concurrently
+   * from several threads.
+   */
+  std::shared_ptr<const ShapeTables>
+  get_shape_tables(const UpdateFlags      update_flags,
+                   const Quadrature<dim> &quadrature) const;
+
   /**
    * Correct the shape third derivatives by subtracting the terms
    * corresponding to the Jacobian pushed forward gradient and second
@@ -480,6 +450,31 @@ protected:
    * PolynomialType.
    */
   PolynomialType poly_space;
+
+private:
+  /**
+   * An entry of the cache of shape function tables kept by
+   * get_shape_tables().
+   */
+  struct ShapeTablesCacheEntry
+  {
+    UpdateFlags                      update_flags;
+    Quadrature<dim>                  quadrature;
+    std::weak_ptr<const ShapeTables> tables;
+  };
+
+  /**
+   * The shape function tables computed by get_shape_tables() and still in
+   * use by some InternalData object. Since only weak pointers are stored,
+   * the tables are released as soon as the last FEValues object using them
+   * is destroyed.
+   */
+  mutable std::vector<ShapeTablesCacheEntry> shape_tables_cache;
+
+  /**
+   * A mutex guarding access to shape_tables_cache.
+   */
+  mutable Threads::Mutex shape_tables_cache_mutex;
 };
 
 /*@}*/
@@ -26,9 +26,67 @@
 #include <deal.II/fe/fe_poly.h>
 #include <deal.II/fe/fe_values.h>
 
+#include <algorithm>
+#include <mutex>
+
 
 DEAL_II_NAMESPACE_OPEN
 
+namespace internal
+{
+  namespace FE_PolyImplementation
+  {
+    /**
+     * Fill the given tables of shape values, gradients and hessians at all
+     * the given points in one sweep if the polynomial space provides a
+     * batched evaluate() function, and return whether it did so. The
+     * general case does nothing and returns false, in which case the caller
+     * has to evaluate the polynomial space point by point.
+     */
+    template <class PolynomialType, int dim>
+    bool
+    evaluate_batched(const PolynomialType &,
+                     const std::vector<Point<dim>> &,
+                     Table<2, double> &,
+                     Table<2, Tensor<1, dim>> &,
+                     Table<2, Tensor<2, dim>> &)
+    {
+      return false;
+    }
+
+
+
+    template <int dim, typename PolynomialType>
+    bool
+    evaluate_batched(
+      const TensorProductPolynomials<dim, PolynomialType> &poly_space,
+      const std::vector<Point<dim>> &                      points,
+      Table<2, double> &                                   values,
+      Table<2, Tensor<1, dim>> &                           grads,
+      Table<2, Tensor<2, dim>> &                           grad_grads)
+    {
+      poly_space.evaluate(points, values, grads, grad_grads);
+      return true;
+    }
+
+
+
+    template <int dim>
+    bool
+    evaluate_batched(const PolynomialSpace<dim> &   poly_space,
+                     const std::vector<Point<dim>> &points,
+                     Table<2, double> &             values,
+                     Table<2, Tensor<1, dim>> &     grads,
+                     Table<2, Tensor<2, dim>> &     grad_grads)
+    {
+      poly_space.evaluate(points, values, grads, grad_grads);
+      return true;
+    }
+  } // namespace FE_PolyImplementation
+} // namespace internal
+
+
+
 template <class PolynomialType, int dim, int spacedim>
 FE_Poly<PolynomialType, dim, spacedim>::FE_Poly(
   const PolynomialType &            poly_space,
@@ -216,6 +274,121 @@ FE_Poly<PolynomialType, dim, spacedim>::requires_update_flags(
 
 
 
+
+template <class PolynomialType, int dim, int spacedim>
+std::shared_ptr<
+  const typename FE_Poly<PolynomialType, dim, spacedim>::ShapeTables>
+FE_Poly<PolynomialType, dim, spacedim>::get_shape_tables(
+  const UpdateFlags      update_flags,
+  const Quadrature<dim> &quadrature) const
+{
+  // only the flags that determine the contents of the tables are relevant
+  // for finding a match
+  const UpdateFlags flags =
+    update_flags &
+    (update_values | update_gradients | update_hessians |
+     update_3rd_derivatives);
+
+  {
+    std::lock_guard<std::mutex> lock(shape_tables_cache_mutex);
+
+    // drop the entries whose tables are no longer in use by anyone, and
+    // look for one that matches the current request
+    shape_tables_cache.erase(
+      std::remove_if(shape_tables_cache.begin(),
+                     shape_tables_cache.end(),
+                     [](const ShapeTablesCacheEntry &entry) {
+                       return entry.tables.expired();
+                     }),
+      shape_tables_cache.end());
+
+    for (const ShapeTablesCacheEntry &entry : shape_tables_cache)
+      if (entry.update_flags == flags && entry.quadrature == quadrature)
+        if (std::shared_ptr<const ShapeTables> tables = entry.tables.lock())
+          return tables;
+  }
+
+  // no match found. compute the tables outside the lock, so that other
+  // threads are not held up in the meantime
+  auto tables = std::make_shared<ShapeTables>();
+
+  const unsigned int n_q_points = quadrature.size();
+
+  // initialize some scratch arrays. we need them for the underlying
+  // polynomial to put the values and derivatives of shape functions
+  // to put there, depending on what the user requested
+  std::vector<double> values(flags & update_values ? this->dofs_per_cell : 0);
+  std::vector<Tensor<1, dim>> grads(
+    flags & update_gradients ? this->dofs_per_cell : 0);
+  std::vector<Tensor<2, dim>> grad_grads(
+    flags & update_hessians ? this->dofs_per_cell : 0);
+  std::vector<Tensor<3, dim>> third_derivatives(
+    flags & update_3rd_derivatives ? this->dofs_per_cell : 0);
+  std::vector<Tensor<4, dim>>
+    fourth_derivatives; // won't be needed, so leave empty
+
+  if (flags & update_values)
+    tables->shape_values.reinit(this->dofs_per_cell, n_q_points);
+
+  if (flags & update_gradients)
+    tables->shape_gradients.reinit(this->dofs_per_cell, n_q_points);
+
+  if (flags & update_hessians)
+    tables->shape_hessians.reinit(this->dofs_per_cell, n_q_points);
+
+  if (flags & update_3rd_derivatives)
+    tables->shape_3rd_derivatives.reinit(this->dofs_per_cell, n_q_points);
+
+  // third derivatives are not supported by the batched evaluation of the
+  // polynomial spaces, in which case we fall back to the loop below
+  const bool evaluated_in_batches =
+    !(flags & update_3rd_derivatives) &&
+    internal::FE_PolyImplementation::evaluate_batched(poly_space,
+                                                      quadrature.get_points(),
+                                                      tables->shape_values,
+                                                      tables->shape_gradients,
+                                                      tables->shape_hessians);
+
+  // note that the shape gradients are only those on the unit cell, and need
+  // to be transformed when visiting an actual cell
+  if (flags != update_default && !evaluated_in_batches)
+    for (unsigned int i = 0; i < n_q_points; ++i)
+      {
+        poly_space.compute(quadrature.point(i),
+                           values,
+                           grads,
+                           grad_grads,
+                           third_derivatives,
+                           fourth_derivatives);
+
+        if (flags & update_values)
+          for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
+            tables->shape_values[k][i] = values[k];
+
+        if (flags & update_gradients)
+          for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
+            tables->shape_gradients[k][i] = grads[k];
+
+        if (flags & update_hessians)
+          for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
+            tables->shape_hessians[k][i] = grad_grads[k];
+
+        if (flags & update_3rd_derivatives)
+          for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
+            tables->shape_3rd_derivatives[k][i] = third_derivatives[k];
+      }
+
+  // record the tables for later requests. if another thread has computed
+  // the same tables in the meantime, the two copies simply coexist until
+  // one of them expires
+  std::lock_guard<std::mutex> lock(shape_tables_cache_mutex);
+  shape_tables_cache.push_back(
+    ShapeTablesCacheEntry{flags, quadrature, tables});
+
+  return tables;
+}
+
+
 //---------------------------------------------------------------------------
 // Fill data of FEValues
 //---------------------------------------------------------------------------
@@ -245,6 +418,8 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_values(
          ExcInternalError());
   const InternalData &fe_data = static_cast<const InternalData &>(fe_internal);
 
+  const ShapeTables &shape_tables = *fe_data.shape_tables;
+
   const UpdateFlags flags(fe_data.update_each);
 
   // transform gradients and higher derivatives. there is nothing to do
@@ -253,7 +428,7 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_values(
   if (flags & update_gradients &&
       cell_similarity != CellSimilarity::translation)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-      mapping.transform(make_array_view(fe_data.shape_gradients, k),
+      mapping.transform(make_array_view(shape_tables.shape_gradients, k),
                         mapping_covariant,
                         mapping_internal,
                         make_array_view(output_data.shape_gradients, k));
@@ -261,7 +436,7 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_values(
   if (flags & update_hessians && cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_hessians, k),
+        mapping.transform(make_array_view(shape_tables.shape_hessians, k),
                           mapping_covariant_gradient,
                           mapping_internal,
                           make_array_view(output_data.shape_hessians, k));
@@ -278,11 +453,11 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives, k),
-                          mapping_covariant_hessian,
-                          mapping_internal,
-                          make_array_view(output_data.shape_3rd_derivatives,
-                                          k));
+        mapping.transform(
+          make_array_view(shape_tables.shape_3rd_derivatives, k),
+          mapping_covariant_hessian,
+          mapping_internal,
+          make_array_view(output_data.shape_3rd_derivatives, k));
 
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
         correct_third_derivatives(output_data,
@@ -318,6 +493,8 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_face_values(
          ExcInternalError());
   const InternalData &fe_data = static_cast<const InternalData &>(fe_internal);
 
+  const ShapeTables &shape_tables = *fe_data.shape_tables;
+
   // offset determines which data set
   // to take (all data sets for all
   // faces are stored contiguously)
@@ -337,24 +514,29 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_face_values(
   if (flags & update_values)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
       for (unsigned int i = 0; i < quadrature.size(); ++i)
-        output_data.shape_values(k, i) = fe_data.shape_values[k][i + offset];
+        output_data.shape_values(k, i) =
+          shape_tables.shape_values[k][i + offset];
 
   if (flags & update_gradients)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-      mapping.transform(
-        make_array_view(fe_data.shape_gradients, k, offset, quadrature.size()),
-        mapping_covariant,
-        mapping_internal,
-        make_array_view(output_data.shape_gradients, k));
+      mapping.transform(make_array_view(shape_tables.shape_gradients,
+                                        k,
+                                        offset,
+                                        quadrature.size()),
+                        mapping_covariant,
+                        mapping_internal,
+                        make_array_view(output_data.shape_gradients, k));
 
   if (flags & update_hessians)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(
-          make_array_view(fe_data.shape_hessians, k, offset, quadrature.size()),
-          mapping_covariant_gradient,
-          mapping_internal,
-          make_array_view(output_data.shape_hessians, k));
+        mapping.transform(make_array_view(shape_tables.shape_hessians,
+                                          k,
+                                          offset,
+                                          quadrature.size()),
+                          mapping_covariant_gradient,
+                          mapping_internal,
+                          make_array_view(output_data.shape_hessians, k));
 
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
         for (unsigned int i = 0; i < quadrature.size(); ++i)
@@ -367,7 +549,7 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_face_values(
   if (flags & update_3rd_derivatives)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives,
+        mapping.transform(make_array_view(shape_tables.shape_3rd_derivatives,
                                           k,
                                           offset,
                                           quadrature.size()),
@@ -411,6 +593,8 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_subface_values(
          ExcInternalError());
   const InternalData &fe_data = static_cast<const InternalData &>(fe_internal);
 
+  const ShapeTables &shape_tables = *fe_data.shape_tables;
+
   // offset determines which data set
   // to take (all data sets for all
   // sub-faces are stored contiguously)
@@ -432,24 +616,29 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_subface_values(
   if (flags & update_values)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
       for (unsigned int i = 0; i < quadrature.size(); ++i)
-        output_data.shape_values(k, i) = fe_data.shape_values[k][i + offset];
+        output_data.shape_values(k, i) =
+          shape_tables.shape_values[k][i + offset];
 
   if (flags & update_gradients)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-      mapping.transform(
-        make_array_view(fe_data.shape_gradients, k, offset, quadrature.size()),
-        mapping_covariant,
-        mapping_internal,
-        make_array_view(output_data.shape_gradients, k));
+      mapping.transform(make_array_view(shape_tables.shape_gradients,
+                                        k,
+                                        offset,
+                                        quadrature.size()),
+                        mapping_covariant,
+                        mapping_internal,
+                        make_array_view(output_data.shape_gradients, k));
 
   if (flags & update_hessians)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(
-          make_array_view(fe_data.shape_hessians, k, offset, quadrature.size()),
-          mapping_covariant_gradient,
-          mapping_internal,
-          make_array_view(output_data.shape_hessians, k));
+        mapping.transform(make_array_view(shape_tables.shape_hessians,
+                                          k,
+                                          offset,
+                                          quadrature.size()),
+                          mapping_covariant_gradient,
+                          mapping_internal,
+                          make_array_view(output_data.shape_hessians, k));
 
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
         for (unsigned int i = 0; i < quadrature.size(); ++i)
@@ -462,7 +651,7 @@ FE_Poly<PolynomialType, dim, spacedim>::fill_fe_subface_values(
   if (flags & update_3rd_derivatives)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives,
+        mapping.transform(make_array_view(shape_tables.shape_3rd_derivatives,
                                           k,
                                           offset,
                                           quadrature.size()),
@@ -580,6 +769,15 @@ FE_Poly<PolynomialType, dim, spacedim>::get_poly_space_numbering_inverse() const
 
 
 
+template <class PolynomialType, int dim, int spacedim>
+const PolynomialType &
+FE_Poly<PolynomialType, dim, spacedim>::get_poly_space() const
+{
+  return poly_space;
+}
+
+
+
 DEAL_II_NAMESPACE_CLOSE
 
 #endif
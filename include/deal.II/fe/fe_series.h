@@ -183,6 +183,16 @@ namespace FESeries
    * $ dim $-dimensional Legendre polynomials constructed from
    * $ \widetilde P_m(x) $ using tensor product rule.
    *
+   * For finite elements whose shape functions are tensor products of
+   * one-dimensional polynomials (e.g., FE_Q and FE_DGQ) and that are
+   * integrated with a tensor product quadrature, the transformation factors
+   * into one-dimensional transformations along each coordinate direction.
+   * In this case, only a matrix of size $N \times (p+1)$ is stored and the
+   * coefficients are computed by sum factorization, which reduces the cost
+   * per cell from ${\cal O}(N^d (p+1)^d)$ to ${\cal O}(d N (p+1)^d)$
+   * operations for $N \geq p+1$. All other elements use the full
+   * transformation matrix.
+   *
    * @author Denis Davydov, 2016.
    */
   template <int dim, int spacedim = dim>
@@ -234,10 +244,34 @@ namespace FESeries
      */
     std::vector<FullMatrix<CoefficientType>> legendre_transform_matrices;
 
+    /**
+     * One-dimensional transformation matrices for each FiniteElement that
+     * permits sum factorization. The corresponding entry of
+     * @p legendre_transform_matrices stays empty for these elements.
+     */
+    std::vector<FullMatrix<CoefficientType>> legendre_transform_matrices_1d;
+
+    /**
+     * Factor that the coefficients obtained with
+     * @p legendre_transform_matrices_1d need to be scaled with.
+     */
+    std::vector<CoefficientType> legendre_transform_scaling_1d;
+
+    /**
+     * Numbering of the degrees of freedom in lexicographic order for each
+     * FiniteElement that permits sum factorization.
+     */
+    std::vector<std::vector<unsigned int>> lexicographic_numberings;
+
     /**
      * Auxiliary vector to store unrolled coefficients.
      */
     std::vector<CoefficientType> unrolled_coefficients;
+
+    /**
+     * Auxiliary vectors for the intermediate results of sum factorization.
+     */
+    std::vector<CoefficientType> sum_factorization_values[2];
   };
 
 
@@ -429,6 +429,70 @@ namespace FETools
     std::vector<std::vector<FullMatrix<number>>> &matrices,
     const bool                                    isotropic_only = false);
 
+  /**
+   * Enable a cache for the prolongation and restriction matrices of finite
+   * elements. For high polynomial degrees, these matrices are expensive to
+   * compute: FE_Q<3>(8) has 729 degrees of freedom per cell, and computing
+   * the matrices of all children takes seconds. Without the cache, this
+   * work is repeated by every element object, e.g., by the copies of the
+   * same element in an hp::FECollection or in a multigrid hierarchy, and
+   * by every MPI process in every run of a program.
+   *
+   * With the cache enabled, elements that support it (currently FE_Q,
+   * FE_Q_DG0, FE_Q_Bubbles through FE_Q_Base, and FE_DGQ with its
+   * variants) first look up a matrix in the cache under a key built from
+   * FiniteElement::get_name(), and store the matrices they had to compute.
+   * The cache is kept in memory for the lifetime of the program or until
+   * disable_matrix_cache() is called.
+   *
+   * If @p directory is not empty, the matrices are in addition stored as
+   * binary files in this directory, which must exist, and read from there
+   * if they are not yet in memory. This allows all processes of later runs,
+   * and processes that construct an element after another process of the
+   * same run has stored its matrices, to skip the computation. Files are
+   * written under a temporary name and then renamed, so that processes
+   * reading the directory concurrently never see incomplete files. The
+   * files contain the matrix entries in the binary representation of the
+   * machine, so the directory should only be shared between machines of
+   * the same architecture.
+   *
+   * Elements whose name does not determine their support points, i.e.,
+   * those with <code>QUnknownNodes</code> in their name because they were
+   * constructed from an arbitrary set of points, are never cached.
+   *
+   * @note The matrices are copied from the cache into each element, so the
+   * memory held by the cache adds to the memory of the elements.
+   */
+  void
+  enable_matrix_cache(const std::string &directory = "");
+
+  /**
+   * Disable the cache enabled by enable_matrix_cache() and release the
+   * matrices it holds in memory. Files written to disk are kept.
+   */
+  void
+  disable_matrix_cache();
+
+  /**
+   * Copy the matrix stored under @p key in the cache enabled by
+   * enable_matrix_cache() into @p matrix and return <code>true</code>, or
+   * return <code>false</code> if the cache is disabled or does not contain
+   * the key. This function is used by the implementation of finite element
+   * classes and is safe to be called concurrently from several threads.
+   */
+  bool
+  load_cached_matrix(const std::string &key, FullMatrix<double> &matrix);
+
+  /**
+   * Store @p matrix under @p key in the cache enabled by
+   * enable_matrix_cache(). Does nothing if the cache is disabled. This
+   * function is used by the implementation of finite element classes and is
+   * safe to be called concurrently from several threads.
+   */
+  void
+  store_cached_matrix(const std::string &       key,
+                      const FullMatrix<double> &matrix);
+
   /**
    * Project scalar data defined in quadrature points to a finite element
    * space on a single cell.
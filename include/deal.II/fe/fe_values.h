@@ -542,6 +542,15 @@ namespace FEValuesViews
      * Store the data about shape functions.
      */
     std::vector<ShapeFunctionData> shape_function_data;
+
+    /**
+     * The indices of the shape functions for which the selected component
+     * may be nonzero, in ascending order. The functions that evaluate a
+     * finite element field only loop over these shape functions, rather than
+     * checking all shape functions of the element, which for an FESystem
+     * with many components are mostly zero in the selected component.
+     */
+    std::vector<unsigned int> nonzero_shape_functions;
   };
 
 
@@ -1222,6 +1231,13 @@ namespace FEValuesViews
      * Store the data about shape functions.
      */
     std::vector<ShapeFunctionData> shape_function_data;
+
+    /**
+     * The indices of the shape functions for which at least one of the
+     * selected components may be nonzero, in ascending order. See the
+     * corresponding field of the Scalar class.
+     */
+    std::vector<unsigned int> nonzero_shape_functions;
   };
 
 
@@ -3237,6 +3253,21 @@ public:
   CellSimilarity::Similarity
   get_cell_similarity() const;
 
+  /**
+   * By default, the detection of cells that are translations of the previous
+   * cell (see get_cell_similarity()) is switched off when more than one
+   * thread is used, because the first cell a thread sees, and hence the
+   * roundoff in the reused data, depends on the dynamic scheduling of tasks.
+   * Passing <tt>true</tt> to this function enables the check also in that
+   * case, trading bitwise reproducibility between runs for the savings of
+   * not recomputing the mapping and shape function data on similar cells.
+   * This is useful for meshes consisting mostly of translated copies of the
+   * same cell, as long as the same FEValues object is reinitialized on
+   * consecutive cells, like within a chunk of MeshWorker::mesh_loop().
+   */
+  void
+  always_allow_check_for_cell_similarity(const bool allow);
+
   /**
    * Determine an estimate for the memory consumption (in bytes) of this
    * object.
@@ -3453,6 +3484,12 @@ protected:
    */
   CellSimilarity::Similarity cell_similarity;
 
+  /**
+   * Whether check_cell_similarity() runs also when more than one thread is
+   * used. See always_allow_check_for_cell_similarity().
+   */
+  bool check_for_cell_similarity_allowed;
+
   /**
    * A function that checks whether the new cell is similar to the one
    * previously used. Then, a significant amount of the data can be reused,
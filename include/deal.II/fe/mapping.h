@@ -456,6 +456,33 @@ public:
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const Point<spacedim> &                                     p) const = 0;
 
+  /**
+   * Map the points @p real_points on the real @p cell to the corresponding
+   * points on the unit cell, and store them in @p unit_points. This
+   * function is equivalent to calling transform_real_to_unit_cell() for
+   * each point, but derived classes can implement it more efficiently by
+   * re-using the cell geometry for all points and by processing several
+   * points at once. This is useful when many points need to be located in
+   * the same cell, as it is the case in the particle handling.
+   *
+   * Rather than throwing an exception of type
+   * Mapping::ExcTransformationFailed, this function sets the first
+   * coordinate of the unit point to <code>std::numeric_limits<double>::
+   * infinity()</code> for each point where the inverse mapping could not be
+   * computed. Such a point is hence not reported as inside the reference
+   * cell by GeometryInfo::is_inside_unit_cell().
+   *
+   * @param cell Iterator to the cell that will be used to define the mapping.
+   * @param real_points Locations of points on the given cell.
+   * @param unit_points The reference cell locations of the points, with the
+   * same length as @p real_points.
+   */
+  virtual void
+  transform_points_real_to_unit_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<spacedim>> &                    real_points,
+    const ArrayView<Point<dim>> &unit_points) const;
+
   /**
    * Transform the point @p p on the real @p cell to the corresponding point
    * on the unit cell, and then projects it to a dim-1  point on the face with
@@ -78,14 +78,30 @@ public:
 
   /**
    * Initialize the data cache by computing the mapping support points for all
-   * cells (on all levels) of the given triangulation. Note that the cache is
-   * invalidated upon the signal Triangulation::Signals::any_change of the
-   * underlying triangulation.
+   * cells (on all levels) of the given triangulation. The cells are processed
+   * in parallel. Note that the cache is invalidated upon the signal
+   * Triangulation::Signals::any_change of the underlying triangulation.
+   *
+   * Since the cache contains both active and level cells, a single object of
+   * this class can be shared by the MatrixFree objects set up on the active
+   * cells and on all levels of a multigrid hierarchy.
    */
   void
   initialize(const Triangulation<dim, spacedim> &  triangulation,
              const MappingQGeneric<dim, spacedim> &mapping);
 
+  /**
+   * Return a reference to the cached mapping support points of the given
+   * @p cell, in the order returned by
+   * MappingQGeneric::compute_mapping_support_points(). In contrast to the
+   * latter function, no copy of the points is made, which allows users of
+   * this class such as MatrixFree to access the geometry without
+   * evaluating the mapping anew.
+   */
+  const std::vector<Point<spacedim>> &
+  get_mapping_support_points(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell) const;
+
   /**
    * Return the memory consumption (in bytes) of the cache.
    */
@@ -183,6 +183,20 @@ public:
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const Point<spacedim> &p) const override;
 
+  /**
+   * Map the points @p real_points on the real @p cell to the unit cell, see
+   * the documentation of the Mapping base class. For dim==spacedim, this
+   * function evaluates the mapping support points of the cell only once and
+   * runs the Newton iteration for VectorizedArray<double>::n_array_elements
+   * points at once. Points for which this iteration does not converge are
+   * handed to transform_real_to_unit_cell(), which employs a line search.
+   */
+  virtual void
+  transform_points_real_to_unit_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<spacedim>> &                    real_points,
+    const ArrayView<Point<dim>> &unit_points) const override;
+
   /**
    * @}
    */
@@ -298,6 +312,17 @@ public:
     void
     compute_shape_function_values(const std::vector<Point<dim>> &unit_points);
 
+    /**
+     * Check whether the points of each data set of @p quadrature, i.e., of
+     * the cell or of one face or subface in one orientation, consisting of
+     * @p n_points_per_set points each, form a tensor-product grid in the
+     * reference cell. If this is the case for all data sets, fill
+     * @p tensor_product_points, otherwise leave it empty.
+     */
+    void
+    initialize_tensor_product_points(const Quadrature<dim> &quadrature,
+                                     const unsigned int     n_points_per_set);
+
 
     /**
      * Shape function at quadrature point. Shape functions are in tensor
@@ -494,6 +519,51 @@ public:
      */
     bool tensor_product_quadrature;
 
+    /**
+     * The description of the quadrature points of one data set in case they
+     * form a tensor-product grid in the reference cell.
+     */
+    struct TensorProductPoints
+    {
+      /**
+       * The values, first and second derivatives of the one-dimensional
+       * Lagrange polynomials in the @p line_support_points, evaluated in the
+       * distinct coordinates of the quadrature points along each coordinate
+       * direction. The tables are indexed by the coordinate and the
+       * polynomial.
+       */
+      std::array<std::array<Table<2, double>, 3>, dim> shape_1d;
+
+      /**
+       * The index of each quadrature point within the lexicographic
+       * numbering of the tensor-product grid.
+       */
+      std::vector<unsigned int> tensor_index;
+    };
+
+    /**
+     * In case the quadrature points of all data sets form tensor-product
+     * grids but the evaluation indicated by @p tensor_product_quadrature is
+     * not applicable, e.g. because the points are located on faces or
+     * because the one-dimensional formulas differ between the coordinate
+     * directions, this field describes the points of each data set, which
+     * allows evaluating the mapping by sum factorization. Empty otherwise.
+     */
+    std::vector<TensorProductPoints> tensor_product_points;
+
+    /**
+     * The renumbering from the lexicographic numbering of the mapping
+     * support points, as used in the evaluation with
+     * @p tensor_product_points, to their hierarchical numbering.
+     */
+    std::vector<unsigned int> lexicographic_to_hierarchic;
+
+    /**
+     * Temporary data for the evaluation with @p tensor_product_points.
+     */
+    mutable std::array<std::vector<Tensor<1, spacedim>>, dim + 1>
+      tensor_product_scratch;
+
     /**
      * Tensors of covariant transformation at each of the quadrature points.
      * The matrix stored is the Jacobian * G^{-1}, where G = Jacobian^{t} *
@@ -484,6 +484,13 @@ public:
    * file format. The Gmsh formats are documented at
    * http://www.geuz.org/gmsh/.
    *
+   * Files in version 4.1 of the format can also be in binary form, which is
+   * considerably faster to read for large meshes: the nodes and elements of
+   * each entity block are then read in one go and converted to the
+   * intermediate format of this class in parallel. Binary files need to
+   * have been written on a machine with the same endianness and size of
+   * integers as the one reading them.
+   *
    * @note The input function of deal.II does not distinguish between newline
    * and other whitespace. Therefore, deal.II will be able to read files in a
    * slightly more general format than Gmsh.
@@ -713,6 +720,13 @@ private:
   static void
   skip_comment_lines(std::istream &in, const char comment_start);
 
+  /**
+   * Read the rest of a binary msh file in version 4.1 of the format, after
+   * the version information at its start has been read by read_msh().
+   */
+  void
+  read_msh_binary(std::istream &in);
+
   /**
    * This function does the nasty work (due to very lax conventions and
    * different versions of the tecplot format) of extracting the important
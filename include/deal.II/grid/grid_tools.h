@@ -806,6 +806,49 @@ namespace GridTools
       &cell_hint =
         typename Triangulation<dim, spacedim>::active_cell_iterator());
 
+  /**
+   * This function computes the same information as
+   * GridTools::compute_point_locations_try_all(), but is designed for large
+   * sets of points. Rather than walking from the cell of one point to the
+   * next, the points are first sorted along a space-filling curve (the
+   * Morton or Z-order curve) within their bounding box, such that points
+   * that are close in space are processed one after the other. The points
+   * are then located in chunks of the sorted list, which are distributed
+   * over the available threads by parallel::apply_to_subranges(). For each
+   * chunk, the cells whose bounding boxes contain a point are found with
+   * GridTools::Cache::get_cell_bounding_boxes_rtree(), and all subsequent
+   * points inside the bounding box of the cell found last are transformed
+   * to that cell at once by Mapping::transform_points_real_to_unit_cell().
+   *
+   * Points that are not found inside the bounding box of any of their
+   * candidate cells, as it may happen for curved cells with higher order
+   * mappings whose bounding boxes are only approximate, are finally searched
+   * with GridTools::find_active_cell_around_point() and are reported as
+   * missing only if this search fails as well.
+   *
+   * The result is deterministic and independent of the number of threads:
+   * the cells are sorted by their level and index, and the point indices of
+   * each cell are in ascending order, as are the indices of the missing
+   * points. For the meaning of the four components of the returned tuple
+   * see GridTools::compute_point_locations_try_all().
+   *
+   * @note This function builds all data structures of @p cache it needs
+   * before spawning tasks, such that @p cache must not be used concurrently
+   * by other threads during the call.
+   */
+  template <int dim, int spacedim>
+#  ifndef DOXYGEN
+  std::tuple<
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>,
+    std::vector<std::vector<Point<dim>>>,
+    std::vector<std::vector<unsigned int>>,
+    std::vector<unsigned int>>
+#  else
+  return_type
+#  endif
+  compute_point_locations_batched(const Cache<dim, spacedim> &        cache,
+                                  const std::vector<Point<spacedim>> &points);
+
   /**
    * Given a @p cache and a list of
    * @p local_points for each process, find the points lying on the locally
@@ -3900,14 +3943,18 @@ namespace GridTools
         AssertThrowMPI(ierr);
       }
 
-    // 3. receive messages
+    // 3. receive messages. we receive exactly one message from each
+    // ghost owner, and because MPI guarantees that messages between two
+    // processes are received in the order in which they were sent, this
+    // is the message sent by its matching call to this function, even if
+    // the other process already went on to call this function again
     std::vector<char> receive;
-    for (unsigned int idx = 0; idx < n_ghost_owners; ++idx)
+    for (const auto ghost_owner : ghost_owners)
       {
         MPI_Status status;
         int        len;
         int        ierr =
-          MPI_Probe(MPI_ANY_SOURCE, 786, tria->get_communicator(), &status);
+          MPI_Probe(ghost_owner, 786, tria->get_communicator(), &status);
         AssertThrowMPI(ierr);
         ierr = MPI_Get_count(&status, MPI_BYTE, &len);
         AssertThrowMPI(ierr);
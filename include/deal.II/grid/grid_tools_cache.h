@@ -36,6 +36,7 @@
 #include <boost/signals2.hpp>
 
 #include <cmath>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -52,15 +53,20 @@ namespace GridTools
    * for faster access whenever the triangulation has not changed.
    *
    * Notice that this class only notices if the underlying Triangulation has
-   * changed due to a Triangulation::Signals::any_change() signal being
-   * triggered.
+   * changed due to one of the signals that trigger
+   * Triangulation::Signals::any_change(). If only the vertices have been
+   * moved, as announced by Triangulation::Signals::mesh_movement, the objects
+   * that depend on the connectivity of the mesh only, like the vertex to cell
+   * map and the list of active cells, are kept, and the geometric objects are
+   * recomputed from them.
    *
    * If the triangulation changes for other reasons, for example because you
    * use it in conjunction with a MappingQEulerian object that sees the
    * vertices through its own transformation, or because you manually change
    * some vertex locations, then some of the structures in this class become
    * obsolete, and you will have to mark them as outdated, by calling the
-   * method mark_for_update() manually.
+   * method mark_for_update() manually. For such changes of the geometry,
+   * passing update_vertex_locations is sufficient.
    *
    * @author Luca Heltai, 2017.
    */
@@ -181,9 +187,13 @@ namespace GridTools
     /**
      * Return the cached vertex_kdtree object, constructed with the vertices of
      * the stored triangulation.
+     *
+     * @deprecated Use get_used_vertices_rtree() instead, which can be
+     * queried for the nearest vertices of many points at once with
+     * find_nearest_leaves().
      */
-    const KDTree<spacedim> &
-    get_vertex_kdtree() const;
+    DEAL_II_DEPRECATED const KDTree<spacedim> &
+                             get_vertex_kdtree() const;
 #endif
 
   private:
@@ -252,9 +262,26 @@ namespace GridTools
       cell_bounding_boxes_rtree;
 
     /**
-     * Storage for the status of the triangulation signal.
+     * The bounding boxes of the active cells, from which
+     * cell_bounding_boxes_rtree is packed. After a movement of the mesh, only
+     * the boxes are recomputed, without looping over the triangulation.
+     */
+    mutable std::vector<
+      std::pair<BoundingBox<spacedim>,
+                typename Triangulation<dim, spacedim>::active_cell_iterator>>
+      cell_bounding_boxes;
+
+    /**
+     * Whether the cells stored in cell_bounding_boxes are the active cells of
+     * the triangulation, i.e., update_vertex_to_cell_map has not been marked
+     * since they were collected.
+     */
+    mutable bool cell_list_is_current;
+
+    /**
+     * Storage for the status of the triangulation signals.
      */
-    boost::signals2::connection tria_signal;
+    std::vector<boost::signals2::connection> tria_signals;
   };
 
 
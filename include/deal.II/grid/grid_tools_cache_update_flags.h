@@ -83,6 +83,16 @@ namespace GridTools
      */
     update_covering_rtree = 0x040,
 
+    /**
+     * Update all objects that depend on the locations of the vertices, but
+     * not on the connectivity of the mesh, i.e., all objects except the
+     * vertex_to_cell_map. These are marked for update when the
+     * Triangulation::Signals::mesh_movement signal is triggered, and this is
+     * the flag to pass to Cache::mark_for_update() after changing the
+     * vertex locations manually or the displacement of a MappingQEulerian.
+     */
+    update_vertex_locations = 0x07E,
+
     /**
      * Update all objects.
      */
@@ -47,6 +47,9 @@ DEAL_II_NAMESPACE_OPEN
 template <int dim, int spacedim>
 class Manifold;
 
+template <int dim, int spacedim>
+class Triangulation;
+
 namespace GridTools
 {
   template <typename CellIterator>
@@ -486,6 +489,113 @@ namespace internal
       void
       serialize(Archive &ar, const unsigned int version);
     };
+
+
+
+    /**
+     * An iterator over an array of pairs of level and index of active cells,
+     * such as the one returned by
+     * Triangulation::get_locally_owned_active_cells(). Dereferencing it
+     * yields an iterator to the cell described by the current pair, so that
+     * it can be used in range-based for loops like a range of cell
+     * iterators.
+     */
+    template <int dim, int spacedim>
+    class ActiveCellListIterator
+    {
+    public:
+      /**
+       * Constructor. Point to the cell described by @p level_and_index.
+       */
+      ActiveCellListIterator(
+        const dealii::Triangulation<dim, spacedim> *  triangulation,
+        const std::pair<unsigned int, unsigned int> *level_and_index);
+
+      /**
+       * Return an iterator to the cell pointed to.
+       */
+      TriaActiveIterator<CellAccessor<dim, spacedim>> operator*() const;
+
+      /**
+       * Move on to the next cell of the array.
+       */
+      ActiveCellListIterator &
+      operator++();
+
+      /**
+       * Compare for equality.
+       */
+      bool
+      operator==(const ActiveCellListIterator &other) const;
+
+      /**
+       * Compare for inequality.
+       */
+      bool
+      operator!=(const ActiveCellListIterator &other) const;
+
+    private:
+      /**
+       * The triangulation the cells belong to.
+       */
+      const dealii::Triangulation<dim, spacedim> *triangulation;
+
+      /**
+       * The current element of the array.
+       */
+      const std::pair<unsigned int, unsigned int> *level_and_index;
+    };
+
+
+
+    /**
+     * A range over an array of pairs of level and index of active cells, to
+     * be used in range-based for loops. See
+     * Triangulation::locally_owned_active_cell_iterators().
+     */
+    template <int dim, int spacedim>
+    class ActiveCellList
+    {
+    public:
+      /**
+       * Constructor. The range contains the cells described by
+       * @p levels_and_indices.
+       */
+      ActiveCellList(
+        const dealii::Triangulation<dim, spacedim> *triangulation,
+        const std::vector<std::pair<unsigned int, unsigned int>>
+          &levels_and_indices);
+
+      /**
+       * Return an iterator to the first cell of the range.
+       */
+      ActiveCellListIterator<dim, spacedim>
+      begin() const;
+
+      /**
+       * Return an iterator past the last cell of the range.
+       */
+      ActiveCellListIterator<dim, spacedim>
+      end() const;
+
+      /**
+       * Return the number of cells in the range.
+       */
+      std::size_t
+      size() const;
+
+    private:
+      /**
+       * The triangulation the cells belong to.
+       */
+      const dealii::Triangulation<dim, spacedim> *triangulation;
+
+      /**
+       * The array of cells.
+       */
+      const std::vector<std::pair<unsigned int, unsigned int>>
+        &levels_and_indices;
+    };
   } // namespace TriangulationImplementation
 } // namespace internal
 
@@ -945,6 +1055,13 @@ namespace internal
  * after a remeshing they are available on all cells, where they were set on
  * the previous mesh.
  *
+ * Memory for the user data of the lines, quads, etc is only allocated when
+ * the first user index or pointer of such an object is set, and released
+ * again by clear_user_data(). Consequently, triangulations that do not use
+ * user data do not pay for them. The allocation is synchronized, so the
+ * user data of different objects can be set concurrently on several threads
+ * as before.
+ *
  * The usual warning about the missing type safety of @p void pointers are
  * obviously in place here; responsibility for correctness of types etc lies
  * entirely with the user of the pointer.
@@ -2956,6 +3073,38 @@ public:
   IteratorRange<active_cell_iterator>
   active_cell_iterators_on_level(const unsigned int level) const;
 
+  /**
+   * Return the locally owned active cells of this triangulation as a flat
+   * array of pairs of level and index, sorted by their active_cell_index().
+   * For a sequential triangulation, all active cells are locally owned. For
+   * the classes derived from parallel::TriangulationBase, these are the
+   * cells whose subdomain_id() equals locally_owned_subdomain().
+   *
+   * The array is built whenever the mesh or the partitioning changes, so
+   * going through it avoids the overhead of incrementing cell iterators,
+   * which have to skip inactive cells and, for parallel triangulations,
+   * cells that are not locally owned.
+   */
+  const std::vector<std::pair<unsigned int, unsigned int>> &
+  get_locally_owned_active_cells() const;
+
+  /**
+   * Return a range of all locally owned active cells, as described in
+   * get_locally_owned_active_cells(), for use in range-based for loops:
+   * @code
+   *   for (const auto &cell :
+   *        triangulation.locally_owned_active_cell_iterators())
+   *     cell->set_user_flag();
+   * @endcode
+   * This loop goes over the same cells as a loop over active_cell_iterators()
+   * that skips all cells for which CellAccessor::is_locally_owned() is
+   * false, and in the same order.
+   *
+   * @ingroup CPP11
+   */
+  internal::TriangulationImplementation::ActiveCellList<dim, spacedim>
+  locally_owned_active_cell_iterators() const;
+
   /*
    * @}
    */
@@ -3615,6 +3764,15 @@ protected:
   void
   update_periodic_face_map();
 
+  /**
+   * Rebuild the array returned by get_locally_owned_active_cells(). This
+   * function is called whenever the active cells change, and needs to be
+   * called by derived classes whenever they change the subdomain ids of the
+   * cells.
+   */
+  void
+  update_locally_owned_active_cells();
+
 
 private:
   /**
@@ -4009,6 +4167,12 @@ private:
    */
   dealii::internal::TriangulationImplementation::NumberCache<dim> number_cache;
 
+  /**
+   * The level and index of all locally owned active cells, see
+   * get_locally_owned_active_cells().
+   */
+  std::vector<std::pair<unsigned int, unsigned int>> locally_owned_active_cells;
+
   /**
    * A map that relates the number of a boundary vertex to the boundary
    * indicator. This field is only used in 1d. We have this field because we
@@ -4129,6 +4293,96 @@ namespace internal
       ar &n_active_hexes &n_active_hexes_level;
     }
 
+
+
+    template <int dim, int spacedim>
+    inline ActiveCellListIterator<dim, spacedim>::ActiveCellListIterator(
+      const dealii::Triangulation<dim, spacedim> *  triangulation,
+      const std::pair<unsigned int, unsigned int> *level_and_index)
+      : triangulation(triangulation)
+      , level_and_index(level_and_index)
+    {}
+
+
+
+    template <int dim, int spacedim>
+    inline TriaActiveIterator<CellAccessor<dim, spacedim>>
+      ActiveCellListIterator<dim, spacedim>::operator*() const
+    {
+      return TriaActiveIterator<CellAccessor<dim, spacedim>>(
+        triangulation, level_and_index->first, level_and_index->second);
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline ActiveCellListIterator<dim, spacedim> &
+    ActiveCellListIterator<dim, spacedim>::operator++()
+    {
+      ++level_and_index;
+      return *this;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline bool
+    ActiveCellListIterator<dim, spacedim>::
+    operator==(const ActiveCellListIterator &other) const
+    {
+      return level_and_index == other.level_and_index;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline bool
+    ActiveCellListIterator<dim, spacedim>::
+    operator!=(const ActiveCellListIterator &other) const
+    {
+      return level_and_index != other.level_and_index;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline ActiveCellList<dim, spacedim>::ActiveCellList(
+      const dealii::Triangulation<dim, spacedim> *triangulation,
+      const std::vector<std::pair<unsigned int, unsigned int>>
+        &levels_and_indices)
+      : triangulation(triangulation)
+      , levels_and_indices(levels_and_indices)
+    {}
+
+
+
+    template <int dim, int spacedim>
+    inline ActiveCellListIterator<dim, spacedim>
+    ActiveCellList<dim, spacedim>::begin() const
+    {
+      return ActiveCellListIterator<dim, spacedim>(triangulation,
+                                                   levels_and_indices.data());
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline ActiveCellListIterator<dim, spacedim>
+    ActiveCellList<dim, spacedim>::end() const
+    {
+      return ActiveCellListIterator<dim, spacedim>(
+        triangulation, levels_and_indices.data() + levels_and_indices.size());
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline std::size_t
+    ActiveCellList<dim, spacedim>::size() const
+    {
+      return levels_and_indices.size();
+    }
+
   } // namespace TriangulationImplementation
 } // namespace internal
 
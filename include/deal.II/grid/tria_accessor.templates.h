@@ -1771,7 +1771,9 @@ void *
 TriaAccessor<structdim, dim, spacedim>::user_pointer() const
 {
   Assert(this->used(), TriaAccessorExceptions::ExcCellNotUsed());
-  return this->objects().user_pointer(this->present_index);
+  // use the read-only access, which does not allocate the user data
+  const auto &objects = this->objects();
+  return const_cast<void *>(objects.user_pointer(this->present_index));
 }
 
 
@@ -1828,7 +1830,9 @@ unsigned int
 TriaAccessor<structdim, dim, spacedim>::user_index() const
 {
   Assert(this->used(), TriaAccessorExceptions::ExcCellNotUsed());
-  return this->objects().user_index(this->present_index);
+  // use the read-only access, which does not allocate the user data
+  const auto &objects = this->objects();
+  return objects.user_index(this->present_index);
 }
 
 
@@ -23,6 +23,8 @@
 
 #include <deal.II/grid/tria_object.h>
 
+#include <atomic>
+#include <mutex>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -283,7 +285,8 @@ namespace internal
 
       /**
        * Clear all user pointers or indices and reset their type, such that
-       * the next access may be either or.
+       * the next access may be either or. This also releases the memory
+       * used for them until they are set again.
        */
       void
       clear_user_data();
@@ -401,9 +404,65 @@ namespace internal
       /**
        * Pointer which is not used by the library but may be accessed and set
        * by the user to handle data local to a line/quad/etc.
+       *
+       * Since most triangulations never use these data, this vector is only
+       * allocated by the first write access through user_pointer() or
+       * user_index(), and is empty up to then. Read-only access to an empty
+       * vector returns zero. Once allocated, the vector has as many elements
+       * as #cells.
        */
       std::vector<UserData> user_data;
 
+      /**
+       * The state of the allocation of #user_data. Threads that set the
+       * user data of different objects may trigger the allocation at the
+       * same time, so it is done under a mutex, and the accessors check the
+       * flag set after the allocation instead of the vector itself. This
+       * class is copied like the other members, where the copy gets its own
+       * mutex.
+       */
+      struct UserDataAllocation
+      {
+        /**
+         * Constructor.
+         */
+        UserDataAllocation();
+
+        /**
+         * Copy constructor. Copies the flag, but not the mutex.
+         */
+        UserDataAllocation(const UserDataAllocation &other);
+
+        /**
+         * Copy operator. Copies the flag, but not the mutex.
+         */
+        UserDataAllocation &
+        operator=(const UserDataAllocation &other);
+
+        /**
+         * Whether #user_data has been allocated.
+         */
+        std::atomic<bool> allocated;
+
+        /**
+         * A mutex guarding the allocation of #user_data.
+         */
+        std::mutex mutex;
+      };
+
+      /**
+       * The state of the allocation of #user_data.
+       */
+      UserDataAllocation user_data_allocation;
+
+      /**
+       * Allocate #user_data with one element for each of the #cells unless
+       * this has happened before. This function may be called by several
+       * threads concurrently.
+       */
+      void
+      allocate_user_data();
+
       /**
        * In order to avoid confusion between user pointers and indices, this
        * enum is set by the first function accessing either and subsequent
@@ -632,7 +691,9 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_pointer;
 
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (!user_data_allocation.allocated.load(std::memory_order_acquire))
+        allocate_user_data();
       return user_data[i].p;
     }
 
@@ -645,7 +706,9 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_pointer;
 
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (!user_data_allocation.allocated.load(std::memory_order_acquire))
+        return nullptr;
       return user_data[i].p;
     }
 
@@ -658,7 +721,9 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_index;
 
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (!user_data_allocation.allocated.load(std::memory_order_acquire))
+        allocate_user_data();
       return user_data[i].i;
     }
 
@@ -667,8 +732,9 @@ namespace internal
     inline void
     TriaObjects<G>::clear_user_data(const unsigned int i)
     {
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
-      user_data[i].i = 0;
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (user_data_allocation.allocated.load(std::memory_order_acquire))
+        user_data[i].i = 0;
     }
 
 
@@ -689,7 +755,9 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_index;
 
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (!user_data_allocation.allocated.load(std::memory_order_acquire))
+        return 0;
       return user_data[i].i;
     }
 
@@ -699,8 +767,45 @@ namespace internal
     TriaObjects<G>::clear_user_data()
     {
       user_data_type = data_unknown;
-      for (unsigned int i = 0; i < user_data.size(); ++i)
-        user_data[i].p = nullptr;
+      std::vector<UserData>().swap(user_data);
+      user_data_allocation.allocated = false;
+    }
+
+
+    template <typename G>
+    inline void
+    TriaObjects<G>::allocate_user_data()
+    {
+      std::lock_guard<std::mutex> lock(user_data_allocation.mutex);
+      if (!user_data_allocation.allocated.load(std::memory_order_relaxed))
+        {
+          user_data.resize(cells.size());
+          user_data_allocation.allocated.store(true,
+                                               std::memory_order_release);
+        }
+    }
+
+
+    template <typename G>
+    inline TriaObjects<G>::UserDataAllocation::UserDataAllocation()
+      : allocated(false)
+    {}
+
+
+    template <typename G>
+    inline TriaObjects<G>::UserDataAllocation::UserDataAllocation(
+      const UserDataAllocation &other)
+      : allocated(other.allocated.load())
+    {}
+
+
+    template <typename G>
+    inline typename TriaObjects<G>::UserDataAllocation &
+    TriaObjects<G>::UserDataAllocation::
+    operator=(const UserDataAllocation &other)
+    {
+      allocated = other.allocated.load();
+      return *this;
     }
 
 
@@ -736,6 +841,7 @@ namespace internal
       ar &       manifold_id;
       ar &next_free_single &next_free_pair &reverse_order_next_free_single;
       ar &user_data &user_data_type;
+      user_data_allocation.allocated = !user_data.empty();
     }
 
 
@@ -1491,6 +1491,26 @@ namespace hp
         levels[i] = std::move(level);
       }
 
+    // archives of a previous version of DoFLevel do not contain the position
+    // of the interior DoF indices within the indices of a cell, which only
+    // depends on the finite element of the cell
+    for (const auto &level : levels)
+      if (level->first_interior_dof_indices.empty() &&
+          !level->cell_dof_indices_cache.empty())
+        {
+          AssertThrow(
+            fe_collection.size() > 0,
+            ExcMessage(
+              "This DoFHandler has been stored with a previous version of "
+              "the library. To load it, you need to associate the finite "
+              "elements with it first by calling distribute_dofs()."));
+          level->first_interior_dof_indices.resize(fe_collection.size());
+          for (unsigned int fe = 0; fe < fe_collection.size(); ++fe)
+            level->first_interior_dof_indices[fe] =
+              fe_collection[fe].dofs_per_cell -
+              fe_collection[fe].template n_dofs_per_object<dim>();
+        }
+
     // Workaround for nullptr, see in save().
     bool faces_is_nullptr = true;
     ar & faces_is_nullptr;
@@ -21,6 +21,8 @@
 
 #include <deal.II/base/exceptions.h>
 
+#include <boost/serialization/version.hpp>
+
 #include <vector>
 
 
@@ -30,8 +32,6 @@ namespace hp
 {
   template <int, int>
   class DoFHandler;
-  template <int, int>
-  class FECollection;
 } // namespace hp
 
 
@@ -59,55 +59,44 @@ namespace internal
      * This is the class that stores the degrees of freedom on cells in a hp
      * hierarchy. Compared to faces and edges, the task here is simple since
      * each cell can only have a single active finite element index.
-     * Consequently, all we need is one long array with DoF indices and one
-     * array of offsets where each cell's indices start within the array of
-     * indices. This is in contrast to the DoFObjects class where each face or
-     * edge may have more than one associated finite element with
+     * Consequently, all we need is one long array with the DoF indices of all
+     * cells and one array of offsets where each cell's indices start within
+     * that array. This is in contrast to the DoFObjects class where each face
+     * or edge may have more than one associated finite element with
      * corresponding degrees of freedom.
      *
-     * The data stored here is represented by three arrays - The @p
-     * active_fe_indices array stores for each cell which finite element is
-     * used on this cell. Since some cells are not active on the current
-     * level, some entries in this array may represent an invalid value. - The
-     * @p dof_indices array stores for each active cell on the current level
-     * the dofs that associated with the <i>interior</i> of the cell, i.e.,
-     * the @p dofs_per_line dofs associated with the line in 1d, and @p
-     * dofs_per_quad and @p dofs_per_hex in 2d and 3d. These numbers are in
-     * general smaller than @p dofs_per_cell. - The @p dof_offsets array
-     * stores, for each cell, the starting point of the dof indices
-     * corresponding to this cell in the @p dof_indices array. This is
-     * analogous to how we store data in compressed row storage for sparse
-     * matrices. For cells that are not active on the current level, we store
-     * an invalid value for the starting index.
-     *
-     * <h3>Compression</h3>
-     *
-     * It is common for the indices stored in @p dof_indices for one cell to
-     * be numbered consecutively. For example, using the standard numbering
-     * (without renumbering DoFs), the quad dofs on the first cell of a mesh
-     * when using a $Q_3$ element will be numbered <tt>12, 13, 14, 15</tt>.
-     * This allows for compression if we only store the first entry and have
-     * some way to mark the DoFs on this object as compressed. Here,
-     * compression means that we know that subsequent DoF indices can be
-     * obtained from the previous ones by just incrementing them by one -- in
-     * other words, we use a variant of doing run-length encoding. The way to
-     * do this is that we use positive FE indices for uncompressed sets of
-     * DoFs and if a set of indices is compressed, then we instead store the
-     * FE index in binary complement (which we can identify by looking at the
-     * sign bit when interpreting the number as a signed one). There are two
-     * functions, compress_data() and uncompress_data() that convert between
-     * the two possible representations.
+     * The data stored here is represented by the following arrays:
+     * - The @p active_fe_indices array stores for each cell which finite
+     *   element is used on this cell. Since some cells are not active on the
+     *   current level, some entries in this array may represent an invalid
+     *   value.
+     * - The @p cell_dof_indices_cache array stores for each active cell on
+     *   the current level the indices of all degrees of freedom of the cell,
+     *   in the order in which DoFCellAccessor::get_dof_indices() returns
+     *   them. The number of indices stored for a cell is the @p dofs_per_cell
+     *   of its finite element.
+     * - The @p cell_cache_offsets array stores, for each cell, the starting
+     *   point of the indices of this cell in the @p cell_dof_indices_cache
+     *   array. This is analogous to how we store data in compressed row
+     *   storage for sparse matrices. For cells that are not active on the
+     *   current level, we store an invalid value for the starting index.
      *
-     * Note that compression is not always possible. For example, if one
-     * renumbered the example above using DoFRenumbering::downstream with
-     * $(1,0)^T$ as direction, then they would likely be numbered <tt>12, 14,
-     * 13, 15</tt>, which can not be compressed using run-length encoding.
+     * The degrees of freedom associated with the <i>interior</i> of a cell,
+     * i.e., the @p dofs_per_line dofs associated with the line in 1d, and
+     * @p dofs_per_quad and @p dofs_per_hex in 2d and 3d, come last in the
+     * indices of a cell. They are not stored separately, but read from and
+     * written to their position in @p cell_dof_indices_cache, whose start
+     * within the indices of the cell only depends on the finite element and
+     * is stored in @p first_interior_dof_indices for each element of the
+     * collection. All other entries for a cell are copies of the indices
+     * stored on the vertices, lines, and quads of the cell, and are filled
+     * by DoFCellAccessor::update_cell_dof_indices_cache().
      */
     class DoFLevel
     {
     private:
       /**
-       * The type in which we store the offsets into the dof_indices array.
+       * The type in which we store the offsets into the array of DoF indices.
        */
       using offset_type = unsigned int;
 
@@ -116,35 +105,12 @@ namespace internal
        */
       using active_fe_index_type = unsigned short int;
 
-      /**
-       * A signed type that matches the type in which we store the active FE
-       * index. We use this in computing binary complements.
-       */
-      using signed_active_fe_index_type = signed short int;
-
       /**
        * Invalid active_fe_index which will be used as a default value to
        * determine whether a future_fe_index has been set or not.
        */
       static const active_fe_index_type invalid_active_fe_index;
 
-      /**
-       * Given an active_fe_index, return whether the corresponding
-       * set of DoF indices are compressed. See the general documentation
-       * of this class for a description of when this is the case.
-       */
-      static bool
-      is_compressed_entry(const active_fe_index_type active_fe_index);
-
-      /**
-       * Given an active_fe_index (either corresponding to an uncompressed
-       * or compressed state), return the active_fe_index that corresponds
-       * to the respectively other state. See the general documentation
-       * of this class for a description of how compression is indicated.
-       */
-      static active_fe_index_type
-      get_toggled_compression_state(const active_fe_index_type active_fe_index);
-
       /**
        * Indices specifying the finite element of hp::FECollection to use for
        * the different cells on the current level. The vector stores one
@@ -172,38 +138,27 @@ namespace internal
       std::vector<active_fe_index_type> future_fe_indices;
 
       /**
-       * Store the start index for the degrees of freedom of each object in
-       * the @p dof_indices array. If the cell corresponding to a particular
-       * index in this array is not active on this level, then we do not store
-       * any DoFs for it. In that case, the offset we store here must be an
-       * invalid number and indeed we store
-       * <code>(std::vector<types::global_dof_index>::size_type)(-1)</code>
-       * for it.
-       *
-       * The type we store is then obviously the type the @p dof_indices array
-       * uses for indexing.
-       */
-      std::vector<offset_type> dof_offsets;
-
-      /**
-       * Store the global indices of the degrees of freedom. information. The
-       * dof_offsets field determines where each (active) cell's data is
-       * stored.
-       */
-      std::vector<types::global_dof_index> dof_indices;
-
-      /**
-       * The offsets for each cell of the cache that holds all DoF indices.
+       * The offsets for each cell into the array that holds all DoF indices.
+       * For cells that are not active on this level, the offset is an invalid
+       * number, <code>static_cast<offset_type>(-1)</code>.
        */
       std::vector<offset_type> cell_cache_offsets;
 
       /**
-       * Cache for the DoF indices on cells. The size of this array equals the
-       * sum over all cells of
+       * The DoF indices of all active cells on this level. The size of this
+       * array equals the sum over all cells of
        * selected_fe[active_fe_index[cell]].dofs_per_cell.
        */
       std::vector<types::global_dof_index> cell_dof_indices_cache;
 
+      /**
+       * For each finite element of the hp::FECollection, the position of the
+       * first degree of freedom associated with the interior of a cell
+       * within the indices of the cell, i.e., <code>dofs_per_cell -
+       * n_dofs_per_object<dim>()</code>.
+       */
+      std::vector<offset_type> first_interior_dof_indices;
+
     public:
       /**
        * Set the global index of the @p local_index-th degree of freedom
@@ -311,60 +266,17 @@ namespace internal
       /**
        * Read or write the data of this object to or from a stream for the
        * purpose of serialization
+       *
+       * Archives of version 0 still contain the separate array of the
+       * interior DoF indices of cells, which is skipped. They do not contain
+       * the position of the interior DoF indices within the indices of a
+       * cell, which hp::DoFHandler::load() fills in from its finite elements.
        */
       template <class Archive>
       void
       serialize(Archive &ar, const unsigned int version);
 
     private:
-      /**
-       * Compress the arrays that store dof indices by using a variant of run-
-       * length encoding. See the general documentation of this class for more
-       * information.
-       *
-       * @param fe_collection The object that can tell us how many degrees of
-       * freedom each of the finite elements has that we store in this object.
-       */
-      template <int dim, int spacedim>
-      void
-      compress_data(
-        const dealii::hp::FECollection<dim, spacedim> &fe_collection);
-
-      /**
-       * Uncompress the arrays that store dof indices by using a variant of
-       * run-length encoding. See the general documentation of this class for
-       * more information.
-       *
-       * @param fe_collection The object that can tell us how many degrees of
-       * freedom each of the finite elements has that we store in this object.
-       */
-      template <int dim, int spacedim>
-      void
-      uncompress_data(
-        const dealii::hp::FECollection<dim, spacedim> &fe_collection);
-
-
-      /**
-       * Restore the active fe indices stored by the current object to
-       * an uncompressed state. At the same time, do not touch any of
-       * the other data structures. This leaves the active_fe_indices
-       * array out-of-synch from the other member variables, and the
-       * function can consequently only be used when the remaining
-       * data structures are going to be rebuilt next. This is
-       * specifically the case in hp::DoFHandler::distribute_dofs()
-       * where we throw away all data in the DoFLevels objects *except
-       * for the active_fe_indices* array. This function therefore
-       * simply makes sure that that one array is in uncompressed
-       * format so that we can use the information about active
-       * fe_indices for all cells that were used in the previous mesh
-       * refinement cycle (or the previous time distribute_dofs() was
-       * called) without having to care about any of the other data
-       * fields.
-       */
-      void
-      normalize_active_fe_indices();
-
-
       // Make hp::DoFHandler and its auxiliary class a friend since it is the
       // class that needs to create these data structures.
       template <int, int>
@@ -379,54 +291,28 @@ namespace internal
     // -------------------- template functions --------------------------------
 
 
-    inline bool
-    DoFLevel::is_compressed_entry(const active_fe_index_type active_fe_index)
-    {
-      return (static_cast<signed_active_fe_index_type>(active_fe_index) < 0);
-    }
-
-
-
-    inline DoFLevel::active_fe_index_type
-    DoFLevel::get_toggled_compression_state(
-      const active_fe_index_type active_fe_index)
-    {
-      // convert the active_fe_index into a signed type, flip all
-      // bits, and get the unsigned representation back
-      return static_cast<active_fe_index_type>(
-        ~(static_cast<signed_active_fe_index_type>(active_fe_index)));
-    }
-
-
-
     inline types::global_dof_index
     DoFLevel::get_dof_index(const unsigned int obj_index,
                             const unsigned int fe_index,
                             const unsigned int local_index) const
     {
-      (void)fe_index;
-      Assert(obj_index < dof_offsets.size(),
-             ExcIndexRange(obj_index, 0, dof_offsets.size()));
+      Assert(obj_index < cell_cache_offsets.size(),
+             ExcIndexRange(obj_index, 0, cell_cache_offsets.size()));
 
       // make sure we are on an object for which DoFs have been
       // allocated at all
-      Assert(dof_offsets[obj_index] != static_cast<offset_type>(-1),
+      Assert(cell_cache_offsets[obj_index] != static_cast<offset_type>(-1),
              ExcMessage("You are trying to access degree of freedom "
                         "information for an object on which no such "
                         "information is available"));
 
-      Assert(fe_index ==
-               (is_compressed_entry(active_fe_indices[obj_index]) == false ?
-                  active_fe_indices[obj_index] :
-                  get_toggled_compression_state(active_fe_indices[obj_index])),
+      Assert(fe_index == active_fe_indices[obj_index],
              ExcMessage("FE index does not match that of the present cell"));
+      AssertIndexRange(fe_index, first_interior_dof_indices.size());
 
-      // see if the dof_indices array has been compressed for this
-      // particular cell
-      if (is_compressed_entry(active_fe_indices[obj_index]) == false)
-        return dof_indices[dof_offsets[obj_index] + local_index];
-      else
-        return dof_indices[dof_offsets[obj_index]] + local_index;
+      return cell_dof_indices_cache[cell_cache_offsets[obj_index] +
+                                    first_interior_dof_indices[fe_index] +
+                                    local_index];
     }
 
 
@@ -437,24 +323,23 @@ namespace internal
                             const unsigned int            local_index,
                             const types::global_dof_index global_index)
     {
-      (void)fe_index;
-      Assert(obj_index < dof_offsets.size(),
-             ExcIndexRange(obj_index, 0, dof_offsets.size()));
+      Assert(obj_index < cell_cache_offsets.size(),
+             ExcIndexRange(obj_index, 0, cell_cache_offsets.size()));
 
       // make sure we are on an
       // object for which DoFs have
       // been allocated at all
-      Assert(dof_offsets[obj_index] != static_cast<offset_type>(-1),
+      Assert(cell_cache_offsets[obj_index] != static_cast<offset_type>(-1),
              ExcMessage("You are trying to access degree of freedom "
                         "information for an object on which no such "
                         "information is available"));
-      Assert(
-        is_compressed_entry(active_fe_indices[obj_index]) == false,
-        ExcMessage(
-          "This function can no longer be called after compressing the dof_indices array"));
       Assert(fe_index == active_fe_indices[obj_index],
              ExcMessage("FE index does not match that of the present cell"));
-      dof_indices[dof_offsets[obj_index] + local_index] = global_index;
+      AssertIndexRange(fe_index, first_interior_dof_indices.size());
+
+      cell_dof_indices_cache[cell_cache_offsets[obj_index] +
+                             first_interior_dof_indices[fe_index] +
+                             local_index] = global_index;
     }
 
 
@@ -465,10 +350,7 @@ namespace internal
       Assert(obj_index < active_fe_indices.size(),
              ExcIndexRange(obj_index, 0, active_fe_indices.size()));
 
-      if (is_compressed_entry(active_fe_indices[obj_index]) == false)
-        return active_fe_indices[obj_index];
-      else
-        return get_toggled_compression_state(active_fe_indices[obj_index]);
+      return active_fe_indices[obj_index];
     }
 
 
@@ -489,12 +371,12 @@ namespace internal
       Assert(obj_index < active_fe_indices.size(),
              ExcIndexRange(obj_index, 0, active_fe_indices.size()));
 
-      // check whether the given fe_index is within the range of
-      // values that we interpret as "not compressed". if not, then
-      // the index is so large that we cannot accept it. (but this
-      // will not likely happen because it requires someone using an
-      // FECollection that has more than 32k entries.)
-      Assert(is_compressed_entry(fe_index) == false,
+      // check whether the given fe_index can be represented by the type
+      // we store it in, and that it is not the value we reserve for
+      // marking invalid entries. (but this will not likely happen
+      // because it requires someone using an FECollection that has more
+      // than 64k entries.)
+      Assert(fe_index < invalid_active_fe_index,
              ExcMessage(
                "You are using an active_fe_index that is larger than an "
                "internal limitation for these objects. Try to work with "
@@ -531,12 +413,12 @@ namespace internal
       Assert(obj_index < future_fe_indices.size(),
              ExcIndexRange(obj_index, 0, future_fe_indices.size()));
 
-      // check whether the given fe_index is within the range of
-      // values that we interpret as "not compressed". if not, then
-      // the index is so large that we cannot accept it. (but this
-      // will not likely happen because it requires someone using an
-      // FECollection that has more than 32k entries.)
-      Assert(is_compressed_entry(fe_index) == false,
+      // check whether the given fe_index can be represented by the type
+      // we store it in, and that it is not the value we reserve for
+      // marking invalid entries. (but this will not likely happen
+      // because it requires someone using an FECollection that has more
+      // than 64k entries.)
+      Assert(fe_index < invalid_active_fe_index,
              ExcMessage(
                "You are using a future_fe_index that is larger than an "
                "internal limitation for these objects. Try to work with "
@@ -597,14 +479,42 @@ namespace internal
 
     template <class Archive>
     inline void
-    DoFLevel::serialize(Archive &ar, const unsigned int)
+    DoFLevel::serialize(Archive &ar, const unsigned int version)
     {
-      ar & this->active_fe_indices;
-      ar & this->cell_cache_offsets;
-      ar & this->cell_dof_indices_cache;
-      ar & this->dof_indices;
-      ar & this->dof_offsets;
-      ar & this->future_fe_indices;
+      if (version == 0)
+        {
+          // the layout of the first version, in which the interior DoF
+          // indices of each cell were stored a second time, possibly
+          // compressed, together with their own offsets. only loading is
+          // possible since saving always writes the current version
+          std::vector<types::global_dof_index> dof_indices;
+          std::vector<offset_type>             dof_offsets;
+
+          ar & this->active_fe_indices;
+          ar & this->cell_cache_offsets;
+          ar & this->cell_dof_indices_cache;
+          ar & dof_indices;
+          ar & dof_offsets;
+          ar & this->future_fe_indices;
+
+          // compressed entries stored the active_fe_index in binary
+          // complement
+          for (auto &active_fe_index : active_fe_indices)
+            if (active_fe_index != invalid_active_fe_index &&
+                static_cast<signed short int>(active_fe_index) < 0)
+              active_fe_index = static_cast<active_fe_index_type>(
+                ~static_cast<signed short int>(active_fe_index));
+
+          first_interior_dof_indices.clear();
+        }
+      else
+        {
+          ar & this->active_fe_indices;
+          ar & this->cell_cache_offsets;
+          ar & this->cell_dof_indices_cache;
+          ar & this->first_interior_dof_indices;
+          ar & this->future_fe_indices;
+        }
     }
   } // namespace hp
 
@@ -612,4 +522,8 @@ namespace internal
 
 DEAL_II_NAMESPACE_CLOSE
 
+// version 1 stores the interior DoF indices of cells only in the array of all
+// indices of a cell, see DoFLevel::serialize()
+BOOST_CLASS_VERSION(dealii::internal::hp::DoFLevel, 1)
+
 #endif
@@ -110,6 +110,37 @@ namespace internal
       UpdateFlags
       get_update_flags() const;
 
+      /**
+       * Create the FEValues objects for the given combinations of finite
+       * element, mapping, and quadrature indices right away, rather than
+       * lazily in the first call to reinit() that needs them. All three
+       * vectors must have the same length, and the <i>i</i>th object
+       * created is the one for the indices <tt>fe_indices[i]</tt>,
+       * <tt>mapping_indices[i]</tt>, and <tt>q_indices[i]</tt>.
+       *
+       * Setting up an FEValues object evaluates the shape functions of both
+       * the finite element and the mapping at all quadrature points, which is
+       * expensive for high polynomial degrees. For large collections, the
+       * lazy creation makes the first cells of each assembly loop much more
+       * expensive than the remaining ones, and it happens on whatever thread
+       * gets to these cells first. This function instead creates all
+       * requested objects in parallel.
+       */
+      void
+      precalculate_fe_values(const std::vector<unsigned int> &fe_indices,
+                             const std::vector<unsigned int> &mapping_indices,
+                             const std::vector<unsigned int> &q_indices);
+
+      /**
+       * Same as above, but for all the combinations of indices that reinit()
+       * selects by default: one for each element of the finite element
+       * collection, paired with the mapping and quadrature of the same index
+       * if the respective collection has more than one element, and with the
+       * first one otherwise.
+       */
+      void
+      precalculate_fe_values();
+
       /**
        * Return a reference to the @p FEValues object selected by the last
        * call to select_fe_values(). select_fe_values() in turn is called when
@@ -465,6 +465,42 @@ namespace hp
     /**
      * @}
      */
+
+    /**
+     * @name Optimizing p-level distribution
+     * @{
+     */
+
+    /**
+     * Adjust the @p future_fe_indices so that the levels of neighboring cells
+     * in the hierarchy of the hp::FECollection differ by at most
+     * @p max_difference. Cells whose future finite element is too low in the
+     * hierarchy compared to any of their neighbors are raised to the
+     * appropriate superordinate element.
+     *
+     * The level of each finite element is the number of times that
+     * hp::FECollection::previous_in_hierarchy() can be applied until the
+     * least subordinate element is reached.
+     *
+     * Cells are processed in parallel. All new levels of a sweep over the
+     * mesh are computed from the ones of the previous sweep, and sweeps are
+     * repeated until no more levels change. The result is therefore
+     * independent of the number of threads. On parallel::Triangulation
+     * objects, the levels on ghost cells are communicated after each sweep.
+     *
+     * @return Whether any @p future_fe_indices have been changed.
+     *
+     * @note Call this function after the p-adaptivity decisions have been
+     *   made, e.g., after choose_p_over_h().
+     */
+    template <int dim, int spacedim>
+    bool
+    limit_p_level_difference(const hp::DoFHandler<dim, spacedim> &dof_handler,
+                             const unsigned int max_difference = 1);
+
+    /**
+     * @}
+     */
   } // namespace Refinement
 } // namespace hp
 
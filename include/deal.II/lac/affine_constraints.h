@@ -1050,6 +1050,37 @@ public:
                              VectorType &                  global_vector,
                              bool use_inhomogeneities_for_rhs = false) const;
 
+  /**
+   * Batched version of the distribute_local_to_global() function for a
+   * single matrix above: distribute the local matrices of a whole batch of
+   * cells, each with its own set of global indices, into the global matrix at
+   * once. The constraints are resolved cell by cell exactly as in the
+   * single-cell function, including the treatment of the diagonal entries of
+   * constrained degrees of freedom, but the resulting entries are not
+   * written into the global matrix right away. Instead, the entries of all
+   * cells of the batch are collected, sorted by row and column, and entries
+   * coming from different cells for the same position are summed up, before
+   * each affected row is written with a single call to the
+   * <tt>add(row, n_cols, col_indices, values)</tt> function of the global
+   * matrix.
+   *
+   * This reduces the number of searches in and the number of scattered
+   * writes to the global matrix, which pays off when many cells of the batch
+   * share degrees of freedom, as is e.g. the case for the cells collected
+   * into the copy data of one chunk of a WorkStream::run() loop. On the other
+   * hand, the entries of the batch need to be kept in a temporary array, so
+   * batches should not be chosen too large.
+   *
+   * @note The note on thread safety of the single-cell function applies
+   * here as well.
+   */
+  template <typename MatrixType>
+  void
+  distribute_local_to_global(
+    const std::vector<FullMatrix<number>> &     local_matrices,
+    const std::vector<std::vector<size_type>> &local_dof_indices,
+    MatrixType &                                global_matrix) const;
+
   /**
    * Do a similar operation as the distribute_local_to_global() function that
    * distributes writing entries into a matrix for constrained degrees of
@@ -1302,6 +1333,35 @@ public:
                             const MPI_Comm               mpi_communicator,
                             const bool                   verbose = false) const;
 
+  /**
+   * Make the constraints on the locally relevant lines consistent between
+   * the processors of a distributed computation and close() the object.
+   *
+   * Each processor typically only knows the constraints it can compute from
+   * its own (locally owned and ghost) cells, e.g., when calling
+   * DoFTools::make_hanging_node_constraints(). This function first sends the
+   * constraints of all locally relevant but not locally owned lines to the
+   * owner of the respective degree of freedom, which adds those lines that
+   * it does not know about yet. Then, the owners send the constraints of all
+   * their lines that are locally relevant on other processors back to these
+   * processors, where they replace the constraints computed locally.
+   * Finally, close() is called to resolve chains of constraints.
+   *
+   * Communication only takes place with the processors that share locally
+   * relevant degrees of freedom with the current one, i.e., the processors
+   * found as ghost and import targets of a Utilities::MPI::Partitioner set up
+   * with @p locally_owned_dofs and @p locally_relevant_dofs. The former must
+   * be contiguous, as is the case for the degrees of freedom of a DoFHandler
+   * on a parallel::distributed::Triangulation.
+   *
+   * This is a collective operation and must not be called on an object that
+   * has already been closed.
+   */
+  void
+  make_consistent_in_parallel(const IndexSet &locally_owned_dofs,
+                              const IndexSet &locally_relevant_dofs,
+                              const MPI_Comm  mpi_communicator);
+
   /**
    * Exception
    *
@@ -18,6 +18,8 @@
 
 #include <deal.II/base/cuda_size.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/partitioner.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/thread_local_storage.h>
 
@@ -201,6 +203,102 @@ AffineConstraints<number>::is_consistent_in_parallel(
 
 
 
+template <typename number>
+void
+AffineConstraints<number>::make_consistent_in_parallel(
+  const IndexSet &locally_owned_dofs,
+  const IndexSet &locally_relevant_dofs,
+  const MPI_Comm  mpi_communicator)
+{
+  Assert(sorted == false, ExcMatrixIsClosed());
+
+  if (Utilities::MPI::n_mpi_processes(mpi_communicator) == 1)
+    {
+      close();
+      return;
+    }
+
+  // the partitioner knows which processes own our ghost dofs, and which
+  // processes have our locally owned dofs as ghosts. these are the only
+  // processes we need to talk to
+  const Utilities::MPI::Partitioner partitioner(locally_owned_dofs,
+                                                locally_relevant_dofs,
+                                                mpi_communicator);
+
+  const auto get_line = [&](const size_type index) -> ConstraintLine & {
+    return lines[lines_cache[calculate_line_index(index)]];
+  };
+
+  // send the constraints for the ghost dofs to their owners. the ghost
+  // indices are sorted by the owning process, in the same order as the
+  // ghost targets
+  {
+    std::map<unsigned int, std::vector<ConstraintLine>> lines_to_owners;
+
+    IndexSet::ElementIterator ghost = partitioner.ghost_indices().begin();
+    for (const auto &target : partitioner.ghost_targets())
+      for (unsigned int i = 0; i < target.second; ++i, ++ghost)
+        if (is_constrained(*ghost))
+          lines_to_owners[target.first].push_back(get_line(*ghost));
+
+    const std::map<unsigned int, std::vector<ConstraintLine>> received =
+      Utilities::MPI::some_to_some(mpi_communicator, lines_to_owners);
+
+    // add the lines we did not know about. if several processes know about
+    // the same line, the one of the process with the lowest rank wins
+    for (const auto &kv : received)
+      for (const ConstraintLine &line : kv.second)
+        if (is_constrained(line.index) == false)
+          {
+            add_line(line.index);
+            add_entries(line.index, line.entries);
+            set_inhomogeneity(line.index, line.inhomogeneity);
+          }
+  }
+
+  // now send the constraints of the locally owned dofs that are ghosts
+  // elsewhere back, so that all processes agree with the owner. the import
+  // indices are ranges of local indices, split by the importing process
+  {
+    std::map<unsigned int, std::vector<ConstraintLine>> lines_to_ghosts;
+
+    auto range = partitioner.import_indices().begin();
+    for (const auto &target : partitioner.import_targets())
+      for (unsigned int n_indices = 0; n_indices < target.second; ++range)
+        {
+          for (unsigned int i = range->first; i < range->second; ++i)
+            {
+              const size_type index = partitioner.local_to_global(i);
+              if (is_constrained(index))
+                lines_to_ghosts[target.first].push_back(get_line(index));
+            }
+          n_indices += range->second - range->first;
+        }
+
+    const std::map<unsigned int, std::vector<ConstraintLine>> received =
+      Utilities::MPI::some_to_some(mpi_communicator, lines_to_ghosts);
+
+    for (const auto &kv : received)
+      for (const ConstraintLine &line : kv.second)
+        if (is_constrained(line.index))
+          {
+            ConstraintLine &local_line = get_line(line.index);
+            local_line.entries         = line.entries;
+            local_line.inhomogeneity   = line.inhomogeneity;
+          }
+        else
+          {
+            add_line(line.index);
+            add_entries(line.index, line.entries);
+            set_inhomogeneity(line.index, line.inhomogeneity);
+          }
+  }
+
+  close();
+}
+
+
+
 template <typename number>
 void
 AffineConstraints<number>::add_lines(const std::set<size_type> &lines)
@@ -310,11 +408,20 @@ AffineConstraints<number>::close()
   // sort the lines
   std::sort(lines.begin(), lines.end());
 
-  // update list of pointers and give the vector a sharp size since we
-  // won't modify the size any more after this point.
+  // give the vector of lines a sharp size since we won't modify the size any
+  // more after this point. add_line() grows it geometrically, so it may
+  // otherwise hold almost twice the memory it needs
+  lines.shrink_to_fit();
+
+  // update list of pointers and give the vector a sharp size as well. since
+  // the lines are now sorted, the last one has the largest index into
+  // lines_cache, and all entries beyond it would only say that the
+  // corresponding dof is not constrained, which is also what we report for
+  // indices beyond the end of lines_cache
   {
-    std::vector<size_type> new_lines(lines_cache.size(),
-                                     numbers::invalid_size_type);
+    std::vector<size_type> new_lines(
+      lines.empty() ? 0 : calculate_line_index(lines.back().index) + 1,
+      numbers::invalid_size_type);
     size_type              counter = 0;
     for (const ConstraintLine &line : lines)
       {
@@ -330,18 +437,32 @@ AffineConstraints<number>::close()
       Assert(i == calculate_line_index(lines[lines_cache[i]].index),
              ExcInternalError());
 
+  // the work on the individual lines below is independent between lines
+  // (except for the resolution of chains), so split the loops over all
+  // lines into chunks of the following size and work on them in parallel
+  const unsigned int grainsize = 256;
+
   // first, strip zero entries, as we have to do that only once
-  for (ConstraintLine &line : lines)
-    // first remove zero entries. that would mean that in the linear
-    // constraint for a node, x_i = ax_1 + bx_2 + ..., another node times 0
-    // appears. obviously, 0*something can be omitted
-    line.entries.erase(std::remove_if(line.entries.begin(),
-                                      line.entries.end(),
-                                      [](
-                                        const std::pair<size_type, number> &p) {
-                                        return p.second == number(0.);
-                                      }),
-                       line.entries.end());
+  parallel::apply_to_subranges(
+    size_type(0),
+    lines.size(),
+    [this](const size_type begin, const size_type end) {
+      for (size_type l = begin; l < end; ++l)
+        {
+          // first remove zero entries. that would mean that in the linear
+          // constraint for a node, x_i = ax_1 + bx_2 + ..., another node
+          // times 0 appears. obviously, 0*something can be omitted
+          ConstraintLine &line = lines[l];
+          line.entries.erase(
+            std::remove_if(line.entries.begin(),
+                           line.entries.end(),
+                           [](const std::pair<size_type, number> &p) {
+                             return p.second == number(0.);
+                           }),
+            line.entries.end());
+        }
+    },
+    grainsize);
 
 
 
@@ -371,13 +492,45 @@ AffineConstraints<number>::close()
   // we sort the list so that throwing out duplicates becomes much more
   // efficient. also, we have to do it only once, rather than in each
   // iteration
+  //
+  // typically, only few lines reference constrained dofs at all. finding
+  // these lines is the expensive part and can be done in parallel since it
+  // only reads the lines. the replacement itself then only needs to visit
+  // these lines, in their original order, so that the result is the same as
+  // if we had looped over all lines
+  std::vector<size_type> chained_lines;
+  {
+    std::vector<char> line_is_chained(lines.size(), 0);
+    parallel::apply_to_subranges(
+      size_type(0),
+      lines.size(),
+      [this, &line_is_chained](const size_type begin, const size_type end) {
+        for (size_type l = begin; l < end; ++l)
+          for (const std::pair<size_type, number> &entry : lines[l].entries)
+            if (((local_lines.size() == 0) ||
+                 (local_lines.is_element(entry.first))) &&
+                is_constrained(entry.first))
+              {
+                line_is_chained[l] = 1;
+                break;
+              }
+      },
+      grainsize);
+
+    for (size_type l = 0; l < lines.size(); ++l)
+      if (line_is_chained[l] != 0)
+        chained_lines.push_back(l);
+  }
+
   size_type iteration = 0;
-  while (true)
+  while (chained_lines.size() > 0)
     {
       bool chained_constraint_replaced = false;
 
-      for (ConstraintLine &line : lines)
+      for (const size_type l : chained_lines)
         {
+          ConstraintLine &line = lines[l];
+
 #ifdef DEBUG
           // we need to keep track of how many replacements we do in this line,
           // because we can end up in a cycle A->B->C->A without the number of
@@ -484,91 +637,102 @@ AffineConstraints<number>::close()
   // finally sort the entries and re-scale them if necessary. in this step,
   // we also throw out duplicates as mentioned above. moreover, as some
   // entries might have had zero weights, we replace them by a vector with
-  // sharp sizes.
-  for (ConstraintLine &line : lines)
-    {
-      std::sort(line.entries.begin(),
-                line.entries.end(),
-                [](const std::pair<unsigned int, number> &a,
-                   const std::pair<unsigned int, number> &b) -> bool {
-                  // Let's use lexicogrpahic ordering with std::abs for number
-                  // type (it might be complex valued).
-                  return (a.first < b.first) ||
-                         (a.first == b.first &&
-                          std::abs(a.second) < std::abs(b.second));
-                });
-
-      // loop over the now sorted list and see whether any of the entries
-      // references the same dofs more than once in order to find how many
-      // non-duplicate entries we have. This lets us allocate the correct
-      // amount of memory for the constraint entries.
-      size_type duplicates = 0;
-      for (size_type i = 1; i < line.entries.size(); ++i)
-        if (line.entries[i].first == line.entries[i - 1].first)
-          duplicates++;
-
-      if (duplicates > 0 || line.entries.size() < line.entries.capacity())
+  // sharp sizes. this is done for each line separately, i.e., in parallel
+  parallel::apply_to_subranges(
+    size_type(0),
+    lines.size(),
+    [this](const size_type begin, const size_type end) {
+      for (size_type l = begin; l < end; ++l)
         {
-          typename ConstraintLine::Entries new_entries;
-
-          // if we have no duplicates, copy verbatim the entries. this way,
-          // the final size is of the vector is correct.
-          if (duplicates == 0)
-            new_entries = line.entries;
-          else
+          ConstraintLine &line = lines[l];
+
+          std::sort(line.entries.begin(),
+                    line.entries.end(),
+                    [](const std::pair<unsigned int, number> &a,
+                       const std::pair<unsigned int, number> &b) -> bool {
+                      // Let's use lexicogrpahic ordering with std::abs for
+                      // number type (it might be complex valued).
+                      return (a.first < b.first) ||
+                             (a.first == b.first &&
+                              std::abs(a.second) < std::abs(b.second));
+                    });
+
+          // loop over the now sorted list and see whether any of the entries
+          // references the same dofs more than once in order to find how many
+          // non-duplicate entries we have. This lets us allocate the correct
+          // amount of memory for the constraint entries.
+          size_type duplicates = 0;
+          for (size_type i = 1; i < line.entries.size(); ++i)
+            if (line.entries[i].first == line.entries[i - 1].first)
+              duplicates++;
+
+          if (duplicates > 0 ||
+              line.entries.size() < line.entries.capacity())
             {
-              // otherwise, we need to go through the list and resolve the
-              // duplicates
-              new_entries.reserve(line.entries.size() - duplicates);
-              new_entries.push_back(line.entries[0]);
-              for (size_type j = 1; j < line.entries.size(); ++j)
-                if (line.entries[j].first == line.entries[j - 1].first)
-                  {
-                    Assert(new_entries.back().first == line.entries[j].first,
-                           ExcInternalError());
-                    new_entries.back().second += line.entries[j].second;
-                  }
-                else
-                  new_entries.push_back(line.entries[j]);
-
-              Assert(new_entries.size() == line.entries.size() - duplicates,
-                     ExcInternalError());
+              typename ConstraintLine::Entries new_entries;
 
-              // make sure there are really no duplicates left and that the
-              // list is still sorted
-              for (size_type j = 1; j < new_entries.size(); ++j)
+              // if we have no duplicates, copy verbatim the entries. this
+              // way, the final size is of the vector is correct.
+              if (duplicates == 0)
+                new_entries = line.entries;
+              else
                 {
-                  Assert(new_entries[j].first != new_entries[j - 1].first,
-                         ExcInternalError());
-                  Assert(new_entries[j].first > new_entries[j - 1].first,
+                  // otherwise, we need to go through the list and resolve the
+                  // duplicates
+                  new_entries.reserve(line.entries.size() - duplicates);
+                  new_entries.push_back(line.entries[0]);
+                  for (size_type j = 1; j < line.entries.size(); ++j)
+                    if (line.entries[j].first == line.entries[j - 1].first)
+                      {
+                        Assert(new_entries.back().first ==
+                                 line.entries[j].first,
+                               ExcInternalError());
+                        new_entries.back().second += line.entries[j].second;
+                      }
+                    else
+                      new_entries.push_back(line.entries[j]);
+
+                  Assert(new_entries.size() ==
+                           line.entries.size() - duplicates,
                          ExcInternalError());
+
+                  // make sure there are really no duplicates left and that the
+                  // list is still sorted
+                  for (size_type j = 1; j < new_entries.size(); ++j)
+                    {
+                      Assert(new_entries[j].first != new_entries[j - 1].first,
+                             ExcInternalError());
+                      Assert(new_entries[j].first > new_entries[j - 1].first,
+                             ExcInternalError());
+                    }
                 }
-            }
 
-          // replace old list of constraints for this dof by the new one
-          line.entries.swap(new_entries);
-        }
+              // replace old list of constraints for this dof by the new one
+              line.entries.swap(new_entries);
+            }
 
-      // Finally do the following check: if the sum of weights for the
-      // constraints is close to one, but not exactly one, then rescale all
-      // the weights so that they sum up to 1. this adds a little numerical
-      // stability and avoids all sorts of problems where the actual value
-      // is close to, but not quite what we expected
-      //
-      // the case where the weights don't quite sum up happens when we
-      // compute the interpolation weights "on the fly", i.e. not from
-      // precomputed tables. in this case, the interpolation weights are
-      // also subject to round-off
-      number sum = 0.;
-      for (const std::pair<size_type, number> &entry : line.entries)
-        sum += entry.second;
-      if (std::abs(sum - number(1.)) < 1.e-13)
-        {
-          for (std::pair<size_type, number> &entry : line.entries)
-            entry.second /= sum;
-          line.inhomogeneity /= sum;
+          // Finally do the following check: if the sum of weights for the
+          // constraints is close to one, but not exactly one, then rescale
+          // all the weights so that they sum up to 1. this adds a little
+          // numerical stability and avoids all sorts of problems where the
+          // actual value is close to, but not quite what we expected
+          //
+          // the case where the weights don't quite sum up happens when we
+          // compute the interpolation weights "on the fly", i.e. not from
+          // precomputed tables. in this case, the interpolation weights are
+          // also subject to round-off
+          number sum = 0.;
+          for (const std::pair<size_type, number> &entry : line.entries)
+            sum += entry.second;
+          if (std::abs(sum - number(1.)) < 1.e-13)
+            {
+              for (std::pair<size_type, number> &entry : line.entries)
+                entry.second /= sum;
+              line.inhomogeneity /= sum;
+            }
         }
-    } // end of loop over all constraint lines
+    },
+    grainsize);
 
 #ifdef DEBUG
   // if in debug mode: check that no dof is constrained to another dof that
@@ -2277,13 +2441,23 @@ AffineConstraints<number>::distribute(VectorType &vec) const
       // own locally, possibly as ghost vector elements, then read from them,
       // and finally throw away the ghosted vector. Implement this in the
       // following.
-      IndexSet needed_elements = vec_owned_elements;
-
+      //
+      // collect the needed elements in a sorted list first so that the index
+      // set can merge them into ranges in one go, rather than inserting them
+      // one at a time
+      std::vector<size_type> needed_indices;
       for (const ConstraintLine &line : lines)
         if (vec_owned_elements.is_element(line.index))
           for (const std::pair<size_type, number> &entry : line.entries)
             if (!vec_owned_elements.is_element(entry.first))
-              needed_elements.add_index(entry.first);
+              needed_indices.push_back(entry.first);
+      std::sort(needed_indices.begin(), needed_indices.end());
+      needed_indices.erase(std::unique(needed_indices.begin(),
+                                       needed_indices.end()),
+                           needed_indices.end());
+
+      IndexSet needed_elements = vec_owned_elements;
+      needed_elements.add_indices(needed_indices.begin(), needed_indices.end());
 
       VectorType ghosted_vector;
       internal::import_vector_with_ghost_elements(
@@ -2800,6 +2974,51 @@ namespace internals
       }
   }
 
+  // a single entry of a global matrix, used to collect the contributions of
+  // a batch of cells in distribute_local_to_global before writing them into
+  // the global matrix row by row. entries are sorted lexicographically by row
+  // and column.
+  template <typename number>
+  struct MatrixEntry
+  {
+    MatrixEntry(const size_type row, const size_type column, const number value)
+      : row(row)
+      , column(column)
+      , value(value)
+    {}
+
+    bool
+    operator<(const MatrixEntry &other) const
+    {
+      return row < other.row || (row == other.row && column < other.column);
+    }
+
+    size_type row;
+    size_type column;
+    number    value;
+  };
+
+  // a stand-in for a global matrix that collects all entries added to it in
+  // a list of MatrixEntry objects. this lets us reuse set_matrix_diagonals
+  // for the batched variant of distribute_local_to_global.
+  template <typename number>
+  class MatrixEntryCollector
+  {
+  public:
+    MatrixEntryCollector(std::vector<MatrixEntry<number>> &entries)
+      : entries(entries)
+    {}
+
+    void
+    add(const size_type row, const size_type column, const number value)
+    {
+      entries.emplace_back(row, column, value);
+    }
+
+  private:
+    std::vector<MatrixEntry<number>> &entries;
+  };
+
   /**
    * Scratch data that is used during calls to distribute_local_to_global and
    * add_entries_local_to_global. In order to avoid frequent memory
@@ -2876,6 +3095,12 @@ namespace internals
        * Data array for reorder row/column indices.
        */
       GlobalRowsFromLocal<number> global_columns;
+
+      /**
+       * Temporary array for the matrix entries collected from a batch of
+       * cells.
+       */
+      std::vector<MatrixEntry<number>> matrix_entries;
     };
 
 
@@ -3670,8 +3895,14 @@ AffineConstraints<number>::distribute_local_to_global(
   // calling the other function above.
   const bool use_vectors =
     (local_vector.size() == 0 && global_vector.size() == 0) ? false : true;
+  SparseMatrix<number> *sparse_matrix =
+    dynamic_cast<SparseMatrix<number> *>(&global_matrix);
+  // the shortcut for deal.II sparse matrices writes into the matrix rows
+  // directly, which we must not do if several threads may add to the same
+  // row at the same time
   const bool use_dealii_matrix =
-    std::is_same<MatrixType, SparseMatrix<number>>::value;
+    std::is_same<MatrixType, SparseMatrix<number>>::value &&
+    sparse_matrix->get_thread_safe_add() == false;
 
   AssertDimension(local_matrix.n(), local_dof_indices.size());
   AssertDimension(local_matrix.m(), local_dof_indices.size());
@@ -3709,8 +3940,6 @@ AffineConstraints<number>::distribute_local_to_global(
     scratch_data->vector_values;
   vector_indices.resize(n_actual_dofs);
   vector_values.resize(n_actual_dofs);
-  SparseMatrix<number> *sparse_matrix =
-    dynamic_cast<SparseMatrix<number> *>(&global_matrix);
   if (use_dealii_matrix == false)
     {
       cols.resize(n_actual_dofs);
@@ -3804,6 +4033,101 @@ AffineConstraints<number>::distribute_local_to_global(
                                   use_inhomogeneities_for_rhs);
 }
 
+// batched variant of distribute_local_to_global for matrices: resolve the
+// constraints for each cell as above, but collect the resulting entries of
+// all cells, merge them and write each global row once
+template <typename number>
+template <typename MatrixType>
+void
+AffineConstraints<number>::distribute_local_to_global(
+  const std::vector<FullMatrix<number>> &     local_matrices,
+  const std::vector<std::vector<size_type>> &local_dof_indices,
+  MatrixType &                                global_matrix) const
+{
+  AssertDimension(local_matrices.size(), local_dof_indices.size());
+  Assert(global_matrix.m() == global_matrix.n(), ExcNotQuadratic());
+  Assert(lines.empty() || sorted == true, ExcMatrixNotClosed());
+
+  typename internals::AffineConstraintsData<number>::ScratchDataAccessor
+    scratch_data;
+
+  internals::GlobalRowsFromLocal<number> &global_rows =
+    scratch_data->global_rows;
+  std::vector<size_type> &cols = scratch_data->columns;
+  std::vector<number> &   vals = scratch_data->values;
+
+  std::vector<internals::MatrixEntry<number>> &entries =
+    scratch_data->matrix_entries;
+  entries.clear();
+  internals::MatrixEntryCollector<number> collector(entries);
+  Vector<number>                          dummy(0);
+
+  // first resolve the constraints on all cells and collect the resulting
+  // entries
+  for (unsigned int cell = 0; cell < local_matrices.size(); ++cell)
+    {
+      const FullMatrix<number> &    local_matrix = local_matrices[cell];
+      const std::vector<size_type> &dof_indices  = local_dof_indices[cell];
+      AssertDimension(local_matrix.n(), dof_indices.size());
+      AssertDimension(local_matrix.m(), dof_indices.size());
+
+      global_rows.reinit(dof_indices.size());
+      make_sorted_row_list(dof_indices, global_rows);
+
+      const size_type n_actual_dofs = global_rows.size();
+      cols.resize(n_actual_dofs);
+      vals.resize(n_actual_dofs);
+
+      for (size_type i = 0; i < n_actual_dofs; ++i)
+        {
+          size_type *col_ptr = cols.data();
+          number *   val_ptr = vals.data();
+          internals::resolve_matrix_row(global_rows,
+                                        global_rows,
+                                        i,
+                                        0,
+                                        n_actual_dofs,
+                                        local_matrix,
+                                        col_ptr,
+                                        val_ptr);
+          const size_type row      = global_rows.global_row(i);
+          const size_type n_values = col_ptr - cols.data();
+          for (size_type j = 0; j < n_values; ++j)
+            entries.emplace_back(row, cols[j], vals[j]);
+        }
+
+      internals::set_matrix_diagonals(global_rows,
+                                      dof_indices,
+                                      local_matrix,
+                                      *this,
+                                      collector,
+                                      dummy,
+                                      false);
+    }
+
+  // then sort the entries, sum up the contributions of different cells to
+  // the same position and write each row in one go
+  std::sort(entries.begin(), entries.end());
+
+  typename std::vector<internals::MatrixEntry<number>>::const_iterator
+    entry = entries.begin();
+  while (entry != entries.end())
+    {
+      const size_type row = entry->row;
+      cols.clear();
+      vals.clear();
+      for (; entry != entries.end() && entry->row == row; ++entry)
+        if (!cols.empty() && cols.back() == entry->column)
+          vals.back() += entry->value;
+        else
+          {
+            cols.push_back(entry->column);
+            vals.push_back(entry->value);
+          }
+      global_matrix.add(row, cols.size(), cols.data(), vals.data(), false, true);
+    }
+}
+
 // similar function as above, but now specialized for block matrices. See the
 // other function for additional comments.
 template <typename number>
@@ -3860,13 +4184,12 @@ AffineConstraints<number>::distribute_local_to_global(
   block_starts.resize(num_blocks + 1);
   internals::make_block_starts(global_matrix, global_rows, block_starts);
 
+  // the arrays for the column data are also needed for deal.II sparse
+  // matrices in case one of the blocks is set up for concurrent additions
   std::vector<size_type> &cols = scratch_data->columns;
   std::vector<number> &   vals = scratch_data->values;
-  if (use_dealii_matrix == false)
-    {
-      cols.resize(n_actual_dofs);
-      vals.resize(n_actual_dofs);
-    }
+  cols.resize(n_actual_dofs);
+  vals.resize(n_actual_dofs);
 
   // the basic difference to the non-block variant from now onwards is that we
   // go through the blocks of the matrix separately, which allows us to set
@@ -3882,7 +4205,14 @@ AffineConstraints<number>::distribute_local_to_global(
             {
               const size_type start_block = block_starts[block_col],
                               end_block   = block_starts[block_col + 1];
-              if (use_dealii_matrix == false)
+              SparseMatrix<number> *sparse_matrix =
+                use_dealii_matrix ? dynamic_cast<SparseMatrix<number> *>(
+                                      &global_matrix.block(block, block_col)) :
+                                    nullptr;
+              Assert(use_dealii_matrix == false || sparse_matrix != nullptr,
+                     ExcInternalError());
+              if (sparse_matrix == nullptr ||
+                  sparse_matrix->get_thread_safe_add() == true)
                 {
                   size_type *col_ptr = cols.data();
                   number *   val_ptr = vals.data();
@@ -3902,10 +4232,6 @@ AffineConstraints<number>::distribute_local_to_global(
                 }
               else
                 {
-                  SparseMatrix<number> *sparse_matrix =
-                    dynamic_cast<SparseMatrix<number> *>(
-                      &global_matrix.block(block, block_col));
-                  Assert(sparse_matrix != nullptr, ExcInternalError());
                   internals::resolve_matrix_row(global_rows,
                                                 i,
                                                 start_block,
@@ -0,0 +1,571 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_batched_full_matrix_h
+#define dealii_batched_full_matrix_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/lapack_support.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*! @addtogroup Matrix1
+ *@{
+ */
+
+/**
+ * A collection of many small dense square matrices of equal size that are
+ * factorized and solved with all at once. This is useful when a large number
+ * of independent small systems needs to be solved, e.g., for the local
+ * inverses of block-Jacobi preconditioners or for static condensation in
+ * hybridized discontinuous Galerkin methods, where calling
+ * LAPACKFullMatrix::compute_lu_factorization() for each of the matrices
+ * separately is dominated by the overhead of the calls and by the poor
+ * vectorization of LAPACK for sizes of a few dozen rows.
+ *
+ * The matrices are stored in an interleaved layout: The entries $(i,j)$ of
+ * VectorizedArray::n_array_elements consecutive matrices are stored in one
+ * VectorizedArray, such that all arithmetic operations of the factorizations
+ * and of the forward and backward substitutions act on
+ * VectorizedArray::n_array_elements matrices with a single SIMD instruction.
+ * Furthermore, the groups of matrices are worked on in parallel with the
+ * threads of the task scheduler. If the number of matrices is not a multiple
+ * of VectorizedArray::n_array_elements, the unused lanes of the last group
+ * hold identity matrices.
+ *
+ * The LU factorization uses partial pivoting like the LAPACK function getrf,
+ * the pivot rows being chosen separately for each matrix. The Cholesky
+ * factorization does not need pivoting and is thus cheaper, but requires the
+ * matrices to be symmetric and positive definite.
+ *
+ * A typical use looks as follows:
+ * @code
+ * BatchedFullMatrix<double> matrices(n_cells, dofs_per_cell);
+ * for (unsigned int c = 0; c < n_cells; ++c)
+ *   matrices.set_matrix(c, cell_matrix[c]);
+ * matrices.compute_lu_factorization();
+ *
+ * // rhs holds the right hand sides of all cells one after the other and
+ * // is overwritten by the solutions
+ * matrices.solve(make_array_view(rhs));
+ * @endcode
+ *
+ * @note The factorizations run on the host. For batched factorizations on
+ * GPUs, vendor libraries like cuBLAS provide their own batched interfaces.
+ *
+ * @tparam Number The scalar type of the matrix entries, @p double or
+ * @p float.
+ */
+template <typename Number>
+class BatchedFullMatrix
+{
+public:
+  /**
+   * The number of matrices that are worked on with one instruction.
+   */
+  static constexpr unsigned int n_lanes =
+    VectorizedArray<Number>::n_array_elements;
+
+  /**
+   * Default constructor. Creates an empty object.
+   */
+  BatchedFullMatrix();
+
+  /**
+   * Constructor. Creates @p n_matrices zero matrices with @p size rows and
+   * columns each.
+   */
+  BatchedFullMatrix(const unsigned int n_matrices, const unsigned int size);
+
+  /**
+   * Set the number and size of the matrices and set all entries to zero.
+   */
+  void
+  reinit(const unsigned int n_matrices, const unsigned int size);
+
+  /**
+   * Return the number of matrices.
+   */
+  unsigned int
+  n_matrices() const;
+
+  /**
+   * Return the number of rows and columns of each matrix.
+   */
+  unsigned int
+  size() const;
+
+  /**
+   * Copy the entries of @p matrix into the matrix with index @p index. The
+   * type @p MatrixType may be any matrix type with functions m() and n()
+   * and an <code>operator()(i,j)</code> for reading the entries, such as
+   * FullMatrix or LAPACKFullMatrix.
+   */
+  template <typename MatrixType>
+  void
+  set_matrix(const unsigned int index, const MatrixType &matrix);
+
+  /**
+   * Copy the content of the matrix with index @p index into @p matrix,
+   * which must have the correct size. After one of the factorizations has
+   * been computed, this returns the factors in the same format as LAPACK,
+   * i.e., the row-permuted matrices $L$ and $U$ for the LU factorization
+   * and the lower triangular factor $L$ in the lower triangle for the
+   * Cholesky factorization.
+   */
+  template <typename MatrixType>
+  void
+  get_matrix(const unsigned int index, MatrixType &matrix) const;
+
+  /**
+   * Compute the LU factorization of all matrices with partial pivoting.
+   * An exception of type LAPACKSupport::ExcErrorCode is thrown if one of the
+   * matrices is singular, with the error code set to the (one-based) column
+   * in which a zero pivot was encountered like in LAPACK.
+   */
+  void
+  compute_lu_factorization();
+
+  /**
+   * Compute the Cholesky factorization $A=LL^T$ of all matrices, using the
+   * lower triangle of the matrices. An exception of type
+   * LAPACKSupport::ExcErrorCode is thrown if one of the matrices is not
+   * positive definite.
+   */
+  void
+  compute_cholesky_factorization();
+
+  /**
+   * Solve the linear systems with all matrices after one of the
+   * factorizations has been computed. The vector @p rhs holds the right
+   * hand sides of all matrices one after the other, i.e., the right hand
+   * side for the matrix with index $i$ is stored in the entries
+   * $[i\cdot\text{size}(), (i+1)\cdot\text{size}())$, and it is overwritten
+   * by the solutions.
+   */
+  void
+  solve(const ArrayView<Number> &rhs) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * Return a pointer to the entries of the group of matrices with index
+   * @p batch, stored row by row.
+   */
+  VectorizedArray<Number> *
+  batch_data(const unsigned int batch);
+
+  /**
+   * Const version of the function above.
+   */
+  const VectorizedArray<Number> *
+  batch_data(const unsigned int batch) const;
+
+  /**
+   * The number of matrices.
+   */
+  unsigned int n_mat;
+
+  /**
+   * The number of rows and columns of each matrix.
+   */
+  unsigned int n_rows;
+
+  /**
+   * The entries of the matrices in the interleaved layout.
+   */
+  AlignedVector<VectorizedArray<Number>> data;
+
+  /**
+   * The pivot rows of the LU factorization. The index of the pivot row of
+   * column $k$ of the matrix with index $i$ is stored in entry $k\cdot
+   * N + i$, where $N$ is the number of matrices rounded up to a multiple of
+   * VectorizedArray::n_array_elements.
+   */
+  std::vector<unsigned int> pivots;
+
+  /**
+   * What the matrices currently contain.
+   */
+  LAPACKSupport::State state;
+};
+
+/*@}*/
+
+/*----------------------- Inline functions ----------------------------------*/
+
+#ifndef DOXYGEN
+
+template <typename Number>
+inline BatchedFullMatrix<Number>::BatchedFullMatrix()
+  : n_mat(0)
+  , n_rows(0)
+  , state(LAPACKSupport::matrix)
+{}
+
+
+
+template <typename Number>
+inline BatchedFullMatrix<Number>::BatchedFullMatrix(
+  const unsigned int n_matrices,
+  const unsigned int size)
+  : BatchedFullMatrix()
+{
+  reinit(n_matrices, size);
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::reinit(const unsigned int n_matrices,
+                                  const unsigned int size)
+{
+  n_mat  = n_matrices;
+  n_rows = size;
+  state  = LAPACKSupport::matrix;
+  pivots.clear();
+
+  const unsigned int n_batches = (n_matrices + n_lanes - 1) / n_lanes;
+  data.clear();
+  data.resize(static_cast<std::size_t>(n_batches) * size * size,
+              VectorizedArray<Number>());
+
+  // set the unused lanes of the last batch to the identity matrix to keep
+  // the factorizations well-defined
+  if (n_batches > 0)
+    {
+      VectorizedArray<Number> *last = batch_data(n_batches - 1);
+      for (unsigned int v = n_matrices - (n_batches - 1) * n_lanes;
+           v < n_lanes;
+           ++v)
+        for (unsigned int i = 0; i < size; ++i)
+          last[i * size + i][v] = Number(1.);
+    }
+}
+
+
+
+template <typename Number>
+inline unsigned int
+BatchedFullMatrix<Number>::n_matrices() const
+{
+  return n_mat;
+}
+
+
+
+template <typename Number>
+inline unsigned int
+BatchedFullMatrix<Number>::size() const
+{
+  return n_rows;
+}
+
+
+
+template <typename Number>
+inline VectorizedArray<Number> *
+BatchedFullMatrix<Number>::batch_data(const unsigned int batch)
+{
+  return data.begin() + static_cast<std::size_t>(batch) * n_rows * n_rows;
+}
+
+
+
+template <typename Number>
+inline const VectorizedArray<Number> *
+BatchedFullMatrix<Number>::batch_data(const unsigned int batch) const
+{
+  return data.begin() + static_cast<std::size_t>(batch) * n_rows * n_rows;
+}
+
+
+
+template <typename Number>
+template <typename MatrixType>
+inline void
+BatchedFullMatrix<Number>::set_matrix(const unsigned int index,
+                                      const MatrixType & matrix)
+{
+  AssertIndexRange(index, n_mat);
+  AssertDimension(matrix.m(), n_rows);
+  AssertDimension(matrix.n(), n_rows);
+  Assert(state == LAPACKSupport::matrix,
+         LAPACKSupport::ExcState(state));
+
+  VectorizedArray<Number> *entries = batch_data(index / n_lanes);
+  const unsigned int       lane    = index % n_lanes;
+  for (unsigned int i = 0; i < n_rows; ++i)
+    for (unsigned int j = 0; j < n_rows; ++j)
+      entries[i * n_rows + j][lane] = matrix(i, j);
+}
+
+
+
+template <typename Number>
+template <typename MatrixType>
+inline void
+BatchedFullMatrix<Number>::get_matrix(const unsigned int index,
+                                      MatrixType &       matrix) const
+{
+  AssertIndexRange(index, n_mat);
+  AssertDimension(matrix.m(), n_rows);
+  AssertDimension(matrix.n(), n_rows);
+
+  const VectorizedArray<Number> *entries = batch_data(index / n_lanes);
+  const unsigned int             lane    = index % n_lanes;
+  for (unsigned int i = 0; i < n_rows; ++i)
+    for (unsigned int j = 0; j < n_rows; ++j)
+      matrix(i, j) = entries[i * n_rows + j][lane];
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::compute_lu_factorization()
+{
+  Assert(state == LAPACKSupport::matrix,
+         LAPACKSupport::ExcState(state));
+  state = LAPACKSupport::unusable;
+
+  const unsigned int n_batches = (n_mat + n_lanes - 1) / n_lanes;
+  const unsigned int n         = n_rows;
+  pivots.resize(static_cast<std::size_t>(n_batches) * n_lanes * n);
+
+  parallel::apply_to_subranges(
+    0U,
+    n_batches,
+    [this, n, n_batches](const unsigned int begin, const unsigned int end) {
+      for (unsigned int batch = begin; batch < end; ++batch)
+        {
+          VectorizedArray<Number> *a = batch_data(batch);
+          for (unsigned int k = 0; k < n; ++k)
+            {
+              // the pivot search and the row exchange differ between the
+              // matrices of a batch, so do them lane by lane. they are of
+              // lower complexity than the elimination below
+              for (unsigned int v = 0; v < n_lanes; ++v)
+                {
+                  unsigned int pivot     = k;
+                  Number       max_value = std::abs(a[k * n + k][v]);
+                  for (unsigned int i = k + 1; i < n; ++i)
+                    if (std::abs(a[i * n + k][v]) > max_value)
+                      {
+                        pivot     = i;
+                        max_value = std::abs(a[i * n + k][v]);
+                      }
+                  AssertThrow(max_value != Number(),
+                              LAPACKSupport::ExcErrorCode("getrf", k + 1));
+                  pivots[static_cast<std::size_t>(k) * n_lanes * n_batches +
+                         batch * n_lanes + v] = pivot;
+                  if (pivot != k)
+                    for (unsigned int j = 0; j < n; ++j)
+                      std::swap(a[k * n + j][v], a[pivot * n + j][v]);
+                }
+
+              const VectorizedArray<Number> inv_pivot =
+                Number(1.) / a[k * n + k];
+              for (unsigned int i = k + 1; i < n; ++i)
+                {
+                  const VectorizedArray<Number> factor =
+                    a[i * n + k] * inv_pivot;
+                  a[i * n + k] = factor;
+                  for (unsigned int j = k + 1; j < n; ++j)
+                    a[i * n + j] -= factor * a[k * n + j];
+                }
+            }
+        }
+    },
+    1);
+
+  state = LAPACKSupport::lu;
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::compute_cholesky_factorization()
+{
+  Assert(state == LAPACKSupport::matrix,
+         LAPACKSupport::ExcState(state));
+  state = LAPACKSupport::unusable;
+
+  const unsigned int n_batches = (n_mat + n_lanes - 1) / n_lanes;
+  const unsigned int n         = n_rows;
+
+  parallel::apply_to_subranges(
+    0U,
+    n_batches,
+    [this, n](const unsigned int begin, const unsigned int end) {
+      for (unsigned int batch = begin; batch < end; ++batch)
+        {
+          VectorizedArray<Number> *a = batch_data(batch);
+          for (unsigned int j = 0; j < n; ++j)
+            {
+              VectorizedArray<Number> diagonal = a[j * n + j];
+              for (unsigned int k = 0; k < j; ++k)
+                diagonal -= a[j * n + k] * a[j * n + k];
+              for (unsigned int v = 0; v < n_lanes; ++v)
+                AssertThrow(diagonal[v] > Number(),
+                            LAPACKSupport::ExcErrorCode("potrf", j + 1));
+              diagonal       = std::sqrt(diagonal);
+              a[j * n + j]   = diagonal;
+              const auto inv = Number(1.) / diagonal;
+              for (unsigned int i = j + 1; i < n; ++i)
+                {
+                  VectorizedArray<Number> sum = a[i * n + j];
+                  for (unsigned int k = 0; k < j; ++k)
+                    sum -= a[i * n + k] * a[j * n + k];
+                  a[i * n + j] = sum * inv;
+                }
+            }
+        }
+    },
+    1);
+
+  state = LAPACKSupport::cholesky;
+}
+
+
+
+template <typename Number>
+inline void
+BatchedFullMatrix<Number>::solve(const ArrayView<Number> &rhs) const
+{
+  Assert(state == LAPACKSupport::lu || state == LAPACKSupport::cholesky,
+         LAPACKSupport::ExcState(state));
+  AssertDimension(rhs.size(), static_cast<std::size_t>(n_mat) * n_rows);
+
+  const unsigned int n_batches = (n_mat + n_lanes - 1) / n_lanes;
+  const unsigned int n         = n_rows;
+
+  parallel::apply_to_subranges(
+    0U,
+    n_batches,
+    [this, n, n_batches, &rhs](const unsigned int begin,
+                               const unsigned int end) {
+      AlignedVector<VectorizedArray<Number>> x(n);
+      for (unsigned int batch = begin; batch < end; ++batch)
+        {
+          const VectorizedArray<Number> *a = batch_data(batch);
+          const unsigned int             n_filled_lanes =
+            std::min(n_lanes, n_mat - batch * n_lanes);
+
+          // transpose the right hand sides into the interleaved layout
+          for (unsigned int i = 0; i < n; ++i)
+            x[i] = Number();
+          for (unsigned int v = 0; v < n_filled_lanes; ++v)
+            for (unsigned int i = 0; i < n; ++i)
+              x[i][v] = rhs[(batch * n_lanes + v) * n + i];
+
+          if (state == LAPACKSupport::lu)
+            {
+              // apply the row exchanges in the order of the factorization
+              for (unsigned int k = 0; k < n; ++k)
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  {
+                    const unsigned int pivot =
+                      pivots[static_cast<std::size_t>(k) * n_lanes *
+                               n_batches +
+                             batch * n_lanes + v];
+                    if (pivot != k)
+                      std::swap(x[k][v], x[pivot][v]);
+                  }
+
+              // forward substitution with the unit lower triangle
+              for (unsigned int i = 1; i < n; ++i)
+                {
+                  VectorizedArray<Number> sum = x[i];
+                  for (unsigned int j = 0; j < i; ++j)
+                    sum -= a[i * n + j] * x[j];
+                  x[i] = sum;
+                }
+
+              // backward substitution with the upper triangle
+              for (unsigned int i = n; i > 0;)
+                {
+                  --i;
+                  VectorizedArray<Number> sum = x[i];
+                  for (unsigned int j = i + 1; j < n; ++j)
+                    sum -= a[i * n + j] * x[j];
+                  x[i] = sum / a[i * n + i];
+                }
+            }
+          else
+            {
+              // forward substitution with L
+              for (unsigned int i = 0; i < n; ++i)
+                {
+                  VectorizedArray<Number> sum = x[i];
+                  for (unsigned int j = 0; j < i; ++j)
+                    sum -= a[i * n + j] * x[j];
+                  x[i] = sum / a[i * n + i];
+                }
+
+              // backward substitution with L^T, going through L by columns
+              for (unsigned int i = n; i > 0;)
+                {
+                  --i;
+                  x[i] /= a[i * n + i];
+                  for (unsigned int j = 0; j < i; ++j)
+                    x[j] -= a[i * n + j] * x[i];
+                }
+            }
+
+          for (unsigned int v = 0; v < n_filled_lanes; ++v)
+            for (unsigned int i = 0; i < n; ++i)
+              rhs[(batch * n_lanes + v) * n + i] = x[i][v];
+        }
+    },
+    1);
+}
+
+
+
+template <typename Number>
+inline std::size_t
+BatchedFullMatrix<Number>::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(data) +
+         MemoryConsumption::memory_consumption(pivots);
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -193,30 +193,11 @@ namespace LinearAlgebra
       __device__ void
       reduce_within_warp(volatile Number *result_buffer, size_type local_idx)
       {
-        if (block_size >= 64)
-          result_buffer[local_idx] =
-            Operation::reduction_op(result_buffer[local_idx],
-                                    result_buffer[local_idx + 32]);
-        if (block_size >= 32)
-          result_buffer[local_idx] =
-            Operation::reduction_op(result_buffer[local_idx],
-                                    result_buffer[local_idx + 16]);
-        if (block_size >= 16)
-          result_buffer[local_idx] =
-            Operation::reduction_op(result_buffer[local_idx],
-                                    result_buffer[local_idx + 8]);
-        if (block_size >= 8)
-          result_buffer[local_idx] =
-            Operation::reduction_op(result_buffer[local_idx],
-                                    result_buffer[local_idx + 4]);
-        if (block_size >= 4)
-          result_buffer[local_idx] =
-            Operation::reduction_op(result_buffer[local_idx],
-                                    result_buffer[local_idx + 2]);
-        if (block_size >= 2)
-          result_buffer[local_idx] =
-            Operation::reduction_op(result_buffer[local_idx],
-                                    result_buffer[local_idx + 1]);
+        for (size_type s = warp_size; s > 0; s = s >> 1)
+          if (block_size >= 2 * s)
+            result_buffer[local_idx] =
+              Operation::reduction_op(result_buffer[local_idx],
+                                      result_buffer[local_idx + s]);
       }
 
 
@@ -229,7 +210,7 @@ namespace LinearAlgebra
              const size_type global_idx,
              const size_type N)
       {
-        for (size_type s = block_size / 2; s > 32; s = s >> 1)
+        for (size_type s = block_size / 2; s > warp_size; s = s >> 1)
           {
             if (local_idx < s)
               result_buffer[local_idx] =
@@ -238,7 +219,7 @@ namespace LinearAlgebra
             __syncthreads();
           }
 
-        if (local_idx < 32)
+        if (local_idx < warp_size)
           reduce_within_warp<Number, Operation>(result_buffer, local_idx);
 
         if (local_idx == 0)
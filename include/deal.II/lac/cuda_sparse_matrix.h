@@ -123,6 +123,24 @@ namespace CUDAWrappers
     void
     reinit(Utilities::CUDA::Handle &             handle,
            const ::dealii::SparseMatrix<Number> &sparse_matrix_host);
+
+    /**
+     * Reinitialize the sparse matrix with the structure given by
+     * @p sparsity_pattern and set all entries to zero. Only the structure is
+     * copied to the device, so that the values can then be assembled
+     * directly on the device, without going through a ::dealii::SparseMatrix
+     * on the host: The pointers returned by get_cusparse_matrix() give
+     * access to the values, the column indices, and the row pointers in the
+     * compressed sparse row format, where the column indices within each row
+     * are sorted in increasing order, such that the position of an entry can
+     * be found by a binary search within its row.
+     *
+     * If the matrix has been initialized before, the cuSPARSE matrix
+     * description is reused.
+     */
+    void
+    reinit(Utilities::CUDA::Handle &handle,
+           const SparsityPattern &  sparsity_pattern);
     //@}
 
     /**
@@ -330,6 +348,16 @@ namespace CUDAWrappers
     //@}
 
   private:
+    /**
+     * Copy the structure of the matrix given by the row pointers @p row_ptr
+     * and the column indices @p column_index to the device and allocate the
+     * values. The matrix description is only created if it does not exist
+     * yet.
+     */
+    void
+    setup_device_structure(const std::vector<int> &row_ptr,
+                           const std::vector<int> &column_index);
+
     /**
      * cuSPARSE handle used to call cuSPARSE functions.
      */
@@ -27,6 +27,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <mutex>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -315,6 +316,44 @@ namespace DynamicSparsityPatternIterators
  * sp.copy_from (dynamic_pattern);
  * @endcode
  *
+ *
+ * <h3>Thread safety</h3>
+ *
+ * By default, no two threads may add entries to the same object at the same
+ * time. After calling set_thread_safe_insertion(), add() and add_entries()
+ * may be called concurrently from several threads, as is done for example by
+ * DoFTools::make_sparsity_pattern() when working on the cells in parallel.
+ * Rows are then protected by a fixed pool of mutexes shared by all objects
+ * of this class, so that threads only wait for each other when they insert
+ * into rows that happen to be guarded by the same mutex. All other
+ * functions, in particular the ones that query or compress the pattern,
+ * must not run concurrently with insertions.
+ *
+ *
+ * <h3>Lazy insertion</h3>
+ *
+ * Every insertion into a row keeps the row sorted, which requires moving all
+ * entries right of the inserted ones. For rows with hundreds of entries that
+ * receive contributions from many cells, as for higher order elements in 3d,
+ * this dominates the time to build the pattern. After calling
+ * set_lazy_insertion(), new entries are instead appended to their row
+ * without sorting or removing duplicates, and each row is only sorted and
+ * made unique when it would otherwise need to grow its memory, and once more
+ * for all rows in compress(). Between the call to set_lazy_insertion() and
+ * the next call to compress(), the object must only be used for adding
+ * entries:
+ * @code
+ * DynamicSparsityPattern dynamic_pattern (dof_handler.n_dofs());
+ * dynamic_pattern.set_lazy_insertion();
+ * DoFTools::make_sparsity_pattern (dof_handler,
+ *                                  dynamic_pattern,
+ *                                  constraints);
+ * dynamic_pattern.compress();
+ *
+ * SparsityPattern sp;
+ * sp.copy_from (dynamic_pattern);
+ * @endcode
+ *
  * @author Timo Heister, 2008
  */
 class DynamicSparsityPattern : public Subscriptor
@@ -325,6 +364,14 @@ public:
    */
   using size_type = types::global_dof_index;
 
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcLazyInsertion,
+                   "This function can not be called between a call to "
+                   "set_lazy_insertion() and the next call to compress(), "
+                   "since the rows are not sorted in the meantime.");
+
   /**
    * Typedef an for iterator class that allows to walk over all nonzero
    * elements of a sparsity pattern.
@@ -400,9 +447,11 @@ public:
          const IndexSet &rowset = IndexSet());
 
   /**
-   * Since this object is kept compressed at all times anyway, this function
-   * does nothing, but is declared to make the interface of this class as much
-   * alike as that of the SparsityPattern class.
+   * Unless set_lazy_insertion() has been called, this object is kept
+   * compressed at all times anyway, and this function does nothing but is
+   * declared to make the interface of this class as much alike as that of
+   * the SparsityPattern class. Otherwise, sort the entries of all rows,
+   * remove duplicates, and return to the default mode of insertion.
    */
   void
   compress();
@@ -438,6 +487,27 @@ public:
               ForwardIterator end,
               const bool      indices_are_unique_and_sorted = false);
 
+  /**
+   * Allow or disallow concurrent calls to add() and add_entries() from
+   * several threads. See the section on thread safety in the class
+   * documentation. Insertions are slightly more expensive in this mode
+   * because a mutex needs to be acquired for every row. The setting is reset
+   * to @p false by reinit().
+   */
+  void
+  set_thread_safe_insertion(const bool thread_safe);
+
+  /**
+   * Switch to lazy insertion, where add() and add_entries() append to the
+   * rows and the rows are only sorted when they would need to grow and in
+   * the next call to compress(). See the section on lazy insertion in the
+   * class documentation. Until compress() has been called, the object must
+   * not be used other than for adding entries. This mode can be combined
+   * with set_thread_safe_insertion(), and is reset by reinit().
+   */
+  void
+  set_lazy_insertion();
+
   /**
    * Check if a value at a certain position may be non-zero.
    */
@@ -667,11 +737,31 @@ public:
   memory_consumption() const;
 
 private:
+  /**
+   * Return the mutex that guards insertions into the row with the given
+   * index within #lines if thread-safe insertion has been enabled.
+   */
+  static std::mutex &
+  get_row_mutex(const size_type rowindex);
+
   /**
    * A flag that stores whether any entries have been added so far.
    */
   bool have_entries;
 
+  /**
+   * Whether add() and add_entries() may be called concurrently, see
+   * set_thread_safe_insertion().
+   */
+  bool thread_safe_insertion;
+
+  /**
+   * Whether add() and add_entries() append to the rows without sorting, see
+   * set_lazy_insertion(). While this flag is set, the rows are not
+   * guaranteed to be sorted and unique.
+   */
+  bool lazy_insertion;
+
   /**
    * Number of rows that this sparsity structure shall represent.
    */
@@ -719,6 +809,21 @@ private:
                 ForwardIterator end,
                 const bool      indices_are_sorted);
 
+    /**
+     * Append the columns specified by the iterator range to this line without
+     * keeping it sorted. If the currently allocated memory does not suffice,
+     * the line is compacted first.
+     */
+    template <typename ForwardIterator>
+    void
+    append_entries(ForwardIterator begin, ForwardIterator end);
+
+    /**
+     * Sort the entries and remove duplicates.
+     */
+    void
+    compact();
+
     /**
      * estimates memory consumption.
      */
@@ -1009,6 +1114,27 @@ DynamicSparsityPattern::Line::add(const size_type j)
 
 
 
+template <typename ForwardIterator>
+inline void
+DynamicSparsityPattern::Line::append_entries(ForwardIterator begin,
+                                             ForwardIterator end)
+{
+  // rather than letting the vector grow, first get rid of the duplicates
+  // that have accumulated. only grow if this does not free at least half of
+  // the memory, so that the cost of sorting is amortized over the
+  // subsequent insertions
+  const std::size_t n_elements = std::distance(begin, end);
+  if (entries.size() + n_elements > entries.capacity())
+    {
+      compact();
+      if (entries.size() + n_elements > entries.capacity() / 2)
+        entries.reserve(2 * (entries.size() + n_elements));
+    }
+  entries.insert(entries.end(), begin, end);
+}
+
+
+
 inline DynamicSparsityPattern::size_type
 DynamicSparsityPattern::n_rows() const
 {
@@ -1034,11 +1160,25 @@ DynamicSparsityPattern::add(const size_type i, const size_type j)
   if (rowset.size() > 0 && !rowset.is_element(i))
     return;
 
-  have_entries = true;
+  // in thread-safe mode, the flag has already been set, and we must not
+  // write to it concurrently
+  if (!have_entries)
+    have_entries = true;
 
   const size_type rowindex =
     rowset.size() == 0 ? i : rowset.index_within_set(i);
-  lines[rowindex].add(j);
+  if (thread_safe_insertion)
+    {
+      std::lock_guard<std::mutex> lock(get_row_mutex(rowindex));
+      if (lazy_insertion)
+        lines[rowindex].append_entries(&j, &j + 1);
+      else
+        lines[rowindex].add(j);
+    }
+  else if (lazy_insertion)
+    lines[rowindex].append_entries(&j, &j + 1);
+  else
+    lines[rowindex].add(j);
 }
 
 
@@ -1060,7 +1200,18 @@ DynamicSparsityPattern::add_entries(const size_type row,
 
   const size_type rowindex =
     rowset.size() == 0 ? row : rowset.index_within_set(row);
-  lines[rowindex].add_entries(begin, end, indices_are_sorted);
+  if (thread_safe_insertion)
+    {
+      std::lock_guard<std::mutex> lock(get_row_mutex(rowindex));
+      if (lazy_insertion)
+        lines[rowindex].append_entries(begin, end);
+      else
+        lines[rowindex].add_entries(begin, end, indices_are_sorted);
+    }
+  else if (lazy_insertion)
+    lines[rowindex].append_entries(begin, end);
+  else
+    lines[rowindex].add_entries(begin, end, indices_are_sorted);
 }
 
 
@@ -1069,6 +1220,7 @@ inline types::global_dof_index
 DynamicSparsityPattern::row_length(const size_type row) const
 {
   Assert(row < n_rows(), ExcIndexRangeType<size_type>(row, 0, n_rows()));
+  Assert(!lazy_insertion, ExcLazyInsertion());
 
   if (!have_entries)
     return 0;
@@ -1089,6 +1241,7 @@ DynamicSparsityPattern::column_number(const size_type row,
 {
   Assert(row < n_rows(), ExcIndexRangeType<size_type>(row, 0, n_rows()));
   Assert(rowset.size() == 0 || rowset.is_element(row), ExcInternalError());
+  Assert(!lazy_insertion, ExcLazyInsertion());
 
   const size_type local_row =
     rowset.size() ? rowset.index_within_set(row) : row;
@@ -1123,6 +1276,7 @@ inline DynamicSparsityPattern::iterator
 DynamicSparsityPattern::begin(const size_type r) const
 {
   Assert(r < n_rows(), ExcIndexRangeType<size_type>(r, 0, n_rows()));
+  Assert(!lazy_insertion, ExcLazyInsertion());
 
   if (!have_entries)
     return {this};
@@ -19,6 +19,11 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/lapack_full_matrix.h>
 #include <deal.II/lac/linear_operator.h>
 #include <deal.II/lac/precondition.h>
 #include <deal.II/lac/solver.h>
@@ -28,7 +33,9 @@
 #include <deal.II/lac/solver_minres.h>
 #include <deal.II/lac/vector_memory.h>
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -200,6 +207,121 @@ protected:
   AdditionalData additional_data;
 };
 
+
+/**
+ * Locally optimal block preconditioned conjugate gradient method (LOBPCG)
+ * for computing the smallest eigenvalues and the corresponding eigenvectors
+ * of a symmetric generalized eigenvalue problem $Ax=\lambda Bx$ with a
+ * symmetric positive definite matrix $B$.
+ *
+ * The method iterates on a block of as many vectors as eigenpairs are
+ * requested. In each step, the current approximations $X$, the
+ * preconditioned residuals $W = P(AX - BX\Theta)$, and the search
+ * directions $P$ of the previous step span a subspace of three times the
+ * block size, and the new approximations are computed by the Rayleigh-Ritz
+ * procedure on this subspace. As in the other solvers in this file, the
+ * matrices only need to provide a <tt>vmult()</tt> function, so the class
+ * works with matrix-free operators such as those in the MatrixFreeOperators
+ * namespace and LinearAlgebra::distributed::Vector without any copies into
+ * the vectors of an external library. The preconditioner is typically an
+ * approximation of the inverse of $A$, e.g. a multigrid V-cycle, or
+ * PreconditionIdentity.
+ *
+ * Apart from the applications of the operators, the work consists of the
+ * Gram matrices $S^TAS$ and $S^TBS$ of the subspace basis $S$ and of linear
+ * combinations of the basis vectors. For LinearAlgebra::distributed::Vector,
+ * all entries of both Gram matrices are computed in a single sweep over
+ * the locally owned entries followed by one global reduction, and the
+ * linear combinations are computed in a single sweep as well, processing the
+ * vectors in chunks that fit into cache. For other vector types, these
+ * operations fall back to the scalar products and <tt>add()</tt> functions
+ * of the vectors. The projected eigenvalue problems are small and are solved
+ * redundantly on each process with LAPACK. The basis is orthonormalized
+ * with respect to $B$ via an eigendecomposition of $S^TBS$, dropping
+ * directions that are numerically linearly dependent, which happens as the
+ * iteration converges.
+ *
+ * The iteration stops when the largest $l_2$ norm of the residuals
+ * $Ax_i-\lambda_i Bx_i$ falls below the tolerance of the SolverControl
+ * object.
+ *
+ * This class requires deal.II to be configured with LAPACK.
+ */
+template <typename VectorType = Vector<double>>
+class EigenLOBPCG : private SolverBase<VectorType>
+{
+public:
+  /**
+   * Declare type of container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Directions of the subspace basis whose $B$-norm after
+     * orthogonalization is smaller than this factor times the largest one
+     * are considered linearly dependent and are dropped.
+     */
+    double linear_dependence_tolerance;
+
+    /**
+     * Constructor.
+     */
+    AdditionalData(const double linear_dependence_tolerance = 1e-10)
+      : linear_dependence_tolerance(linear_dependence_tolerance)
+    {}
+  };
+
+  /**
+   * Constructor.
+   */
+  EigenLOBPCG(SolverControl &           cn,
+              VectorMemory<VectorType> &mem,
+              const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  EigenLOBPCG(SolverControl &cn, const AdditionalData &data = AdditionalData());
+
+  /**
+   * Compute the smallest <tt>eigenvectors.size()</tt> eigenvalues of the
+   * problem $Ax=\lambda Bx$ and the corresponding eigenvectors. On input,
+   * @p eigenvectors contains linearly independent start vectors. On output,
+   * @p eigenvalues contains the eigenvalues in ascending order and
+   * @p eigenvectors the eigenvectors, orthonormal with respect to $B$.
+   */
+  template <typename MatrixType,
+            typename MassMatrixType,
+            typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        const MassMatrixType &    B,
+        const PreconditionerType &preconditioner,
+        std::vector<double> &     eigenvalues,
+        std::vector<VectorType> & eigenvectors);
+
+  /**
+   * Same as above for the standard eigenvalue problem $Ax=\lambda x$.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        const PreconditionerType &preconditioner,
+        std::vector<double> &     eigenvalues,
+        std::vector<VectorType> & eigenvectors);
+
+protected:
+  /**
+   * Flags for execution.
+   */
+  AdditionalData additional_data;
+};
 /*@}*/
 //---------------------------------------------------------------------------
 
@@ -412,6 +534,434 @@ EigenInverse<VectorType>::solve(double &          value,
   // otherwise exit as normal
 }
 
+//---------------------------------------------------------------------------
+
+namespace internal
+{
+  namespace EigenLOBPCGImplementation
+  {
+    /**
+     * Compute the Gram matrices $S^TAS$ and $S^TBS$ from the basis vectors
+     * in @p S and their products with $A$ and $B$ in @p AS and @p BS.
+     */
+    template <typename VectorType>
+    void
+    compute_gram_matrices(const std::vector<const VectorType *> &S,
+                          const std::vector<const VectorType *> &AS,
+                          const std::vector<const VectorType *> &BS,
+                          FullMatrix<double> &                   gram_A,
+                          FullMatrix<double> &                   gram_B)
+    {
+      const unsigned int m = S.size();
+      gram_A.reinit(m, m);
+      gram_B.reinit(m, m);
+      for (unsigned int i = 0; i < m; ++i)
+        for (unsigned int j = i; j < m; ++j)
+          {
+            gram_A(i, j) = gram_A(j, i) = (*S[i]) * (*AS[j]);
+            gram_B(i, j) = gram_B(j, i) = (*S[i]) * (*BS[j]);
+          }
+    }
+
+
+
+    /**
+     * Same as above for LinearAlgebra::distributed::Vector, computing all
+     * scalar products in one sweep over the locally owned entries and one
+     * global reduction.
+     */
+    template <typename Number>
+    void
+    compute_gram_matrices(
+      const std::vector<const LinearAlgebra::distributed::Vector<Number> *> &S,
+      const std::vector<const LinearAlgebra::distributed::Vector<Number> *>
+        &AS,
+      const std::vector<const LinearAlgebra::distributed::Vector<Number> *>
+        &                 BS,
+      FullMatrix<double> &gram_A,
+      FullMatrix<double> &gram_B)
+    {
+      const unsigned int m          = S.size();
+      const unsigned int local_size = S[0]->local_size();
+
+      // the entries of the upper triangles of both matrices, interleaved
+      std::vector<double> local_sums(m * (m + 1), 0.);
+
+      // work on chunks of the vectors that fit into cache for all vectors
+      // of the basis together
+      const unsigned int chunk_size = 256;
+      for (unsigned int begin = 0; begin < local_size; begin += chunk_size)
+        {
+          const unsigned int end = std::min(begin + chunk_size, local_size);
+          unsigned int       c   = 0;
+          for (unsigned int i = 0; i < m; ++i)
+            {
+              const Number *s_i = S[i]->begin();
+              for (unsigned int j = i; j < m; ++j, c += 2)
+                {
+                  const Number *as_j  = AS[j]->begin();
+                  const Number *bs_j  = BS[j]->begin();
+                  double        sum_a = 0., sum_b = 0.;
+                  for (unsigned int e = begin; e < end; ++e)
+                    {
+                      sum_a += s_i[e] * as_j[e];
+                      sum_b += s_i[e] * bs_j[e];
+                    }
+                  local_sums[c] += sum_a;
+                  local_sums[c + 1] += sum_b;
+                }
+            }
+        }
+
+      std::vector<double> sums(local_sums.size());
+      Utilities::MPI::sum(local_sums, S[0]->get_mpi_communicator(), sums);
+
+      gram_A.reinit(m, m);
+      gram_B.reinit(m, m);
+      unsigned int c = 0;
+      for (unsigned int i = 0; i < m; ++i)
+        for (unsigned int j = i; j < m; ++j, c += 2)
+          {
+            gram_A(i, j) = gram_A(j, i) = sums[c];
+            gram_B(i, j) = gram_B(j, i) = sums[c + 1];
+          }
+    }
+
+
+
+    /**
+     * Set <tt>Y[j]</tt> to the linear combination of the vectors
+     * <tt>S[i]</tt> with $i\geq$ @p first_row and the coefficients
+     * <tt>coefficients(i,j)</tt>.
+     */
+    template <typename VectorType>
+    void
+    linear_combination(const std::vector<const VectorType *> &S,
+                       const FullMatrix<double> &             coefficients,
+                       const unsigned int                     first_row,
+                       std::vector<VectorType> &              Y)
+    {
+      for (unsigned int j = 0; j < Y.size(); ++j)
+        {
+          Y[j] = 0.;
+          for (unsigned int i = first_row; i < S.size(); ++i)
+            Y[j].add(coefficients(i, j), *S[i]);
+        }
+    }
+
+
+
+    /**
+     * Same as above for LinearAlgebra::distributed::Vector, computing all
+     * linear combinations in one sweep over the locally owned entries.
+     */
+    template <typename Number>
+    void
+    linear_combination(
+      const std::vector<const LinearAlgebra::distributed::Vector<Number> *> &S,
+      const FullMatrix<double> &coefficients,
+      const unsigned int        first_row,
+      std::vector<LinearAlgebra::distributed::Vector<Number>> &Y)
+    {
+      const unsigned int local_size = S[0]->local_size();
+      const unsigned int chunk_size = 256;
+      for (unsigned int begin = 0; begin < local_size; begin += chunk_size)
+        {
+          const unsigned int end = std::min(begin + chunk_size, local_size);
+          for (unsigned int j = 0; j < Y.size(); ++j)
+            {
+              Number *y_j = Y[j].begin();
+              for (unsigned int e = begin; e < end; ++e)
+                y_j[e] = Number();
+              for (unsigned int i = first_row; i < S.size(); ++i)
+                {
+                  const Number  c   = coefficients(i, j);
+                  const Number *s_i = S[i]->begin();
+                  for (unsigned int e = begin; e < end; ++e)
+                    y_j[e] += c * s_i[e];
+                }
+            }
+        }
+    }
+
+
+
+    /**
+     * Solve the projected eigenvalue problem with the Gram matrices
+     * @p gram_A and @p gram_B for the @p n_wanted smallest eigenvalues.
+     * The basis is first orthonormalized with respect to @p gram_B by an
+     * eigendecomposition, dropping directions that are linearly dependent
+     * up to @p tolerance. The columns of @p coefficients are the
+     * eigenvectors in terms of the original basis, orthonormal with respect
+     * to @p gram_B.
+     */
+    inline void
+    solve_projected_problem(const FullMatrix<double> &gram_A,
+                            const FullMatrix<double> &gram_B,
+                            const unsigned int        n_wanted,
+                            const double              tolerance,
+                            std::vector<double> &     eigenvalues,
+                            FullMatrix<double> &      coefficients)
+    {
+      const unsigned int m = gram_A.m();
+
+      // the eigenvalues of symmetric matrices are bounded by the Frobenius
+      // norm, which gives the search interval of the LAPACK routine
+      Vector<double>           mu;
+      FullMatrix<double>       V;
+      LAPACKFullMatrix<double> matrix_B(m);
+      matrix_B             = gram_B;
+      const double bound_B = 2. * gram_B.frobenius_norm() + 1.;
+      matrix_B.compute_eigenvalues_symmetric(-bound_B, bound_B, 0., mu, V);
+      AssertDimension(mu.size(), m);
+
+      // T = V_kept diag(mu_kept)^{-1/2} is an orthonormal basis with
+      // respect to gram_B of the numerically independent directions
+      const double max_mu = *std::max_element(mu.begin(), mu.end());
+      std::vector<unsigned int> kept;
+      for (unsigned int i = 0; i < m; ++i)
+        if (mu(i) > tolerance * max_mu)
+          kept.push_back(i);
+      AssertThrow(kept.size() >= n_wanted,
+                  ExcMessage("The subspace of the eigenvalue solver has "
+                             "become linearly dependent. Check that the "
+                             "start vectors are linearly independent."));
+
+      FullMatrix<double> T(m, kept.size());
+      for (unsigned int l = 0; l < kept.size(); ++l)
+        {
+          const double scaling = 1. / std::sqrt(mu(kept[l]));
+          for (unsigned int i = 0; i < m; ++i)
+            T(i, l) = V(i, kept[l]) * scaling;
+        }
+
+      FullMatrix<double> gram_A_T(m, kept.size()),
+        reduced_A(kept.size(), kept.size());
+      gram_A.mmult(gram_A_T, T);
+      T.Tmmult(reduced_A, gram_A_T);
+      // remove round-off asymmetry
+      for (unsigned int i = 0; i < kept.size(); ++i)
+        for (unsigned int j = i + 1; j < kept.size(); ++j)
+          reduced_A(i, j) = reduced_A(j, i) =
+            0.5 * (reduced_A(i, j) + reduced_A(j, i));
+
+      Vector<double>           theta;
+      FullMatrix<double>       Y;
+      LAPACKFullMatrix<double> matrix_A(kept.size());
+      matrix_A             = reduced_A;
+      const double bound_A = 2. * reduced_A.frobenius_norm() + 1.;
+      matrix_A.compute_eigenvalues_symmetric(-bound_A, bound_A, 0., theta, Y);
+      AssertDimension(theta.size(), kept.size());
+
+      // LAPACK returns the eigenvalues in ascending order
+      eigenvalues.resize(n_wanted);
+      coefficients.reinit(m, n_wanted);
+      for (unsigned int j = 0; j < n_wanted; ++j)
+        {
+          eigenvalues[j] = theta(j);
+          for (unsigned int i = 0; i < m; ++i)
+            {
+              double sum = 0.;
+              for (unsigned int l = 0; l < kept.size(); ++l)
+                sum += T(i, l) * Y(l, j);
+              coefficients(i, j) = sum;
+            }
+        }
+    }
+  } // namespace EigenLOBPCGImplementation
+} // namespace internal
+
+
+
+template <class VectorType>
+EigenLOBPCG<VectorType>::EigenLOBPCG(SolverControl &           cn,
+                                     VectorMemory<VectorType> &mem,
+                                     const AdditionalData &    data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <class VectorType>
+EigenLOBPCG<VectorType>::EigenLOBPCG(SolverControl &       cn,
+                                     const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <class VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+EigenLOBPCG<VectorType>::solve(const MatrixType &        A,
+                               const PreconditionerType &preconditioner,
+                               std::vector<double> &     eigenvalues,
+                               std::vector<VectorType> & eigenvectors)
+{
+  solve(A, PreconditionIdentity(), preconditioner, eigenvalues, eigenvectors);
+}
+
+
+
+template <class VectorType>
+template <typename MatrixType,
+          typename MassMatrixType,
+          typename PreconditionerType>
+void
+EigenLOBPCG<VectorType>::solve(const MatrixType &        A,
+                               const MassMatrixType &    B,
+                               const PreconditionerType &preconditioner,
+                               std::vector<double> &     eigenvalues,
+                               std::vector<VectorType> & eigenvectors)
+{
+  using namespace internal::EigenLOBPCGImplementation;
+
+  LogStream::Prefix prefix("LOBPCG");
+
+  const unsigned int n = eigenvectors.size();
+  Assert(n > 0, ExcMessage("At least one start vector must be given."));
+
+  // the blocks of the current approximations X, the preconditioned
+  // residuals W, and the search directions P, together with their products
+  // with A and B, and the new values of X and P
+  const auto create_block = [&]() {
+    std::vector<VectorType> block(n);
+    for (auto &v : block)
+      v.reinit(eigenvectors[0], true);
+    return block;
+  };
+  std::vector<VectorType> X = eigenvectors, AX = create_block(),
+                          BX = create_block(), W = create_block(),
+                          AW = create_block(), BW = create_block(),
+                          P = create_block(), AP = create_block(),
+                          BP = create_block(), X_new = create_block(),
+                          P_new = create_block();
+
+  std::vector<const VectorType *> S, AS, BS;
+  FullMatrix<double>              gram_A, gram_B, coefficients;
+
+  // set up the basis pointers for the blocks used in the current step
+  const auto set_basis = [&](const bool with_W, const bool with_P) {
+    S.clear();
+    AS.clear();
+    BS.clear();
+    for (unsigned int j = 0; j < n; ++j)
+      {
+        S.push_back(&X[j]);
+        AS.push_back(&AX[j]);
+        BS.push_back(&BX[j]);
+      }
+    for (unsigned int j = 0; with_W && j < n; ++j)
+      {
+        S.push_back(&W[j]);
+        AS.push_back(&AW[j]);
+        BS.push_back(&BW[j]);
+      }
+    for (unsigned int j = 0; with_P && j < n; ++j)
+      {
+        S.push_back(&P[j]);
+        AS.push_back(&AP[j]);
+        BS.push_back(&BP[j]);
+      }
+  };
+
+  // update X = S C and P = S C without the X rows, and the same for the
+  // products with A and B, which avoids applying the operators again
+  const auto update_blocks = [&](const bool with_P) {
+    linear_combination(S, coefficients, 0, X_new);
+    if (with_P)
+      linear_combination(S, coefficients, n, P_new);
+    X.swap(X_new);
+    if (with_P)
+      P.swap(P_new);
+
+    linear_combination(AS, coefficients, 0, X_new);
+    if (with_P)
+      linear_combination(AS, coefficients, n, P_new);
+    AX.swap(X_new);
+    if (with_P)
+      AP.swap(P_new);
+
+    linear_combination(BS, coefficients, 0, X_new);
+    if (with_P)
+      linear_combination(BS, coefficients, n, P_new);
+    BX.swap(X_new);
+    if (with_P)
+      BP.swap(P_new);
+  };
+
+  // Rayleigh-Ritz on the start vectors
+  for (unsigned int j = 0; j < n; ++j)
+    {
+      A.vmult(AX[j], X[j]);
+      B.vmult(BX[j], X[j]);
+    }
+  set_basis(false, false);
+  compute_gram_matrices(S, AS, BS, gram_A, gram_B);
+  solve_projected_problem(gram_A,
+                          gram_B,
+                          n,
+                          additional_data.linear_dependence_tolerance,
+                          eigenvalues,
+                          coefficients);
+  update_blocks(false);
+
+  // Main loop
+  SolverControl::State conv         = SolverControl::iterate;
+  double               max_residual = 0.;
+  bool                 have_P       = false;
+  unsigned int         iter         = 0;
+  for (;; ++iter)
+    {
+      // compute the residuals in AW, which is free at this point, and
+      // precondition them
+      max_residual = 0.;
+      for (unsigned int j = 0; j < n; ++j)
+        {
+          AW[j].equ(1., AX[j]);
+          AW[j].add(-eigenvalues[j], BX[j]);
+          max_residual = std::max(max_residual, AW[j].l2_norm());
+        }
+
+      conv = this->iteration_status(iter, max_residual, X[0]);
+      if (conv != SolverControl::iterate)
+        break;
+
+      for (unsigned int j = 0; j < n; ++j)
+        {
+          preconditioner.vmult(W[j], AW[j]);
+
+          // scale the new directions to unit length to keep the Gram
+          // matrices well balanced
+          const double norm = W[j].l2_norm();
+          if (norm > 0.)
+            W[j] *= 1. / norm;
+          A.vmult(AW[j], W[j]);
+          B.vmult(BW[j], W[j]);
+        }
+
+      set_basis(true, have_P);
+      compute_gram_matrices(S, AS, BS, gram_A, gram_B);
+      solve_projected_problem(gram_A,
+                              gram_B,
+                              n,
+                              additional_data.linear_dependence_tolerance,
+                              eigenvalues,
+                              coefficients);
+      update_blocks(true);
+      have_P = true;
+    }
+
+  // in case of failure: throw exception
+  AssertThrow(conv == SolverControl::success,
+              SolverControl::NoConvergence(iter, max_residual));
+
+  // otherwise exit as normal
+  eigenvectors.swap(X);
+}
+
 DEAL_II_NAMESPACE_CLOSE
 
 #endif
@@ -19,6 +19,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/exceptions.h>
 
 #include <deal.II/lac/block_indices.h>
@@ -340,6 +341,54 @@ namespace LinearAlgebra
       void
       update_ghost_values() const;
 
+      /**
+       * Initiate the update of the ghost values of all blocks. If all blocks
+       * live on the same communicator and do not use shared memory, the data
+       * of all blocks that is exchanged with the same process is sent in a
+       * single message, rather than one message per block and process. This
+       * makes the number of messages independent of the number of blocks.
+       * Otherwise, the exchange is started block by block.
+       *
+       * @param communication_channel Sets an offset to the MPI tags that
+       * avoids interference with other ongoing exchanges, see
+       * Vector::update_ghost_values_start(). The exchange of the individual
+       * blocks in the fallback case uses the channels
+       * <code>communication_channel</code> up to
+       * <code>communication_channel + n_blocks() - 1</code>.
+       *
+       * The exchange must be completed with update_ghost_values_finish()
+       * before the ghost values can be read.
+       */
+      void
+      update_ghost_values_start(
+        const unsigned int communication_channel = 0) const;
+
+      /**
+       * Finish the update of the ghost values initiated by
+       * update_ghost_values_start().
+       */
+      void
+      update_ghost_values_finish() const;
+
+      /**
+       * Initiate the transfer of the data in the ghost entries of all blocks
+       * to their owners, see compress(). For VectorOperation::add, the data
+       * is combined into one message per process in the same way as in
+       * update_ghost_values_start(); all other operations are started block
+       * by block.
+       */
+      void
+      compress_start(
+        const unsigned int                communication_channel = 0,
+        ::dealii::VectorOperation::values operation = VectorOperation::add);
+
+      /**
+       * Finish the transfer of ghost data initiated by compress_start(). The
+       * argument @p operation must be the same as in compress_start().
+       */
+      void
+      compress_finish(::dealii::VectorOperation::values operation);
+
       /**
        * This method zeros the entries on ghost dofs, but does not touch
        * locally owned DoFs.
@@ -542,6 +591,23 @@ namespace LinearAlgebra
                                             const BlockVector<Number> &V,
                                             const bool symmetric = false) const;
 
+      /**
+       * Calculate the scalar product between the $i$th block of this vector
+       * and the $i$th block of @p V for all blocks and store them in
+       * @p result, i.e., $r_i = U_i \cdot V_i$. This is the operation needed
+       * by solvers that iterate on several right hand sides stored as the
+       * blocks of one vector at once, like SolverCGMultipleRHS.
+       *
+       * The size of @p result must equal the number of blocks, and both
+       * vectors must have the same block structure.
+       *
+       * @note Internally, a single global reduction will be called to
+       * accumulate the scalar products of all blocks.
+       */
+      void
+      blockwise_inner_product(const ArrayView<Number> &  result,
+                              const BlockVector<Number> &V) const;
+
       /**
        * Set each block of this vector as follows:
        * $V^i = s V^i + b \sum_{j} U_j A^{ji}$ where $V^i$
@@ -716,6 +782,35 @@ namespace LinearAlgebra
        */
       DeclException0(ExcIteratorRangeDoesNotMatchVectorSize);
       //@}
+
+    private:
+      /**
+       * Return whether the data of all blocks can be exchanged in one
+       * message per process, i.e., whether the blocks share the same
+       * communicator and none of them reads the ghost data of other
+       * processes from shared memory.
+       */
+      bool
+      exchange_blocks_combined() const;
+
+#ifdef DEAL_II_WITH_MPI
+      /**
+       * The data sent by the ongoing combined exchange, sorted by the
+       * receiving process and within the data of one process by blocks.
+       */
+      mutable std::vector<Number> send_buffer;
+
+      /**
+       * The data received by the ongoing combined exchange, in the same
+       * layout as @p send_buffer.
+       */
+      mutable std::vector<Number> receive_buffer;
+
+      /**
+       * The MPI requests of the ongoing combined exchange.
+       */
+      mutable std::vector<MPI_Request> combined_requests;
+#endif
     };
 
     /*@}*/
@@ -25,6 +25,8 @@
 #include <deal.II/lac/trilinos_parallel_block_vector.h>
 #include <deal.II/lac/vector.h>
 
+#include <map>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -38,6 +40,114 @@ namespace LinearAlgebra
 {
   namespace distributed
   {
+#ifdef DEAL_II_WITH_MPI
+    namespace internal
+    {
+      /**
+       * Compute where the data exchanged with each process starts in the
+       * buffers of a combined exchange of all blocks of @p vec, where the
+       * data of one process is contiguous. The targets considered are the
+       * import targets of the partitioners of the blocks if @p imports is
+       * true and their ghost targets otherwise. The total size of the buffer
+       * is returned in @p buffer_size.
+       */
+      template <typename Number>
+      std::map<unsigned int, unsigned int>
+      compute_combined_buffer_offsets(const BlockVector<Number> &vec,
+                                      const bool                 imports,
+                                      unsigned int &             buffer_size)
+      {
+        std::map<unsigned int, unsigned int> offsets;
+        for (unsigned int block = 0; block < vec.n_blocks(); ++block)
+          {
+            const Utilities::MPI::Partitioner &partitioner =
+              *vec.block(block).get_partitioner();
+            for (const auto &target : imports ? partitioner.import_targets() :
+                                                partitioner.ghost_targets())
+              offsets[target.first] += target.second;
+          }
+
+        buffer_size = 0;
+        for (auto &offset : offsets)
+          {
+            const unsigned int n_entries = offset.second;
+            offset.second                = buffer_size;
+            buffer_size += n_entries;
+          }
+        return offsets;
+      }
+
+
+
+      /**
+       * Start the non-blocking receives and sends of a combined exchange
+       * with the buffer layout given by @p send_offsets and @p
+       * receive_offsets.
+       */
+      template <typename Number>
+      void
+      start_combined_exchange(
+        const MPI_Comm &                            communicator,
+        const unsigned int                          communication_channel,
+        const std::vector<Number> &                 send_buffer,
+        const std::map<unsigned int, unsigned int> &send_offsets,
+        std::vector<Number> &                       receive_buffer,
+        const std::map<unsigned int, unsigned int> &receive_offsets,
+        std::vector<MPI_Request> &                  requests)
+      {
+        const unsigned int my_pid =
+          Utilities::MPI::this_mpi_process(communicator);
+
+        // as in Utilities::MPI::Partitioner, the tag of a message is the
+        // rank of the sender plus the communication channel
+        for (auto offset = receive_offsets.begin();
+             offset != receive_offsets.end();
+             ++offset)
+          {
+            const auto         next = std::next(offset);
+            const unsigned int end =
+              next == receive_offsets.end() ? receive_buffer.size() :
+                                              next->second;
+            if (end == offset->second)
+              continue;
+
+            requests.emplace_back();
+            const int ierr =
+              MPI_Irecv(receive_buffer.data() + offset->second,
+                        (end - offset->second) * sizeof(Number),
+                        MPI_BYTE,
+                        offset->first,
+                        offset->first + communication_channel,
+                        communicator,
+                        &requests.back());
+            AssertThrowMPI(ierr);
+          }
+
+        for (auto offset = send_offsets.begin(); offset != send_offsets.end();
+             ++offset)
+          {
+            const auto         next = std::next(offset);
+            const unsigned int end =
+              next == send_offsets.end() ? send_buffer.size() : next->second;
+            if (end == offset->second)
+              continue;
+
+            requests.emplace_back();
+            const int ierr = MPI_Isend(send_buffer.data() + offset->second,
+                                       (end - offset->second) * sizeof(Number),
+                                       MPI_BYTE,
+                                       offset->first,
+                                       my_pid + communication_channel,
+                                       communicator,
+                                       &requests.back());
+            AssertThrowMPI(ierr);
+          }
+      }
+    } // namespace internal
+#endif
+
+
+
     template <typename Number>
     BlockVector<Number>::BlockVector(const size_type n_blocks,
                                      const size_type block_size)
@@ -248,6 +358,15 @@ namespace LinearAlgebra
     void
     BlockVector<Number>::compress(::dealii::VectorOperation::values operation)
     {
+      // with a single message per process for all blocks, the number of
+      // outstanding requests does not grow with the number of blocks
+      if (operation == VectorOperation::add && exchange_blocks_combined())
+        {
+          compress_start(8273, operation);
+          compress_finish(operation);
+          return;
+        }
+
       const unsigned int n_chunks =
         (this->n_blocks() + communication_block_size - 1) /
         communication_block_size;
@@ -275,6 +394,13 @@ namespace LinearAlgebra
     void
     BlockVector<Number>::update_ghost_values() const
     {
+      if (exchange_blocks_combined())
+        {
+          update_ghost_values_start(9923);
+          update_ghost_values_finish();
+          return;
+        }
+
       const unsigned int n_chunks =
         (this->n_blocks() + communication_block_size - 1) /
         communication_block_size;
@@ -297,6 +423,273 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number>
+    void
+    BlockVector<Number>::update_ghost_values_start(
+      const unsigned int communication_channel) const
+    {
+#ifdef DEAL_II_WITH_MPI
+      if (exchange_blocks_combined())
+        {
+          Assert(combined_requests.empty(),
+                 ExcMessage("Another operation seems to still be running. "
+                            "Call update_ghost_values_finish() first."));
+
+          unsigned int send_size = 0, receive_size = 0;
+          const std::map<unsigned int, unsigned int> send_offsets =
+            internal::compute_combined_buffer_offsets(*this, true, send_size);
+          const std::map<unsigned int, unsigned int> receive_offsets =
+            internal::compute_combined_buffer_offsets(*this,
+                                                      false,
+                                                      receive_size);
+          send_buffer.resize(send_size);
+          receive_buffer.resize(receive_size);
+
+          // pack the locally owned data requested by each process, block by
+          // block
+          std::map<unsigned int, unsigned int> send_positions = send_offsets;
+          for (unsigned int block = 0; block < this->n_blocks(); ++block)
+            {
+              const Utilities::MPI::Partitioner &partitioner =
+                *this->block(block).get_partitioner();
+              const Number *values = this->block(block).begin();
+              auto import_range    = partitioner.import_indices().begin();
+              unsigned int index   = partitioner.n_import_indices() > 0 ?
+                                     import_range->first :
+                                     0;
+              for (const auto &target : partitioner.import_targets())
+                {
+                  Number *write_position =
+                    send_buffer.data() + send_positions[target.first];
+                  for (unsigned int i = 0; i < target.second; ++i)
+                    {
+                      while (index == import_range->second)
+                        {
+                          ++import_range;
+                          index = import_range->first;
+                        }
+                      *write_position++ = values[index++];
+                    }
+                  send_positions[target.first] += target.second;
+                }
+            }
+
+          internal::start_combined_exchange(
+            this->block(0).get_mpi_communicator(),
+            communication_channel,
+            send_buffer,
+            send_offsets,
+            receive_buffer,
+            receive_offsets,
+            combined_requests);
+          return;
+        }
+#endif
+
+      for (unsigned int block = 0; block < this->n_blocks(); ++block)
+        this->block(block).update_ghost_values_start(communication_channel +
+                                                     block);
+    }
+
+
+
+    template <typename Number>
+    void
+    BlockVector<Number>::update_ghost_values_finish() const
+    {
+#ifdef DEAL_II_WITH_MPI
+      if (exchange_blocks_combined())
+        {
+          if (combined_requests.size() > 0)
+            {
+              const int ierr = MPI_Waitall(combined_requests.size(),
+                                           combined_requests.data(),
+                                           MPI_STATUSES_IGNORE);
+              AssertThrowMPI(ierr);
+              combined_requests.clear();
+            }
+
+          // move the data received from each process into the ghost ranges
+          // of the blocks
+          unsigned int                         receive_size = 0;
+          std::map<unsigned int, unsigned int> receive_positions =
+            internal::compute_combined_buffer_offsets(*this,
+                                                      false,
+                                                      receive_size);
+          AssertDimension(receive_size, receive_buffer.size());
+          for (unsigned int block = 0; block < this->n_blocks(); ++block)
+            {
+              const Utilities::MPI::Partitioner &partitioner =
+                *this->block(block).get_partitioner();
+              Number *ghost_values =
+                const_cast<Number *>(this->block(block).begin()) +
+                partitioner.local_size();
+              for (const auto &target : partitioner.ghost_targets())
+                {
+                  const Number *read_position =
+                    receive_buffer.data() + receive_positions[target.first];
+                  std::copy(read_position,
+                            read_position + target.second,
+                            ghost_values);
+                  ghost_values += target.second;
+                  receive_positions[target.first] += target.second;
+                }
+              this->block(block).vector_is_ghosted = true;
+            }
+          return;
+        }
+#endif
+
+      for (unsigned int block = 0; block < this->n_blocks(); ++block)
+        this->block(block).update_ghost_values_finish();
+    }
+
+
+
+    template <typename Number>
+    void
+    BlockVector<Number>::compress_start(
+      const unsigned int                communication_channel,
+      ::dealii::VectorOperation::values operation)
+    {
+#ifdef DEAL_II_WITH_MPI
+      if (operation == VectorOperation::add && exchange_blocks_combined())
+        {
+          Assert(combined_requests.empty(),
+                 ExcMessage("Another operation seems to still be running. "
+                            "Call compress_finish() first."));
+          Assert(has_ghost_elements() == false,
+                 ExcMessage("Cannot call compress() on a ghosted vector"));
+
+          unsigned int send_size = 0, receive_size = 0;
+          const std::map<unsigned int, unsigned int> send_offsets =
+            internal::compute_combined_buffer_offsets(*this, false, send_size);
+          const std::map<unsigned int, unsigned int> receive_offsets =
+            internal::compute_combined_buffer_offsets(*this,
+                                                      true,
+                                                      receive_size);
+          send_buffer.resize(send_size);
+          receive_buffer.resize(receive_size);
+
+          // pack the ghost data destined for each process, block by block
+          std::map<unsigned int, unsigned int> send_positions = send_offsets;
+          for (unsigned int block = 0; block < this->n_blocks(); ++block)
+            {
+              const Utilities::MPI::Partitioner &partitioner =
+                *this->block(block).get_partitioner();
+              const Number *ghost_values =
+                this->block(block).begin() + partitioner.local_size();
+              for (const auto &target : partitioner.ghost_targets())
+                {
+                  std::copy(ghost_values,
+                            ghost_values + target.second,
+                            send_buffer.data() + send_positions[target.first]);
+                  ghost_values += target.second;
+                  send_positions[target.first] += target.second;
+                }
+            }
+
+          internal::start_combined_exchange(
+            this->block(0).get_mpi_communicator(),
+            communication_channel,
+            send_buffer,
+            send_offsets,
+            receive_buffer,
+            receive_offsets,
+            combined_requests);
+          return;
+        }
+#endif
+
+      for (unsigned int block = 0; block < this->n_blocks(); ++block)
+        this->block(block).compress_start(communication_channel + block,
+                                          operation);
+    }
+
+
+
+    template <typename Number>
+    void
+    BlockVector<Number>::compress_finish(
+      ::dealii::VectorOperation::values operation)
+    {
+#ifdef DEAL_II_WITH_MPI
+      if (operation == VectorOperation::add && exchange_blocks_combined())
+        {
+          if (combined_requests.size() > 0)
+            {
+              const int ierr = MPI_Waitall(combined_requests.size(),
+                                           combined_requests.data(),
+                                           MPI_STATUSES_IGNORE);
+              AssertThrowMPI(ierr);
+              combined_requests.clear();
+            }
+
+          // add the data received from each process into the locally owned
+          // entries of the blocks and clear the ghost ranges
+          unsigned int                         receive_size = 0;
+          std::map<unsigned int, unsigned int> receive_positions =
+            internal::compute_combined_buffer_offsets(*this,
+                                                      true,
+                                                      receive_size);
+          AssertDimension(receive_size, receive_buffer.size());
+          for (unsigned int block = 0; block < this->n_blocks(); ++block)
+            {
+              const Utilities::MPI::Partitioner &partitioner =
+                *this->block(block).get_partitioner();
+              Number *     values       = this->block(block).begin();
+              auto         import_range = partitioner.import_indices().begin();
+              unsigned int index        = partitioner.n_import_indices() > 0 ?
+                                     import_range->first :
+                                     0;
+              for (const auto &target : partitioner.import_targets())
+                {
+                  const Number *read_position =
+                    receive_buffer.data() + receive_positions[target.first];
+                  for (unsigned int i = 0; i < target.second; ++i)
+                    {
+                      while (index == import_range->second)
+                        {
+                          ++import_range;
+                          index = import_range->first;
+                        }
+                      values[index++] += *read_position++;
+                    }
+                  receive_positions[target.first] += target.second;
+                }
+              this->block(block).zero_out_ghosts();
+            }
+          return;
+        }
+#endif
+
+      for (unsigned int block = 0; block < this->n_blocks(); ++block)
+        this->block(block).compress_finish(operation);
+    }
+
+
+
+    template <typename Number>
+    bool
+    BlockVector<Number>::exchange_blocks_combined() const
+    {
+#ifdef DEAL_II_WITH_MPI
+      if (this->n_blocks() < 2)
+        return false;
+
+      const MPI_Comm &communicator = this->block(0).get_mpi_communicator();
+      for (unsigned int block = 0; block < this->n_blocks(); ++block)
+        if (this->block(block).get_mpi_communicator() != communicator ||
+            this->block(block).shared_arrays.size() > 0)
+          return false;
+      return true;
+#else
+      return false;
+#endif
+    }
+
+
+
     template <typename Number>
     void
     BlockVector<Number>::zero_out_ghosts() const
@@ -900,6 +1293,27 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number>
+    void
+    BlockVector<Number>::blockwise_inner_product(
+      const ArrayView<Number> &  result,
+      const BlockVector<Number> &V) const
+    {
+      AssertDimension(result.size(), this->n_blocks());
+      AssertDimension(V.n_blocks(), this->n_blocks());
+
+      for (unsigned int i = 0; i < this->n_blocks(); ++i)
+        result[i] = this->block(i).inner_product_local(V.block(i));
+
+      if (this->n_blocks() > 0)
+        Utilities::MPI::sum(ArrayView<const Number>(result.data(),
+                                                    result.size()),
+                            this->block(0).get_mpi_communicator(),
+                            result);
+    }
+
+
+
     template <typename Number>
     template <typename FullMatrixType>
     Number
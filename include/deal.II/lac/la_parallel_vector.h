@@ -18,6 +18,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/memory_space.h>
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/numbers.h>
@@ -42,7 +43,15 @@ namespace LinearAlgebra
   {
     template <typename>
     class BlockVector;
-  }
+
+    template <typename>
+    class VectorExpression;
+
+    namespace internal
+    {
+      struct VectorExpressionEvaluator;
+    }
+  } // namespace distributed
 
   template <typename>
   class ReadWriteVector;
@@ -353,10 +362,29 @@ namespace LinearAlgebra
        * @p partitioner. The input argument is a shared pointer, which store
        * the partitioner data only once and share it between several vectors
        * with the same layout.
+       *
+       * The optional argument @p comm_sm is a sub-communicator of the
+       * communicator of @p partitioner that groups the processes that share
+       * memory, e.g. obtained from MPI_Comm_split_type() with
+       * MPI_COMM_TYPE_SHARED. If it contains more than one process, the
+       * memory of the vector is allocated in an MPI-3 shared-memory window
+       * and update_ghost_values() and compress() read the data of the
+       * processes in @p comm_sm directly from their memory instead of
+       * sending it through MPI. This only affects the performance: the
+       * vector behaves in the same way as without @p comm_sm, with two
+       * restrictions. First, the locally owned entries must not be changed
+       * between update_ghost_values_start() and
+       * update_ghost_values_finish(). Second, the allocation and
+       * deallocation of the memory is collective on @p comm_sm, so all
+       * processes must create, reinit and destroy their vectors in the same
+       * order. Vectors initialized from this vector by reinit(const
+       * Vector&) share @p comm_sm. Shared memory is only used for
+       * MemorySpace::Host.
        */
       void
       reinit(
-        const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner);
+        const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner,
+        const MPI_Comm &comm_sm = MPI_COMM_SELF);
 
       /**
        * Swap the contents of this vector and the other vector @p v. One could
@@ -571,6 +599,24 @@ namespace LinearAlgebra
       void
       update_ghost_values_finish() const;
 
+      /**
+       * Wait until the ghost data of one more process has arrived in an
+       * exchange started with update_ghost_values_start() and return the
+       * index of that process within the ghost_targets() of the partitioner
+       * of this vector. The ghost entries owned by that process can be read
+       * (e.g. via local_element()) from this point on, i.e., before
+       * update_ghost_values_finish() has been called.
+       *
+       * Returns numbers::invalid_unsigned_int once the data of all processes
+       * has arrived, or if the exchange cannot be tracked process by
+       * process, as is the case for exchanges through shared memory and for
+       * vectors in device memory. In either case, the ghost values are only
+       * available after the subsequent call to update_ghost_values_finish(),
+       * which is mandatory also when this function has been used.
+       */
+      unsigned int
+      update_ghost_values_wait_any() const;
+
       /**
        * This method zeros the entries on ghost dofs, but does not touch
        * locally owned DoFs.
@@ -897,6 +943,63 @@ namespace LinearAlgebra
           const Number                       b,
           const Vector<Number, MemorySpace> &v);
 
+      /**
+       * Compute the inner products of this vector with each of the vectors
+       * in @p V and store them in @p results, i.e., <tt>results[i] = *this *
+       * *V[i]</tt>. The same applies for complex-valued vectors as for the
+       * operator*().
+       *
+       * In contrast to calling operator*() for each vector separately, this
+       * vector is loaded from memory only once for every batch of up to
+       * eight vectors, and the local results of all vectors are combined by
+       * a single global reduction. This is useful for orthogonalizing a
+       * vector against a set of basis vectors with the classical
+       * Gram-Schmidt algorithm in Krylov solvers.
+       */
+      void
+      multi_dot(const ArrayView<const Vector<Number, MemorySpace> *const> &V,
+                const ArrayView<Number> &results) const;
+
+      /**
+       * Multiple addition of scaled vectors, i.e., <tt>*this += a[0]*(*V[0])
+       * + a[1]*(*V[1]) + ...</tt>. In contrast to subsequent calls to add(),
+       * this vector is only loaded and stored once for every batch of up to
+       * eight vectors.
+       */
+      void
+      multi_add(const ArrayView<const Number> &                           a,
+                const ArrayView<const Vector<Number, MemorySpace> *const> &V);
+
+      /**
+       * Assign the value of a vector expression such as <tt>a*x + b*y -
+       * z</tt> to this vector, evaluating the whole expression in a single
+       * loop over the locally owned entries. See the documentation of
+       * VectorExpression for details. Only available for the memory space
+       * Host, and only if the header
+       * <tt>deal.II/lac/la_parallel_vector_expressions.h</tt> is included.
+       */
+      template <typename Expression>
+      Vector<Number, MemorySpace> &
+      operator=(const VectorExpression<Expression> &expression);
+
+      /**
+       * Add the value of a vector expression to this vector in a single loop
+       * over the locally owned entries, see operator=() with a
+       * VectorExpression argument.
+       */
+      template <typename Expression>
+      Vector<Number, MemorySpace> &
+      operator+=(const VectorExpression<Expression> &expression);
+
+      /**
+       * Subtract the value of a vector expression from this vector in a
+       * single loop over the locally owned entries, see operator=() with a
+       * VectorExpression argument.
+       */
+      template <typename Expression>
+      Vector<Number, MemorySpace> &
+      operator-=(const VectorExpression<Expression> &expression);
+
       //@}
 
 
@@ -1362,6 +1465,20 @@ namespace LinearAlgebra
        */
       mutable bool vector_is_ghosted;
 
+      /**
+       * The communicator of the processes that share memory with this
+       * process, as given to reinit(). MPI_COMM_SELF if no shared memory is
+       * used.
+       */
+      MPI_Comm comm_sm;
+
+      /**
+       * If the memory of this vector is allocated in a shared-memory window,
+       * the arrays of all processes in @p comm_sm, indexed by their rank in
+       * that communicator. Empty otherwise.
+       */
+      std::vector<ArrayView<const Number>> shared_arrays;
+
 #ifdef DEAL_II_WITH_MPI
       /**
        * A vector that collects all requests from @p compress() operations.
@@ -1395,10 +1512,13 @@ namespace LinearAlgebra
       clear_mpi_requests();
 
       /**
-       * A helper function that is used to resize the val array.
+       * A helper function that is used to resize the val array. If @p
+       * comm_sm contains more than one process, the memory is allocated in
+       * a shared-memory window on that communicator.
        */
       void
-      resize_val(const size_type new_allocated_size);
+      resize_val(const size_type new_allocated_size,
+                 const MPI_Comm &comm_sm = MPI_COMM_SELF);
 
       // Make all other vector types friends.
       template <typename Number2, typename MemorySpace2>
@@ -1407,6 +1527,9 @@ namespace LinearAlgebra
       // Make BlockVector type friends.
       template <typename Number2>
       friend class BlockVector;
+
+      // The evaluation of vector expressions uses the thread partitioner.
+      friend struct internal::VectorExpressionEvaluator;
     };
     /*@}*/
 
@@ -93,7 +93,9 @@ namespace LinearAlgebra
           const types::global_dof_index /*new_alloc_size*/,
           types::global_dof_index & /*allocated_size*/,
           ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpaceType>
-            & /*data*/)
+            & /*data*/,
+          const MPI_Comm & /*comm_sm*/,
+          std::vector<ArrayView<const Number>> & /*shared_arrays*/)
         {}
 
         static void
@@ -127,9 +129,82 @@ namespace LinearAlgebra
         resize_val(const types::global_dof_index new_alloc_size,
                    types::global_dof_index &     allocated_size,
                    ::dealii::MemorySpace::
-                     MemorySpaceData<Number, ::dealii::MemorySpace::Host> &data)
+                     MemorySpaceData<Number, ::dealii::MemorySpace::Host> &data,
+                   const MPI_Comm &                      comm_sm,
+                   std::vector<ArrayView<const Number>> &shared_arrays)
         {
-          if (new_alloc_size > allocated_size)
+#ifdef DEAL_II_WITH_MPI
+#  if DEAL_II_MPI_VERSION_GTE(3, 0)
+          if (comm_sm != MPI_COMM_SELF &&
+              Utilities::MPI::n_mpi_processes(comm_sm) > 1)
+            {
+              // the window is allocated collectively on the shared-memory
+              // communicator, so set up a new one irrespective of the size
+              // that is already allocated on this process
+              data.values.reset();
+              shared_arrays.clear();
+
+              MPI_Info info;
+              int      ierr = MPI_Info_create(&info);
+              AssertThrowMPI(ierr);
+              // let MPI place the memory of each process close to it
+              ierr = MPI_Info_set(info, "alloc_shared_noncontig", "true");
+              AssertThrowMPI(ierr);
+
+              // allocate at least one entry to get a valid pointer that owns
+              // the window
+              Number *new_val = nullptr;
+              MPI_Win win;
+              ierr = MPI_Win_allocate_shared(
+                std::max<types::global_dof_index>(new_alloc_size, 1) *
+                  sizeof(Number),
+                sizeof(Number),
+                info,
+                comm_sm,
+                &new_val,
+                &win);
+              AssertThrowMPI(ierr);
+              ierr = MPI_Info_free(&info);
+              AssertThrowMPI(ierr);
+
+              // the vector might be destroyed after MPI_Finalize(), in which
+              // case the window is gone anyway
+              const auto free_window = [win](Number *) mutable {
+                int finalized = 0;
+                MPI_Finalized(&finalized);
+                if (finalized == 0)
+                  MPI_Win_free(&win);
+              };
+              data.values =
+                std::unique_ptr<Number[], std::function<void(Number *)>>(
+                  new_val, free_window);
+
+              const unsigned int n_procs_sm =
+                Utilities::MPI::n_mpi_processes(comm_sm);
+              shared_arrays.resize(n_procs_sm);
+              for (unsigned int p = 0; p < n_procs_sm; ++p)
+                {
+                  MPI_Aint size      = 0;
+                  int      disp_unit = 0;
+                  Number * ptr       = nullptr;
+                  ierr =
+                    MPI_Win_shared_query(win, p, &size, &disp_unit, &ptr);
+                  AssertThrowMPI(ierr);
+                  shared_arrays[p] =
+                    ArrayView<const Number>(ptr, size / sizeof(Number));
+                }
+
+              allocated_size = new_alloc_size;
+              return;
+            }
+#  endif
+#endif
+          (void)comm_sm;
+
+          // memory in a shared-memory window must be replaced when the
+          // vector returns to a plain allocation
+          if (new_alloc_size > allocated_size ||
+              (shared_arrays.size() > 0 && new_alloc_size > 0))
             {
               Assert(((allocated_size > 0 && data.values != nullptr) ||
                       data.values == nullptr),
@@ -140,7 +215,9 @@ namespace LinearAlgebra
                 reinterpret_cast<void **>(&new_val),
                 64,
                 sizeof(Number) * new_alloc_size);
-              data.values.reset(new_val);
+              data.values =
+                std::unique_ptr<Number[], std::function<void(Number *)>>(
+                  new_val, &free);
 
               allocated_size = new_alloc_size;
             }
@@ -149,6 +226,7 @@ namespace LinearAlgebra
               data.values.reset();
               allocated_size = 0;
             }
+          shared_arrays.clear();
         }
 
         static void
@@ -227,7 +305,9 @@ namespace LinearAlgebra
         resize_val(const types::global_dof_index new_alloc_size,
                    types::global_dof_index &     allocated_size,
                    ::dealii::MemorySpace::
-                     MemorySpaceData<Number, ::dealii::MemorySpace::CUDA> &data)
+                     MemorySpaceData<Number, ::dealii::MemorySpace::CUDA> &data,
+                   const MPI_Comm & /*comm_sm*/,
+                   std::vector<ArrayView<const Number>> & /*shared_arrays*/)
         {
           static_assert(
             std::is_same<Number, float>::value ||
@@ -379,18 +459,12 @@ namespace LinearAlgebra
     Vector<Number, MemorySpaceType>::clear_mpi_requests()
     {
 #ifdef DEAL_II_WITH_MPI
-      for (size_type j = 0; j < compress_requests.size(); j++)
-        {
-          const int ierr = MPI_Request_free(&compress_requests[j]);
-          AssertThrowMPI(ierr);
-        }
-      compress_requests.clear();
-      for (size_type j = 0; j < update_ghost_values_requests.size(); j++)
-        {
-          const int ierr = MPI_Request_free(&update_ghost_values_requests[j]);
-          AssertThrowMPI(ierr);
-        }
-      update_ghost_values_requests.clear();
+      // the requests might be persistent requests owned by the partitioner,
+      // so let the partitioner free them
+      if (compress_requests.size() > 0)
+        partitioner->free_requests(compress_requests);
+      if (update_ghost_values_requests.size() > 0)
+        partitioner->free_requests(update_ghost_values_requests);
 #endif
     }
 
@@ -398,11 +472,17 @@ namespace LinearAlgebra
 
     template <typename Number, typename MemorySpaceType>
     void
-    Vector<Number, MemorySpaceType>::resize_val(const size_type new_alloc_size)
+    Vector<Number, MemorySpaceType>::resize_val(const size_type new_alloc_size,
+                                                const MPI_Comm &comm_sm_in)
     {
+      comm_sm = comm_sm_in;
       internal::la_parallel_vector_templates_functions<
         Number,
-        MemorySpaceType>::resize_val(new_alloc_size, allocated_size, data);
+        MemorySpaceType>::resize_val(new_alloc_size,
+                                     allocated_size,
+                                     data,
+                                     comm_sm,
+                                     shared_arrays);
 
       thread_loop_partitioner =
         std::make_shared<::dealii::parallel::internal::TBBPartitioner>();
@@ -450,12 +530,15 @@ namespace LinearAlgebra
       // different (check only if the are allocated
       // differently, not if the actual data is
       // different)
-      if (partitioner.get() != v.partitioner.get())
+      // the memory in a shared-memory window is allocated collectively,
+      // which must not depend on the state of the vector on this process
+      if (partitioner.get() != v.partitioner.get() ||
+          v.shared_arrays.size() > 0 || shared_arrays.size() > 0)
         {
           partitioner = v.partitioner;
           const size_type new_allocated_size =
             partitioner->local_size() + partitioner->n_ghost_indices();
-          resize_val(new_allocated_size);
+          resize_val(new_allocated_size, v.comm_sm);
         }
 
       if (omit_zeroing_entries == false)
@@ -509,7 +592,8 @@ namespace LinearAlgebra
     template <typename Number, typename MemorySpaceType>
     void
     Vector<Number, MemorySpaceType>::reinit(
-      const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner_in)
+      const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner_in,
+      const MPI_Comm &                                          comm_sm_in)
     {
       clear_mpi_requests();
       partitioner = partitioner_in;
@@ -517,7 +601,11 @@ namespace LinearAlgebra
       // set vector size and allocate memory
       const size_type new_allocated_size =
         partitioner->local_size() + partitioner->n_ghost_indices();
-      resize_val(new_allocated_size);
+      resize_val(new_allocated_size, comm_sm_in);
+#ifdef DEAL_II_WITH_MPI
+      if (shared_arrays.size() > 0)
+        partitioner->initialize_shared_memory_exchange(comm_sm);
+#endif
 
       // initialize to zero
       this->operator=(Number());
@@ -987,7 +1075,8 @@ namespace LinearAlgebra
               partitioner->n_ghost_indices()),
             ArrayView<Number, MemorySpace::Host>(
               import_data.values.get(), partitioner->n_import_indices()),
-            compress_requests);
+            compress_requests,
+            shared_arrays);
         }
 #endif
     }
@@ -1043,7 +1132,8 @@ namespace LinearAlgebra
               ArrayView<Number, MemorySpace::Host>(
                 data.values.get() + partitioner->local_size(),
                 partitioner->n_ghost_indices()),
-              compress_requests);
+              compress_requests,
+              shared_arrays);
         }
 
 #  if defined DEAL_II_COMPILER_CUDA_AWARE && \
@@ -1116,10 +1206,13 @@ namespace LinearAlgebra
 
 #  if defined DEAL_II_COMPILER_CUDA_AWARE && \
     !defined(DEAL_II_MPI_WITH_CUDA_SUPPORT)
-      // Move the data to the host and then move it back to the
-      // device. We use values to store the elements because the function
-      // uses a view of the array and thus we need the data on the host to
-      // outlive the scope of the function.
+      // The exchange runs on the host, which only reads the locally owned
+      // entries sent to other processes. Gather these on the device and only
+      // move them to the host, instead of the whole vector. We use values to
+      // store the elements because the function uses a view of the array and
+      // thus we need the data on the host to outlive the scope of the
+      // function. The ghost values are moved back to the device in
+      // update_ghost_values_finish().
       Number *new_val;
       Utilities::System::posix_memalign(reinterpret_cast<void **>(&new_val),
                                         64,
@@ -1127,11 +1220,22 @@ namespace LinearAlgebra
 
       data.values.reset(new_val);
 
-      cudaError_t cuda_error_code = cudaMemcpy(data.values.get(),
-                                               data.values_dev.get(),
-                                               allocated_size * sizeof(Number),
-                                               cudaMemcpyDeviceToHost);
-      AssertCuda(cuda_error_code);
+      if (partitioner->n_import_indices() > 0)
+        {
+          if (import_data.values_dev == nullptr)
+            import_data.values_dev.reset(
+              Utilities::CUDA::allocate_device_data<Number>(
+                partitioner->n_import_indices()));
+          partitioner->copy_import_entries_to_host(
+            ArrayView<const Number, MemorySpace::CUDA>(
+              data.values_dev.get(), partitioner->local_size()),
+            ArrayView<Number, MemorySpace::CUDA>(
+              import_data.values_dev.get(), partitioner->n_import_indices()),
+            ArrayView<Number, MemorySpace::Host>(
+              import_data.values.get(), partitioner->n_import_indices()),
+            ArrayView<Number, MemorySpace::Host>(data.values.get(),
+                                                 partitioner->local_size()));
+        }
 #  endif
 
 #  if !(defined(DEAL_II_COMPILER_CUDA_AWARE) && \
@@ -1145,7 +1249,8 @@ namespace LinearAlgebra
         ArrayView<Number, MemorySpace::Host>(data.values.get() +
                                                partitioner->local_size(),
                                              partitioner->n_ghost_indices()),
-        update_ghost_values_requests);
+        update_ghost_values_requests,
+        shared_arrays);
 #  else
       partitioner->export_to_ghosted_array_start<Number, MemorySpace::CUDA>(
         counter,
@@ -1173,9 +1278,13 @@ namespace LinearAlgebra
 #ifdef DEAL_II_WITH_MPI
       // wait for both sends and receives to complete, even though only
       // receives are really necessary. this gives (much) better performance
-      AssertDimension(partitioner->ghost_targets().size() +
-                        partitioner->import_targets().size(),
-                      update_ghost_values_requests.size());
+      Assert(shared_arrays.size() > 0 ||
+               partitioner->ghost_targets().size() +
+                   partitioner->import_targets().size() ==
+                 update_ghost_values_requests.size(),
+             ExcDimensionMismatch(partitioner->ghost_targets().size() +
+                                    partitioner->import_targets().size(),
+                                  update_ghost_values_requests.size()));
       if (update_ghost_values_requests.size() > 0)
         {
           // make this function thread safe
@@ -1187,7 +1296,8 @@ namespace LinearAlgebra
             ArrayView<Number, MemorySpace::Host>(
               data.values.get() + partitioner->local_size(),
               partitioner->n_ghost_indices()),
-            update_ghost_values_requests);
+            update_ghost_values_requests,
+            shared_arrays);
 #  else
           partitioner->export_to_ghosted_array_finish(
             ArrayView<Number, MemorySpace::CUDA>(
@@ -1220,6 +1330,27 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number, typename MemorySpaceType>
+    unsigned int
+    Vector<Number, MemorySpaceType>::update_ghost_values_wait_any() const
+    {
+#ifdef DEAL_II_WITH_MPI
+      if (update_ghost_values_requests.empty() || shared_arrays.size() > 0 ||
+          std::is_same<MemorySpaceType, MemorySpace::CUDA>::value)
+        return numbers::invalid_unsigned_int;
+
+      // make this function thread safe
+      std::lock_guard<std::mutex> lock(mutex);
+
+      return partitioner->export_to_ghosted_array_wait_any(
+        update_ghost_values_requests);
+#else
+      return numbers::invalid_unsigned_int;
+#endif
+    }
+
+
+
     template <typename Number, typename MemorySpaceType>
     void
     Vector<Number, MemorySpaceType>::import(
@@ -1351,6 +1482,8 @@ namespace LinearAlgebra
       std::swap(data, v.data);
       std::swap(import_data, v.import_data);
       std::swap(vector_is_ghosted, v.vector_is_ghosted);
+      std::swap(comm_sm, v.comm_sm);
+      std::swap(shared_arrays, v.shared_arrays);
     }
 
 
@@ -1749,6 +1882,72 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number, typename MemorySpaceType>
+    void
+    Vector<Number, MemorySpaceType>::multi_dot(
+      const ArrayView<const Vector<Number, MemorySpaceType> *const> &vectors,
+      const ArrayView<Number> &                                      results) const
+    {
+      AssertDimension(vectors.size(), results.size());
+
+      std::vector<
+        const ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpaceType> *>
+        v_data(vectors.size());
+      for (unsigned int i = 0; i < vectors.size(); ++i)
+        {
+          AssertDimension(local_size(), vectors[i]->local_size());
+          v_data[i] = &vectors[i]->data;
+        }
+
+      dealii::internal::VectorOperations::
+        functions<Number, Number, MemorySpaceType>::multi_dot(
+          thread_loop_partitioner,
+          partitioner->local_size(),
+          v_data,
+          data,
+          results.data());
+
+      if (partitioner->n_mpi_processes() > 1)
+        Utilities::MPI::sum(ArrayView<const Number>(results.data(),
+                                                    results.size()),
+                            partitioner->get_mpi_communicator(),
+                            results);
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    void
+    Vector<Number, MemorySpaceType>::multi_add(
+      const ArrayView<const Number> &                                a,
+      const ArrayView<const Vector<Number, MemorySpaceType> *const> &vectors)
+    {
+      AssertDimension(a.size(), vectors.size());
+
+      std::vector<
+        const ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpaceType> *>
+        v_data(vectors.size());
+      for (unsigned int i = 0; i < vectors.size(); ++i)
+        {
+          AssertIsFinite(a[i]);
+          AssertDimension(local_size(), vectors[i]->local_size());
+          v_data[i] = &vectors[i]->data;
+        }
+
+      dealii::internal::VectorOperations::
+        functions<Number, Number, MemorySpaceType>::multi_add(
+          thread_loop_partitioner,
+          partitioner->local_size(),
+          a.data(),
+          v_data,
+          data);
+
+      if (vector_is_ghosted)
+        update_ghost_values();
+    }
+
+
+
     template <typename Number, typename MemorySpaceType>
     bool
     Vector<Number, MemorySpaceType>::all_zero() const
@@ -0,0 +1,676 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_la_parallel_vector_expressions_h
+#define dealii_la_parallel_vector_expressions_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/numbers.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector_operation.h>
+#include <deal.II/lac/vector_operations_internal.h>
+
+#include <type_traits>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  namespace VectorOperations
+  {
+    // The reduction operations for vector expressions. They are placed in
+    // this namespace like the other operations, since parallel_reduce()
+    // finds some of its helper functions by argument-dependent lookup.
+
+    /**
+     * The operation passed to parallel_reduce() for the inner product of
+     * two vector expressions.
+     */
+    template <typename Expression1, typename Expression2>
+    struct VectorExpressionDot
+    {
+      using Number = typename Expression1::value_type;
+
+      static const bool vectorizes =
+        VectorizedArray<Number>::n_array_elements > 1;
+
+      VectorExpressionDot(const Expression1 &expression1,
+                          const Expression2 &expression2)
+        : expression1(expression1)
+        , expression2(expression2)
+      {}
+
+      Number
+      operator()(const size_type i) const
+      {
+        return expression1.value(i) *
+               Number(numbers::NumberTraits<Number>::conjugate(
+                 expression2.value(i)));
+      }
+
+      VectorizedArray<Number>
+      do_vectorized(const size_type i) const
+      {
+        // VectorizedArray is only available for real numbers, see the Dot
+        // operation
+        return expression1.vectorized_value(i) *
+               expression2.vectorized_value(i);
+      }
+
+      const Expression1 &expression1;
+      const Expression2 &expression2;
+    };
+
+
+
+    /**
+     * The operation passed to parallel_reduce() for the square of the
+     * $l_2$ norm of a vector expression.
+     */
+    template <typename Expression, typename RealType>
+    struct VectorExpressionNorm2
+    {
+      using Number = typename Expression::value_type;
+
+      static const bool vectorizes =
+        VectorizedArray<Number>::n_array_elements > 1;
+
+      VectorExpressionNorm2(const Expression &expression)
+        : expression(expression)
+      {}
+
+      RealType
+      operator()(const size_type i) const
+      {
+        return numbers::NumberTraits<Number>::abs_square(expression.value(i));
+      }
+
+      VectorizedArray<Number>
+      do_vectorized(const size_type i) const
+      {
+        const VectorizedArray<Number> x = expression.vectorized_value(i);
+        return x * x;
+      }
+
+      const Expression &expression;
+    };
+  } // namespace VectorOperations
+} // namespace internal
+
+
+
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    /*! @addtogroup Vectors
+     *@{
+     */
+
+    /**
+     * The base class of lazily evaluated linear combinations of
+     * LinearAlgebra::distributed::Vector objects (with memory space Host).
+     *
+     * Writing an update such as $u = a x + b y - c z$ with the usual
+     * vector functions requires several calls like
+     * @code
+     *   u.equ(a, x);
+     *   u.add(b, y, -c, z);
+     * @endcode
+     * each of which is a separate pass through memory. With the operators
+     * defined in this file, the right hand side is instead represented by a
+     * tree of small objects that merely reference the vectors and store the
+     * factors,
+     * @code
+     *   #include <deal.II/lac/la_parallel_vector_expressions.h>
+     *
+     *   u = a * x + b * y - c * z;
+     *   u += 2. * (x - y);
+     * @endcode
+     * and the assignment evaluates the whole expression in a single loop
+     * over the locally owned entries, reading each vector once and writing
+     * the result once. The loop is split among threads in the same way as
+     * the other vector operations and processes the entries in chunks of the
+     * width of VectorizedArray. The expression may contain the destination
+     * vector itself, as in <tt>u = a * u + b * x</tt>, since each entry only
+     * depends on the entries with the same index.
+     *
+     * As with add() or sadd(), only the locally owned entries are computed.
+     * If the destination vector is in ghosted state, its ghost entries are
+     * updated afterwards, which involves communication.
+     *
+     * Expressions can also be reduced without storing them in a vector by
+     * the functions inner_product() and l2_norm() below, e.g.,
+     * <tt>l2_norm(x - y)</tt> computes the norm of the difference of two
+     * vectors in one pass and without a temporary vector.
+     *
+     * All vectors in an expression must have the same number type and the
+     * same parallel layout. Since the expression objects only store
+     * references to the vectors, they should not outlive them.
+     *
+     * This class uses the curiously recurring template pattern: @p Derived
+     * is the class of the actual expression.
+     */
+    template <typename Derived>
+    class VectorExpression
+    {
+    public:
+      /**
+       * Return a reference to the actual expression.
+       */
+      const Derived &
+      derived() const
+      {
+        return static_cast<const Derived &>(*this);
+      }
+    };
+
+    /*@}*/
+
+
+
+    namespace internal
+    {
+      using size_type = types::global_dof_index;
+
+      /**
+       * The leaf of a vector expression: the locally owned entries of a
+       * vector.
+       */
+      template <typename Number>
+      class VectorEntries : public VectorExpression<VectorEntries<Number>>
+      {
+      public:
+        using value_type = Number;
+
+        VectorEntries(const Vector<Number, MemorySpace::Host> &vector)
+          : vector(vector)
+          , values(vector.begin())
+        {}
+
+        Number
+        value(const size_type i) const
+        {
+          return values[i];
+        }
+
+        VectorizedArray<Number>
+        vectorized_value(const size_type i) const
+        {
+          VectorizedArray<Number> x;
+          x.load(values + i);
+          return x;
+        }
+
+        /**
+         * Return a vector of the expression, which defines the parallel
+         * layout.
+         */
+        const Vector<Number, MemorySpace::Host> &
+        get_vector() const
+        {
+          return vector;
+        }
+
+      private:
+        const Vector<Number, MemorySpace::Host> &vector;
+        const Number *const                      values;
+      };
+
+
+
+      /**
+       * The product of a scalar and a vector expression.
+       */
+      template <typename Expression>
+      class ScaledExpression
+        : public VectorExpression<ScaledExpression<Expression>>
+      {
+      public:
+        using value_type = typename Expression::value_type;
+
+        ScaledExpression(const value_type factor, const Expression &expression)
+          : factor(factor)
+          , expression(expression)
+        {}
+
+        value_type
+        value(const size_type i) const
+        {
+          return factor * expression.value(i);
+        }
+
+        VectorizedArray<value_type>
+        vectorized_value(const size_type i) const
+        {
+          return factor * expression.vectorized_value(i);
+        }
+
+        const Vector<value_type, MemorySpace::Host> &
+        get_vector() const
+        {
+          return expression.get_vector();
+        }
+
+      private:
+        const value_type factor;
+        const Expression expression;
+      };
+
+
+
+      /**
+       * The sum of two vector expressions, or their difference if
+       * @p subtract is true.
+       */
+      template <typename Expression1, typename Expression2, bool subtract>
+      class SumExpression
+        : public VectorExpression<
+            SumExpression<Expression1, Expression2, subtract>>
+      {
+      public:
+        using value_type = typename Expression1::value_type;
+
+        static_assert(
+          std::is_same<value_type, typename Expression2::value_type>::value,
+          "All vectors of an expression must have the same number type.");
+
+        SumExpression(const Expression1 &expression1,
+                      const Expression2 &expression2)
+          : expression1(expression1)
+          , expression2(expression2)
+        {
+          AssertDimension(expression1.get_vector().local_size(),
+                          expression2.get_vector().local_size());
+        }
+
+        value_type
+        value(const size_type i) const
+        {
+          return subtract ? expression1.value(i) - expression2.value(i) :
+                            expression1.value(i) + expression2.value(i);
+        }
+
+        VectorizedArray<value_type>
+        vectorized_value(const size_type i) const
+        {
+          return subtract ? expression1.vectorized_value(i) -
+                              expression2.vectorized_value(i) :
+                            expression1.vectorized_value(i) +
+                              expression2.vectorized_value(i);
+        }
+
+        const Vector<value_type, MemorySpace::Host> &
+        get_vector() const
+        {
+          return expression1.get_vector();
+        }
+
+      private:
+        const Expression1 expression1;
+        const Expression2 expression2;
+      };
+
+
+
+      /**
+       * A traits class that translates the operands of the arithmetic
+       * operators into vector expressions: vectors are wrapped into
+       * VectorEntries, and expressions are taken as they are. For all other
+       * types, there is no member @p type, which removes the operators from
+       * overload resolution.
+       */
+      template <typename T, typename = void>
+      struct VectorExpressionOperand
+      {};
+
+      template <typename Number>
+      struct VectorExpressionOperand<Vector<Number, MemorySpace::Host>>
+      {
+        using type = VectorEntries<Number>;
+
+        static type
+        make(const Vector<Number, MemorySpace::Host> &vector)
+        {
+          return type(vector);
+        }
+      };
+
+      template <typename T>
+      struct VectorExpressionOperand<
+        T,
+        typename std::enable_if<
+          std::is_base_of<VectorExpression<T>, T>::value>::type>
+      {
+        using type = T;
+
+        static const T &
+        make(const T &expression)
+        {
+          return expression;
+        }
+      };
+
+
+
+      /**
+       * The loop that evaluates a vector expression into the array @p dst,
+       * either overwriting or adding to its entries, as called by the
+       * parallel_for() of the vector operations.
+       */
+      template <typename Expression, bool add>
+      struct VectorExpressionLoop
+      {
+        using Number = typename Expression::value_type;
+
+        VectorExpressionLoop(Number *const dst, const Expression &expression)
+          : dst(dst)
+          , expression(expression)
+        {}
+
+        void
+        operator()(const size_type begin, const size_type end) const
+        {
+          const unsigned int n_lanes = VectorizedArray<Number>::n_array_elements;
+          size_type          i       = begin;
+          if (n_lanes > 1)
+            for (; i + n_lanes <= end; i += n_lanes)
+              {
+                VectorizedArray<Number> result = expression.vectorized_value(i);
+                if (add)
+                  {
+                    VectorizedArray<Number> old_value;
+                    old_value.load(dst + i);
+                    result += old_value;
+                  }
+                result.store(dst + i);
+              }
+          for (; i < end; ++i)
+            dst[i] = add ? dst[i] + expression.value(i) : expression.value(i);
+        }
+
+        Number *const     dst;
+        const Expression &expression;
+      };
+
+
+
+      /**
+       * The functions evaluating vector expressions. This class is a friend
+       * of Vector in order to use the thread partitioner of the vectors.
+       */
+      struct VectorExpressionEvaluator
+      {
+        template <typename Number, typename Expression>
+        static void
+        evaluate(Vector<Number, MemorySpace::Host> &dst,
+                 const Expression &                 expression,
+                 const VectorOperation::values      operation)
+        {
+          static_assert(
+            std::is_same<Number, typename Expression::value_type>::value,
+            "The destination vector must have the same number type as the "
+            "vectors of the expression.");
+          AssertDimension(dst.local_size(),
+                          expression.get_vector().local_size());
+
+          if (operation == VectorOperation::add)
+            {
+              VectorExpressionLoop<Expression, true> loop(dst.begin(),
+                                                          expression);
+              dealii::internal::VectorOperations::parallel_for(
+                loop, 0, dst.local_size(), dst.thread_loop_partitioner);
+            }
+          else
+            {
+              VectorExpressionLoop<Expression, false> loop(dst.begin(),
+                                                           expression);
+              dealii::internal::VectorOperations::parallel_for(
+                loop, 0, dst.local_size(), dst.thread_loop_partitioner);
+            }
+
+          if (dst.vector_is_ghosted)
+            dst.update_ghost_values();
+        }
+
+        template <typename Expression1, typename Expression2>
+        static typename Expression1::value_type
+        inner_product(const Expression1 &expression1,
+                      const Expression2 &expression2)
+        {
+          using Number = typename Expression1::value_type;
+          static_assert(
+            std::is_same<Number, typename Expression2::value_type>::value,
+            "All vectors of an expression must have the same number type.");
+          const auto &vector = expression1.get_vector();
+          AssertDimension(vector.local_size(),
+                          expression2.get_vector().local_size());
+
+          Number sum = Number();
+          dealii::internal::VectorOperations::
+            VectorExpressionDot<Expression1, Expression2>
+              dot(expression1, expression2);
+          dealii::internal::VectorOperations::parallel_reduce(
+            dot, 0, vector.local_size(), sum, vector.thread_loop_partitioner);
+          AssertIsFinite(sum);
+
+          return Utilities::MPI::sum(sum, vector.get_mpi_communicator());
+        }
+
+        template <typename Expression>
+        static typename numbers::NumberTraits<
+          typename Expression::value_type>::real_type
+        l2_norm(const Expression &expression)
+        {
+          using real_type = typename numbers::NumberTraits<
+            typename Expression::value_type>::real_type;
+          const auto &vector = expression.get_vector();
+
+          real_type sum = real_type();
+          dealii::internal::VectorOperations::
+            VectorExpressionNorm2<Expression, real_type>
+              norm2(expression);
+          dealii::internal::VectorOperations::parallel_reduce(
+            norm2, 0, vector.local_size(), sum, vector.thread_loop_partitioner);
+          AssertIsFinite(sum);
+
+          return std::sqrt(
+            Utilities::MPI::sum(sum, vector.get_mpi_communicator()));
+        }
+      };
+    } // namespace internal
+
+
+
+    /**
+     * @name Operators building vector expressions
+     */
+    //@{
+
+    /**
+     * Sum of two vectors or vector expressions.
+     *
+     * @relatesalso VectorExpression
+     */
+    template <typename T1, typename T2>
+    inline internal::SumExpression<
+      typename internal::VectorExpressionOperand<T1>::type,
+      typename internal::VectorExpressionOperand<T2>::type,
+      false>
+    operator+(const T1 &a, const T2 &b)
+    {
+      return {internal::VectorExpressionOperand<T1>::make(a),
+              internal::VectorExpressionOperand<T2>::make(b)};
+    }
+
+    /**
+     * Difference of two vectors or vector expressions.
+     *
+     * @relatesalso VectorExpression
+     */
+    template <typename T1, typename T2>
+    inline internal::SumExpression<
+      typename internal::VectorExpressionOperand<T1>::type,
+      typename internal::VectorExpressionOperand<T2>::type,
+      true>
+    operator-(const T1 &a, const T2 &b)
+    {
+      return {internal::VectorExpressionOperand<T1>::make(a),
+              internal::VectorExpressionOperand<T2>::make(b)};
+    }
+
+    /**
+     * Product of a scalar and a vector or vector expression.
+     *
+     * @relatesalso VectorExpression
+     */
+    template <typename T>
+    inline internal::ScaledExpression<
+      typename internal::VectorExpressionOperand<T>::type>
+    operator*(const typename internal::VectorExpressionOperand<
+                T>::type::value_type factor,
+              const T &              a)
+    {
+      return {factor, internal::VectorExpressionOperand<T>::make(a)};
+    }
+
+    /**
+     * Product of a vector or vector expression and a scalar.
+     *
+     * @relatesalso VectorExpression
+     */
+    template <typename T>
+    inline internal::ScaledExpression<
+      typename internal::VectorExpressionOperand<T>::type>
+    operator*(const T &                    a,
+              const typename internal::VectorExpressionOperand<
+                T>::type::value_type factor)
+    {
+      return {factor, internal::VectorExpressionOperand<T>::make(a)};
+    }
+
+    /**
+     * Negation of a vector or vector expression.
+     *
+     * @relatesalso VectorExpression
+     */
+    template <typename T>
+    inline internal::ScaledExpression<
+      typename internal::VectorExpressionOperand<T>::type>
+    operator-(const T &a)
+    {
+      using value_type =
+        typename internal::VectorExpressionOperand<T>::type::value_type;
+      return {value_type(-1), internal::VectorExpressionOperand<T>::make(a)};
+    }
+
+    //@}
+
+
+
+    /**
+     * Return the inner product of two vectors or vector expressions,
+     * evaluated in one pass over the locally owned entries and reduced over
+     * all processes of the communicator of the vectors. As for the
+     * operator*() of Vector, the second argument is complex conjugated.
+     *
+     * @relatesalso VectorExpression
+     */
+    template <typename T1, typename T2>
+    inline typename internal::VectorExpressionOperand<T1>::type::value_type
+    inner_product(const T1 &a, const T2 &b)
+    {
+      return internal::VectorExpressionEvaluator::inner_product(
+        internal::VectorExpressionOperand<T1>::make(a),
+        internal::VectorExpressionOperand<T2>::make(b));
+    }
+
+    /**
+     * Return the $l_2$ norm of a vector expression, evaluated in one pass
+     * over the locally owned entries without storing the expression in a
+     * vector, e.g., <tt>l2_norm(x - y)</tt>.
+     *
+     * @relatesalso VectorExpression
+     */
+    template <typename Expression>
+    inline typename numbers::NumberTraits<
+      typename Expression::value_type>::real_type
+    l2_norm(const VectorExpression<Expression> &expression)
+    {
+      return internal::VectorExpressionEvaluator::l2_norm(expression.derived());
+    }
+
+
+
+    /*------------------- Member functions of Vector ------------------------*/
+
+#ifndef DOXYGEN
+
+    template <typename Number, typename MemorySpace>
+    template <typename Expression>
+    inline Vector<Number, MemorySpace> &
+    Vector<Number, MemorySpace>::
+    operator=(const VectorExpression<Expression> &expression)
+    {
+      internal::VectorExpressionEvaluator::evaluate(*this,
+                                                    expression.derived(),
+                                                    VectorOperation::insert);
+      return *this;
+    }
+
+
+
+    template <typename Number, typename MemorySpace>
+    template <typename Expression>
+    inline Vector<Number, MemorySpace> &
+    Vector<Number, MemorySpace>::
+    operator+=(const VectorExpression<Expression> &expression)
+    {
+      internal::VectorExpressionEvaluator::evaluate(*this,
+                                                    expression.derived(),
+                                                    VectorOperation::add);
+      return *this;
+    }
+
+
+
+    template <typename Number, typename MemorySpace>
+    template <typename Expression>
+    inline Vector<Number, MemorySpace> &
+    Vector<Number, MemorySpace>::
+    operator-=(const VectorExpression<Expression> &expression)
+    {
+      internal::VectorExpressionEvaluator::evaluate(
+        *this,
+        internal::ScaledExpression<Expression>(Number(-1),
+                                               expression.derived()),
+        VectorOperation::add);
+      return *this;
+    }
+
+#endif // DOXYGEN
+
+  } // namespace distributed
+} // namespace LinearAlgebra
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
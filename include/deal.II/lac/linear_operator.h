@@ -19,11 +19,14 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/std_cxx14/memory.h>
 
 #include <deal.II/lac/vector_memory.h>
 
 #include <array>
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <type_traits>
 
 DEAL_II_NAMESPACE_OPEN
@@ -35,7 +38,10 @@ namespace internal
   namespace LinearOperatorImplementation
   {
     class EmptyPayload;
-  }
+
+    template <typename VectorType>
+    class ScratchVector;
+  } // namespace LinearOperatorImplementation
 } // namespace internal
 
 template <typename Number>
@@ -215,6 +221,8 @@ public:
              ExcMessage("Uninitialized LinearOperator<Range, "
                         "Domain>::reinit_domain_vector method called"));
     };
+
+    prepare = []() {};
   }
 
   /**
@@ -300,6 +308,17 @@ public:
   std::function<void(Domain &v, bool omit_zeroing_entries)>
     reinit_domain_vector;
 
+  /**
+   * Set up the scratch vectors that compositions and inverses within this
+   * LinearOperator use for intermediate results. The scratch vectors are
+   * kept for the lifetime of the operator (and shared with its copies) and
+   * are otherwise set up on the first application, so calling this function
+   * is optional. Calling it once before the operator is applied repeatedly,
+   * e.g., within an outer iterative solver, moves the memory allocations of
+   * the operator itself out of the solver loop.
+   */
+  std::function<void()> prepare;
+
   /**
    * @name In-place vector space operations
    */
@@ -419,6 +438,11 @@ operator+(const LinearOperator<Range, Domain, Payload> &first_op,
         first_op.Tvmult_add(v, u);
       };
 
+      return_op.prepare = [first_op, second_op]() {
+        first_op.prepare();
+        second_op.prepare();
+      };
+
       return return_op;
     }
 }
@@ -449,7 +473,25 @@ operator-(const LinearOperator<Range, Domain, Payload> &first_op,
   else
     {
       // implement with addition and scalar multiplication
-      return first_op + (-1. * second_op);
+      LinearOperator<Range, Domain, Payload> return_op =
+        first_op + (-1. * second_op);
+
+      // for vmult and Tvmult, negate the result of second_op before adding
+      // first_op instead of scaling the vector back and forth in the
+      // vmult_add of (-1. * second_op)
+      return_op.vmult = [first_op, second_op](Range &v, const Domain &u) {
+        second_op.vmult(v, u);
+        v *= -1.;
+        first_op.vmult_add(v, u);
+      };
+
+      return_op.Tvmult = [first_op, second_op](Domain &v, const Range &u) {
+        second_op.Tvmult(v, u);
+        v *= -1.;
+        first_op.Tvmult_add(v, u);
+      };
+
+      return return_op;
     }
 }
 
@@ -595,40 +637,47 @@ operator*(const LinearOperator<Range, Intermediate, Payload> & first_op,
       // ensure to have valid computation objects by catching first_op and
       // second_op by value
 
-      return_op.vmult = [first_op, second_op](Range &v, const Domain &u) {
-        GrowingVectorMemory<Intermediate> vector_memory;
-
-        typename VectorMemory<Intermediate>::Pointer i(vector_memory);
-        second_op.reinit_range_vector(*i, /*bool omit_zeroing_entries =*/true);
-        second_op.vmult(*i, u);
-        first_op.vmult(v, *i);
-      };
-
-      return_op.vmult_add = [first_op, second_op](Range &v, const Domain &u) {
-        GrowingVectorMemory<Intermediate> vector_memory;
-
-        typename VectorMemory<Intermediate>::Pointer i(vector_memory);
-        second_op.reinit_range_vector(*i, /*bool omit_zeroing_entries =*/true);
-        second_op.vmult(*i, u);
-        first_op.vmult_add(v, *i);
-      };
+      // reuse one scratch vector for the intermediate result of all
+      // applications of the composition (and its copies)
+      const auto scratch = std::make_shared<
+        internal::LinearOperatorImplementation::ScratchVector<Intermediate>>();
+
+      return_op.vmult =
+        [first_op, second_op, scratch](Range &v, const Domain &u) {
+          typename internal::LinearOperatorImplementation::ScratchVector<
+            Intermediate>::Pointer i(*scratch, second_op.reinit_range_vector);
+          second_op.vmult(*i, u);
+          first_op.vmult(v, *i);
+        };
 
-      return_op.Tvmult = [first_op, second_op](Domain &v, const Range &u) {
-        GrowingVectorMemory<Intermediate> vector_memory;
+      return_op.vmult_add =
+        [first_op, second_op, scratch](Range &v, const Domain &u) {
+          typename internal::LinearOperatorImplementation::ScratchVector<
+            Intermediate>::Pointer i(*scratch, second_op.reinit_range_vector);
+          second_op.vmult(*i, u);
+          first_op.vmult_add(v, *i);
+        };
 
-        typename VectorMemory<Intermediate>::Pointer i(vector_memory);
-        first_op.reinit_domain_vector(*i, /*bool omit_zeroing_entries =*/true);
-        first_op.Tvmult(*i, u);
-        second_op.Tvmult(v, *i);
-      };
+      return_op.Tvmult =
+        [first_op, second_op, scratch](Domain &v, const Range &u) {
+          typename internal::LinearOperatorImplementation::ScratchVector<
+            Intermediate>::Pointer i(*scratch, first_op.reinit_domain_vector);
+          first_op.Tvmult(*i, u);
+          second_op.Tvmult(v, *i);
+        };
 
-      return_op.Tvmult_add = [first_op, second_op](Domain &v, const Range &u) {
-        GrowingVectorMemory<Intermediate> vector_memory;
+      return_op.Tvmult_add =
+        [first_op, second_op, scratch](Domain &v, const Range &u) {
+          typename internal::LinearOperatorImplementation::ScratchVector<
+            Intermediate>::Pointer i(*scratch, first_op.reinit_domain_vector);
+          first_op.Tvmult(*i, u);
+          second_op.Tvmult_add(v, *i);
+        };
 
-        typename VectorMemory<Intermediate>::Pointer i(vector_memory);
-        first_op.reinit_domain_vector(*i, /*bool omit_zeroing_entries =*/true);
-        first_op.Tvmult(*i, u);
-        second_op.Tvmult_add(v, *i);
+      return_op.prepare = [first_op, second_op, scratch]() {
+        first_op.prepare();
+        second_op.prepare();
+        scratch->prepare(second_op.reinit_range_vector);
       };
 
       return return_op;
@@ -659,6 +708,8 @@ transpose_operator(const LinearOperator<Range, Domain, Payload> &op)
   return_op.Tvmult     = op.vmult;
   return_op.Tvmult_add = op.vmult_add;
 
+  return_op.prepare = op.prepare;
+
   return return_op;
 }
 
@@ -699,34 +750,43 @@ inverse_operator(const LinearOperator<Range, Domain, Payload> &op,
   return_op.reinit_range_vector  = op.reinit_domain_vector;
   return_op.reinit_domain_vector = op.reinit_range_vector;
 
+  // reuse one scratch vector for the solution in vmult_add and Tvmult_add
+  const auto scratch = std::make_shared<
+    internal::LinearOperatorImplementation::ScratchVector<Range>>();
+
   return_op.vmult = [op, &solver, &preconditioner](Range &v, const Domain &u) {
     op.reinit_range_vector(v, /*bool omit_zeroing_entries =*/false);
     solver.solve(op, v, u, preconditioner);
   };
 
-  return_op.vmult_add = [op, &solver, &preconditioner](Range &       v,
-                                                       const Domain &u) {
-    GrowingVectorMemory<Range> vector_memory;
-
-    typename VectorMemory<Range>::Pointer v2(vector_memory);
-    op.reinit_range_vector(*v2, /*bool omit_zeroing_entries =*/false);
-    solver.solve(op, *v2, u, preconditioner);
-    v += *v2;
-  };
+  return_op.vmult_add =
+    [op, &solver, &preconditioner, scratch](Range &v, const Domain &u) {
+      typename internal::LinearOperatorImplementation::ScratchVector<
+        Range>::Pointer v2(*scratch,
+                           op.reinit_range_vector,
+                           /*bool omit_zeroing_entries =*/false);
+      solver.solve(op, *v2, u, preconditioner);
+      v += *v2;
+    };
 
   return_op.Tvmult = [op, &solver, &preconditioner](Range &v, const Domain &u) {
     op.reinit_range_vector(v, /*bool omit_zeroing_entries =*/false);
     solver.solve(transpose_operator(op), v, u, preconditioner);
   };
 
-  return_op.Tvmult_add = [op, &solver, &preconditioner](Range &       v,
-                                                        const Domain &u) {
-    GrowingVectorMemory<Range> vector_memory;
+  return_op.Tvmult_add =
+    [op, &solver, &preconditioner, scratch](Range &v, const Domain &u) {
+      typename internal::LinearOperatorImplementation::ScratchVector<
+        Range>::Pointer v2(*scratch,
+                           op.reinit_range_vector,
+                           /*bool omit_zeroing_entries =*/false);
+      solver.solve(transpose_operator(op), *v2, u, preconditioner);
+      v += *v2;
+    };
 
-    typename VectorMemory<Range>::Pointer v2(vector_memory);
-    op.reinit_range_vector(*v2, /*bool omit_zeroing_entries =*/false);
-    solver.solve(transpose_operator(op), *v2, u, preconditioner);
-    v += *v2;
+  return_op.prepare = [op, scratch]() {
+    op.prepare();
+    scratch->prepare(op.reinit_range_vector);
   };
 
   return return_op;
@@ -756,34 +816,44 @@ inverse_operator(const LinearOperator<Range, Domain, Payload> &op,
   return_op.reinit_range_vector  = op.reinit_domain_vector;
   return_op.reinit_domain_vector = op.reinit_range_vector;
 
+  // reuse one scratch vector for the solution in vmult_add and Tvmult_add
+  const auto scratch = std::make_shared<
+    internal::LinearOperatorImplementation::ScratchVector<Range>>();
+
   return_op.vmult = [op, &solver, preconditioner](Range &v, const Domain &u) {
     op.reinit_range_vector(v, /*bool omit_zeroing_entries =*/false);
     solver.solve(op, v, u, preconditioner);
   };
 
-  return_op.vmult_add = [op, &solver, preconditioner](Range &       v,
-                                                      const Domain &u) {
-    GrowingVectorMemory<Range> vector_memory;
-
-    typename VectorMemory<Range>::Pointer v2(vector_memory);
-    op.reinit_range_vector(*v2, /*bool omit_zeroing_entries =*/false);
-    solver.solve(op, *v2, u, preconditioner);
-    v += *v2;
-  };
+  return_op.vmult_add =
+    [op, &solver, preconditioner, scratch](Range &v, const Domain &u) {
+      typename internal::LinearOperatorImplementation::ScratchVector<
+        Range>::Pointer v2(*scratch,
+                           op.reinit_range_vector,
+                           /*bool omit_zeroing_entries =*/false);
+      solver.solve(op, *v2, u, preconditioner);
+      v += *v2;
+    };
 
   return_op.Tvmult = [op, &solver, preconditioner](Range &v, const Domain &u) {
     op.reinit_range_vector(v, /*bool omit_zeroing_entries =*/false);
     solver.solve(transpose_operator(op), v, u, preconditioner);
   };
 
-  return_op.Tvmult_add = [op, &solver, preconditioner](Range &       v,
-                                                       const Domain &u) {
-    GrowingVectorMemory<Range> vector_memory;
+  return_op.Tvmult_add =
+    [op, &solver, preconditioner, scratch](Range &v, const Domain &u) {
+      typename internal::LinearOperatorImplementation::ScratchVector<
+        Range>::Pointer v2(*scratch,
+                           op.reinit_range_vector,
+                           /*bool omit_zeroing_entries =*/false);
+      solver.solve(transpose_operator(op), *v2, u, preconditioner);
+      v += *v2;
+    };
 
-    typename VectorMemory<Range>::Pointer v2(vector_memory);
-    op.reinit_range_vector(*v2, /*bool omit_zeroing_entries =*/false);
-    solver.solve(transpose_operator(op), *v2, u, preconditioner);
-    v += *v2;
+  return_op.prepare = [op, preconditioner, scratch]() {
+    op.prepare();
+    preconditioner.prepare();
+    scratch->prepare(op.reinit_range_vector);
   };
 
   return return_op;
@@ -1169,6 +1239,113 @@ namespace internal
     };
 
 
+    /**
+     * A scratch vector for the intermediate results of a composite
+     * LinearOperator. The scratch vector is shared by the operator and all of
+     * its copies and is reused for every application of the operator.
+     *
+     * Taking the intermediate vectors from a GrowingVectorMemory pool
+     * instead locks a global mutex on every application. Moreover, the pool
+     * is shared among all operators with the same vector type, so that the
+     * pooled vectors are resized back and forth when operators with
+     * different vector layouts are applied alternately, as happens for the
+     * nested products in a Schur complement. The pool is therefore only used
+     * as a fallback if the scratch vector is already in use, i.e., if the
+     * operator is applied recursively or from several threads concurrently.
+     */
+    template <typename VectorType>
+    class ScratchVector
+    {
+    public:
+      /**
+       * A handle to the scratch vector, or to a vector from a
+       * GrowingVectorMemory pool if the scratch vector is in use. The vector
+       * is initialized upon construction and the scratch vector is released
+       * upon destruction.
+       */
+      class Pointer
+      {
+      public:
+        Pointer(ScratchVector<VectorType> &scratch,
+                const std::function<void(VectorType &, bool)> &reinit_vector,
+                const bool omit_zeroing_entries = true)
+          : scratch(scratch.in_use.exchange(true) ? nullptr : &scratch)
+        {
+          if (this->scratch != nullptr)
+            vector = &scratch.vector;
+          else
+            {
+              pool =
+                std_cxx14::make_unique<GrowingVectorMemory<VectorType>>();
+              pool_vector = std_cxx14::make_unique<
+                typename VectorMemory<VectorType>::Pointer>(*pool);
+              vector = pool_vector->get();
+            }
+
+          // the layout of the vector is set again on every use since the
+          // underlying operators may have been reinitialized in the meantime.
+          // For an unchanged layout, this does not allocate memory.
+          reinit_vector(*vector, omit_zeroing_entries);
+        }
+
+        Pointer(const Pointer &) = delete;
+
+        Pointer &
+        operator=(const Pointer &) = delete;
+
+        ~Pointer()
+        {
+          if (scratch != nullptr)
+            scratch->in_use = false;
+        }
+
+        VectorType &operator*() const
+        {
+          return *vector;
+        }
+
+        VectorType *operator->() const
+        {
+          return vector;
+        }
+
+      private:
+        ScratchVector<VectorType> *scratch;
+
+        std::unique_ptr<GrowingVectorMemory<VectorType>> pool;
+
+        std::unique_ptr<typename VectorMemory<VectorType>::Pointer>
+          pool_vector;
+
+        VectorType *vector;
+      };
+
+      ScratchVector()
+        : in_use(false)
+      {}
+
+      /**
+       * Initialize the scratch vector with @p reinit_vector unless it is in
+       * use, such that subsequent applications of the operator do not
+       * allocate memory.
+       */
+      void
+      prepare(const std::function<void(VectorType &, bool)> &reinit_vector)
+      {
+        if (in_use.exchange(true) == false)
+          {
+            reinit_vector(vector, /*bool omit_zeroing_entries =*/true);
+            in_use = false;
+          }
+      }
+
+    private:
+      VectorType vector;
+
+      std::atomic<bool> in_use;
+    };
+
+
     // A helper function to apply a given vmult, or Tvmult to a vector with
     // intermediate storage
     template <typename Function, typename Range, typename Domain>
@@ -948,6 +948,27 @@ private:
  * AdditionalData::eig_cg_n_iterations to zero, and provide the variable
  * AdditionalData::max_eigenvalue instead. The minimal eigenvalue is
  * implicitly specified via `max_eigenvalue/smoothing_range`.
+ *
+ * This also allows to reuse the estimate of an earlier setup, e.g. when the
+ * preconditioner is re-initialized on a slightly changed mesh in a
+ * time-dependent simulation, where the spectrum of the diagonally
+ * preconditioned matrix barely changes. The bounds used by the
+ * preconditioner are returned by estimate_eigenvalues(), which is also
+ * called by the first vmult(), and can be queried with
+ * get_eigenvalue_information() afterwards.
+ *
+ * <h4>Power iteration</h4>
+ *
+ * By default, the eigenvalues are estimated by the Lanczos process
+ * underlying the CG method, which needs two global reductions per
+ * iteration. If AdditionalData::eigenvalue_algorithm is set to
+ * AdditionalData::EigenvalueAlgorithm::power_iteration, a power iteration
+ * with AdditionalData::eig_cg_n_iterations steps is used instead, which
+ * only computes one norm, i.e., a single global reduction, per step. It
+ * only gives an estimate of the largest eigenvalue, so it needs a
+ * smoothing range larger than one. The power iteration converges more slowly
+ * than the Lanczos process, but a rough estimate of the largest eigenvalue
+ * is all the Chebyshev smoother needs.
 
  * <h4>Using the PreconditionChebyshev as a solver</h4>
  *
@@ -1019,14 +1040,33 @@ public:
    */
   struct AdditionalData
   {
+    /**
+     * The algorithms to estimate the eigenvalues.
+     */
+    enum class EigenvalueAlgorithm
+    {
+      /**
+       * The Lanczos process of a CG iteration, which estimates both the
+       * smallest and the largest eigenvalue.
+       */
+      lanczos,
+      /**
+       * A power iteration, which only estimates the largest eigenvalue but
+       * needs a single global reduction per step.
+       */
+      power_iteration
+    };
+
     /**
      * Constructor.
      */
-    AdditionalData(const unsigned int degree              = 1,
-                   const double       smoothing_range     = 0.,
-                   const unsigned int eig_cg_n_iterations = 8,
-                   const double       eig_cg_residual     = 1e-2,
-                   const double       max_eigenvalue      = 1);
+    AdditionalData(const unsigned int        degree              = 1,
+                   const double              smoothing_range     = 0.,
+                   const unsigned int        eig_cg_n_iterations = 8,
+                   const double              eig_cg_residual     = 1e-2,
+                   const double              max_eigenvalue      = 1,
+                   const EigenvalueAlgorithm eigenvalue_algorithm =
+                     EigenvalueAlgorithm::lanczos);
 
     /**
      * This determines the degree of the Chebyshev polynomial. The degree of
@@ -1056,8 +1096,9 @@ public:
 
     /**
      * Maximum number of CG iterations performed for finding the maximum
-     * eigenvalue. If set to zero, no computations are performed. Instead, the
-     * user must supply a largest eigenvalue via the variable
+     * eigenvalue, or the number of steps of the power iteration. If set to
+     * zero, no computations are performed. Instead, the user must supply a
+     * largest eigenvalue via the variable
      * PreconditionChebyshev::AdditionalData::max_eigenvalue.
      */
     unsigned int eig_cg_n_iterations;
@@ -1071,10 +1112,16 @@ public:
     /**
      * Maximum eigenvalue to work with. Only in effect if @p
      * eig_cg_n_iterations is set to zero, otherwise this parameter is
-     * ignored.
+     * ignored. To reuse the estimate of an earlier setup, set this variable
+     * to EigenvalueInformation::max_eigenvalue_estimate of that setup.
      */
     double max_eigenvalue;
 
+    /**
+     * The algorithm used to estimate the eigenvalues.
+     */
+    EigenvalueAlgorithm eigenvalue_algorithm;
+
     /**
      * Stores the preconditioner object that the Chebyshev is wrapped around.
      */
@@ -1082,6 +1129,43 @@ public:
   };
 
 
+  /**
+   * The result of the eigenvalue estimate, i.e., the bounds of the
+   * eigenvalue range the Chebyshev polynomial is built for.
+   */
+  struct EigenvalueInformation
+  {
+    /**
+     * Constructor, initializing the bounds to invalid values.
+     */
+    EigenvalueInformation();
+
+    /**
+     * The estimate of the smallest eigenvalue, or the lower end of the
+     * interval given by the smoothing range.
+     */
+    double min_eigenvalue_estimate;
+
+    /**
+     * The estimate of the largest eigenvalue, including the safety factor
+     * applied to computed estimates. This is the value to pass as
+     * AdditionalData::max_eigenvalue to reuse the estimate.
+     */
+    double max_eigenvalue_estimate;
+
+    /**
+     * The number of iterations spent on the estimate.
+     */
+    unsigned int cg_iterations;
+
+    /**
+     * The degree of the Chebyshev polynomial, which is computed together
+     * with the estimate if AdditionalData::degree is
+     * numbers::invalid_unsigned_int.
+     */
+    unsigned int degree;
+  };
+
   PreconditionChebyshev();
 
   /**
@@ -1145,6 +1229,31 @@ public:
   size_type
   n() const;
 
+  /**
+   * Estimate the eigenvalues of the preconditioned matrix with the algorithm
+   * selected in AdditionalData, using @p src for the layout of the temporary
+   * vectors, and set up the Chebyshev polynomial. If
+   * AdditionalData::eig_cg_n_iterations is zero, the bounds given in
+   * AdditionalData are used instead. This function is called by the first
+   * vmult(), Tvmult(), step() or Tstep() after initialize(), but it can also
+   * be called explicitly before. If the eigenvalues have already been
+   * estimated since the last call to initialize(), the previous result is
+   * returned.
+   *
+   * This function must not be called concurrently with vmult() and the
+   * other functions applying the preconditioner.
+   */
+  EigenvalueInformation
+  estimate_eigenvalues(const VectorType &src) const;
+
+  /**
+   * Return the result of the last eigenvalue estimate, without computing
+   * one. The information is only valid if the eigenvalues have been
+   * estimated since the last call to initialize().
+   */
+  const EigenvalueInformation &
+  get_eigenvalue_information() const;
+
 private:
   /**
    * A pointer to the underlying matrix.
@@ -1193,19 +1302,15 @@ private:
   bool eigenvalues_are_initialized;
 
   /**
-   * A mutex to avoid that multiple vmult() invocations by different threads
-   * overwrite the temporary vectors.
+   * The result of the last eigenvalue estimate.
    */
-  mutable Threads::Mutex mutex;
+  EigenvalueInformation eigenvalue_information;
 
   /**
-   * Initializes the factors theta and delta based on an eigenvalue
-   * computation. If the user set provided values for the largest eigenvalue
-   * in AdditionalData, no computation is performed and the information given
-   * by the user is used.
+   * A mutex to avoid that multiple vmult() invocations by different threads
+   * overwrite the temporary vectors.
    */
-  void
-  estimate_eigenvalues(const VectorType &src) const;
+  mutable Threads::Mutex mutex;
 };
 
 
@@ -2086,16 +2191,30 @@ namespace internal
 
 template <typename MatrixType, class VectorType, typename PreconditionerType>
 inline PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
-  AdditionalData::AdditionalData(const unsigned int degree,
-                                 const double       smoothing_range,
-                                 const unsigned int eig_cg_n_iterations,
-                                 const double       eig_cg_residual,
-                                 const double       max_eigenvalue)
+  AdditionalData::AdditionalData(
+    const unsigned int        degree,
+    const double              smoothing_range,
+    const unsigned int        eig_cg_n_iterations,
+    const double              eig_cg_residual,
+    const double              max_eigenvalue,
+    const EigenvalueAlgorithm eigenvalue_algorithm)
   : degree(degree)
   , smoothing_range(smoothing_range)
   , eig_cg_n_iterations(eig_cg_n_iterations)
   , eig_cg_residual(eig_cg_residual)
   , max_eigenvalue(max_eigenvalue)
+  , eigenvalue_algorithm(eigenvalue_algorithm)
+{}
+
+
+
+template <typename MatrixType, typename VectorType, typename PreconditionerType>
+inline PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
+  EigenvalueInformation::EigenvalueInformation()
+  : min_eigenvalue_estimate(std::numeric_limits<double>::max())
+  , max_eigenvalue_estimate(std::numeric_limits<double>::lowest())
+  , cg_iterations(0)
+  , degree(0)
 {}
 
 
@@ -2127,6 +2246,7 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::initialize(
   internal::PreconditionChebyshevImplementation::initialize_preconditioner(
     matrix, data.preconditioner);
   eigenvalues_are_initialized = false;
+  eigenvalue_information      = EigenvalueInformation();
 }
 
 
@@ -2136,6 +2256,7 @@ inline void
 PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::clear()
 {
   eigenvalues_are_initialized = false;
+  eigenvalue_information      = EigenvalueInformation();
   theta = delta = 1.0;
   matrix_ptr    = nullptr;
   {
@@ -2150,21 +2271,27 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::clear()
 
 
 template <typename MatrixType, typename VectorType, typename PreconditionerType>
-inline void
+inline typename PreconditionChebyshev<MatrixType,
+                                      VectorType,
+                                      PreconditionerType>::EigenvalueInformation
 PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
   estimate_eigenvalues(const VectorType &src) const
 {
-  Assert(eigenvalues_are_initialized == false, ExcInternalError());
+  if (eigenvalues_are_initialized)
+    return eigenvalue_information;
   Assert(data.preconditioner.get() != nullptr, ExcNotInitialized());
 
   solution_old.reinit(src);
   temp_vector1.reinit(src, true);
 
+  EigenvalueInformation info;
+
   // calculate largest eigenvalue using a hand-tuned CG iteration on the
   // matrix weighted by its diagonal. we start with a vector that consists of
   // ones only, weighted by the length.
   double max_eigenvalue, min_eigenvalue;
-  if (data.eig_cg_n_iterations > 0)
+  if (data.eig_cg_n_iterations > 0 &&
+      data.eigenvalue_algorithm == AdditionalData::EigenvalueAlgorithm::lanczos)
     {
       Assert(data.eig_cg_n_iterations > 2,
              ExcMessage(
@@ -2201,6 +2328,7 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
         }
       catch (SolverControl::NoConvergence &)
         {}
+      info.cg_iterations = control.last_step();
 
       // read the eigenvalues from the attached eigenvalue tracker
       if (eigenvalue_tracker.values.empty())
@@ -2214,6 +2342,38 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
           max_eigenvalue = 1.2 * eigenvalue_tracker.values.back();
         }
     }
+  else if (data.eig_cg_n_iterations > 0)
+    {
+      Assert(data.smoothing_range > 1.,
+             ExcMessage("The power iteration only estimates the largest "
+                        "eigenvalue, so the smallest one must be given by a "
+                        "smoothing range larger than one."));
+
+      // power iteration on the preconditioned matrix, starting from the same
+      // high-frequency vector as the CG variant. the iterate is kept at unit
+      // length, so the norm of the next iterate, the only global reduction
+      // of a step, is the estimate of the largest eigenvalue
+      internal::PreconditionChebyshevImplementation::set_initial_guess(
+        temp_vector1);
+      temp_vector1 /= temp_vector1.l2_norm();
+      double eigenvalue_estimate = 1.;
+      for (unsigned int i = 0; i < data.eig_cg_n_iterations; ++i)
+        {
+          matrix_ptr->vmult(solution_old, temp_vector1);
+          data.preconditioner->vmult(temp_vector1, solution_old);
+          const double norm = temp_vector1.l2_norm();
+          ++info.cg_iterations;
+          if (norm == 0.)
+            break;
+          eigenvalue_estimate = norm;
+          temp_vector1 /= norm;
+        }
+
+      // include a safety factor since the power iteration converges to the
+      // largest eigenvalue from below
+      max_eigenvalue = 1.2 * eigenvalue_estimate;
+      min_eigenvalue = max_eigenvalue / data.smoothing_range;
+    }
   else
     {
       max_eigenvalue = data.max_eigenvalue;
@@ -2272,9 +2432,30 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
       temp_vector2.reinit(empty_vector);
     }
 
+  info.min_eigenvalue_estimate = min_eigenvalue;
+  info.max_eigenvalue_estimate = max_eigenvalue;
+  info.degree                  = data.degree;
+  const_cast<
+    PreconditionChebyshev<MatrixType, VectorType, PreconditionerType> *>(this)
+    ->eigenvalue_information = info;
   const_cast<
     PreconditionChebyshev<MatrixType, VectorType, PreconditionerType> *>(this)
     ->eigenvalues_are_initialized = true;
+
+  return info;
+}
+
+
+
+template <typename MatrixType, typename VectorType, typename PreconditionerType>
+inline const typename PreconditionChebyshev<MatrixType,
+                                            VectorType,
+                                            PreconditionerType>::
+  EigenvalueInformation &
+  PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
+    get_eigenvalue_information() const
+{
+  return eigenvalue_information;
 }
 
 
@@ -0,0 +1,447 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_precondition_block_triangular_h
+#define dealii_precondition_block_triangular_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/table.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+/*! @addtogroup Preconditioners
+ *@{
+ */
+
+/**
+ * A block-triangular preconditioner for block systems, most prominently the
+ * saddle point systems of Stokes-type problems. For a system with $n$ blocks,
+ * this class applies the inverse of the upper triangular block matrix
+ * @f[
+ *   P = \begin{pmatrix} D_0 & A_{01} & \cdots & A_{0,n-1} \\
+ *                       0   & D_1    & \cdots & A_{1,n-1} \\
+ *                       \vdots &     & \ddots & \vdots \\
+ *                       0   & \cdots & 0      & D_{n-1} \end{pmatrix}
+ * @f]
+ * (or of the corresponding lower triangular matrix) by block back
+ * substitution, where the inverses of the diagonal blocks $D_i$ are
+ * replaced by approximations. For the Stokes system, the typical choice is
+ * $D_0=A$, $A_{01}=B^T$, and $D_1=-S$ with an approximation of the Schur
+ * complement $S$ such as the pressure mass matrix.
+ *
+ * The same can be expressed with block_back_substitution() and
+ * BlockLinearOperator. This class differs in how the inner operations are
+ * set up and carried out, with the aim of making the preconditioner cheap
+ * to apply many times and to reuse across the nonlinear iterations of a
+ * solver:
+ * <ul>
+ * <li> The residual of each block row is formed in a block vector that is
+ * allocated on the first call to vmult() and kept afterwards, so repeated
+ * applications do not allocate any memory.
+ * <li> The approximate inverse of a diagonal block can either be a single
+ * application of a preconditioner, see set_diagonal_preconditioner(), or an
+ * inexact inner solve with a Krylov solver, see set_diagonal_solver(). For
+ * inexact solves, the solver should be controlled by a relative tolerance or
+ * an iteration limit that does not throw, such as ReductionControl or
+ * IterationNumberControl.
+ * <li> If AdditionalData::warm_start is set, each inner solve starts from the
+ * solution of the same block computed in the previous call to vmult() rather
+ * than from zero. This is useful when the preconditioner is applied to
+ * similar vectors in a row, e.g. in consecutive Newton steps.
+ * <li> All matrices, solvers, and preconditioners are stored by reference.
+ * If the blocks change over a nonlinear iteration, it suffices to update
+ * these objects, e.g. with TrilinosWrappers::PreconditionAMG::reinit() that
+ * can keep the aggregation hierarchy of the previous setup, and the
+ * preconditioner picks up the new state without being set up again. The
+ * objects must remain alive as long as this class is used.
+ * </ul>
+ *
+ * Note that inexact inner solves and warm starts make the preconditioner a
+ * nonlinear operator that changes from one application to the next, so the
+ * outer solver must be a flexible method such as SolverFGMRES.
+ *
+ * A typical setup for the Stokes system reads:
+ * @code
+ * PreconditionBlockTriangular<BlockVector<double>> preconditioner;
+ * preconditioner.initialize(2);
+ * preconditioner.set_diagonal_solver(0, solver_A, system_matrix.block(0, 0),
+ *                                    amg_A);
+ * preconditioner.set_diagonal_preconditioner(1, mass_preconditioner, -1.);
+ * preconditioner.set_off_diagonal_block(0, 1, system_matrix.block(0, 1));
+ *
+ * SolverFGMRES<BlockVector<double>> solver(solver_control);
+ * solver.solve(system_matrix, solution, system_rhs, preconditioner);
+ * @endcode
+ *
+ * @tparam BlockVectorType The block vector type the preconditioner acts on,
+ * e.g. BlockVector or LinearAlgebra::distributed::BlockVector. The inner
+ * operations act on its <tt>BlockType</tt>.
+ */
+template <typename BlockVectorType>
+class PreconditionBlockTriangular : public Subscriptor
+{
+public:
+  /**
+   * The type of the individual blocks of the vector.
+   */
+  using VectorType = typename BlockVectorType::BlockType;
+
+  /**
+   * Parameters for the preconditioner.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(const bool upper_triangular = true,
+                   const bool warm_start       = false);
+
+    /**
+     * Whether the preconditioner is upper triangular, i.e., the blocks are
+     * solved for from the last to the first, or lower triangular.
+     */
+    bool upper_triangular;
+
+    /**
+     * Whether the inner solves set up with set_diagonal_solver() start from
+     * the result of the previous call to vmult().
+     */
+    bool warm_start;
+  };
+
+  /**
+   * Constructor. The preconditioner needs to be set up with initialize()
+   * before use.
+   */
+  PreconditionBlockTriangular();
+
+  /**
+   * Set up the preconditioner for @p n_blocks blocks. All diagonal and
+   * off-diagonal entries are empty afterwards.
+   */
+  void
+  initialize(const unsigned int    n_blocks,
+             const AdditionalData &additional_data = AdditionalData());
+
+  /**
+   * Approximate the inverse of the diagonal block @p block by a single
+   * application of @p preconditioner, whose result is multiplied by
+   * @p factor.
+   */
+  template <typename PreconditionerType>
+  void
+  set_diagonal_preconditioner(const unsigned int        block,
+                              const PreconditionerType &preconditioner,
+                              const double              factor = 1.);
+
+  /**
+   * Approximate the inverse of the diagonal block @p block by an inner
+   * solve of @p matrix with @p solver, preconditioned by @p preconditioner,
+   * with the result multiplied by @p factor. The accuracy of the inner solve
+   * is determined by the SolverControl object of @p solver.
+   */
+  template <typename SolverType, typename MatrixType, typename PreconditionerType>
+  void
+  set_diagonal_solver(const unsigned int        block,
+                      SolverType &              solver,
+                      const MatrixType &        matrix,
+                      const PreconditionerType &preconditioner,
+                      const double              factor = 1.);
+
+  /**
+   * Set the off-diagonal block in position (@p row, @p column) to
+   * @p matrix. For an upper triangular preconditioner, @p column must be
+   * larger than @p row, and smaller otherwise.
+   */
+  template <typename MatrixType>
+  void
+  set_off_diagonal_block(const unsigned int row,
+                         const unsigned int column,
+                         const MatrixType & matrix);
+
+  /**
+   * Apply the preconditioner, i.e., solve the block-triangular system with
+   * right hand side @p src for @p dst.
+   */
+  void
+  vmult(BlockVectorType &dst, const BlockVectorType &src) const;
+
+  /**
+   * Discard the solutions kept for warm starts, such that the next inner
+   * solves start from zero again.
+   */
+  void
+  clear_warm_start();
+
+  /**
+   * Exception.
+   */
+  DeclException1(ExcDiagonalBlockNotSet,
+                 unsigned int,
+                 << "The approximate inverse of the diagonal block " << arg1
+                 << " has not been set.");
+
+private:
+  /**
+   * The approximate inverses of the diagonal blocks. The first argument is
+   * the result, which on entry holds the initial guess for inner solves.
+   */
+  std::vector<std::function<void(VectorType &, const VectorType &)>>
+    diagonal_inverses;
+
+  /**
+   * The factors the results of the diagonal inverses are multiplied with.
+   */
+  std::vector<double> diagonal_factors;
+
+  /**
+   * Whether the approximate inverse of a diagonal block is an inner solve
+   * that uses an initial guess.
+   */
+  std::vector<bool> uses_initial_guess;
+
+  /**
+   * Functions adding the products of the off-diagonal blocks with a vector
+   * to their first argument. Empty entries denote zero blocks.
+   */
+  Table<2, std::function<void(VectorType &, const VectorType &)>>
+    off_diagonal_vmult_add;
+
+  /**
+   * The parameters of the preconditioner.
+   */
+  AdditionalData additional_data;
+
+  /**
+   * The right hand sides of the block rows, kept between calls to vmult().
+   */
+  mutable BlockVectorType residual;
+
+  /**
+   * The results of the previous call to vmult() for warm starts.
+   */
+  mutable BlockVectorType previous_solution;
+
+  /**
+   * Whether @p previous_solution holds a valid initial guess.
+   */
+  mutable bool previous_solution_valid;
+};
+
+/*@}*/
+
+/* ---------------------------- inline functions --------------------------- */
+
+#ifndef DOXYGEN
+
+template <typename BlockVectorType>
+inline PreconditionBlockTriangular<BlockVectorType>::AdditionalData::
+  AdditionalData(const bool upper_triangular, const bool warm_start)
+  : upper_triangular(upper_triangular)
+  , warm_start(warm_start)
+{}
+
+
+
+template <typename BlockVectorType>
+inline PreconditionBlockTriangular<BlockVectorType>::
+  PreconditionBlockTriangular()
+  : previous_solution_valid(false)
+{}
+
+
+
+template <typename BlockVectorType>
+inline void
+PreconditionBlockTriangular<BlockVectorType>::initialize(
+  const unsigned int    n_blocks,
+  const AdditionalData &additional_data)
+{
+  this->additional_data = additional_data;
+  diagonal_inverses.clear();
+  diagonal_inverses.resize(n_blocks);
+  diagonal_factors.clear();
+  diagonal_factors.resize(n_blocks, 1.);
+  uses_initial_guess.clear();
+  uses_initial_guess.resize(n_blocks, false);
+  off_diagonal_vmult_add.reinit(n_blocks, n_blocks);
+  previous_solution_valid = false;
+}
+
+
+
+template <typename BlockVectorType>
+template <typename PreconditionerType>
+inline void
+PreconditionBlockTriangular<BlockVectorType>::set_diagonal_preconditioner(
+  const unsigned int        block,
+  const PreconditionerType &preconditioner,
+  const double              factor)
+{
+  AssertIndexRange(block, diagonal_inverses.size());
+  const PreconditionerType *preconditioner_ptr = &preconditioner;
+  diagonal_inverses[block] = [preconditioner_ptr](VectorType &      dst,
+                                                  const VectorType &src) {
+    preconditioner_ptr->vmult(dst, src);
+  };
+  diagonal_factors[block]   = factor;
+  uses_initial_guess[block] = false;
+}
+
+
+
+template <typename BlockVectorType>
+template <typename SolverType, typename MatrixType, typename PreconditionerType>
+inline void
+PreconditionBlockTriangular<BlockVectorType>::set_diagonal_solver(
+  const unsigned int        block,
+  SolverType &              solver,
+  const MatrixType &        matrix,
+  const PreconditionerType &preconditioner,
+  const double              factor)
+{
+  AssertIndexRange(block, diagonal_inverses.size());
+  SolverType *              solver_ptr         = &solver;
+  const MatrixType *        matrix_ptr         = &matrix;
+  const PreconditionerType *preconditioner_ptr = &preconditioner;
+  diagonal_inverses[block] =
+    [solver_ptr, matrix_ptr, preconditioner_ptr](VectorType &      dst,
+                                                 const VectorType &src) {
+      solver_ptr->solve(*matrix_ptr, dst, src, *preconditioner_ptr);
+    };
+  diagonal_factors[block]   = factor;
+  uses_initial_guess[block] = true;
+}
+
+
+
+template <typename BlockVectorType>
+template <typename MatrixType>
+inline void
+PreconditionBlockTriangular<BlockVectorType>::set_off_diagonal_block(
+  const unsigned int row,
+  const unsigned int column,
+  const MatrixType & matrix)
+{
+  AssertIndexRange(row, off_diagonal_vmult_add.n_rows());
+  AssertIndexRange(column, off_diagonal_vmult_add.n_cols());
+  Assert(additional_data.upper_triangular ? column > row : column < row,
+         ExcMessage("The block (" + std::to_string(row) + "," +
+                    std::to_string(column) +
+                    ") is not in the strict triangle of the preconditioner."));
+  const MatrixType *matrix_ptr = &matrix;
+  off_diagonal_vmult_add(row, column) = [matrix_ptr](VectorType &      dst,
+                                                     const VectorType &src) {
+    matrix_ptr->vmult_add(dst, src);
+  };
+}
+
+
+
+template <typename BlockVectorType>
+inline void
+PreconditionBlockTriangular<BlockVectorType>::vmult(
+  BlockVectorType &      dst,
+  const BlockVectorType &src) const
+{
+  const unsigned int n_blocks = diagonal_inverses.size();
+  AssertDimension(src.n_blocks(), n_blocks);
+  AssertDimension(dst.n_blocks(), n_blocks);
+
+  // only allocate the temporary vectors if the layout has changed
+  if (residual.n_blocks() != n_blocks || residual.size() != src.size())
+    residual.reinit(src, true);
+  if (additional_data.warm_start &&
+      (previous_solution.n_blocks() != n_blocks ||
+       previous_solution.size() != src.size()))
+    {
+      previous_solution.reinit(src);
+      previous_solution_valid = false;
+    }
+
+  for (unsigned int b = 0; b < n_blocks; ++b)
+    {
+      const unsigned int i =
+        additional_data.upper_triangular ? n_blocks - 1 - b : b;
+      Assert(diagonal_inverses[i], ExcDiagonalBlockNotSet(i));
+
+      // form the right hand side of this block row from the blocks already
+      // computed, negating twice to be able to use vmult_add() of the
+      // off-diagonal blocks
+      bool has_coupling = false;
+      for (unsigned int c = 0; c < b; ++c)
+        {
+          const unsigned int j =
+            additional_data.upper_triangular ? n_blocks - 1 - c : c;
+          if (off_diagonal_vmult_add(i, j))
+            {
+              if (has_coupling == false)
+                residual.block(i).equ(-1., src.block(i));
+              off_diagonal_vmult_add(i, j)(residual.block(i), dst.block(j));
+              has_coupling = true;
+            }
+        }
+      if (has_coupling)
+        residual.block(i) *= -1.;
+      const VectorType &block_rhs =
+        has_coupling ? residual.block(i) : src.block(i);
+
+      // the initial guess is given in the scaling of the inner operation,
+      // whereas the stored previous solution includes the factor
+      if (uses_initial_guess[i])
+        {
+          if (additional_data.warm_start && previous_solution_valid)
+            dst.block(i).equ(1. / diagonal_factors[i],
+                             previous_solution.block(i));
+          else
+            dst.block(i) = 0.;
+        }
+
+      diagonal_inverses[i](dst.block(i), block_rhs);
+      if (diagonal_factors[i] != 1.)
+        dst.block(i) *= diagonal_factors[i];
+    }
+
+  if (additional_data.warm_start)
+    {
+      previous_solution       = dst;
+      previous_solution_valid = true;
+    }
+}
+
+
+
+template <typename BlockVectorType>
+inline void
+PreconditionBlockTriangular<BlockVectorType>::clear_warm_start()
+{
+  previous_solution_valid = false;
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
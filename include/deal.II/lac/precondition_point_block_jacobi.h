@@ -0,0 +1,281 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_precondition_point_block_jacobi_h
+#define dealii_precondition_point_block_jacobi_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/exceptions.h>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+/*! @addtogroup Preconditioners
+ *@{
+ */
+
+/**
+ * A block-diagonal preconditioner with small dense blocks of fixed size on
+ * the diagonal, typically one block for all the components of a vector-valued
+ * problem at a support point ("point blocks"). In contrast to
+ * PreconditionBlockJacobi, this class does not store a reference to the
+ * matrix, only acts on the rows owned by the current process, and can
+ * therefore be applied to both Vector and LinearAlgebra::distributed::Vector
+ * objects without any communication. This makes it a scalable
+ * preconditioner for matrix-based parts of a code that does not want to rely
+ * on PETSc or Trilinos.
+ *
+ * Two variants of the blocks are available, selected by
+ * AdditionalData::type:
+ * <ul>
+ * <li> Type::block_jacobi: The blocks are the inverses of the diagonal blocks
+ * $A_{kk}$ of the matrix, computed by LAPACKFullMatrix::invert().
+ * <li> Type::spai0: The blocks $M_k$ minimize the Frobenius norm
+ * $\|I-MA\|_F$ among all block-diagonal matrices $M$, the block version of
+ * the sparse approximate inverse with diagonal sparsity pattern, often
+ * called SPAI(0). This amounts to $M_k = A_{kk}^T (A_{k,:}A_{k,:}^T)^{-1}$,
+ * where $A_{k,:}$ denotes the rows of the matrix belonging to the $k$th
+ * block. Since only these rows enter, the blocks can be computed from the
+ * locally owned rows alone. SPAI(0) is also well-defined if the diagonal
+ * blocks are singular or badly conditioned, and it is more robust than Jacobi
+ * for matrices that are not diagonally dominant.
+ * </ul>
+ * In both cases, the blocks are finally multiplied by the relaxation factor
+ * AdditionalData::relaxation.
+ *
+ * For the application of the preconditioner, the blocks are stored
+ * interleaved in batches of VectorizedArray<Number>::n_array_elements blocks,
+ * so that vmult() and Tvmult() process as many blocks at once as there are
+ * lanes in the SIMD registers. The batches are distributed among the threads
+ * with parallel::apply_to_subranges().
+ *
+ * The matrix given to initialize() is expected to hold the locally owned
+ * rows passed as second argument, in the order of the index set, with
+ * columns in the global numbering. In serial, this is any square matrix, and
+ * the index set may be omitted. In parallel, this could for example be a
+ * rectangular SparseMatrix with as many rows as there are locally owned
+ * indices, assembled by the user. The locally owned range must be contiguous
+ * and its size divisible by the block size, and blocks consist of
+ * consecutive indices. For point blocks of a vector-valued problem, the
+ * components at a support point must therefore be numbered consecutively.
+ * This is the case for the default numbering of a DoFHandler with an FESystem
+ * of equal FE_Q elements, but not after DoFRenumbering::component_wise().
+ *
+ * @note Instantiations for this template are provided for <tt>@<float@> and
+ * @<double@></tt>, and for SparseMatrix as the matrix type.
+ */
+template <typename Number>
+class PreconditionPointBlockJacobi : public Subscriptor
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * The variants of how the blocks are computed.
+   */
+  enum class Type
+  {
+    /**
+     * Inverses of the diagonal blocks of the matrix.
+     */
+    block_jacobi,
+    /**
+     * Sparse approximate inverse with block-diagonal pattern.
+     */
+    spai0
+  };
+
+  /**
+   * Parameters for the preconditioner.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(const unsigned int block_size = 1,
+                   const Type         type       = Type::block_jacobi,
+                   const Number       relaxation = 1.);
+
+    /**
+     * The size of the diagonal blocks.
+     */
+    unsigned int block_size;
+
+    /**
+     * The variant of the blocks.
+     */
+    Type type;
+
+    /**
+     * The factor the blocks are multiplied with.
+     */
+    Number relaxation;
+  };
+
+  /**
+   * Constructor. Initializes the preconditioner to be empty.
+   */
+  PreconditionPointBlockJacobi();
+
+  /**
+   * Compute the blocks of the preconditioner for the matrix @p matrix whose
+   * rows correspond to the indices in @p locally_owned_rows, as explained in
+   * the class documentation. If the index set is empty, the rows of the
+   * matrix are assumed to correspond to the indices $0,\ldots,m-1$.
+   *
+   * The matrix type needs to provide the functions <tt>m()</tt> and
+   * <tt>n()</tt>, and row iterators <tt>begin(row)</tt> and
+   * <tt>end(row)</tt> whose entries provide <tt>column()</tt> and
+   * <tt>value()</tt>, as SparseMatrix does. The matrix is not referenced
+   * after this call.
+   */
+  template <typename MatrixType>
+  void
+  initialize(const MatrixType &    matrix,
+             const IndexSet &      locally_owned_rows = IndexSet(),
+             const AdditionalData &additional_data    = AdditionalData());
+
+  /**
+   * Release all memory and return to a state as if just created by the
+   * default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Apply the preconditioner, i.e., multiply the locally owned part of
+   * @p src by the block-diagonal matrix and write the result into @p dst.
+   * Ghost entries of the vectors are neither read nor written.
+   */
+  template <typename VectorType>
+  void
+  vmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Apply the transpose of the preconditioner.
+   */
+  template <typename VectorType>
+  void
+  Tvmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Return the number of locally owned rows of the preconditioner.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the number of locally owned columns of the preconditioner, which
+   * equals m().
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the size of the diagonal blocks.
+   */
+  unsigned int
+  block_size() const;
+
+  /**
+   * Return an estimate for the memory consumption (in bytes) of this object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * Worker function for vmult() and Tvmult() on the batches in the range
+   * [begin, end).
+   */
+  void
+  apply_on_subrange(const unsigned int begin,
+                    const unsigned int end,
+                    Number *           dst,
+                    const Number *     src,
+                    const bool         transpose) const;
+
+  /**
+   * The number of locally owned rows.
+   */
+  size_type n_rows;
+
+  /**
+   * The size of the blocks.
+   */
+  unsigned int n_block_size;
+
+  /**
+   * The number of blocks.
+   */
+  unsigned int n_blocks;
+
+  /**
+   * The entries of the blocks. Entry $(i,j)$ of block $k$ is stored in lane
+   * <tt>k % n_lanes</tt> of element <tt>(k / n_lanes) * b * b + i * b +
+   * j</tt>, where $b$ is the block size and <tt>n_lanes</tt> the number of
+   * lanes of VectorizedArray<Number>. Unused lanes of the last batch are set
+   * to zero.
+   */
+  AlignedVector<VectorizedArray<Number>> blocks;
+};
+
+/*@}*/
+
+#ifndef DOXYGEN
+/*---------------------- Inline functions -----------------------------------*/
+
+
+template <typename Number>
+inline typename PreconditionPointBlockJacobi<Number>::size_type
+PreconditionPointBlockJacobi<Number>::m() const
+{
+  return n_rows;
+}
+
+
+
+template <typename Number>
+inline typename PreconditionPointBlockJacobi<Number>::size_type
+PreconditionPointBlockJacobi<Number>::n() const
+{
+  return n_rows;
+}
+
+
+
+template <typename Number>
+inline unsigned int
+PreconditionPointBlockJacobi<Number>::block_size() const
+{
+  return n_block_size;
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -0,0 +1,318 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_precondition_point_block_jacobi_templates_h
+#define dealii_precondition_point_block_jacobi_templates_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/lapack_full_matrix.h>
+#include <deal.II/lac/precondition_point_block_jacobi.h>
+
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace PreconditionPointBlockJacobiImplementation
+  {
+    /**
+     * Minimal number of batches of blocks a thread works on when applying
+     * the preconditioner.
+     */
+    const unsigned int minimum_parallel_grain_size = 64;
+  } // namespace PreconditionPointBlockJacobiImplementation
+} // namespace internal
+
+
+
+template <typename Number>
+PreconditionPointBlockJacobi<Number>::AdditionalData::AdditionalData(
+  const unsigned int block_size,
+  const Type         type,
+  const Number       relaxation)
+  : block_size(block_size)
+  , type(type)
+  , relaxation(relaxation)
+{}
+
+
+
+template <typename Number>
+PreconditionPointBlockJacobi<Number>::PreconditionPointBlockJacobi()
+  : n_rows(0)
+  , n_block_size(1)
+  , n_blocks(0)
+{}
+
+
+
+template <typename Number>
+void
+PreconditionPointBlockJacobi<Number>::clear()
+{
+  n_rows       = 0;
+  n_block_size = 1;
+  n_blocks     = 0;
+  blocks.clear();
+}
+
+
+
+template <typename Number>
+template <typename MatrixType>
+void
+PreconditionPointBlockJacobi<Number>::initialize(
+  const MatrixType &    matrix,
+  const IndexSet &      locally_owned_rows,
+  const AdditionalData &additional_data)
+{
+  const unsigned int b = additional_data.block_size;
+  Assert(b > 0, ExcMessage("The block size must be positive."));
+
+  size_type first_row = 0;
+  if (locally_owned_rows.size() > 0)
+    {
+      Assert(locally_owned_rows.is_contiguous(),
+             ExcMessage("The locally owned rows must form a contiguous "
+                        "range."));
+      AssertDimension(matrix.m(), locally_owned_rows.n_elements());
+      if (locally_owned_rows.n_elements() > 0)
+        first_row = locally_owned_rows.nth_index_in_set(0);
+    }
+  Assert(matrix.m() % b == 0,
+         ExcMessage("The number of locally owned rows must be divisible by "
+                    "the block size."));
+  AssertThrow(matrix.m() < numbers::invalid_unsigned_int,
+              ExcMessage("PreconditionPointBlockJacobi works on blocks of "
+                         "32 bit indices and does not support this many "
+                         "locally owned rows."));
+
+  clear();
+  n_rows       = matrix.m();
+  n_block_size = b;
+  n_blocks     = n_rows / b;
+
+  constexpr unsigned int n_lanes = VectorizedArray<Number>::n_array_elements;
+  const unsigned int     n_batches = (n_blocks + n_lanes - 1) / n_lanes;
+  VectorizedArray<Number> zero;
+  zero = Number();
+  blocks.resize(static_cast<std::size_t>(n_batches) * b * b, zero);
+
+  const auto compute_blocks = [&](const unsigned int begin,
+                                  const unsigned int end) {
+    LAPACKFullMatrix<Number> diagonal_block(b, b), gram_matrix(b, b);
+    std::vector<std::tuple<size_type, unsigned int, Number>> row_entries;
+
+    for (unsigned int k = begin; k < end; ++k)
+      {
+        const size_type block_start = first_row + k * b;
+
+        // collect the entries of the rows of this block. the diagonal block
+        // is all we need for Jacobi, whereas SPAI(0) additionally computes
+        // the Gram matrix of the rows, i.e., the dot products between all
+        // pairs of rows of the block
+        diagonal_block = Number();
+        row_entries.clear();
+        for (unsigned int i = 0; i < b; ++i)
+          for (auto entry = matrix.begin(k * b + i);
+               entry != matrix.end(k * b + i);
+               ++entry)
+            {
+              const size_type col   = entry->column();
+              const Number    value = entry->value();
+              if (col >= block_start && col < block_start + b)
+                diagonal_block(i, col - block_start) = value;
+              if (additional_data.type == Type::spai0)
+                row_entries.emplace_back(col, i, value);
+            }
+
+        if (additional_data.type == Type::block_jacobi)
+          diagonal_block.invert();
+        else
+          {
+            std::sort(row_entries.begin(), row_entries.end());
+            gram_matrix = Number();
+            for (auto p = row_entries.begin(); p != row_entries.end();)
+              {
+                auto q = p;
+                while (q != row_entries.end() &&
+                       std::get<0>(*q) == std::get<0>(*p))
+                  ++q;
+                for (auto e1 = p; e1 != q; ++e1)
+                  for (auto e2 = p; e2 != q; ++e2)
+                    gram_matrix(std::get<1>(*e1), std::get<1>(*e2)) +=
+                      std::get<2>(*e1) * std::get<2>(*e2);
+                p = q;
+              }
+            gram_matrix.invert();
+
+            // M_k = A_kk^T G^{-1}, formed in place of the diagonal block
+            LAPACKFullMatrix<Number> product(b, b);
+            diagonal_block.Tmmult(product, gram_matrix);
+            diagonal_block = product;
+          }
+
+        // write the block into its lane of the batch
+        VectorizedArray<Number> *batch =
+          blocks.begin() + static_cast<std::size_t>(k / n_lanes) * b * b;
+        for (unsigned int i = 0; i < b; ++i)
+          for (unsigned int j = 0; j < b; ++j)
+            batch[i * b + j][k % n_lanes] =
+              additional_data.relaxation * diagonal_block(i, j);
+      }
+  };
+
+  parallel::apply_to_subranges(0U, n_blocks, compute_blocks, 16);
+}
+
+
+
+template <typename Number>
+void
+PreconditionPointBlockJacobi<Number>::apply_on_subrange(
+  const unsigned int begin,
+  const unsigned int end,
+  Number *           dst,
+  const Number *     src,
+  const bool         transpose) const
+{
+  constexpr unsigned int n_lanes = VectorizedArray<Number>::n_array_elements;
+  const unsigned int     b       = n_block_size;
+
+  unsigned int offsets[n_lanes];
+  for (unsigned int l = 0; l < n_lanes; ++l)
+    offsets[l] = l * b;
+
+  // the source entries of the batch are read before anything is written to
+  // the destination, so the vectors may be the same
+  AlignedVector<VectorizedArray<Number>> src_values(b);
+
+  for (unsigned int batch = begin; batch < end; ++batch)
+    {
+      const VectorizedArray<Number> *matrix =
+        blocks.begin() + static_cast<std::size_t>(batch) * b * b;
+      const std::size_t first_index =
+        static_cast<std::size_t>(batch) * n_lanes * b;
+
+      if ((batch + 1) * n_lanes <= n_blocks)
+        {
+          for (unsigned int j = 0; j < b; ++j)
+            src_values[j].gather(src + first_index + j, offsets);
+          for (unsigned int i = 0; i < b; ++i)
+            {
+              VectorizedArray<Number> sum = transpose ?
+                                              matrix[i] * src_values[0] :
+                                              matrix[i * b] * src_values[0];
+              for (unsigned int j = 1; j < b; ++j)
+                sum += (transpose ? matrix[j * b + i] : matrix[i * b + j]) *
+                       src_values[j];
+              sum.scatter(offsets, dst + first_index + i);
+            }
+        }
+      else
+        {
+          // incomplete last batch: only work on the lanes with blocks
+          const unsigned int n_filled = n_blocks - batch * n_lanes;
+          for (unsigned int j = 0; j < b; ++j)
+            for (unsigned int l = 0; l < n_filled; ++l)
+              src_values[j][l] = src[first_index + offsets[l] + j];
+          for (unsigned int l = 0; l < n_filled; ++l)
+            for (unsigned int i = 0; i < b; ++i)
+              {
+                Number sum = Number();
+                for (unsigned int j = 0; j < b; ++j)
+                  sum += (transpose ? matrix[j * b + i][l] :
+                                      matrix[i * b + j][l]) *
+                         src_values[j][l];
+                dst[first_index + offsets[l] + i] = sum;
+              }
+        }
+    }
+}
+
+
+
+template <typename Number>
+template <typename VectorType>
+void
+PreconditionPointBlockJacobi<Number>::vmult(VectorType &      dst,
+                                            const VectorType &src) const
+{
+  static_assert(
+    std::is_same<typename VectorType::value_type, Number>::value,
+    "The vector must have the same number type as the preconditioner.");
+  AssertDimension(static_cast<size_type>(dst.end() - dst.begin()), n_rows);
+  AssertDimension(static_cast<size_type>(src.end() - src.begin()), n_rows);
+
+  constexpr unsigned int n_lanes = VectorizedArray<Number>::n_array_elements;
+  parallel::apply_to_subranges(
+    0U,
+    (n_blocks + n_lanes - 1) / n_lanes,
+    [&](const unsigned int begin, const unsigned int end) {
+      this->apply_on_subrange(begin, end, dst.begin(), src.begin(), false);
+    },
+    internal::PreconditionPointBlockJacobiImplementation::
+      minimum_parallel_grain_size);
+}
+
+
+
+template <typename Number>
+template <typename VectorType>
+void
+PreconditionPointBlockJacobi<Number>::Tvmult(VectorType &      dst,
+                                             const VectorType &src) const
+{
+  static_assert(
+    std::is_same<typename VectorType::value_type, Number>::value,
+    "The vector must have the same number type as the preconditioner.");
+  AssertDimension(static_cast<size_type>(dst.end() - dst.begin()), n_rows);
+  AssertDimension(static_cast<size_type>(src.end() - src.begin()), n_rows);
+
+  constexpr unsigned int n_lanes = VectorizedArray<Number>::n_array_elements;
+  parallel::apply_to_subranges(
+    0U,
+    (n_blocks + n_lanes - 1) / n_lanes,
+    [&](const unsigned int begin, const unsigned int end) {
+      this->apply_on_subrange(begin, end, dst.begin(), src.begin(), true);
+    },
+    internal::PreconditionPointBlockJacobiImplementation::
+      minimum_parallel_grain_size);
+}
+
+
+
+template <typename Number>
+std::size_t
+PreconditionPointBlockJacobi<Number>::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(blocks);
+}
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -26,6 +26,7 @@
 #  include <deal.II/base/thread_management.h>
 
 #  include <deal.II/lac/full_matrix.h>
+#  include <deal.II/lac/la_parallel_vector.h>
 #  include <deal.II/lac/lapack_full_matrix.h>
 #  include <deal.II/lac/lapack_support.h>
 
@@ -237,6 +238,38 @@ public:
   void
   copy_to(ScaLAPACKMatrix<NumberType> &dest) const;
 
+  /**
+   * Copy the entries of the distributed vectors @p columns into the columns
+   * of this matrix, i.e., the $j$th vector becomes the $j$th column. The
+   * number of vectors must equal the number of columns and the size of the
+   * vectors the number of rows of the matrix.
+   *
+   * The entries are sent directly from the processes owning them in the
+   * vectors to the processes owning them in the block-cyclic distribution
+   * with a single all-to-all exchange, without gathering the matrix on any
+   * process. This allows to set up, e.g., the matrix of snapshots in
+   * reduced basis methods from vectors of finite element solutions. All
+   * vectors must have the same parallel layout, and they must be
+   * distributed over the processes of the MPI communicator used to create
+   * the process grid of this matrix, in the same order.
+   */
+  void
+  copy_from(
+    const std::vector<LinearAlgebra::distributed::Vector<NumberType>>
+      &columns);
+
+  /**
+   * Copy the columns of this matrix into the distributed vectors
+   * @p columns, i.e., the inverse operation of the function above. The
+   * vectors must already have the correct size and parallel layout, and
+   * only their locally owned entries are set. This can be used to obtain,
+   * e.g., the eigenvectors computed by eigenpairs_symmetric_by_index() as
+   * distributed vectors.
+   */
+  void
+  copy_to(std::vector<LinearAlgebra::distributed::Vector<NumberType>>
+            &columns) const;
+
   /**
    * Copy a submatrix (subset) of the distributed matrix A to a submatrix of the distributed matrix @p B.
    *
@@ -0,0 +1,411 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_sell_sparse_matrix_h
+#  define dealii_sell_sparse_matrix_h
+
+
+#  include <deal.II/base/config.h>
+
+#  include <deal.II/base/aligned_vector.h>
+#  include <deal.II/base/subscriptor.h>
+#  include <deal.II/base/vectorization.h>
+
+#  include <deal.II/lac/exceptions.h>
+
+#  include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+template <typename number>
+class Vector;
+template <typename number>
+class SparseMatrix;
+class SparsityPattern;
+
+/*! @addtogroup Matrix1
+ *@{
+ */
+
+/**
+ * A sparse matrix stored in the sliced ELLPACK format with chunk size $C$
+ * and sorting scope $\sigma$, commonly referred to as SELL-C-$\sigma$.
+ *
+ * The rows of the matrix are grouped into chunks of $C$ consecutive rows,
+ * where $C$ equals the number of lanes of VectorizedArray<number>, i.e., the
+ * SIMD width the library has been configured for. Within each chunk, the
+ * entries are stored column-major: first the first nonzero entry of each of
+ * the $C$ rows, then the second entry of each row, and so on, with rows
+ * shorter than the longest row of their chunk padded by explicit zeros. As
+ * a consequence, the matrix-vector product processes $C$ rows at once with
+ * contiguous loads of the matrix entries and one gather operation on the
+ * source vector per entry, rather than the short scalar inner loops over the
+ * entries of a single row done by SparseMatrix::vmult(). This is different
+ * from ChunkSparseMatrix that vectorizes within dense blocks and hence only
+ * pays off if the matrix actually consists of dense blocks.
+ *
+ * To reduce the amount of padding, rows are sorted by decreasing length
+ * within windows of $\sigma$ consecutive rows before being grouped into
+ * chunks. The permutation is stored in this class and is invisible to the
+ * user, i.e., all vectors are given in the original numbering. Larger
+ * windows reduce the padding for matrices with strongly varying row lengths
+ * at the price of less locality in the write access to the destination
+ * vector. A value of one disables sorting altogether.
+ *
+ * This class only stores the data needed for a fast application of the
+ * matrix. The typical usage is therefore to assemble the matrix into a
+ * SparseMatrix as usual and then to convert it:
+ * @code
+ *   SELLSparseMatrix<double> sell_matrix;
+ *   sell_matrix.reinit(sparsity_pattern);
+ *   sell_matrix.copy_from(system_matrix);
+ *
+ *   SolverCG<Vector<double>> solver(solver_control);
+ *   solver.solve(sell_matrix, solution, system_rhs, PreconditionIdentity());
+ * @endcode
+ * Since only the pattern is needed for reinit(), the conversion can be
+ * repeated cheaply with copy_from() whenever the values of the assembled
+ * matrix change.
+ *
+ * @note Instantiations for this template are provided for <tt>@<float@> and
+ * @<double@></tt>; others can be generated in application programs (see the
+ * section on
+ * @ref Instantiations
+ * in the manual).
+ */
+template <typename number>
+class SELLSparseMatrix : public virtual Subscriptor
+{
+public:
+  /**
+   * Declare the type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Type of matrix entries. This alias is analogous to <tt>value_type</tt>
+   * in the standard library containers.
+   */
+  using value_type = number;
+
+  /**
+   * The number of rows that are grouped into one chunk, which is the
+   * number of lanes of VectorizedArray<number>.
+   */
+  static const unsigned int chunk_size =
+    VectorizedArray<number>::n_array_elements;
+
+  /**
+   * Constructor; initializes the matrix to be empty, without any structure.
+   * It must be initialized by reinit() before it can be used.
+   */
+  SELLSparseMatrix();
+
+  /**
+   * Copy constructor.
+   */
+  SELLSparseMatrix(const SELLSparseMatrix<number> &) = default;
+
+  /**
+   * Copy assignment operator.
+   */
+  SELLSparseMatrix<number> &
+  operator=(const SELLSparseMatrix<number> &) = default;
+
+  /**
+   * Set up the structure of the matrix from the given sparsity pattern
+   * and set all entries to zero. Rows are sorted by decreasing length within
+   * windows of @p sorting_window rows, which is rounded up to a multiple of
+   * the chunk size.
+   *
+   * In contrast to SparseMatrix, the sparsity pattern is not referenced
+   * after this call and may be destroyed.
+   */
+  void
+  reinit(const SparsityPattern &sparsity,
+         const unsigned int     sorting_window = 32);
+
+  /**
+   * Release all memory and return to a state as if just created by the
+   * default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Return whether the object is empty.
+   */
+  bool
+  empty() const;
+
+  /**
+   * Copy the entries of the given matrix into this object. The sparsity
+   * pattern of @p matrix must be the one this object has been initialized
+   * with by reinit().
+   */
+  template <typename number2>
+  void
+  copy_from(const SparseMatrix<number2> &matrix);
+
+  /**
+   * Return the dimension of the codomain (or range) space.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the dimension of the domain space.
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of entries of the sparsity pattern this object has been
+   * initialized with, i.e., excluding the padding.
+   */
+  std::size_t
+  n_nonzero_elements() const;
+
+  /**
+   * Return the value of the entry (i,j), or zero if the entry is not part of
+   * the sparsity pattern. This function needs to search the row and is
+   * therefore slow.
+   */
+  number
+  el(const size_type i, const size_type j) const;
+
+  /**
+   * Return the main diagonal element in the <i>i</i>th row. This function
+   * throws an error if the matrix is not quadratic.
+   */
+  number
+  diag_element(const size_type i) const;
+
+  /**
+   * Matrix-vector multiplication: let $dst = M*src$ with $M$ being this
+   * matrix. If the vector entries are of the same type as the matrix
+   * entries, the products of all rows of a chunk are computed in SIMD
+   * fashion.
+   */
+  template <typename somenumber>
+  void
+  vmult(Vector<somenumber> &dst, const Vector<somenumber> &src) const;
+
+  /**
+   * Matrix-vector multiplication: let $dst = M^T*src$ with $M$ being this
+   * matrix. This function does the same as vmult() but takes the transposed
+   * matrix. Since the transposed product scatters into the destination
+   * vector, it is not vectorized.
+   */
+  template <typename somenumber>
+  void
+  Tvmult(Vector<somenumber> &dst, const Vector<somenumber> &src) const;
+
+  /**
+   * Adding matrix-vector multiplication. Add $M*src$ on $dst$ with $M$ being
+   * this matrix.
+   */
+  template <typename somenumber>
+  void
+  vmult_add(Vector<somenumber> &dst, const Vector<somenumber> &src) const;
+
+  /**
+   * Adding matrix-vector multiplication. Add $M^T*src$ to $dst$ with $M$
+   * being this matrix. This function does the same as vmult_add() but takes
+   * the transposed matrix.
+   */
+  template <typename somenumber>
+  void
+  Tvmult_add(Vector<somenumber> &dst, const Vector<somenumber> &src) const;
+
+  /**
+   * Apply the Jacobi preconditioner, which multiplies every element of the
+   * <tt>src</tt> vector by the inverse of the respective diagonal element and
+   * multiplies the result with the relaxation factor <tt>omega</tt>.
+   */
+  template <typename somenumber>
+  void
+  precondition_Jacobi(Vector<somenumber> &      dst,
+                      const Vector<somenumber> &src,
+                      const number              omega = 1.) const;
+
+  /**
+   * Return an estimate for the memory consumption (in bytes) of this object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcDifferentSparsityPatterns,
+                   "The sparsity pattern of the given matrix does not match "
+                   "the one this object has been initialized with.");
+
+  /**
+   * Exception
+   */
+  DeclExceptionMsg(ExcSourceEqualsDestination,
+                   "You are attempting an operation on two matrices that "
+                   "are the same object, but the operation requires that the "
+                   "two objects are in fact different.");
+
+private:
+  /**
+   * Worker function for vmult() and vmult_add() on the chunks in the range
+   * [begin, end).
+   */
+  template <typename somenumber>
+  void
+  vmult_on_subrange(const unsigned int begin,
+                    const unsigned int end,
+                    somenumber *       dst,
+                    const somenumber * src,
+                    const bool         add) const;
+
+  /**
+   * Vectorized variant of vmult_on_subrange() for vectors with the same
+   * number type as the matrix.
+   */
+  void
+  vmult_on_subrange(const unsigned int begin,
+                    const unsigned int end,
+                    number *           dst,
+                    const number *     src,
+                    const bool         add) const;
+
+  /**
+   * Number of rows of the matrix.
+   */
+  size_type n_rows;
+
+  /**
+   * Number of columns of the matrix.
+   */
+  size_type n_cols;
+
+  /**
+   * Number of entries of the sparsity pattern, excluding the padding.
+   */
+  std::size_t n_entries;
+
+  /**
+   * For each of the <tt>chunk_size</tt> slots of every chunk, the row of the
+   * matrix stored in that slot. Slots beyond the last row of the matrix are
+   * marked by numbers::invalid_unsigned_int.
+   */
+  std::vector<unsigned int> slot_to_row;
+
+  /**
+   * The inverse of #slot_to_row, i.e., the slot each row is stored in.
+   */
+  std::vector<unsigned int> row_to_slot;
+
+  /**
+   * The number of entries of the row stored in each slot, i.e., the number
+   * of valid entries before the padding starts.
+   */
+  std::vector<unsigned int> slot_lengths;
+
+  /**
+   * The position in #values and #column_indices where the data of each chunk
+   * starts, with one additional entry marking the end of the last chunk. The
+   * <tt>k</tt>th entry of the row in slot <tt>l</tt> of chunk <tt>c</tt> is
+   * stored at <tt>chunk_starts[c] + k * chunk_size + l</tt>.
+   */
+  std::vector<std::size_t> chunk_starts;
+
+  /**
+   * The column indices, in the layout described at #chunk_starts. Padded
+   * entries repeat the last valid column of their row (or refer to column
+   * zero for empty rows) so that the gather in vmult() never leaves the
+   * vector.
+   */
+  AlignedVector<unsigned int> column_indices;
+
+  /**
+   * The matrix entries, in the layout described at #chunk_starts, with
+   * padded entries set to zero.
+   */
+  AlignedVector<number> values;
+
+  /**
+   * The position of the diagonal entry of each row in #values, or
+   * numbers::invalid_size_type if the row does not store its diagonal. Only
+   * filled for square matrices.
+   */
+  std::vector<std::size_t> diagonal_positions;
+};
+
+/*@}*/
+
+#  ifndef DOXYGEN
+/*---------------------- Inline functions -----------------------------------*/
+
+
+
+template <typename number>
+inline typename SELLSparseMatrix<number>::size_type
+SELLSparseMatrix<number>::m() const
+{
+  return n_rows;
+}
+
+
+
+template <typename number>
+inline typename SELLSparseMatrix<number>::size_type
+SELLSparseMatrix<number>::n() const
+{
+  return n_cols;
+}
+
+
+
+template <typename number>
+inline std::size_t
+SELLSparseMatrix<number>::n_nonzero_elements() const
+{
+  return n_entries;
+}
+
+
+
+template <typename number>
+inline bool
+SELLSparseMatrix<number>::empty() const
+{
+  return n_rows == 0 || n_cols == 0;
+}
+
+
+
+template <typename number>
+inline number
+SELLSparseMatrix<number>::diag_element(const size_type i) const
+{
+  Assert(m() == n(), ExcNotQuadratic());
+  AssertIndexRange(i, m());
+  Assert(diagonal_positions[i] != numbers::invalid_size_type,
+         ExcMessage("The diagonal entry of this row is not stored."));
+  return values[diagonal_positions[i]];
+}
+
+#  endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -0,0 +1,383 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_sell_sparse_matrix_templates_h
+#define dealii_sell_sparse_matrix_templates_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/sell_sparse_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace SELLSparseMatrixImplementation
+  {
+    /**
+     * Minimal number of chunks a thread works on in the matrix-vector
+     * product.
+     */
+    const unsigned int minimum_parallel_grain_size = 64;
+  } // namespace SELLSparseMatrixImplementation
+} // namespace internal
+
+
+
+template <typename number>
+SELLSparseMatrix<number>::SELLSparseMatrix()
+  : n_rows(0)
+  , n_cols(0)
+  , n_entries(0)
+{}
+
+
+
+template <typename number>
+void
+SELLSparseMatrix<number>::reinit(const SparsityPattern &sparsity,
+                                 const unsigned int     sorting_window)
+{
+  Assert(sparsity.is_compressed(), SparsityPattern::ExcNotCompressed());
+  AssertThrow(sparsity.n_rows() < numbers::invalid_unsigned_int &&
+                sparsity.n_cols() < numbers::invalid_unsigned_int,
+              ExcMessage("SELLSparseMatrix stores row and column indices "
+                         "as 32 bit integers and does not support matrices "
+                         "of this size."));
+  Assert(sorting_window > 0, ExcMessage("The sorting window must be positive"));
+
+  clear();
+  n_rows    = sparsity.n_rows();
+  n_cols    = sparsity.n_cols();
+  n_entries = sparsity.n_nonzero_elements();
+
+  // sort the rows by decreasing length within each window, keeping the
+  // original order among rows of equal length
+  const unsigned int window =
+    (sorting_window + chunk_size - 1) / chunk_size * chunk_size;
+  const unsigned int n_chunks = (n_rows + chunk_size - 1) / chunk_size;
+  slot_to_row.resize(n_chunks * chunk_size, numbers::invalid_unsigned_int);
+  std::iota(slot_to_row.begin(),
+            slot_to_row.begin() + n_rows,
+            static_cast<unsigned int>(0));
+  for (unsigned int start = 0; start < n_rows; start += window)
+    std::stable_sort(slot_to_row.begin() + start,
+                     slot_to_row.begin() +
+                       std::min<size_type>(start + window, n_rows),
+                     [&sparsity](const unsigned int a, const unsigned int b) {
+                       return sparsity.row_length(a) > sparsity.row_length(b);
+                     });
+
+  row_to_slot.resize(n_rows);
+  slot_lengths.resize(slot_to_row.size(), 0);
+  for (unsigned int slot = 0; slot < n_rows; ++slot)
+    {
+      row_to_slot[slot_to_row[slot]] = slot;
+      slot_lengths[slot]             = sparsity.row_length(slot_to_row[slot]);
+    }
+
+  chunk_starts.resize(n_chunks + 1);
+  chunk_starts[0] = 0;
+  for (unsigned int c = 0; c < n_chunks; ++c)
+    chunk_starts[c + 1] =
+      chunk_starts[c] +
+      chunk_size * *std::max_element(slot_lengths.begin() + c * chunk_size,
+                                     slot_lengths.begin() +
+                                       (c + 1) * chunk_size);
+
+  column_indices.resize_fast(chunk_starts.back());
+  values.resize(chunk_starts.back(), number());
+  if (n_rows == n_cols)
+    diagonal_positions.resize(n_rows, numbers::invalid_size_type);
+
+  for (unsigned int c = 0; c < n_chunks; ++c)
+    for (unsigned int l = 0; l < chunk_size; ++l)
+      {
+        const unsigned int slot = c * chunk_size + l;
+        const unsigned int row  = slot_to_row[slot];
+        unsigned int       col  = 0;
+        std::size_t        pos  = chunk_starts[c] + l;
+        for (unsigned int k = 0; k < slot_lengths[slot];
+             ++k, pos += chunk_size)
+          {
+            col                 = sparsity.column_number(row, k);
+            column_indices[pos] = col;
+            if (col == row && n_rows == n_cols)
+              diagonal_positions[row] = pos;
+          }
+        for (; pos < chunk_starts[c + 1]; pos += chunk_size)
+          column_indices[pos] = col;
+      }
+}
+
+
+
+template <typename number>
+void
+SELLSparseMatrix<number>::clear()
+{
+  n_rows    = 0;
+  n_cols    = 0;
+  n_entries = 0;
+  slot_to_row.clear();
+  row_to_slot.clear();
+  slot_lengths.clear();
+  chunk_starts.clear();
+  column_indices.clear();
+  values.clear();
+  diagonal_positions.clear();
+}
+
+
+
+template <typename number>
+template <typename number2>
+void
+SELLSparseMatrix<number>::copy_from(const SparseMatrix<number2> &matrix)
+{
+  Assert(m() == matrix.m(), ExcDimensionMismatch(m(), matrix.m()));
+  Assert(n() == matrix.n(), ExcDimensionMismatch(n(), matrix.n()));
+  Assert(n_entries == matrix.n_nonzero_elements(),
+         ExcDifferentSparsityPatterns());
+
+  for (unsigned int row = 0; row < n_rows; ++row)
+    {
+      const unsigned int slot = row_to_slot[row];
+      Assert(matrix.get_row_length(row) == slot_lengths[slot],
+             ExcDifferentSparsityPatterns());
+      std::size_t pos = chunk_starts[slot / chunk_size] + slot % chunk_size;
+      for (auto entry = matrix.begin(row); entry != matrix.end(row);
+           ++entry, pos += chunk_size)
+        {
+          Assert(column_indices[pos] == entry->column(),
+                 ExcDifferentSparsityPatterns());
+          values[pos] = entry->value();
+        }
+    }
+}
+
+
+
+template <typename number>
+number
+SELLSparseMatrix<number>::el(const size_type i, const size_type j) const
+{
+  AssertIndexRange(i, m());
+  AssertIndexRange(j, n());
+
+  const unsigned int slot = row_to_slot[i];
+  std::size_t        pos  = chunk_starts[slot / chunk_size] + slot % chunk_size;
+  for (unsigned int k = 0; k < slot_lengths[slot]; ++k, pos += chunk_size)
+    if (column_indices[pos] == j)
+      return values[pos];
+  return number();
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+void
+SELLSparseMatrix<number>::vmult_on_subrange(const unsigned int begin,
+                                            const unsigned int end,
+                                            somenumber *       dst,
+                                            const somenumber * src,
+                                            const bool         add) const
+{
+  for (unsigned int c = begin; c < end; ++c)
+    {
+      somenumber sum[chunk_size] = {};
+
+      const number *      val_ptr = values.begin() + chunk_starts[c];
+      const number *const val_end = values.begin() + chunk_starts[c + 1];
+      const unsigned int *col_ptr = column_indices.begin() + chunk_starts[c];
+      for (; val_ptr != val_end; val_ptr += chunk_size, col_ptr += chunk_size)
+        for (unsigned int l = 0; l < chunk_size; ++l)
+          sum[l] += somenumber(val_ptr[l]) * src[col_ptr[l]];
+
+      const unsigned int *rows = slot_to_row.data() + c * chunk_size;
+      for (unsigned int l = 0; l < chunk_size; ++l)
+        if (rows[l] != numbers::invalid_unsigned_int)
+          {
+            if (add)
+              dst[rows[l]] += sum[l];
+            else
+              dst[rows[l]] = sum[l];
+          }
+    }
+}
+
+
+
+template <typename number>
+void
+SELLSparseMatrix<number>::vmult_on_subrange(const unsigned int begin,
+                                            const unsigned int end,
+                                            number *           dst,
+                                            const number *     src,
+                                            const bool         add) const
+{
+  for (unsigned int c = begin; c < end; ++c)
+    {
+      VectorizedArray<number> sum = number();
+
+      const number *      val_ptr = values.begin() + chunk_starts[c];
+      const number *const val_end = values.begin() + chunk_starts[c + 1];
+      const unsigned int *col_ptr = column_indices.begin() + chunk_starts[c];
+      for (; val_ptr != val_end; val_ptr += chunk_size, col_ptr += chunk_size)
+        {
+          VectorizedArray<number> matrix_entries, src_entries;
+          matrix_entries.load(val_ptr);
+          src_entries.gather(src, col_ptr);
+          sum += matrix_entries * src_entries;
+        }
+
+      const unsigned int *rows = slot_to_row.data() + c * chunk_size;
+      for (unsigned int l = 0; l < chunk_size; ++l)
+        if (rows[l] != numbers::invalid_unsigned_int)
+          {
+            if (add)
+              dst[rows[l]] += sum[l];
+            else
+              dst[rows[l]] = sum[l];
+          }
+    }
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+void
+SELLSparseMatrix<number>::vmult(Vector<somenumber> &      dst,
+                                const Vector<somenumber> &src) const
+{
+  Assert(m() == dst.size(), ExcDimensionMismatch(m(), dst.size()));
+  Assert(n() == src.size(), ExcDimensionMismatch(n(), src.size()));
+  Assert(&src != &dst, ExcSourceEqualsDestination());
+
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(chunk_starts.size() - 1),
+    [&](const unsigned int begin, const unsigned int end) {
+      this->vmult_on_subrange(begin, end, dst.begin(), src.begin(), false);
+    },
+    internal::SELLSparseMatrixImplementation::minimum_parallel_grain_size);
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+void
+SELLSparseMatrix<number>::vmult_add(Vector<somenumber> &      dst,
+                                    const Vector<somenumber> &src) const
+{
+  Assert(m() == dst.size(), ExcDimensionMismatch(m(), dst.size()));
+  Assert(n() == src.size(), ExcDimensionMismatch(n(), src.size()));
+  Assert(&src != &dst, ExcSourceEqualsDestination());
+
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(chunk_starts.size() - 1),
+    [&](const unsigned int begin, const unsigned int end) {
+      this->vmult_on_subrange(begin, end, dst.begin(), src.begin(), true);
+    },
+    internal::SELLSparseMatrixImplementation::minimum_parallel_grain_size);
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+void
+SELLSparseMatrix<number>::Tvmult(Vector<somenumber> &      dst,
+                                 const Vector<somenumber> &src) const
+{
+  dst = 0;
+  Tvmult_add(dst, src);
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+void
+SELLSparseMatrix<number>::Tvmult_add(Vector<somenumber> &      dst,
+                                     const Vector<somenumber> &src) const
+{
+  Assert(n() == dst.size(), ExcDimensionMismatch(n(), dst.size()));
+  Assert(m() == src.size(), ExcDimensionMismatch(m(), src.size()));
+  Assert(&src != &dst, ExcSourceEqualsDestination());
+
+  // all slots beyond the first n_rows ones are padding
+  for (unsigned int slot = 0; slot < n_rows; ++slot)
+    {
+      const somenumber s = src(slot_to_row[slot]);
+      std::size_t pos = chunk_starts[slot / chunk_size] + slot % chunk_size;
+      for (unsigned int k = 0; k < slot_lengths[slot]; ++k, pos += chunk_size)
+        dst(column_indices[pos]) += somenumber(values[pos]) * s;
+    }
+}
+
+
+
+template <typename number>
+template <typename somenumber>
+void
+SELLSparseMatrix<number>::precondition_Jacobi(Vector<somenumber> &      dst,
+                                              const Vector<somenumber> &src,
+                                              const number omega) const
+{
+  Assert(m() == n(),
+         ExcMessage("This operation is only valid on square matrices."));
+  Assert(dst.size() == n(), ExcDimensionMismatch(dst.size(), n()));
+  Assert(src.size() == n(), ExcDimensionMismatch(src.size(), n()));
+
+  for (size_type i = 0; i < n_rows; ++i)
+    dst(i) = omega * src(i) / somenumber(diag_element(i));
+}
+
+
+
+template <typename number>
+std::size_t
+SELLSparseMatrix<number>::memory_consumption() const
+{
+  return sizeof(*this) + MemoryConsumption::memory_consumption(slot_to_row) +
+         MemoryConsumption::memory_consumption(row_to_slot) +
+         MemoryConsumption::memory_consumption(slot_lengths) +
+         MemoryConsumption::memory_consumption(chunk_starts) +
+         column_indices.memory_consumption() + values.memory_consumption() +
+         MemoryConsumption::memory_consumption(diagonal_positions);
+}
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -19,13 +19,18 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/signaling_nan.h>
 #include <deal.II/base/subscriptor.h>
 
+#include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_control.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 
 DEAL_II_NAMESPACE_OPEN
@@ -112,6 +117,25 @@ namespace internal
  * to find a general good criterion, so if things do not work for you, try to
  * change this value.
  *
+ * The third parameter selects a variant of the algorithm with fewer global
+ * reductions, which are the limiting factor for parallel computations on
+ * many processes with a moderate number of unknowns per process. The
+ * classical algorithm computes five inner products in every iteration, each
+ * followed by a global reduction, plus the norm of the residual. The variant
+ * applies the preconditioner and the matrix to the intermediate residual
+ * $s=r-\alpha v$ before checking its norm, which allows to compute all inner
+ * products of the second half of the iteration in a single reduction,
+ * together with the inner product with the shadow residual needed for the
+ * next iteration. This leaves two reductions per iteration when the exact
+ * residual is not requested, and three otherwise. The norm of the updated
+ * residual is then obtained from the merged inner products; when this
+ * formula suffers from cancellation, i.e., when the residual is much smaller
+ * than $s$, the norm is computed from the vector instead. For
+ * LinearAlgebra::distributed::Vector, the merged inner products as well as
+ * the update of the search direction are computed in a single sweep over
+ * the vector entries. In the last iteration, the variant applies the
+ * preconditioner and the matrix once more than the classical algorithm.
+ *
  *
  * <h3>Observing the progress of linear solver iterations</h3>
  *
@@ -140,13 +164,16 @@ public:
     /**
      * Constructor.
      *
-     * The default is to perform an exact residual computation and breakdown
-     * parameter 1e-10.
+     * The default is to perform an exact residual computation, breakdown
+     * parameter 1e-10, and the classical algorithm with separate inner
+     * products.
      */
-    explicit AdditionalData(const bool   exact_residual = true,
-                            const double breakdown      = 1.e-10)
+    explicit AdditionalData(const bool   exact_residual       = true,
+                            const double breakdown            = 1.e-10,
+                            const bool   merge_inner_products = false)
       : exact_residual(exact_residual)
       , breakdown(breakdown)
+      , merge_inner_products(merge_inner_products)
     {}
     /**
      * Flag for exact computation of residual.
@@ -156,6 +183,12 @@ public:
      * Breakdown threshold.
      */
     double breakdown;
+    /**
+     * Flag for the variant of the algorithm that merges the inner products
+     * of each half step into one global reduction, see the documentation of
+     * this class.
+     */
+    bool merge_inner_products;
   };
 
   /**
@@ -288,6 +321,15 @@ private:
   template <typename MatrixType, typename PreconditionerType>
   IterationResult
   iterate(const MatrixType &A, const PreconditionerType &preconditioner);
+
+  /**
+   * The iteration loop of the variant with merged inner products. The
+   * function returns a structure indicating what happened in this function.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  IterationResult
+  iterate_merged(const MatrixType &        A,
+                 const PreconditionerType &preconditioner);
 };
 
 /*@}*/
@@ -295,6 +337,119 @@ private:
 
 #ifndef DOXYGEN
 
+namespace internal
+{
+  namespace SolverBicgstabImplementation
+  {
+    /**
+     * Compute the inner products <tt>t*s</tt>, <tt>t*t</tt>, <tt>s*s</tt>,
+     * <tt>t*rbar</tt>, and <tt>s*rbar</tt>, in this order.
+     */
+    template <typename VectorType>
+    void
+    compute_merged_inner_products(const VectorType &     s,
+                                  const VectorType &     t,
+                                  const VectorType &     rbar,
+                                  std::array<double, 5> &products)
+    {
+      products[0] = t * s;
+      products[1] = t * t;
+      products[2] = s * s;
+      products[3] = t * rbar;
+      products[4] = s * rbar;
+    }
+
+
+
+    /**
+     * Same as above for LinearAlgebra::distributed::Vector, computing all
+     * inner products in one sweep over the locally owned entries and one
+     * global reduction.
+     */
+    template <typename Number>
+    void
+    compute_merged_inner_products(
+      const LinearAlgebra::distributed::Vector<Number> &s,
+      const LinearAlgebra::distributed::Vector<Number> &t,
+      const LinearAlgebra::distributed::Vector<Number> &rbar,
+      std::array<double, 5> &                           products)
+    {
+      const Number *     s_values    = s.begin();
+      const Number *     t_values    = t.begin();
+      const Number *     rbar_values = rbar.begin();
+      const unsigned int local_size  = s.local_size();
+
+      std::array<double, 5> local_products = {{0., 0., 0., 0., 0.}};
+
+      // accumulate chunks separately to limit the round-off error of the
+      // long sums
+      const unsigned int chunk_size = 256;
+      for (unsigned int begin = 0; begin < local_size; begin += chunk_size)
+        {
+          const unsigned int end = std::min(begin + chunk_size, local_size);
+          std::array<double, 5> sums = {{0., 0., 0., 0., 0.}};
+          for (unsigned int e = begin; e < end; ++e)
+            {
+              sums[0] += t_values[e] * s_values[e];
+              sums[1] += t_values[e] * t_values[e];
+              sums[2] += s_values[e] * s_values[e];
+              sums[3] += t_values[e] * rbar_values[e];
+              sums[4] += s_values[e] * rbar_values[e];
+            }
+          for (unsigned int i = 0; i < 5; ++i)
+            local_products[i] += sums[i];
+        }
+
+      Utilities::MPI::sum(ArrayView<const double>(local_products.data(), 5),
+                          s.get_mpi_communicator(),
+                          ArrayView<double>(products.data(), 5));
+    }
+
+
+
+    /**
+     * Update the search direction, <tt>p = r + beta*(p - omega*v)</tt>.
+     */
+    template <typename VectorType>
+    void
+    update_search_direction(VectorType &      p,
+                            const VectorType &r,
+                            const VectorType &v,
+                            const double      beta,
+                            const double      omega)
+    {
+      p.sadd(beta, 1., r);
+      p.add(-beta * omega, v);
+    }
+
+
+
+    /**
+     * Same as above for LinearAlgebra::distributed::Vector, doing the update
+     * in one sweep over the locally owned entries.
+     */
+    template <typename Number>
+    void
+    update_search_direction(LinearAlgebra::distributed::Vector<Number> &p,
+                            const LinearAlgebra::distributed::Vector<Number> &r,
+                            const LinearAlgebra::distributed::Vector<Number> &v,
+                            const double beta,
+                            const double omega)
+    {
+      Number *           p_values   = p.begin();
+      const Number *     r_values   = r.begin();
+      const Number *     v_values   = v.begin();
+      const Number       factor_p   = beta;
+      const Number       factor_v   = -beta * omega;
+      const unsigned int local_size = p.local_size();
+      for (unsigned int e = 0; e < local_size; ++e)
+        p_values[e] =
+          r_values[e] + factor_p * p_values[e] + factor_v * v_values[e];
+    }
+  } // namespace SolverBicgstabImplementation
+} // namespace internal
+
+
 
 template <typename VectorType>
 SolverBicgstab<VectorType>::IterationResult::IterationResult(
@@ -461,6 +616,107 @@ SolverBicgstab<VectorType>::iterate(const MatrixType &        A,
 }
 
 
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+typename SolverBicgstab<VectorType>::IterationResult
+SolverBicgstab<VectorType>::iterate_merged(
+  const MatrixType &        A,
+  const PreconditionerType &preconditioner)
+{
+  SolverControl::State state = SolverControl::iterate;
+  alpha = omega = rho = 1.;
+
+  VectorType &r    = *Vr;
+  VectorType &rbar = *Vrbar;
+  VectorType &p    = *Vp;
+  VectorType &y    = *Vy;
+  VectorType &z    = *Vz;
+  VectorType &t    = *Vt;
+  VectorType &v    = *Vv;
+
+  rbar         = r;
+  bool startup = true;
+
+  // the inner product r*rbar is computed together with the other inner
+  // products of the previous iteration; in the first iteration, rbar=r
+  double r_times_rbar = res * res;
+
+  std::array<double, 5> products;
+
+  do
+    {
+      ++step;
+
+      rhobar = r_times_rbar;
+      beta   = rhobar * alpha / (rho * omega);
+      rho    = rhobar;
+      if (startup == true)
+        {
+          p       = r;
+          startup = false;
+        }
+      else
+        internal::SolverBicgstabImplementation::update_search_direction(
+          p, r, v, beta, omega);
+
+      preconditioner.vmult(y, p);
+      A.vmult(v, y);
+      rhobar = rbar * v;
+
+      alpha = rho / rhobar;
+
+      if (std::fabs(alpha) > 1.e10)
+        return IterationResult(true, state, step, res);
+
+      // from here on, r holds the intermediate residual s. its norm is
+      // computed along with the inner products for omega, so the check for
+      // early success comes after the second matrix-vector product
+      r.add(-alpha, v);
+      preconditioner.vmult(z, r);
+      A.vmult(t, z);
+      internal::SolverBicgstabImplementation::compute_merged_inner_products(
+        r, t, rbar, products);
+      const double t_times_s = products[0];
+      const double t_times_t = products[1];
+      const double s_times_s = products[2];
+
+      // check for early success, see the iterate() function
+      res = std::sqrt(std::abs(s_times_s));
+      if (this->iteration_status(step, res, *Vx) == SolverControl::success)
+        {
+          Vx->add(alpha, y);
+          print_vectors(step, *Vx, r, y);
+          return IterationResult(false, SolverControl::success, step, res);
+        }
+
+      omega = t_times_s / t_times_t;
+      Vx->add(alpha, y, omega, z);
+      r.add(-omega, t);
+      r_times_rbar = products[4] - omega * products[3];
+
+      if (additional_data.exact_residual)
+        res = criterion(A, *Vx, *Vb);
+      else
+        {
+          // the norm of r=s-omega*t follows from the inner products above,
+          // but suffers from cancellation if r is much smaller than s
+          const double res_square =
+            s_times_s - 2. * omega * t_times_s + omega * omega * t_times_t;
+          if (res_square > 1e-4 * s_times_s)
+            res = std::sqrt(res_square);
+          else
+            res = r.l2_norm();
+        }
+
+      state = this->iteration_status(step, res, *Vx);
+      print_vectors(step, *Vx, r, y);
+    }
+  while (state == SolverControl::iterate);
+  return IterationResult(false, state, step, res);
+}
+
+
+
 template <typename VectorType>
 template <typename MatrixType, typename PreconditionerType>
 void
@@ -503,7 +759,10 @@ SolverBicgstab<VectorType>::solve(const MatrixType &        A,
           state.state = SolverControl::success;
           break;
         }
-      state = iterate(A, preconditioner);
+      if (additional_data.merge_inner_products)
+        state = iterate_merged(A, preconditioner);
+      else
+        state = iterate(A, preconditioner);
       ++step;
     }
   while (state.breakdown == true);
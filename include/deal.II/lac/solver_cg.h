@@ -22,6 +22,7 @@
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/logstream.h>
 #include <deal.II/base/subscriptor.h>
+#include <deal.II/base/tracing.h>
 
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_control.h>
@@ -103,11 +104,30 @@ public:
 
   /**
    * Standardized data struct to pipe additional data to the solver.
-   * Here, it doesn't store anything but just exists for consistency
-   * with the other solver classes.
    */
   struct AdditionalData
-  {};
+  {
+    /**
+     * Constructor. By default, the convergence is checked in every
+     * iteration.
+     */
+    explicit AdditionalData(const unsigned int check_frequency = 1);
+
+    /**
+     * Number of iterations between two calls to the SolverControl object
+     * and the other slots connected to the iteration status. In the
+     * iterations in between, the preconditioned algorithm does not compute
+     * the norm of the residual, which saves a global reduction in parallel
+     * computations, and no output is generated. Since convergence is only
+     * detected in the iterations where it is checked, the solver may
+     * perform up to <tt>check_frequency-1</tt> iterations more than
+     * necessary, and more than the maximal number of steps of the
+     * SolverControl object. Likewise, the history data of the
+     * SolverControl object then contains one entry per check rather than
+     * one entry per iteration.
+     */
+    unsigned int check_frequency;
+  };
 
   /**
    * Constructor.
@@ -238,6 +258,17 @@ protected:
 
 #ifndef DOXYGEN
 
+template <typename VectorType>
+inline SolverCG<VectorType>::AdditionalData::AdditionalData(
+  const unsigned int check_frequency)
+  : check_frequency(check_frequency)
+{
+  Assert(check_frequency > 0,
+         ExcMessage("The check frequency of SolverCG must be positive."));
+}
+
+
+
 template <typename VectorType>
 SolverCG<VectorType>::SolverCG(SolverControl &           cn,
                                VectorMemory<VectorType> &mem,
@@ -393,6 +424,8 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
 
   while (conv == SolverControl::iterate)
     {
+      Tracing::Scope trace("SolverCG::iteration");
+
       it++;
       A.vmult(h, d);
 
@@ -401,13 +434,27 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
       alpha = gh / alpha;
 
       x.add(alpha, d);
-      res = std::sqrt(std::abs(g.add_and_dot(alpha, h, g)));
+
+      // the norm of the residual is only needed in the iterations where
+      // the convergence is checked, unless the algorithm without
+      // preconditioner uses it for the update of the search direction
+      const bool check_step = (it % additional_data.check_frequency == 0);
+      if (check_step ||
+          std::is_same<PreconditionerType, PreconditionIdentity>::value)
+        res = std::sqrt(std::abs(g.add_and_dot(alpha, h, g)));
+      else
+        g.add(alpha, h);
 
       print_vectors(it, x, g, d);
 
-      conv = this->iteration_status(it, res, x);
-      if (conv != SolverControl::iterate)
-        break;
+      // a zero residual must be detected right away since the next update
+      // would divide by zero
+      if (check_step || res == 0.)
+        {
+          conv = this->iteration_status(it, res, x);
+          if (conv != SolverControl::iterate)
+            break;
+        }
 
       if (std::is_same<PreconditionerType, PreconditionIdentity>::value ==
           false)
@@ -416,7 +463,14 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
 
           beta = gh;
           Assert(std::abs(beta) != 0., ExcDivideByZero());
-          gh   = g * h;
+          gh = g * h;
+          if (gh == number() && check_step == false)
+            {
+              res  = g.l2_norm();
+              conv = this->iteration_status(it, res, x);
+              if (conv != SolverControl::iterate)
+                break;
+            }
           beta = gh / beta;
           d.sadd(beta, -1., h);
         }
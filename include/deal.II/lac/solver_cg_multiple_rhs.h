@@ -0,0 +1,326 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_cg_multiple_rhs_h
+#define dealii_solver_cg_multiple_rhs_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * This class implements the preconditioned Conjugate Gradient method for a
+ * symmetric positive definite matrix and several right hand sides at once.
+ * The right hand sides and the solutions are stored as the blocks of a block
+ * vector, i.e., @p VectorType must be a block vector such as
+ * LinearAlgebra::distributed::BlockVector or BlockVector, with one block per
+ * right hand side. Each block must have the layout of a vector the matrix
+ * acts on.
+ *
+ * The method runs one independent CG iteration per block, with separate
+ * step lengths $\alpha_i$ and $\beta_i$, but all of them in lockstep: In
+ * each iteration, the matrix and the preconditioner are applied once to the
+ * whole block vector. This allows operators that can act on several vectors
+ * at once to amortize their costs across the right hand sides. For example,
+ * a matrix-free operator based on FEEvaluation with @p n_components equal to
+ * the number of blocks on a scalar DoFHandler reads all blocks of the
+ * source vector in one pass over the cells, i.e., it loads the indices and
+ * the geometry data only once for all right hand sides. Furthermore, the
+ * inner products of all blocks are computed with a single global reduction
+ * for LinearAlgebra::distributed::BlockVector, and the ghost exchange of the
+ * blocks is combined into one message per process, see
+ * LinearAlgebra::distributed::BlockVector::update_ghost_values(). The
+ * matrix and the preconditioner are called with the full block vector, so
+ * both need to work on the block vector type.
+ *
+ * The iterates of each block are the same as the ones SolverCG would compute
+ * for that block alone. The iteration is stopped once the largest norm of
+ * the (unpreconditioned) residuals of all blocks satisfies the criterion of
+ * the SolverControl object, via the mechanism described in the Solver base
+ * class. Blocks that converge earlier keep being updated, which does not
+ * harm their accuracy. A block with a zero residual, e.g., because its right
+ * hand side is zero, is not updated at all.
+ *
+ * There is no AdditionalData for this class.
+ */
+template <typename VectorType = BlockVector<double>>
+class SolverCGMultipleRHS : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   * Here, it doesn't store anything but just exists for consistency
+   * with the other solver classes.
+   */
+  struct AdditionalData
+  {};
+
+  /**
+   * Constructor.
+   */
+  SolverCGMultipleRHS(SolverControl &           cn,
+                      VectorMemory<VectorType> &mem,
+                      const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverCGMultipleRHS(SolverControl &       cn,
+                      const AdditionalData &data = AdditionalData());
+
+  /**
+   * Virtual destructor.
+   */
+  virtual ~SolverCGMultipleRHS() override = default;
+
+  /**
+   * Solve the linear systems $Ax_i=b_i$ for all blocks $x_i$ of @p x.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        VectorType &              x,
+        const VectorType &        b,
+        const PreconditionerType &preconditioner);
+
+protected:
+  /**
+   * Additional parameters.
+   */
+  AdditionalData additional_data;
+};
+
+/*@}*/
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+namespace internal
+{
+  namespace SolverCGMultipleRHSImplementation
+  {
+    /**
+     * Computes the inner products between corresponding blocks of two block
+     * vectors. For general vector types, one inner product (and thus one
+     * reduction for parallel vectors) per block is computed.
+     */
+    template <typename VectorType>
+    struct BlockwiseInnerProducts
+    {
+      template <typename Number>
+      static void
+      compute(const ArrayView<Number> &result,
+              const VectorType &       u,
+              const VectorType &       v)
+      {
+        AssertDimension(result.size(), u.n_blocks());
+        for (unsigned int i = 0; i < u.n_blocks(); ++i)
+          result[i] = u.block(i) * v.block(i);
+      }
+    };
+
+
+
+    /**
+     * Computes the inner products for LinearAlgebra::distributed::BlockVector
+     * with a single global reduction for all blocks.
+     */
+    template <typename Number>
+    struct BlockwiseInnerProducts<
+      LinearAlgebra::distributed::BlockVector<Number>>
+    {
+      static void
+      compute(const ArrayView<Number> &                              result,
+              const LinearAlgebra::distributed::BlockVector<Number> &u,
+              const LinearAlgebra::distributed::BlockVector<Number> &v)
+      {
+        u.blockwise_inner_product(result, v);
+      }
+    };
+  } // namespace SolverCGMultipleRHSImplementation
+} // namespace internal
+
+
+
+template <typename VectorType>
+SolverCGMultipleRHS<VectorType>::SolverCGMultipleRHS(
+  SolverControl &           cn,
+  VectorMemory<VectorType> &mem,
+  const AdditionalData &    data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+SolverCGMultipleRHS<VectorType>::SolverCGMultipleRHS(
+  SolverControl &       cn,
+  const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverCGMultipleRHS<VectorType>::solve(const MatrixType &        A,
+                                       VectorType &              x,
+                                       const VectorType &        b,
+                                       const PreconditionerType &preconditioner)
+{
+  using number = typename VectorType::value_type;
+  using InnerProducts =
+    internal::SolverCGMultipleRHSImplementation::BlockwiseInnerProducts<
+      VectorType>;
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("cg_multiple_rhs");
+
+  AssertDimension(x.n_blocks(), b.n_blocks());
+  const unsigned int n_blocks = x.n_blocks();
+
+  // Memory allocation
+  typename VectorMemory<VectorType>::Pointer g_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer d_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer h_pointer(this->memory);
+
+  // define some aliases for simpler access, using the notation of SolverCG:
+  // g is the residual, h the preconditioned residual and d the search
+  // direction, which is also used to hold the product of the matrix with the
+  // search direction
+  VectorType &g = *g_pointer;
+  VectorType &d = *d_pointer;
+  VectorType &h = *h_pointer;
+
+  // resize the vectors, but do not set the values since they'd be
+  // overwritten soon anyway.
+  g.reinit(x, true);
+  d.reinit(x, true);
+  h.reinit(x, true);
+
+  std::vector<number> gh(n_blocks), gh_old(n_blocks), dAd(n_blocks),
+    norms(n_blocks);
+  const ArrayView<number> gh_view(gh), dAd_view(dAd), norms_view(norms);
+
+  // compute the largest norm of the residuals of all blocks
+  const auto compute_residual = [&]() {
+    InnerProducts::compute(norms_view, g, g);
+    double res = 0;
+    for (unsigned int i = 0; i < n_blocks; ++i)
+      res = std::max(res, std::sqrt(std::abs(double(norms[i]))));
+    return res;
+  };
+
+  int    it  = 0;
+  double res = -std::numeric_limits<double>::max();
+
+  // compute residual. if vector is zero, then short-circuit the full
+  // computation
+  if (!x.all_zero())
+    {
+      A.vmult(g, x);
+      g.sadd(-1., 1., b);
+    }
+  else
+    g = b;
+  res = compute_residual();
+
+  conv = this->iteration_status(0, res, x);
+  if (conv != SolverControl::iterate)
+    return;
+
+  preconditioner.vmult(h, g);
+  InnerProducts::compute(gh_view, g, h);
+
+  std::vector<number> alpha(n_blocks), beta(n_blocks);
+
+  while (conv == SolverControl::iterate)
+    {
+      ++it;
+
+      // update the search directions. a block with a zero inner product of
+      // the residuals is converged exactly and gets a zero step below
+      if (it == 1)
+        d = h;
+      else
+        for (unsigned int i = 0; i < n_blocks; ++i)
+          {
+            beta[i] = (gh_old[i] != number()) ? gh[i] / gh_old[i] : number();
+            d.block(i).sadd(beta[i], 1., h.block(i));
+          }
+
+      A.vmult(h, d);
+
+      InnerProducts::compute(dAd_view, d, h);
+      for (unsigned int i = 0; i < n_blocks; ++i)
+        {
+          Assert(std::abs(dAd[i]) != 0. || std::abs(gh[i]) == 0.,
+                 ExcDivideByZero());
+          alpha[i] = (dAd[i] != number()) ? gh[i] / dAd[i] : number();
+          x.block(i).add(alpha[i], d.block(i));
+          g.block(i).add(-alpha[i], h.block(i));
+        }
+      res = compute_residual();
+
+      conv = this->iteration_status(it, res, x);
+      if (conv != SolverControl::iterate)
+        break;
+
+      preconditioner.vmult(h, g);
+
+      gh_old = gh;
+      InnerProducts::compute(gh_view, g, h);
+    }
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
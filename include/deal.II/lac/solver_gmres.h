@@ -26,6 +26,7 @@
 
 #include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/householder.h>
+#include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/lapack_full_matrix.h>
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_control.h>
@@ -104,6 +105,53 @@ namespace internal
        */
       std::vector<typename VectorMemory<VectorType>::Pointer> data;
     };
+
+
+
+    /**
+     * Compute the inner products between the first @p n_rows vectors stored
+     * in @p vectors and the @p n_columns vectors starting at index
+     * @p first_column, i.e., <tt>result(i,j) = vectors[i] *
+     * vectors[first_column+j]</tt>. The generic implementation computes one
+     * inner product after the other, whereas the overload for
+     * LinearAlgebra::distributed::Vector accumulates all local contributions
+     * first and combines them with a single global reduction.
+     */
+    template <typename VectorType>
+    void
+    block_inner_products(const TmpVectors<VectorType> &vectors,
+                         const unsigned int            n_rows,
+                         const unsigned int            first_column,
+                         const unsigned int            n_columns,
+                         FullMatrix<double> &          result);
+
+    /**
+     * Compute the inner products of the vector @p vv with the first
+     * @p n_vectors vectors stored in @p vectors and write them into the
+     * first entries of @p h. For vector types that provide a multi_dot()
+     * function, all inner products are computed in a single sweep over
+     * @p vv, otherwise one after the other.
+     */
+    template <typename VectorType>
+    void
+    multi_dot(const VectorType &            vv,
+              const TmpVectors<VectorType> &vectors,
+              const unsigned int            n_vectors,
+              Vector<double> &              h);
+
+    /**
+     * Add the linear combination <tt>factor * sum_i h(i) * vectors[i]</tt> of
+     * the first @p n_vectors vectors stored in @p vectors to @p vv. For
+     * vector types that provide a multi_add() function, this is done in a
+     * single sweep over @p vv, otherwise one vector after the other.
+     */
+    template <typename VectorType>
+    void
+    multi_add(VectorType &                  vv,
+              const double                  factor,
+              const Vector<double> &        h,
+              const TmpVectors<VectorType> &vectors,
+              const unsigned int            n_vectors);
   } // namespace SolverGMRESImplementation
 } // namespace internal
 
@@ -172,6 +220,40 @@ namespace internal
  * will then be called from the solver with the estimates as argument.
  *
  *
+ * <h3>Communication-avoiding s-step variant</h3>
+ *
+ * The classical variant orthogonalizes one new Krylov vector at a time with
+ * the modified Gram-Schmidt algorithm. For parallel vectors, every inner
+ * product of that algorithm is a global reduction, i.e., step $k$ of a
+ * restart cycle involves $k+1$ reductions that can not be combined. When
+ * AdditionalData::s_step_size is set to a number $s>1$, the solver instead
+ * builds $s$ new vectors at once by successive applications of the
+ * (preconditioned) matrix, a so-called matrix powers kernel, and
+ * orthogonalizes the whole block against the previous basis and among
+ * itself with two passes of block classical Gram-Schmidt combined with a
+ * Cholesky QR factorization. The local contributions of all inner products
+ * of one pass are collected into a single global reduction, which reduces
+ * the number of reductions per restart cycle by roughly a factor of $s$.
+ * The Hessenberg matrix of the Arnoldi process is then recovered from the
+ * coefficients of the block orthogonalization by a small change of basis,
+ * such that convergence monitoring, the solution update, and the eigenvalue
+ * estimates work the same way as in the classical variant.
+ *
+ * The matrix powers kernel uses a monomial basis scaled by an estimate of
+ * the norm of the (preconditioned) matrix, whose condition number grows
+ * exponentially with $s$. Whenever the Cholesky factorization detects that
+ * the block has become numerically rank-deficient, the block is truncated
+ * to the vectors that could be orthogonalized safely. Block sizes between
+ * four and eight are usually a good compromise. The s-step variant only
+ * supports the default residual, see AdditionalData::use_default_residual,
+ * and does not use the re-orthogonalization mechanism of the classical
+ * variant.
+ *
+ * The collective computation of inner products is implemented for
+ * LinearAlgebra::distributed::Vector. For other vector types, the algorithm
+ * is still valid but the inner products are computed one at a time.
+ *
+ *
  * @author Wolfgang Bangerth, Guido Kanschat, Ralf Hartmann.
  */
 template <class VectorType = Vector<double>>
@@ -183,16 +265,47 @@ public:
    */
   struct AdditionalData
   {
+    /**
+     * Algorithms for orthogonalizing a new Krylov vector against the
+     * previous basis vectors in the classical variant of the solver.
+     */
+    enum OrthogonalizationStrategy
+    {
+      /**
+       * The modified Gram-Schmidt algorithm. It subtracts the projection
+       * onto one basis vector after the other, which needs one pass through
+       * the new vector and one global reduction per basis vector.
+       */
+      modified_gram_schmidt,
+      /**
+       * The classical Gram-Schmidt algorithm. It computes all projections at
+       * once via the multi_dot() function of the vector classes and subtracts
+       * them via multi_add(), which loads the new vector only once for
+       * several basis vectors and combines all inner products in a single
+       * global reduction. The algorithm is less stable than the modified
+       * Gram-Schmidt algorithm in terms of the orthogonality of the basis,
+       * which is compensated by the same re-orthogonalization mechanism,
+       * see #force_re_orthogonalization.
+       */
+      classical_gram_schmidt
+    };
+
     /**
      * Constructor. By default, set the number of temporary vectors to 30,
      * i.e. do a restart every 28 iterations. Also set preconditioning from
      * left, the residual of the stopping criterion to the default residual,
-     * and re-orthogonalization only if necessary.
+     * re-orthogonalization only if necessary, the variant that computes
+     * one basis vector at a time, and the modified Gram-Schmidt algorithm
+     * for the orthogonalization.
      */
-    explicit AdditionalData(const unsigned int max_n_tmp_vectors     = 30,
-                            const bool         right_preconditioning = false,
-                            const bool         use_default_residual  = true,
-                            const bool force_re_orthogonalization    = false);
+    explicit AdditionalData(
+      const unsigned int              max_n_tmp_vectors          = 30,
+      const bool                      right_preconditioning      = false,
+      const bool                      use_default_residual       = true,
+      const bool                      force_re_orthogonalization = false,
+      const unsigned int              s_step_size                = 1,
+      const OrthogonalizationStrategy orthogonalization_strategy =
+        modified_gram_schmidt);
 
     /**
      * Maximum number of temporary vectors. This parameter controls the size
@@ -223,6 +336,21 @@ public:
      * if necessary.
      */
     bool force_re_orthogonalization;
+
+    /**
+     * Number of Krylov vectors that are generated and orthogonalized as one
+     * block by the communication-avoiding variant of the solver, see the
+     * section on the s-step variant in the documentation of this class. The
+     * default value of one selects the classical algorithm with the modified
+     * Gram-Schmidt orthogonalization.
+     */
+    unsigned int s_step_size;
+
+    /**
+     * Algorithm used to orthogonalize the basis vectors in the classical
+     * variant of the solver.
+     */
+    OrthogonalizationStrategy orthogonalization_strategy;
   };
 
   /**
@@ -411,6 +539,24 @@ protected:
     const boost::signals2::signal<void(int)> &re_orthogonalize_signal =
       boost::signals2::signal<void(int)>());
 
+  /**
+   * Orthogonalize the vector @p vv against the @p dim (orthogonal) vectors
+   * given by the first argument using the classical Gram-Schmidt algorithm,
+   * with the same re-orthogonalization mechanism and arguments as
+   * modified_gram_schmidt().
+   */
+  static double
+  classical_gram_schmidt(
+    const internal::SolverGMRESImplementation::TmpVectors<VectorType>
+      &                                       orthogonal_vectors,
+    const unsigned int                        dim,
+    const unsigned int                        accumulated_iterations,
+    VectorType &                              vv,
+    Vector<double> &                          h,
+    bool &                                    re_orthogonalize,
+    const boost::signals2::signal<void(int)> &re_orthogonalize_signal =
+      boost::signals2::signal<void(int)>());
+
   /**
    * Estimates the eigenvalues from the Hessenberg matrix, H_orig, generated
    * during the inner iterations. Uses these estimate to compute the condition
@@ -427,6 +573,17 @@ protected:
       &                                          hessenberg_signal,
     const boost::signals2::signal<void(double)> &cond_signal);
 
+  /**
+   * Implementation of solve() for the communication-avoiding s-step variant
+   * selected by AdditionalData::s_step_size.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve_s_step(const MatrixType &        A,
+               VectorType &              x,
+               const VectorType &        b,
+               const PreconditionerType &preconditioner);
+
   /**
    * Projected system matrix
    */
@@ -586,6 +743,177 @@ namespace internal
 
 
 
+    // Vector types that provide the functions multi_dot() and multi_add()
+    template <typename VectorType>
+    struct HasMultiVectorOperations : std::false_type
+    {};
+
+    template <typename Number>
+    struct HasMultiVectorOperations<dealii::Vector<Number>> : std::true_type
+    {};
+
+    template <typename Number>
+    struct HasMultiVectorOperations<LinearAlgebra::distributed::Vector<Number>>
+      : std::true_type
+    {};
+
+
+
+    template <typename VectorType>
+    void
+    multi_dot(const VectorType &            vv,
+              const TmpVectors<VectorType> &vectors,
+              const unsigned int            n_vectors,
+              Vector<double> &              h,
+              std::false_type)
+    {
+      for (unsigned int i = 0; i < n_vectors; ++i)
+        h(i) = vv * vectors[i];
+    }
+
+
+
+    template <typename VectorType>
+    void
+    multi_dot(const VectorType &            vv,
+              const TmpVectors<VectorType> &vectors,
+              const unsigned int            n_vectors,
+              Vector<double> &              h,
+              std::true_type)
+    {
+      std::vector<const VectorType *> vector_ptrs(n_vectors);
+      for (unsigned int i = 0; i < n_vectors; ++i)
+        vector_ptrs[i] = &vectors[i];
+      std::vector<typename VectorType::value_type> results(n_vectors);
+      vv.multi_dot(vector_ptrs, results);
+      for (unsigned int i = 0; i < n_vectors; ++i)
+        h(i) = results[i];
+    }
+
+
+
+    template <typename VectorType>
+    void
+    multi_dot(const VectorType &            vv,
+              const TmpVectors<VectorType> &vectors,
+              const unsigned int            n_vectors,
+              Vector<double> &              h)
+    {
+      AssertIndexRange(n_vectors, h.size() + 1);
+      multi_dot(vv,
+                vectors,
+                n_vectors,
+                h,
+                HasMultiVectorOperations<VectorType>());
+    }
+
+
+
+    template <typename VectorType>
+    void
+    multi_add(VectorType &                  vv,
+              const double                  factor,
+              const Vector<double> &        h,
+              const TmpVectors<VectorType> &vectors,
+              const unsigned int            n_vectors,
+              std::false_type)
+    {
+      for (unsigned int i = 0; i < n_vectors; ++i)
+        vv.add(factor * h(i), vectors[i]);
+    }
+
+
+
+    template <typename VectorType>
+    void
+    multi_add(VectorType &                  vv,
+              const double                  factor,
+              const Vector<double> &        h,
+              const TmpVectors<VectorType> &vectors,
+              const unsigned int            n_vectors,
+              std::true_type)
+    {
+      std::vector<const VectorType *> vector_ptrs(n_vectors);
+      std::vector<typename VectorType::value_type> factors(n_vectors);
+      for (unsigned int i = 0; i < n_vectors; ++i)
+        {
+          vector_ptrs[i] = &vectors[i];
+          factors[i]     = factor * h(i);
+        }
+      vv.multi_add(factors, vector_ptrs);
+    }
+
+
+
+    template <typename VectorType>
+    void
+    multi_add(VectorType &                  vv,
+              const double                  factor,
+              const Vector<double> &        h,
+              const TmpVectors<VectorType> &vectors,
+              const unsigned int            n_vectors)
+    {
+      AssertIndexRange(n_vectors, h.size() + 1);
+      multi_add(vv,
+                factor,
+                h,
+                vectors,
+                n_vectors,
+                HasMultiVectorOperations<VectorType>());
+    }
+
+
+
+    template <typename VectorType>
+    void
+    block_inner_products(const TmpVectors<VectorType> &vectors,
+                         const unsigned int            n_rows,
+                         const unsigned int            first_column,
+                         const unsigned int            n_columns,
+                         FullMatrix<double> &          result)
+    {
+      result.reinit(n_rows, n_columns);
+      Vector<double> column(n_rows);
+      for (unsigned int j = 0; j < n_columns; ++j)
+        {
+          multi_dot(vectors[first_column + j], vectors, n_rows, column);
+          for (unsigned int i = 0; i < n_rows; ++i)
+            result(i, j) = column(i);
+        }
+    }
+
+
+
+    template <typename Number>
+    void
+    block_inner_products(
+      const TmpVectors<LinearAlgebra::distributed::Vector<Number>> &vectors,
+      const unsigned int                                            n_rows,
+      const unsigned int first_column,
+      const unsigned int n_columns,
+      FullMatrix<double> &result)
+    {
+      result.reinit(n_rows, n_columns);
+      const unsigned int local_size = vectors[0].local_size();
+      for (unsigned int j = 0; j < n_columns; ++j)
+        {
+          const Number *column = vectors[first_column + j].begin();
+          AssertDimension(vectors[first_column + j].local_size(), local_size);
+          for (unsigned int i = 0; i < n_rows; ++i)
+            {
+              const Number *row = vectors[i].begin();
+              double        sum = 0;
+              for (unsigned int k = 0; k < local_size; ++k)
+                sum += static_cast<double>(row[k]) * column[k];
+              result(i, j) = sum;
+            }
+        }
+
+      Utilities::MPI::sum(result, vectors[0].get_mpi_communicator(), result);
+    }
+
+
+
     // A comparator for better printing eigenvalues
     inline bool
     complex_less_pred(const std::complex<double> &x,
@@ -601,18 +929,24 @@ namespace internal
 
 template <class VectorType>
 inline SolverGMRES<VectorType>::AdditionalData::AdditionalData(
-  const unsigned int max_n_tmp_vectors,
-  const bool         right_preconditioning,
-  const bool         use_default_residual,
-  const bool         force_re_orthogonalization)
+  const unsigned int              max_n_tmp_vectors,
+  const bool                      right_preconditioning,
+  const bool                      use_default_residual,
+  const bool                      force_re_orthogonalization,
+  const unsigned int              s_step_size,
+  const OrthogonalizationStrategy orthogonalization_strategy)
   : max_n_tmp_vectors(max_n_tmp_vectors)
   , right_preconditioning(right_preconditioning)
   , use_default_residual(use_default_residual)
   , force_re_orthogonalization(force_re_orthogonalization)
+  , s_step_size(s_step_size)
+  , orthogonalization_strategy(orthogonalization_strategy)
 {
   Assert(3 <= max_n_tmp_vectors,
          ExcMessage("SolverGMRES needs at least three "
                     "temporary vectors."));
+  Assert(s_step_size > 0,
+         ExcMessage("The s-step size of SolverGMRES must be positive."));
 }
 
 
@@ -737,6 +1071,74 @@ SolverGMRES<VectorType>::modified_gram_schmidt(
 
 
 
+template <class VectorType>
+inline double
+SolverGMRES<VectorType>::classical_gram_schmidt(
+  const internal::SolverGMRESImplementation::TmpVectors<VectorType>
+    &                                       orthogonal_vectors,
+  const unsigned int                        dim,
+  const unsigned int                        accumulated_iterations,
+  VectorType &                              vv,
+  Vector<double> &                          h,
+  bool &                                    reorthogonalize,
+  const boost::signals2::signal<void(int)> &reorthogonalize_signal)
+{
+  Assert(dim > 0, ExcInternalError());
+  const unsigned int inner_iteration = dim - 1;
+
+  // need initial norm for detection of re-orthogonalization, see
+  // modified_gram_schmidt()
+  double     norm_vv_start = 0;
+  const bool consider_reorthogonalize =
+    (reorthogonalize == false) && (inner_iteration % 5 == 4);
+  if (consider_reorthogonalize)
+    norm_vv_start = vv.l2_norm();
+
+  // Orthogonalization: compute all inner products against the (old) vector
+  // vv at once and then subtract all projections at once
+  internal::SolverGMRESImplementation::multi_dot(vv,
+                                                 orthogonal_vectors,
+                                                 dim,
+                                                 h);
+  internal::SolverGMRESImplementation::multi_add(
+    vv, -1., h, orthogonal_vectors, dim);
+  double norm_vv = vv.l2_norm();
+
+  if (consider_reorthogonalize)
+    {
+      if (norm_vv >
+          10. * norm_vv_start *
+            std::sqrt(
+              std::numeric_limits<typename VectorType::value_type>::epsilon()))
+        return norm_vv;
+
+      else
+        {
+          reorthogonalize = true;
+          if (!reorthogonalize_signal.empty())
+            reorthogonalize_signal(accumulated_iterations);
+        }
+    }
+
+  if (reorthogonalize == true)
+    {
+      Vector<double> htmp(dim);
+      internal::SolverGMRESImplementation::multi_dot(vv,
+                                                     orthogonal_vectors,
+                                                     dim,
+                                                     htmp);
+      internal::SolverGMRESImplementation::multi_add(
+        vv, -1., htmp, orthogonal_vectors, dim);
+      for (unsigned int i = 0; i < dim; ++i)
+        h(i) += htmp(i);
+      norm_vv = vv.l2_norm();
+    }
+
+  return norm_vv;
+}
+
+
+
 template <class VectorType>
 inline void
 SolverGMRES<VectorType>::compute_eigs_and_cond(
@@ -803,6 +1205,12 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
   LogStream::Prefix prefix("GMRES");
 
+  if (additional_data.s_step_size > 1)
+    {
+      solve_s_step(A, x, b, preconditioner);
+      return;
+    }
+
   // extra call to std::max to placate static analyzers: coverity rightfully
   // complains that data.max_n_tmp_vectors - 2 may overflow
   const unsigned int n_tmp_vectors =
@@ -955,13 +1363,23 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
           dim = inner_iteration + 1;
 
-          const double s         = modified_gram_schmidt(tmp_vectors,
-                                                 dim,
-                                                 accumulated_iterations,
-                                                 vv,
-                                                 h,
-                                                 re_orthogonalize,
-                                                 re_orthogonalize_signal);
+          const double s =
+            (additional_data.orthogonalization_strategy ==
+             AdditionalData::classical_gram_schmidt) ?
+              classical_gram_schmidt(tmp_vectors,
+                                     dim,
+                                     accumulated_iterations,
+                                     vv,
+                                     h,
+                                     re_orthogonalize,
+                                     re_orthogonalize_signal) :
+              modified_gram_schmidt(tmp_vectors,
+                                    dim,
+                                    accumulated_iterations,
+                                    vv,
+                                    h,
+                                    re_orthogonalize,
+                                    re_orthogonalize_signal);
           h(inner_iteration + 1) = s;
 
           // s=0 is a lucky breakdown, the solver will reach convergence,
@@ -1090,6 +1508,330 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
 
 
+template <class VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverGMRES<VectorType>::solve_s_step(const MatrixType &        A,
+                                      VectorType &              x,
+                                      const VectorType &        b,
+                                      const PreconditionerType &preconditioner)
+{
+  Assert(additional_data.use_default_residual,
+         ExcMessage("The s-step variant of SolverGMRES only supports the "
+                    "default residual as stopping criterion."));
+
+  const unsigned int n_tmp_vectors =
+    std::max(additional_data.max_n_tmp_vectors, 3u);
+  const unsigned int max_basis_size = n_tmp_vectors - 2;
+  const unsigned int s_step_size    = additional_data.s_step_size;
+
+  // Generate an object where basis vectors are stored.
+  internal::SolverGMRESImplementation::TmpVectors<VectorType> tmp_vectors(
+    n_tmp_vectors, this->memory);
+
+  unsigned int accumulated_iterations = 0;
+
+  // The Hessenberg matrix before applying Givens rotations is needed not only
+  // for the eigenvalue estimates, but also to transform the coefficients of
+  // the block orthogonalization into the Arnoldi relation
+  FullMatrix<double> H_orig(n_tmp_vectors, n_tmp_vectors - 1);
+  H.reinit(n_tmp_vectors, n_tmp_vectors - 1);
+
+  dealii::Vector<double> gamma(n_tmp_vectors), ci(n_tmp_vectors - 1),
+    si(n_tmp_vectors - 1), h(n_tmp_vectors - 1);
+
+  // Small matrices of the block orthogonalization: the inner products of one
+  // pass, the accumulated projection coefficients onto the previous basis,
+  // and the accumulated triangular factors of the Cholesky QR
+  // factorization, as well as the Cholesky factor of a single pass
+  FullMatrix<double>     inner_products, C, R, R_pass, tmp;
+  dealii::Vector<double> coefficients(n_tmp_vectors);
+
+  // Tolerance on the part of a block vector that is orthogonal to the
+  // previous vectors relative to its norm (both squared) below which the
+  // vector is considered linearly dependent
+  const double dependency_tolerance =
+    1e4 * std::numeric_limits<double>::epsilon();
+
+  unsigned int dim = 0;
+
+  SolverControl::State iteration_state = SolverControl::iterate;
+  double               last_res        = -std::numeric_limits<double>::max();
+
+  const bool left_precondition = !additional_data.right_preconditioning;
+
+  // define two aliases
+  VectorType &v = tmp_vectors(0, x);
+  VectorType &p = tmp_vectors(n_tmp_vectors - 1, x);
+
+  do
+    {
+      if (left_precondition)
+        {
+          A.vmult(p, x);
+          p.sadd(-1., 1., b);
+          preconditioner.vmult(v, p);
+        }
+      else
+        {
+          A.vmult(v, x);
+          v.sadd(-1., 1., b);
+        };
+
+      double rho = v.l2_norm();
+
+      last_res        = rho;
+      iteration_state = this->iteration_status(accumulated_iterations, rho, x);
+
+      if (iteration_state != SolverControl::iterate)
+        break;
+
+      gamma(0) = rho;
+
+      v *= 1. / rho;
+
+      // Scaling of the monomial basis, estimated by the norm of the first
+      // matrix-vector product in each restart cycle
+      double scaling   = 0.;
+      bool   breakdown = false;
+
+      dim = 0;
+      while (dim < max_basis_size && iteration_state == SolverControl::iterate &&
+             !breakdown)
+        {
+          // index of the last orthonormal basis vector, from which the next
+          // block is started
+          const unsigned int j = dim;
+          const unsigned int n_block =
+            std::min(s_step_size, max_basis_size - j);
+
+          // matrix powers kernel
+          for (unsigned int k = 1; k <= n_block; ++k)
+            {
+              VectorType &vv = tmp_vectors(j + k, x);
+              if (left_precondition)
+                {
+                  A.vmult(p, tmp_vectors[j + k - 1]);
+                  preconditioner.vmult(vv, p);
+                }
+              else
+                {
+                  preconditioner.vmult(p, tmp_vectors[j + k - 1]);
+                  A.vmult(vv, p);
+                }
+              if (scaling == 0.)
+                {
+                  scaling = vv.l2_norm();
+                  if (scaling == 0.)
+                    scaling = 1.;
+                }
+              vv *= 1. / scaling;
+            }
+
+          // Block orthogonalization with two passes of classical Gram-Schmidt
+          // and Cholesky QR. Before each pass, the block $W$ generated above
+          // is represented as $W = V C + Q R$ in terms of the previous basis
+          // $V$ and the current content $Q$ of the block vectors.
+          unsigned int n_accepted = n_block;
+          C.reinit(j + 1, n_block);
+          R.reinit(n_block, n_block);
+          for (unsigned int i = 0; i < n_block; ++i)
+            R(i, i) = 1.;
+
+          for (unsigned int pass = 0; pass < 2 && n_accepted > 0; ++pass)
+            {
+              internal::SolverGMRESImplementation::block_inner_products(
+                tmp_vectors,
+                j + 1 + n_accepted,
+                j + 1,
+                n_accepted,
+                inner_products);
+
+              // project out the previous basis
+              for (unsigned int c = 0; c < n_accepted; ++c)
+                {
+                  for (unsigned int i = 0; i <= j; ++i)
+                    coefficients(i) = inner_products(i, c);
+                  internal::SolverGMRESImplementation::multi_add(
+                    tmp_vectors[j + 1 + c],
+                    -1.,
+                    coefficients,
+                    tmp_vectors,
+                    j + 1);
+                }
+
+              // Cholesky factorization of the Gram matrix of the projected
+              // vectors, which is obtained from the inner products of the
+              // unprojected ones by Pythagoras' theorem. The factorization is
+              // truncated at the first vector that is numerically linearly
+              // dependent of the previous ones.
+              R_pass.reinit(n_accepted, n_accepted);
+              unsigned int n_factorized = n_accepted;
+              for (unsigned int c = 0; c < n_accepted; ++c)
+                {
+                  for (unsigned int r = 0; r <= c; ++r)
+                    {
+                      double entry = inner_products(j + 1 + r, c);
+                      for (unsigned int i = 0; i <= j; ++i)
+                        entry -= inner_products(i, r) * inner_products(i, c);
+                      for (unsigned int l = 0; l < r; ++l)
+                        entry -= R_pass(l, r) * R_pass(l, c);
+                      if (r < c)
+                        R_pass(r, c) = entry / R_pass(r, r);
+                      else if (entry > dependency_tolerance *
+                                         inner_products(j + 1 + c, c))
+                        R_pass(c, c) = std::sqrt(entry);
+                    }
+                  if (R_pass(c, c) == 0.)
+                    {
+                      n_factorized = c;
+                      break;
+                    }
+                }
+
+              // $Q = Q R_{pass}^{-1}$
+              for (unsigned int c = 0; c < n_factorized; ++c)
+                {
+                  VectorType &vv = tmp_vectors[j + 1 + c];
+                  for (unsigned int r = 0; r < c; ++r)
+                    vv.add(-R_pass(r, c), tmp_vectors[j + 1 + r]);
+                  vv *= 1. / R_pass(c, c);
+                }
+
+              // accumulate the coefficients, $C = C + C_{pass} R$ and
+              // $R = R_{pass} R$
+              for (unsigned int c = 0; c < n_accepted; ++c)
+                for (unsigned int i = 0; i <= j; ++i)
+                  for (unsigned int l = 0; l <= c; ++l)
+                    C(i, c) += inner_products(i, l) * R(l, c);
+              tmp = R;
+              for (unsigned int c = 0; c < n_factorized; ++c)
+                for (unsigned int r = 0; r <= c; ++r)
+                  {
+                    double entry = 0.;
+                    for (unsigned int l = r; l <= c; ++l)
+                      entry += R_pass(r, l) * tmp(l, c);
+                    R(r, c) = entry;
+                  }
+
+              n_accepted = n_factorized;
+            }
+
+          // If not even the first vector of the block is linearly independent
+          // of the previous basis, we have a (lucky) breakdown: the Krylov
+          // space is invariant and we only add the last column to the
+          // Hessenberg matrix, with a zero entry below the diagonal.
+          if (n_accepted == 0)
+            {
+              breakdown = true;
+              for (unsigned int i = 0; i < n_block; ++i)
+                R(i, 0) = 0.;
+            }
+
+          // Translate the factorization $M A Z = s W = V (s C) + Q (s R)$ of
+          // the basis $Z = [v_j, w_1, \ldots, w_{k-1}]$ of the matrix powers
+          // kernel into the Arnoldi relation $M A V = V H$ column by column,
+          // using that $Z$ can be expressed in terms of the basis vectors
+          // collected so far via the coefficients in $C$ and $R$
+          const unsigned int n_columns = std::max(n_accepted, 1u);
+          for (unsigned int m = 0; m < n_columns; ++m)
+            {
+              const unsigned int col = j + m;
+              h.reinit(n_tmp_vectors - 1);
+              for (unsigned int i = 0; i <= j; ++i)
+                h(i) = scaling * C(i, m);
+              for (unsigned int r = 0; r <= m; ++r)
+                h(j + 1 + r) = scaling * R(r, m);
+
+              if (m > 0)
+                {
+                  for (unsigned int i = 0; i <= j; ++i)
+                    for (unsigned int l = 0; l < j; ++l)
+                      h(i) -= H_orig(i, l) * C(l, m - 1);
+
+                  // entries of the previous columns of $Z$ in the new basis
+                  // vectors, an upper triangular matrix
+                  for (unsigned int i = 0; i <= col; ++i)
+                    h(i) -= H_orig(i, j) * C(j, m - 1);
+                  for (unsigned int l = 1; l < m; ++l)
+                    for (unsigned int i = 0; i <= j + l + 1; ++i)
+                      h(i) -= H_orig(i, j + l) * R(l - 1, m - 1);
+                  const double diagonal = R(m - 1, m - 1);
+                  for (unsigned int i = 0; i <= col + 1; ++i)
+                    h(i) /= diagonal;
+                }
+
+              for (unsigned int i = 0; i < n_tmp_vectors; ++i)
+                H_orig(i, col) = (i <= col + 1) ? h(i) : 0.;
+
+              ++accumulated_iterations;
+
+              //  Transformation into tridiagonal structure
+              givens_rotation(h, gamma, ci, si, col);
+
+              //  append vector on matrix
+              for (unsigned int i = 0; i <= col; ++i)
+                H(i, col) = h(i);
+
+              dim = col + 1;
+
+              //  default residual
+              rho             = std::fabs(gamma(dim));
+              last_res        = rho;
+              iteration_state =
+                this->iteration_status(accumulated_iterations, rho, x);
+              if (iteration_state != SolverControl::iterate)
+                break;
+            }
+        }
+
+      // end of inner iteration. now calculate the solution from the temporary
+      // vectors
+      h.reinit(dim);
+      H1.reinit(dim + 1, dim);
+
+      for (unsigned int i = 0; i < dim + 1; ++i)
+        for (unsigned int j = 0; j < dim; ++j)
+          H1(i, j) = H(i, j);
+
+      compute_eigs_and_cond(H_orig,
+                            dim,
+                            all_eigenvalues_signal,
+                            all_hessenberg_signal,
+                            condition_number_signal);
+
+      H1.backward(h, gamma);
+
+      if (left_precondition)
+        for (unsigned int i = 0; i < dim; ++i)
+          x.add(h(i), tmp_vectors[i]);
+      else
+        {
+          p = 0.;
+          for (unsigned int i = 0; i < dim; ++i)
+            p.add(h(i), tmp_vectors[i]);
+          preconditioner.vmult(v, p);
+          x.add(1., v);
+        };
+    }
+  while (iteration_state == SolverControl::iterate);
+
+  compute_eigs_and_cond(H_orig,
+                        dim,
+                        eigenvalues_signal,
+                        hessenberg_signal,
+                        condition_number_signal);
+
+  if (!krylov_space_signal.empty())
+    krylov_space_signal(tmp_vectors);
+
+  // in case of failure: throw exception
+  AssertThrow(iteration_state == SolverControl::success,
+              SolverControl::NoConvergence(accumulated_iterations, last_res));
+}
+
+
+
 template <class VectorType>
 boost::signals2::connection
 SolverGMRES<VectorType>::connect_condition_number_slot(
@@ -0,0 +1,393 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_iterative_refinement_h
+#define dealii_solver_iterative_refinement_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/vector_memory.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * This class implements mixed-precision iterative refinement, also known as
+ * defect correction: The residual $r_k = b - Ax_k$ of the linear system is
+ * computed with the operator and vectors of type @p VectorType, typically
+ * in double precision, and the correction $A d_k = r_k$ is solved
+ * approximately by an inner solver of type @p InnerSolverType working with
+ * a lower precision operator and preconditioner, typically in single
+ * precision. The update $x_{k+1} = x_k + d_k$ is again done in the higher
+ * precision. Since the inner solver only needs to reduce the residual by a
+ * moderate factor in each step, it can run entirely in single precision,
+ * which halves the memory traffic of the matrix-vector products and the
+ * preconditioner (e.g. a geometric multigrid cycle on matrix-free
+ * operators), while the outer iteration converges to the accuracy of the
+ * higher precision.
+ *
+ * Each inner solve is asked to reduce the residual by the factor
+ * AdditionalData::inner_reduction, but not by more than what is needed to
+ * meet the tolerance of the SolverControl object of this class, such that
+ * the last inner solve does not do unnecessary work. The residual passed to
+ * the inner solver is scaled to unit norm to stay in the range of the lower
+ * precision number type. An inner solve that does not reach its reduction
+ * within AdditionalData::max_inner_iterations steps is not an error, the
+ * outer iteration simply continues from the correction it computed. The
+ * number of iterations of each inner solve can be queried with
+ * get_inner_iterations() after solve() to assess the cost of the solution.
+ *
+ * The conversion between the vector types is done with
+ * LinearAlgebra::distributed::Vector::copy_locally_owned_data_from() for
+ * LinearAlgebra::distributed::Vector, and by the converting assignment
+ * operator for all other vector types.
+ *
+ * The norm of the residual of the outer iteration is used to determine
+ * convergence via the mechanism described in the Solver base class.
+ *
+ * A typical use with matrix-free operators in double and float precision
+ * and a multigrid preconditioner built on the float operators reads:
+ * @code
+ * SolverControl control(100, 1e-10 * system_rhs.l2_norm());
+ * SolverIterativeRefinement<LinearAlgebra::distributed::Vector<double>>
+ *   solver(control);
+ * solver.solve(system_matrix_double,
+ *              solution,
+ *              system_rhs,
+ *              system_matrix_float,
+ *              multigrid_preconditioner_float);
+ * @endcode
+ */
+template <typename VectorType = LinearAlgebra::distributed::Vector<double>,
+          typename InnerSolverType =
+            SolverCG<LinearAlgebra::distributed::Vector<float>>>
+class SolverIterativeRefinement : public SolverBase<VectorType>
+{
+public:
+  /**
+   * The vector type of the inner solver.
+   */
+  using inner_vector_type = typename InnerSolverType::vector_type;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor. The default values are suitable for an inner solver in
+     * single precision.
+     */
+    explicit AdditionalData(const double       inner_reduction      = 1e-4,
+                            const unsigned int max_inner_iterations = 1000)
+      : inner_reduction(inner_reduction)
+      , max_inner_iterations(max_inner_iterations)
+    {}
+
+    /**
+     * The factor by which each inner solve should reduce the residual. It
+     * should be well above the machine accuracy of the number type of the
+     * inner solver.
+     */
+    double inner_reduction;
+
+    /**
+     * The maximal number of iterations of each inner solve.
+     */
+    unsigned int max_inner_iterations;
+  };
+
+  /**
+   * Constructor.
+   */
+  SolverIterativeRefinement(SolverControl &           cn,
+                            VectorMemory<VectorType> &mem,
+                            const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverIterativeRefinement(SolverControl &       cn,
+                            const AdditionalData &data = AdditionalData());
+
+  /**
+   * Virtual destructor.
+   */
+  virtual ~SolverIterativeRefinement() override = default;
+
+  /**
+   * Solve the linear system $Ax=b$ for x. The residuals are computed with
+   * @p A, the corrections with the inner solver applied to @p inner_A and
+   * @p inner_preconditioner, which represent the same operator as @p A in
+   * the lower precision.
+   */
+  template <typename MatrixType,
+            typename InnerMatrixType,
+            typename InnerPreconditionerType>
+  void
+  solve(const MatrixType &             A,
+        VectorType &                   x,
+        const VectorType &             b,
+        const InnerMatrixType &        inner_A,
+        const InnerPreconditionerType &inner_preconditioner);
+
+  /**
+   * Return the number of iterations of each inner solve of the last call to
+   * solve().
+   */
+  const std::vector<unsigned int> &
+  get_inner_iterations() const;
+
+protected:
+  /**
+   * The control object of the outer iteration, which determines the
+   * reduction requested from the inner solves.
+   */
+  SolverControl &solver_control;
+
+  /**
+   * Additional parameters.
+   */
+  AdditionalData additional_data;
+
+  /**
+   * The number of iterations of each inner solve.
+   */
+  std::vector<unsigned int> inner_iterations;
+};
+
+/*@}*/
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+namespace internal
+{
+  namespace SolverIterativeRefinementImplementation
+  {
+    /**
+     * Set @p dst to @p src, converting the number type.
+     */
+    template <typename VectorType, typename VectorType2>
+    void
+    copy(VectorType &dst, const VectorType2 &src)
+    {
+      dst = src;
+    }
+
+
+
+    /**
+     * Same as above for LinearAlgebra::distributed::Vector, where only the
+     * locally owned entries are copied. The layout of @p src is adopted
+     * if @p dst does not share its partitioner.
+     */
+    template <typename Number, typename Number2>
+    void
+    copy(LinearAlgebra::distributed::Vector<Number> &        dst,
+         const LinearAlgebra::distributed::Vector<Number2> &src)
+    {
+      if (dst.get_partitioner() != src.get_partitioner())
+        dst.reinit(src.get_partitioner(), true);
+      dst.copy_locally_owned_data_from(src);
+    }
+
+
+
+    /**
+     * Add @p factor times @p correction to @p x, using @p tmp as scratch
+     * space for the conversion of the number type.
+     */
+    template <typename VectorType, typename InnerVectorType>
+    void
+    add_correction(VectorType &           x,
+                   const double           factor,
+                   const InnerVectorType &correction,
+                   VectorType &           tmp)
+    {
+      tmp = correction;
+      x.add(factor, tmp);
+    }
+
+
+
+    /**
+     * Same as above for LinearAlgebra::distributed::Vector, where the
+     * correction is added in a single pass through the locally owned
+     * entries without a temporary vector.
+     */
+    template <typename Number, typename Number2>
+    void
+    add_correction(
+      LinearAlgebra::distributed::Vector<Number> &        x,
+      const double                                       factor,
+      const LinearAlgebra::distributed::Vector<Number2> &correction,
+      LinearAlgebra::distributed::Vector<Number> &)
+    {
+      AssertDimension(x.local_size(), correction.local_size());
+      Number *           x_ptr          = x.begin();
+      const Number2 *    correction_ptr = correction.begin();
+      const unsigned int n_entries      = x.local_size();
+      const Number       scaling        = factor;
+      for (unsigned int i = 0; i < n_entries; ++i)
+        x_ptr[i] += scaling * static_cast<Number>(correction_ptr[i]);
+
+      if (x.has_ghost_elements())
+        x.update_ghost_values();
+    }
+  } // namespace SolverIterativeRefinementImplementation
+} // namespace internal
+
+
+
+template <typename VectorType, typename InnerSolverType>
+SolverIterativeRefinement<VectorType, InnerSolverType>::
+  SolverIterativeRefinement(SolverControl &           cn,
+                            VectorMemory<VectorType> &mem,
+                            const AdditionalData &    data)
+  : SolverBase<VectorType>(cn, mem)
+  , solver_control(cn)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType, typename InnerSolverType>
+SolverIterativeRefinement<VectorType, InnerSolverType>::
+  SolverIterativeRefinement(SolverControl &cn, const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , solver_control(cn)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType, typename InnerSolverType>
+template <typename MatrixType,
+          typename InnerMatrixType,
+          typename InnerPreconditionerType>
+void
+SolverIterativeRefinement<VectorType, InnerSolverType>::solve(
+  const MatrixType &             A,
+  VectorType &                   x,
+  const VectorType &             b,
+  const InnerMatrixType &        inner_A,
+  const InnerPreconditionerType &inner_preconditioner)
+{
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("IterativeRefinement");
+
+  inner_iterations.clear();
+
+  // Memory allocation
+  typename VectorMemory<VectorType>::Pointer r_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer tmp_pointer(this->memory);
+  VectorType &                               r   = *r_pointer;
+  VectorType &                               tmp = *tmp_pointer;
+  r.reinit(x, true);
+  tmp.reinit(x, true);
+
+  GrowingVectorMemory<inner_vector_type>            inner_memory;
+  typename VectorMemory<inner_vector_type>::Pointer inner_r_pointer(
+    inner_memory);
+  typename VectorMemory<inner_vector_type>::Pointer inner_x_pointer(
+    inner_memory);
+  inner_vector_type &inner_r = *inner_r_pointer;
+  inner_vector_type &inner_x = *inner_x_pointer;
+
+  unsigned int it  = 0;
+  double       res = -std::numeric_limits<double>::max();
+  while (true)
+    {
+      // compute the residual in the higher precision
+      A.vmult(r, x);
+      r.sadd(-1., 1., b);
+      res = r.l2_norm();
+
+      conv = this->iteration_status(it, res, x);
+      if (conv != SolverControl::iterate)
+        break;
+
+      // solve for the correction in the lower precision, with the residual
+      // scaled to unit norm before the conversion to avoid underflow. do
+      // not ask for a larger reduction than what is needed to reach the
+      // tolerance of the outer iteration
+      r *= 1. / res;
+      internal::SolverIterativeRefinementImplementation::copy(inner_r, r);
+      inner_x.reinit(inner_r);
+
+      const double reduction =
+        std::min(1.,
+                 std::max(additional_data.inner_reduction,
+                          0.5 * solver_control.tolerance() / res));
+      ReductionControl inner_control(
+        additional_data.max_inner_iterations, 0., reduction, false, false);
+      InnerSolverType inner_solver(inner_control);
+      try
+        {
+          inner_solver.solve(inner_A, inner_x, inner_r, inner_preconditioner);
+        }
+      catch (SolverControl::NoConvergence &)
+        {}
+      inner_iterations.push_back(inner_control.last_step());
+      deallog << "Inner solve: " << inner_control.last_step()
+              << " iterations" << std::endl;
+
+      // add the correction in the higher precision
+      internal::SolverIterativeRefinementImplementation::add_correction(
+        x, res, inner_x, tmp);
+      ++it;
+    }
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+
+
+template <typename VectorType, typename InnerSolverType>
+const std::vector<unsigned int> &
+SolverIterativeRefinement<VectorType, InnerSolverType>::get_inner_iterations()
+  const
+{
+  return inner_iterations;
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
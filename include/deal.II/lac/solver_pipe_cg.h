@@ -0,0 +1,383 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_pipe_cg_h
+#define dealii_solver_pipe_cg_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <array>
+#include <cmath>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * This class implements the pipelined variant of the preconditioned
+ * Conjugate Gradient method by P. Ghysels and W. Vanroose, "Hiding global
+ * synchronization latency in the preconditioned Conjugate Gradient
+ * algorithm", Parallel Computing 40 (2014), pp. 224-238. Like SolverCG, it
+ * solves linear systems with a symmetric positive definite matrix and a
+ * symmetric positive definite preconditioner.
+ *
+ * In exact arithmetic, the method computes the same iterates as SolverCG.
+ * The difference lies in the global communication: The classical method
+ * needs two inner products per iteration that each depend on the result of
+ * the previous operation, i.e., two global reductions that can not be
+ * overlapped with other work. The pipelined variant reformulates the
+ * recurrences with additional auxiliary vectors such that all three inner
+ * products of an iteration (two for the coefficients and one for the norm of
+ * the residual used for the convergence check) are computed at once, and the
+ * single global reduction can proceed while the preconditioner and the matrix
+ * are applied. This hides the latency of the reduction on large processor
+ * counts where it would otherwise dominate the solution time.
+ *
+ * The price are eight vector updates per iteration instead of three, five
+ * more auxiliary vectors, one additional matrix-vector product and
+ * preconditioner application at the point where convergence is detected, and
+ * a somewhat larger sensitivity to round-off errors because the residual is
+ * only computed through recurrences. The method is thus beneficial when the
+ * latency of global reductions is the limiting factor, not for small
+ * processor counts.
+ *
+ * The reduction is only overlapped with the other operations for
+ * LinearAlgebra::distributed::Vector with @p double or @p float entries on
+ * MemorySpace::Host, using MPI_Iallreduce() from MPI 3.0. For all other
+ * vector types, the same algorithm is run with the usual blocking inner
+ * products.
+ *
+ * As for SolverCG, the norm of the (unpreconditioned) residual is used to
+ * determine convergence via the mechanism described in the Solver base class.
+ * There is no AdditionalData for this class.
+ */
+template <typename VectorType = Vector<double>>
+class SolverPipeCG : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   * Here, it doesn't store anything but just exists for consistency
+   * with the other solver classes.
+   */
+  struct AdditionalData
+  {};
+
+  /**
+   * Constructor.
+   */
+  SolverPipeCG(SolverControl &           cn,
+               VectorMemory<VectorType> &mem,
+               const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverPipeCG(SolverControl &       cn,
+               const AdditionalData &data = AdditionalData());
+
+  /**
+   * Virtual destructor.
+   */
+  virtual ~SolverPipeCG() override = default;
+
+  /**
+   * Solve the linear system $Ax=b$ for x.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        VectorType &              x,
+        const VectorType &        b,
+        const PreconditionerType &preconditioner);
+
+protected:
+  /**
+   * Additional parameters.
+   */
+  AdditionalData additional_data;
+};
+
+/*@}*/
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+namespace internal
+{
+  namespace SolverPipeCGImplementation
+  {
+    /**
+     * Computes the inner products $(r,u)$, $(w,u)$ and $(r,r)$ of one
+     * iteration of the pipelined CG method. For general vector types, the
+     * inner products are computed in start() and finish() does nothing.
+     */
+    template <typename VectorType>
+    struct InnerProducts
+    {
+      void
+      start(const VectorType &r, const VectorType &u, const VectorType &w)
+      {
+        values[0] = r * u;
+        values[1] = w * u;
+        values[2] = r * r;
+      }
+
+      void
+      finish()
+      {}
+
+      std::array<typename VectorType::value_type, 3> values;
+    };
+
+
+
+    /**
+     * Computes the inner products for LinearAlgebra::distributed::Vector in
+     * a single pass through the locally owned entries and starts a
+     * non-blocking reduction that is completed in finish().
+     */
+    template <typename Number>
+    struct DistributedInnerProducts
+    {
+      void
+      start(const LinearAlgebra::distributed::Vector<Number> &r,
+            const LinearAlgebra::distributed::Vector<Number> &u,
+            const LinearAlgebra::distributed::Vector<Number> &w)
+      {
+        AssertDimension(r.local_size(), u.local_size());
+        AssertDimension(r.local_size(), w.local_size());
+        const Number *r_ptr = r.begin();
+        const Number *u_ptr = u.begin();
+        const Number *w_ptr = w.begin();
+        Number        ru = 0, wu = 0, rr = 0;
+        for (unsigned int i = 0; i < r.local_size(); ++i)
+          {
+            ru += r_ptr[i] * u_ptr[i];
+            wu += w_ptr[i] * u_ptr[i];
+            rr += r_ptr[i] * r_ptr[i];
+          }
+        values = {{ru, wu, rr}};
+
+        const MPI_Comm &communicator = r.get_mpi_communicator();
+        if (Utilities::MPI::n_mpi_processes(communicator) > 1)
+          reduction = Utilities::MPI::isum(
+            ArrayView<const Number>(values.data(), values.size()),
+            communicator);
+      }
+
+      void
+      finish()
+      {
+        if (reduction.size() > 0)
+          {
+            const ArrayView<const Number> sums = reduction.get_all();
+            std::copy(sums.begin(), sums.end(), values.begin());
+            reduction = Utilities::MPI::ReductionFuture<Number>();
+          }
+      }
+
+      std::array<Number, 3> values;
+
+      Utilities::MPI::ReductionFuture<Number> reduction;
+    };
+
+
+
+    template <>
+    struct InnerProducts<LinearAlgebra::distributed::Vector<double>>
+      : public DistributedInnerProducts<double>
+    {};
+
+
+
+    template <>
+    struct InnerProducts<LinearAlgebra::distributed::Vector<float>>
+      : public DistributedInnerProducts<float>
+    {};
+  } // namespace SolverPipeCGImplementation
+} // namespace internal
+
+
+
+template <typename VectorType>
+SolverPipeCG<VectorType>::SolverPipeCG(SolverControl &           cn,
+                                       VectorMemory<VectorType> &mem,
+                                       const AdditionalData &    data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+SolverPipeCG<VectorType>::SolverPipeCG(SolverControl &       cn,
+                                       const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverPipeCG<VectorType>::solve(const MatrixType &        A,
+                                VectorType &              x,
+                                const VectorType &        b,
+                                const PreconditionerType &preconditioner)
+{
+  using number = typename VectorType::value_type;
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("pipe_cg");
+
+  // Memory allocation
+  typename VectorMemory<VectorType>::Pointer r_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer u_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer w_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer m_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer n_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer p_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer s_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer q_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer z_pointer(this->memory);
+
+  // define some aliases for simpler access, using the notation of the paper
+  // by Ghysels and Vanroose: r is the residual, u the preconditioned
+  // residual, w = A u, m = P^{-1} w, n = A m, and p, s = A p, q = P^{-1} s,
+  // z = A q are the search direction and its transformations
+  VectorType &r = *r_pointer;
+  VectorType &u = *u_pointer;
+  VectorType &w = *w_pointer;
+  VectorType &m = *m_pointer;
+  VectorType &n = *n_pointer;
+  VectorType &p = *p_pointer;
+  VectorType &s = *s_pointer;
+  VectorType &q = *q_pointer;
+  VectorType &z = *z_pointer;
+
+  // resize the vectors, but do not set the values since they'd be
+  // overwritten soon anyway.
+  r.reinit(x, true);
+  u.reinit(x, true);
+  w.reinit(x, true);
+  m.reinit(x, true);
+  n.reinit(x, true);
+  p.reinit(x, true);
+  s.reinit(x, true);
+  q.reinit(x, true);
+  z.reinit(x, true);
+
+  // compute residual. if vector is zero, then short-circuit the full
+  // computation
+  if (!x.all_zero())
+    {
+      A.vmult(r, x);
+      r.sadd(-1., 1., b);
+    }
+  else
+    r = b;
+
+  preconditioner.vmult(u, r);
+  A.vmult(w, u);
+
+  internal::SolverPipeCGImplementation::InnerProducts<VectorType> products;
+
+  unsigned int it        = 0;
+  double       res       = -std::numeric_limits<double>::max();
+  number       gamma_old = 0;
+  number       alpha_old = 0;
+  number       alpha     = 0;
+
+  while (true)
+    {
+      // start the reduction and hide its latency behind the preconditioner
+      // and the matrix-vector product
+      products.start(r, u, w);
+      preconditioner.vmult(m, w);
+      A.vmult(n, m);
+      products.finish();
+
+      const number gamma = products.values[0];
+      const number delta = products.values[1];
+      res                = std::sqrt(std::abs(products.values[2]));
+
+      conv = this->iteration_status(it, res, x);
+      if (conv != SolverControl::iterate)
+        break;
+
+      if (it == 0)
+        {
+          Assert(std::abs(delta) != 0., ExcDivideByZero());
+          alpha = gamma / delta;
+          z     = n;
+          q     = m;
+          s     = w;
+          p     = u;
+        }
+      else
+        {
+          Assert(std::abs(gamma_old) != 0., ExcDivideByZero());
+          const number beta        = gamma / gamma_old;
+          const number denominator = delta - beta * gamma / alpha_old;
+          Assert(std::abs(denominator) != 0., ExcDivideByZero());
+          alpha = gamma / denominator;
+          z.sadd(beta, 1., n);
+          q.sadd(beta, 1., m);
+          s.sadd(beta, 1., w);
+          p.sadd(beta, 1., u);
+        }
+
+      x.add(alpha, p);
+      r.add(-alpha, s);
+      u.add(-alpha, q);
+      w.add(-alpha, z);
+
+      gamma_old = gamma;
+      alpha_old = alpha;
+      ++it;
+    }
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, res));
+  // otherwise exit as normal
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
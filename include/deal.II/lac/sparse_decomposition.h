@@ -18,6 +18,8 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/parallel.h>
+
 #include <deal.II/lac/sparse_matrix.h>
 
 #include <cmath>
@@ -93,6 +95,28 @@ DEAL_II_NAMESPACE_OPEN
  * <code>*use_this_sparsity</code> is used to store the decomposed matrix. For
  * restrictions on the sparsity see section `Fill-in' above).
  *
+ * 5/ By setting <code>use_level_scheduling=true</code>, the triangular
+ * solves in the vmult() functions of derived classes are run in parallel on
+ * the threads available to the library. To this end, the rows of the lower
+ * and upper triangular factors are grouped into levels such that all rows of
+ * a level only depend on rows in previous levels, and all rows in a level are
+ * processed concurrently. The result is the same as for the sequential
+ * solves up to roundoff. How much parallelism is available depends on the
+ * sparsity pattern and the numbering of the unknowns: for a matrix from a
+ * finite element discretization numbered in Cuthill-McKee order, the number
+ * of levels is roughly the bandwidth of the matrix, whereas a numbering by
+ * colors (e.g. from GraphColoring) results in only a few levels with many
+ * rows each.
+ *
+ * 6/ SparseILU additionally supports computing the factorization itself in
+ * parallel by <code>n_parallel_factorization_sweeps</code> sweeps of the
+ * fixed-point iteration by E. Chow and A. Patel ("Fine-grained parallel
+ * incomplete LU factorization", SIAM J. Sci. Comput. 37 (2015), C169-C193).
+ * All entries of the factors are updated independently of each other in
+ * each sweep, starting from the entries of the matrix. The result converges
+ * to the sequentially computed factorization as the number of sweeps grows,
+ * but a few sweeps are usually enough for a good preconditioner.
+ *
  *
  * <h3>Particular implementations</h3>
  *
@@ -150,7 +174,9 @@ public:
     AdditionalData(const double           strengthen_diagonal   = 0,
                    const unsigned int     extra_off_diagonals   = 0,
                    const bool             use_previous_sparsity = false,
-                   const SparsityPattern *use_this_sparsity     = nullptr);
+                   const SparsityPattern *use_this_sparsity     = nullptr,
+                   const bool             use_level_scheduling  = false,
+                   const unsigned int     n_parallel_factorization_sweeps = 0);
 
     /**
      * <code>strengthen_diag</code> times the sum of absolute row entries is
@@ -193,6 +219,22 @@ public:
      * matrix.
      */
     const SparsityPattern *use_this_sparsity;
+
+    /**
+     * If this flag is true, the forward and backward substitutions in
+     * vmult() are done in parallel over the rows of each level of a level
+     * schedule of the triangular factors. See the class documentation for
+     * details.
+     */
+    bool use_level_scheduling;
+
+    /**
+     * If nonzero, derived classes that support it (currently SparseILU)
+     * compute the factorization in parallel by this many sweeps of the
+     * fixed-point iteration of Chow and Patel instead of the exact
+     * sequential algorithm. Zero selects the sequential algorithm.
+     */
+    unsigned int n_parallel_factorization_sweeps;
   };
 
   /**
@@ -328,6 +370,54 @@ protected:
   void
   prebuild_lower_bound();
 
+  /**
+   * Group the rows into the levels of the forward and backward
+   * substitution, filling #lower_level_rows, #lower_level_starts,
+   * #upper_level_rows, and #upper_level_starts. Needs
+   * #prebuilt_lower_bound.
+   */
+  void
+  compute_level_schedule();
+
+  /**
+   * Call @p row_worker for each row in @p level_rows, one level after the
+   * other in the order given by @p level_starts, and for the rows within a
+   * level in parallel. If no level schedule has been computed, i.e., if
+   * @p level_starts is empty, call @p row_worker
+   * sequentially in the order given by @p forward.
+   */
+  template <typename RowWorker>
+  void
+  apply_by_level(const std::vector<size_type> &level_rows,
+                 const std::vector<size_type> &level_starts,
+                 const bool                    forward,
+                 const RowWorker &             row_worker) const;
+
+  /**
+   * The rows of the matrix sorted by the level of the forward substitution
+   * with the lower triangular factor. Empty unless a level schedule has been
+   * requested via AdditionalData::use_level_scheduling.
+   */
+  std::vector<size_type> lower_level_rows;
+
+  /**
+   * The position in #lower_level_rows where each level starts, with one
+   * additional entry marking the end of the last level.
+   */
+  std::vector<size_type> lower_level_starts;
+
+  /**
+   * Same as #lower_level_rows for the backward substitution with the upper
+   * triangular factor.
+   */
+  std::vector<size_type> upper_level_rows;
+
+  /**
+   * Same as #lower_level_starts for the backward substitution with the
+   * upper triangular factor.
+   */
+  std::vector<size_type> upper_level_starts;
+
 private:
   /**
    * In general this pointer is zero except for the case that no
@@ -412,6 +502,42 @@ SparseLUDecomposition<number>::Tvmult_add(OutVector &     dst,
   dst += tmp;
 }
 
+
+
+template <typename number>
+template <typename RowWorker>
+inline void
+SparseLUDecomposition<number>::apply_by_level(
+  const std::vector<size_type> &level_rows,
+  const std::vector<size_type> &level_starts,
+  const bool                    forward,
+  const RowWorker &             row_worker) const
+{
+  if (level_starts.empty())
+    {
+      const size_type N = this->m();
+      if (forward)
+        for (size_type row = 0; row < N; ++row)
+          row_worker(row);
+      else
+        for (size_type row = N; row > 0;)
+          row_worker(--row);
+      return;
+    }
+
+  // levels with fewer rows than the grain size are processed by a single
+  // thread
+  for (unsigned int level = 0; level + 1 < level_starts.size(); ++level)
+    parallel::apply_to_subranges(
+      level_starts[level],
+      level_starts[level + 1],
+      [&](const size_type begin, const size_type end) {
+        for (size_type i = begin; i < end; ++i)
+          row_worker(level_rows[i]);
+      },
+      internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+}
+
 //---------------------------------------------------------------------------
 
 
@@ -420,11 +546,15 @@ SparseLUDecomposition<number>::AdditionalData::AdditionalData(
   const double           strengthen_diag,
   const unsigned int     extra_off_diag,
   const bool             use_prev_sparsity,
-  const SparsityPattern *use_this_spars)
+  const SparsityPattern *use_this_spars,
+  const bool             use_level_sched,
+  const unsigned int     n_parallel_sweeps)
   : strengthen_diagonal(strengthen_diag)
   , extra_off_diagonals(extra_off_diag)
   , use_previous_sparsity(use_prev_sparsity)
   , use_this_sparsity(use_this_spars)
+  , use_level_scheduling(use_level_sched)
+  , n_parallel_factorization_sweeps(n_parallel_sweeps)
 {}
 
 
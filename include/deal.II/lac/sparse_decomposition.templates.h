@@ -54,6 +54,10 @@ SparseLUDecomposition<number>::clear()
 {
   std::vector<const size_type *> tmp;
   tmp.swap(prebuilt_lower_bound);
+  lower_level_rows.clear();
+  lower_level_starts.clear();
+  upper_level_rows.clear();
+  upper_level_starts.clear();
 
   SparseMatrix<number>::clear();
 
@@ -131,6 +135,10 @@ SparseLUDecomposition<number>::initialize(
     std::vector<const size_type *> tmp;
     tmp.swap(prebuilt_lower_bound);
   }
+  lower_level_rows.clear();
+  lower_level_starts.clear();
+  upper_level_rows.clear();
+  upper_level_starts.clear();
   SparseMatrix<number>::reinit(*sparsity_pattern_to_use);
 }
 
@@ -157,6 +165,66 @@ SparseLUDecomposition<number>::prebuild_lower_bound()
     }
 }
 
+
+
+template <typename number>
+void
+SparseLUDecomposition<number>::compute_level_schedule()
+{
+  Assert(prebuilt_lower_bound.size() == this->m(), ExcNotInitialized());
+
+  const size_type *const column_numbers =
+    this->get_sparsity_pattern().colnums.get();
+  const std::size_t *const rowstart_indices =
+    this->get_sparsity_pattern().rowstart.get();
+  const size_type N = this->m();
+
+  // sort the rows by level with a counting sort, keeping the original order
+  // within each level
+  const auto sort_by_level = [N](const std::vector<unsigned int> &level,
+                                 std::vector<size_type> &         level_rows,
+                                 std::vector<size_type> &level_starts) {
+    const unsigned int n_levels =
+      N > 0 ? *std::max_element(level.begin(), level.end()) + 1 : 0;
+    level_starts.assign(n_levels + 1, 0);
+    for (size_type row = 0; row < N; ++row)
+      ++level_starts[level[row] + 1];
+    for (unsigned int l = 0; l < n_levels; ++l)
+      level_starts[l + 1] += level_starts[l];
+
+    std::vector<size_type> next(level_starts.begin(), level_starts.end() - 1);
+    level_rows.resize(N);
+    for (size_type row = 0; row < N; ++row)
+      level_rows[next[level[row]]++] = row;
+  };
+
+  // in the forward substitution, a row depends on the rows referenced left
+  // of the diagonal, i.e., between the diagonal stored at the first position
+  // and the first entry right of the diagonal
+  std::vector<unsigned int> level(N, 0);
+  for (size_type row = 0; row < N; ++row)
+    for (const size_type *col = &column_numbers[rowstart_indices[row] + 1];
+         col != prebuilt_lower_bound[row];
+         ++col)
+      level[row] = std::max(level[row], level[*col] + 1);
+  sort_by_level(level, lower_level_rows, lower_level_starts);
+
+  // in the backward substitution, a row depends on the rows referenced right
+  // of the diagonal
+  std::fill(level.begin(), level.end(), 0);
+  for (size_type row = N; row > 0;)
+    {
+      --row;
+      for (const size_type *col = prebuilt_lower_bound[row];
+           col != &column_numbers[rowstart_indices[row + 1]];
+           ++col)
+        level[row] = std::max(level[row], level[*col] + 1);
+    }
+  sort_by_level(level, upper_level_rows, upper_level_starts);
+}
+
+
+
 template <typename number>
 template <typename somenumber>
 void
@@ -237,7 +305,11 @@ std::size_t
 SparseLUDecomposition<number>::memory_consumption() const
 {
   return (SparseMatrix<number>::memory_consumption() +
-          MemoryConsumption::memory_consumption(prebuilt_lower_bound));
+          MemoryConsumption::memory_consumption(prebuilt_lower_bound) +
+          MemoryConsumption::memory_consumption(lower_level_rows) +
+          MemoryConsumption::memory_consumption(lower_level_starts) +
+          MemoryConsumption::memory_consumption(upper_level_rows) +
+          MemoryConsumption::memory_consumption(upper_level_starts));
 }
 
 
@@ -24,6 +24,7 @@
 #include <deal.II/base/thread_management.h>
 
 #include <deal.II/lac/block_sparse_matrix.h>
+#include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/sparse_matrix.h>
 #include <deal.II/lac/sparse_matrix_ez.h>
 #include <deal.II/lac/vector.h>
@@ -148,6 +149,14 @@ public:
    * This function copies the contents of the matrix into its own storage; the
    * matrix can therefore be deleted after this operation, even if subsequent
    * solves are required.
+   *
+   * The factorization consists of a symbolic phase that only depends on the
+   * sparsity pattern (the fill-reducing ordering and the analysis of the
+   * elimination tree) and a numeric phase that computes the actual LU
+   * factors. The result of the symbolic phase is kept, and if this function
+   * is called again with a matrix that has exactly the same sparsity pattern
+   * as the previous one, as is typically the case in the steps of a
+   * nonlinear iteration, only the numeric factorization is recomputed.
    */
   template <class Matrix>
   void
@@ -253,6 +262,15 @@ public:
   solve(BlockVector<double> &rhs_and_solution,
         const bool           transpose = false) const;
 
+  /**
+   * Same as before, but for several right hand sides at once, given by the
+   * columns of @p rhs_and_solution. The work arrays of UMFPACK are only
+   * allocated once for all right hand sides.
+   */
+  void
+  solve(FullMatrix<double> &rhs_and_solution,
+        const bool          transpose = false) const;
+
   /**
    * Call the two functions factorize() and solve() in that order, i.e.
    * perform the whole solution process for the given right hand side vector.
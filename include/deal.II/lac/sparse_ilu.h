@@ -41,6 +41,11 @@ DEAL_II_NAMESPACE_OPEN
  * given in the book Y. Saad: "Iterative methods for sparse linear systems",
  * second edition, in section 10.3.2.
  *
+ * Alternatively, the factorization can be computed in parallel by the
+ * fixed-point iteration of Chow and Patel, and the forward and backward
+ * substitutions in vmult() can be parallelized by level scheduling. See the
+ * documentation of SparseLUDecomposition for these options.
+ *
  *
  * <h3>Usage and state management</h3>
  *
@@ -155,6 +160,15 @@ public:
                     "that the matrix for which you try to compute a "
                     "decomposition is singular.");
   //@}
+
+private:
+  /**
+   * Compute the factorization by @p n_sweeps sweeps of the fixed-point
+   * iteration of Chow and Patel, with all entries within one sweep updated in
+   * parallel from the values of the previous sweep.
+   */
+  void
+  compute_parallel_factorization(const unsigned int n_sweeps);
 };
 
 /*@}*/
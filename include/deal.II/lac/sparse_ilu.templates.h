@@ -20,6 +20,9 @@
 
 #  include <deal.II/base/config.h>
 
+#  include <deal.II/base/parallel.h>
+#  include <deal.II/base/utilities.h>
+
 #  include <deal.II/lac/sparse_ilu.h>
 #  include <deal.II/lac/vector.h>
 
@@ -52,6 +55,15 @@ SparseILU<number>::initialize(const SparseMatrix<somenumber> &matrix,
   if (data.strengthen_diagonal > 0)
     this->strengthen_diagonal_impl();
 
+  if (data.use_level_scheduling)
+    this->compute_level_schedule();
+
+  if (data.n_parallel_factorization_sweeps > 0)
+    {
+      compute_parallel_factorization(data.n_parallel_factorization_sweeps);
+      return;
+    }
+
   // in the following, we implement algorithm 10.4 in the book by Saad by
   // translating in essence the algorithm given at the end of section 10.3.2,
   // using the names of variables used there
@@ -133,6 +145,105 @@ SparseILU<number>::initialize(const SparseMatrix<somenumber> &matrix,
 
 
 
+template <typename number>
+void
+SparseILU<number>::compute_parallel_factorization(const unsigned int n_sweeps)
+{
+  // we implement the fixed-point iteration of E. Chow and A. Patel, "Fine-
+  // grained parallel incomplete LU factorization", SIAM J. Sci. Comput. 37
+  // (2015), which computes every entry of the factors from
+  //   l_ij = (a_ij - sum_{k<j} l_ik u_kj) / u_jj   for i>j,
+  //   u_ij =  a_ij - sum_{k<i} l_ik u_kj           for i<=j,
+  // using the values of the previous sweep on the right hand side. in the
+  // end, the entries are stored in the same format as in the sequential
+  // algorithm, i.e., with the multipliers of L left of the diagonal, U on and
+  // right of the diagonal, and the diagonal inverted
+  const SparsityPattern &  sparsity = this->get_sparsity_pattern();
+  const std::size_t *const ia       = sparsity.rowstart.get();
+  const size_type *const   ja       = sparsity.colnums.get();
+
+  number *        luval = this->SparseMatrix<number>::val.get();
+  const size_type N     = this->m();
+
+  // the entries of the (possibly strengthened) matrix stay fixed during the
+  // iteration
+  const std::vector<number> a(luval, luval + ia[N]);
+  std::vector<number>       previous(ia[N]);
+
+  // the position of entry (row,col) in the pattern, or
+  // numbers::invalid_size_type if it is not part of the pattern. the
+  // diagonal is stored first, all other entries are sorted
+  const auto find_entry = [ia, ja](const size_type row,
+                                   const size_type col) -> std::size_t {
+    if (row == col)
+      return ia[row];
+    const size_type *const row_end = &ja[ia[row + 1]];
+    const size_type *const p =
+      Utilities::lower_bound(&ja[ia[row] + 1], row_end, col);
+    return (p != row_end && *p == col) ? p - ja : numbers::invalid_size_type;
+  };
+
+  // initial guess: the strictly lower part of A scaled by the diagonal for
+  // L, and the upper part of A for U
+  for (size_type row = 0; row < N; ++row)
+    for (std::size_t j = ia[row] + 1;
+         j < std::size_t(this->prebuilt_lower_bound[row] - ja);
+         ++j)
+      {
+        Assert(a[ia[ja[j]]] != number(), ExcZeroPivot(ja[j]));
+        luval[j] = a[j] / a[ia[ja[j]]];
+      }
+
+  for (unsigned int sweep = 0; sweep < n_sweeps; ++sweep)
+    {
+      std::copy(luval, luval + ia[N], previous.begin());
+      parallel::apply_to_subranges(
+        size_type(0),
+        N,
+        [&](const size_type begin, const size_type end) {
+          for (size_type row = begin; row < end; ++row)
+            {
+              const std::size_t lower_end =
+                this->prebuilt_lower_bound[row] - ja;
+              for (std::size_t j = ia[row]; j < ia[row + 1]; ++j)
+                {
+                  const size_type col   = ja[j];
+                  const size_type limit = std::min(row, col);
+
+                  // the entries left of the diagonal are sorted, so we can
+                  // stop at the first one at or beyond min(row,col)
+                  number sum = a[j];
+                  for (std::size_t jk = ia[row] + 1;
+                       jk < lower_end && ja[jk] < limit;
+                       ++jk)
+                    {
+                      const std::size_t kj = find_entry(ja[jk], col);
+                      if (kj != numbers::invalid_size_type)
+                        sum -= previous[jk] * previous[kj];
+                    }
+
+                  if (col < row)
+                    {
+                      Assert(previous[ia[col]] != number(), ExcZeroPivot(col));
+                      luval[j] = sum / previous[ia[col]];
+                    }
+                  else
+                    luval[j] = sum;
+                }
+            }
+        },
+        internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+    }
+
+  for (size_type row = 0; row < N; ++row)
+    {
+      Assert(luval[ia[row]] != number(), ExcZeroPivot(row));
+      luval[ia[row]] = 1. / luval[ia[row]];
+    }
+}
+
+
+
 template <typename number>
 template <typename somenumber>
 void
@@ -143,7 +254,6 @@ SparseILU<number>::vmult(Vector<somenumber> &      dst,
          ExcDimensionMismatch(dst.size(), src.size()));
   Assert(dst.size() == this->m(), ExcDimensionMismatch(dst.size(), this->m()));
 
-  const size_type          N = dst.size();
   const std::size_t *const rowstart_indices =
     this->get_sparsity_pattern().rowstart.get();
   const size_type *const column_numbers =
@@ -161,9 +271,15 @@ SparseILU<number>::vmult(Vector<somenumber> &      dst,
   // we split the y_i = b_i off and
   // perform it at the outset of the
   // loop
+  //
+  // if a level schedule is available, the rows within each level are
+  // independent of each other and get processed in parallel
   dst = src;
-  for (size_type row = 0; row < N; ++row)
-    {
+  this->apply_by_level(
+    this->lower_level_rows,
+    this->lower_level_starts,
+    true,
+    [&](const size_type row) {
       // get start of this row. skip the
       // diagonal element
       const size_type *const rowstart =
@@ -180,7 +296,7 @@ SparseILU<number>::vmult(Vector<somenumber> &      dst,
            ++col, ++luval)
         dst_row -= *luval * dst(*col);
       dst(row) = dst_row;
-    }
+    });
 
   // now the backward solve. same
   // procedure, but we need not set
@@ -190,8 +306,11 @@ SparseILU<number>::vmult(Vector<somenumber> &      dst,
   // note that we need to scale now,
   // since the diagonal is not equal to
   // one now
-  for (int row = N - 1; row >= 0; --row)
-    {
+  this->apply_by_level(
+    this->upper_level_rows,
+    this->upper_level_starts,
+    false,
+    [&](const size_type row) {
       // get end of this row
       const size_type *const rowend =
         &column_numbers[rowstart_indices[row + 1]];
@@ -211,7 +330,7 @@ SparseILU<number>::vmult(Vector<somenumber> &      dst,
       // note that the diagonal element
       // was stored inverted
       dst(row) = dst_row * this->diag_element(row);
-    }
+    });
 }
 
 
@@ -21,6 +21,7 @@
 
 #  include <deal.II/base/smartpointer.h>
 #  include <deal.II/base/subscriptor.h>
+#  include <deal.II/base/thread_management.h>
 
 #  include <deal.II/lac/exceptions.h>
 #  include <deal.II/lac/identity_matrix.h>
@@ -903,6 +904,33 @@ public:
       const bool       elide_zero_values      = true,
       const bool       col_indices_are_sorted = false);
 
+  /**
+   * Allow or disallow concurrent calls to the add() functions that add
+   * individual elements or rows of elements from several threads. In this
+   * mode, every element is added by Threads::atomic_add(), so that several
+   * threads may write into the same row and even the same element at the
+   * same time. This makes it possible to copy local contributions into the
+   * matrix from all threads at once, for example by the copier of
+   * WorkStream::run_with_concurrent_copier(), or through
+   * AffineConstraints::distribute_local_to_global() called from there.
+   *
+   * Since every element is located by a binary search and written by an
+   * atomic operation, each single addition is more expensive than in the
+   * default mode. Furthermore, the order in which contributions are summed
+   * up is no longer deterministic. Functions other than add() are not
+   * affected by this setting and keep their thread-safety properties. The
+   * setting is reset to @p false by reinit().
+   */
+  void
+  set_thread_safe_add(const bool thread_safe);
+
+  /**
+   * Return whether concurrent calls to add() are allowed, see
+   * set_thread_safe_add().
+   */
+  bool
+  get_thread_safe_add() const;
+
   /**
    * Multiply the entire matrix by a fixed factor.
    */
@@ -1721,6 +1749,11 @@ private:
    */
   std::size_t max_len;
 
+  /**
+   * Whether add() uses atomic operations, see set_thread_safe_add().
+   */
+  bool thread_safe_add;
+
   // make all other sparse matrices friends
   template <typename somenumber>
   friend class SparseMatrix;
@@ -1883,7 +1916,28 @@ SparseMatrix<number>::add(const size_type i,
       return;
     }
 
-  val[index] += value;
+  if (thread_safe_add)
+    Threads::atomic_add(val[index], value);
+  else
+    val[index] += value;
+}
+
+
+
+template <typename number>
+inline void
+SparseMatrix<number>::set_thread_safe_add(const bool thread_safe)
+{
+  thread_safe_add = thread_safe;
+}
+
+
+
+template <typename number>
+inline bool
+SparseMatrix<number>::get_thread_safe_add() const
+{
+  return thread_safe_add;
 }
 
 
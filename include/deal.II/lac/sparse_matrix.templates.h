@@ -51,6 +51,7 @@ SparseMatrix<number>::SparseMatrix()
   : cols(nullptr, "SparseMatrix")
   , val(nullptr)
   , max_len(0)
+  , thread_safe_add(false)
 {}
 
 
@@ -61,6 +62,7 @@ SparseMatrix<number>::SparseMatrix(const SparseMatrix &m)
   , cols(nullptr, "SparseMatrix")
   , val(nullptr)
   , max_len(0)
+  , thread_safe_add(false)
 {
   Assert(m.cols == nullptr && m.val == nullptr && m.max_len == 0,
          ExcMessage(
@@ -78,6 +80,7 @@ SparseMatrix<number>::SparseMatrix(SparseMatrix<number> &&m) noexcept
   , cols(m.cols)
   , val(std::move(m.val))
   , max_len(m.max_len)
+  , thread_safe_add(m.thread_safe_add)
 {
   m.cols    = nullptr;
   m.val     = nullptr;
@@ -106,9 +109,10 @@ template <typename number>
 SparseMatrix<number> &
 SparseMatrix<number>::operator=(SparseMatrix<number> &&m) noexcept
 {
-  cols    = m.cols;
-  val     = std::move(m.val);
-  max_len = m.max_len;
+  cols            = m.cols;
+  val             = std::move(m.val);
+  max_len         = m.max_len;
+  thread_safe_add = m.thread_safe_add;
 
   m.cols    = nullptr;
   m.val     = nullptr;
@@ -124,6 +128,7 @@ SparseMatrix<number>::SparseMatrix(const SparsityPattern &c)
   : cols(nullptr, "SparseMatrix")
   , val(nullptr)
   , max_len(0)
+  , thread_safe_add(false)
 {
   // virtual functions called in constructors and destructors never use the
   // override in a derived class
@@ -139,6 +144,7 @@ SparseMatrix<number>::SparseMatrix(const SparsityPattern &c,
   : cols(nullptr, "SparseMatrix")
   , val(nullptr)
   , max_len(0)
+  , thread_safe_add(false)
 {
   (void)id;
   Assert(c.n_rows() == id.m(), ExcDimensionMismatch(c.n_rows(), id.m()));
@@ -258,7 +264,8 @@ template <typename number>
 void
 SparseMatrix<number>::reinit(const SparsityPattern &sparsity)
 {
-  cols = &sparsity;
+  cols            = &sparsity;
+  thread_safe_add = false;
 
   if (cols->empty())
     {
@@ -543,6 +550,15 @@ SparseMatrix<number>::add(const size_type  row,
 {
   Assert(cols != nullptr, ExcNotInitialized());
 
+  // in thread-safe mode, let the function adding a single element, which
+  // searches the entry and uses an atomic update, do all of the work
+  if (thread_safe_add)
+    {
+      for (size_type j = 0; j < n_cols; ++j)
+        add(row, col_indices[j], number(values[j]));
+      return;
+    }
+
   // if we have sufficiently many columns
   // and sorted indices it is faster to
   // just go through the column indices and
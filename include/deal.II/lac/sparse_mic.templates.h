@@ -73,12 +73,17 @@ SparseMIC<number>::initialize(const SparseMatrix<somenumber> &matrix,
   Assert(matrix.m() == matrix.n(), ExcNotQuadratic());
   Assert(data.strengthen_diagonal >= 0,
          ExcInvalidStrengthening(data.strengthen_diagonal));
+  Assert(data.n_parallel_factorization_sweeps == 0,
+         ExcMessage("SparseMIC does not implement a parallel factorization."));
 
   SparseLUDecomposition<number>::initialize(matrix, data);
   this->strengthen_diagonal = data.strengthen_diagonal;
   this->prebuild_lower_bound();
   this->copy_from(matrix);
 
+  if (data.use_level_scheduling)
+    this->compute_level_schedule();
+
   Assert(this->m() == this->n(), ExcNotQuadratic());
   Assert(matrix.m() == this->m(), ExcDimensionMismatch(matrix.m(), this->m()));
 
@@ -156,10 +161,15 @@ SparseMIC<number>::vmult(Vector<somenumber> &      dst,
   // We assume the underlying matrix A is: A = X - L - U, where -L and -U are
   // strictly lower- and upper- diagonal parts of the system.
   //
-  // Solve (X-L)X{-1}(X-U) x = b in 3 steps:
+  // Solve (X-L)X{-1}(X-U) x = b in 3 steps. If a level schedule is
+  // available, the rows within each level of the two substitutions are
+  // processed in parallel:
   dst = src;
-  for (size_type row = 0; row < N; ++row)
-    {
+  this->apply_by_level(
+    this->lower_level_rows,
+    this->lower_level_starts,
+    true,
+    [&](const size_type row) {
       // Now: (X-L)u = b
 
       // get start of this row. skip
@@ -171,25 +181,28 @@ SparseMIC<number>::vmult(Vector<somenumber> &      dst,
         dst(row) -= p->value() * dst(p->column());
 
       dst(row) *= inv_diag[row];
-    }
+    });
 
   // Now: v = Xu
   for (size_type row = 0; row < N; row++)
     dst(row) *= diag[row];
 
   // x = (X-U)v
-  for (int row = N - 1; row >= 0; --row)
-    {
+  this->apply_by_level(
+    this->upper_level_rows,
+    this->upper_level_starts,
+    false,
+    [&](const size_type row) {
       // get end of this row
       for (typename SparseMatrix<number>::const_iterator p =
              this->begin(row) + 1;
            p != this->end(row);
            ++p)
-        if (p->column() > static_cast<size_type>(row))
+        if (p->column() > row)
           dst(row) -= p->value() * dst(p->column());
 
       dst(row) *= inv_diag[row];
-    }
+    });
 }
 
 
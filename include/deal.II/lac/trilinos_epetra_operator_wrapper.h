@@ -0,0 +1,360 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_trilinos_epetra_operator_wrapper_h
+#define dealii_trilinos_epetra_operator_wrapper_h
+
+
+#include <deal.II/base/config.h>
+
+#ifdef DEAL_II_WITH_TRILINOS
+
+#  include <deal.II/base/index_set.h>
+#  include <deal.II/base/smartpointer.h>
+
+#  include <deal.II/lac/exceptions.h>
+#  include <deal.II/lac/la_parallel_vector.h>
+
+#  include <Epetra_Map.h>
+#  include <Epetra_MultiVector.h>
+#  include <Epetra_Operator.h>
+
+#  include <algorithm>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace TrilinosWrappers
+{
+  /**
+   * A wrapper class that exposes an operator acting on
+   * LinearAlgebra::distributed::Vector<double>, such as the operators in the
+   * MatrixFreeOperators namespace, as an Epetra_Operator. This allows to use
+   * such operators inside Trilinos solvers and as the operator in Trilinos
+   * preconditioners that only perform matrix-vector products, e.g. Chebyshev
+   * smoothers.
+   *
+   * The locally owned entries of a LinearAlgebra::distributed::Vector and an
+   * Epetra_Vector based on the same locally owned index set are stored in
+   * the same order, so the Epetra_Map of this class is built from the
+   * locally owned range of the vectors created by
+   * <tt>OperatorType::initialize_dof_vector()</tt>. In each application, the
+   * entries of the Epetra vector are copied into a vector with ghost storage
+   * that is kept in this class, and the result is copied back. This
+   * involves no communication and no index translation beyond the one
+   * performed by the operator itself. A complete aliasing of the memory is
+   * not possible because the operator needs the storage for ghost entries
+   * directly after the locally owned entries, whereas Epetra only allocates
+   * the locally owned ones. For the opposite direction, i.e., applying a
+   * Trilinos preconditioner to a LinearAlgebra::distributed::Vector,
+   * PreconditionBase::vmult() already works on views of the deal.II vectors.
+   *
+   * The operator must provide the functions
+   * <tt>initialize_dof_vector(LinearAlgebra::distributed::Vector<double>
+   * &)</tt>, <tt>vmult()</tt>, and <tt>Tvmult()</tt>. It must be derived
+   * from Subscriptor, as all operators in MatrixFreeOperators are, and must
+   * remain alive as long as this object is used.
+   *
+   * @ingroup TrilinosWrappers
+   */
+  template <typename OperatorType>
+  class EpetraOperatorWrapper : public Epetra_Operator
+  {
+  public:
+    /**
+     * Constructor. Sets up the vectors and the Epetra_Map describing the
+     * parallel partitioning of @p op.
+     */
+    EpetraOperatorWrapper(const OperatorType &op);
+
+    /**
+     * Destructor.
+     */
+    virtual ~EpetraOperatorWrapper() override = default;
+
+    /**
+     * @name Core Epetra_Operator functionality
+     */
+    //@{
+
+    /**
+     * Set a flag that determines whether Apply() performs a multiplication
+     * with the transpose of the operator.
+     *
+     * This overloads the same function from the Trilinos class
+     * Epetra_Operator.
+     */
+    virtual int
+    SetUseTranspose(bool UseTranspose) override;
+
+    /**
+     * Apply the operator to all columns of @p X and write the result into
+     * the respective columns of @p Y.
+     *
+     * This overloads the same function from the Trilinos class
+     * Epetra_Operator.
+     */
+    virtual int
+    Apply(const Epetra_MultiVector &X, Epetra_MultiVector &Y) const override;
+
+    /**
+     * The inverse of the wrapped operator is not available. This function
+     * returns an error code.
+     *
+     * This overloads the same function from the Trilinos class
+     * Epetra_Operator.
+     */
+    virtual int
+    ApplyInverse(const Epetra_MultiVector &X,
+                 Epetra_MultiVector &      Y) const override;
+    //@}
+
+    /**
+     * @name Additional Epetra_Operator functionality
+     */
+    //@{
+
+    /**
+     * Return a label to describe this class.
+     */
+    virtual const char *
+    Label() const override;
+
+    /**
+     * Return the flag set by SetUseTranspose().
+     */
+    virtual bool
+    UseTranspose() const override;
+
+    /**
+     * Return <tt>false</tt> since the infinity norm of the wrapped operator
+     * is not known.
+     */
+    virtual bool
+    HasNormInf() const override;
+
+    /**
+     * Throws an error since the infinity norm is not available.
+     */
+    virtual double
+    NormInf() const override;
+
+    /**
+     * Return a reference to the communicator of the Epetra_Map.
+     */
+    virtual const Epetra_Comm &
+    Comm() const override;
+
+    /**
+     * Return the partitioning of the domain space of the operator.
+     */
+    virtual const Epetra_Map &
+    OperatorDomainMap() const override;
+
+    /**
+     * Return the partitioning of the range space of the operator, which is
+     * the same as the one of the domain space.
+     */
+    virtual const Epetra_Map &
+    OperatorRangeMap() const override;
+    //@}
+
+  private:
+    /**
+     * A pointer to the wrapped operator.
+     */
+    SmartPointer<const OperatorType, EpetraOperatorWrapper<OperatorType>>
+      op;
+
+    /**
+     * Vector holding the input of the operator, including its ghost storage.
+     */
+    mutable LinearAlgebra::distributed::Vector<double> src;
+
+    /**
+     * Vector holding the output of the operator, including its ghost
+     * storage.
+     */
+    mutable LinearAlgebra::distributed::Vector<double> dst;
+
+    /**
+     * The locally owned part of the vectors in Epetra format.
+     */
+    Epetra_Map map;
+
+    /**
+     * Flag set by SetUseTranspose().
+     */
+    bool use_transpose;
+  };
+
+
+
+  /* ----------------------- inline and template functions ----------------- */
+
+#  ifndef DOXYGEN
+
+  namespace internal
+  {
+    namespace EpetraOperatorWrapperImplementation
+    {
+      template <typename OperatorType>
+      LinearAlgebra::distributed::Vector<double>
+      create_vector(const OperatorType &op)
+      {
+        LinearAlgebra::distributed::Vector<double> vector;
+        op.initialize_dof_vector(vector);
+        return vector;
+      }
+    } // namespace EpetraOperatorWrapperImplementation
+  }   // namespace internal
+
+
+
+  template <typename OperatorType>
+  EpetraOperatorWrapper<OperatorType>::EpetraOperatorWrapper(
+    const OperatorType &op)
+    : op(&op)
+    , src(internal::EpetraOperatorWrapperImplementation::create_vector(op))
+    , dst(src)
+    , map(src.get_partitioner()->locally_owned_range().make_trilinos_map(
+        src.get_mpi_communicator(),
+        false))
+    , use_transpose(false)
+  {}
+
+
+
+  template <typename OperatorType>
+  int
+  EpetraOperatorWrapper<OperatorType>::SetUseTranspose(bool UseTranspose)
+  {
+    use_transpose = UseTranspose;
+    return 0;
+  }
+
+
+
+  template <typename OperatorType>
+  int
+  EpetraOperatorWrapper<OperatorType>::Apply(const Epetra_MultiVector &X,
+                                             Epetra_MultiVector &      Y) const
+  {
+    AssertDimension(X.NumVectors(), Y.NumVectors());
+    AssertDimension(static_cast<unsigned int>(X.MyLength()),
+                    src.local_size());
+    AssertDimension(static_cast<unsigned int>(Y.MyLength()),
+                    dst.local_size());
+
+    const unsigned int local_size = src.local_size();
+    for (int column = 0; column < X.NumVectors(); ++column)
+      {
+        // the ghost entries of src are recomputed by the operator, so only
+        // the locally owned range needs to be filled
+        src.zero_out_ghosts();
+        std::copy(X[column], X[column] + local_size, src.begin());
+
+        if (use_transpose)
+          op->Tvmult(dst, src);
+        else
+          op->vmult(dst, src);
+
+        std::copy(dst.begin(), dst.begin() + local_size, Y[column]);
+      }
+    return 0;
+  }
+
+
+
+  template <typename OperatorType>
+  int
+  EpetraOperatorWrapper<OperatorType>::ApplyInverse(const Epetra_MultiVector &,
+                                                    Epetra_MultiVector &) const
+  {
+    return -1;
+  }
+
+
+
+  template <typename OperatorType>
+  const char *
+  EpetraOperatorWrapper<OperatorType>::Label() const
+  {
+    return "deal.II operator wrapped as Epetra_Operator";
+  }
+
+
+
+  template <typename OperatorType>
+  bool
+  EpetraOperatorWrapper<OperatorType>::UseTranspose() const
+  {
+    return use_transpose;
+  }
+
+
+
+  template <typename OperatorType>
+  bool
+  EpetraOperatorWrapper<OperatorType>::HasNormInf() const
+  {
+    return false;
+  }
+
+
+
+  template <typename OperatorType>
+  double
+  EpetraOperatorWrapper<OperatorType>::NormInf() const
+  {
+    AssertThrow(false, ExcNotImplemented());
+    return 0.0;
+  }
+
+
+
+  template <typename OperatorType>
+  const Epetra_Comm &
+  EpetraOperatorWrapper<OperatorType>::Comm() const
+  {
+    return map.Comm();
+  }
+
+
+
+  template <typename OperatorType>
+  const Epetra_Map &
+  EpetraOperatorWrapper<OperatorType>::OperatorDomainMap() const
+  {
+    return map;
+  }
+
+
+
+  template <typename OperatorType>
+  const Epetra_Map &
+  EpetraOperatorWrapper<OperatorType>::OperatorRangeMap() const
+  {
+    return map;
+  }
+
+#  endif // DOXYGEN
+
+} // namespace TrilinosWrappers
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // DEAL_II_WITH_TRILINOS
+
+#endif
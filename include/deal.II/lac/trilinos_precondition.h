@@ -1400,7 +1400,8 @@ namespace TrilinosWrappers
                      const unsigned int smoother_overlap = 0,
                      const bool         output_details   = false,
                      const char *       smoother_type    = "Chebyshev",
-                     const char *       coarse_type      = "Amesos-KLU");
+                     const char *       coarse_type      = "Amesos-KLU",
+                     const bool         reuse_hierarchy  = false);
 
       /**
        * Fill in a @p parameter_list that can be used to initialize the
@@ -1595,6 +1596,19 @@ namespace TrilinosWrappers
        * settings as for the smoother type are possible.
        */
       const char *coarse_type;
+
+      /**
+       * If this flag is set to <tt>true</tt>, ML keeps the aggregates and
+       * tentative prolongators of the multilevel hierarchy after the setup
+       * (ML option "reuse: enable"). A subsequent call to
+       * PreconditionAMG::reinit() after the values, but not the sparsity
+       * pattern, of the matrix have changed then only recomputes the
+       * smoothed prolongators, the Galerkin products on the coarser levels,
+       * and the smoothers, which is usually several times faster than a
+       * call to initialize(). This is the typical situation for the
+       * matrices in a time stepping scheme or a nonlinear iteration.
+       */
+      bool reuse_hierarchy;
     };
 
     /**
@@ -1687,6 +1701,12 @@ namespace TrilinosWrappers
      * considerably faster than the initialize function, since the coarsening
      * pattern is usually the most difficult thing to do when setting up the
      * AMG ML preconditioner.
+     *
+     * The matrix given to initialize() must still exist and hold the new
+     * values, since ML refers to it directly. For the coarsening structure
+     * to be available, the preconditioner must have been set up with
+     * AdditionalData::reuse_hierarchy set to <tt>true</tt>, or with the ML
+     * option "reuse: enable" in the parameter list variant of initialize().
      */
     void
     reinit();
@@ -0,0 +1,338 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_trilinos_tpetra_sparse_matrix_h
+#define dealii_trilinos_tpetra_sparse_matrix_h
+
+
+#include <deal.II/base/config.h>
+
+#if defined(DEAL_II_TRILINOS_TPETRA_SPARSE_MATRIX_IS_FUNCTIONAL) && \
+  defined(DEAL_II_WITH_MPI)
+
+#  include <deal.II/base/index_set.h>
+#  include <deal.II/base/subscriptor.h>
+#  include <deal.II/base/thread_local_storage.h>
+#  include <deal.II/base/thread_management.h>
+
+#  include <deal.II/lac/full_matrix.h>
+#  include <deal.II/lac/trilinos_tpetra_vector.h>
+#  include <deal.II/lac/vector_operation.h>
+
+#  include <Tpetra_CrsGraph.hpp>
+#  include <Tpetra_CrsMatrix.hpp>
+#  include <mpi.h>
+
+#  include <memory>
+#  include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+// Forward declaration
+class DynamicSparsityPattern;
+
+namespace LinearAlgebra
+{
+  namespace TpetraWrappers
+  {
+    /**
+     * This class implements a wrapper to the Trilinos distributed sparse
+     * matrix class Tpetra::CrsMatrix. It works together with
+     * TpetraWrappers::Vector and, like it, uses the default Kokkos node of
+     * the Trilinos installation for the matrix-vector product.
+     *
+     * As opposed to TrilinosWrappers::SparseMatrix, which is based on Epetra,
+     * the add() functions of this class may be called concurrently from
+     * several threads, e.g., from the copier of WorkStream::run() when the
+     * copier is not serialized. This works as follows: reinit() builds a
+     * Tpetra::CrsGraph from the given sparsity pattern and completes it, so
+     * the structure of the matrix is fixed ("static graph") and adding into
+     * an existing entry can be done with an atomic update. For locally owned
+     * rows, add() translates the indices into the local numbering and calls
+     * Tpetra::CrsMatrix::sumIntoLocalValues() with atomic updates enabled,
+     * without any lock. Entries in rows owned by other processes are
+     * collected by Tpetra and sent to their owners in compress(); since
+     * Tpetra's storage for those is not thread-safe, these calls are
+     * serialized with a mutex.
+     *
+     * The sparsity pattern passed to reinit() must contain all entries the
+     * locally owned rows receive, including those added by other processes,
+     * as is the case after calling SparsityTools::distribute_sparsity_pattern().
+     * Adding to an entry that is not part of the sparsity pattern is an
+     * error.
+     *
+     * A typical assembly cycle looks as follows:
+     * @code
+     * matrix.reinit(locally_owned_dofs, dsp, mpi_communicator);
+     * ...
+     * matrix = 0.;
+     * // possibly threaded loop calling matrix.add(...)
+     * matrix.compress(VectorOperation::add);
+     * matrix.vmult(dst, src);
+     * @endcode
+     *
+     * This class is only available if the configuration found that the
+     * Trilinos installation supports the static graph construction and the
+     * atomic sumIntoLocalValues() used here for the index types of deal.II.
+     *
+     * @ingroup TrilinosWrappers
+     * @ingroup Matrix1
+     */
+    template <typename Number>
+    class SparseMatrix : public Subscriptor
+    {
+    public:
+      /**
+       * Declare the type for container size.
+       */
+      using size_type = types::global_dof_index;
+
+      /**
+       * Declare the type of the matrix entries.
+       */
+      using value_type = Number;
+
+      /**
+       * Type of the underlying Trilinos matrix.
+       */
+      using MatrixType =
+        Tpetra::CrsMatrix<Number, int, types::global_dof_index>;
+
+      /**
+       * Type of the underlying Trilinos sparsity pattern.
+       */
+      using GraphType = Tpetra::CrsGraph<int, types::global_dof_index>;
+
+      /**
+       * Constructor. Create an empty matrix.
+       */
+      SparseMatrix() = default;
+
+      /**
+       * Initialize a square matrix whose rows are distributed according to
+       * @p parallel_partitioning, with the nonzero entries given by
+       * @p sparsity_pattern. The matrix is set to zero and is ready for
+       * calls to add().
+       */
+      void
+      reinit(const IndexSet &              parallel_partitioning,
+             const DynamicSparsityPattern &sparsity_pattern,
+             const MPI_Comm &              communicator);
+
+      /**
+       * Set all entries of the matrix to zero and prepare the matrix for
+       * another assembly. Only the value zero is allowed for @p d.
+       */
+      SparseMatrix &
+      operator=(const Number d);
+
+      /**
+       * Add @p value to the entry (<i>i,j</i>). The entry must be part of
+       * the sparsity pattern.
+       *
+       * This function may be called concurrently from several threads.
+       */
+      void
+      add(const size_type i, const size_type j, const Number value);
+
+      /**
+       * Add the @p n_cols values in @p values to the entries of row @p row in
+       * the columns given by @p col_indices. All entries must be part of the
+       * sparsity pattern. The argument @p elide_zero_values allows to skip
+       * zero entries.
+       *
+       * This function may be called concurrently from several threads.
+       */
+      void
+      add(const size_type  row,
+          const size_type  n_cols,
+          const size_type *col_indices,
+          const Number *   values,
+          const bool       elide_zero_values = true);
+
+      /**
+       * Add the entries of the local matrix @p full_matrix to the rows and
+       * columns given by @p indices, as done in the copier of a typical
+       * assembly loop.
+       *
+       * This function may be called concurrently from several threads.
+       */
+      void
+      add(const std::vector<size_type> &indices,
+          const FullMatrix<Number> &    full_matrix,
+          const bool                    elide_zero_values = true);
+
+      /**
+       * Send the entries added to rows owned by other processes to their
+       * owners and finalize the matrix for matrix-vector products. Only
+       * VectorOperation::add is supported.
+       */
+      void
+      compress(const VectorOperation::values operation);
+
+      /**
+       * Matrix-vector multiplication: let <i>dst = M*src</i>.
+       */
+      void
+      vmult(Vector<Number> &dst, const Vector<Number> &src) const;
+
+      /**
+       * Matrix-vector multiplication with the transpose of the matrix: let
+       * <i>dst = M<sup>T</sup>*src</i>.
+       */
+      void
+      Tvmult(Vector<Number> &dst, const Vector<Number> &src) const;
+
+      /**
+       * Return the number of rows of this matrix.
+       */
+      size_type
+      m() const;
+
+      /**
+       * Return the number of columns of this matrix.
+       */
+      size_type
+      n() const;
+
+      /**
+       * Return the rows owned by the current process.
+       */
+      const IndexSet &
+      locally_owned_range_indices() const;
+
+      /**
+       * Return a const reference to the underlying Tpetra::CrsMatrix.
+       */
+      const MatrixType &
+      trilinos_matrix() const;
+
+      /**
+       * Return a (modifiable) reference to the underlying Tpetra::CrsMatrix.
+       */
+      MatrixType &
+      trilinos_matrix();
+
+      /**
+       * Return the memory consumption of this class in bytes.
+       */
+      std::size_t
+      memory_consumption() const;
+
+      /**
+       * Exception thrown when adding to an entry that is not part of the
+       * sparsity pattern.
+       */
+      DeclException2(ExcInvalidIndex,
+                     size_type,
+                     size_type,
+                     << "You tried to access element (" << arg1 << "/" << arg2
+                     << ")"
+                     << " of a sparse matrix, but it appears to not"
+                     << " exist in the Trilinos sparsity pattern.");
+
+    private:
+      /**
+       * The rows owned by the current process.
+       */
+      IndexSet owned_rows;
+
+      /**
+       * The sparsity pattern of the matrix, completed in reinit().
+       */
+      Teuchos::RCP<GraphType> graph;
+
+      /**
+       * The matrix, built on the static graph above.
+       */
+      Teuchos::RCP<MatrixType> matrix;
+
+      /**
+       * Scratch arrays of each thread for the local column indices passed to
+       * Tpetra in add() for locally owned rows.
+       */
+      Threads::ThreadLocalStorage<std::vector<int>> local_columns;
+
+      /**
+       * Scratch arrays of each thread for the global column indices passed
+       * to Tpetra in add() for rows owned by other processes.
+       */
+      Threads::ThreadLocalStorage<std::vector<types::global_dof_index>>
+        global_columns;
+
+      /**
+       * Scratch arrays of each thread for the values passed to Tpetra in
+       * add().
+       */
+      Threads::ThreadLocalStorage<std::vector<Number>> column_values;
+
+      /**
+       * Mutex serializing the additions to rows owned by other processes.
+       */
+      Threads::Mutex nonlocal_mutex;
+    };
+
+
+
+    /* ------------------------- inline functions -------------------------- */
+
+#  ifndef DOXYGEN
+
+    template <typename Number>
+    inline void
+    SparseMatrix<Number>::add(const size_type i,
+                              const size_type j,
+                              const Number    value)
+    {
+      add(i, 1, &j, &value, false);
+    }
+
+
+
+    template <typename Number>
+    inline const IndexSet &
+    SparseMatrix<Number>::locally_owned_range_indices() const
+    {
+      return owned_rows;
+    }
+
+
+
+    template <typename Number>
+    inline const typename SparseMatrix<Number>::MatrixType &
+    SparseMatrix<Number>::trilinos_matrix() const
+    {
+      return *matrix;
+    }
+
+
+
+    template <typename Number>
+    inline typename SparseMatrix<Number>::MatrixType &
+    SparseMatrix<Number>::trilinos_matrix()
+    {
+      return *matrix;
+    }
+
+#  endif // DOXYGEN
+
+  } // namespace TpetraWrappers
+} // namespace LinearAlgebra
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
+
+#endif
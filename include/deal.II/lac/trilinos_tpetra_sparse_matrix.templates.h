@@ -0,0 +1,296 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_trilinos_tpetra_sparse_matrix_templates_h
+#define dealii_trilinos_tpetra_sparse_matrix_templates_h
+
+#include <deal.II/lac/trilinos_tpetra_sparse_matrix.h>
+
+#ifdef DEAL_II_TRILINOS_TPETRA_SPARSE_MATRIX_IS_FUNCTIONAL
+
+#  ifdef DEAL_II_WITH_MPI
+
+#    include <deal.II/lac/dynamic_sparsity_pattern.h>
+#    include <deal.II/lac/exceptions.h>
+
+#    include <Teuchos_ArrayView.hpp>
+#    include <Tpetra_CrsGraph_def.hpp>
+#    include <Tpetra_CrsMatrix_def.hpp>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace LinearAlgebra
+{
+  namespace TpetraWrappers
+  {
+    template <typename Number>
+    void
+    SparseMatrix<Number>::reinit(
+      const IndexSet &              parallel_partitioning,
+      const DynamicSparsityPattern &sparsity_pattern,
+      const MPI_Comm &              communicator)
+    {
+      AssertDimension(sparsity_pattern.n_rows(), parallel_partitioning.size());
+      AssertDimension(sparsity_pattern.n_cols(), parallel_partitioning.size());
+
+      owned_rows = parallel_partitioning;
+      const Teuchos::RCP<const Tpetra::Map<int, types::global_dof_index>>
+        row_map = Teuchos::rcp(new Tpetra::Map<int, types::global_dof_index>(
+          parallel_partitioning.make_tpetra_map(communicator, false)));
+
+      // count the entries per row first such that the graph can allocate
+      // its storage at once
+      const unsigned int n_local_rows = parallel_partitioning.n_elements();
+#    if DEAL_II_TRILINOS_VERSION_GTE(13, 0, 0)
+      std::vector<std::size_t> entries_per_row(n_local_rows);
+#    else
+      Teuchos::ArrayRCP<std::size_t> entries_per_row(n_local_rows);
+#    endif
+      for (unsigned int i = 0; i < n_local_rows; ++i)
+        entries_per_row[i] = sparsity_pattern.row_length(
+          parallel_partitioning.nth_index_in_set(i));
+
+#    if DEAL_II_TRILINOS_VERSION_GTE(13, 0, 0)
+      graph = Teuchos::rcp(new GraphType(
+        row_map, Teuchos::ArrayView<const std::size_t>(entries_per_row)));
+#    else
+      graph = Teuchos::rcp(
+        new GraphType(row_map,
+                      Teuchos::ArrayRCP<const std::size_t>(entries_per_row),
+                      Tpetra::StaticProfile));
+#    endif
+      std::vector<types::global_dof_index> row_indices;
+      for (unsigned int i = 0; i < n_local_rows; ++i)
+        {
+          const types::global_dof_index row =
+            parallel_partitioning.nth_index_in_set(i);
+          row_indices.clear();
+          for (auto entry = sparsity_pattern.begin(row);
+               entry != sparsity_pattern.end(row);
+               ++entry)
+            row_indices.push_back(entry->column());
+          graph->insertGlobalIndices(
+            row,
+            Teuchos::ArrayView<const types::global_dof_index>(
+              row_indices.data(), row_indices.size()));
+        }
+      graph->fillComplete(row_map, row_map);
+
+      // the matrix gets a static graph, which is what allows to add into
+      // its entries concurrently
+      matrix = Teuchos::rcp(new MatrixType(graph));
+      matrix->setAllToScalar(Teuchos::ScalarTraits<Number>::zero());
+    }
+
+
+
+    template <typename Number>
+    SparseMatrix<Number> &
+    SparseMatrix<Number>::operator=(const Number d)
+    {
+      (void)d;
+      Assert(d == Number(), ExcScalarAssignmentOnlyForZeroValue());
+      Assert(matrix.is_null() == false, ExcNotInitialized());
+
+      if (matrix->isFillComplete())
+        matrix->resumeFill();
+      matrix->setAllToScalar(Teuchos::ScalarTraits<Number>::zero());
+      return *this;
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::add(const size_type  row,
+                              const size_type  n_cols,
+                              const size_type *col_indices,
+                              const Number *   values,
+                              const bool       elide_zero_values)
+    {
+      Assert(matrix.is_null() == false, ExcNotInitialized());
+      Assert(matrix->isFillActive(),
+             ExcMessage("The matrix must be set to zero with operator= "
+                        "before adding entries after a call to compress()."));
+
+      std::vector<Number> &values_to_add = column_values.get();
+      values_to_add.clear();
+
+      const int local_row = matrix->getRowMap()->getLocalElement(row);
+      if (local_row != Teuchos::OrdinalTraits<int>::invalid())
+        {
+          // locally owned row: translate the columns into the local
+          // numbering of the column map and add atomically, which needs no
+          // lock
+          const auto &      column_map = *matrix->getColMap();
+          std::vector<int> &columns    = local_columns.get();
+          columns.clear();
+          for (size_type j = 0; j < n_cols; ++j)
+            if (elide_zero_values == false || values[j] != Number())
+              {
+                const int local_column =
+                  column_map.getLocalElement(col_indices[j]);
+                Assert(local_column != Teuchos::OrdinalTraits<int>::invalid(),
+                       ExcInvalidIndex(row, col_indices[j]));
+                columns.push_back(local_column);
+                values_to_add.push_back(values[j]);
+              }
+
+          const int n_added = matrix->sumIntoLocalValues(
+            local_row,
+            Teuchos::ArrayView<const int>(columns.data(), columns.size()),
+            Teuchos::ArrayView<const Number>(values_to_add.data(),
+                                             values_to_add.size()),
+            /* atomic = */ true);
+          (void)n_added;
+          Assert(n_added == static_cast<int>(columns.size()),
+                 ExcMessage("Some of the entries added to row " +
+                            std::to_string(row) +
+                            " are not part of the sparsity pattern."));
+        }
+      else
+        {
+          // row owned by another process: Tpetra stores these entries in a
+          // container that is not thread-safe, so serialize the access
+          std::vector<types::global_dof_index> &columns = global_columns.get();
+          columns.clear();
+          for (size_type j = 0; j < n_cols; ++j)
+            if (elide_zero_values == false || values[j] != Number())
+              {
+                columns.push_back(col_indices[j]);
+                values_to_add.push_back(values[j]);
+              }
+
+          std::lock_guard<std::mutex> lock(nonlocal_mutex);
+          matrix->sumIntoGlobalValues(
+            row,
+            Teuchos::ArrayView<const types::global_dof_index>(columns.data(),
+                                                              columns.size()),
+            Teuchos::ArrayView<const Number>(values_to_add.data(),
+                                             values_to_add.size()));
+        }
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::add(const std::vector<size_type> &indices,
+                              const FullMatrix<Number> &    full_matrix,
+                              const bool                    elide_zero_values)
+    {
+      AssertDimension(indices.size(), full_matrix.m());
+      AssertDimension(indices.size(), full_matrix.n());
+
+      for (size_type i = 0; i < indices.size(); ++i)
+        add(indices[i],
+            indices.size(),
+            indices.data(),
+            &full_matrix(i, 0),
+            elide_zero_values);
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::compress(const VectorOperation::values operation)
+    {
+      (void)operation;
+      Assert(operation == VectorOperation::add, ExcNotImplemented());
+      Assert(matrix.is_null() == false, ExcNotInitialized());
+
+      // fillComplete() first sends the entries of rows owned by other
+      // processes to their owners
+      matrix->fillComplete(graph->getDomainMap(), graph->getRangeMap());
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::vmult(Vector<Number> &      dst,
+                                const Vector<Number> &src) const
+    {
+      Assert(matrix->isFillComplete(),
+             ExcMessage("compress() must be called before vmult()."));
+      matrix->apply(src.trilinos_vector(), dst.trilinos_vector());
+    }
+
+
+
+    template <typename Number>
+    void
+    SparseMatrix<Number>::Tvmult(Vector<Number> &      dst,
+                                 const Vector<Number> &src) const
+    {
+      Assert(matrix->isFillComplete(),
+             ExcMessage("compress() must be called before Tvmult()."));
+      matrix->apply(src.trilinos_vector(),
+                    dst.trilinos_vector(),
+                    Teuchos::TRANS);
+    }
+
+
+
+    template <typename Number>
+    typename SparseMatrix<Number>::size_type
+    SparseMatrix<Number>::m() const
+    {
+      return matrix.is_null() ? 0 : matrix->getGlobalNumRows();
+    }
+
+
+
+    template <typename Number>
+    typename SparseMatrix<Number>::size_type
+    SparseMatrix<Number>::n() const
+    {
+      return matrix.is_null() ? 0 : matrix->getGlobalNumCols();
+    }
+
+
+
+    template <typename Number>
+    std::size_t
+    SparseMatrix<Number>::memory_consumption() const
+    {
+      if (matrix.is_null())
+        return sizeof(*this);
+
+      // the matrix stores one local column index and one value per entry,
+      // and the graph one offset per row
+#    if DEAL_II_TRILINOS_VERSION_GTE(13, 2, 0)
+      const std::size_t n_entries = matrix->getLocalNumEntries();
+      const std::size_t n_rows    = matrix->getLocalNumRows();
+#    else
+      const std::size_t n_entries = matrix->getNodeNumEntries();
+      const std::size_t n_rows    = matrix->getNodeNumRows();
+#    endif
+      return sizeof(*this) + owned_rows.memory_consumption() +
+             n_entries * (sizeof(int) + sizeof(Number)) +
+             (n_rows + 1) * sizeof(std::size_t);
+    }
+  } // namespace TpetraWrappers
+} // namespace LinearAlgebra
+
+DEAL_II_NAMESPACE_CLOSE
+
+#  endif
+
+#endif
+
+#endif
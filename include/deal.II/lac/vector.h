@@ -23,7 +23,9 @@
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/index_set.h>
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/memory_space.h>
 #include <deal.II/base/subscriptor.h>
+#include <deal.II/base/thread_management.h>
 
 #include <deal.II/differentiation/ad/ad_number_traits.h>
 
@@ -64,6 +66,9 @@ class LAPACKFullMatrix;
 template <typename>
 class BlockVector;
 
+template <typename ElementType, typename MemorySpaceType>
+class ArrayView;
+
 namespace parallel
 {
   namespace internal
@@ -562,6 +567,40 @@ public:
   Number
   add_and_dot(const Number a, const Vector<Number> &V, const Vector<Number> &W);
 
+  /**
+   * Compute the inner products of this vector with each of the vectors in
+   * @p V and store them in @p results, i.e., <tt>results[i] = *this *
+   * *V[i]</tt>. The same applies for complex-valued vectors as for the
+   * operator*().
+   *
+   * In contrast to calling operator*() for each vector separately, this
+   * vector is loaded from memory only once for every batch of up to eight
+   * vectors. This is useful for orthogonalizing a vector against a set of
+   * basis vectors with the classical Gram-Schmidt algorithm in Krylov
+   * solvers.
+   *
+   * @dealiiOperationIsMultithreaded The algorithm uses pairwise summation
+   * with the same order of summation in every run, which gives fully
+   * repeatable results from one run to another.
+   */
+  void
+  multi_dot(
+    const ArrayView<const Vector<Number> *const, MemorySpace::Host> &V,
+    const ArrayView<Number, MemorySpace::Host> &results) const;
+
+  /**
+   * Multiple addition of scaled vectors, i.e., <tt>*this += a[0]*(*V[0]) +
+   * a[1]*(*V[1]) + ...</tt>. In contrast to subsequent calls to add(), this
+   * vector is only loaded and stored once for every batch of up to eight
+   * vectors.
+   *
+   * @dealiiOperationIsMultithreaded
+   */
+  void
+  multi_add(
+    const ArrayView<const Number, MemorySpace::Host> &               a,
+    const ArrayView<const Vector<Number> *const, MemorySpace::Host> &V);
+
   //@}
 
 
@@ -739,6 +778,22 @@ public:
       const size_type *  indices,
       const OtherNumber *values);
 
+  /**
+   * Allow or disallow concurrent calls to the three collective add()
+   * functions above from several threads, also for overlapping sets of
+   * indices. In this mode, every value is added by Threads::atomic_add(),
+   * which makes it possible to copy local contributions into the vector from
+   * all threads at once, see SparseMatrix::set_thread_safe_add() and
+   * WorkStream::run_with_concurrent_copier(). Writes through operator() or
+   * operator[] are not affected and remain unsynchronized.
+   *
+   * The setting belongs to the object, i.e., it is not transferred along
+   * with the elements of the vector by copy construction, copy assignment,
+   * or swap().
+   */
+  void
+  set_thread_safe_add(const bool thread_safe);
+
   /**
    * Addition of @p s to all components. Note that @p s is a scalar and not a
    * vector.
@@ -1036,6 +1091,12 @@ private:
   mutable std::shared_ptr<parallel::internal::TBBPartitioner>
     thread_loop_partitioner;
 
+  /**
+   * Whether the collective add() functions use atomic operations, see
+   * set_thread_safe_add().
+   */
+  bool thread_safe_add = false;
+
   // Make all other vector types friends.
   template <typename Number2>
   friend class Vector;
@@ -1288,12 +1349,25 @@ Vector<Number>::add(const size_type    n_indices,
         ExcMessage(
           "The given value is not finite but either infinite or Not A Number (NaN)"));
 
-      this->values[indices[i]] += values[i];
+      if (thread_safe_add)
+        Threads::atomic_add(this->values[indices[i]],
+                            static_cast<Number>(values[i]));
+      else
+        this->values[indices[i]] += values[i];
     }
 }
 
 
 
+template <typename Number>
+inline void
+Vector<Number>::set_thread_safe_add(const bool thread_safe)
+{
+  thread_safe_add = thread_safe;
+}
+
+
+
 template <typename Number>
 template <typename Number2>
 inline bool
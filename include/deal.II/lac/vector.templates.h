@@ -17,6 +17,7 @@
 #define dealii_vector_templates_h
 
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/numbers.h>
 #include <deal.II/base/template_constraints.h>
 
@@ -246,8 +247,8 @@ void
 Vector<Number>::reinit(const Vector<Number2> &v,
                        const bool             omit_zeroing_entries)
 {
-  do_reinit(v.size(), omit_zeroing_entries, false);
   thread_loop_partitioner = v.thread_loop_partitioner;
+  do_reinit(v.size(), omit_zeroing_entries, false);
 }
 
 
@@ -565,6 +566,54 @@ Vector<Number>::add_and_dot(const Number          a,
 
 
 
+template <typename Number>
+void
+Vector<Number>::multi_dot(
+  const ArrayView<const Vector<Number> *const, MemorySpace::Host> &V,
+  const ArrayView<Number, MemorySpace::Host> &results) const
+{
+  Assert(size() != 0, ExcEmptyObject());
+  AssertDimension(V.size(), results.size());
+
+  std::vector<const Number *> v_values(V.size());
+  for (unsigned int i = 0; i < V.size(); ++i)
+    {
+      AssertDimension(size(), V[i]->size());
+      v_values[i] = V[i]->values.begin();
+    }
+
+  internal::VectorOperations::multi_dot(thread_loop_partitioner,
+                                        size(),
+                                        values.begin(),
+                                        v_values,
+                                        results.data());
+}
+
+
+
+template <typename Number>
+void
+Vector<Number>::multi_add(
+  const ArrayView<const Number, MemorySpace::Host> &               a,
+  const ArrayView<const Vector<Number> *const, MemorySpace::Host> &V)
+{
+  Assert(size() != 0, ExcEmptyObject());
+  AssertDimension(a.size(), V.size());
+
+  std::vector<const Number *> v_values(V.size());
+  for (unsigned int i = 0; i < V.size(); ++i)
+    {
+      AssertIsFinite(a[i]);
+      AssertDimension(size(), V[i]->size());
+      v_values[i] = V[i]->values.begin();
+    }
+
+  internal::VectorOperations::multi_add(
+    thread_loop_partitioner, size(), a.data(), v_values, values.begin());
+}
+
+
+
 template <typename Number>
 Vector<Number> &
 Vector<Number>::operator+=(const Vector<Number> &v)
@@ -1029,22 +1078,33 @@ Vector<Number>::do_reinit(const size_type new_size,
       else
         {
           values.resize_fast(new_size);
-          if (!omit_zeroing_entries)
-            values.fill();
         }
     }
   else
     {
-      // otherwise size() < new_size and we must allocate
+      // otherwise size() < new_size and we must allocate. the new memory is
+      // left untouched here, so that the operating system only places its
+      // pages when they are first written to below
       AlignedVector<Number> new_values;
       new_values.resize_fast(new_size);
-      if (!omit_zeroing_entries)
-        new_values.fill();
       new_values.swap(values);
     }
 
   if (reset_partitioner)
     maybe_reset_thread_partitioner();
+
+  // zero the entries through the same thread partitioner that all later
+  // vector operations use. on NUMA systems, this first touch places the
+  // memory of each chunk close to the thread that will work on it
+  if (!omit_zeroing_entries && new_size > 0)
+    {
+      internal::VectorOperations::Vector_set<Number> setter(Number(),
+                                                            values.begin());
+      internal::VectorOperations::parallel_for(setter,
+                                               0,
+                                               new_size,
+                                               thread_loop_partitioner);
+    }
 }
 
 
@@ -21,10 +21,12 @@
 
 #include <deal.II/base/logstream.h>
 #include <deal.II/base/smartpointer.h>
+#include <deal.II/base/thread_local_storage.h>
 #include <deal.II/base/thread_management.h>
 
 #include <deal.II/lac/vector.h>
 
+#include <atomic>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -314,6 +316,19 @@ public:
  * of creating a new memory pool every time. A drawback of this policy is that
  * vectors once allocated are only released at the end of the program run.
  *
+ * Vectors that are returned to the pool are kept in a list local to the
+ * thread that returned them, and alloc() first looks for a vector in the
+ * list of the calling thread. This has two benefits: First, the common case
+ * of a function that repeatedly requests and releases temporary vectors
+ * (e.g., an iterative solver called many times) does not need to take any
+ * lock. Second, the list is used in last-in first-out order, so alloc()
+ * returns the vector that was released most recently by the same thread,
+ * which typically already has the size and parallel layout the caller is
+ * about to reinit() it with; the reinitialization then does not need to
+ * allocate any memory. Only if the list of the calling thread is empty (or
+ * has grown too long, see max_thread_local_vectors), vectors are exchanged
+ * through a list shared between all threads that is protected by a mutex.
+ *
  * @author Guido Kanschat, 1999, 2007; Wolfgang Bangerth, 2017.
  */
 template <typename VectorType = dealii::Vector<double>>
@@ -393,14 +408,29 @@ public:
   virtual std::size_t
   memory_consumption() const;
 
+  /**
+   * Return the number of calls to alloc() through this object that could be
+   * served by a vector from the pool (the first component of the returned
+   * pair), and the number of calls for which a new vector had to be created
+   * (the second component).
+   */
+  std::pair<size_type, size_type>
+  get_statistics() const;
+
+  /**
+   * The maximal number of unused vectors kept in the list of a single
+   * thread. Vectors released beyond this number are moved to the list shared
+   * between all threads, so that vectors allocated on one thread and
+   * released on another can still be reused.
+   */
+  static const unsigned int max_thread_local_vectors = 16;
+
 private:
   /**
-   * A type that describes this entries of an array that represents
-   * the vectors stored by this object. The first component of the pair
-   * is be a flag telling whether the vector is used, the second
-   * a pointer to the vector itself.
+   * A type that describes the entries of an array that represents
+   * the vectors stored by this object.
    */
-  using entry_type = std::pair<bool, std::unique_ptr<VectorType>>;
+  using entry_type = std::unique_ptr<VectorType>;
 
   /**
    * The class providing the actual storage for the memory pool.
@@ -430,9 +460,23 @@ private:
     initialize(const size_type size);
 
     /**
-     * Pointer to the storage object
+     * Pointer to the storage object. This array owns all vectors of the
+     * pool, whether they are currently in use or not.
      */
     std::vector<entry_type> *data;
+
+    /**
+     * The vectors that are currently not in use, sorted by the thread that
+     * released them last. These lists can be accessed without holding the
+     * mutex.
+     */
+    Threads::ThreadLocalStorage<std::vector<VectorType *>> thread_unused;
+
+    /**
+     * Vectors that are currently not in use and that are available to all
+     * threads. Access to this list requires holding the mutex.
+     */
+    std::vector<VectorType *> shared_unused;
   };
 
   /**
@@ -445,13 +489,19 @@ private:
    * Overall number of allocations. Only used for bookkeeping and to generate
    * output at the end of an object's lifetime.
    */
-  size_type total_alloc;
+  std::atomic<size_type> total_alloc;
+
+  /**
+   * Number of allocations that had to create a new vector because no unused
+   * one was available in the pool.
+   */
+  std::atomic<size_type> n_misses;
 
   /**
    * Number of vectors currently allocated in this object; used for detecting
    * memory leaks.
    */
-  size_type current_alloc;
+  std::atomic<size_type> current_alloc;
 
   /**
    * A flag controlling the logging of statistics by the destructor.
@@ -459,8 +509,8 @@ private:
   bool log_statistics;
 
   /**
-   * Mutex to synchronize access to internal data of this object from multiple
-   * threads.
+   * Mutex to synchronize access to the parts of the pool that are shared
+   * between all threads.
    */
   static Threads::Mutex mutex;
 };
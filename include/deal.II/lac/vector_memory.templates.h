@@ -22,6 +22,9 @@
 
 #include <deal.II/lac/vector_memory.h>
 
+#include <algorithm>
+#include <set>
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -73,8 +76,8 @@ GrowingVectorMemory<VectorType>::Pool::initialize(const size_type size)
            i != data->end();
            ++i)
         {
-          i->first  = false;
-          i->second = std_cxx14::make_unique<VectorType>();
+          *i = std_cxx14::make_unique<VectorType>();
+          shared_unused.push_back(i->get());
         }
     }
 }
@@ -86,6 +89,7 @@ inline GrowingVectorMemory<VectorType>::GrowingVectorMemory(
   const bool      log_statistics)
 
   : total_alloc(0)
+  , n_misses(0)
   , current_alloc(0)
   , log_statistics(log_statistics)
 {
@@ -101,8 +105,12 @@ inline GrowingVectorMemory<VectorType>::~GrowingVectorMemory()
                 StandardExceptions::ExcMemoryLeak(current_alloc));
   if (log_statistics)
     {
+      std::lock_guard<std::mutex> lock(mutex);
+
       deallog << "GrowingVectorMemory:Overall allocated vectors: "
-              << total_alloc << std::endl;
+              << total_alloc.load() << std::endl;
+      deallog << "GrowingVectorMemory:Newly created vectors: "
+              << n_misses.load() << std::endl;
       deallog << "GrowingVectorMemory:Maximum allocated vectors: "
               << get_pool().data->size() << std::endl;
     }
@@ -114,28 +122,36 @@ template <typename VectorType>
 inline VectorType *
 GrowingVectorMemory<VectorType>::alloc()
 {
-  std::lock_guard<std::mutex> lock(mutex);
-
   ++total_alloc;
   ++current_alloc;
-  // see if there is a free vector
-  // available in our list
-  for (typename std::vector<entry_type>::iterator i = get_pool().data->begin();
-       i != get_pool().data->end();
-       ++i)
+
+  Pool &pool = get_pool();
+
+  // see if there is a free vector available in the list of the current
+  // thread. we take the one released last, as it is the most likely one to
+  // already have the layout the caller wants
+  std::vector<VectorType *> &thread_unused = pool.thread_unused.get();
+  if (thread_unused.size() > 0)
     {
-      if (i->first == false)
-        {
-          i->first = true;
-          return i->second.get();
-        }
+      VectorType *v = thread_unused.back();
+      thread_unused.pop_back();
+      return v;
     }
 
-  // no free vector found, so let's just allocate a new one
-  get_pool().data->emplace_back(
-    entry_type(true, std_cxx14::make_unique<VectorType>()));
+  // if not, try the list shared between all threads, and only then allocate
+  // a new vector
+  std::lock_guard<std::mutex> lock(mutex);
+  if (pool.shared_unused.size() > 0)
+    {
+      VectorType *v = pool.shared_unused.back();
+      pool.shared_unused.pop_back();
+      return v;
+    }
+
+  ++n_misses;
+  pool.data->emplace_back(std_cxx14::make_unique<VectorType>());
 
-  return get_pool().data->back().second.get();
+  return pool.data->back().get();
 }
 
 
@@ -144,20 +160,30 @@ template <typename VectorType>
 inline void
 GrowingVectorMemory<VectorType>::free(const VectorType *const v)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  Pool &pool = get_pool();
+
+#ifdef DEBUG
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    Assert(std::find_if(pool.data->begin(),
+                        pool.data->end(),
+                        [v](const entry_type &entry) {
+                          return entry.get() == v;
+                        }) != pool.data->end(),
+           typename VectorMemory<VectorType>::ExcNotAllocatedHere());
+  }
+#endif
 
-  for (typename std::vector<entry_type>::iterator i = get_pool().data->begin();
-       i != get_pool().data->end();
-       ++i)
+  --current_alloc;
+
+  std::vector<VectorType *> &thread_unused = pool.thread_unused.get();
+  if (thread_unused.size() < max_thread_local_vectors)
+    thread_unused.push_back(const_cast<VectorType *>(v));
+  else
     {
-      if (v == i->second.get())
-        {
-          i->first = false;
-          --current_alloc;
-          return;
-        }
+      std::lock_guard<std::mutex> lock(mutex);
+      pool.shared_unused.push_back(const_cast<VectorType *>(v));
     }
-  Assert(false, typename VectorMemory<VectorType>::ExcNotAllocatedHere());
 }
 
 
@@ -168,8 +194,33 @@ GrowingVectorMemory<VectorType>::release_unused_memory()
 {
   std::lock_guard<std::mutex> lock(mutex);
 
-  if (get_pool().data != nullptr)
-    get_pool().data->clear();
+  Pool &pool = get_pool();
+  if (pool.data == nullptr)
+    return;
+
+  // collect the unused vectors of all threads. this function must not be
+  // called while other threads allocate or release vectors, so we can
+  // safely access their lists here
+  std::set<const VectorType *> unused(pool.shared_unused.begin(),
+                                      pool.shared_unused.end());
+#ifdef DEAL_II_WITH_THREADS
+  for (const std::vector<VectorType *> &thread_unused :
+       pool.thread_unused.get_implementation())
+    unused.insert(thread_unused.begin(), thread_unused.end());
+#else
+  unused.insert(pool.thread_unused.get_implementation().begin(),
+                pool.thread_unused.get_implementation().end());
+#endif
+  pool.thread_unused.clear();
+  pool.shared_unused.clear();
+
+  pool.data->erase(std::remove_if(pool.data->begin(),
+                                  pool.data->end(),
+                                  [&unused](const entry_type &entry) {
+                                    return unused.find(entry.get()) !=
+                                           unused.end();
+                                  }),
+                   pool.data->end());
 }
 
 
@@ -187,12 +238,22 @@ GrowingVectorMemory<VectorType>::memory_consumption() const
          get_pool().data->begin();
        i != end;
        ++i)
-    result += sizeof(*i) + MemoryConsumption::memory_consumption(i->second);
+    result += sizeof(*i) + MemoryConsumption::memory_consumption(*i);
 
   return result;
 }
 
 
+
+template <typename VectorType>
+inline std::pair<typename GrowingVectorMemory<VectorType>::size_type,
+                 typename GrowingVectorMemory<VectorType>::size_type>
+GrowingVectorMemory<VectorType>::get_statistics() const
+{
+  return {total_alloc - n_misses, n_misses};
+}
+
+
 DEAL_II_NAMESPACE_CLOSE
 
 #endif
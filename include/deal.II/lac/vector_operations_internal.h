@@ -351,6 +351,52 @@ namespace internal
       const Number        factor;
     };
 
+    template <typename Number, int n_vectors>
+    struct Vectorization_multi_add
+    {
+      Vectorization_multi_add(Number *const             val,
+                              const Number *const *const v_val,
+                              const Number *const        factors)
+        : val(val)
+      {
+        for (unsigned int j = 0; j < n_vectors; ++j)
+          {
+            this->v_val[j]   = v_val[j];
+            this->factors[j] = factors[j];
+          }
+      }
+
+      void
+      operator()(const size_type begin, const size_type end) const
+      {
+        if (parallel::internal::EnableOpenMPSimdFor<Number>::value)
+          {
+            DEAL_II_OPENMP_SIMD_PRAGMA
+            for (size_type i = begin; i < end; ++i)
+              {
+                Number sum = val[i];
+                for (unsigned int j = 0; j < n_vectors; ++j)
+                  sum += factors[j] * v_val[j][i];
+                val[i] = sum;
+              }
+          }
+        else
+          {
+            for (size_type i = begin; i < end; ++i)
+              {
+                Number sum = val[i];
+                for (unsigned int j = 0; j < n_vectors; ++j)
+                  sum += factors[j] * v_val[j][i];
+                val[i] = sum;
+              }
+          }
+      }
+
+      Number *const val;
+      const Number *v_val[n_vectors];
+      Number        factors[n_vectors];
+    };
+
     template <typename Number>
     struct Vectorization_sadd_xav
     {
@@ -966,6 +1012,78 @@ namespace internal
       const Number        a;
     };
 
+    /**
+     * The maximal number of vectors that the operations MultiDot and
+     * Vectorization_multi_add below process in one sweep through memory.
+     * Longer lists of vectors are worked on in batches of this size.
+     */
+    const unsigned int multi_vector_batch_size = 8;
+
+    /**
+     * A fixed-size array of @p n_vectors numbers that is used as the result
+     * type of the accumulation loops when computing several inner products
+     * at once.
+     */
+    template <typename Number, int n_vectors>
+    struct MultiDotResult
+    {
+      MultiDotResult()
+      {
+        for (unsigned int j = 0; j < n_vectors; ++j)
+          values[j] = Number();
+      }
+
+      MultiDotResult &
+      operator+=(const MultiDotResult &other)
+      {
+        for (unsigned int j = 0; j < n_vectors; ++j)
+          values[j] += other.values[j];
+        return *this;
+      }
+
+      MultiDotResult
+      operator+(const MultiDotResult &other) const
+      {
+        MultiDotResult result(*this);
+        result += other;
+        return result;
+      }
+
+      Number values[n_vectors];
+    };
+
+    // Compute the inner products of X with the n_vectors vectors Y[j] in a
+    // single sweep through X. The loop over the vectors is expanded at
+    // compile time, so the compiler vectorizes the products over j, whereas
+    // the outer accumulation loops use the same pairwise summation as the
+    // other reductions.
+    template <typename Number, typename Number2, int n_vectors>
+    struct MultiDot
+    {
+      static const bool vectorizes = false;
+
+      MultiDot(const Number *const X, const Number2 *const *const Y)
+        : X(X)
+      {
+        for (unsigned int j = 0; j < n_vectors; ++j)
+          this->Y[j] = Y[j];
+      }
+
+      MultiDotResult<Number, n_vectors>
+      operator()(const size_type i) const
+      {
+        MultiDotResult<Number, n_vectors> result;
+        const Number                      x = X[i];
+        for (unsigned int j = 0; j < n_vectors; ++j)
+          result.values[j] =
+            x * Number(numbers::NumberTraits<Number2>::conjugate(Y[j][i]));
+        return result;
+      }
+
+      const Number *const X;
+      const Number2 *     Y[n_vectors];
+    };
+
 
 
     // this is the main working loop for all vector sums using the templated
@@ -1424,6 +1542,159 @@ namespace internal
     }
 
 
+
+    // Select the instantiation of the MultiDot operation with the given number
+    // of vectors at run time, starting from the largest one
+    template <typename Number, typename Number2>
+    void
+    multi_dot_batch(
+      const std::shared_ptr<parallel::internal::TBBPartitioner> &,
+      const size_type,
+      const Number *const,
+      const Number2 *const *const,
+      const unsigned int,
+      Number *const,
+      std::integral_constant<int, 0>)
+    {
+      Assert(false, ExcInternalError());
+    }
+
+    template <typename Number, typename Number2, int n_vectors>
+    void
+    multi_dot_batch(
+      const std::shared_ptr<parallel::internal::TBBPartitioner> &partitioner,
+      const size_type                                            size,
+      const Number *const                                        X,
+      const Number2 *const *const                                Y,
+      const unsigned int                                         n,
+      Number *const                                              results,
+      std::integral_constant<int, n_vectors>)
+    {
+      if (n < n_vectors)
+        multi_dot_batch(partitioner,
+                        size,
+                        X,
+                        Y,
+                        n,
+                        results,
+                        std::integral_constant<int, n_vectors - 1>());
+      else
+        {
+          MultiDot<Number, Number2, n_vectors> op(X, Y);
+          MultiDotResult<Number, n_vectors>    result;
+          parallel_reduce(op, 0, size, result, partitioner);
+          for (unsigned int j = 0; j < n_vectors; ++j)
+            {
+              AssertIsFinite(result.values[j]);
+              results[j] = result.values[j];
+            }
+        }
+    }
+
+
+
+    /**
+     * Compute the inner products of the vector @p X of length @p size with
+     * the vectors @p Y and store them in the array @p results, i.e.,
+     * <tt>results[j] = X * Y[j]</tt>. The vector @p X is only loaded once
+     * for every batch of up to multi_vector_batch_size vectors.
+     */
+    template <typename Number, typename Number2>
+    void
+    multi_dot(
+      const std::shared_ptr<parallel::internal::TBBPartitioner> &partitioner,
+      const size_type                                            size,
+      const Number *const                                        X,
+      const std::vector<const Number2 *> &                       Y,
+      Number *const                                              results)
+    {
+      for (unsigned int first = 0; first < Y.size();
+           first += multi_vector_batch_size)
+        multi_dot_batch(
+          partitioner,
+          size,
+          X,
+          Y.data() + first,
+          std::min<unsigned int>(multi_vector_batch_size, Y.size() - first),
+          results + first,
+          std::integral_constant<int, multi_vector_batch_size>());
+    }
+
+
+
+    // Select the instantiation of the Vectorization_multi_add operation with
+    // the given number of vectors at run time, starting from the largest one
+    template <typename Number>
+    void
+    multi_add_batch(
+      const std::shared_ptr<parallel::internal::TBBPartitioner> &,
+      const size_type,
+      const Number *const,
+      const Number *const *const,
+      const unsigned int,
+      Number *const,
+      std::integral_constant<int, 0>)
+    {
+      Assert(false, ExcInternalError());
+    }
+
+    template <typename Number, int n_vectors>
+    void
+    multi_add_batch(
+      const std::shared_ptr<parallel::internal::TBBPartitioner> &partitioner,
+      const size_type                                            size,
+      const Number *const                                        factors,
+      const Number *const *const                                 Y,
+      const unsigned int                                         n,
+      Number *const                                              X,
+      std::integral_constant<int, n_vectors>)
+    {
+      if (n < n_vectors)
+        multi_add_batch(partitioner,
+                        size,
+                        factors,
+                        Y,
+                        n,
+                        X,
+                        std::integral_constant<int, n_vectors - 1>());
+      else
+        {
+          Vectorization_multi_add<Number, n_vectors> vector_add(X,
+                                                                Y,
+                                                                factors);
+          parallel_for(vector_add, 0, size, partitioner);
+        }
+    }
+
+
+
+    /**
+     * Add the multiples <tt>factors[j] * Y[j]</tt> of the vectors @p Y to
+     * the vector @p X of length @p size. The vector @p X is only loaded and
+     * stored once for every batch of up to multi_vector_batch_size vectors.
+     */
+    template <typename Number>
+    void
+    multi_add(
+      const std::shared_ptr<parallel::internal::TBBPartitioner> &partitioner,
+      const size_type                                            size,
+      const Number *const                                        factors,
+      const std::vector<const Number *> &                        Y,
+      Number *const                                              X)
+    {
+      for (unsigned int first = 0; first < Y.size();
+           first += multi_vector_batch_size)
+        multi_add_batch(
+          partitioner,
+          size,
+          factors + first,
+          Y.data() + first,
+          std::min<unsigned int>(multi_vector_batch_size, Y.size() - first),
+          X,
+          std::integral_constant<int, multi_vector_batch_size>());
+    }
+
+
     template <typename Number, typename Number2, typename MemorySpace>
     struct functions
     {
@@ -1659,6 +1930,30 @@ namespace internal
         return Number();
       }
 
+      static void
+      multi_dot(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner> &
+        /*thread_loop_partitioner*/,
+        const size_type /*size*/,
+        const std::vector<
+          const ::dealii::MemorySpace::MemorySpaceData<Number2, MemorySpace> *>
+          & /*v_data*/,
+        ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpace> & /*data*/,
+        Number *const /*results*/)
+      {}
+
+      static void
+      multi_add(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner> &
+        /*thread_loop_partitioner*/,
+        const size_type /*size*/,
+        const Number *const /*factors*/,
+        const std::vector<
+          const ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpace> *>
+          & /*v_data*/,
+        ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpace> & /*data*/)
+      {}
+
       template <typename MemorySpace2>
       static void
       import(
@@ -2016,6 +2311,46 @@ namespace internal
         return sum;
       }
 
+      static void
+      multi_dot(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+          &             thread_loop_partitioner,
+        const size_type size,
+        const std::vector<const ::dealii::MemorySpace::
+                            MemorySpaceData<Number2, ::dealii::MemorySpace::Host>
+                              *> &v_data,
+        ::dealii::MemorySpace::MemorySpaceData<Number,
+                                               ::dealii::MemorySpace::Host>
+          &          data,
+        Number *const results)
+      {
+        std::vector<const Number2 *> v_values(v_data.size());
+        for (unsigned int j = 0; j < v_data.size(); ++j)
+          v_values[j] = v_data[j]->values.get();
+        dealii::internal::VectorOperations::multi_dot(
+          thread_loop_partitioner, size, data.values.get(), v_values, results);
+      }
+
+      static void
+      multi_add(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+          &                 thread_loop_partitioner,
+        const size_type     size,
+        const Number *const factors,
+        const std::vector<const ::dealii::MemorySpace::
+                            MemorySpaceData<Number, ::dealii::MemorySpace::Host>
+                              *> &v_data,
+        ::dealii::MemorySpace::MemorySpaceData<Number,
+                                               ::dealii::MemorySpace::Host>
+          &data)
+      {
+        std::vector<const Number *> v_values(v_data.size());
+        for (unsigned int j = 0; j < v_data.size(); ++j)
+          v_values[j] = v_data[j]->values.get();
+        dealii::internal::VectorOperations::multi_add(
+          thread_loop_partitioner, size, factors, v_values, data.values.get());
+      }
+
       template <typename MemorySpace2>
       static void
       import(const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
@@ -2616,6 +2951,42 @@ namespace internal
         return res;
       }
 
+      // the CUDA variants of the block operations are simply implemented by
+      // calling the single-vector kernels one after the other
+      static void
+      multi_dot(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+          &             thread_loop_partitioner,
+        const size_type size,
+        const std::vector<const ::dealii::MemorySpace::
+                            MemorySpaceData<Number, ::dealii::MemorySpace::CUDA>
+                              *> &v_data,
+        ::dealii::MemorySpace::MemorySpaceData<Number,
+                                               ::dealii::MemorySpace::CUDA>
+          &          data,
+        Number *const results)
+      {
+        for (unsigned int j = 0; j < v_data.size(); ++j)
+          results[j] = dot(thread_loop_partitioner, size, *v_data[j], data);
+      }
+
+      static void
+      multi_add(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+          &                 thread_loop_partitioner,
+        const size_type     size,
+        const Number *const factors,
+        const std::vector<const ::dealii::MemorySpace::
+                            MemorySpaceData<Number, ::dealii::MemorySpace::CUDA>
+                              *> &v_data,
+        ::dealii::MemorySpace::MemorySpaceData<Number,
+                                               ::dealii::MemorySpace::CUDA>
+          &data)
+      {
+        for (unsigned int j = 0; j < v_data.size(); ++j)
+          add_av(thread_loop_partitioner, size, factors[j], *v_data[j], data);
+      }
+
       template <typename MemorySpace2>
       static void
       import(const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
@@ -0,0 +1,403 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_vector_snapshot_store_h
+#define dealii_vector_snapshot_store_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*! @addtogroup Vectors
+ *@{
+ */
+
+/**
+ * A store for snapshots of the locally owned entries of
+ * LinearAlgebra::distributed::Vector objects, as needed by adjoint solvers
+ * that have to revisit the forward solution of many time steps in reverse
+ * order. Each snapshot is identified by an index, typically the number of
+ * the time step, and is kept in compressed form:
+ *
+ * - If AdditionalData::tolerance is zero, the snapshots are stored
+ *   losslessly. The bytes of the values are regrouped by their significance
+ *   before compressing them with zlib, which groups the slowly varying sign
+ *   and exponent bytes of neighboring entries.
+ * - If AdditionalData::tolerance is positive, each entry is rounded to the
+ *   nearest multiple of twice the tolerance, so that the error of each
+ *   restored entry is at most the tolerance. The differences of the
+ *   resulting integers between neighboring entries are then stored, which
+ *   for smooth fields compress to a small fraction of the original size.
+ *   Snapshots with entries that are not finite or too large for this
+ *   representation are stored losslessly.
+ *
+ * The compression is done in blocks of the data in parallel, using the
+ * threads of the current process. If deal.II was configured without zlib,
+ * the data are only rearranged but not compressed.
+ *
+ * If the memory used by the snapshots exceeds AdditionalData::memory_limit
+ * and AdditionalData::spill_directory is set, the snapshots stored first
+ * are written to files in that directory, which should be node-local storage
+ * for efficiency. The files are written by background tasks, so that the
+ * calling code can continue with the next time step while the data are
+ * written; load() waits for the write of a snapshot to finish if necessary.
+ * The files are removed by remove(), clear(), and the destructor.
+ *
+ * Together with BinomialCheckpointSchedule, which determines when to store
+ * and restore snapshots if not all time steps can be stored, this class
+ * can be used as follows:
+ * @code
+ * VectorSnapshotStore<double>::AdditionalData data;
+ * data.tolerance = 1e-10;
+ * VectorSnapshotStore<double> store(data);
+ * const BinomialCheckpointSchedule schedule(n_steps, n_snapshots);
+ * unsigned int current_step = 0;
+ * for (const auto &action : schedule.get_actions())
+ *   switch (action.type)
+ *     {
+ *       case BinomialCheckpointSchedule::store:
+ *         store.store(action.slot, forward_solution);
+ *         break;
+ *       case BinomialCheckpointSchedule::restore:
+ *         store.load(action.slot, forward_solution);
+ *         current_step = action.step;
+ *         break;
+ *       case BinomialCheckpointSchedule::advance:
+ *         for (; current_step < action.step; ++current_step)
+ *           forward_step(forward_solution);
+ *         break;
+ *       case BinomialCheckpointSchedule::reverse_step:
+ *         adjoint_step(action.step, forward_solution, adjoint_solution);
+ *         break;
+ *     }
+ * @endcode
+ *
+ * The functions of this class must not be called concurrently.
+ *
+ * @author The deal.II developers, 2019
+ */
+template <typename Number>
+class VectorSnapshotStore : public Subscriptor
+{
+public:
+  /**
+   * Parameters of the store.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(const double       tolerance = 0.,
+                   const std::size_t  memory_limit =
+                     std::numeric_limits<std::size_t>::max(),
+                   const std::string &spill_directory = "");
+
+    /**
+     * The maximal absolute error of each restored entry, or zero for
+     * lossless storage.
+     */
+    double tolerance;
+
+    /**
+     * The maximal number of bytes of compressed snapshots kept in memory
+     * before snapshots are written to @p spill_directory.
+     */
+    std::size_t memory_limit;
+
+    /**
+     * The directory the snapshots exceeding @p memory_limit are written to.
+     * If empty, all snapshots are kept in memory regardless of
+     * @p memory_limit.
+     */
+    std::string spill_directory;
+  };
+
+  /**
+   * Constructor.
+   */
+  VectorSnapshotStore(const AdditionalData &additional_data = AdditionalData());
+
+  /**
+   * Destructor. Waits for all pending writes and removes the files written
+   * by this object.
+   */
+  ~VectorSnapshotStore() override;
+
+  /**
+   * Store the locally owned entries of @p vector under @p index, replacing
+   * a snapshot previously stored under this index.
+   */
+  void
+  store(const unsigned int                                index,
+        const LinearAlgebra::distributed::Vector<Number> &vector);
+
+  /**
+   * Restore the locally owned entries of @p vector from the snapshot stored
+   * under @p index. The vector needs to have the same parallel layout as the
+   * one the snapshot was taken from. The ghost entries of @p vector are set
+   * to zero.
+   */
+  void
+  load(const unsigned int                          index,
+       LinearAlgebra::distributed::Vector<Number> &vector) const;
+
+  /**
+   * Return whether a snapshot is stored under @p index.
+   */
+  bool
+  has_snapshot(const unsigned int index) const;
+
+  /**
+   * Remove the snapshot stored under @p index, if any.
+   */
+  void
+  remove(const unsigned int index);
+
+  /**
+   * Remove all snapshots.
+   */
+  void
+  clear();
+
+  /**
+   * Return the number of bytes of the compressed snapshots currently held in
+   * memory.
+   */
+  std::size_t
+  n_bytes_in_memory() const;
+
+  /**
+   * Return the number of bytes the snapshots currently held would need
+   * without compression.
+   */
+  std::size_t
+  n_bytes_uncompressed() const;
+
+  /**
+   * Return an estimate for the memory consumption, in bytes, of this object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+  /**
+   * Exception.
+   */
+  DeclException1(ExcNoSnapshot,
+                 unsigned int,
+                 << "No snapshot has been stored under the index " << arg1
+                 << ".");
+
+private:
+  /**
+   * A compressed snapshot.
+   */
+  struct Snapshot
+  {
+    /**
+     * The number of values of the snapshot.
+     */
+    std::size_t n_values;
+
+    /**
+     * The distance between the representable values if the values were
+     * rounded, or zero if they were stored losslessly.
+     */
+    double quantum;
+
+    /**
+     * The compressed blocks of the data, one after the other. Empty if the
+     * snapshot has been written to disk.
+     */
+    std::vector<char> data;
+
+    /**
+     * The compressed sizes of the blocks in @p data.
+     */
+    std::vector<std::size_t> block_sizes;
+
+    /**
+     * The name of the file the snapshot was written to, or an empty string
+     * if it is held in memory.
+     */
+    std::string file_name;
+
+    /**
+     * The task writing the file, if any.
+     */
+    mutable Threads::Task<void> write_task;
+  };
+
+  /**
+   * Write the snapshots stored first to files until the memory limit is
+   * met again.
+   */
+  void
+  spill_to_disk();
+
+  /**
+   * The parameters of the store.
+   */
+  const AdditionalData additional_data;
+
+  /**
+   * The snapshots.
+   */
+  std::map<unsigned int, Snapshot> snapshots;
+
+  /**
+   * The indices of the snapshots held in memory, in the order they were
+   * stored.
+   */
+  std::list<unsigned int> in_memory_order;
+
+  /**
+   * The sum of the sizes of the compressed snapshots held in memory.
+   */
+  std::size_t bytes_in_memory;
+};
+
+
+
+/**
+ * The schedule of binomial checkpointing for reversing a time integration
+ * with @p n_steps steps when only @p n_snapshots states can be stored at a
+ * time, following A. Griewank, A. Walther: "Algorithm 799: Revolve: An
+ * Implementation of Checkpointing for the Reverse or Adjoint Mode of
+ * Computational Differentiation", ACM TOMS 26 (2000). With $s$ snapshots
+ * and $r$ forward sweeps over each step, up to $\binom{s+r}{s}$ steps can
+ * be reversed, so the recomputation cost grows only logarithmically with
+ * the number of steps for a fixed number of snapshots.
+ *
+ * Time step $i$, for $0\le i<$ @p n_steps, takes the forward state from
+ * $u_i$ to $u_{i+1}$. The schedule is a list of actions for a program that
+ * holds one forward state $u_i$ (initially $u_0$) and a set of
+ * @p n_snapshots slots to store states in, see VectorSnapshotStore for an
+ * example of how to execute it:
+ * - store: store the current state, $u_{\text{step}}$, in the slot
+ *   @p slot.
+ * - restore: replace the current state by the state $u_{\text{step}}$
+ *   stored in the slot @p slot.
+ * - advance: perform forward time steps until the current state is
+ *   $u_{\text{step}}$.
+ * - reverse_step: perform the adjoint of time step @p step, for which the
+ *   current forward state is $u_{\text{step}}$. The steps are reversed in
+ *   the order @p n_steps-1, ..., 0. After this action, the current forward
+ *   state is not used anymore until the next restore.
+ *
+ * The initial state is stored in slot 0 by the first action of every
+ * schedule, and remains there.
+ *
+ * @author The deal.II developers, 2019
+ */
+class BinomialCheckpointSchedule
+{
+public:
+  /**
+   * The kinds of actions, see the class documentation.
+   */
+  enum ActionType
+  {
+    store,
+    restore,
+    advance,
+    reverse_step
+  };
+
+  /**
+   * An action of the schedule.
+   */
+  struct Action
+  {
+    /**
+     * The kind of action.
+     */
+    ActionType type;
+
+    /**
+     * The time step the action refers to.
+     */
+    unsigned int step;
+
+    /**
+     * The slot for store and restore actions, or
+     * numbers::invalid_unsigned_int for the other actions.
+     */
+    unsigned int slot;
+  };
+
+  /**
+   * Constructor. Compute the schedule for reversing @p n_steps time steps
+   * with @p n_snapshots slots, which must be at least one.
+   */
+  BinomialCheckpointSchedule(const unsigned int n_steps,
+                             const unsigned int n_snapshots);
+
+  /**
+   * Return the actions of the schedule.
+   */
+  const std::vector<Action> &
+  get_actions() const;
+
+  /**
+   * Return the total number of forward time steps the schedule performs,
+   * which is at least @p n_steps-1.
+   */
+  unsigned int
+  n_forward_steps() const;
+
+private:
+  /**
+   * Append the actions that reverse the time steps from @p start to @p end
+   * to the schedule, given that the current state is $u_{\text{start}}$,
+   * which is also stored in the slot @p start_slot, and the slots from
+   * @p first_free_slot on are available.
+   */
+  void
+  reverse(const unsigned int start,
+          const unsigned int end,
+          const unsigned int start_slot,
+          const unsigned int first_free_slot);
+
+  /**
+   * The number of slots.
+   */
+  const unsigned int n_snapshots;
+
+  /**
+   * The actions.
+   */
+  std::vector<Action> actions;
+};
+
+/*@}*/
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -96,9 +96,11 @@ namespace CUDAWrappers
       AdditionalData(
         const ParallelizationScheme parallelization_scheme = parallel_in_elem,
         const UpdateFlags           mapping_update_flags   = update_gradients |
-                                                 update_JxW_values)
+                                                 update_JxW_values,
+        const bool overlap_communication_computation = false)
         : parallelization_scheme(parallelization_scheme)
         , mapping_update_flags(mapping_update_flags)
+        , overlap_communication_computation(overlap_communication_computation)
       {}
 
       /**
@@ -120,6 +122,16 @@ namespace CUDAWrappers
        * must be specified by this field.
        */
       UpdateFlags mapping_update_flags;
+
+      /**
+       * If true, the cells whose degrees of freedom are all locally owned are
+       * colored separately from the cells that touch ghost entries. In
+       * cell_loop() on distributed vectors, the kernels for the former are
+       * then launched before waiting for the import of the ghost values, so
+       * that the MPI communication overlaps with computations on the device.
+       * This flag is ignored when MPI is not used.
+       */
+      bool overlap_communication_computation;
     };
 
     /**
@@ -407,6 +419,19 @@ namespace CUDAWrappers
      */
     unsigned int n_colors;
 
+    /**
+     * If true, the import of the ghost values in distributed_cell_loop() is
+     * overlapped with the kernels of the first n_inner_colors colors.
+     */
+    bool overlap_communication_computation;
+
+    /**
+     * Number of colors, stored first, whose cells do not touch any ghost
+     * entry. This is only non-zero if overlap_communication_computation is
+     * set.
+     */
+    unsigned int n_inner_colors;
+
     /**
      * Number of cells in each color.
      */
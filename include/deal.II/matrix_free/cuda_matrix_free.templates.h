@@ -471,6 +471,55 @@ namespace CUDAWrappers
 
 
 
+    /**
+     * Return the number of bytes of dynamically allocated shared memory that
+     * apply_kernel_shmem() needs for one thread block: the values of all the
+     * cells in the block followed by the dim components of their gradients.
+     */
+    template <int dim, typename Number, typename Functor>
+    constexpr std::size_t
+    shared_memory_size()
+    {
+      return cells_per_block_shmem(dim, Functor::n_dofs_1d - 1) *
+             (Functor::n_local_dofs + dim * Functor::n_q_points) *
+             sizeof(Number);
+    }
+
+
+
+    template <int dim, typename Number, typename Functor>
+    __global__ void
+    apply_kernel_shmem(Functor                                      func,
+                       const typename MatrixFree<dim, Number>::Data gpu_data,
+                       const Number *                               src,
+                       Number *                                     dst);
+
+
+
+    /**
+     * Prepare the launch of apply_kernel_shmem() for the given @p Functor.
+     * For high polynomial degrees, the shared memory needed by one thread
+     * block exceeds the default limit of 48 kB and the kernel has to opt in
+     * to the larger amount of shared memory available on recent devices.
+     */
+    template <int dim, typename Number, typename Functor>
+    void
+    prepare_apply_kernel_shmem()
+    {
+      constexpr std::size_t shmem_size =
+        shared_memory_size<dim, Number, Functor>();
+      if (shmem_size > 48 * 1024)
+        {
+          const cudaError_t cuda_error = cudaFuncSetAttribute(
+            apply_kernel_shmem<dim, Number, Functor>,
+            cudaFuncAttributeMaxDynamicSharedMemorySize,
+            shmem_size);
+          AssertCuda(cuda_error);
+        }
+    }
+
+
+
     template <int dim, typename Number, typename Functor>
     __global__ void
     apply_kernel_shmem(Functor                                      func,
@@ -485,9 +534,14 @@ namespace CUDAWrappers
         cells_per_block * Functor::n_local_dofs;
       constexpr unsigned int n_q_points_per_block =
         cells_per_block * Functor::n_q_points;
-      // TODO make use of dynamically allocated shared memory
-      __shared__ Number values[n_dofs_per_block];
-      __shared__ Number gradients[dim][n_q_points_per_block];
+
+      // The shared memory is allocated dynamically at kernel launch, see
+      // shared_memory_size(). An extern __shared__ array cannot depend on a
+      // template parameter, so we declare it with a type that is suitably
+      // aligned for all Number types and cast it.
+      extern __shared__ double2 shared_memory_buffer[];
+      Number *values    = reinterpret_cast<Number *>(shared_memory_buffer);
+      Number *gradients = values + n_dofs_per_block;
 
       const unsigned int local_cell = threadIdx.x / Functor::n_dofs_1d;
       const unsigned int cell =
@@ -495,10 +549,11 @@ namespace CUDAWrappers
 
       Number *gq[dim];
       for (int d = 0; d < dim; ++d)
-        gq[d] = &gradients[d][local_cell * Functor::n_q_points];
+        gq[d] = gradients + d * n_q_points_per_block +
+                local_cell * Functor::n_q_points;
 
       SharedData<dim, Number> shared_data(
-        &values[local_cell * Functor::n_local_dofs], gq);
+        values + local_cell * Functor::n_local_dofs, gq);
 
       if (cell < gpu_data.n_cells)
         func(cell, &gpu_data, &shared_data, src, dst);
@@ -528,6 +583,8 @@ namespace CUDAWrappers
   template <int dim, typename Number>
   MatrixFree<dim, Number>::MatrixFree()
     : n_dofs(0)
+    , overlap_communication_computation(false)
+    , n_inner_colors(0)
     , constrained_dofs(nullptr)
     , padding_length(0)
   {}
@@ -818,6 +875,16 @@ namespace CUDAWrappers
 
     Assert(n_dofs_1d == n_q_points_1d,
            ExcMessage("n_q_points_1d must be equal to fe_degree+1."));
+    AssertThrow(fe_degree <= internal::max_elem_degree,
+                ExcMessage("The shape functions stored in constant memory "
+                           "only support polynomial degrees up to " +
+                           std::to_string(internal::max_elem_degree) + "."));
+    AssertThrow(
+      parallelization_scheme == parallel_over_elem ||
+        Utilities::fixed_power<dim>(n_dofs_1d) <= 1024,
+      ExcMessage("With parallel_in_elem, one CUDA thread is used per degree "
+                 "of freedom of a cell, but a thread block cannot hold more "
+                 "than 1024 threads."));
 
     // Set padding length to the closest power of two larger than or equal to
     // the number of threads.
@@ -865,8 +932,49 @@ namespace CUDAWrappers
       return internal::get_conflict_indices<dim, Number>(filter, constraints);
     };
 
+    overlap_communication_computation =
+      comm && additional_data.overlap_communication_computation;
+    n_inner_colors = 0;
+
     std::vector<std::vector<CellFilter>> graph;
-    if (begin != end)
+    if (overlap_communication_computation)
+      {
+        // Color the cells that only touch locally owned degrees of freedom
+        // and the ones that also touch ghost entries separately, and store
+        // the colors of the former first.
+        const IndexSet &owned_dofs = dof_handler.locally_owned_dofs();
+        for (const bool touches_ghosts : {false, true})
+          {
+            const auto predicate =
+              [&owned_dofs, touches_ghosts](
+                const typename DoFHandler<dim>::active_cell_iterator &cell) {
+                if (!cell->is_locally_owned())
+                  return false;
+                std::vector<types::global_dof_index> dof_indices(
+                  cell->get_fe().dofs_per_cell);
+                cell->get_dof_indices(dof_indices);
+                for (const auto dof : dof_indices)
+                  if (!owned_dofs.is_element(dof))
+                    return touches_ghosts;
+                return !touches_ghosts;
+              };
+            CellFilter begin_subset(predicate, dof_handler.begin_active());
+            CellFilter end_subset(predicate, dof_handler.end());
+            if (begin_subset != end_subset)
+              {
+                const auto subset_graph =
+                  GraphColoring::make_graph_coloring(begin_subset,
+                                                     end_subset,
+                                                     fun);
+                graph.insert(graph.end(),
+                             subset_graph.begin(),
+                             subset_graph.end());
+              }
+            if (!touches_ghosts)
+              n_inner_colors = graph.size();
+          }
+      }
+    else if (begin != end)
       graph = GraphColoring::make_graph_coloring(begin, end, fun);
     n_colors = graph.size();
 
@@ -973,12 +1081,15 @@ namespace CUDAWrappers
                                             VectorType &      dst) const
   {
     // Execute the loop on the cells
+    internal::prepare_apply_kernel_shmem<dim, Number, Functor>();
+    constexpr std::size_t shmem_size =
+      internal::shared_memory_size<dim, Number, Functor>();
     for (unsigned int i = 0; i < n_colors; ++i)
       internal::apply_kernel_shmem<dim, Number, Functor>
-        <<<grid_dim[i], block_dim[i]>>>(func,
-                                        get_data(i),
-                                        src.get_values(),
-                                        dst.get_values());
+        <<<grid_dim[i], block_dim[i], shmem_size>>>(func,
+                                                    get_data(i),
+                                                    src.get_values(),
+                                                    dst.get_values());
   }
 
 
@@ -996,15 +1107,39 @@ namespace CUDAWrappers
       partitioner);
     LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA> ghosted_dst(
       ghosted_src);
-    ghosted_src = src;
+    if (overlap_communication_computation)
+      {
+        // Only copy the locally owned values and start the import of the
+        // ghost values. It is completed after the kernels for the cells that
+        // do not touch ghost entries have been launched.
+        AssertDimension(src.local_size(), partitioner->local_size());
+        const cudaError_t cuda_error =
+          cudaMemcpy(ghosted_src.get_values(),
+                     src.get_values(),
+                     partitioner->local_size() * sizeof(Number),
+                     cudaMemcpyDeviceToDevice);
+        AssertCuda(cuda_error);
+        ghosted_src.update_ghost_values_start();
+      }
+    else
+      ghosted_src = src;
 
     // Execute the loop on the cells
+    internal::prepare_apply_kernel_shmem<dim, Number, Functor>();
+    constexpr std::size_t shmem_size =
+      internal::shared_memory_size<dim, Number, Functor>();
     for (unsigned int i = 0; i < n_colors; ++i)
-      internal::apply_kernel_shmem<dim, Number, Functor>
-        <<<grid_dim[i], block_dim[i]>>>(func,
-                                        get_data(i),
-                                        ghosted_src.get_values(),
-                                        ghosted_dst.get_values());
+      {
+        if (overlap_communication_computation && i == n_inner_colors)
+          ghosted_src.update_ghost_values_finish();
+        internal::apply_kernel_shmem<dim, Number, Functor>
+          <<<grid_dim[i], block_dim[i], shmem_size>>>(func,
+                                                      get_data(i),
+                                                      ghosted_src.get_values(),
+                                                      ghosted_dst.get_values());
+      }
+    if (overlap_communication_computation && n_inner_colors == n_colors)
+      ghosted_src.update_ghost_values_finish();
 
     // Add the ghosted values
     ghosted_dst.compress(VectorOperation::add);
@@ -133,6 +133,11 @@ namespace internal
        * processor, get a temporary number by this function, and will later be
        * assigned the correct index after all the ghost indices have been
        * collected by the call to @p assign_ghosts.
+       *
+       * If the cell has a nonzero entry in @p hanging_node_constraint_masks,
+       * the argument @p local_indices_plain holds the indices of the cell
+       * before the hanging degrees of freedom have been replaced, which are
+       * stored as the plain indices of the cell.
        */
       template <typename number>
       void
@@ -142,7 +147,9 @@ namespace internal
         const AffineConstraints<number> &           constraints,
         const unsigned int                          cell_number,
         ConstraintValues<double> &                  constraint_values,
-        bool &                                      cell_at_boundary);
+        bool &                                      cell_at_boundary,
+        const std::vector<types::global_dof_index> &local_indices_plain =
+          std::vector<types::global_dof_index>());
 
       /**
        * This method assigns the correct indices to ghost indices from the
@@ -215,6 +222,16 @@ namespace internal
        * The intent of this pattern is to zero the vector entries in close
        * temporal proximity to the first access and thus keeping the vector
        * entries in cache.
+       *
+       * In addition, this function fills the lists @p cell_loop_pre_list and
+       * @p cell_loop_post_list with the ranges of locally owned degrees of
+       * freedom that are touched the first and the last time, respectively,
+       * within a partition of the loop. Ranges that are communicated with
+       * other processes or that are not touched by any cell are assigned to
+       * the extra index after the last partition, to be scheduled before and
+       * after the loop. Likewise, the list @p cell_loop_post_cell_list is
+       * filled with the cell batches whose degrees of freedom are touched
+       * the last time within a partition.
        */
       template <int length>
       void
@@ -222,6 +239,18 @@ namespace internal
         const TaskInfo &                               task_info,
         const std::vector<FaceToCellTopology<length>> &faces);
 
+      /**
+       * Fills the fields @p ghost_targets_by_range and @p
+       * ghost_targets_by_range_index with the processes whose ghost data is
+       * read by the cells and faces of each range of the loop in TaskInfo
+       * that touches the processor boundary.
+       */
+      template <int length>
+      void
+      compute_ghost_targets_by_range(
+        const TaskInfo &                               task_info,
+        const std::vector<FaceToCellTopology<length>> &faces);
+
       /**
        * Return the memory consumption in bytes of this class.
        */
@@ -504,6 +533,20 @@ namespace internal
        */
       std::vector<unsigned int> plain_dof_indices;
 
+      /**
+       * Stores the mask of hanging node constraints for each cell that are
+       * resolved on the fly by FEEvaluation rather than through the entries
+       * in @p constraint_indicator, with the encoding described in
+       * internal::MatrixFreeFunctions::HangingNodeConstraintMask. The index
+       * runs over the cells in the numbering of @p row_starts, i.e., over the
+       * lanes of all cell batches after reorder_cells() has been called. For
+       * cells with a nonzero mask, the indices of the degrees of freedom
+       * sitting at hanging nodes are replaced by the ones on the coarser
+       * neighbor in @p dof_indices, whereas @p plain_dof_indices contain the
+       * original indices. The vector is empty if the algorithm is not used.
+       */
+      std::vector<unsigned int> hanging_node_constraint_masks;
+
       /**
        * Stores the offset in terms of the number of base elements over all
        * DoFInfo objects.
@@ -598,6 +641,69 @@ namespace internal
        * Stores the actual ranges in the vector to be cleared.
        */
       std::vector<unsigned int> vector_zero_range_list;
+
+      /**
+       * Stores an integer to each partition in TaskInfo that indicates when
+       * to schedule operations that will be done before any access to vector
+       * entries. The last entry refers to the operations that must be done
+       * before the loop starts, i.e., before the ghost values are sent.
+       */
+      std::vector<unsigned int> cell_loop_pre_list_index;
+
+      /**
+       * Stores the actual ranges of the operation before any access to
+       * vector entries, in terms of the MPI-local indices of the locally
+       * owned degrees of freedom.
+       */
+      std::vector<std::pair<unsigned int, unsigned int>> cell_loop_pre_list;
+
+      /**
+       * Stores an integer to each partition in TaskInfo that indicates when
+       * to schedule operations that will be done after all access to vector
+       * entries. The last entry refers to the operations that must be done
+       * after the loop has finished, i.e., after the compress operation.
+       */
+      std::vector<unsigned int> cell_loop_post_list_index;
+
+      /**
+       * Stores the actual ranges of the operation after all access to vector
+       * entries, in terms of the MPI-local indices of the locally owned
+       * degrees of freedom.
+       */
+      std::vector<std::pair<unsigned int, unsigned int>> cell_loop_post_list;
+
+      /**
+       * Stores an integer to each partition in TaskInfo that indicates when
+       * to schedule operations on cell batches that need the contributions
+       * of the cells and all faces to the degrees of freedom of the cells,
+       * in analogy to @p cell_loop_post_list_index.
+       */
+      std::vector<unsigned int> cell_loop_post_cell_list_index;
+
+      /**
+       * Stores the ranges of cell batches whose degrees of freedom are
+       * touched the last time within the partitions given by
+       * @p cell_loop_post_cell_list_index. The ranges do not extend over
+       * the cell partitions of TaskInfo.
+       */
+      std::vector<std::pair<unsigned int, unsigned int>>
+        cell_loop_post_cell_list;
+
+      /**
+       * Stores for the ranges of cells and faces in the loop of TaskInfo
+       * the processes whose ghost data is read within the range, in terms of
+       * the index within the ghost targets of @p vector_partitioner. The
+       * data is stored in compressed row format with the row starts in @p
+       * ghost_targets_by_range_index. Only ranges at the processor boundary
+       * have entries, and the fields are only filled if
+       * TaskInfo::overlap_communication_by_process is set.
+       */
+      std::vector<unsigned int> ghost_targets_by_range;
+
+      /**
+       * Stores the row starts of the field @p ghost_targets_by_range.
+       */
+      std::vector<unsigned int> ghost_targets_by_range_index;
     };
 
 
@@ -29,6 +29,8 @@
 #include <deal.II/matrix_free/mapping_info.h>
 #include <deal.II/matrix_free/task_info.h>
 
+#include <algorithm>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace internal
@@ -167,7 +169,16 @@ namespace internal
       start_components.clear();
       row_starts_plain_indices.clear();
       plain_dof_indices.clear();
+      hanging_node_constraint_masks.clear();
       dof_indices_interleaved.clear();
+      cell_loop_pre_list_index.clear();
+      cell_loop_pre_list.clear();
+      cell_loop_post_list_index.clear();
+      cell_loop_post_list.clear();
+      cell_loop_post_cell_list_index.clear();
+      cell_loop_post_cell_list.clear();
+      ghost_targets_by_range.clear();
+      ghost_targets_by_range_index.clear();
       for (unsigned int i = 0; i < 3; ++i)
         {
           index_storage_variants[i].clear();
@@ -217,7 +228,9 @@ namespace internal
           // shift for this cell within the block as compared to the next
           // one
           const bool has_constraints =
-            row_starts[ib].second != row_starts[ib + n_fe_components].second;
+            row_starts[ib].second != row_starts[ib + n_fe_components].second ||
+            (!hanging_node_constraint_masks.empty() &&
+             hanging_node_constraint_masks[cell * n_vectorization + v] != 0);
 
           auto do_copy = [&](const unsigned int *begin,
                              const unsigned int *end) {
@@ -258,7 +271,8 @@ namespace internal
       const AffineConstraints<number> &           constraints,
       const unsigned int                          cell_number,
       ConstraintValues<double> &                  constraint_values,
-      bool &                                      cell_at_subdomain_boundary)
+      bool &                                      cell_at_subdomain_boundary,
+      const std::vector<types::global_dof_index> &local_indices_plain)
     {
       Assert(vector_partitioner.get() != nullptr, ExcInternalError());
       const unsigned int n_mpi_procs = vector_partitioner->n_mpi_processes();
@@ -395,15 +409,25 @@ namespace internal
             row_starts_plain_indices.resize(
               (row_starts.size() - 1) / n_components + 1);
           row_starts_plain_indices[cell_number] = plain_dof_indices.size();
+          const bool cell_has_hanging_node_constraints =
+            (hanging_node_constraint_masks.size() > cell_number &&
+             hanging_node_constraint_masks[cell_number] != 0);
           const bool cell_has_constraints =
             (row_starts[(cell_number + 1) * n_components].second >
-             row_starts[cell_number * n_components].second);
+             row_starts[cell_number * n_components].second) ||
+            cell_has_hanging_node_constraints;
           if (cell_has_constraints == true)
             {
+              Assert(!cell_has_hanging_node_constraints ||
+                       local_indices_plain.size() == local_indices.size(),
+                     ExcInternalError());
+              const std::vector<types::global_dof_index> &plain_indices =
+                cell_has_hanging_node_constraints ? local_indices_plain :
+                                                    local_indices;
               for (unsigned int i = 0; i < dofs_this_cell; ++i)
                 {
                   types::global_dof_index current_dof =
-                    local_indices[lexicographic_inv[i]];
+                    plain_indices[lexicographic_inv[i]];
                   if (n_mpi_procs > 1 &&
                       (current_dof < first_owned || current_dof >= last_owned))
                     {
@@ -505,7 +529,10 @@ namespace internal
               if (store_plain_indices == true)
                 {
                   if (row_starts[boundary_cells[i] * n_components].second !=
-                      row_starts[(boundary_cells[i] + 1) * n_components].second)
+                        row_starts[(boundary_cells[i] + 1) * n_components]
+                          .second ||
+                      (!hanging_node_constraint_masks.empty() &&
+                       hanging_node_constraint_masks[boundary_cells[i]] != 0))
                     {
                       unsigned int *data_ptr =
                         plain_dof_indices.data() +
@@ -531,12 +558,12 @@ namespace internal
       std::vector<types::global_dof_index> empty;
       ghost_dofs.swap(empty);
 
-      // set the ghost indices now. need to cast away constness here, but that
-      // is uncritical since we reset the Partitioner in the same initialize
-      // call as this call here.
-      Utilities::MPI::Partitioner *vec_part =
-        const_cast<Utilities::MPI::Partitioner *>(vector_partitioner.get());
-      vec_part->set_ghost_indices(ghost_indices);
+      // set the ghost indices now. the partitioner is shared with other
+      // MatrixFree objects that use the same index layout
+      vector_partitioner = Utilities::MPI::Partitioner::create_shared(
+        vector_partitioner->locally_owned_range(),
+        ghost_indices,
+        vector_partitioner->get_mpi_communicator());
     }
 
 
@@ -593,7 +620,11 @@ namespace internal
       std::vector<std::pair<unsigned short, unsigned short>>
                                 new_constraint_indicator;
       std::vector<unsigned int> new_plain_indices, new_rowstart_plain;
+      std::vector<unsigned int> new_hanging_node_constraint_masks;
       unsigned int              position_cell = 0;
+      if (!hanging_node_constraint_masks.empty())
+        new_hanging_node_constraint_masks.resize(
+          vectorization_length * task_info.cell_partition_data.back(), 0);
       new_dof_indices.reserve(dof_indices.size());
       new_constraint_indicator.reserve(constraint_indicator.size());
       if (store_plain_indices == true)
@@ -643,9 +674,17 @@ namespace internal
                     new_constraint_indicator.push_back(
                       constraint_indicator[index]);
                 }
+              const bool has_hanging_node_constraints =
+                !hanging_node_constraint_masks.empty() &&
+                hanging_node_constraint_masks[cell_no / n_components] != 0;
+              if (has_hanging_node_constraints)
+                new_hanging_node_constraint_masks[i * vectorization_length +
+                                                  j] =
+                  hanging_node_constraint_masks[cell_no / n_components];
               if (store_plain_indices &&
-                  row_starts[cell_no].second !=
-                    row_starts[cell_no + n_components].second)
+                  (row_starts[cell_no].second !=
+                     row_starts[cell_no + n_components].second ||
+                   has_hanging_node_constraints))
                 {
                   new_rowstart_plain[i * vectorization_length + j] =
                     new_plain_indices.size();
@@ -688,6 +727,7 @@ namespace internal
       new_constraint_indicator.swap(constraint_indicator);
       new_plain_indices.swap(plain_dof_indices);
       new_rowstart_plain.swap(row_starts_plain_indices);
+      new_hanging_node_constraint_masks.swap(hanging_node_constraint_masks);
 
 #ifdef DEBUG
       // sanity check 1: all indices should be smaller than the number of dofs
@@ -794,7 +834,9 @@ namespace internal
             {
               const unsigned int cell_no = i * vectorization_length + j;
               if (row_starts[cell_no * n_components].second !=
-                  row_starts[(cell_no + 1) * n_components].second)
+                    row_starts[(cell_no + 1) * n_components].second ||
+                  (!hanging_node_constraint_masks.empty() &&
+                   hanging_node_constraint_masks[cell_no] != 0))
                 {
                   has_constraints = true;
                   break;
@@ -1069,6 +1111,15 @@ namespace internal
                 interleaved_dof_indices[k * vectorization_length + j] =
                   dof_indices[j * ndofs + k];
           }
+
+      // Step 5: The interleaved indices mirror the full array of indices, so
+      // release the memory in case no cell batch ended up with that storage
+      // variant as is typical for continuous elements with constraints
+      if (std::find(index_storage_variants[dof_access_cell].begin(),
+                    index_storage_variants[dof_access_cell].end(),
+                    IndexStorageVariants::interleaved) ==
+          index_storage_variants[dof_access_cell].end())
+        std::vector<unsigned int>().swap(dof_indices_interleaved);
     }
 
 
@@ -1217,6 +1268,8 @@ namespace internal
       std::vector<unsigned int> touched_by(
         (n_dofs + chunk_size_zero_vector - 1) / chunk_size_zero_vector,
         numbers::invalid_unsigned_int);
+      std::vector<unsigned int> touched_last_by(touched_by.size(),
+                                                numbers::invalid_unsigned_int);
       for (unsigned int part = 0;
            part < task_info.partition_row_index.size() - 2;
            ++part)
@@ -1240,6 +1293,7 @@ namespace internal
                       dof_indices[it] / chunk_size_zero_vector;
                     if (touched_by[myindex] == numbers::invalid_unsigned_int)
                       touched_by[myindex] = chunk;
+                    touched_last_by[myindex] = chunk;
                   }
               }
             if (faces.size() > 0)
@@ -1262,9 +1316,151 @@ namespace internal
                         if (touched_by[myindex] ==
                             numbers::invalid_unsigned_int)
                           touched_by[myindex] = chunk;
+                        touched_last_by[myindex] = chunk;
                       }
                   }
+            // the cells on the interior side of faces are touched the last
+            // time by the face if the cell on the exterior side comes later
+            // in the loop
+            if (faces.size() > 0)
+              {
+                const auto touch_interior_cells = [&](const unsigned int begin,
+                                                      const unsigned int end) {
+                  for (unsigned int face = begin; face < end; ++face)
+                    for (unsigned int v = 0;
+                         v < length && faces[face].cells_interior[v] !=
+                                         numbers::invalid_unsigned_int;
+                         ++v)
+                      {
+                        const unsigned int cell =
+                          faces[face].cells_interior[v];
+                        for (unsigned int it =
+                               row_starts[cell * n_components].first;
+                             it != row_starts[(cell + 1) * n_components].first;
+                             ++it)
+                          touched_last_by[dof_indices[it] /
+                                          chunk_size_zero_vector] = chunk;
+                      }
+                };
+                touch_interior_cells(task_info.face_partition_data[chunk],
+                                     task_info.face_partition_data[chunk + 1]);
+                touch_interior_cells(
+                  task_info.boundary_partition_data[chunk],
+                  task_info.boundary_partition_data[chunk + 1]);
+              }
+          }
+      // compute the ranges of locally owned entries for the operations
+      // before and after the cell loop. Entries that are not touched by any
+      // cell or that get imported/exported via MPI are assigned to the
+      // additional slot 'n_loop_chunks' that is scheduled before the ghost
+      // exchange starts and after the compress operation has finished
+      {
+        const unsigned int n_loop_chunks =
+          task_info
+            .partition_row_index[task_info.partition_row_index.size() - 2];
+        const unsigned int local_size = vector_partitioner->local_size();
+        const unsigned int n_owned_chunks =
+          (local_size + chunk_size_zero_vector - 1) / chunk_size_zero_vector;
+        std::vector<unsigned int> pre_chunk(n_owned_chunks),
+          post_chunk(n_owned_chunks);
+        for (unsigned int i = 0; i < n_owned_chunks; ++i)
+          {
+            pre_chunk[i] = touched_by[i] == numbers::invalid_unsigned_int ?
+                             n_loop_chunks :
+                             touched_by[i];
+            post_chunk[i] =
+              touched_last_by[i] == numbers::invalid_unsigned_int ?
+                n_loop_chunks :
+                touched_last_by[i];
+          }
+        for (const auto &range : vector_partitioner->import_indices())
+          for (unsigned int i = range.first / chunk_size_zero_vector;
+               i < (range.second + chunk_size_zero_vector - 1) /
+                     chunk_size_zero_vector;
+               ++i)
+            pre_chunk[i] = post_chunk[i] = n_loop_chunks;
+
+        const auto fill_range_list =
+          [&](const std::vector<unsigned int> &chunk_assignment,
+              std::vector<unsigned int> &      list_index,
+              std::vector<std::pair<unsigned int, unsigned int>> &list) {
+            std::vector<std::vector<unsigned int>> chunks_in_slot(
+              n_loop_chunks + 1);
+            for (unsigned int i = 0; i < chunk_assignment.size(); ++i)
+              chunks_in_slot[chunk_assignment[i]].push_back(i);
+            list_index.resize(n_loop_chunks + 2);
+            list.clear();
+            list_index[0] = 0;
+            for (unsigned int slot = 0; slot <= n_loop_chunks; ++slot)
+              {
+                // merge adjacent chunks into a single range
+                for (const unsigned int i : chunks_in_slot[slot])
+                  {
+                    const unsigned int begin = i * chunk_size_zero_vector;
+                    const unsigned int end =
+                      std::min(begin + chunk_size_zero_vector, local_size);
+                    if (list.size() > list_index[slot] &&
+                        list.back().second == begin)
+                      list.back().second = end;
+                    else
+                      list.emplace_back(begin, end);
+                  }
+                list_index[slot + 1] = list.size();
+              }
+          };
+        fill_range_list(pre_chunk,
+                        cell_loop_pre_list_index,
+                        cell_loop_pre_list);
+        fill_range_list(post_chunk,
+                        cell_loop_post_list_index,
+                        cell_loop_post_list);
+
+        // a cell batch is complete after the last range touching one of its
+        // degrees of freedom. Cells with entries exchanged via MPI are only
+        // complete after the compress operation
+        std::vector<std::vector<unsigned int>> cells_in_slot(n_loop_chunks +
+                                                             1);
+        std::vector<unsigned int> cell_chunk(
+          task_info.cell_partition_data[n_loop_chunks]);
+        for (unsigned int chunk = 0; chunk < n_loop_chunks; ++chunk)
+          for (unsigned int cell = task_info.cell_partition_data[chunk];
+               cell < task_info.cell_partition_data[chunk + 1];
+               ++cell)
+            {
+              unsigned int slot = chunk;
+              for (unsigned int it =
+                     row_starts[cell * vectorization_length * n_components]
+                       .first;
+                   it != row_starts[(cell + 1) * vectorization_length *
+                                    n_components]
+                           .first;
+                   ++it)
+                slot = std::max(slot,
+                                dof_indices[it] < local_size ?
+                                  post_chunk[dof_indices[it] /
+                                             chunk_size_zero_vector] :
+                                  n_loop_chunks);
+              cells_in_slot[slot].push_back(cell);
+              cell_chunk[cell] = chunk;
+            }
+        cell_loop_post_cell_list_index.resize(n_loop_chunks + 2);
+        cell_loop_post_cell_list.clear();
+        cell_loop_post_cell_list_index[0] = 0;
+        for (unsigned int slot = 0; slot <= n_loop_chunks; ++slot)
+          {
+            for (const unsigned int cell : cells_in_slot[slot])
+              if (cell_loop_post_cell_list.size() >
+                    cell_loop_post_cell_list_index[slot] &&
+                  cell_loop_post_cell_list.back().second == cell &&
+                  cell_chunk[cell - 1] == cell_chunk[cell])
+                ++cell_loop_post_cell_list.back().second;
+              else
+                cell_loop_post_cell_list.emplace_back(cell, cell + 1);
+            cell_loop_post_cell_list_index[slot + 1] =
+              cell_loop_post_cell_list.size();
           }
+      }
+
       // ensure that all indices are touched at least during the last round
       for (auto &index : touched_by)
         if (index == numbers::invalid_unsigned_int)
@@ -1299,6 +1495,90 @@ namespace internal
 
 
 
+    template <int length>
+    void
+    DoFInfo::compute_ghost_targets_by_range(
+      const TaskInfo &                               task_info,
+      const std::vector<FaceToCellTopology<length>> &faces)
+    {
+      AssertDimension(length, vectorization_length);
+      ghost_targets_by_range.clear();
+      ghost_targets_by_range_index.clear();
+
+      // without MPI, there is no partition at the processor boundary
+      if (task_info.partition_row_index.size() < 5)
+        return;
+
+      // the ghost entries are grouped by the owning process, so the process
+      // of an entry follows from the first ghost index of each process
+      const unsigned int        local_size = vector_partitioner->local_size();
+      std::vector<unsigned int> target_starts(1, local_size);
+      for (const auto &target : vector_partitioner->ghost_targets())
+        target_starts.push_back(target_starts.back() + target.second);
+
+      const unsigned int        n_components = start_components.back();
+      std::vector<unsigned int> targets_of_range;
+      const auto add_indices = [&](const unsigned int begin,
+                                   const unsigned int end) {
+        for (unsigned int it = begin; it != end; ++it)
+          if (dof_indices[it] >= local_size)
+            targets_of_range.push_back(
+              std::upper_bound(target_starts.begin(),
+                               target_starts.end(),
+                               dof_indices[it]) -
+              target_starts.begin() - 1);
+      };
+      const auto add_face_cells = [&](const unsigned int *cells) {
+        for (unsigned int v = 0;
+             v < length && cells[v] != numbers::invalid_unsigned_int;
+             ++v)
+          add_indices(row_starts[cells[v] * n_components].first,
+                      row_starts[(cells[v] + 1) * n_components].first);
+      };
+
+      const unsigned int n_ranges = task_info.cell_partition_data.size() - 1;
+      ghost_targets_by_range_index.resize(n_ranges + 1, 0);
+      for (unsigned int range = 0; range < n_ranges; ++range)
+        {
+          targets_of_range.clear();
+          if (range >= task_info.partition_row_index[1] &&
+              range < task_info.partition_row_index[2])
+            {
+              for (unsigned int cell = task_info.cell_partition_data[range];
+                   cell < task_info.cell_partition_data[range + 1];
+                   ++cell)
+                add_indices(
+                  row_starts[cell * length * n_components].first,
+                  row_starts[(cell + 1) * length * n_components].first);
+              if (faces.size() > 0)
+                {
+                  for (unsigned int face =
+                         task_info.face_partition_data[range];
+                       face < task_info.face_partition_data[range + 1];
+                       ++face)
+                    {
+                      add_face_cells(faces[face].cells_interior);
+                      add_face_cells(faces[face].cells_exterior);
+                    }
+                  for (unsigned int face =
+                         task_info.boundary_partition_data[range];
+                       face < task_info.boundary_partition_data[range + 1];
+                       ++face)
+                    add_face_cells(faces[face].cells_interior);
+                }
+            }
+          std::sort(targets_of_range.begin(), targets_of_range.end());
+          ghost_targets_by_range.insert(
+            ghost_targets_by_range.end(),
+            targets_of_range.begin(),
+            std::unique(targets_of_range.begin(), targets_of_range.end()));
+          ghost_targets_by_range_index[range + 1] =
+            ghost_targets_by_range.size();
+        }
+    }
+
+
+
     namespace internal
     {
       // rudimentary version of a vector that keeps entries always ordered
@@ -1604,9 +1884,22 @@ namespace internal
       memory +=
         (row_starts.capacity() * sizeof(std::pair<unsigned int, unsigned int>));
       memory += MemoryConsumption::memory_consumption(dof_indices);
+      memory += MemoryConsumption::memory_consumption(dof_indices_interleaved);
+      for (unsigned int i = 0; i < 3; ++i)
+        {
+          memory +=
+            MemoryConsumption::memory_consumption(dof_indices_contiguous[i]);
+          memory += MemoryConsumption::memory_consumption(
+            dof_indices_interleave_strides[i]);
+        }
       memory += MemoryConsumption::memory_consumption(row_starts_plain_indices);
       memory += MemoryConsumption::memory_consumption(plain_dof_indices);
+      memory +=
+        MemoryConsumption::memory_consumption(hanging_node_constraint_masks);
       memory += MemoryConsumption::memory_consumption(constraint_indicator);
+      memory += MemoryConsumption::memory_consumption(ghost_targets_by_range);
+      memory +=
+        MemoryConsumption::memory_consumption(ghost_targets_by_range_index);
       memory += MemoryConsumption::memory_consumption(*vector_partitioner);
       return memory;
     }
@@ -1625,6 +1918,17 @@ namespace internal
       out << "       Memory dof indices:           ";
       task_info.print_memory_statistics(
         out, MemoryConsumption::memory_consumption(dof_indices));
+      out << "       Memory compressed indices:    ";
+      {
+        std::size_t compressed_memory =
+          MemoryConsumption::memory_consumption(dof_indices_interleaved);
+        for (unsigned int i = 0; i < 3; ++i)
+          compressed_memory +=
+            MemoryConsumption::memory_consumption(dof_indices_contiguous[i]) +
+            MemoryConsumption::memory_consumption(
+              dof_indices_interleave_strides[i]);
+        task_info.print_memory_statistics(out, compressed_memory);
+      }
       out << "       Memory constraint indicators: ";
       task_info.print_memory_statistics(
         out, MemoryConsumption::memory_consumption(constraint_indicator));
@@ -996,9 +996,22 @@ namespace internal
    * evaluation, spectral collocation or simply collocation, meaning the same
    * location for shape functions and evaluation space (quadrature points).
    *
+   * The template argument @p variant selects how the derivatives in the
+   * collocation space are applied: With the default evaluate_evenodd, the
+   * symmetry of the nodes is used to halve the work of the 1D kernels. For
+   * non-symmetric node distributions such as Gauss-Radau points, where
+   * ShapeInfo::shape_values_identity is set but the element is of type
+   * ElementType::tensor_general, evaluate_general applies the full 1D
+   * derivative matrices stored in ShapeInfo::shape_gradients and
+   * ShapeInfo::shape_hessians, still skipping the interpolation of values.
+   *
    * @author Katharina Kormann, 2012
    */
-  template <int dim, int fe_degree, int n_components, typename Number>
+  template <int              dim,
+            int              fe_degree,
+            int              n_components,
+            typename Number,
+            EvaluatorVariant variant = evaluate_evenodd>
   struct FEEvaluationImplCollocation
   {
     static void
@@ -1025,9 +1038,14 @@ namespace internal
 
 
 
-  template <int dim, int fe_degree, int n_components, typename Number>
+  template <int              dim,
+            int              fe_degree,
+            int              n_components,
+            typename Number,
+            EvaluatorVariant variant>
   inline void
-  FEEvaluationImplCollocation<dim, fe_degree, n_components, Number>::evaluate(
+  FEEvaluationImplCollocation<dim, fe_degree, n_components, Number, variant>::
+    evaluate(
     const MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
     const Number *                                values_dofs,
     Number *                                      values_quad,
@@ -1038,17 +1056,26 @@ namespace internal
     const bool evaluate_gradients,
     const bool evaluate_hessians)
   {
-    AssertDimension(shape_info.shape_gradients_collocation_eo.size(),
-                    (fe_degree + 2) / 2 * (fe_degree + 1));
-
-    EvaluatorTensorProduct<evaluate_evenodd,
-                           dim,
-                           fe_degree + 1,
-                           fe_degree + 1,
-                           Number>
-                           eval(AlignedVector<Number>(),
-           shape_info.shape_gradients_collocation_eo,
-           shape_info.shape_hessians_collocation_eo);
+    static_assert(variant == evaluate_evenodd || variant == evaluate_general,
+                  "Only the even-odd and general variants are supported");
+    if (variant == evaluate_evenodd)
+      {
+        AssertDimension(shape_info.shape_gradients_collocation_eo.size(),
+                        (fe_degree + 2) / 2 * (fe_degree + 1));
+      }
+    else
+      {
+        Assert(shape_info.shape_values_identity, ExcInternalError());
+      }
+
+    EvaluatorTensorProduct<variant, dim, fe_degree + 1, fe_degree + 1, Number>
+      eval(AlignedVector<Number>(),
+           variant == evaluate_evenodd ?
+             shape_info.shape_gradients_collocation_eo :
+             shape_info.shape_gradients,
+           variant == evaluate_evenodd ?
+             shape_info.shape_hessians_collocation_eo :
+             shape_info.shape_hessians);
     constexpr unsigned int n_q_points = Utilities::pow(fe_degree + 1, dim);
 
     for (unsigned int c = 0; c < n_components; c++)
@@ -1102,9 +1129,14 @@ namespace internal
 
 
 
-  template <int dim, int fe_degree, int n_components, typename Number>
+  template <int              dim,
+            int              fe_degree,
+            int              n_components,
+            typename Number,
+            EvaluatorVariant variant>
   inline void
-  FEEvaluationImplCollocation<dim, fe_degree, n_components, Number>::integrate(
+  FEEvaluationImplCollocation<dim, fe_degree, n_components, Number, variant>::
+    integrate(
     const MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
     Number *                                      values_dofs,
     Number *                                      values_quad,
@@ -1114,17 +1146,26 @@ namespace internal
     const bool integrate_gradients,
     const bool add_into_values_array)
   {
-    AssertDimension(shape_info.shape_gradients_collocation_eo.size(),
-                    (fe_degree + 2) / 2 * (fe_degree + 1));
-
-    EvaluatorTensorProduct<evaluate_evenodd,
-                           dim,
-                           fe_degree + 1,
-                           fe_degree + 1,
-                           Number>
-                           eval(AlignedVector<Number>(),
-           shape_info.shape_gradients_collocation_eo,
-           shape_info.shape_hessians_collocation_eo);
+    static_assert(variant == evaluate_evenodd || variant == evaluate_general,
+                  "Only the even-odd and general variants are supported");
+    if (variant == evaluate_evenodd)
+      {
+        AssertDimension(shape_info.shape_gradients_collocation_eo.size(),
+                        (fe_degree + 2) / 2 * (fe_degree + 1));
+      }
+    else
+      {
+        Assert(shape_info.shape_values_identity, ExcInternalError());
+      }
+
+    EvaluatorTensorProduct<variant, dim, fe_degree + 1, fe_degree + 1, Number>
+      eval(AlignedVector<Number>(),
+           variant == evaluate_evenodd ?
+             shape_info.shape_gradients_collocation_eo :
+             shape_info.shape_gradients,
+           variant == evaluate_evenodd ?
+             shape_info.shape_hessians_collocation_eo :
+             shape_info.shape_hessians);
     constexpr unsigned int n_q_points = Utilities::pow(fe_degree + 1, dim);
 
     for (unsigned int c = 0; c < n_components; c++)
@@ -598,7 +598,7 @@ template <int dim,
           int n_q_points_1d,
           int n_components,
           typename Number>
-inline void
+void
 SelectEvaluator<dim, fe_degree, n_q_points_1d, n_components, Number>::evaluate(
   const internal::MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
   Number *                                                values_dofs_actual,
@@ -705,6 +705,26 @@ SelectEvaluator<dim, fe_degree, n_q_points_1d, n_components, Number>::evaluate(
                           evaluate_gradients,
                           evaluate_hessians);
     }
+  else if (fe_degree + 1 == n_q_points_1d &&
+           shape_info.element_type ==
+             internal::MatrixFreeFunctions::tensor_general &&
+           shape_info.shape_values_identity)
+    {
+      internal::FEEvaluationImplCollocation<
+        dim,
+        fe_degree,
+        n_components,
+        Number,
+        internal::evaluate_general>::evaluate(shape_info,
+                                              values_dofs_actual,
+                                              values_quad,
+                                              gradients_quad,
+                                              hessians_quad,
+                                              scratch_data,
+                                              evaluate_values,
+                                              evaluate_gradients,
+                                              evaluate_hessians);
+    }
   else if (shape_info.element_type ==
            internal::MatrixFreeFunctions::tensor_general)
     {
@@ -734,7 +754,7 @@ template <int dim,
           int n_q_points_1d,
           int n_components,
           typename Number>
-inline void
+void
 SelectEvaluator<dim, fe_degree, n_q_points_1d, n_components, Number>::integrate(
   const internal::MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
   Number *                                                values_dofs_actual,
@@ -835,6 +855,25 @@ SelectEvaluator<dim, fe_degree, n_q_points_1d, n_components, Number>::integrate(
                            integrate_gradients,
                            sum_into_values_array);
     }
+  else if (fe_degree + 1 == n_q_points_1d &&
+           shape_info.element_type ==
+             internal::MatrixFreeFunctions::tensor_general &&
+           shape_info.shape_values_identity)
+    {
+      internal::FEEvaluationImplCollocation<
+        dim,
+        fe_degree,
+        n_components,
+        Number,
+        internal::evaluate_general>::integrate(shape_info,
+                                               values_dofs_actual,
+                                               values_quad,
+                                               gradients_quad,
+                                               scratch_data,
+                                               integrate_values,
+                                               integrate_gradients,
+                                               sum_into_values_array);
+    }
   else if (shape_info.element_type ==
            internal::MatrixFreeFunctions::tensor_general)
     {
@@ -859,7 +898,7 @@ SelectEvaluator<dim, fe_degree, n_q_points_1d, n_components, Number>::integrate(
 
 
 template <int dim, int dummy, int n_components, typename Number>
-inline void
+void
 SelectEvaluator<dim, -1, dummy, n_components, Number>::evaluate(
   const internal::MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
   Number *                                                values_dofs_actual,
@@ -941,7 +980,7 @@ SelectEvaluator<dim, -1, dummy, n_components, Number>::evaluate(
 
 
 template <int dim, int dummy, int n_components, typename Number>
-inline void
+void
 SelectEvaluator<dim, -1, dummy, n_components, Number>::integrate(
   const internal::MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
   Number *                                                values_dofs_actual,
@@ -1015,6 +1054,59 @@ SelectEvaluator<dim, -1, dummy, n_components, Number>::integrate(
         integrate_gradients,
         sum_into_values_array);
 }
+
+
+
+// The library contains precompiled instantiations of SelectEvaluator for
+// VectorizedArray<double> and VectorizedArray<float> with one to three
+// components, both for the degree only known at run time (fe_degree=-1) and
+// for the polynomial degrees one to four with fe_degree+1 quadrature points
+// in 1D. Declare them here so that user code calls into the library instead
+// of compiling the evaluation kernels again. The macros are also used in
+// evaluation_selector.inst.in to create the instantiations.
+#  define DEAL_II_SELECT_EVALUATOR_INSTANTIATION(prefix, dim, degree, n_q) \
+    prefix struct SelectEvaluator<dim,                                   \
+                                  degree,                                \
+                                  n_q,                                   \
+                                  1,                                     \
+                                  VectorizedArray<double>>;              \
+    prefix struct SelectEvaluator<dim,                                   \
+                                  degree,                                \
+                                  n_q,                                   \
+                                  2,                                     \
+                                  VectorizedArray<double>>;              \
+    prefix struct SelectEvaluator<dim,                                   \
+                                  degree,                                \
+                                  n_q,                                   \
+                                  3,                                     \
+                                  VectorizedArray<double>>;              \
+    prefix struct SelectEvaluator<dim,                                   \
+                                  degree,                                \
+                                  n_q,                                   \
+                                  1,                                     \
+                                  VectorizedArray<float>>;               \
+    prefix struct SelectEvaluator<dim,                                   \
+                                  degree,                                \
+                                  n_q,                                   \
+                                  2,                                     \
+                                  VectorizedArray<float>>;               \
+    prefix struct SelectEvaluator<dim,                                   \
+                                  degree,                                \
+                                  n_q,                                   \
+                                  3,                                     \
+                                  VectorizedArray<float>>;
+
+#  define DEAL_II_SELECT_EVALUATOR_INSTANTIATIONS(prefix, dim) \
+    DEAL_II_SELECT_EVALUATOR_INSTANTIATION(prefix, dim, -1, 0)  \
+    DEAL_II_SELECT_EVALUATOR_INSTANTIATION(prefix, dim, 1, 2)   \
+    DEAL_II_SELECT_EVALUATOR_INSTANTIATION(prefix, dim, 2, 3)   \
+    DEAL_II_SELECT_EVALUATOR_INSTANTIATION(prefix, dim, 3, 4)   \
+    DEAL_II_SELECT_EVALUATOR_INSTANTIATION(prefix, dim, 4, 5)
+
+DEAL_II_SELECT_EVALUATOR_INSTANTIATIONS(extern template, 1)
+DEAL_II_SELECT_EVALUATOR_INSTANTIATIONS(extern template, 2)
+DEAL_II_SELECT_EVALUATOR_INSTANTIATIONS(extern template, 3)
+
 #endif // DOXYGEN
 
 DEAL_II_NAMESPACE_CLOSE
@@ -31,6 +31,7 @@
 
 #include <deal.II/matrix_free/evaluation_kernels.h>
 #include <deal.II/matrix_free/evaluation_selector.h>
+#include <deal.II/matrix_free/hanging_nodes_internal.h>
 #include <deal.II/matrix_free/mapping_data_on_the_fly.h>
 #include <deal.II/matrix_free/matrix_free.h>
 #include <deal.II/matrix_free/shape_info.h>
@@ -186,6 +187,10 @@ public:
    * std::vector<VectorType> or std::vector<VectorType *>, this function reads
    * @p n_components blocks from the block vector starting at the index
    * @p first_index. For non-block vectors, @p first_index is ignored.
+   *
+   * If MatrixFree::AdditionalData::use_fast_hanging_node_algorithm is set,
+   * the values at hanging nodes are interpolated from the values on the
+   * coarser neighbor inside this function.
    */
   template <typename VectorType>
   void
@@ -253,6 +258,11 @@ public:
    * std::vector<VectorType> or std::vector<VectorType *>, this function
    * writes to @p n_components blocks of the block vector starting at the
    * index @p first_index. For non-block vectors, @p first_index is ignored.
+   *
+   * If MatrixFree::AdditionalData::use_fast_hanging_node_algorithm is set,
+   * the contributions of hanging nodes are transferred to the degrees of
+   * freedom on the coarser neighbor inside this function. The values stored
+   * internally are left unchanged.
    */
   template <typename VectorType>
   void
@@ -293,6 +303,12 @@ public:
    * std::vector<VectorType> or std::vector<VectorType *>, this function
    * writes to @p n_components blocks of the block vector starting at the
    * index @p first_index. For non-block vectors, @p first_index is ignored.
+   *
+   * @note For cell batches that contain cells with hanging node constraints
+   * resolved on the fly (see
+   * MatrixFree::AdditionalData::use_fast_hanging_node_algorithm), the values
+   * are written to the plain indices of the cells, i.e., including the
+   * constrained degrees of freedom.
    */
   template <typename VectorType>
   void
@@ -747,7 +763,8 @@ protected:
     const unsigned int quad_no,
     const unsigned int fe_degree,
     const unsigned int n_q_points,
-    const bool         is_interior_face);
+    const bool         is_interior_face,
+    const unsigned int active_fe_index = numbers::invalid_unsigned_int);
 
   /**
    * Constructor that comes with reduced functionality and works similar as
@@ -852,6 +869,23 @@ protected:
   read_write_operation_global(const VectorOperation &operation,
                               VectorType *           vectors[]) const;
 
+  /**
+   * Return whether some of the cells in the current cell batch carry hanging
+   * node constraints that are resolved on the fly, see
+   * MatrixFree::AdditionalData::use_fast_hanging_node_algorithm.
+   */
+  bool
+  has_hanging_node_constraints() const;
+
+  /**
+   * Apply the hanging node constraints resolved on the fly (@p transpose =
+   * false) or their transpose (@p transpose = true) on the values of the
+   * degrees of freedom of the cells in the current batch. Uses the memory
+   * in @p scratch_data.
+   */
+  void
+  apply_hanging_node_constraints(const bool transpose) const;
+
   /**
    * This is the general array for all data fields.
    */
@@ -1047,6 +1081,13 @@ protected:
    */
   unsigned int subface_index;
 
+  /**
+   * Stores the numbers of the cells behind the current face, with one entry
+   * per vectorization lane, for an FEFaceEvaluation object of the exterior
+   * side that was initialized by the cell-based reinit() function.
+   */
+  unsigned int neighbor_cells[VectorizedArrayType::n_array_elements];
+
   /**
    * Stores the type of the cell we are currently working with after a call to
    * reinit(). Valid values are @p cartesian, @p affine and @p general, which
@@ -1105,6 +1146,16 @@ protected:
                     MappingDataOnTheFly<dim, Number, VectorizedArrayType>>
     mapped_geometry;
 
+  /**
+   * Storage for the inverse and transposed Jacobians and the JxW values on
+   * the current cell batch in case the geometry is evaluated on the fly
+   * from the mapping support points in MappingInfo, see
+   * MatrixFree::AdditionalData::geometry_on_the_fly. The pointers @p
+   * jacobian and @p J_value then point into these fields.
+   */
+  AlignedVector<Tensor<2, dim, VectorizedArrayType>> jacobians_on_the_fly;
+  AlignedVector<VectorizedArrayType>                 JxW_values_on_the_fly;
+
   /**
    * For a FiniteElement with more than one base element, select at which
    * component this data structure should start.
@@ -1183,7 +1234,8 @@ protected:
     const unsigned int quad_no,
     const unsigned int fe_degree,
     const unsigned int n_q_points,
-    const bool         is_interior_face = true);
+    const bool         is_interior_face = true,
+    const unsigned int active_fe_index  = numbers::invalid_unsigned_int);
 
   /**
    * Constructor with reduced functionality for similar usage of FEEvaluation
@@ -1323,7 +1375,8 @@ protected:
     const unsigned int quad_no,
     const unsigned int fe_degree,
     const unsigned int n_q_points,
-    const bool         is_interior_face = true);
+    const bool         is_interior_face = true,
+    const unsigned int active_fe_index  = numbers::invalid_unsigned_int);
 
   /**
    * Constructor with reduced functionality for similar usage of FEEvaluation
@@ -1487,7 +1540,8 @@ protected:
     const unsigned int quad_no,
     const unsigned int dofs_per_cell,
     const unsigned int n_q_points,
-    const bool         is_interior_face = true);
+    const bool         is_interior_face = true,
+    const unsigned int active_fe_index  = numbers::invalid_unsigned_int);
 
   /**
    * Constructor with reduced functionality for similar usage of FEEvaluation
@@ -1637,7 +1691,8 @@ protected:
     const unsigned int                                quad_no,
     const unsigned int                                fe_degree,
     const unsigned int                                n_q_points,
-    const bool                                        is_interior_face = true);
+    const bool                                        is_interior_face = true,
+    const unsigned int active_fe_index = numbers::invalid_unsigned_int);
 
   /**
    * Constructor with reduced functionality for similar usage of FEEvaluation
@@ -2340,6 +2395,22 @@ public:
                const unsigned int                                  quad_no = 0,
                const unsigned int first_selected_component                 = 0);
 
+  /**
+   * Constructor for the hp case. Same as the constructor above, but the
+   * finite element and quadrature formula of the hp collections are selected
+   * by the active FE index of the cell batches in @p range, rather than by
+   * the template parameters. Together with the runtime degree
+   * <code>fe_degree=-1</code>, this allows a single cell operation to work on
+   * all elements of the collection. All cell batches in @p range must share
+   * the same active FE index, see MatrixFree::cell_loop_hp() and
+   * MatrixFree::create_cell_subrange_hp_by_index().
+   */
+  FEEvaluation(const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+               const std::pair<unsigned int, unsigned int> &       range,
+               const unsigned int                                  dof_no  = 0,
+               const unsigned int                                  quad_no = 0,
+               const unsigned int first_selected_component                 = 0);
+
   /**
    * Constructor that comes with reduced functionality and works similar as
    * FEValues. The arguments are similar to the ones passed to the constructor
@@ -2599,6 +2670,16 @@ private:
   void
   check_template_arguments(const unsigned int fe_no,
                            const unsigned int first_selected_component);
+
+  /**
+   * Computes the inverse and transposed Jacobians as well as the JxW values
+   * in all quadrature points of the current cell batch from the support
+   * points of the mapping, given in the format of
+   * MappingInfoStorage::mapping_support_points, by sum factorization, and
+   * sets the internal pointers to the result.
+   */
+  void
+  compute_geometry_on_the_fly(const VectorizedArrayType *support_points);
 };
 
 
@@ -2794,6 +2875,17 @@ public:
    * method is less efficient than the other reinit() method taking a
    * numbering of the faces because it needs to copy the data associated with
    * the faces to the cells in this call.
+   *
+   * For an object of the exterior side (second argument to the constructor
+   * set to false), this method points to the neighbors of the cells behind
+   * the given face, as used by MatrixFree::loop_cell_centric(). The normal
+   * vector and the integration weights are the ones of the cell, whereas
+   * the degrees of freedom and Jacobians are those of the neighbor. This
+   * access is only implemented for neighbors on the same refinement level
+   * with faces in standard orientation, and requires all neighbors within
+   * the cell batch to see the face with the same face number. For lanes
+   * without a neighbor at the boundary, the cell itself is accessed and the
+   * data is not meaningful.
    */
   void
   reinit(const unsigned int cell_batch_number, const unsigned int face_number);
@@ -2981,23 +3073,38 @@ inline FEEvaluationBase<dim,
                    const unsigned int quad_no_in,
                    const unsigned int fe_degree,
                    const unsigned int n_q_points,
-                   const bool         is_interior_face)
+                   const bool         is_interior_face,
+                   const unsigned int active_fe_index_in)
   : scratch_data_array(data_in.acquire_scratch_data())
   , quad_no(quad_no_in)
   , n_fe_components(data_in.get_dof_info(dof_no).start_components.back())
-  , active_fe_index(fe_degree != numbers::invalid_unsigned_int ?
-                      data_in.get_dof_info(dof_no).fe_index_from_degree(
-                        first_selected_component,
-                        fe_degree) :
-                      0)
-  , active_quad_index(fe_degree != numbers::invalid_unsigned_int ?
-                        (is_face ? data_in.get_mapping_info()
-                                     .face_data[quad_no_in]
-                                     .quad_index_from_n_q_points(n_q_points) :
-                                   data_in.get_mapping_info()
-                                     .cell_data[quad_no_in]
-                                     .quad_index_from_n_q_points(n_q_points)) :
-                        0)
+  , active_fe_index(active_fe_index_in != numbers::invalid_unsigned_int ?
+                      active_fe_index_in :
+                      (fe_degree != numbers::invalid_unsigned_int ?
+                         data_in.get_dof_info(dof_no).fe_index_from_degree(
+                           first_selected_component,
+                           fe_degree) :
+                         0))
+  , active_quad_index(
+      fe_degree != numbers::invalid_unsigned_int ?
+        (is_face ? data_in.get_mapping_info()
+                     .face_data[quad_no_in]
+                     .quad_index_from_n_q_points(n_q_points) :
+                   data_in.get_mapping_info()
+                     .cell_data[quad_no_in]
+                     .quad_index_from_n_q_points(n_q_points)) :
+        // with a runtime degree, the quadrature formula of an hp collection
+        // is the one with the same index as the finite element, or the only
+        // one present
+        std::min<unsigned int>(
+          active_fe_index,
+          (is_face ? data_in.get_mapping_info()
+                       .face_data[quad_no_in]
+                       .descriptor.size() :
+                     data_in.get_mapping_info()
+                       .cell_data[quad_no_in]
+                       .descriptor.size()) -
+            1))
   , n_quadrature_points(fe_degree != numbers::invalid_unsigned_int ?
                           n_q_points :
                           (is_face ? data_in
@@ -3881,6 +3988,39 @@ namespace internal
 
 
 
+    // variant for a possibly partially filled batch where
+    // VectorType::value_type is the same as Number -> can call gather with
+    // inactive lanes masked out
+    template <typename VectorType>
+    void
+    process_dof_gather_masked(const unsigned int   n_lanes,
+                              const unsigned int * indices,
+                              VectorType &         vec,
+                              VectorizedArrayType &res,
+                              std::integral_constant<bool, true>) const
+    {
+      masked_gather(n_lanes, vec.begin(), indices, res);
+    }
+
+
+
+    template <typename VectorType>
+    void
+    process_dof_gather_masked(const unsigned int   n_lanes,
+                              const unsigned int * indices,
+                              const VectorType &   vec,
+                              VectorizedArrayType &res,
+                              std::integral_constant<bool, false>) const
+    {
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        res[v] = vector_access(vec, indices[v]);
+      for (unsigned int v = n_lanes; v < VectorizedArrayType::n_array_elements;
+           ++v)
+        res[v] = Number();
+    }
+
+
+
     template <typename VectorType>
     void
     process_dof_global(const types::global_dof_index index,
@@ -4051,6 +4191,35 @@ namespace internal
 
 
 
+    // variant for a possibly partially filled batch -> the indices of
+    // different lanes may coincide, which masked_scatter_add() resolves
+    template <typename VectorType>
+    void
+    process_dof_gather_masked(const unsigned int   n_lanes,
+                              const unsigned int * indices,
+                              VectorType &         vec,
+                              VectorizedArrayType &res,
+                              std::integral_constant<bool, true>) const
+    {
+      masked_scatter_add(n_lanes, res, indices, vec.begin());
+    }
+
+
+
+    template <typename VectorType>
+    void
+    process_dof_gather_masked(const unsigned int   n_lanes,
+                              const unsigned int * indices,
+                              VectorType &         vec,
+                              VectorizedArrayType &res,
+                              std::integral_constant<bool, false>) const
+    {
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        vector_access_add(vec, indices[v], res[v]);
+    }
+
+
+
     template <typename VectorType>
     void
     process_dof_global(const types::global_dof_index index,
@@ -4198,6 +4367,33 @@ namespace internal
 
 
 
+    template <typename VectorType>
+    void
+    process_dof_gather_masked(const unsigned int   n_lanes,
+                              const unsigned int * indices,
+                              VectorType &         vec,
+                              VectorizedArrayType &res,
+                              std::integral_constant<bool, true>) const
+    {
+      masked_scatter(n_lanes, res, indices, vec.begin());
+    }
+
+
+
+    template <typename VectorType>
+    void
+    process_dof_gather_masked(const unsigned int   n_lanes,
+                              const unsigned int * indices,
+                              VectorType &         vec,
+                              VectorizedArrayType &res,
+                              std::integral_constant<bool, false>) const
+    {
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        vector_access(vec, indices[v]) = res[v];
+    }
+
+
+
     template <typename VectorType>
     void
     process_dof_global(const types::global_dof_index index,
@@ -4347,11 +4543,18 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
       internal::check_vector_compatibility(*src[0], *dof_info);
     }
 
+  // The neighbors of a cell accessed through the cell-based face
+  // initialization are gathered lane by lane from the general index storage
+  const bool access_neighbor_cells =
+    is_face && is_interior_face == false &&
+    dof_access_index == internal::MatrixFreeFunctions::DoFInfo::dof_access_cell;
+
   // Case 2: contiguous indices which use reduced storage of indices and can
   // use vectorized load/store operations -> go to separate function
   AssertIndexRange(cell,
                    dof_info->index_storage_variants[dof_access_index].size());
-  if (dof_info->index_storage_variants
+  if (access_neighbor_cells == false &&
+      dof_info->index_storage_variants
         [is_face ? dof_access_index :
                    internal::MatrixFreeFunctions::DoFInfo::dof_access_cell]
         [cell] >=
@@ -4375,7 +4578,8 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
 
   const unsigned int dofs_per_component =
     this->data->dofs_per_component_on_cell;
-  if (dof_info->index_storage_variants
+  if (access_neighbor_cells == false &&
+      dof_info->index_storage_variants
         [is_face ? dof_access_index :
                    internal::MatrixFreeFunctions::DoFInfo::dof_access_cell]
         [cell] ==
@@ -4420,8 +4624,10 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
           internal::MatrixFreeFunctions::DoFInfo::dof_access_cell)
         for (unsigned int v = 0; v < n_vectorization_actual; ++v)
           cells_copied[v] = cell * VectorizedArrayType::n_array_elements + v;
-      cells = dof_access_index ==
-                  internal::MatrixFreeFunctions::DoFInfo::dof_access_cell ?
+      cells = access_neighbor_cells ?
+                &neighbor_cells[0] :
+                dof_access_index ==
+                    internal::MatrixFreeFunctions::DoFInfo::dof_access_cell ?
                 &cells_copied[0] :
                 (is_interior_face ?
                    &this->matrix_info->get_face_info(cell).cells_interior[0] :
@@ -4445,8 +4651,10 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
                                           first_selected_component]
                              .first;
         }
-      for (unsigned int v = n_vectorization_actual; v < n_vectorization; ++v)
-        dof_indices[v] = nullptr;
+      std::fill(dof_indices + std::min<unsigned int>(n_vectorization_actual,
+                                                     n_vectorization),
+                dof_indices + n_vectorization,
+                nullptr);
     }
   else
     {
@@ -4465,6 +4673,11 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
                              first_selected_component]
                 .second)
             has_constraints = true;
+          if (apply_constraints == false &&
+              !dof_info->hanging_node_constraint_masks.empty() &&
+              dof_info->hanging_node_constraint_masks[cell * n_vectorization +
+                                                      v] != 0)
+            has_constraints = true;
           Assert(
             dof_info
                   ->row_starts[(cell * n_vectorization + v) * n_fe_components +
@@ -4492,36 +4705,48 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
                            first_selected_component]
               .first;
         }
-      for (unsigned int v = n_vectorization_actual; v < n_vectorization; ++v)
-        dof_indices[v] = nullptr;
+      std::fill(dof_indices + std::min<unsigned int>(n_vectorization_actual,
+                                                     n_vectorization),
+                dof_indices + n_vectorization,
+                nullptr);
     }
 
   // Case where we have no constraints throughout the whole cell: Can go
-  // through the list of DoFs directly
+  // through the list of DoFs directly. We collect the indices of all lanes
+  // for one local DoF and let the operation gather or scatter them at once,
+  // masking out the unfilled lanes of a partially filled batch. Different
+  // lanes may refer to the same DoF, which the masked scatter-add handles.
   if (!has_constraints)
     {
-      if (n_vectorization_actual < n_vectorization)
-        for (unsigned int comp = 0; comp < n_components; ++comp)
-          for (unsigned int i = 0; i < dofs_per_component; ++i)
-            operation.process_empty(values_dofs[comp][i]);
+      unsigned int lane_indices[n_vectorization];
       if (n_components == 1 || n_fe_components == 1)
         {
-          for (unsigned int v = 0; v < n_vectorization_actual; ++v)
-            for (unsigned int i = 0; i < dofs_per_component; ++i)
+          for (unsigned int i = 0; i < dofs_per_component; ++i)
+            {
+              for (unsigned int v = 0; v < n_vectorization_actual; ++v)
+                lane_indices[v] = dof_indices[v][i];
               for (unsigned int comp = 0; comp < n_components; ++comp)
-                operation.process_dof(dof_indices[v][i],
-                                      *src[comp],
-                                      values_dofs[comp][i][v]);
+                operation.process_dof_gather_masked(n_vectorization_actual,
+                                                    lane_indices,
+                                                    *src[comp],
+                                                    values_dofs[comp][i],
+                                                    vector_selector);
+            }
         }
       else
         {
           for (unsigned int comp = 0; comp < n_components; ++comp)
-            for (unsigned int v = 0; v < n_vectorization_actual; ++v)
-              for (unsigned int i = 0; i < dofs_per_component; ++i)
-                operation.process_dof(
-                  dof_indices[v][comp * dofs_per_component + i],
-                  *src[0],
-                  values_dofs[comp][i][v]);
+            for (unsigned int i = 0; i < dofs_per_component; ++i)
+              {
+                for (unsigned int v = 0; v < n_vectorization_actual; ++v)
+                  lane_indices[v] =
+                    dof_indices[v][comp * dofs_per_component + i];
+                operation.process_dof_gather_masked(n_vectorization_actual,
+                                                    lane_indices,
+                                                    *src[0],
+                                                    values_dofs[comp][i],
+                                                    vector_selector);
+              }
         }
       return;
     }
@@ -4566,14 +4791,17 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
         }
 
       if (apply_constraints == false &&
-          dof_info
-              ->row_starts[(cell * n_vectorization + v) * n_fe_components +
-                           first_selected_component]
-              .second !=
-            dof_info
-              ->row_starts[(cell * n_vectorization + v) * n_fe_components +
-                           first_selected_component + n_components_read]
-              .second)
+          (dof_info
+               ->row_starts[(cell * n_vectorization + v) * n_fe_components +
+                            first_selected_component]
+               .second !=
+             dof_info
+               ->row_starts[(cell * n_vectorization + v) * n_fe_components +
+                            first_selected_component + n_components_read]
+               .second ||
+           (!is_face && !dof_info->hanging_node_constraint_masks.empty() &&
+            dof_info->hanging_node_constraint_masks[cell * n_vectorization +
+                                                    v] != 0)))
         {
           Assert(
             dof_info->row_starts_plain_indices[cell * n_vectorization + v] !=
@@ -5039,6 +5267,9 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
     std::bitset<VectorizedArrayType::n_array_elements>().flip(),
     true);
 
+  if (has_hanging_node_constraints())
+    apply_hanging_node_constraints(false);
+
 #  ifdef DEBUG
   dof_values_initialized = true;
 #  endif
@@ -5110,7 +5341,25 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
 
   internal::VectorDistributorLocalToGlobal<Number, VectorizedArrayType>
     distributor;
-  read_write_operation(distributor, dst_data, mask);
+  if (has_hanging_node_constraints())
+    {
+      // apply the transpose of the constraints on the values, keeping a copy
+      // of the original values in the scratch data
+      const unsigned int dofs_per_component =
+        this->data->dofs_per_component_on_cell;
+      VectorizedArrayType *values_copy =
+        scratch_data + this->data->fe_degree + 1;
+      std::copy(values_dofs[0],
+                values_dofs[0] + n_components * dofs_per_component,
+                values_copy);
+      apply_hanging_node_constraints(true);
+      read_write_operation(distributor, dst_data, mask);
+      std::copy(values_copy,
+                values_copy + n_components * dofs_per_component,
+                values_dofs[0]);
+    }
+  else
+    read_write_operation(distributor, dst_data, mask);
 }
 
 
@@ -5143,7 +5392,57 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
                                                               d + first_index);
 
   internal::VectorSetter<Number, VectorizedArrayType> setter;
-  read_write_operation(setter, dst_data, mask);
+  read_write_operation(setter,
+                       dst_data,
+                       mask,
+                       has_hanging_node_constraints() == false);
+}
+
+
+
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+inline bool
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  has_hanging_node_constraints() const
+{
+  if (is_face || dof_info == nullptr ||
+      dof_info->hanging_node_constraint_masks.empty())
+    return false;
+
+  AssertIndexRange((cell + 1) * VectorizedArrayType::n_array_elements,
+                   dof_info->hanging_node_constraint_masks.size() + 1);
+  const unsigned int *masks = dof_info->hanging_node_constraint_masks.data() +
+                              cell * VectorizedArrayType::n_array_elements;
+  for (unsigned int v = 0; v < VectorizedArrayType::n_array_elements; ++v)
+    if (masks[v] != 0)
+      return true;
+  return false;
+}
+
+
+
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+inline void
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  apply_hanging_node_constraints(const bool transpose) const
+{
+  internal::MatrixFreeFunctions::
+    FEEvaluationImplHangingNodes<dim, VectorizedArrayType>::run(
+      n_components,
+      *this->data,
+      transpose,
+      dof_info->hanging_node_constraint_masks.data() +
+        cell * VectorizedArrayType::n_array_elements,
+      values_dofs[0],
+      scratch_data);
 }
 
 
@@ -5579,6 +5878,9 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   // cell with general Jacobian
   else
     {
+      Assert(this->mapping_data->mapping_support_points.empty(),
+             ExcMessage("Hessians are not available on curved cells when "
+                        "the geometry is evaluated on the fly."));
       const Tensor<1, dim *(dim + 1) / 2, Tensor<1, dim, VectorizedArrayType>>
         &jac_grad =
           mapping_data->jacobian_gradients
@@ -5684,6 +5986,9 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
   // cell with general Jacobian
   else
     {
+      Assert(this->mapping_data->mapping_support_points.empty(),
+             ExcMessage("Hessians are not available on curved cells when "
+                        "the geometry is evaluated on the fly."));
       const Tensor<1, dim *(dim + 1) / 2, Tensor<1, dim, VectorizedArrayType>>
         &jac_grad =
           mapping_data->jacobian_gradients
@@ -5940,7 +6245,8 @@ inline FEEvaluationAccess<dim,
     const unsigned int quad_no_in,
     const unsigned int fe_degree,
     const unsigned int n_q_points,
-    const bool         is_interior_face)
+    const bool         is_interior_face,
+    const unsigned int active_fe_index)
   : FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>(
       data_in,
       dof_no,
@@ -5948,7 +6254,8 @@ inline FEEvaluationAccess<dim,
       quad_no_in,
       fe_degree,
       n_q_points,
-      is_interior_face)
+      is_interior_face,
+      active_fe_index)
 {}
 
 
@@ -6045,7 +6352,8 @@ inline FEEvaluationAccess<dim, 1, Number, is_face, VectorizedArrayType>::
     const unsigned int quad_no_in,
     const unsigned int fe_degree,
     const unsigned int n_q_points,
-    const bool         is_interior_face)
+    const bool         is_interior_face,
+    const unsigned int active_fe_index)
   : FEEvaluationBase<dim, 1, Number, is_face, VectorizedArrayType>(
       data_in,
       dof_no,
@@ -6053,7 +6361,8 @@ inline FEEvaluationAccess<dim, 1, Number, is_face, VectorizedArrayType>::
       quad_no_in,
       fe_degree,
       n_q_points,
-      is_interior_face)
+      is_interior_face,
+      active_fe_index)
 {}
 
 
@@ -6340,7 +6649,8 @@ inline FEEvaluationAccess<dim, dim, Number, is_face, VectorizedArrayType>::
     const unsigned int quad_no_in,
     const unsigned int fe_degree,
     const unsigned int n_q_points,
-    const bool         is_interior_face)
+    const bool         is_interior_face,
+    const unsigned int active_fe_index)
   : FEEvaluationBase<dim, dim, Number, is_face, VectorizedArrayType>(
       data_in,
       dof_no,
@@ -6348,7 +6658,8 @@ inline FEEvaluationAccess<dim, dim, Number, is_face, VectorizedArrayType>::
       quad_no_in,
       fe_degree,
       n_q_points,
-      is_interior_face)
+      is_interior_face,
+      active_fe_index)
 {}
 
 
@@ -6727,7 +7038,8 @@ inline FEEvaluationAccess<1, 1, Number, is_face, VectorizedArrayType>::
                      const unsigned int quad_no_in,
                      const unsigned int fe_degree,
                      const unsigned int n_q_points,
-                     const bool         is_interior_face)
+                     const bool         is_interior_face,
+                     const unsigned int active_fe_index)
   : FEEvaluationBase<1, 1, Number, is_face, VectorizedArrayType>(
       data_in,
       dof_no,
@@ -6735,7 +7047,8 @@ inline FEEvaluationAccess<1, 1, Number, is_face, VectorizedArrayType>::
       quad_no_in,
       fe_degree,
       n_q_points,
-      is_interior_face)
+      is_interior_face,
+      active_fe_index)
 {}
 
 
@@ -7030,6 +7343,41 @@ inline FEEvaluation<dim,
 
 
 
+
+template <int dim,
+          int fe_degree,
+          int n_q_points_1d,
+          int n_components_,
+          typename Number,
+          typename VectorizedArrayType>
+inline FEEvaluation<dim,
+                    fe_degree,
+                    n_q_points_1d,
+                    n_components_,
+                    Number,
+                    VectorizedArrayType>::
+  FEEvaluation(const MatrixFree<dim, Number, VectorizedArrayType> &data_in,
+               const std::pair<unsigned int, unsigned int> &       range,
+               const unsigned int                                  fe_no,
+               const unsigned int                                  quad_no,
+               const unsigned int first_selected_component)
+  : BaseClass(data_in,
+              fe_no,
+              first_selected_component,
+              quad_no,
+              fe_degree,
+              static_n_q_points,
+              true,
+              data_in.get_cell_active_fe_index(range, fe_no))
+  , dofs_per_component(this->data->dofs_per_component_on_cell)
+  , dofs_per_cell(this->data->dofs_per_component_on_cell * n_components_)
+  , n_q_points(this->data->n_q_points)
+{
+  check_template_arguments(fe_no, 0);
+}
+
+
+
 template <int dim,
           int fe_degree,
           int n_q_points_1d,
@@ -7371,8 +7719,15 @@ FEEvaluation<dim,
 
   const unsigned int offsets =
     this->mapping_data->data_index_offsets[cell_index];
-  this->jacobian = &this->mapping_data->jacobians[0][offsets];
-  this->J_value  = &this->mapping_data->JxW_values[offsets];
+  if (this->cell_type == internal::MatrixFreeFunctions::general &&
+      !this->mapping_data->mapping_support_points.empty())
+    compute_geometry_on_the_fly(
+      &this->mapping_data->mapping_support_points[offsets]);
+  else
+    {
+      this->jacobian = &this->mapping_data->jacobians[0][offsets];
+      this->J_value  = &this->mapping_data->JxW_values[offsets];
+    }
 
 #  ifdef DEBUG
   this->dof_values_initialized     = false;
@@ -7384,6 +7739,71 @@ FEEvaluation<dim,
 
 
 
+template <int dim,
+          int fe_degree,
+          int n_q_points_1d,
+          int n_components_,
+          typename Number,
+          typename VectorizedArrayType>
+inline void
+FEEvaluation<dim,
+             fe_degree,
+             n_q_points_1d,
+             n_components_,
+             Number,
+             VectorizedArrayType>::
+  compute_geometry_on_the_fly(const VectorizedArrayType *support_points)
+{
+  const internal::MatrixFreeFunctions::ShapeInfo<VectorizedArrayType>
+    &geometry_shape = this->mapping_data->geometry_shape_info;
+  AssertDimension(geometry_shape.n_q_points, this->n_quadrature_points);
+
+  // The vector for the JxW values is also used to hold the unit cell
+  // gradients of the geometry, i.e., the Jacobians of the transformation,
+  // and the temporary data of the sum factorization kernels
+  const unsigned int n_q_points = this->n_quadrature_points;
+  const unsigned int temp_size =
+    2 * std::max(geometry_shape.dofs_per_component_on_cell, n_q_points);
+  this->jacobians_on_the_fly.resize_fast(n_q_points);
+  this->JxW_values_on_the_fly.resize_fast(
+    (dim * dim + dim + 1) * n_q_points + temp_size);
+  VectorizedArrayType *unit_values =
+    this->JxW_values_on_the_fly.begin() + n_q_points;
+  VectorizedArrayType *unit_gradients = unit_values + dim * n_q_points;
+
+  internal::FEEvaluationImpl<
+    internal::MatrixFreeFunctions::tensor_general,
+    dim,
+    -1,
+    0,
+    dim,
+    VectorizedArrayType>::evaluate(geometry_shape,
+                                   support_points,
+                                   unit_values,
+                                   unit_gradients,
+                                   unit_gradients,
+                                   unit_gradients + dim * dim * n_q_points,
+                                   false,
+                                   true,
+                                   false);
+
+  const Number *quadrature_weights = this->quadrature_weights;
+  for (unsigned int q = 0; q < n_q_points; ++q)
+    {
+      Tensor<2, dim, VectorizedArrayType> jac;
+      for (unsigned int d = 0; d < dim; ++d)
+        for (unsigned int e = 0; e < dim; ++e)
+          jac[d][e] = unit_gradients[(d * dim + e) * n_q_points + q];
+      this->JxW_values_on_the_fly[q] = determinant(jac) * quadrature_weights[q];
+      this->jacobians_on_the_fly[q]  = transpose(invert(jac));
+    }
+
+  this->jacobian = this->jacobians_on_the_fly.begin();
+  this->J_value  = this->JxW_values_on_the_fly.begin();
+}
+
+
+
 template <int dim,
           int fe_degree,
           int n_q_points_1d,
@@ -7927,22 +8347,88 @@ FEFaceEvaluation<dim,
   Assert(this->mapped_geometry == nullptr,
          ExcMessage("FEEvaluation was initialized without a matrix-free object."
                     " Integer indexing is not possible"));
-  Assert(this->is_interior_face == true,
-         ExcMessage(
-           "Cell-based FEFaceEvaluation::reinit only possible for the "
-           "interior face with second argument to constructor as true"));
   if (this->mapped_geometry != nullptr)
     return;
   Assert(this->matrix_info != nullptr, ExcNotInitialized());
 
-  this->cell_type = this->matrix_info->get_mapping_info().cell_type[cell_index];
-  this->cell      = cell_index;
+  this->cell_type = this->matrix_info->get_mapping_info().faces_by_cells_type(
+    cell_index, face_number);
+  this->cell             = cell_index;
   this->face_orientation = 0;
   this->subface_index    = GeometryInfo<dim>::max_children_per_cell;
   this->face_no          = face_number;
   this->dof_access_index =
     internal::MatrixFreeFunctions::DoFInfo::dof_access_cell;
 
+  // For the exterior side, collect the cells behind the face from the face
+  // topology, which describes the face from the side of the locally
+  // processed cell or from the side of the neighbor. Lanes without a
+  // neighbor, i.e., at the boundary, point to the cell itself.
+  if (this->is_interior_face == false)
+    {
+      constexpr unsigned int n_lanes = VectorizedArrayType::n_array_elements;
+      const Table<3, unsigned int> &cell_and_face_to_plain_faces =
+        this->matrix_info->get_cell_and_face_to_plain_faces();
+      Assert(cell_and_face_to_plain_faces.size(0) > cell_index,
+             ExcMessage("The cell-based access to the neighbor requires the "
+                        "face data structures in MatrixFree, set "
+                        "AdditionalData::mapping_update_flags_inner_faces."));
+      this->face_no = numbers::invalid_unsigned_int;
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          const unsigned int cell_this = cell_index * n_lanes + v;
+          this->neighbor_cells[v]      = cell_this;
+          const unsigned int face_index =
+            cell_and_face_to_plain_faces(cell_index, face_number, v);
+          if (face_index == numbers::invalid_unsigned_int)
+            {
+              Assert(v >= this->matrix_info->n_active_entries_per_cell_batch(
+                            cell_index) ||
+                       this->matrix_info->get_faces_by_cells_boundary_id(
+                         cell_index, face_number)[v] !=
+                         numbers::invalid_boundary_id,
+                     ExcMessage("The face to the neighbor is not present in "
+                                "MatrixFree, set AdditionalData::"
+                                "hold_all_faces_to_owned_cells."));
+              continue;
+            }
+          const internal::MatrixFreeFunctions::FaceToCellTopology<n_lanes>
+            &faces = this->matrix_info->get_face_info(face_index / n_lanes);
+          const unsigned int lane = face_index % n_lanes;
+          if (faces.cells_exterior[lane] == numbers::invalid_unsigned_int)
+            continue;
+
+          unsigned int neighbor_face_no;
+          if (faces.cells_interior[lane] == cell_this)
+            {
+              this->neighbor_cells[v] = faces.cells_exterior[lane];
+              neighbor_face_no        = faces.exterior_face_no;
+            }
+          else
+            {
+              AssertDimension(faces.cells_exterior[lane], cell_this);
+              this->neighbor_cells[v] = faces.cells_interior[lane];
+              neighbor_face_no        = faces.interior_face_no;
+            }
+          Assert(faces.subface_index >=
+                   GeometryInfo<dim>::max_children_per_cell,
+                 ExcNotImplemented("The cell-based access to the neighbor is "
+                                   "not implemented for hanging nodes"));
+          Assert(faces.face_orientation % 8 == 0,
+                 ExcNotImplemented("The cell-based access to the neighbor is "
+                                   "only implemented for faces in standard "
+                                   "orientation"));
+          Assert(this->face_no == numbers::invalid_unsigned_int ||
+                   this->face_no == neighbor_face_no,
+                 ExcNotImplemented("The cell-based access to the neighbor "
+                                   "requires the same face number of all "
+                                   "neighbors within a cell batch"));
+          this->face_no = neighbor_face_no;
+        }
+      if (this->face_no == numbers::invalid_unsigned_int)
+        this->face_no = face_number;
+    }
+
   const unsigned int offsets =
     this->matrix_info->get_mapping_info()
       .face_data_by_cells[this->quad_no]
@@ -7960,10 +8446,11 @@ FEFaceEvaluation<dim,
                             .normal_vectors[offsets];
   this->jacobian = &this->matrix_info->get_mapping_info()
                       .face_data_by_cells[this->quad_no]
-                      .jacobians[0][offsets];
-  this->normal_x_jacobian = &this->matrix_info->get_mapping_info()
-                               .face_data_by_cells[this->quad_no]
-                               .normals_times_jacobians[0][offsets];
+                      .jacobians[!this->is_interior_face][offsets];
+  this->normal_x_jacobian =
+    &this->matrix_info->get_mapping_info()
+       .face_data_by_cells[this->quad_no]
+       .normals_times_jacobians[!this->is_interior_face][offsets];
 
 #  ifdef DEBUG
   this->dof_values_initialized     = false;
@@ -8261,8 +8748,16 @@ FEFaceEvaluation<
                          internal::is_vectorizable<VectorType, Number>::value>
     vector_selector;
 
+  // The neighbors of cells accessed by the cell-based reinit() function go
+  // through the general vector access of case 5
+  const bool access_neighbor_cells =
+    this->is_interior_face == false &&
+    this->dof_access_index ==
+      internal::MatrixFreeFunctions::DoFInfo::dof_access_cell;
+
   // case 1: contiguous and interleaved indices
-  if (((evaluate_gradients == false &&
+  if (access_neighbor_cells == false &&
+      ((evaluate_gradients == false &&
         this->data->nodal_at_cell_boundaries == true) ||
        (this->data->element_type ==
           internal::MatrixFreeFunctions::tensor_symmetric_hermite &&
@@ -8348,7 +8843,8 @@ FEFaceEvaluation<
     }
 
   // case 2: contiguous and interleaved indices with fixed stride
-  else if (((evaluate_gradients == false &&
+  else if (access_neighbor_cells == false &&
+           ((evaluate_gradients == false &&
              this->data->nodal_at_cell_boundaries == true) ||
             (this->data->element_type ==
                internal::MatrixFreeFunctions::tensor_symmetric_hermite &&
@@ -8445,7 +8941,8 @@ FEFaceEvaluation<
     }
 
   // case 3: contiguous and interleaved indices with mixed stride
-  else if (((evaluate_gradients == false &&
+  else if (access_neighbor_cells == false &&
+           ((evaluate_gradients == false &&
              this->data->nodal_at_cell_boundaries == true) ||
             (this->data->element_type ==
                internal::MatrixFreeFunctions::tensor_symmetric_hermite &&
@@ -8593,7 +9090,8 @@ FEFaceEvaluation<
     }
 
   // case 4: contiguous indices without interleaving
-  else if (((evaluate_gradients == false &&
+  else if (access_neighbor_cells == false &&
+           ((evaluate_gradients == false &&
              this->data->nodal_at_cell_boundaries == true) ||
             (this->data->element_type ==
                internal::MatrixFreeFunctions::tensor_symmetric_hermite &&
@@ -8824,8 +9322,16 @@ FEFaceEvaluation<
                          internal::is_vectorizable<VectorType, Number>::value>
     vector_selector;
 
+  // The neighbors of cells accessed by the cell-based reinit() function go
+  // through the general vector access of case 5
+  const bool access_neighbor_cells =
+    this->is_interior_face == false &&
+    this->dof_access_index ==
+      internal::MatrixFreeFunctions::DoFInfo::dof_access_cell;
+
   // case 1: contiguous and interleaved indices
-  if (((integrate_gradients == false &&
+  if (access_neighbor_cells == false &&
+      ((integrate_gradients == false &&
         this->data->nodal_at_cell_boundaries == true) ||
        (this->data->element_type ==
           internal::MatrixFreeFunctions::tensor_symmetric_hermite &&
@@ -8914,7 +9420,8 @@ FEFaceEvaluation<
     }
 
   // case 2: contiguous and interleaved indices with fixed stride
-  else if (((integrate_gradients == false &&
+  else if (access_neighbor_cells == false &&
+           ((integrate_gradients == false &&
              this->data->nodal_at_cell_boundaries == true) ||
             (this->data->element_type ==
                internal::MatrixFreeFunctions::tensor_symmetric_hermite &&
@@ -9015,7 +9522,8 @@ FEFaceEvaluation<
     }
 
   // case 3: contiguous and interleaved indices with mixed stride
-  else if (((integrate_gradients == false &&
+  else if (access_neighbor_cells == false &&
+           ((integrate_gradients == false &&
              this->data->nodal_at_cell_boundaries == true) ||
             (this->data->element_type ==
                internal::MatrixFreeFunctions::tensor_symmetric_hermite &&
@@ -9157,7 +9665,8 @@ FEFaceEvaluation<
     }
 
   // case 4: contiguous indices without interleaving
-  else if (((integrate_gradients == false &&
+  else if (access_neighbor_cells == false &&
+           ((integrate_gradients == false &&
              this->data->nodal_at_cell_boundaries == true) ||
             (this->data->element_type ==
                internal::MatrixFreeFunctions::tensor_symmetric_hermite &&
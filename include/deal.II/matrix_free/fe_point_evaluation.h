@@ -0,0 +1,894 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef dealii_fe_point_evaluation_h
+#define dealii_fe_point_evaluation_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/std_cxx14/memory.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/fe/fe_nothing.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/matrix_free/shape_info.h>
+#include <deal.II/matrix_free/tensor_product_kernels.h>
+
+#include <memory>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace FEPointEvaluation
+  {
+    /**
+     * The types of the values and gradients returned by FEPointEvaluation,
+     * which are scalars and tensors of rank one for scalar elements and
+     * tensors of one rank higher for vector-valued elements.
+     */
+    template <int n_components, int dim, typename Number>
+    struct EvaluatorTypeTraits
+    {
+      using value_type    = Tensor<1, n_components, Number>;
+      using gradient_type = Tensor<1, n_components, Tensor<1, dim, Number>>;
+
+      static Number &
+      access(value_type &value, const unsigned int component)
+      {
+        return value[component];
+      }
+
+      static const Number &
+      access(const value_type &value, const unsigned int component)
+      {
+        return value[component];
+      }
+
+      static Tensor<1, dim, Number> &
+      access(gradient_type &gradient, const unsigned int component)
+      {
+        return gradient[component];
+      }
+
+      static const Tensor<1, dim, Number> &
+      access(const gradient_type &gradient, const unsigned int component)
+      {
+        return gradient[component];
+      }
+    };
+
+    template <int dim, typename Number>
+    struct EvaluatorTypeTraits<1, dim, Number>
+    {
+      using value_type    = Number;
+      using gradient_type = Tensor<1, dim, Number>;
+
+      static Number &
+      access(value_type &value, const unsigned int)
+      {
+        return value;
+      }
+
+      static const Number &
+      access(const value_type &value, const unsigned int)
+      {
+        return value;
+      }
+
+      static Tensor<1, dim, Number> &
+      access(gradient_type &gradient, const unsigned int)
+      {
+        return gradient;
+      }
+
+      static const Tensor<1, dim, Number> &
+      access(const gradient_type &gradient, const unsigned int)
+      {
+        return gradient;
+      }
+    };
+
+
+
+    /**
+     * Evaluation and integration of a tensor product of 1D polynomials at a
+     * single point, or at several points at once if @p Number is a
+     * VectorizedArray. The values and derivatives of the @p n 1D
+     * polynomials in direction @p d at the point are given by
+     * <code>shapes[2*n*d + i]</code> and <code>shapes[2*n*d + n + i]</code>,
+     * respectively. The coefficients are given in lexicographic ordering.
+     * The sum over the coefficients is factorized into one sum per
+     * direction, starting with the slowest running index, which results in
+     * a cost of $\mathcal O(n^d)$ operations per point.
+     */
+    template <int dim, typename Number, typename Number2>
+    struct PointKernel
+    {
+      template <bool do_gradients>
+      static void
+      evaluate(const unsigned int      n,
+               const Number *          shapes,
+               const Number2 *         values,
+               Number &                value,
+               Tensor<1, dim, Number> &gradient)
+      {
+        const unsigned int stride = Utilities::fixed_power<dim - 1>(n);
+        const Number *     my_shapes = shapes + 2 * n * (dim - 1);
+
+        value    = Number();
+        gradient = Tensor<1, dim, Number>();
+        for (unsigned int i = 0; i < n; ++i)
+          {
+            Number                     inner_value;
+            Tensor<1, dim - 1, Number> inner_gradient;
+            PointKernel<dim - 1, Number, Number2>::template evaluate<
+              do_gradients>(
+              n, shapes, values + i * stride, inner_value, inner_gradient);
+
+            value += my_shapes[i] * inner_value;
+            if (do_gradients)
+              {
+                for (unsigned int d = 0; d < dim - 1; ++d)
+                  gradient[d] += my_shapes[i] * inner_gradient[d];
+                gradient[dim - 1] += my_shapes[n + i] * inner_value;
+              }
+          }
+      }
+
+      template <bool do_gradients>
+      static void
+      integrate(const unsigned int            n,
+                const Number *                shapes,
+                const Number &                value,
+                const Tensor<1, dim, Number> &gradient,
+                Number *                      values)
+      {
+        const unsigned int stride = Utilities::fixed_power<dim - 1>(n);
+        const Number *     my_shapes = shapes + 2 * n * (dim - 1);
+
+        for (unsigned int i = 0; i < n; ++i)
+          {
+            Number                     inner_value = my_shapes[i] * value;
+            Tensor<1, dim - 1, Number> inner_gradient;
+            if (do_gradients)
+              {
+                inner_value += my_shapes[n + i] * gradient[dim - 1];
+                for (unsigned int d = 0; d < dim - 1; ++d)
+                  inner_gradient[d] = my_shapes[i] * gradient[d];
+              }
+            PointKernel<dim - 1, Number, Number2>::template integrate<
+              do_gradients>(
+              n, shapes, inner_value, inner_gradient, values + i * stride);
+          }
+      }
+    };
+
+    template <typename Number, typename Number2>
+    struct PointKernel<1, Number, Number2>
+    {
+      template <bool do_gradients>
+      static void
+      evaluate(const unsigned int    n,
+               const Number *        shapes,
+               const Number2 *       values,
+               Number &              value,
+               Tensor<1, 1, Number> &gradient)
+      {
+        value = shapes[0] * values[0];
+        if (do_gradients)
+          gradient[0] = shapes[n] * values[0];
+        for (unsigned int i = 1; i < n; ++i)
+          {
+            value += shapes[i] * values[i];
+            if (do_gradients)
+              gradient[0] += shapes[n + i] * values[i];
+          }
+      }
+
+      template <bool do_gradients>
+      static void
+      integrate(const unsigned int          n,
+                const Number *              shapes,
+                const Number &              value,
+                const Tensor<1, 1, Number> &gradient,
+                Number *                    values)
+      {
+        for (unsigned int i = 0; i < n; ++i)
+          {
+            values[i] += shapes[i] * value;
+            if (do_gradients)
+              values[i] += shapes[n + i] * gradient[0];
+          }
+      }
+    };
+  } // namespace FEPointEvaluation
+} // namespace internal
+
+
+
+/**
+ * This class provides an interface to the evaluation of interpolated
+ * solution values and gradients on cells at arbitrary reference point
+ * locations, e.g. at the locations of particles, and to the transposed
+ * operation of testing with the shape functions at these points, as needed
+ * for scattering particle quantities to the mesh. It is an alternative to
+ * setting up an FEValues object with a Quadrature object holding the points
+ * of each cell, which needs to compute the full tables of shape function
+ * values and gradients for each cell.
+ *
+ * Instead, this class uses the representation of the element as a tensor
+ * product of 1D polynomials that is also used by FEEvaluation, as given by
+ * internal::MatrixFreeFunctions::ShapeInfo. The coefficients of a cell are
+ * first transformed to the values in the points of a 1D Lagrange basis in
+ * the Gauss-Lobatto points by sum factorization, which is skipped for nodal
+ * elements like FE_Q and FE_DGQ with their default support points. The
+ * interpolant is then evaluated at the points with the values of the 1D
+ * Lagrange polynomials in each direction and the sum is factorized into one
+ * sum per direction. The points are processed in batches of
+ * VectorizedArray<Number>::n_array_elements points with vectorized
+ * arithmetic. The integration works in the reverse order, adding the
+ * contributions of all points to the coefficients of the cell.
+ *
+ * All elements supported by FEEvaluation that are a full tensor product of
+ * 1D polynomials are supported, possibly as the single base element of an
+ * FESystem with @p n_components components. Values are computed on the
+ * reference cell and need no mapping. For gradients, which need the
+ * inverse Jacobian of the mapping at the points, and for the real location
+ * of the points, an FEValues object with an FE_Nothing element is used to
+ * query the given mapping in reinit().
+ *
+ * A typical use to interpolate a field to the particles of a
+ * Particles::ParticleHandler reads as follows:
+ * @code
+ * FEPointEvaluation<1, dim> evaluator(mapping, dof_handler.get_fe());
+ * std::vector<double>       solution_values(fe.dofs_per_cell);
+ * std::vector<Point<dim>>   unit_points;
+ * for (const auto &cell : dof_handler.active_cell_iterators())
+ *   {
+ *     const auto particles = particle_handler.particles_in_cell(cell);
+ *     unit_points.clear();
+ *     for (const auto &particle : particles)
+ *       unit_points.push_back(particle.get_reference_location());
+ *
+ *     cell->get_dof_values(solution,
+ *                          solution_values.begin(),
+ *                          solution_values.end());
+ *     evaluator.reinit(cell, unit_points);
+ *     evaluator.evaluate(solution_values, true, false);
+ *
+ *     unsigned int p = 0;
+ *     for (auto &particle : particles)
+ *       particle.get_properties()[0] = evaluator.get_value(p++);
+ *   }
+ * @endcode
+ *
+ * @tparam n_components The number of components of the element.
+ * @tparam dim The space dimension.
+ * @tparam Number The number type of the solution values, double or float.
+ */
+template <int n_components, int dim, typename Number = double>
+class FEPointEvaluation
+{
+public:
+  using value_type = typename internal::FEPointEvaluation::
+    EvaluatorTypeTraits<n_components, dim, Number>::value_type;
+  using gradient_type = typename internal::FEPointEvaluation::
+    EvaluatorTypeTraits<n_components, dim, Number>::gradient_type;
+
+  /**
+   * Constructor. Sets up the 1D polynomials of the element @p fe. The
+   * argument @p update_flags controls what is computed by reinit():
+   * update_gradients enables the evaluation and integration of gradients,
+   * and update_quadrature_points enables real_point().
+   */
+  FEPointEvaluation(const Mapping<dim> &       mapping,
+                    const FiniteElement<dim> & fe,
+                    const UpdateFlags          update_flags = update_values);
+
+  /**
+   * Set up the evaluation at the points @p unit_points, given in the
+   * coordinates of the reference cell, of the cell @p cell.
+   */
+  void
+  reinit(const typename Triangulation<dim>::cell_iterator &cell,
+         const ArrayView<const Point<dim>> &               unit_points);
+
+  /**
+   * Evaluate the interpolant of the coefficients @p solution_values of the
+   * cell, given in the numbering of the element, at the points passed to
+   * reinit(). The results are accessible through get_value() and
+   * get_gradient().
+   */
+  void
+  evaluate(const ArrayView<const Number> &solution_values,
+           const bool                     evaluate_values,
+           const bool                     evaluate_gradients);
+
+  /**
+   * Test the values and gradients submitted by submit_value() and
+   * submit_gradient() with the shape functions and their gradients,
+   * respectively, at the points passed to reinit(), summing over all
+   * points. The result is written into @p solution_values in the numbering
+   * of the element, overwriting its previous content.
+   */
+  void
+  integrate(const ArrayView<Number> &solution_values,
+            const bool               integrate_values,
+            const bool               integrate_gradients);
+
+  /**
+   * Return the value at the point with index @p point_index after a call
+   * to evaluate() with @p evaluate_values set.
+   */
+  const value_type &
+  get_value(const unsigned int point_index) const;
+
+  /**
+   * Write a value to be tested by integrate() at the point with index
+   * @p point_index.
+   */
+  void
+  submit_value(const value_type &value, const unsigned int point_index);
+
+  /**
+   * Return the gradient in real coordinates at the point with index
+   * @p point_index after a call to evaluate() with @p evaluate_gradients
+   * set.
+   */
+  const gradient_type &
+  get_gradient(const unsigned int point_index) const;
+
+  /**
+   * Write a gradient in real coordinates to be tested by integrate() at the
+   * point with index @p point_index.
+   */
+  void
+  submit_gradient(const gradient_type &gradient,
+                  const unsigned int   point_index);
+
+  /**
+   * Return the number of points passed to the last call of reinit().
+   */
+  unsigned int
+  n_points() const;
+
+  /**
+   * Return the location of the point with index @p point_index on the
+   * reference cell.
+   */
+  const Point<dim> &
+  unit_point(const unsigned int point_index) const;
+
+  /**
+   * Return the location of the point with index @p point_index in real
+   * coordinates. Requires update_quadrature_points.
+   */
+  Point<dim>
+  real_point(const unsigned int point_index) const;
+
+private:
+  using VectorizedArrayType = VectorizedArray<Number>;
+
+  /**
+   * Fill @p shapes with the values and derivatives of the 1D Lagrange
+   * polynomials at the points of the batch starting at @p first_point. Lanes
+   * beyond the last point are filled with the last point.
+   */
+  void
+  compute_shapes(const unsigned int first_point);
+
+  /**
+   * The mapping used to compute Jacobians and real point locations.
+   */
+  SmartPointer<const Mapping<dim>> mapping;
+
+  /**
+   * The update flags passed to the constructor.
+   */
+  const UpdateFlags update_flags;
+
+  /**
+   * The 1D shape functions of the element, evaluated in the nodes of the 1D
+   * Lagrange basis.
+   */
+  internal::MatrixFreeFunctions::ShapeInfo<Number> shape_info;
+
+  /**
+   * The nodes of the 1D Lagrange basis used for the evaluation.
+   */
+  std::vector<Number> nodes;
+
+  /**
+   * The inverse of the product of the differences of each node to all other
+   * nodes, which normalizes the 1D Lagrange polynomials.
+   */
+  std::vector<Number> lagrange_weights;
+
+  /**
+   * The element used for the FEValues object querying the mapping.
+   */
+  FE_Nothing<dim> fe_nothing;
+
+  /**
+   * The FEValues object querying the mapping if gradients or real point
+   * locations are requested.
+   */
+  std::unique_ptr<FEValues<dim>> fe_values;
+
+  /**
+   * The points passed to reinit().
+   */
+  std::vector<Point<dim>> unit_points;
+
+  /**
+   * The inverse Jacobians of the mapping at the points.
+   */
+  std::vector<DerivativeForm<1, dim, dim>> inverse_jacobians;
+
+  /**
+   * The values at the points.
+   */
+  std::vector<value_type> values;
+
+  /**
+   * The gradients at the points.
+   */
+  std::vector<gradient_type> gradients;
+
+  /**
+   * The coefficients of the cell in the 1D Lagrange basis.
+   */
+  AlignedVector<Number> nodal_values;
+
+  /**
+   * The contributions of the points to the coefficients in the 1D Lagrange
+   * basis during integrate(), still split by lanes.
+   */
+  AlignedVector<VectorizedArrayType> nodal_contributions;
+
+  /**
+   * The values and derivatives of the 1D polynomials at a batch of points.
+   */
+  AlignedVector<VectorizedArrayType> shapes;
+};
+
+
+
+// ----------------------- template and inline functions ----------------------
+
+
+template <int n_components, int dim, typename Number>
+FEPointEvaluation<n_components, dim, Number>::FEPointEvaluation(
+  const Mapping<dim> &       mapping,
+  const FiniteElement<dim> & fe,
+  const UpdateFlags          update_flags)
+  : mapping(&mapping)
+  , update_flags(update_flags)
+{
+  AssertDimension(fe.n_components(), n_components);
+  AssertThrow(fe.n_base_elements() == 1,
+              ExcMessage("FEPointEvaluation only supports elements with a "
+                         "single base element."));
+
+  // The polynomials are represented by their values in the n nodes of a 1D
+  // Lagrange basis with the same number of nodes as polynomials, which
+  // avoids an ill-conditioned representation in the monomial basis
+  const unsigned int n = fe.degree + 1;
+  const Quadrature<1> quadrature_1d =
+    (n == 1 ? Quadrature<1>(QGauss<1>(1)) : Quadrature<1>(QGaussLobatto<1>(n)));
+  shape_info.reinit(quadrature_1d, fe);
+
+  AssertThrow(shape_info.element_type <=
+                internal::MatrixFreeFunctions::tensor_general,
+              ExcMessage("FEPointEvaluation only supports elements that are "
+                         "a full tensor product of 1D polynomials."));
+  AssertDimension(shape_info.fe_degree + 1, n);
+
+  nodes.resize(n);
+  lagrange_weights.resize(n, Number(1.));
+  for (unsigned int i = 0; i < n; ++i)
+    nodes[i] = quadrature_1d.point(i)[0];
+  for (unsigned int i = 0; i < n; ++i)
+    {
+      for (unsigned int j = 0; j < n; ++j)
+        if (j != i)
+          lagrange_weights[i] *= nodes[i] - nodes[j];
+      lagrange_weights[i] = Number(1.) / lagrange_weights[i];
+    }
+
+  shapes.resize_fast(2 * n * dim);
+}
+
+
+
+template <int n_components, int dim, typename Number>
+void
+FEPointEvaluation<n_components, dim, Number>::reinit(
+  const typename Triangulation<dim>::cell_iterator &cell,
+  const ArrayView<const Point<dim>> &               unit_points)
+{
+  this->unit_points.assign(unit_points.begin(), unit_points.end());
+  values.resize(unit_points.size());
+
+  const UpdateFlags mapping_flags =
+    ((update_flags & update_gradients) ? update_inverse_jacobians :
+                                         update_default) |
+    (update_flags & update_quadrature_points);
+  if (mapping_flags != update_default && unit_points.size() > 0)
+    {
+      const Quadrature<dim> quadrature(this->unit_points);
+      fe_values = std_cxx14::make_unique<FEValues<dim>>(*mapping,
+                                                        fe_nothing,
+                                                        quadrature,
+                                                        mapping_flags);
+      fe_values->reinit(cell);
+
+      if (update_flags & update_gradients)
+        {
+          gradients.resize(unit_points.size());
+          inverse_jacobians.resize(unit_points.size());
+          for (unsigned int q = 0; q < unit_points.size(); ++q)
+            inverse_jacobians[q] = fe_values->inverse_jacobian(q);
+        }
+    }
+}
+
+
+
+template <int n_components, int dim, typename Number>
+inline void
+FEPointEvaluation<n_components, dim, Number>::compute_shapes(
+  const unsigned int first_point)
+{
+  const unsigned int n        = nodes.size();
+  const unsigned int n_lanes  = VectorizedArrayType::n_array_elements;
+  const unsigned int n_points = unit_points.size();
+
+  Point<dim, VectorizedArrayType> point;
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    for (unsigned int d = 0; d < dim; ++d)
+      point[d][v] = unit_points[std::min(first_point + v, n_points - 1)][d];
+
+  // values and derivatives of the Lagrange polynomials by the product
+  // formula and the product rule
+  for (unsigned int d = 0; d < dim; ++d)
+    for (unsigned int i = 0; i < n; ++i)
+      {
+        VectorizedArrayType value      = lagrange_weights[i];
+        VectorizedArrayType derivative = VectorizedArrayType();
+        for (unsigned int j = 0; j < n; ++j)
+          if (j != i)
+            {
+              const VectorizedArrayType factor = point[d] - nodes[j];
+              derivative                       = derivative * factor + value;
+              value *= factor;
+            }
+        shapes[2 * n * d + i]     = value;
+        shapes[2 * n * d + n + i] = derivative;
+      }
+}
+
+
+
+template <int n_components, int dim, typename Number>
+void
+FEPointEvaluation<n_components, dim, Number>::evaluate(
+  const ArrayView<const Number> &solution_values,
+  const bool                     evaluate_values,
+  const bool                     evaluate_gradients)
+{
+  AssertDimension(solution_values.size(),
+                  shape_info.lexicographic_numbering.size());
+  Assert(!evaluate_gradients || (update_flags & update_gradients),
+         ExcMessage("Gradients need update_gradients in the constructor."));
+  if (unit_points.empty() || !(evaluate_values || evaluate_gradients))
+    return;
+
+  using Traits = internal::FEPointEvaluation::
+    EvaluatorTypeTraits<n_components, dim, Number>;
+  using Kernel = internal::FEPointEvaluation::
+    PointKernel<dim, VectorizedArrayType, Number>;
+
+  const unsigned int n                  = nodes.size();
+  const unsigned int dofs_per_component = shape_info.dofs_per_component_on_cell;
+  const unsigned int n_lanes            = VectorizedArrayType::n_array_elements;
+  const unsigned int n_points           = unit_points.size();
+
+  // Transform the coefficients of each component into the coefficients of
+  // the 1D Lagrange basis, with one sum-factorization sweep per direction
+  nodal_values.resize_fast(n_components * dofs_per_component);
+  for (unsigned int i = 0; i < nodal_values.size(); ++i)
+    nodal_values[i] = solution_values[shape_info.lexicographic_numbering[i]];
+  if (!shape_info.shape_values_identity)
+    {
+      internal::EvaluatorTensorProduct<internal::evaluate_general,
+                                       dim,
+                                       0,
+                                       0,
+                                       Number,
+                                       Number>
+        eval(shape_info.shape_values,
+             AlignedVector<Number>(),
+             AlignedVector<Number>(),
+             n,
+             n);
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          Number *data = nodal_values.begin() + c * dofs_per_component;
+          eval.template values<0, true, false>(data, data);
+          if (dim > 1)
+            eval.template values<(dim > 1 ? 1 : 0), true, false>(data, data);
+          if (dim > 2)
+            eval.template values<(dim > 2 ? 2 : 0), true, false>(data, data);
+        }
+    }
+
+  for (unsigned int first = 0; first < n_points; first += n_lanes)
+    {
+      const unsigned int n_active = std::min(n_lanes, n_points - first);
+      compute_shapes(first);
+
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          VectorizedArrayType                 value;
+          Tensor<1, dim, VectorizedArrayType> unit_gradient;
+          if (evaluate_gradients)
+            Kernel::template evaluate<true>(n,
+                                            shapes.begin(),
+                                            nodal_values.begin() +
+                                              c * dofs_per_component,
+                                            value,
+                                            unit_gradient);
+          else
+            Kernel::template evaluate<false>(n,
+                                             shapes.begin(),
+                                             nodal_values.begin() +
+                                               c * dofs_per_component,
+                                             value,
+                                             unit_gradient);
+
+          for (unsigned int v = 0; v < n_active; ++v)
+            {
+              if (evaluate_values)
+                Traits::access(values[first + v], c) = value[v];
+              if (evaluate_gradients)
+                {
+                  // transform to real coordinates with the transpose of
+                  // the inverse Jacobian
+                  Tensor<1, dim, Number> &gradient =
+                    Traits::access(gradients[first + v], c);
+                  for (unsigned int d = 0; d < dim; ++d)
+                    {
+                      gradient[d] = 0;
+                      for (unsigned int e = 0; e < dim; ++e)
+                        gradient[d] += unit_gradient[e][v] *
+                                       inverse_jacobians[first + v][e][d];
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+
+template <int n_components, int dim, typename Number>
+void
+FEPointEvaluation<n_components, dim, Number>::integrate(
+  const ArrayView<Number> &solution_values,
+  const bool               integrate_values,
+  const bool               integrate_gradients)
+{
+  AssertDimension(solution_values.size(),
+                  shape_info.lexicographic_numbering.size());
+  Assert(!integrate_gradients || (update_flags & update_gradients),
+         ExcMessage("Gradients need update_gradients in the constructor."));
+
+  using Traits = internal::FEPointEvaluation::
+    EvaluatorTypeTraits<n_components, dim, Number>;
+  using Kernel = internal::FEPointEvaluation::
+    PointKernel<dim, VectorizedArrayType, Number>;
+
+  const unsigned int n                  = nodes.size();
+  const unsigned int dofs_per_component = shape_info.dofs_per_component_on_cell;
+  const unsigned int n_lanes            = VectorizedArrayType::n_array_elements;
+  const unsigned int n_points           = unit_points.size();
+
+  nodal_contributions.resize_fast(n_components * dofs_per_component);
+  for (unsigned int i = 0; i < nodal_contributions.size(); ++i)
+    nodal_contributions[i] = VectorizedArrayType();
+
+  if (integrate_values || integrate_gradients)
+    for (unsigned int first = 0; first < n_points; first += n_lanes)
+      {
+        const unsigned int n_active = std::min(n_lanes, n_points - first);
+        compute_shapes(first);
+
+        for (unsigned int c = 0; c < n_components; ++c)
+          {
+            // the lanes beyond the last point do not contribute
+            VectorizedArrayType                 value = VectorizedArrayType();
+            Tensor<1, dim, VectorizedArrayType> unit_gradient;
+            for (unsigned int v = 0; v < n_active; ++v)
+              {
+                if (integrate_values)
+                  value[v] = Traits::access(values[first + v], c);
+                if (integrate_gradients)
+                  {
+                    // transform to reference coordinates with the inverse
+                    // Jacobian
+                    const Tensor<1, dim, Number> &gradient =
+                      Traits::access(gradients[first + v], c);
+                    for (unsigned int e = 0; e < dim; ++e)
+                      for (unsigned int d = 0; d < dim; ++d)
+                        unit_gradient[e][v] +=
+                          inverse_jacobians[first + v][e][d] * gradient[d];
+                  }
+              }
+
+            if (integrate_gradients)
+              Kernel::template integrate<true>(n,
+                                               shapes.begin(),
+                                               value,
+                                               unit_gradient,
+                                               nodal_contributions.begin() +
+                                                 c * dofs_per_component);
+            else
+              Kernel::template integrate<false>(n,
+                                                shapes.begin(),
+                                                value,
+                                                unit_gradient,
+                                                nodal_contributions.begin() +
+                                                  c * dofs_per_component);
+          }
+      }
+
+  // Sum the contributions of the lanes and apply the transpose of the
+  // transformation to the 1D Lagrange basis
+  nodal_values.resize_fast(n_components * dofs_per_component);
+  for (unsigned int i = 0; i < nodal_values.size(); ++i)
+    {
+      nodal_values[i] = nodal_contributions[i][0];
+      for (unsigned int v = 1; v < n_lanes; ++v)
+        nodal_values[i] += nodal_contributions[i][v];
+    }
+  if (!shape_info.shape_values_identity)
+    {
+      internal::EvaluatorTensorProduct<internal::evaluate_general,
+                                       dim,
+                                       0,
+                                       0,
+                                       Number,
+                                       Number>
+        eval(shape_info.shape_values,
+             AlignedVector<Number>(),
+             AlignedVector<Number>(),
+             n,
+             n);
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          Number *data = nodal_values.begin() + c * dofs_per_component;
+          if (dim > 2)
+            eval.template values<(dim > 2 ? 2 : 0), false, false>(data, data);
+          if (dim > 1)
+            eval.template values<(dim > 1 ? 1 : 0), false, false>(data, data);
+          eval.template values<0, false, false>(data, data);
+        }
+    }
+
+  for (unsigned int i = 0; i < nodal_values.size(); ++i)
+    solution_values[shape_info.lexicographic_numbering[i]] = nodal_values[i];
+}
+
+
+
+template <int n_components, int dim, typename Number>
+inline const typename FEPointEvaluation<n_components, dim, Number>::value_type &
+FEPointEvaluation<n_components, dim, Number>::get_value(
+  const unsigned int point_index) const
+{
+  AssertIndexRange(point_index, values.size());
+  return values[point_index];
+}
+
+
+
+template <int n_components, int dim, typename Number>
+inline const typename FEPointEvaluation<n_components, dim, Number>::
+  gradient_type &
+  FEPointEvaluation<n_components, dim, Number>::get_gradient(
+    const unsigned int point_index) const
+{
+  AssertIndexRange(point_index, gradients.size());
+  return gradients[point_index];
+}
+
+
+
+template <int n_components, int dim, typename Number>
+inline void
+FEPointEvaluation<n_components, dim, Number>::submit_value(
+  const value_type & value,
+  const unsigned int point_index)
+{
+  AssertIndexRange(point_index, values.size());
+  values[point_index] = value;
+}
+
+
+
+template <int n_components, int dim, typename Number>
+inline void
+FEPointEvaluation<n_components, dim, Number>::submit_gradient(
+  const gradient_type &gradient,
+  const unsigned int   point_index)
+{
+  AssertIndexRange(point_index, gradients.size());
+  gradients[point_index] = gradient;
+}
+
+
+
+template <int n_components, int dim, typename Number>
+inline unsigned int
+FEPointEvaluation<n_components, dim, Number>::n_points() const
+{
+  return unit_points.size();
+}
+
+
+
+template <int n_components, int dim, typename Number>
+inline const Point<dim> &
+FEPointEvaluation<n_components, dim, Number>::unit_point(
+  const unsigned int point_index) const
+{
+  AssertIndexRange(point_index, unit_points.size());
+  return unit_points[point_index];
+}
+
+
+
+template <int n_components, int dim, typename Number>
+inline Point<dim>
+FEPointEvaluation<n_components, dim, Number>::real_point(
+  const unsigned int point_index) const
+{
+  Assert(update_flags & update_quadrature_points,
+         ExcMessage("Real points need update_quadrature_points in the "
+                    "constructor."));
+  AssertIndexRange(point_index, unit_points.size());
+  return fe_values->quadrature_point(point_index);
+}
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
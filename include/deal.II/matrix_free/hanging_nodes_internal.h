@@ -0,0 +1,907 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 - 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_matrix_free_hanging_nodes_internal_h
+#define dealii_matrix_free_hanging_nodes_internal_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_tools.h>
+
+#include <deal.II/matrix_free/shape_info.h>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  namespace MatrixFreeFunctions
+  {
+    /**
+     * Here is the system for how we store constraint types in a binary mask.
+     * This is not a complete contradiction-free system, i.e., there are
+     * invalid states that we just assume that we never get.
+     *
+     * If the mask is zero, there are no constraints. Then, there are three
+     * different fields with one bit per dimension. The first field determines
+     * the type, or the position of an element along each direction. The
+     * second field determines if there is a constrained face with that
+     * direction as normal. The last field determines if there is a
+     * constrained edge of a given pair of coordinate planes, but where
+     * neither of the corresponding faces are constrained (only valid in 3D).
+     *
+     * The layout is the same as the one used by CUDAWrappers::MatrixFree.
+     */
+    enum HangingNodeConstraintMask : unsigned int
+    {
+      /**
+       * The element is placed in the 'first position' along the respective
+       * axis. These also determine which face is constrained. For example,
+       * in 2D, if constr_face_x and constr_type_x are set, then x = 0 is
+       * constrained.
+       */
+      constr_type_x = 1 << 0,
+      constr_type_y = 1 << 1,
+      constr_type_z = 1 << 2,
+
+      /**
+       * Element has a constraint at the face with the respective normal
+       * direction.
+       */
+      constr_face_x = 1 << 3,
+      constr_face_y = 1 << 4,
+      constr_face_z = 1 << 5,
+
+      /**
+       * Element has a constraint at an edge between the respective pair of
+       * coordinate planes.
+       */
+      constr_edge_xy = 1 << 6,
+      constr_edge_yz = 1 << 7,
+      constr_edge_zx = 1 << 8
+    };
+
+
+
+    /**
+     * This class creates the mask used in the treatment of hanging nodes in
+     * FEEvaluation and replaces the indices of the hanging degrees of
+     * freedom on a cell by the indices of the degrees of freedom on the
+     * coarser neighbor they are constrained to. This is the host part of the
+     * algorithm in CUDAWrappers::internal::HangingNodes, without the
+     * transfer of indices to the device.
+     *
+     * The implementation of this class is explained in <em>Section 3 of
+     * Matrix-Free Finite-Element Computations On Graphics Processors With
+     * Adaptively Refined Unstructured Meshes</em> by Karl Ljungkvist,
+     * SpringSim-HPC, 2017 April 23-26.
+     */
+    template <int dim>
+    class HangingNodes
+    {
+    public:
+      /**
+       * Constructor. The shape functions are assumed to be the ones of a
+       * scalar FE_Q element of degree @p fe_degree, and @p
+       * lexicographic_numbering translates the lexicographic numbering of
+       * the unknowns in the cell into the numbering of the finite element.
+       */
+      HangingNodes(const unsigned int               fe_degree,
+                   const DoFHandler<dim> &          dof_handler,
+                   const std::vector<unsigned int> &lexicographic_numbering);
+
+      /**
+       * Compute the value of the constraint mask for a given cell and replace
+       * the indices of the constrained degrees of freedom in @p dof_indices
+       * by the indices on the coarser neighbor. The indices are given in the
+       * numbering of the finite element, i.e., as returned by
+       * DoFCellAccessor::get_dof_indices().
+       */
+      void
+      setup_constraints(
+        const typename DoFHandler<dim>::active_cell_iterator &cell,
+        std::vector<types::global_dof_index> &                dof_indices,
+        unsigned int &                                        mask) const;
+
+    private:
+      /**
+       * Set up line-to-cell mapping for edge constraints in 3D.
+       */
+      void
+      setup_line_to_cell();
+
+      void
+      rotate_subface_index(int times, unsigned int &subface_index) const;
+
+      void
+      rotate_face(int                                   times,
+                  unsigned int                          n_dofs_1d,
+                  std::vector<types::global_dof_index> &dofs) const;
+
+      unsigned int
+      line_dof_idx(int          local_line,
+                   unsigned int dof,
+                   unsigned int n_dofs_1d) const;
+
+      void
+      transpose_face(std::vector<types::global_dof_index> &dofs) const;
+
+      void
+      transpose_subface_index(unsigned int &subface) const;
+
+      using cell_iterator = typename DoFHandler<dim>::cell_iterator;
+
+      const unsigned int n_raw_lines;
+      std::vector<std::vector<std::pair<cell_iterator, unsigned int>>>
+                                       line_to_cells;
+      const std::vector<unsigned int> &lexicographic_numbering;
+      std::vector<unsigned int>        lexicographic_face_numbering;
+      const unsigned int               fe_degree;
+      const DoFHandler<dim> &          dof_handler;
+    };
+
+
+
+    /**
+     * Vectorized application of the hanging node constraints computed by
+     * HangingNodes on the lexicographically ordered degrees of freedom of a
+     * cell batch. Each lane of the vectorized array can carry a different
+     * mask. The lanes are grouped by their mask, and the interpolation is
+     * done with the full vector width for all lanes of a group at once,
+     * writing back the result only into the lanes belonging to the group.
+     *
+     * The interpolation is done in a sum-factorized way along the lines of
+     * the tensor product, using the subface interpolation matrix stored in
+     * ShapeInfo::subface_interpolation_matrix.
+     */
+    template <int dim, typename Number>
+    struct FEEvaluationImplHangingNodes
+    {
+      /**
+       * Apply the constraints (@p transpose = false, i.e., compute the values
+       * at the hanging nodes from the values on the coarser neighbor, as
+       * done when reading from a vector) or their transpose (@p transpose =
+       * true, as done when adding into a vector) on the degrees of freedom
+       * in @p values for @p n_components components. The array @p
+       * scratch_data must provide space for at least
+       * <tt>shape_info.fe_degree+1</tt> entries.
+       */
+      static void
+      run(const unsigned int       n_components,
+          const ShapeInfo<Number> &shape_info,
+          const bool               transpose,
+          const unsigned int *     constraint_masks,
+          Number *                 values,
+          Number *                 scratch_data);
+
+    private:
+      /**
+       * Interpolate along direction @p direction for all lanes marked in
+       * @p lanes, which all carry the mask @p mask.
+       */
+      static void
+      interpolate(const unsigned int direction,
+                  const unsigned int fe_degree,
+                  const Number *     weights,
+                  const bool         transpose,
+                  const unsigned int mask,
+                  const bool *       lanes,
+                  Number *           values,
+                  Number *           tmp);
+    };
+
+
+
+    /* ---------------------- inline/template functions ------------------- */
+
+    template <int dim>
+    inline HangingNodes<dim>::HangingNodes(
+      const unsigned int               fe_degree,
+      const DoFHandler<dim> &          dof_handler,
+      const std::vector<unsigned int> &lexicographic_numbering)
+      : n_raw_lines(dof_handler.get_triangulation().n_raw_lines())
+      , line_to_cells(dim == 3 ? n_raw_lines : 0)
+      , lexicographic_numbering(lexicographic_numbering)
+      , fe_degree(fe_degree)
+      , dof_handler(dof_handler)
+    {
+      Assert(dim > 1, ExcNotImplemented());
+
+      // the face numbering of an FE_Q in dim-1 dimensions; we need to avoid
+      // to instantiate FE_Q<0> for dim = 1, where this class is never used
+      constexpr int face_dim = dim > 1 ? dim - 1 : 1;
+      lexicographic_face_numbering =
+        FETools::lexicographic_to_hierarchic_numbering<face_dim>(
+          FE_Q<face_dim>(fe_degree));
+
+      // Set up line-to-cell mapping for edge constraints (only if dim = 3)
+      if (dim == 3)
+        setup_line_to_cell();
+    }
+
+
+
+    template <int dim>
+    inline void
+    HangingNodes<dim>::setup_line_to_cell()
+    {
+      // In 3D, we can have DoFs on only an edge being constrained (e.g. in a
+      // cartesian 2x2x2 grid, where only the upper left 2 cells are refined).
+      // This sets up a helper data structure in the form of a mapping from
+      // edges (i.e. lines) to neighboring cells.
+
+      // Mapping from an edge to which children that share that edge.
+      const unsigned int line_to_children[12][2] = {{0, 2},
+                                                    {1, 3},
+                                                    {0, 1},
+                                                    {2, 3},
+                                                    {4, 6},
+                                                    {5, 7},
+                                                    {4, 5},
+                                                    {6, 7},
+                                                    {0, 4},
+                                                    {1, 5},
+                                                    {2, 6},
+                                                    {3, 7}};
+
+      std::vector<std::vector<std::pair<cell_iterator, unsigned int>>>
+        line_to_inactive_cells(n_raw_lines);
+
+      // First add active and inactive cells to their lines:
+      for (const auto &cell : dof_handler.cell_iterators())
+        {
+          for (unsigned int line = 0; line < GeometryInfo<dim>::lines_per_cell;
+               ++line)
+            {
+              const unsigned int line_idx = cell->line(line)->index();
+              if (cell->active())
+                line_to_cells[line_idx].push_back(std::make_pair(cell, line));
+              else
+                line_to_inactive_cells[line_idx].push_back(
+                  std::make_pair(cell, line));
+            }
+        }
+
+      // Now, we can access edge-neighboring active cells on same level to also
+      // access of an edge to the edges "children". These are found from looking
+      // at the corresponding edge of children of inactive edge neighbors.
+      for (unsigned int line_idx = 0; line_idx < n_raw_lines; ++line_idx)
+        {
+          if ((line_to_cells[line_idx].size() > 0) &&
+              line_to_inactive_cells[line_idx].size() > 0)
+            {
+              // We now have cells to add (active ones) and edges to which they
+              // should be added (inactive cells).
+              const cell_iterator &inactive_cell =
+                line_to_inactive_cells[line_idx][0].first;
+              const unsigned int neighbor_line =
+                line_to_inactive_cells[line_idx][0].second;
+
+              for (unsigned int c = 0; c < 2; ++c)
+                {
+                  const cell_iterator &child =
+                    inactive_cell->child(line_to_children[neighbor_line][c]);
+                  const unsigned int child_line_idx =
+                    child->line(neighbor_line)->index();
+
+                  // Now add all active cells
+                  for (const auto &cl : line_to_cells[line_idx])
+                    line_to_cells[child_line_idx].push_back(cl);
+                }
+            }
+        }
+    }
+
+
+
+    template <int dim>
+    inline void
+    HangingNodes<dim>::setup_constraints(
+      const typename DoFHandler<dim>::active_cell_iterator &cell,
+      std::vector<types::global_dof_index> &                dof_indices,
+      unsigned int &                                        mask) const
+    {
+      mask                         = 0;
+      const unsigned int n_dofs_1d = fe_degree + 1;
+      const unsigned int dofs_per_face =
+        Utilities::fixed_power<dim - 1>(n_dofs_1d);
+      AssertDimension(dof_indices.size(),
+                      Utilities::fixed_power<dim>(n_dofs_1d));
+
+      // work on a lexicographic copy of the indices
+      std::vector<types::global_dof_index> lex_indices(dof_indices.size());
+      for (unsigned int i = 0; i < lex_indices.size(); ++i)
+        lex_indices[i] = dof_indices[lexicographic_numbering[i]];
+
+      std::vector<types::global_dof_index> neighbor_dofs(dofs_per_face);
+
+      for (unsigned int face = 0; face < GeometryInfo<dim>::faces_per_cell;
+           ++face)
+        {
+          if ((!cell->at_boundary(face)) &&
+              (cell->neighbor(face)->has_children() == false))
+            {
+              const cell_iterator neighbor = cell->neighbor(face);
+
+              // Neighbor is coarser than us, i.e., face is constrained
+              if (neighbor->level() < cell->level())
+                {
+                  const unsigned int neighbor_face =
+                    cell->neighbor_face_no(face);
+
+                  // Find position of face on neighbor
+                  unsigned int subface = 0;
+                  for (; subface < GeometryInfo<dim>::max_children_per_face;
+                       ++subface)
+                    if (neighbor->neighbor_child_on_subface(neighbor_face,
+                                                            subface) == cell)
+                      break;
+
+                  // Get indices to read
+                  neighbor_dofs.resize(dofs_per_face);
+                  neighbor->face(neighbor_face)->get_dof_indices(neighbor_dofs);
+
+                  if (dim == 2)
+                    {
+                      if (face < 2)
+                        {
+                          mask |= constr_face_x;
+                          if (face == 0)
+                            mask |= constr_type_x;
+                          if (subface == 0)
+                            mask |= constr_type_y;
+                        }
+                      else
+                        {
+                          mask |= constr_face_y;
+                          if (face == 2)
+                            mask |= constr_type_y;
+                          if (subface == 0)
+                            mask |= constr_type_x;
+                        }
+
+                      // Offset if upper/right face
+                      const unsigned int offset =
+                        (face % 2 == 1) ? fe_degree : 0;
+
+                      for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                        {
+                          // x-line for y = 0 or y = fe_degree, y-line for
+                          // x = 0 or x = fe_degree
+                          const unsigned int idx =
+                            (face > 1) ? n_dofs_1d * offset + i :
+                                         n_dofs_1d * i + offset;
+
+                          lex_indices[idx] =
+                            neighbor_dofs[lexicographic_face_numbering[i]];
+                        }
+                    }
+                  else if (dim == 3)
+                    {
+                      const bool transpose = !(cell->face_orientation(face));
+
+                      int rotate = 0;
+
+                      if (cell->face_rotation(face))
+                        rotate -= 1;
+                      if (cell->face_flip(face))
+                        rotate -= 2;
+
+                      rotate_face(rotate, n_dofs_1d, neighbor_dofs);
+                      rotate_subface_index(rotate, subface);
+
+                      if (transpose)
+                        {
+                          transpose_face(neighbor_dofs);
+                          transpose_subface_index(subface);
+                        }
+
+                      // YZ-plane
+                      if (face < 2)
+                        {
+                          mask |= constr_face_x;
+                          if (face == 0)
+                            mask |= constr_type_x;
+                          if (subface % 2 == 0)
+                            mask |= constr_type_y;
+                          if (subface / 2 == 0)
+                            mask |= constr_type_z;
+                        }
+                      // XZ-plane
+                      else if (face < 4)
+                        {
+                          mask |= constr_face_y;
+                          if (face == 2)
+                            mask |= constr_type_y;
+                          if (subface % 2 == 0)
+                            mask |= constr_type_z;
+                          if (subface / 2 == 0)
+                            mask |= constr_type_x;
+                        }
+                      // XY-plane
+                      else
+                        {
+                          mask |= constr_face_z;
+                          if (face == 4)
+                            mask |= constr_type_z;
+                          if (subface % 2 == 0)
+                            mask |= constr_type_x;
+                          if (subface / 2 == 0)
+                            mask |= constr_type_y;
+                        }
+
+                      // Offset if upper/right/back face
+                      const unsigned int offset =
+                        (face % 2 == 1) ? fe_degree : 0;
+
+                      for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                        for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                          {
+                            unsigned int idx = 0;
+                            // If YZ-plane, i.e., if x = 0 or x = fe_degree,
+                            // and orientation standard
+                            if (face < 2)
+                              idx = n_dofs_1d * n_dofs_1d * i + n_dofs_1d * j +
+                                    offset;
+                            // If XZ-plane, i.e., if y = 0 or y = fe_degree,
+                            // and orientation standard
+                            else if (face < 4)
+                              idx = n_dofs_1d * n_dofs_1d * j +
+                                    n_dofs_1d * offset + i;
+                            // If XY-plane, i.e., if z = 0 or z = fe_degree,
+                            // and orientation standard
+                            else
+                              idx = n_dofs_1d * n_dofs_1d * offset +
+                                    n_dofs_1d * i + j;
+
+                            lex_indices[idx] =
+                              neighbor_dofs[lexicographic_face_numbering
+                                              [n_dofs_1d * i + j]];
+                          }
+                    }
+                  else
+                    Assert(false, ExcNotImplemented());
+                }
+            }
+        }
+
+      // In 3D we can have a situation where only DoFs on an edge are
+      // constrained. Append these here.
+      if (dim == 3)
+        {
+          // For each line on cell, which faces does it belong to, what is the
+          // edge mask, what is the types of the faces it belong to, and what is
+          // the type along the edge.
+          const unsigned int line_to_edge[12][4] = {
+            {constr_face_x | constr_face_z,
+             constr_edge_zx,
+             constr_type_x | constr_type_z,
+             constr_type_y},
+            {constr_face_x | constr_face_z,
+             constr_edge_zx,
+             constr_type_z,
+             constr_type_y},
+            {constr_face_y | constr_face_z,
+             constr_edge_yz,
+             constr_type_y | constr_type_z,
+             constr_type_x},
+            {constr_face_y | constr_face_z,
+             constr_edge_yz,
+             constr_type_z,
+             constr_type_x},
+            {constr_face_x | constr_face_z,
+             constr_edge_zx,
+             constr_type_x,
+             constr_type_y},
+            {constr_face_x | constr_face_z, constr_edge_zx, 0, constr_type_y},
+            {constr_face_y | constr_face_z,
+             constr_edge_yz,
+             constr_type_y,
+             constr_type_x},
+            {constr_face_y | constr_face_z, constr_edge_yz, 0, constr_type_x},
+            {constr_face_x | constr_face_y,
+             constr_edge_xy,
+             constr_type_x | constr_type_y,
+             constr_type_z},
+            {constr_face_x | constr_face_y,
+             constr_edge_xy,
+             constr_type_y,
+             constr_type_z},
+            {constr_face_x | constr_face_y,
+             constr_edge_xy,
+             constr_type_x,
+             constr_type_z},
+            {constr_face_x | constr_face_y, constr_edge_xy, 0, constr_type_z}};
+
+          for (unsigned int local_line = 0;
+               local_line < GeometryInfo<dim>::lines_per_cell;
+               ++local_line)
+            {
+              // If we don't already have a constraint for as part of a face
+              if (!(mask & line_to_edge[local_line][0]))
+                {
+                  // For each cell which share that edge
+                  const unsigned int line = cell->line(local_line)->index();
+                  for (const auto &edge_neighbor : line_to_cells[line])
+                    {
+                      // If one of them is coarser than us
+                      const cell_iterator neighbor_cell = edge_neighbor.first;
+                      if (neighbor_cell->level() < cell->level())
+                        {
+                          const unsigned int local_line_neighbor =
+                            edge_neighbor.second;
+                          mask |= line_to_edge[local_line][1] |
+                                  line_to_edge[local_line][2];
+
+                          bool flipped = false;
+                          if (cell->line(local_line)->vertex_index(0) ==
+                              neighbor_cell->line(local_line_neighbor)
+                                ->vertex_index(0))
+                            {
+                              // Assuming line directions match axes directions,
+                              // we have an unflipped edge of first type
+                              mask |= line_to_edge[local_line][3];
+                            }
+                          else if (cell->line(local_line)->vertex_index(1) ==
+                                   neighbor_cell->line(local_line_neighbor)
+                                     ->vertex_index(1))
+                            {
+                              // We have an unflipped edge of second type
+                            }
+                          else if (cell->line(local_line)->vertex_index(1) ==
+                                   neighbor_cell->line(local_line_neighbor)
+                                     ->vertex_index(0))
+                            {
+                              // We have a flipped edge of second type
+                              flipped = true;
+                            }
+                          else if (cell->line(local_line)->vertex_index(0) ==
+                                   neighbor_cell->line(local_line_neighbor)
+                                     ->vertex_index(1))
+                            {
+                              // We have a flipped edge of first type
+                              mask |= line_to_edge[local_line][3];
+                              flipped = true;
+                            }
+                          else
+                            Assert(false, ExcInternalError());
+
+                          // Copy the unconstrained values
+                          neighbor_dofs.resize(dof_indices.size());
+                          neighbor_cell->get_dof_indices(neighbor_dofs);
+
+                          for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                            {
+                              // Get local dof index along line
+                              const unsigned int idx =
+                                line_dof_idx(local_line, i, n_dofs_1d);
+                              lex_indices[idx] = neighbor_dofs
+                                [lexicographic_numbering[line_dof_idx(
+                                  local_line_neighbor,
+                                  flipped ? fe_degree - i : i,
+                                  n_dofs_1d)]];
+                            }
+
+                          // Stop looping over edge neighbors
+                          break;
+                        }
+                    }
+                }
+            }
+        }
+
+      // transform back to the numbering of the finite element
+      if (mask != 0)
+        for (unsigned int i = 0; i < lex_indices.size(); ++i)
+          dof_indices[lexicographic_numbering[i]] = lex_indices[i];
+    }
+
+
+
+    template <int dim>
+    inline void
+    HangingNodes<dim>::rotate_subface_index(int           times,
+                                            unsigned int &subface_index) const
+    {
+      const unsigned int rot_mapping[4] = {2, 0, 3, 1};
+
+      times = times % 4;
+      times = times < 0 ? times + 4 : times;
+      for (int t = 0; t < times; ++t)
+        subface_index = rot_mapping[subface_index];
+    }
+
+
+
+    template <int dim>
+    inline void
+    HangingNodes<dim>::rotate_face(
+      int                                   times,
+      unsigned int                          n_dofs_1d,
+      std::vector<types::global_dof_index> &dofs) const
+    {
+      const unsigned int rot_mapping[4] = {2, 0, 3, 1};
+
+      times = times % 4;
+      times = times < 0 ? times + 4 : times;
+
+      std::vector<types::global_dof_index> copy(dofs.size());
+      for (int t = 0; t < times; ++t)
+        {
+          std::swap(copy, dofs);
+
+          // Vertices
+          for (unsigned int i = 0; i < 4; ++i)
+            dofs[rot_mapping[i]] = copy[i];
+
+          // Edges
+          const unsigned int n_int  = n_dofs_1d - 2;
+          unsigned int       offset = 4;
+          for (unsigned int i = 0; i < n_int; ++i)
+            {
+              // Left edge
+              dofs[offset + i] = copy[offset + 2 * n_int + (n_int - 1 - i)];
+              // Right edge
+              dofs[offset + n_int + i] =
+                copy[offset + 3 * n_int + (n_int - 1 - i)];
+              // Bottom edge
+              dofs[offset + 2 * n_int + i] = copy[offset + n_int + i];
+              // Top edge
+              dofs[offset + 3 * n_int + i] = copy[offset + i];
+            }
+
+          // Interior points
+          offset += 4 * n_int;
+
+          for (unsigned int i = 0; i < n_int; ++i)
+            for (unsigned int j = 0; j < n_int; ++j)
+              dofs[offset + i * n_int + j] =
+                copy[offset + j * n_int + (n_int - 1 - i)];
+        }
+    }
+
+
+
+    template <int dim>
+    inline unsigned int
+    HangingNodes<dim>::line_dof_idx(int          local_line,
+                                    unsigned int dof,
+                                    unsigned int n_dofs_1d) const
+    {
+      unsigned int x, y, z;
+
+      if (local_line < 8)
+        {
+          x =
+            (local_line % 4 == 0) ? 0 : (local_line % 4 == 1) ? fe_degree : dof;
+          y =
+            (local_line % 4 == 2) ? 0 : (local_line % 4 == 3) ? fe_degree : dof;
+          z = (local_line / 4) * fe_degree;
+        }
+      else
+        {
+          x = ((local_line - 8) % 2) * fe_degree;
+          y = ((local_line - 8) / 2) * fe_degree;
+          z = dof;
+        }
+
+      return n_dofs_1d * n_dofs_1d * z + n_dofs_1d * y + x;
+    }
+
+
+
+    template <int dim>
+    inline void
+    HangingNodes<dim>::transpose_face(
+      std::vector<types::global_dof_index> &dofs) const
+    {
+      const std::vector<types::global_dof_index> copy(dofs);
+
+      // Vertices
+      dofs[1] = copy[2];
+      dofs[2] = copy[1];
+
+      // Edges
+      const unsigned int n_int  = fe_degree - 1;
+      unsigned int       offset = 4;
+      for (unsigned int i = 0; i < n_int; ++i)
+        {
+          // Right edge
+          dofs[offset + i] = copy[offset + 2 * n_int + i];
+          // Left edge
+          dofs[offset + n_int + i] = copy[offset + 3 * n_int + i];
+          // Bottom edge
+          dofs[offset + 2 * n_int + i] = copy[offset + i];
+          // Top edge
+          dofs[offset + 3 * n_int + i] = copy[offset + n_int + i];
+        }
+
+      // Interior
+      offset += 4 * n_int;
+      for (unsigned int i = 0; i < n_int; ++i)
+        for (unsigned int j = 0; j < n_int; ++j)
+          dofs[offset + i * n_int + j] = copy[offset + j * n_int + i];
+    }
+
+
+
+    template <int dim>
+    inline void
+    HangingNodes<dim>::transpose_subface_index(unsigned int &subface) const
+    {
+      if (subface == 1)
+        subface = 2;
+      else if (subface == 2)
+        subface = 1;
+    }
+
+
+
+    template <int dim, typename Number>
+    inline void
+    FEEvaluationImplHangingNodes<dim, Number>::run(
+      const unsigned int       n_components,
+      const ShapeInfo<Number> &shape_info,
+      const bool               transpose,
+      const unsigned int *     constraint_masks,
+      Number *                 values,
+      Number *                 scratch_data)
+    {
+      constexpr unsigned int n_lanes   = Number::n_array_elements;
+      const unsigned int     fe_degree = shape_info.fe_degree;
+      const unsigned int     dofs_per_component =
+        Utilities::fixed_power<dim>(fe_degree + 1);
+
+      Assert(shape_info.subface_interpolation_matrix.size() ==
+               (fe_degree + 1) * (fe_degree + 1),
+             ExcMessage("The hanging node constraints can only be resolved "
+                        "for elements with nodal shape functions."));
+
+      // go through the unique masks of the lanes and process all lanes that
+      // carry the same mask at once
+      bool processed[n_lanes] = {};
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          const unsigned int mask = constraint_masks[v];
+          if (mask == 0 || processed[v])
+            continue;
+
+          bool lanes[n_lanes] = {};
+          for (unsigned int w = v; w < n_lanes; ++w)
+            if (constraint_masks[w] == mask)
+              {
+                lanes[w]     = true;
+                processed[w] = true;
+              }
+
+          // the interpolation in the different directions acts on different
+          // degrees of freedom except for the ones on the coarse vertices,
+          // which are left unchanged, so the order of the directions does not
+          // matter, neither for the constraints nor for their transpose
+          for (unsigned int c = 0; c < n_components; ++c)
+            for (unsigned int direction = 0; direction < dim; ++direction)
+              interpolate(direction,
+                          fe_degree,
+                          shape_info.subface_interpolation_matrix.begin(),
+                          transpose,
+                          mask,
+                          lanes,
+                          values + c * dofs_per_component,
+                          scratch_data);
+        }
+    }
+
+
+
+    template <int dim, typename Number>
+    inline void
+    FEEvaluationImplHangingNodes<dim, Number>::interpolate(
+      const unsigned int direction,
+      const unsigned int fe_degree,
+      const Number *     weights,
+      const bool         transpose,
+      const unsigned int mask,
+      const bool *       lanes,
+      Number *           values,
+      Number *           tmp)
+    {
+      constexpr unsigned int n_lanes   = Number::n_array_elements;
+      const unsigned int     n_dofs_1d = fe_degree + 1;
+      const unsigned int     stride    = Utilities::pow(n_dofs_1d, direction);
+
+      const bool is_first_type = (mask & (constr_type_x << direction)) != 0;
+
+      // interpolate along one line of the tensor product, starting at the
+      // given offset
+      const auto interpolate_line = [&](const unsigned int offset) {
+        Number *line = values + offset;
+        for (unsigned int k = 0; k < n_dofs_1d; ++k)
+          {
+            Number sum = Number();
+            for (unsigned int i = 0; i < n_dofs_1d; ++i)
+              {
+                const unsigned int row = transpose ? i : k;
+                const unsigned int col = transpose ? k : i;
+                const Number &     w =
+                  is_first_type ?
+                    weights[row * n_dofs_1d + col] :
+                    weights[(fe_degree - row) * n_dofs_1d + fe_degree - col];
+                sum += w * line[i * stride];
+              }
+            tmp[k] = sum;
+          }
+        for (unsigned int k = 0; k < n_dofs_1d; ++k)
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            if (lanes[v])
+              line[k * stride][v] = tmp[k][v];
+      };
+
+      if (dim == 2)
+        {
+          // the lines along 'direction' are on the face with normal in the
+          // other direction
+          const unsigned int other = 1 - direction;
+          if (mask & (constr_face_x << other))
+            {
+              const unsigned int position =
+                (mask & (constr_type_x << other)) ? 0 : fe_degree;
+              interpolate_line(position * Utilities::pow(n_dofs_1d, other));
+            }
+        }
+      else if (dim == 3)
+        {
+          const unsigned int d1    = (direction + 1) % 3;
+          const unsigned int d2    = (direction + 2) % 3;
+          const unsigned int face1 = constr_face_x << d1;
+          const unsigned int face2 = constr_face_x << d2;
+          const unsigned int edge  = constr_edge_xy << d1;
+          if ((mask & (face1 | face2 | edge)) == 0)
+            return;
+
+          const unsigned int position1 =
+            (mask & (constr_type_x << d1)) ? 0 : fe_degree;
+          const unsigned int position2 =
+            (mask & (constr_type_x << d2)) ? 0 : fe_degree;
+          const unsigned int stride1 = Utilities::pow(n_dofs_1d, d1);
+          const unsigned int stride2 = Utilities::pow(n_dofs_1d, d2);
+          for (unsigned int i2 = 0; i2 < n_dofs_1d; ++i2)
+            for (unsigned int i1 = 0; i1 < n_dofs_1d; ++i1)
+              {
+                const bool on_face1 = (i1 == position1);
+                const bool on_face2 = (i2 == position2);
+                if (((mask & face1) && on_face1) ||
+                    ((mask & face2) && on_face2) ||
+                    ((mask & edge) && on_face1 && on_face2))
+                  interpolate_line(i1 * stride1 + i2 * stride2);
+              }
+        }
+      else
+        Assert(false, ExcNotImplemented());
+    }
+  } // end of namespace MatrixFreeFunctions
+} // end of namespace internal
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -25,12 +25,17 @@
 #include <deal.II/fe/fe.h>
 #include <deal.II/fe/mapping.h>
 
+#include <deal.II/grid/cell_id.h>
+
 #include <deal.II/hp/q_collection.h>
 
 #include <deal.II/matrix_free/face_info.h>
 #include <deal.II/matrix_free/helper_functions.h>
+#include <deal.II/matrix_free/shape_info.h>
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -263,6 +268,28 @@ namespace internal
        */
       AlignedVector<Point<spacedim, VectorizedArrayType>> quadrature_points;
 
+      /**
+       * In case the geometry is evaluated on the fly (see
+       * MatrixFree::AdditionalData::geometry_on_the_fly), this field stores
+       * the support points of a polynomial description of the mapping for
+       * all cells of type GeometryType::general, with all
+       * <code>geometry_shape_info.dofs_per_component_on_cell</code> entries
+       * of the first coordinate direction first, then the second direction,
+       * and so on. For these cells, the inverse Jacobians, JxW values and
+       * second derivatives are not stored in the respective fields and the
+       * entry in @p data_index_offsets points into the present array
+       * instead. Empty if all data is precomputed.
+       */
+      AlignedVector<VectorizedArrayType> mapping_support_points;
+
+      /**
+       * The 1D shape functions of the polynomial space of @p
+       * mapping_support_points evaluated in the 1D quadrature points, used
+       * by FEEvaluation to compute the Jacobians via sum factorization. Only
+       * filled if @p mapping_support_points is non-empty.
+       */
+      ShapeInfo<VectorizedArrayType> geometry_shape_info;
+
       /**
        * Returns the quadrature index for a given number of quadrature
        * points. If not in hp mode or if the index is not found, this
@@ -272,6 +299,18 @@ namespace internal
       unsigned int
       quad_index_from_n_q_points(const unsigned int n_q_points) const;
 
+      /**
+       * Copies the data from another object with a different number type,
+       * converting all entries to the present number type. The vectorization
+       * length of the two objects must coincide.
+       */
+      template <typename Number2, typename VectorizedArrayType2>
+      void
+      copy_from(const MappingInfoStorage<structdim,
+                                         spacedim,
+                                         Number2,
+                                         VectorizedArrayType2> &other);
+
       /**
        * Prints a detailed summary of memory consumption in the different
        * structures of this class to the given output stream.
@@ -290,6 +329,111 @@ namespace internal
 
 
 
+    /**
+     * Geometry data of individual cells as computed by the mapping, i.e.,
+     * the data of one lane of a cell batch before it is merged with the
+     * other lanes, stored by the CellId of the cells. This allows
+     * MappingInfo::initialize() to reuse the data of the cells that did not
+     * change since the previous call, see
+     * MatrixFree::AdditionalData::reuse_cell_geometry.
+     *
+     * For each cell and quadrature formula, the array @p data holds a record
+     * consisting of a header with the active FE index, the number of
+     * quadrature points, a bit mask of the stored fields (see the enum
+     * Content) and the geometry type detected for the cell, followed by the
+     * vertices of the cell and the stored fields.
+     *
+     * @ingroup matrixfree
+     */
+    template <int dim>
+    struct CellGeometryCache
+    {
+      /**
+       * The fields that can be stored in a record.
+       */
+      enum Content : unsigned int
+      {
+        /**
+         * The quadrature points.
+         */
+        quadrature_points = 1,
+        /**
+         * The constant Jacobian of a Cartesian or affine cell.
+         */
+        constant_jacobian = 2,
+        /**
+         * The Jacobians in all quadrature points.
+         */
+        jacobians = 4,
+        /**
+         * The gradients of the Jacobians in all quadrature points.
+         */
+        jacobian_gradients = 8
+      };
+
+      /**
+       * Size of the header of a record.
+       */
+      static const unsigned int header_size = 4;
+
+      /**
+       * Return the index of the cell with the given @p id in @p offsets, or
+       * numbers::invalid_unsigned_int if the cell is not in the cache.
+       */
+      unsigned int
+      find(const CellId &id) const;
+
+      /**
+       * Append the records of @p other to this object. The cells must be
+       * sorted by sort() afterwards.
+       */
+      void
+      append(const CellGeometryCache<dim> &other);
+
+      /**
+       * Sort the list of cells by their CellId for the lookup in find().
+       */
+      void
+      sort();
+
+      /**
+       * Clear all data fields in this class.
+       */
+      void
+      clear();
+
+      /**
+       * Return the memory consumption of this class in bytes.
+       */
+      std::size_t
+      memory_consumption() const;
+
+      /**
+       * The number of quadrature formulas.
+       */
+      unsigned int n_quads = 0;
+
+      /**
+       * The CellId of the cached cells together with the index of the cell
+       * in @p offsets.
+       */
+      std::vector<std::pair<CellId, unsigned int>> cells;
+
+      /**
+       * For each cell and quadrature formula, the start of the record in
+       * @p data, or <tt>std::numeric_limits<std::size_t>::max()</tt> if no
+       * record is stored.
+       */
+      std::vector<std::size_t> offsets;
+
+      /**
+       * The records.
+       */
+      std::vector<double> data;
+    };
+
+
+
     /**
      * The class that stores all geometry-dependent data related with cell
      * interiors for use in the matrix-free class.
@@ -307,7 +451,15 @@ namespace internal
        * CellIterator::level() and CellIterator::index(), in order to allow
        * for different kinds of iterators, e.g. standard DoFHandler,
        * multigrid, etc.)  on a fixed Triangulation. In addition, a mapping
-       * and several quadrature formulas are given.
+       * and several quadrature formulas are given. The optional argument @p
+       * geometry_on_the_fly selects the quadrature formulas for which only
+       * the mapping support points are stored on curved cells, see
+       * MatrixFree::AdditionalData::geometry_on_the_fly. If @p
+       * reuse_cell_geometry is set, the data of cells contained in
+       * @p cell_geometry_cache is copied from there instead of evaluating
+       * the mapping, and the cache is filled with the data of the given
+       * cells for the next call, see
+       * MatrixFree::AdditionalData::reuse_cell_geometry.
        */
       void
       initialize(
@@ -320,7 +472,9 @@ namespace internal
         const UpdateFlags                              update_flags_cells,
         const UpdateFlags update_flags_boundary_faces,
         const UpdateFlags update_flags_inner_faces,
-        const UpdateFlags update_flags_faces_by_cells);
+        const UpdateFlags update_flags_faces_by_cells,
+        const std::vector<bool> &geometry_on_the_fly = std::vector<bool>(),
+        const bool               reuse_cell_geometry = false);
 
       /**
        * Return the type of a given cell as detected during initialization.
@@ -329,7 +483,21 @@ namespace internal
       get_cell_type(const unsigned int cell_chunk_no) const;
 
       /**
-       * Clear all data fields in this class.
+       * Copies the data from another object with a different number type,
+       * converting all entries to the present number type. The vectorization
+       * length of the two objects must coincide. This allows to set up the
+       * geometry data in single precision without evaluating the mapping
+       * again.
+       */
+      template <typename Number2, typename VectorizedArrayType2>
+      void
+      copy_from(
+        const MappingInfo<dim, Number2, VectorizedArrayType2> &other);
+
+      /**
+       * Clear all data fields in this class, except for
+       * @p cell_geometry_cache that is kept for the next call to
+       * initialize().
        */
       void
       clear();
@@ -366,6 +534,15 @@ namespace internal
        */
       std::vector<GeometryType> face_type;
 
+      /**
+       * Stores the type of the faces of cells as accessed through
+       * face_data_by_cells, indexed by the cell batch and the face number
+       * within the cell. The type is the one of the cell, unless the cells
+       * behind the face require a more general description of their
+       * Jacobians, in which case it is set to general.
+       */
+      ::dealii::Table<2, GeometryType> faces_by_cells_type;
+
       /**
        * The data cache for the cells.
        */
@@ -385,6 +562,12 @@ namespace internal
       std::vector<MappingInfoStorage<dim - 1, dim, Number, VectorizedArrayType>>
         face_data_by_cells;
 
+      /**
+       * The geometry data of the individual cells of the last call to
+       * initialize() with the option @p reuse_cell_geometry set.
+       */
+      CellGeometryCache<dim> cell_geometry_cache;
+
       /**
        * Computes the information in the given cells, called within
        * initialize.
@@ -396,7 +579,23 @@ namespace internal
         const std::vector<unsigned int> &              active_fe_index,
         const Mapping<dim> &                           mapping,
         const std::vector<dealii::hp::QCollection<1>> &quad,
-        const UpdateFlags                              update_flags_cells);
+        const UpdateFlags                              update_flags_cells,
+        const bool reuse_cell_geometry = false);
+
+      /**
+       * For those quadrature formulas selected by @p geometry_on_the_fly,
+       * compute the support points of a polynomial representation of the
+       * mapping on all cells of type GeometryType::general and release the
+       * inverse Jacobians, JxW values, and second derivatives of those
+       * cells computed in initialize_cells(). Called within initialize.
+       */
+      void
+      initialize_geometry_on_the_fly(
+        const dealii::Triangulation<dim> &                        tria,
+        const std::vector<std::pair<unsigned int, unsigned int>> &cells,
+        const Mapping<dim> &                                      mapping,
+        const std::vector<dealii::hp::QCollection<1>> &           quad,
+        const std::vector<bool> &geometry_on_the_fly);
 
       /**
        * Computes the information in the given faces, called within
@@ -547,6 +746,81 @@ namespace internal
 
 
 
+    template <int structdim,
+              int spacedim,
+              typename Number,
+              typename VectorizedArrayType>
+    template <typename Number2, typename VectorizedArrayType2>
+    inline void
+    MappingInfoStorage<structdim, spacedim, Number, VectorizedArrayType>::
+      copy_from(const MappingInfoStorage<structdim,
+                                         spacedim,
+                                         Number2,
+                                         VectorizedArrayType2> &other)
+    {
+      static_assert(VectorizedArrayType::n_array_elements ==
+                      VectorizedArrayType2::n_array_elements,
+                    "The vectorization length of the two objects must match.");
+
+      descriptor.resize(other.descriptor.size());
+      for (unsigned int i = 0; i < descriptor.size(); ++i)
+        {
+          descriptor[i].n_q_points = other.descriptor[i].n_q_points;
+          descriptor[i].quadrature = other.descriptor[i].quadrature;
+          for (unsigned int d = 0; d < structdim; ++d)
+            convert_number_type(
+              other.descriptor[i].tensor_quadrature_weights[d],
+              descriptor[i].tensor_quadrature_weights[d]);
+          convert_number_type(other.descriptor[i].quadrature_weights,
+                              descriptor[i].quadrature_weights);
+          descriptor[i].face_orientations =
+            other.descriptor[i].face_orientations;
+        }
+
+      data_index_offsets = other.data_index_offsets;
+      convert_number_type(other.JxW_values, JxW_values);
+      convert_number_type(other.normal_vectors, normal_vectors);
+      for (unsigned int i = 0; i < 2; ++i)
+        {
+          convert_number_type(other.jacobians[i], jacobians[i]);
+          convert_number_type(other.jacobian_gradients[i],
+                              jacobian_gradients[i]);
+          convert_number_type(other.normals_times_jacobians[i],
+                              normals_times_jacobians[i]);
+        }
+      quadrature_point_offsets = other.quadrature_point_offsets;
+      convert_number_type(other.quadrature_points, quadrature_points);
+      convert_number_type(other.mapping_support_points,
+                          mapping_support_points);
+      geometry_shape_info.copy_from(other.geometry_shape_info);
+    }
+
+
+
+    template <int dim, typename Number, typename VectorizedArrayType>
+    template <typename Number2, typename VectorizedArrayType2>
+    inline void
+    MappingInfo<dim, Number, VectorizedArrayType>::copy_from(
+      const MappingInfo<dim, Number2, VectorizedArrayType2> &other)
+    {
+      cell_type = other.cell_type;
+      face_type = other.face_type;
+      faces_by_cells_type = other.faces_by_cells_type;
+
+      cell_data.resize(other.cell_data.size());
+      for (unsigned int i = 0; i < cell_data.size(); ++i)
+        cell_data[i].copy_from(other.cell_data[i]);
+      face_data.resize(other.face_data.size());
+      for (unsigned int i = 0; i < face_data.size(); ++i)
+        face_data[i].copy_from(other.face_data[i]);
+      face_data_by_cells.resize(other.face_data_by_cells.size());
+      for (unsigned int i = 0; i < face_data_by_cells.size(); ++i)
+        face_data_by_cells[i].copy_from(other.face_data_by_cells[i]);
+      cell_geometry_cache = other.cell_geometry_cache;
+    }
+
+
+
     template <int dim, typename Number, typename VectorizedArrayType>
     inline GeometryType
     MappingInfo<dim, Number, VectorizedArrayType>::get_cell_type(
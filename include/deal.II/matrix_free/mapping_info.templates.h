@@ -22,11 +22,18 @@
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/fe/fe_nothing.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_tools.h>
 #include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
 #include <deal.II/fe/mapping_q1.h>
+#include <deal.II/fe/mapping_q_cache.h>
 
 #include <deal.II/matrix_free/mapping_info.h>
 
+#include <algorithm>
+#include <limits>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -142,7 +149,9 @@ namespace internal
              MemoryConsumption::memory_consumption(normals_times_jacobians[0]) +
              MemoryConsumption::memory_consumption(normals_times_jacobians[1]) +
              MemoryConsumption::memory_consumption(quadrature_point_offsets) +
-             MemoryConsumption::memory_consumption(quadrature_points);
+             MemoryConsumption::memory_consumption(quadrature_points) +
+             MemoryConsumption::memory_consumption(mapping_support_points) +
+             geometry_shape_info.memory_consumption();
     }
 
 
@@ -192,6 +201,17 @@ namespace internal
                 normals_times_jacobians[1]));
         }
 
+      const std::size_t support_point_size =
+        Utilities::MPI::sum(mapping_support_points.size(),
+                            task_info.communicator);
+      if (support_point_size > 0)
+        {
+          out << "      Memory mapping support points: ";
+          task_info.print_memory_statistics(
+            out,
+            MemoryConsumption::memory_consumption(mapping_support_points));
+        }
+
       const std::size_t quad_size =
         Utilities::MPI::sum(quadrature_points.size(), task_info.communicator);
       if (quad_size > 0)
@@ -206,6 +226,84 @@ namespace internal
 
 
 
+    /* ------------------------ CellGeometryCache implementation ----------- */
+
+    template <int dim>
+    unsigned int
+    CellGeometryCache<dim>::find(const CellId &id) const
+    {
+      const auto entry =
+        std::lower_bound(cells.begin(),
+                         cells.end(),
+                         id,
+                         [](const std::pair<CellId, unsigned int> &a,
+                            const CellId &b) { return a.first < b; });
+      if (entry != cells.end() && entry->first == id)
+        return entry->second;
+      else
+        return numbers::invalid_unsigned_int;
+    }
+
+
+
+    template <int dim>
+    void
+    CellGeometryCache<dim>::append(const CellGeometryCache<dim> &other)
+    {
+      Assert(cells.empty() || n_quads == other.n_quads, ExcInternalError());
+      n_quads = other.n_quads;
+
+      const unsigned int cell_shift = cells.size();
+      const std::size_t  data_shift = data.size();
+      const std::size_t  invalid    = std::numeric_limits<std::size_t>::max();
+      for (const auto &cell : other.cells)
+        cells.emplace_back(cell.first, cell.second + cell_shift);
+      for (const std::size_t offset : other.offsets)
+        offsets.push_back(offset == invalid ? invalid : offset + data_shift);
+      data.insert(data.end(), other.data.begin(), other.data.end());
+    }
+
+
+
+    template <int dim>
+    void
+    CellGeometryCache<dim>::sort()
+    {
+      std::sort(cells.begin(),
+                cells.end(),
+                [](const std::pair<CellId, unsigned int> &a,
+                   const std::pair<CellId, unsigned int> &b) {
+                  return a.first < b.first;
+                });
+    }
+
+
+
+    template <int dim>
+    void
+    CellGeometryCache<dim>::clear()
+    {
+      n_quads = 0;
+      cells.clear();
+      offsets.clear();
+      data.clear();
+      data.shrink_to_fit();
+    }
+
+
+
+    template <int dim>
+    std::size_t
+    CellGeometryCache<dim>::memory_consumption() const
+    {
+      return sizeof(*this) +
+             cells.capacity() * sizeof(std::pair<CellId, unsigned int>) +
+             offsets.capacity() * sizeof(std::size_t) +
+             data.capacity() * sizeof(double);
+    }
+
+
+
     /* ------------------------ MappingInfo implementation ----------------- */
 
     template <int dim, typename Number, typename VectorizedArrayType>
@@ -217,6 +315,7 @@ namespace internal
       face_data_by_cells.clear();
       cell_type.clear();
       face_type.clear();
+      faces_by_cells_type.reinit(0, 0);
     }
 
 
@@ -279,15 +378,27 @@ namespace internal
       const std::vector<dealii::hp::QCollection<1>> &           quad,
       const UpdateFlags update_flags_cells,
       const UpdateFlags update_flags_boundary_faces,
-      const UpdateFlags update_flags_inner_faces,
-      const UpdateFlags update_flags_faces_by_cells)
+      const UpdateFlags        update_flags_inner_faces,
+      const UpdateFlags        update_flags_faces_by_cells,
+      const std::vector<bool> &geometry_on_the_fly,
+      const bool               reuse_cell_geometry)
     {
       clear();
 
       // Could call these functions in parallel, but not useful because the
       // work inside is nicely split up already
-      initialize_cells(
-        tria, cells, active_fe_index, mapping, quad, update_flags_cells);
+      initialize_cells(tria,
+                       cells,
+                       active_fe_index,
+                       mapping,
+                       quad,
+                       update_flags_cells,
+                       reuse_cell_geometry);
+      if (std::find(geometry_on_the_fly.begin(),
+                    geometry_on_the_fly.end(),
+                    true) != geometry_on_the_fly.end())
+        initialize_geometry_on_the_fly(
+          tria, cells, mapping, quad, geometry_on_the_fly);
       initialize_faces(tria,
                        cells,
                        face_info.faces,
@@ -379,8 +490,190 @@ namespace internal
           }
       }
 
+      /**
+       * Return the fields a record of CellGeometryCache holds for a cell of
+       * type @p lane_type and the quadrature formula @p my_q. If @p
+       * only_quadrature_points is set, the Jacobians are not needed because
+       * the whole batch of cells has constant Jacobians that are taken from
+       * the first quadrature formula.
+       */
+      template <int dim>
+      unsigned int
+      get_cache_content(const unsigned int my_q,
+                        const GeometryType lane_type,
+                        const bool         only_quadrature_points,
+                        const UpdateFlags  update_flags)
+      {
+        using Cache          = CellGeometryCache<dim>;
+        unsigned int content = 0;
+        if (update_flags & update_quadrature_points)
+          content |= Cache::quadrature_points;
+        if (only_quadrature_points == false)
+          {
+            if (my_q == 0 && lane_type <= affine)
+              content |= Cache::constant_jacobian;
+            else
+              {
+                content |= Cache::jacobians;
+                if (update_flags & update_jacobian_grads)
+                  content |= Cache::jacobian_gradients;
+              }
+          }
+        return content;
+      }
+
+
+
+      /**
+       * Fill the data of the lane @p lane of @p cell_data with the record of
+       * the given cell stored in @p cache for the quadrature formula @p my_q.
+       * Return @p false if the cache does not hold a record that matches the
+       * present setting or the vertices of the cell, in which case nothing is
+       * filled.
+       */
+      template <int dim, typename Number, typename VectorizedArrayType>
+      bool
+      read_from_cache(
+        const CellGeometryCache<dim> &                            cache,
+        const CellId &                                            id,
+        const typename dealii::Triangulation<dim>::cell_iterator &cell,
+        const unsigned int                                        my_q,
+        const unsigned int                                        fe_index,
+        const unsigned int                                        n_q_points,
+        const UpdateFlags                                         update_flags,
+        const bool                                   only_quadrature_points,
+        const unsigned int                           lane,
+        GeometryType &                               lane_type,
+        LocalData<dim, Number, VectorizedArrayType> &cell_data)
+      {
+        using Cache              = CellGeometryCache<dim>;
+        const unsigned int index = cache.find(id);
+        if (index == numbers::invalid_unsigned_int || my_q >= cache.n_quads)
+          return false;
+        const std::size_t offset = cache.offsets[index * cache.n_quads + my_q];
+        if (offset == std::numeric_limits<std::size_t>::max())
+          return false;
+
+        const double *record = cache.data.data() + offset;
+        if (record[0] != fe_index || record[1] != n_q_points)
+          return false;
+        const unsigned int content = static_cast<unsigned int>(record[2]);
+        const GeometryType type =
+          static_cast<GeometryType>(static_cast<unsigned int>(record[3]));
+        const unsigned int needed = get_cache_content<dim>(
+          my_q, type, only_quadrature_points, update_flags);
+        if ((content & needed) != needed)
+          return false;
+
+        const double *entry = record + Cache::header_size;
+        for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          for (unsigned int d = 0; d < dim; ++d, ++entry)
+            if (cell->vertex(v)[d] != *entry)
+              return false;
+
+        if (content & Cache::quadrature_points)
+          {
+            if (needed & Cache::quadrature_points)
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                for (unsigned int d = 0; d < dim; ++d)
+                  cell_data.quadrature_points[q][d][lane] = entry[q * dim + d];
+            entry += n_q_points * dim;
+          }
+        if (content & Cache::constant_jacobian)
+          {
+            if (needed & Cache::constant_jacobian)
+              for (unsigned int d = 0; d < dim; ++d)
+                for (unsigned int e = 0; e < dim; ++e)
+                  cell_data.const_jac[d][e][lane] = entry[d * dim + e];
+            entry += dim * dim;
+          }
+        if (content & Cache::jacobians)
+          {
+            if (needed & Cache::jacobians)
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                for (unsigned int d = 0; d < dim; ++d)
+                  for (unsigned int e = 0; e < dim; ++e)
+                    cell_data.general_jac[q][d][e][lane] =
+                      entry[(q * dim + d) * dim + e];
+            entry += n_q_points * dim * dim;
+          }
+        if (needed & Cache::jacobian_gradients)
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            for (unsigned int d = 0; d < dim; ++d)
+              for (unsigned int e = 0; e < dim; ++e)
+                for (unsigned int f = 0; f < dim; ++f)
+                  cell_data.general_jac_grad[q][d][e][f][lane] =
+                    entry[((q * dim + d) * dim + e) * dim + f];
+
+        if (my_q == 0)
+          lane_type = type;
+        return true;
+      }
+
+
+
+      /**
+       * Append a record with the data of the lane @p lane of @p cell_data
+       * for the quadrature formula @p my_q to @p cache, where @p index is
+       * the position of the cell in CellGeometryCache::offsets.
+       */
+      template <int dim, typename Number, typename VectorizedArrayType>
+      void
+      write_to_cache(
+        const typename dealii::Triangulation<dim>::cell_iterator &cell,
+        const unsigned int                                        index,
+        const unsigned int                                        my_q,
+        const unsigned int                                        fe_index,
+        const unsigned int                                        n_q_points,
+        const UpdateFlags                                         update_flags,
+        const bool         only_quadrature_points,
+        const unsigned int lane,
+        const GeometryType lane_type,
+        const LocalData<dim, Number, VectorizedArrayType> &cell_data,
+        CellGeometryCache<dim> &                           cache)
+      {
+        using Cache                = CellGeometryCache<dim>;
+        const unsigned int content = get_cache_content<dim>(
+          my_q, lane_type, only_quadrature_points, update_flags);
+
+        std::vector<double> &data                   = cache.data;
+        cache.offsets[index * cache.n_quads + my_q] = data.size();
+        data.push_back(fe_index);
+        data.push_back(n_q_points);
+        data.push_back(content);
+        data.push_back(static_cast<unsigned int>(lane_type));
+        for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          for (unsigned int d = 0; d < dim; ++d)
+            data.push_back(cell->vertex(v)[d]);
+
+        if (content & Cache::quadrature_points)
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            for (unsigned int d = 0; d < dim; ++d)
+              data.push_back(cell_data.quadrature_points[q][d][lane]);
+        if (content & Cache::constant_jacobian)
+          for (unsigned int d = 0; d < dim; ++d)
+            for (unsigned int e = 0; e < dim; ++e)
+              data.push_back(cell_data.const_jac[d][e][lane]);
+        if (content & Cache::jacobians)
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            for (unsigned int d = 0; d < dim; ++d)
+              for (unsigned int e = 0; e < dim; ++e)
+                data.push_back(cell_data.general_jac[q][d][e][lane]);
+        if (content & Cache::jacobian_gradients)
+          for (unsigned int q = 0; q < n_q_points; ++q)
+            for (unsigned int d = 0; d < dim; ++d)
+              for (unsigned int e = 0; e < dim; ++e)
+                for (unsigned int f = 0; f < dim; ++f)
+                  data.push_back(cell_data.general_jac_grad[q][d][e][f][lane]);
+      }
+
+
+
       /**
        * Helper function called internally during the initialize function.
+       * If @p cache is given, the data of the cells found in the cache is
+       * copied from there instead of evaluating the mapping, using the
+       * CellId of the cells given in @p cell_ids.
        */
       template <int dim, typename Number, typename VectorizedArrayType>
       void
@@ -391,7 +684,10 @@ namespace internal
         GeometryType &                               cell_t_prev,
         GeometryType (&cell_t)[VectorizedArrayType::n_array_elements],
         dealii::FEValues<dim, dim> &                 fe_val,
-        LocalData<dim, Number, VectorizedArrayType> &cell_data)
+        LocalData<dim, Number, VectorizedArrayType> &cell_data,
+        const unsigned int                           fe_index = 0,
+        const CellGeometryCache<dim> *               cache    = nullptr,
+        const CellId *                               cell_ids = nullptr)
       {
         const unsigned int n_q_points   = fe_val.n_quadrature_points;
         const UpdateFlags  update_flags = fe_val.get_update_flags();
@@ -406,9 +702,24 @@ namespace internal
           {
             typename dealii::Triangulation<dim>::cell_iterator cell_it(
               &tria, cells[j].first, cells[j].second);
-            fe_val.reinit(cell_it);
             cell_t[j] = general;
 
+            if (cache != nullptr &&
+                read_from_cache(*cache,
+                                cell_ids[j],
+                                cell_it,
+                                my_q,
+                                fe_index,
+                                n_q_points,
+                                update_flags,
+                                my_q > 0 && cell_t_prev <= affine,
+                                j,
+                                cell_t[j],
+                                cell_data))
+              continue;
+
+            fe_val.reinit(cell_it);
+
             // extract quadrature points and store them temporarily. if we have
             // Cartesian cells, we can compress the indices
             if (update_flags & update_quadrature_points)
@@ -426,9 +737,11 @@ namespace internal
               continue;
 
             // first round: if the transformation is detected to be the same as
-            // on the old cell, we only need to copy over the data.
+            // on the old cell, we only need to copy over the data. This is
+            // not possible when the previous lanes might have been read from
+            // the cache rather than from fe_val.
             if (fe_val.get_cell_similarity() == CellSimilarity::translation &&
-                my_q == 0)
+                my_q == 0 && cache == nullptr)
               {
                 if (j == 0)
                   cell_t[j] = cell_t_prev;
@@ -585,7 +898,9 @@ namespace internal
         MappingInfo<dim, Number, VectorizedArrayType> &mapping_info,
         std::pair<std::vector<
                     MappingInfoStorage<dim, dim, Number, VectorizedArrayType>>,
-                  CompressedCellData<dim, Number, VectorizedArrayType>> &data)
+                  CompressedCellData<dim, Number, VectorizedArrayType>> &data,
+        const CellGeometryCache<dim> *old_cache,
+        CellGeometryCache<dim> *      new_cache)
       {
         FE_Nothing<dim> dummy_fe;
 
@@ -655,6 +970,12 @@ namespace internal
               }
           }
 
+        // the CellId of the cells in the current batch and their index in
+        // the new cache, if the geometry of the cells is cached
+        std::array<CellId, VectorizedArrayType::n_array_elements> cell_ids;
+        std::array<unsigned int, VectorizedArrayType::n_array_elements>
+          cache_index;
+
         const unsigned int end_cell = std::min(mapping_info.cell_type.size(),
                                                std::size_t(cell_range.second));
         // loop over given cells
@@ -662,6 +983,34 @@ namespace internal
           for (unsigned int my_q = 0; my_q < mapping_info.cell_data.size();
                ++my_q)
             {
+              const std::pair<unsigned int, unsigned int> *batch_cells =
+                &cells[cell * VectorizedArrayType::n_array_elements];
+              if (my_q == 0 && (old_cache != nullptr || new_cache != nullptr))
+                for (unsigned int j = 0;
+                     j < VectorizedArrayType::n_array_elements;
+                     ++j)
+                  {
+                    cell_ids[j] =
+                      typename dealii::Triangulation<dim>::cell_iterator(
+                        &tria, batch_cells[j].first, batch_cells[j].second)
+                        ->id();
+
+                    // the unused lanes of the last batch repeat the last
+                    // cell, which needs to be stored only once
+                    if (new_cache == nullptr ||
+                        (j > 0 && batch_cells[j] == batch_cells[j - 1]))
+                      cache_index[j] = numbers::invalid_unsigned_int;
+                    else
+                      {
+                        cache_index[j] = new_cache->cells.size();
+                        new_cache->cells.emplace_back(cell_ids[j],
+                                                      cache_index[j]);
+                        new_cache->offsets.resize(
+                          new_cache->offsets.size() + new_cache->n_quads,
+                          std::numeric_limits<std::size_t>::max());
+                      }
+                  }
+
               // GENERAL OUTLINE: First generate the data in format "number"
               // for vectorization_width cells, and then find the most
               // general type of cell for appropriate vectorized formats. then
@@ -688,14 +1037,41 @@ namespace internal
                        active_fe_index[cell] != active_fe_index[cell - 1])
                 cell_t_prev = general;
 
+              // for later quadrature formulas on cells with constant
+              // Jacobians, only the quadrature points are evaluated
+              const bool only_quadrature_points =
+                my_q > 0 && cell_t_prev <= affine;
+
               evaluate_on_cell<dim, Number, VectorizedArrayType>(
                 tria,
-                &cells[cell * VectorizedArrayType::n_array_elements],
+                batch_cells,
                 my_q,
                 cell_t_prev,
                 cell_t,
                 fe_val,
-                cell_data);
+                cell_data,
+                fe_index,
+                old_cache,
+                cell_ids.data());
+
+              if (new_cache != nullptr)
+                for (unsigned int j = 0;
+                     j < VectorizedArrayType::n_array_elements;
+                     ++j)
+                  if (cache_index[j] != numbers::invalid_unsigned_int)
+                    write_to_cache(
+                      typename dealii::Triangulation<dim>::cell_iterator(
+                        &tria, batch_cells[j].first, batch_cells[j].second),
+                      cache_index[j],
+                      my_q,
+                      fe_index,
+                      n_q_points,
+                      update_flags_feval,
+                      only_quadrature_points,
+                      j,
+                      cell_t[j],
+                      cell_data,
+                      *new_cache);
 
               // now reorder the data into vectorized types. if we are here
               // for the first time, we need to find out whether the Jacobian
@@ -1020,7 +1396,8 @@ namespace internal
       const std::vector<unsigned int> &                         active_fe_index,
       const Mapping<dim> &                                      mapping,
       const std::vector<dealii::hp::QCollection<1>> &           quad,
-      const UpdateFlags update_flags_input)
+      const UpdateFlags update_flags_input,
+      const bool        reuse_cell_geometry)
     {
       const unsigned int n_quads = quad.size();
       const unsigned int n_cells = cells.size();
@@ -1046,6 +1423,13 @@ namespace internal
                                                      update_default);
         }
 
+      // take the cache of the previous call, if any, and let every chunk of
+      // cells below fill its own part of the new cache
+      CellGeometryCache<dim> old_cache;
+      if (reuse_cell_geometry)
+        std::swap(old_cache, cell_geometry_cache);
+      cell_geometry_cache.clear();
+
       if (n_macro_cells == 0)
         return;
 
@@ -1063,6 +1447,12 @@ namespace internal
       // Reserve enough space to avoid re-allocation (which would break the
       // references to the data fields passed to the tasks!)
       data_cells_local.reserve(MultithreadInfo::n_threads());
+      std::vector<CellGeometryCache<dim>> new_cache(
+        reuse_cell_geometry ?
+          (n_macro_cells + work_per_chunk - 1) / work_per_chunk :
+          0);
+      for (auto &cache : new_cache)
+        cache.n_quads = n_quads;
 
       {
         Threads::TaskGroup<>                  tasks;
@@ -1087,13 +1477,25 @@ namespace internal
               quad,
               update_flags,
               *this,
-              data_cells_local.back());
+              data_cells_local.back(),
+              old_cache.cells.empty() ? nullptr : &old_cache,
+              reuse_cell_geometry ?
+                &new_cache[data_cells_local.size() - 1] :
+                nullptr);
             cell_range.first = cell_range.second;
             cell_range.second += work_per_chunk;
           }
         tasks.join_all();
       }
 
+      if (reuse_cell_geometry)
+        {
+          old_cache.clear();
+          for (const auto &cache : new_cache)
+            cell_geometry_cache.append(cache);
+          cell_geometry_cache.sort();
+        }
+
       // Fill in each thread's constant Jacobians into the data of the zeroth
       // chunk in serial
       std::vector<std::vector<unsigned int>> indices_compressed(
@@ -1191,6 +1593,134 @@ namespace internal
 
 
 
+    template <int dim, typename Number, typename VectorizedArrayType>
+    void
+    MappingInfo<dim, Number, VectorizedArrayType>::
+      initialize_geometry_on_the_fly(
+        const dealii::Triangulation<dim> &                        tria,
+        const std::vector<std::pair<unsigned int, unsigned int>> &cells,
+        const Mapping<dim> &                                      mapping,
+        const std::vector<dealii::hp::QCollection<1>> &           quad,
+        const std::vector<bool> &geometry_on_the_fly)
+    {
+      AssertIndexRange(geometry_on_the_fly.size(), cell_data.size() + 1);
+
+      // The geometry is represented by a tensor product polynomial of the
+      // degree of the mapping, interpolated in the Gauss-Lobatto points. For
+      // MappingQGeneric, this reproduces the mapping exactly.
+      unsigned int mapping_degree = 1;
+      if (const MappingQGeneric<dim> *mapping_q =
+            dynamic_cast<const MappingQGeneric<dim> *>(&mapping))
+        mapping_degree = mapping_q->get_degree();
+      else if (const MappingQ<dim> *mapping_q =
+                 dynamic_cast<const MappingQ<dim> *>(&mapping))
+        mapping_degree = mapping_q->get_degree();
+      else
+        AssertThrow(false,
+                    ExcMessage("Evaluating the geometry on the fly is only "
+                               "supported for MappingQGeneric and MappingQ."));
+
+      const QGaussLobatto<1> support_points_1d(mapping_degree + 1);
+      const FE_Q<dim>        fe_geometry(support_points_1d);
+      FEValues<dim>          fe_values(mapping,
+                              fe_geometry,
+                              Quadrature<dim>(support_points_1d),
+                              update_quadrature_points);
+      const unsigned int     n_support_points = fe_values.n_quadrature_points;
+      const unsigned int n_lanes = VectorizedArrayType::n_array_elements;
+
+      // If the mapping caches its support points, which are also located in
+      // the Gauss-Lobatto points, read them directly from the cache instead
+      // of evaluating the mapping with FEValues. The cache stores them in
+      // the hierarchical numbering of FE_Q, so we need to translate the
+      // lexicographic numbering used here.
+      const MappingQCache<dim> *mapping_q_cache =
+        dynamic_cast<const MappingQCache<dim> *>(&mapping);
+      const std::vector<unsigned int> lexicographic_to_hierarchic =
+        mapping_q_cache != nullptr ?
+          FETools::lexicographic_to_hierarchic_numbering<dim>(fe_geometry) :
+          std::vector<unsigned int>();
+
+      for (unsigned int my_q = 0; my_q < geometry_on_the_fly.size(); ++my_q)
+        if (geometry_on_the_fly[my_q] == true)
+          {
+            MappingInfoStorage<dim, dim, Number, VectorizedArrayType> &data =
+              cell_data[my_q];
+            AssertThrow(data.descriptor.size() == 1,
+                        ExcMessage("Evaluating the geometry on the fly is not "
+                                   "implemented for the hp case."));
+            data.geometry_shape_info.reinit(quad[my_q][0], fe_geometry);
+
+            // The data of cells with constant Jacobians is placed before the
+            // data of general cells, so the first offset of a general cell
+            // tells us how much data to keep
+            std::size_t n_constant_entries = data.JxW_values.size();
+            unsigned int n_general_cells   = 0;
+            for (unsigned int cell = 0; cell < cell_type.size(); ++cell)
+              if (cell_type[cell] == general)
+                {
+                  n_constant_entries =
+                    std::min<std::size_t>(n_constant_entries,
+                                          data.data_index_offsets[cell]);
+                  ++n_general_cells;
+                }
+
+            data.mapping_support_points.resize_fast(n_general_cells * dim *
+                                                    n_support_points);
+            for (unsigned int cell = 0, count = 0; cell < cell_type.size();
+                 ++cell)
+              if (cell_type[cell] == general)
+                {
+                  const unsigned int offset = count * dim * n_support_points;
+                  data.data_index_offsets[cell] = offset;
+                  for (unsigned int v = 0; v < n_lanes; ++v)
+                    {
+                      typename dealii::Triangulation<dim>::cell_iterator
+                        cell_it(&tria,
+                                cells[cell * n_lanes + v].first,
+                                cells[cell * n_lanes + v].second);
+                      if (mapping_q_cache != nullptr)
+                        {
+                          const std::vector<Point<dim>> &points =
+                            mapping_q_cache->get_mapping_support_points(
+                              cell_it);
+                          AssertDimension(points.size(), n_support_points);
+                          for (unsigned int i = 0; i < n_support_points; ++i)
+                            for (unsigned int d = 0; d < dim; ++d)
+                              data.mapping_support_points
+                                [offset + d * n_support_points + i][v] =
+                                points[lexicographic_to_hierarchic[i]][d];
+                        }
+                      else
+                        {
+                          fe_values.reinit(cell_it);
+                          for (unsigned int i = 0; i < n_support_points; ++i)
+                            for (unsigned int d = 0; d < dim; ++d)
+                              data.mapping_support_points
+                                [offset + d * n_support_points + i][v] =
+                                fe_values.quadrature_point(i)[d];
+                        }
+                    }
+                  ++count;
+                }
+
+            // release the memory of the precomputed data on general cells
+            AlignedVector<VectorizedArrayType> JxW_values(n_constant_entries);
+            AlignedVector<Tensor<2, dim, VectorizedArrayType>> jacobians(
+              n_constant_entries);
+            for (std::size_t i = 0; i < n_constant_entries; ++i)
+              {
+                JxW_values[i] = data.JxW_values[i];
+                jacobians[i]  = data.jacobians[0][i];
+              }
+            data.JxW_values.swap(JxW_values);
+            data.jacobians[0].swap(jacobians);
+            data.jacobian_gradients[0].clear();
+          }
+    }
+
+
+
     /* ------------------------- initialization of faces ------------------- */
 
     // Namespace with implementation of extraction of values on face
@@ -1934,7 +2464,116 @@ namespace internal
           for (unsigned int q = 0; q < n_hp_quads; ++q)
             face_data_by_cells[my_q].descriptor[q].initialize(quad[my_q][q],
                                                               update_default);
+        }
+
+      FE_Nothing<dim> dummy_fe;
+      // currently no hp-indices implemented
+      const unsigned int fe_index = 0;
+      std::vector<std::vector<std::shared_ptr<dealii::FEFaceValues<dim>>>>
+        fe_face_values(face_data_by_cells.size());
+      std::vector<std::vector<std::shared_ptr<dealii::FEFaceValues<dim>>>>
+        fe_face_values_neighbor(face_data_by_cells.size());
+      for (unsigned int i = 0; i < fe_face_values.size(); ++i)
+        {
+          fe_face_values[i].resize(face_data_by_cells[i].descriptor.size());
+          fe_face_values_neighbor[i].resize(
+            face_data_by_cells[i].descriptor.size());
+        }
+      const auto get_fe_face_values_neighbor =
+        [&](const unsigned int my_q) -> dealii::FEFaceValues<dim> & {
+        if (fe_face_values_neighbor[my_q][fe_index].get() == nullptr)
+          fe_face_values_neighbor[my_q][fe_index].reset(
+            new dealii::FEFaceValues<dim>(
+              mapping,
+              dummy_fe,
+              face_data_by_cells[my_q].descriptor[fe_index].quadrature,
+              update_jacobians));
+        return *fe_face_values_neighbor[my_q][fe_index];
+      };
+
+      // The Jacobians of the neighbor are only available for neighbors on
+      // the same level, as the cell-based face access does not support
+      // hanging nodes. For faces at the boundary or with a neighbor on a
+      // different level, the data of the cell itself is used.
+      using CellNeighbor =
+        std::pair<typename dealii::Triangulation<dim>::cell_iterator,
+                  unsigned int>;
+      const auto get_neighbor =
+        [](const typename dealii::Triangulation<dim>::cell_iterator &cell_it,
+           const unsigned int face) -> CellNeighbor {
+        if (cell_it->at_boundary(face) &&
+            cell_it->has_periodic_neighbor(face) == false)
+          return CellNeighbor(cell_it, face);
+        const typename dealii::Triangulation<dim>::cell_iterator neighbor =
+          cell_it->neighbor_or_periodic_neighbor(face);
+        if (neighbor->level() != cell_it->level())
+          return CellNeighbor(cell_it, face);
+        return CellNeighbor(neighbor,
+                            cell_it->at_boundary(face) ?
+                              cell_it->periodic_neighbor_face_no(face) :
+                              cell_it->neighbor_face_no(face));
+      };
+
+      // Faces of cells with constant Jacobians inherit the type of the cell
+      // unless the Jacobians of one of the neighbors vary along the face or
+      // are not aligned with the coordinate directions of a Cartesian cell
+      faces_by_cells_type.reinit(
+        TableIndices<2>(cell_type.size(), GeometryInfo<dim>::faces_per_cell));
+      for (unsigned int cell = 0; cell < cell_type.size(); ++cell)
+        for (unsigned int face = 0; face < GeometryInfo<dim>::faces_per_cell;
+             ++face)
+          {
+            faces_by_cells_type(cell, face) = cell_type[cell];
+            if (cell_type[cell] > affine)
+              continue;
+            for (unsigned int my_q = 0; my_q < n_quads; ++my_q)
+              {
+                dealii::FEFaceValues<dim> &fe_val =
+                  get_fe_face_values_neighbor(my_q);
+                for (unsigned int v = 0; v < vectorization_width; ++v)
+                  {
+                    const CellNeighbor neighbor = get_neighbor(
+                      typename dealii::Triangulation<dim>::cell_iterator(
+                        &tria,
+                        cells[cell * vectorization_width + v].first,
+                        cells[cell * vectorization_width + v].second),
+                      face);
+                    fe_val.reinit(neighbor.first, neighbor.second);
+                    const DerivativeForm<1, dim, dim> jacobian_0 =
+                      fe_val.jacobian(0).covariant_form();
+                    const double compare_norm_jac = jacobian_0.norm();
+                    bool neighbor_is_cartesian =
+                      neighbor.second / 2 == face / 2;
+                    for (unsigned int q = 0; q < fe_val.n_quadrature_points;
+                         ++q)
+                      {
+                        const DerivativeForm<1, dim, dim> inv_jac =
+                          fe_val.jacobian(q).covariant_form();
+                        for (unsigned int d = 0; d < dim; ++d)
+                          for (unsigned int e = 0; e < dim; ++e)
+                            {
+                              if (std::abs(inv_jac[d][e] - jacobian_0[d][e]) >
+                                  2048. *
+                                    std::numeric_limits<double>::epsilon() *
+                                    compare_norm_jac)
+                                faces_by_cells_type(cell, face) = general;
+                              if (e != d &&
+                                  std::abs(inv_jac[d][e]) >
+                                    2048. *
+                                      std::numeric_limits<double>::epsilon() *
+                                      compare_norm_jac)
+                                neighbor_is_cartesian = false;
+                            }
+                      }
+                    if (faces_by_cells_type(cell, face) == cartesian &&
+                        neighbor_is_cartesian == false)
+                      faces_by_cells_type(cell, face) = affine;
+                  }
+              }
+          }
 
+      for (unsigned int my_q = 0; my_q < n_quads; ++my_q)
+        {
           // since we already know the cell type, we can pre-allocate the right
           // amount of data straight away and we just need to do some basic
           // counting
@@ -1950,7 +2589,7 @@ namespace internal
                  face < GeometryInfo<dim>::faces_per_cell;
                  ++face)
               {
-                if (cell_type[i] <= affine)
+                if (faces_by_cells_type(i, face) <= affine)
                   {
                     face_data_by_cells[my_q].data_index_offsets
                       [i * GeometryInfo<dim>::faces_per_cell + face] =
@@ -1973,15 +2612,17 @@ namespace internal
               }
           face_data_by_cells[my_q].JxW_values.resize_fast(
             storage_length * GeometryInfo<dim>::faces_per_cell);
-          face_data_by_cells[my_q].jacobians[0].resize_fast(
-            storage_length * GeometryInfo<dim>::faces_per_cell);
+          for (unsigned int i = 0; i < 2; ++i)
+            face_data_by_cells[my_q].jacobians[i].resize_fast(
+              storage_length * GeometryInfo<dim>::faces_per_cell);
           if (update_flags & update_normal_vectors)
             face_data_by_cells[my_q].normal_vectors.resize_fast(
               storage_length * GeometryInfo<dim>::faces_per_cell);
           if (update_flags & update_normal_vectors &&
               update_flags & update_jacobians)
-            face_data_by_cells[my_q].normals_times_jacobians[0].resize_fast(
-              storage_length * GeometryInfo<dim>::faces_per_cell);
+            for (unsigned int i = 0; i < 2; ++i)
+              face_data_by_cells[my_q].normals_times_jacobians[i].resize_fast(
+                storage_length * GeometryInfo<dim>::faces_per_cell);
           if (update_flags & update_jacobian_grads)
             face_data_by_cells[my_q].jacobian_gradients[0].resize_fast(
               storage_length * GeometryInfo<dim>::faces_per_cell);
@@ -1992,13 +2633,6 @@ namespace internal
               face_data_by_cells[my_q].descriptor[0].n_q_points);
         }
 
-      FE_Nothing<dim> dummy_fe;
-      // currently no hp-indices implemented
-      const unsigned int fe_index = 0;
-      std::vector<std::vector<std::shared_ptr<dealii::FEFaceValues<dim>>>>
-        fe_face_values(face_data_by_cells.size());
-      for (unsigned int i = 0; i < fe_face_values.size(); ++i)
-        fe_face_values[i].resize(face_data_by_cells[i].descriptor.size());
       for (unsigned int cell = 0; cell < cell_type.size(); ++cell)
         for (unsigned int my_q = 0; my_q < face_data_by_cells.size(); ++my_q)
           for (unsigned int face = 0; face < GeometryInfo<dim>::faces_per_cell;
@@ -2013,10 +2647,16 @@ namespace internal
                     update_flags));
               dealii::FEFaceValues<dim> &fe_val =
                 *fe_face_values[my_q][fe_index];
+              dealii::FEFaceValues<dim> &fe_val_neighbor =
+                get_fe_face_values_neighbor(my_q);
               const unsigned int offset =
                 face_data_by_cells[my_q]
                   .data_index_offsets[cell * GeometryInfo<dim>::faces_per_cell +
                                       face];
+              const unsigned int n_q_points_work =
+                faces_by_cells_type(cell, face) <= affine ?
+                  1 :
+                  fe_val.n_quadrature_points;
 
               for (unsigned int v = 0; v < vectorization_width; ++v)
                 {
@@ -2025,29 +2665,17 @@ namespace internal
                     cells[cell * vectorization_width + v].first,
                     cells[cell * vectorization_width + v].second);
                   fe_val.reinit(cell_it, face);
+                  const CellNeighbor neighbor = get_neighbor(cell_it, face);
+                  fe_val_neighbor.reinit(neighbor.first, neighbor.second);
 
                   // copy data for affine data type
-                  if (cell_type[cell] <= affine)
+                  if (faces_by_cells_type(cell, face) <= affine)
                     {
                       if (update_flags & update_JxW_values)
                         face_data_by_cells[my_q].JxW_values[offset][v] =
                           fe_val.JxW(0) / face_data_by_cells[my_q]
                                             .descriptor[fe_index]
                                             .quadrature.weight(0);
-                      if (update_flags & update_jacobians)
-                        {
-                          DerivativeForm<1, dim, dim> inv_jac =
-                            fe_val.jacobian(0).covariant_form();
-                          for (unsigned int d = 0; d < dim; ++d)
-                            for (unsigned int e = 0; e < dim; ++e)
-                              {
-                                const unsigned int ee = ExtractFaceHelper::
-                                  reorder_face_derivative_indices<dim>(face, e);
-                                face_data_by_cells[my_q]
-                                  .jacobians[0][offset][d][e][v] =
-                                  inv_jac[d][ee];
-                              }
-                        }
                       if (update_flags & update_jacobian_grads)
                         {
                           Assert(false, ExcNotImplemented());
@@ -2066,23 +2694,6 @@ namespace internal
                              ++q)
                           face_data_by_cells[my_q].JxW_values[offset + q][v] =
                             fe_val.JxW(q);
-                      if (update_flags & update_jacobians)
-                        for (unsigned int q = 0; q < fe_val.n_quadrature_points;
-                             ++q)
-                          {
-                            DerivativeForm<1, dim, dim> inv_jac =
-                              fe_val.jacobian(q).covariant_form();
-                            for (unsigned int d = 0; d < dim; ++d)
-                              for (unsigned int e = 0; e < dim; ++e)
-                                {
-                                  const unsigned int ee = ExtractFaceHelper::
-                                    reorder_face_derivative_indices<dim>(face,
-                                                                         e);
-                                  face_data_by_cells[my_q]
-                                    .jacobians[0][offset + q][d][e][v] =
-                                    inv_jac[d][ee];
-                                }
-                          }
                       if (update_flags & update_jacobian_grads)
                         {
                           Assert(false, ExcNotImplemented());
@@ -2095,6 +2706,31 @@ namespace internal
                               .normal_vectors[offset + q][d][v] =
                               fe_val.normal_vector(q)[d];
                     }
+                  // the Jacobians of both the cell and its neighbor
+                  if (update_flags & update_jacobians)
+                    for (unsigned int q = 0; q < n_q_points_work; ++q)
+                      {
+                        const DerivativeForm<1, dim, dim> inv_jac =
+                          fe_val.jacobian(q).covariant_form();
+                        const DerivativeForm<1, dim, dim> inv_jac_neighbor =
+                          fe_val_neighbor.jacobian(q).covariant_form();
+                        for (unsigned int d = 0; d < dim; ++d)
+                          for (unsigned int e = 0; e < dim; ++e)
+                            {
+                              const unsigned int ee = ExtractFaceHelper::
+                                reorder_face_derivative_indices<dim>(face, e);
+                              face_data_by_cells[my_q]
+                                .jacobians[0][offset + q][d][e][v] =
+                                inv_jac[d][ee];
+                              const unsigned int ee_neighbor =
+                                ExtractFaceHelper::
+                                  reorder_face_derivative_indices<dim>(
+                                    neighbor.second, e);
+                              face_data_by_cells[my_q]
+                                .jacobians[1][offset + q][d][e][v] =
+                                inv_jac_neighbor[d][ee_neighbor];
+                            }
+                      }
                   if (update_flags & update_quadrature_points)
                     for (unsigned int q = 0; q < fe_val.n_quadrature_points;
                          ++q)
@@ -2106,14 +2742,12 @@ namespace internal
                 }
               if (update_flags & update_normal_vectors &&
                   update_flags & update_jacobians)
-                for (unsigned int q = 0; q < (cell_type[cell] <= affine ?
-                                                1 :
-                                                fe_val.n_quadrature_points);
-                     ++q)
-                  face_data_by_cells[my_q]
-                    .normals_times_jacobians[0][offset + q] =
-                    face_data_by_cells[my_q].normal_vectors[offset + q] *
-                    face_data_by_cells[my_q].jacobians[0][offset + q];
+                for (unsigned int q = 0; q < n_q_points_work; ++q)
+                  for (unsigned int i = 0; i < 2; ++i)
+                    face_data_by_cells[my_q]
+                      .normals_times_jacobians[i][offset + q] =
+                      face_data_by_cells[my_q].normal_vectors[offset + q] *
+                      face_data_by_cells[my_q].jacobians[i][offset + q];
             }
     }
 
@@ -2127,6 +2761,8 @@ namespace internal
       memory += MemoryConsumption::memory_consumption(face_data);
       memory += cell_type.capacity() * sizeof(GeometryType);
       memory += face_type.capacity() * sizeof(GeometryType);
+      memory += faces_by_cells_type.n_elements() * sizeof(GeometryType);
+      memory += cell_geometry_cache.memory_consumption();
       memory += sizeof(*this);
       return memory;
     }
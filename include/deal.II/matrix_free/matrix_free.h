@@ -46,6 +46,7 @@
 #include <deal.II/matrix_free/task_info.h>
 #include <deal.II/matrix_free/type_traits.h>
 
+#include <array>
 #include <cstdlib>
 #include <limits>
 #include <list>
@@ -224,7 +225,10 @@ public:
       const bool         initialize_mapping  = true,
       const bool         overlap_communication_computation    = true,
       const bool         hold_all_faces_to_owned_cells        = false,
-      const bool         cell_vectorization_categories_strict = false)
+      const bool         cell_vectorization_categories_strict = false,
+      const bool         use_fast_hanging_node_algorithm      = false,
+      const bool         overlap_communication_by_process     = false,
+      const bool         reuse_cell_geometry                  = false)
       : tasks_parallel_scheme(tasks_parallel_scheme)
       , tasks_block_size(tasks_block_size)
       , mapping_update_flags(mapping_update_flags)
@@ -239,6 +243,9 @@ public:
       , hold_all_faces_to_owned_cells(hold_all_faces_to_owned_cells)
       , cell_vectorization_categories_strict(
           cell_vectorization_categories_strict)
+      , use_fast_hanging_node_algorithm(use_fast_hanging_node_algorithm)
+      , overlap_communication_by_process(overlap_communication_by_process)
+      , reuse_cell_geometry(reuse_cell_geometry)
     {}
 
     /**
@@ -267,7 +274,12 @@ public:
      * where only one partition is present. Note that for problems with
      * hanging nodes, there are quite many colors (50 or more in 3D), which
      * might degrade parallel performance (bad cache behavior, many
-     * synchronization points).
+     * synchronization points). To mitigate the latter, the chunks are not
+     * scheduled color by color when only one partition is present. Instead,
+     * a chunk is started as soon as all neighboring chunks of lower colors
+     * are done, which removes the barrier between colors and lets idle
+     * threads pick up work of the next color. This does not apply to loops
+     * with face integrals.
      *
      * @note Threading support is currently experimental for the case inner
      * face integrals are performed and it is recommended to use MPI
@@ -462,6 +474,102 @@ public:
      * them in a single vectorized array.
      */
     bool cell_vectorization_categories_strict;
+
+    /**
+     * This field allows to select, for each quadrature formula passed to
+     * reinit(), whether the Jacobian transformations on curved cells are
+     * cached (the default, also chosen if this vector is empty or shorter
+     * than the number of quadrature formulas) or recomputed on the fly in
+     * FEEvaluation::reinit() (entry set to @p true). In the latter case,
+     * only the support points of a polynomial description of the geometry
+     * are stored for cells of type GeometryType::general, and FEEvaluation
+     * computes the inverse Jacobians and JxW values by sum factorization
+     * from these points. Since the support points take considerably less
+     * memory than the Jacobians in all quadrature points, this trades
+     * arithmetic operations for memory transfer, which can be worthwhile on
+     * hardware with a high ratio of arithmetic throughput to memory
+     * bandwidth. Cartesian and affine cells are not affected as their data
+     * is compressed anyway.
+     *
+     * @note This option is only supported for MappingQGeneric and MappingQ,
+     * not in the hp case, and not for the evaluation of Hessians on general
+     * cells.
+     */
+    std::vector<bool> geometry_on_the_fly;
+
+    /**
+     * If set to @p true, the hanging node constraints of continuous FE_Q
+     * elements are not resolved through the generic constraint pool but
+     * applied on the fly in FEEvaluation::read_dof_values() and
+     * FEEvaluation::distribute_local_to_global() by interpolating from the
+     * degrees of freedom of the coarser neighbor with sum factorization. The
+     * cells carry a compact mask describing the constrained faces and
+     * edges, and the interpolation is applied with vectorized operations on
+     * all lanes of a cell batch sharing the same mask. This avoids the
+     * indirect addressing of the constraint entries on the refinement
+     * interfaces and keeps the index compression of the remaining cells.
+     * The other constraints (e.g. Dirichlet conditions) in the
+     * AffineConstraints object are treated as usual.
+     *
+     * @note This option is only supported for scalar FE_Q elements in 2D and
+     * 3D on the active cells of a DoFHandler (not in the hp case or on
+     * multigrid levels), and only for cell integrals. The default is @p
+     * false.
+     */
+    bool use_fast_hanging_node_algorithm;
+
+    /**
+     * Option to refine the overlap of communication and computation enabled
+     * by @p overlap_communication_computation. By default, the loops wait
+     * for the ghost data of all processes before working on any cell or
+     * face at the processor boundary. If this option is set, the ranges of
+     * cells and faces at the processor boundary are instead processed as
+     * soon as the data of the processes they read from has arrived, which
+     * is detected with MPI_Waitany() on the individual messages. This hides
+     * more of the latency in case the messages of some neighbors arrive
+     * late, e.g. on irregular partitions.
+     *
+     * Since the order of the ranges, and thus the order of the summation
+     * into the destination vector, depends on the arrival of the messages,
+     * the results may differ in the last digits between runs.
+     *
+     * @note This option only affects loops without threads (see @p
+     * tasks_parallel_scheme) whose source vector is a single
+     * LinearAlgebra::distributed::Vector that receives its ghost data in
+     * place. This is the case for continuous elements and for face
+     * integrals with DataAccessOnFaces::gradients or
+     * DataAccessOnFaces::unspecified, but not when only a subset of the
+     * ghost entries is exchanged, e.g. with DataAccessOnFaces::values for
+     * nodal elements, and not for exchanges through shared memory. Loops in
+     * the other situations wait for all data as usual. The default is @p
+     * false.
+     */
+    bool overlap_communication_by_process;
+
+    /**
+     * If set to @p true, the geometry data of the individual cells computed
+     * by the mapping is kept in a cache indexed by the CellId of the cells.
+     * When reinit() is called again with this option, e.g. after adaptive
+     * refinement, the data of the cells found in the cache is copied from
+     * there instead of evaluating the mapping, which is the most expensive
+     * part of the setup for higher order or curved mappings. Only the new
+     * cells, typically a small fraction after a local refinement, are
+     * evaluated. Cells whose vertices moved are detected and recomputed,
+     * too. The index data and the data on faces are always computed from
+     * scratch, since they depend on the global numbering of the unknowns
+     * and on the neighbors of a cell, respectively.
+     *
+     * The cache takes about as much memory as the uncompressed geometry
+     * data of all cells, i.e., considerably more than the geometry data
+     * itself on Cartesian or affine meshes. It is kept until the next call
+     * to reinit() and released if this option is not set in that call.
+     *
+     * @note The mapping, the quadrature formulas, and the triangulation must
+     * be the same as in the previous call, and the mapping must not depend
+     * on data beyond the vertices of the cells (e.g. a MappingQEulerian
+     * whose displacement changed), since this is not detected.
+     */
+    bool reuse_cell_geometry;
   };
 
   /**
@@ -621,6 +729,24 @@ public:
   copy_from(
     const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free_base);
 
+  /**
+   * Copy function that initializes the present object from a MatrixFree
+   * object with a different number type, converting the geometry data and
+   * the shape information to the number type of the present object. The
+   * index data (DoFInfo, TaskInfo, FaceInfo) is copied unchanged. This
+   * allows for example to set up a single-precision MatrixFree object for a
+   * multigrid smoother from the double-precision object of the same level
+   * without evaluating the mapping or enumerating the degrees of freedom
+   * again. The vectorization length of the two objects must coincide, i.e.,
+   * a MatrixFree<dim,double> object can be converted to a
+   * <code>MatrixFree<dim, float, VectorizedArray<float,
+   * VectorizedArray<double>::n_array_elements>></code> object.
+   */
+  template <typename OtherNumber, typename OtherVectorizedArrayType>
+  void
+  copy_from(const MatrixFree<dim, OtherNumber, OtherVectorizedArrayType>
+              &matrix_free_base);
+
   /**
    * Clear all data fields and brings the class into a condition similar to
    * after having called the default constructor.
@@ -734,6 +860,33 @@ public:
             const InVector &                                   src,
             const bool zero_dst_vector = false) const;
 
+  /**
+   * Same as the cell_loop() above, but for the hp case: each range of cell
+   * batches handed out by the loop is split into subranges with the same
+   * active FE index of the DoFHandler given by @p dof_handler_index, and
+   * @p cell_operation is called once for each non-empty subrange, in order
+   * of increasing FE index. This way, @p cell_operation only ever sees cell
+   * batches of a single finite element and can set up its FEEvaluation
+   * objects with the constructor taking a cell range, using the runtime
+   * degree <code>fe_degree=-1</code>. A single operator then covers all
+   * degrees of the collection that are precompiled for the evaluation
+   * kernels, without dispatching over template instantiations itself.
+   *
+   * Without hp, the ranges are passed on unchanged.
+   */
+  template <typename OutVector, typename InVector>
+  void
+  cell_loop_hp(const std::function<
+                 void(const MatrixFree<dim, Number, VectorizedArrayType> &,
+                      OutVector &,
+                      const InVector &,
+                      const std::pair<unsigned int, unsigned int> &)>
+                 &                cell_operation,
+               OutVector &        dst,
+               const InVector &   src,
+               const bool         zero_dst_vector   = false,
+               const unsigned int dof_handler_index = 0) const;
+
   /**
    * This is the second variant to run the loop over all cells, now providing
    * a function pointer to a member function of class `CLASS`. This method
@@ -802,6 +955,93 @@ public:
             const InVector &src,
             const bool      zero_dst_vector = false) const;
 
+  /**
+   * This function is similar to the cell_loop with a member function
+   * pointer above, but adds two additional functors to execute some
+   * additional work before and after the cell integrals are computed.
+   *
+   * The two additional functors work on a range of degrees of freedom,
+   * expressed in terms of the degree-of-freedom numbering of the selected
+   * DoFHandler `dof_handler_index_pre_post` in MPI-local indices, i.e.,
+   * numbers between zero and the locally owned size of the vector
+   * partitioner. The ranges are selected in such a way that each range of
+   * locally owned degrees of freedom is passed to @p operation_before_loop
+   * just before the first cell that reads or writes one of its entries is
+   * processed, and to @p operation_after_loop right after the last cell or
+   * face touching the range has been processed. This allows to fuse vector
+   * updates, e.g., the vector updates of a conjugate gradient iteration or a
+   * Chebyshev smoother, with the operator evaluation while the vector
+   * entries are still in caches. Ranges with entries that are sent to or
+   * received from other processes are scheduled before the ghost exchange
+   * of the source vector starts and after the compress operation of the
+   * destination vector has finished, respectively. The granularity of the
+   * ranges is the chunk size used for zeroing the destination vector
+   * inside the loop.
+   *
+   * Since the functors do not see a global vector, they may operate on any
+   * number of vectors that share the partitioning of
+   * `dof_handler_index_pre_post`, including the `src` and `dst` vectors.
+   * Note that the destination vector is not zeroed inside the loop, so
+   * @p operation_before_loop typically contains the respective operation.
+   *
+   * If the loop is run with threads, the two functors are called only once
+   * with the whole range of locally owned degrees of freedom, before and
+   * after the loop, respectively.
+   */
+  template <typename CLASS, typename OutVector, typename InVector>
+  void
+  cell_loop(void (CLASS::*cell_operation)(
+              const MatrixFree &,
+              OutVector &,
+              const InVector &,
+              const std::pair<unsigned int, unsigned int> &) const,
+            const CLASS *   owning_class,
+            OutVector &     dst,
+            const InVector &src,
+            const std::function<void(const unsigned int, const unsigned int)>
+              &operation_before_loop,
+            const std::function<void(const unsigned int, const unsigned int)>
+              &                operation_after_loop,
+            const unsigned int dof_handler_index_pre_post = 0) const;
+
+  /**
+   * Same as above, but for class member functions which are non-const.
+   */
+  template <typename CLASS, typename OutVector, typename InVector>
+  void
+  cell_loop(void (CLASS::*cell_operation)(
+              const MatrixFree &,
+              OutVector &,
+              const InVector &,
+              const std::pair<unsigned int, unsigned int> &),
+            CLASS *         owning_class,
+            OutVector &     dst,
+            const InVector &src,
+            const std::function<void(const unsigned int, const unsigned int)>
+              &operation_before_loop,
+            const std::function<void(const unsigned int, const unsigned int)>
+              &                operation_after_loop,
+            const unsigned int dof_handler_index_pre_post = 0) const;
+
+  /**
+   * Same as above, but taking an `std::function` as the `cell_operation`
+   * rather than a class member function.
+   */
+  template <typename OutVector, typename InVector>
+  void
+  cell_loop(const std::function<void(
+              const MatrixFree<dim, Number, VectorizedArrayType> &,
+              OutVector &,
+              const InVector &,
+              const std::pair<unsigned int, unsigned int> &)> &cell_operation,
+            OutVector &                                        dst,
+            const InVector &                                   src,
+            const std::function<void(const unsigned int, const unsigned int)>
+              &operation_before_loop,
+            const std::function<void(const unsigned int, const unsigned int)>
+              &                operation_after_loop,
+            const unsigned int dof_handler_index_pre_post = 0) const;
+
   /**
    * This method runs a loop over all cells (in parallel) and performs the MPI
    * data exchange on the source vector and destination vector. As opposed to
@@ -1042,6 +1282,215 @@ public:
        const DataAccessOnFaces src_vector_face_access =
          DataAccessOnFaces::unspecified) const;
 
+  /**
+   * This function is similar to the loop() with member function pointers
+   * above, but takes an additional @p cell_operation_after_faces that is run
+   * on ranges of cell batches as soon as the contributions of the cells and
+   * of all faces adjacent to them have been added into @p dst. This allows
+   * to post-process the result of an operator evaluation while the
+   * respective entries of @p dst are still in caches, rather than in a
+   * separate cell_loop(). A typical use is a stage of an explicit
+   * Runge--Kutta method for a discontinuous Galerkin discretization, where
+   * @p cell_operation_after_faces reads the residual from @p dst, applies
+   * the inverse mass matrix with
+   * MatrixFreeOperators::CellwiseInverseMassMatrix, and writes the stage
+   * vector and the updated solution with FEEvaluation objects on further
+   * vectors of the owning class:
+   * @code
+   * void local_apply_inverse_mass_and_update(
+   *   const MatrixFree<dim, Number> &             data,
+   *   VectorType &                                dst,
+   *   const VectorType &,
+   *   const std::pair<unsigned int, unsigned int> &cell_range) const
+   * {
+   *   FEEvaluation<dim, degree, degree + 1, 1, Number> phi(data);
+   *   MatrixFreeOperators::CellwiseInverseMassMatrix<dim, degree, 1, Number>
+   *     inverse(phi);
+   *   AlignedVector<VectorizedArray<Number>> inverse_JxW(phi.n_q_points);
+   *   for (unsigned int cell = cell_range.first;
+   *        cell < cell_range.second;
+   *        ++cell)
+   *     {
+   *       phi.reinit(cell);
+   *       phi.read_dof_values(dst);
+   *       inverse.fill_inverse_JxW_values(inverse_JxW);
+   *       inverse.apply(inverse_JxW,
+   *                     1,
+   *                     phi.begin_dof_values(),
+   *                     phi.begin_dof_values());
+   *       // update the stage vectors from phi.begin_dof_values() ...
+   *     }
+   * }
+   * @endcode
+   *
+   * Since @p dst is overwritten in place for some cells while other cells
+   * are still being integrated, @p cell_operation_after_faces must only
+   * write into the degrees of freedom of the cells in the given range. The
+   * cells whose degrees of freedom are exchanged with other processes are
+   * processed after the compress operation of @p dst. If the loop is run
+   * with threads, @p cell_operation_after_faces is called once for all
+   * cells after the loop. The ranges are determined by the degree of
+   * freedom numbering of the DoFHandler with index
+   * @p dof_handler_index_pre_post, which should be the one of @p dst.
+   */
+  template <typename CLASS, typename OutVector, typename InVector>
+  void
+  loop(
+    void (CLASS::*cell_operation)(const MatrixFree &,
+                                  OutVector &,
+                                  const InVector &,
+                                  const std::pair<unsigned int, unsigned int> &)
+      const,
+    void (CLASS::*face_operation)(const MatrixFree &,
+                                  OutVector &,
+                                  const InVector &,
+                                  const std::pair<unsigned int, unsigned int> &)
+      const,
+    void (CLASS::*boundary_operation)(
+      const MatrixFree &,
+      OutVector &,
+      const InVector &,
+      const std::pair<unsigned int, unsigned int> &) const,
+    void (CLASS::*cell_operation_after_faces)(
+      const MatrixFree &,
+      OutVector &,
+      const InVector &,
+      const std::pair<unsigned int, unsigned int> &) const,
+    const CLASS *           owning_class,
+    OutVector &             dst,
+    const InVector &        src,
+    const bool              zero_dst_vector = false,
+    const DataAccessOnFaces dst_vector_face_access =
+      DataAccessOnFaces::unspecified,
+    const DataAccessOnFaces src_vector_face_access =
+      DataAccessOnFaces::unspecified,
+    const unsigned int dof_handler_index_pre_post = 0) const;
+
+  /**
+   * Same as above, but for class member functions which are non-const.
+   */
+  template <typename CLASS, typename OutVector, typename InVector>
+  void
+  loop(void (CLASS::*cell_operation)(
+         const MatrixFree &,
+         OutVector &,
+         const InVector &,
+         const std::pair<unsigned int, unsigned int> &),
+       void (CLASS::*face_operation)(
+         const MatrixFree &,
+         OutVector &,
+         const InVector &,
+         const std::pair<unsigned int, unsigned int> &),
+       void (CLASS::*boundary_operation)(
+         const MatrixFree &,
+         OutVector &,
+         const InVector &,
+         const std::pair<unsigned int, unsigned int> &),
+       void (CLASS::*cell_operation_after_faces)(
+         const MatrixFree &,
+         OutVector &,
+         const InVector &,
+         const std::pair<unsigned int, unsigned int> &),
+       CLASS *                 owning_class,
+       OutVector &             dst,
+       const InVector &        src,
+       const bool              zero_dst_vector = false,
+       const DataAccessOnFaces dst_vector_face_access =
+         DataAccessOnFaces::unspecified,
+       const DataAccessOnFaces src_vector_face_access =
+         DataAccessOnFaces::unspecified,
+       const unsigned int dof_handler_index_pre_post = 0) const;
+
+  /**
+   * This method runs the loop over all cells (in parallel) where the
+   * @p cell_operation computes both the cell integrals and the integrals on
+   * all faces of the cells of a cell batch, with the data of the neighbors
+   * accessed through FEFaceEvaluation::reinit(cell_batch_number,
+   * face_number) on an FEFaceEvaluation object for the exterior side. As
+   * opposed to loop(), the degrees of freedom of a cell are read and written
+   * only once per loop, and each face is computed from both sides by the
+   * two adjacent cells. This improves the reuse of data in caches and
+   * avoids the conflicts of writing face contributions into the degrees of
+   * freedom of neighbors, at the cost of computing each inner face twice.
+   *
+   * The cell-centric loop requires the face data structures to be set up by
+   * setting AdditionalData::mapping_update_flags_inner_faces and the data
+   * of faces associated with cells by
+   * AdditionalData::mapping_update_flags_faces_by_cells. In parallel,
+   * AdditionalData::hold_all_faces_to_owned_cells must be set in order to
+   * have access to all neighbors of the locally owned cells. The loop only
+   * writes into the degrees of freedom of the cells of a range, so the
+   * ghost entries of @p dst are only exchanged as for a cell loop.
+   *
+   * @param cell_operation Pointer to member function of `CLASS` with the
+   * signature <tt>cell_operation (const MatrixFree<dim,Number> &, OutVector &,
+   * InVector &, std::pair<unsigned int,unsigned int> &)</tt> where the first
+   * argument passes the data of the calling class and the last argument
+   * defines the range of cells which should be worked on.
+   *
+   * @param owning_class The object which provides the `cell_operation`
+   * call.
+   *
+   * @param dst Destination vector holding the result.
+   *
+   * @param src Input vector, whose ghost entries are updated at the start of
+   * the loop.
+   *
+   * @param zero_dst_vector If this flag is set to `true`, the vector `dst`
+   * will be set to zero inside the loop.
+   *
+   * @param src_vector_face_access Set the type of access into the vector
+   * `src` that will happen on the exterior side of the faces of the cells,
+   * see loop().
+   */
+  template <typename CLASS, typename OutVector, typename InVector>
+  void
+  loop_cell_centric(void (CLASS::*cell_operation)(
+                      const MatrixFree &,
+                      OutVector &,
+                      const InVector &,
+                      const std::pair<unsigned int, unsigned int> &) const,
+                    const CLASS *           owning_class,
+                    OutVector &             dst,
+                    const InVector &        src,
+                    const bool              zero_dst_vector = false,
+                    const DataAccessOnFaces src_vector_face_access =
+                      DataAccessOnFaces::unspecified) const;
+
+  /**
+   * Same as above, but for class member functions which are non-const.
+   */
+  template <typename CLASS, typename OutVector, typename InVector>
+  void
+  loop_cell_centric(void (CLASS::*cell_operation)(
+                      const MatrixFree &,
+                      OutVector &,
+                      const InVector &,
+                      const std::pair<unsigned int, unsigned int> &),
+                    CLASS *                 owning_class,
+                    OutVector &             dst,
+                    const InVector &        src,
+                    const bool              zero_dst_vector = false,
+                    const DataAccessOnFaces src_vector_face_access =
+                      DataAccessOnFaces::unspecified) const;
+
+  /**
+   * Same as above, but with std::function.
+   */
+  template <typename OutVector, typename InVector>
+  void
+  loop_cell_centric(
+    const std::function<void(const MatrixFree &,
+                             OutVector &,
+                             const InVector &,
+                             const std::pair<unsigned int, unsigned int> &)>
+      &                     cell_operation,
+    OutVector &             dst,
+    const InVector &        src,
+    const bool              zero_dst_vector = false,
+    const DataAccessOnFaces src_vector_face_access =
+      DataAccessOnFaces::unspecified) const;
+
   /**
    * In the hp adaptive case, a subrange of cells as computed during the cell
    * loop might contain elements of different degrees. Use this function to
@@ -1066,6 +1515,17 @@ public:
     const unsigned int                           fe_index,
     const unsigned int                           dof_handler_index = 0) const;
 
+  /**
+   * Return the active FE index of the cell batches in the given @p range in
+   * the hp case, and zero otherwise. All cell batches in the range must share
+   * the same index, as is the case for the subranges computed by
+   * create_cell_subrange_hp_by_index() and for the ranges passed to the cell
+   * operation of cell_loop_hp().
+   */
+  unsigned int
+  get_cell_active_fe_index(const std::pair<unsigned int, unsigned int> &range,
+                           const unsigned int dof_handler_index = 0) const;
+
   //@}
 
   /**
@@ -1461,6 +1921,124 @@ public:
   void
   print_memory_consumption(StreamType &out) const;
 
+  /**
+   * A structured breakdown of the memory consumption of this class on the
+   * current process, as returned by get_memory_statistics(), together with
+   * an estimate of the memory traffic of an operator application.
+   *
+   * All numbers refer to the data of the calling process only. Global
+   * figures can be obtained by passing the entries to Utilities::MPI::sum()
+   * or Utilities::MPI::min_max_avg().
+   */
+  struct MemoryStatistics
+  {
+    /**
+     * Constructor. Sets all entries to zero.
+     */
+    MemoryStatistics();
+
+    /**
+     * The total memory consumption in bytes, as returned by
+     * memory_consumption().
+     */
+    std::size_t total;
+
+    /**
+     * Memory of the cell indices in bytes, see get_cell_iterator().
+     */
+    std::size_t cell_index;
+
+    /**
+     * Memory of the index data in bytes, including the vector
+     * partitioners, with one entry per DoFHandler.
+     */
+    std::vector<std::size_t> dof_info;
+
+    /**
+     * Memory of the pool of constraint coefficients shared by all
+     * DoFHandler objects in bytes.
+     */
+    std::size_t constraint_pool;
+
+    /**
+     * Memory of the mapping data on cells in bytes, summed over all
+     * quadrature formulas and split by the internal::MatrixFreeFunctions::
+     * GeometryType of the cell batches, i.e., Cartesian, affine, flat faces,
+     * and general cells. Since the data of all cell batches is stored in
+     * common arrays, the memory is attributed in proportion to the number
+     * of entries stored for the batches of each type.
+     */
+    std::array<std::size_t, 4> cell_mapping;
+
+    /**
+     * Memory of the mapping data on faces in bytes, summed over all
+     * quadrature formulas.
+     */
+    std::size_t face_mapping;
+
+    /**
+     * Memory of the remaining data of the mapping in bytes, like the
+     * geometry type of cells and faces.
+     */
+    std::size_t other_mapping;
+
+    /**
+     * Memory of the face indicators in bytes.
+     */
+    std::size_t face_info;
+
+    /**
+     * Memory of the shape functions evaluated on the unit cell in bytes.
+     */
+    std::size_t shape_info;
+
+    /**
+     * Memory of the information on the parallel partitioning of the loops
+     * in bytes.
+     */
+    std::size_t task_info;
+
+    /**
+     * Estimate of the number of bytes transferred from main memory per
+     * locally owned degree of freedom in one cell loop of an operator on
+     * the respective DoFHandler, with one entry per DoFHandler. The
+     * estimate assumes that the source vector including its ghost entries
+     * is read once, the destination vector is read and written once, and
+     * that the indices of the cells, the constraint pool, as well as the
+     * Jacobians, JxW values, and geometry types of the cells for the
+     * quadrature formula passed to get_memory_statistics() are read once.
+     * Caches are assumed to hold no data from a previous loop, and the
+     * data of faces is not included. The numbers hence describe a lower
+     * bound for the memory transfer of a cell loop that can be used
+     * together with the memory bandwidth of a machine to estimate the
+     * run time of operators limited by memory bandwidth.
+     */
+    std::vector<double> bytes_per_dof;
+
+    /**
+     * Print the statistics to @p out in a human-readable form.
+     */
+    void
+    print(std::ostream &out) const;
+
+    /**
+     * Write the statistics to @p out in JSON format, using the names of the
+     * member variables as keys.
+     */
+    void
+    write_json(std::ostream &out) const;
+  };
+
+  /**
+   * Return a structured breakdown of the memory consumption of this class
+   * on the current process and an estimate of the bytes transferred per
+   * degree of freedom in a cell loop, see MemoryStatistics. The estimate
+   * uses the mapping data of the quadrature formula with index
+   * @p quad_index.
+   */
+  MemoryStatistics
+  get_memory_statistics(const unsigned int quad_index = 0) const;
+
   /**
    * Prints a summary of this class to the given output stream. It is focused
    * on the indices, and does not print all the data stored.
@@ -1540,6 +2118,17 @@ public:
     VectorizedArrayType::n_array_elements> &
   get_face_info(const unsigned int face_batch_number) const;
 
+  /**
+   * Return the table that translates a triple of the cell batch number, the
+   * index of a face within a cell and the index within the cell batch of
+   * vectorization into the index within the faces array, given as
+   * `face_batch_number * n_array_elements + lane`. Faces at the boundary and
+   * faces not held by the present object are marked by
+   * numbers::invalid_unsigned_int.
+   */
+  const Table<3, unsigned int> &
+  get_cell_and_face_to_plain_faces() const;
+
   /**
    * Obtains a scratch data object for internal use. Make sure to release it
    * afterwards by passing the pointer you obtain from this object to the
@@ -1773,6 +2362,13 @@ private:
    */
   mutable std::list<std::pair<bool, AlignedVector<Number>>>
     scratch_pad_non_threadsafe;
+
+  /**
+   * Allow access to the data of objects with a different number type in
+   * copy_from().
+   */
+  template <int, typename, typename>
+  friend class MatrixFree;
 };
 
 
@@ -2063,6 +2659,31 @@ MatrixFree<dim, Number, VectorizedArrayType>::create_cell_subrange_hp(
 
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+inline unsigned int
+MatrixFree<dim, Number, VectorizedArrayType>::get_cell_active_fe_index(
+  const std::pair<unsigned int, unsigned int> &range,
+  const unsigned int                           dof_handler_index) const
+{
+  AssertIndexRange(dof_handler_index, dof_info.size());
+  const std::vector<unsigned int> &fe_indices =
+    dof_info[dof_handler_index].cell_active_fe_index;
+  if (fe_indices.empty() || range.first >= range.second)
+    return 0;
+
+  AssertIndexRange(range.second, fe_indices.size() + 1);
+#ifdef DEBUG
+  for (unsigned int i = range.first + 1; i < range.second; ++i)
+    Assert(fe_indices[i] == fe_indices[range.first],
+           ExcMessage("The cell batches in the given range do not share the "
+                      "same active FE index. Use create_cell_subrange_hp() "
+                      "or cell_loop_hp() to obtain such ranges."));
+#endif
+  return fe_indices[range.first];
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 inline bool
 MatrixFree<dim, Number, VectorizedArrayType>::at_irregular_cell(
@@ -2231,6 +2852,16 @@ MatrixFree<dim, Number, VectorizedArrayType>::get_face_info(
 
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+inline const Table<3, unsigned int> &
+MatrixFree<dim, Number, VectorizedArrayType>::get_cell_and_face_to_plain_faces()
+  const
+{
+  return face_info.cell_and_face_to_plain_faces;
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 inline const Quadrature<dim> &
 MatrixFree<dim, Number, VectorizedArrayType>::get_quadrature(
@@ -2451,11 +3082,56 @@ namespace internal
 
 
 template <int dim, typename Number, typename VectorizedArrayType>
-template <typename DoFHandlerType, typename QuadratureType, typename number2>
+template <typename OtherNumber, typename OtherVectorizedArrayType>
 void
-MatrixFree<dim, Number, VectorizedArrayType>::reinit(
-  const DoFHandlerType &            dof_handler,
-  const AffineConstraints<number2> &constraints_in,
+MatrixFree<dim, Number, VectorizedArrayType>::copy_from(
+  const MatrixFree<dim, OtherNumber, OtherVectorizedArrayType> &v)
+{
+  static_assert(VectorizedArrayType::n_array_elements ==
+                  OtherVectorizedArrayType::n_array_elements,
+                "The vectorization length of the two objects must match.");
+
+  clear();
+  dof_handlers.dof_handler    = v.dof_handlers.dof_handler;
+  dof_handlers.hp_dof_handler = v.dof_handlers.hp_dof_handler;
+  dof_handlers.active_dof_handler =
+    v.dof_handlers.active_dof_handler ==
+        MatrixFree<dim, OtherNumber, OtherVectorizedArrayType>::DoFHandlers::
+          usual ?
+      DoFHandlers::usual :
+      DoFHandlers::hp;
+  dof_handlers.n_dof_handlers = v.dof_handlers.n_dof_handlers;
+  dof_handlers.level          = v.dof_handlers.level;
+
+  dof_info = v.dof_info;
+  constraint_pool_data.assign(v.constraint_pool_data.begin(),
+                              v.constraint_pool_data.end());
+  constraint_pool_row_index = v.constraint_pool_row_index;
+  mapping_info.copy_from(v.mapping_info);
+
+  shape_info.reinit(v.shape_info.size());
+  for (unsigned int i = 0; i < shape_info.size(0); ++i)
+    for (unsigned int j = 0; j < shape_info.size(1); ++j)
+      for (unsigned int k = 0; k < shape_info.size(2); ++k)
+        for (unsigned int l = 0; l < shape_info.size(3); ++l)
+          shape_info(i, j, k, l).copy_from(v.shape_info(i, j, k, l));
+
+  cell_level_index           = v.cell_level_index;
+  cell_level_index_end_local = v.cell_level_index_end_local;
+  task_info                  = v.task_info;
+  face_info                  = v.face_info;
+  indices_are_initialized    = v.indices_are_initialized;
+  mapping_is_initialized     = v.mapping_is_initialized;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename DoFHandlerType, typename QuadratureType, typename number2>
+void
+MatrixFree<dim, Number, VectorizedArrayType>::reinit(
+  const DoFHandlerType &            dof_handler,
+  const AffineConstraints<number2> &constraints_in,
   const QuadratureType &            quad,
   const typename MatrixFree<dim, Number, VectorizedArrayType>::AdditionalData
     additional_data)
@@ -2777,6 +3453,78 @@ namespace internal
 
 
 
+    /**
+     * For vectors whose ghost data cannot be tracked process by process,
+     * return an invalid component.
+     */
+    template <typename VectorType>
+    unsigned int
+    find_component_for_exchange_by_process(const VectorType & /*vec*/) const
+    {
+      return numbers::invalid_unsigned_int;
+    }
+
+
+
+    /**
+     * Return the component in the MF object that describes the ghost
+     * exchange of the given vector in case its ghost data arrives in place
+     * and the ranges of the loop know the processes they read from, and an
+     * invalid component otherwise.
+     */
+    unsigned int
+    find_component_for_exchange_by_process(
+      const LinearAlgebra::distributed::Vector<Number> &vec) const
+    {
+#  ifdef DEAL_II_WITH_MPI
+      if (vec.size() == 0)
+        return numbers::invalid_unsigned_int;
+      const unsigned int mf_component = find_vector_in_mf(vec, false);
+      if (mf_component == numbers::invalid_unsigned_int ||
+          matrix_free.get_dof_info(mf_component)
+            .ghost_targets_by_range_index.empty())
+        return numbers::invalid_unsigned_int;
+      if (vector_face_access !=
+            dealii::MatrixFree<dim, Number, VectorizedArrayType>::
+              DataAccessOnFaces::unspecified &&
+          &get_partitioner(mf_component) !=
+            matrix_free.get_dof_info(mf_component).vector_partitioner.get())
+        return numbers::invalid_unsigned_int;
+      return mf_component;
+#  else
+      (void)vec;
+      return numbers::invalid_unsigned_int;
+#  endif
+    }
+
+
+
+    /**
+     * Wait for the ghost data of one more process for vectors that do not
+     * support this, which returns an invalid process.
+     */
+    template <typename VectorType>
+    unsigned int
+    update_ghost_values_wait_any(const VectorType & /*vec*/) const
+    {
+      return numbers::invalid_unsigned_int;
+    }
+
+
+
+    /**
+     * Wait for the ghost data of one more process for
+     * LinearAlgebra::distributed::Vector.
+     */
+    unsigned int
+    update_ghost_values_wait_any(
+      const LinearAlgebra::distributed::Vector<Number> &vec) const
+    {
+      return vec.update_ghost_values_wait_any();
+    }
+
+
+
     /**
      * Start update_ghost_value for serial vectors
      */
@@ -3212,6 +3960,147 @@ namespace internal
 
 
 
+    /**
+     * Start update_ghost_value for all blocks of a block vector at once.
+     * Only LinearAlgebra::distributed::BlockVector supports this, so this
+     * variant returns false to indicate that the blocks must be exchanged
+     * one by one.
+     */
+    template <typename VectorType>
+    bool
+    update_ghost_values_start_all_blocks(
+      const unsigned int /*component_in_block_vector*/,
+      const VectorType & /*vec*/)
+    {
+      return false;
+    }
+
+
+
+    /**
+     * Start update_ghost_value for all blocks of a
+     * LinearAlgebra::distributed::BlockVector at once, which sends the data
+     * of all blocks in one message per process. This is only done if the
+     * full ghost range is exchanged, because the partitioners restricted to
+     * the data accessed by faces can be different for the different
+     * blocks. Return whether the exchange has been started.
+     */
+    bool
+    update_ghost_values_start_all_blocks(
+      const unsigned int                                     channel,
+      const LinearAlgebra::distributed::BlockVector<Number> &vec)
+    {
+      if (vector_face_access !=
+          dealii::MatrixFree<dim, Number, VectorizedArrayType>::
+            DataAccessOnFaces::unspecified)
+        return false;
+
+      if (vec.has_ghost_elements())
+        ghosts_were_set = true;
+      vec.update_ghost_values_start(channel + channel_shift);
+      return true;
+    }
+
+
+
+    /**
+     * Finish update_ghost_value for all blocks of a block vector at once,
+     * see update_ghost_values_start_all_blocks().
+     */
+    template <typename VectorType>
+    bool
+    update_ghost_values_finish_all_blocks(const VectorType & /*vec*/)
+    {
+      return false;
+    }
+
+
+
+    /**
+     * Finish update_ghost_value for all blocks of a
+     * LinearAlgebra::distributed::BlockVector at once.
+     */
+    bool
+    update_ghost_values_finish_all_blocks(
+      const LinearAlgebra::distributed::BlockVector<Number> &vec)
+    {
+      if (vector_face_access !=
+          dealii::MatrixFree<dim, Number, VectorizedArrayType>::
+            DataAccessOnFaces::unspecified)
+        return false;
+
+      vec.update_ghost_values_finish();
+      return true;
+    }
+
+
+
+    /**
+     * Start compress for all blocks of a block vector at once, see
+     * update_ghost_values_start_all_blocks().
+     */
+    template <typename VectorType>
+    bool
+    compress_start_all_blocks(const unsigned int /*component_in_block_vector*/,
+                              VectorType & /*vec*/)
+    {
+      return false;
+    }
+
+
+
+    /**
+     * Start compress for all blocks of a
+     * LinearAlgebra::distributed::BlockVector at once.
+     */
+    bool
+    compress_start_all_blocks(
+      const unsigned int                               channel,
+      LinearAlgebra::distributed::BlockVector<Number> &vec)
+    {
+      if (vector_face_access !=
+          dealii::MatrixFree<dim, Number, VectorizedArrayType>::
+            DataAccessOnFaces::unspecified)
+        return false;
+
+      vec.compress_start(channel + channel_shift, VectorOperation::add);
+      return true;
+    }
+
+
+
+    /**
+     * Finish compress for all blocks of a block vector at once, see
+     * update_ghost_values_start_all_blocks().
+     */
+    template <typename VectorType>
+    bool
+    compress_finish_all_blocks(VectorType & /*vec*/)
+    {
+      return false;
+    }
+
+
+
+    /**
+     * Finish compress for all blocks of a
+     * LinearAlgebra::distributed::BlockVector at once.
+     */
+    bool
+    compress_finish_all_blocks(
+      LinearAlgebra::distributed::BlockVector<Number> &vec)
+    {
+      if (vector_face_access !=
+          dealii::MatrixFree<dim, Number, VectorizedArrayType>::
+            DataAccessOnFaces::unspecified)
+        return false;
+
+      vec.compress_finish(VectorOperation::add);
+      return true;
+    }
+
+
+
     /**
      * Reset all ghost values for serial vectors
      */
@@ -3506,6 +4395,11 @@ namespace internal
     VectorDataExchange<dim, Number, VectorizedArrayType> &exchanger,
     const unsigned int                                    channel = 0)
   {
+    // exchange all blocks in one message per process if possible, in which
+    // case the number of blocks does not affect the number of requests
+    if (exchanger.update_ghost_values_start_all_blocks(channel, vec))
+      return;
+
     if (get_communication_block_size(vec) < vec.n_blocks())
       {
         // don't forget to set ghosts_were_set, that otherwise happens
@@ -3597,6 +4491,9 @@ namespace internal
     VectorDataExchange<dim, Number, VectorizedArrayType> &exchanger,
     const unsigned int                                    channel = 0)
   {
+    if (exchanger.update_ghost_values_finish_all_blocks(vec))
+      return;
+
     if (get_communication_block_size(vec) < vec.n_blocks())
       {
         // do nothing, everything has already been completed in the _start()
@@ -3684,6 +4581,9 @@ namespace internal
     VectorDataExchange<dim, Number, VectorizedArrayType> &exchanger,
     const unsigned int                                    channel = 0)
   {
+    if (exchanger.compress_start_all_blocks(channel, vec))
+      return;
+
     if (get_communication_block_size(vec) < vec.n_blocks())
       vec.compress(dealii::VectorOperation::add);
     else
@@ -3768,6 +4668,9 @@ namespace internal
     VectorDataExchange<dim, Number, VectorizedArrayType> &exchanger,
     const unsigned int                                    channel = 0)
   {
+    if (exchanger.compress_finish_all_blocks(vec))
+      return;
+
     if (get_communication_block_size(vec) < vec.n_blocks())
       {
         // do nothing, everything has already been completed in the _start()
@@ -4066,12 +4969,20 @@ namespace internal
              const typename MF::DataAccessOnFaces src_vector_face_access =
                MF::DataAccessOnFaces::none,
              const typename MF::DataAccessOnFaces dst_vector_face_access =
-               MF::DataAccessOnFaces::none)
+               MF::DataAccessOnFaces::none,
+             const std::function<void(const unsigned int, const unsigned int)>
+               &operation_before_loop = {},
+             const std::function<void(const unsigned int, const unsigned int)>
+               &                operation_after_loop       = {},
+             const unsigned int dof_handler_index_pre_post = 0,
+             const bool         is_cell_centric            = false,
+             function_type      cell_after_faces_function  = nullptr)
       : matrix_free(matrix_free)
       , container(const_cast<Container &>(container))
       , cell_function(cell_function)
       , face_function(face_function)
       , boundary_function(boundary_function)
+      , cell_after_faces_function(cell_after_faces_function)
       , src(src)
       , dst(dst)
       , src_data_exchanger(matrix_free,
@@ -4083,6 +4994,12 @@ namespace internal
       , src_and_dst_are_same(PointerComparison::equal(&src, &dst))
       , zero_dst_vector_setting(zero_dst_vector_setting &&
                                 !src_and_dst_are_same)
+      , operation_before_loop(operation_before_loop)
+      , operation_after_loop(operation_after_loop)
+      , dof_handler_index_pre_post(dof_handler_index_pre_post)
+      , is_cell_centric(is_cell_centric)
+      , ghost_exchange_component(numbers::invalid_unsigned_int)
+      , ghost_exchange_finished(false)
     {}
 
     // Runs the cell work. If no function is given, nothing is done
@@ -4133,6 +5050,69 @@ namespace internal
     {
       if (!src_and_dst_are_same)
         internal::update_ghost_values_finish(src, src_data_exchanger);
+      ghost_exchange_finished = true;
+    }
+
+    // Waits for the ghost data of one more process. If the source vector
+    // cannot be tracked process by process, the exchange is finished right
+    // away
+    virtual bool
+    vector_update_ghosts_wait_any() override
+    {
+      if (ghost_exchange_finished)
+        return false;
+
+      if (ghost_exchange_component == numbers::invalid_unsigned_int)
+        {
+          // the processes the ranges read from are not known for the
+          // neighbors accessed by cell-centric loops
+          if (!src_and_dst_are_same && !is_cell_centric)
+            ghost_exchange_component =
+              src_data_exchanger.find_component_for_exchange_by_process(src);
+          if (ghost_exchange_component != numbers::invalid_unsigned_int)
+            ghost_target_arrived.assign(
+              matrix_free.get_dof_info(ghost_exchange_component)
+                .vector_partitioner->ghost_targets()
+                .size(),
+              false);
+        }
+
+      if (ghost_exchange_component != numbers::invalid_unsigned_int)
+        {
+          const unsigned int target =
+            src_data_exchanger.update_ghost_values_wait_any(src);
+          if (target != numbers::invalid_unsigned_int)
+            {
+              AssertIndexRange(target, ghost_target_arrived.size());
+              ghost_target_arrived[target] = true;
+              return true;
+            }
+        }
+
+      vector_update_ghosts_finish();
+      return false;
+    }
+
+    // Checks whether the processes the given range reads from have sent
+    // their ghost data
+    virtual bool
+    ghost_data_available(const unsigned int range_index) override
+    {
+      if (ghost_exchange_finished || src_and_dst_are_same)
+        return true;
+      if (ghost_exchange_component == numbers::invalid_unsigned_int)
+        return false;
+
+      const internal::MatrixFreeFunctions::DoFInfo &dof_info =
+        matrix_free.get_dof_info(ghost_exchange_component);
+      AssertIndexRange(range_index + 1,
+                       dof_info.ghost_targets_by_range_index.size());
+      for (unsigned int i = dof_info.ghost_targets_by_range_index[range_index];
+           i < dof_info.ghost_targets_by_range_index[range_index + 1];
+           ++i)
+        if (ghost_target_arrived[dof_info.ghost_targets_by_range[i]] == false)
+          return false;
+      return true;
     }
 
     // Starts the communication for the vector compress operation
@@ -4159,12 +5139,97 @@ namespace internal
         internal::zero_vector_region(range_index, dst, dst_data_exchanger);
     }
 
+    // Runs the operation before the first access to a range of vector
+    // entries. If the loop is run with threads, the whole range is done at
+    // once as indicated by an invalid range index.
+    virtual void
+    cell_loop_pre_range(const unsigned int range_index) override
+    {
+      if (operation_before_loop)
+        run_pre_post_operation(
+          range_index,
+          matrix_free.get_dof_info(dof_handler_index_pre_post)
+            .cell_loop_pre_list_index,
+          matrix_free.get_dof_info(dof_handler_index_pre_post)
+            .cell_loop_pre_list,
+          operation_before_loop);
+    }
+
+    // Runs the operation after the last access to a range of vector
+    // entries, and the cell operation on the cells whose cell and face
+    // integrals have been completed
+    virtual void
+    cell_loop_post_range(const unsigned int range_index) override
+    {
+      if (cell_after_faces_function != nullptr)
+        {
+          if (range_index == numbers::invalid_unsigned_int)
+            (container.*cell_after_faces_function)(
+              matrix_free,
+              this->dst,
+              this->src,
+              std::make_pair(0U, matrix_free.n_cell_batches()));
+          else
+            {
+              const std::vector<unsigned int> &list_index =
+                matrix_free.get_dof_info(dof_handler_index_pre_post)
+                  .cell_loop_post_cell_list_index;
+              AssertIndexRange(range_index + 1, list_index.size());
+              for (unsigned int id = list_index[range_index];
+                   id != list_index[range_index + 1];
+                   ++id)
+                (container.*cell_after_faces_function)(
+                  matrix_free,
+                  this->dst,
+                  this->src,
+                  matrix_free.get_dof_info(dof_handler_index_pre_post)
+                    .cell_loop_post_cell_list[id]);
+            }
+        }
+
+      if (operation_after_loop)
+        run_pre_post_operation(
+          range_index,
+          matrix_free.get_dof_info(dof_handler_index_pre_post)
+            .cell_loop_post_list_index,
+          matrix_free.get_dof_info(dof_handler_index_pre_post)
+            .cell_loop_post_list,
+          operation_after_loop);
+    }
+
   private:
+    void
+    run_pre_post_operation(
+      const unsigned int               range_index,
+      const std::vector<unsigned int> &list_index,
+      const std::vector<std::pair<unsigned int, unsigned int>> &list,
+      const std::function<void(const unsigned int, const unsigned int)>
+        &operation) const
+    {
+      if (range_index == numbers::invalid_unsigned_int)
+        {
+          const unsigned int local_size =
+            matrix_free.get_dof_info(dof_handler_index_pre_post)
+              .vector_partitioner->local_size();
+          if (local_size > 0)
+            operation(0U, local_size);
+        }
+      else
+        {
+          AssertIndexRange(range_index + 1, list_index.size());
+          for (unsigned int id = list_index[range_index];
+               id != list_index[range_index + 1];
+               ++id)
+            operation(list[id].first, list[id].second);
+        }
+    }
+
     const MF &    matrix_free;
     Container &   container;
     function_type cell_function;
     function_type face_function;
     function_type boundary_function;
+    function_type cell_after_faces_function;
 
     const InVector &src;
     OutVector &     dst;
@@ -4178,6 +5243,18 @@ namespace internal
                dst_data_exchanger;
     const bool src_and_dst_are_same;
     const bool zero_dst_vector_setting;
+    const std::function<void(const unsigned int, const unsigned int)>
+      operation_before_loop;
+    const std::function<void(const unsigned int, const unsigned int)>
+                       operation_after_loop;
+    const unsigned int dof_handler_index_pre_post;
+    const bool         is_cell_centric;
+
+    // the state of the ghost exchange tracked process by process in
+    // vector_update_ghosts_wait_any()
+    unsigned int      ghost_exchange_component;
+    std::vector<bool> ghost_target_arrived;
+    bool              ghost_exchange_finished;
   };
 
 
@@ -4280,6 +5357,56 @@ MatrixFree<dim, Number, VectorizedArrayType>::cell_loop(
 
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename OutVector, typename InVector>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::cell_loop_hp(
+  const std::function<void(const MatrixFree<dim, Number, VectorizedArrayType> &,
+                           OutVector &,
+                           const InVector &,
+                           const std::pair<unsigned int, unsigned int> &)>
+    &                cell_operation,
+  OutVector &        dst,
+  const InVector &   src,
+  const bool         zero_dst_vector,
+  const unsigned int dof_handler_index) const
+{
+  AssertIndexRange(dof_handler_index, dof_info.size());
+  const internal::MatrixFreeFunctions::DoFInfo &info =
+    dof_info[dof_handler_index];
+
+  if (info.cell_active_fe_index.empty())
+    {
+      cell_loop(cell_operation, dst, src, zero_dst_vector);
+      return;
+    }
+
+  const std::function<void(const MatrixFree<dim, Number, VectorizedArrayType> &,
+                           OutVector &,
+                           const InVector &,
+                           const std::pair<unsigned int, unsigned int> &)>
+    split_operation =
+      [&](const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+          OutVector &                                         out,
+          const InVector &                                    in,
+          const std::pair<unsigned int, unsigned int> &       range) {
+        for (unsigned int fe_index = 0; fe_index < info.max_fe_index;
+             ++fe_index)
+          {
+            const std::pair<unsigned int, unsigned int> subrange =
+              create_cell_subrange_hp_by_index(range,
+                                               fe_index,
+                                               dof_handler_index);
+            if (subrange.second > subrange.first)
+              cell_operation(matrix_free, out, in, subrange);
+          }
+      };
+
+  cell_loop(split_operation, dst, src, zero_dst_vector);
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 template <typename OutVector, typename InVector>
 inline void
@@ -4441,6 +5568,137 @@ MatrixFree<dim, Number, VectorizedArrayType>::cell_loop(
 
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename CLASS, typename OutVector, typename InVector>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::cell_loop(
+  void (CLASS::*function_pointer)(
+    const MatrixFree<dim, Number, VectorizedArrayType> &,
+    OutVector &,
+    const InVector &,
+    const std::pair<unsigned int, unsigned int> &) const,
+  const CLASS *   owning_class,
+  OutVector &     dst,
+  const InVector &src,
+  const std::function<void(const unsigned int, const unsigned int)>
+    &operation_before_loop,
+  const std::function<void(const unsigned int, const unsigned int)>
+    &                operation_after_loop,
+  const unsigned int dof_handler_index_pre_post) const
+{
+  AssertIndexRange(dof_handler_index_pre_post, dof_info.size());
+  internal::MFWorker<MatrixFree<dim, Number, VectorizedArrayType>,
+                     InVector,
+                     OutVector,
+                     CLASS,
+                     true>
+    worker(*this,
+           src,
+           dst,
+           false,
+           *owning_class,
+           function_pointer,
+           nullptr,
+           nullptr,
+           DataAccessOnFaces::none,
+           DataAccessOnFaces::none,
+           operation_before_loop,
+           operation_after_loop,
+           dof_handler_index_pre_post);
+  task_info.loop(worker);
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename CLASS, typename OutVector, typename InVector>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::cell_loop(
+  void (CLASS::*function_pointer)(
+    const MatrixFree<dim, Number, VectorizedArrayType> &,
+    OutVector &,
+    const InVector &,
+    const std::pair<unsigned int, unsigned int> &),
+  CLASS *         owning_class,
+  OutVector &     dst,
+  const InVector &src,
+  const std::function<void(const unsigned int, const unsigned int)>
+    &operation_before_loop,
+  const std::function<void(const unsigned int, const unsigned int)>
+    &                operation_after_loop,
+  const unsigned int dof_handler_index_pre_post) const
+{
+  AssertIndexRange(dof_handler_index_pre_post, dof_info.size());
+  internal::MFWorker<MatrixFree<dim, Number, VectorizedArrayType>,
+                     InVector,
+                     OutVector,
+                     CLASS,
+                     false>
+    worker(*this,
+           src,
+           dst,
+           false,
+           *owning_class,
+           function_pointer,
+           nullptr,
+           nullptr,
+           DataAccessOnFaces::none,
+           DataAccessOnFaces::none,
+           operation_before_loop,
+           operation_after_loop,
+           dof_handler_index_pre_post);
+  task_info.loop(worker);
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename OutVector, typename InVector>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::cell_loop(
+  const std::function<void(const MatrixFree<dim, Number, VectorizedArrayType> &,
+                           OutVector &,
+                           const InVector &,
+                           const std::pair<unsigned int, unsigned int> &)>
+    &             cell_operation,
+  OutVector &     dst,
+  const InVector &src,
+  const std::function<void(const unsigned int, const unsigned int)>
+    &operation_before_loop,
+  const std::function<void(const unsigned int, const unsigned int)>
+    &                operation_after_loop,
+  const unsigned int dof_handler_index_pre_post) const
+{
+  AssertIndexRange(dof_handler_index_pre_post, dof_info.size());
+  using Wrapper =
+    internal::MFClassWrapper<MatrixFree<dim, Number, VectorizedArrayType>,
+                             InVector,
+                             OutVector>;
+  Wrapper wrap(cell_operation, nullptr, nullptr);
+  internal::MFWorker<MatrixFree<dim, Number, VectorizedArrayType>,
+                     InVector,
+                     OutVector,
+                     Wrapper,
+                     true>
+    worker(*this,
+           src,
+           dst,
+           false,
+           wrap,
+           &Wrapper::cell_integrator,
+           &Wrapper::face_integrator,
+           &Wrapper::boundary_integrator,
+           DataAccessOnFaces::none,
+           DataAccessOnFaces::none,
+           operation_before_loop,
+           operation_after_loop,
+           dof_handler_index_pre_post);
+
+  task_info.loop(worker);
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 template <typename CLASS, typename OutVector, typename InVector>
 inline void
@@ -4486,6 +5744,258 @@ MatrixFree<dim, Number, VectorizedArrayType>::loop(
 }
 
 
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename CLASS, typename OutVector, typename InVector>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::loop(
+  void (CLASS::*cell_operation)(
+    const MatrixFree<dim, Number, VectorizedArrayType> &,
+    OutVector &,
+    const InVector &,
+    const std::pair<unsigned int, unsigned int> &) const,
+  void (CLASS::*face_operation)(
+    const MatrixFree<dim, Number, VectorizedArrayType> &,
+    OutVector &,
+    const InVector &,
+    const std::pair<unsigned int, unsigned int> &) const,
+  void (CLASS::*boundary_operation)(
+    const MatrixFree<dim, Number, VectorizedArrayType> &,
+    OutVector &,
+    const InVector &,
+    const std::pair<unsigned int, unsigned int> &) const,
+  void (CLASS::*cell_operation_after_faces)(
+    const MatrixFree<dim, Number, VectorizedArrayType> &,
+    OutVector &,
+    const InVector &,
+    const std::pair<unsigned int, unsigned int> &) const,
+  const CLASS *           owning_class,
+  OutVector &             dst,
+  const InVector &        src,
+  const bool              zero_dst_vector,
+  const DataAccessOnFaces dst_vector_face_access,
+  const DataAccessOnFaces src_vector_face_access,
+  const unsigned int      dof_handler_index_pre_post) const
+{
+  AssertIndexRange(dof_handler_index_pre_post, dof_info.size());
+  internal::MFWorker<MatrixFree<dim, Number, VectorizedArrayType>,
+                     InVector,
+                     OutVector,
+                     CLASS,
+                     true>
+    worker(*this,
+           src,
+           dst,
+           zero_dst_vector,
+           *owning_class,
+           cell_operation,
+           face_operation,
+           boundary_operation,
+           src_vector_face_access,
+           dst_vector_face_access,
+           {},
+           {},
+           dof_handler_index_pre_post,
+           false,
+           cell_operation_after_faces);
+  task_info.loop(worker);
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename CLASS, typename OutVector, typename InVector>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::loop(
+  void (CLASS::*cell_operation)(
+    const MatrixFree<dim, Number, VectorizedArrayType> &,
+    OutVector &,
+    const InVector &,
+    const std::pair<unsigned int, unsigned int> &),
+  void (CLASS::*face_operation)(
+    const MatrixFree<dim, Number, VectorizedArrayType> &,
+    OutVector &,
+    const InVector &,
+    const std::pair<unsigned int, unsigned int> &),
+  void (CLASS::*boundary_operation)(
+    const MatrixFree<dim, Number, VectorizedArrayType> &,
+    OutVector &,
+    const InVector &,
+    const std::pair<unsigned int, unsigned int> &),
+  void (CLASS::*cell_operation_after_faces)(
+    const MatrixFree<dim, Number, VectorizedArrayType> &,
+    OutVector &,
+    const InVector &,
+    const std::pair<unsigned int, unsigned int> &),
+  CLASS *                 owning_class,
+  OutVector &             dst,
+  const InVector &        src,
+  const bool              zero_dst_vector,
+  const DataAccessOnFaces dst_vector_face_access,
+  const DataAccessOnFaces src_vector_face_access,
+  const unsigned int      dof_handler_index_pre_post) const
+{
+  AssertIndexRange(dof_handler_index_pre_post, dof_info.size());
+  internal::MFWorker<MatrixFree<dim, Number, VectorizedArrayType>,
+                     InVector,
+                     OutVector,
+                     CLASS,
+                     false>
+    worker(*this,
+           src,
+           dst,
+           zero_dst_vector,
+           *owning_class,
+           cell_operation,
+           face_operation,
+           boundary_operation,
+           src_vector_face_access,
+           dst_vector_face_access,
+           {},
+           {},
+           dof_handler_index_pre_post,
+           false,
+           cell_operation_after_faces);
+  task_info.loop(worker);
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename CLASS, typename OutVector, typename InVector>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::loop_cell_centric(
+  void (CLASS::*cell_operation)(
+    const MatrixFree<dim, Number, VectorizedArrayType> &,
+    OutVector &,
+    const InVector &,
+    const std::pair<unsigned int, unsigned int> &) const,
+  const CLASS *           owning_class,
+  OutVector &             dst,
+  const InVector &        src,
+  const bool              zero_dst_vector,
+  const DataAccessOnFaces src_vector_face_access) const
+{
+  Assert(face_info.cell_and_face_to_plain_faces.size(0) >= n_macro_cells() &&
+           mapping_info.face_data_by_cells.empty() == false,
+         ExcMessage("The cell-centric loop requires the face data of both "
+                    "AdditionalData::mapping_update_flags_inner_faces and "
+                    "AdditionalData::mapping_update_flags_faces_by_cells."));
+  internal::MFWorker<MatrixFree<dim, Number, VectorizedArrayType>,
+                     InVector,
+                     OutVector,
+                     CLASS,
+                     true>
+    worker(*this,
+           src,
+           dst,
+           zero_dst_vector,
+           *owning_class,
+           cell_operation,
+           nullptr,
+           nullptr,
+           src_vector_face_access,
+           DataAccessOnFaces::none,
+           {},
+           {},
+           0,
+           true);
+  task_info.loop(worker);
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename CLASS, typename OutVector, typename InVector>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::loop_cell_centric(
+  void (CLASS::*cell_operation)(
+    const MatrixFree<dim, Number, VectorizedArrayType> &,
+    OutVector &,
+    const InVector &,
+    const std::pair<unsigned int, unsigned int> &),
+  CLASS *                 owning_class,
+  OutVector &             dst,
+  const InVector &        src,
+  const bool              zero_dst_vector,
+  const DataAccessOnFaces src_vector_face_access) const
+{
+  Assert(face_info.cell_and_face_to_plain_faces.size(0) >= n_macro_cells() &&
+           mapping_info.face_data_by_cells.empty() == false,
+         ExcMessage("The cell-centric loop requires the face data of both "
+                    "AdditionalData::mapping_update_flags_inner_faces and "
+                    "AdditionalData::mapping_update_flags_faces_by_cells."));
+  internal::MFWorker<MatrixFree<dim, Number, VectorizedArrayType>,
+                     InVector,
+                     OutVector,
+                     CLASS,
+                     false>
+    worker(*this,
+           src,
+           dst,
+           zero_dst_vector,
+           *owning_class,
+           cell_operation,
+           nullptr,
+           nullptr,
+           src_vector_face_access,
+           DataAccessOnFaces::none,
+           {},
+           {},
+           0,
+           true);
+  task_info.loop(worker);
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename OutVector, typename InVector>
+inline void
+MatrixFree<dim, Number, VectorizedArrayType>::loop_cell_centric(
+  const std::function<void(const MatrixFree<dim, Number, VectorizedArrayType> &,
+                           OutVector &,
+                           const InVector &,
+                           const std::pair<unsigned int, unsigned int> &)>
+    &                     cell_operation,
+  OutVector &             dst,
+  const InVector &        src,
+  const bool              zero_dst_vector,
+  const DataAccessOnFaces src_vector_face_access) const
+{
+  Assert(face_info.cell_and_face_to_plain_faces.size(0) >= n_macro_cells() &&
+           mapping_info.face_data_by_cells.empty() == false,
+         ExcMessage("The cell-centric loop requires the face data of both "
+                    "AdditionalData::mapping_update_flags_inner_faces and "
+                    "AdditionalData::mapping_update_flags_faces_by_cells."));
+  using Wrapper =
+    internal::MFClassWrapper<MatrixFree<dim, Number, VectorizedArrayType>,
+                             InVector,
+                             OutVector>;
+  Wrapper wrap(cell_operation, nullptr, nullptr);
+  internal::MFWorker<MatrixFree<dim, Number, VectorizedArrayType>,
+                     InVector,
+                     OutVector,
+                     Wrapper,
+                     true>
+    worker(*this,
+           src,
+           dst,
+           zero_dst_vector,
+           wrap,
+           &Wrapper::cell_integrator,
+           nullptr,
+           nullptr,
+           src_vector_face_access,
+           DataAccessOnFaces::none,
+           {},
+           {},
+           0,
+           true);
+  task_info.loop(worker);
+}
+
+
 #endif // ifndef DOXYGEN
 
 
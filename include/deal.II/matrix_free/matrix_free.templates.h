@@ -21,6 +21,7 @@
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/polynomials_piecewise.h>
 #include <deal.II/base/tensor_product_polynomials.h>
+#include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/distributed/tria.h>
@@ -28,12 +29,14 @@
 #include <deal.II/dofs/dof_accessor.h>
 
 #include <deal.II/fe/fe_poly.h>
+#include <deal.II/fe/fe_q.h>
 
 #include <deal.II/hp/q_collection.h>
 
 #include <deal.II/matrix_free/dof_info.templates.h>
 #include <deal.II/matrix_free/face_info.h>
 #include <deal.II/matrix_free/face_setup_internal.h>
+#include <deal.II/matrix_free/hanging_nodes_internal.h>
 #include <deal.II/matrix_free/matrix_free.h>
 #include <deal.II/matrix_free/shape_info.templates.h>
 
@@ -45,7 +48,12 @@ DEAL_II_DISABLE_EXTRA_DIAGNOSTICS
 DEAL_II_ENABLE_EXTRA_DIAGNOSTICS
 #endif
 
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
 #include <fstream>
+#include <iomanip>
+#include <set>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -220,16 +228,18 @@ MatrixFree<dim, Number, VectorizedArrayType>::copy_from(
   const MatrixFree<dim, Number, VectorizedArrayType> &v)
 {
   clear();
-  dof_handlers              = v.dof_handlers;
-  dof_info                  = v.dof_info;
-  constraint_pool_data      = v.constraint_pool_data;
-  constraint_pool_row_index = v.constraint_pool_row_index;
-  mapping_info              = v.mapping_info;
-  shape_info                = v.shape_info;
-  cell_level_index          = v.cell_level_index;
-  task_info                 = v.task_info;
-  indices_are_initialized   = v.indices_are_initialized;
-  mapping_is_initialized    = v.mapping_is_initialized;
+  dof_handlers               = v.dof_handlers;
+  dof_info                   = v.dof_info;
+  constraint_pool_data       = v.constraint_pool_data;
+  constraint_pool_row_index  = v.constraint_pool_row_index;
+  mapping_info               = v.mapping_info;
+  shape_info                 = v.shape_info;
+  cell_level_index           = v.cell_level_index;
+  cell_level_index_end_local = v.cell_level_index_end_local;
+  task_info                  = v.task_info;
+  face_info                  = v.face_info;
+  indices_are_initialized    = v.indices_are_initialized;
+  mapping_is_initialized     = v.mapping_is_initialized;
 }
 
 
@@ -246,6 +256,12 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
   const typename MatrixFree<dim, Number, VectorizedArrayType>::AdditionalData
     &additional_data)
 {
+  // The setup steps below are collected in a task graph, such that the
+  // independent ones (the shape information of the individual elements and
+  // the DoFHandler information) can run concurrently
+  Threads::TaskGraph                         setup_tasks;
+  std::vector<Threads::TaskGraph::TaskIndex> shape_info_tasks;
+
   // Reads out the FE information and stores the shape function values,
   // gradients and Hessians for quadrature points.
   {
@@ -260,8 +276,11 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
         for (unsigned int nq = 0; nq < n_quad; nq++)
           {
             AssertDimension(quad[nq].size(), 1);
-            shape_info(c, nq, 0, 0)
-              .reinit(quad[nq][0], dof_handler[no]->get_fe(), b);
+            shape_info_tasks.push_back(
+              setup_tasks.add_task([this, &dof_handler, &quad, no, b, c, nq]() {
+                shape_info(c, nq, 0, 0)
+                  .reinit(quad[nq][0], dof_handler[no]->get_fe(), b);
+              }));
           }
   }
 
@@ -272,58 +291,72 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
       AssertDimension(dof_handler.size(), constraint.size());
       AssertDimension(dof_handler.size(), locally_owned_set.size());
 
-      // set variables that are independent of FE
-      if (Utilities::MPI::job_supports_mpi() == true)
-        {
-          const parallel::Triangulation<dim> *dist_tria =
-            dynamic_cast<const parallel::Triangulation<dim> *>(
-              &(dof_handler[0]->get_triangulation()));
-          task_info.communicator = dist_tria != nullptr ?
-                                     dist_tria->get_communicator() :
-                                     MPI_COMM_SELF;
-          task_info.my_pid =
-            Utilities::MPI::this_mpi_process(task_info.communicator);
-          task_info.n_procs =
-            Utilities::MPI::n_mpi_processes(task_info.communicator);
-        }
-      else
-        {
-          task_info.communicator = MPI_COMM_SELF;
-          task_info.my_pid       = 0;
-          task_info.n_procs      = 1;
-        }
+      const Threads::TaskGraph::TaskIndex dof_handler_task =
+        setup_tasks.add_task([&]() {
+          // set variables that are independent of FE
+          if (Utilities::MPI::job_supports_mpi() == true)
+            {
+              const parallel::Triangulation<dim> *dist_tria =
+                dynamic_cast<const parallel::Triangulation<dim> *>(
+                  &(dof_handler[0]->get_triangulation()));
+              task_info.communicator = dist_tria != nullptr ?
+                                         dist_tria->get_communicator() :
+                                         MPI_COMM_SELF;
+              task_info.my_pid =
+                Utilities::MPI::this_mpi_process(task_info.communicator);
+              task_info.n_procs =
+                Utilities::MPI::n_mpi_processes(task_info.communicator);
+            }
+          else
+            {
+              task_info.communicator = MPI_COMM_SELF;
+              task_info.my_pid       = 0;
+              task_info.n_procs      = 1;
+            }
 
-      initialize_dof_handlers(dof_handler, additional_data);
-      for (unsigned int no = 0; no < dof_handler.size(); ++no)
-        {
-          dof_info[no].store_plain_indices =
-            additional_data.store_plain_indices;
-          dof_info[no].global_base_element_offset =
-            no > 0 ? dof_info[no - 1].global_base_element_offset +
-                       dof_handler[no - 1]->get_fe().n_base_elements() :
-                     0;
-        }
+          initialize_dof_handlers(dof_handler, additional_data);
+          for (unsigned int no = 0; no < dof_handler.size(); ++no)
+            {
+              dof_info[no].store_plain_indices =
+                additional_data.store_plain_indices;
+              dof_info[no].global_base_element_offset =
+                no > 0 ? dof_info[no - 1].global_base_element_offset +
+                           dof_handler[no - 1]->get_fe().n_base_elements() :
+                         0;
+            }
 
-        // initialize the basic multithreading information that needs to be
-        // passed to the DoFInfo structure
+            // initialize the basic multithreading information that needs to be
+            // passed to the DoFInfo structure
 #ifdef DEAL_II_WITH_THREADS
-      if (additional_data.tasks_parallel_scheme != AdditionalData::none &&
-          MultithreadInfo::n_threads() > 1)
-        {
-          task_info.scheme =
-            internal::MatrixFreeFunctions::TaskInfo::TasksParallelScheme(
-              static_cast<int>(additional_data.tasks_parallel_scheme));
-          task_info.block_size = additional_data.tasks_block_size;
-        }
-      else
+          if (additional_data.tasks_parallel_scheme != AdditionalData::none &&
+              MultithreadInfo::n_threads() > 1)
+            {
+              task_info.scheme =
+                internal::MatrixFreeFunctions::TaskInfo::TasksParallelScheme(
+                  static_cast<int>(additional_data.tasks_parallel_scheme));
+              task_info.block_size = additional_data.tasks_block_size;
+            }
+          else
 #endif
-        task_info.scheme = internal::MatrixFreeFunctions::TaskInfo::none;
+            task_info.scheme = internal::MatrixFreeFunctions::TaskInfo::none;
+          task_info.overlap_communication_by_process =
+            additional_data.overlap_communication_by_process &&
+            additional_data.overlap_communication_computation;
+        });
 
       // set dof_indices together with constraint_indicator and
       // constraint_pool_data. It also reorders the way cells are gone through
       // (to separate cells with overlap to other processors from others
-      // without).
-      initialize_indices(constraint, locally_owned_set, additional_data);
+      // without). This needs both the DoFHandler information and the shape
+      // information for the lexicographic renumbering.
+      std::vector<Threads::TaskGraph::TaskIndex> index_dependencies =
+        shape_info_tasks;
+      index_dependencies.push_back(dof_handler_task);
+      setup_tasks.add_task(
+        [&]() {
+          initialize_indices(constraint, locally_owned_set, additional_data);
+        },
+        index_dependencies);
     }
 
   // initialize bare structures
@@ -367,6 +400,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
         }
     }
 
+  setup_tasks.run();
+
   // Evaluates transformations from unit to real cell, Jacobian determinants,
   // quadrature points in real space, based on the ordering of the cells
   // determined in @p extract_local_to_global_indices. The algorithm assumes
@@ -386,7 +421,9 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
         additional_data.mapping_update_flags,
         additional_data.mapping_update_flags_boundary_faces,
         additional_data.mapping_update_flags_inner_faces,
-        additional_data.mapping_update_flags_faces_by_cells);
+        additional_data.mapping_update_flags_faces_by_cells,
+        additional_data.geometry_on_the_fly,
+        additional_data.reuse_cell_geometry);
 
       mapping_is_initialized = true;
     }
@@ -406,6 +443,11 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
   const typename MatrixFree<dim, Number, VectorizedArrayType>::AdditionalData
     &additional_data)
 {
+  // The setup steps below are collected in a task graph, such that the
+  // independent ones can run concurrently, see the DoFHandler version above
+  Threads::TaskGraph                         setup_tasks;
+  std::vector<Threads::TaskGraph::TaskIndex> shape_info_tasks;
+
   // Reads out the FE information and stores the shape function values,
   // gradients and Hessians for quadrature points.
   {
@@ -430,8 +472,11 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
              ++fe_no)
           for (unsigned int nq = 0; nq < n_quad; nq++)
             for (unsigned int q_no = 0; q_no < quad[nq].size(); ++q_no)
-              shape_info(c, nq, fe_no, q_no)
-                .reinit(quad[nq][q_no], dof_handler[no]->get_fe(fe_no), b);
+              shape_info_tasks.push_back(setup_tasks.add_task(
+                [this, &dof_handler, &quad, no, b, c, fe_no, nq, q_no]() {
+                  shape_info(c, nq, fe_no, q_no)
+                    .reinit(quad[nq][q_no], dof_handler[no]->get_fe(fe_no), b);
+                }));
   }
 
   if (additional_data.initialize_indices == true)
@@ -441,58 +486,72 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
       AssertDimension(dof_handler.size(), constraint.size());
       AssertDimension(dof_handler.size(), locally_owned_set.size());
 
-      // set variables that are independent of FE
-      if (Utilities::MPI::job_supports_mpi() == true)
-        {
-          const parallel::Triangulation<dim> *dist_tria =
-            dynamic_cast<const parallel::Triangulation<dim> *>(
-              &(dof_handler[0]->get_triangulation()));
-          task_info.communicator = dist_tria != nullptr ?
-                                     dist_tria->get_communicator() :
-                                     MPI_COMM_SELF;
-          task_info.my_pid =
-            Utilities::MPI::this_mpi_process(task_info.communicator);
-          task_info.n_procs =
-            Utilities::MPI::n_mpi_processes(task_info.communicator);
-        }
-      else
-        {
-          task_info.communicator = MPI_COMM_SELF;
-          task_info.my_pid       = 0;
-          task_info.n_procs      = 1;
-        }
+      const Threads::TaskGraph::TaskIndex dof_handler_task =
+        setup_tasks.add_task([&]() {
+          // set variables that are independent of FE
+          if (Utilities::MPI::job_supports_mpi() == true)
+            {
+              const parallel::Triangulation<dim> *dist_tria =
+                dynamic_cast<const parallel::Triangulation<dim> *>(
+                  &(dof_handler[0]->get_triangulation()));
+              task_info.communicator = dist_tria != nullptr ?
+                                         dist_tria->get_communicator() :
+                                         MPI_COMM_SELF;
+              task_info.my_pid =
+                Utilities::MPI::this_mpi_process(task_info.communicator);
+              task_info.n_procs =
+                Utilities::MPI::n_mpi_processes(task_info.communicator);
+            }
+          else
+            {
+              task_info.communicator = MPI_COMM_SELF;
+              task_info.my_pid       = 0;
+              task_info.n_procs      = 1;
+            }
 
-      initialize_dof_handlers(dof_handler, additional_data);
-      for (unsigned int no = 0; no < dof_handler.size(); ++no)
-        {
-          dof_info[no].store_plain_indices =
-            additional_data.store_plain_indices;
-          dof_info[no].global_base_element_offset =
-            no > 0 ? dof_info[no - 1].global_base_element_offset +
-                       dof_handler[no - 1]->get_fe()[0].n_base_elements() :
-                     0;
-        }
+          initialize_dof_handlers(dof_handler, additional_data);
+          for (unsigned int no = 0; no < dof_handler.size(); ++no)
+            {
+              dof_info[no].store_plain_indices =
+                additional_data.store_plain_indices;
+              dof_info[no].global_base_element_offset =
+                no > 0 ? dof_info[no - 1].global_base_element_offset +
+                           dof_handler[no - 1]->get_fe()[0].n_base_elements() :
+                         0;
+            }
 
-        // initialize the basic multithreading information that needs to be
-        // passed to the DoFInfo structure
+            // initialize the basic multithreading information that needs to be
+            // passed to the DoFInfo structure
 #ifdef DEAL_II_WITH_THREADS
-      if (additional_data.tasks_parallel_scheme != AdditionalData::none &&
-          MultithreadInfo::n_threads() > 1)
-        {
-          task_info.scheme =
-            internal::MatrixFreeFunctions::TaskInfo::TasksParallelScheme(
-              static_cast<int>(additional_data.tasks_parallel_scheme));
-          task_info.block_size = additional_data.tasks_block_size;
-        }
-      else
+          if (additional_data.tasks_parallel_scheme != AdditionalData::none &&
+              MultithreadInfo::n_threads() > 1)
+            {
+              task_info.scheme =
+                internal::MatrixFreeFunctions::TaskInfo::TasksParallelScheme(
+                  static_cast<int>(additional_data.tasks_parallel_scheme));
+              task_info.block_size = additional_data.tasks_block_size;
+            }
+          else
 #endif
-        task_info.scheme = internal::MatrixFreeFunctions::TaskInfo::none;
+            task_info.scheme = internal::MatrixFreeFunctions::TaskInfo::none;
+          task_info.overlap_communication_by_process =
+            additional_data.overlap_communication_by_process &&
+            additional_data.overlap_communication_computation;
+        });
 
       // set dof_indices together with constraint_indicator and
       // constraint_pool_data. It also reorders the way cells are gone through
       // (to separate cells with overlap to other processors from others
-      // without).
-      initialize_indices(constraint, locally_owned_set, additional_data);
+      // without). This needs both the DoFHandler information and the shape
+      // information for the lexicographic renumbering.
+      std::vector<Threads::TaskGraph::TaskIndex> index_dependencies =
+        shape_info_tasks;
+      index_dependencies.push_back(dof_handler_task);
+      setup_tasks.add_task(
+        [&]() {
+          initialize_indices(constraint, locally_owned_set, additional_data);
+        },
+        index_dependencies);
     }
 
   // initialize bare structures
@@ -538,6 +597,8 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
         }
     }
 
+  setup_tasks.run();
+
   // Evaluates transformations from unit to real cell, Jacobian determinants,
   // quadrature points in real space, based on the ordering of the cells
   // determined in @p extract_local_to_global_indices.
@@ -553,7 +614,9 @@ MatrixFree<dim, Number, VectorizedArrayType>::internal_reinit(
         additional_data.mapping_update_flags,
         additional_data.mapping_update_flags_boundary_faces,
         additional_data.mapping_update_flags_inner_faces,
-        additional_data.mapping_update_flags_faces_by_cells);
+        additional_data.mapping_update_flags_faces_by_cells,
+        additional_data.geometry_on_the_fly,
+        additional_data.reuse_cell_geometry);
 
       mapping_is_initialized = true;
     }
@@ -891,6 +954,39 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
             static_cast<unsigned int>(i - start_index));
     }
 
+  // set up the data structures for resolving hanging node constraints on the
+  // fly in FEEvaluation, which is only possible for scalar FE_Q elements
+  // on the active cells
+  std::vector<
+    std::unique_ptr<internal::MatrixFreeFunctions::HangingNodes<dim>>>
+    hanging_nodes(n_fe);
+  if (additional_data.use_fast_hanging_node_algorithm && dim > 1 &&
+      dof_handlers.active_dof_handler == DoFHandlers::usual &&
+      dof_handlers.level == numbers::invalid_unsigned_int)
+    {
+      AssertThrow(do_face_integrals == false,
+                  ExcNotImplemented("The fast hanging node algorithm is "
+                                    "only implemented for cell integrals."));
+      for (unsigned int no = 0; no < n_fe; ++no)
+        {
+          const DoFHandler<dim> &   dofh = *dof_handlers.dof_handler[no];
+          const FiniteElement<dim> &fe   = dofh.get_fe();
+          if (fe.n_components() == 1 &&
+              dynamic_cast<const FE_Q<dim> *>(&fe) != nullptr &&
+              dofh.get_triangulation().has_hanging_nodes() &&
+              shape_info(dof_info[no].global_base_element_offset, 0, 0, 0)
+                  .subface_interpolation_matrix.size() > 0)
+            {
+              hanging_nodes[no] = std_cxx14::make_unique<
+                internal::MatrixFreeFunctions::HangingNodes<dim>>(
+                fe.degree, dofh, lexicographic[no][0]);
+              dof_info[no].hanging_node_constraint_masks.resize(
+                n_active_cells, 0);
+            }
+        }
+    }
+  std::vector<types::global_dof_index> local_dof_indices_plain;
+
   // extract all the global indices associated with the computation, and form
   // the ghost indices
   std::vector<unsigned int> subdomain_boundary_cells;
@@ -916,12 +1012,21 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
                 dofh);
               local_dof_indices.resize(dof_info[no].dofs_per_cell[0]);
               cell_it->get_dof_indices(local_dof_indices);
+              if (hanging_nodes[no] && counter < cell_level_index_end_local)
+                {
+                  local_dof_indices_plain = local_dof_indices;
+                  hanging_nodes[no]->setup_constraints(
+                    cell_it,
+                    local_dof_indices,
+                    dof_info[no].hanging_node_constraint_masks[counter]);
+                }
               dof_info[no].read_dof_indices(local_dof_indices,
                                             lexicographic[no][0],
                                             *constraint[no],
                                             counter,
                                             constraint_values,
-                                            cell_at_subdomain_boundary);
+                                            cell_at_subdomain_boundary,
+                                            local_dof_indices_plain);
               if (cell_categorization_enabled)
                 {
                   AssertIndexRange(
@@ -1466,14 +1571,14 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
                                          dof_info[no].start_components.back()]
                              .first;
                        ++i)
-                    if (dof_info[no].dof_indices[i] > part.local_size())
+                    if (dof_info[no].dof_indices[i] >= part.local_size())
                       ghost_indices.push_back(
                         part.local_to_global(dof_info[no].dof_indices[i]));
                   for (unsigned int i =
                          dof_info[no].row_starts_plain_indices[cell];
                        i < dof_info[no].row_starts_plain_indices[cell + 1];
                        ++i)
-                    if (dof_info[no].plain_dof_indices[i] > part.local_size())
+                    if (dof_info[no].plain_dof_indices[i] >= part.local_size())
                       ghost_indices.push_back(part.local_to_global(
                         dof_info[no].plain_dof_indices[i]));
                 }
@@ -1496,15 +1601,35 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
                 dof_info[no].vector_partitioner;
             else
               {
-                dof_info[no].vector_partitioner_face_variants[0].reset(
-                  new Utilities::MPI::Partitioner(part.locally_owned_range(),
-                                                  part.get_mpi_communicator()));
-                const_cast<Utilities::MPI::Partitioner *>(
-                  dof_info[no].vector_partitioner_face_variants[0].get())
-                  ->set_ghost_indices(compressed_set, part.ghost_indices());
+                dof_info[no].vector_partitioner_face_variants[0] =
+                  Utilities::MPI::Partitioner::create_shared(
+                    part.locally_owned_range(),
+                    compressed_set,
+                    part.get_mpi_communicator(),
+                    part.ghost_indices());
               }
           }
 
+          // Exterior cells without contiguous index storage are read in
+          // full by FEFaceEvaluation, so all their ghost indices must be
+          // imported also for the reduced exchange
+          const auto add_ghost_indices_of_cell =
+            [&](const unsigned int cell) {
+              for (unsigned int i =
+                     dof_info[no]
+                       .row_starts[cell * dof_info[no].start_components.back()]
+                       .first;
+                   i <
+                   dof_info[no]
+                     .row_starts[(cell + 1) *
+                                 dof_info[no].start_components.back()]
+                     .first;
+                   ++i)
+                if (dof_info[no].dof_indices[i] >= part.local_size())
+                  ghost_indices.push_back(
+                    part.local_to_global(dof_info[no].dof_indices[i]));
+            };
+
           // partitioner 1: values on faces
           {
             bool all_nodal = true;
@@ -1518,7 +1643,6 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
                 dof_info[no].vector_partitioner;
             else
               {
-                bool has_noncontiguous_cell = false;
                 for (unsigned int f = 0; f < n_inner_face_batches(); ++f)
                   for (unsigned int v = 0;
                        v < VectorizedArrayType::n_array_elements &&
@@ -1581,11 +1705,9 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
                                     dof_access_face_exterior][f] <
                                internal::MatrixFreeFunctions::DoFInfo::
                                  IndexStorageVariants::contiguous)
-                        has_noncontiguous_cell = true;
+                        add_ghost_indices_of_cell(
+                          face_info.faces[f].cells_exterior[v]);
                     }
-                has_noncontiguous_cell =
-                  Utilities::MPI::min<int>(has_noncontiguous_cell,
-                                           task_info.communicator) != 0;
 
                 std::sort(ghost_indices.begin(), ghost_indices.end());
                 ghost_indices.erase(std::unique(ghost_indices.begin(),
@@ -1604,18 +1726,17 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
                         .n_elements(),
                     dof_info[no].vector_partitioner->get_mpi_communicator()) !=
                   0;
-                if (all_ghosts_equal || has_noncontiguous_cell)
+                if (all_ghosts_equal)
                   dof_info[no].vector_partitioner_face_variants[1] =
                     dof_info[no].vector_partitioner;
                 else
                   {
-                    dof_info[no].vector_partitioner_face_variants[1].reset(
-                      new Utilities::MPI::Partitioner(
+                    dof_info[no].vector_partitioner_face_variants[1] =
+                      Utilities::MPI::Partitioner::create_shared(
                         part.locally_owned_range(),
-                        part.get_mpi_communicator()));
-                    const_cast<Utilities::MPI::Partitioner *>(
-                      dof_info[no].vector_partitioner_face_variants[1].get())
-                      ->set_ghost_indices(compressed_set, part.ghost_indices());
+                        compressed_set,
+                        part.get_mpi_communicator(),
+                        part.ghost_indices());
                   }
               }
           }
@@ -1693,6 +1814,13 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
                                           dof_info[no].dofs_per_cell[0] *
                                             stride);
                         }
+                      else if (dof_info[no].index_storage_variants
+                                 [internal::MatrixFreeFunctions::DoFInfo::
+                                    dof_access_face_exterior][f] <
+                               internal::MatrixFreeFunctions::DoFInfo::
+                                 IndexStorageVariants::contiguous)
+                        add_ghost_indices_of_cell(
+                          face_info.faces[f].cells_exterior[v]);
                     }
                 std::sort(ghost_indices.begin(), ghost_indices.end());
                 ghost_indices.erase(std::unique(ghost_indices.begin(),
@@ -1716,13 +1844,12 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
                     dof_info[no].vector_partitioner;
                 else
                   {
-                    dof_info[no].vector_partitioner_face_variants[2].reset(
-                      new Utilities::MPI::Partitioner(
+                    dof_info[no].vector_partitioner_face_variants[2] =
+                      Utilities::MPI::Partitioner::create_shared(
                         part.locally_owned_range(),
-                        part.get_mpi_communicator()));
-                    const_cast<Utilities::MPI::Partitioner *>(
-                      dof_info[no].vector_partitioner_face_variants[2].get())
-                      ->set_ghost_indices(compressed_set, part.ghost_indices());
+                        compressed_set,
+                        part.get_mpi_communicator(),
+                        part.ghost_indices());
                   }
               }
           }
@@ -1730,7 +1857,12 @@ MatrixFree<dim, Number, VectorizedArrayType>::initialize_indices(
     }
 
   for (unsigned int no = 0; no < n_fe; ++no)
-    dof_info[no].compute_vector_zero_access_pattern(task_info, face_info.faces);
+    {
+      dof_info[no].compute_vector_zero_access_pattern(task_info,
+                                                      face_info.faces);
+      if (task_info.overlap_communication_by_process)
+        dof_info[no].compute_ghost_targets_by_range(task_info, face_info.faces);
+    }
 
   indices_are_initialized = true;
 }
@@ -1972,6 +2104,240 @@ MatrixFree<dim, Number, VectorizedArrayType>::print_memory_consumption(
 
 
 
+template <int dim, typename Number, typename VectorizedArrayType>
+MatrixFree<dim, Number, VectorizedArrayType>::MemoryStatistics::
+  MemoryStatistics()
+  : total(0)
+  , cell_index(0)
+  , constraint_pool(0)
+  , face_mapping(0)
+  , other_mapping(0)
+  , face_info(0)
+  , shape_info(0)
+  , task_info(0)
+{
+  cell_mapping.fill(0);
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+void
+MatrixFree<dim, Number, VectorizedArrayType>::MemoryStatistics::print(
+  std::ostream &out) const
+{
+  static const char *geometry_names[4] = {"Cartesian",
+                                          "affine",
+                                          "flat faces",
+                                          "general"};
+
+  out << "Memory matrix-free data total:      " << total << " bytes"
+      << std::endl;
+  out << "  Cell index:                       " << cell_index << " bytes"
+      << std::endl;
+  for (unsigned int j = 0; j < dof_info.size(); ++j)
+    out << "  DoFInfo component " << j << ":              " << dof_info[j]
+        << " bytes" << std::endl;
+  out << "  Constraint pool:                  " << constraint_pool << " bytes"
+      << std::endl;
+  for (unsigned int t = 0; t < cell_mapping.size(); ++t)
+    out << "  Cell mapping, " << std::left << std::setw(20)
+        << (std::string(geometry_names[t]) + ':') << std::right
+        << cell_mapping[t] << " bytes" << std::endl;
+  out << "  Face mapping:                     " << face_mapping << " bytes"
+      << std::endl;
+  out << "  Other mapping data:               " << other_mapping << " bytes"
+      << std::endl;
+  out << "  Face indicators:                  " << face_info << " bytes"
+      << std::endl;
+  out << "  Unit cell shape data:             " << shape_info << " bytes"
+      << std::endl;
+  out << "  Task partitioning info:           " << task_info << " bytes"
+      << std::endl;
+  for (unsigned int j = 0; j < bytes_per_dof.size(); ++j)
+    out << "Estimated transfer per DoF, component " << j << ": "
+        << bytes_per_dof[j] << " bytes" << std::endl;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+void
+MatrixFree<dim, Number, VectorizedArrayType>::MemoryStatistics::write_json(
+  std::ostream &out) const
+{
+  boost::property_tree::ptree tree;
+  tree.put("total", total);
+  tree.put("cell_index", cell_index);
+
+  boost::property_tree::ptree dof_info_tree;
+  for (const std::size_t memory : dof_info)
+    {
+      boost::property_tree::ptree entry;
+      entry.put("", memory);
+      dof_info_tree.push_back(std::make_pair("", entry));
+    }
+  tree.add_child("dof_info", dof_info_tree);
+
+  tree.put("constraint_pool", constraint_pool);
+  tree.put("cell_mapping.cartesian", cell_mapping[0]);
+  tree.put("cell_mapping.affine", cell_mapping[1]);
+  tree.put("cell_mapping.flat_faces", cell_mapping[2]);
+  tree.put("cell_mapping.general", cell_mapping[3]);
+  tree.put("face_mapping", face_mapping);
+  tree.put("other_mapping", other_mapping);
+  tree.put("face_info", face_info);
+  tree.put("shape_info", shape_info);
+  tree.put("task_info", task_info);
+
+  boost::property_tree::ptree bytes_per_dof_tree;
+  for (const double bytes : bytes_per_dof)
+    {
+      boost::property_tree::ptree entry;
+      entry.put("", bytes);
+      bytes_per_dof_tree.push_back(std::make_pair("", entry));
+    }
+  tree.add_child("bytes_per_dof", bytes_per_dof_tree);
+
+  boost::property_tree::write_json(out, tree);
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+typename MatrixFree<dim, Number, VectorizedArrayType>::MemoryStatistics
+MatrixFree<dim, Number, VectorizedArrayType>::get_memory_statistics(
+  const unsigned int quad_index) const
+{
+  MemoryStatistics statistics;
+  statistics.total      = memory_consumption();
+  statistics.cell_index = MemoryConsumption::memory_consumption(
+    cell_level_index);
+  for (const auto &info : dof_info)
+    statistics.dof_info.push_back(MemoryConsumption::memory_consumption(info));
+  statistics.constraint_pool =
+    MemoryConsumption::memory_consumption(constraint_pool_data) +
+    MemoryConsumption::memory_consumption(constraint_pool_row_index);
+  statistics.face_info  = MemoryConsumption::memory_consumption(face_info);
+  statistics.shape_info = MemoryConsumption::memory_consumption(shape_info);
+  statistics.task_info  = MemoryConsumption::memory_consumption(task_info);
+
+  // split the cell data of the mapping by the geometry type of the cell
+  // batches, according to the number of entries of each batch. Cartesian and
+  // affine batches share the entries of a common block of constant
+  // Jacobians, so each distinct entry of that block is only counted once,
+  // whereas the other batches store one entry per quadrature point
+  std::size_t mapping_memory_cells = 0;
+  for (const auto &data : mapping_info.cell_data)
+    {
+      const std::size_t memory = data.memory_consumption();
+      mapping_memory_cells += memory;
+
+      const unsigned int n_batches =
+        std::min<std::size_t>(data.data_index_offsets.size(),
+                              mapping_info.cell_type.size());
+      std::array<std::size_t, 4> n_entries;
+      n_entries.fill(0);
+      std::set<unsigned int> constant_jacobian_indices;
+      for (unsigned int c = 0; c < n_batches; ++c)
+        {
+          const internal::MatrixFreeFunctions::GeometryType type =
+            mapping_info.cell_type[c];
+          if (type <= internal::MatrixFreeFunctions::affine)
+            {
+              if (constant_jacobian_indices
+                    .insert(data.data_index_offsets[c])
+                    .second)
+                ++n_entries[type];
+            }
+          else
+            {
+              const unsigned int fe_index =
+                (data.descriptor.size() > 1 &&
+                 c < dof_info[0].cell_active_fe_index.size()) ?
+                  dof_info[0].cell_active_fe_index[c] :
+                  0;
+              n_entries[type] += data.descriptor[fe_index].n_q_points;
+            }
+        }
+      const std::size_t n_total_entries =
+        n_entries[0] + n_entries[1] + n_entries[2] + n_entries[3];
+      if (n_total_entries == 0)
+        statistics.cell_mapping[internal::MatrixFreeFunctions::general] +=
+          memory;
+      else
+        for (unsigned int t = 0; t < 4; ++t)
+          statistics.cell_mapping[t] += static_cast<std::size_t>(
+            static_cast<double>(memory) * n_entries[t] / n_total_entries);
+    }
+  for (const auto &data : mapping_info.face_data)
+    statistics.face_mapping += data.memory_consumption();
+  for (const auto &data : mapping_info.face_data_by_cells)
+    statistics.face_mapping += data.memory_consumption();
+  const std::size_t mapping_memory = mapping_info.memory_consumption();
+  statistics.other_mapping =
+    mapping_memory > mapping_memory_cells + statistics.face_mapping ?
+      mapping_memory - mapping_memory_cells - statistics.face_mapping :
+      0;
+
+  // estimate the memory transfer of a cell loop for each DoFHandler
+  constexpr unsigned int n_lanes = VectorizedArrayType::n_array_elements;
+  std::size_t            mapping_bytes =
+    mapping_info.cell_type.size() *
+    sizeof(internal::MatrixFreeFunctions::GeometryType);
+  if (quad_index < mapping_info.cell_data.size())
+    {
+      const auto &data = mapping_info.cell_data[quad_index];
+      mapping_bytes +=
+        MemoryConsumption::memory_consumption(data.data_index_offsets) +
+        MemoryConsumption::memory_consumption(data.JxW_values) +
+        MemoryConsumption::memory_consumption(data.jacobians[0]);
+    }
+  for (const auto &info : dof_info)
+    {
+      using IndexStorageVariants =
+        internal::MatrixFreeFunctions::DoFInfo::IndexStorageVariants;
+      const unsigned int n_batches =
+        std::min<std::size_t>(n_cell_batches(),
+                              info.index_storage_variants[2].size());
+      std::size_t index_bytes = 0;
+      for (unsigned int cell = 0; cell < n_batches; ++cell)
+        if (info.index_storage_variants[2][cell] >=
+            IndexStorageVariants::contiguous)
+          index_bytes += n_lanes * sizeof(unsigned int);
+        else if ((cell + 1) * n_lanes < info.row_starts.size())
+          {
+            const auto &start = info.row_starts[cell * n_lanes];
+            const auto &end   = info.row_starts[(cell + 1) * n_lanes];
+            index_bytes +=
+              (end.first - start.first) * sizeof(unsigned int) +
+              (end.second - start.second) *
+                sizeof(std::pair<unsigned short, unsigned short>) +
+              n_lanes * sizeof(std::pair<unsigned int, unsigned int>);
+          }
+
+      std::size_t n_owned = 0, n_ghosts = 0;
+      if (info.vector_partitioner.get() != nullptr)
+        {
+          n_owned  = info.vector_partitioner->local_size();
+          n_ghosts = info.vector_partitioner->n_ghost_indices();
+        }
+      const std::size_t vector_bytes =
+        (3 * n_owned + n_ghosts) * sizeof(Number);
+
+      statistics.bytes_per_dof.push_back(
+        n_owned > 0 ? static_cast<double>(vector_bytes + index_bytes +
+                                          mapping_bytes +
+                                          statistics.constraint_pool) /
+                        n_owned :
+                      0.);
+    }
+
+  return statistics;
+}
+
+
+
 template <int dim, typename Number, typename VectorizedArrayType>
 void
 MatrixFree<dim, Number, VectorizedArrayType>::print(std::ostream &out) const
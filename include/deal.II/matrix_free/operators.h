@@ -606,6 +606,23 @@ namespace MatrixFreeOperators
    * provide a helper method 'fill_inverse_JxW_values' to get the inverse of a
    * constant-coefficient operator).
    *
+   * If the evaluation object has more quadrature points than degrees of
+   * freedom per direction, as for over-integrated discontinuous Galerkin
+   * methods, the mass matrix is not diagonal in the quadrature points
+   * anymore. In that case, this class applies the weight-adjusted
+   * approximation $M^{-1} S \text{diag}(w_q/(J_q c_q)) S^T M^{-1}$ of the
+   * inverse, where $M$ is the mass matrix on the reference cell, $S$ the
+   * matrix of shape values in the quadrature points, $w_q$ the quadrature
+   * weights, $J_q$ the Jacobian determinants and $c_q$ the coefficient. The
+   * inverse of the reference mass matrix is a tensor product of 1D inverses,
+   * so the cost is again that of applying the forward operator. The result
+   * is the exact inverse on cells with a constant Jacobian determinant and
+   * constant coefficient, such as affine cells, and a spectrally equivalent
+   * approximation with an error that decreases with the variation of the
+   * geometry and the coefficient within the cell otherwise. The coefficient
+   * array is defined in the quadrature points in both cases, see
+   * fill_inverse_JxW_values().
+   *
    * @author Martin Kronbichler, 2014
    */
   template <int dim,
@@ -635,9 +652,9 @@ namespace MatrixFreeOperators
      * Applies the inverse mass matrix operation on an input array. It is
      * assumed that the passed input and output arrays are of correct size,
      * namely FEEval::dofs_per_cell * n_components long. The inverse of the
-     * local coefficient (also containing the inverse JxW values) must be
-     * passed as first argument. Passing more than one component in the
-     * coefficient is allowed.
+     * local coefficient (also containing the inverse JxW values) in the
+     * quadrature points must be passed as first argument. Passing more than
+     * one component in the coefficient is allowed.
      */
     void
     apply(const AlignedVector<VectorizedArrayType> &inverse_coefficient,
@@ -677,6 +694,10 @@ namespace MatrixFreeOperators
      * and the first half of the transformation to the quadrature points,
      * reducing the number of tensor product calls from 3*dim*n_components to
      * dim*n_components.
+     *
+     * If there are more quadrature points than degrees of freedom per
+     * direction, this function computes the L2 projection of the values in
+     * the quadrature points onto the basis on the reference cell.
      */
     void
     transform_from_q_points_to_basis(const unsigned int n_actual_components,
@@ -706,6 +727,28 @@ namespace MatrixFreeOperators
      * A structure to hold inverse shape functions
      */
     AlignedVector<VectorizedArrayType> inverse_shape;
+
+    /**
+     * The number of quadrature points per direction of @p fe_eval.
+     */
+    const unsigned int n_q_points_1d;
+
+    /**
+     * Temporary storage for the values in the quadrature points if there are
+     * more quadrature points than degrees of freedom per direction.
+     */
+    mutable AlignedVector<VectorizedArrayType> temporary_data;
+
+    /**
+     * Implementation of apply() for the case with more quadrature points
+     * than degrees of freedom per direction.
+     */
+    void
+    apply_weight_adjusted(
+      const AlignedVector<VectorizedArrayType> &inverse_coefficients,
+      const unsigned int                        n_actual_components,
+      const VectorizedArrayType *               in_array,
+      VectorizedArrayType *                     out_array) const;
   };
 
 
@@ -942,7 +985,19 @@ namespace MatrixFreeOperators
                              false,
                              VectorizedArrayType> &fe_eval)
     : fe_eval(fe_eval)
+    , n_q_points_1d(fe_eval.get_shape_info().n_q_points_1d)
   {
+    if (n_q_points_1d != fe_degree + 1)
+      {
+        Assert(fe_eval.get_shape_info().inverse_shape_values.size() ==
+                 (fe_degree + 1) * n_q_points_1d,
+               ExcMessage("The inverse mass matrix needs at least as many "
+                          "quadrature points as degrees of freedom per "
+                          "direction of a tensor product element."));
+        temporary_data.resize(2 * Utilities::fixed_power<dim>(n_q_points_1d));
+        return;
+      }
+
     FullMatrix<double> shapes_1d(fe_degree + 1, fe_degree + 1);
     for (unsigned int i = 0, c = 0; i < shapes_1d.m(); ++i)
       for (unsigned int j = 0; j < shapes_1d.n(); ++j, ++c)
@@ -979,20 +1034,18 @@ namespace MatrixFreeOperators
     fill_inverse_JxW_values(
       AlignedVector<VectorizedArrayType> &inverse_jxw) const
   {
-    constexpr unsigned int dofs_per_component_on_cell =
-      Utilities::pow(fe_degree + 1, dim);
-    Assert(inverse_jxw.size() > 0 &&
-             inverse_jxw.size() % dofs_per_component_on_cell == 0,
+    const unsigned int n_q_points = Utilities::fixed_power<dim>(n_q_points_1d);
+    Assert(inverse_jxw.size() > 0 && inverse_jxw.size() % n_q_points == 0,
            ExcMessage(
-             "Expected diagonal to be a multiple of scalar dof per cells"));
+             "Expected diagonal to be a multiple of scalar quadrature points"));
 
-    // temporarily reduce size of inverse_jxw to dofs_per_cell to get JxW values
+    // temporarily reduce size of inverse_jxw to n_q_points to get JxW values
     // from fe_eval (will not reallocate any memory)
-    for (unsigned int q = 0; q < dofs_per_component_on_cell; ++q)
+    for (unsigned int q = 0; q < n_q_points; ++q)
       inverse_jxw[q] = 1. / fe_eval.JxW(q);
     // copy values to rest of vector
-    for (unsigned int q = dofs_per_component_on_cell; q < inverse_jxw.size();)
-      for (unsigned int i = 0; i < dofs_per_component_on_cell; ++i, ++q)
+    for (unsigned int q = n_q_points; q < inverse_jxw.size();)
+      for (unsigned int i = 0; i < n_q_points; ++i, ++q)
         inverse_jxw[q] = inverse_jxw[i];
   }
 
@@ -1014,6 +1067,15 @@ namespace MatrixFreeOperators
           const VectorizedArrayType *               in_array,
           VectorizedArrayType *                     out_array) const
   {
+    if (n_q_points_1d != fe_degree + 1)
+      {
+        apply_weight_adjusted(inverse_coefficients,
+                              n_actual_components,
+                              in_array,
+                              out_array);
+        return;
+      }
+
     constexpr unsigned int dofs_per_component =
       Utilities::pow(fe_degree + 1, dim);
     Assert(inverse_coefficients.size() > 0 &&
@@ -1076,6 +1138,94 @@ namespace MatrixFreeOperators
 
 
 
+  template <int dim,
+            int fe_degree,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType>
+  inline void
+  CellwiseInverseMassMatrix<dim,
+                            fe_degree,
+                            n_components,
+                            Number,
+                            VectorizedArrayType>::
+    apply_weight_adjusted(
+      const AlignedVector<VectorizedArrayType> &inverse_coefficients,
+      const unsigned int                        n_actual_components,
+      const VectorizedArrayType *               in_array,
+      VectorizedArrayType *                     out_array) const
+  {
+    constexpr unsigned int dofs_per_component =
+      Utilities::pow(fe_degree + 1, dim);
+    const unsigned int n_q_points = Utilities::fixed_power<dim>(n_q_points_1d);
+    Assert(inverse_coefficients.size() > 0 &&
+             inverse_coefficients.size() % n_q_points == 0,
+           ExcMessage(
+             "Expected diagonal to be a multiple of scalar quadrature points"));
+    if (inverse_coefficients.size() != n_q_points)
+      AssertDimension(n_actual_components * n_q_points,
+                      inverse_coefficients.size());
+
+    // with the L2 projection P = M^{-1} S W from the quadrature points onto
+    // the basis, P diag(1/(J w c)) P^T equals M^{-1} S diag(w/(J c)) S^T
+    // M^{-1}, which is the exact inverse for constant J and c
+    internal::EvaluatorTensorProduct<internal::evaluate_general,
+                                     dim,
+                                     0,
+                                     0,
+                                     VectorizedArrayType>
+      evaluator(fe_eval.get_shape_info().inverse_shape_values,
+                AlignedVector<VectorizedArrayType>(),
+                AlignedVector<VectorizedArrayType>(),
+                fe_degree + 1,
+                n_q_points_1d);
+
+    const unsigned int shift_coefficient =
+      inverse_coefficients.size() > n_q_points ? n_q_points : 0;
+    const VectorizedArrayType *inv_coefficient = inverse_coefficients.data();
+    VectorizedArrayType *      temp1           = temporary_data.begin();
+    VectorizedArrayType *      temp2           = temp1 + n_q_points;
+    for (unsigned int d = 0; d < n_actual_components; ++d)
+      {
+        const VectorizedArrayType *in  = in_array + d * dofs_per_component;
+        VectorizedArrayType *      out = out_array + d * dofs_per_component;
+        if (dim == 3)
+          {
+            evaluator.template values<0, true, false>(in, temp1);
+            evaluator.template values<1, true, false>(temp1, temp2);
+            evaluator.template values<2, true, false>(temp2, temp1);
+          }
+        if (dim == 2)
+          {
+            evaluator.template values<0, true, false>(in, temp2);
+            evaluator.template values<1, true, false>(temp2, temp1);
+          }
+        if (dim == 1)
+          evaluator.template values<0, true, false>(in, temp1);
+
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          temp1[q] *= inv_coefficient[q];
+
+        if (dim == 3)
+          {
+            evaluator.template values<2, false, false>(temp1, temp2);
+            evaluator.template values<1, false, false>(temp2, temp1);
+            evaluator.template values<0, false, false>(temp1, out);
+          }
+        if (dim == 2)
+          {
+            evaluator.template values<1, false, false>(temp1, temp2);
+            evaluator.template values<0, false, false>(temp2, out);
+          }
+        if (dim == 1)
+          evaluator.template values<0, false, false>(temp1, out);
+
+        inv_coefficient += shift_coefficient;
+      }
+  }
+
+
+
   template <int dim,
             int fe_degree,
             int n_components,
@@ -1092,6 +1242,44 @@ namespace MatrixFreeOperators
                                      VectorizedArrayType *      out_array) const
   {
     constexpr unsigned int dofs_per_cell = Utilities::pow(fe_degree + 1, dim);
+    if (n_q_points_1d != fe_degree + 1)
+      {
+        const unsigned int n_q_points =
+          Utilities::fixed_power<dim>(n_q_points_1d);
+        internal::EvaluatorTensorProduct<internal::evaluate_general,
+                                         dim,
+                                         0,
+                                         0,
+                                         VectorizedArrayType>
+          evaluator(fe_eval.get_shape_info().inverse_shape_values,
+                    AlignedVector<VectorizedArrayType>(),
+                    AlignedVector<VectorizedArrayType>(),
+                    fe_degree + 1,
+                    n_q_points_1d);
+        VectorizedArrayType *temp = temporary_data.begin();
+        for (unsigned int d = 0; d < n_actual_components; ++d)
+          {
+            const VectorizedArrayType *in  = in_array + d * n_q_points;
+            VectorizedArrayType *      out = out_array + d * dofs_per_cell;
+            if (dim == 3)
+              {
+                evaluator.template values<2, false, false>(in, temp);
+                evaluator.template values<1, false, false>(temp,
+                                                           temp + n_q_points);
+                evaluator.template values<0, false, false>(temp + n_q_points,
+                                                           out);
+              }
+            if (dim == 2)
+              {
+                evaluator.template values<1, false, false>(in, temp);
+                evaluator.template values<0, false, false>(temp, out);
+              }
+            if (dim == 1)
+              evaluator.template values<0, false, false>(in, out);
+          }
+        return;
+      }
+
     internal::EvaluatorTensorProduct<internal::evaluate_evenodd,
                                      dim,
                                      fe_degree + 1,
@@ -20,7 +20,10 @@
 
 #include <deal.II/base/aligned_vector.h>
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/point.h>
 #include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/fe/fe.h>
 
@@ -132,6 +135,16 @@ namespace internal
              const FiniteElement<dim> &fe_dim,
              const unsigned int        base_element = 0);
 
+      /**
+       * Initializes the data fields from another object of the same element
+       * and quadrature formula but a different number type, e.g. to obtain
+       * the shape information for single precision from the one computed in
+       * double precision without evaluating the finite element again.
+       */
+      template <typename Number2>
+      void
+      copy_from(const ShapeInfo<Number2> &other);
+
       /**
        * Return the memory consumption of this class in bytes.
        */
@@ -232,6 +245,33 @@ namespace internal
        */
       AlignedVector<Number> hessians_within_subface[2];
 
+      /**
+       * Stores the one-dimensional values of the shape functions in the
+       * support points of the first half of the unit interval, i.e., entry
+       * <tt>i*(fe_degree+1)+j</tt> holds the value of the shape function @p j
+       * in the lexicographic numbering at the scaled support point
+       * <tt>x_i/2</tt>. This is the interpolation matrix from a coarse face to
+       * the first child face and is used to resolve hanging node constraints
+       * on the fly.
+       *
+       * @note This object is only filled for elements with support points
+       * that are nodal at the cell boundaries.
+       */
+      AlignedVector<Number> subface_interpolation_matrix;
+
+      /**
+       * Stores the one-dimensional L2 projection from the quadrature points
+       * onto the shape functions, $P = M^{-1} S W$, where $S$ holds the shape
+       * values in the quadrature points, $W$ the quadrature weights, and
+       * $M = S W S^T$ is the 1D mass matrix. The layout is the same as for
+       * @p shape_values, with <tt>n_dofs_1d * n_q_points_1d</tt> entries and
+       * the quadrature points running fastest.
+       *
+       * @note This object is only filled for tensor product elements with at
+       * least as many quadrature points as shape functions per direction.
+       */
+      AlignedVector<Number> inverse_shape_values;
+
       /**
        * Renumbering from deal.II's numbering of cell degrees of freedom to
        * lexicographic numbering used inside the FEEvaluation schemes of the
@@ -279,6 +319,19 @@ namespace internal
        */
       bool nodal_at_cell_boundaries;
 
+      /**
+       * Indicates whether the 1D shape values evaluated in the quadrature
+       * points form the identity matrix, i.e., whether the nodes of the
+       * basis functions coincide with the quadrature points. Besides
+       * ElementType::tensor_symmetric_collocation, this is also detected for
+       * elements of type ElementType::tensor_general, e.g. FE_DGQArbitraryNodes
+       * based on Gauss-Radau points combined with the same quadrature
+       * formula. In that case, FEEvaluation can skip the interpolation of
+       * values and only needs to apply the (non-symmetric) 1D derivative
+       * matrices.
+       */
+      bool shape_values_identity;
+
       /**
        * For nodal basis functions with nodes located at the boundary of the
        * unit cell, face integrals that involve only the values of the shape
@@ -364,10 +417,11 @@ namespace internal
       check_1d_shapes_symmetric(const unsigned int n_q_points_1d);
 
       /**
-       * Check whether symmetric 1D basis functions are such that the shape
-       * values form a diagonal matrix, i.e., the nodal points are collocated
-       * with the quadrature points. This allows for specialized algorithms
-       * that save some operations in the evaluation.
+       * Check whether the 1D basis functions are such that the shape values
+       * form a diagonal matrix, i.e., the nodal points are collocated with
+       * the quadrature points. This allows for specialized algorithms that
+       * save some operations in the evaluation. The check does not rely on
+       * symmetry of the basis functions.
        */
       bool
       check_1d_shapes_collocation();
@@ -375,6 +429,66 @@ namespace internal
 
 
 
+    /**
+     * Helper functions to copy data between data structures with different
+     * number types, converting each scalar entry. Used to set up the
+     * matrix-free data structures in single precision from the ones computed
+     * in double precision, see MatrixFree::copy_from().
+     */
+    template <typename Number, typename Number2>
+    inline void
+    convert_number_type(const Number2 &in, Number &out)
+    {
+      out = in;
+    }
+
+
+
+    template <typename Number, typename Number2, int width>
+    inline void
+    convert_number_type(const VectorizedArray<Number2, width> &in,
+                        VectorizedArray<Number, width> &       out)
+    {
+      for (unsigned int v = 0;
+           v < VectorizedArray<Number, width>::n_array_elements;
+           ++v)
+        out[v] = in[v];
+    }
+
+
+
+    template <int rank, int dim, typename Number, typename Number2>
+    inline void
+    convert_number_type(const Tensor<rank, dim, Number2> &in,
+                        Tensor<rank, dim, Number> &       out)
+    {
+      for (unsigned int d = 0; d < dim; ++d)
+        convert_number_type(in[d], out[d]);
+    }
+
+
+
+    template <int dim, typename Number, typename Number2>
+    inline void
+    convert_number_type(const Point<dim, Number2> &in, Point<dim, Number> &out)
+    {
+      for (unsigned int d = 0; d < dim; ++d)
+        convert_number_type(in[d], out[d]);
+    }
+
+
+
+    template <typename T, typename T2>
+    inline void
+    convert_number_type(const AlignedVector<T2> &in, AlignedVector<T> &out)
+    {
+      out.resize_fast(in.size());
+      for (unsigned int i = 0; i < in.size(); ++i)
+        convert_number_type(in[i], out[i]);
+    }
+
+
+
     // ------------------------------------------ inline functions
 
     template <typename Number>
@@ -390,10 +504,56 @@ namespace internal
       , n_q_points_face(0)
       , dofs_per_component_on_face(0)
       , nodal_at_cell_boundaries(false)
+      , shape_values_identity(false)
     {
       reinit(quad, fe_in, base_element_number);
     }
 
+
+
+    template <typename Number>
+    template <typename Number2>
+    inline void
+    ShapeInfo<Number>::copy_from(const ShapeInfo<Number2> &other)
+    {
+      element_type = other.element_type;
+      convert_number_type(other.shape_values, shape_values);
+      convert_number_type(other.shape_gradients, shape_gradients);
+      convert_number_type(other.shape_hessians, shape_hessians);
+      convert_number_type(other.shape_values_eo, shape_values_eo);
+      convert_number_type(other.shape_gradients_eo, shape_gradients_eo);
+      convert_number_type(other.shape_hessians_eo, shape_hessians_eo);
+      convert_number_type(other.shape_gradients_collocation_eo,
+                          shape_gradients_collocation_eo);
+      convert_number_type(other.shape_hessians_collocation_eo,
+                          shape_hessians_collocation_eo);
+      for (unsigned int i = 0; i < 2; ++i)
+        {
+          convert_number_type(other.shape_data_on_face[i],
+                              shape_data_on_face[i]);
+          convert_number_type(other.values_within_subface[i],
+                              values_within_subface[i]);
+          convert_number_type(other.gradients_within_subface[i],
+                              gradients_within_subface[i]);
+          convert_number_type(other.hessians_within_subface[i],
+                              hessians_within_subface[i]);
+        }
+      convert_number_type(other.subface_interpolation_matrix,
+                          subface_interpolation_matrix);
+      convert_number_type(other.inverse_shape_values, inverse_shape_values);
+      lexicographic_numbering    = other.lexicographic_numbering;
+      fe_degree                  = other.fe_degree;
+      n_q_points_1d              = other.n_q_points_1d;
+      n_q_points                 = other.n_q_points;
+      dofs_per_component_on_cell = other.dofs_per_component_on_cell;
+      n_q_points_face            = other.n_q_points_face;
+      dofs_per_component_on_face = other.dofs_per_component_on_face;
+      nodal_at_cell_boundaries   = other.nodal_at_cell_boundaries;
+      shape_values_identity      = other.shape_values_identity;
+      face_to_cell_index_nodal   = other.face_to_cell_index_nodal;
+      face_to_cell_index_hermite = other.face_to_cell_index_hermite;
+    }
+
   } // end of namespace MatrixFreeFunctions
 
 } // end of namespace internal
@@ -28,6 +28,8 @@
 #include <deal.II/fe/fe_poly.h>
 #include <deal.II/fe/fe_q_dg0.h>
 
+#include <deal.II/lac/full_matrix.h>
+
 #include <deal.II/matrix_free/shape_info.h>
 
 
@@ -64,6 +66,7 @@ namespace internal
       , n_q_points_face(0)
       , dofs_per_component_on_face(0)
       , nodal_at_cell_boundaries(false)
+      , shape_values_identity(false)
     {}
 
 
@@ -137,7 +140,18 @@ namespace internal
             // FE_Nothing case -> nothing to do here
           }
         else
-          Assert(false, ExcNotImplemented());
+          // The evaluation kernels rely on the element being
+          // representable by a (possibly truncated) tensor product of 1D
+          // polynomials on hypercube cells. Collapsed-coordinate bases as
+          // used for wedges or simplices would need a triangulation that
+          // can hold such cells in the first place, so there is nothing to
+          // fall back to here.
+          AssertThrow(false,
+                      ExcMessage("The element " + fe->get_name() +
+                                 " is not based on a tensor product of 1D "
+                                 "polynomials and can hence not be used with "
+                                 "the sum-factorization kernels of "
+                                 "MatrixFree and FEEvaluation."));
 
         // Finally store the renumbering into the member variable of this
         // class
@@ -336,6 +350,10 @@ namespace internal
       else if (element_type == tensor_symmetric_plus_dg0)
         check_1d_shapes_symmetric(n_q_points_1d);
 
+      shape_values_identity =
+        element_type == tensor_symmetric_collocation ||
+        (element_type == tensor_general && check_1d_shapes_collocation());
+
       nodal_at_cell_boundaries = true;
       for (unsigned int i = 1; i < n_dofs_1d; ++i)
         if (std::abs(get_first_array_element(shape_data_on_face[0][i])) >
@@ -344,6 +362,61 @@ namespace internal
               1e-13)
           nodal_at_cell_boundaries = false;
 
+      // store the L2 projection from the quadrature points to the 1D shape
+      // functions, which is used for the inverse of the mass matrix when
+      // there are more quadrature points than shape functions
+      inverse_shape_values.clear();
+      if (element_type <= tensor_general && n_q_points_1d >= n_dofs_1d)
+        {
+          FullMatrix<double> shapes_1d(n_dofs_1d, n_q_points_1d);
+          for (unsigned int i = 0; i < n_dofs_1d; ++i)
+            for (unsigned int q = 0; q < n_q_points_1d; ++q)
+              {
+                Point<dim> q_point = unit_point;
+                q_point[0]         = quad.get_points()[q][0];
+                shapes_1d(i, q) =
+                  fe->shape_value(scalar_lexicographic[i], q_point);
+              }
+          FullMatrix<double> inverse_mass_1d(n_dofs_1d, n_dofs_1d);
+          for (unsigned int i = 0; i < n_dofs_1d; ++i)
+            for (unsigned int j = 0; j < n_dofs_1d; ++j)
+              for (unsigned int q = 0; q < n_q_points_1d; ++q)
+                inverse_mass_1d(i, j) +=
+                  shapes_1d(i, q) * quad.weight(q) * shapes_1d(j, q);
+          inverse_mass_1d.gauss_jordan();
+
+          inverse_shape_values.resize_fast(array_size);
+          for (unsigned int i = 0; i < n_dofs_1d; ++i)
+            for (unsigned int q = 0; q < n_q_points_1d; ++q)
+              {
+                double sum = 0;
+                for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                  sum += inverse_mass_1d(i, j) * shapes_1d(j, q);
+                inverse_shape_values[i * n_q_points_1d + q] =
+                  sum * quad.weight(q);
+              }
+        }
+
+      // for nodal elements, store the interpolation from the support points
+      // of a face to the support points of the first half of the face,
+      // which is needed to resolve hanging node constraints in
+      // FEEvaluation
+      subface_interpolation_matrix.clear();
+      if (nodal_at_cell_boundaries == true && fe->has_support_points())
+        {
+          const std::vector<Point<dim>> &support_points =
+            fe->get_unit_support_points();
+          subface_interpolation_matrix.resize(n_dofs_1d * n_dofs_1d);
+          for (unsigned int i = 0; i < n_dofs_1d; ++i)
+            {
+              Point<dim> q_point = unit_point;
+              q_point[0] = 0.5 * support_points[scalar_lexicographic[i]][0];
+              for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                subface_interpolation_matrix[i * n_dofs_1d + j] =
+                  fe->shape_value(scalar_lexicographic[j], q_point);
+            }
+        }
+
       if (nodal_at_cell_boundaries == true)
         {
           face_to_cell_index_nodal.reinit(GeometryInfo<dim>::faces_per_cell,
@@ -584,6 +657,9 @@ namespace internal
           memory +=
             MemoryConsumption::memory_consumption(gradients_within_subface[i]);
         }
+      memory +=
+        MemoryConsumption::memory_consumption(subface_interpolation_matrix);
+      memory += MemoryConsumption::memory_consumption(inverse_shape_values);
       return memory;
     }
 
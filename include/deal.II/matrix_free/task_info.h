@@ -54,6 +54,18 @@ namespace internal
     virtual void
     vector_update_ghosts_finish() = 0;
 
+    /// Waits until the ghost data of the update ghost values operation has
+    /// arrived from at least one more process and returns true, or finishes
+    /// the operation as vector_update_ghosts_finish() and returns false once
+    /// all data has arrived or the data cannot be tracked process by process
+    virtual bool
+    vector_update_ghosts_wait_any() = 0;
+
+    /// Returns whether the ghost data read by the cells and faces of the
+    /// given range as stored in DoFInfo has already arrived
+    virtual bool
+    ghost_data_available(const unsigned int range_index) = 0;
+
     /// Starts the communication for the vector compress operation
     virtual void
     vector_compress_start() = 0;
@@ -67,6 +79,18 @@ namespace internal
     virtual void
     zero_dst_vector_range(const unsigned int range_index) = 0;
 
+    /// Runs the operation on the vector entries that must be done before
+    /// their first access in the loop, according to a range stored in
+    /// DoFInfo
+    virtual void
+    cell_loop_pre_range(const unsigned int range_index) = 0;
+
+    /// Runs the operation on the vector entries that must be done after
+    /// their last access in the loop, according to a range stored in
+    /// DoFInfo
+    virtual void
+    cell_loop_post_range(const unsigned int range_index) = 0;
+
     /// Runs the cell work specified by MatrixFree::loop or
     /// MatrixFree::cell_loop
     virtual void
@@ -448,6 +472,14 @@ namespace internal
        */
       TasksParallelScheme scheme;
 
+      /**
+       * Stores whether the serial loop processes the cells and faces at the
+       * processor boundary in the order the ghost data of the respective
+       * processes arrives, see
+       * MatrixFree::AdditionalData::overlap_communication_by_process.
+       */
+      bool overlap_communication_by_process;
+
       /**
        * The blocks are organized by a vector-of-vector concept, and this data
        * field @p partition_row_index stores the distance from one 'vector' to
@@ -550,6 +582,33 @@ namespace internal
        */
       unsigned int n_workers;
 
+      /**
+       * For the color schemes with a single partition, this field stores the
+       * start of each block of cell batches in the final cell numbering. It
+       * is used together with the next three fields to schedule the blocks
+       * dynamically as soon as all neighbors of lower colors are done,
+       * instead of waiting for all blocks of the previous color.
+       */
+      std::vector<unsigned int> block_cell_start;
+
+      /**
+       * Number of neighboring blocks of a lower color that need to be
+       * finished before a given block can be scheduled
+       */
+      std::vector<unsigned int> block_n_predecessors;
+
+      /**
+       * Index into @p block_successors where the list of the blocks that
+       * depend on a given block starts, in compressed row storage
+       */
+      std::vector<unsigned int> block_successor_start;
+
+      /**
+       * List of neighboring blocks of a higher color that depend on a given
+       * block
+       */
+      std::vector<unsigned int> block_successors;
+
       /**
        * Stores whether a particular task is at an MPI boundary and needs data
        * exchange
@@ -0,0 +1,998 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef dealii_matrix_free_tools_h
+#define dealii_matrix_free_tools_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/grid/cell_id.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <deal.II/numerics/error_estimator.h>
+
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/**
+ * A namespace for utility functions that work on the data structures of
+ * MatrixFree.
+ */
+namespace MatrixFreeTools
+{
+  /**
+   * Compute the error indicator of KellyErrorEstimator::estimate() for the
+   * solution vector @p solution with the face integrals evaluated by
+   * FEFaceEvaluation in vectorized form over the inner and boundary faces
+   * of @p matrix_free, instead of FEFaceValues on each cell.
+   *
+   * The indicator of each locally owned active cell is written into the
+   * entry of @p error with the cell's active_cell_index(); all other entries
+   * are zero. As in KellyErrorEstimator::estimate(), the contribution of
+   * a boundary face is only nonzero if its boundary indicator appears in
+   * @p neumann_bc, and @p strategy selects the scaling of the face
+   * integrals. The result coincides with the one of
+   * KellyErrorEstimator::estimate() with a constant coefficient and all
+   * components selected, if the face quadrature formula with index
+   * @p quad_no is the one passed to the latter.
+   *
+   * Each face is visited once by MatrixFree, by exactly one of the processes
+   * owning the two adjacent cells in parallel computations. Contributions to
+   * cells owned by another process are sent to their owner after the face
+   * loop.
+   *
+   * The solution vector must be initialized via
+   * MatrixFree::initialize_dof_vector() (or be compatible with it) and must
+   * satisfy the constraints of @p matrix_free, i.e., hanging node values must
+   * have been set by AffineConstraints::distribute(). Its ghost values are
+   * updated here if they are not yet present, and zeroed again at the end.
+   * @p matrix_free needs to have been set up with update_gradients and
+   * update_JxW_values for both inner and boundary faces, plus
+   * update_quadrature_points for boundary faces if @p neumann_bc is not
+   * empty.
+   *
+   * @note The number of vector components of the finite element is given by
+   * the template argument @p n_components. Only non-hp DoFHandler objects
+   * are supported.
+   */
+  template <int n_components = 1,
+            int dim,
+            typename Number,
+            typename VectorizedArrayType>
+  void
+  estimate_kelly(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const LinearAlgebra::distributed::Vector<Number> &  solution,
+    Vector<float> &                                     error,
+    const std::map<types::boundary_id, const Function<dim, Number> *>
+      &                neumann_bc = {},
+    const unsigned int dof_no     = 0,
+    const unsigned int quad_no    = 0,
+    const typename KellyErrorEstimator<dim>::Strategy strategy =
+      KellyErrorEstimator<dim>::cell_diameter_over_24);
+
+
+
+  /**
+   * Compute the diagonal of the matrix represented by the cell operation
+   * @p local_vmult and write it into @p diagonal, e.g. for use in a
+   * Jacobi or Chebyshev preconditioner of a matrix-free operator.
+   *
+   * The function @p local_vmult receives an FEEvaluation object that has
+   * been reinitialized on a cell batch and whose degrees of freedom have been
+   * set to some values. It must do what the cell operation of the operator
+   * does between FEEvaluation::read_dof_values() and
+   * FEEvaluation::distribute_local_to_global(), i.e., call
+   * FEEvaluation::evaluate(), operate on the quadrature points, and call
+   * FEEvaluation::integrate(). The columns of the cell matrices are computed
+   * by applying @p local_vmult to the unit vectors, simultaneously for all
+   * cells in a batch. The cell matrices are then condensed with
+   * @p constraints, which should be the constraints @p matrix_free has been
+   * set up with, so that also hanging node constraints are taken into
+   * account.
+   *
+   * The vector @p diagonal must have been initialized via
+   * MatrixFree::initialize_dof_vector() or, in serial, with the number of
+   * degrees of freedom. The entries of constrained degrees of freedom are
+   * set to one, as done by the operators in the MatrixFreeOperators
+   * namespace.
+   *
+   * The arguments @p dof_no, @p quad_no, and @p first_selected_component are
+   * passed to the constructor of FEEvaluation.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename number,
+            typename VectorType>
+  void
+  compute_diagonal(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const AffineConstraints<number> &                   constraints,
+    VectorType &                                        diagonal,
+    const std::function<void(FEEvaluation<dim,
+                                          fe_degree,
+                                          n_q_points_1d,
+                                          n_components,
+                                          Number,
+                                          VectorizedArrayType> &)>
+      &                local_vmult,
+    const unsigned int dof_no                   = 0,
+    const unsigned int quad_no                  = 0,
+    const unsigned int first_selected_component = 0);
+
+
+
+  /**
+   * Assemble the matrix represented by the cell operation @p local_vmult into
+   * @p matrix, e.g. to set up an algebraic multigrid preconditioner on the
+   * coarse level of a matrix-free multigrid method without a separate
+   * assembly with FEValues.
+   *
+   * The cell matrices are computed as described for compute_diagonal() and
+   * added to @p matrix by AffineConstraints::distribute_local_to_global()
+   * with @p constraints, followed by a call to compress(). The sparsity
+   * pattern of @p matrix must therefore contain the entries created by
+   * DoFTools::make_sparsity_pattern() with the same constraints. Any type
+   * accepted by AffineConstraints::distribute_local_to_global(), like
+   * SparseMatrix or TrilinosWrappers::SparseMatrix, can be used as
+   * @p MatrixType. The matrix is not zeroed by this function.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename number,
+            typename MatrixType>
+  void
+  compute_matrix(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const AffineConstraints<number> &                   constraints,
+    MatrixType &                                        matrix,
+    const std::function<void(FEEvaluation<dim,
+                                          fe_degree,
+                                          n_q_points_1d,
+                                          n_components,
+                                          Number,
+                                          VectorizedArrayType> &)>
+      &                local_vmult,
+    const unsigned int dof_no                   = 0,
+    const unsigned int quad_no                  = 0,
+    const unsigned int first_selected_component = 0);
+
+
+
+  /**
+   * Select the parameters of MatrixFree::AdditionalData that control the
+   * execution of the cell loop, but not its result, by measuring the run
+   * time of @p operation for several candidate values, and initialize
+   * @p matrix_free with the fastest configuration. The returned object is
+   * @p additional_data with the selected values, so that it can be passed to
+   * later calls of MatrixFree::reinit() on the same mesh.
+   *
+   * The function @p operation should perform the work the program spends
+   * most of its time in, e.g., a call to the vmult() function of a
+   * matrix-free operator that runs MatrixFree::cell_loop() on
+   * @p matrix_free. Each candidate configuration is set up by
+   * MatrixFree::reinit() with the given @p mapping, @p dof_handler,
+   * @p constraints, and @p quad, and timed by calling @p operation once for
+   * warming up and then @p n_repetitions times, taking the minimum of the
+   * wall times. In parallel computations, the slowest process determines the
+   * time of a configuration. Vectors used by @p operation that have been
+   * initialized by MatrixFree::initialize_dof_vector() remain usable, as the
+   * parallel layout of the vectors does not depend on the tuned parameters.
+   *
+   * The following parameters are tuned:
+   * <ul>
+   * <li> AdditionalData::tasks_parallel_scheme, choosing between all schemes
+   * if more than one thread is available (see MultithreadInfo::n_threads())
+   * and AdditionalData::none otherwise. </li>
+   * <li> AdditionalData::tasks_block_size for the task-parallel schemes,
+   * choosing between the automatic value and a few fixed sizes. </li>
+   * <li> AdditionalData::cell_vectorization_categories_strict, if
+   * AdditionalData::cell_vectorization_category is not empty and the flag is
+   * not already set. Only the strict variant is tried in addition, since it
+   * does not change the categories seen by the cell operation of a batch in
+   * a way that would invalidate @p operation. </li>
+   * </ul>
+   * The categories themselves are never changed.
+   *
+   * If @p tuning_file is not empty, the selected configuration is appended
+   * to that file, keyed by the host name of the first process, the number of
+   * MPI processes and threads, the width of the vectorization, and the
+   * number of active cells and degrees of freedom. If the file already
+   * contains an entry with the same key, the trials are skipped and the
+   * stored configuration is used. The file is only accessed by the process
+   * with rank zero.
+   *
+   * Since every candidate requires a full call to MatrixFree::reinit(), this
+   * function is meant to be called once for a setup that is used for many
+   * operator evaluations, or once per mesh size in combination with
+   * @p tuning_file.
+   */
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            typename DoFHandlerType,
+            typename QuadratureType,
+            typename number>
+  typename MatrixFree<dim, Number, VectorizedArrayType>::AdditionalData
+  tune_additional_data(
+    MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const Mapping<dim> &                          mapping,
+    const DoFHandlerType &                        dof_handler,
+    const AffineConstraints<number> &             constraints,
+    const QuadratureType &                        quad,
+    const typename MatrixFree<dim, Number, VectorizedArrayType>::AdditionalData
+      &                          additional_data,
+    const std::function<void()> &operation,
+    const std::string &          tuning_file   = "",
+    const unsigned int           n_repetitions = 5);
+
+
+
+  namespace internal
+  {
+    /**
+     * Return the squared magnitude of the normal derivative of a scalar
+     * field.
+     */
+    template <typename VectorizedArrayType>
+    inline VectorizedArrayType
+    square(const VectorizedArrayType &value)
+    {
+      return value * value;
+    }
+
+
+
+    /**
+     * Return the squared magnitude of the normal derivative of a vector
+     * field.
+     */
+    template <int n_components, typename VectorizedArrayType>
+    inline VectorizedArrayType
+    square(const Tensor<1, n_components, VectorizedArrayType> &value)
+    {
+      VectorizedArrayType result = value[0] * value[0];
+      for (unsigned int c = 1; c < n_components; ++c)
+        result += value[c] * value[c];
+      return result;
+    }
+
+
+
+    /**
+     * Subtract the value of the Neumann boundary @p function at @p point from
+     * lane @p v of the normal derivative of a scalar field.
+     */
+    template <int dim, typename Number, typename VectorizedArrayType>
+    inline void
+    subtract_boundary_value(const Function<dim, Number> &function,
+                            const Point<dim> &           point,
+                            const unsigned int           v,
+                            VectorizedArrayType &        value)
+    {
+      value[v] -= function.value(point);
+    }
+
+
+
+    /**
+     * Subtract the value of the Neumann boundary @p function at @p point from
+     * lane @p v of the normal derivative of a vector field.
+     */
+    template <int dim,
+              typename Number,
+              int n_components,
+              typename VectorizedArrayType>
+    inline void
+    subtract_boundary_value(
+      const Function<dim, Number> &                 function,
+      const Point<dim> &                            point,
+      const unsigned int                            v,
+      Tensor<1, n_components, VectorizedArrayType> &value)
+    {
+      for (unsigned int c = 0; c < n_components; ++c)
+        value[c][v] -= function.value(point, c);
+    }
+
+
+
+    /**
+     * Return the active cell behind face @p face_no of @p cell. If the
+     * neighbor is refined, its child behind subface @p subface_no is
+     * returned. Periodic neighbors are taken into account.
+     */
+    template <int dim>
+    inline typename DoFHandler<dim>::cell_iterator
+    active_neighbor(const typename DoFHandler<dim>::cell_iterator &cell,
+                    const unsigned int                             face_no,
+                    const unsigned int                             subface_no)
+    {
+      const bool periodic = cell->has_periodic_neighbor(face_no);
+      const typename DoFHandler<dim>::cell_iterator neighbor =
+        periodic ? cell->periodic_neighbor(face_no) : cell->neighbor(face_no);
+
+      if (!neighbor->has_children())
+        return neighbor;
+
+      AssertIndexRange(subface_no, GeometryInfo<dim>::max_children_per_face);
+      return periodic ?
+               cell->periodic_neighbor_child_on_subface(face_no, subface_no) :
+               cell->neighbor_child_on_subface(face_no, subface_no);
+    }
+
+
+
+    /**
+     * Compute the matrices of the cells in the batch @p phi has been
+     * reinitialized on by applying @p local_vmult to the unit vectors, and
+     * collect the global indices of the degrees of freedom of the cells in
+     * the order used by FEEvaluation. Only the first
+     * n_active_entries_per_cell_batch() entries of @p cell_matrices and
+     * @p dof_indices are filled.
+     */
+    template <int dim,
+              int fe_degree,
+              int n_q_points_1d,
+              int n_components,
+              typename Number,
+              typename VectorizedArrayType,
+              typename number>
+    void
+    compute_cell_matrices(
+      const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+      const unsigned int                                  cell,
+      FEEvaluation<dim,
+                   fe_degree,
+                   n_q_points_1d,
+                   n_components,
+                   Number,
+                   VectorizedArrayType> &                 phi,
+      const std::function<void(FEEvaluation<dim,
+                                            fe_degree,
+                                            n_q_points_1d,
+                                            n_components,
+                                            Number,
+                                            VectorizedArrayType> &)>
+        &                                                 local_vmult,
+      const unsigned int                                  dof_no,
+      const unsigned int                                  first_component,
+      std::vector<FullMatrix<number>> &                   cell_matrices,
+      std::vector<std::vector<types::global_dof_index>> & dof_indices)
+    {
+      const FiniteElement<dim> &fe =
+        matrix_free.get_dof_handler(dof_no).get_fe();
+      const unsigned int dofs_per_cell = phi.dofs_per_cell;
+      const unsigned int n_filled_lanes =
+        matrix_free.n_active_entries_per_cell_batch(cell);
+
+      // FEEvaluation numbers the degrees of freedom of the selected
+      // components lexicographically, one component after the other. The
+      // first selected component might not be the first one of its base
+      // element.
+      const std::vector<unsigned int> &lexicographic_numbering =
+        phi.get_shape_info().lexicographic_numbering;
+      unsigned int components_before = 0;
+      for (unsigned int e = 0;
+           e < fe.component_to_base_index(first_component).first;
+           ++e)
+        components_before += fe.element_multiplicity(e);
+      const unsigned int lexicographic_offset =
+        (first_component - components_before) * phi.dofs_per_component;
+
+      std::vector<types::global_dof_index> cell_dof_indices(fe.dofs_per_cell);
+      for (unsigned int v = 0; v < n_filled_lanes; ++v)
+        {
+          matrix_free.get_cell_iterator(cell, v, dof_no)
+            ->get_active_or_mg_dof_indices(cell_dof_indices);
+          dof_indices[v].resize(dofs_per_cell);
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            dof_indices[v][i] = cell_dof_indices
+              [lexicographic_numbering[lexicographic_offset + i]];
+          cell_matrices[v].reinit(dofs_per_cell, dofs_per_cell);
+        }
+
+      phi.reinit(cell);
+      for (unsigned int j = 0; j < dofs_per_cell; ++j)
+        {
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            phi.begin_dof_values()[i] = VectorizedArrayType();
+          phi.begin_dof_values()[j] = 1.;
+
+          local_vmult(phi);
+
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            for (unsigned int v = 0; v < n_filled_lanes; ++v)
+              cell_matrices[v](i, j) = phi.begin_dof_values()[i][v];
+        }
+    }
+
+
+
+    /**
+     * Return the key under which tune_additional_data() stores the selected
+     * configuration in its file, consisting of space-separated entries
+     * without the trailing space.
+     */
+    template <int dim, int spacedim>
+    std::string
+    get_tuning_key(const Triangulation<dim, spacedim> &tria,
+                   const types::global_dof_index       n_dofs,
+                   const unsigned int                  n_lanes,
+                   const MPI_Comm &                    communicator)
+    {
+      std::ostringstream key;
+      key << Utilities::System::get_hostname() << ' '
+          << Utilities::MPI::n_mpi_processes(communicator) << ' '
+          << MultithreadInfo::n_threads() << ' ' << n_lanes << ' '
+          << tria.n_global_active_cells() << ' ' << n_dofs;
+      return key.str();
+    }
+  } // namespace internal
+
+
+
+  template <int n_components,
+            int dim,
+            typename Number,
+            typename VectorizedArrayType>
+  void
+  estimate_kelly(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const LinearAlgebra::distributed::Vector<Number> &  solution,
+    Vector<float> &                                     error,
+    const std::map<types::boundary_id, const Function<dim, Number> *>
+      &                                               neumann_bc,
+    const unsigned int                                dof_no,
+    const unsigned int                                quad_no,
+    const typename KellyErrorEstimator<dim>::Strategy strategy)
+  {
+    using cell_iterator = typename DoFHandler<dim>::cell_iterator;
+
+    const DoFHandler<dim> &dof_handler = matrix_free.get_dof_handler(dof_no);
+    const Triangulation<dim> &tria     = dof_handler.get_triangulation();
+    const unsigned int        degree   = dof_handler.get_fe().degree;
+
+    AssertDimension(dof_handler.get_fe().n_components(), n_components);
+
+    constexpr unsigned int n_lanes = VectorizedArrayType::n_array_elements;
+    const unsigned int n_owned_cells = matrix_free.n_cell_batches() * n_lanes;
+
+    const auto get_cell = [&](const unsigned int cell_index) {
+      Assert(cell_index < n_owned_cells, ExcInternalError());
+      return matrix_free.get_cell_iterator(cell_index / n_lanes,
+                                           cell_index % n_lanes,
+                                           dof_no);
+    };
+
+    // Sums of the scaled face integrals of the locally owned cells, and the
+    // contributions to cells owned by other processes
+    std::vector<double> face_sums(tria.n_active_cells(), 0.);
+    std::map<unsigned int, std::vector<std::pair<CellId, double>>>
+      ghost_face_sums;
+
+    const auto add_face_sum = [&](const cell_iterator &cell,
+                                  const double         value) {
+      if (cell->is_locally_owned())
+        face_sums[cell->active_cell_index()] += value;
+      else
+        ghost_face_sums[cell->subdomain_id()].emplace_back(cell->id(), value);
+    };
+
+    const bool has_ghost_elements = solution.has_ghost_elements();
+    if (has_ghost_elements == false)
+      solution.update_ghost_values();
+
+    // inner faces: integrate the squared jump of the normal derivative
+    {
+      FEFaceEvaluation<dim, -1, 0, n_components, Number, VectorizedArrayType>
+        phi_m(matrix_free, true, dof_no, quad_no),
+        phi_p(matrix_free, false, dof_no, quad_no);
+
+      for (unsigned int face = 0; face < matrix_free.n_inner_face_batches();
+           ++face)
+        {
+          phi_m.reinit(face);
+          phi_m.read_dof_values(solution);
+          phi_m.evaluate(false, true);
+          phi_p.reinit(face);
+          phi_p.read_dof_values(solution);
+          phi_p.evaluate(false, true);
+
+          VectorizedArrayType integral = VectorizedArrayType();
+          for (unsigned int q = 0; q < phi_m.n_q_points; ++q)
+            integral += internal::square(phi_m.get_normal_derivative(q) -
+                                         phi_p.get_normal_derivative(q)) *
+                        phi_m.JxW(q);
+
+          const auto &face_info = matrix_free.get_face_info(face);
+          for (unsigned int v = 0;
+               v < matrix_free.n_active_entries_per_face_batch(face);
+               ++v)
+            {
+              // MatrixFree visits each face on exactly one process, so one of
+              // the two cells is locally owned. We reach the other one through
+              // the neighbor relations of the mesh.
+              cell_iterator interior_cell, exterior_cell;
+              if (face_info.cells_interior[v] < n_owned_cells)
+                {
+                  interior_cell = get_cell(face_info.cells_interior[v]);
+                  exterior_cell = internal::active_neighbor<dim>(
+                    interior_cell,
+                    face_info.interior_face_no,
+                    face_info.subface_index);
+                }
+              else
+                {
+                  exterior_cell = get_cell(face_info.cells_exterior[v]);
+                  interior_cell = internal::active_neighbor<dim>(
+                    exterior_cell,
+                    face_info.exterior_face_no,
+                    face_info.subface_index);
+                }
+
+              double factor = 1.;
+              if (strategy == KellyErrorEstimator<
+                                dim>::face_diameter_over_twice_max_degree)
+                {
+                  // the face integrated over is the face of the finer cell
+                  const double diameter =
+                    interior_cell->level() >= exterior_cell->level() ?
+                      interior_cell->face(face_info.interior_face_no)
+                        ->diameter() :
+                      exterior_cell->face(face_info.exterior_face_no)
+                        ->diameter();
+                  factor = diameter / degree / 2.0;
+                }
+
+              add_face_sum(interior_cell, factor * integral[v]);
+              add_face_sum(exterior_cell, factor * integral[v]);
+            }
+        }
+    }
+
+    // boundary faces: integrate the squared difference between the normal
+    // derivative and the Neumann data
+    if (neumann_bc.empty() == false)
+      {
+        FEFaceEvaluation<dim, -1, 0, n_components, Number, VectorizedArrayType>
+          phi(matrix_free, true, dof_no, quad_no);
+
+        for (unsigned int face = matrix_free.n_inner_face_batches();
+             face < matrix_free.n_inner_face_batches() +
+                      matrix_free.n_boundary_face_batches();
+             ++face)
+          {
+            const auto function =
+              neumann_bc.find(matrix_free.get_boundary_id(face));
+            if (function == neumann_bc.end())
+              continue;
+
+            const unsigned int n_filled_lanes =
+              matrix_free.n_active_entries_per_face_batch(face);
+
+            phi.reinit(face);
+            phi.read_dof_values(solution);
+            phi.evaluate(false, true);
+
+            VectorizedArrayType integral = VectorizedArrayType();
+            for (unsigned int q = 0; q < phi.n_q_points; ++q)
+              {
+                auto normal_derivative = phi.get_normal_derivative(q);
+                const Point<dim, VectorizedArrayType> point_batch =
+                  phi.quadrature_point(q);
+                for (unsigned int v = 0; v < n_filled_lanes; ++v)
+                  {
+                    Point<dim> point;
+                    for (unsigned int d = 0; d < dim; ++d)
+                      point[d] = point_batch[d][v];
+                    internal::subtract_boundary_value(*function->second,
+                                                      point,
+                                                      v,
+                                                      normal_derivative);
+                  }
+                integral += internal::square(normal_derivative) * phi.JxW(q);
+              }
+
+            const auto &face_info = matrix_free.get_face_info(face);
+            for (unsigned int v = 0; v < n_filled_lanes; ++v)
+              {
+                const cell_iterator cell =
+                  get_cell(face_info.cells_interior[v]);
+
+                double factor = 1.;
+                if (strategy == KellyErrorEstimator<
+                                  dim>::face_diameter_over_twice_max_degree)
+                  factor =
+                    cell->face(face_info.interior_face_no)->diameter() / degree;
+
+                add_face_sum(cell, factor * integral[v]);
+              }
+          }
+      }
+
+    if (has_ghost_elements == false)
+      solution.zero_out_ghosts();
+
+    // send the contributions to cells owned by other processes to their owner
+    if (const parallel::Triangulation<dim> *parallel_tria =
+          dynamic_cast<const parallel::Triangulation<dim> *>(&tria))
+      {
+        const std::map<unsigned int, std::vector<std::pair<CellId, double>>>
+          received = Utilities::MPI::some_to_some(
+            parallel_tria->get_communicator(), ghost_face_sums);
+
+        for (const auto &process_and_sums : received)
+          for (const auto &cell_and_sum : process_and_sums.second)
+            {
+              const auto cell = cell_and_sum.first.to_cell(tria);
+              Assert(cell->is_locally_owned(), ExcInternalError());
+              face_sums[cell->active_cell_index()] += cell_and_sum.second;
+            }
+      }
+    else
+      Assert(ghost_face_sums.empty(), ExcInternalError());
+
+    error.reinit(tria.n_active_cells());
+    for (const auto &cell : tria.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          double cell_factor = 1.;
+          if (strategy == KellyErrorEstimator<dim>::cell_diameter_over_24)
+            cell_factor = cell->diameter() / 24;
+          else if (strategy == KellyErrorEstimator<dim>::cell_diameter)
+            cell_factor = cell->diameter();
+
+          error(cell->active_cell_index()) =
+            std::sqrt(cell_factor * face_sums[cell->active_cell_index()]);
+        }
+  }
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename number,
+            typename VectorType>
+  void
+  compute_diagonal(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const AffineConstraints<number> &                   constraints,
+    VectorType &                                        diagonal,
+    const std::function<void(FEEvaluation<dim,
+                                          fe_degree,
+                                          n_q_points_1d,
+                                          n_components,
+                                          Number,
+                                          VectorizedArrayType> &)>
+      &                local_vmult,
+    const unsigned int dof_no,
+    const unsigned int quad_no,
+    const unsigned int first_selected_component)
+  {
+    FEEvaluation<dim,
+                 fe_degree,
+                 n_q_points_1d,
+                 n_components,
+                 Number,
+                 VectorizedArrayType>
+      phi(matrix_free, dof_no, quad_no, first_selected_component);
+
+    constexpr unsigned int n_lanes = VectorizedArrayType::n_array_elements;
+    std::vector<FullMatrix<number>> cell_matrices(n_lanes);
+    std::vector<std::vector<types::global_dof_index>> dof_indices(n_lanes);
+
+    // for every global index a cell contributes to, the local indices and
+    // the weights by which they enter after resolving the constraints
+    std::map<types::global_dof_index,
+             std::vector<std::pair<unsigned int, number>>>
+      local_contributions;
+
+    diagonal = 0.;
+    for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+      {
+        internal::compute_cell_matrices(matrix_free,
+                                        cell,
+                                        phi,
+                                        local_vmult,
+                                        dof_no,
+                                        first_selected_component,
+                                        cell_matrices,
+                                        dof_indices);
+
+        for (unsigned int v = 0;
+             v < matrix_free.n_active_entries_per_cell_batch(cell);
+             ++v)
+          {
+            local_contributions.clear();
+            for (unsigned int i = 0; i < dof_indices[v].size(); ++i)
+              if (constraints.is_constrained(dof_indices[v][i]))
+                {
+                  for (const auto &entry :
+                       *constraints.get_constraint_entries(dof_indices[v][i]))
+                    local_contributions[entry.first].emplace_back(
+                      i, entry.second);
+                }
+              else
+                local_contributions[dof_indices[v][i]].emplace_back(i, 1.);
+
+            for (const auto &contribution : local_contributions)
+              {
+                number sum = 0;
+                for (const auto &row : contribution.second)
+                  for (const auto &column : contribution.second)
+                    sum += row.second * column.second *
+                           cell_matrices[v](row.first, column.first);
+                diagonal(contribution.first) += sum;
+              }
+          }
+      }
+    diagonal.compress(VectorOperation::add);
+
+    const IndexSet locally_owned = diagonal.locally_owned_elements();
+    for (const auto &line : constraints.get_lines())
+      if (locally_owned.is_element(line.index))
+        diagonal(line.index) = 1.;
+  }
+
+
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename number,
+            typename MatrixType>
+  void
+  compute_matrix(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const AffineConstraints<number> &                   constraints,
+    MatrixType &                                        matrix,
+    const std::function<void(FEEvaluation<dim,
+                                          fe_degree,
+                                          n_q_points_1d,
+                                          n_components,
+                                          Number,
+                                          VectorizedArrayType> &)>
+      &                local_vmult,
+    const unsigned int dof_no,
+    const unsigned int quad_no,
+    const unsigned int first_selected_component)
+  {
+    FEEvaluation<dim,
+                 fe_degree,
+                 n_q_points_1d,
+                 n_components,
+                 Number,
+                 VectorizedArrayType>
+      phi(matrix_free, dof_no, quad_no, first_selected_component);
+
+    constexpr unsigned int n_lanes = VectorizedArrayType::n_array_elements;
+    std::vector<FullMatrix<number>> cell_matrices(n_lanes);
+    std::vector<std::vector<types::global_dof_index>> dof_indices(n_lanes);
+
+    for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+      {
+        internal::compute_cell_matrices(matrix_free,
+                                        cell,
+                                        phi,
+                                        local_vmult,
+                                        dof_no,
+                                        first_selected_component,
+                                        cell_matrices,
+                                        dof_indices);
+
+        for (unsigned int v = 0;
+             v < matrix_free.n_active_entries_per_cell_batch(cell);
+             ++v)
+          constraints.distribute_local_to_global(cell_matrices[v],
+                                                 dof_indices[v],
+                                                 matrix);
+      }
+    matrix.compress(VectorOperation::add);
+  }
+
+
+
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            typename DoFHandlerType,
+            typename QuadratureType,
+            typename number>
+  typename MatrixFree<dim, Number, VectorizedArrayType>::AdditionalData
+  tune_additional_data(
+    MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const Mapping<dim> &                          mapping,
+    const DoFHandlerType &                        dof_handler,
+    const AffineConstraints<number> &             constraints,
+    const QuadratureType &                        quad,
+    const typename MatrixFree<dim, Number, VectorizedArrayType>::AdditionalData
+      &                          additional_data,
+    const std::function<void()> &operation,
+    const std::string &          tuning_file,
+    const unsigned int           n_repetitions)
+  {
+    using AdditionalData =
+      typename MatrixFree<dim, Number, VectorizedArrayType>::AdditionalData;
+
+    AssertThrow(n_repetitions > 0,
+                ExcMessage("At least one repetition is needed for timing."));
+
+    constexpr int spacedim     = DoFHandlerType::space_dimension;
+    const auto &  tria         = dof_handler.get_triangulation();
+    MPI_Comm      communicator = MPI_COMM_SELF;
+    if (const auto *parallel_tria =
+          dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(&tria))
+      communicator = parallel_tria->get_communicator();
+    const bool is_root = Utilities::MPI::this_mpi_process(communicator) == 0;
+
+    // collect the candidates. the task-parallel schemes and the block sizes
+    // only make a difference if there is more than one thread
+    std::vector<AdditionalData> candidates;
+    {
+      AdditionalData data        = additional_data;
+      data.tasks_parallel_scheme = AdditionalData::none;
+      candidates.push_back(data);
+      if (MultithreadInfo::n_threads() > 1)
+        for (const auto scheme : {AdditionalData::partition_partition,
+                                  AdditionalData::partition_color,
+                                  AdditionalData::color})
+          for (const unsigned int block_size : {0U, 8U, 32U, 128U})
+            {
+              data.tasks_parallel_scheme = scheme;
+              data.tasks_block_size      = block_size;
+              candidates.push_back(data);
+            }
+
+      if (additional_data.cell_vectorization_category.empty() == false &&
+          additional_data.cell_vectorization_categories_strict == false)
+        {
+          const unsigned int n_candidates = candidates.size();
+          for (unsigned int c = 0; c < n_candidates; ++c)
+            {
+              candidates.push_back(candidates[c]);
+              candidates.back().cell_vectorization_categories_strict = true;
+            }
+        }
+    }
+
+    // look up the configuration in the file on the root process and send it
+    // to all other processes, using that all entries are zero on the others
+    const std::string key =
+      is_root && !tuning_file.empty() ?
+        internal::get_tuning_key(tria,
+                                 dof_handler.n_dofs(),
+                                 VectorizedArrayType::n_array_elements,
+                                 communicator) :
+        std::string();
+    unsigned int stored[4] = {0, 0, 0, 0};
+    if (is_root && !tuning_file.empty())
+      {
+        std::ifstream file(tuning_file);
+        std::string   line;
+        while (std::getline(file, line))
+          if (line.compare(0, key.size() + 1, key + ' ') == 0)
+            {
+              std::istringstream values(line.substr(key.size() + 1));
+              values >> stored[1] >> stored[2] >> stored[3];
+              stored[0] = values ? 1 : 0;
+            }
+      }
+    if (!tuning_file.empty())
+      Utilities::MPI::max(stored, communicator, stored);
+
+    AdditionalData best_data = additional_data;
+    if (stored[0] == 1)
+      {
+        best_data.tasks_parallel_scheme =
+          static_cast<typename AdditionalData::TasksParallelScheme>(stored[1]);
+        best_data.tasks_block_size                     = stored[2];
+        best_data.cell_vectorization_categories_strict = stored[3] != 0;
+        matrix_free.reinit(mapping, dof_handler, constraints, quad, best_data);
+        return best_data;
+      }
+
+    double       best_time = std::numeric_limits<double>::max();
+    unsigned int best      = 0;
+    Timer        timer;
+    for (unsigned int c = 0; c < candidates.size(); ++c)
+      {
+        matrix_free.reinit(
+          mapping, dof_handler, constraints, quad, candidates[c]);
+        operation();
+
+        double time = std::numeric_limits<double>::max();
+        for (unsigned int r = 0; r < n_repetitions; ++r)
+          {
+            timer.restart();
+            operation();
+            time = std::min(time, timer.wall_time());
+          }
+        time = Utilities::MPI::max(time, communicator);
+        if (time < best_time)
+          {
+            best_time = time;
+            best      = c;
+          }
+      }
+
+    best_data = candidates[best];
+    if (best + 1 != candidates.size())
+      matrix_free.reinit(mapping, dof_handler, constraints, quad, best_data);
+
+    if (is_root && !tuning_file.empty())
+      {
+        std::ofstream file(tuning_file, std::ios::app);
+        AssertThrow(file, ExcIO());
+        file << key << ' '
+             << static_cast<unsigned int>(best_data.tasks_parallel_scheme)
+             << ' ' << best_data.tasks_block_size << ' '
+             << (best_data.cell_vectorization_categories_strict ? 1 : 0)
+             << std::endl;
+      }
+
+    return best_data;
+  }
+} // namespace MatrixFreeTools
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+
+#endif
@@ -766,6 +766,22 @@ namespace MeshWorker
     const Mapping<dim, spacedim> &
     get_mapping() const;
 
+    /**
+     * Enable the detection of cells that are translations of the previously
+     * visited cell in the FEValues objects on the cell and the neighbor cell
+     * also when more than one thread is used. See
+     * FEValuesBase::always_allow_check_for_cell_similarity() for the
+     * consequences.
+     *
+     * MeshWorker::mesh_loop() hands the cells of a chunk to the same copy of
+     * this object, one after the other, so that on meshes with many
+     * translated cells, like structured or mildly refined Cartesian meshes,
+     * the mapping and shape function data are only recomputed when the
+     * geometry changes. The setting is retained when this object is copied.
+     */
+    void
+    always_allow_check_for_cell_similarity(const bool allow);
+
   private:
     /**
      * Construct a unique name to store vectors of values, gradients,
@@ -834,6 +850,12 @@ namespace MeshWorker
      */
     UpdateFlags neighbor_face_update_flags;
 
+    /**
+     * Whether the FEValues objects of this class detect similar cells also
+     * when more than one thread is used.
+     */
+    bool check_for_cell_similarity_allowed;
+
     /**
      * Finite element values on the current cell.
      */
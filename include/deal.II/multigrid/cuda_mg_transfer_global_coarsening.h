@@ -0,0 +1,416 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_cuda_mg_transfer_global_coarsening_h
+#define dealii_cuda_mg_transfer_global_coarsening_h
+
+#include <deal.II/base/config.h>
+
+#ifdef DEAL_II_COMPILER_CUDA_AWARE
+
+#  include <deal.II/base/cuda.h>
+#  include <deal.II/base/mg_level_object.h>
+#  include <deal.II/base/partitioner.h>
+#  include <deal.II/base/smartpointer.h>
+
+#  include <deal.II/dofs/dof_handler.h>
+
+#  include <deal.II/lac/la_parallel_vector.h>
+
+#  include <deal.II/multigrid/mg_base.h>
+#  include <deal.II/multigrid/mg_transfer_global_coarsening.h>
+
+#  include <functional>
+#  include <memory>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace CUDAWrappers
+{
+  /*!@addtogroup mg */
+  /*@{*/
+
+  /**
+   * The device version of dealii::MGTwoLevelTransfer: the transfer between
+   * two levels of a global-coarsening multigrid method for vectors in
+   * MemorySpace::CUDA. The transfer is set up on the host by
+   * dealii::MGTwoLevelTransfer, either geometrically or polynomially, and
+   * reinit() copies its sparse matrix of the prolongation to the device.
+   * The prolongation then runs one thread per locally owned fine degree of
+   * freedom, and the restriction adds the contributions of each row to the
+   * coarse vector with atomic operations. The ghost values of the coarse
+   * level are exchanged by the vectors themselves, so the data stays on the
+   * device throughout the multigrid cycle.
+   */
+  template <int dim, typename Number>
+  class MGTwoLevelTransfer
+  {
+  public:
+    /**
+     * The type of the vectors on the levels.
+     */
+    using VectorType =
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA>;
+
+    /**
+     * Constructor.
+     */
+    MGTwoLevelTransfer();
+
+    /**
+     * Copy the transfer set up on the host to the device. @p transfer is
+     * not referenced after this call.
+     */
+    void
+    reinit(const dealii::MGTwoLevelTransfer<dim, Number> &transfer);
+
+    /**
+     * Perform the prolongation from @p src on the coarse level to @p dst on
+     * the fine level. The previous content of @p dst is overwritten.
+     */
+    void
+    prolongate(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Perform the prolongation from @p src on the coarse level and add the
+     * result to @p dst on the fine level.
+     */
+    void
+    prolongate_and_add(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Perform the restriction from @p src on the fine level and add the
+     * result to @p dst on the coarse level.
+     */
+    void
+    restrict_and_add(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Return the partitioner of the locally owned degrees of freedom on the
+     * fine level.
+     */
+    const std::shared_ptr<const Utilities::MPI::Partitioner> &
+    get_partitioner_fine() const;
+
+    /**
+     * Return the partitioner of the locally owned degrees of freedom on the
+     * coarse level.
+     */
+    const std::shared_ptr<const Utilities::MPI::Partitioner> &
+    get_partitioner_coarse() const;
+
+    /**
+     * Memory used by this object, on the host and the device.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * The partitioners, see dealii::MGTwoLevelTransfer.
+     */
+    std::shared_ptr<const Utilities::MPI::Partitioner> partitioner_fine;
+    std::shared_ptr<const Utilities::MPI::Partitioner> partitioner_coarse;
+    std::shared_ptr<const Utilities::MPI::Partitioner>
+      partitioner_coarse_ghosted;
+
+    /**
+     * The number of rows of the prolongation.
+     */
+    unsigned int n_rows;
+
+    /**
+     * The number of entries of the prolongation.
+     */
+    unsigned int n_entries;
+
+    /**
+     * The sparse matrix of the prolongation on the device, in the format of
+     * dealii::MGTwoLevelTransfer.
+     */
+    std::unique_ptr<unsigned int[], void (*)(unsigned int *)> row_starts;
+    std::unique_ptr<unsigned int[], void (*)(unsigned int *)> column_indices;
+    std::unique_ptr<Number[], void (*)(Number *)>             values;
+
+    /**
+     * A vector with the layout of #partitioner_coarse_ghosted used for
+     * importing and exporting the ghost entries of the coarse level.
+     */
+    mutable VectorType vec_coarse;
+  };
+
+
+
+  /**
+   * The device version of dealii::MGTransferGlobalCoarsening, which
+   * implements the MGTransferBase interface for vectors in
+   * MemorySpace::CUDA on top of CUDAWrappers::MGTwoLevelTransfer objects.
+   * Together with level operators based on CUDAWrappers::MatrixFree, a
+   * smoother like PreconditionChebyshev, and a coarse-grid solver like
+   * MGCoarseGridIterativeSolver with SolverCG, all of which work on device
+   * vectors, the whole multigrid cycle runs on the device:
+   * @code
+   * using VectorType =
+   *   LinearAlgebra::distributed::Vector<double, MemorySpace::CUDA>;
+   *
+   * MGLevelObject<CUDAWrappers::MGTwoLevelTransfer<dim, double>>
+   *   device_transfers(1, max_level);
+   * for (unsigned int l = 1; l <= max_level; ++l)
+   *   device_transfers[l].reinit(transfers[l]);
+   * CUDAWrappers::MGTransferGlobalCoarsening<dim, double> transfer(
+   *   device_transfers, [&](const unsigned int level, VectorType &vec) {
+   *     level_operators[level].initialize_dof_vector(vec);
+   *   });
+   *
+   * SolverControl coarse_control(100, 1e-12, false, false);
+   * SolverCG<VectorType> coarse_solver(coarse_control);
+   * MGCoarseGridIterativeSolver<VectorType,
+   *                             SolverCG<VectorType>,
+   *                             LevelOperatorType,
+   *                             PreconditionIdentity>
+   *   mg_coarse(coarse_solver, level_operators[0], identity);
+   * @endcode
+   * Here, <tt>transfers</tt> are the dealii::MGTwoLevelTransfer objects set
+   * up on the host as described for dealii::MGTransferGlobalCoarsening.
+   */
+  template <int dim, typename Number>
+  class MGTransferGlobalCoarsening
+    : public MGTransferBase<
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA>>
+  {
+  public:
+    /**
+     * The type of the vectors on the levels.
+     */
+    using VectorType =
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::CUDA>;
+
+    /**
+     * Constructor, see dealii::MGTransferGlobalCoarsening.
+     */
+    MGTransferGlobalCoarsening(
+      const MGLevelObject<MGTwoLevelTransfer<dim, Number>> &transfer,
+      const std::function<void(const unsigned int, VectorType &)>
+        &initialize_dof_vector =
+          std::function<void(const unsigned int, VectorType &)>());
+
+    /**
+     * Prolongate a vector from level <tt>to_level-1</tt> to level
+     * <tt>to_level</tt>. The previous content of @p dst is overwritten.
+     */
+    virtual void
+    prolongate(const unsigned int to_level,
+               VectorType &       dst,
+               const VectorType & src) const override;
+
+    /**
+     * Prolongate a vector from level <tt>to_level-1</tt> to level
+     * <tt>to_level</tt> and add it to the previous content of @p dst.
+     */
+    virtual void
+    prolongate_and_add(const unsigned int to_level,
+                       VectorType &       dst,
+                       const VectorType & src) const override;
+
+    /**
+     * Restrict a vector from level <tt>from_level</tt> to level
+     * <tt>from_level-1</tt> and add the result to @p dst.
+     */
+    virtual void
+    restrict_and_add(const unsigned int from_level,
+                     VectorType &       dst,
+                     const VectorType & src) const override;
+
+    /**
+     * Copy the device vector @p src into the vector on the finest level and
+     * set the vectors on all other levels to zero.
+     */
+    template <int spacedim>
+    void
+    copy_to_mg(const DoFHandler<dim, spacedim> &dof_handler,
+               MGLevelObject<VectorType> &      dst,
+               const VectorType &               src) const;
+
+    /**
+     * Copy the vector on the finest level of @p src into the device vector
+     * @p dst.
+     */
+    template <int spacedim>
+    void
+    copy_from_mg(const DoFHandler<dim, spacedim> &dof_handler,
+                 VectorType &                     dst,
+                 const MGLevelObject<VectorType> &src) const;
+
+    /**
+     * Memory used by this object.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * The transfer operators between the levels.
+     */
+    SmartPointer<const MGLevelObject<MGTwoLevelTransfer<dim, Number>>,
+                 MGTransferGlobalCoarsening<dim, Number>>
+      transfer;
+
+    /**
+     * The function to set up the level vectors in copy_to_mg().
+     */
+    std::function<void(const unsigned int, VectorType &)>
+      initialize_dof_vector;
+  };
+
+  /*@}*/
+
+
+#  ifndef DOXYGEN
+
+  template <int dim, typename Number>
+  inline const std::shared_ptr<const Utilities::MPI::Partitioner> &
+  MGTwoLevelTransfer<dim, Number>::get_partitioner_fine() const
+  {
+    return partitioner_fine;
+  }
+
+
+
+  template <int dim, typename Number>
+  inline const std::shared_ptr<const Utilities::MPI::Partitioner> &
+  MGTwoLevelTransfer<dim, Number>::get_partitioner_coarse() const
+  {
+    return partitioner_coarse;
+  }
+
+
+
+  template <int dim, typename Number>
+  MGTransferGlobalCoarsening<dim, Number>::MGTransferGlobalCoarsening(
+    const MGLevelObject<MGTwoLevelTransfer<dim, Number>> &transfer,
+    const std::function<void(const unsigned int, VectorType &)>
+      &initialize_dof_vector)
+    : transfer(&transfer)
+    , initialize_dof_vector(initialize_dof_vector)
+  {}
+
+
+
+  template <int dim, typename Number>
+  void
+  MGTransferGlobalCoarsening<dim, Number>::prolongate(
+    const unsigned int to_level,
+    VectorType &       dst,
+    const VectorType & src) const
+  {
+    (*transfer)[to_level].prolongate(dst, src);
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  MGTransferGlobalCoarsening<dim, Number>::prolongate_and_add(
+    const unsigned int to_level,
+    VectorType &       dst,
+    const VectorType & src) const
+  {
+    (*transfer)[to_level].prolongate_and_add(dst, src);
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  MGTransferGlobalCoarsening<dim, Number>::restrict_and_add(
+    const unsigned int from_level,
+    VectorType &       dst,
+    const VectorType & src) const
+  {
+    (*transfer)[from_level].restrict_and_add(dst, src);
+  }
+
+
+
+  template <int dim, typename Number>
+  template <int spacedim>
+  void
+  MGTransferGlobalCoarsening<dim, Number>::copy_to_mg(
+    const DoFHandler<dim, spacedim> &dof_handler,
+    MGLevelObject<VectorType> &      dst,
+    const VectorType &               src) const
+  {
+    (void)dof_handler;
+    AssertDimension(dst.max_level(), transfer->max_level());
+    AssertDimension(dst.min_level() + 1, transfer->min_level());
+
+    for (unsigned int level = dst.min_level(); level <= dst.max_level();
+         ++level)
+      {
+        if (initialize_dof_vector)
+          initialize_dof_vector(level, dst[level]);
+        else
+          {
+            const auto &partitioner =
+              level == dst.max_level() ?
+                (*transfer)[level].get_partitioner_fine() :
+                (*transfer)[level + 1].get_partitioner_coarse();
+            if (dst[level].size() != partitioner->size() ||
+                dst[level].local_size() != partitioner->local_size())
+              dst[level].reinit(partitioner);
+          }
+        dst[level] = 0.;
+      }
+
+    dst[dst.max_level()].copy_locally_owned_data_from(src);
+  }
+
+
+
+  template <int dim, typename Number>
+  template <int spacedim>
+  void
+  MGTransferGlobalCoarsening<dim, Number>::copy_from_mg(
+    const DoFHandler<dim, spacedim> &dof_handler,
+    VectorType &                     dst,
+    const MGLevelObject<VectorType> &src) const
+  {
+    (void)dof_handler;
+    dst.copy_locally_owned_data_from(src[src.max_level()]);
+  }
+
+
+
+  template <int dim, typename Number>
+  std::size_t
+  MGTransferGlobalCoarsening<dim, Number>::memory_consumption() const
+  {
+    std::size_t memory = 0;
+    for (unsigned int level = transfer->min_level();
+         level <= transfer->max_level();
+         ++level)
+      memory += (*transfer)[level].memory_consumption();
+    return memory;
+  }
+
+#  endif // DOXYGEN
+
+} // namespace CUDAWrappers
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
+
+#endif
@@ -197,6 +197,27 @@ public:
              VectorType &       dst,
              const VectorType & src) const = 0;
 
+  /**
+   * Prolongate a vector from level <tt>to_level-1</tt> to level
+   * <tt>to_level</tt> and add the result to the previous content of
+   * <tt>dst</tt>. This is the operation needed for the coarse grid
+   * correction in the Multigrid class.
+   *
+   * The default implementation calls prolongate() on a temporary vector
+   * and adds it to <tt>dst</tt>. Derived classes can provide more efficient
+   * implementations that work directly on <tt>dst</tt>.
+   *
+   * @arg src is a vector with as many elements as there are degrees of
+   * freedom on the coarser level involved.
+   *
+   * @arg dst has as many elements as there are degrees of freedom on the
+   * finer level.
+   */
+  virtual void
+  prolongate_and_add(const unsigned int to_level,
+                     VectorType &       dst,
+                     const VectorType & src) const;
+
   /**
    * Restrict a vector from level <tt>from_level</tt> to level
    * <tt>from_level-1</tt> and add this restriction to <tt>dst</tt>. If the
@@ -0,0 +1,556 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_mg_transfer_global_coarsening_h
+#define dealii_mg_transfer_global_coarsening_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/mg_level_object.h>
+#include <deal.II/base/partitioner.h>
+#include <deal.II/base/smartpointer.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/multigrid/mg_base.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/*!@addtogroup mg */
+/*@{*/
+
+/**
+ * A namespace with functions that set up the data structures for multigrid
+ * methods based on global coarsening, see MGTransferGlobalCoarsening.
+ */
+namespace MGTransferGlobalCoarseningTools
+{
+  /**
+   * Create the sequence of coarser triangulations for a global-coarsening
+   * multigrid method on @p fine_triangulation. Each triangulation of the
+   * sequence is obtained from the next finer one by coarsening all cells
+   * whose children are all active, i.e., by removing the finest level
+   * everywhere. The triangulations are returned from the coarsest to the
+   * second-finest one, so there are <tt>n_global_levels()-1</tt> of them;
+   * the finest level of the hierarchy is @p fine_triangulation itself.
+   *
+   * For parallel::distributed::Triangulation objects, each triangulation is
+   * a new parallel::distributed::Triangulation on the same communicator,
+   * built from the coarse mesh of @p fine_triangulation and partitioned on
+   * its own. All levels of the multigrid hierarchy are therefore load
+   * balanced, in contrast to the level meshes of the local smoothing
+   * approach, where the coarse levels are owned by the processes that own
+   * the fine cells below them. The boundary and manifold indicators as well
+   * as the manifolds of the coarse mesh are copied, but periodicity
+   * information is not.
+   *
+   * For serial triangulations, the triangulations are created by
+   * Triangulation::copy_triangulation() and coarsening. Other parallel
+   * triangulations are not supported.
+   */
+  template <int dim>
+  std::vector<std::shared_ptr<const Triangulation<dim>>>
+  create_geometric_coarsening_sequence(
+    const Triangulation<dim> &fine_triangulation);
+} // namespace MGTransferGlobalCoarseningTools
+
+
+
+namespace CUDAWrappers
+{
+  template <int dim, typename Number>
+  class MGTwoLevelTransfer;
+}
+
+
+
+/**
+ * The transfer between two levels of a global-coarsening multigrid method,
+ * whose spaces are represented by two different DoFHandler objects. Two
+ * kinds of levels are supported:
+ * <ul>
+ * <li> Geometric coarsening, set up by reinit_geometric_transfer(): The
+ * DoFHandler objects use the same finite element on two separate
+ * triangulations. Every active cell of the fine triangulation must either be
+ * an active cell of the coarse triangulation as well, or a child of such a
+ * cell, as is the case for the triangulations created by
+ * MGTransferGlobalCoarseningTools::create_geometric_coarsening_sequence().
+ * The triangulations may be partitioned independently of each other.
+ * <li> Polynomial coarsening, set up by reinit_polynomial_transfer(): The
+ * DoFHandler objects live on the same triangulation, with a finite element
+ * of lower degree on the coarse level, e.g. FE_Q(3) and FE_Q(6). This allows
+ * to coarsen a high-order discretization before switching to geometric
+ * coarsening, e.g. with the degrees 6, 3, 2, 1.
+ * </ul>
+ * Both kinds of levels can be combined in one MGTransferGlobalCoarsening
+ * object.
+ *
+ * The transfer acts on vectors of the active degrees of freedom of the two
+ * DoFHandler objects, i.e., on the vectors a level MatrixFree object would
+ * also use. The prolongation is assembled cell by cell from the embedding
+ * matrices of the finite element into its children, or from the
+ * interpolation matrix between the two finite elements, respectively, and
+ * stored as a sparse matrix with the locally owned fine degrees of freedom
+ * as rows. Constraints of the coarse space, e.g. from hanging nodes, are
+ * resolved into the columns, whereas constrained fine degrees of freedom get
+ * an empty row, as their values follow from the constraints of the fine
+ * level. As a consequence, prolongate() only imports the ghost values of the
+ * coarse vector, and restrict_and_add() only sends contributions to the
+ * owners of coarse degrees of freedom, but neither needs ghost values of the
+ * fine vector.
+ *
+ * The geometric transfer currently requires isotropic refinement.
+ */
+template <int dim, typename Number>
+class MGTwoLevelTransfer
+{
+public:
+  /**
+   * Set up the transfer between the DoFHandler objects @p dof_handler_fine
+   * and @p dof_handler_coarse on two triangulations that differ by at most
+   * one refinement of each cell.
+   *
+   * The constraints need to contain the lines of all locally relevant
+   * degrees of freedom, as is the case for the ones usually used for the
+   * level operators. Inhomogeneities are ignored.
+   */
+  template <typename Number2>
+  void
+  reinit_geometric_transfer(
+    const DoFHandler<dim> &           dof_handler_fine,
+    const DoFHandler<dim> &           dof_handler_coarse,
+    const AffineConstraints<Number2> &constraint_fine,
+    const AffineConstraints<Number2> &constraint_coarse);
+
+  /**
+   * Set up the transfer between the DoFHandler objects @p dof_handler_fine
+   * and @p dof_handler_coarse on the same triangulation, whose finite
+   * elements span nested spaces, such as FE_Q elements of different
+   * degrees. The fine element must be able to interpolate the coarse one,
+   * see FiniteElement::get_interpolation_matrix().
+   *
+   * The requirements on the constraints are the same as for
+   * reinit_geometric_transfer().
+   */
+  template <typename Number2>
+  void
+  reinit_polynomial_transfer(
+    const DoFHandler<dim> &           dof_handler_fine,
+    const DoFHandler<dim> &           dof_handler_coarse,
+    const AffineConstraints<Number2> &constraint_fine,
+    const AffineConstraints<Number2> &constraint_coarse);
+
+  /**
+   * Perform the prolongation from @p src on the coarse level to @p dst on
+   * the fine level. The previous content of @p dst is overwritten.
+   */
+  void
+  prolongate(LinearAlgebra::distributed::Vector<Number> &      dst,
+             const LinearAlgebra::distributed::Vector<Number> &src) const;
+
+  /**
+   * Perform the prolongation from @p src on the coarse level and add the
+   * result to @p dst on the fine level.
+   */
+  void
+  prolongate_and_add(
+    LinearAlgebra::distributed::Vector<Number> &      dst,
+    const LinearAlgebra::distributed::Vector<Number> &src) const;
+
+  /**
+   * Perform the restriction, i.e., the transpose of the prolongation, from
+   * @p src on the fine level and add the result to @p dst on the coarse
+   * level.
+   */
+  void
+  restrict_and_add(LinearAlgebra::distributed::Vector<Number> &      dst,
+                   const LinearAlgebra::distributed::Vector<Number> &src) const;
+
+  /**
+   * Return the partitioner of the locally owned degrees of freedom on the
+   * fine level.
+   */
+  const std::shared_ptr<const Utilities::MPI::Partitioner> &
+  get_partitioner_fine() const;
+
+  /**
+   * Return the partitioner of the locally owned degrees of freedom on the
+   * coarse level.
+   */
+  const std::shared_ptr<const Utilities::MPI::Partitioner> &
+  get_partitioner_coarse() const;
+
+  /**
+   * Memory used by this object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * Set up the partitioners and the sparse matrix of the prolongation from
+   * its locally owned rows @p rows, whose columns are global coarse indices.
+   */
+  void
+  setup_prolongation(
+    const IndexSet &owned_fine,
+    const IndexSet &owned_coarse,
+    const MPI_Comm &comm,
+    const std::vector<std::vector<std::pair<types::global_dof_index, double>>>
+      &rows);
+
+  /**
+   * The locally owned degrees of freedom on the fine level, without ghosts.
+   */
+  std::shared_ptr<const Utilities::MPI::Partitioner> partitioner_fine;
+
+  /**
+   * The locally owned degrees of freedom on the coarse level, without
+   * ghosts.
+   */
+  std::shared_ptr<const Utilities::MPI::Partitioner> partitioner_coarse;
+
+  /**
+   * The locally owned degrees of freedom on the coarse level together with
+   * all entries the locally owned rows of the prolongation refer to.
+   */
+  std::shared_ptr<const Utilities::MPI::Partitioner>
+    partitioner_coarse_ghosted;
+
+  /**
+   * The positions in #column_indices and #values where the rows of the
+   * prolongation start, with one additional entry marking the end of the
+   * last row. The rows are the locally owned fine degrees of freedom.
+   */
+  std::vector<unsigned int> row_starts;
+
+  /**
+   * The columns of the prolongation in the local numbering of
+   * #partitioner_coarse_ghosted.
+   */
+  std::vector<unsigned int> column_indices;
+
+  /**
+   * The entries of the prolongation.
+   */
+  std::vector<Number> values;
+
+  /**
+   * A vector with the layout of #partitioner_coarse_ghosted used for
+   * importing and exporting the ghost entries of the coarse level.
+   */
+  mutable LinearAlgebra::distributed::Vector<Number> vec_coarse;
+
+  /**
+   * The device version copies the sparse matrix of the prolongation.
+   */
+  friend class CUDAWrappers::MGTwoLevelTransfer<dim, Number>;
+};
+
+
+
+/**
+ * Implementation of the MGTransferBase interface for multigrid methods based
+ * on global coarsening. In contrast to MGTransferMatrixFree, which works on
+ * the level meshes of a single triangulation (local smoothing), the levels
+ * of the multigrid hierarchy are given by a sequence of triangulations with
+ * their own DoFHandler objects and level operators, and the transfer between
+ * two consecutive levels is done by MGTwoLevelTransfer. The vectors on all
+ * levels refer to the active degrees of freedom of the respective DoFHandler,
+ * so the level operators are the same kind of operators as on the finest
+ * level, e.g., the ones of a MatrixFree object per level, and no interface
+ * matrices are needed at refinement edges.
+ *
+ * A typical setup reads as follows:
+ * @code
+ * const auto coarse_triangulations =
+ *   MGTransferGlobalCoarseningTools::create_geometric_coarsening_sequence(
+ *     triangulation);
+ * const unsigned int max_level = coarse_triangulations.size();
+ *
+ * MGLevelObject<DoFHandler<dim>> dof_handlers(0, max_level);
+ * MGLevelObject<AffineConstraints<double>> constraints(0, max_level);
+ * for (unsigned int l = 0; l <= max_level; ++l)
+ *   {
+ *     dof_handlers[l].initialize(l < max_level ? *coarse_triangulations[l] :
+ *                                                triangulation,
+ *                                fe);
+ *     // set up constraints[l] and the level operator...
+ *   }
+ *
+ * MGLevelObject<MGTwoLevelTransfer<dim, double>> transfers(1, max_level);
+ * for (unsigned int l = 1; l <= max_level; ++l)
+ *   transfers[l].reinit_geometric_transfer(dof_handlers[l],
+ *                                          dof_handlers[l - 1],
+ *                                          constraints[l],
+ *                                          constraints[l - 1]);
+ *
+ * MGTransferGlobalCoarsening<dim, double> transfer(
+ *   transfers, [&](const unsigned int level, VectorType &vec) {
+ *     level_operators[level].initialize_dof_vector(vec);
+ *   });
+ * @endcode
+ * The finest level of the DoFHandler objects has to be the DoFHandler the
+ * global vectors handed to PreconditionMG live on.
+ */
+template <int dim, typename Number>
+class MGTransferGlobalCoarsening
+  : public MGTransferBase<LinearAlgebra::distributed::Vector<Number>>
+{
+public:
+  /**
+   * The type of the vectors on the levels.
+   */
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  /**
+   * Constructor. @p transfer holds the transfer from level <tt>l-1</tt> to
+   * level <tt>l</tt> in its entry <tt>l</tt>, for all levels except the
+   * coarsest one; the object is referenced and must outlive this one.
+   *
+   * The optional function @p initialize_dof_vector is used by copy_to_mg()
+   * to set up the level vectors, typically with the partitioners of the
+   * level MatrixFree objects. If it is not given, the level vectors only
+   * hold the locally owned degrees of freedom.
+   */
+  MGTransferGlobalCoarsening(
+    const MGLevelObject<MGTwoLevelTransfer<dim, Number>> &transfer,
+    const std::function<void(const unsigned int, VectorType &)>
+      &initialize_dof_vector =
+        std::function<void(const unsigned int, VectorType &)>());
+
+  /**
+   * Prolongate a vector from level <tt>to_level-1</tt> to level
+   * <tt>to_level</tt>. The previous content of @p dst is overwritten.
+   */
+  virtual void
+  prolongate(const unsigned int to_level,
+             VectorType &       dst,
+             const VectorType & src) const override;
+
+  /**
+   * Prolongate a vector from level <tt>to_level-1</tt> to level
+   * <tt>to_level</tt> and add it to the previous content of @p dst.
+   */
+  virtual void
+  prolongate_and_add(const unsigned int to_level,
+                     VectorType &       dst,
+                     const VectorType & src) const override;
+
+  /**
+   * Restrict a vector from level <tt>from_level</tt> to level
+   * <tt>from_level-1</tt> and add the result to @p dst.
+   */
+  virtual void
+  restrict_and_add(const unsigned int from_level,
+                   VectorType &       dst,
+                   const VectorType & src) const override;
+
+  /**
+   * Transfer the vector @p src on the finest level to the multigrid vectors.
+   * With global coarsening, the vector on the finest level is a plain copy
+   * of @p src, and the vectors on all other levels are set to zero.
+   */
+  template <class InVector, int spacedim>
+  void
+  copy_to_mg(const DoFHandler<dim, spacedim> &dof_handler,
+             MGLevelObject<VectorType> &      dst,
+             const InVector &                 src) const;
+
+  /**
+   * Copy the vector on the finest level of @p src into @p dst.
+   */
+  template <class OutVector, int spacedim>
+  void
+  copy_from_mg(const DoFHandler<dim, spacedim> &dof_handler,
+               OutVector &                      dst,
+               const MGLevelObject<VectorType> &src) const;
+
+  /**
+   * Memory used by this object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * The transfer operators between the levels.
+   */
+  SmartPointer<const MGLevelObject<MGTwoLevelTransfer<dim, Number>>,
+               MGTransferGlobalCoarsening<dim, Number>>
+    transfer;
+
+  /**
+   * The function to set up the level vectors in copy_to_mg().
+   */
+  std::function<void(const unsigned int, VectorType &)> initialize_dof_vector;
+};
+
+
+/*@}*/
+
+
+//------------------------ inline functions --------------------------------
+
+#ifndef DOXYGEN
+
+template <int dim, typename Number>
+inline const std::shared_ptr<const Utilities::MPI::Partitioner> &
+MGTwoLevelTransfer<dim, Number>::get_partitioner_fine() const
+{
+  return partitioner_fine;
+}
+
+
+
+template <int dim, typename Number>
+inline const std::shared_ptr<const Utilities::MPI::Partitioner> &
+MGTwoLevelTransfer<dim, Number>::get_partitioner_coarse() const
+{
+  return partitioner_coarse;
+}
+
+
+
+template <int dim, typename Number>
+MGTransferGlobalCoarsening<dim, Number>::MGTransferGlobalCoarsening(
+  const MGLevelObject<MGTwoLevelTransfer<dim, Number>> &transfer,
+  const std::function<void(const unsigned int, VectorType &)>
+    &initialize_dof_vector)
+  : transfer(&transfer)
+  , initialize_dof_vector(initialize_dof_vector)
+{}
+
+
+
+template <int dim, typename Number>
+void
+MGTransferGlobalCoarsening<dim, Number>::prolongate(
+  const unsigned int to_level,
+  VectorType &       dst,
+  const VectorType & src) const
+{
+  (*transfer)[to_level].prolongate(dst, src);
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTransferGlobalCoarsening<dim, Number>::prolongate_and_add(
+  const unsigned int to_level,
+  VectorType &       dst,
+  const VectorType & src) const
+{
+  (*transfer)[to_level].prolongate_and_add(dst, src);
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTransferGlobalCoarsening<dim, Number>::restrict_and_add(
+  const unsigned int from_level,
+  VectorType &       dst,
+  const VectorType & src) const
+{
+  (*transfer)[from_level].restrict_and_add(dst, src);
+}
+
+
+
+template <int dim, typename Number>
+template <class InVector, int spacedim>
+void
+MGTransferGlobalCoarsening<dim, Number>::copy_to_mg(
+  const DoFHandler<dim, spacedim> &dof_handler,
+  MGLevelObject<VectorType> &      dst,
+  const InVector &                 src) const
+{
+  (void)dof_handler;
+  AssertDimension(dst.max_level(), transfer->max_level());
+  AssertDimension(dst.min_level() + 1, transfer->min_level());
+
+  for (unsigned int level = dst.min_level(); level <= dst.max_level(); ++level)
+    {
+      if (initialize_dof_vector)
+        initialize_dof_vector(level, dst[level]);
+      else
+        {
+          const auto &partitioner =
+            level == dst.max_level() ?
+              (*transfer)[level].get_partitioner_fine() :
+              (*transfer)[level + 1].get_partitioner_coarse();
+          if (dst[level].size() != partitioner->size() ||
+              dst[level].local_size() != partitioner->local_size())
+            dst[level].reinit(partitioner);
+        }
+      dst[level] = 0.;
+    }
+
+  VectorType &dst_fine = dst[dst.max_level()];
+  AssertDimension(dst_fine.local_size(), src.local_size());
+  for (unsigned int i = 0; i < dst_fine.local_size(); ++i)
+    dst_fine.local_element(i) = src.local_element(i);
+}
+
+
+
+template <int dim, typename Number>
+template <class OutVector, int spacedim>
+void
+MGTransferGlobalCoarsening<dim, Number>::copy_from_mg(
+  const DoFHandler<dim, spacedim> &dof_handler,
+  OutVector &                      dst,
+  const MGLevelObject<VectorType> &src) const
+{
+  (void)dof_handler;
+  const VectorType &src_fine = src[src.max_level()];
+  AssertDimension(dst.local_size(), src_fine.local_size());
+  for (unsigned int i = 0; i < src_fine.local_size(); ++i)
+    dst.local_element(i) = src_fine.local_element(i);
+}
+
+
+
+template <int dim, typename Number>
+std::size_t
+MGTransferGlobalCoarsening<dim, Number>::memory_consumption() const
+{
+  std::size_t memory = 0;
+  for (unsigned int level = transfer->min_level();
+       level <= transfer->max_level();
+       ++level)
+    memory += (*transfer)[level].memory_consumption();
+  return memory;
+}
+
+#endif // DOXYGEN
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -115,7 +115,13 @@ namespace internal
     };
 
     /**
-     * Set up most of the internal data structures of MGTransferMatrixFree
+     * Set up most of the internal data structures of MGTransferMatrixFree.
+     *
+     * If @p external_partitioners is non-empty, it holds one partitioner per
+     * level. The ghosted level vectors are then set up with these
+     * partitioners instead of the minimal ones needed for the transfer,
+     * provided that their ghost indices contain all indices accessed by the
+     * transfer on all processes.
      */
     template <int dim, typename Number>
     void
@@ -132,7 +138,10 @@ namespace internal
       std::vector<std::vector<std::pair<unsigned int, unsigned int>>>
         &copy_indices_global_mine,
       MGLevelObject<LinearAlgebra::distributed::Vector<Number>>
-        &ghosted_level_vector);
+        &ghosted_level_vector,
+      const std::vector<std::shared_ptr<const Utilities::MPI::Partitioner>>
+        &external_partitioners =
+          std::vector<std::shared_ptr<const Utilities::MPI::Partitioner>>());
 
   } // namespace MGTransfer
 } // namespace internal
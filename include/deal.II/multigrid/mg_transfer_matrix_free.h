@@ -89,9 +89,22 @@ public:
 
   /**
    * Actually build the information for the prolongation for each level.
+   *
+   * The optional argument @p external_partitioners allows to pass one
+   * partitioner per level, typically the ones of the level MatrixFree
+   * objects, i.e., <tt>matrix_free.get_vector_partitioner()</tt>. If the
+   * ghost range of these partitioners contains all the entries accessed by
+   * the transfer, the internal ghosted level vectors use them, and so do the
+   * level vectors set up by copy_to_mg(). Then, prolongate_and_add() and
+   * restrict_and_add() work directly on the vectors handed in, and the level
+   * operators do not need to copy the vectors into their own layout either.
+   * Otherwise, the partitioners are ignored.
    */
   void
-  build(const DoFHandler<dim, dim> &mg_dof);
+  build(const DoFHandler<dim, dim> &mg_dof,
+        const std::vector<std::shared_ptr<const Utilities::MPI::Partitioner>>
+          &external_partitioners =
+            std::vector<std::shared_ptr<const Utilities::MPI::Partitioner>>());
 
   /**
    * Prolongate a vector from level <tt>to_level-1</tt> to level
@@ -113,6 +126,27 @@ public:
     LinearAlgebra::distributed::Vector<Number> &      dst,
     const LinearAlgebra::distributed::Vector<Number> &src) const override;
 
+  /**
+   * Prolongate a vector from level <tt>to_level-1</tt> to level
+   * <tt>to_level</tt> like prolongate(), but add the result to the previous
+   * content of <tt>dst</tt>. This is the coarse grid correction of a
+   * V-cycle, which Multigrid calls instead of a prolongation into a
+   * temporary vector followed by an addition.
+   *
+   * If @p src uses the same partitioner as the internal ghosted vector of
+   * level <tt>to_level-1</tt>, its ghost values are imported in place rather
+   * than copying it into the internal vector first, and zeroed again at the
+   * end. Likewise, if @p dst uses the partitioner of level <tt>to_level</tt>,
+   * the result is accumulated directly into @p dst. This is the case for
+   * level vectors set up by copy_to_mg() or as copies of those, so the
+   * coarse grid correction then touches each vector only once.
+   */
+  virtual void
+  prolongate_and_add(
+    const unsigned int                                to_level,
+    LinearAlgebra::distributed::Vector<Number> &      dst,
+    const LinearAlgebra::distributed::Vector<Number> &src) const override;
+
   /**
    * Restrict a vector from level <tt>from_level</tt> to level
    * <tt>from_level-1</tt> using the transpose operation of the prolongate()
@@ -130,6 +164,10 @@ public:
    *
    * @param dst has as many elements as there are degrees of freedom on the
    * coarser level.
+   *
+   * As for prolongate_and_add(), the copies into the internal ghosted
+   * vectors are skipped if @p src and @p dst use the partitioners of the
+   * respective levels.
    */
   virtual void
   restrict_and_add(
@@ -0,0 +1,884 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_mg_vertex_patch_smoother_h
+#define dealii_mg_vertex_patch_smoother_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/partitioner.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/tensor_product_matrix.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/shape_info.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup mg */
+/*@{*/
+
+/**
+ * An overlapping Schwarz smoother on vertex patches for continuous scalar
+ * tensor-product elements, meant to be used as the preconditioner of
+ * MGSmootherPrecondition on each level of a multigrid hierarchy (or, e.g.,
+ * inside PreconditionChebyshev).
+ *
+ * A vertex patch consists of the $2^d$ cells around an interior vertex of the
+ * mesh. The smoother solves local problems on the degrees of freedom in the
+ * interior of each patch, i.e., on a tensor grid of $(2k-1)^d$ unknowns for
+ * elements of degree $k$. The local matrices are not extracted from the
+ * operator but set up as the Laplacian on the patch, using the extent of the
+ * cells in each coordinate direction. This makes the local matrices separable
+ * sums of Kronecker products, which are inverted by the fast diagonalization
+ * method in TensorProductMatrixSymmetricSum. The patches are grouped into
+ * batches of VectorizedArray<Number>::n_array_elements patches of the same
+ * color, so that the inverses of all patches in a batch are applied with a
+ * single pass through the vectorized tensor-product kernels.
+ *
+ * The smoother comes in two flavors selected by AdditionalData::type:
+ * <ul>
+ * <li> The additive variant computes $P^{-1} r = \omega \sum_p R_p^T A_p^{-1}
+ * R_p r$ over all patches $p$, where $R_p$ restricts a global vector to the
+ * interior unknowns of the patch. It is symmetric and does not use the
+ * operator, but needs a relaxation parameter $\omega$ (or an outer
+ * PreconditionChebyshev) since the patches overlap.
+ * <li> The multiplicative variant visits the colors one after another and
+ * updates the residual with one operator evaluation between two colors.
+ * Patches of the same color do not share any cell and are thus independent
+ * of each other. Tvmult() visits the colors in reverse order, such that
+ * alternating calls to vmult() and Tvmult() as done by
+ * MGSmootherPrecondition with the symmetric flag give a symmetric smoother.
+ * </ul>
+ *
+ * The patch unknowns are read through a vector with its own ghost layer that
+ * contains all unknowns of the patches a process works on. Each patch is
+ * handled by exactly one process, namely the owner of the cell with the
+ * lowest subdomain id among the cells of the patch, and the contributions to
+ * unknowns owned by other processes are sent back by
+ * LinearAlgebra::distributed::Vector::compress(). The coloring is computed on
+ * each process separately, so the multiplicative variant acts additively
+ * between the patches of different processes.
+ *
+ * @note The setup assumes that neighboring cells share their faces in the
+ * standard orientation and that the cells are aligned with the coordinate
+ * directions, as is the case for meshes generated from
+ * GridGenerator::subdivided_hyper_rectangle() and similar functions. Patches
+ * where the degrees of freedom seen from the different cells do not match
+ * are skipped. The same holds for patches with cells on different levels of
+ * an adaptively refined mesh. Unknowns that are not in the interior of any
+ * patch, e.g. unknowns on a Neumann boundary, are not touched by the
+ * smoother.
+ *
+ * @tparam MatrixType The level operator. It must provide a vmult() function
+ * for LinearAlgebra::distributed::Vector<Number> objects set up by
+ * MatrixFree::initialize_dof_vector(), as e.g.
+ * MatrixFreeOperators::LaplaceOperator. It is only used by the
+ * multiplicative variant.
+ *
+ * @author Martin Kronbichler, 2019
+ */
+template <int dim, typename MatrixType, typename Number = double>
+class VertexPatchSmoother : public Subscriptor
+{
+public:
+  /**
+   * Type of the vectors the smoother operates on.
+   */
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  /**
+   * Standardized data struct to pipe additional data to the smoother.
+   */
+  struct AdditionalData
+  {
+    /**
+     * The ways of combining the patch corrections.
+     */
+    enum class Type
+    {
+      /**
+       * Sum up the corrections of all patches computed for the same
+       * residual.
+       */
+      additive,
+      /**
+       * Update the residual after each color of patches.
+       */
+      multiplicative
+    };
+
+    /**
+     * Constructor.
+     */
+    AdditionalData(const Type         type       = Type::additive,
+                   const Number       relaxation = 1.,
+                   const unsigned int level = numbers::invalid_unsigned_int);
+
+    /**
+     * The MatrixFree object the level operator is based on. It provides the
+     * DoFHandler, the layout of the vectors and the underlying finite
+     * element.
+     */
+    std::shared_ptr<const MatrixFree<dim, Number>> matrix_free;
+
+    /**
+     * The variant of the smoother.
+     */
+    Type type;
+
+    /**
+     * The relaxation parameter the patch corrections are multiplied by.
+     */
+    Number relaxation;
+
+    /**
+     * The multigrid level the MatrixFree object has been set up for. The
+     * default value selects the active cells.
+     */
+    unsigned int level;
+
+    /**
+     * The global indices of the unknowns the smoother does not touch, e.g.
+     * the indices returned by MGConstrainedDoFs::get_boundary_indices() for
+     * Dirichlet boundaries. Patch unknowns in this set are neither read
+     * nor written. The set must contain the relevant indices of all patches
+     * of a process, including those owned by other processes.
+     */
+    IndexSet constrained_dofs;
+  };
+
+  /**
+   * Constructor.
+   */
+  VertexPatchSmoother();
+
+  /**
+   * Set up the patches of the mesh underlying @p additional_data.matrix_free
+   * and the inverses of the local matrices. The @p matrix is only used by
+   * the multiplicative variant.
+   */
+  void
+  initialize(const MatrixType &    matrix,
+             const AdditionalData &additional_data);
+
+  /**
+   * Release all memory and reset the object to the state after the default
+   * constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Apply the smoother to @p src, i.e., run one sweep over the patches for
+   * the equation with right hand side @p src starting from a zero vector.
+   */
+  void
+  vmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Apply the transpose of the smoother, which visits the colors in reverse
+   * order for the multiplicative variant and is the same as vmult() for the
+   * additive one.
+   */
+  void
+  Tvmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Run one sweep over the patches for the equation with right hand side
+   * @p src, starting with the content of @p dst.
+   */
+  void
+  step(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Run one sweep of the transpose smoother, starting with the content of
+   * @p dst.
+   */
+  void
+  Tstep(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Return the number of patches this process works on.
+   */
+  unsigned int
+  n_patches() const;
+
+  /**
+   * Return the number of colors of the patches of this process.
+   */
+  unsigned int
+  n_colors() const;
+
+  /**
+   * Return the memory consumption of this object in bytes.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * Run one sweep over the colors in forward or reverse order and add the
+   * result to @p dst. If @p zero_initial_guess is set, the content of @p dst
+   * is assumed to be zero, which skips the first residual evaluation.
+   */
+  void
+  do_sweep(VectorType &      dst,
+           const VectorType &src,
+           const bool        zero_initial_guess,
+           const bool        reverse) const;
+
+  /**
+   * Add the relaxed patch corrections of the batches in the given range for
+   * the residual stored in src_patches to dst_patches.
+   */
+  void
+  apply_batches(const unsigned int first_batch,
+                const unsigned int last_batch) const;
+
+  /**
+   * Pointer to the level operator.
+   */
+  SmartPointer<const MatrixType, VertexPatchSmoother> matrix;
+
+  /**
+   * The variant of the smoother.
+   */
+  typename AdditionalData::Type type;
+
+  /**
+   * The relaxation parameter.
+   */
+  Number relaxation;
+
+  /**
+   * The number of unknowns in the interior of a patch per direction.
+   */
+  unsigned int n_dofs_1d;
+
+  /**
+   * The number of unknowns in the interior of a patch.
+   */
+  unsigned int n_dofs_per_patch;
+
+  /**
+   * The number of patches of this process.
+   */
+  unsigned int n_local_patches;
+
+  /**
+   * The inverses of the local matrices, one object per batch of patches.
+   */
+  std::vector<TensorProductMatrixSymmetricSum<dim, VectorizedArray<Number>>>
+    patch_matrices;
+
+  /**
+   * The indices of the patch unknowns in the local index space of
+   * patch_partitioner with the lanes of a batch running fastest, i.e.,
+   * entry <tt>(batch * n_dofs_per_patch + i) * n_lanes + lane</tt>, with
+   * numbers::invalid_unsigned_int for unknowns that are skipped and for the
+   * unused lanes of a batch.
+   */
+  std::vector<unsigned int> patch_dof_indices;
+
+  /**
+   * The range of batches of each color, i.e., the batches of color @p c are
+   * the ones from <tt>color_starts[c]</tt> to <tt>color_starts[c+1]</tt>.
+   */
+  std::vector<unsigned int> color_starts;
+
+  /**
+   * The partitioner with the locally owned range of the MatrixFree vectors
+   * and the ghost unknowns of all local patches.
+   */
+  std::shared_ptr<const Utilities::MPI::Partitioner> patch_partitioner;
+
+  /**
+   * Ghosted vector holding the residual of the patch unknowns.
+   */
+  mutable VectorType src_patches;
+
+  /**
+   * Ghosted vector collecting the patch corrections.
+   */
+  mutable VectorType dst_patches;
+
+  /**
+   * Vector for the residual of the multiplicative variant.
+   */
+  mutable VectorType residual;
+};
+
+/*@}*/
+
+/* ------------------------- inline functions --------------------------- */
+
+#ifndef DOXYGEN
+
+template <int dim, typename MatrixType, typename Number>
+inline VertexPatchSmoother<dim, MatrixType, Number>::AdditionalData::
+  AdditionalData(const Type         type,
+                 const Number       relaxation,
+                 const unsigned int level)
+  : type(type)
+  , relaxation(relaxation)
+  , level(level)
+{}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline VertexPatchSmoother<dim, MatrixType, Number>::VertexPatchSmoother()
+  : type(AdditionalData::Type::additive)
+  , relaxation(1.)
+  , n_dofs_1d(0)
+  , n_dofs_per_patch(0)
+  , n_local_patches(0)
+{}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline void
+VertexPatchSmoother<dim, MatrixType, Number>::clear()
+{
+  matrix           = nullptr;
+  type             = AdditionalData::Type::additive;
+  relaxation       = 1.;
+  n_dofs_1d        = 0;
+  n_dofs_per_patch = 0;
+  n_local_patches  = 0;
+  patch_matrices.clear();
+  patch_dof_indices.clear();
+  color_starts.clear();
+  patch_partitioner.reset();
+  src_patches.reinit(0);
+  dst_patches.reinit(0);
+  residual.reinit(0);
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline void
+VertexPatchSmoother<dim, MatrixType, Number>::initialize(
+  const MatrixType &    matrix,
+  const AdditionalData &additional_data)
+{
+  Assert(additional_data.matrix_free.get() != nullptr,
+         ExcMessage("The smoother needs a MatrixFree object to set up the "
+                    "patches."));
+  const MatrixFree<dim, Number> &matrix_free = *additional_data.matrix_free;
+  const DoFHandler<dim> &        dof_handler = matrix_free.get_dof_handler();
+  const FiniteElement<dim> &     fe          = dof_handler.get_fe();
+  AssertThrow(fe.n_components() == 1 && fe.dofs_per_vertex == 1,
+              ExcMessage("VertexPatchSmoother only works for continuous "
+                         "scalar elements."));
+
+  const unsigned int k = fe.degree;
+  const internal::MatrixFreeFunctions::ShapeInfo<double> shape_info(
+    QGauss<1>(k + 1), fe);
+  AssertThrow(shape_info.element_type <=
+                internal::MatrixFreeFunctions::tensor_symmetric,
+              ExcMessage("VertexPatchSmoother only works for elements with "
+                         "a symmetric tensor-product basis like FE_Q."));
+
+  clear();
+  this->matrix = &matrix;
+  type         = additional_data.type;
+  relaxation   = additional_data.relaxation;
+
+  constexpr unsigned int n_lanes = VectorizedArray<Number>::n_array_elements;
+  constexpr unsigned int n_cells_per_patch = 1U << dim;
+  n_dofs_1d        = 2 * k - 1;
+  n_dofs_per_patch = Utilities::pow(n_dofs_1d, dim);
+
+  // 1D mass and stiffness matrices of the reference interval in
+  // lexicographic order
+  const QGauss<1>      quadrature(k + 1);
+  const unsigned int   n_q_points = quadrature.size();
+  Table<2, Number>     mass_1d(k + 1, k + 1), laplace_1d(k + 1, k + 1);
+  for (unsigned int i = 0; i <= k; ++i)
+    for (unsigned int j = 0; j <= k; ++j)
+      {
+        double sum_mass = 0., sum_laplace = 0.;
+        for (unsigned int q = 0; q < n_q_points; ++q)
+          {
+            sum_mass += shape_info.shape_values[i * n_q_points + q] *
+                        shape_info.shape_values[j * n_q_points + q] *
+                        quadrature.weight(q);
+            sum_laplace += shape_info.shape_gradients[i * n_q_points + q] *
+                           shape_info.shape_gradients[j * n_q_points + q] *
+                           quadrature.weight(q);
+          }
+        mass_1d(i, j)    = sum_mass;
+        laplace_1d(i, j) = sum_laplace;
+      }
+
+  // collect the cells around each vertex together with their unknowns
+  const bool level_cells =
+    additional_data.level != numbers::invalid_unsigned_int;
+  const Triangulation<dim> &tria         = dof_handler.get_triangulation();
+  const types::subdomain_id my_subdomain = tria.locally_owned_subdomain();
+  std::vector<typename Triangulation<dim>::cell_iterator> cells;
+  std::vector<types::subdomain_id>                        cell_subdomains;
+  std::vector<types::global_dof_index>                    cell_dofs;
+  std::vector<std::vector<std::pair<unsigned int, unsigned int>>>
+    cells_at_vertex(tria.n_vertices());
+  {
+    std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+    const auto add_cell = [&](const types::subdomain_id subdomain) {
+      for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+        cells_at_vertex[cells.back()->vertex_index(v)].emplace_back(
+          cells.size() - 1, v);
+      cell_subdomains.push_back(subdomain);
+      cell_dofs.insert(cell_dofs.end(), dof_indices.begin(), dof_indices.end());
+    };
+    if (level_cells)
+      {
+        AssertIndexRange(additional_data.level, tria.n_global_levels());
+        for (const auto &cell :
+             dof_handler.mg_cell_iterators_on_level(additional_data.level))
+          if (cell->level_subdomain_id() != numbers::artificial_subdomain_id)
+            {
+              cell->get_mg_dof_indices(dof_indices);
+              cells.push_back(cell);
+              add_cell(cell->level_subdomain_id());
+            }
+      }
+    else
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        if (cell->is_artificial() == false)
+          {
+            cell->get_dof_indices(dof_indices);
+            cells.push_back(cell);
+            add_cell(cell->subdomain_id());
+          }
+  }
+
+  // extract the interior unknowns of all patches this process works on. a
+  // cell sits at position 0 in direction d if the patch vertex is its
+  // vertex at the upper end in that direction and at position 1 otherwise
+  std::vector<types::global_dof_index>                   global_patch_dofs;
+  std::vector<std::array<unsigned int, n_cells_per_patch>> patches;
+  {
+    std::vector<types::global_dof_index>        dofs_on_patch(n_dofs_per_patch);
+    std::array<unsigned int, n_cells_per_patch> patch_cells;
+    for (const auto &cells_of_patch : cells_at_vertex)
+      {
+        if (cells_of_patch.size() != n_cells_per_patch)
+          continue;
+
+        bool                position_taken[n_cells_per_patch] = {};
+        bool                patch_is_valid = true;
+        types::subdomain_id owner          = numbers::invalid_subdomain_id;
+        for (const auto &cell : cells_of_patch)
+          {
+            unsigned int position = 0;
+            for (unsigned int d = 0; d < dim; ++d)
+              if (((cell.second >> d) & 1) == 0)
+                position |= 1U << d;
+            if (position_taken[position] ||
+                cells[cell.first]->level() !=
+                  cells[cells_of_patch[0].first]->level())
+              patch_is_valid = false;
+            position_taken[position] = true;
+            patch_cells[position]    = cell.first;
+            owner = std::min(owner, cell_subdomains[cell.first]);
+          }
+        if (patch_is_valid == false ||
+            (my_subdomain != numbers::invalid_subdomain_id &&
+             owner != my_subdomain))
+          continue;
+
+        // the unknowns on the interfaces between the cells are seen from
+        // several cells, which must agree on the index
+        for (unsigned int i = 0; i < n_dofs_per_patch && patch_is_valid; ++i)
+          {
+            unsigned int patch_index[dim];
+            for (unsigned int d = 0, stride = 1; d < dim;
+                 ++d, stride *= n_dofs_1d)
+              patch_index[d] = 1 + (i / stride) % n_dofs_1d;
+
+            dofs_on_patch[i] = numbers::invalid_dof_index;
+            for (unsigned int c = 0; c < n_cells_per_patch; ++c)
+              {
+                unsigned int cell_index = 0;
+                bool         cell_has_dof = true;
+                for (unsigned int d = 0, stride = 1; d < dim;
+                     ++d, stride *= k + 1)
+                  {
+                    const unsigned int position = (c >> d) & 1;
+                    if (position == 0 ? patch_index[d] > k :
+                                        patch_index[d] < k)
+                      cell_has_dof = false;
+                    cell_index += (patch_index[d] - position * k) * stride;
+                  }
+                if (cell_has_dof == false)
+                  continue;
+
+                const types::global_dof_index index =
+                  cell_dofs[static_cast<std::size_t>(patch_cells[c]) *
+                              fe.dofs_per_cell +
+                            shape_info.lexicographic_numbering[cell_index]];
+                if (dofs_on_patch[i] == numbers::invalid_dof_index)
+                  dofs_on_patch[i] = index;
+                else if (dofs_on_patch[i] != index)
+                  patch_is_valid = false;
+              }
+          }
+        if (patch_is_valid == false)
+          continue;
+
+        for (auto &index : dofs_on_patch)
+          if (additional_data.constrained_dofs.size() > 0 &&
+              additional_data.constrained_dofs.is_element(index))
+            index = numbers::invalid_dof_index;
+        global_patch_dofs.insert(global_patch_dofs.end(),
+                                 dofs_on_patch.begin(),
+                                 dofs_on_patch.end());
+        patches.push_back(patch_cells);
+      }
+  }
+  n_local_patches = patches.size();
+
+  // greedy coloring of the patches such that patches of the same color do
+  // not share a cell
+  std::vector<unsigned int> patch_colors(n_local_patches);
+  unsigned int              n_colors = 0;
+  {
+    std::vector<std::vector<unsigned int>> patches_of_cell(cells.size());
+    for (unsigned int p = 0; p < n_local_patches; ++p)
+      for (const unsigned int cell : patches[p])
+        patches_of_cell[cell].push_back(p);
+
+    std::vector<unsigned int> color_used_by(n_cells_per_patch * 8,
+                                            numbers::invalid_unsigned_int);
+    for (unsigned int p = 0; p < n_local_patches; ++p)
+      {
+        for (const unsigned int cell : patches[p])
+          for (const unsigned int neighbor : patches_of_cell[cell])
+            if (neighbor < p)
+              {
+                if (patch_colors[neighbor] >= color_used_by.size())
+                  color_used_by.resize(2 * patch_colors[neighbor] + 1,
+                                       numbers::invalid_unsigned_int);
+                color_used_by[patch_colors[neighbor]] = p;
+              }
+        unsigned int color = 0;
+        while (color < color_used_by.size() && color_used_by[color] == p)
+          ++color;
+        patch_colors[p] = color;
+        n_colors        = std::max(n_colors, color + 1);
+      }
+  }
+
+  // set up the vector layout with all patch unknowns as ghosts
+  const Utilities::MPI::Partitioner &vector_partitioner =
+    *matrix_free.get_vector_partitioner();
+  {
+    IndexSet ghost_indices(vector_partitioner.size());
+    std::vector<types::global_dof_index> ghosts;
+    for (const auto index : global_patch_dofs)
+      if (index != numbers::invalid_dof_index &&
+          vector_partitioner.in_local_range(index) == false)
+        ghosts.push_back(index);
+    std::sort(ghosts.begin(), ghosts.end());
+    ghosts.erase(std::unique(ghosts.begin(), ghosts.end()), ghosts.end());
+    ghost_indices.add_indices(ghosts.begin(), ghosts.end());
+    ghost_indices.compress();
+    patch_partitioner = std::make_shared<Utilities::MPI::Partitioner>(
+      vector_partitioner.locally_owned_range(),
+      ghost_indices,
+      vector_partitioner.get_mpi_communicator());
+  }
+  src_patches.reinit(patch_partitioner);
+  dst_patches.reinit(patch_partitioner);
+
+  // sort the patches by color, fill the batches and compute the 1D
+  // matrices of the patches from the extent of the cells
+  std::vector<unsigned int> patches_by_color(n_local_patches);
+  for (unsigned int p = 0; p < n_local_patches; ++p)
+    patches_by_color[p] = p;
+  std::stable_sort(patches_by_color.begin(),
+                   patches_by_color.end(),
+                   [&](const unsigned int a, const unsigned int b) {
+                     return patch_colors[a] < patch_colors[b];
+                   });
+
+  color_starts.resize(n_colors + 1, 0);
+  std::vector<std::vector<unsigned int>> batches;
+  for (unsigned int i = 0; i < n_local_patches;)
+    {
+      const unsigned int color = patch_colors[patches_by_color[i]];
+      std::vector<unsigned int> batch;
+      for (; i < n_local_patches && batch.size() < n_lanes &&
+             patch_colors[patches_by_color[i]] == color;
+           ++i)
+        batch.push_back(patches_by_color[i]);
+      batches.push_back(batch);
+      color_starts[color + 1] = batches.size();
+    }
+
+  patch_matrices.resize(batches.size());
+  patch_dof_indices.resize(static_cast<std::size_t>(batches.size()) *
+                             n_dofs_per_patch * n_lanes,
+                           numbers::invalid_unsigned_int);
+  std::array<Table<2, VectorizedArray<Number>>, dim> mass_matrices,
+    laplace_matrices;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      mass_matrices[d].reinit(n_dofs_1d, n_dofs_1d);
+      laplace_matrices[d].reinit(n_dofs_1d, n_dofs_1d);
+    }
+  for (unsigned int b = 0; b < batches.size(); ++b)
+    {
+      for (unsigned int l = 0; l < n_lanes; ++l)
+        {
+          // fill the unused lanes with the matrices of the first patch
+          const unsigned int p = batches[b][l < batches[b].size() ? l : 0];
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              const double h[2] = {
+                cells[patches[p][0]]->extent_in_direction(d),
+                cells[patches[p][1U << d]]->extent_in_direction(d)};
+              for (unsigned int i = 1; i < 2 * k; ++i)
+                for (unsigned int j = 1; j < 2 * k; ++j)
+                  {
+                    double mass = 0., laplace = 0.;
+                    for (unsigned int c = 0; c < 2; ++c)
+                      if (i >= c * k && i <= (c + 1) * k && j >= c * k &&
+                          j <= (c + 1) * k)
+                        {
+                          mass += h[c] * mass_1d(i - c * k, j - c * k);
+                          laplace += laplace_1d(i - c * k, j - c * k) / h[c];
+                        }
+                    mass_matrices[d](i - 1, j - 1)[l]    = mass;
+                    laplace_matrices[d](i - 1, j - 1)[l] = laplace;
+                  }
+            }
+          if (l < batches[b].size())
+            for (unsigned int i = 0; i < n_dofs_per_patch; ++i)
+              {
+                const types::global_dof_index index =
+                  global_patch_dofs[static_cast<std::size_t>(p) *
+                                      n_dofs_per_patch +
+                                    i];
+                if (index != numbers::invalid_dof_index)
+                  patch_dof_indices[(static_cast<std::size_t>(b) *
+                                       n_dofs_per_patch +
+                                     i) *
+                                      n_lanes +
+                                    l] =
+                    patch_partitioner->global_to_local(index);
+              }
+        }
+      patch_matrices[b].reinit(mass_matrices, laplace_matrices);
+    }
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline void
+VertexPatchSmoother<dim, MatrixType, Number>::apply_batches(
+  const unsigned int first_batch,
+  const unsigned int last_batch) const
+{
+  constexpr unsigned int n_lanes = VectorizedArray<Number>::n_array_elements;
+  AlignedVector<VectorizedArray<Number>> src_values(n_dofs_per_patch),
+    dst_values(n_dofs_per_patch);
+
+  for (unsigned int b = first_batch; b < last_batch; ++b)
+    {
+      const unsigned int *indices =
+        patch_dof_indices.data() +
+        static_cast<std::size_t>(b) * n_dofs_per_patch * n_lanes;
+      for (unsigned int i = 0; i < n_dofs_per_patch; ++i)
+        for (unsigned int l = 0; l < n_lanes; ++l)
+          src_values[i][l] =
+            indices[i * n_lanes + l] == numbers::invalid_unsigned_int ?
+              Number() :
+              src_patches.local_element(indices[i * n_lanes + l]);
+
+      patch_matrices[b].apply_inverse(
+        make_array_view(dst_values.begin(), dst_values.end()),
+        ArrayView<const VectorizedArray<Number>>(src_values.begin(),
+                                                 src_values.size()));
+
+      for (unsigned int i = 0; i < n_dofs_per_patch; ++i)
+        for (unsigned int l = 0; l < n_lanes; ++l)
+          if (indices[i * n_lanes + l] != numbers::invalid_unsigned_int)
+            dst_patches.local_element(indices[i * n_lanes + l]) +=
+              relaxation * dst_values[i][l];
+    }
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline void
+VertexPatchSmoother<dim, MatrixType, Number>::do_sweep(
+  VectorType &      dst,
+  const VectorType &src,
+  const bool        zero_initial_guess,
+  const bool        reverse) const
+{
+  Assert(patch_partitioner.get() != nullptr, ExcNotInitialized());
+  AssertDimension(dst.local_size(), patch_partitioner->local_size());
+  AssertDimension(src.local_size(), patch_partitioner->local_size());
+
+  const bool multiplicative = type == AdditionalData::Type::multiplicative;
+  const unsigned int n_sweeps = multiplicative ? n_colors() : 1;
+  for (unsigned int sweep = 0; sweep < n_sweeps; ++sweep)
+    {
+      const VectorType *rhs = &src;
+      if (sweep > 0 || zero_initial_guess == false)
+        {
+          Assert(matrix != nullptr, ExcNotInitialized());
+          if (residual.get_partitioner().get() != dst.get_partitioner().get())
+            residual.reinit(dst, true);
+          matrix->vmult(residual, dst);
+          residual.sadd(-1., 1., src);
+          rhs = &residual;
+        }
+
+      src_patches.copy_locally_owned_data_from(*rhs);
+      src_patches.update_ghost_values();
+      dst_patches = 0.;
+
+      if (multiplicative)
+        {
+          const unsigned int color = reverse ? n_sweeps - 1 - sweep : sweep;
+          apply_batches(color_starts[color], color_starts[color + 1]);
+        }
+      else
+        apply_batches(0, patch_matrices.size());
+
+      dst_patches.compress(VectorOperation::add);
+      dst += dst_patches;
+    }
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline void
+VertexPatchSmoother<dim, MatrixType, Number>::vmult(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  dst = 0.;
+  do_sweep(dst, src, true, false);
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline void
+VertexPatchSmoother<dim, MatrixType, Number>::Tvmult(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  dst = 0.;
+  do_sweep(dst, src, true, true);
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline void
+VertexPatchSmoother<dim, MatrixType, Number>::step(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  do_sweep(dst, src, false, false);
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline void
+VertexPatchSmoother<dim, MatrixType, Number>::Tstep(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  do_sweep(dst, src, false, true);
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline unsigned int
+VertexPatchSmoother<dim, MatrixType, Number>::n_patches() const
+{
+  return n_local_patches;
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline unsigned int
+VertexPatchSmoother<dim, MatrixType, Number>::n_colors() const
+{
+  return color_starts.empty() ? 0 : color_starts.size() - 1;
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline std::size_t
+VertexPatchSmoother<dim, MatrixType, Number>::memory_consumption() const
+{
+  // each batch stores the 1D mass matrices, derivative matrices and
+  // eigenvectors as well as the eigenvalues in each direction
+  return sizeof(*this) +
+         patch_matrices.size() *
+           (sizeof(patch_matrices[0]) +
+            dim * (3 * n_dofs_1d * n_dofs_1d + n_dofs_1d) *
+              sizeof(VectorizedArray<Number>)) +
+         MemoryConsumption::memory_consumption(patch_dof_indices) +
+         MemoryConsumption::memory_consumption(color_starts) +
+         src_patches.memory_consumption() + dst_patches.memory_consumption() +
+         residual.memory_consumption();
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -84,8 +84,9 @@ namespace mg
 
     /**
      * This signal is triggered before (@p before is true) and after (@p before
-     * is false) the call to MGTransfer::prolongate() which prolongs a vector to
-     * @p level from the next coarser one (@p level - 1).
+     * is false) the call to MGTransfer::prolongate_and_add() which prolongs a
+     * vector to @p level from the next coarser one (@p level - 1) and adds it
+     * to the solution on @p level.
      */
     boost::signals2::signal<void(const bool before, const unsigned int level)>
       prolongation;
@@ -167,13 +167,9 @@ Multigrid<VectorType>::level_v_step(const unsigned int level)
 
   // do coarse grid correction
   this->signals.prolongation(true, level);
-  transfer->prolongate(level, t[level], solution[level - 1]);
+  transfer->prolongate_and_add(level, solution[level], solution[level - 1]);
   this->signals.prolongation(false, level);
 
-  if (debug > 2)
-    deallog << "Prolongate norm        " << t[level].l2_norm() << std::endl;
-  solution[level] += t[level];
-
   // get in contribution from edge matrices to the defect
   if (edge_in != nullptr)
     {
@@ -295,8 +291,7 @@ Multigrid<VectorType>::level_step(const unsigned int level, Cycle cycle)
     }
 
   // do coarse grid correction
-  transfer->prolongate(level, t[level], solution[level - 1]);
-  solution[level] += t[level];
+  transfer->prolongate_and_add(level, solution[level], solution[level - 1]);
 
   // get in contribution from edge matrices to the defect
   if (edge_in != nullptr)
@@ -19,11 +19,15 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/quadrature.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/table.h>
 
 #include <deal.II/dofs/dof_handler.h>
 
 #include <deal.II/fe/component_mask.h>
 #include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_values.h>
 #include <deal.II/fe/mapping_q1.h>
 
 #include <deal.II/grid/grid_tools_cache.h>
@@ -221,6 +225,400 @@ namespace NonMatching
     const ComponentMask &          immersed_comps = ComponentMask(),
     const Mapping<dim1, spacedim> &immersed_mapping =
       StaticMappingQ1<dim1, spacedim>::mapping);
+
+  /**
+   * A matrix-free version of the coupling mass matrix computed by
+   * create_coupling_mass_matrix(). Instead of storing the matrix entries,
+   * this class stores, for each cell of the immersed triangulation, the
+   * locally owned cells of the embedding triangulation that contain some of
+   * its quadrature points together with the reference coordinates of these
+   * points. This search is done once in the constructor, and its result is
+   * reused by every call to vmult() and Tvmult(), which evaluate the shape
+   * functions of both spaces on the fly.
+   *
+   * The memory needed is proportional to the number of quadrature points on
+   * the immersed triangulation, rather than to the number of nonzero entries
+   * of the coupling matrix, and the class can be wrapped into a
+   * LinearOperator by calling linear_operator() on it. The arguments have
+   * the same meaning as in create_coupling_mass_matrix(), and the same
+   * restrictions on the triangulations apply.
+   *
+   * The operator does not apply any constraints. If the embedding
+   * triangulation is parallel, vmult() only adds the contributions of locally
+   * owned cells, i.e., distributed vectors need to be compressed afterwards,
+   * and Tvmult() needs a source vector with ghost entries for all locally
+   * relevant degrees of freedom.
+   */
+  template <int dim0, int dim1, int spacedim>
+  class CouplingMassOperator : public Subscriptor
+  {
+  public:
+    /**
+     * Constructor. Locates the quadrature points of the immersed
+     * triangulation in the embedding triangulation described by @p cache.
+     * The DoFHandler objects and the immersed mapping need to live longer
+     * than this object.
+     */
+    CouplingMassOperator(const GridTools::Cache<dim0, spacedim> &cache,
+                         const DoFHandler<dim0, spacedim> &      space_dh,
+                         const DoFHandler<dim1, spacedim> &      immersed_dh,
+                         const Quadrature<dim1> &                quad,
+                         const ComponentMask &space_comps    = ComponentMask(),
+                         const ComponentMask &immersed_comps = ComponentMask(),
+                         const Mapping<dim1, spacedim> &immersed_mapping =
+                           StaticMappingQ1<dim1, spacedim>::mapping);
+
+    /**
+     * Number of rows, i.e., the number of degrees of freedom of the
+     * embedding space.
+     */
+    types::global_dof_index
+    m() const;
+
+    /**
+     * Number of columns, i.e., the number of degrees of freedom of the
+     * immersed space.
+     */
+    types::global_dof_index
+    n() const;
+
+    /**
+     * Matrix-vector multiplication: let @p dst be the coupling mass matrix
+     * times @p src, where @p src is a vector on the immersed space and
+     * @p dst a vector on the embedding space.
+     */
+    template <typename VectorType>
+    void
+    vmult(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Same as vmult(), but adds the result to @p dst.
+     */
+    template <typename VectorType>
+    void
+    vmult_add(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Multiplication with the transpose of the coupling mass matrix, mapping
+     * a vector on the embedding space to one on the immersed space.
+     */
+    template <typename VectorType>
+    void
+    Tvmult(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Same as Tvmult(), but adds the result to @p dst.
+     */
+    template <typename VectorType>
+    void
+    Tvmult_add(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Return an estimate for the memory consumption, in bytes, of this
+     * object.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * The part of an immersed cell that lies in one embedding cell.
+     */
+    struct CellIntersection
+    {
+      /**
+       * The embedding cell.
+       */
+      typename DoFHandler<dim0, spacedim>::active_cell_iterator cell;
+
+      /**
+       * The reference coordinates of the quadrature points in the embedding
+       * cell.
+       */
+      Quadrature<dim0> quadrature;
+
+      /**
+       * The indices of the points in the quadrature formula of the immersed
+       * cell.
+       */
+      std::vector<unsigned int> q_indices;
+    };
+
+    /**
+     * Evaluate the selected components of the shape functions of the
+     * embedding space on @p intersection and either add the products with
+     * @p values to @p dst (if @p transpose is false), or add the values of
+     * @p src to @p values (if @p transpose is true).
+     */
+    template <typename VectorType>
+    void
+    apply_on_intersection(
+      const CellIntersection &                   intersection,
+      FEValues<dim0, spacedim> &                 fe_values,
+      std::vector<types::global_dof_index> &     dof_indices,
+      Table<2, typename VectorType::value_type> &values,
+      VectorType *                               dst,
+      const VectorType *                         src) const;
+
+    /**
+     * The mapping of the embedding triangulation, taken from the
+     * GridTools::Cache object passed to the constructor.
+     */
+    SmartPointer<const Mapping<dim0, spacedim>> space_mapping;
+
+    SmartPointer<const DoFHandler<dim0, spacedim>> space_dh;
+    SmartPointer<const DoFHandler<dim1, spacedim>> immersed_dh;
+    SmartPointer<const Mapping<dim1, spacedim>>    immersed_mapping;
+
+    /**
+     * The quadrature formula on the immersed cells.
+     */
+    const Quadrature<dim1> quadrature;
+
+    /**
+     * For each component of the two finite elements, its index among the
+     * selected components, or numbers::invalid_unsigned_int.
+     */
+    std::vector<unsigned int> space_gtl;
+    std::vector<unsigned int> immersed_gtl;
+
+    /**
+     * The number of components that are coupled.
+     */
+    unsigned int n_coupled_components;
+
+    /**
+     * The intersections of each active immersed cell, indexed by the active
+     * cell index.
+     */
+    std::vector<std::vector<CellIntersection>> intersections;
+  };
+
+
+
+#ifndef DOXYGEN
+
+  template <int dim0, int dim1, int spacedim>
+  inline types::global_dof_index
+  CouplingMassOperator<dim0, dim1, spacedim>::m() const
+  {
+    return space_dh->n_dofs();
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  inline types::global_dof_index
+  CouplingMassOperator<dim0, dim1, spacedim>::n() const
+  {
+    return immersed_dh->n_dofs();
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  template <typename VectorType>
+  void
+  CouplingMassOperator<dim0, dim1, spacedim>::apply_on_intersection(
+    const CellIntersection &                   intersection,
+    FEValues<dim0, spacedim> &                 fe_values,
+    std::vector<types::global_dof_index> &     dof_indices,
+    Table<2, typename VectorType::value_type> &values,
+    VectorType *                               dst,
+    const VectorType *                         src) const
+  {
+    using Number = typename VectorType::value_type;
+
+    const FiniteElement<dim0, spacedim> &fe = space_dh->get_fe();
+    fe_values.reinit(intersection.cell);
+    intersection.cell->get_dof_indices(dof_indices);
+
+    for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+      {
+        const unsigned int c =
+          space_gtl[fe.system_to_component_index(i).first];
+        if (c >= n_coupled_components)
+          continue;
+
+        if (dst != nullptr)
+          {
+            Number sum = Number();
+            for (unsigned int q = 0; q < intersection.q_indices.size(); ++q)
+              sum += fe_values.shape_value(i, q) *
+                     values(intersection.q_indices[q], c);
+            (*dst)(dof_indices[i]) += sum;
+          }
+        else
+          {
+            const Number src_value = (*src)(dof_indices[i]);
+            for (unsigned int q = 0; q < intersection.q_indices.size(); ++q)
+              values(intersection.q_indices[q], c) +=
+                fe_values.shape_value(i, q) * src_value;
+          }
+      }
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  template <typename VectorType>
+  void
+  CouplingMassOperator<dim0, dim1, spacedim>::vmult(VectorType &      dst,
+                                                    const VectorType &src) const
+  {
+    dst = typename VectorType::value_type();
+    vmult_add(dst, src);
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  template <typename VectorType>
+  void
+  CouplingMassOperator<dim0, dim1, spacedim>::vmult_add(
+    VectorType &      dst,
+    const VectorType &src) const
+  {
+    AssertDimension(dst.size(), m());
+    AssertDimension(src.size(), n());
+
+    using Number = typename VectorType::value_type;
+
+    const FiniteElement<dim1, spacedim> &fe = immersed_dh->get_fe();
+    FEValues<dim1, spacedim>             fe_values(*immersed_mapping,
+                                                   fe,
+                                                   quadrature,
+                                                   update_values |
+                                                     update_JxW_values);
+    std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+    std::vector<types::global_dof_index> space_dof_indices(
+      space_dh->get_fe().dofs_per_cell);
+    Table<2, Number> values(quadrature.size(), n_coupled_components);
+
+    for (const auto &cell : immersed_dh->active_cell_iterators())
+      {
+        const auto &cell_intersections =
+          intersections[cell->active_cell_index()];
+        if (cell_intersections.empty())
+          continue;
+
+        // Compute the selected components of the source on the immersed
+        // cell, multiplied by the quadrature weights
+        fe_values.reinit(cell);
+        cell->get_dof_indices(dof_indices);
+        values.fill(Number());
+        for (unsigned int j = 0; j < fe.dofs_per_cell; ++j)
+          {
+            const unsigned int c =
+              immersed_gtl[fe.system_to_component_index(j).first];
+            if (c >= n_coupled_components)
+              continue;
+            const Number src_value = src(dof_indices[j]);
+            for (unsigned int q = 0; q < quadrature.size(); ++q)
+              values(q, c) += fe_values.shape_value(j, q) * src_value;
+          }
+        for (unsigned int q = 0; q < quadrature.size(); ++q)
+          for (unsigned int c = 0; c < n_coupled_components; ++c)
+            values(q, c) *= fe_values.JxW(q);
+
+        // Test with the shape functions of the embedding cells
+        for (const auto &intersection : cell_intersections)
+          {
+            FEValues<dim0, spacedim> space_fe_values(*space_mapping,
+                                                     space_dh->get_fe(),
+                                                     intersection.quadrature,
+                                                     update_values);
+            apply_on_intersection<VectorType>(intersection,
+                                              space_fe_values,
+                                              space_dof_indices,
+                                              values,
+                                              &dst,
+                                              nullptr);
+          }
+      }
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  template <typename VectorType>
+  void
+  CouplingMassOperator<dim0, dim1, spacedim>::Tvmult(
+    VectorType &      dst,
+    const VectorType &src) const
+  {
+    dst = typename VectorType::value_type();
+    Tvmult_add(dst, src);
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  template <typename VectorType>
+  void
+  CouplingMassOperator<dim0, dim1, spacedim>::Tvmult_add(
+    VectorType &      dst,
+    const VectorType &src) const
+  {
+    AssertDimension(dst.size(), n());
+    AssertDimension(src.size(), m());
+
+    using Number = typename VectorType::value_type;
+
+    const FiniteElement<dim1, spacedim> &fe = immersed_dh->get_fe();
+    FEValues<dim1, spacedim>             fe_values(*immersed_mapping,
+                                                   fe,
+                                                   quadrature,
+                                                   update_values |
+                                                     update_JxW_values);
+    std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+    std::vector<types::global_dof_index> space_dof_indices(
+      space_dh->get_fe().dofs_per_cell);
+    Table<2, Number> values(quadrature.size(), n_coupled_components);
+
+    for (const auto &cell : immersed_dh->active_cell_iterators())
+      {
+        const auto &cell_intersections =
+          intersections[cell->active_cell_index()];
+        if (cell_intersections.empty())
+          continue;
+
+        // Interpolate the selected components of the source from the
+        // embedding cells to the quadrature points of the immersed cell
+        values.fill(Number());
+        for (const auto &intersection : cell_intersections)
+          {
+            FEValues<dim0, spacedim> space_fe_values(*space_mapping,
+                                                     space_dh->get_fe(),
+                                                     intersection.quadrature,
+                                                     update_values);
+            apply_on_intersection<VectorType>(intersection,
+                                              space_fe_values,
+                                              space_dof_indices,
+                                              values,
+                                              nullptr,
+                                              &src);
+          }
+
+        // Test with the shape functions of the immersed cell
+        fe_values.reinit(cell);
+        cell->get_dof_indices(dof_indices);
+        for (unsigned int j = 0; j < fe.dofs_per_cell; ++j)
+          {
+            const unsigned int c =
+              immersed_gtl[fe.system_to_component_index(j).first];
+            if (c >= n_coupled_components)
+              continue;
+            Number sum = Number();
+            for (unsigned int q = 0; q < quadrature.size(); ++q)
+              sum += fe_values.shape_value(j, q) * values(q, c) *
+                     fe_values.JxW(q);
+            dst(dof_indices[j]) += sum;
+          }
+      }
+  }
+
+#endif // DOXYGEN
 } // namespace NonMatching
 DEAL_II_NAMESPACE_CLOSE
 
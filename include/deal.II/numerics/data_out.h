@@ -20,8 +20,11 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/bounding_box.h>
+
 #include <deal.II/numerics/data_out_dof_data.h>
 
+#include <functional>
 #include <memory>
 
 DEAL_II_NAMESPACE_OPEN
@@ -52,6 +55,19 @@ namespace internal
       std::vector<Point<spacedim>> patch_evaluation_points;
 
       const std::vector<std::vector<unsigned int>> *cell_to_patch_index_map;
+
+      /**
+       * The inputs of the postprocessors that use batched evaluation, one
+       * entry per DoF data set, collected from all cells of the batch
+       * currently worked on.
+       */
+      std::vector<DataPostprocessorInputs::Batch<spacedim>>
+        postprocessor_batch_inputs;
+
+      /**
+       * The output of the postprocessor that was last evaluated on a batch.
+       */
+      Table<2, double> postprocessor_batch_outputs;
     };
   } // namespace DataOutImplementation
 } // namespace internal
@@ -95,6 +111,13 @@ namespace internal
  * the same data in more than one format without having to rebuild the
  * patches.
  *
+ * For very large meshes, holding all patches in memory at the same time can
+ * dominate the memory consumption of the output. The function
+ * write_vtu_in_chunks() therefore builds the patches of a limited number of
+ * cells at a time and writes each such chunk to the output stream before
+ * building the next one, so that the memory used for the patches is bounded
+ * by the size of a chunk.
+ *
  *
  * <h3>User interface information</h3>
  *
@@ -175,6 +198,11 @@ public:
     DoFHandlerType::dimension,
     DoFHandlerType::space_dimension>::active_cell_iterator;
 
+  /**
+   * Constructor.
+   */
+  DataOut();
+
   /**
    * Enumeration describing the part of the domain in which cells
    * should be written with curved boundaries. In reality, no file
@@ -316,6 +344,85 @@ public:
                 const unsigned int     n_subdivisions = 0,
                 const CurvedCellRegion curved_region  = curved_boundary);
 
+  /**
+   * Build the patches in chunks of at most @p n_patches_per_chunk cells and
+   * write each chunk to @p out in the VTU format as soon as it has been
+   * built, instead of first building the patches of all cells as
+   * build_patches() does. This bounds the memory used for the patches by the
+   * size of one chunk. Each chunk is written as a separate <tt>Piece</tt> of
+   * the unstructured grid, which is understood by all VTU readers; the
+   * content of the file is otherwise the same as the one written by
+   * build_patches() followed by DataOutInterface::write_vtu(). The flags set
+   * by DataOutInterface::set_flags() for the VTK format are obeyed.
+   *
+   * The arguments @p mapping, @p n_subdivisions, and @p curved_region have
+   * the same meaning as for build_patches().
+   *
+   * Since the patches are released after they have been written, no patches
+   * are stored in this object after this function returns, and the other
+   * output functions can only be used after calling build_patches().
+   */
+  void
+  write_vtu_in_chunks(
+    std::ostream &     out,
+    const unsigned int n_patches_per_chunk,
+    const Mapping<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
+      &                    mapping,
+    const unsigned int     n_subdivisions = 0,
+    const CurvedCellRegion curved_region  = curved_boundary);
+
+  /**
+   * Restrict the output to a region of interest. When building patches, the
+   * cells of the triangulation are visited from the coarse cells down to
+   * the active ones, and the cells for which @p predicate returns
+   * <tt>false</tt> are skipped together with all of their descendants.
+   * Consequently, neither the number of patches nor the time to find the
+   * cells to be output grows with parts of the mesh that lie outside the
+   * region. The predicate is called on active and non-active cells, and
+   * needs to be consistent with the hierarchy of the mesh, i.e., it must
+   * not return <tt>false</tt> for a cell unless it would return
+   * <tt>false</tt> for all of its descendants.
+   *
+   * An empty function object, the default, selects all cells. If a
+   * selection or an output level (see set_max_output_level()) is set, the
+   * first_cell() and next_cell() functions are not used.
+   */
+  void
+  set_cell_selection(
+    const std::function<bool(const cell_iterator &)> &predicate);
+
+  /**
+   * Restrict the output to the cells that intersect the box @p region. The
+   * box is compared to the bounding box of the vertices of each cell, see
+   * the previous function.
+   */
+  void
+  set_cell_selection(
+    const BoundingBox<DoFHandlerType::space_dimension> &region);
+
+  /**
+   * Output a coarsened representation of the mesh, in which no cell is
+   * finer than @p level. Active cells on coarser levels are output as
+   * usual, whereas the descendants of a cell on @p level are represented by
+   * a single patch for that cell, with the values of the solution
+   * interpolated from its children. This reduces the size of the output,
+   * and the time to produce it, by the number of active cells per cell on
+   * @p level.
+   *
+   * On a parallel triangulation, a cell on @p level is only represented in
+   * this way by the process that owns all of its active descendants. At the
+   * boundaries between the subdomains of the processes, the locally owned
+   * descendants are output instead, so that each part of the domain is
+   * covered by exactly one process.
+   *
+   * Since cell data cannot be interpolated to coarser cells, this function
+   * can only be used for output of data defined on degrees of freedom.
+   * Passing numbers::invalid_unsigned_int, the default, outputs the active
+   * cells.
+   */
+  void
+  set_max_output_level(const unsigned int level);
+
   /**
    * Return the first cell which we want output for. The default
    * implementation returns the first active cell, but you might want to
@@ -356,13 +463,89 @@ private:
   next_locally_owned_cell(const cell_iterator &cell);
 
   /**
-   * Build one patch. This function is called in a WorkStream context.
+   * Return the cells for which patches are to be built. If neither a cell
+   * selection nor a maximal output level has been set, these are the cells
+   * returned by first_locally_owned_cell() and next_locally_owned_cell().
+   * Otherwise, the cells are found by descending from the coarse cells of
+   * the triangulation as described in set_cell_selection() and
+   * set_max_output_level().
+   */
+  std::vector<cell_iterator>
+  get_cells_for_output();
+
+  /**
+   * Append the cells that are to be output from the subtree of @p cell to
+   * @p cells, see get_cells_for_output(). If @p check_ownership is true, a
+   * non-active cell is only output as a whole if all of its active
+   * descendants are locally owned.
+   */
+  void
+  collect_cells_for_output(const cell_iterator &       cell,
+                           const bool                  check_ownership,
+                           std::vector<cell_iterator> &cells) const;
+
+  /**
+   * The predicate set by set_cell_selection().
+   */
+  std::function<bool(const cell_iterator &)> cell_selection;
+
+  /**
+   * The level set by set_max_output_level().
+   */
+  unsigned int max_output_level;
+
+  /**
+   * Build the patches of the selected cells, at most @p n_patches_per_chunk
+   * at a time. After each chunk has been built into the patches of this
+   * object, the function @p process_chunk is called (if it is not empty).
+   * build_patches() calls this function with a single chunk that contains
+   * all cells.
+   */
+  void
+  build_patches_in_chunks(
+    const Mapping<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
+      &                          mapping,
+    const unsigned int           n_subdivisions,
+    const CurvedCellRegion       curved_region,
+    const unsigned int           n_patches_per_chunk,
+    const std::function<void()> &process_chunk);
+
+  /**
+   * A half-open range of consecutive entries in the list of cells and their
+   * active indices, whose patches are built together.
+   */
+  using cell_batch =
+    std::pair<const std::pair<cell_iterator, unsigned int> *,
+              const std::pair<cell_iterator, unsigned int> *>;
+
+  /**
+   * Build the patches of a batch of cells. This function is called in a
+   * WorkStream context.
    *
    * The first argument here is the iterator, the second the scratch data
    * object. All following are tied to particular values when calling
    * WorkStream::run(). The function does not take a CopyData object but
-   * rather allocates one on its own stack for memory access efficiency
-   * reasons.
+   * writes directly into the patches of this object. After the patches of
+   * all cells of the batch have been built by build_one_patch(), the
+   * postprocessors that use batched evaluation are evaluated on the points
+   * of all of these cells at once.
+   */
+  void
+  build_patch_batch(const cell_batch *batch,
+                    internal::DataOutImplementation::ParallelData<
+                      DoFHandlerType::dimension,
+                      DoFHandlerType::space_dimension> &scratch_data,
+                    const unsigned int                  n_subdivisions,
+                    const CurvedCellRegion              curved_cell_region,
+                    const unsigned int                  first_patch_index);
+
+  /**
+   * Build one patch. The patch is stored in the patches of this object at the
+   * position of its patch index minus @p first_patch_index, i.e., relative
+   * to the chunk currently being built. The inputs of postprocessors that use
+   * batched evaluation are stored in the scratch data at the position
+   * @p index_in_batch of the cell within its batch, instead of evaluating
+   * these postprocessors.
    */
   void
   build_one_patch(const std::pair<cell_iterator, unsigned int> *cell_and_index,
@@ -370,7 +553,9 @@ private:
                     DoFHandlerType::dimension,
                     DoFHandlerType::space_dimension> &scratch_data,
                   const unsigned int                  n_subdivisions,
-                  const CurvedCellRegion              curved_cell_region);
+                  const CurvedCellRegion              curved_cell_region,
+                  const unsigned int                  first_patch_index,
+                  const unsigned int                  index_in_batch);
 };
 
 
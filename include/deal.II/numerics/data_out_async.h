@@ -0,0 +1,304 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_data_out_async_h
+#define dealii_data_out_async_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * A class that writes graphical output in the background, so that a
+ * simulation can continue while its output is generated and written.
+ *
+ * The interface resembles the one of DataOut: a DoFHandler is attached and
+ * data vectors are added, after which write() is called. In contrast to
+ * DataOut, add_data_vector() copies the given vectors, so they may be
+ * modified as soon as the function returns. The call to write() then starts
+ * a task that sets up a DataOut object on these copies, builds its patches,
+ * and passes it to a user-provided function that writes it to a file in
+ * one format or other. The following code shows the typical use in a time
+ * loop:
+ * @code
+ *   AsyncDataOut<dim> data_out;
+ *   for (unsigned int step = 0; step < n_steps; ++step)
+ *     {
+ *       ... compute solution ...
+ *
+ *       data_out.attach_dof_handler(dof_handler);
+ *       data_out.add_data_vector(solution, "solution");
+ *       data_out.write([step](const DataOut<dim> &data_out) {
+ *         std::ofstream output("solution-" +
+ *                              Utilities::int_to_string(step, 4) + ".vtu");
+ *         data_out.write_vtu(output);
+ *       });
+ *     }
+ *   data_out.wait();
+ * @endcode
+ *
+ * To bound the memory held by copies of vectors that are still waiting to
+ * be written, at most the number of writes given to the constructor are
+ * pending at any time. If this number is reached, write() first waits for
+ * the oldest of them to finish.
+ *
+ * @note While writes are pending, the DoFHandler and the triangulation it
+ * is based on must not be changed, e.g. by refining the mesh or by
+ * distributing degrees of freedom anew. Call wait() before doing so.
+ *
+ * @note The function passed to write() is executed on a different thread.
+ * If it uses MPI, e.g. by calling DataOutInterface::write_vtu_in_parallel(),
+ * MPI needs to have been initialized with support for multiple threads,
+ * and all processes need to call write() in the same order.
+ *
+ * @ingroup output
+ */
+template <int dim, typename DoFHandlerType = DoFHandler<dim>>
+class AsyncDataOut
+{
+public:
+  /**
+   * Constructor. The argument denotes the maximal number of writes that are
+   * allowed to be pending at any time.
+   */
+  explicit AsyncDataOut(const unsigned int max_pending_writes = 1);
+
+  /**
+   * Destructor. Waits for all pending writes to finish.
+   */
+  ~AsyncDataOut();
+
+  /**
+   * Designate a DoFHandler to be used for the vectors added by the
+   * following calls to add_data_vector().
+   */
+  void
+  attach_dof_handler(const DoFHandlerType &dof_handler);
+
+  /**
+   * Add a copy of the data vector @p data to the output generated by the
+   * next call to write(). See DataOut_DoFData::add_data_vector() for the
+   * meaning of the arguments.
+   */
+  template <class VectorType>
+  void
+  add_data_vector(
+    const VectorType &                                data,
+    const std::vector<std::string> &                  names,
+    const typename DataOut<dim, DoFHandlerType>::DataVectorType type =
+      DataOut<dim, DoFHandlerType>::type_automatic,
+    const std::vector<DataComponentInterpretation::DataComponentInterpretation>
+      &data_component_interpretation = std::vector<
+        DataComponentInterpretation::DataComponentInterpretation>());
+
+  /**
+   * Same as above, for a scalar field or one where all components share the
+   * same name.
+   */
+  template <class VectorType>
+  void
+  add_data_vector(
+    const VectorType &                                data,
+    const std::string &                               name,
+    const typename DataOut<dim, DoFHandlerType>::DataVectorType type =
+      DataOut<dim, DoFHandlerType>::type_automatic,
+    const std::vector<DataComponentInterpretation::DataComponentInterpretation>
+      &data_component_interpretation = std::vector<
+        DataComponentInterpretation::DataComponentInterpretation>());
+
+  /**
+   * Add a copy of the data vector @p data, to be converted by
+   * @p data_postprocessor. The postprocessor object itself is not copied
+   * and needs to exist until the corresponding write has finished.
+   */
+  template <class VectorType>
+  void
+  add_data_vector(const VectorType &data,
+                  const DataPostprocessor<DoFHandlerType::space_dimension>
+                    &data_postprocessor);
+
+  /**
+   * Start a task that builds the patches for the data vectors added since
+   * the last call to this function, using @p n_subdivisions as in
+   * DataOut::build_patches(), and then calls @p writer with the resulting
+   * DataOut object. The function returns as soon as the task has been
+   * started, unless the maximal number of pending writes has been reached,
+   * in which case it first waits for the oldest pending write.
+   *
+   * As for all tasks, an exception thrown by @p writer is not passed on to
+   * the caller, but aborts the program with an error message.
+   */
+  void
+  write(
+    const std::function<void(const DataOut<dim, DoFHandlerType> &)> &writer,
+    const unsigned int n_subdivisions = 0);
+
+  /**
+   * Wait for all pending writes to finish.
+   */
+  void
+  wait();
+
+  /**
+   * Return the number of writes that have been started and not yet been
+   * waited for.
+   */
+  unsigned int
+  n_pending_writes() const;
+
+private:
+  /**
+   * The maximal number of pending writes.
+   */
+  const unsigned int max_pending_writes;
+
+  /**
+   * The DoFHandler used for the data vectors added next.
+   */
+  SmartPointer<const DoFHandlerType, AsyncDataOut<dim, DoFHandlerType>>
+    dof_handler;
+
+  /**
+   * Functions that add the copies of the data vectors stored so far to a
+   * DataOut object, given the DoFHandler attached to it. Each of them owns
+   * the copy of its vector.
+   */
+  std::vector<std::function<void(DataOut<dim, DoFHandlerType> &,
+                                 const DoFHandlerType &)>>
+    data_vectors;
+
+  /**
+   * The tasks of the pending writes, oldest first.
+   */
+  std::list<Threads::Task<void>> pending_writes;
+};
+
+
+/* ---------------------- template functions ------------------------ */
+
+#ifndef DOXYGEN
+
+template <int dim, typename DoFHandlerType>
+template <class VectorType>
+void
+AsyncDataOut<dim, DoFHandlerType>::add_data_vector(
+  const VectorType &                                          data,
+  const std::vector<std::string> &                            names,
+  const typename DataOut<dim, DoFHandlerType>::DataVectorType type,
+  const std::vector<DataComponentInterpretation::DataComponentInterpretation>
+    &data_component_interpretation)
+{
+  Assert(dof_handler != nullptr,
+         ExcMessage("You need to attach a DoFHandler before adding data "
+                    "vectors."));
+
+  const DoFHandlerType *const             dof = &*dof_handler;
+  const std::shared_ptr<const VectorType> copy =
+    std::make_shared<const VectorType>(data);
+  data_vectors.emplace_back(
+    [dof, copy, names, type, data_component_interpretation](
+      DataOut<dim, DoFHandlerType> &data_out,
+      const DoFHandlerType &        attached_dof_handler) {
+      if (dof == &attached_dof_handler)
+        data_out.add_data_vector(*copy,
+                                 names,
+                                 type,
+                                 data_component_interpretation);
+      else
+        data_out.add_data_vector(*dof,
+                                 *copy,
+                                 names,
+                                 data_component_interpretation);
+    });
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+template <class VectorType>
+void
+AsyncDataOut<dim, DoFHandlerType>::add_data_vector(
+  const VectorType &                                          data,
+  const std::string &                                         name,
+  const typename DataOut<dim, DoFHandlerType>::DataVectorType type,
+  const std::vector<DataComponentInterpretation::DataComponentInterpretation>
+    &data_component_interpretation)
+{
+  Assert(dof_handler != nullptr,
+         ExcMessage("You need to attach a DoFHandler before adding data "
+                    "vectors."));
+
+  const DoFHandlerType *const             dof = &*dof_handler;
+  const std::shared_ptr<const VectorType> copy =
+    std::make_shared<const VectorType>(data);
+  data_vectors.emplace_back(
+    [dof, copy, name, type, data_component_interpretation](
+      DataOut<dim, DoFHandlerType> &data_out,
+      const DoFHandlerType &        attached_dof_handler) {
+      if (dof == &attached_dof_handler)
+        data_out.add_data_vector(*copy,
+                                 name,
+                                 type,
+                                 data_component_interpretation);
+      else
+        data_out.add_data_vector(*dof,
+                                 *copy,
+                                 name,
+                                 data_component_interpretation);
+    });
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+template <class VectorType>
+void
+AsyncDataOut<dim, DoFHandlerType>::add_data_vector(
+  const VectorType &                                              data,
+  const DataPostprocessor<DoFHandlerType::space_dimension> &data_postprocessor)
+{
+  Assert(dof_handler != nullptr,
+         ExcMessage("You need to attach a DoFHandler before adding data "
+                    "vectors."));
+
+  const DoFHandlerType *const             dof = &*dof_handler;
+  const std::shared_ptr<const VectorType> copy =
+    std::make_shared<const VectorType>(data);
+  const DataPostprocessor<DoFHandlerType::space_dimension> *const
+    postprocessor = &data_postprocessor;
+  data_vectors.emplace_back([dof, copy, postprocessor](
+                              DataOut<dim, DoFHandlerType> &data_out,
+                              const DoFHandlerType &) {
+    data_out.add_data_vector(*dof, *copy, *postprocessor);
+  });
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
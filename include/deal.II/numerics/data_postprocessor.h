@@ -20,6 +20,7 @@
 
 #include <deal.II/base/point.h>
 #include <deal.II/base/subscriptor.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/tensor.h>
 
 #include <deal.II/fe/fe_update_flags.h>
@@ -336,6 +337,75 @@ namespace DataPostprocessorInputs
     std::vector<std::vector<Tensor<2, spacedim>>> solution_hessians;
   };
 
+
+
+  /**
+   * A structure that is used to pass information to
+   * DataPostprocessor::evaluate_batch(). It contains the values and
+   * derivatives of a scalar or vector-valued finite element field at the
+   * evaluation points of a batch of cells, stored as structure of arrays: the
+   * last index of each table runs over all evaluation points of all cells in
+   * the batch, so that loops over the points access contiguous memory and
+   * can be vectorized by the compiler.
+   *
+   * Unlike the Scalar and Vector classes, this structure does not give access
+   * to the cells the points belong to, since a batch contains points from
+   * several cells.
+   */
+  template <int spacedim>
+  struct Batch
+  {
+    /**
+     * Return the number of evaluation points in the batch.
+     */
+    unsigned int
+    n_evaluation_points() const;
+
+    /**
+     * The values of the solution. The entry <tt>solution_values(c, q)</tt>
+     * holds the value of component @p c at point @p q.
+     */
+    Table<2, double> solution_values;
+
+    /**
+     * The gradients of the solution. The entry
+     * <tt>solution_gradients(c, d, q)</tt> holds the derivative of component
+     * @p c in coordinate direction @p d at point @p q.
+     *
+     * This table is only filled if DataPostprocessor::get_needed_update_flags()
+     * returns UpdateFlags::update_gradients.
+     */
+    Table<3, double> solution_gradients;
+
+    /**
+     * The second derivatives of the solution. The entry
+     * <tt>solution_hessians(c, d, e, q)</tt> holds the derivative of component
+     * @p c in coordinate directions @p d and @p e at point @p q.
+     *
+     * This table is only filled if DataPostprocessor::get_needed_update_flags()
+     * returns UpdateFlags::update_hessians.
+     */
+    Table<4, double> solution_hessians;
+
+    /**
+     * The coordinates of the evaluation points. The entry
+     * <tt>evaluation_points(d, q)</tt> holds coordinate @p d of point @p q.
+     *
+     * This table is only filled if DataPostprocessor::get_needed_update_flags()
+     * returns UpdateFlags::update_quadrature_points.
+     */
+    Table<2, double> evaluation_points;
+  };
+
+
+
+  template <int spacedim>
+  inline unsigned int
+  Batch<spacedim>::n_evaluation_points() const
+  {
+    return solution_values.size(1);
+  }
+
 } // namespace DataPostprocessorInputs
 
 
@@ -468,6 +538,35 @@ public:
   evaluate_vector_field(const DataPostprocessorInputs::Vector<dim> &input_data,
                         std::vector<Vector<double>> &computed_quantities) const;
 
+  /**
+   * Return whether DataOut should call evaluate_batch() for batches of cells
+   * instead of evaluate_scalar_field() or evaluate_vector_field() for each
+   * cell. The default implementation returns false.
+   *
+   * Derived classes that compute quantities which only depend on the
+   * solution and the location of the evaluation points, but not on the
+   * cell, can override this function and evaluate_batch() to process the
+   * points of many cells in a single, vectorizable loop.
+   */
+  virtual bool
+  uses_batched_evaluation() const;
+
+  /**
+   * Same as the evaluate_scalar_field() and evaluate_vector_field()
+   * functions, but for the evaluation points of a batch of cells whose data
+   * is stored as structure of arrays, see DataPostprocessorInputs::Batch.
+   * The result must be written into @p computed_quantities, which has been
+   * sized so that the entry <tt>computed_quantities(i, q)</tt> holds the
+   * output variable @p i at point @p q.
+   *
+   * This function is only called if uses_batched_evaluation() returns true.
+   * It is called concurrently for different batches and must therefore be
+   * thread-safe.
+   */
+  virtual void
+  evaluate_batch(const DataPostprocessorInputs::Batch<dim> &input_data,
+                 Table<2, double> &computed_quantities) const;
+
   /**
    * Return the vector of strings describing the names of the computed
    * quantities.
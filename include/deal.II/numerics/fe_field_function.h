@@ -470,6 +470,23 @@ namespace Functions
      */
     mutable cell_hint_t cell_hint;
 
+    /**
+     * Find the cells around the given @p points and evaluate the field at
+     * the points of each cell by calling @p cell_evaluator with an FEValues
+     * object for these points and a vector of values of that size, each
+     * initialized to @p initial_value. The results are written into the
+     * entries of @p values that correspond to the points.
+     *
+     * The cells are worked on in parallel.
+     */
+    template <typename ValueType, typename CellEvaluator>
+    void
+    evaluate_on_cells(const std::vector<Point<dim>> &points,
+                      std::vector<ValueType> &       values,
+                      const ValueType &              initial_value,
+                      const UpdateFlags              update_flags,
+                      const CellEvaluator &          cell_evaluator) const;
+
     /**
      * Given a cell, return the reference coordinates of the given point
      * within this cell if it indeed lies within the cell. Otherwise return an
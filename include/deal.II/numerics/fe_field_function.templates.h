@@ -18,6 +18,7 @@
 
 
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/fe/fe_values.h>
@@ -267,46 +268,16 @@ namespace Functions
     Assert(points.size() == values.size(),
            ExcDimensionMismatch(points.size(), values.size()));
 
-    std::vector<typename DoFHandlerType::active_cell_iterator> cells;
-    std::vector<std::vector<Point<dim>>>                       qpoints;
-    std::vector<std::vector<unsigned int>>                     maps;
-
-    const unsigned int n_cells =
-      compute_point_locations(points, cells, qpoints, maps);
-
-    // Create quadrature collection
-    hp::QCollection<dim> quadrature_collection;
-    for (unsigned int i = 0; i < n_cells; ++i)
-      {
-        // Number of quadrature points on this cell
-        unsigned int nq = qpoints[i].size();
-        // Construct a quadrature formula
-        std::vector<double> ww(nq, 1. / nq);
-
-        quadrature_collection.push_back(Quadrature<dim>(qpoints[i], ww));
-      }
-
-    // Now gather all the information we need
-    hp::MappingCollection<dim> mapping_collection(mapping);
-    hp::FEValues<dim>          fe_v(mapping_collection,
-                           dh->get_fe_collection(),
-                           quadrature_collection,
-                           update_values);
-    for (unsigned int i = 0; i < n_cells; ++i)
-      {
-        AssertThrow(!cells[i]->is_artificial(),
-                    VectorTools::ExcPointNotAvailableHere());
-
-        fe_v.reinit(cells[i], i, 0);
-        const unsigned int nq = qpoints[i].size();
-
-        std::vector<Vector<typename VectorType::value_type>> vvalues(
-          nq, Vector<typename VectorType::value_type>(this->n_components));
-        fe_v.get_present_fe_values().get_function_values(data_vector, vvalues);
-
-        for (unsigned int q = 0; q < nq; ++q)
-          values[maps[i][q]] = vvalues[q];
-      }
+    using value_type = typename VectorType::value_type;
+    evaluate_on_cells(
+      points,
+      values,
+      Vector<value_type>(this->n_components),
+      update_values,
+      [this](const FEValues<dim> &            fe_values,
+             std::vector<Vector<value_type>> &cell_values) {
+        fe_values.get_function_values(data_vector, cell_values);
+      });
   }
 
 
@@ -347,55 +318,17 @@ namespace Functions
     Assert(points.size() == values.size(),
            ExcDimensionMismatch(points.size(), values.size()));
 
-    std::vector<typename DoFHandlerType::active_cell_iterator> cells;
-    std::vector<std::vector<Point<dim>>>                       qpoints;
-    std::vector<std::vector<unsigned int>>                     maps;
-
-    const unsigned int n_cells =
-      compute_point_locations(points, cells, qpoints, maps);
-
-    // Create quadrature collection
-    hp::QCollection<dim> quadrature_collection;
-    for (unsigned int i = 0; i < n_cells; ++i)
-      {
-        // Number of quadrature points on this cell
-        unsigned int nq = qpoints[i].size();
-        // Construct a quadrature formula
-        std::vector<double> ww(nq, 1. / nq);
-
-        quadrature_collection.push_back(Quadrature<dim>(qpoints[i], ww));
-      }
-
-    // Now gather all the information we need
-    hp::MappingCollection<dim> mapping_collection(mapping);
-    hp::FEValues<dim>          fe_v(mapping_collection,
-                           dh->get_fe_collection(),
-                           quadrature_collection,
-                           update_gradients);
-    for (unsigned int i = 0; i < n_cells; ++i)
-      {
-        AssertThrow(!cells[i]->is_artificial(),
-                    VectorTools::ExcPointNotAvailableHere());
-
-        fe_v.reinit(cells[i], i, 0);
-
-        const unsigned int nq = qpoints[i].size();
-        std::vector<
-          std::vector<Tensor<1, dim, typename VectorType::value_type>>>
-          vgrads(nq,
-                 std::vector<Tensor<1, dim, typename VectorType::value_type>>(
-                   this->n_components));
-        fe_v.get_present_fe_values().get_function_gradients(data_vector,
-                                                            vgrads);
-
-        for (unsigned int q = 0; q < nq; ++q)
-          {
-            const unsigned int s = vgrads[q].size();
-            values[maps[i][q]].resize(s);
-            for (unsigned int l = 0; l < s; l++)
-              values[maps[i][q]][l] = vgrads[q][l];
-          }
-      }
+    using value_type = typename VectorType::value_type;
+    evaluate_on_cells(
+      points,
+      values,
+      std::vector<Tensor<1, dim, value_type>>(this->n_components),
+      update_gradients,
+      [this](const FEValues<dim> &fe_values,
+             std::vector<std::vector<Tensor<1, dim, value_type>>>
+               &cell_values) {
+        fe_values.get_function_gradients(data_vector, cell_values);
+      });
   }
 
 
@@ -436,48 +369,16 @@ namespace Functions
     Assert(points.size() == values.size(),
            ExcDimensionMismatch(points.size(), values.size()));
 
-    std::vector<typename DoFHandlerType::active_cell_iterator> cells;
-    std::vector<std::vector<Point<dim>>>                       qpoints;
-    std::vector<std::vector<unsigned int>>                     maps;
-
-    const unsigned int n_cells =
-      compute_point_locations(points, cells, qpoints, maps);
-
-    // Create quadrature collection
-    hp::QCollection<dim> quadrature_collection;
-    for (unsigned int i = 0; i < n_cells; ++i)
-      {
-        // Number of quadrature points on this cell
-        unsigned int nq = qpoints[i].size();
-        // Construct a quadrature formula
-        std::vector<double> ww(nq, 1. / nq);
-
-        quadrature_collection.push_back(Quadrature<dim>(qpoints[i], ww));
-      }
-
-    // Now gather all the information we need
-    hp::MappingCollection<dim> mapping_collection(mapping);
-    hp::FEValues<dim>          fe_v(mapping_collection,
-                           dh->get_fe_collection(),
-                           quadrature_collection,
-                           update_hessians);
-    // Now gather all the information we need
-    for (unsigned int i = 0; i < n_cells; ++i)
-      {
-        AssertThrow(!cells[i]->is_artificial(),
-                    VectorTools::ExcPointNotAvailableHere());
-
-        fe_v.reinit(cells[i], i, 0);
-
-        const unsigned int nq = qpoints[i].size();
-        std::vector<Vector<typename VectorType::value_type>> vvalues(
-          nq, Vector<typename VectorType::value_type>(this->n_components));
-        fe_v.get_present_fe_values().get_function_laplacians(data_vector,
-                                                             vvalues);
-
-        for (unsigned int q = 0; q < nq; ++q)
-          values[maps[i][q]] = vvalues[q];
-      }
+    using value_type = typename VectorType::value_type;
+    evaluate_on_cells(
+      points,
+      values,
+      Vector<value_type>(this->n_components),
+      update_hessians,
+      [this](const FEValues<dim> &            fe_values,
+             std::vector<Vector<value_type>> &cell_values) {
+        fe_values.get_function_laplacians(data_vector, cell_values);
+      });
   }
 
 
@@ -508,6 +409,58 @@ namespace Functions
 
 
 
+  template <int dim, typename DoFHandlerType, typename VectorType>
+  template <typename ValueType, typename CellEvaluator>
+  void
+  FEFieldFunction<dim, DoFHandlerType, VectorType>::evaluate_on_cells(
+    const std::vector<Point<dim>> &points,
+    std::vector<ValueType> &       values,
+    const ValueType &              initial_value,
+    const UpdateFlags              update_flags,
+    const CellEvaluator &          cell_evaluator) const
+  {
+    std::vector<typename DoFHandlerType::active_cell_iterator> cells;
+    std::vector<std::vector<Point<dim>>>                       qpoints;
+    std::vector<std::vector<unsigned int>>                     maps;
+
+    const unsigned int n_cells =
+      compute_point_locations(points, cells, qpoints, maps);
+
+    for (unsigned int i = 0; i < n_cells; ++i)
+      AssertThrow(!cells[i]->is_artificial(),
+                  VectorTools::ExcPointNotAvailableHere());
+
+    // every point belongs to exactly one cell, so the cells can be worked
+    // on independently. the FEValues object of each cell only lives as
+    // long as the cell is worked on
+    parallel::apply_to_subranges(
+      0U,
+      n_cells,
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<ValueType> cell_values;
+        for (unsigned int i = begin; i < end; ++i)
+          {
+            const unsigned int nq = qpoints[i].size();
+
+            FEValues<dim> fe_values(
+              mapping,
+              cells[i]->get_fe(),
+              Quadrature<dim>(qpoints[i], std::vector<double>(nq, 1. / nq)),
+              update_flags);
+            fe_values.reinit(cells[i]);
+
+            cell_values.resize(nq, initial_value);
+            cell_evaluator(fe_values, cell_values);
+
+            for (unsigned int q = 0; q < nq; ++q)
+              values[maps[i][q]] = cell_values[q];
+          }
+      },
+      8);
+  }
+
+
+
   template <int dim, typename DoFHandlerType, typename VectorType>
   unsigned int
   FEFieldFunction<dim, DoFHandlerType, VectorType>::compute_point_locations(
@@ -526,6 +479,16 @@ namespace Functions
       cells[i++] = typename DoFHandlerType::cell_iterator(*c, dh);
     qpoints = std::get<1>(cell_qpoint_map);
     maps    = std::get<2>(cell_qpoint_map);
+
+    // continue the next search from the cell that contains the last point,
+    // which is likely close to the points of a subsequent call
+    for (unsigned int c = 0; c < cells.size(); ++c)
+      if (maps[c].back() + 1 == points.size())
+        {
+          cell_hint.get() = cells[c];
+          break;
+        }
+
     return cells.size();
   }
 
@@ -19,6 +19,7 @@
 #include <deal.II/base/function.h>
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/quadrature.h>
+#include <deal.II/base/tensor_product_polynomials.h>
 #include <deal.II/base/work_stream.h>
 
 #include <deal.II/dofs/dof_accessor.h>
@@ -26,6 +27,7 @@
 #include <deal.II/dofs/dof_tools.h>
 
 #include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_poly.h>
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/fe/mapping_q1.h>
 
@@ -57,7 +59,9 @@
 
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <memory>
 #include <set>
 
 
@@ -127,6 +131,260 @@ namespace MatrixCreator
 
 
 
+    /**
+     * The one-dimensional mass, Laplace, and derivative matrices of a scalar
+     * element whose shape functions are tensor products of one-dimensional
+     * polynomials, integrated with the one-dimensional factors of a tensor
+     * product quadrature formula. On cells with a constant Jacobian, the cell
+     * mass and Laplace matrices are sums of Kronecker products of these
+     * matrices, which is much cheaper to evaluate than the sum over all
+     * quadrature points for every pair of shape functions.
+     */
+    template <int dim>
+    struct TensorProductMatrices
+    {
+      TensorProductMatrices(
+        const TensorProductPolynomials<dim> &poly_space,
+        const Quadrature<dim> &              quadrature);
+
+      /**
+       * For every shape function, the indices of its one-dimensional factors.
+       */
+      std::vector<std::array<unsigned int, dim>> tensor_indices;
+
+      /**
+       * The matrices $\int p_i p_j$ in each coordinate direction.
+       */
+      std::array<FullMatrix<double>, dim> mass;
+
+      /**
+       * The matrices $\int p_i' p_j'$ in each coordinate direction.
+       */
+      std::array<FullMatrix<double>, dim> laplace;
+
+      /**
+       * The matrices $\int p_i' p_j$ in each coordinate direction.
+       */
+      std::array<FullMatrix<double>, dim> derivative;
+
+      /**
+       * The weight of the first quadrature point, used to extract the
+       * determinant of the Jacobian from the JxW values.
+       */
+      double first_weight;
+    };
+
+
+
+    template <int dim>
+    TensorProductMatrices<dim>::TensorProductMatrices(
+      const TensorProductPolynomials<dim> &poly_space,
+      const Quadrature<dim> &              quadrature)
+      : tensor_indices(poly_space.n())
+      , first_weight(quadrature.weight(0))
+    {
+      const std::vector<Polynomials::Polynomial<double>> &polynomials =
+        poly_space.get_underlying_polynomials();
+      const unsigned int n_polynomials = polynomials.size();
+
+      const std::vector<unsigned int> &numbering = poly_space.get_numbering();
+      for (unsigned int i = 0; i < tensor_indices.size(); ++i)
+        for (unsigned int d = 0, index = numbering[i]; d < dim; ++d)
+          {
+            tensor_indices[i][d] = index % n_polynomials;
+            index /= n_polynomials;
+          }
+
+      const std::array<Quadrature<1>, dim> quadratures_1d =
+        quadrature.get_tensor_basis();
+      std::vector<double> values(2);
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          const Quadrature<1> &quadrature_1d = quadratures_1d[d];
+          const unsigned int   n_q_points    = quadrature_1d.size();
+
+          FullMatrix<double> shape_values(n_polynomials, n_q_points);
+          FullMatrix<double> shape_derivatives(n_polynomials, n_q_points);
+          for (unsigned int i = 0; i < n_polynomials; ++i)
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              {
+                polynomials[i].value(quadrature_1d.point(q)[0], values);
+                shape_values(i, q)      = values[0];
+                shape_derivatives(i, q) = values[1];
+              }
+
+          mass[d].reinit(n_polynomials, n_polynomials);
+          laplace[d].reinit(n_polynomials, n_polynomials);
+          derivative[d].reinit(n_polynomials, n_polynomials);
+          for (unsigned int i = 0; i < n_polynomials; ++i)
+            for (unsigned int j = 0; j < n_polynomials; ++j)
+              for (unsigned int q = 0; q < n_q_points; ++q)
+                {
+                  const double weight = quadrature_1d.weight(q);
+                  mass[d](i, j) +=
+                    shape_values(i, q) * shape_values(j, q) * weight;
+                  laplace[d](i, j) +=
+                    shape_derivatives(i, q) * shape_derivatives(j, q) * weight;
+                  derivative[d](i, j) +=
+                    shape_derivatives(i, q) * shape_values(j, q) * weight;
+                }
+        }
+    }
+
+
+
+    /**
+     * Return the data for the computation of cell matrices by Kronecker
+     * products if @p fe is a scalar element with tensor product shape
+     * functions and @p quadrature is a tensor product formula, and a null
+     * pointer otherwise.
+     */
+    template <int dim, int spacedim>
+    std::shared_ptr<const TensorProductMatrices<dim>>
+    create_tensor_product_matrices(const FiniteElement<dim, spacedim> &fe,
+                                   const Quadrature<dim> &quadrature)
+    {
+      const auto fe_poly = dynamic_cast<
+        const FE_Poly<TensorProductPolynomials<dim>, dim, spacedim> *>(&fe);
+      if (fe_poly == nullptr || fe.n_components() != 1 ||
+          quadrature.size() == 0 || quadrature.is_tensor_product() == false)
+        return nullptr;
+
+      return std::make_shared<const TensorProductMatrices<dim>>(
+        fe_poly->get_poly_space(), quadrature);
+    }
+
+
+
+    /**
+     * Return the data of create_tensor_product_matrices() for each element of
+     * @p fe_collection, or an empty vector if none of them supports the
+     * computation of cell matrices by Kronecker products.
+     */
+    template <int dim, int spacedim>
+    std::vector<std::shared_ptr<const TensorProductMatrices<dim>>>
+    create_tensor_product_matrices(
+      const ::dealii::hp::FECollection<dim, spacedim> &fe_collection,
+      const ::dealii::hp::QCollection<dim> &           quadrature_collection)
+    {
+      std::vector<std::shared_ptr<const TensorProductMatrices<dim>>> matrices(
+        fe_collection.size());
+      bool any_element_supported = false;
+      for (unsigned int i = 0; i < fe_collection.size(); ++i)
+        {
+          // hp::FEValues uses the same quadrature formula for all elements if
+          // only one is given
+          matrices[i] = create_tensor_product_matrices(
+            fe_collection[i],
+            quadrature_collection[quadrature_collection.size() == 1 ? 0 : i]);
+          if (matrices[i] != nullptr)
+            any_element_supported = true;
+        }
+
+      if (any_element_supported == false)
+        matrices.clear();
+      return matrices;
+    }
+
+
+
+    /**
+     * Return whether the Jacobian of the mapping is the same at all
+     * quadrature points of the cell @p fe_values was last reinitialized on.
+     */
+    template <int dim, int spacedim>
+    bool
+    has_constant_jacobian(const FEValues<dim, spacedim> &fe_values)
+    {
+      const DerivativeForm<1, dim, spacedim> &jacobian =
+        fe_values.jacobian(0);
+      const double tolerance = 1e-12 * jacobian.norm();
+      for (unsigned int q = 1; q < fe_values.n_quadrature_points; ++q)
+        {
+          double difference = 0;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            difference +=
+              (fe_values.jacobian(q)[d] - jacobian[d]).norm_square();
+          if (difference > tolerance * tolerance)
+            return false;
+        }
+      return true;
+    }
+
+
+
+    /**
+     * Fill @p cell_matrix with the mass matrix of a cell with constant
+     * Jacobian, given the determinant @p det_jacobian.
+     */
+    template <int dim, typename number>
+    void
+    tensor_product_mass_matrix(const TensorProductMatrices<dim> &matrices,
+                               const double                      det_jacobian,
+                               FullMatrix<number> &              cell_matrix)
+    {
+      const unsigned int dofs_per_cell = matrices.tensor_indices.size();
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        for (unsigned int j = i; j < dofs_per_cell; ++j)
+          {
+            double product = det_jacobian;
+            for (unsigned int d = 0; d < dim; ++d)
+              product *= matrices.mass[d](matrices.tensor_indices[i][d],
+                                          matrices.tensor_indices[j][d]);
+            cell_matrix(i, j) = product;
+            cell_matrix(j, i) = product;
+          }
+    }
+
+
+
+    /**
+     * Fill @p cell_matrix with the Laplace matrix of a cell with constant
+     * Jacobian. The entry $(a,b)$ of @p metric holds the product of the
+     * contravariant metric tensor and the determinant of the Jacobian, i.e.,
+     * the factor that multiplies the integral of the product of the
+     * derivatives in reference directions $a$ and $b$.
+     */
+    template <int dim, typename number>
+    void
+    tensor_product_laplace_matrix(const TensorProductMatrices<dim> &matrices,
+                                  const Tensor<2, dim> &            metric,
+                                  FullMatrix<number> &              cell_matrix)
+    {
+      const unsigned int dofs_per_cell = matrices.tensor_indices.size();
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        for (unsigned int j = i; j < dofs_per_cell; ++j)
+          {
+            const std::array<unsigned int, dim> &index_i =
+              matrices.tensor_indices[i];
+            const std::array<unsigned int, dim> &index_j =
+              matrices.tensor_indices[j];
+
+            double sum = 0;
+            for (unsigned int a = 0; a < dim; ++a)
+              for (unsigned int b = 0; b < dim; ++b)
+                {
+                  double product = metric[a][b];
+                  for (unsigned int d = 0; d < dim; ++d)
+                    if (d == a && d == b)
+                      product *= matrices.laplace[d](index_i[d], index_j[d]);
+                    else if (d == a)
+                      product *=
+                        matrices.derivative[d](index_i[d], index_j[d]);
+                    else if (d == b)
+                      product *=
+                        matrices.derivative[d](index_j[d], index_i[d]);
+                    else
+                      product *= matrices.mass[d](index_i[d], index_j[d]);
+                  sum += product;
+                }
+            cell_matrix(i, j) = sum;
+            cell_matrix(j, i) = sum;
+          }
+    }
+
+
+
     namespace AssemblerData
     {
       template <int dim, int spacedim, typename number>
@@ -141,10 +399,15 @@ namespace MatrixCreator
           : fe_collection(fe)
           , quadrature_collection(quadrature)
           , mapping_collection(mapping)
+          , tensor_product_matrices(
+              coefficient == nullptr ?
+                create_tensor_product_matrices(fe, quadrature) :
+                std::vector<
+                  std::shared_ptr<const TensorProductMatrices<dim>>>())
           , x_fe_values(mapping_collection,
                         fe_collection,
                         quadrature_collection,
-                        update_flags)
+                        fe_values_update_flags(update_flags))
           , coefficient_values(quadrature_collection.max_n_quadrature_points())
           , coefficient_vector_values(
               quadrature_collection.max_n_quadrature_points(),
@@ -162,10 +425,11 @@ namespace MatrixCreator
           : fe_collection(data.fe_collection)
           , quadrature_collection(data.quadrature_collection)
           , mapping_collection(data.mapping_collection)
+          , tensor_product_matrices(data.tensor_product_matrices)
           , x_fe_values(mapping_collection,
                         fe_collection,
                         quadrature_collection,
-                        data.update_flags)
+                        fe_values_update_flags(data.update_flags))
           , coefficient_values(data.coefficient_values)
           , coefficient_vector_values(data.coefficient_vector_values)
           , rhs_values(data.rhs_values)
@@ -182,12 +446,44 @@ namespace MatrixCreator
           return *this;
         }
 
+        /**
+         * Return the flags to initialize x_fe_values with. The Jacobians are
+         * needed to decide whether a cell matrix can be computed by Kronecker
+         * products.
+         */
+        UpdateFlags
+        fe_values_update_flags(const UpdateFlags flags) const
+        {
+          return tensor_product_matrices.empty() ? flags :
+                                                   flags | update_jacobians;
+        }
+
+        /**
+         * Return the data for computing the matrix on @p cell by Kronecker
+         * products, or a null pointer if the general quadrature loop needs to
+         * be used.
+         */
+        template <typename CellIterator>
+        const TensorProductMatrices<dim> *
+        get_tensor_product_matrices(
+          const CellIterator &           cell,
+          const FEValues<dim, spacedim> &fe_values) const
+        {
+          if (tensor_product_matrices.empty() ||
+              tensor_product_matrices[cell->active_fe_index()] == nullptr ||
+              has_constant_jacobian(fe_values) == false)
+            return nullptr;
+          return tensor_product_matrices[cell->active_fe_index()].get();
+        }
 
         const ::dealii::hp::FECollection<dim, spacedim> &fe_collection;
         const ::dealii::hp::QCollection<dim> &           quadrature_collection;
         const ::dealii::hp::MappingCollection<dim, spacedim>
           &mapping_collection;
 
+        std::vector<std::shared_ptr<const TensorProductMatrices<dim>>>
+          tensor_product_matrices;
+
         ::dealii::hp::FEValues<dim, spacedim> x_fe_values;
 
         std::vector<number>                 coefficient_values;
@@ -284,6 +580,26 @@ namespace MatrixCreator
 
 
       const std::vector<double> &JxW = fe_values.get_JxW_values();
+
+      if (const TensorProductMatrices<dim> *matrices =
+            data.get_tensor_product_matrices(cell, fe_values))
+        {
+          tensor_product_mass_matrix(*matrices,
+                                     JxW[0] / matrices->first_weight,
+                                     copy_data.cell_matrix);
+
+          if (use_rhs_function)
+            for (unsigned int i = 0; i < dofs_per_cell; ++i)
+              {
+                number add_data = 0;
+                for (unsigned int point = 0; point < n_q_points; ++point)
+                  add_data += data.rhs_values[point] *
+                              fe_values.shape_value(i, point) * JxW[point];
+                copy_data.cell_rhs(i) = add_data;
+              }
+          return;
+        }
+
       for (unsigned int i = 0; i < dofs_per_cell; ++i)
         if (fe.is_primitive())
           {
@@ -491,7 +807,38 @@ namespace MatrixCreator
 
 
       const std::vector<double> &JxW = fe_values.get_JxW_values();
-      double                     add_data;
+
+      if (const TensorProductMatrices<dim> *matrices =
+            data.get_tensor_product_matrices(cell, fe_values))
+        {
+          const DerivativeForm<1, dim, spacedim> covariant =
+            fe_values.jacobian(0).covariant_form();
+          const double   det_jacobian = JxW[0] / matrices->first_weight;
+          Tensor<2, dim> metric;
+          for (unsigned int a = 0; a < dim; ++a)
+            for (unsigned int b = 0; b < dim; ++b)
+              {
+                for (unsigned int d = 0; d < spacedim; ++d)
+                  metric[a][b] += covariant[d][a] * covariant[d][b];
+                metric[a][b] *= det_jacobian;
+              }
+          tensor_product_laplace_matrix(*matrices,
+                                        metric,
+                                        copy_data.cell_matrix);
+
+          if (use_rhs_function)
+            for (unsigned int i = 0; i < dofs_per_cell; ++i)
+              {
+                double add_data = 0;
+                for (unsigned int point = 0; point < n_q_points; ++point)
+                  add_data += fe_values.shape_value(i, point) * JxW[point] *
+                              data.rhs_values[point];
+                copy_data.cell_rhs(i) = add_data;
+              }
+          return;
+        }
+
+      double add_data;
       for (unsigned int i = 0; i < dofs_per_cell; ++i)
         if (fe.is_primitive())
           {
@@ -41,6 +41,7 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -114,11 +115,15 @@ namespace internal
  * point will most likely change slightly, making the interpretation of the
  * data difficult, hence this is not implemented currently.)
  *
- * <li> Secondly, @p evaluate_field_at_requested_location calls @p
- * VectorTools::point_value to compute values at the specific point requested.
- * This method is valid for any FE that is supported by @p
- * VectorTools::point_value. Specifically, this method can be called by codes
- * using adaptive mesh refinement.
+ * <li> Secondly, @p evaluate_field_at_requested_location computes values at
+ * the specific points requested, in the same way as @p
+ * VectorTools::point_value. This method is valid for any FE that is supported
+ * by @p VectorTools::point_value. The cells around the requested points and
+ * the coordinates of the points on the reference cell are only searched for
+ * once and are cached until the triangulation changes, and all points in one
+ * cell are evaluated together. Specifically, this method can be called by
+ * codes using adaptive mesh refinement, and for meshes distributed over
+ * several MPI processes.
  *
  * <li>Finally, the class offers a function @p evaluate_field that takes a @p
  * DataPostprocessor object. This method allows the deal.II data postprocessor
@@ -377,9 +382,22 @@ public:
    * Extract values at the points actually requested from the VectorType
    * supplied and add them to the new dataset in vector_name. Unlike the other
    * evaluate_field methods this method does not care if the dof_handler has
-   * been modified because it uses calls to @p VectorTools::point_value to
-   * extract there data. Therefore, if only this method is used, the class is
-   * fully compatible with adaptive refinement. The component_mask supplied
+   * been modified because it evaluates the solution at the requested points
+   * the same way as @p VectorTools::point_value. Therefore, if only this
+   * method is used, the class is fully compatible with adaptive refinement.
+   *
+   * The cell around each requested point and the coordinates of the point
+   * on the reference cell are determined by the first call of this method
+   * and reused by later calls until the triangulation changes. The points
+   * that lie in the same cell are evaluated together with a single FEValues
+   * object. If the triangulation is a parallel::Triangulation, each process
+   * evaluates the points in its locally owned cells and the values are
+   * combined with a single collective operation, so this method must then be
+   * called on all processes of the communicator at the same time, and the
+   * solution vector must contain the ghost values of the locally relevant
+   * degrees of freedom.
+   *
+   * The component_mask supplied
    * when the field was added is used to select components to extract. If a @p
    * DoFHandler is used, one (and only one) evaluate_field method must be
    * called for each dataset (time step, iteration, etc) for each vector_name,
@@ -673,6 +691,46 @@ private:
   unsigned int n_indep;
 
 
+  /**
+   * The locally owned cells that contain at least one of the requested
+   * locations, as used by evaluate_field_at_requested_location().
+   */
+  std::vector<typename DoFHandler<dim>::active_cell_iterator>
+    requested_location_cells;
+
+  /**
+   * For each of the requested_location_cells, the indices of the requested
+   * locations, i.e., of the entries of point_geometry_data, inside the cell.
+   */
+  std::vector<std::vector<unsigned int>> requested_location_indices;
+
+  /**
+   * For each of the requested_location_cells, an FEValues object whose
+   * quadrature points are the reference coordinates of the requested
+   * locations inside the cell.
+   */
+  std::vector<std::unique_ptr<FEValues<dim>>> requested_location_fe_values;
+
+  /**
+   * For each requested location, the number of processes that evaluate the
+   * solution at the location. This is more than one if the location lies on
+   * the boundary between the cells of several processes.
+   */
+  std::vector<unsigned int> requested_location_n_owners;
+
+  /**
+   * Whether the data above is valid for the current triangulation.
+   */
+  bool requested_locations_cached;
+
+
+  /**
+   * Find the cells around the requested locations and set up the data used
+   * by evaluate_field_at_requested_location().
+   */
+  void
+  setup_requested_locations();
+
   /**
    * A function that will be triggered through signals whenever the
    * triangulation is modified.
@@ -18,6 +18,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/point.h>
 
 #include <deal.II/boost_adaptors/bounding_box.h>
@@ -27,6 +28,7 @@
 #include <boost/geometry.hpp>
 
 #include <memory>
+#include <vector>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -160,6 +162,27 @@ template <typename IndexType = boost::geometry::index::linear<16>,
 RTree<typename ContainerType::value_type, IndexType>
 pack_rtree(const ContainerType &container);
 
+/**
+ * For each of the @p points, find the @p n_nearest leaves of @p tree that are
+ * closest to it, sorted by increasing distance. This is a batched version of
+ * the query
+ * @code
+ * tree.query(boost::geometry::index::nearest(point, n_nearest), ...);
+ * @endcode
+ * for many points at once, e.g. to look up the closest vertices of a mesh
+ * for all support points of another mesh. Since queries of a constant tree
+ * do not modify it, the points are distributed over the available threads
+ * with parallel::apply_to_subranges().
+ *
+ * If the tree holds fewer than @p n_nearest leaves, all of them are returned
+ * for each point.
+ */
+template <typename LeafType, typename IndexType, int spacedim>
+std::vector<std::vector<LeafType>>
+find_nearest_leaves(const RTree<LeafType, IndexType> &  tree,
+                    const std::vector<Point<spacedim>> &points,
+                    const unsigned int                  n_nearest);
+
 
 
 // Inline and template functions
@@ -180,6 +203,34 @@ pack_rtree(const ContainerType &container)
   return pack_rtree<IndexType>(container.begin(), container.end());
 }
 
+
+
+template <typename LeafType, typename IndexType, int spacedim>
+std::vector<std::vector<LeafType>>
+find_nearest_leaves(const RTree<LeafType, IndexType> &  tree,
+                    const std::vector<Point<spacedim>> &points,
+                    const unsigned int                  n_nearest)
+{
+  std::vector<std::vector<LeafType>> result(points.size());
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(points.size()),
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int i = begin; i < end; ++i)
+        {
+          result[i].reserve(std::min<std::size_t>(n_nearest, tree.size()));
+          // the query iterator returns the leaves by increasing distance
+          for (auto it = tree.qbegin(
+                 boost::geometry::index::nearest(points[i], n_nearest));
+               it != tree.qend();
+               ++it)
+            result[i].push_back(*it);
+        }
+    },
+    256);
+  return result;
+}
+
 #endif
 
 DEAL_II_NAMESPACE_CLOSE
@@ -798,6 +798,42 @@ namespace VectorTools
     const AffineConstraints<typename VectorType::value_type> &constraints,
     VectorType &                                              u2);
 
+  /**
+   * Compute the interpolation of a @p dof1-function @p u1 to a @p
+   * dof2-function @p u2, where @p dof1 and @p dof2 are defined on
+   * triangulations that cover the same domain but are otherwise unrelated,
+   * e.g., a mesh and its replacement generated by an external mesh
+   * generator. In contrast to the functions above, the two triangulations
+   * need not share a coarse mesh and, if they are distributed, may be
+   * partitioned in any way.
+   *
+   * The values of @p u2 are obtained by evaluating @p u1 at the support
+   * points of the locally owned degrees of freedom of @p dof2, which
+   * requires that the finite element of @p dof2 is primitive and has support
+   * points. All points are located on the triangulation of @p dof1 at once
+   * and the values are exchanged between the processes with a
+   * Utilities::MPI::RemotePointEvaluation object. The shape functions of the
+   * finite element of @p dof1 are evaluated on the reference cell, so it
+   * must be an element whose shape functions are not transformed by the
+   * mapping, like FE_Q or FE_DGQ and systems thereof.
+   *
+   * @p u1 needs to contain the values of all locally relevant degrees of
+   * freedom of @p dof1, i.e., parallel vectors must have their ghost values
+   * updated. Degrees of freedom of @p dof2 whose support points lie outside
+   * the triangulation of @p dof1 are left untouched.
+   *
+   * For a parallel::Triangulation, this is a collective operation on its
+   * communicator.
+   */
+  template <int dim, int spacedim, typename VectorType>
+  void
+  interpolate_to_different_mesh(const Mapping<dim, spacedim> &   mapping1,
+                                const DoFHandler<dim, spacedim> &dof1,
+                                const VectorType &               u1,
+                                const Mapping<dim, spacedim> &   mapping2,
+                                const DoFHandler<dim, spacedim> &dof2,
+                                VectorType &                     u2);
+
   /**
    * Compute the projection of @p function to the finite element space. In other
    * words, given a function $f(\mathbf x)$, the current function computes a
@@ -2569,6 +2605,39 @@ namespace VectorTools
                        const Function<spacedim, double> *   weight   = nullptr,
                        const double                         exponent = 2.);
 
+  /**
+   * Same as above, but evaluate the finite element function @p fe_function
+   * with the MatrixFree framework, using the DoFHandler with index @p dof_no
+   * and the quadrature formula with index @p quad_no of @p matrix_free. The
+   * cells are visited in batches and the finite element function is
+   * evaluated with sum factorization, which is considerably faster than the
+   * FEValues-based version for higher polynomial degrees and large meshes.
+   * All the norms of NormType are supported.
+   *
+   * @p matrix_free must have been set up with at least the update flags
+   * update_quadrature_points and update_JxW_values, plus update_values and
+   * update_gradients for the norms involving values and gradients,
+   * respectively. @p fe_function needs to have its ghost values updated.
+   * The entries of @p difference are computed for the locally owned cells
+   * and are zero for all other cells.
+   */
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            class InVector,
+            class OutVector>
+  void
+  integrate_difference(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const InVector &                                    fe_function,
+    const Function<dim, double> &                       exact_solution,
+    OutVector &                                         difference,
+    const NormType &                                    norm,
+    const Function<dim, double> *                       weight   = nullptr,
+    const double                                        exponent = 2.,
+    const unsigned int                                  dof_no   = 0,
+    const unsigned int                                  quad_no  = 0);
+
   /**
    * Take a Vector @p cellwise_error of errors on each cell with
    * <tt>tria.n_active_cells()</tt> entries and return the global
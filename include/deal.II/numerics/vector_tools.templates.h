@@ -19,10 +19,12 @@
 
 #include <deal.II/base/derivative_form.h>
 #include <deal.II/base/function.h>
+#include <deal.II/base/mpi_remote_point_evaluation.h>
 #include <deal.II/base/numbers.h>
 #include <deal.II/base/polynomials_piecewise.h>
 #include <deal.II/base/qprojector.h>
 #include <deal.II/base/quadrature.h>
+#include <deal.II/base/std_cxx14/memory.h>
 
 #include <deal.II/distributed/tria_base.h>
 
@@ -73,6 +75,7 @@
 #include <deal.II/lac/trilinos_tpetra_vector.h>
 #include <deal.II/lac/trilinos_vector.h>
 #include <deal.II/lac/vector.h>
+#include <deal.II/lac/vector_element_access.h>
 #include <deal.II/lac/vector_memory.h>
 
 #include <deal.II/matrix_free/fe_evaluation.h>
@@ -907,6 +910,123 @@ namespace VectorTools
     constraints.distribute(u2);
   }
 
+
+
+  template <int dim, int spacedim, typename VectorType>
+  void
+  interpolate_to_different_mesh(const Mapping<dim, spacedim> &   mapping1,
+                                const DoFHandler<dim, spacedim> &dof1,
+                                const VectorType &               u1,
+                                const Mapping<dim, spacedim> &   mapping2,
+                                const DoFHandler<dim, spacedim> &dof2,
+                                VectorType &                     u2)
+  {
+    using value_type = typename VectorType::value_type;
+
+    const FiniteElement<dim, spacedim> &fe2 = dof2.get_fe();
+    Assert(fe2.is_primitive(), ExcMessage("The element must be primitive."));
+    Assert(fe2.has_support_points(),
+           ExcMessage("The element must have support points."));
+    AssertDimension(dof1.get_fe().n_components(), fe2.n_components());
+    Assert(u1.size() == dof1.n_dofs(),
+           ExcDimensionMismatch(u1.size(), dof1.n_dofs()));
+    Assert(u2.size() == dof2.n_dofs(),
+           ExcDimensionMismatch(u2.size(), dof2.n_dofs()));
+
+    // collect the support points of the locally owned degrees of freedom of
+    // dof2, each of them only once
+    FEValues<dim, spacedim> fe_values(mapping2,
+                                      fe2,
+                                      Quadrature<dim>(
+                                        fe2.get_unit_support_points()),
+                                      update_quadrature_points);
+
+    const IndexSet &owned_dofs = dof2.locally_owned_dofs();
+    std::vector<bool> dof_is_touched(owned_dofs.n_elements(), false);
+    std::vector<types::global_dof_index> dof_indices(fe2.dofs_per_cell);
+
+    std::vector<Point<spacedim>>         points;
+    std::vector<types::global_dof_index> point_dofs;
+    std::vector<unsigned int>            point_components;
+    for (const auto &cell : dof2.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          fe_values.reinit(cell);
+          cell->get_dof_indices(dof_indices);
+          for (unsigned int i = 0; i < fe2.dofs_per_cell; ++i)
+            if (owned_dofs.is_element(dof_indices[i]))
+              {
+                const unsigned int index =
+                  owned_dofs.index_within_set(dof_indices[i]);
+                if (dof_is_touched[index] == false)
+                  {
+                    dof_is_touched[index] = true;
+                    points.push_back(fe_values.quadrature_point(i));
+                    point_dofs.push_back(dof_indices[i]);
+                    point_components.push_back(
+                      fe2.system_to_component_index(i).first);
+                  }
+              }
+        }
+
+    // locate all points on the triangulation of dof1 once, and reuse the
+    // communication pattern for all components
+    Utilities::MPI::RemotePointEvaluation<dim, spacedim> remote_evaluation;
+    remote_evaluation.reinit(points, dof1.get_triangulation(), mapping1);
+    const std::vector<unsigned int> &point_ptrs =
+      remote_evaluation.get_point_ptrs();
+
+    std::vector<value_type> values, buffer;
+    Vector<value_type>      local_values;
+    for (unsigned int component = 0; component < fe2.n_components();
+         ++component)
+      {
+        remote_evaluation.evaluate_and_process(
+          values,
+          buffer,
+          [&](const ArrayView<value_type> &evaluated_values,
+              const typename Utilities::MPI::
+                RemotePointEvaluation<dim, spacedim>::CellData &cell_data) {
+            for (unsigned int c = 0; c < cell_data.cells.size(); ++c)
+              {
+                const typename DoFHandler<dim, spacedim>::active_cell_iterator
+                  cell(&dof1.get_triangulation(),
+                       cell_data.cells[c].first,
+                       cell_data.cells[c].second,
+                       &dof1);
+                const FiniteElement<dim, spacedim> &fe1 = cell->get_fe();
+
+                local_values.reinit(fe1.dofs_per_cell);
+                cell->get_dof_values(u1, local_values);
+
+                for (unsigned int q = cell_data.reference_point_ptrs[c];
+                     q < cell_data.reference_point_ptrs[c + 1];
+                     ++q)
+                  {
+                    value_type value = value_type();
+                    for (unsigned int i = 0; i < fe1.dofs_per_cell; ++i)
+                      value += local_values[i] *
+                               fe1.shape_value_component(
+                                 i,
+                                 cell_data.reference_point_values[q],
+                                 component);
+                    evaluated_values[q] = value;
+                  }
+              }
+          });
+
+        // a point on the interface between several cells has been found
+        // several times, but the values agree for continuous fields
+        for (unsigned int p = 0; p < points.size(); ++p)
+          if (point_components[p] == component &&
+              point_ptrs[p + 1] > point_ptrs[p])
+            dealii::internal::ElementAccess<VectorType>::set(
+              values[point_ptrs[p]], point_dofs[p], u2);
+      }
+
+    u2.compress(VectorOperation::insert);
+  }
+
   namespace internal
   {
     /**
@@ -7795,16 +7915,14 @@ namespace VectorTools
 
   namespace internal
   {
-    template <int dim, int spacedim, typename Number>
-    struct IDScratchData
+    /**
+     * The values of the finite element function, the exact solution, and
+     * the weight at the quadrature points of a cell, as used by
+     * integrate_difference_inner().
+     */
+    template <int spacedim, typename Number>
+    struct IDValueData
     {
-      IDScratchData(const dealii::hp::MappingCollection<dim, spacedim> &mapping,
-                    const dealii::hp::FECollection<dim, spacedim> &     fe,
-                    const dealii::hp::QCollection<dim> &                q,
-                    const UpdateFlags update_flags);
-
-      IDScratchData(const IDScratchData &data);
-
       void
       resize_vectors(const unsigned int n_q_points,
                      const unsigned int n_components);
@@ -7822,6 +7940,18 @@ namespace VectorTools
       std::vector<Vector<double>>                   tmp_vector_values;
       std::vector<Tensor<1, spacedim>>              tmp_gradients;
       std::vector<std::vector<Tensor<1, spacedim>>> tmp_vector_gradients;
+    };
+
+
+    template <int dim, int spacedim, typename Number>
+    struct IDScratchData : public IDValueData<spacedim, Number>
+    {
+      IDScratchData(const dealii::hp::MappingCollection<dim, spacedim> &mapping,
+                    const dealii::hp::FECollection<dim, spacedim> &     fe,
+                    const dealii::hp::QCollection<dim> &                q,
+                    const UpdateFlags update_flags);
+
+      IDScratchData(const IDScratchData &data);
 
       dealii::hp::FEValues<dim, spacedim> x_fe_values;
     };
@@ -7845,9 +7975,9 @@ namespace VectorTools
                     data.x_fe_values.get_update_flags())
     {}
 
-    template <int dim, int spacedim, typename Number>
+    template <int spacedim, typename Number>
     void
-    IDScratchData<dim, spacedim, Number>::resize_vectors(
+    IDValueData<spacedim, Number>::resize_vectors(
       const unsigned int n_q_points,
       const unsigned int n_components)
     {
@@ -7900,27 +8030,29 @@ namespace VectorTools
     // function
     template <int dim, int spacedim, typename Number>
     double
-    integrate_difference_inner(const Function<spacedim> &exact_solution,
-                               const NormType &          norm,
-                               const Function<spacedim> *weight,
-                               const UpdateFlags         update_flags,
-                               const double              exponent,
-                               const unsigned int        n_components,
-                               IDScratchData<dim, spacedim, Number> &data)
+    integrate_difference_inner(
+      const Function<spacedim> &              exact_solution,
+      const NormType &                        norm,
+      const Function<spacedim> *              weight,
+      const UpdateFlags                       update_flags,
+      const double                            exponent,
+      const unsigned int                      n_components,
+      const std::vector<Point<spacedim>> &    quadrature_points,
+      const std::vector<double> &             JxW_values,
+      const std::vector<Tensor<1, spacedim>> *normal_vectors,
+      IDValueData<spacedim, Number> &         data)
     {
-      const bool                             fe_is_system = (n_components != 1);
-      const dealii::FEValues<dim, spacedim> &fe_values =
-        data.x_fe_values.get_present_fe_values();
-      const unsigned int n_q_points = fe_values.n_quadrature_points;
+      const bool         fe_is_system = (n_components != 1);
+      const unsigned int n_q_points   = quadrature_points.size();
 
       if (weight != nullptr)
         {
           if (weight->n_components > 1)
-            weight->vector_value_list(fe_values.get_quadrature_points(),
+            weight->vector_value_list(quadrature_points,
                                       data.weight_vectors);
           else
             {
-              weight->value_list(fe_values.get_quadrature_points(),
+              weight->value_list(quadrature_points,
                                  data.weight_values);
               for (unsigned int k = 0; k < n_q_points; ++k)
                 data.weight_vectors[k] = data.weight_values[k];
@@ -7948,13 +8080,13 @@ namespace VectorTools
           if (fe_is_system)
             {
               exact_solution.vector_value_list(
-                fe_values.get_quadrature_points(), data.tmp_vector_values);
+                quadrature_points, data.tmp_vector_values);
               for (unsigned int i = 0; i < n_q_points; ++i)
                 data.psi_values[i] = data.tmp_vector_values[i];
             }
           else
             {
-              exact_solution.value_list(fe_values.get_quadrature_points(),
+              exact_solution.value_list(quadrature_points,
                                         data.tmp_values);
               for (unsigned int i = 0; i < n_q_points; ++i)
                 data.psi_values[i](0) = data.tmp_values[i];
@@ -7975,7 +8107,7 @@ namespace VectorTools
           if (fe_is_system)
             {
               exact_solution.vector_gradient_list(
-                fe_values.get_quadrature_points(), data.tmp_vector_gradients);
+                quadrature_points, data.tmp_vector_gradients);
               for (unsigned int i = 0; i < n_q_points; ++i)
                 for (unsigned int comp = 0; comp < data.psi_grads[i].size();
                      ++comp)
@@ -7983,7 +8115,7 @@ namespace VectorTools
             }
           else
             {
-              exact_solution.gradient_list(fe_values.get_quadrature_points(),
+              exact_solution.gradient_list(quadrature_points,
                                            data.tmp_gradients);
               for (unsigned int i = 0; i < n_q_points; ++i)
                 data.psi_grads[i][0] = data.tmp_gradients[i];
@@ -8000,9 +8132,9 @@ namespace VectorTools
                 {
                   // compute (f.n) n
                   const typename ProductType<Number, double>::type f_dot_n =
-                    data.psi_grads[q][k] * fe_values.normal_vector(q);
+                    data.psi_grads[q][k] * (*normal_vectors)[q];
                   const Tensor<1, spacedim, Number> f_dot_n_times_n =
-                    f_dot_n * fe_values.normal_vector(q);
+                    f_dot_n * (*normal_vectors)[q];
 
                   data.psi_grads[q][k] -=
                     (data.function_grads[q][k] + f_dot_n_times_n);
@@ -8028,7 +8160,7 @@ namespace VectorTools
                 for (unsigned int k = 0; k < n_components; ++k)
                   if (data.weight_vectors[q](k) != 0)
                     sum += data.psi_values[q](k) * data.weight_vectors[q](k);
-                diff_mean += sum * fe_values.JxW(q);
+                diff_mean += sum * JxW_values[q];
               }
             break;
 
@@ -8046,7 +8178,7 @@ namespace VectorTools
                                         data.psi_values[q](k))),
                                     exponent / 2.) *
                            data.weight_vectors[q](k);
-                diff += sum * fe_values.JxW(q);
+                diff += sum * JxW_values[q];
               }
 
             // Compute the root only if no derivative values are added later
@@ -8065,7 +8197,7 @@ namespace VectorTools
                     sum += numbers::NumberTraits<Number>::abs_square(
                              data.psi_values[q](k)) *
                            data.weight_vectors[q](k);
-                diff += sum * fe_values.JxW(q);
+                diff += sum * JxW_values[q];
               }
             // Compute the root only, if no derivative values are added later
             if (norm == L2_norm)
@@ -8107,7 +8239,7 @@ namespace VectorTools
                     sum += std::pow(data.psi_grads[q][k].norm_square(),
                                     exponent / 2.) *
                            data.weight_vectors[q](k);
-                diff += sum * fe_values.JxW(q);
+                diff += sum * JxW_values[q];
               }
             diff = std::pow(diff, 1. / exponent);
             break;
@@ -8121,7 +8253,7 @@ namespace VectorTools
                   if (data.weight_vectors[q](k) != 0)
                     sum += data.psi_grads[q][k].norm_square() *
                            data.weight_vectors[q](k);
-                diff += sum * fe_values.JxW(q);
+                diff += sum * JxW_values[q];
               }
             diff = std::sqrt(diff);
             break;
@@ -8151,7 +8283,7 @@ namespace VectorTools
                     sum += data.psi_grads[q][k][k - idx] *
                            std::sqrt(data.weight_vectors[q](k));
                 diff += numbers::NumberTraits<Number>::abs_square(sum) *
-                        fe_values.JxW(q);
+                        JxW_values[q];
               }
             diff = std::sqrt(diff);
             break;
@@ -8186,60 +8318,40 @@ namespace VectorTools
 
 
 
-    template <int dim,
-              class InVector,
-              class OutVector,
-              typename DoFHandlerType,
-              int spacedim>
-    static void
-    do_integrate_difference(
-      const dealii::hp::MappingCollection<dim, spacedim> &mapping,
-      const DoFHandlerType &                              dof,
-      const InVector &                                    fe_function,
-      const Function<spacedim> &                          exact_solution,
-      OutVector &                                         difference,
-      const dealii::hp::QCollection<dim> &                q,
-      const NormType &                                    norm,
-      const Function<spacedim> *                          weight,
-      const double                                        exponent_1)
+    /**
+     * Return the exponent that is actually used for the given norm, which
+     * is fixed for the L1 norm and the Hilbert space norms.
+     */
+    inline double
+    integrate_difference_exponent(const NormType &norm, const double exponent)
     {
-      using Number = typename InVector::value_type;
-      // we mark the "exponent" parameter to this function "const" since it is
-      // strictly incoming, but we need to set it to something different later
-      // on, if necessary, so have a read-write version of it:
-      double exponent = exponent_1;
-
-      const unsigned int n_components = dof.get_fe(0).n_components();
-
-      Assert(exact_solution.n_components == n_components,
-             ExcDimensionMismatch(exact_solution.n_components, n_components));
-
-      if (weight != nullptr)
-        {
-          Assert((weight->n_components == 1) ||
-                   (weight->n_components == n_components),
-                 ExcDimensionMismatch(weight->n_components, n_components));
-        }
-
-      difference.reinit(dof.get_triangulation().n_active_cells());
-
       switch (norm)
         {
           case L2_norm:
           case H1_seminorm:
           case H1_norm:
           case Hdiv_seminorm:
-            exponent = 2.;
-            break;
+            return 2.;
 
           case L1_norm:
-            exponent = 1.;
-            break;
+            return 1.;
 
           default:
-            break;
+            return exponent;
         }
+    }
+
 
+
+    /**
+     * Return the update flags needed to compute the given norm. The normal
+     * vectors are needed for the tangential gradients of codimension one
+     * problems.
+     */
+    inline UpdateFlags
+    integrate_difference_update_flags(const NormType &norm,
+                                      const bool      codimension_one)
+    {
       UpdateFlags update_flags =
         UpdateFlags(update_quadrature_points | update_JxW_values);
       switch (norm)
@@ -8249,7 +8361,7 @@ namespace VectorTools
           case W1p_seminorm:
           case W1infty_seminorm:
             update_flags |= UpdateFlags(update_gradients);
-            if (spacedim == dim + 1)
+            if (codimension_one)
               update_flags |= UpdateFlags(update_normal_vectors);
 
             break;
@@ -8258,7 +8370,7 @@ namespace VectorTools
           case W1p_norm:
           case W1infty_norm:
             update_flags |= UpdateFlags(update_gradients);
-            if (spacedim == dim + 1)
+            if (codimension_one)
               update_flags |= UpdateFlags(update_normal_vectors);
             DEAL_II_FALLTHROUGH;
 
@@ -8266,6 +8378,48 @@ namespace VectorTools
             update_flags |= UpdateFlags(update_values);
             break;
         }
+      return update_flags;
+    }
+
+
+
+    template <int dim,
+              class InVector,
+              class OutVector,
+              typename DoFHandlerType,
+              int spacedim>
+    static void
+    do_integrate_difference(
+      const dealii::hp::MappingCollection<dim, spacedim> &mapping,
+      const DoFHandlerType &                              dof,
+      const InVector &                                    fe_function,
+      const Function<spacedim> &                          exact_solution,
+      OutVector &                                         difference,
+      const dealii::hp::QCollection<dim> &                q,
+      const NormType &                                    norm,
+      const Function<spacedim> *                          weight,
+      const double                                        exponent_1)
+    {
+      using Number = typename InVector::value_type;
+
+      const unsigned int n_components = dof.get_fe(0).n_components();
+
+      Assert(exact_solution.n_components == n_components,
+             ExcDimensionMismatch(exact_solution.n_components, n_components));
+
+      if (weight != nullptr)
+        {
+          Assert((weight->n_components == 1) ||
+                   (weight->n_components == n_components),
+                 ExcDimensionMismatch(weight->n_components, n_components));
+        }
+
+      difference.reinit(dof.get_triangulation().n_active_cells());
+
+      const double exponent = integrate_difference_exponent(norm, exponent_1);
+
+      const UpdateFlags update_flags =
+        integrate_difference_update_flags(norm, spacedim == dim + 1);
 
       const dealii::hp::FECollection<dim, spacedim> &fe_collection =
         dof.get_fe_collection();
@@ -8296,13 +8450,19 @@ namespace VectorTools
                                                data.function_grads);
 
             difference(cell->active_cell_index()) =
-              integrate_difference_inner<dim, spacedim, Number>(exact_solution,
-                                                                norm,
-                                                                weight,
-                                                                update_flags,
-                                                                exponent,
-                                                                n_components,
-                                                                data);
+              integrate_difference_inner<dim, spacedim, Number>(
+                exact_solution,
+                norm,
+                weight,
+                update_flags,
+                exponent,
+                n_components,
+                fe_values.get_quadrature_points(),
+                fe_values.get_JxW_values(),
+                (update_flags & update_normal_vectors) ?
+                  &fe_values.get_normal_vectors() :
+                  nullptr,
+                data);
           }
         else
           // the cell is a ghost cell or is artificial. write a zero into the
@@ -8413,6 +8573,117 @@ namespace VectorTools
       exponent);
   }
 
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            class InVector,
+            class OutVector>
+  void
+  integrate_difference(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const InVector &                                    fe_function,
+    const Function<dim> &                               exact_solution,
+    OutVector &                                         difference,
+    const NormType &                                    norm,
+    const Function<dim> *                               weight,
+    const double                                        exponent_1,
+    const unsigned int                                  dof_no,
+    const unsigned int                                  quad_no)
+  {
+    const DoFHandler<dim> &dof = matrix_free.get_dof_handler(dof_no);
+    const unsigned int     n_components = dof.get_fe().n_components();
+
+    Assert(exact_solution.n_components == n_components,
+           ExcDimensionMismatch(exact_solution.n_components, n_components));
+    if (weight != nullptr)
+      {
+        Assert((weight->n_components == 1) ||
+                 (weight->n_components == n_components),
+               ExcDimensionMismatch(weight->n_components, n_components));
+      }
+
+    difference.reinit(dof.get_triangulation().n_active_cells());
+
+    const double exponent =
+      internal::integrate_difference_exponent(norm, exponent_1);
+
+    const UpdateFlags update_flags =
+      internal::integrate_difference_update_flags(norm, false);
+
+    // evaluate the components one at a time with scalar evaluators, which
+    // supports any number of components and the degree set at run time
+    using EvaluatorType =
+      FEEvaluation<dim, -1, 0, 1, Number, VectorizedArrayType>;
+    std::vector<std::unique_ptr<EvaluatorType>> evaluators;
+    for (unsigned int c = 0; c < n_components; ++c)
+      evaluators.push_back(std_cxx14::make_unique<EvaluatorType>(
+        matrix_free, dof_no, quad_no, c));
+
+    const unsigned int n_q_points = evaluators[0]->n_q_points;
+    internal::IDValueData<dim, Number> data;
+    data.resize_vectors(n_q_points, n_components);
+    std::vector<Point<dim>> quadrature_points(n_q_points);
+    std::vector<double>     JxW_values(n_q_points);
+
+    for (unsigned int cell = 0; cell < matrix_free.n_macro_cells(); ++cell)
+      {
+        for (auto &phi : evaluators)
+          {
+            phi->reinit(cell);
+            phi->read_dof_values_plain(fe_function);
+            phi->evaluate(update_flags & update_values,
+                          update_flags & update_gradients);
+          }
+
+        // the values at the quadrature points of the cells within the batch
+        // are handed to the same function as used for the FEValues-based
+        // implementation, cell by cell
+        for (unsigned int v = 0; v < matrix_free.n_components_filled(cell);
+             ++v)
+          {
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              {
+                const Point<dim, VectorizedArrayType> point =
+                  evaluators[0]->quadrature_point(q);
+                for (unsigned int d = 0; d < dim; ++d)
+                  quadrature_points[q][d] = point[d][v];
+                JxW_values[q] = evaluators[0]->JxW(q)[v];
+
+                for (unsigned int c = 0; c < n_components; ++c)
+                  {
+                    if (update_flags & update_values)
+                      data.function_values[q][c] =
+                        evaluators[c]->get_value(q)[v];
+                    if (update_flags & update_gradients)
+                      {
+                        const Tensor<1, dim, VectorizedArrayType> gradient =
+                          evaluators[c]->get_gradient(q);
+                        for (unsigned int d = 0; d < dim; ++d)
+                          data.function_grads[q][c][d] = gradient[d][v];
+                      }
+                  }
+              }
+
+            difference(
+              matrix_free.get_cell_iterator(cell, v, dof_no)
+                ->active_cell_index()) =
+              internal::integrate_difference_inner<dim, dim, Number>(
+                exact_solution,
+                norm,
+                weight,
+                update_flags,
+                exponent,
+                n_components,
+                quadrature_points,
+                JxW_values,
+                nullptr,
+                data);
+          }
+      }
+  }
+
+
+
   template <int dim, int spacedim, class InVector>
   double
   compute_global_error(const Triangulation<dim, spacedim> &tria,
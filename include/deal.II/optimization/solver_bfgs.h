@@ -336,25 +336,40 @@ SolverBFGS<VectorType>::solve(
         deallog << "Iteration " << k << " history " << m << std::endl
                 << "f=" << f << std::endl;
 
-      // 1. Two loop recursion to calculate p = - H*g
+      // 1. Two loop recursion to calculate p = - H*g. Each update of p is
+      // fused with the scalar product needed by the next step via
+      // add_and_dot(), so that every history entry is only read once per
+      // loop
       c1.resize(m);
       p = g;
+      Number p_dot = (m > 0 ? s[0] * p : Number());
       // first loop:
       for (unsigned int i = 0; i < m; ++i)
         {
-          c1[i] = rho[i] * (s[i] * p);
-          p.add(-c1[i], y[i]);
+          c1[i] = rho[i] * p_dot;
+          if (i + 1 < m)
+            p_dot = p.add_and_dot(-c1[i], y[i], s[i + 1]);
+          else if (preconditioner_signal.empty())
+            p_dot = p.add_and_dot(-c1[i], y[i], y[i]);
+          else
+            p.add(-c1[i], y[i]);
         }
       // H0
       if (!preconditioner_signal.empty())
-        preconditioner_signal(p, s, y);
+        {
+          preconditioner_signal(p, s, y);
+          if (m > 0)
+            p_dot = y[m - 1] * p;
+        }
 
       // second loop:
       for (int i = m - 1; i >= 0; --i)
         {
-          Assert(i >= 0, ExcInternalError());
-          const Number c2 = rho[i] * (y[i] * p);
-          p.add(c1[i] - c2, s[i]);
+          const Number c2 = rho[i] * p_dot;
+          if (i > 0)
+            p_dot = p.add_and_dot(c1[i] - c2, s[i], y[i - 1]);
+          else
+            p.add(c1[i] - c2, s[i]);
         }
       p *= -1.;
 
@@ -87,6 +87,9 @@ namespace Particles
     using LevelInd = std::pair<int, int>;
   } // namespace internal
 
+  template <int, int>
+  class ParticleHandler;
+
   /**
    * Base class of particles - represents a particle with position,
    * an ID number and a variable number of properties. This class
@@ -235,7 +238,10 @@ namespace Particles
      * own properties). Usually this is only done once per particle, but
      * since the particle does not know about the properties,
      * we want to do it not at construction time. Another use for this
-     * function is after particle transfer to a new process.
+     * function is after particle transfer to a new process. If the particle
+     * already owns properties that were not allocated by a property pool,
+     * e.g. after de-serialization by load(), they are moved into the new
+     * pool.
      */
     void
     set_property_pool(PropertyPool &property_pool);
@@ -330,6 +336,13 @@ namespace Particles
      * A handle to all particle properties
      */
     PropertyPool::Handle properties;
+
+    /**
+     * The ParticleHandler updates the handles of its particles when it
+     * rearranges the memory of the property pool.
+     */
+    template <int, int>
+    friend class ParticleHandler;
   };
 
   /* ---------------------- inline and template functions ------------------ */
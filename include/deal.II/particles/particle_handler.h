@@ -27,6 +27,7 @@
 
 #include <deal.II/particles/particle.h>
 #include <deal.II/particles/particle_iterator.h>
+#include <deal.II/particles/particle_storage.h>
 #include <deal.II/particles/property_pool.h>
 
 #include <boost/range/iterator_range.hpp>
@@ -83,9 +84,10 @@ namespace Particles
       const unsigned int n_properties = 0);
 
     /**
-     * Destructor.
+     * Destructor. Releases all particles before the property pool that
+     * holds their properties.
      */
-    virtual ~ParticleHandler() override = default;
+    virtual ~ParticleHandler() override;
 
     /**
      * Initialize the particle handler. This function does not clear the
@@ -321,6 +323,39 @@ namespace Particles
       const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
       const;
 
+    /**
+     * Return a structure-of-arrays representation of all locally owned
+     * particles, sorted by the cell they are located in, see the
+     * ParticleStorage class. The representation is built on the first call
+     * after the particles have been modified, e.g. after insertion, removal,
+     * or a call to sort_particles_into_subdomains_and_cells(), and is reused
+     * by subsequent calls.
+     *
+     * The returned object reflects the state of the particles at the time of
+     * the call. Calling one of the functions of this class that give access
+     * to particles, like begin() or particles_in_cell(), marks the
+     * representation as outdated because the particles might be changed
+     * through the returned iterators. Changes made through iterators that
+     * were obtained before the call to this function are not seen by the
+     * returned object.
+     */
+    const ParticleStorage<dim, spacedim> &
+    get_particle_storage() const;
+
+    /**
+     * Set the locations of all locally owned particles to @p new_positions,
+     * which must be given in the order of the particles in
+     * get_particle_storage(). If @p displace_particles is set, the entries
+     * of @p new_positions are interpreted as displacements that are added to
+     * the current locations instead. The reference locations and the cells
+     * of the particles are not updated, which must be done by a call to
+     * sort_particles_into_subdomains_and_cells() once the particles have
+     * been moved.
+     */
+    void
+    set_particle_positions(const std::vector<Point<spacedim>> &new_positions,
+                           const bool displace_particles = true);
+
     /**
      * Find and update the cells containing each particle for all locally owned
      * particles. If particles moved out of the local subdomain
@@ -340,6 +375,26 @@ namespace Particles
     void
     exchange_ghost_particles();
 
+    /**
+     * Update the ghost particles created by the last call of
+     * exchange_ghost_particles() without rebuilding them. This function
+     * reuses the lists of particles that were sent to and received from the
+     * other processes, and only communicates the locations, reference
+     * locations, and properties of these particles, as well as the data of
+     * the functions registered by register_additional_store_load_functions().
+     * Since the size of these data is the same for every particle, no sizes
+     * need to be communicated.
+     *
+     * Reusing the lists is only correct if no locally owned particle has
+     * been inserted, removed, or moved to another cell since the last call
+     * of exchange_ghost_particles(). If this is not the case on any of the
+     * processes, e.g. because sort_particles_into_subdomains_and_cells()
+     * found particles that crossed cell boundaries, this function calls
+     * exchange_ghost_particles() instead.
+     */
+    void
+    update_ghost_particles();
+
     /**
      * Callback function that should be called before every refinement
      * and when writing checkpoints. This function is used to
@@ -390,6 +445,41 @@ namespace Particles
      */
     std::multimap<internal::LevelInd, Particle<dim, spacedim>> ghost_particles;
 
+    /**
+     * The structure-of-arrays representation of the locally owned particles
+     * returned by get_particle_storage().
+     */
+    mutable ParticleStorage<dim, spacedim> particle_storage;
+
+    /**
+     * Whether @p particle_storage represents the current state of the
+     * particles.
+     */
+    mutable bool particle_storage_is_current;
+
+    /**
+     * The locally owned particles that were sent to each of the other
+     * processes by the last call of exchange_ghost_particles().
+     */
+    std::map<types::subdomain_id, std::vector<particle_iterator>>
+      ghost_particles_sent;
+
+    /**
+     * The ghost particles that were received from each of the other
+     * processes by the last call of exchange_ghost_particles(), in the order
+     * in which they were sent.
+     */
+    std::map<types::subdomain_id, std::vector<particle_iterator>>
+      ghost_particles_received;
+
+    /**
+     * Whether @p ghost_particles_sent and @p ghost_particles_received still
+     * describe the ghost particles, i.e., whether no locally owned particle
+     * has been inserted, removed, or moved to another cell since the last
+     * call of exchange_ghost_particles().
+     */
+    bool ghost_particles_lists_are_current;
+
     /**
      * This variable stores how many particles are stored globally. It is
      * calculated by update_cached_numbers().
@@ -469,7 +559,11 @@ namespace Particles
      * Transfer particles that have crossed subdomain boundaries to other
      * processors.
      * All received particles and their new cells will be appended to the
-     * @p received_particles vector.
+     * @p received_particles vector. Only the processes that particles are
+     * sent to are contacted, and the processes that send particles to this
+     * process are determined by Utilities::MPI::ConsensusAlgorithm_NBX.
+     * Received particles are unpacked while the other messages are still
+     * in transit.
      *
      * @param [in] particles_to_send All particles that should be sent and
      * their new subdomain_ids are in this map.
@@ -485,6 +579,10 @@ namespace Particles
      * particle to be send in which the particle belongs. This parameter
      * is necessary if the cell information of the particle iterator is
      * outdated (e.g. after particle movement).
+     *
+     * @param [out] received_particles_by_domain Optional map in which the
+     * iterators to the received particles are stored for each sending
+     * process, in the order in which they were sent.
      */
     void
     send_recv_particles(
@@ -499,13 +597,31 @@ namespace Particles
         &new_cells_for_particles = std::map<
           types::subdomain_id,
           std::vector<
-            typename Triangulation<dim, spacedim>::active_cell_iterator>>());
+            typename Triangulation<dim, spacedim>::active_cell_iterator>>(),
+      std::map<types::subdomain_id, std::vector<particle_iterator>>
+        *received_particles_by_domain = nullptr);
 #  endif
 
+    /**
+     * Move the properties of all particles into one contiguous block of
+     * memory of the property pool, ordered by the cells the particles are
+     * located in, with the locally owned particles before the ghost
+     * particles. This makes the properties of the particles of each cell
+     * contiguous, so that they can be copied at once by store_particles().
+     */
+    void
+    sort_property_pool();
+
     /**
      * Called by listener functions from Triangulation for every cell
      * before a refinement step. All particles have to be attached to their
      * cell to be sent around to the new processes.
+     *
+     * The particles of a cell are written as the number of particles,
+     * followed by the arrays of their ids, locations, reference locations,
+     * and properties. Except for the ghost cells, the arrays are copied in
+     * blocks from the representation returned by get_particle_storage() and
+     * from the property pool.
      */
     std::vector<char>
     store_particles(
@@ -0,0 +1,165 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_particles_particle_storage_h
+#define dealii_particles_particle_storage_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/point.h>
+
+#include <deal.II/particles/particle.h>
+#include <deal.II/particles/property_pool.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Particles
+{
+  template <int, int>
+  class ParticleHandler;
+
+  /**
+   * A structure-of-arrays representation of the locally owned particles of a
+   * ParticleHandler. The particles are sorted by the cell they are located
+   * in, and the data of all particles, i.e., their locations, reference
+   * locations, ids, and handles into the PropertyPool, is stored in separate
+   * contiguous arrays. The particles of the cell with (local) number @p c
+   * occupy the index range given by particle_range(c). This layout allows to
+   * loop over the particles of a cell or over all particles without chasing
+   * pointers, and to update all particle locations with vectorized code,
+   * e.g. by adding a displacement computed from get_locations() and passing
+   * the result to ParticleHandler::set_particle_positions().
+   *
+   * Objects of this class are set up by ParticleHandler::get_particle_storage()
+   * and cannot be modified by the user.
+   */
+  template <int dim, int spacedim = dim>
+  class ParticleStorage
+  {
+  public:
+    /**
+     * Constructor. Creates an empty object.
+     */
+    ParticleStorage();
+
+    /**
+     * Reset all arrays to zero size.
+     */
+    void
+    clear();
+
+    /**
+     * Return the number of particles stored in this object.
+     */
+    std::size_t
+    n_particles() const;
+
+    /**
+     * Return the number of cells that contain at least one particle.
+     */
+    unsigned int
+    n_cells() const;
+
+    /**
+     * Return the level and index of the cell with local number @p c, which
+     * can be used to construct a cell iterator of the triangulation.
+     */
+    const internal::LevelInd &
+    get_cell(const unsigned int c) const;
+
+    /**
+     * Return the half-open range of particle indices into the arrays of
+     * this class that belong to the cell with local number @p c.
+     */
+    std::pair<unsigned int, unsigned int>
+    particle_range(const unsigned int c) const;
+
+    /**
+     * Return the locations of all particles.
+     */
+    ArrayView<const Point<spacedim>>
+    get_locations() const;
+
+    /**
+     * Return the locations of all particles in the coordinates of the
+     * reference cell of their surrounding cell.
+     */
+    ArrayView<const Point<dim>>
+    get_reference_locations() const;
+
+    /**
+     * Return the ids of all particles.
+     */
+    ArrayView<const types::particle_index>
+    get_ids() const;
+
+    /**
+     * Return the handles for the properties of all particles into the
+     * PropertyPool of the ParticleHandler. If the particles do not store
+     * properties, the entries equal PropertyPool::invalid_handle.
+     */
+    ArrayView<const PropertyPool::Handle>
+    get_property_handles() const;
+
+    /**
+     * Return an estimate for the memory consumption, in bytes, of this
+     * object.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * The level and index of the cells with particles.
+     */
+    std::vector<internal::LevelInd> cells;
+
+    /**
+     * The start of the particle range of each cell, with one additional
+     * entry holding the total number of particles.
+     */
+    std::vector<unsigned int> cell_offsets;
+
+    /**
+     * The particle locations.
+     */
+    std::vector<Point<spacedim>> locations;
+
+    /**
+     * The particle locations in the reference cell.
+     */
+    std::vector<Point<dim>> reference_locations;
+
+    /**
+     * The particle ids.
+     */
+    std::vector<types::particle_index> ids;
+
+    /**
+     * The handles to the particle properties.
+     */
+    std::vector<PropertyPool::Handle> property_handles;
+
+    template <int, int>
+    friend class ParticleHandler;
+  };
+} // namespace Particles
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
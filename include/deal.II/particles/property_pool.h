@@ -17,6 +17,10 @@
 #define dealii_particles_property_pool_h
 
 #include <deal.II/base/array_view.h>
+#include <deal.II/base/thread_management.h>
+
+#include <memory>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -28,8 +32,14 @@ namespace Particles
    * needs the same amount, it is more efficient to let this be handled by a
    * central manager that does not need to allocate/deallocate memory every
    * time a particle is constructed/destroyed.
-   * The current implementation uses simple new/delete allocation for every
-   * block. Additionally, the current implementation
+   * The current implementation hands out slots from a small number of large
+   * chunks of memory and keeps track of released slots in a free list, so
+   * that allocating and deallocating the properties of a particle does not
+   * involve the system allocator in the common case. The function
+   * sort_memory_slots() moves the properties of a given list of handles
+   * into one contiguous block of memory in the given order, which allows to
+   * copy the properties of many particles at once, e.g., for serialization.
+   * Additionally, the current implementation
    * assumes the same number of properties per particle, but of course the
    * PropertyType could contain a pointer to dynamically allocated memory
    * with varying sizes per particle (this memory would not be managed by this
@@ -37,6 +47,11 @@ namespace Particles
    * Because PropertyPool only returns handles it could be enhanced internally
    * (e.g. to allow for varying number of properties per handle) without
    * affecting its interface.
+   *
+   * All member functions that change the free list are guarded by a mutex,
+   * so handles can be allocated and deallocated concurrently from several
+   * threads, as was possible when every slot was obtained from the system
+   * allocator.
    */
   class PropertyPool
   {
@@ -61,7 +76,8 @@ namespace Particles
     /**
      * Return a new handle that allows accessing the reserved block
      * of memory. If the number of properties is zero this will return an
-     * invalid handle.
+     * invalid handle. The handle remains valid until it is passed to
+     * deallocate_properties_array() or sort_memory_slots().
      */
     Handle
     allocate_properties_array();
@@ -69,11 +85,28 @@ namespace Particles
     /**
      * Mark the properties corresponding to the handle @p handle as
      * deleted. Calling this function more than once for the same
-     * handle causes undefined behavior.
+     * handle causes undefined behavior. Calling it with the invalid handle
+     * does nothing.
      */
     void
     deallocate_properties_array(const Handle handle);
 
+    /**
+     * Move the properties of the slots given by @p handles into a newly
+     * allocated contiguous block of memory, in the order in which they
+     * appear in @p handles, and replace the entries of @p handles by the new
+     * handles. Entries that equal the invalid handle are left untouched. The
+     * old handles are released, and chunks of memory that do not contain any
+     * allocated slot any more are returned to the system. Handles that are
+     * not part of @p handles remain valid.
+     *
+     * Calling this function with the handles of all particles in the order
+     * of the cells they are located in makes the properties of the particles
+     * of each cell contiguous in memory.
+     */
+    void
+    sort_memory_slots(std::vector<Handle> &handles);
+
     /**
      * Return an ArrayView to the properties that correspond to the given
      * handle @p handle.
@@ -94,11 +127,63 @@ namespace Particles
     unsigned int
     n_properties_per_slot() const;
 
+    /**
+     * Return the number of slots that are currently allocated.
+     */
+    std::size_t
+    n_allocated_slots() const;
+
+    /**
+     * Return an estimate for the memory consumption, in bytes, of this
+     * object.
+     */
+    std::size_t
+    memory_consumption() const;
+
   private:
+    /**
+     * Allocate a new chunk of memory with space for @p n_slots slots and add
+     * its slots to the free list.
+     */
+    void
+    add_chunk(const std::size_t n_slots);
+
+    /**
+     * Return the chunks in which all slots are free to the system, and
+     * remove their slots from the free list.
+     */
+    void
+    release_unused_chunks();
+
     /**
      * The number of properties that are reserved per particle.
      */
     const unsigned int n_properties;
+
+    /**
+     * The chunks of memory the slots are handed out from.
+     */
+    std::vector<std::unique_ptr<double[]>> chunks;
+
+    /**
+     * The number of slots in each of the chunks.
+     */
+    std::vector<std::size_t> chunk_n_slots;
+
+    /**
+     * The slots that are currently not in use.
+     */
+    std::vector<Handle> free_slots;
+
+    /**
+     * The total number of slots in all chunks.
+     */
+    std::size_t n_slots;
+
+    /**
+     * A mutex guarding the chunks and the free list.
+     */
+    mutable Threads::Mutex mutex;
   };
 
 
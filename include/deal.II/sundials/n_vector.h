@@ -0,0 +1,202 @@
+//-----------------------------------------------------------
+//
+//    Copyright (C) 2019 by the deal.II authors
+//
+//    This file is part of the deal.II library.
+//
+//    The deal.II library is free software; you can use it, redistribute
+//    it, and/or modify it under the terms of the GNU Lesser General
+//    Public License as published by the Free Software Foundation; either
+//    version 2.1 of the License, or (at your option) any later version.
+//    The full text of the license can be found in the file LICENSE.md at
+//    the top level directory of deal.II.
+//
+//-----------------------------------------------------------
+
+#ifndef dealii_sundials_n_vector_h
+#define dealii_sundials_n_vector_h
+
+#include <deal.II/base/config.h>
+
+#ifdef DEAL_II_WITH_SUNDIALS
+
+#  include <deal.II/base/mpi.h>
+
+#  include <deal.II/lac/block_vector.h>
+#  include <deal.II/lac/la_parallel_block_vector.h>
+#  include <deal.II/lac/la_parallel_vector.h>
+#  include <deal.II/lac/vector.h>
+#  include <deal.II/lac/vector_memory.h>
+
+#  include <sundials/sundials_nvector.h>
+
+#  include <functional>
+#  include <type_traits>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace SUNDIALS
+{
+  namespace internal
+  {
+    /**
+     * A type trait that is true if the SUNDIALS wrappers can operate on a
+     * vector of type @p VectorType in place, i.e., if an N_Vector can be
+     * created that merely refers to the deal.II vector and implements all
+     * the N_Vector operations in terms of the deal.II vector interface. For
+     * all other vector types the wrappers fall back to copying between the
+     * deal.II vector and a native serial or parallel N_Vector.
+     */
+    template <typename VectorType>
+    struct IsNVectorViewSupported : std::false_type
+    {};
+
+    template <>
+    struct IsNVectorViewSupported<Vector<double>> : std::true_type
+    {};
+
+    template <>
+    struct IsNVectorViewSupported<BlockVector<double>> : std::true_type
+    {};
+
+    template <>
+    struct IsNVectorViewSupported<LinearAlgebra::distributed::Vector<double>>
+      : std::true_type
+    {};
+
+    template <>
+    struct IsNVectorViewSupported<
+      LinearAlgebra::distributed::BlockVector<double>> : std::true_type
+    {};
+
+
+
+    /**
+     * Create an N_Vector that refers to @p vector without copying its
+     * elements. The N_Vector does not own @p vector, which therefore has to
+     * outlive it. Vectors that SUNDIALS clones from the returned N_Vector
+     * own their own deal.II vector, which is released by N_VDestroy().
+     *
+     * This function is only available for vector types for which
+     * IsNVectorViewSupported is true.
+     */
+    template <typename VectorType>
+    N_Vector
+    make_nvector_view(VectorType &vector);
+
+    /**
+     * Return whether @p v was created by make_nvector_view() for the vector
+     * type @p VectorType, or was cloned from such an N_Vector.
+     */
+    template <typename VectorType>
+    bool
+    is_nvector_view(const N_Vector v);
+
+    /**
+     * Return the deal.II vector an N_Vector created by make_nvector_view()
+     * refers to.
+     */
+    template <typename VectorType>
+    VectorType *
+    unwrap_nvector(N_Vector v);
+
+    /**
+     * Create an N_Vector with the same layout as @p layout and copy the
+     * elements of @p layout into it. For vector types that support views,
+     * the result owns a deal.II vector and is handed to SUNDIALS directly,
+     * so that all vectors SUNDIALS clones from it are deal.II vectors as
+     * well. Otherwise, a native serial or parallel N_Vector is created on
+     * @p communicator. In either case, the result has to be released with
+     * N_VDestroy().
+     */
+    template <typename VectorType>
+    N_Vector
+    create_nvector(const VectorType &layout, const MPI_Comm &communicator);
+
+    /**
+     * Copy the elements of @p src into @p dst, which must have been created
+     * by create_nvector().
+     */
+    template <typename VectorType>
+    void
+    copy_to_nvector(N_Vector dst, const VectorType &src);
+
+    /**
+     * Copy the elements of @p src, which must have been created by
+     * create_nvector(), into @p dst.
+     */
+    template <typename VectorType>
+    void
+    copy_from_nvector(VectorType &dst, const N_Vector src);
+
+
+
+    /**
+     * Give access to an N_Vector handed to one of the SUNDIALS callbacks as
+     * a deal.II vector. If the N_Vector is a view of a deal.II vector, that
+     * vector is used in place, and set to zero unless @p copy_in is set.
+     * Otherwise, a temporary vector is created with @p reinit_vector, the
+     * elements of the N_Vector are copied into it if @p copy_in is set, and
+     * copied back when this object goes out of scope if @p copy_out is set.
+     */
+    template <typename VectorType>
+    class NVectorAccess
+    {
+    public:
+      /**
+       * Constructor.
+       */
+      NVectorAccess(N_Vector                                 v,
+                    const std::function<void(VectorType &)> &reinit_vector,
+                    const bool                               copy_in,
+                    const bool                               copy_out);
+
+      /**
+       * Destructor. Copies the temporary vector back into the N_Vector if
+       * requested.
+       */
+      ~NVectorAccess();
+
+      NVectorAccess(const NVectorAccess &) = delete;
+
+      NVectorAccess &
+      operator=(const NVectorAccess &) = delete;
+
+      /**
+       * Access the deal.II vector.
+       */
+      VectorType &operator*();
+
+    private:
+      /**
+       * The N_Vector this object gives access to.
+       */
+      N_Vector nvector;
+
+      /**
+       * Whether the temporary vector is copied back into the N_Vector.
+       */
+      const bool copy_out;
+
+      /**
+       * Memory pool for the temporary vector.
+       */
+      GrowingVectorMemory<VectorType> memory;
+
+      /**
+       * The temporary vector. Empty if the N_Vector is accessed in place.
+       */
+      typename VectorMemory<VectorType>::Pointer temporary;
+
+      /**
+       * The deal.II vector that is accessed.
+       */
+      VectorType *vector;
+    };
+  } // namespace internal
+} // namespace SUNDIALS
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // DEAL_II_WITH_SUNDIALS
+#endif // dealii_sundials_n_vector_h
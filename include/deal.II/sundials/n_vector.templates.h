@@ -0,0 +1,794 @@
+//-----------------------------------------------------------
+//
+//    Copyright (C) 2019 by the deal.II authors
+//
+//    This file is part of the deal.II library.
+//
+//    The deal.II library is free software; you can use it, redistribute
+//    it, and/or modify it under the terms of the GNU Lesser General
+//    Public License as published by the Free Software Foundation; either
+//    version 2.1 of the License, or (at your option) any later version.
+//    The full text of the license can be found in the file LICENSE.md at
+//    the top level directory of deal.II.
+//
+//-----------------------------------------------------------
+
+#ifndef dealii_sundials_n_vector_templates_h
+#define dealii_sundials_n_vector_templates_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/sundials/n_vector.h>
+
+#ifdef DEAL_II_WITH_SUNDIALS
+
+#  include <deal.II/base/array_view.h>
+#  include <deal.II/base/mpi.h>
+#  include <deal.II/base/std_cxx14/memory.h>
+
+#  include <deal.II/lac/vector_type_traits.h>
+
+#  include <deal.II/sundials/copy.h>
+
+#  include <algorithm>
+#  include <cmath>
+#  include <limits>
+#  include <memory>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace SUNDIALS
+{
+  namespace internal
+  {
+    namespace NVectorOperations
+    {
+#  if DEAL_II_SUNDIALS_VERSION_LT(3, 0, 0)
+      using index_type = long int;
+#  else
+      using index_type = sunindextype;
+#  endif
+
+      inline booleantype
+      to_booleantype(const bool value)
+      {
+#  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
+        return value ? SUNTRUE : SUNFALSE;
+#  else
+        return value ? TRUE : FALSE;
+#  endif
+      }
+
+
+
+      /**
+       * The locally owned elements of the supported vector types, split
+       * into contiguous blocks.
+       */
+      inline unsigned int
+      n_local_blocks(const Vector<double> &)
+      {
+        return 1;
+      }
+
+      inline unsigned int
+      n_local_blocks(const LinearAlgebra::distributed::Vector<double> &)
+      {
+        return 1;
+      }
+
+      template <typename VectorType>
+      unsigned int
+      n_local_blocks(const BlockVectorBase<VectorType> &v)
+      {
+        return v.n_blocks();
+      }
+
+      inline ArrayView<double>
+      local_block(Vector<double> &v, const unsigned int)
+      {
+        return ArrayView<double>(v.begin(), v.size());
+      }
+
+      inline ArrayView<const double>
+      local_block(const Vector<double> &v, const unsigned int)
+      {
+        return ArrayView<const double>(v.begin(), v.size());
+      }
+
+      inline ArrayView<double>
+      local_block(LinearAlgebra::distributed::Vector<double> &v,
+                  const unsigned int)
+      {
+        return ArrayView<double>(v.begin(), v.local_size());
+      }
+
+      inline ArrayView<const double>
+      local_block(const LinearAlgebra::distributed::Vector<double> &v,
+                  const unsigned int)
+      {
+        return ArrayView<const double>(v.begin(), v.local_size());
+      }
+
+      template <typename VectorType>
+      ArrayView<double>
+      local_block(BlockVectorBase<VectorType> &v, const unsigned int b)
+      {
+        return local_block(v.block(b), 0);
+      }
+
+      template <typename VectorType>
+      ArrayView<const double>
+      local_block(const BlockVectorBase<VectorType> &v, const unsigned int b)
+      {
+        return local_block(v.block(b), 0);
+      }
+
+      inline MPI_Comm
+      get_communicator(const Vector<double> &)
+      {
+        return MPI_COMM_SELF;
+      }
+
+      inline MPI_Comm
+      get_communicator(const BlockVector<double> &)
+      {
+        return MPI_COMM_SELF;
+      }
+
+      inline MPI_Comm
+      get_communicator(const LinearAlgebra::distributed::Vector<double> &v)
+      {
+        return v.get_mpi_communicator();
+      }
+
+      inline MPI_Comm
+      get_communicator(
+        const LinearAlgebra::distributed::BlockVector<double> &v)
+      {
+        return v.n_blocks() > 0 ? v.block(0).get_mpi_communicator() :
+                                  MPI_COMM_SELF;
+      }
+
+
+
+      /**
+       * The content of an N_Vector that refers to a deal.II vector. Vectors
+       * created by clone() own their deal.II vector, views of user vectors
+       * do not.
+       */
+      template <typename VectorType>
+      struct Content
+      {
+        VectorType *                vector = nullptr;
+        std::unique_ptr<VectorType> owned_vector;
+      };
+
+      template <typename VectorType>
+      VectorType &
+      get(N_Vector v)
+      {
+        Assert(v->content != nullptr, ExcInternalError());
+        auto *content = static_cast<Content<VectorType> *>(v->content);
+        Assert(content->vector != nullptr, ExcInternalError());
+        return *content->vector;
+      }
+
+
+
+      template <typename VectorType>
+      N_Vector
+      allocate(Content<VectorType> *content);
+
+      template <typename VectorType>
+      N_Vector
+      clone_empty(N_Vector)
+      {
+        return allocate(new Content<VectorType>());
+      }
+
+      template <typename VectorType>
+      N_Vector
+      clone(N_Vector w)
+      {
+        auto *content         = new Content<VectorType>();
+        content->owned_vector = std_cxx14::make_unique<VectorType>();
+        content->owned_vector->reinit(get<VectorType>(w), false);
+        content->vector = content->owned_vector.get();
+        return allocate(content);
+      }
+
+      template <typename VectorType>
+      void
+      destroy(N_Vector v)
+      {
+        if (v == nullptr)
+          return;
+        delete static_cast<Content<VectorType> *>(v->content);
+        delete v->ops;
+        delete v;
+      }
+
+#  if DEAL_II_SUNDIALS_VERSION_GTE(2, 7, 0)
+      inline N_Vector_ID
+      get_vector_id(N_Vector)
+      {
+        return SUNDIALS_NVEC_CUSTOM;
+      }
+#  endif
+
+      template <typename VectorType>
+      void
+      space(N_Vector v, index_type *lrw, index_type *liw)
+      {
+        *lrw = get<VectorType>(v).size();
+        *liw = 1;
+      }
+
+      template <typename VectorType>
+      void
+      linear_sum(realtype a, N_Vector x, realtype b, N_Vector y, N_Vector z)
+      {
+        const VectorType &src_x = get<VectorType>(x);
+        const VectorType &src_y = get<VectorType>(y);
+        VectorType &      dst   = get<VectorType>(z);
+
+        if (&dst == &src_x)
+          dst.sadd(a, b, src_y);
+        else if (&dst == &src_y)
+          dst.sadd(b, a, src_x);
+        else
+          {
+            dst.equ(a, src_x);
+            dst.add(b, src_y);
+          }
+      }
+
+      template <typename VectorType>
+      void
+      set_constant(realtype c, N_Vector z)
+      {
+        get<VectorType>(z) = c;
+      }
+
+      template <typename VectorType>
+      void
+      scale(realtype c, N_Vector x, N_Vector z)
+      {
+        const VectorType &src = get<VectorType>(x);
+        VectorType &      dst = get<VectorType>(z);
+
+        if (&dst == &src)
+          dst *= c;
+        else
+          dst.equ(c, src);
+      }
+
+      template <typename VectorType>
+      void
+      add_constant(N_Vector x, realtype b, N_Vector z)
+      {
+        const VectorType &src = get<VectorType>(x);
+        VectorType &      dst = get<VectorType>(z);
+
+        if (&dst != &src)
+          dst = src;
+        dst.add(b);
+      }
+
+      /**
+       * Set z_i = op(x_i) for all locally owned elements.
+       */
+      template <typename VectorType, typename Operation>
+      void
+      unary_operation(N_Vector x, N_Vector z, const Operation &op)
+      {
+        const VectorType &src = get<VectorType>(x);
+        VectorType &      dst = get<VectorType>(z);
+
+        for (unsigned int b = 0; b < n_local_blocks(dst); ++b)
+          {
+            const ArrayView<const double> s = local_block(src, b);
+            const ArrayView<double>       d = local_block(dst, b);
+            for (std::size_t i = 0; i < d.size(); ++i)
+              d[i] = op(s[i]);
+          }
+      }
+
+      /**
+       * Set z_i = op(x_i, y_i) for all locally owned elements.
+       */
+      template <typename VectorType, typename Operation>
+      void
+      binary_operation(N_Vector x, N_Vector y, N_Vector z, const Operation &op)
+      {
+        const VectorType &src_x = get<VectorType>(x);
+        const VectorType &src_y = get<VectorType>(y);
+        VectorType &      dst   = get<VectorType>(z);
+
+        for (unsigned int b = 0; b < n_local_blocks(dst); ++b)
+          {
+            const ArrayView<const double> s_x = local_block(src_x, b);
+            const ArrayView<const double> s_y = local_block(src_y, b);
+            const ArrayView<double>       d   = local_block(dst, b);
+            for (std::size_t i = 0; i < d.size(); ++i)
+              d[i] = op(s_x[i], s_y[i]);
+          }
+      }
+
+      template <typename VectorType>
+      void
+      elementwise_product(N_Vector x, N_Vector y, N_Vector z)
+      {
+        binary_operation<VectorType>(
+          x, y, z, [](const double a, const double b) { return a * b; });
+      }
+
+      template <typename VectorType>
+      void
+      elementwise_division(N_Vector x, N_Vector y, N_Vector z)
+      {
+        binary_operation<VectorType>(
+          x, y, z, [](const double a, const double b) { return a / b; });
+      }
+
+      template <typename VectorType>
+      void
+      elementwise_abs(N_Vector x, N_Vector z)
+      {
+        unary_operation<VectorType>(x, z, [](const double a) {
+          return std::abs(a);
+        });
+      }
+
+      template <typename VectorType>
+      void
+      elementwise_inverse(N_Vector x, N_Vector z)
+      {
+        unary_operation<VectorType>(x, z, [](const double a) {
+          return 1. / a;
+        });
+      }
+
+      template <typename VectorType>
+      void
+      compare(realtype c, N_Vector x, N_Vector z)
+      {
+        unary_operation<VectorType>(x, z, [c](const double a) {
+          return std::abs(a) >= c ? 1. : 0.;
+        });
+      }
+
+      template <typename VectorType>
+      realtype
+      dot_product(N_Vector x, N_Vector y)
+      {
+        return get<VectorType>(x) * get<VectorType>(y);
+      }
+
+      template <typename VectorType>
+      realtype
+      max_norm(N_Vector x)
+      {
+        return get<VectorType>(x).linfty_norm();
+      }
+
+      template <typename VectorType>
+      realtype
+      l1_norm(N_Vector x)
+      {
+        return get<VectorType>(x).l1_norm();
+      }
+
+      /**
+       * Return the global sum of (x_i w_i)^2 over all elements for which
+       * the mask, if given, is positive.
+       */
+      template <typename VectorType>
+      double
+      weighted_sum_of_squares(N_Vector x, N_Vector w, N_Vector id)
+      {
+        const VectorType &src_x = get<VectorType>(x);
+        const VectorType &src_w = get<VectorType>(w);
+
+        double sum = 0.;
+        for (unsigned int b = 0; b < n_local_blocks(src_x); ++b)
+          {
+            const ArrayView<const double> s_x = local_block(src_x, b);
+            const ArrayView<const double> s_w = local_block(src_w, b);
+            if (id == nullptr)
+              for (std::size_t i = 0; i < s_x.size(); ++i)
+                sum += (s_x[i] * s_w[i]) * (s_x[i] * s_w[i]);
+            else
+              {
+                const ArrayView<const double> s_id =
+                  local_block(get<VectorType>(id), b);
+                for (std::size_t i = 0; i < s_x.size(); ++i)
+                  if (s_id[i] > 0.)
+                    sum += (s_x[i] * s_w[i]) * (s_x[i] * s_w[i]);
+              }
+          }
+        return Utilities::MPI::sum(sum, get_communicator(src_x));
+      }
+
+      template <typename VectorType>
+      realtype
+      weighted_rms_norm(N_Vector x, N_Vector w)
+      {
+        return std::sqrt(weighted_sum_of_squares<VectorType>(x, w, nullptr) /
+                         get<VectorType>(x).size());
+      }
+
+      template <typename VectorType>
+      realtype
+      weighted_rms_norm_mask(N_Vector x, N_Vector w, N_Vector id)
+      {
+        return std::sqrt(weighted_sum_of_squares<VectorType>(x, w, id) /
+                         get<VectorType>(x).size());
+      }
+
+      template <typename VectorType>
+      realtype
+      weighted_l2_norm(N_Vector x, N_Vector w)
+      {
+        return std::sqrt(weighted_sum_of_squares<VectorType>(x, w, nullptr));
+      }
+
+      template <typename VectorType>
+      realtype
+      min_element(N_Vector x)
+      {
+        const VectorType &src = get<VectorType>(x);
+
+        double result = std::numeric_limits<double>::max();
+        for (unsigned int b = 0; b < n_local_blocks(src); ++b)
+          {
+            const ArrayView<const double> s = local_block(src, b);
+            for (std::size_t i = 0; i < s.size(); ++i)
+              result = std::min(result, s[i]);
+          }
+        return Utilities::MPI::min(result, get_communicator(src));
+      }
+
+      template <typename VectorType>
+      booleantype
+      inverse_test(N_Vector x, N_Vector z)
+      {
+        const VectorType &src = get<VectorType>(x);
+        VectorType &      dst = get<VectorType>(z);
+
+        double all_nonzero = 1.;
+        for (unsigned int b = 0; b < n_local_blocks(dst); ++b)
+          {
+            const ArrayView<const double> s = local_block(src, b);
+            const ArrayView<double>       d = local_block(dst, b);
+            for (std::size_t i = 0; i < d.size(); ++i)
+              if (s[i] == 0.)
+                all_nonzero = 0.;
+              else
+                d[i] = 1. / s[i];
+          }
+        return to_booleantype(
+          Utilities::MPI::min(all_nonzero, get_communicator(src)) > 0.);
+      }
+
+      template <typename VectorType>
+      booleantype
+      constraint_mask(N_Vector c, N_Vector x, N_Vector m)
+      {
+        const VectorType &src_c = get<VectorType>(c);
+        const VectorType &src_x = get<VectorType>(x);
+        VectorType &      dst   = get<VectorType>(m);
+
+        // a constraint of +-2 requires x_i to be strictly positive or
+        // negative, one of +-1 requires it to be non-negative or
+        // non-positive, and 0 means x_i is unconstrained
+        double all_satisfied = 1.;
+        for (unsigned int b = 0; b < n_local_blocks(dst); ++b)
+          {
+            const ArrayView<const double> s_c = local_block(src_c, b);
+            const ArrayView<const double> s_x = local_block(src_x, b);
+            const ArrayView<double>       d   = local_block(dst, b);
+            for (std::size_t i = 0; i < d.size(); ++i)
+              {
+                const double product = s_x[i] * s_c[i];
+                const bool   violated =
+                  (std::abs(s_c[i]) > 1.5 && product <= 0.) ||
+                  (std::abs(s_c[i]) > 0.5 && product < 0.);
+                d[i] = violated ? 1. : 0.;
+                if (violated)
+                  all_satisfied = 0.;
+              }
+          }
+        return to_booleantype(
+          Utilities::MPI::min(all_satisfied, get_communicator(src_c)) > 0.);
+      }
+
+      template <typename VectorType>
+      realtype
+      min_quotient(N_Vector num, N_Vector denom)
+      {
+        const VectorType &src_num   = get<VectorType>(num);
+        const VectorType &src_denom = get<VectorType>(denom);
+
+        double result = std::numeric_limits<double>::max();
+        for (unsigned int b = 0; b < n_local_blocks(src_num); ++b)
+          {
+            const ArrayView<const double> s_num   = local_block(src_num, b);
+            const ArrayView<const double> s_denom = local_block(src_denom, b);
+            for (std::size_t i = 0; i < s_num.size(); ++i)
+              if (s_denom[i] != 0.)
+                result = std::min(result, s_num[i] / s_denom[i]);
+          }
+        return Utilities::MPI::min(result, get_communicator(src_num));
+      }
+
+
+
+      template <typename VectorType>
+      N_Vector
+      allocate(Content<VectorType> *content)
+      {
+        N_Vector v = new _generic_N_Vector;
+        v->content = content;
+        v->ops     = new _generic_N_Vector_Ops();
+
+#  if DEAL_II_SUNDIALS_VERSION_GTE(2, 7, 0)
+        v->ops->nvgetvectorid = get_vector_id;
+#  endif
+        v->ops->nvclone           = clone<VectorType>;
+        v->ops->nvcloneempty      = clone_empty<VectorType>;
+        v->ops->nvdestroy         = destroy<VectorType>;
+        v->ops->nvspace           = space<VectorType>;
+        v->ops->nvgetarraypointer = nullptr;
+        v->ops->nvsetarraypointer = nullptr;
+        v->ops->nvlinearsum       = linear_sum<VectorType>;
+        v->ops->nvconst           = set_constant<VectorType>;
+        v->ops->nvprod            = elementwise_product<VectorType>;
+        v->ops->nvdiv             = elementwise_division<VectorType>;
+        v->ops->nvscale           = scale<VectorType>;
+        v->ops->nvabs             = elementwise_abs<VectorType>;
+        v->ops->nvinv             = elementwise_inverse<VectorType>;
+        v->ops->nvaddconst        = add_constant<VectorType>;
+        v->ops->nvdotprod         = dot_product<VectorType>;
+        v->ops->nvmaxnorm         = max_norm<VectorType>;
+        v->ops->nvwrmsnorm        = weighted_rms_norm<VectorType>;
+        v->ops->nvwrmsnormmask    = weighted_rms_norm_mask<VectorType>;
+        v->ops->nvmin             = min_element<VectorType>;
+        v->ops->nvwl2norm         = weighted_l2_norm<VectorType>;
+        v->ops->nvl1norm          = l1_norm<VectorType>;
+        v->ops->nvcompare         = compare<VectorType>;
+        v->ops->nvinvtest         = inverse_test<VectorType>;
+        v->ops->nvconstrmask      = constraint_mask<VectorType>;
+        v->ops->nvminquotient     = min_quotient<VectorType>;
+
+        return v;
+      }
+
+
+
+      /**
+       * Copy between a supported deal.II vector and a native serial or
+       * parallel N_Vector, whose local elements are stored contiguously in
+       * the same order as the locally owned blocks of the deal.II vector.
+       */
+      template <typename VectorType>
+      void
+      copy_local(N_Vector dst, const VectorType &src)
+      {
+        realtype *data = N_VGetArrayPointer(dst);
+        for (unsigned int b = 0; b < n_local_blocks(src); ++b)
+          {
+            const ArrayView<const double> s = local_block(src, b);
+            data = std::copy(s.begin(), s.end(), data);
+          }
+      }
+
+      template <typename VectorType>
+      void
+      copy_local(VectorType &dst, const N_Vector src)
+      {
+        const realtype *data = N_VGetArrayPointer(src);
+        for (unsigned int b = 0; b < n_local_blocks(dst); ++b)
+          {
+            const ArrayView<double> d = local_block(dst, b);
+            std::copy(data, data + d.size(), d.begin());
+            data += d.size();
+          }
+      }
+
+
+
+      template <typename VectorType>
+      N_Vector
+      create_nvector(const VectorType &layout,
+                     const MPI_Comm &,
+                     std::true_type)
+      {
+        auto *content         = new Content<VectorType>();
+        content->owned_vector = std_cxx14::make_unique<VectorType>(layout);
+        content->vector       = content->owned_vector.get();
+        return allocate(content);
+      }
+
+      template <typename VectorType>
+      N_Vector
+      create_nvector(const VectorType &layout,
+                     const MPI_Comm &  communicator,
+                     std::false_type)
+      {
+        N_Vector v = nullptr;
+#  ifdef DEAL_II_WITH_MPI
+        if (is_serial_vector<VectorType>::value == false)
+          {
+            const IndexSet    is = layout.locally_owned_elements();
+            const std::size_t local_system_size = is.n_elements();
+
+            v = N_VNew_Parallel(communicator, local_system_size, layout.size());
+          }
+        else
+#  endif
+          {
+            (void)communicator;
+            Assert(is_serial_vector<VectorType>::value,
+                   ExcInternalError(
+                     "Trying to use a serial code with a parallel vector."));
+            v = N_VNew_Serial(layout.size());
+          }
+        copy(v, layout);
+        return v;
+      }
+
+      template <typename VectorType>
+      void
+      copy_to_nvector(N_Vector dst, const VectorType &src, std::true_type)
+      {
+        if (is_nvector_view<VectorType>(dst))
+          get<VectorType>(dst) = src;
+        else
+          copy_local(dst, src);
+      }
+
+      template <typename VectorType>
+      void
+      copy_to_nvector(N_Vector dst, const VectorType &src, std::false_type)
+      {
+        copy(dst, src);
+      }
+
+      template <typename VectorType>
+      void
+      copy_from_nvector(VectorType &dst, const N_Vector src, std::true_type)
+      {
+        if (is_nvector_view<VectorType>(src))
+          dst = get<VectorType>(src);
+        else
+          copy_local(dst, src);
+      }
+
+      template <typename VectorType>
+      void
+      copy_from_nvector(VectorType &dst, const N_Vector src, std::false_type)
+      {
+        copy(dst, src);
+      }
+    } // namespace NVectorOperations
+
+
+
+    template <typename VectorType>
+    N_Vector
+    make_nvector_view(VectorType &vector)
+    {
+      static_assert(IsNVectorViewSupported<VectorType>::value,
+                    "This vector type can not be wrapped by an N_Vector.");
+      auto *content   = new NVectorOperations::Content<VectorType>();
+      content->vector = &vector;
+      return NVectorOperations::allocate(content);
+    }
+
+
+
+    template <typename VectorType>
+    bool
+    is_nvector_view(const N_Vector v)
+    {
+      return v != nullptr && v->ops != nullptr &&
+             v->ops->nvdestroy == &NVectorOperations::destroy<VectorType>;
+    }
+
+
+
+    template <typename VectorType>
+    VectorType *
+    unwrap_nvector(N_Vector v)
+    {
+      Assert(is_nvector_view<VectorType>(v), ExcInternalError());
+      return &NVectorOperations::get<VectorType>(v);
+    }
+
+
+
+    template <typename VectorType>
+    N_Vector
+    create_nvector(const VectorType &layout, const MPI_Comm &communicator)
+    {
+      return NVectorOperations::create_nvector(
+        layout, communicator, IsNVectorViewSupported<VectorType>());
+    }
+
+
+
+    template <typename VectorType>
+    void
+    copy_to_nvector(N_Vector dst, const VectorType &src)
+    {
+      NVectorOperations::copy_to_nvector(dst,
+                                         src,
+                                         IsNVectorViewSupported<VectorType>());
+    }
+
+
+
+    template <typename VectorType>
+    void
+    copy_from_nvector(VectorType &dst, const N_Vector src)
+    {
+      NVectorOperations::copy_from_nvector(
+        dst, src, IsNVectorViewSupported<VectorType>());
+    }
+
+
+
+    template <typename VectorType>
+    NVectorAccess<VectorType>::NVectorAccess(
+      N_Vector                                 v,
+      const std::function<void(VectorType &)> &reinit_vector,
+      const bool                               copy_in,
+      const bool                               copy_out)
+      : nvector(v)
+      , copy_out(copy_out)
+      , vector(nullptr)
+    {
+      if (IsNVectorViewSupported<VectorType>::value &&
+          is_nvector_view<VectorType>(v))
+        {
+          vector = &NVectorOperations::get<VectorType>(v);
+          // callbacks may rely on their output vectors being zero, as they
+          // would be after reinit_vector()
+          if (!copy_in)
+            *vector = 0.;
+        }
+      else
+        {
+          temporary = typename VectorMemory<VectorType>::Pointer(memory);
+          reinit_vector(*temporary);
+          if (copy_in)
+            copy_from_nvector(*temporary, v);
+          vector = temporary.get();
+        }
+    }
+
+
+
+    template <typename VectorType>
+    NVectorAccess<VectorType>::~NVectorAccess()
+    {
+      if (temporary && copy_out)
+        copy_to_nvector(nvector, *temporary);
+    }
+
+
+
+    template <typename VectorType>
+    VectorType &NVectorAccess<VectorType>::operator*()
+    {
+      return *vector;
+    }
+  } // namespace internal
+} // namespace SUNDIALS
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // DEAL_II_WITH_SUNDIALS
+#endif // dealii_sundials_n_vector_templates_h
@@ -34,8 +34,10 @@
 #include <deal.II/base/data_out_base.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/base/thread_management.h>
+#include <deal.II/base/tracing.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/numerics/data_component_interpretation.h>
@@ -46,6 +48,7 @@
 #include <ctime>
 #include <fstream>
 #include <iomanip>
+#include <limits>
 #include <memory>
 #include <set>
 #include <sstream>
@@ -253,6 +256,10 @@ namespace
   /**
    * Do a zlib compression followed by a base64 encoding of the given data. The
    * result is then written to the given stream.
+   *
+   * The data is split into blocks of fixed size that are compressed
+   * independently, and in parallel, as supported by the compression header
+   * of the VTK file format.
    */
   template <typename T>
   void
@@ -262,37 +269,70 @@ namespace
   {
     if (data.size() != 0)
       {
-        // allocate a buffer for compressing data and do so
-        uLongf compressed_data_length = compressBound(data.size() * sizeof(T));
-        char * compressed_data        = new char[compressed_data_length];
-        int    err =
-          compress2(reinterpret_cast<Bytef *>(compressed_data),
-                    &compressed_data_length,
-                    reinterpret_cast<const Bytef *>(data.data()),
-                    data.size() * sizeof(T),
-                    get_zlib_compression_level(flags.compression_level));
-        (void)err;
-        Assert(err == Z_OK, ExcInternalError());
-
-        // now encode the compression header
-        const uint32_t compression_header[4] = {
-          1,                                              /* number of blocks */
-          static_cast<uint32_t>(data.size() * sizeof(T)), /* size of block */
-          static_cast<uint32_t>(data.size() *
-                                sizeof(T)), /* size of last block */
-          static_cast<uint32_t>(
-            compressed_data_length)}; /* list of compressed sizes of blocks */
+        const std::size_t  data_size  = data.size() * sizeof(T);
+        const std::size_t  block_size = 1 << 16;
+        const unsigned int n_blocks = (data_size + block_size - 1) / block_size;
+        const int          compression_level =
+          get_zlib_compression_level(flags.compression_level);
+
+        // compress the blocks in parallel, each into its own buffer
+        std::vector<std::vector<char>> compressed_blocks(n_blocks);
+        parallel::apply_to_subranges(
+          0U,
+          n_blocks,
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int b = begin; b < end; ++b)
+              {
+                const std::size_t offset = b * block_size;
+                const uLong       length =
+                  std::min(block_size, data_size - offset);
+                uLongf compressed_length = compressBound(length);
+                compressed_blocks[b].resize(compressed_length);
+                const int err =
+                  compress2(reinterpret_cast<Bytef *>(
+                              compressed_blocks[b].data()),
+                            &compressed_length,
+                            reinterpret_cast<const Bytef *>(data.data()) +
+                              offset,
+                            length,
+                            compression_level);
+                (void)err;
+                Assert(err == Z_OK, ExcInternalError());
+                compressed_blocks[b].resize(compressed_length);
+              }
+          },
+          1);
+
+        // now encode the compression header, consisting of the number of
+        // blocks, the size of a block, the size of the last block, and the
+        // list of compressed sizes of blocks
+        std::vector<uint32_t> compression_header(3 + n_blocks);
+        compression_header[0] = n_blocks;
+        compression_header[1] = std::min(block_size, data_size);
+        compression_header[2] = data_size - (n_blocks - 1) * block_size;
+        std::size_t compressed_data_length = 0;
+        for (unsigned int b = 0; b < n_blocks; ++b)
+          {
+            compression_header[3 + b] = compressed_blocks[b].size();
+            compressed_data_length += compressed_blocks[b].size();
+          }
 
         char *encoded_header =
-          encode_block(reinterpret_cast<const char *>(&compression_header[0]),
-                       4 * sizeof(compression_header[0]));
+          encode_block(reinterpret_cast<const char *>(
+                         compression_header.data()),
+                       compression_header.size() * sizeof(uint32_t));
         output_stream << encoded_header;
         delete[] encoded_header;
 
         // next do the compressed data encoding in base64
+        std::vector<char> compressed_data;
+        compressed_data.reserve(compressed_data_length);
+        for (const std::vector<char> &block : compressed_blocks)
+          compressed_data.insert(compressed_data.end(),
+                                 block.begin(),
+                                 block.end());
         char *encoded_data =
-          encode_block(compressed_data, compressed_data_length);
-        delete[] compressed_data;
+          encode_block(compressed_data.data(), compressed_data.size());
 
         output_stream << encoded_data;
         delete[] encoded_data;
@@ -1958,6 +1998,17 @@ namespace DataOutBase
   {}
 
 
+  Hdf5Flags::Hdf5Flags(const unsigned int chunk_size,
+                       const unsigned int compression_level,
+                       const bool         single_precision_data,
+                       const bool         single_precision_nodes)
+    : chunk_size(chunk_size)
+    , compression_level(compression_level)
+    , single_precision_data(single_precision_data)
+    , single_precision_nodes(single_precision_nodes)
+  {}
+
+
   DataOutFilterFlags::DataOutFilterFlags(const bool filter_duplicate_vertices,
                                          const bool xdmf_hdf5_output)
     : filter_duplicate_vertices(filter_duplicate_vertices)
@@ -7446,19 +7497,146 @@ DataOutInterface<dim, spacedim>::write_vtu_in_parallel(
   const std::string &filename,
   MPI_Comm           comm) const
 {
+  write_vtu_in_parallel(filename, comm, 1);
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutInterface<dim, spacedim>::write_vtu_in_parallel(
+  const std::string &                                     filename,
+  MPI_Comm                                                comm,
+  const unsigned int                                      n_ranks_per_writer,
+  const std::vector<std::pair<std::string, std::string>> &mpi_io_hints) const
+{
+  Tracing::Scope trace("DataOutInterface::write_vtu_in_parallel");
+
 #ifndef DEAL_II_WITH_MPI
   // without MPI fall back to the normal way to write a vtu file:
   (void)comm;
+  (void)n_ranks_per_writer;
+  (void)mpi_io_hints;
 
   std::ofstream f(filename);
   write_vtu(f);
 #else
 
-  const int myrank = Utilities::MPI::this_mpi_process(comm);
+  const unsigned int myrank  = Utilities::MPI::this_mpi_process(comm);
+  const unsigned int n_ranks = Utilities::MPI::n_mpi_processes(comm);
+
+  // split the processes into the groups that send their data to a common
+  // writer, which is the process with the lowest rank in the group
+  MPI_Comm group_comm;
+  int      ierr;
+  if (n_ranks_per_writer == 0)
+    {
+#  if DEAL_II_MPI_VERSION_GTE(3, 0)
+      ierr = MPI_Comm_split_type(
+        comm, MPI_COMM_TYPE_SHARED, myrank, MPI_INFO_NULL, &group_comm);
+#  else
+      ierr = MPI_Comm_split(comm, myrank, myrank, &group_comm);
+#  endif
+    }
+  else
+    ierr =
+      MPI_Comm_split(comm, myrank / n_ranks_per_writer, myrank, &group_comm);
+  AssertThrowMPI(ierr);
+  const unsigned int group_rank = Utilities::MPI::this_mpi_process(group_comm);
+  const unsigned int group_size = Utilities::MPI::n_mpi_processes(group_comm);
+
+  // the data to be written by this process. the first process also writes
+  // the header, and the last one the footer, at the end of the file
+  std::string data;
+  {
+    std::stringstream ss;
+    if (myrank == 0)
+      DataOutBase::write_vtu_header(ss, vtk_flags);
+    DataOutBase::write_vtu_main(get_patches(),
+                                get_dataset_names(),
+                                get_nonscalar_data_ranges(),
+                                vtk_flags,
+                                ss);
+    data = ss.str();
+  }
+
+  // collect the data of the group on the writer
+  {
+    AssertThrow(data.size() <=
+                  static_cast<std::size_t>(std::numeric_limits<int>::max()),
+                ExcMessage("The output of a single process must not exceed "
+                           "2GB when writing it with MPI I/O."));
+    const int        my_size = data.size();
+    std::vector<int> sizes(group_size);
+    ierr = MPI_Gather(
+      &my_size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, group_comm);
+    AssertThrowMPI(ierr);
+
+    // group_comm is a new communicator, so there are no other messages
+    // that could be confused with the ones sent here
+    const int mpi_tag = 0;
+    if (group_rank == 0)
+      {
+        std::size_t offset = data.size();
+        for (unsigned int p = 1; p < group_size; ++p)
+          {
+            data.resize(offset + sizes[p]);
+            ierr = MPI_Recv(&data[offset],
+                            sizes[p],
+                            MPI_CHAR,
+                            p,
+                            mpi_tag,
+                            group_comm,
+                            MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+            offset += sizes[p];
+          }
+      }
+    else
+      {
+        ierr = MPI_Send(DEAL_II_MPI_CONST_CAST(data.data()),
+                        my_size,
+                        MPI_CHAR,
+                        0,
+                        mpi_tag,
+                        group_comm);
+        AssertThrowMPI(ierr);
+        data.clear();
+      }
+  }
+  ierr = MPI_Comm_free(&group_comm);
+  AssertThrowMPI(ierr);
+
+  if (myrank == n_ranks - 1)
+    {
+      std::stringstream ss;
+      DataOutBase::write_vtu_footer(ss);
+      data += ss.str();
+    }
+
+  // compute the position of the data of each writer in the file
+  const unsigned long long int my_data_size = data.size();
+  unsigned long long int       offset       = 0;
+  ierr = MPI_Exscan(DEAL_II_MPI_CONST_CAST(&my_data_size),
+                    &offset,
+                    1,
+                    MPI_UNSIGNED_LONG_LONG,
+                    MPI_SUM,
+                    comm);
+  AssertThrowMPI(ierr);
+  if (myrank == 0)
+    offset = 0;
 
   MPI_Info info;
-  int ierr = MPI_Info_create(&info);
+  ierr = MPI_Info_create(&info);
   AssertThrowMPI(ierr);
+  for (const auto &hint : mpi_io_hints)
+    {
+      ierr = MPI_Info_set(info,
+                          DEAL_II_MPI_CONST_CAST(hint.first.c_str()),
+                          DEAL_II_MPI_CONST_CAST(hint.second.c_str()));
+      AssertThrowMPI(ierr);
+    }
   MPI_File fh;
   ierr = MPI_File_open(comm,
                        DEAL_II_MPI_CONST_CAST(filename.c_str()),
@@ -7476,55 +7654,29 @@ DataOutInterface<dim, spacedim>::write_vtu_in_parallel(
   ierr = MPI_Info_free(&info);
   AssertThrowMPI(ierr);
 
-  unsigned int header_size;
-
-  // write header
-  if (myrank == 0)
-    {
-      std::stringstream ss;
-      DataOutBase::write_vtu_header(ss, vtk_flags);
-      header_size = ss.str().size();
-      ierr = MPI_File_write(fh,
-                            DEAL_II_MPI_CONST_CAST(ss.str().c_str()),
-                            header_size,
-                            MPI_CHAR,
-                            MPI_STATUS_IGNORE);
-      AssertThrowMPI(ierr);
-    }
-
-  ierr = MPI_Bcast(&header_size, 1, MPI_UNSIGNED, 0, comm);
-  AssertThrowMPI(ierr);
-
-  ierr = MPI_File_seek_shared(fh, header_size, MPI_SEEK_SET);
+  // write the data with collective calls, in blocks that fit into the int
+  // argument of MPI_File_write_at_all(). all processes need to take part in
+  // the same number of calls, even if they do not write anything
+  const std::size_t      block_size = 1 << 30;
+  unsigned long long int n_blocks =
+    (data.size() + block_size - 1) / block_size;
+  ierr = MPI_Allreduce(
+    MPI_IN_PLACE, &n_blocks, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, comm);
   AssertThrowMPI(ierr);
-  {
-    std::stringstream ss;
-    DataOutBase::write_vtu_main(get_patches(),
-                                get_dataset_names(),
-                                get_nonscalar_data_ranges(),
-                                vtk_flags,
-                                ss);
-    ierr = MPI_File_write_ordered(fh,
-                                  DEAL_II_MPI_CONST_CAST(ss.str().c_str()),
-                                  ss.str().size(),
-                                  MPI_CHAR,
-                                  MPI_STATUS_IGNORE);
-    AssertThrowMPI(ierr);
-  }
-
-  // write footer
-  if (myrank == 0)
+  for (unsigned long long int block = 0; block < n_blocks; ++block)
     {
-      std::stringstream ss;
-      DataOutBase::write_vtu_footer(ss);
-      unsigned int footer_size = ss.str().size();
-      ierr = MPI_File_write_shared(fh,
-                                   DEAL_II_MPI_CONST_CAST(ss.str().c_str()),
-                                   footer_size,
+      const std::size_t begin =
+        std::min<std::size_t>(block * block_size, data.size());
+      const std::size_t end = std::min(begin + block_size, data.size());
+      ierr = MPI_File_write_at_all(fh,
+                                   offset + begin,
+                                   DEAL_II_MPI_CONST_CAST(data.data() + begin),
+                                   end - begin,
                                    MPI_CHAR,
                                    MPI_STATUS_IGNORE);
       AssertThrowMPI(ierr);
     }
+
   ierr = MPI_File_close(&fh);
   AssertThrowMPI(ierr);
 #endif
@@ -7626,6 +7778,8 @@ DataOutInterface<dim, spacedim>::create_xdmf_entry(
                       global_node_cell_count[1],
                       dim,
                       spacedim);
+      entry.set_precision(hdf5_flags.single_precision_nodes ? 4 : 8,
+                          hdf5_flags.single_precision_data ? 4 : 8);
       unsigned int n_data_sets = data_filter.n_data_sets();
 
       // The vector names generated here must match those generated in the HDF5
@@ -7881,7 +8035,8 @@ DataOutInterface<dim, spacedim>::write_hdf5_parallel(
                                    write_mesh_file,
                                    mesh_filename,
                                    solution_filename,
-                                   comm);
+                                   comm,
+                                   hdf5_flags);
 }
 
 
@@ -7899,6 +8054,27 @@ DataOutBase::write_hdf5_parallel(
 
 
 
+template <int dim, int spacedim>
+void
+DataOutBase::write_hdf5_parallel(
+  const std::vector<Patch<dim, spacedim>> &patches,
+  const DataOutBase::DataOutFilter &       data_filter,
+  const bool                               write_mesh_file,
+  const std::string &                      mesh_filename,
+  const std::string &                      solution_filename,
+  MPI_Comm                                 comm)
+{
+  write_hdf5_parallel(patches,
+                      data_filter,
+                      write_mesh_file,
+                      mesh_filename,
+                      solution_filename,
+                      comm,
+                      Hdf5Flags());
+}
+
+
+
 template <int dim, int spacedim>
 void
 DataOutBase::write_hdf5_parallel(
@@ -7907,8 +8083,12 @@ DataOutBase::write_hdf5_parallel(
   const bool                        write_mesh_file,
   const std::string &               mesh_filename,
   const std::string &               solution_filename,
-  MPI_Comm                          comm)
+  MPI_Comm                          comm,
+  const Hdf5Flags &                 flags)
 {
+  AssertThrow(flags.compression_level <= 9,
+              ExcMessage("The compression level must be between 0 and 9."));
+
   AssertThrow(
     spacedim >= 2,
     ExcMessage(
@@ -7925,6 +8105,7 @@ DataOutBase::write_hdf5_parallel(
   (void)mesh_filename;
   (void)solution_filename;
   (void)comm;
+  (void)flags;
   AssertThrow(false, ExcMessage("HDF5 support is disabled."));
 #else
 #  ifndef DEAL_II_WITH_MPI
@@ -8013,6 +8194,37 @@ DataOutBase::write_hdf5_parallel(
 #    endif
 #  endif
 
+  // Create the property list for the creation of a dataset with the given
+  // number of rows and columns, which determines whether the dataset is
+  // chunked and compressed. The caller needs to close it again
+  const auto create_dataset_plist = [&flags](const hsize_t n_rows,
+                                             const hsize_t n_columns) {
+    const hid_t dataset_plist_id = H5Pcreate(H5P_DATASET_CREATE);
+    AssertThrow(dataset_plist_id >= 0, ExcIO());
+    if (flags.chunk_size > 0 && n_rows > 0)
+      {
+        const hsize_t chunk_dims[2] = {
+          std::min<hsize_t>(flags.chunk_size, n_rows), n_columns};
+        herr_t plist_status = H5Pset_chunk(dataset_plist_id, 2, chunk_dims);
+        AssertThrow(plist_status >= 0, ExcIO());
+        if (flags.compression_level > 0)
+          {
+            plist_status =
+              H5Pset_deflate(dataset_plist_id, flags.compression_level);
+            AssertThrow(plist_status >= 0, ExcIO());
+          }
+      }
+    return dataset_plist_id;
+  };
+  hid_t dataset_plist_id;
+
+  // The type of the floating point numbers in the file. The data is always
+  // given in double precision in memory and converted by HDF5 when writing
+  const hid_t node_file_type =
+    flags.single_precision_nodes ? H5T_NATIVE_FLOAT : H5T_NATIVE_DOUBLE;
+  const hid_t data_file_type =
+    flags.single_precision_data ? H5T_NATIVE_FLOAT : H5T_NATIVE_DOUBLE;
+
   if (write_mesh_file)
     {
       // Overwrite any existing files (change this to an option?)
@@ -8035,35 +8247,45 @@ DataOutBase::write_hdf5_parallel(
       AssertThrow(cell_dataspace >= 0, ExcIO());
 
       // Create the dataset for the nodes and cells
+      dataset_plist_id = create_dataset_plist(node_ds_dim[0], node_ds_dim[1]);
 #  if H5Gcreate_vers == 1
       node_dataset = H5Dcreate(h5_mesh_file_id,
                                "nodes",
-                               H5T_NATIVE_DOUBLE,
+                               node_file_type,
                                node_dataspace,
-                               H5P_DEFAULT);
+                               dataset_plist_id);
 #  else
       node_dataset = H5Dcreate(h5_mesh_file_id,
                                "nodes",
-                               H5T_NATIVE_DOUBLE,
+                               node_file_type,
                                node_dataspace,
                                H5P_DEFAULT,
-                               H5P_DEFAULT,
+                               dataset_plist_id,
                                H5P_DEFAULT);
 #  endif
       AssertThrow(node_dataset >= 0, ExcIO());
+      status = H5Pclose(dataset_plist_id);
+      AssertThrow(status >= 0, ExcIO());
+
+      dataset_plist_id = create_dataset_plist(cell_ds_dim[0], cell_ds_dim[1]);
 #  if H5Gcreate_vers == 1
-      cell_dataset = H5Dcreate(
-        h5_mesh_file_id, "cells", H5T_NATIVE_UINT, cell_dataspace, H5P_DEFAULT);
+      cell_dataset = H5Dcreate(h5_mesh_file_id,
+                               "cells",
+                               H5T_NATIVE_UINT,
+                               cell_dataspace,
+                               dataset_plist_id);
 #  else
       cell_dataset = H5Dcreate(h5_mesh_file_id,
                                "cells",
                                H5T_NATIVE_UINT,
                                cell_dataspace,
                                H5P_DEFAULT,
-                               H5P_DEFAULT,
+                               dataset_plist_id,
                                H5P_DEFAULT);
 #  endif
       AssertThrow(cell_dataset >= 0, ExcIO());
+      status = H5Pclose(dataset_plist_id);
+      AssertThrow(status >= 0, ExcIO());
 
       // Close the node and cell dataspaces since we're done with them
       status = H5Sclose(node_dataspace);
@@ -8183,22 +8405,25 @@ DataOutBase::write_hdf5_parallel(
       pt_data_dataspace = H5Screate_simple(2, node_ds_dim, nullptr);
       AssertThrow(pt_data_dataspace >= 0, ExcIO());
 
+      dataset_plist_id = create_dataset_plist(node_ds_dim[0], node_ds_dim[1]);
 #  if H5Gcreate_vers == 1
       pt_data_dataset = H5Dcreate(h5_solution_file_id,
                                   vector_name.c_str(),
-                                  H5T_NATIVE_DOUBLE,
+                                  data_file_type,
                                   pt_data_dataspace,
-                                  H5P_DEFAULT);
+                                  dataset_plist_id);
 #  else
       pt_data_dataset = H5Dcreate(h5_solution_file_id,
                                   vector_name.c_str(),
-                                  H5T_NATIVE_DOUBLE,
+                                  data_file_type,
                                   pt_data_dataspace,
                                   H5P_DEFAULT,
-                                  H5P_DEFAULT,
+                                  dataset_plist_id,
                                   H5P_DEFAULT);
 #  endif
       AssertThrow(pt_data_dataset >= 0, ExcIO());
+      status = H5Pclose(dataset_plist_id);
+      AssertThrow(status >= 0, ExcIO());
 
       // Create the data subset we'll use to read from memory
       count[0] = local_node_cell_count[0];
@@ -8262,6 +8487,8 @@ DataOutInterface<dim, spacedim>::write(
   std::ostream &                  out,
   const DataOutBase::OutputFormat output_format_) const
 {
+  Tracing::Scope trace("DataOutInterface::write");
+
   DataOutBase::OutputFormat output_format = output_format_;
   if (output_format == DataOutBase::default_format)
     output_format = default_fmt;
@@ -8365,6 +8592,8 @@ DataOutInterface<dim, spacedim>::set_flags(const FlagType &flags)
   else if (typeid(flags) == typeid(deal_II_intermediate_flags))
     deal_II_intermediate_flags =
       *reinterpret_cast<const DataOutBase::Deal_II_IntermediateFlags *>(&flags);
+  else if (typeid(flags) == typeid(hdf5_flags))
+    hdf5_flags = *reinterpret_cast<const DataOutBase::Hdf5Flags *>(&flags);
   else
     Assert(false, ExcNotImplemented());
 }
@@ -8498,7 +8727,8 @@ DataOutInterface<dim, spacedim>::memory_consumption() const
           MemoryConsumption::memory_consumption(tecplot_flags) +
           MemoryConsumption::memory_consumption(vtk_flags) +
           MemoryConsumption::memory_consumption(svg_flags) +
-          MemoryConsumption::memory_consumption(deal_II_intermediate_flags));
+          MemoryConsumption::memory_consumption(deal_II_intermediate_flags) +
+          MemoryConsumption::memory_consumption(hdf5_flags));
 }
 
 
@@ -8596,6 +8826,15 @@ DataOutInterface<dim, spacedim>::validate_dataset_names() const
 
 
 
+template <int dim, int spacedim>
+const DataOutBase::VtkFlags &
+DataOutInterface<dim, spacedim>::get_vtk_flags() const
+{
+  return vtk_flags;
+}
+
+
+
 // ---------------------------------------------- DataOutReader ----------
 
 template <int dim, int spacedim>
@@ -8813,6 +9052,8 @@ XDMFEntry::XDMFEntry()
   , num_cells(numbers::invalid_unsigned_int)
   , dimension(numbers::invalid_unsigned_int)
   , space_dimension(numbers::invalid_unsigned_int)
+  , node_precision(8)
+  , attribute_precision(8)
 {}
 
 
@@ -8853,6 +9094,8 @@ XDMFEntry::XDMFEntry(const std::string &mesh_filename,
   , num_cells(cells)
   , dimension(dim)
   , space_dimension(spacedim)
+  , node_precision(8)
+  , attribute_precision(8)
 {}
 
 
@@ -8866,6 +9109,20 @@ XDMFEntry::add_attribute(const std::string &attr_name,
 
 
 
+void
+XDMFEntry::set_precision(const unsigned int node_precision,
+                         const unsigned int attribute_precision)
+{
+  Assert(node_precision == 4 || node_precision == 8,
+         ExcMessage("The precision must be either 4 or 8 bytes."));
+  Assert(attribute_precision == 4 || attribute_precision == 8,
+         ExcMessage("The precision must be either 4 or 8 bytes."));
+  this->node_precision      = node_precision;
+  this->attribute_precision = attribute_precision;
+}
+
+
+
 namespace
 {
   /**
@@ -8897,7 +9154,8 @@ XDMFEntry::get_xdmf_content(const unsigned int indent_level) const
      << (space_dimension <= 2 ? "XY" : "XYZ") << "\">\n";
   ss << indent(indent_level + 2) << "<DataItem Dimensions=\"" << num_nodes
      << " " << (space_dimension <= 2 ? 2 : space_dimension)
-     << "\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">\n";
+     << "\" NumberType=\"Float\" Precision=\"" << node_precision
+     << "\" Format=\"HDF\">\n";
   ss << indent(indent_level + 3) << h5_mesh_filename << ":/nodes\n";
   ss << indent(indent_level + 2) << "</DataItem>\n";
   ss << indent(indent_level + 1) << "</Geometry>\n";
@@ -8949,7 +9207,8 @@ XDMFEntry::get_xdmf_content(const unsigned int indent_level) const
       // Vectors must have 3 elements even for 2D models
       ss << indent(indent_level + 2) << "<DataItem Dimensions=\"" << num_nodes
          << " " << (attribute_dim.second > 1 ? 3 : 1)
-         << "\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">\n";
+         << "\" NumberType=\"Float\" Precision=\"" << attribute_precision
+         << "\" Format=\"HDF\">\n";
       ss << indent(indent_level + 3) << h5_sol_filename << ":/"
          << attribute_dim.first << "\n";
       ss << indent(indent_level + 2) << "</DataItem>\n";
@@ -8963,6 +9222,68 @@ XDMFEntry::get_xdmf_content(const unsigned int indent_level) const
 
 
 
+// ---------------------------------------------- XDMFTimeSeries ----------
+
+XDMFTimeSeries::XDMFTimeSeries(
+  const std::string &                    basename,
+  MPI_Comm                               comm,
+  const DataOutBase::DataOutFilterFlags &filter_flags)
+  : basename(basename)
+  , comm(comm)
+  , filter_flags(filter_flags)
+  , n_mesh_generations(0)
+{}
+
+
+
+template <int dim, int spacedim>
+void
+XDMFTimeSeries::write_time_step(const DataOutInterface<dim, spacedim> &data_out,
+                                const double                           time,
+                                const bool mesh_changed)
+{
+  DataOutBase::DataOutFilter data_filter(filter_flags);
+  data_out.write_filtered_data(data_filter);
+
+  const bool write_mesh_file = mesh_changed || entries.empty();
+  if (write_mesh_file)
+    {
+      mesh_filename = basename + "_mesh-" +
+                      Utilities::int_to_string(n_mesh_generations, 4) + ".h5";
+      ++n_mesh_generations;
+    }
+  const std::string solution_filename =
+    basename + "_solution-" + Utilities::int_to_string(entries.size(), 5) +
+    ".h5";
+
+  data_out.write_hdf5_parallel(
+    data_filter, write_mesh_file, mesh_filename, solution_filename, comm);
+
+  // the XDMF file is placed next to the HDF5 files, so it refers to them
+  // without the directory part of their names
+  const auto strip_directory = [](const std::string &filename) {
+    const std::size_t pos = filename.find_last_of('/');
+    return (pos == std::string::npos) ? filename : filename.substr(pos + 1);
+  };
+  entries.push_back(
+    data_out.create_xdmf_entry(data_filter,
+                               strip_directory(mesh_filename),
+                               strip_directory(solution_filename),
+                               time,
+                               comm));
+  data_out.write_xdmf_file(entries, basename + ".xdmf", comm);
+}
+
+
+
+const std::vector<XDMFEntry> &
+XDMFTimeSeries::get_entries() const
+{
+  return entries;
+}
+
+
+
 namespace DataOutBase
 {
   template <int dim, int spacedim>
@@ -19,9 +19,11 @@
 #include <deal.II/base/point.h>
 #include <deal.II/base/std_cxx17/cmath.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/lac/vector.h>
 
+#include <algorithm>
 #include <cmath>
 
 DEAL_II_NAMESPACE_OPEN
@@ -2473,6 +2475,157 @@ namespace Functions
 
       return grad;
     }
+
+
+    // Interpolate the data values at the 2^dim corners of a box at the
+    // point p_unit given in unit coordinates. Corner c lies at the upper end
+    // of the box in coordinate direction d if bit d of c is set. This is
+    // written for all lanes of a VectorizedArray at once.
+    template <int dim, typename Number>
+    Number
+    interpolate_corners(const std::array<Number, (1U << dim)> &corner_values,
+                        const Point<dim, Number> &               p_unit)
+    {
+      Number result = 0.;
+      for (unsigned int c = 0; c < (1U << dim); ++c)
+        {
+          Number weight = corner_values[c];
+          for (unsigned int d = 0; d < dim; ++d)
+            weight *= ((c >> d) & 1) ? p_unit[d] : 1. - p_unit[d];
+          result += weight;
+        }
+      return result;
+    }
+
+
+    // Same as above, but for the gradient, with dx the width of the box in
+    // each dimension.
+    template <int dim, typename Number>
+    Tensor<1, dim, Number>
+    gradient_interpolate_corners(
+      const std::array<Number, (1U << dim)> &corner_values,
+      const Point<dim, Number> &               p_unit,
+      const Point<dim, Number> &               dx)
+    {
+      Tensor<1, dim, Number> grad;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          Number derivative = 0.;
+          for (unsigned int c = 0; c < (1U << dim); ++c)
+            {
+              Number weight = corner_values[c];
+              for (unsigned int e = 0; e < dim; ++e)
+                if (e != d)
+                  weight *= ((c >> e) & 1) ? p_unit[e] : 1. - p_unit[e];
+              if ((c >> d) & 1)
+                derivative += weight;
+              else
+                derivative -= weight;
+            }
+          grad[d] = derivative / dx[d];
+        }
+      return grad;
+    }
+
+
+    // Store the data values at the corners of the box with lower left
+    // index ix in lane v of corner_values, with the numbering of the corners
+    // used by interpolate_corners().
+    template <int dim, typename Number>
+    void
+    gather_corner_values(const Table<dim, double> &       data_values,
+                         const TableIndices<dim> &        ix,
+                         const unsigned int               v,
+                         std::array<Number, (1U << dim)> &corner_values)
+    {
+      for (unsigned int c = 0; c < (1U << dim); ++c)
+        {
+          TableIndices<dim> corner;
+          for (unsigned int d = 0; d < dim; ++d)
+            corner[d] = ix[d] + ((c >> d) & 1);
+          corner_values[c][v] = data_values(corner);
+        }
+    }
+
+
+    // Return whether the interval [x_i,x_{i+1}] of the coordinate array x is
+    // the one used to interpolate at the coordinate p. Coordinates to the
+    // left of x_0 belong to the first and coordinates to the right of the
+    // last entry of x to the last interval, where the function is extended
+    // by a constant.
+    inline bool
+    is_interval_of_coordinate(const std::vector<double> &x,
+                              const double               p,
+                              const unsigned int         i)
+    {
+      return ((i == 0 || x[i] < p) && (i == x.size() - 2 || p <= x[i + 1]));
+    }
+
+
+    // Find the interval of the coordinate array x used to interpolate at
+    // the coordinate p, see above.
+    unsigned int
+    find_interval(const std::vector<double> &x, const double p)
+    {
+      // get the index of the first element of the coordinate array that is
+      // larger than p
+      const unsigned int i =
+        std::lower_bound(x.begin(), x.end(), p) - x.begin();
+
+      // the one we want is the index of the coordinate to the left, however,
+      // so decrease it by one (unless we have a point to the left of all, in
+      // which case we stay where we are; the formulas below are made in a way
+      // that allow us to extend the function by a constant value)
+      //
+      // to make this work, if we got x.end(), we actually have to consider
+      // the last box which has index size()-2
+      if (i == x.size())
+        return x.size() - 2;
+      else if (i > 0)
+        return i - 1;
+      else
+        return 0;
+    }
+
+
+    // Same as above, but test the interval guess and its two neighbors
+    // first. For a sequence of nearby points, this avoids most of the
+    // binary searches.
+    unsigned int
+    find_interval(const std::vector<double> &x,
+                  const double               p,
+                  const unsigned int         guess)
+    {
+      if (is_interval_of_coordinate(x, p, guess))
+        return guess;
+      else if (guess + 2 < x.size() &&
+               is_interval_of_coordinate(x, p, guess + 1))
+        return guess + 1;
+      else if (guess > 0 && is_interval_of_coordinate(x, p, guess - 1))
+        return guess - 1;
+      else
+        return find_interval(x, p);
+    }
+
+
+    // Compute the position of the point p relative to the box with lower
+    // left index ix of the coordinate arrays, truncated below and above to
+    // accommodate points that may lie outside the range.
+    template <int dim, typename CoordinateArrays>
+    Point<dim>
+    unit_point(const CoordinateArrays & coordinate_values,
+               const TableIndices<dim> &ix,
+               const Point<dim> &       p)
+    {
+      Point<dim> p_unit;
+      for (unsigned int d = 0; d < dim; ++d)
+        p_unit[d] = std::max(std::min((p[d] - coordinate_values[d][ix[d]]) /
+                                        (coordinate_values[d][ix[d] + 1] -
+                                         coordinate_values[d][ix[d]]),
+                                      1.),
+                             0.);
+      return p_unit;
+    }
   } // namespace
 
   template <int dim>
@@ -2513,26 +2666,22 @@ namespace Functions
     // intervals, starting at x.size()-2 and going to x.size()-1.
     TableIndices<dim> ix;
     for (unsigned int d = 0; d < dim; ++d)
-      {
-        // get the index of the first element of the coordinate arrays that is
-        // larger than p[d]
-        ix[d] = (std::lower_bound(coordinate_values[d].begin(),
-                                  coordinate_values[d].end(),
-                                  p[d]) -
-                 coordinate_values[d].begin());
-
-        // the one we want is the index of the coordinate to the left, however,
-        // so decrease it by one (unless we have a point to the left of all, in
-        // which case we stay where we are; the formulas below are made in a way
-        // that allow us to extend the function by a constant value)
-        //
-        // to make this work, if we got coordinate_values[d].end(), we actually
-        // have to consider the last box which has index size()-2
-        if (ix[d] == coordinate_values[d].size())
-          ix[d] = coordinate_values[d].size() - 2;
-        else if (ix[d] > 0)
-          --ix[d];
-      }
+      ix[d] = find_interval(coordinate_values[d], p[d]);
+
+    return ix;
+  }
+
+
+
+  template <int dim>
+  TableIndices<dim>
+  InterpolatedTensorProductGridData<dim>::table_index_of_point(
+    const Point<dim> &       p,
+    const TableIndices<dim> &guess) const
+  {
+    TableIndices<dim> ix;
+    for (unsigned int d = 0; d < dim; ++d)
+      ix[d] = find_interval(coordinate_values[d], p[d], guess[d]);
 
     return ix;
   }
@@ -2555,17 +2704,8 @@ namespace Functions
     const TableIndices<dim> ix = table_index_of_point(p);
 
     // now compute the relative point within the interval/rectangle/box
-    // defined by the point coordinates found above. truncate below and
-    // above to accommodate points that may lie outside the range
-    Point<dim> p_unit;
-    for (unsigned int d = 0; d < dim; ++d)
-      p_unit[d] = std::max(std::min((p[d] - coordinate_values[d][ix[d]]) /
-                                      (coordinate_values[d][ix[d] + 1] -
-                                       coordinate_values[d][ix[d]]),
-                                    1.),
-                           0.);
-
-    return interpolate(data_values, ix, p_unit);
+    // defined by the point coordinates found above
+    return interpolate(data_values, ix, unit_point(coordinate_values, ix, p));
   }
 
 
@@ -2589,13 +2729,155 @@ namespace Functions
     for (unsigned int d = 0; d < dim; ++d)
       dx[d] = coordinate_values[d][ix[d] + 1] - coordinate_values[d][ix[d]];
 
-    Point<dim> p_unit;
+    return gradient_interpolate(data_values,
+                                ix,
+                                unit_point(coordinate_values, ix, p),
+                                dx);
+  }
+
+
+
+  template <int dim>
+  void
+  InterpolatedTensorProductGridData<dim>::value_list(
+    const std::vector<Point<dim>> &points,
+    std::vector<double> &          values,
+    const unsigned int             component) const
+  {
+    (void)component;
+    Assert(
+      component == 0,
+      ExcMessage(
+        "This is a scalar function object, the component can only be zero."));
+    AssertDimension(values.size(), points.size());
+
+    // start the search for each point at the box of the previous one
+    TableIndices<dim> ix;
+    for (unsigned int d = 0; d < dim; ++d)
+      ix[d] = 0;
+    for (unsigned int q = 0; q < points.size(); ++q)
+      {
+        ix        = table_index_of_point(points[q], ix);
+        values[q] = interpolate(data_values,
+                                ix,
+                                unit_point(coordinate_values, ix, points[q]));
+      }
+  }
+
+
+
+  template <int dim>
+  void
+  InterpolatedTensorProductGridData<dim>::gradient_list(
+    const std::vector<Point<dim>> &points,
+    std::vector<Tensor<1, dim>> &  gradients,
+    const unsigned int             component) const
+  {
+    (void)component;
+    Assert(
+      component == 0,
+      ExcMessage(
+        "This is a scalar function object, the component can only be zero."));
+    AssertDimension(gradients.size(), points.size());
+
+    TableIndices<dim> ix;
+    for (unsigned int d = 0; d < dim; ++d)
+      ix[d] = 0;
+    for (unsigned int q = 0; q < points.size(); ++q)
+      {
+        ix = table_index_of_point(points[q], ix);
+
+        Point<dim> dx;
+        for (unsigned int d = 0; d < dim; ++d)
+          dx[d] =
+            coordinate_values[d][ix[d] + 1] - coordinate_values[d][ix[d]];
+
+        gradients[q] =
+          gradient_interpolate(data_values,
+                               ix,
+                               unit_point(coordinate_values, ix, points[q]),
+                               dx);
+      }
+  }
+
+
+
+  template <int dim>
+  VectorizedArray<double>
+  InterpolatedTensorProductGridData<dim>::value(
+    const Point<dim, VectorizedArray<double>> &p,
+    const unsigned int                         component) const
+  {
+    (void)component;
+    Assert(
+      component == 0,
+      ExcMessage(
+        "This is a scalar function object, the component can only be zero."));
+
+    // the table lookup needs to be done lane by lane, but the interpolation
+    // itself can be done on all lanes at once
+    std::array<VectorizedArray<double>, (1U << dim)> corner_values;
+    Point<dim, VectorizedArray<double>>              p_unit;
+    TableIndices<dim>                                ix;
+    for (unsigned int d = 0; d < dim; ++d)
+      ix[d] = 0;
+    for (unsigned int v = 0; v < VectorizedArray<double>::n_array_elements;
+         ++v)
+      {
+        Point<dim> p_lane;
+        for (unsigned int d = 0; d < dim; ++d)
+          p_lane[d] = p[d][v];
+        ix = table_index_of_point(p_lane, ix);
+
+        const Point<dim> p_unit_lane =
+          unit_point(coordinate_values, ix, p_lane);
+        for (unsigned int d = 0; d < dim; ++d)
+          p_unit[d][v] = p_unit_lane[d];
+        gather_corner_values(data_values, ix, v, corner_values);
+      }
+
+    return interpolate_corners(corner_values, p_unit);
+  }
+
+
+
+  template <int dim>
+  Tensor<1, dim, VectorizedArray<double>>
+  InterpolatedTensorProductGridData<dim>::gradient(
+    const Point<dim, VectorizedArray<double>> &p,
+    const unsigned int                         component) const
+  {
+    (void)component;
+    Assert(
+      component == 0,
+      ExcMessage(
+        "This is a scalar function object, the component can only be zero."));
+
+    std::array<VectorizedArray<double>, (1U << dim)> corner_values;
+    Point<dim, VectorizedArray<double>>              p_unit, dx;
+    TableIndices<dim>                                ix;
     for (unsigned int d = 0; d < dim; ++d)
-      p_unit[d] =
-        std::max(std::min((p[d] - coordinate_values[d][ix[d]]) / dx[d], 1.),
-                 0.0);
+      ix[d] = 0;
+    for (unsigned int v = 0; v < VectorizedArray<double>::n_array_elements;
+         ++v)
+      {
+        Point<dim> p_lane;
+        for (unsigned int d = 0; d < dim; ++d)
+          p_lane[d] = p[d][v];
+        ix = table_index_of_point(p_lane, ix);
+
+        const Point<dim> p_unit_lane =
+          unit_point(coordinate_values, ix, p_lane);
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            p_unit[d][v] = p_unit_lane[d];
+            dx[d][v] =
+              coordinate_values[d][ix[d] + 1] - coordinate_values[d][ix[d]];
+          }
+        gather_corner_values(data_values, ix, v, corner_values);
+      }
 
-    return gradient_interpolate(data_values, ix, p_unit, dx);
+    return gradient_interpolate_corners(corner_values, p_unit, dx);
   }
 
 
@@ -2624,48 +2906,69 @@ namespace Functions
 
 
   template <int dim>
-  double
-  InterpolatedUniformGridData<dim>::value(const Point<dim> & p,
-                                          const unsigned int component) const
+  Point<dim>
+  InterpolatedUniformGridData<dim>::interval_sizes() const
   {
-    (void)component;
-    Assert(
-      component == 0,
-      ExcMessage(
-        "This is a scalar function object, the component can only be zero."));
+    Point<dim> delta_x;
+    for (unsigned int d = 0; d < dim; ++d)
+      delta_x[d] =
+        ((interval_endpoints[d].second - interval_endpoints[d].first) /
+         n_subintervals[d]);
+    return delta_x;
+  }
+
+
 
+  template <int dim>
+  TableIndices<dim>
+  InterpolatedUniformGridData<dim>::table_index_of_point(
+    const Point<dim> &p,
+    const Point<dim> &delta_x,
+    Point<dim> &      p_unit) const
+  {
     // find out where this data point lies, relative to the given
     // subdivision points
     TableIndices<dim> ix;
     for (unsigned int d = 0; d < dim; ++d)
       {
-        const double delta_x =
-          ((interval_endpoints[d].second - interval_endpoints[d].first) /
-           n_subintervals[d]);
         if (p[d] <= interval_endpoints[d].first)
           ix[d] = 0;
-        else if (p[d] >= interval_endpoints[d].second - delta_x)
+        else if (p[d] >= interval_endpoints[d].second - delta_x[d])
           ix[d] = n_subintervals[d] - 1;
         else
           ix[d] = static_cast<unsigned int>(
-            (p[d] - interval_endpoints[d].first) / delta_x);
+            (p[d] - interval_endpoints[d].first) / delta_x[d]);
       }
 
     // now compute the relative point within the interval/rectangle/box
     // defined by the point coordinates found above. truncate below and
     // above to accommodate points that may lie outside the range
-    Point<dim> p_unit;
     for (unsigned int d = 0; d < dim; ++d)
-      {
-        const double delta_x =
-          ((interval_endpoints[d].second - interval_endpoints[d].first) /
-           n_subintervals[d]);
-        p_unit[d] = std::max(std::min((p[d] - interval_endpoints[d].first -
-                                       ix[d] * delta_x) /
-                                        delta_x,
-                                      1.),
-                             0.);
-      }
+      p_unit[d] = std::max(std::min((p[d] - interval_endpoints[d].first -
+                                     ix[d] * delta_x[d]) /
+                                      delta_x[d],
+                                    1.),
+                           0.);
+
+    return ix;
+  }
+
+
+
+  template <int dim>
+  double
+  InterpolatedUniformGridData<dim>::value(const Point<dim> & p,
+                                          const unsigned int component) const
+  {
+    (void)component;
+    Assert(
+      component == 0,
+      ExcMessage(
+        "This is a scalar function object, the component can only be zero."));
+
+    Point<dim>              p_unit;
+    const TableIndices<dim> ix =
+      table_index_of_point(p, interval_sizes(), p_unit);
 
     return interpolate(data_values, ix, p_unit);
   }
@@ -2683,42 +2986,138 @@ namespace Functions
       ExcMessage(
         "This is a scalar function object, the component can only be zero."));
 
-    // find out where this data point lies, relative to the given
-    // subdivision points
-    TableIndices<dim> ix;
-    for (unsigned int d = 0; d < dim; ++d)
+    const Point<dim>        delta_x = interval_sizes();
+    Point<dim>              p_unit;
+    const TableIndices<dim> ix = table_index_of_point(p, delta_x, p_unit);
+
+    return gradient_interpolate(data_values, ix, p_unit, delta_x);
+  }
+
+
+
+  template <int dim>
+  void
+  InterpolatedUniformGridData<dim>::value_list(
+    const std::vector<Point<dim>> &points,
+    std::vector<double> &          values,
+    const unsigned int             component) const
+  {
+    (void)component;
+    Assert(
+      component == 0,
+      ExcMessage(
+        "This is a scalar function object, the component can only be zero."));
+    AssertDimension(values.size(), points.size());
+
+    const Point<dim> delta_x = interval_sizes();
+    for (unsigned int q = 0; q < points.size(); ++q)
       {
-        const double delta_x = ((this->interval_endpoints[d].second -
-                                 this->interval_endpoints[d].first) /
-                                this->n_subintervals[d]);
-        if (p[d] <= this->interval_endpoints[d].first)
-          ix[d] = 0;
-        else if (p[d] >= this->interval_endpoints[d].second - delta_x)
-          ix[d] = this->n_subintervals[d] - 1;
-        else
-          ix[d] = static_cast<unsigned int>(
-            (p[d] - this->interval_endpoints[d].first) / delta_x);
+        Point<dim>              p_unit;
+        const TableIndices<dim> ix =
+          table_index_of_point(points[q], delta_x, p_unit);
+        values[q] = interpolate(data_values, ix, p_unit);
       }
+  }
 
-    // now compute the relative point within the interval/rectangle/box
-    // defined by the point coordinates found above. truncate below and
-    // above to accommodate points that may lie outside the range
-    Point<dim> p_unit;
-    Point<dim> delta_x;
-    for (unsigned int d = 0; d < dim; ++d)
+
+
+  template <int dim>
+  void
+  InterpolatedUniformGridData<dim>::gradient_list(
+    const std::vector<Point<dim>> &points,
+    std::vector<Tensor<1, dim>> &  gradients,
+    const unsigned int             component) const
+  {
+    (void)component;
+    Assert(
+      component == 0,
+      ExcMessage(
+        "This is a scalar function object, the component can only be zero."));
+    AssertDimension(gradients.size(), points.size());
+
+    const Point<dim> delta_x = interval_sizes();
+    for (unsigned int q = 0; q < points.size(); ++q)
       {
-        delta_x[d] = ((this->interval_endpoints[d].second -
-                       this->interval_endpoints[d].first) /
-                      this->n_subintervals[d]);
-        p_unit[d] =
-          std::max(std::min((p[d] - this->interval_endpoints[d].first -
-                             ix[d] * delta_x[d]) /
-                              delta_x[d],
-                            1.),
-                   0.);
+        Point<dim>              p_unit;
+        const TableIndices<dim> ix =
+          table_index_of_point(points[q], delta_x, p_unit);
+        gradients[q] = gradient_interpolate(data_values, ix, p_unit, delta_x);
+      }
+  }
+
+
+
+  template <int dim>
+  VectorizedArray<double>
+  InterpolatedUniformGridData<dim>::value(
+    const Point<dim, VectorizedArray<double>> &p,
+    const unsigned int                         component) const
+  {
+    (void)component;
+    Assert(
+      component == 0,
+      ExcMessage(
+        "This is a scalar function object, the component can only be zero."));
+
+    // the table lookup needs to be done lane by lane, but the interpolation
+    // itself can be done on all lanes at once
+    const Point<dim> delta_x = interval_sizes();
+    std::array<VectorizedArray<double>, (1U << dim)> corner_values;
+    Point<dim, VectorizedArray<double>>              p_unit;
+    for (unsigned int v = 0; v < VectorizedArray<double>::n_array_elements;
+         ++v)
+      {
+        Point<dim> p_lane;
+        for (unsigned int d = 0; d < dim; ++d)
+          p_lane[d] = p[d][v];
+
+        Point<dim>              p_unit_lane;
+        const TableIndices<dim> ix =
+          table_index_of_point(p_lane, delta_x, p_unit_lane);
+        for (unsigned int d = 0; d < dim; ++d)
+          p_unit[d][v] = p_unit_lane[d];
+        gather_corner_values(data_values, ix, v, corner_values);
+      }
+
+    return interpolate_corners(corner_values, p_unit);
+  }
+
+
+
+  template <int dim>
+  Tensor<1, dim, VectorizedArray<double>>
+  InterpolatedUniformGridData<dim>::gradient(
+    const Point<dim, VectorizedArray<double>> &p,
+    const unsigned int                         component) const
+  {
+    (void)component;
+    Assert(
+      component == 0,
+      ExcMessage(
+        "This is a scalar function object, the component can only be zero."));
+
+    const Point<dim> delta_x = interval_sizes();
+    std::array<VectorizedArray<double>, (1U << dim)> corner_values;
+    Point<dim, VectorizedArray<double>>              p_unit, dx;
+    for (unsigned int v = 0; v < VectorizedArray<double>::n_array_elements;
+         ++v)
+      {
+        Point<dim> p_lane;
+        for (unsigned int d = 0; d < dim; ++d)
+          p_lane[d] = p[d][v];
+
+        Point<dim>              p_unit_lane;
+        const TableIndices<dim> ix =
+          table_index_of_point(p_lane, delta_x, p_unit_lane);
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            p_unit[d][v] = p_unit_lane[d];
+            dx[d][v]     = delta_x[d];
+          }
+        gather_corner_values(data_values, ix, v, corner_values);
       }
 
-    return gradient_interpolate(this->data_values, ix, p_unit, delta_x);
+    return gradient_interpolate_corners(corner_values, p_unit, dx);
   }
 
 
@@ -18,6 +18,7 @@
 #include <deal.II/base/patterns.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/lac/vector.h>
 
@@ -271,6 +272,17 @@ namespace internal
     return uniform_distribution(rng);
   }
 
+  // print the information of an error raised by muparser
+  void
+  print_parser_error(const mu::ParserError &e)
+  {
+    std::cerr << "Message:  <" << e.GetMsg() << ">\n";
+    std::cerr << "Formula:  <" << e.GetExpr() << ">\n";
+    std::cerr << "Token:    <" << e.GetToken() << ">\n";
+    std::cerr << "Position: <" << e.GetPos() << ">\n";
+    std::cerr << "Errc:     <" << e.GetCode() << ">" << std::endl;
+  }
+
 } // namespace internal
 
 
@@ -490,6 +502,130 @@ FunctionParser<dim>::vector_value(const Point<dim> &p,
     values(component) = fp.get()[component]->Eval();
 }
 
+
+
+template <int dim>
+void
+FunctionParser<dim>::value_list(const std::vector<Point<dim>> &points,
+                                std::vector<double> &          values,
+                                const unsigned int             component) const
+{
+  Assert(initialized == true, ExcNotInitialized());
+  Assert(component < this->n_components,
+         ExcIndexRange(component, 0, this->n_components));
+  Assert(values.size() == points.size(),
+         ExcDimensionMismatch(values.size(), points.size()));
+
+  // initialize the parser if that hasn't happened yet on the current thread
+  if (fp.get().size() == 0)
+    init_muparser();
+
+  // look up the thread-local objects only once for all points
+  std::vector<double> &variables = vars.get();
+  mu::Parser &         parser    = *fp.get()[component];
+
+  if (dim != n_vars)
+    variables[dim] = this->get_time();
+
+  try
+    {
+      for (unsigned int q = 0; q < points.size(); ++q)
+        {
+          for (unsigned int i = 0; i < dim; ++i)
+            variables[i] = points[q][i];
+          values[q] = parser.Eval();
+        }
+    }
+  catch (mu::ParserError &e)
+    {
+      internal::print_parser_error(e);
+      AssertThrow(false, ExcParseError(e.GetCode(), e.GetMsg()));
+    }
+}
+
+
+
+template <int dim>
+void
+FunctionParser<dim>::vector_value_list(
+  const std::vector<Point<dim>> &points,
+  std::vector<Vector<double>> &  values) const
+{
+  Assert(initialized == true, ExcNotInitialized());
+  Assert(values.size() == points.size(),
+         ExcDimensionMismatch(values.size(), points.size()));
+
+  // initialize the parser if that hasn't happened yet on the current thread
+  if (fp.get().size() == 0)
+    init_muparser();
+
+  // look up the thread-local objects only once for all points
+  std::vector<double> &                           variables = vars.get();
+  const std::vector<std::unique_ptr<mu::Parser>> &parsers   = fp.get();
+
+  if (dim != n_vars)
+    variables[dim] = this->get_time();
+
+  try
+    {
+      for (unsigned int q = 0; q < points.size(); ++q)
+        {
+          Assert(values[q].size() == this->n_components,
+                 ExcDimensionMismatch(values[q].size(), this->n_components));
+          for (unsigned int i = 0; i < dim; ++i)
+            variables[i] = points[q][i];
+          for (unsigned int component = 0; component < this->n_components;
+               ++component)
+            values[q](component) = parsers[component]->Eval();
+        }
+    }
+  catch (mu::ParserError &e)
+    {
+      internal::print_parser_error(e);
+      AssertThrow(false, ExcParseError(e.GetCode(), e.GetMsg()));
+    }
+}
+
+
+
+template <int dim>
+VectorizedArray<double>
+FunctionParser<dim>::value(const Point<dim, VectorizedArray<double>> &p,
+                           const unsigned int component) const
+{
+  Assert(initialized == true, ExcNotInitialized());
+  Assert(component < this->n_components,
+         ExcIndexRange(component, 0, this->n_components));
+
+  // initialize the parser if that hasn't happened yet on the current thread
+  if (fp.get().size() == 0)
+    init_muparser();
+
+  std::vector<double> &variables = vars.get();
+  mu::Parser &         parser    = *fp.get()[component];
+
+  if (dim != n_vars)
+    variables[dim] = this->get_time();
+
+  VectorizedArray<double> result;
+  try
+    {
+      for (unsigned int v = 0; v < VectorizedArray<double>::n_array_elements;
+           ++v)
+        {
+          for (unsigned int i = 0; i < dim; ++i)
+            variables[i] = p[i][v];
+          result[v] = parser.Eval();
+        }
+    }
+  catch (mu::ParserError &e)
+    {
+      internal::print_parser_error(e);
+      AssertThrow(false, ExcParseError(e.GetCode(), e.GetMsg()));
+    }
+  return result;
+}
+
 #else
 
 
@@ -532,6 +668,36 @@ FunctionParser<dim>::vector_value(const Point<dim> &, Vector<double> &) const
 }
 
 
+
+template <int dim>
+void
+FunctionParser<dim>::value_list(const std::vector<Point<dim>> &,
+                                std::vector<double> &,
+                                const unsigned int) const
+{
+  Assert(false, ExcNeedsFunctionparser());
+}
+
+
+template <int dim>
+void
+FunctionParser<dim>::vector_value_list(const std::vector<Point<dim>> &,
+                                       std::vector<Vector<double>> &) const
+{
+  Assert(false, ExcNeedsFunctionparser());
+}
+
+
+template <int dim>
+VectorizedArray<double>
+FunctionParser<dim>::value(const Point<dim, VectorizedArray<double>> &,
+                           const unsigned int) const
+{
+  Assert(false, ExcNeedsFunctionparser());
+  return VectorizedArray<double>();
+}
+
+
 #endif
 
 // Explicit Instantiations.
@@ -30,6 +30,42 @@
 DEAL_II_NAMESPACE_OPEN
 
 
+namespace
+{
+  /**
+   * Return the first range in <tt>[first, last)</tt>, a sorted list of
+   * non-overlapping ranges, that ends after @p index. The search starts with
+   * exponentially growing steps from @p first, so that skipping @p k ranges
+   * only costs <tt>O(log k)</tt> operations. This makes merging a set with
+   * few ranges against a set with many ranges cheap.
+   */
+  template <typename Iterator, typename size_type>
+  Iterator
+  skip_ranges_ending_before(Iterator        first,
+                            const Iterator  last,
+                            const size_type index)
+  {
+    if (first == last || first->end > index)
+      return first;
+
+    // find an interval (first + step/2, first + step] that contains the
+    // result, then do a binary search therein
+    std::size_t       step   = 1;
+    const std::size_t n_left = last - first;
+    while (step < n_left && (first + step)->end <= index)
+      step *= 2;
+
+    return std::upper_bound(
+      first + step / 2 + 1,
+      first + std::min(step + 1, n_left),
+      index,
+      [](const size_type value, const typename Iterator::value_type &range) {
+        return value < range.end;
+      });
+  }
+} // namespace
+
+
 
 #ifdef DEAL_II_WITH_TRILINOS
 
@@ -179,6 +215,35 @@ IndexSet::do_compress() const
           largest_range      = i - ranges.begin();
         }
     }
+
+  // set up the lookup table for index sets with many ranges. choose the
+  // bucket size as the smallest power of two for which there are at most an
+  // eighth as many buckets as ranges: more buckets make the lookup only
+  // slightly faster, but make setting up the table considerably more
+  // expensive
+  range_lookup.clear();
+  range_lookup_shift = 0;
+  if (ranges.size() >= 64)
+    {
+      const size_type first_index = ranges.front().begin;
+      const size_type span        = ranges.back().end - first_index;
+      while ((span >> range_lookup_shift) > ranges.size() / 8)
+        ++range_lookup_shift;
+
+      const size_type n_buckets = ((span - 1) >> range_lookup_shift) + 1;
+      range_lookup.resize(n_buckets + 1);
+      unsigned int range = 0;
+      for (size_type bucket = 0; bucket < n_buckets; ++bucket)
+        {
+          const size_type bucket_begin =
+            first_index + (bucket << range_lookup_shift);
+          while (ranges[range].end <= bucket_begin)
+            ++range;
+          range_lookup[bucket] = range;
+        }
+      range_lookup[n_buckets] = ranges.size();
+    }
+
   is_compressed = true;
 
   // check that next_index is correct. needs to be after the previous
@@ -202,11 +267,11 @@ IndexSet IndexSet::operator&(const IndexSet &is) const
   while ((r1 != ranges.end()) && (r2 != is.ranges.end()))
     {
       // if r1 and r2 do not overlap at all, then move the pointer that sits
-      // to the left of the other up by one
+      // to the left of the other up to the first range that might overlap
       if (r1->end <= r2->begin)
-        ++r1;
+        r1 = skip_ranges_ending_before(r1, ranges.cend(), r2->begin);
       else if (r2->end <= r1->begin)
-        ++r2;
+        r2 = skip_ranges_ending_before(r2, is.ranges.cend(), r1->begin);
       else
         {
           // the ranges must overlap somehow
@@ -214,9 +279,10 @@ IndexSet IndexSet::operator&(const IndexSet &is) const
                    ((r2->begin <= r1->begin) && (r2->end > r1->begin)),
                  ExcInternalError());
 
-          // add the overlapping range to the result
-          result.add_range(std::max(r1->begin, r2->begin),
-                           std::min(r1->end, r2->end));
+          // add the overlapping range to the result. the overlaps are found
+          // in ascending order, so we can append them directly
+          result.ranges.emplace_back(std::max(r1->begin, r2->begin),
+                                     std::min(r1->end, r2->end));
 
           // now move that iterator that ends earlier one up. note that it has
           // to be this one because a subsequent range may still have a chance
@@ -228,6 +294,7 @@ IndexSet IndexSet::operator&(const IndexSet &is) const
         }
     }
 
+  result.is_compressed = false;
   result.compress();
   return result;
 }
@@ -268,68 +335,56 @@ IndexSet::subtract_set(const IndexSet &other)
 {
   compress();
   other.compress();
-  is_compressed = false;
 
-
-  // we save new ranges to be added to our IndexSet in an temporary vector and
-  // add all of them in one go at the end.
+  // go through the ranges of both sets in parallel and collect the parts of
+  // our ranges not covered by the ranges of the other set. since both lists
+  // are sorted, the result is sorted as well
   std::vector<Range> new_ranges;
+  new_ranges.reserve(ranges.size());
 
-  std::vector<Range>::iterator own_it   = ranges.begin();
-  std::vector<Range>::iterator other_it = other.ranges.begin();
-
-  while (own_it != ranges.end() && other_it != other.ranges.end())
+  std::vector<Range>::const_iterator own_it   = ranges.cbegin(),
+                                     other_it = other.ranges.cbegin();
+  while (own_it != ranges.cend())
     {
-      // advance own iterator until we get an overlap
-      if (own_it->end <= other_it->begin)
-        {
-          ++own_it;
-          continue;
-        }
-      // we are done with other_it, so advance
-      if (own_it->begin >= other_it->end)
+      // skip the ranges of the other set that lie before the current range
+      other_it =
+        skip_ranges_ending_before(other_it, other.ranges.cend(), own_it->begin);
+      if (other_it == other.ranges.cend())
+        break;
+
+      // copy our ranges that lie before the next range of the other set
+      const std::vector<Range>::const_iterator next =
+        skip_ranges_ending_before(own_it, ranges.cend(), other_it->begin);
+      if (next != own_it)
         {
-          ++other_it;
+          new_ranges.insert(new_ranges.end(), own_it, next);
+          own_it = next;
           continue;
         }
 
-      // Now own_it and other_it overlap.  First save the part of own_it that
-      // is before other_it (if not empty).
-      if (own_it->begin < other_it->begin)
-        {
-          Range r(own_it->begin, other_it->begin);
-          r.nth_index_in_set = 0; // fix warning of unused variable
-          new_ranges.push_back(r);
-        }
-      // change own_it to the sub range behind other_it. Do not delete own_it
-      // in any case. As removal would invalidate iterators, we just shrink
-      // the range to an empty one.
-      own_it->begin = other_it->end;
-      if (own_it->begin > own_it->end)
+      // now the current range overlaps with other_it. cut out all ranges of
+      // the other set that overlap. the last of them might also overlap with
+      // our next range, so do not advance other_it
+      size_type begin = own_it->begin;
+      for (std::vector<Range>::const_iterator it = other_it;
+           it != other.ranges.cend() && it->begin < own_it->end;
+           ++it)
         {
-          own_it->begin = own_it->end;
-          ++own_it;
+          if (it->begin > begin)
+            new_ranges.emplace_back(begin, it->begin);
+          begin = std::max(begin, it->end);
         }
-
-      // continue without advancing iterators, the right one will be advanced
-      // next.
+      if (begin < own_it->end)
+        new_ranges.emplace_back(begin, own_it->end);
+      ++own_it;
     }
 
-  // Now delete all empty ranges we might
-  // have created.
-  for (std::vector<Range>::iterator it = ranges.begin(); it != ranges.end();)
-    {
-      if (it->begin >= it->end)
-        it = ranges.erase(it);
-      else
-        ++it;
-    }
+  // the remaining ranges are not affected
+  new_ranges.insert(new_ranges.end(), own_it, ranges.cend());
 
-  // done, now add the temporary ranges
-  const std::vector<Range>::iterator end = new_ranges.end();
-  for (std::vector<Range>::iterator it = new_ranges.begin(); it != end; ++it)
-    add_range(it->begin, it->end);
+  ranges.swap(new_ranges);
 
+  is_compressed = false;
   compress();
 }
 
@@ -729,6 +784,7 @@ IndexSet::memory_consumption() const
   return (MemoryConsumption::memory_consumption(ranges) +
           MemoryConsumption::memory_consumption(is_compressed) +
           MemoryConsumption::memory_consumption(index_space_size) +
+          MemoryConsumption::memory_consumption(range_lookup) +
           sizeof(compress_mutex));
 }
 
@@ -367,6 +367,15 @@ LogStream::depth_file(const unsigned int n)
 
 
 
+bool
+LogStream::is_output_enabled() const
+{
+  const unsigned int depth = get_prefixes().size();
+  return (depth <= std_depth) || (file != nullptr && depth <= file_depth);
+}
+
+
+
 bool
 LogStream::log_thread_id(const bool flag)
 {
@@ -25,9 +25,14 @@
 #include <deal.II/lac/la_parallel_vector.h>
 #include <deal.II/lac/vector_memory.h>
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <numeric>
 #include <set>
+#include <type_traits>
 #include <vector>
 
 #ifdef DEAL_II_WITH_TRILINOS
@@ -871,8 +876,12 @@ namespace Utilities
     template <typename T1, typename T2>
     ConsensusAlgorithm_NBX<T1, T2>::ConsensusAlgorithm_NBX(
       ConsensusAlgorithmProcess<T1, T2> &process,
-      const MPI_Comm &                   comm)
+      const MPI_Comm &                   comm,
+      const unsigned int                 tag_request,
+      const unsigned int                 tag_delivery)
       : ConsensusAlgorithm<T1, T2>(process, comm)
+      , tag_request(tag_request)
+      , tag_delivery(tag_delivery)
     {}
 
 
@@ -1192,8 +1201,12 @@ namespace Utilities
     template <typename T1, typename T2>
     ConsensusAlgorithm_PEX<T1, T2>::ConsensusAlgorithm_PEX(
       ConsensusAlgorithmProcess<T1, T2> &process,
-      const MPI_Comm &                   comm)
+      const MPI_Comm &                   comm,
+      const unsigned int                 tag_request,
+      const unsigned int                 tag_delivery)
       : ConsensusAlgorithm<T1, T2>(process, comm)
+      , tag_request(tag_request)
+      , tag_delivery(tag_delivery)
     {}
 
 
@@ -1364,28 +1377,675 @@ namespace Utilities
 
 
 
+#ifdef DEAL_II_WITH_MPI
+    namespace
+    {
+      /**
+       * A message from process @p source to process @p target as stored in
+       * the byte buffers of ConsensusAlgorithm_NodeAware. The payload is not
+       * copied, but points into the buffer.
+       */
+      struct ConsensusRecord
+      {
+        unsigned int source;
+        unsigned int target;
+        const char * data;
+        unsigned int n_bytes;
+      };
+
+
+
+      /**
+       * Append a record consisting of the ranks of the sender and receiver,
+       * the size of the payload in bytes, and the payload to @p buffer.
+       */
+      void
+      append_record(std::vector<char> &buffer,
+                    const unsigned int source,
+                    const unsigned int target,
+                    const char *       data,
+                    const unsigned int n_bytes)
+      {
+        const unsigned int header[3] = {source, target, n_bytes};
+        const char *const  header_bytes =
+          reinterpret_cast<const char *>(&header[0]);
+        buffer.insert(buffer.end(), header_bytes, header_bytes + sizeof(header));
+        buffer.insert(buffer.end(), data, data + n_bytes);
+      }
+
+
+
+      template <typename T>
+      void
+      append_record(std::vector<char> &   buffer,
+                    const unsigned int    source,
+                    const unsigned int    target,
+                    const std::vector<T> &payload)
+      {
+        append_record(buffer,
+                      source,
+                      target,
+                      reinterpret_cast<const char *>(payload.data()),
+                      payload.size() * sizeof(T));
+      }
+
+
+
+      void
+      append_record(std::vector<char> &buffer, const ConsensusRecord &record)
+      {
+        append_record(
+          buffer, record.source, record.target, record.data, record.n_bytes);
+      }
+
+
+
+      /**
+       * Split a buffer filled by append_record() into its records.
+       */
+      std::vector<ConsensusRecord>
+      split_records(const std::vector<char> &buffer)
+      {
+        std::vector<ConsensusRecord> records;
+        std::size_t                  position = 0;
+        while (position < buffer.size())
+          {
+            unsigned int header[3];
+            Assert(position + sizeof(header) <= buffer.size(),
+                   ExcInternalError());
+            std::memcpy(&header[0], buffer.data() + position, sizeof(header));
+            position += sizeof(header);
+            records.push_back(
+              {header[0], header[1], buffer.data() + position, header[2]});
+            position += header[2];
+          }
+        Assert(position == buffer.size(), ExcInternalError());
+        return records;
+      }
+
+
+
+      /**
+       * Copy the payload of @p record into a vector of elements of type T.
+       */
+      template <typename T>
+      std::vector<T>
+      unpack_record(const ConsensusRecord &record)
+      {
+        Assert(record.n_bytes % sizeof(T) == 0, ExcInternalError());
+        std::vector<T> payload(record.n_bytes / sizeof(T));
+        if (record.n_bytes > 0)
+          std::memcpy(payload.data(), record.data, record.n_bytes);
+        return payload;
+      }
+
+
+
+      /**
+       * Gather the buffers of all processes of @p node_comm on the process
+       * with rank zero, concatenated in the order of the ranks. The returned
+       * buffer is empty on all other processes.
+       */
+      std::vector<char>
+      gather_on_node_leader(const std::vector<char> &buffer,
+                            const MPI_Comm &         node_comm)
+      {
+        const unsigned int node_rank = this_mpi_process(node_comm);
+        const unsigned int node_size = n_mpi_processes(node_comm);
+
+        int              size = buffer.size();
+        std::vector<int> sizes(node_rank == 0 ? node_size : 0);
+        int ierr = MPI_Gather(
+          &size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, node_comm);
+        AssertThrowMPI(ierr);
+
+        std::vector<int> offsets(sizes.size() + 1, 0);
+        std::partial_sum(sizes.begin(), sizes.end(), offsets.begin() + 1);
+
+        std::vector<char> gathered(offsets.back());
+        ierr = MPI_Gatherv(DEAL_II_MPI_CONST_CAST(buffer.data()),
+                           size,
+                           MPI_CHAR,
+                           gathered.data(),
+                           sizes.data(),
+                           offsets.data(),
+                           MPI_CHAR,
+                           0,
+                           node_comm);
+        AssertThrowMPI(ierr);
+
+        return gathered;
+      }
+
+
+
+      /**
+       * Send the i-th entry of @p buffers, which is only accessed on the
+       * process with rank zero in @p node_comm, to the process with rank i
+       * and return the buffer received by the calling process.
+       */
+      std::vector<char>
+      scatter_from_node_leader(const std::vector<std::vector<char>> &buffers,
+                               const MPI_Comm &node_comm)
+      {
+        const unsigned int node_rank = this_mpi_process(node_comm);
+
+        std::vector<int>  sizes;
+        std::vector<int>  offsets;
+        std::vector<char> send_buffer;
+        if (node_rank == 0)
+          {
+            AssertDimension(buffers.size(), n_mpi_processes(node_comm));
+            offsets.push_back(0);
+            for (const auto &buffer : buffers)
+              {
+                sizes.push_back(buffer.size());
+                offsets.push_back(offsets.back() + buffer.size());
+                send_buffer.insert(send_buffer.end(),
+                                   buffer.begin(),
+                                   buffer.end());
+              }
+          }
+
+        int size = 0;
+        int ierr = MPI_Scatter(
+          sizes.data(), 1, MPI_INT, &size, 1, MPI_INT, 0, node_comm);
+        AssertThrowMPI(ierr);
+
+        std::vector<char> received(size);
+        ierr = MPI_Scatterv(send_buffer.data(),
+                            sizes.data(),
+                            offsets.data(),
+                            MPI_CHAR,
+                            received.data(),
+                            size,
+                            MPI_CHAR,
+                            0,
+                            node_comm);
+        AssertThrowMPI(ierr);
+
+        return received;
+      }
+
+
+
+      /**
+       * Send each buffer in @p outgoing to the node leader given by its key
+       * and receive one buffer from each of the node leaders in @p sources.
+       * A buffer addressed to the calling process is not sent, but copied.
+       */
+      std::map<unsigned int, std::vector<char>>
+      exchange_between_node_leaders(
+        const std::map<unsigned int, std::vector<char>> &outgoing,
+        const std::vector<unsigned int> &                sources,
+        const MPI_Comm &                                 leader_comm,
+        const int                                        tag)
+      {
+        const unsigned int my_node = this_mpi_process(leader_comm);
+
+        std::map<unsigned int, std::vector<char>> incoming;
+
+        std::vector<MPI_Request> send_requests;
+        send_requests.reserve(outgoing.size());
+        for (const auto &message : outgoing)
+          {
+            if (message.first == my_node)
+              {
+                incoming[my_node] = message.second;
+                continue;
+              }
+
+            send_requests.emplace_back();
+            const int ierr =
+              MPI_Isend(DEAL_II_MPI_CONST_CAST(message.second.data()),
+                        message.second.size(),
+                        MPI_CHAR,
+                        message.first,
+                        tag,
+                        leader_comm,
+                        &send_requests.back());
+            AssertThrowMPI(ierr);
+          }
+
+        for (const unsigned int source : sources)
+          {
+            if (source == my_node)
+              continue;
+
+            MPI_Status status;
+            int        ierr = MPI_Probe(source, tag, leader_comm, &status);
+            AssertThrowMPI(ierr);
+
+            int n_bytes;
+            ierr = MPI_Get_count(&status, MPI_CHAR, &n_bytes);
+            AssertThrowMPI(ierr);
+
+            std::vector<char> &buffer = incoming[source];
+            buffer.resize(n_bytes);
+            ierr = MPI_Recv(buffer.data(),
+                            n_bytes,
+                            MPI_CHAR,
+                            source,
+                            tag,
+                            leader_comm,
+                            MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+          }
+
+        const int ierr = MPI_Waitall(send_requests.size(),
+                                     send_requests.data(),
+                                     MPI_STATUSES_IGNORE);
+        AssertThrowMPI(ierr);
+
+        return incoming;
+      }
+
+
+
+      /**
+       * Sort the records received by a node leader by the process of the
+       * node they are addressed to. @p node_members contains the ranks of the
+       * processes of the node in the original communicator, in ascending
+       * order.
+       */
+      std::vector<std::vector<char>>
+      distribute_to_node_members(
+        const std::map<unsigned int, std::vector<char>> &incoming,
+        const std::vector<unsigned int> &                node_members)
+      {
+        std::vector<std::vector<char>> buffers(node_members.size());
+        for (const auto &message : incoming)
+          for (const ConsensusRecord &record : split_records(message.second))
+            {
+              const auto member = std::lower_bound(node_members.begin(),
+                                                   node_members.end(),
+                                                   record.target);
+              Assert(member != node_members.end() && *member == record.target,
+                     ExcInternalError());
+              append_record(buffers[member - node_members.begin()], record);
+            }
+        return buffers;
+      }
+
+
+
+#  if DEAL_II_MPI_VERSION_GTE(3, 0)
+      /**
+       * The communicators and rank maps ConsensusAlgorithm_NodeAware needs
+       * for a given communicator. Setting them up requires a split of the
+       * communicator and an all-gather over all of its processes, so they are
+       * created once per communicator and cached as an attribute of it.
+       */
+      struct NodeAwareCommunicators
+      {
+        /**
+         * The processes of the communicator on the same shared-memory node
+         * as this process.
+         */
+        MPI_Comm node_comm;
+
+        /**
+         * The node leaders, i.e., the processes with rank zero on their node.
+         * MPI_COMM_NULL on processes that are no leaders.
+         */
+        MPI_Comm leader_comm;
+
+        /**
+         * Whether this process is the leader of its node.
+         */
+        bool is_leader;
+
+        /**
+         * For each process of the communicator, the rank of the leader of its
+         * node in @p leader_comm.
+         */
+        std::vector<unsigned int> node_of_rank;
+
+        /**
+         * On the node leader, the ranks of the processes of its node in the
+         * communicator, in ascending order. Empty on all other processes.
+         */
+        std::vector<unsigned int> node_members;
+      };
+
+
+
+      /**
+       * Free the communicators of the NodeAwareCommunicators attached to a
+       * communicator when the communicator is freed.
+       */
+      int
+      delete_node_aware_communicators(MPI_Comm,
+                                      int,
+                                      void *attribute_value,
+                                      void *)
+      {
+        NodeAwareCommunicators *communicators =
+          static_cast<NodeAwareCommunicators *>(attribute_value);
+        if (communicators->leader_comm != MPI_COMM_NULL)
+          MPI_Comm_free(&communicators->leader_comm);
+        MPI_Comm_free(&communicators->node_comm);
+        delete communicators;
+        return MPI_SUCCESS;
+      }
+
+
+
+      /**
+       * Return the NodeAwareCommunicators of @p comm, setting them up when
+       * called for the first time for this communicator. This is a
+       * collective operation in that case.
+       *
+       * The attribute is not copied when the communicator is duplicated,
+       * and freed with the communicator. Since MPI_Finalize() does not free
+       * MPI_COMM_WORLD, the communicators cached for it are never freed.
+       */
+      const NodeAwareCommunicators &
+      get_node_aware_communicators(const MPI_Comm &comm)
+      {
+        static const int keyval = []() {
+          int       keyval;
+          const int ierr =
+            MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN,
+                                   &delete_node_aware_communicators,
+                                   &keyval,
+                                   nullptr);
+          AssertThrowMPI(ierr);
+          return keyval;
+        }();
+
+        void *attribute_value;
+        int   flag;
+        int   ierr = MPI_Comm_get_attr(comm, keyval, &attribute_value, &flag);
+        AssertThrowMPI(ierr);
+        if (flag)
+          return *static_cast<NodeAwareCommunicators *>(attribute_value);
+
+        // set up one communicator per shared-memory node and one of the node
+        // leaders. Each process learns the rank of the leader of each process
+        // in the communicator of the node leaders, and each leader the ranks
+        // of the processes of its node.
+        const unsigned int my_rank = this_mpi_process(comm);
+        std::unique_ptr<NodeAwareCommunicators> communicators(
+          new NodeAwareCommunicators());
+
+        ierr = MPI_Comm_split_type(comm,
+                                   MPI_COMM_TYPE_SHARED,
+                                   my_rank,
+                                   MPI_INFO_NULL,
+                                   &communicators->node_comm);
+        AssertThrowMPI(ierr);
+        communicators->is_leader =
+          (this_mpi_process(communicators->node_comm) == 0);
+
+        ierr = MPI_Comm_split(comm,
+                              communicators->is_leader ? 0 : MPI_UNDEFINED,
+                              my_rank,
+                              &communicators->leader_comm);
+        AssertThrowMPI(ierr);
+
+        unsigned int my_node =
+          communicators->is_leader ?
+            this_mpi_process(communicators->leader_comm) :
+            0;
+        ierr =
+          MPI_Bcast(&my_node, 1, MPI_UNSIGNED, 0, communicators->node_comm);
+        AssertThrowMPI(ierr);
+
+        communicators->node_of_rank.resize(n_mpi_processes(comm));
+        ierr = MPI_Allgather(&my_node,
+                             1,
+                             MPI_UNSIGNED,
+                             communicators->node_of_rank.data(),
+                             1,
+                             MPI_UNSIGNED,
+                             comm);
+        AssertThrowMPI(ierr);
+
+        // since the node communicator is ordered by the rank in the original
+        // communicator, this list is sorted
+        communicators->node_members.resize(
+          communicators->is_leader ?
+            n_mpi_processes(communicators->node_comm) :
+            0);
+        ierr = MPI_Gather(&my_rank,
+                          1,
+                          MPI_UNSIGNED,
+                          communicators->node_members.data(),
+                          1,
+                          MPI_UNSIGNED,
+                          0,
+                          communicators->node_comm);
+        AssertThrowMPI(ierr);
+
+        ierr = MPI_Comm_set_attr(comm, keyval, communicators.get());
+        AssertThrowMPI(ierr);
+        return *communicators.release();
+      }
+#  endif
+    } // namespace
+#endif
+
+
+
+    template <typename T1, typename T2>
+    ConsensusAlgorithm_NodeAware<T1, T2>::ConsensusAlgorithm_NodeAware(
+      ConsensusAlgorithmProcess<T1, T2> &process,
+      const MPI_Comm &                   comm,
+      const unsigned int                 tag_request,
+      const unsigned int                 tag_delivery)
+      : ConsensusAlgorithm<T1, T2>(process, comm)
+      , tag_request(tag_request)
+      , tag_delivery(tag_delivery)
+    {}
+
+
+
+    template <typename T1, typename T2>
+    void
+    ConsensusAlgorithm_NodeAware<T1, T2>::run()
+    {
+#ifdef DEAL_II_WITH_MPI
+#  if DEAL_II_MPI_VERSION_GTE(3, 0)
+      static_assert(std::is_trivially_copyable<T1>::value &&
+                      std::is_trivially_copyable<T2>::value,
+                    "The payload is sent as raw bytes.");
+
+      // 1) get the communicators of the shared-memory nodes and of the node
+      //    leaders, which are only set up in the first call for a
+      //    communicator, see get_node_aware_communicators()
+      const NodeAwareCommunicators &communicators =
+        get_node_aware_communicators(this->comm);
+      const MPI_Comm &node_comm   = communicators.node_comm;
+      const MPI_Comm &leader_comm = communicators.leader_comm;
+      const bool      is_leader   = communicators.is_leader;
+      const std::vector<unsigned int> &node_of_rank =
+        communicators.node_of_rank;
+      const std::vector<unsigned int> &node_members =
+        communicators.node_members;
+
+      // 2) pack the requests of this process
+      const std::vector<unsigned int> targets = this->process.compute_targets();
+      std::vector<char>               requests;
+      for (const unsigned int target : targets)
+        {
+          std::vector<T1> send_buffer;
+          this->process.pack_recv_buffer(target, send_buffer);
+          append_record(requests, this->my_rank, target, send_buffer);
+        }
+
+      // 3) collect the requests on the node leader, send them to the leaders
+      //    of the nodes of their targets as one message per node, and
+      //    distribute them to the targets
+      std::vector<unsigned int> requesting_nodes;
+      std::vector<unsigned int> requested_nodes;
+      std::vector<char>         my_requests;
+      {
+        const std::vector<char> node_requests =
+          gather_on_node_leader(requests, node_comm);
+
+        std::vector<std::vector<char>> member_requests;
+        if (is_leader)
+          {
+            std::map<unsigned int, std::vector<char>> outgoing;
+            for (const ConsensusRecord &record : split_records(node_requests))
+              append_record(outgoing[node_of_rank[record.target]], record);
+
+            // requests between processes of the same node do not leave the
+            // node leader, so the own node is not part of the communication
+            // pattern
+            const unsigned int my_node = this_mpi_process(leader_comm);
+            for (const auto &message : outgoing)
+              if (message.first != my_node)
+                requested_nodes.push_back(message.first);
+            requesting_nodes =
+              compute_point_to_point_communication_pattern(leader_comm,
+                                                           requested_nodes);
+            if (outgoing.find(my_node) != outgoing.end())
+              {
+                requested_nodes.push_back(my_node);
+                requesting_nodes.push_back(my_node);
+              }
+
+            member_requests = distribute_to_node_members(
+              exchange_between_node_leaders(outgoing,
+                                            requesting_nodes,
+                                            leader_comm,
+                                            tag_request),
+              node_members);
+          }
+
+        my_requests = scatter_from_node_leader(member_requests, node_comm);
+      }
+
+      // 4) answer the requests addressed to this process
+      std::vector<char> answers;
+      for (const ConsensusRecord &record : split_records(my_requests))
+        {
+          AssertDimension(record.target, this->my_rank);
+          std::vector<T2> request_buffer;
+          this->process.process_request(record.source,
+                                        unpack_record<T1>(record),
+                                        request_buffer);
+          append_record(answers, this->my_rank, record.source, request_buffer);
+        }
+
+      // 5) send the answers back the same way. Each node leader answers each
+      //    node leader it has received requests from with exactly one
+      //    message, which might be empty if no process of the requesting node
+      //    has sent a request to this node.
+      std::vector<char> my_answers;
+      {
+        const std::vector<char> node_answers =
+          gather_on_node_leader(answers, node_comm);
+
+        std::vector<std::vector<char>> member_answers;
+        if (is_leader)
+          {
+            std::map<unsigned int, std::vector<char>> outgoing;
+            for (const unsigned int node : requesting_nodes)
+              outgoing[node];
+            for (const ConsensusRecord &record : split_records(node_answers))
+              {
+                Assert(outgoing.find(node_of_rank[record.target]) !=
+                         outgoing.end(),
+                       ExcInternalError());
+                append_record(outgoing[node_of_rank[record.target]], record);
+              }
+
+            member_answers = distribute_to_node_members(
+              exchange_between_node_leaders(outgoing,
+                                            requested_nodes,
+                                            leader_comm,
+                                            tag_delivery),
+              node_members);
+          }
+
+        my_answers = scatter_from_node_leader(member_answers, node_comm);
+      }
+
+      // 6) process the answers to the requests of this process
+      for (const ConsensusRecord &record : split_records(my_answers))
+        this->process.unpack_recv_buffer(record.source,
+                                         unpack_record<T2>(record));
+
+#  else
+      AssertThrow(
+        false,
+        ExcMessage(
+          "ConsensusAlgorithm_NodeAware uses MPI 3.0 features. You should compile with at least MPI 3.0."));
+#  endif
+#endif
+    }
+
+
+
+    namespace
+    {
+      /**
+       * Return the tag requested by the user of ConsensusAlgorithmSelector,
+       * or the default tag of the selected implementation if none was given.
+       */
+      inline unsigned int
+      select_tag(const unsigned int requested_tag,
+                 const unsigned int default_tag)
+      {
+        return (requested_tag != numbers::invalid_unsigned_int ? requested_tag :
+                                                                 default_tag);
+      }
+    } // namespace
+
+
+
     template <typename T1, typename T2>
     ConsensusAlgorithmSelector<T1, T2>::ConsensusAlgorithmSelector(
       ConsensusAlgorithmProcess<T1, T2> &process,
-      const MPI_Comm &                   comm)
+      const MPI_Comm &                   comm,
+      const unsigned int                 tag_request,
+      const unsigned int                 tag_delivery)
       : ConsensusAlgorithm<T1, T2>(process, comm)
     {
       // Depending on the number of processes we switch between implementations.
-      // We reduce the threshold for debug mode to be able to test also the
+      // We reduce the thresholds for debug mode to be able to test also the
       // non-blocking implementation. This feature is tested by:
       // tests/multigrid/transfer_matrix_free_06.with_mpi=true.with_p4est=true.with_trilinos=true.mpirun=15.output
 #ifdef DEAL_II_WITH_MPI
 #  if DEAL_II_MPI_VERSION_GTE(3, 0)
 #    ifdef DEBUG
-      if (Utilities::MPI::n_mpi_processes(comm) > 14)
+      const unsigned int nbx_threshold        = 14;
+      const unsigned int node_aware_threshold = 29;
 #    else
-      if (Utilities::MPI::n_mpi_processes(comm) > 99)
+      const unsigned int nbx_threshold        = 99;
+      const unsigned int node_aware_threshold = 4095;
 #    endif
-        consensus_algo.reset(new ConsensusAlgorithm_NBX<T1, T2>(process, comm));
+      const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+      if (n_procs > node_aware_threshold)
+        consensus_algo.reset(new ConsensusAlgorithm_NodeAware<T1, T2>(
+          process,
+          comm,
+          select_tag(tag_request,
+                     ConsensusAlgorithm_NodeAware<T1, T2>::default_tag_request),
+          select_tag(
+            tag_delivery,
+            ConsensusAlgorithm_NodeAware<T1, T2>::default_tag_delivery)));
+      else if (n_procs > nbx_threshold)
+        consensus_algo.reset(new ConsensusAlgorithm_NBX<T1, T2>(
+          process,
+          comm,
+          select_tag(tag_request,
+                     ConsensusAlgorithm_NBX<T1, T2>::default_tag_request),
+          select_tag(tag_delivery,
+                     ConsensusAlgorithm_NBX<T1, T2>::default_tag_delivery)));
       else
 #  endif
 #endif
-        consensus_algo.reset(new ConsensusAlgorithm_PEX<T1, T2>(process, comm));
+        consensus_algo.reset(new ConsensusAlgorithm_PEX<T1, T2>(
+          process,
+          comm,
+          select_tag(tag_request,
+                     ConsensusAlgorithm_PEX<T1, T2>::default_tag_request),
+          select_tag(tag_delivery,
+                     ConsensusAlgorithm_PEX<T1, T2>::default_tag_delivery)));
     }
 
 
@@ -1405,6 +2065,14 @@ namespace Utilities
       {
         static const unsigned int tag_setup = 11;
 
+        /**
+         * The minimal number of indices each process of the dictionary is
+         * responsible for. For small index spaces distributed among many
+         * processes, this puts the dictionary on a few processes only,
+         * rather than spreading very few indices over all of them.
+         */
+        static const types::global_dof_index range_minimum_grain_size = 64;
+
         std::vector<unsigned int> actually_owning_ranks;
 
         types::global_dof_index dofs_per_process;
@@ -1420,83 +2088,69 @@ namespace Utilities
 #ifdef DEAL_II_WITH_MPI
           unsigned int my_rank = this_mpi_process(comm);
 
-          types::global_dof_index              dic_local_rececived = 0;
-          std::map<unsigned int, unsigned int> relevant_procs_map;
-
-          // 2) collect relevant processes and process local dict entries
-          {
-            std::vector<unsigned int> relevant_procs;
-            for (auto i : owned_indices)
-              {
-                unsigned int other_rank = this->dof_to_dict_rank(i);
-                if (other_rank == my_rank)
-                  {
-                    this->actually_owning_ranks[i - this->local_range.first] =
-                      my_rank;
-                    dic_local_rececived++;
-                  }
-                else if (relevant_procs.empty() ||
-                         relevant_procs.back() != other_rank)
-                  relevant_procs.push_back(other_rank);
-              }
-
+          types::global_dof_index dic_local_rececived = 0;
+
+          // 2) split the locally owned intervals at the boundaries of the
+          // ranges of the dictionary processes; the entries of the local
+          // range are filled right away, the others are collected per
+          // process (in ascending order of the rank)
+          std::vector<std::pair<
+            unsigned int,
+            std::vector<
+              std::pair<types::global_dof_index, types::global_dof_index>>>>
+            buffers;
+          for (auto interval = owned_indices.begin_intervals();
+               interval != owned_indices.end_intervals();
+               ++interval)
             {
-              unsigned int c = 0;
-              for (auto i : relevant_procs)
-                relevant_procs_map[i] = c++;
+              const types::global_dof_index interval_end =
+                interval->last() + 1;
+              for (types::global_dof_index begin = *interval->begin();
+                   begin < interval_end;)
+                {
+                  const unsigned int other_rank =
+                    this->dof_to_dict_rank(begin);
+                  const types::global_dof_index end =
+                    std::min(interval_end,
+                             dofs_per_process *
+                               (static_cast<types::global_dof_index>(
+                                  other_rank) +
+                                1));
+                  if (other_rank == my_rank)
+                    {
+                      std::fill(this->actually_owning_ranks.begin() +
+                                  (begin - this->local_range.first),
+                                this->actually_owning_ranks.begin() +
+                                  (end - this->local_range.first),
+                                my_rank);
+                      dic_local_rececived += end - begin;
+                    }
+                  else
+                    {
+                      if (buffers.empty() || buffers.back().first != other_rank)
+                        buffers.emplace_back(
+                          other_rank,
+                          std::vector<std::pair<types::global_dof_index,
+                                                types::global_dof_index>>());
+                      buffers.back().second.emplace_back(begin, end);
+                    }
+                  begin = end;
+                }
             }
-          }
-
-          const unsigned int n_relevant_procs = relevant_procs_map.size();
-          std::vector<std::vector<
-            std::pair<types::global_dof_index, types::global_dof_index>>>
-                                   buffers(n_relevant_procs);
-          std::vector<MPI_Request> request(n_relevant_procs);
 
           // 3) send messages with local dofs to the right dict process
-          {
-            std::vector<std::vector<types::global_dof_index>> temp(
-              n_relevant_procs);
-
-            // collect dofs of each dict process
-            for (auto i : owned_indices)
-              {
-                unsigned int other_rank = this->dof_to_dict_rank(i);
-                if (other_rank != my_rank)
-                  temp[relevant_procs_map[other_rank]].push_back(i);
-              }
-
-            // send dofs to each process
-            for (auto rank_pair : relevant_procs_map)
-              {
-                const int rank  = rank_pair.first;
-                const int index = rank_pair.second;
-
-                // create index set and compress data to be sent
-                auto &   indices_i = temp[index];
-                IndexSet is(this->size);
-                is.add_indices(indices_i.begin(), indices_i.end());
-                is.compress();
-
-                // translate index set to a list of pairs
-                auto &buffer = buffers[index];
-                for (auto interval = is.begin_intervals();
-                     interval != is.end_intervals();
-                     interval++)
-                  buffer.emplace_back(*interval->begin(), interval->last() + 1);
-
-                // send data
-                const auto ierr = MPI_Isend(buffer.data(),
-                                            buffer.size() * 2,
-                                            DEAL_II_DOF_INDEX_MPI_TYPE,
-                                            rank,
-                                            tag_setup,
-                                            comm,
-                                            &request[index]);
-                AssertThrowMPI(ierr);
-              }
-          }
-
+          std::vector<MPI_Request> request(buffers.size());
+          for (unsigned int i = 0; i < buffers.size(); ++i)
+            {
+              const auto ierr = MPI_Isend(buffers[i].second.data(),
+                                          buffers[i].second.size() * 2,
+                                          DEAL_II_DOF_INDEX_MPI_TYPE,
+                                          buffers[i].first,
+                                          tag_setup,
+                                          comm,
+                                          &request[i]);
+              AssertThrowMPI(ierr);
+            }
 
           // 4) receive messages until all dofs in dict are processed
           while (this->local_size != dic_local_rececived)
@@ -1531,19 +2185,19 @@ namespace Utilities
 
               // process message: loop over all intervals
               for (auto interval : buffer)
-                for (types::global_dof_index i = interval.first;
-                     i < interval.second;
-                     i++)
-                  {
-                    this->actually_owning_ranks[i - this->local_range.first] =
-                      other_rank;
-                    dic_local_rececived++;
-                  }
+                {
+                  std::fill(this->actually_owning_ranks.begin() +
+                              (interval.first - this->local_range.first),
+                            this->actually_owning_ranks.begin() +
+                              (interval.second - this->local_range.first),
+                            other_rank);
+                  dic_local_rececived += interval.second - interval.first;
+                }
             }
 
           // 5) make sure that all messages have been sent
           const auto ierr =
-            MPI_Waitall(n_relevant_procs, request.data(), MPI_STATUSES_IGNORE);
+            MPI_Waitall(request.size(), request.data(), MPI_STATUSES_IGNORE);
           AssertThrowMPI(ierr);
 #else
           (void)owned_indices;
@@ -1565,8 +2219,10 @@ namespace Utilities
           const unsigned int n_procs = n_mpi_processes(comm);
           const unsigned int my_rank = this_mpi_process(comm);
 
-          size               = owned_indices.size();
-          dofs_per_process   = (size + n_procs - 1) / n_procs;
+          size             = owned_indices.size();
+          dofs_per_process = (size + n_procs - 1) / n_procs;
+          if (dofs_per_process < range_minimum_grain_size)
+            dofs_per_process = range_minimum_grain_size;
           local_range.first  = std::min(dofs_per_process * my_rank, size);
           local_range.second = std::min(dofs_per_process * (my_rank + 1), size);
           local_size         = local_range.second - local_range.first;
@@ -1752,6 +2408,18 @@ namespace Utilities
     }
 
 #include "mpi.inst"
+
+    // the consensus algorithm used for exchanging untyped data, e.g. in
+    // Particles::ParticleHandler
+    template class ConsensusAlgorithmProcess<char, char>;
+    template class ConsensusAlgorithm_NBX<char, char>;
+
+    // the consensus algorithm used for sending the ghost indices to their
+    // owners in Utilities::MPI::Partitioner::set_ghost_indices()
+    template class ConsensusAlgorithmProcess<types::global_dof_index,
+                                             unsigned int>;
+    template class ConsensusAlgorithmSelector<types::global_dof_index,
+                                              unsigned int>;
   } // end of namespace MPI
 } // end of namespace Utilities
 
@@ -0,0 +1,263 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/grid/filtered_iterator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+
+#include <algorithm>
+#include <map>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Utilities
+{
+  namespace MPI
+  {
+    template <int dim, int spacedim>
+    RemotePointEvaluation<dim, spacedim>::RemotePointEvaluation()
+      : communicator(MPI_COMM_SELF)
+      , unique_mapping(false)
+      , all_found(false)
+    {}
+
+
+
+    template <int dim, int spacedim>
+    void
+    RemotePointEvaluation<dim, spacedim>::reinit(
+      const std::vector<Point<spacedim>> &points,
+      const Triangulation<dim, spacedim> &tria,
+      const Mapping<dim, spacedim> &      mapping)
+    {
+      using active_cell_iterator =
+        typename Triangulation<dim, spacedim>::active_cell_iterator;
+
+      this->tria    = &tria;
+      this->mapping = &mapping;
+
+      const auto parallel_tria =
+        dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(&tria);
+      communicator = (parallel_tria != nullptr) ?
+                       parallel_tria->get_communicator() :
+                       MPI_COMM_SELF;
+      const unsigned int my_rank = this_mpi_process(communicator);
+
+      GridTools::Cache<dim, spacedim> cache(tria, mapping);
+
+      // Locate the points and collect, for each point found in a locally
+      // owned cell, the cell, the reference location, the rank that asked
+      // for the point, and the index of the point on that rank
+      std::vector<active_cell_iterator> entry_cells;
+      std::vector<Point<dim>>           entry_unit_points;
+      std::vector<unsigned int>         entry_ranks;
+      std::vector<unsigned int>         entry_indices;
+      if (n_mpi_processes(communicator) == 1)
+        {
+          const auto result =
+            GridTools::compute_point_locations_batched(cache, points);
+          for (unsigned int c = 0; c < std::get<0>(result).size(); ++c)
+            for (unsigned int q = 0; q < std::get<1>(result)[c].size(); ++q)
+              {
+                entry_cells.push_back(std::get<0>(result)[c]);
+                entry_unit_points.push_back(std::get<1>(result)[c][q]);
+                entry_ranks.push_back(my_rank);
+                entry_indices.push_back(std::get<2>(result)[c][q]);
+              }
+        }
+      else
+        {
+          const std::vector<BoundingBox<spacedim>> local_boxes =
+            GridTools::compute_mesh_predicate_bounding_box(
+              tria,
+              std::function<bool(const active_cell_iterator &)>(
+                IteratorFilters::LocallyOwnedCell()));
+          const auto global_boxes =
+            GridTools::exchange_local_bounding_boxes(local_boxes,
+                                                     communicator);
+          const auto result =
+            GridTools::distributed_compute_point_locations(cache,
+                                                           points,
+                                                           global_boxes);
+          for (unsigned int c = 0; c < std::get<0>(result).size(); ++c)
+            for (unsigned int q = 0; q < std::get<1>(result)[c].size(); ++q)
+              {
+                entry_cells.push_back(std::get<0>(result)[c]);
+                entry_unit_points.push_back(std::get<1>(result)[c][q]);
+                entry_ranks.push_back(std::get<4>(result)[c][q]);
+                entry_indices.push_back(std::get<2>(result)[c][q]);
+              }
+        }
+
+      // Order the evaluation by cells
+      const unsigned int        n_entries = entry_cells.size();
+      std::vector<unsigned int> evaluation_order(n_entries);
+      for (unsigned int i = 0; i < n_entries; ++i)
+        evaluation_order[i] = i;
+      std::stable_sort(evaluation_order.begin(),
+                       evaluation_order.end(),
+                       [&](const unsigned int a, const unsigned int b) {
+                         return entry_cells[a] < entry_cells[b];
+                       });
+
+      cell_data = CellData();
+      cell_data.reference_point_values.reserve(n_entries);
+      for (unsigned int i = 0; i < n_entries; ++i)
+        {
+          const active_cell_iterator &cell = entry_cells[evaluation_order[i]];
+          if (i == 0 || cell != entry_cells[evaluation_order[i - 1]])
+            {
+              cell_data.cells.emplace_back(cell->level(), cell->index());
+              cell_data.reference_point_ptrs.push_back(i);
+            }
+          cell_data.reference_point_values.push_back(
+            entry_unit_points[evaluation_order[i]]);
+        }
+      cell_data.reference_point_ptrs.push_back(n_entries);
+
+      // Sort the evaluated values by the rank they are sent to, and tell
+      // each rank the indices of its points in the order of the values
+      send_permutation.resize(n_entries);
+      for (unsigned int i = 0; i < n_entries; ++i)
+        send_permutation[i] = i;
+      std::stable_sort(send_permutation.begin(),
+                       send_permutation.end(),
+                       [&](const unsigned int a, const unsigned int b) {
+                         return entry_ranks[evaluation_order[a]] <
+                                entry_ranks[evaluation_order[b]];
+                       });
+
+      send_ranks.clear();
+      send_ptrs.clear();
+      std::map<unsigned int, std::vector<unsigned int>> indices_to_send;
+      for (unsigned int i = 0; i < n_entries; ++i)
+        {
+          const unsigned int entry = evaluation_order[send_permutation[i]];
+          if (send_ranks.empty() || send_ranks.back() != entry_ranks[entry])
+            {
+              send_ranks.push_back(entry_ranks[entry]);
+              send_ptrs.push_back(i);
+            }
+          indices_to_send[entry_ranks[entry]].push_back(entry_indices[entry]);
+        }
+      send_ptrs.push_back(n_entries);
+
+      std::map<unsigned int, std::vector<unsigned int>> indices_from_self;
+      const auto self = indices_to_send.find(my_rank);
+      if (self != indices_to_send.end())
+        {
+          indices_from_self[my_rank] = std::move(self->second);
+          indices_to_send.erase(self);
+        }
+      std::map<unsigned int, std::vector<unsigned int>> received_indices =
+        n_mpi_processes(communicator) > 1 ?
+          some_to_some(communicator, indices_to_send) :
+          std::map<unsigned int, std::vector<unsigned int>>();
+      if (!indices_from_self.empty())
+        received_indices[my_rank] = std::move(indices_from_self[my_rank]);
+
+      // Assign each received value its place in the output, with the values
+      // of each point grouped and ordered by the rank of the sender
+      std::vector<unsigned int> n_values_per_point(points.size(), 0);
+      for (const auto &rank_and_indices : received_indices)
+        for (const unsigned int index : rank_and_indices.second)
+          {
+            AssertIndexRange(index, points.size());
+            ++n_values_per_point[index];
+          }
+
+      point_ptrs.resize(points.size() + 1);
+      point_ptrs[0]  = 0;
+      unique_mapping = true;
+      all_found      = true;
+      for (unsigned int i = 0; i < points.size(); ++i)
+        {
+          point_ptrs[i + 1] = point_ptrs[i] + n_values_per_point[i];
+          unique_mapping    = unique_mapping && n_values_per_point[i] == 1;
+          all_found         = all_found && n_values_per_point[i] > 0;
+        }
+
+      recv_ranks.clear();
+      recv_ptrs.clear();
+      recv_permutation.clear();
+      std::fill(n_values_per_point.begin(), n_values_per_point.end(), 0);
+      for (const auto &rank_and_indices : received_indices)
+        {
+          recv_ranks.push_back(rank_and_indices.first);
+          recv_ptrs.push_back(recv_permutation.size());
+          for (const unsigned int index : rank_and_indices.second)
+            recv_permutation.push_back(point_ptrs[index] +
+                                       n_values_per_point[index]++);
+        }
+      recv_ptrs.push_back(recv_permutation.size());
+    }
+
+
+
+    template <int dim, int spacedim>
+    const std::vector<unsigned int> &
+    RemotePointEvaluation<dim, spacedim>::get_point_ptrs() const
+    {
+      return point_ptrs;
+    }
+
+
+
+    template <int dim, int spacedim>
+    bool
+    RemotePointEvaluation<dim, spacedim>::is_map_unique() const
+    {
+      return unique_mapping;
+    }
+
+
+
+    template <int dim, int spacedim>
+    bool
+    RemotePointEvaluation<dim, spacedim>::all_points_found() const
+    {
+      return all_found;
+    }
+
+
+
+    template <int dim, int spacedim>
+    const Triangulation<dim, spacedim> &
+    RemotePointEvaluation<dim, spacedim>::get_triangulation() const
+    {
+      Assert(tria != nullptr, ExcMessage("reinit() has not been called."));
+      return *tria;
+    }
+
+
+
+    template <int dim, int spacedim>
+    const Mapping<dim, spacedim> &
+    RemotePointEvaluation<dim, spacedim>::get_mapping() const
+    {
+      Assert(mapping != nullptr, ExcMessage("reinit() has not been called."));
+      return *mapping;
+    }
+  } // namespace MPI
+} // namespace Utilities
+
+#include "mpi_remote_point_evaluation.inst"
+
+DEAL_II_NAMESPACE_CLOSE
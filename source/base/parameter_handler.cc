@@ -458,6 +458,65 @@ ParameterHandler::parse_input(const std::string &filename,
 
 
 
+void
+ParameterHandler::parse_input(const std::string &filename,
+                              const MPI_Comm &   mpi_communicator,
+                              const std::string &last_line,
+                              const bool         skip_undefined)
+{
+#ifdef DEAL_II_WITH_MPI
+  // read the file on the root process and send its content to all others.
+  // the root sends the length of the content first, or the largest possible
+  // value if the file could not be found
+  const unsigned long long int file_not_found =
+    std::numeric_limits<unsigned long long int>::max();
+  std::string            content;
+  unsigned long long int content_size = 0;
+  if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+    {
+      try
+        {
+          PathSearch        search("PARAMETERS");
+          const std::string openname = search.find(filename);
+          std::ifstream     file_stream(openname.c_str());
+          AssertThrow(file_stream, ExcIO());
+
+          std::ostringstream buffer;
+          buffer << file_stream.rdbuf();
+          content      = buffer.str();
+          content_size = content.size();
+        }
+      catch (const PathSearch::ExcFileNotFound &)
+        {
+          content_size = file_not_found;
+        }
+    }
+
+  int ierr =
+    MPI_Bcast(&content_size, 1, MPI_UNSIGNED_LONG_LONG, 0, mpi_communicator);
+  AssertThrowMPI(ierr);
+
+  AssertThrow(content_size != file_not_found,
+              PathSearch::ExcFileNotFound(filename, "PARAMETERS"));
+
+  content.resize(content_size);
+  if (content_size > 0)
+    {
+      ierr =
+        MPI_Bcast(&content[0], content_size, MPI_CHAR, 0, mpi_communicator);
+      AssertThrowMPI(ierr);
+    }
+
+  std::istringstream input_stream(content);
+  parse_input(input_stream, filename, last_line, skip_undefined);
+#else
+  (void)mpi_communicator;
+  parse_input(filename, last_line, skip_undefined);
+#endif
+}
+
+
+
 void
 ParameterHandler::parse_input_from_string(const std::string &s,
                                           const std::string &last_line,
@@ -621,6 +680,7 @@ void
 ParameterHandler::clear()
 {
   entries = std_cxx14::make_unique<boost::property_tree::ptree>();
+  value_nodes.clear();
 }
 
 
@@ -655,6 +715,9 @@ ParameterHandler::declare_entry(const std::string &          entry,
                  "pattern_description",
                patterns.back()->description());
 
+  value_nodes[get_current_full_path(entry)] = &entries->get_child(
+    get_current_full_path(entry) + path_separator + "value");
+
   // as documented, do the default value checking at the very end
   AssertThrow(pattern.match(default_value),
               ExcValueDoesNotMatchPattern(default_value,
@@ -790,10 +853,18 @@ ParameterHandler::leave_subsection()
 std::string
 ParameterHandler::get(const std::string &entry_string) const
 {
+  const std::string path = get_current_full_path(entry_string);
+
+  // look up the entry in the hash map first. it only misses for entries
+  // that are not declared, or after the tree was deserialized
+  const auto value_node = value_nodes.find(path);
+  if (value_node != value_nodes.end())
+    return value_node->second->data();
+
   // assert that the entry is indeed
   // declared
-  if (boost::optional<std::string> value = entries->get_optional<std::string>(
-        get_current_full_path(entry_string) + path_separator + "value"))
+  if (boost::optional<std::string> value =
+        entries->get_optional<std::string>(path + path_separator + "value"))
     return value.get();
   else
     {
@@ -808,11 +879,17 @@ std::string
 ParameterHandler::get(const std::vector<std::string> &entry_subsection_path,
                       const std::string &             entry_string) const
 {
+  const std::string path =
+    get_current_full_path(entry_subsection_path, entry_string);
+
+  const auto value_node = value_nodes.find(path);
+  if (value_node != value_nodes.end())
+    return value_node->second->data();
+
   // assert that the entry is indeed
   // declared
-  if (boost::optional<std::string> value = entries->get_optional<std::string>(
-        get_current_full_path(entry_subsection_path, entry_string) +
-        path_separator + "value"))
+  if (boost::optional<std::string> value =
+        entries->get_optional<std::string>(path + path_separator + "value"))
     return value.get();
   else
     {
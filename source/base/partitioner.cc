@@ -22,6 +22,130 @@ namespace Utilities
 {
   namespace MPI
   {
+    namespace
+    {
+      /**
+       * Tags of the consensus algorithm in Partitioner::set_ghost_indices(),
+       * different from the default tags used in compute_index_owner().
+       */
+      const unsigned int ghost_exchange_tag_request  = 18;
+      const unsigned int ghost_exchange_tag_delivery = 19;
+
+      /**
+       * The process of the consensus algorithm in
+       * Partitioner::set_ghost_indices(): each processor sends its ghost
+       * indices to their owners, which record them as the indices they need
+       * to send on export. The owners do not answer.
+       */
+      class GhostIndexExchangeProcess
+        : public ConsensusAlgorithmProcess<types::global_dof_index,
+                                           unsigned int>
+      {
+      public:
+        /**
+         * Constructor. The @p ghost_indices are sorted by their owners, which
+         * are given together with the number of indices they own by
+         * @p ghost_targets.
+         */
+        GhostIndexExchangeProcess(
+          const std::vector<std::pair<unsigned int, unsigned int>>
+            &                                         ghost_targets,
+          const std::vector<types::global_dof_index> &ghost_indices)
+          : ghost_targets(ghost_targets)
+          , ghost_indices(ghost_indices)
+        {}
+
+        virtual std::vector<unsigned int>
+        compute_targets() override
+        {
+          std::vector<unsigned int> targets;
+          targets.reserve(ghost_targets.size());
+          unsigned int offset = 0;
+          for (const auto &target : ghost_targets)
+            {
+              targets.push_back(target.first);
+              ranges[target.first] =
+                std::make_pair(offset, offset + target.second);
+              offset += target.second;
+            }
+          return targets;
+        }
+
+        virtual void
+        pack_recv_buffer(
+          const int                             other_rank,
+          std::vector<types::global_dof_index> &send_buffer) override
+        {
+          const auto range = ranges.find(other_rank);
+          Assert(range != ranges.end(), ExcInternalError());
+          send_buffer.assign(ghost_indices.begin() + range->second.first,
+                             ghost_indices.begin() + range->second.second);
+        }
+
+        virtual void
+        process_request(const unsigned int other_rank,
+                        const std::vector<types::global_dof_index> &buffer_recv,
+                        std::vector<unsigned int> &) override
+        {
+          requested_indices[other_rank] = buffer_recv;
+        }
+
+        /**
+         * The indices requested by the other processors, i.e., the indices
+         * this processor sends on export, sorted by the rank of the
+         * requesting processor.
+         */
+        std::map<unsigned int, std::vector<types::global_dof_index>>
+          requested_indices;
+
+      private:
+        const std::vector<std::pair<unsigned int, unsigned int>> &ghost_targets;
+        const std::vector<types::global_dof_index> &              ghost_indices;
+
+        /**
+         * The range of the ghost indices of each owner within
+         * @p ghost_indices.
+         */
+        std::map<unsigned int, std::pair<unsigned int, unsigned int>> ranges;
+      };
+
+
+
+      /**
+       * An entry of the list of partitioners created by
+       * Partitioner::create_shared(). The locally owned and ghost indices
+       * are taken from the partitioner itself. The @p id is the same on all
+       * processors that created the partitioner together, and it increases
+       * with every partitioner created on one processor.
+       */
+      struct SharedPartitionerEntry
+      {
+        MPI_Comm                         communicator;
+        IndexSet                         larger_ghost_index_set;
+        std::weak_ptr<const Partitioner> partitioner;
+        unsigned int                     id;
+      };
+
+      /**
+       * The partitioners created by Partitioner::create_shared(). Only weak
+       * pointers are kept, so that the partitioners are deleted when they
+       * are not used anymore.
+       */
+      std::vector<SharedPartitionerEntry> shared_partitioners;
+
+      /**
+       * A lower bound for the id of the next entry of shared_partitioners.
+       */
+      unsigned int next_shared_partitioner_id = 0;
+
+      /**
+       * A mutex guarding shared_partitioners.
+       */
+      Threads::Mutex shared_partitioners_mutex;
+    } // namespace
+
+
+
     Partitioner::Partitioner()
       : global_size(0)
       , local_range_data(
@@ -33,6 +157,7 @@ namespace Utilities
       , n_procs(1)
       , communicator(MPI_COMM_SELF)
       , have_ghost_indices(false)
+      , shared_memory_exchange_is_initialized(false)
     {}
 
 
@@ -49,6 +174,7 @@ namespace Utilities
       , n_procs(1)
       , communicator(MPI_COMM_SELF)
       , have_ghost_indices(false)
+      , shared_memory_exchange_is_initialized(false)
     {
       locally_owned_range_data.add_range(0, size);
       locally_owned_range_data.compress();
@@ -69,6 +195,7 @@ namespace Utilities
       , n_procs(1)
       , communicator(communicator_in)
       , have_ghost_indices(false)
+      , shared_memory_exchange_is_initialized(false)
     {
       set_owned_indices(locally_owned_indices);
       set_ghost_indices(ghost_indices_in);
@@ -87,12 +214,22 @@ namespace Utilities
       , n_procs(1)
       , communicator(communicator_in)
       , have_ghost_indices(false)
+      , shared_memory_exchange_is_initialized(false)
     {
       set_owned_indices(locally_owned_indices);
     }
 
 
 
+    Partitioner::~Partitioner()
+    {
+#ifdef DEAL_II_WITH_MPI
+      free_persistent_requests();
+#endif
+    }
+
+
+
     void
     Partitioner::reinit(const IndexSet &vector_space_vector_index_set,
                         const IndexSet &read_write_vector_index_set,
@@ -109,6 +246,11 @@ namespace Utilities
     void
     Partitioner::set_owned_indices(const IndexSet &locally_owned_indices)
     {
+#ifdef DEAL_II_WITH_MPI
+      free_persistent_requests();
+#endif
+      shared_memory_exchange_is_initialized = false;
+
       if (Utilities::MPI::job_supports_mpi() == true)
         {
           my_pid  = Utilities::MPI::this_mpi_process(communicator);
@@ -151,6 +293,11 @@ namespace Utilities
     Partitioner::set_ghost_indices(const IndexSet &ghost_indices_in,
                                    const IndexSet &larger_ghost_index_set)
     {
+#ifdef DEAL_II_WITH_MPI
+      free_persistent_requests();
+#endif
+      shared_memory_exchange_is_initialized = false;
+
       // Set ghost indices from input. To be sure that no entries from the
       // locally owned range are present, subtract the locally owned indices
       // in any case.
@@ -180,9 +327,6 @@ namespace Utilities
       // the processors the ghost indices actually belong to, and the indices
       // that are locally held but ghost indices of other processors. This
       // allows then to import and export data very easily.
-
-      // find out the end index for each processor and communicate it (this
-      // implies the start index for the next processor)
 #ifdef DEAL_II_WITH_MPI
       if (n_procs < 2)
         {
@@ -192,48 +336,43 @@ namespace Utilities
           return;
         }
 
-      std::vector<types::global_dof_index> first_index(n_procs + 1);
-      // Allow non-zero start index for the vector. send this data to all
-      // processors
-      first_index[0] = local_range_data.first;
-      int ierr       = MPI_Bcast(
-        first_index.data(), 1, DEAL_II_DOF_INDEX_MPI_TYPE, 0, communicator);
-      AssertThrowMPI(ierr);
-
-      // Get the end-of-local_range for all processors
-      ierr = MPI_Allgather(&local_range_data.second,
-                           1,
-                           DEAL_II_DOF_INDEX_MPI_TYPE,
-                           &first_index[1],
-                           1,
-                           DEAL_II_DOF_INDEX_MPI_TYPE,
-                           communicator);
-      AssertThrowMPI(ierr);
-      first_index[n_procs] = global_size;
-
       // fix case when there are some processors without any locally owned
-      // indices: then there might be a zero in some entries. The reason
-      // is that local_range_data will contain [0,0) and second index is
-      // incorrect inside the Allgather'ed first_index. Below we fix this
-      // by ensuring that the start point is always the end index of the
-      // processor immediately before.
+      // indices: then local_range_data contains [0,0), whereas the start
+      // point should be the end index of the processor immediately
+      // before. We get the latter as the maximum over the end indices of all
+      // processors before this one by a prefix reduction, rather than by
+      // gathering the ranges of all processors (which would need memory
+      // proportional to the number of processors). Allow non-zero start
+      // index for the vector, which is the start index of the first
+      // processor.
       if (global_size > 0)
         {
-          for (unsigned int i = 1; i < n_procs; ++i)
-            if (first_index[i] == 0)
-              first_index[i] = first_index[i - 1];
+          types::global_dof_index first_index = local_range_data.first;
+          int                     ierr        = MPI_Bcast(
+            &first_index, 1, DEAL_II_DOF_INDEX_MPI_TYPE, 0, communicator);
+          AssertThrowMPI(ierr);
+
+          types::global_dof_index end_of_previous = 0;
+          ierr = MPI_Exscan(&local_range_data.second,
+                            &end_of_previous,
+                            1,
+                            DEAL_II_DOF_INDEX_MPI_TYPE,
+                            MPI_MAX,
+                            communicator);
+          AssertThrowMPI(ierr);
+          // the result of MPI_Exscan is undefined on the first processor
+          if (my_pid > 0)
+            first_index = std::max(first_index, end_of_previous);
 
           // correct if our processor has a wrong local range
-          if (first_index[my_pid] != local_range_data.first)
+          if (first_index != local_range_data.first)
             {
               Assert(local_range_data.first == local_range_data.second,
                      ExcInternalError());
-              local_range_data.first = local_range_data.second =
-                first_index[my_pid];
+              local_range_data.first = local_range_data.second = first_index;
             }
         }
 
-      unsigned int n_ghost_targets = 0;
       {
         const auto index_owner =
           Utilities::MPI::compute_index_owner(this->locally_owned_range_data,
@@ -256,93 +395,51 @@ namespace Utilities
                   ghost_targets_data.emplace_back(i, 1);
               }
           }
-
-        n_ghost_targets = ghost_targets_data.size();
       }
-      // find the processes that want to import to me
-      {
-        std::vector<int> send_buffer(n_procs, 0);
-        std::vector<int> receive_buffer(n_procs, 0);
-        for (unsigned int i = 0; i < n_ghost_targets; i++)
-          send_buffer[ghost_targets_data[i].first] =
-            ghost_targets_data[i].second;
-
-        const int ierr = MPI_Alltoall(send_buffer.data(),
-                                      1,
-                                      MPI_INT,
-                                      receive_buffer.data(),
-                                      1,
-                                      MPI_INT,
-                                      communicator);
-        AssertThrowMPI(ierr);
 
-        // allocate memory for import data
-        std::vector<std::pair<unsigned int, unsigned int>> import_targets_temp;
-        n_import_indices_data = 0;
-        for (unsigned int i = 0; i < n_procs; i++)
-          if (receive_buffer[i] > 0)
-            {
-              n_import_indices_data += receive_buffer[i];
-              import_targets_temp.emplace_back(i, receive_buffer[i]);
-            }
-        // copy, don't move, to get deterministic memory usage.
-        import_targets_data = import_targets_temp;
-      }
-
-      // now that we know how many indices each process will receive from
-      // ghosts, send and receive indices for import data. non-blocking receives
-      // and blocking sends
+      // send the ghost indices to their owners, which need to send the
+      // values of these indices on export (the import indices in the
+      // nomenclature of this class). the consensus algorithm makes the
+      // owners find out who sends them indices without an all-to-all
+      // communication, which would take time and memory proportional to
+      // the number of processors.
       {
-        std::vector<types::global_dof_index> expanded_import_indices(
-          n_import_indices_data);
-        unsigned int             current_index_start = 0;
-        std::vector<MPI_Request> import_requests(import_targets_data.size() +
-                                                 n_ghost_targets);
-        for (unsigned int i = 0; i < import_targets_data.size(); i++)
-          {
-            const int ierr =
-              MPI_Irecv(&expanded_import_indices[current_index_start],
-                        import_targets_data[i].second,
-                        DEAL_II_DOF_INDEX_MPI_TYPE,
-                        import_targets_data[i].first,
-                        import_targets_data[i].first,
-                        communicator,
-                        &import_requests[i]);
-            AssertThrowMPI(ierr);
-            current_index_start += import_targets_data[i].second;
-          }
-        AssertDimension(current_index_start, n_import_indices_data);
-
-        // use non-blocking send for ghost indices stored in
-        // expanded_ghost_indices
         std::vector<types::global_dof_index> expanded_ghost_indices;
         if (n_ghost_indices_data > 0)
           ghost_indices_data.fill_index_vector(expanded_ghost_indices);
 
-        current_index_start = 0;
-        for (unsigned int i = 0; i < n_ghost_targets; i++)
-          {
-            const int ierr =
-              MPI_Isend(&expanded_ghost_indices[current_index_start],
-                        ghost_targets_data[i].second,
-                        DEAL_II_DOF_INDEX_MPI_TYPE,
-                        ghost_targets_data[i].first,
-                        my_pid,
-                        communicator,
-                        &import_requests[import_targets_data.size() + i]);
-            AssertThrowMPI(ierr);
-            current_index_start += ghost_targets_data[i].second;
-          }
-        AssertDimension(current_index_start, n_ghost_indices_data);
+        // the consensus algorithms receive their requests from any
+        // processor, so use tags different from the ones of the consensus
+        // algorithm in compute_index_owner(): some processors might still
+        // answer requests of that one while others have already started
+        // this one, and vice versa with the one of a subsequent call
+        GhostIndexExchangeProcess process(ghost_targets_data,
+                                          expanded_ghost_indices);
+        ConsensusAlgorithmSelector<types::global_dof_index, unsigned int>
+          consensus_algorithm(process,
+                              communicator,
+                              ghost_exchange_tag_request,
+                              ghost_exchange_tag_delivery);
+        consensus_algorithm.run();
 
-        // wait for all import from other processes to be done
-        if (import_requests.size() > 0)
+        // allocate memory for import data
+        std::vector<std::pair<unsigned int, unsigned int>> import_targets_temp;
+        n_import_indices_data = 0;
+        for (const auto &request : process.requested_indices)
           {
-            const int ierr = MPI_Waitall(import_requests.size(),
-                                         import_requests.data(),
-                                         MPI_STATUSES_IGNORE);
-            AssertThrowMPI(ierr);
+            n_import_indices_data += request.second.size();
+            import_targets_temp.emplace_back(request.first,
+                                             request.second.size());
           }
+        // copy, don't move, to get deterministic memory usage.
+        import_targets_data = import_targets_temp;
+
+        std::vector<types::global_dof_index> expanded_import_indices;
+        expanded_import_indices.reserve(n_import_indices_data);
+        for (const auto &request : process.requested_indices)
+          expanded_import_indices.insert(expanded_import_indices.end(),
+                                         request.second.begin(),
+                                         request.second.end());
 
         // transform import indices to local index space and compress
         // contiguous indices in form of ranges
@@ -478,6 +575,88 @@ namespace Utilities
 
 
 
+    std::shared_ptr<const Partitioner>
+    Partitioner::create_shared(const IndexSet &locally_owned_indices,
+                               const IndexSet &ghost_indices_in,
+                               const MPI_Comm  communicator,
+                               const IndexSet &larger_ghost_index_set)
+    {
+      // the ghost indices as they are stored by set_ghost_indices()
+      IndexSet ghost_indices(locally_owned_indices.size());
+      if (ghost_indices_in.n_elements() > 0)
+        ghost_indices = ghost_indices_in;
+      ghost_indices.subtract_set(locally_owned_indices);
+      ghost_indices.compress();
+
+      // find the most recently created partitioner with this layout
+      std::shared_ptr<const Partitioner> partitioner;
+      unsigned int                       id = numbers::invalid_unsigned_int;
+      {
+        std::lock_guard<std::mutex> lock(shared_partitioners_mutex);
+        for (auto entry = shared_partitioners.begin();
+             entry != shared_partitioners.end();)
+          {
+            std::shared_ptr<const Partitioner> candidate =
+              entry->partitioner.lock();
+            if (candidate == nullptr)
+              {
+                entry = shared_partitioners.erase(entry);
+                continue;
+              }
+            if (entry->communicator == communicator &&
+                (partitioner == nullptr || entry->id > id) &&
+                candidate->size() == locally_owned_indices.size() &&
+                entry->larger_ghost_index_set.size() ==
+                  larger_ghost_index_set.size() &&
+                candidate->locally_owned_range() == locally_owned_indices &&
+                candidate->ghost_indices() == ghost_indices &&
+                entry->larger_ghost_index_set == larger_ghost_index_set)
+              {
+                partitioner = candidate;
+                id          = entry->id;
+              }
+            ++entry;
+          }
+      }
+
+      // an existing partitioner can only be used if all processors found
+      // the same one, i.e., one that they have created together, because
+      // the import indices of a partitioner depend on the ghost indices of
+      // all processors at the time of its creation. the minimum and the
+      // maximum of the ids are computed in a single reduction
+      std::vector<unsigned int> ids = {id,
+                                       partitioner != nullptr ?
+                                         numbers::invalid_unsigned_int - id :
+                                         0};
+      Utilities::MPI::min(ids, communicator, ids);
+      if (ids[0] != numbers::invalid_unsigned_int &&
+          ids[0] == numbers::invalid_unsigned_int - ids[1])
+        return partitioner;
+
+      auto new_partitioner =
+        std::make_shared<Partitioner>(locally_owned_indices, communicator);
+      new_partitioner->set_ghost_indices(ghost_indices, larger_ghost_index_set);
+
+      // all processors agree on the id of the new partitioner, which is
+      // larger than the ids of all partitioners created before on any of
+      // them
+      unsigned int new_id = 0;
+      {
+        std::lock_guard<std::mutex> lock(shared_partitioners_mutex);
+        new_id = next_shared_partitioner_id;
+      }
+      new_id = Utilities::MPI::max(new_id, communicator);
+
+      std::lock_guard<std::mutex> lock(shared_partitioners_mutex);
+      next_shared_partitioner_id =
+        std::max(next_shared_partitioner_id, new_id + 1);
+      shared_partitioners.push_back(
+        {communicator, larger_ghost_index_set, new_partitioner, new_id});
+      return new_partitioner;
+    }
+
+
+
     bool
     Partitioner::is_compatible(const Partitioner &part) const
     {
@@ -530,9 +709,254 @@ namespace Utilities
       memory +=
         MemoryConsumption::memory_consumption(ghost_indices_subset_data);
       memory += MemoryConsumption::memory_consumption(ghost_indices_data);
+#ifdef DEAL_II_WITH_MPI
+      memory += MemoryConsumption::memory_consumption(ghost_targets_sm_rank);
+      memory += MemoryConsumption::memory_consumption(ghost_indices_sm_ranges);
+      memory += MemoryConsumption::memory_consumption(
+        ghost_indices_sm_ranges_by_target);
+      memory += MemoryConsumption::memory_consumption(import_targets_sm_rank);
+      memory +=
+        MemoryConsumption::memory_consumption(import_targets_sm_offset);
+#endif
       return memory;
     }
 
+
+
+#ifdef DEAL_II_WITH_MPI
+    void
+    Partitioner::initialize_shared_memory_exchange(
+      const MPI_Comm &communicator_sm_in) const
+    {
+      if (shared_memory_exchange_is_initialized &&
+          communicator_sm == communicator_sm_in)
+        return;
+
+      communicator_sm = communicator_sm_in;
+      const unsigned int n_procs_sm =
+        Utilities::MPI::n_mpi_processes(communicator_sm);
+
+      // translate the ranks of the communication partners into the ranks
+      // within the shared-memory communicator
+      MPI_Group group, group_sm;
+      int       ierr = MPI_Comm_group(communicator, &group);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Comm_group(communicator_sm, &group_sm);
+      AssertThrowMPI(ierr);
+      const auto translate_ranks =
+        [&](const std::vector<std::pair<unsigned int, unsigned int>> &targets,
+            std::vector<unsigned int> &ranks_sm) {
+          std::vector<int> ranks(targets.size()), translated(targets.size());
+          for (unsigned int i = 0; i < targets.size(); ++i)
+            ranks[i] = targets[i].first;
+          if (targets.size() > 0)
+            {
+              ierr = MPI_Group_translate_ranks(group,
+                                               ranks.size(),
+                                               ranks.data(),
+                                               group_sm,
+                                               translated.data());
+              AssertThrowMPI(ierr);
+            }
+          ranks_sm.resize(targets.size());
+          for (unsigned int i = 0; i < targets.size(); ++i)
+            ranks_sm[i] = translated[i] == MPI_UNDEFINED ?
+                            numbers::invalid_unsigned_int :
+                            translated[i];
+        };
+      translate_ranks(ghost_targets_data, ghost_targets_sm_rank);
+      translate_ranks(import_targets_data, import_targets_sm_rank);
+      ierr = MPI_Group_free(&group);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Group_free(&group_sm);
+      AssertThrowMPI(ierr);
+
+      // collect the locally owned ranges of the processes on the node to
+      // translate our ghost indices into their local index space
+      std::vector<types::global_dof_index> ranges_sm(2 * n_procs_sm);
+      types::global_dof_index my_range[2] = {local_range_data.first,
+                                             local_range_data.second};
+      ierr = MPI_Allgather(my_range,
+                           2,
+                           DEAL_II_DOF_INDEX_MPI_TYPE,
+                           ranges_sm.data(),
+                           2,
+                           DEAL_II_DOF_INDEX_MPI_TYPE,
+                           communicator_sm);
+      AssertThrowMPI(ierr);
+
+      // for each process on the node, determine the position in our ghost
+      // array where its data ends up, which is where it reads the data from
+      // in import_from_ghosted_array_finish()
+      std::vector<unsigned int> ghost_offsets(n_procs_sm,
+                                              numbers::invalid_unsigned_int);
+      ghost_indices_sm_ranges.clear();
+      ghost_indices_sm_ranges_by_target.resize(1, 0);
+      unsigned int offset = local_size();
+      for (unsigned int i = 0; i < ghost_targets_data.size(); ++i)
+        {
+          const unsigned int rank_sm = ghost_targets_sm_rank[i];
+          if (rank_sm != numbers::invalid_unsigned_int)
+            {
+              ghost_offsets[rank_sm] = offset;
+              const IndexSet ghosts_of_rank =
+                ghost_indices_data.get_view(ranges_sm[2 * rank_sm],
+                                            ranges_sm[2 * rank_sm + 1]);
+              AssertDimension(ghosts_of_rank.n_elements(),
+                              ghost_targets_data[i].second);
+              for (IndexSet::IntervalIterator interval =
+                     ghosts_of_rank.begin_intervals();
+                   interval != ghosts_of_rank.end_intervals();
+                   ++interval)
+                ghost_indices_sm_ranges.emplace_back(*interval->begin(),
+                                                     interval->last() + 1);
+            }
+          ghost_indices_sm_ranges_by_target.push_back(
+            ghost_indices_sm_ranges.size());
+          offset += ghost_targets_data[i].second;
+        }
+
+      std::vector<unsigned int> import_offsets(n_procs_sm);
+      ierr = MPI_Alltoall(ghost_offsets.data(),
+                          1,
+                          MPI_UNSIGNED,
+                          import_offsets.data(),
+                          1,
+                          MPI_UNSIGNED,
+                          communicator_sm);
+      AssertThrowMPI(ierr);
+      import_targets_sm_offset.resize(import_targets_data.size());
+      for (unsigned int i = 0; i < import_targets_data.size(); ++i)
+        if (import_targets_sm_rank[i] != numbers::invalid_unsigned_int)
+          {
+            import_targets_sm_offset[i] =
+              import_offsets[import_targets_sm_rank[i]];
+            Assert(import_targets_sm_offset[i] !=
+                     numbers::invalid_unsigned_int,
+                   ExcInternalError());
+          }
+        else
+          import_targets_sm_offset[i] = numbers::invalid_unsigned_int;
+
+      shared_memory_exchange_is_initialized = true;
+    }
+
+
+
+    bool
+    Partitioner::get_persistent_requests(
+      const void *                                           receive_buffer,
+      const void *                                           send_buffer,
+      const unsigned int                                     channel,
+      const unsigned int                                     bytes_per_entry,
+      const std::function<void(std::vector<MPI_Request> &)> &setup_requests,
+      std::vector<MPI_Request> &                             requests) const
+    {
+      // Limit the number of cached sets of requests: Every set keeps MPI
+      // resources alive, and arrays that are only used for a single exchange
+      // (e.g. temporary vectors) would otherwise fill the cache with entries
+      // that are never reused.
+      const std::size_t max_n_request_sets = 32;
+
+      const auto key = std::make_tuple(receive_buffer,
+                                       send_buffer,
+                                       channel,
+                                       bytes_per_entry);
+
+      Threads::Mutex::ScopedLock lock(persistent_requests_mutex);
+      auto                       it = persistent_requests.find(key);
+      if (it == persistent_requests.end())
+        {
+          if (persistent_requests.size() >= max_n_request_sets)
+            return false;
+          it = persistent_requests
+                 .emplace(key, std::vector<MPI_Request>(requests.size()))
+                 .first;
+          setup_requests(it->second);
+        }
+      requests = it->second;
+      return true;
+    }
+
+
+
+    void
+    Partitioner::free_persistent_requests()
+    {
+      Threads::Mutex::ScopedLock lock(persistent_requests_mutex);
+
+      // the partitioner might be destroyed after MPI_Finalize() in which case
+      // the requests are gone anyway
+      int       finalized = 0;
+      const int ierr      = MPI_Finalized(&finalized);
+      AssertNothrow(ierr == MPI_SUCCESS, ExcMPI(ierr));
+      if (finalized == 0)
+        for (auto &entry : persistent_requests)
+          for (MPI_Request &request : entry.second)
+            {
+              const int ierr = MPI_Request_free(&request);
+              AssertNothrow(ierr == MPI_SUCCESS, ExcMPI(ierr));
+              (void)ierr;
+            }
+      (void)ierr;
+      persistent_requests.clear();
+    }
+
+
+
+    unsigned int
+    Partitioner::export_to_ghosted_array_wait_any(
+      std::vector<MPI_Request> &requests) const
+    {
+      const unsigned int n_ghost_targets = ghost_targets_data.size();
+      if (requests.size() == 0 || n_ghost_targets == 0)
+        return numbers::invalid_unsigned_int;
+      Assert(requests.size() == n_ghost_targets + import_targets_data.size(),
+             ExcMessage("Waiting for individual processes is not supported "
+                        "for exchanges through shared memory."));
+
+      // the receives come first in the list of requests. completed requests
+      // are either null or inactive persistent requests, which are both
+      // skipped by MPI_Waitany
+      int       index = MPI_UNDEFINED;
+      const int ierr  = MPI_Waitany(n_ghost_targets,
+                                   requests.data(),
+                                   &index,
+                                   MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+      return index == MPI_UNDEFINED ? numbers::invalid_unsigned_int :
+                                      static_cast<unsigned int>(index);
+    }
+
+
+
+    void
+    Partitioner::free_requests(std::vector<MPI_Request> &requests) const
+    {
+      {
+        // the requests of an interrupted exchange must not be started again,
+        // so remove them from the cache. The copies in the cache and in
+        // 'requests' refer to the same MPI objects, so free them only once.
+        Threads::Mutex::ScopedLock lock(persistent_requests_mutex);
+        for (auto it = persistent_requests.begin();
+             it != persistent_requests.end();
+             ++it)
+          if (it->second == requests)
+            {
+              persistent_requests.erase(it);
+              break;
+            }
+      }
+
+      for (MPI_Request &request : requests)
+        {
+          const int ierr = MPI_Request_free(&request);
+          AssertThrowMPI(ierr);
+        }
+      requests.clear();
+    }
+#endif
+
   } // end of namespace MPI
 
 } // end of namespace Utilities
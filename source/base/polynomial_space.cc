@@ -16,6 +16,9 @@
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/polynomial_space.h>
 #include <deal.II/base/table.h>
+#include <deal.II/base/vectorization.h>
+
+#include <array>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -396,6 +399,121 @@ PolynomialSpace<dim>::compute(
 }
 
 
+template <int dim>
+void
+PolynomialSpace<dim>::evaluate(const std::vector<Point<dim>> &unit_points,
+                               Table<2, double> &             values,
+                               Table<2, Tensor<1, dim>> &     grads,
+                               Table<2, Tensor<2, dim>> &     grad_grads) const
+{
+  const unsigned int n_1d     = polynomials.size();
+  const unsigned int n_points = unit_points.size();
+
+  Assert(values.n_rows() == 0 ||
+           (values.n_rows() == n_pols && values.n_cols() == n_points),
+         ExcDimensionMismatch2(values.n_rows(), n_pols, 0));
+  Assert(grads.n_rows() == 0 ||
+           (grads.n_rows() == n_pols && grads.n_cols() == n_points),
+         ExcDimensionMismatch2(grads.n_rows(), n_pols, 0));
+  Assert(grad_grads.n_rows() == 0 ||
+           (grad_grads.n_rows() == n_pols && grad_grads.n_cols() == n_points),
+         ExcDimensionMismatch2(grad_grads.n_rows(), n_pols, 0));
+
+  const bool update_values     = (values.n_rows() == n_pols),
+             update_grads      = (grads.n_rows() == n_pols),
+             update_grad_grads = (grad_grads.n_rows() == n_pols);
+
+  unsigned int v_size = 0;
+  if (update_values)
+    v_size = 1;
+  if (update_grads)
+    v_size = 2;
+  if (update_grad_grads)
+    v_size = 3;
+  if (v_size == 0 || n_points == 0)
+    return;
+
+  constexpr unsigned int n_lanes = VectorizedArray<double>::n_array_elements;
+
+  // values (and derivatives) of the 1D polynomials for all the points of
+  // the current batch, accessed as v[d][n][o] with
+  //  d: coordinate direction
+  //  n: number of 1d polynomial
+  //  o: order of derivative
+  // directions beyond dim are set to one, so that the products below can be
+  // written for three dimensions
+  Table<2, std::array<VectorizedArray<double>, 3>> v(3, n_1d);
+  for (unsigned int d = dim; d < 3; ++d)
+    for (unsigned int i = 0; i < n_1d; ++i)
+      v(d, i).fill(make_vectorized_array(0.));
+  for (unsigned int d = dim; d < 3; ++d)
+    v(d, 0)[0] = make_vectorized_array(1.);
+  std::array<double, 3> point_values;
+
+  for (unsigned int q0 = 0; q0 < n_points; q0 += n_lanes)
+    {
+      const unsigned int n_filled = std::min(n_lanes, n_points - q0);
+
+      // unused lanes of the last batch simply repeat the last point
+      for (unsigned int d = 0; d < dim; ++d)
+        for (unsigned int i = 0; i < n_1d; ++i)
+          for (unsigned int l = 0; l < n_lanes; ++l)
+            {
+              polynomials[i].value(
+                unit_points[q0 + std::min(l, n_filled - 1)][d],
+                v_size - 1,
+                point_values.data());
+              for (unsigned int o = 0; o < v_size; ++o)
+                v(d, i)[o][l] = point_values[o];
+            }
+
+      unsigned int k = 0;
+      for (unsigned int iz = 0; iz < ((dim > 2) ? n_1d : 1); ++iz)
+        for (unsigned int iy = 0; iy < ((dim > 1) ? n_1d - iz : 1); ++iy)
+          for (unsigned int ix = 0; ix < n_1d - iy - iz; ++ix)
+            {
+              const unsigned int k2 = index_map_inverse[k++];
+
+              if (update_values)
+                {
+                  const VectorizedArray<double> value =
+                    v(0, ix)[0] * v(1, iy)[0] * v(2, iz)[0];
+                  for (unsigned int l = 0; l < n_filled; ++l)
+                    values[k2][q0 + l] = value[l];
+                }
+
+              if (update_grads)
+                for (unsigned int d = 0; d < dim; ++d)
+                  {
+                    const VectorizedArray<double> grad =
+                      v(0, ix)[(d == 0) ? 1 : 0] * v(1, iy)[(d == 1) ? 1 : 0] *
+                      v(2, iz)[(d == 2) ? 1 : 0];
+                    for (unsigned int l = 0; l < n_filled; ++l)
+                      grads[k2][q0 + l][d] = grad[l];
+                  }
+
+              if (update_grad_grads)
+                for (unsigned int d1 = 0; d1 < dim; ++d1)
+                  for (unsigned int d2 = d1; d2 < dim; ++d2)
+                    {
+                      // derivative order for each direction
+                      const unsigned int j0 = (d1 == 0) + (d2 == 0);
+                      const unsigned int j1 = (d1 == 1) + (d2 == 1);
+                      const unsigned int j2 = (d1 == 2) + (d2 == 2);
+
+                      const VectorizedArray<double> der2 =
+                        v(0, ix)[j0] * v(1, iy)[j1] * v(2, iz)[j2];
+                      for (unsigned int l = 0; l < n_filled; ++l)
+                        {
+                          grad_grads[k2][q0 + l][d1][d2] = der2[l];
+                          grad_grads[k2][q0 + l][d2][d1] = der2[l];
+                        }
+                    }
+            }
+    }
+}
+
+
 template class PolynomialSpace<1>;
 template class PolynomialSpace<2>;
 template class PolynomialSpace<3>;
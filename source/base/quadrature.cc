@@ -22,7 +22,10 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <functional>
 #include <iterator>
+#include <map>
+#include <mutex>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -835,61 +838,130 @@ QProjector<2>::project_to_all_faces(const SubQuadrature &quadrature)
 
 
 
-template <>
-Quadrature<3>
-QProjector<3>::project_to_all_faces(const SubQuadrature &quadrature)
+namespace internal
 {
-  const unsigned int dim = 3;
+  namespace QProjectorImplementation
+  {
+    /**
+     * A cache for the cell quadrature formulas generated by
+     * QProjector<3>::project_to_all_faces(), indexed by the points and
+     * weights of the face quadrature formula they were generated from.
+     * The number of cached formulas is bounded to not accumulate memory in
+     * applications that use many different face quadratures.
+     */
+    class AllFacesCache
+    {
+    public:
+      Quadrature<3>
+      get(const Quadrature<2> &                                      quadrature,
+          const std::function<Quadrature<3>(const Quadrature<2> &)> &compute)
+      {
+        std::vector<double> key;
+        key.reserve(3 * quadrature.size());
+        for (unsigned int q = 0; q < quadrature.size(); ++q)
+          {
+            key.push_back(quadrature.point(q)[0]);
+            key.push_back(quadrature.point(q)[1]);
+            key.push_back(quadrature.weight(q));
+          }
 
-  SubQuadrature q_reflected = reflect(quadrature);
-  SubQuadrature q[8]        = {quadrature,
-                        rotate(quadrature, 1),
-                        rotate(quadrature, 2),
-                        rotate(quadrature, 3),
-                        q_reflected,
-                        rotate(q_reflected, 3),
-                        rotate(q_reflected, 2),
-                        rotate(q_reflected, 1)};
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto                  entry = rules.find(key);
+        if (entry != rules.end())
+          return entry->second;
 
+        if (rules.size() >= max_n_rules)
+          rules.clear();
+        return rules.emplace(std::move(key), compute(quadrature))
+          .first->second;
+      }
 
+    private:
+      static const unsigned int max_n_rules = 32;
 
-  const unsigned int n_points = quadrature.size(),
-                     n_faces  = GeometryInfo<dim>::faces_per_cell;
+      std::mutex                                   mutex;
+      std::map<std::vector<double>, Quadrature<3>> rules;
+    };
+  } // namespace QProjectorImplementation
+} // namespace internal
 
-  // first fix quadrature points
-  std::vector<Point<dim>> q_points;
-  q_points.reserve(n_points * n_faces * 8);
-  std::vector<Point<dim>> help(n_points);
 
-  std::vector<double> weights;
-  weights.reserve(n_points * n_faces * 8);
 
-  // do the following for all possible
-  // mutations of a face (mutation==0
-  // corresponds to a face with standard
-  // orientation, no flip and no rotation)
-  for (const auto &mutation : q)
-    {
-      // project to each face and append
-      // results
-      for (unsigned int face = 0; face < n_faces; ++face)
-        {
-          project_to_face(mutation, face, help);
-          std::copy(help.begin(), help.end(), std::back_inserter(q_points));
-        }
+template <>
+Quadrature<3>
+QProjector<3>::project_to_oriented_face(const SubQuadrature &quadrature,
+                                        const unsigned int   face_no,
+                                        const bool           face_orientation,
+                                        const bool           face_flip,
+                                        const bool           face_rotation)
+{
+  // the order of the mutations follows the one of the data sets in
+  // project_to_all_faces(), see also DataSetDescriptor::face()
+  const unsigned int n_rotations =
+    2 * (face_flip ? 1 : 0) + (face_rotation ? 1 : 0);
+  const SubQuadrature mutation =
+    (face_orientation ? rotate(quadrature, n_rotations) :
+                        rotate(reflect(quadrature), (4 - n_rotations) % 4));
+
+  return project_to_face(mutation, face_no);
+}
 
-      // next copy over weights
-      for (unsigned int face = 0; face < n_faces; ++face)
-        std::copy(mutation.get_weights().begin(),
-                  mutation.get_weights().end(),
-                  std::back_inserter(weights));
-    }
 
 
-  Assert(q_points.size() == n_points * n_faces * 8, ExcInternalError());
-  Assert(weights.size() == n_points * n_faces * 8, ExcInternalError());
+template <>
+Quadrature<3>
+QProjector<3>::project_to_all_faces(const SubQuadrature &quadrature)
+{
+  static internal::QProjectorImplementation::AllFacesCache cache;
+
+  return cache.get(quadrature, [](const SubQuadrature &quadrature) {
+    const unsigned int dim = 3;
+
+    SubQuadrature q_reflected = reflect(quadrature);
+    SubQuadrature q[8]        = {quadrature,
+                          rotate(quadrature, 1),
+                          rotate(quadrature, 2),
+                          rotate(quadrature, 3),
+                          q_reflected,
+                          rotate(q_reflected, 3),
+                          rotate(q_reflected, 2),
+                          rotate(q_reflected, 1)};
+
+    const unsigned int n_points = quadrature.size(),
+                       n_faces  = GeometryInfo<dim>::faces_per_cell;
+
+    // first fix quadrature points
+    std::vector<Point<dim>> q_points;
+    q_points.reserve(n_points * n_faces * 8);
+    std::vector<Point<dim>> help(n_points);
+
+    std::vector<double> weights;
+    weights.reserve(n_points * n_faces * 8);
+
+    // do the following for all possible mutations of a face (mutation==0
+    // corresponds to a face with standard orientation, no flip and no
+    // rotation)
+    for (const auto &mutation : q)
+      {
+        // project to each face and append results
+        for (unsigned int face = 0; face < n_faces; ++face)
+          {
+            project_to_face(mutation, face, help);
+            std::copy(help.begin(), help.end(), std::back_inserter(q_points));
+          }
 
-  return Quadrature<dim>(q_points, weights);
+        // next copy over weights
+        for (unsigned int face = 0; face < n_faces; ++face)
+          std::copy(mutation.get_weights().begin(),
+                    mutation.get_weights().end(),
+                    std::back_inserter(weights));
+      }
+
+    Assert(q_points.size() == n_points * n_faces * 8, ExcInternalError());
+    Assert(weights.size() == n_points * n_faces * 8, ExcInternalError());
+
+    return Quadrature<dim>(q_points, weights);
+  });
 }
 
 
@@ -1510,6 +1582,18 @@ QProjector<dim>::project_to_face(const SubQuadrature &quadrature,
 }
 
 
+template <int dim>
+Quadrature<dim>
+QProjector<dim>::project_to_oriented_face(const SubQuadrature &quadrature,
+                                          const unsigned int   face_no,
+                                          const bool,
+                                          const bool,
+                                          const bool)
+{
+  return project_to_face(quadrature, face_no);
+}
+
+
 template <int dim>
 Quadrature<dim>
 QProjector<dim>::project_to_subface(const SubQuadrature &          quadrature,
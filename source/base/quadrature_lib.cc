@@ -21,6 +21,8 @@
 #include <cmath>
 #include <functional>
 #include <limits>
+#include <map>
+#include <mutex>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -58,34 +60,82 @@ QGaussLobatto<0>::QGaussLobatto(const unsigned int)
 
 
 
-template <>
-QGauss<1>::QGauss(const unsigned int n)
-  : Quadrature<1>(n)
+namespace internal
 {
-  if (n == 0)
-    return;
+  /**
+   * A cache for one-dimensional quadrature rules that are expensive to
+   * compute, like the ones based on the roots of Jacobi polynomials. Each
+   * rule is computed the first time it is requested and then kept until the
+   * end of the program, so that the many quadrature objects created for
+   * example when setting up face quadratures only pay for copying the points
+   * and weights. Access is synchronized, so the cache can be used from
+   * several threads.
+   */
+  class Quadrature1DCache
+  {
+  public:
+    using Rule = std::pair<std::vector<Point<1>>, std::vector<double>>;
+
+    /**
+     * Return the rule with @p n points, computing it with @p compute_rule
+     * if it is not yet in the cache.
+     */
+    const Rule &
+    get(const unsigned int                                n,
+        const std::function<Rule(const unsigned int)> &compute_rule)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto                        rule = rules.find(n);
+      if (rule == rules.end())
+        rule = rules.emplace(n, compute_rule(n)).first;
+      // elements of a std::map are never moved, so the reference stays
+      // valid after we release the lock
+      return rule->second;
+    }
+
+  private:
+    std::mutex                   mutex;
+    std::map<unsigned int, Rule> rules;
+  };
 
-  std::vector<long double> points =
-    Polynomials::jacobi_polynomial_roots<long double>(n, 0, 0);
 
-  for (unsigned int i = 0; i < (points.size() + 1) / 2; ++i)
+
+  namespace QGauss
+  {
+    /**
+     * Compute the points and weights of the Gauss-Legendre rule with @p n
+     * points on the unit interval.
+     */
+    Quadrature1DCache::Rule
+    compute_rule(const unsigned int n)
     {
-      this->quadrature_points[i][0]         = points[i];
-      this->quadrature_points[n - i - 1][0] = 1. - points[i];
-
-      // derivative of Jacobi polynomial
-      const long double pp =
-        0.5 * (n + 1) *
-        Polynomials::jacobi_polynomial_value(n - 1, 1, 1, points[i]);
-      const long double x      = -1. + 2. * points[i];
-      const double      w      = 1. / ((1. - x * x) * pp * pp);
-      this->weights[i]         = w;
-      this->weights[n - i - 1] = w;
+      Quadrature1DCache::Rule rule;
+      rule.first.resize(n);
+      rule.second.resize(n);
+
+      std::vector<long double> points =
+        Polynomials::jacobi_polynomial_roots<long double>(n, 0, 0);
+
+      for (unsigned int i = 0; i < (points.size() + 1) / 2; ++i)
+        {
+          rule.first[i][0]         = points[i];
+          rule.first[n - i - 1][0] = 1. - points[i];
+
+          // derivative of Jacobi polynomial
+          const long double pp =
+            0.5 * (n + 1) *
+            Polynomials::jacobi_polynomial_value(n - 1, 1, 1, points[i]);
+          const long double x    = -1. + 2. * points[i];
+          const double      w    = 1. / ((1. - x * x) * pp * pp);
+          rule.second[i]         = w;
+          rule.second[n - i - 1] = w;
+        }
+      return rule;
     }
-}
+  } // namespace QGauss
+
+
 
-namespace internal
-{
   namespace QGaussLobatto
   {
     /**
@@ -132,30 +182,65 @@ namespace internal
 
       return w;
     }
+
+
+
+    /**
+     * Compute the points and weights of the Gauss-Lobatto rule with @p n
+     * points on the unit interval.
+     */
+    Quadrature1DCache::Rule
+    compute_rule(const unsigned int n)
+    {
+      std::vector<long double> points =
+        Polynomials::jacobi_polynomial_roots<long double>(n - 2, 1, 1);
+      points.insert(points.begin(), 0);
+      points.push_back(1.);
+      std::vector<long double> w = compute_quadrature_weights(points, 0, 0);
+
+      // scale weights to the interval [0.0, 1.0]:
+      Quadrature1DCache::Rule rule;
+      rule.first.resize(n);
+      rule.second.resize(n);
+      for (unsigned int i = 0; i < points.size(); ++i)
+        {
+          rule.first[i][0] = points[i];
+          rule.second[i]   = 0.5 * w[i];
+        }
+      return rule;
+    }
   } // namespace QGaussLobatto
 } // namespace internal
 
 
 
+template <>
+QGauss<1>::QGauss(const unsigned int n)
+  : Quadrature<1>(n)
+{
+  if (n == 0)
+    return;
+
+  static internal::Quadrature1DCache cache;
+  const internal::Quadrature1DCache::Rule &rule =
+    cache.get(n, internal::QGauss::compute_rule);
+  this->quadrature_points = rule.first;
+  this->weights           = rule.second;
+}
+
+
+
 template <>
 QGaussLobatto<1>::QGaussLobatto(const unsigned int n)
   : Quadrature<1>(n)
 {
   Assert(n >= 2, ExcNotImplemented());
 
-  std::vector<long double> points =
-    Polynomials::jacobi_polynomial_roots<long double>(n - 2, 1, 1);
-  points.insert(points.begin(), 0);
-  points.push_back(1.);
-  std::vector<long double> w =
-    internal::QGaussLobatto::compute_quadrature_weights(points, 0, 0);
-
-  // scale weights to the interval [0.0, 1.0]:
-  for (unsigned int i = 0; i < points.size(); ++i)
-    {
-      this->quadrature_points[i][0] = points[i];
-      this->weights[i]              = 0.5 * w[i];
-    }
+  static internal::Quadrature1DCache cache;
+  const internal::Quadrature1DCache::Rule &rule =
+    cache.get(n, internal::QGaussLobatto::compute_rule);
+  this->quadrature_points = rule.first;
+  this->weights           = rule.second;
 }
 
 
@@ -15,7 +15,9 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/polynomials_piecewise.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/tensor_product_polynomials.h>
+#include <deal.II/base/vectorization.h>
 
 #include <boost/container/small_vector.hpp>
 
@@ -405,6 +407,118 @@ TensorProductPolynomials<dim, PolynomialType>::compute(
 
 
 
+template <int dim, typename PolynomialType>
+void
+TensorProductPolynomials<dim, PolynomialType>::evaluate(
+  const std::vector<Point<dim>> &unit_points,
+  Table<2, double> &             values,
+  Table<2, Tensor<1, dim>> &     grads,
+  Table<2, Tensor<2, dim>> &     grad_grads) const
+{
+  Assert(dim <= 3, ExcNotImplemented());
+
+  const unsigned int n_points = unit_points.size();
+  Assert(values.n_rows() == 0 ||
+           (values.n_rows() == n_tensor_pols && values.n_cols() == n_points),
+         ExcDimensionMismatch2(values.n_rows(), n_tensor_pols, 0));
+  Assert(grads.n_rows() == 0 ||
+           (grads.n_rows() == n_tensor_pols && grads.n_cols() == n_points),
+         ExcDimensionMismatch2(grads.n_rows(), n_tensor_pols, 0));
+  Assert(grad_grads.n_rows() == 0 || (grad_grads.n_rows() == n_tensor_pols &&
+                                      grad_grads.n_cols() == n_points),
+         ExcDimensionMismatch2(grad_grads.n_rows(), n_tensor_pols, 0));
+
+  const bool update_values     = (values.n_rows() == n_tensor_pols),
+             update_grads      = (grads.n_rows() == n_tensor_pols),
+             update_grad_grads = (grad_grads.n_rows() == n_tensor_pols);
+
+  unsigned int n_values_and_derivatives = 0;
+  if (update_values)
+    n_values_and_derivatives = 1;
+  if (update_grads)
+    n_values_and_derivatives = 2;
+  if (update_grad_grads)
+    n_values_and_derivatives = 3;
+  if (n_values_and_derivatives == 0 || n_points == 0)
+    return;
+
+  constexpr unsigned int n_lanes = VectorizedArray<double>::n_array_elements;
+  const unsigned int     n_polynomials = polynomials.size();
+
+  // values (and derivatives) of the 1D polynomials, accessed as
+  // values_1d[polynomial][direction][derivative], for all the points of
+  // the current batch
+  std::vector<std::array<std::array<VectorizedArray<double>, 3>, dim>>
+                        values_1d(n_polynomials);
+  std::array<double, 3> point_values_1d;
+
+  for (unsigned int q0 = 0; q0 < n_points; q0 += n_lanes)
+    {
+      const unsigned int n_filled = std::min(n_lanes, n_points - q0);
+
+      // unused lanes of the last batch simply repeat the last point
+      for (unsigned int i = 0; i < n_polynomials; ++i)
+        for (unsigned int d = 0; d < dim; ++d)
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            {
+              polynomials[i].value(
+                unit_points[q0 + std::min(v, n_filled - 1)][d],
+                n_values_and_derivatives - 1,
+                point_values_1d.data());
+              for (unsigned int k = 0; k < n_values_and_derivatives; ++k)
+                values_1d[i][d][k][v] = point_values_1d[k];
+            }
+
+      unsigned int indices[3];
+      unsigned int ind = 0;
+      for (indices[2] = 0; indices[2] < (dim > 2 ? n_polynomials : 1);
+           ++indices[2])
+        for (indices[1] = 0; indices[1] < (dim > 1 ? n_polynomials : 1);
+             ++indices[1])
+          for (indices[0] = 0; indices[0] < n_polynomials; ++indices[0], ++ind)
+            {
+              const unsigned int i = index_map_inverse[ind];
+
+              if (update_values)
+                {
+                  VectorizedArray<double> value = values_1d[indices[0]][0][0];
+                  for (unsigned int x = 1; x < dim; ++x)
+                    value *= values_1d[indices[x]][x][0];
+                  for (unsigned int v = 0; v < n_filled; ++v)
+                    values[i][q0 + v] = value[v];
+                }
+
+              if (update_grads)
+                for (unsigned int d = 0; d < dim; ++d)
+                  {
+                    VectorizedArray<double> grad =
+                      values_1d[indices[0]][0][(d == 0) ? 1 : 0];
+                    for (unsigned int x = 1; x < dim; ++x)
+                      grad *= values_1d[indices[x]][x][(d == x) ? 1 : 0];
+                    for (unsigned int v = 0; v < n_filled; ++v)
+                      grads[i][q0 + v][d] = grad[v];
+                  }
+
+              if (update_grad_grads)
+                for (unsigned int d1 = 0; d1 < dim; ++d1)
+                  for (unsigned int d2 = d1; d2 < dim; ++d2)
+                    {
+                      VectorizedArray<double> der2 =
+                        values_1d[indices[0]][0][(d1 == 0) + (d2 == 0)];
+                      for (unsigned int x = 1; x < dim; ++x)
+                        der2 *= values_1d[indices[x]][x][(d1 == x) + (d2 == x)];
+                      for (unsigned int v = 0; v < n_filled; ++v)
+                        {
+                          grad_grads[i][q0 + v][d1][d2] = der2[v];
+                          grad_grads[i][q0 + v][d2][d1] = der2[v];
+                        }
+                    }
+            }
+    }
+}
+
+
+
 /* ------------------- AnisotropicPolynomials -------------- */
 
 
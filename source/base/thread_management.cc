@@ -17,7 +17,14 @@
 
 #include <atomic>
 #include <cstdlib>
+#include <exception>
 #include <iostream>
+#include <memory>
+#include <mutex>
+
+#ifdef DEAL_II_WITH_THREADS
+#  include <tbb/task_group.h>
+#endif
 
 #ifdef DEAL_II_HAVE_UNISTD_H
 #  include <unistd.h>
@@ -257,6 +264,97 @@ namespace Threads
       }
     return return_values;
   }
+
+
+
+  TaskGraph::TaskIndex
+  TaskGraph::add_task(const std::function<void()> & function,
+                      const std::vector<TaskIndex> &dependencies)
+  {
+    const TaskIndex task = functions.size();
+
+    functions.push_back(function);
+    successors.emplace_back();
+    n_dependencies.push_back(dependencies.size());
+    for (const TaskIndex dependency : dependencies)
+      {
+        Assert(dependency < task,
+               ExcMessage("A task can only depend on tasks that have been "
+                          "added to the graph before it."));
+        successors[dependency].push_back(task);
+      }
+
+    return task;
+  }
+
+
+
+  unsigned int
+  TaskGraph::n_tasks() const
+  {
+    return functions.size();
+  }
+
+
+
+  void
+  TaskGraph::run() const
+  {
+#ifdef DEAL_II_WITH_THREADS
+    if (MultithreadInfo::n_threads() > 1 && functions.size() > 1)
+      {
+        // count down the unfinished dependencies of each task, and start a
+        // task as soon as its counter reaches zero. the tasks started by
+        // other tasks are added to the same task_group, so waiting for it
+        // waits for all of them
+        std::unique_ptr<std::atomic<unsigned int>[]> n_pending(
+          new std::atomic<unsigned int>[functions.size()]);
+        for (TaskIndex task = 0; task < functions.size(); ++task)
+          n_pending[task] = n_dependencies[task];
+
+        std::exception_ptr first_exception;
+        std::mutex         exception_mutex;
+        tbb::task_group    task_group;
+
+        std::function<void(const TaskIndex)> start_task =
+          [&](const TaskIndex task) {
+            task_group.run([&, task]() {
+              try
+                {
+                  functions[task]();
+                }
+              catch (...)
+                {
+                  // remember the first exception, and do not start the
+                  // tasks depending on the failed one
+                  std::lock_guard<std::mutex> lock(exception_mutex);
+                  if (!first_exception)
+                    first_exception = std::current_exception();
+                  return;
+                }
+
+              for (const TaskIndex successor : successors[task])
+                if (--n_pending[successor] == 0)
+                  start_task(successor);
+            });
+          };
+
+        for (TaskIndex task = 0; task < functions.size(); ++task)
+          if (n_dependencies[task] == 0)
+            start_task(task);
+        task_group.wait();
+
+        if (first_exception)
+          std::rethrow_exception(first_exception);
+        return;
+      }
+#endif
+
+    // tasks only depend on tasks added before them, so the order of addition
+    // is a valid order to run them in
+    for (const std::function<void()> &function : functions)
+      function();
+  }
 } // namespace Threads
 
 
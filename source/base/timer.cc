@@ -24,6 +24,7 @@
 #include <chrono>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <sstream>
 #include <string>
@@ -33,6 +34,15 @@
 #  include <sys/resource.h>
 #endif
 
+#ifdef DEAL_II_HAVE_LINUX_PERF_EVENT_H
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+
+#  include <cstring>
+#endif
+
 #ifdef DEAL_II_MSVC
 #  include <windows.h>
 #endif
@@ -101,7 +111,145 @@ namespace internal
         data.max_index = numbers::invalid_unsigned_int;
       }
     } // namespace
-  }   // namespace TimerImplementation
+
+
+
+    /**
+     * A set of hardware performance counters for the events listed in
+     * TimerOutput::HardwareCounter, opened through the perf_event interface
+     * of the Linux kernel. The counters run from construction to
+     * destruction of the object; the values of a section are obtained as
+     * the difference of two calls to read().
+     */
+    class HardwareCounters
+    {
+    public:
+      /**
+       * Open the counters. If any of them cannot be opened, all of them are
+       * closed again and is_available() returns false.
+       */
+      HardwareCounters();
+
+      /**
+       * Close the counters.
+       */
+      ~HardwareCounters();
+
+      HardwareCounters(const HardwareCounters &) = delete;
+
+      HardwareCounters &
+      operator=(const HardwareCounters &) = delete;
+
+      /**
+       * Return whether the counters could be opened.
+       */
+      bool
+      is_available() const;
+
+      /**
+       * Return the current values of the counters.
+       */
+      std::array<std::uint64_t, TimerOutput::n_hardware_counters>
+      read() const;
+
+    private:
+      /**
+       * The file descriptors of the counters, or -1 for counters that are
+       * not open.
+       */
+      std::array<int, TimerOutput::n_hardware_counters> file_descriptors;
+    };
+
+
+
+    HardwareCounters::HardwareCounters()
+    {
+      file_descriptors.fill(-1);
+
+#ifdef DEAL_II_HAVE_LINUX_PERF_EVENT_H
+      const std::array<std::uint64_t, TimerOutput::n_hardware_counters>
+        events = {{PERF_COUNT_HW_CPU_CYCLES,
+                   PERF_COUNT_HW_INSTRUCTIONS,
+                   PERF_COUNT_HW_CACHE_REFERENCES,
+                   PERF_COUNT_HW_CACHE_MISSES}};
+
+      for (unsigned int c = 0; c < TimerOutput::n_hardware_counters; ++c)
+        {
+          perf_event_attr attributes;
+          std::memset(&attributes, 0, sizeof(attributes));
+          attributes.type           = PERF_TYPE_HARDWARE;
+          attributes.size           = sizeof(attributes);
+          attributes.config         = events[c];
+          attributes.disabled       = 1;
+          attributes.inherit        = 1;
+          attributes.exclude_kernel = 1;
+          attributes.exclude_hv     = 1;
+
+          // measure the calling thread (and the threads it creates from now
+          // on) on any CPU
+          file_descriptors[c] = static_cast<int>(
+            syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+          if (file_descriptors[c] < 0)
+            {
+              for (int &fd : file_descriptors)
+                if (fd >= 0)
+                  {
+                    close(fd);
+                    fd = -1;
+                  }
+              return;
+            }
+        }
+
+      for (const int fd : file_descriptors)
+        {
+          ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+          ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+
+
+    HardwareCounters::~HardwareCounters()
+    {
+#ifdef DEAL_II_HAVE_LINUX_PERF_EVENT_H
+      for (const int fd : file_descriptors)
+        if (fd >= 0)
+          close(fd);
+#endif
+    }
+
+
+
+    bool
+    HardwareCounters::is_available() const
+    {
+      return file_descriptors[0] >= 0;
+    }
+
+
+
+    std::array<std::uint64_t, TimerOutput::n_hardware_counters>
+    HardwareCounters::read() const
+    {
+      std::array<std::uint64_t, TimerOutput::n_hardware_counters> values;
+      values.fill(0);
+
+#ifdef DEAL_II_HAVE_LINUX_PERF_EVENT_H
+      for (unsigned int c = 0; c < TimerOutput::n_hardware_counters; ++c)
+        if (file_descriptors[c] >= 0)
+          {
+            std::uint64_t value = 0;
+            if (::read(file_descriptors[c], &value, sizeof(value)) ==
+                sizeof(value))
+              values[c] = value;
+          }
+#endif
+
+      return values;
+    }
+  } // namespace TimerImplementation
 } // namespace internal
 
 
@@ -313,6 +461,9 @@ Timer::reset()
 
 /* ---------------------------- TimerOutput -------------------------- */
 
+constexpr unsigned int TimerOutput::n_hardware_counters;
+
+
 TimerOutput::TimerOutput(std::ostream &        stream,
                          const OutputFrequency output_frequency,
                          const OutputType      output_type)
@@ -368,7 +519,7 @@ TimerOutput::~TimerOutput()
   auto do_exit = [this]() {
     try
       {
-        while (active_sections.size() > 0)
+        while (thread_data.get().active_sections.size() > 0)
           leave_subsection();
         // don't print unless we leave all subsections
         if ((output_frequency == summary ||
@@ -412,18 +563,29 @@ TimerOutput::~TimerOutput()
 void
 TimerOutput::enter_subsection(const std::string &section_name)
 {
-  std::lock_guard<std::mutex> lock(mutex);
-
   Assert(section_name.empty() == false, ExcMessage("Section string is empty."));
 
-  Assert(std::find(active_sections.begin(),
-                   active_sections.end(),
-                   section_name) == active_sections.end(),
+  ThreadData &data = thread_data.get();
+
+  Assert(std::find_if(data.active_sections.begin(),
+                      data.active_sections.end(),
+                      [&section_name](const std::vector<std::string> &path) {
+                        return path.back() == section_name;
+                      }) == data.active_sections.end(),
          ExcMessage(std::string("Cannot enter the already active section <") +
                     section_name + ">."));
 
-  if (sections.find(section_name) == sections.end())
+  // the new section is a child of the section entered most recently
+  std::vector<std::string> path;
+  if (!data.active_sections.empty())
+    path = data.active_sections.back();
+  path.push_back(section_name);
+
+  auto section_it = data.sections.find(path);
+  if (section_it == data.sections.end())
     {
+      section_it = data.sections.emplace(path, Section()).first;
+
       if (mpi_communicator != MPI_COMM_SELF)
         {
           // create a new timer for this section. the second argument
@@ -433,20 +595,24 @@ TimerOutput::enter_subsection(const std::string &section_name)
           // The mpi_communicator from TimerOutput is passed to the
           // Timer here, so this Timer will collect timing information
           // among all processes inside mpi_communicator.
-          sections[section_name].timer = Timer(mpi_communicator, true);
+          section_it->second.timer = Timer(mpi_communicator, true);
         }
 
 
-      sections[section_name].total_cpu_time  = 0;
-      sections[section_name].total_wall_time = 0;
-      sections[section_name].n_calls         = 0;
+      section_it->second.total_cpu_time  = 0;
+      section_it->second.total_wall_time = 0;
+      section_it->second.n_calls         = 0;
+      section_it->second.total_counters.fill(0);
     }
 
-  sections[section_name].timer.reset();
-  sections[section_name].timer.start();
-  sections[section_name].n_calls++;
+  Section &section = section_it->second;
+  section.timer.reset();
+  section.timer.start();
+  section.n_calls++;
+  if (hardware_counters)
+    section.counters_at_start = hardware_counters->read();
 
-  active_sections.push_back(section_name);
+  data.active_sections.push_back(path);
 }
 
 
@@ -454,36 +620,45 @@ TimerOutput::enter_subsection(const std::string &section_name)
 void
 TimerOutput::leave_subsection(const std::string &section_name)
 {
-  Assert(!active_sections.empty(),
-         ExcMessage("Cannot exit any section because none has been entered!"));
+  ThreadData &data = thread_data.get();
 
-  std::lock_guard<std::mutex> lock(mutex);
+  Assert(!data.active_sections.empty(),
+         ExcMessage("Cannot exit any section because none has been entered!"));
 
+  // if no string is given, exit the last active section.
+  auto active_it = std::prev(data.active_sections.end());
   if (!section_name.empty())
     {
-      Assert(sections.find(section_name) != sections.end(),
-             ExcMessage("Cannot delete a section that was never created."));
-      Assert(std::find(active_sections.begin(),
-                       active_sections.end(),
-                       section_name) != active_sections.end(),
+      active_it = std::find_if(data.active_sections.begin(),
+                               data.active_sections.end(),
+                               [&section_name](
+                                 const std::vector<std::string> &path) {
+                                 return path.back() == section_name;
+                               });
+      Assert(active_it != data.active_sections.end(),
              ExcMessage("Cannot delete a section that has not been entered."));
     }
 
-  // if no string is given, exit the last
-  // active section.
-  const std::string actual_section_name =
-    (section_name.empty() ? active_sections.back() : section_name);
+  const std::string &actual_section_name = active_it->back();
+  Section &          section             = data.sections[*active_it];
 
-  sections[actual_section_name].timer.stop();
-  sections[actual_section_name].total_wall_time +=
-    sections[actual_section_name].timer.last_wall_time();
+  section.timer.stop();
+  section.total_wall_time += section.timer.last_wall_time();
 
   // Get cpu time. On MPI systems, if constructed with an mpi_communicator
   // like MPI_COMM_WORLD, then the Timer will sum up the CPU time between
   // processors among the provided mpi_communicator. Therefore, no
   // communication is needed here.
-  const double cpu_time = sections[actual_section_name].timer.last_cpu_time();
-  sections[actual_section_name].total_cpu_time += cpu_time;
+  const double cpu_time = section.timer.last_cpu_time();
+  section.total_cpu_time += cpu_time;
+
+  if (hardware_counters)
+    {
+      const std::array<std::uint64_t, n_hardware_counters> counters =
+        hardware_counters->read();
+      for (unsigned int c = 0; c < n_hardware_counters; ++c)
+        section.total_counters[c] += counters[c] - section.counters_at_start[c];
+    }
 
   // in case we have to print out something, do that here...
   if ((output_frequency == every_call ||
@@ -494,7 +669,7 @@ TimerOutput::leave_subsection(const std::string &section_name)
       std::ostringstream cpu;
       cpu << cpu_time << "s";
       std::ostringstream wall;
-      wall << sections[actual_section_name].timer.last_wall_time() << "s";
+      wall << section.timer.last_wall_time() << "s";
       if (output_type == cpu_times)
         output_time = ", CPU time: " + cpu.str();
       else if (output_type == wall_times)
@@ -503,14 +678,69 @@ TimerOutput::leave_subsection(const std::string &section_name)
         output_time =
           ", CPU/wall time: " + cpu.str() + " / " + wall.str() + ".";
 
+      std::lock_guard<std::mutex> lock(mutex);
       out_stream << actual_section_name << output_time << std::endl;
     }
 
   // delete the index from the list of
   // active ones
-  active_sections.erase(std::find(active_sections.begin(),
-                                  active_sections.end(),
-                                  actual_section_name));
+  data.active_sections.erase(active_it);
+}
+
+
+
+void
+TimerOutput::Section::accumulate(const Section &other)
+{
+  total_cpu_time += other.total_cpu_time;
+  total_wall_time += other.total_wall_time;
+  n_calls += other.n_calls;
+  for (unsigned int c = 0; c < n_hardware_counters; ++c)
+    total_counters[c] += other.total_counters[c];
+}
+
+
+
+std::map<std::vector<std::string>, TimerOutput::Section>
+TimerOutput::merged_section_tree() const
+{
+  std::map<std::vector<std::string>, Section> merged;
+  const auto add_thread_data = [&merged](const ThreadData &data) {
+    for (const auto &section : data.sections)
+      {
+        auto it = merged.find(section.first);
+        if (it == merged.end())
+          merged.emplace(section.first, section.second);
+        else
+          it->second.accumulate(section.second);
+      }
+  };
+
+#ifdef DEAL_II_WITH_THREADS
+  for (const ThreadData &data : thread_data.get_implementation())
+    add_thread_data(data);
+#else
+  add_thread_data(thread_data.get_implementation());
+#endif
+
+  return merged;
+}
+
+
+
+std::map<std::string, TimerOutput::Section>
+TimerOutput::merged_sections() const
+{
+  std::map<std::string, Section> merged;
+  for (const auto &node : merged_section_tree())
+    {
+      auto it = merged.find(node.first.back());
+      if (it == merged.end())
+        merged.emplace(node.first.back(), node.second);
+      else
+        it->second.accumulate(node.second);
+    }
+  return merged;
 }
 
 
@@ -519,7 +749,7 @@ std::map<std::string, double>
 TimerOutput::get_summary_data(const OutputData kind) const
 {
   std::map<std::string, double> output;
-  for (const auto &section : sections)
+  for (const auto &section : merged_sections())
     {
       switch (kind)
         {
@@ -544,6 +774,8 @@ TimerOutput::get_summary_data(const OutputData kind) const
 void
 TimerOutput::print_summary() const
 {
+  const std::map<std::string, Section> sections = merged_sections();
+
   // we are going to change the precision and width of output below. store the
   // old values so we can restore it later on
   const std::istream::fmtflags old_flags = out_stream.get_stream().flags();
@@ -857,6 +1089,280 @@ TimerOutput::print_summary() const
 
 
 
+std::map<std::vector<std::string>, double>
+TimerOutput::get_tree_summary_data(const OutputData kind) const
+{
+  std::map<std::vector<std::string>, double> output;
+  for (const auto &node : merged_section_tree())
+    {
+      switch (kind)
+        {
+          case TimerOutput::OutputData::total_cpu_time:
+            output[node.first] = node.second.total_cpu_time;
+            break;
+          case TimerOutput::OutputData::total_wall_time:
+            output[node.first] = node.second.total_wall_time;
+            break;
+          case TimerOutput::OutputData::n_calls:
+            output[node.first] = node.second.n_calls;
+            break;
+          default:
+            Assert(false, ExcNotImplemented());
+        }
+    }
+  return output;
+}
+
+
+
+void
+TimerOutput::print_tree_summary() const
+{
+  // the map is sorted lexicographically by the paths, so every section is
+  // followed by the sections nested in it
+  const std::map<std::vector<std::string>, Section> tree =
+    merged_section_tree();
+
+  // we are going to change the precision and width of output below. store the
+  // old values so we can restore it later on
+  const std::istream::fmtflags old_flags = out_stream.get_stream().flags();
+  const std::streamsize old_precision    = out_stream.get_stream().precision();
+  const std::streamsize old_width        = out_stream.get_stream().width();
+
+  // get the maximum width among all sections, indented by two spaces per
+  // level
+  unsigned int max_width = 0;
+  for (const auto &node : tree)
+    max_width =
+      std::max(max_width,
+               static_cast<unsigned int>(2 * (node.first.size() - 1) +
+                                         node.first.back().length()));
+
+  // 32 is the default width until | character
+  max_width = std::max(max_width + 1, static_cast<unsigned int>(32));
+  const std::string extra_dash  = std::string(max_width - 32, '-');
+  const std::string extra_space = std::string(max_width - 32, ' ');
+
+  const double total_wall_time = timer_all.wall_time();
+
+  out_stream << "\n\n"
+             << "+---------------------------------------------" << extra_dash
+             << "+------------"
+             << "+------------+\n"
+             << "| Total wallclock time elapsed since start    " << extra_space
+             << "|";
+  out_stream << std::setw(10) << std::setprecision(3) << std::right;
+  out_stream << total_wall_time << "s |            |\n";
+  out_stream << "|                                             " << extra_space
+             << "|            "
+             << "|            |\n";
+  out_stream << "| Section                         " << extra_space
+             << "| no. calls |";
+  out_stream << "  wall time | % of outer |\n";
+  out_stream << "+---------------------------------" << extra_dash
+             << "+-----------+------------"
+             << "+------------+";
+  for (const auto &node : tree)
+    {
+      std::string name_out =
+        std::string(2 * (node.first.size() - 1), ' ') + node.first.back();
+      name_out.resize(max_width, ' ');
+      out_stream << std::endl;
+      out_stream << "| " << name_out;
+      out_stream << "| ";
+      out_stream << std::setw(9);
+      out_stream << node.second.n_calls << " |";
+      out_stream << std::setw(10);
+      out_stream << std::setprecision(3);
+      out_stream << node.second.total_wall_time << "s |";
+      out_stream << std::setw(10);
+
+      // the time of sections on the outermost level is given relative to
+      // the total time, the time of nested sections relative to the section
+      // they are nested in
+      double outer_wall_time = total_wall_time;
+      if (node.first.size() > 1)
+        {
+          const auto outer = tree.find(std::vector<std::string>(
+            node.first.begin(), std::prev(node.first.end())));
+          Assert(outer != tree.end(), ExcInternalError());
+          outer_wall_time = outer->second.total_wall_time;
+        }
+
+      if (outer_wall_time != 0)
+        {
+          // if run time was less than 0.1%, just print a zero to avoid
+          // printing silly things such as "2.45e-6%". otherwise print
+          // the actual percentage
+          const double fraction =
+            node.second.total_wall_time / outer_wall_time;
+          if (fraction > 0.001)
+            {
+              out_stream << std::setprecision(2);
+              out_stream << fraction * 100;
+            }
+          else
+            out_stream << 0.0;
+
+          out_stream << "% |";
+        }
+      else
+        out_stream << 0.0 << "% |";
+    }
+  out_stream << std::endl
+             << "+---------------------------------" << extra_dash
+             << "+-----------+"
+             << "------------+------------+\n"
+             << std::endl;
+
+  // restore previous precision and width
+  out_stream.get_stream().precision(old_precision);
+  out_stream.get_stream().width(old_width);
+  out_stream.get_stream().flags(old_flags);
+}
+
+
+
+bool
+TimerOutput::enable_hardware_counters()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if (!hardware_counters)
+    {
+      std::unique_ptr<internal::TimerImplementation::HardwareCounters>
+        counters(new internal::TimerImplementation::HardwareCounters());
+      if (!counters->is_available())
+        return false;
+      hardware_counters = std::move(counters);
+
+      // sections that are currently active on this thread start counting
+      // from now on
+      ThreadData &data = thread_data.get();
+      const std::array<std::uint64_t, n_hardware_counters> current_counters =
+        hardware_counters->read();
+      for (const std::vector<std::string> &path : data.active_sections)
+        data.sections[path].counters_at_start = current_counters;
+    }
+
+  return true;
+}
+
+
+
+bool
+TimerOutput::hardware_counters_enabled() const
+{
+  return hardware_counters != nullptr;
+}
+
+
+
+std::map<std::string, double>
+TimerOutput::get_hardware_counter_data(const HardwareCounter counter) const
+{
+  AssertIndexRange(static_cast<unsigned int>(counter), n_hardware_counters);
+
+  std::map<std::string, double> output;
+  for (const auto &section : merged_sections())
+    output[section.first] = section.second.total_counters[counter];
+  return output;
+}
+
+
+
+void
+TimerOutput::print_hardware_counter_statistics(const MPI_Comm mpi_comm) const
+{
+  const std::map<std::string, Section> sections = merged_sections();
+
+  // we are going to change the precision and width of output below. store the
+  // old values so we can restore it later on
+  const std::istream::fmtflags old_flags = out_stream.get_stream().flags();
+  const std::streamsize old_precision    = out_stream.get_stream().precision();
+  const std::streamsize old_width        = out_stream.get_stream().width();
+
+  // get the maximum width among all sections
+  unsigned int max_width = 0;
+  for (const auto &i : sections)
+    max_width =
+      std::max(max_width, static_cast<unsigned int>(i.first.length()));
+
+  // 32 is the default width until | character
+  max_width = std::max(max_width + 1, static_cast<unsigned int>(32));
+  const std::string extra_dash  = std::string(max_width - 32, '-');
+  const std::string extra_space = std::string(max_width - 32, ' ');
+
+  if (!hardware_counters)
+    out_stream << "\nNote: Hardware performance counters have not been "
+               << "recorded, see enable_hardware_counters()." << std::endl;
+
+  // the recorded counters, followed by the instructions per cycle and the
+  // estimate of the memory bandwidth in GB/s
+  constexpr unsigned int n_quantities     = n_hardware_counters + 2;
+  const char *const      quantity_names[] = {"cycles",
+                                        "instructions",
+                                        "LLC references",
+                                        "LLC misses",
+                                        "instructions per cycle",
+                                        "memory GB/s (estimate)"};
+  const double           cache_line_size  = 64.;
+  const std::string      separator_line =
+    "+---------------------------------" + extra_dash +
+    "+-----------+------------+------------+------------+";
+
+  out_stream << "\n\n" << separator_line << "\n"
+             << "| Section and counter             " << extra_space
+             << "| no. calls |        min |        avg |        max |\n"
+             << separator_line;
+  out_stream << std::setprecision(3) << std::right;
+  for (const auto &i : sections)
+    {
+      std::string name_out = i.first;
+
+      // resize the array so that it is always of the same size
+      unsigned int pos_non_space = name_out.find_first_not_of(' ');
+      name_out.erase(0, pos_non_space);
+      name_out.resize(max_width, ' ');
+      out_stream << std::endl;
+      out_stream << "| " << name_out << "| " << std::setw(9)
+                 << i.second.n_calls << " |            |            |"
+                 << "            |";
+
+      std::array<double, n_quantities> values;
+      for (unsigned int c = 0; c < n_hardware_counters; ++c)
+        values[c] = i.second.total_counters[c];
+      values[n_hardware_counters] =
+        values[cpu_cycles] > 0 ? values[instructions] / values[cpu_cycles] : 0.;
+      values[n_hardware_counters + 1] =
+        i.second.total_wall_time > 0 ?
+          1e-9 * cache_line_size * values[cache_misses] /
+            i.second.total_wall_time :
+          0.;
+
+      for (unsigned int q = 0; q < n_quantities; ++q)
+        {
+          const Utilities::MPI::MinMaxAvg data =
+            Utilities::MPI::min_max_avg(values[q], mpi_comm);
+
+          std::string quantity_out = std::string("  ") + quantity_names[q];
+          quantity_out.resize(max_width, ' ');
+          out_stream << std::endl;
+          out_stream << "| " << quantity_out << "|           |"
+                     << std::setw(11) << data.min << " |" << std::setw(11)
+                     << data.avg << " |" << std::setw(11) << data.max << " |";
+        }
+    }
+  out_stream << std::endl << separator_line << "\n" << std::endl;
+
+  // restore previous precision and width
+  out_stream.get_stream().precision(old_precision);
+  out_stream.get_stream().width(old_width);
+  out_stream.get_stream().flags(old_flags);
+}
+
+
+
 void
 TimerOutput::disable_output()
 {
@@ -874,9 +1380,7 @@ TimerOutput::enable_output()
 void
 TimerOutput::reset()
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  sections.clear();
-  active_sections.clear();
+  thread_data.clear();
   timer_all.restart();
 }
 
@@ -0,0 +1,251 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/tracing.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Tracing
+{
+  namespace
+  {
+    /**
+     * An event as stored in the buffers.
+     */
+    struct Event
+    {
+      const char *  name;
+      std::uint64_t begin;
+      std::uint64_t end;
+    };
+
+    /**
+     * The ring buffer of events of one thread. Only the owning thread
+     * writes to it.
+     */
+    struct ThreadBuffer
+    {
+      ThreadBuffer(const unsigned int thread_index,
+                   const unsigned int capacity)
+        : thread_index(thread_index)
+        , events(capacity)
+        , next(0)
+        , wrapped(false)
+      {}
+
+      /**
+       * The number of the thread, used as the thread id in the trace.
+       */
+      const unsigned int thread_index;
+
+      /**
+       * The storage of the ring buffer.
+       */
+      std::vector<Event> events;
+
+      /**
+       * The position the next event is written to.
+       */
+      std::size_t next;
+
+      /**
+       * Whether the buffer has been filled completely at least once, i.e.,
+       * whether the entries after @p next are valid.
+       */
+      bool wrapped;
+    };
+
+    /**
+     * The buffers of all threads that have recorded events. The buffers
+     * are kept alive by this list after their thread has finished, so that
+     * its events can still be written.
+     */
+    std::vector<std::shared_ptr<ThreadBuffer>> thread_buffers;
+
+    /**
+     * A mutex protecting thread_buffers and buffer_capacity.
+     */
+    std::mutex thread_buffers_mutex;
+
+    /**
+     * The number of events of buffers created from now on.
+     */
+    unsigned int buffer_capacity = 65536;
+
+    /**
+     * The time all time stamps are measured from.
+     */
+    const std::chrono::steady_clock::time_point epoch =
+      std::chrono::steady_clock::now();
+
+    /**
+     * Return the buffer of the calling thread, creating it on first use.
+     */
+    ThreadBuffer &
+    get_thread_buffer()
+    {
+      thread_local std::shared_ptr<ThreadBuffer> buffer;
+      if (buffer == nullptr)
+        {
+          std::lock_guard<std::mutex> lock(thread_buffers_mutex);
+          buffer = std::make_shared<ThreadBuffer>(thread_buffers.size(),
+                                                  buffer_capacity);
+          thread_buffers.push_back(buffer);
+        }
+      return *buffer;
+    }
+
+    /**
+     * Write @p name to @p out as a JSON string.
+     */
+    void
+    write_json_string(std::ostream &out, const char *name)
+    {
+      out << '"';
+      for (const char *c = name; *c != '\0'; ++c)
+        if (*c == '"' || *c == '\\')
+          out << '\\' << *c;
+        else
+          out << *c;
+      out << '"';
+    }
+  } // namespace
+
+
+
+  namespace internal
+  {
+    std::atomic<bool> enabled(false);
+
+
+
+    std::uint64_t
+    now()
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - epoch)
+        .count();
+    }
+
+
+
+    void
+    record_event(const char *        name,
+                 const std::uint64_t begin,
+                 const std::uint64_t end)
+    {
+      ThreadBuffer &buffer = get_thread_buffer();
+      if (buffer.events.empty())
+        return;
+
+      buffer.events[buffer.next] = {name, begin, end};
+      ++buffer.next;
+      if (buffer.next == buffer.events.size())
+        {
+          buffer.next    = 0;
+          buffer.wrapped = true;
+        }
+    }
+  } // namespace internal
+
+
+
+  void
+  enable(const unsigned int events_per_thread)
+  {
+    {
+      std::lock_guard<std::mutex> lock(thread_buffers_mutex);
+      buffer_capacity = events_per_thread;
+    }
+    internal::enabled = true;
+  }
+
+
+
+  void
+  disable()
+  {
+    internal::enabled = false;
+  }
+
+
+
+  void
+  clear()
+  {
+    std::lock_guard<std::mutex> lock(thread_buffers_mutex);
+    for (const auto &buffer : thread_buffers)
+      {
+        buffer->next    = 0;
+        buffer->wrapped = false;
+      }
+  }
+
+
+
+  void
+  write_chrome_trace(std::ostream &out)
+  {
+    const unsigned int rank =
+      Utilities::MPI::job_supports_mpi() ?
+        Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) :
+        0;
+
+    const std::ios::fmtflags old_flags     = out.flags();
+    const std::streamsize    old_precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << "{\"traceEvents\":[";
+    bool first = true;
+
+    std::lock_guard<std::mutex> lock(thread_buffers_mutex);
+    for (const auto &buffer : thread_buffers)
+      {
+        // write the events in the order they were recorded, i.e., starting
+        // with the oldest one that has not been overwritten
+        const std::size_t n_events =
+          buffer->wrapped ? buffer->events.size() : buffer->next;
+        const std::size_t start = buffer->wrapped ? buffer->next : 0;
+        for (std::size_t i = 0; i < n_events; ++i)
+          {
+            const Event &event =
+              buffer->events[(start + i) % buffer->events.size()];
+            out << (first ? "\n" : ",\n") << "{\"name\":";
+            write_json_string(out, event.name);
+            // time stamps are given in microseconds
+            out << ",\"ph\":\"X\",\"ts\":" << 1e-3 * event.begin
+                << ",\"dur\":" << 1e-3 * (event.end - event.begin)
+                << ",\"pid\":" << rank << ",\"tid\":" << buffer->thread_index
+                << "}";
+            first = false;
+          }
+      }
+    out << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+
+    out.flags(old_flags);
+    out.precision(old_precision);
+  }
+} // namespace Tracing
+
+DEAL_II_NAMESPACE_CLOSE
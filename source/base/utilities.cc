@@ -32,6 +32,7 @@
 #include <boost/random.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <bitset>
 #include <cctype>
 #include <cerrno>
@@ -53,6 +54,10 @@
 #  include <cstdlib>
 #endif
 
+#if defined(__linux__)
+#  include <sys/mman.h>
+#endif
+
 
 #ifdef DEAL_II_WITH_TRILINOS
 #  ifdef DEAL_II_WITH_MPI
@@ -941,8 +946,10 @@ namespace Utilities
           case 0:
             return "disabled";
           case 1:
-#ifdef __ALTIVEC__
+#if defined(__ALTIVEC__)
             return "AltiVec";
+#elif defined(__ARM_NEON)
+            return "NEON";
 #else
             return "SSE2";
 #endif
@@ -1039,14 +1046,48 @@ namespace Utilities
 
 
 
+    namespace
+    {
+      /**
+       * Whether large allocations should be backed by huge pages, see
+       * use_huge_pages().
+       */
+      std::atomic<bool> huge_pages_requested(false);
+
+      /**
+       * The size of a (transparent) huge page on the architectures we care
+       * about.
+       */
+      constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+    } // namespace
+
+
+
     void
     posix_memalign(void **memptr, std::size_t alignment, std::size_t size)
     {
 #ifndef DEAL_II_MSVC
+#  if defined(__linux__) && defined(MADV_HUGEPAGE)
+      // align large blocks to the huge page size so that they can be backed
+      // by huge pages from the very first page on
+      const bool advise_huge_pages =
+        huge_pages_requested && size >= huge_page_size;
+      if (advise_huge_pages)
+        alignment = std::max(alignment, huge_page_size);
+#  endif
+
       const int ierr = ::posix_memalign(memptr, alignment, size);
 
       AssertThrow(ierr == 0, ExcOutOfMemory());
       AssertThrow(*memptr != nullptr, ExcOutOfMemory());
+
+#  if defined(__linux__) && defined(MADV_HUGEPAGE)
+      // this is only a hint to the kernel, so we do not care whether it
+      // succeeds. note that this must happen before the memory is first
+      // touched, which is up to the caller
+      if (advise_huge_pages)
+        madvise(*memptr, size, MADV_HUGEPAGE);
+#  endif
 #else
       // Windows does not appear to have posix_memalign. just use the
       // regular malloc in that case
@@ -1058,6 +1099,14 @@ namespace Utilities
 
 
 
+    void
+    use_huge_pages(const bool flag)
+    {
+      huge_pages_requested = flag;
+    }
+
+
+
     bool
     job_supports_mpi()
     {
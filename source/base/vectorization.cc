@@ -39,8 +39,10 @@ const unsigned int VectorizedArray<double, 8>::n_array_elements;
 const unsigned int VectorizedArray<double, 4>::n_array_elements;
 #  endif
 
-#  if (DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__SSE2__)) || \
-    (DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__ALTIVEC__))
+#  if (DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__SSE2__)) ||  \
+    (DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__ALTIVEC__)) || \
+    (DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__ARM_NEON) &&   \
+     defined(__aarch64__))
 const unsigned int VectorizedArray<double, 2>::n_array_elements;
 #  endif
 
@@ -53,8 +55,10 @@ const unsigned int VectorizedArray<float, 16>::n_array_elements;
 const unsigned int VectorizedArray<float, 8>::n_array_elements;
 #  endif
 
-#  if (DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__SSE2__)) || \
-    (DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__ALTIVEC__))
+#  if (DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__SSE2__)) ||  \
+    (DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__ALTIVEC__)) || \
+    (DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__ARM_NEON) &&   \
+     defined(__aarch64__))
 const unsigned int VectorizedArray<float, 4>::n_array_elements;
 #  endif
 #endif
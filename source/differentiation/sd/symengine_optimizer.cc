@@ -0,0 +1,500 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/config.h>
+
+#ifdef DEAL_II_WITH_SYMENGINE
+
+#  include <deal.II/differentiation/sd/symengine_optimizer.h>
+#  include <deal.II/differentiation/sd/symengine_utilities.h>
+
+#  include <symengine/symbol.h>
+#  include <symengine/symengine_config.h>
+
+#  include <algorithm>
+
+// SymEngine can only store and restore compiled LLVM objects as of
+// version 0.6.
+#  if defined(DEAL_II_SYMENGINE_WITH_LLVM) && \
+    (SYMENGINE_MAJOR_VERSION > 0 || SYMENGINE_MINOR_VERSION >= 6)
+#    define DEAL_II_SYMENGINE_LLVM_SERIALIZATION
+#  endif
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Differentiation
+{
+  namespace SD
+  {
+    namespace SE = ::SymEngine;
+
+    namespace
+    {
+      /**
+       * Call the @p evaluator on the double precision @p values and write
+       * the result into @p results. The scratch arrays are not needed in
+       * this case.
+       */
+      template <typename Evaluator>
+      void
+      call_evaluator(Evaluator &   evaluator,
+                     const double *values,
+                     double *      results,
+                     const std::size_t,
+                     const std::size_t,
+                     std::vector<double> &,
+                     std::vector<double> &)
+      {
+        evaluator.call(results, values);
+      }
+
+
+      /**
+       * Call the @p evaluator on @p values of a type other than double by
+       * converting them to and from double precision in the scratch arrays.
+       */
+      template <typename Evaluator, typename ReturnType>
+      void
+      call_evaluator(Evaluator &          evaluator,
+                     const ReturnType *   values,
+                     ReturnType *         results,
+                     const std::size_t    n_values,
+                     const std::size_t    n_results,
+                     std::vector<double> &double_values,
+                     std::vector<double> &double_results)
+      {
+        double_values.resize(n_values);
+        double_results.resize(n_results);
+        std::copy(values, values + n_values, double_values.begin());
+        evaluator.call(double_results.data(), double_values.data());
+        std::copy(double_results.begin(), double_results.end(), results);
+      }
+    } // namespace
+
+
+
+    template <typename ReturnType>
+    BatchOptimizer<ReturnType>::BatchOptimizer(
+      const OptimizerType     optimization_method,
+      const OptimizationFlags optimization_flags)
+      : method(OptimizerType::dictionary)
+      , flags(OptimizationFlags::optimize_default)
+      , is_optimized(false)
+      , has_substituted_values(false)
+    {
+      set_optimization_method(optimization_method, optimization_flags);
+    }
+
+
+
+    template <typename ReturnType>
+    void
+    BatchOptimizer<ReturnType>::set_optimization_method(
+      const OptimizerType     optimization_method,
+      const OptimizationFlags optimization_flags)
+    {
+      Assert(is_optimized == false, ExcAlreadyOptimized());
+#  ifndef DEAL_II_SYMENGINE_WITH_LLVM
+      AssertThrow(optimization_method != OptimizerType::llvm,
+                  ExcMessage("The LLVM optimizer is not available because "
+                             "SymEngine was built without LLVM support."));
+#  endif
+
+      method = optimization_method;
+      flags  = optimization_flags;
+    }
+
+
+
+    template <typename ReturnType>
+    OptimizerType
+    BatchOptimizer<ReturnType>::optimization_method() const
+    {
+      return method;
+    }
+
+
+
+    template <typename ReturnType>
+    OptimizationFlags
+    BatchOptimizer<ReturnType>::optimization_flags() const
+    {
+      return flags;
+    }
+
+
+
+    template <typename ReturnType>
+    void
+    BatchOptimizer<ReturnType>::register_symbols(
+      const types::substitution_map &substitution_map)
+    {
+      register_symbols(Utilities::extract_symbols(substitution_map));
+    }
+
+
+
+    template <typename ReturnType>
+    void
+    BatchOptimizer<ReturnType>::register_symbols(
+      const types::symbol_vector &symbols)
+    {
+      Assert(is_optimized == false, ExcAlreadyOptimized());
+
+      for (const auto &symbol : symbols)
+        {
+          Assert(SE::is_a<SE::Symbol>(symbol.get_value()),
+                 ExcMessage("Only symbols can be registered as independent "
+                            "variables."));
+          Assert(std::none_of(independent_symbols.begin(),
+                              independent_symbols.end(),
+                              [&symbol](const Expression &registered) {
+                                return registered.get_RCP()->__eq__(
+                                  *symbol.get_RCP());
+                              }),
+                 ExcMessage("This symbol has already been registered."));
+          independent_symbols.push_back(symbol);
+        }
+    }
+
+
+
+    template <typename ReturnType>
+    const types::symbol_vector &
+    BatchOptimizer<ReturnType>::get_independent_symbols() const
+    {
+      return independent_symbols;
+    }
+
+
+
+    template <typename ReturnType>
+    std::size_t
+    BatchOptimizer<ReturnType>::n_independent_variables() const
+    {
+      return independent_symbols.size();
+    }
+
+
+
+    template <typename ReturnType>
+    void
+    BatchOptimizer<ReturnType>::register_function(const Expression &function)
+    {
+      Assert(is_optimized == false, ExcAlreadyOptimized());
+
+      // Registering the same function twice is allowed, but it is only
+      // evaluated once.
+      if (function_indices.find(function) != function_indices.end())
+        return;
+
+      function_indices[function] = dependent_functions.size();
+      dependent_functions.push_back(function);
+    }
+
+
+
+    template <typename ReturnType>
+    void
+    BatchOptimizer<ReturnType>::register_functions(
+      const types::symbol_vector &functions)
+    {
+      for (const auto &function : functions)
+        register_function(function);
+    }
+
+
+
+    template <typename ReturnType>
+    const types::symbol_vector &
+    BatchOptimizer<ReturnType>::get_dependent_functions() const
+    {
+      return dependent_functions;
+    }
+
+
+
+    template <typename ReturnType>
+    std::size_t
+    BatchOptimizer<ReturnType>::n_dependent_variables() const
+    {
+      return dependent_functions.size();
+    }
+
+
+
+    template <typename ReturnType>
+    void
+    BatchOptimizer<ReturnType>::optimize()
+    {
+      Assert(is_optimized == false, ExcAlreadyOptimized());
+
+      const bool use_cse =
+        (flags & OptimizationFlags::optimize_cse) !=
+        OptimizationFlags::optimize_default;
+
+      const SE::vec_basic symbols =
+        Utilities::convert_expression_vector_to_basic_vector(
+          independent_symbols);
+      const SE::vec_basic functions =
+        Utilities::convert_expression_vector_to_basic_vector(
+          dependent_functions);
+
+      switch (method)
+        {
+          case OptimizerType::dictionary:
+            break;
+
+          case OptimizerType::lambda:
+            {
+              lambda_visitor.reset(new SE::LambdaRealDoubleVisitor());
+              lambda_visitor->init(symbols, functions, use_cse);
+              break;
+            }
+
+#  ifdef DEAL_II_SYMENGINE_WITH_LLVM
+          case OptimizerType::llvm:
+            {
+              const unsigned int opt_level =
+                ((flags & OptimizationFlags::optimize_aggressive) !=
+                     OptimizationFlags::optimize_default ?
+                   3 :
+                   2);
+              llvm_visitor.reset(new SE::LLVMDoubleVisitor());
+              llvm_visitor->init(symbols, functions, use_cse, opt_level);
+              break;
+            }
+#  endif
+
+          default:
+            Assert(false, ExcNotImplemented());
+        }
+
+      function_values.resize(dependent_functions.size());
+      is_optimized           = true;
+      has_substituted_values = false;
+    }
+
+
+
+    template <typename ReturnType>
+    bool
+    BatchOptimizer<ReturnType>::optimized() const
+    {
+      return is_optimized;
+    }
+
+
+
+    template <typename ReturnType>
+    void
+    BatchOptimizer<ReturnType>::substitute(
+      const types::substitution_map &substitution_map)
+    {
+      std::vector<ReturnType> values;
+      values.reserve(independent_symbols.size());
+      for (const auto &symbol : independent_symbols)
+        {
+          const auto it = substitution_map.find(symbol);
+          Assert(it != substitution_map.end(),
+                 ExcMessage("The substitution map does not contain a value "
+                            "for all independent symbols."));
+          values.push_back(static_cast<ReturnType>(it->second));
+        }
+
+      substitute(values);
+    }
+
+
+
+    template <typename ReturnType>
+    void
+    BatchOptimizer<ReturnType>::substitute(
+      const std::vector<ReturnType> &values)
+    {
+      Assert(is_optimized == true, ExcNotOptimized());
+      AssertDimension(values.size(), independent_symbols.size());
+
+      evaluate_functions(values.data(), function_values.data());
+      has_substituted_values = true;
+    }
+
+
+
+    template <typename ReturnType>
+    bool
+    BatchOptimizer<ReturnType>::values_substituted() const
+    {
+      return has_substituted_values;
+    }
+
+
+
+    template <typename ReturnType>
+    const std::vector<ReturnType> &
+    BatchOptimizer<ReturnType>::evaluate() const
+    {
+      Assert(has_substituted_values == true,
+             ExcMessage("No values have been substituted yet."));
+      return function_values;
+    }
+
+
+
+    template <typename ReturnType>
+    ReturnType
+    BatchOptimizer<ReturnType>::evaluate(const Expression &function) const
+    {
+      Assert(has_substituted_values == true,
+             ExcMessage("No values have been substituted yet."));
+
+      const auto it = function_indices.find(function);
+      Assert(it != function_indices.end(),
+             ExcMessage("This function has not been registered."));
+      return function_values[it->second];
+    }
+
+
+
+    template <typename ReturnType>
+    void
+    BatchOptimizer<ReturnType>::evaluate_batch(
+      const std::vector<ReturnType> &values,
+      std::vector<ReturnType> &      results)
+    {
+      Assert(is_optimized == true, ExcNotOptimized());
+
+      const std::size_t n_values  = independent_symbols.size();
+      const std::size_t n_results = dependent_functions.size();
+      const std::size_t n_batches =
+        (n_values > 0 ? values.size() / n_values : 1);
+      Assert(n_values == 0 || values.size() % n_values == 0,
+             ExcMessage("The number of values must be a multiple of the "
+                        "number of independent symbols."));
+
+      results.resize(n_batches * n_results);
+      for (std::size_t b = 0; b < n_batches; ++b)
+        evaluate_functions(values.data() + b * n_values,
+                           results.data() + b * n_results);
+    }
+
+
+
+    template <typename ReturnType>
+    void
+    BatchOptimizer<ReturnType>::evaluate_functions(const ReturnType *values,
+                                                   ReturnType *      results)
+    {
+      const std::size_t n_values  = independent_symbols.size();
+      const std::size_t n_results = dependent_functions.size();
+
+      switch (method)
+        {
+          case OptimizerType::dictionary:
+            {
+              types::substitution_map substitution_map;
+              for (std::size_t i = 0; i < n_values; ++i)
+                substitution_map[independent_symbols[i]] =
+                  Expression(values[i]);
+
+              for (std::size_t i = 0; i < n_results; ++i)
+                results[i] =
+                  dependent_functions[i].template substitute_and_evaluate<
+                    ReturnType>(substitution_map);
+              break;
+            }
+
+          case OptimizerType::lambda:
+            {
+              Assert(lambda_visitor, ExcInternalError());
+              call_evaluator(*lambda_visitor,
+                             values,
+                             results,
+                             n_values,
+                             n_results,
+                             double_values,
+                             double_results);
+              break;
+            }
+
+#  ifdef DEAL_II_SYMENGINE_WITH_LLVM
+          case OptimizerType::llvm:
+            {
+              Assert(llvm_visitor, ExcInternalError());
+              call_evaluator(*llvm_visitor,
+                             values,
+                             results,
+                             n_values,
+                             n_results,
+                             double_values,
+                             double_results);
+              break;
+            }
+#  endif
+
+          default:
+            Assert(false, ExcNotImplemented());
+        }
+    }
+
+
+
+    template <typename ReturnType>
+    std::string
+    BatchOptimizer<ReturnType>::dump_compiled_object() const
+    {
+#  ifdef DEAL_II_SYMENGINE_LLVM_SERIALIZATION
+      if (method == OptimizerType::llvm && llvm_visitor)
+        return llvm_visitor->dumps();
+#  endif
+      return std::string();
+    }
+
+
+
+    template <typename ReturnType>
+    bool
+    BatchOptimizer<ReturnType>::load_compiled_object(const std::string &object)
+    {
+      Assert(is_optimized == false, ExcAlreadyOptimized());
+      (void)object;
+
+#  ifdef DEAL_II_SYMENGINE_LLVM_SERIALIZATION
+      if (method == OptimizerType::llvm)
+        {
+          llvm_visitor.reset(new SE::LLVMDoubleVisitor());
+          llvm_visitor->loads(object);
+
+          function_values.resize(dependent_functions.size());
+          is_optimized           = true;
+          has_substituted_values = false;
+          return true;
+        }
+#  endif
+
+      return false;
+    }
+
+
+
+    template class BatchOptimizer<double>;
+    template class BatchOptimizer<float>;
+
+  } // namespace SD
+} // namespace Differentiation
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // DEAL_II_WITH_SYMENGINE
@@ -14,10 +14,16 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/mpi.h>
+
 #include <deal.II/distributed/cell_weights.h>
 
 #include <deal.II/dofs/dof_accessor.h>
 
+#include <deal.II/particles/particle_handler.h>
+
+#include <cmath>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -27,6 +33,10 @@ namespace parallel
   CellWeights<dim, spacedim>::CellWeights(
     const hp::DoFHandler<dim, spacedim> &dof_handler)
     : dof_handler(&dof_handler, typeid(*this).name())
+    , particle_handler(nullptr)
+    , weight_per_particle(0)
+    , measured_cost_factor(0)
+    , average_cell_cost(0.)
   {
     triangulation = (dynamic_cast<parallel::Triangulation<dim, spacedim> *>(
       const_cast<dealii::Triangulation<dim, spacedim> *>(
@@ -44,6 +54,18 @@ namespace parallel
                     std::ref(*this),
                     std::placeholders::_1,
                     std::placeholders::_2));
+
+        // Determine the average cell cost once right before the mesh is
+        // repartitioned, and discard recorded costs once it has changed.
+        const auto update_average = [this]() { update_average_cell_cost(); };
+        cost_listeners.push_back(
+          triangulation->signals.pre_distributed_refinement.connect(
+            update_average));
+        cost_listeners.push_back(
+          triangulation->signals.pre_distributed_repartition.connect(
+            update_average));
+        cost_listeners.push_back(triangulation->signals.any_change.connect(
+          [this]() { clear_cell_costs(); }));
       }
     else
       Assert(
@@ -57,6 +79,8 @@ namespace parallel
   CellWeights<dim, spacedim>::~CellWeights()
   {
     tria_listener.disconnect();
+    for (auto &connection : cost_listeners)
+      connection.disconnect();
   }
 
 
@@ -112,6 +136,119 @@ namespace parallel
 
 
 
+  template <int dim, int spacedim>
+  void
+  CellWeights<dim, spacedim>::register_particle_weighting(
+    const Particles::ParticleHandler<dim, spacedim> &particle_handler,
+    const unsigned int                               weight_per_particle)
+  {
+    this->particle_handler    = &particle_handler;
+    this->weight_per_particle = weight_per_particle;
+  }
+
+
+  template <int dim, int spacedim>
+  void
+  CellWeights<dim, spacedim>::register_measured_cost_weighting(
+    const unsigned int factor)
+  {
+    measured_cost_factor = factor;
+  }
+
+
+  template <int dim, int spacedim>
+  void
+  CellWeights<dim, spacedim>::record_cell_cost(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const double                                                cost)
+  {
+    Assert(cell->active() && cell->is_locally_owned(),
+           ExcMessage("Costs can only be recorded on locally owned "
+                      "active cells."));
+    Assert(cost >= 0., ExcMessage("Cell costs must not be negative."));
+
+    if (cell_costs.empty())
+      cell_costs.resize(triangulation->n_active_cells(), 0.);
+    cell_costs[cell->active_cell_index()] += cost;
+  }
+
+
+  template <int dim, int spacedim>
+  void
+  CellWeights<dim, spacedim>::clear_cell_costs()
+  {
+    cell_costs.clear();
+    average_cell_cost = 0.;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  CellWeights<dim, spacedim>::update_average_cell_cost()
+  {
+    // All processes call this function, so that the reduction is safe even
+    // if only some of them have recorded costs.
+    if (measured_cost_factor == 0)
+      return;
+
+    double local_sum = 0.;
+    for (const double cost : cell_costs)
+      local_sum += cost;
+
+    const double global_sum =
+      Utilities::MPI::sum(local_sum, triangulation->get_communicator());
+    average_cell_cost =
+      global_sum / static_cast<double>(triangulation->n_global_active_cells());
+  }
+
+
+
+  template <int dim, int spacedim>
+  unsigned int
+  CellWeights<dim, spacedim>::additional_weight(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const typename Triangulation<dim, spacedim>::CellStatus     status) const
+  {
+    // Accumulate the number of particles and the measured cost on the cell
+    // as it is present before the mesh changes.
+    unsigned int n_particles = 0;
+    double       cost        = 0.;
+    const auto   accumulate =
+      [&](const typename Triangulation<dim, spacedim>::cell_iterator &active) {
+#ifdef DEAL_II_WITH_P4EST
+        if (particle_handler != nullptr)
+          n_particles += particle_handler->n_particles_in_cell(active);
+#else
+        // Particle handlers are only available with p4est.
+        Assert(particle_handler == nullptr, ExcInternalError());
+#endif
+        if (!cell_costs.empty())
+          cost += cell_costs[active->active_cell_index()];
+      };
+
+    if (status == Triangulation<dim, spacedim>::CELL_COARSEN)
+      for (unsigned int child_index = 0; child_index < cell->n_children();
+           ++child_index)
+        accumulate(cell->child(child_index));
+    else
+      accumulate(cell);
+
+    double weight = static_cast<double>(weight_per_particle) * n_particles;
+    if (measured_cost_factor > 0 && average_cell_cost > 0.)
+      weight += measured_cost_factor * cost / average_cell_cost;
+
+    // The weight returned for a cell that is going to be refined is assigned
+    // to each of its children, so split it among them.
+    if (status == Triangulation<dim, spacedim>::CELL_REFINE ||
+        status == Triangulation<dim, spacedim>::CELL_INVALID)
+      weight /= GeometryInfo<dim>::max_children_per_cell;
+
+    return static_cast<unsigned int>(std::round(weight));
+  }
+
+
+
   template <int dim, int spacedim>
   unsigned int
   CellWeights<dim, spacedim>::weight_callback(
@@ -170,8 +307,10 @@ namespace parallel
           break;
       }
 
-    // Return the cell weight determined by the function of choice.
-    return weighting_function(dof_handler->get_fe(fe_index), cell);
+    // Return the cell weight determined by the function of choice, together
+    // with the contributions of particles and measured costs.
+    return weighting_function(dof_handler->get_fe(fe_index), cell) +
+           additional_weight(cell_, status);
   }
 } // namespace parallel
 
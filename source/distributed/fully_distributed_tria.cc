@@ -0,0 +1,580 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/grid/cell_id.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <algorithm>
+#include <cstdint>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace parallel
+{
+  namespace fullydistributed
+  {
+    template <int dim>
+    CoarseCellData<dim>::CoarseCellData()
+    {
+      std::fill(vertices.begin(),
+                vertices.end(),
+                numbers::invalid_unsigned_int);
+      std::fill(face_manifold_ids.begin(),
+                face_manifold_ids.end(),
+                numbers::flat_manifold_id);
+      std::fill(line_manifold_ids.begin(),
+                line_manifold_ids.end(),
+                numbers::flat_manifold_id);
+    }
+
+
+
+    template <int dim>
+    CellData<dim>::CellData()
+      : coarse_cell_index(numbers::invalid_unsigned_int)
+      , refinement_case(RefinementCase<dim>::no_refinement)
+      , subdomain_id(numbers::artificial_subdomain_id)
+      , material_id(0)
+      , manifold_id(numbers::flat_manifold_id)
+    {
+      std::fill(boundary_ids.begin(),
+                boundary_ids.end(),
+                numbers::internal_face_boundary_id);
+    }
+
+
+
+    template <int dim, int spacedim>
+    ConstructionData<dim, spacedim>
+    create_construction_data(const dealii::Triangulation<dim, spacedim> &tria,
+                             const types::subdomain_id subdomain)
+    {
+      ConstructionData<dim, spacedim> construction_data;
+      if (tria.n_levels() == 0)
+        return construction_data;
+
+      // mark the vertices of the locally owned cells, then the locally owned
+      // cells and the cells sharing a vertex with them as well as all of
+      // their ancestors
+      std::vector<bool> vertex_of_owned_cell(tria.n_vertices(), false);
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->subdomain_id() == subdomain)
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            vertex_of_owned_cell[cell->vertex_index(v)] = true;
+
+      std::vector<std::vector<bool>> cell_is_relevant(tria.n_levels());
+      for (unsigned int level = 0; level < tria.n_levels(); ++level)
+        cell_is_relevant[level].resize(tria.n_raw_cells(level), false);
+      for (const auto &cell : tria.active_cell_iterators())
+        {
+          bool is_relevant = (cell->subdomain_id() == subdomain);
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            if (vertex_of_owned_cell[cell->vertex_index(v)])
+              is_relevant = true;
+          if (is_relevant == false)
+            continue;
+
+          // the ancestors of a cell that has already been marked have been
+          // marked as well
+          for (typename dealii::Triangulation<dim, spacedim>::cell_iterator
+                 ancestor = cell;
+               cell_is_relevant[ancestor->level()][ancestor->index()] ==
+               false;
+               ancestor = ancestor->parent())
+            {
+              cell_is_relevant[ancestor->level()][ancestor->index()] = true;
+              if (ancestor->level() == 0)
+                break;
+            }
+        }
+
+      // collect the coarse cells and their vertices
+      std::vector<unsigned int> coarse_cell_index(
+        tria.n_raw_cells(0), numbers::invalid_unsigned_int);
+      std::vector<unsigned int> vertex_index(tria.n_vertices(),
+                                             numbers::invalid_unsigned_int);
+      for (const auto &cell : tria.cell_iterators_on_level(0))
+        if (cell_is_relevant[0][cell->index()])
+          {
+            coarse_cell_index[cell->index()] =
+              construction_data.coarse_cells.size();
+            construction_data.coarse_cell_index_to_coarse_cell_id.push_back(
+              cell->index());
+
+            CoarseCellData<dim> coarse_cell;
+            for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+                 ++v)
+              {
+                const unsigned int index = cell->vertex_index(v);
+                if (vertex_index[index] == numbers::invalid_unsigned_int)
+                  {
+                    vertex_index[index] =
+                      construction_data.coarse_cell_vertices.size();
+                    construction_data.coarse_cell_vertices.push_back(
+                      cell->vertex(v));
+                  }
+                coarse_cell.vertices[v] = vertex_index[index];
+              }
+            if (dim > 1)
+              for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell;
+                   ++f)
+                coarse_cell.face_manifold_ids[f] = cell->face(f)->manifold_id();
+            if (dim == 3)
+              for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell;
+                   ++l)
+                coarse_cell.line_manifold_ids[l] = cell->line(l)->manifold_id();
+            construction_data.coarse_cells.push_back(coarse_cell);
+          }
+
+      // then the cells on all levels
+      construction_data.cell_infos.resize(tria.n_levels());
+      for (unsigned int level = 0; level < tria.n_levels(); ++level)
+        for (const auto &cell : tria.cell_iterators_on_level(level))
+          if (cell_is_relevant[level][cell->index()])
+            {
+              CellData<dim> cell_data;
+
+              typename dealii::Triangulation<dim, spacedim>::cell_iterator
+                ancestor = cell;
+              while (ancestor->level() > 0)
+                {
+                  const auto parent = ancestor->parent();
+                  for (unsigned int c = 0; c < parent->n_children(); ++c)
+                    if (parent->child(c) == ancestor)
+                      cell_data.child_indices.push_back(c);
+                  ancestor = parent;
+                }
+              std::reverse(cell_data.child_indices.begin(),
+                           cell_data.child_indices.end());
+              cell_data.coarse_cell_index =
+                coarse_cell_index[ancestor->index()];
+
+              if (cell->active())
+                cell_data.subdomain_id = cell->subdomain_id();
+              else
+                cell_data.refinement_case = cell->refinement_case();
+              cell_data.material_id = cell->material_id();
+              cell_data.manifold_id = cell->manifold_id();
+              for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell;
+                   ++f)
+                cell_data.boundary_ids[f] = cell->face(f)->boundary_id();
+
+              construction_data.cell_infos[level].push_back(cell_data);
+            }
+
+      return construction_data;
+    }
+
+
+
+    namespace
+    {
+      /**
+       * Split the brick of cells between @p lower (inclusive) and @p upper
+       * (exclusive) that is assigned to @p n_partitions partitions
+       * recursively in the direction of its largest extent, into two bricks
+       * with numbers of cells proportional to the numbers of partitions
+       * assigned to them, until a brick with a single partition is left.
+       * After each split, @p in_first_half is called with the direction and
+       * position of the split and the first partition of the second half,
+       * and decides which of the two halves to continue with. On return,
+       * @p lower and @p upper describe the brick that is left, and the
+       * number of its partition is returned.
+       */
+      template <int dim, typename Predicate>
+      unsigned int
+      bisect_brick(std::array<unsigned int, dim> &lower,
+                   std::array<unsigned int, dim> &upper,
+                   unsigned int                   n_partitions,
+                   const Predicate &              in_first_half)
+      {
+        unsigned int first_partition = 0;
+        while (n_partitions > 1)
+          {
+            unsigned int direction = 0;
+            for (unsigned int d = 1; d < dim; ++d)
+              if (upper[d] - lower[d] > upper[direction] - lower[direction])
+                direction = d;
+
+            const unsigned int n_first  = n_partitions / 2;
+            const unsigned int position = static_cast<unsigned int>(
+              lower[direction] +
+              std::uint64_t(upper[direction] - lower[direction]) * n_first /
+                n_partitions);
+            if (in_first_half(direction, position, first_partition + n_first))
+              {
+                upper[direction] = position;
+                n_partitions     = n_first;
+              }
+            else
+              {
+                lower[direction] = position;
+                first_partition += n_first;
+                n_partitions -= n_first;
+              }
+          }
+        return first_partition;
+      }
+    } // namespace
+
+
+
+    template <int dim>
+    ConstructionData<dim>
+    create_subdivided_hyper_rectangle_construction_data(
+      const std::vector<unsigned int> &repetitions,
+      const Point<dim> &               p1,
+      const Point<dim> &               p2,
+      const unsigned int               n_partitions,
+      const unsigned int               partition,
+      const bool                       colorize)
+    {
+      AssertDimension(repetitions.size(), dim);
+      AssertIndexRange(partition, n_partitions);
+
+      std::uint64_t n_global_cells = 1;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          Assert(repetitions[d] >= 1,
+                 ExcMessage("The number of repetitions must be positive."));
+          n_global_cells *= repetitions[d];
+        }
+      AssertThrow(n_global_cells < numbers::invalid_unsigned_int,
+                  ExcMessage("The coarse cells of the mesh can not be "
+                             "numbered with unsigned int."));
+
+      // find the brick of cells owned by this partition
+      std::array<unsigned int, dim> owned_lower, owned_upper;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          owned_lower[d] = 0;
+          owned_upper[d] = repetitions[d];
+        }
+      bisect_brick<dim>(
+        owned_lower,
+        owned_upper,
+        n_partitions,
+        [partition](const unsigned int,
+                    const unsigned int,
+                    const unsigned int first_partition_of_second_half) {
+          return partition < first_partition_of_second_half;
+        });
+      for (unsigned int d = 0; d < dim; ++d)
+        AssertThrow(owned_upper[d] > owned_lower[d],
+                    ExcMessage("The mesh is too coarse to give each of the " +
+                               Utilities::to_string(n_partitions) +
+                               " partitions at least one cell."));
+
+      // add the layer of ghost cells, and compute the strides of the
+      // lexicographic numberings of the cells and vertices in this brick and
+      // of the cells in the whole mesh
+      std::array<unsigned int, dim> lower, upper, cell_stride, vertex_stride,
+        global_cell_stride;
+      unsigned int n_cells = 1, n_vertices = 1, n_global = 1;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          lower[d] = (owned_lower[d] > 0 ? owned_lower[d] - 1 : 0);
+          upper[d] = std::min(owned_upper[d] + 1, repetitions[d]);
+
+          cell_stride[d]        = n_cells;
+          vertex_stride[d]      = n_vertices;
+          global_cell_stride[d] = n_global;
+          n_cells *= upper[d] - lower[d];
+          n_vertices *= upper[d] - lower[d] + 1;
+          n_global *= repetitions[d];
+        }
+
+      // the vertices are computed as in
+      // GridGenerator::subdivided_hyper_rectangle(), so that they are the
+      // same on all processes
+      Point<dim> lower_corner, delta;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          lower_corner[d] = std::min(p1[d], p2[d]);
+          delta[d] =
+            (std::max(p1[d], p2[d]) - lower_corner[d]) / repetitions[d];
+          Assert(delta[d] > 0.0,
+                 ExcMessage("The coordinates of p1 and p2 need to be "
+                            "different in all directions."));
+        }
+
+      ConstructionData<dim> construction_data;
+      construction_data.coarse_cell_vertices.resize(n_vertices);
+      for (unsigned int i = 0; i < n_vertices; ++i)
+        {
+          Point<dim> &vertex = construction_data.coarse_cell_vertices[i];
+          for (unsigned int d = 0; d < dim; ++d)
+            vertex[d] =
+              lower_corner[d] +
+              (lower[d] + (i / vertex_stride[d]) % (upper[d] - lower[d] + 1)) *
+                delta[d];
+        }
+
+      construction_data.coarse_cells.resize(n_cells);
+      construction_data.coarse_cell_index_to_coarse_cell_id.resize(n_cells);
+      construction_data.cell_infos.resize(1);
+      construction_data.cell_infos[0].resize(n_cells);
+      for (unsigned int c = 0; c < n_cells; ++c)
+        {
+          std::array<unsigned int, dim> index;
+          bool                          is_owned    = true;
+          unsigned int                  global_cell = 0;
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              index[d] =
+                lower[d] + (c / cell_stride[d]) % (upper[d] - lower[d]);
+              if (index[d] < owned_lower[d] || index[d] >= owned_upper[d])
+                is_owned = false;
+              global_cell += index[d] * global_cell_stride[d];
+            }
+          construction_data.coarse_cell_index_to_coarse_cell_id[c] =
+            global_cell;
+
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            {
+              unsigned int vertex = 0;
+              for (unsigned int d = 0; d < dim; ++d)
+                vertex +=
+                  (index[d] - lower[d] + ((v >> d) & 1)) * vertex_stride[d];
+              construction_data.coarse_cells[c].vertices[v] = vertex;
+            }
+
+          CellData<dim> &cell_data    = construction_data.cell_infos[0][c];
+          cell_data.coarse_cell_index = c;
+          if (is_owned)
+            cell_data.subdomain_id = partition;
+          else
+            {
+              std::array<unsigned int, dim> owner_lower, owner_upper;
+              for (unsigned int d = 0; d < dim; ++d)
+                {
+                  owner_lower[d] = 0;
+                  owner_upper[d] = repetitions[d];
+                }
+              cell_data.subdomain_id = bisect_brick<dim>(
+                owner_lower,
+                owner_upper,
+                n_partitions,
+                [&index](const unsigned int direction,
+                         const unsigned int position,
+                         const unsigned int) {
+                  return index[direction] < position;
+                });
+            }
+
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              if (index[d] == 0)
+                cell_data.boundary_ids[2 * d] = (colorize ? 2 * d : 0);
+              if (index[d] == repetitions[d] - 1)
+                cell_data.boundary_ids[2 * d + 1] = (colorize ? 2 * d + 1 : 0);
+            }
+        }
+
+      return construction_data;
+    }
+
+
+
+#ifdef DEAL_II_WITH_MPI
+
+    template <int dim, int spacedim>
+    Triangulation<dim, spacedim>::Triangulation(MPI_Comm mpi_communicator)
+      : dealii::parallel::Triangulation<dim, spacedim>(mpi_communicator,
+                                                       dealii::Triangulation<
+                                                         dim,
+                                                         spacedim>::none,
+                                                       false)
+    {}
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::create_triangulation(
+      const ConstructionData<dim, spacedim> &construction_data)
+    {
+      Assert(construction_data.cell_infos.size() > 0 &&
+               construction_data.cell_infos[0].size() ==
+                 construction_data.coarse_cells.size(),
+             ExcMessage("The construction data need to describe all coarse "
+                        "cells they contain on level 0."));
+
+      coarse_cell_ids = construction_data.coarse_cell_index_to_coarse_cell_id;
+
+      // create the coarse cells
+      std::vector<dealii::CellData<dim>> cells(
+        construction_data.coarse_cells.size());
+      for (unsigned int c = 0; c < cells.size(); ++c)
+        for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          cells[c].vertices[v] = construction_data.coarse_cells[c].vertices[v];
+      dealii::Triangulation<dim, spacedim>::create_triangulation(
+        construction_data.coarse_cell_vertices, cells, SubCellData());
+
+      // set the manifold ids of the faces and lines of the coarse cells
+      // before refining, so that new vertices are placed on the right
+      // manifolds
+      for (const auto &cell : this->cell_iterators_on_level(0))
+        {
+          const CoarseCellData<dim> &coarse_cell =
+            construction_data.coarse_cells[cell->index()];
+          if (dim > 1)
+            for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell;
+                 ++f)
+              cell->face(f)->set_manifold_id(coarse_cell.face_manifold_ids[f]);
+          if (dim == 3)
+            for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell;
+                 ++l)
+              cell->line(l)->set_manifold_id(coarse_cell.line_manifold_ids[l]);
+        }
+
+      // set the data of the cells level by level, and refine the cells
+      // that have children
+      const auto get_cell = [this](const CellData<dim> &cell_data) {
+        return CellId(cell_data.coarse_cell_index, cell_data.child_indices)
+          .to_cell(*this);
+      };
+      for (unsigned int level = 0;
+           level < construction_data.cell_infos.size();
+           ++level)
+        {
+          bool refine = false;
+          for (const CellData<dim> &cell_data :
+               construction_data.cell_infos[level])
+            {
+              const auto cell = get_cell(cell_data);
+              cell->set_material_id(cell_data.material_id);
+              cell->set_manifold_id(cell_data.manifold_id);
+              // faces at the outer edge of the ghost layer are at the
+              // boundary of the local mesh but not of the global one
+              for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell;
+                   ++f)
+                if (cell->face(f)->at_boundary() &&
+                    cell_data.boundary_ids[f] !=
+                      numbers::internal_face_boundary_id)
+                  cell->face(f)->set_boundary_id(cell_data.boundary_ids[f]);
+
+              // cells may already have been refined to satisfy the level
+              // rules of the triangulation
+              if (cell_data.refinement_case !=
+                    RefinementCase<dim>::no_refinement &&
+                  cell->active())
+                {
+                  cell->set_refine_flag(
+                    RefinementCase<dim>(cell_data.refinement_case));
+                  refine = true;
+                }
+            }
+
+          if (refine)
+            dealii::Triangulation<dim, spacedim>::
+              execute_coarsening_and_refinement();
+        }
+
+      // finally, only the locally owned and ghost cells get their subdomain
+      // ids, all other cells are artificial
+      for (const auto &cell : this->active_cell_iterators())
+        cell->set_subdomain_id(numbers::artificial_subdomain_id);
+      for (const auto &cell_infos : construction_data.cell_infos)
+        for (const CellData<dim> &cell_data : cell_infos)
+          if (cell_data.refinement_case == RefinementCase<dim>::no_refinement)
+            {
+              const auto cell = get_cell(cell_data);
+              Assert(cell->active(), ExcInternalError());
+              cell->set_subdomain_id(cell_data.subdomain_id);
+            }
+
+      this->update_number_cache();
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::create_triangulation(
+      const std::vector<Point<spacedim>> &,
+      const std::vector<dealii::CellData<dim>> &,
+      const SubCellData &)
+    {
+      Assert(false,
+             ExcMessage("A fully distributed triangulation can only be "
+                        "created from a ConstructionData object."));
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::copy_triangulation(
+      const dealii::Triangulation<dim, spacedim> &)
+    {
+      Assert(false,
+             ExcMessage("A fully distributed triangulation can only be "
+                        "created from a ConstructionData object."));
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::execute_coarsening_and_refinement()
+    {
+      Assert(false,
+             ExcMessage("A fully distributed triangulation can not be "
+                        "refined or coarsened."));
+    }
+
+
+
+    template <int dim, int spacedim>
+    unsigned int
+    Triangulation<dim, spacedim>::coarse_cell_index_to_coarse_cell_id(
+      const unsigned int index) const
+    {
+      AssertIndexRange(index, coarse_cell_ids.size());
+      return coarse_cell_ids[index];
+    }
+
+
+
+    template <int dim, int spacedim>
+    std::size_t
+    Triangulation<dim, spacedim>::memory_consumption() const
+    {
+      return dealii::parallel::Triangulation<dim, spacedim>::
+               memory_consumption() +
+             MemoryConsumption::memory_consumption(coarse_cell_ids);
+    }
+
+#endif
+  } // namespace fullydistributed
+} // namespace parallel
+
+
+
+/*-------------- Explicit Instantiations -------------------------------*/
+#include "fully_distributed_tria.inst"
+
+DEAL_II_NAMESPACE_CLOSE
@@ -31,6 +31,7 @@
 #  include <deal.II/grid/tria_iterator.h>
 
 #  include <algorithm>
+#  include <cmath>
 #  include <functional>
 #  include <limits>
 #  include <numeric>
@@ -64,12 +65,12 @@ namespace
 
   /**
    * Compute the global max and min of the criteria vector. These are returned
-   * only on the processor with rank zero, all others get a pair of zeros.
+   * on all processors.
    */
   template <typename number>
   std::pair<number, number>
-  compute_global_min_and_max_at_root(const dealii::Vector<number> &criteria,
-                                     MPI_Comm mpi_communicator)
+  compute_global_min_and_max(const dealii::Vector<number> &criteria,
+                             MPI_Comm                      mpi_communicator)
   {
     // we'd like to compute the global max and min from the local ones in one
     // MPI communication. we can do that by taking the elementwise minimum of
@@ -80,15 +81,10 @@ namespace
     double comp[2]         = {local_min, -local_max};
     double result[2]       = {0, 0};
 
-    // compute the minimum on processor zero
     const int ierr =
-      MPI_Reduce(comp, result, 2, MPI_DOUBLE, MPI_MIN, 0, mpi_communicator);
+      MPI_Allreduce(comp, result, 2, MPI_DOUBLE, MPI_MIN, mpi_communicator);
     AssertThrowMPI(ierr);
 
-    // make sure only processor zero got something
-    if (Utilities::MPI::this_mpi_process(mpi_communicator) != 0)
-      Assert((result[0] == 0) && (result[1] == 0), ExcInternalError());
-
     return std::make_pair(result[0], -result[1]);
   }
 
@@ -96,8 +92,7 @@ namespace
 
   /**
    * Compute the global sum over the elements of the vectors passed to this
-   * function on all processors. This number is returned only on the processor
-   * with rank zero, all others get zero.
+   * function on all processors. This number is returned on all processors.
    */
   template <typename number>
   double
@@ -110,16 +105,11 @@ namespace
                       /* do accumulation in the correct data type: */
                       number());
 
-    double result = 0;
-    // compute the minimum on processor zero
-    const int ierr =
-      MPI_Reduce(&my_sum, &result, 1, MPI_DOUBLE, MPI_SUM, 0, mpi_communicator);
+    double    result = 0;
+    const int ierr   = MPI_Allreduce(
+      &my_sum, &result, 1, MPI_DOUBLE, MPI_SUM, mpi_communicator);
     AssertThrowMPI(ierr);
 
-    // make sure only processor zero got something
-    if (Utilities::MPI::this_mpi_process(mpi_communicator) != 0)
-      Assert(result == 0, ExcInternalError());
-
     return result;
   }
 
@@ -214,6 +204,130 @@ namespace
 
 
 
+  /**
+   * Number of bins of the histograms that are used to locate refinement
+   * thresholds.
+   */
+  const unsigned int n_histogram_bins = 1024;
+
+  /**
+   * Maximal number of histogram rounds. Each round narrows the range in
+   * which the threshold lies down by a factor of n_histogram_bins, so three
+   * rounds resolve it more finely than 25 steps of bisection would.
+   */
+  const unsigned int max_histogram_rounds = 3;
+
+
+
+  /**
+   * Compute a threshold so that the accumulated @p weight of all criteria on
+   * all processors that are larger than the threshold is as close as
+   * possible to @p target.
+   *
+   * Rather than bisecting the interval spanned by the criteria, which needs
+   * one global reduction per step, we sort the criteria into a histogram
+   * with n_histogram_bins bins over the interesting range, sum the
+   * histograms of all processors, and continue with the bin in which the
+   * target is reached. Bins are spaced geometrically if the range does not
+   * contain zero, like the geometric mean in the bisection algorithm.
+   */
+  template <typename number, typename WeightFunction>
+  double
+  compute_threshold_by_histogram(
+    const dealii::Vector<number> &   criteria,
+    const std::pair<double, double> &global_min_and_max,
+    const double                     target,
+    const WeightFunction &           weight,
+    MPI_Comm                         mpi_communicator)
+  {
+    double interesting_range[2] = {global_min_and_max.first,
+                                   global_min_and_max.second};
+    adjust_interesting_range(interesting_range);
+
+    std::vector<double> histogram(n_histogram_bins + 1);
+
+    for (unsigned int round = 0; round < max_histogram_rounds; ++round)
+      {
+        const double lower = interesting_range[0],
+                     upper = interesting_range[1];
+        if (lower == upper)
+          return lower;
+
+        const bool   geometric = (lower > 0);
+        const double log_ratio = geometric ? std::log(upper / lower) : 0.;
+        const auto   edge      = [&](const unsigned int i) -> double {
+          if (i == 0)
+            return lower;
+          else if (i == n_histogram_bins)
+            return upper;
+          else if (geometric)
+            return lower * std::exp(log_ratio * i / n_histogram_bins);
+          else
+            return lower + (upper - lower) * i / n_histogram_bins;
+        };
+
+        // entry i < n_histogram_bins holds the weight of the criteria in
+        // (edge(i), edge(i+1)], the last entry the weight of the ones above
+        // the upper end of the range
+        std::fill(histogram.begin(), histogram.end(), 0.);
+        for (const number c : criteria)
+          if (c > upper)
+            histogram[n_histogram_bins] += weight(c);
+          else if (c > lower)
+            {
+              const double position = geometric ?
+                                        std::log(c / lower) / log_ratio :
+                                        (c - lower) / (upper - lower);
+              unsigned int bin =
+                std::min(static_cast<unsigned int>(position * n_histogram_bins),
+                         n_histogram_bins - 1);
+
+              // correct for round-off in the computation of the position
+              while (bin > 0 && c <= edge(bin))
+                --bin;
+              while (bin < n_histogram_bins - 1 && c > edge(bin + 1))
+                ++bin;
+
+              histogram[bin] += weight(c);
+            }
+
+        const int ierr = MPI_Allreduce(MPI_IN_PLACE,
+                                       histogram.data(),
+                                       histogram.size(),
+                                       MPI_DOUBLE,
+                                       MPI_SUM,
+                                       mpi_communicator);
+        AssertThrowMPI(ierr);
+
+        // walk down from the top of the range and accumulate the weight of
+        // all criteria above edge(bin), as long as it does not exceed the
+        // target
+        double above = histogram[n_histogram_bins];
+        if (above > target)
+          return upper;
+
+        unsigned int bin = n_histogram_bins;
+        while (bin > 0 && above + histogram[bin - 1] <= target)
+          above += histogram[--bin];
+
+        // if we have hit the target exactly, or cannot get closer to it, we
+        // are done. otherwise, it is reached within the bin below edge(bin)
+        if (above == target || bin == 0)
+          return edge(bin);
+
+        interesting_range[0] = edge(bin - 1);
+        interesting_range[1] = edge(bin);
+      }
+
+    // the criteria in the remaining range are so close together that we
+    // can't do much better than picking a value in its middle
+    return (interesting_range[0] > 0 ?
+              std::sqrt(interesting_range[0] * interesting_range[1]) :
+              (interesting_range[0] + interesting_range[1]) / 2);
+  }
+
+
+
   namespace RefineAndCoarsenFixedNumber
   {
     /**
@@ -227,80 +341,12 @@ namespace
                       const unsigned int               n_target_cells,
                       MPI_Comm                         mpi_communicator)
     {
-      double interesting_range[2] = {global_min_and_max.first,
-                                     global_min_and_max.second};
-      adjust_interesting_range(interesting_range);
-
-      const unsigned int master_mpi_rank = 0;
-      unsigned int       iteration       = 0;
-
-      do
-        {
-          int ierr = MPI_Bcast(interesting_range,
-                               2,
-                               MPI_DOUBLE,
-                               master_mpi_rank,
-                               mpi_communicator);
-          AssertThrowMPI(ierr);
-
-          if (interesting_range[0] == interesting_range[1])
-            return interesting_range[0];
-
-          const double test_threshold =
-            (interesting_range[0] > 0 ?
-               std::sqrt(interesting_range[0] * interesting_range[1]) :
-               (interesting_range[0] + interesting_range[1]) / 2);
-
-          // count how many of our own elements would be above this threshold
-          // and then add to it the number for all the others
-          unsigned int my_count =
-            std::count_if(criteria.begin(),
-                          criteria.end(),
-                          [test_threshold](const double c) {
-                            return c > test_threshold;
-                          });
-
-          unsigned int total_count = 0;
-
-          ierr = MPI_Reduce(&my_count,
-                            &total_count,
-                            1,
-                            MPI_UNSIGNED,
-                            MPI_SUM,
-                            master_mpi_rank,
-                            mpi_communicator);
-          AssertThrowMPI(ierr);
-
-          // now adjust the range. if we have too many cells, we take the upper
-          // half of the previous range, otherwise the lower half. if we have
-          // hit the right number, then set the range to the exact value.
-          // slave nodes also update their own interesting_range, however their
-          // results are not significant since the values will be overwritten by
-          // MPI_Bcast from the master node in next loop.
-          if (total_count > n_target_cells)
-            interesting_range[0] = test_threshold;
-          else if (total_count < n_target_cells)
-            interesting_range[1] = test_threshold;
-          else
-            interesting_range[0] = interesting_range[1] = test_threshold;
-
-          // terminate the iteration after 25 go-arounds. this is necessary
-          // because oftentimes error indicators on cells have exactly the
-          // same value, and so there may not be a particular value that cuts
-          // the indicators in such a way that we can achieve the desired
-          // number of cells. using a maximal number of iterations means that
-          // we terminate the iteration after a fixed number N of steps if the
-          // indicators were perfectly badly distributed, and we make at most
-          // a mistake of 1/2^N in the number of cells flagged if indicators
-          // are perfectly equidistributed
-          ++iteration;
-          if (iteration == 25)
-            interesting_range[0] = interesting_range[1] = test_threshold;
-        }
-      while (true);
-
-      Assert(false, ExcInternalError());
-      return -1;
+      return compute_threshold_by_histogram(
+        criteria,
+        global_min_and_max,
+        n_target_cells,
+        [](const number) { return 1.; },
+        mpi_communicator);
     }
   } // namespace RefineAndCoarsenFixedNumber
 
@@ -321,97 +367,19 @@ namespace
                       const double                     target_error,
                       MPI_Comm                         mpi_communicator)
     {
-      double interesting_range[2] = {global_min_and_max.first,
-                                     global_min_and_max.second};
-      adjust_interesting_range(interesting_range);
-
-      const unsigned int master_mpi_rank = 0;
-      unsigned int       iteration       = 0;
-
-      do
-        {
-          int ierr = MPI_Bcast(interesting_range,
-                               2,
-                               MPI_DOUBLE,
-                               master_mpi_rank,
-                               mpi_communicator);
-          AssertThrowMPI(ierr);
-
-          if (interesting_range[0] == interesting_range[1])
-            {
-              // so we have found our threshold. since we adjust the range
-              // at the top of the function to be slightly larger than the
-              // actual extremes of the refinement criteria values, we can end
-              // up in a situation where the threshold is in fact larger than
-              // the maximal refinement indicator. in such cases, we get no
-              // refinement at all. thus, cap the threshold by the actual
-              // largest value
-              double final_threshold =
-                std::min(interesting_range[0], global_min_and_max.second);
-              ierr = MPI_Bcast(&final_threshold,
-                               1,
-                               MPI_DOUBLE,
-                               master_mpi_rank,
-                               mpi_communicator);
-              AssertThrowMPI(ierr);
-
-              return final_threshold;
-            }
-
-          const double test_threshold =
-            (interesting_range[0] > 0 ?
-               std::sqrt(interesting_range[0] * interesting_range[1]) :
-               (interesting_range[0] + interesting_range[1]) / 2);
-
-          // accumulate the error of those our own elements above this threshold
-          // and then add to it the number for all the others
-          double my_error = 0;
-          for (unsigned int i = 0; i < criteria.size(); ++i)
-            if (criteria(i) > test_threshold)
-              my_error += criteria(i);
-
-          double total_error = 0.;
-
-          ierr = MPI_Reduce(&my_error,
-                            &total_error,
-                            1,
-                            MPI_DOUBLE,
-                            MPI_SUM,
-                            master_mpi_rank,
-                            mpi_communicator);
-          AssertThrowMPI(ierr);
-
-          // now adjust the range. if we have too many cells, we take the upper
-          // half of the previous range, otherwise the lower half. if we have
-          // hit the right number, then set the range to the exact value.
-          // slave nodes also update their own interesting_range, however their
-          // results are not significant since the values will be overwritten by
-          // MPI_Bcast from the master node in next loop.
-          if (total_error > target_error)
-            interesting_range[0] = test_threshold;
-          else if (total_error < target_error)
-            interesting_range[1] = test_threshold;
-          else
-            interesting_range[0] = interesting_range[1] = test_threshold;
-
-          // terminate the iteration after 25 go-arounds. this is
-          // necessary because oftentimes error indicators on cells
-          // have exactly the same value, and so there may not be a
-          // particular value that cuts the indicators in such a way
-          // that we can achieve the desired number of cells. using a
-          // max of 25 iterations means that we terminate the
-          // iteration after 25 steps if the indicators were perfectly
-          // badly distributed, and we make at most a mistake of
-          // 1/2^25 in the number of cells flagged if indicators are
-          // perfectly equidistributed
-          ++iteration;
-          if (iteration == 25)
-            interesting_range[0] = interesting_range[1] = test_threshold;
-        }
-      while (true);
-
-      Assert(false, ExcInternalError());
-      return -1;
+      const double threshold = compute_threshold_by_histogram(
+        criteria,
+        global_min_and_max,
+        target_error,
+        [](const number c) { return static_cast<double>(c); },
+        mpi_communicator);
+
+      // since we adjust the range at the top of the function to be slightly
+      // larger than the actual extremes of the refinement criteria values, we
+      // can end up in a situation where the threshold is in fact larger than
+      // the maximal refinement indicator. in such cases, we get no refinement
+      // at all. thus, cap the threshold by the actual largest value
+      return std::min(threshold, global_min_and_max.second);
     }
   } // namespace RefineAndCoarsenFixedFraction
 } // namespace
@@ -460,11 +428,10 @@ namespace parallel
 
         MPI_Comm mpi_communicator = tria.get_communicator();
 
-        // figure out the global max and min of the indicators. we don't need it
-        // here, but it's a collective communication call
+        // figure out the global max and min of the indicators
         const std::pair<Number, Number> global_min_and_max =
-          compute_global_min_and_max_at_root(locally_owned_indicators,
-                                             mpi_communicator);
+          compute_global_min_and_max(locally_owned_indicators,
+                                     mpi_communicator);
 
 
         double top_threshold, bottom_threshold;
@@ -524,11 +491,10 @@ namespace parallel
 
         MPI_Comm mpi_communicator = tria.get_communicator();
 
-        // figure out the global max and min of the indicators. we don't need it
-        // here, but it's a collective communication call
+        // figure out the global max and min of the indicators
         const std::pair<double, double> global_min_and_max =
-          compute_global_min_and_max_at_root(locally_owned_indicators,
-                                             mpi_communicator);
+          compute_global_min_and_max(locally_owned_indicators,
+                                     mpi_communicator);
 
         const double total_error =
           compute_global_sum(locally_owned_indicators, mpi_communicator);
@@ -38,7 +38,10 @@
 #  include <deal.II/lac/trilinos_vector.h>
 #  include <deal.II/lac/vector.h>
 
+#  include <algorithm>
+#  include <cstring>
 #  include <functional>
+#  include <limits>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -51,6 +54,8 @@ namespace parallel
       const DoFHandlerType &dof)
       : dof_handler(&dof, typeid(*this).name())
       , handle(numbers::invalid_unsigned_int)
+      , repartition_n_vectors(0)
+      , repartition_first_cell(0)
     {
       Assert(
         (dynamic_cast<const parallel::distributed::
@@ -307,22 +312,38 @@ namespace parallel
         }
       else
         {
-          auto it_input  = input_vectors.cbegin();
-          auto it_output = dofvalues.begin();
-          for (; it_input != input_vectors.cend(); ++it_input, ++it_output)
+          // Without hp, all cells carry the same number of values, which go
+          // to the fixed size buffer. Write them directly into the buffer,
+          // one vector after the other, without any size information.
+          const unsigned int dofs_per_cell = cell->get_fe().dofs_per_cell;
+          const std::size_t  bytes_per_vector =
+            dofs_per_cell * sizeof(typename VectorType::value_type);
+          std::vector<char> buffer(input_vectors.size() * bytes_per_vector);
+
+          ::dealii::Vector<typename VectorType::value_type> values(
+            dofs_per_cell);
+          for (unsigned int v = 0; v < input_vectors.size(); ++v)
             {
-              it_output->reinit(cell->get_fe().dofs_per_cell);
-              cell->get_interpolated_dof_values(*(*it_input), *it_output);
+              cell->get_interpolated_dof_values(*input_vectors[v], values);
+              if (dofs_per_cell > 0)
+                std::memcpy(buffer.data() + v * bytes_per_vector,
+                            values.begin(),
+                            bytes_per_vector);
             }
+          return buffer;
         }
 
-      // We choose to compress the packed data depending on the registered
-      // dofhandler object. In case of hp, we write in the variable size buffer
-      // and thus allow compression. In the other case, we use the fixed size
-      // buffer and require consistent data sizes on each cell, so we leave it
-      // uncompressed.
-      return Utilities::pack(
-        dofvalues, /*allow_compression=*/DoFHandlerType::is_hp_dof_handler);
+      // Concatenate the values of all vectors, which allows Utilities::pack()
+      // to copy them as a whole instead of going through boost serialization.
+      std::vector<typename VectorType::value_type> packed_values;
+      packed_values.reserve(dofvalues.size() *
+                            (dofvalues.empty() ? 0 : dofvalues[0].size()));
+      for (const auto &values : dofvalues)
+        packed_values.insert(packed_values.end(), values.begin(), values.end());
+
+      // In case of hp, we write in the variable size buffer and thus allow
+      // compression.
+      return Utilities::pack(packed_values, /*allow_compression=*/true);
     }
 
 
@@ -341,15 +362,46 @@ namespace parallel
     {
       typename DoFHandlerType::cell_iterator cell(*cell_, dof_handler);
 
-      const std::vector<::dealii::Vector<typename VectorType::value_type>>
-        dofvalues = Utilities::unpack<
-          std::vector<::dealii::Vector<typename VectorType::value_type>>>(
-          data_range.begin(),
-          data_range.end(),
-          /*allow_compression=*/DoFHandlerType::is_hp_dof_handler);
+      // In case of hp, the values have been packed as one vector, see
+      // pack_callback(). Otherwise, the buffer holds the raw values.
+      std::vector<typename VectorType::value_type> packed_values;
+      const char *                                 values_begin = nullptr;
+      std::size_t                                  n_values     = 0;
+      if (DoFHandlerType::is_hp_dof_handler)
+        {
+          packed_values =
+            Utilities::unpack<std::vector<typename VectorType::value_type>>(
+              data_range.begin(),
+              data_range.end(),
+              /*allow_compression=*/true);
+          values_begin = reinterpret_cast<const char *>(packed_values.data());
+          n_values     = packed_values.size();
+        }
+      else if (data_range.empty() == false)
+        {
+          values_begin = &*data_range.begin();
+          n_values =
+            data_range.size() / sizeof(typename VectorType::value_type);
+        }
 
-      // check if sizes match
-      Assert(dofvalues.size() == all_out.size(), ExcInternalError());
+      // split the values into those of the individual vectors, which all
+      // have the same number of entries
+      Assert(all_out.empty() || n_values % all_out.size() == 0,
+             ExcInternalError());
+      const std::size_t dofs_per_vector =
+        all_out.empty() ? 0 : n_values / all_out.size();
+      std::vector<::dealii::Vector<typename VectorType::value_type>> dofvalues(
+        all_out.size());
+      for (unsigned int v = 0; v < all_out.size(); ++v)
+        {
+          dofvalues[v].reinit(dofs_per_vector, /*omit_zeroing_entries=*/true);
+          const std::size_t bytes_per_vector =
+            dofs_per_vector * sizeof(typename VectorType::value_type);
+          if (bytes_per_vector > 0)
+            std::memcpy(dofvalues[v].begin(),
+                        values_begin + v * bytes_per_vector,
+                        bytes_per_vector);
+        }
 
       if (DoFHandlerType::is_hp_dof_handler)
         {
@@ -434,6 +486,548 @@ namespace parallel
     }
 
 
+
+    namespace
+    {
+      /**
+       * Append the locally owned active cells of the subtree rooted at
+       * @p cell to @p cells, visiting the children in the order of their
+       * child index. This coincides with the order in which p4est traverses
+       * the leaves of a tree.
+       */
+      template <typename CellIterator, typename ActiveCellIterator>
+      void
+      collect_locally_owned_cells(const CellIterator &             cell,
+                                  std::vector<ActiveCellIterator> &cells)
+      {
+        if (cell->has_children())
+          for (unsigned int c = 0; c < cell->n_children(); ++c)
+            collect_locally_owned_cells(cell->child(c), cells);
+        else if (cell->is_locally_owned())
+          cells.push_back(cell);
+      }
+
+
+
+      /**
+       * The number of entries of the header at the beginning of a file
+       * written by SolutionTransfer::save(): the number of vectors, the
+       * number of degrees of freedom per cell, the size of a vector entry in
+       * bytes, and the total number of cells.
+       */
+      constexpr unsigned int n_header_entries = 4;
+
+
+
+      /**
+       * Return the position of the first of the @p n_my_cells locally owned
+       * cells in the order in which p4est enumerates the active cells of the
+       * forest.
+       */
+      unsigned long long int
+      get_first_cell_in_p4est_order(const unsigned long long int n_my_cells,
+                                    const MPI_Comm &             comm)
+      {
+        unsigned long long int first_cell = 0;
+        const int ierr = MPI_Exscan(DEAL_II_MPI_CONST_CAST(&n_my_cells),
+                                    &first_cell,
+                                    1,
+                                    MPI_UNSIGNED_LONG_LONG,
+                                    MPI_SUM,
+                                    comm);
+        AssertThrowMPI(ierr);
+        if (Utilities::MPI::this_mpi_process(comm) == 0)
+          first_cell = 0;
+        return first_cell;
+      }
+
+
+
+      /**
+       * Copy the values of all @p vectors on @p cells into the contiguous
+       * buffer @p data, in the layout [cell][vector][dof].
+       */
+      template <typename CellIterator, typename VectorType>
+      void
+      gather_cell_values(const std::vector<CellIterator> &       cells,
+                         const std::vector<const VectorType *> &vectors,
+                         const unsigned int                     dofs_per_cell,
+                         std::vector<typename VectorType::value_type> &data)
+      {
+        const unsigned int n_vectors = vectors.size();
+        data.resize(cells.size() * n_vectors * dofs_per_cell);
+
+        Vector<typename VectorType::value_type> local_values(dofs_per_cell);
+        for (unsigned int c = 0; c < cells.size(); ++c)
+          for (unsigned int v = 0; v < n_vectors; ++v)
+            {
+              cells[c]->get_dof_values(*vectors[v], local_values);
+              std::copy(local_values.begin(),
+                        local_values.end(),
+                        data.begin() +
+                          (std::size_t(c) * n_vectors + v) * dofs_per_cell);
+            }
+      }
+
+
+
+      /**
+       * The inverse of gather_cell_values(): write the values stored in
+       * @p data into all @p vectors on @p cells and compress the vectors.
+       */
+      template <typename CellIterator, typename VectorType>
+      void
+      scatter_cell_values(
+        const std::vector<CellIterator> &                   cells,
+        const std::vector<typename VectorType::value_type> &data,
+        const unsigned int                                  dofs_per_cell,
+        std::vector<VectorType *> &                         vectors)
+      {
+        const unsigned int n_vectors = vectors.size();
+        Assert(data.size() == cells.size() * n_vectors * dofs_per_cell,
+               ExcInternalError());
+
+        Vector<typename VectorType::value_type> local_values(dofs_per_cell);
+        for (unsigned int c = 0; c < cells.size(); ++c)
+          for (unsigned int v = 0; v < n_vectors; ++v)
+            {
+              const auto begin =
+                data.begin() + (std::size_t(c) * n_vectors + v) * dofs_per_cell;
+              std::copy(begin, begin + dofs_per_cell, local_values.begin());
+              cells[c]->set_dof_values(local_values, *vectors[v]);
+            }
+
+        for (VectorType *vector : vectors)
+          vector->compress(::dealii::VectorOperation::insert);
+      }
+    } // namespace
+
+
+
+    template <int dim, typename VectorType, typename DoFHandlerType>
+    std::vector<typename DoFHandlerType::active_cell_iterator>
+    SolutionTransfer<dim, VectorType, DoFHandlerType>::
+      get_locally_owned_cells_in_p4est_order() const
+    {
+      const auto tria =
+        dynamic_cast<const parallel::distributed::
+                       Triangulation<dim, DoFHandlerType::space_dimension> *>(
+          &dof_handler->get_triangulation());
+      Assert(tria != nullptr, ExcInternalError());
+
+      std::vector<typename DoFHandlerType::active_cell_iterator> cells;
+      cells.reserve(tria->n_locally_owned_active_cells());
+      for (const types::global_dof_index coarse_cell_index :
+           tria->get_p4est_tree_to_coarse_cell_permutation())
+        collect_locally_owned_cells(
+          typename DoFHandlerType::cell_iterator(tria,
+                                                 0,
+                                                 coarse_cell_index,
+                                                 &*dof_handler),
+          cells);
+
+      return cells;
+    }
+
+
+
+    template <int dim, typename VectorType, typename DoFHandlerType>
+    void
+    SolutionTransfer<dim, VectorType, DoFHandlerType>::save(
+      const std::vector<const VectorType *> &all_in,
+      const std::string &                    filename) const
+    {
+      using value_type = typename VectorType::value_type;
+
+      Assert(dof_handler->get_fe_collection().size() == 1,
+             ExcMessage("This function requires that all cells use the same "
+                        "finite element."));
+      const unsigned int n_vectors     = all_in.size();
+      const unsigned int dofs_per_cell = dof_handler->get_fe(0).dofs_per_cell;
+
+      const std::vector<typename DoFHandlerType::active_cell_iterator> cells =
+        get_locally_owned_cells_in_p4est_order();
+
+      // copy the values of all locally owned cells into one contiguous
+      // buffer, in the layout [cell][vector][dof]
+      std::vector<value_type> data;
+      gather_cell_values(cells, all_in, dofs_per_cell, data);
+
+      const MPI_Comm comm =
+        dynamic_cast<const parallel::Triangulation<
+          dim,
+          DoFHandlerType::space_dimension> &>(dof_handler->get_triangulation())
+          .get_communicator();
+
+      // compute the position of the data of this process in the file
+      const unsigned long long int first_cell =
+        get_first_cell_in_p4est_order(cells.size(), comm);
+      const unsigned int myrank = Utilities::MPI::this_mpi_process(comm);
+
+      MPI_File fh;
+      int      ierr = MPI_File_open(comm,
+                           DEAL_II_MPI_CONST_CAST(filename.c_str()),
+                           MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                           MPI_INFO_NULL,
+                           &fh);
+      AssertThrowMPI(ierr);
+
+      ierr = MPI_File_set_size(fh, 0); // delete the file contents
+      AssertThrowMPI(ierr);
+      // this barrier is necessary, because otherwise others might already
+      // write while one core is still setting the size to zero.
+      ierr = MPI_Barrier(comm);
+      AssertThrowMPI(ierr);
+
+      const std::size_t cell_size =
+        std::size_t(n_vectors) * dofs_per_cell * sizeof(value_type);
+      const std::size_t header_size =
+        n_header_entries * sizeof(unsigned long long int);
+      if (myrank == 0)
+        {
+          const unsigned long long int header[n_header_entries] = {
+            n_vectors,
+            dofs_per_cell,
+            sizeof(value_type),
+            dof_handler->get_triangulation().n_global_active_cells()};
+          ierr = MPI_File_write_at(fh,
+                                   0,
+                                   DEAL_II_MPI_CONST_CAST(header),
+                                   n_header_entries,
+                                   MPI_UNSIGNED_LONG_LONG,
+                                   MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+
+      // write the data with collective calls, in blocks that fit into the
+      // int argument of MPI_File_write_at_all(). all processes need to take
+      // part in the same number of calls, even if they do not write anything
+      const char *bytes = reinterpret_cast<const char *>(data.data());
+      const std::size_t n_bytes    = data.size() * sizeof(value_type);
+      const std::size_t block_size = 1 << 30;
+      unsigned long long int n_blocks = (n_bytes + block_size - 1) / block_size;
+      ierr                            = MPI_Allreduce(
+        MPI_IN_PLACE, &n_blocks, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, comm);
+      AssertThrowMPI(ierr);
+      for (unsigned long long int block = 0; block < n_blocks; ++block)
+        {
+          const std::size_t begin =
+            std::min<std::size_t>(block * block_size, n_bytes);
+          const std::size_t end = std::min(begin + block_size, n_bytes);
+          ierr                  = MPI_File_write_at_all(fh,
+                                       header_size + first_cell * cell_size +
+                                         begin,
+                                       DEAL_II_MPI_CONST_CAST(bytes + begin),
+                                       end - begin,
+                                       MPI_CHAR,
+                                       MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+
+      ierr = MPI_File_close(&fh);
+      AssertThrowMPI(ierr);
+    }
+
+
+
+    template <int dim, typename VectorType, typename DoFHandlerType>
+    void
+    SolutionTransfer<dim, VectorType, DoFHandlerType>::save(
+      const VectorType & in,
+      const std::string &filename) const
+    {
+      std::vector<const VectorType *> all_in(1, &in);
+      save(all_in, filename);
+    }
+
+
+
+    template <int dim, typename VectorType, typename DoFHandlerType>
+    void
+    SolutionTransfer<dim, VectorType, DoFHandlerType>::load(
+      std::vector<VectorType *> &all_out,
+      const std::string &        filename) const
+    {
+      using value_type = typename VectorType::value_type;
+
+      Assert(dof_handler->get_fe_collection().size() == 1,
+             ExcMessage("This function requires that all cells use the same "
+                        "finite element."));
+      const unsigned int n_vectors     = all_out.size();
+      const unsigned int dofs_per_cell = dof_handler->get_fe(0).dofs_per_cell;
+
+      const std::vector<typename DoFHandlerType::active_cell_iterator> cells =
+        get_locally_owned_cells_in_p4est_order();
+
+      const MPI_Comm comm =
+        dynamic_cast<const parallel::Triangulation<
+          dim,
+          DoFHandlerType::space_dimension> &>(dof_handler->get_triangulation())
+          .get_communicator();
+
+      const unsigned long long int first_cell =
+        get_first_cell_in_p4est_order(cells.size(), comm);
+
+      MPI_File fh;
+      int      ierr = MPI_File_open(comm,
+                           DEAL_II_MPI_CONST_CAST(filename.c_str()),
+                           MPI_MODE_RDONLY,
+                           MPI_INFO_NULL,
+                           &fh);
+      AssertThrowMPI(ierr);
+
+      unsigned long long int header[n_header_entries];
+      ierr = MPI_File_read_at_all(fh,
+                                  0,
+                                  header,
+                                  n_header_entries,
+                                  MPI_UNSIGNED_LONG_LONG,
+                                  MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+      AssertThrow(header[0] == n_vectors,
+                  ExcMessage("The number of vectors stored in the file does "
+                             "not match the number of given vectors."));
+      AssertThrow(header[1] == dofs_per_cell,
+                  ExcMessage("The number of degrees of freedom per cell "
+                             "stored in the file does not match the finite "
+                             "element of the DoFHandler."));
+      AssertThrow(header[2] == sizeof(value_type),
+                  ExcMessage("The vector entries stored in the file have a "
+                             "different size than those of the given vector "
+                             "type."));
+      AssertThrow(header[3] ==
+                    dof_handler->get_triangulation().n_global_active_cells(),
+                  ExcMessage("The number of cells stored in the file does not "
+                             "match the current triangulation."));
+
+      const std::size_t cell_size =
+        std::size_t(n_vectors) * dofs_per_cell * sizeof(value_type);
+      const std::size_t header_size =
+        n_header_entries * sizeof(unsigned long long int);
+
+      std::vector<value_type> data(cells.size() * n_vectors * dofs_per_cell);
+      char *            bytes      = reinterpret_cast<char *>(data.data());
+      const std::size_t n_bytes    = data.size() * sizeof(value_type);
+      const std::size_t block_size = 1 << 30;
+      unsigned long long int n_blocks = (n_bytes + block_size - 1) / block_size;
+      ierr                            = MPI_Allreduce(
+        MPI_IN_PLACE, &n_blocks, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, comm);
+      AssertThrowMPI(ierr);
+      for (unsigned long long int block = 0; block < n_blocks; ++block)
+        {
+          const std::size_t begin =
+            std::min<std::size_t>(block * block_size, n_bytes);
+          const std::size_t end = std::min(begin + block_size, n_bytes);
+          ierr                  = MPI_File_read_at_all(fh,
+                                      header_size + first_cell * cell_size +
+                                        begin,
+                                      bytes + begin,
+                                      end - begin,
+                                      MPI_CHAR,
+                                      MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+
+      ierr = MPI_File_close(&fh);
+      AssertThrowMPI(ierr);
+
+      scatter_cell_values(cells, data, dofs_per_cell, all_out);
+    }
+
+
+
+    template <int dim, typename VectorType, typename DoFHandlerType>
+    void
+    SolutionTransfer<dim, VectorType, DoFHandlerType>::load(
+      VectorType &       out,
+      const std::string &filename) const
+    {
+      std::vector<VectorType *> all_out(1, &out);
+      load(all_out, filename);
+    }
+
+
+
+    template <int dim, typename VectorType, typename DoFHandlerType>
+    void
+    SolutionTransfer<dim, VectorType, DoFHandlerType>::
+      prepare_for_repartitioning(const std::vector<const VectorType *> &all_in)
+    {
+      Assert(dof_handler->get_fe_collection().size() == 1,
+             ExcMessage("This function requires that all cells use the same "
+                        "finite element."));
+
+      const std::vector<typename DoFHandlerType::active_cell_iterator> cells =
+        get_locally_owned_cells_in_p4est_order();
+
+      gather_cell_values(cells,
+                         all_in,
+                         dof_handler->get_fe(0).dofs_per_cell,
+                         repartition_data);
+      repartition_n_vectors = all_in.size();
+
+      const MPI_Comm comm =
+        dynamic_cast<const parallel::Triangulation<
+          dim,
+          DoFHandlerType::space_dimension> &>(dof_handler->get_triangulation())
+          .get_communicator();
+      repartition_first_cell =
+        get_first_cell_in_p4est_order(cells.size(), comm);
+    }
+
+
+
+    template <int dim, typename VectorType, typename DoFHandlerType>
+    void
+    SolutionTransfer<dim, VectorType, DoFHandlerType>::
+      prepare_for_repartitioning(const VectorType &in)
+    {
+      std::vector<const VectorType *> all_in(1, &in);
+      prepare_for_repartitioning(all_in);
+    }
+
+
+
+    template <int dim, typename VectorType, typename DoFHandlerType>
+    void
+    SolutionTransfer<dim, VectorType, DoFHandlerType>::
+      interpolate_after_repartitioning(std::vector<VectorType *> &all_out)
+    {
+      using value_type = typename VectorType::value_type;
+
+      Assert(all_out.size() == repartition_n_vectors,
+             ExcDimensionMismatch(all_out.size(), repartition_n_vectors));
+      Assert(dof_handler->get_fe_collection().size() == 1,
+             ExcMessage("This function requires that all cells use the same "
+                        "finite element."));
+      const std::size_t cell_size =
+        std::size_t(repartition_n_vectors) *
+        dof_handler->get_fe(0).dofs_per_cell;
+
+      const std::vector<typename DoFHandlerType::active_cell_iterator> cells =
+        get_locally_owned_cells_in_p4est_order();
+
+      const MPI_Comm comm =
+        dynamic_cast<const parallel::Triangulation<
+          dim,
+          DoFHandlerType::space_dimension> &>(dof_handler->get_triangulation())
+          .get_communicator();
+      const unsigned int myrank  = Utilities::MPI::this_mpi_process(comm);
+      const unsigned int n_ranks = Utilities::MPI::n_mpi_processes(comm);
+
+      // exchange the old and new ranges of cells in p4est order of all
+      // processes. since repartitioning does not change the order, these
+      // ranges determine which process sends which part of its data to which
+      // other process.
+      const unsigned long long int n_old_cells =
+        (cell_size == 0 ? 0 : repartition_data.size() / cell_size);
+      const unsigned long long int new_first_cell =
+        get_first_cell_in_p4est_order(cells.size(), comm);
+      const unsigned long long int my_ranges[4] = {
+        repartition_first_cell,
+        repartition_first_cell + n_old_cells,
+        new_first_cell,
+        new_first_cell + cells.size()};
+      std::vector<unsigned long long int> ranges(4 * n_ranks);
+      int ierr = MPI_Allgather(DEAL_II_MPI_CONST_CAST(my_ranges),
+                               4,
+                               MPI_UNSIGNED_LONG_LONG,
+                               ranges.data(),
+                               4,
+                               MPI_UNSIGNED_LONG_LONG,
+                               comm);
+      AssertThrowMPI(ierr);
+      Assert(cell_size == 0 || ranges[4 * n_ranks - 3] == ranges.back(),
+             ExcMessage("The number of cells has changed since "
+                        "prepare_for_repartitioning() was called. This "
+                        "function only supports repartitioning without "
+                        "refinement or coarsening."));
+
+      const int mpi_tag = 110;
+
+      std::vector<value_type>  data(cells.size() * cell_size);
+      std::vector<MPI_Request> requests;
+      const auto               n_bytes = [&](const unsigned long long int n) {
+        const std::size_t bytes = n * cell_size * sizeof(value_type);
+        AssertThrow(bytes <= static_cast<std::size_t>(
+                               std::numeric_limits<int>::max()),
+                    ExcMessage("The data to be sent to a single process is "
+                               "too large for one MPI message."));
+        return static_cast<int>(bytes);
+      };
+      for (unsigned int p = 0; p < n_ranks; ++p)
+        {
+          // the part of our old cells that process p owns now
+          unsigned long long int begin =
+            std::max(my_ranges[0], ranges[4 * p + 2]);
+          unsigned long long int end =
+            std::min(my_ranges[1], ranges[4 * p + 3]);
+          if (begin < end && cell_size > 0)
+            {
+              const value_type *send_data =
+                repartition_data.data() +
+                (begin - repartition_first_cell) * cell_size;
+              if (p == myrank)
+                std::copy(send_data,
+                          send_data + (end - begin) * cell_size,
+                          data.begin() + (begin - new_first_cell) * cell_size);
+              else
+                {
+                  requests.emplace_back();
+                  ierr = MPI_Isend(DEAL_II_MPI_CONST_CAST(send_data),
+                                   n_bytes(end - begin),
+                                   MPI_BYTE,
+                                   p,
+                                   mpi_tag,
+                                   comm,
+                                   &requests.back());
+                  AssertThrowMPI(ierr);
+                }
+            }
+
+          // the part of our new cells that process p owned before
+          begin = std::max(ranges[4 * p], my_ranges[2]);
+          end   = std::min(ranges[4 * p + 1], my_ranges[3]);
+          if (begin < end && cell_size > 0 && p != myrank)
+            {
+              requests.emplace_back();
+              ierr =
+                MPI_Irecv(data.data() + (begin - new_first_cell) * cell_size,
+                          n_bytes(end - begin),
+                          MPI_BYTE,
+                          p,
+                          mpi_tag,
+                          comm,
+                          &requests.back());
+              AssertThrowMPI(ierr);
+            }
+        }
+
+      ierr = MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+      AssertThrowMPI(ierr);
+
+      // release the memory of the old data before writing the new one
+      std::vector<value_type>().swap(repartition_data);
+      repartition_n_vectors = 0;
+
+      scatter_cell_values(cells,
+                          data,
+                          dof_handler->get_fe(0).dofs_per_cell,
+                          all_out);
+    }
+
+
+
+    template <int dim, typename VectorType, typename DoFHandlerType>
+    void
+    SolutionTransfer<dim, VectorType, DoFHandlerType>::
+      interpolate_after_repartitioning(VectorType &out)
+    {
+      std::vector<VectorType *> all_out(1, &out);
+      interpolate_after_repartitioning(all_out);
+    }
+
+
   } // namespace distributed
 } // namespace parallel
 
@@ -1141,6 +1141,13 @@ namespace parallel
 
 
 
+    template <int dim, int spacedim>
+    Triangulation<dim, spacedim>::MovedVerticesExchange::MovedVerticesExchange()
+      : is_valid(false)
+    {}
+
+
+
     template <int dim, int spacedim>
     void
     Triangulation<dim, spacedim>::DataTransfer::pack_data(
@@ -2241,6 +2248,9 @@ namespace parallel
           // store for each cell the vertices we send/receive
           // (for each cell n_vertices entries)
           std::vector<dealii::Point<spacedim>> vertices;
+          // on the sending side, store the indices of these vertices in the
+          // triangulation, which are not sent
+          std::vector<unsigned int> local_vertex_indices;
           // for receiving and unpacking data we need to store pointers to the
           // first vertex and vertex_index on each cell additionally
           // both vectors have as many entries as there are cells
@@ -2450,6 +2460,7 @@ namespace parallel
               if (send_to.size() > 0)
                 {
                   std::vector<unsigned int>            vertex_indices;
+                  std::vector<unsigned int>            local_vertex_indices;
                   std::vector<dealii::Point<spacedim>> local_vertices;
                   for (unsigned int v = 0;
                        v < GeometryInfo<dim>::vertices_per_cell;
@@ -2457,6 +2468,8 @@ namespace parallel
                     if (vertex_locally_moved[dealii_cell->vertex_index(v)])
                       {
                         vertex_indices.push_back(v);
+                        local_vertex_indices.push_back(
+                          dealii_cell->vertex_index(v));
                         local_vertices.push_back(dealii_cell->vertex(v));
                       }
 
@@ -2487,6 +2500,10 @@ namespace parallel
                         p->second.vertices.insert(p->second.vertices.end(),
                                                   local_vertices.begin(),
                                                   local_vertices.end());
+                        p->second.local_vertex_indices.insert(
+                          p->second.local_vertex_indices.end(),
+                          local_vertex_indices.begin(),
+                          local_vertex_indices.end());
                       }
                 }
             }
@@ -2503,6 +2520,8 @@ namespace parallel
         // Additionally, we need to give a pointer to the first vertex indices
         // and vertices. Since the first information saved in vertex_indices
         // is the number of vertices this all the information we need.
+        // The cells and vertex numbers that have been set are appended to
+        // updated_vertices.
         template <int dim, int spacedim>
         void
         set_vertices_recursively(
@@ -2514,7 +2533,10 @@ namespace parallel
           const typename dealii::internal::p4est::types<dim>::quadrant
             &                                  quadrant,
           const dealii::Point<spacedim> *const vertices,
-          const unsigned int *const            vertex_indices)
+          const unsigned int *const            vertex_indices,
+          std::vector<
+            std::pair<typename Triangulation<dim, spacedim>::cell_iterator,
+                      unsigned int>> &updated_vertices)
         {
           if (dealii::internal::p4est::quadrant_is_equal<dim>(p4est_cell,
                                                               quadrant))
@@ -2527,7 +2549,11 @@ namespace parallel
 
               // update dof indices of cell
               for (unsigned int i = 0; i < n_vertices; ++i)
-                dealii_cell->vertex(vertex_indices[i + 1]) = vertices[i];
+                {
+                  dealii_cell->vertex(vertex_indices[i + 1]) = vertices[i];
+                  updated_vertices.emplace_back(dealii_cell,
+                                                vertex_indices[i + 1]);
+                }
 
               return;
             }
@@ -2551,7 +2577,8 @@ namespace parallel
                                                     dealii_cell->child(c),
                                                     quadrant,
                                                     vertices,
-                                                    vertex_indices);
+                                                    vertex_indices,
+                                                    updated_vertices);
         }
       } // namespace
     }   // namespace CommunicateLocallyMovedVertices
@@ -2566,6 +2593,7 @@ namespace parallel
 
       cell_attached_data = {0, 0, {}, {}};
       data_transfer.clear();
+      moved_vertices_exchange = MovedVerticesExchange();
 
       if (parallel_ghost != nullptr)
         {
@@ -3438,6 +3466,9 @@ namespace parallel
     void
     Triangulation<dim, spacedim>::copy_local_forest_to_triangulation()
     {
+      // the vertices exchanged with other processes change with the mesh
+      moved_vertices_exchange = MovedVerticesExchange();
+
       // disable mesh smoothing for recreating the deal.II triangulation,
       // otherwise we might not be able to reproduce the p4est mesh
       // exactly. We restore the original smoothing at the end of this
@@ -4179,6 +4210,82 @@ namespace parallel
       }
 #  endif
 
+      // The vertices sent to and received from other processes only depend
+      // on the mesh and on the set of moved vertices. If the latter is the
+      // same as in the previous call on all processes, only the
+      // coordinates need to be exchanged, in the order set up then.
+      const bool reuse_exchange =
+        Utilities::MPI::min(
+          (moved_vertices_exchange.is_valid &&
+           moved_vertices_exchange.vertex_locally_moved ==
+             vertex_locally_moved) ?
+            1U :
+            0U,
+          this->get_communicator()) == 1U;
+      if (reuse_exchange)
+        {
+          const MovedVerticesExchange &exchange = moved_vertices_exchange;
+
+          const unsigned int n_receives = exchange.receive_from.size();
+          const unsigned int n_sends    = exchange.send_to.size();
+
+          std::vector<MPI_Request> requests(n_receives + n_sends);
+
+          std::vector<std::vector<Point<spacedim>>> receive_buffers(
+            n_receives);
+          for (unsigned int i = 0; i < n_receives; ++i)
+            {
+              receive_buffers[i].resize(exchange.receive_vertices[i].size());
+              const int ierr =
+                MPI_Irecv(receive_buffers[i].data(),
+                          receive_buffers[i].size() * sizeof(Point<spacedim>),
+                          MPI_BYTE,
+                          exchange.receive_from[i],
+                          124,
+                          this->get_communicator(),
+                          &requests[i]);
+              AssertThrowMPI(ierr);
+            }
+
+          const std::vector<Point<spacedim>> &vertices = this->get_vertices();
+
+          std::vector<std::vector<Point<spacedim>>> send_buffers(n_sends);
+          for (unsigned int i = 0; i < n_sends; ++i)
+            {
+              send_buffers[i].reserve(exchange.send_vertices[i].size());
+              for (const unsigned int v : exchange.send_vertices[i])
+                send_buffers[i].push_back(vertices[v]);
+              const int ierr =
+                MPI_Isend(send_buffers[i].data(),
+                          send_buffers[i].size() * sizeof(Point<spacedim>),
+                          MPI_BYTE,
+                          exchange.send_to[i],
+                          124,
+                          this->get_communicator(),
+                          &requests[n_receives + i]);
+              AssertThrowMPI(ierr);
+            }
+
+          if (requests.size() > 0)
+            {
+              const int ierr = MPI_Waitall(requests.size(),
+                                           requests.data(),
+                                           MPI_STATUSES_IGNORE);
+              AssertThrowMPI(ierr);
+            }
+
+          for (unsigned int i = 0; i < n_receives; ++i)
+            for (unsigned int j = 0; j < receive_buffers[i].size(); ++j)
+              exchange.receive_vertices[i][j].first->vertex(
+                exchange.receive_vertices[i][j].second) =
+                receive_buffers[i][j];
+          return;
+        }
+
+      MovedVerticesExchange exchange;
+      exchange.is_valid             = true;
+      exchange.vertex_locally_moved = vertex_locally_moved;
+
       // First find out which process should receive which vertices.
       // These are specifically the ones that are located on cells at the
       // boundary of the subdomain this process owns and the receiving
@@ -4230,6 +4337,8 @@ namespace parallel
           const unsigned int num_cells = it->second.tree_index.size();
           (void)num_cells;
           destinations.push_back(it->first);
+          exchange.send_to.push_back(it->first);
+          exchange.send_vertices.push_back(it->second.local_vertex_indices);
 
           Assert(num_cells == it->second.quadrants.size(), ExcInternalError());
           Assert(num_cells > 0, ExcInternalError());
@@ -4287,6 +4396,8 @@ namespace parallel
 
           cellinfo.unpack_data(receive);
           const unsigned int cells = cellinfo.tree_index.size();
+          exchange.receive_from.push_back(status.MPI_SOURCE);
+          exchange.receive_vertices.emplace_back();
           for (unsigned int c = 0; c < cells; ++c)
             {
               typename dealii::parallel::distributed::
@@ -4308,7 +4419,8 @@ namespace parallel
                           cell,
                           cellinfo.quadrants[c],
                           cellinfo.first_vertices[c],
-                          cellinfo.first_vertex_indices[c]);
+                          cellinfo.first_vertex_indices[c],
+                          exchange.receive_vertices.back());
             }
         }
 
@@ -4326,6 +4438,8 @@ namespace parallel
                                  this->get_communicator()) ==
                Utilities::MPI::sum(n_senders, this->get_communicator()),
              ExcInternalError());
+
+      moved_vertices_exchange = std::move(exchange);
     }
 
 
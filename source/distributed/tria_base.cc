@@ -170,6 +170,9 @@ namespace parallel
               number_cache.n_locally_owned_active_cells.end(),
               0);
 
+    // the subdomain ids of the cells may have changed
+    this->update_locally_owned_active_cells();
+
     number_cache.ghost_owners.clear();
     number_cache.level_ghost_owners.clear();
 
@@ -16,6 +16,7 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/partitioner.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
@@ -45,6 +46,7 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <numeric>
 #include <set>
@@ -2068,6 +2070,175 @@ namespace internal
 
 
 
+        /**
+         * Same as above, but for the non-hp DoFHandler class. The result is
+         * the same as that of the sequential loop over the cells in the
+         * general function above, in which each cell numbers the DoFs on
+         * all of its vertices, lines, and quads that have not been numbered
+         * by a previous cell, followed by the DoFs in its interior. Here,
+         * this enumeration is done in parallel in three steps: first, we
+         * determine for each object the first cell adjacent to it, which is
+         * the cell that numbers the DoFs on this object. This then gives the
+         * number of DoFs numbered by each cell, and a prefix sum over them
+         * the first DoF index of each cell. Finally, all cells number their
+         * DoFs independently of each other.
+         */
+        template <int dim, int spacedim>
+        static types::global_dof_index
+        distribute_dofs(const types::subdomain_id    subdomain_id,
+                        DoFHandler<dim, spacedim> &dof_handler)
+        {
+          Assert(dof_handler.get_triangulation().n_levels() > 0,
+                 ExcMessage("Empty triangulation"));
+
+          const Triangulation<dim, spacedim> &tria =
+            dof_handler.get_triangulation();
+          const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+
+          // Step 1: collect all cells on which we distribute dofs, but
+          // definitely exclude artificial cells
+          std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+            cells;
+          for (const auto &cell : dof_handler.active_cell_iterators())
+            if (!cell->is_artificial())
+              if ((subdomain_id == numbers::invalid_subdomain_id) ||
+                  (cell->subdomain_id() == subdomain_id))
+                cells.push_back(cell);
+          const unsigned int n_cells = cells.size();
+
+          // Step 2: for each vertex, line, and quad with dofs, find the
+          // first cell adjacent to it. object_owners[d] stores this cell for
+          // the objects of dimension d that are not the cell itself, using
+          // an atomic minimum since many cells share each object
+          const unsigned int dofs_per_object[4] = {fe.dofs_per_vertex,
+                                                   fe.dofs_per_line,
+                                                   fe.dofs_per_quad,
+                                                   fe.dofs_per_hex};
+          const unsigned int n_objects[3] = {tria.n_vertices(),
+                                             dim > 1 ? tria.n_raw_lines() : 0,
+                                             dim > 2 ? tria.n_raw_quads() :
+                                                       0};
+          const unsigned int objects_per_cell[3] = {
+            GeometryInfo<dim>::vertices_per_cell,
+            dim > 1 ? GeometryInfo<dim>::lines_per_cell : 0,
+            dim > 2 ? GeometryInfo<dim>::quads_per_cell : 0};
+
+          const auto object_index =
+            [](const typename DoFHandler<dim, spacedim>::active_cell_iterator
+                 &                cell,
+               const unsigned int d,
+               const unsigned int i) -> unsigned int {
+            switch (d)
+              {
+                case 0:
+                  return cell->vertex_index(i);
+                case 1:
+                  return cell->line_index(i);
+                default:
+                  return cell->quad_index(i);
+              }
+          };
+
+          std::vector<std::atomic<unsigned int>> object_owners[3];
+          for (unsigned int d = 0; d < dim; ++d)
+            if (dofs_per_object[d] > 0)
+              {
+                std::vector<std::atomic<unsigned int>> owners(n_objects[d]);
+                object_owners[d].swap(owners);
+                for (auto &owner : object_owners[d])
+                  owner.store(numbers::invalid_unsigned_int,
+                              std::memory_order_relaxed);
+
+                parallel::apply_to_subranges(
+                  0U,
+                  n_cells,
+                  [&](const unsigned int begin, const unsigned int end) {
+                    for (unsigned int c = begin; c < end; ++c)
+                      for (unsigned int i = 0; i < objects_per_cell[d]; ++i)
+                        {
+                          std::atomic<unsigned int> &owner =
+                            object_owners[d][object_index(cells[c], d, i)];
+                          unsigned int current_owner =
+                            owner.load(std::memory_order_relaxed);
+                          while (c < current_owner &&
+                                 !owner.compare_exchange_weak(
+                                   current_owner, c, std::memory_order_relaxed))
+                            ;
+                        }
+                  },
+                  256);
+              }
+
+          // Step 3: count the dofs each cell numbers and compute the first
+          // dof index of each cell
+          std::vector<types::global_dof_index> first_dof_of_cell(n_cells + 1,
+                                                                 0);
+          parallel::apply_to_subranges(
+            0U,
+            n_cells,
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int c = begin; c < end; ++c)
+                {
+                  types::global_dof_index n_dofs = dofs_per_object[dim];
+                  for (unsigned int d = 0; d < dim; ++d)
+                    if (dofs_per_object[d] > 0)
+                      for (unsigned int i = 0; i < objects_per_cell[d]; ++i)
+                        if (object_owners[d][object_index(cells[c], d, i)]
+                              .load(std::memory_order_relaxed) == c)
+                          n_dofs += dofs_per_object[d];
+                  first_dof_of_cell[c + 1] = n_dofs;
+                }
+            },
+            256);
+          for (unsigned int c = 0; c < n_cells; ++c)
+            first_dof_of_cell[c + 1] += first_dof_of_cell[c];
+
+          // Step 4: let each cell number its dofs, in the same order as
+          // distribute_dofs_on_cell()
+          parallel::apply_to_subranges(
+            0U,
+            n_cells,
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int c = begin; c < end; ++c)
+                {
+                  const auto &            cell          = cells[c];
+                  types::global_dof_index next_free_dof = first_dof_of_cell[c];
+                  for (unsigned int d = 0; d < dim; ++d)
+                    if (dofs_per_object[d] > 0)
+                      for (unsigned int i = 0; i < objects_per_cell[d]; ++i)
+                        if (object_owners[d][object_index(cell, d, i)].load(
+                              std::memory_order_relaxed) == c)
+                          for (unsigned int k = 0; k < dofs_per_object[d]; ++k)
+                            switch (d)
+                              {
+                                case 0:
+                                  cell->set_vertex_dof_index(i,
+                                                             k,
+                                                             next_free_dof++);
+                                  break;
+                                case 1:
+                                  cell->line(i)->set_dof_index(k,
+                                                               next_free_dof++);
+                                  break;
+                                default:
+                                  cell->quad(i)->set_dof_index(k,
+                                                               next_free_dof++);
+                              }
+                  for (unsigned int k = 0; k < dofs_per_object[dim]; ++k)
+                    cell->set_dof_index(k, next_free_dof++);
+                  Assert(next_free_dof == first_dof_of_cell[c + 1],
+                         ExcInternalError());
+                }
+            },
+            256);
+
+          update_all_active_cell_dof_indices_caches(dof_handler);
+
+          return first_dof_of_cell.back();
+        }
+
+
+
         /**
          * During DoF distribution, DoFs on ghost interfaces get different
          * indices assigned by each adjacent subdomain. We need to clarify
@@ -4828,9 +4999,6 @@ namespace internal
           (void)vertices_with_ghost_neighbors;
           Assert(false, ExcNotImplemented());
 #  else
-          const unsigned int dim = DoFHandlerType::dimension;
-          const unsigned int spacedim = DoFHandlerType::space_dimension;
-
           // define functions that pack data on cells that are ghost cells
           // somewhere else, and unpack data on cells where we get information
           // from elsewhere
@@ -4957,33 +5125,16 @@ namespace internal
           update_all_active_cell_dof_indices_caches(dof_handler);
 
 
-          // have a barrier so that sends between two calls to this
-          // function are not mixed up.
-          //
-          // this is necessary because above we just see if there are
-          // messages and then receive them, without discriminating
-          // where they come from and whether they were sent in phase
-          // 1 or 2 (the function is called twice in a row). the need
-          // for a global communication step like this barrier could
-          // be avoided by receiving messages specifically from those
-          // processors from which we expect messages, and by using
-          // different tags for phase 1 and 2, but the cost of a
-          // barrier is negligible compared to everything else we do
-          // here
-          if (const auto *triangulation = dynamic_cast<
-                const parallel::distributed::Triangulation<dim, spacedim> *>(
-                &dof_handler.get_triangulation()))
-            {
-              const int ierr = MPI_Barrier(triangulation->get_communicator());
-              AssertThrowMPI(ierr);
-            }
-          else
-            {
-              Assert(false,
-                     ExcMessage(
-                       "The function communicate_dof_indices_on_marked_cells() "
-                       "only works with parallel distributed triangulations."));
-            }
+          // no barrier is necessary to keep the messages of two calls to
+          // this function apart, since exchange_cell_data_to_ghosts() only
+          // receives one message from each of the processes it sends to
+          Assert((dynamic_cast<const parallel::distributed::Triangulation<
+                    DoFHandlerType::dimension,
+                    DoFHandlerType::space_dimension> *>(
+                    &dof_handler.get_triangulation()) != nullptr),
+                 ExcMessage(
+                   "The function communicate_dof_indices_on_marked_cells() "
+                   "only works with parallel distributed triangulations."));
 #  endif
         }
 
@@ -40,6 +40,8 @@
 #include <deal.II/lac/sparsity_pattern.h>
 #include <deal.II/lac/sparsity_tools.h>
 
+#include <deal.II/matrix_free/matrix_free.h>
+
 #include <deal.II/multigrid/mg_tools.h>
 
 #include <boost/config.hpp>
@@ -56,6 +58,7 @@
 #include <cmath>
 #include <functional>
 #include <map>
+#include <numeric>
 #include <vector>
 
 
@@ -1562,6 +1565,60 @@ namespace DoFRenumbering
 
 
 
+  template <typename DoFHandlerType>
+  void
+  hilbert(DoFHandlerType &dof_handler)
+  {
+    std::vector<types::global_dof_index> renumbering(
+      dof_handler.n_locally_owned_dofs());
+    compute_hilbert(renumbering, dof_handler);
+
+    dof_handler.renumber_dofs(renumbering);
+  }
+
+
+
+  template <typename DoFHandlerType>
+  void
+  compute_hilbert(std::vector<types::global_dof_index> &new_dof_indices,
+                  const DoFHandlerType &                dof_handler)
+  {
+    // collect the locally owned active cells and their position along the
+    // Hilbert curve, computed in the bounding box of their centers
+    std::vector<typename DoFHandlerType::active_cell_iterator> cells;
+    std::vector<Point<DoFHandlerType::space_dimension>>        centers;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          cells.push_back(cell);
+          centers.push_back(cell->center());
+        }
+
+    const auto hilbert_indices =
+      Utilities::inverse_Hilbert_space_filling_curve(centers);
+
+    std::vector<unsigned int> permutation(cells.size());
+    std::iota(permutation.begin(), permutation.end(), 0U);
+    std::sort(permutation.begin(),
+              permutation.end(),
+              [&hilbert_indices](const unsigned int a, const unsigned int b) {
+                return std::lexicographical_compare(hilbert_indices[a].begin(),
+                                                    hilbert_indices[a].end(),
+                                                    hilbert_indices[b].begin(),
+                                                    hilbert_indices[b].end());
+              });
+
+    std::vector<typename DoFHandlerType::active_cell_iterator> sorted_cells;
+    sorted_cells.reserve(cells.size());
+    for (const unsigned int i : permutation)
+      sorted_cells.push_back(cells[i]);
+
+    std::vector<types::global_dof_index> reverse(new_dof_indices.size());
+    compute_cell_wise(new_dof_indices, reverse, dof_handler, sorted_cells);
+  }
+
+
+
   template <typename DoFHandlerType>
   void
   cell_wise(
@@ -1728,6 +1785,118 @@ namespace DoFRenumbering
 
 
 
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  matrix_free_data_locality(
+    DoFHandler<dim> &                                    dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free)
+  {
+    std::vector<types::global_dof_index> renumbering(
+      dof_handler.n_locally_owned_dofs());
+    compute_matrix_free_data_locality(renumbering, dof_handler, matrix_free);
+
+    dof_handler.renumber_dofs(renumbering);
+  }
+
+
+
+  template <int dim, typename Number, typename VectorizedArrayType>
+  void
+  compute_matrix_free_data_locality(
+    std::vector<types::global_dof_index> &               new_indices,
+    const DoFHandler<dim> &                              dof_handler,
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free)
+  {
+    const IndexSet &owned_dofs = dof_handler.locally_owned_dofs();
+    const types::global_dof_index n_owned_dofs = owned_dofs.n_elements();
+    AssertDimension(new_indices.size(), n_owned_dofs);
+
+    // find out which of the DoFHandler objects of the MatrixFree object we
+    // are to renumber
+    unsigned int dof_handler_index = numbers::invalid_unsigned_int;
+    for (unsigned int i = 0; i < matrix_free.n_components(); ++i)
+      if (&matrix_free.get_dof_handler(i) == &dof_handler)
+        {
+          dof_handler_index = i;
+          break;
+        }
+    AssertThrow(dof_handler_index != numbers::invalid_unsigned_int,
+                ExcMessage("The given DoFHandler is not one of the DoFHandler "
+                           "objects the MatrixFree object was initialized "
+                           "with."));
+
+    // mark the locally owned degrees of freedom that other processes import
+    // as ghosts. the vector partitioner of MatrixFree enumerates the locally
+    // owned degrees of freedom in the same order as the index set
+    std::vector<bool> is_exported(n_owned_dofs, false);
+    const auto &      partitioner =
+      matrix_free.get_dof_info(dof_handler_index).vector_partitioner;
+    if (partitioner.get() != nullptr)
+      {
+        AssertDimension(partitioner->local_size(), n_owned_dofs);
+        for (const auto &range : partitioner->import_indices())
+          for (unsigned int i = range.first; i < range.second; ++i)
+            is_exported[i] = true;
+      }
+
+    // go through the cells in the order of the cell batches and of the
+    // lanes within each batch, and record the order in which the degrees of
+    // freedom are accessed first. as in compute_cell_wise(), the degrees of
+    // freedom first accessed on the same cell keep their relative order
+    std::vector<bool>                    already_sorted(n_owned_dofs, false);
+    std::vector<types::global_dof_index> reverse;
+    std::vector<types::global_dof_index> exported_dofs;
+    reverse.reserve(n_owned_dofs);
+    std::vector<types::global_dof_index> cell_dofs;
+
+    for (unsigned int batch = 0; batch < matrix_free.n_macro_cells(); ++batch)
+      for (unsigned int v = 0; v < matrix_free.n_components_filled(batch); ++v)
+        {
+          const typename DoFHandler<dim>::cell_iterator cell =
+            matrix_free.get_cell_iterator(batch, v, dof_handler_index);
+          Assert(cell->active(),
+                 ExcMessage("This function can only renumber the degrees of "
+                            "freedom on the active cells."));
+
+          cell_dofs.resize(cell->get_fe().dofs_per_cell);
+          cell->get_active_or_mg_dof_indices(cell_dofs);
+          std::sort(cell_dofs.begin(), cell_dofs.end());
+
+          for (const auto dof : cell_dofs)
+            {
+              const auto local_dof = owned_dofs.index_within_set(dof);
+              if (local_dof != numbers::invalid_dof_index &&
+                  !already_sorted[local_dof])
+                {
+                  already_sorted[local_dof] = true;
+                  if (is_exported[local_dof])
+                    exported_dofs.push_back(local_dof);
+                  else
+                    reverse.push_back(local_dof);
+                }
+            }
+        }
+
+    // degrees of freedom that are not accessed by any cell of the MatrixFree
+    // object (which can only happen if it does not include all locally owned
+    // cells) keep their relative order and go before the exported ones
+    for (types::global_dof_index i = 0; i < n_owned_dofs; ++i)
+      if (!already_sorted[i])
+        {
+          if (is_exported[i])
+            exported_dofs.push_back(i);
+          else
+            reverse.push_back(i);
+        }
+    reverse.insert(reverse.end(), exported_dofs.begin(), exported_dofs.end());
+    AssertDimension(reverse.size(), n_owned_dofs);
+
+    for (types::global_dof_index i = 0; i < n_owned_dofs; ++i)
+      new_indices[reverse[i]] = owned_dofs.nth_index_in_set(i);
+  }
+
+
+
   template <typename DoFHandlerType>
   void
   downstream(DoFHandlerType &                                  dof,
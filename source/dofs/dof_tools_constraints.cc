@@ -1766,6 +1766,113 @@ namespace DoFTools
               }
         }
     }
+
+
+
+    template <int dim, int spacedim, typename number>
+    void
+    make_hp_hanging_node_constraints(
+      const dealii::DoFHandler<dim, spacedim> &dof_handler,
+      AffineConstraints<number> &              constraints)
+    {
+      // for DoFHandlers without hp support, all cells use the same element
+      // and only the first case of the general function above can occur: the
+      // DoFs on the children of a refined face are constrained against the
+      // DoFs on the face itself. collecting these DoF indices is the bulk of
+      // the work, so do it in parallel on the cells, and let a copier that
+      // is called in the order of the cells enter the constraints. this
+      // results in exactly the same constraints as a serial loop
+      const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+      if (fe.dofs_per_face == 0 ||
+          fe.compare_for_domination(fe, /*codim=*/1) ==
+            FiniteElementDomination::no_requirements)
+        return;
+
+      struct ScratchData
+      {};
+
+      // the DoFs on the refined faces of a cell and on their children, along
+      // with the number of the child. we keep the vectors around between
+      // cells and only use the first n_subfaces entries
+      struct CopyData
+      {
+        unsigned int                                      n_subfaces = 0;
+        std::vector<unsigned int>                         subface_no;
+        std::vector<std::vector<types::global_dof_index>> master_dofs;
+        std::vector<std::vector<types::global_dof_index>> slave_dofs;
+      };
+
+      const auto worker =
+        [&fe](const typename dealii::DoFHandler<dim, spacedim>::
+                active_cell_iterator &cell,
+              ScratchData &,
+              CopyData &copy_data) {
+          copy_data.n_subfaces = 0;
+
+          // artificial cells can at best neighbor ghost cells, but we're not
+          // interested in these interfaces
+          if (cell->is_artificial())
+            return;
+
+          for (unsigned int face = 0; face < GeometryInfo<dim>::faces_per_cell;
+               ++face)
+            if (cell->face(face)->has_children())
+              {
+                Assert(cell->face(face)->refinement_case() ==
+                         RefinementCase<dim - 1>::isotropic_refinement,
+                       ExcNotImplemented());
+
+                for (unsigned int c = 0; c < cell->face(face)->n_children();
+                     ++c)
+                  {
+                    if (cell->neighbor_child_on_subface(face, c)
+                          ->is_artificial())
+                      continue;
+
+                    const unsigned int n = copy_data.n_subfaces++;
+                    if (n == copy_data.subface_no.size())
+                      {
+                        copy_data.subface_no.emplace_back();
+                        copy_data.master_dofs.emplace_back(fe.dofs_per_face);
+                        copy_data.slave_dofs.emplace_back(fe.dofs_per_face);
+                      }
+
+                    copy_data.subface_no[n] = c;
+                    cell->face(face)->get_dof_indices(
+                      copy_data.master_dofs[n]);
+                    cell->face(face)->child(c)->get_dof_indices(
+                      copy_data.slave_dofs[n]);
+                  }
+              }
+        };
+
+      // the subface interpolation matrices are computed the first time they
+      // are needed. this happens in the copier, which is never run
+      // concurrently
+      std::vector<std::unique_ptr<FullMatrix<double>>>
+        subface_interpolation_matrices(
+          GeometryInfo<dim>::max_children_per_face);
+
+      const auto copier = [&](const CopyData &copy_data) {
+        for (unsigned int n = 0; n < copy_data.n_subfaces; ++n)
+          {
+            const unsigned int c = copy_data.subface_no[n];
+            ensure_existence_of_subface_matrix(
+              fe, fe, c, subface_interpolation_matrices[c]);
+            filter_constraints(copy_data.master_dofs[n],
+                               copy_data.slave_dofs[n],
+                               *subface_interpolation_matrices[c],
+                               constraints);
+          }
+      };
+
+      WorkStream::run(dof_handler.begin_active(),
+                      dof_handler.end(),
+                      worker,
+                      copier,
+                      ScratchData(),
+                      CopyData());
+    }
   } // namespace internal
 
 
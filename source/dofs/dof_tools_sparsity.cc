@@ -13,11 +13,13 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/multithread_info.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria_base.h>
@@ -57,6 +59,124 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace DoFTools
 {
+  namespace internal
+  {
+    namespace
+    {
+      // add the couplings between the degrees of freedom on each of the
+      // cells to be considered by make_sparsity_pattern(), one cell after
+      // the other
+      template <typename DoFHandlerType,
+                typename SparsityPatternType,
+                typename number>
+      void
+      add_cell_couplings_sequentially(
+        const DoFHandlerType &           dof,
+        SparsityPatternType &            sparsity,
+        const AffineConstraints<number> &constraints,
+        const bool                       keep_constrained_dofs,
+        const types::subdomain_id        subdomain_id)
+      {
+        std::vector<types::global_dof_index> dofs_on_this_cell;
+        dofs_on_this_cell.reserve(max_dofs_per_cell(dof));
+        typename DoFHandlerType::active_cell_iterator cell =
+                                                        dof.begin_active(),
+                                                      endc = dof.end();
+
+        // In case we work with a distributed sparsity pattern of Trilinos
+        // type, we only have to do the work if the current cell is owned by
+        // the calling processor. Otherwise, just continue.
+        for (; cell != endc; ++cell)
+          if (((subdomain_id == numbers::invalid_subdomain_id) ||
+               (subdomain_id == cell->subdomain_id())) &&
+              cell->is_locally_owned())
+            {
+              const unsigned int dofs_per_cell = cell->get_fe().dofs_per_cell;
+              dofs_on_this_cell.resize(dofs_per_cell);
+              cell->get_dof_indices(dofs_on_this_cell);
+
+              // make sparsity pattern for this cell. if no constraints
+              // pattern was given, then the following call acts as if simply
+              // no constraints existed
+              constraints.add_entries_local_to_global(dofs_on_this_cell,
+                                                      sparsity,
+                                                      keep_constrained_dofs);
+            }
+      }
+
+
+
+      template <typename DoFHandlerType,
+                typename SparsityPatternType,
+                typename number>
+      void
+      add_cell_couplings(const DoFHandlerType &           dof,
+                         SparsityPatternType &            sparsity,
+                         const AffineConstraints<number> &constraints,
+                         const bool                       keep_constrained_dofs,
+                         const types::subdomain_id        subdomain_id)
+      {
+        add_cell_couplings_sequentially(
+          dof, sparsity, constraints, keep_constrained_dofs, subdomain_id);
+      }
+
+
+
+      // DynamicSparsityPattern accepts concurrent insertions, so we can work
+      // on the cells in parallel. since the rows touched by different cells
+      // overlap, the insertion is done by the worker and there is nothing
+      // left to do for the copier
+      template <typename DoFHandlerType, typename number>
+      void
+      add_cell_couplings(const DoFHandlerType &           dof,
+                         DynamicSparsityPattern &         sparsity,
+                         const AffineConstraints<number> &constraints,
+                         const bool                       keep_constrained_dofs,
+                         const types::subdomain_id        subdomain_id)
+      {
+        // protecting the rows is not free, so don't do it if there is only
+        // one thread anyway
+        if (MultithreadInfo::n_threads() == 1)
+          {
+            add_cell_couplings_sequentially(
+              dof, sparsity, constraints, keep_constrained_dofs, subdomain_id);
+            return;
+          }
+
+        using CellIterator = typename DoFHandlerType::active_cell_iterator;
+        using ScratchData  = std::vector<types::global_dof_index>;
+
+        ScratchData sample_scratch_data;
+        sample_scratch_data.reserve(max_dofs_per_cell(dof));
+
+        sparsity.set_thread_safe_insertion(true);
+        WorkStream::run(
+          CellIterator(dof.begin_active()),
+          CellIterator(dof.end()),
+          [&](const CellIterator &cell,
+              ScratchData &       dofs_on_this_cell,
+              int &) {
+            if (((subdomain_id == numbers::invalid_subdomain_id) ||
+                 (subdomain_id == cell->subdomain_id())) &&
+                cell->is_locally_owned())
+              {
+                dofs_on_this_cell.resize(cell->get_fe().dofs_per_cell);
+                cell->get_dof_indices(dofs_on_this_cell);
+                constraints.add_entries_local_to_global(dofs_on_this_cell,
+                                                        sparsity,
+                                                        keep_constrained_dofs);
+              }
+          },
+          std::function<void(const int &)>(),
+          sample_scratch_data,
+          0);
+        sparsity.set_thread_safe_insertion(false);
+      }
+    } // namespace
+  }   // namespace internal
+
+
+
   template <typename DoFHandlerType,
             typename SparsityPatternType,
             typename number>
@@ -88,30 +208,8 @@ namespace DoFTools
              "associated DoF handler objects, asking for any subdomain other "
              "than the locally owned one does not make sense."));
 
-    std::vector<types::global_dof_index> dofs_on_this_cell;
-    dofs_on_this_cell.reserve(max_dofs_per_cell(dof));
-    typename DoFHandlerType::active_cell_iterator cell = dof.begin_active(),
-                                                  endc = dof.end();
-
-    // In case we work with a distributed sparsity pattern of Trilinos
-    // type, we only have to do the work if the current cell is owned by
-    // the calling processor. Otherwise, just continue.
-    for (; cell != endc; ++cell)
-      if (((subdomain_id == numbers::invalid_subdomain_id) ||
-           (subdomain_id == cell->subdomain_id())) &&
-          cell->is_locally_owned())
-        {
-          const unsigned int dofs_per_cell = cell->get_fe().dofs_per_cell;
-          dofs_on_this_cell.resize(dofs_per_cell);
-          cell->get_dof_indices(dofs_on_this_cell);
-
-          // make sparsity pattern for this cell. if no constraints pattern
-          // was given, then the following call acts as if simply no
-          // constraints existed
-          constraints.add_entries_local_to_global(dofs_on_this_cell,
-                                                  sparsity,
-                                                  keep_constrained_dofs);
-        }
+    internal::add_cell_couplings(
+      dof, sparsity, constraints, keep_constrained_dofs, subdomain_id);
   }
 
 
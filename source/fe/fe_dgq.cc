@@ -433,14 +433,36 @@ FE_DGQ<dim, spacedim>::get_prolongation_matrix(
           isotropic_matrices.back().resize(
             GeometryInfo<dim>::n_children(RefinementCase<dim>(refinement_case)),
             FullMatrix<double>(this->dofs_per_cell, this->dofs_per_cell));
-          if (dim == spacedim)
-            FETools::compute_embedding_matrices(*this,
-                                                isotropic_matrices,
-                                                true);
-          else
-            FETools::compute_embedding_matrices(FE_DGQ<dim>(this->degree),
-                                                isotropic_matrices,
-                                                true);
+
+          // another element of the same kind might already have computed
+          // the matrices, see FETools::enable_matrix_cache()
+          const std::string cache_key =
+            this->get_name() + " prolongation " +
+            Utilities::to_string(static_cast<unsigned int>(refinement_case)) +
+            " ";
+          bool found_in_cache = true;
+          for (unsigned int c = 0; c < isotropic_matrices.back().size(); ++c)
+            if (!FETools::load_cached_matrix(cache_key +
+                                               Utilities::to_string(c),
+                                             isotropic_matrices.back()[c]))
+              found_in_cache = false;
+
+          if (found_in_cache == false)
+            {
+              if (dim == spacedim)
+                FETools::compute_embedding_matrices(*this,
+                                                    isotropic_matrices,
+                                                    true);
+              else
+                FETools::compute_embedding_matrices(FE_DGQ<dim>(this->degree),
+                                                    isotropic_matrices,
+                                                    true);
+              for (unsigned int c = 0; c < isotropic_matrices.back().size();
+                   ++c)
+                FETools::store_cached_matrix(cache_key +
+                                               Utilities::to_string(c),
+                                             isotropic_matrices.back()[c]);
+            }
           this_nonconst.prolongation[refinement_case - 1].swap(
             isotropic_matrices.back());
         }
@@ -513,14 +535,33 @@ FE_DGQ<dim, spacedim>::get_restriction_matrix(
           isotropic_matrices.back().resize(
             GeometryInfo<dim>::n_children(RefinementCase<dim>(refinement_case)),
             FullMatrix<double>(this->dofs_per_cell, this->dofs_per_cell));
-          if (dim == spacedim)
-            FETools::compute_projection_matrices(*this,
-                                                 isotropic_matrices,
-                                                 true);
-          else
-            FETools::compute_projection_matrices(FE_DGQ<dim>(this->degree),
-                                                 isotropic_matrices,
-                                                 true);
+
+          const std::string cache_key =
+            this->get_name() + " restriction " +
+            Utilities::to_string(static_cast<unsigned int>(refinement_case)) +
+            " ";
+          bool found_in_cache = true;
+          for (unsigned int c = 0; c < isotropic_matrices.back().size(); ++c)
+            if (!FETools::load_cached_matrix(cache_key +
+                                               Utilities::to_string(c),
+                                             isotropic_matrices.back()[c]))
+              found_in_cache = false;
+
+          if (found_in_cache == false)
+            {
+              if (dim == spacedim)
+                FETools::compute_projection_matrices(*this,
+                                                     isotropic_matrices,
+                                                     true);
+              else
+                FETools::compute_projection_matrices(
+                  FE_DGQ<dim>(this->degree), isotropic_matrices, true);
+              for (unsigned int c = 0; c < isotropic_matrices.back().size();
+                   ++c)
+                FETools::store_cached_matrix(cache_key +
+                                               Utilities::to_string(c),
+                                             isotropic_matrices.back()[c]);
+            }
           this_nonconst.restriction[refinement_case - 1].swap(
             isotropic_matrices.back());
         }
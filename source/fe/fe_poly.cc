@@ -50,13 +50,15 @@ FE_Poly<TensorProductPolynomials<1>, 1, 2>::fill_fe_values(
   const InternalData &fe_data =
     static_cast<const InternalData &>(fe_internal); // NOLINT
 
+  const ShapeTables &shape_tables = *fe_data.shape_tables;
+
   // transform gradients and higher derivatives. there is nothing to do
   // for values since we already emplaced them into output_data when
   // we were in get_data()
   if (fe_data.update_each & update_gradients &&
       cell_similarity != CellSimilarity::translation)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-      mapping.transform(make_array_view(fe_data.shape_gradients, k),
+      mapping.transform(make_array_view(shape_tables.shape_gradients, k),
                         mapping_covariant,
                         mapping_internal,
                         make_array_view(output_data.shape_gradients, k));
@@ -65,7 +67,7 @@ FE_Poly<TensorProductPolynomials<1>, 1, 2>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_hessians, k),
+        mapping.transform(make_array_view(shape_tables.shape_hessians, k),
                           mapping_covariant_gradient,
                           mapping_internal,
                           make_array_view(output_data.shape_hessians, k));
@@ -82,11 +84,11 @@ FE_Poly<TensorProductPolynomials<1>, 1, 2>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives, k),
-                          mapping_covariant_hessian,
-                          mapping_internal,
-                          make_array_view(output_data.shape_3rd_derivatives,
-                                          k));
+        mapping.transform(
+          make_array_view(shape_tables.shape_3rd_derivatives, k),
+          mapping_covariant_hessian,
+          mapping_internal,
+          make_array_view(output_data.shape_3rd_derivatives, k));
 
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
         correct_third_derivatives(output_data,
@@ -119,13 +121,15 @@ FE_Poly<TensorProductPolynomials<2>, 2, 3>::fill_fe_values(
   const InternalData &fe_data =
     static_cast<const InternalData &>(fe_internal); // NOLINT
 
+  const ShapeTables &shape_tables = *fe_data.shape_tables;
+
   // transform gradients and higher derivatives. there is nothing to do
   // for values since we already emplaced them into output_data when
   // we were in get_data()
   if (fe_data.update_each & update_gradients &&
       cell_similarity != CellSimilarity::translation)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-      mapping.transform(make_array_view(fe_data.shape_gradients, k),
+      mapping.transform(make_array_view(shape_tables.shape_gradients, k),
                         mapping_covariant,
                         mapping_internal,
                         make_array_view(output_data.shape_gradients, k));
@@ -134,7 +138,7 @@ FE_Poly<TensorProductPolynomials<2>, 2, 3>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_hessians, k),
+        mapping.transform(make_array_view(shape_tables.shape_hessians, k),
                           mapping_covariant_gradient,
                           mapping_internal,
                           make_array_view(output_data.shape_hessians, k));
@@ -151,11 +155,11 @@ FE_Poly<TensorProductPolynomials<2>, 2, 3>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives, k),
-                          mapping_covariant_hessian,
-                          mapping_internal,
-                          make_array_view(output_data.shape_3rd_derivatives,
-                                          k));
+        mapping.transform(
+          make_array_view(shape_tables.shape_3rd_derivatives, k),
+          mapping_covariant_hessian,
+          mapping_internal,
+          make_array_view(output_data.shape_3rd_derivatives, k));
 
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
         correct_third_derivatives(output_data,
@@ -187,13 +191,15 @@ FE_Poly<PolynomialSpace<1>, 1, 2>::fill_fe_values(
   const InternalData &fe_data =
     static_cast<const InternalData &>(fe_internal); // NOLINT
 
+  const ShapeTables &shape_tables = *fe_data.shape_tables;
+
   // transform gradients and higher derivatives. there is nothing to do
   // for values since we already emplaced them into output_data when
   // we were in get_data()
   if (fe_data.update_each & update_gradients &&
       cell_similarity != CellSimilarity::translation)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-      mapping.transform(make_array_view(fe_data.shape_gradients, k),
+      mapping.transform(make_array_view(shape_tables.shape_gradients, k),
                         mapping_covariant,
                         mapping_internal,
                         make_array_view(output_data.shape_gradients, k));
@@ -202,7 +208,7 @@ FE_Poly<PolynomialSpace<1>, 1, 2>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_hessians, k),
+        mapping.transform(make_array_view(shape_tables.shape_hessians, k),
                           mapping_covariant_gradient,
                           mapping_internal,
                           make_array_view(output_data.shape_hessians, k));
@@ -219,11 +225,11 @@ FE_Poly<PolynomialSpace<1>, 1, 2>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives, k),
-                          mapping_covariant_hessian,
-                          mapping_internal,
-                          make_array_view(output_data.shape_3rd_derivatives,
-                                          k));
+        mapping.transform(
+          make_array_view(shape_tables.shape_3rd_derivatives, k),
+          mapping_covariant_hessian,
+          mapping_internal,
+          make_array_view(output_data.shape_3rd_derivatives, k));
 
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
         correct_third_derivatives(output_data,
@@ -255,13 +261,15 @@ FE_Poly<PolynomialSpace<2>, 2, 3>::fill_fe_values(
   const InternalData &fe_data =
     static_cast<const InternalData &>(fe_internal); // NOLINT
 
+  const ShapeTables &shape_tables = *fe_data.shape_tables;
+
   // transform gradients and higher derivatives. there is nothing to do
   // for values since we already emplaced them into output_data when
   // we were in get_data()
   if (fe_data.update_each & update_gradients &&
       cell_similarity != CellSimilarity::translation)
     for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-      mapping.transform(make_array_view(fe_data.shape_gradients, k),
+      mapping.transform(make_array_view(shape_tables.shape_gradients, k),
                         mapping_covariant,
                         mapping_internal,
                         make_array_view(output_data.shape_gradients, k));
@@ -270,7 +278,7 @@ FE_Poly<PolynomialSpace<2>, 2, 3>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_hessians, k),
+        mapping.transform(make_array_view(shape_tables.shape_hessians, k),
                           mapping_covariant_gradient,
                           mapping_internal,
                           make_array_view(output_data.shape_hessians, k));
@@ -287,11 +295,11 @@ FE_Poly<PolynomialSpace<2>, 2, 3>::fill_fe_values(
       cell_similarity != CellSimilarity::translation)
     {
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives, k),
-                          mapping_covariant_hessian,
-                          mapping_internal,
-                          make_array_view(output_data.shape_3rd_derivatives,
-                                          k));
+        mapping.transform(
+          make_array_view(shape_tables.shape_3rd_derivatives, k),
+          mapping_covariant_hessian,
+          mapping_internal,
+          make_array_view(output_data.shape_3rd_derivatives, k));
 
       for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
         correct_third_derivatives(output_data,
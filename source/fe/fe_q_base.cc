@@ -1194,6 +1194,20 @@ FE_Q_Base<PolynomialType, dim, spacedim>::get_prolongation_matrix(
           this->dofs_per_cell)
         return this->prolongation[refinement_case - 1][child];
 
+      // another element of the same kind might already have computed the
+      // matrix, see FETools::enable_matrix_cache()
+      const std::string cache_key =
+        this->get_name() + " prolongation " +
+        Utilities::to_string(static_cast<unsigned int>(refinement_case)) +
+        " " + Utilities::to_string(child);
+      FullMatrix<double> cached_matrix;
+      if (FETools::load_cached_matrix(cache_key, cached_matrix))
+        {
+          cached_matrix.swap(const_cast<FullMatrix<double> &>(
+            this->prolongation[refinement_case - 1][child]));
+          return this->prolongation[refinement_case - 1][child];
+        }
+
       // distinguish q/q_dg0 case: only treat Q dofs first
       const unsigned int q_dofs_per_cell =
         Utilities::fixed_power<dim>(q_degree + 1);
@@ -1357,6 +1371,8 @@ FE_Q_Base<PolynomialType, dim, spacedim>::get_prolongation_matrix(
         }
 #endif
 
+      FETools::store_cached_matrix(cache_key, prolongate);
+
       // swap matrices
       prolongate.swap(const_cast<FullMatrix<double> &>(
         this->prolongation[refinement_case - 1][child]));
@@ -1396,6 +1412,18 @@ FE_Q_Base<PolynomialType, dim, spacedim>::get_restriction_matrix(
           this->dofs_per_cell)
         return this->restriction[refinement_case - 1][child];
 
+      const std::string cache_key =
+        this->get_name() + " restriction " +
+        Utilities::to_string(static_cast<unsigned int>(refinement_case)) +
+        " " + Utilities::to_string(child);
+      FullMatrix<double> cached_matrix;
+      if (FETools::load_cached_matrix(cache_key, cached_matrix))
+        {
+          cached_matrix.swap(const_cast<FullMatrix<double> &>(
+            this->restriction[refinement_case - 1][child]));
+          return this->restriction[refinement_case - 1][child];
+        }
+
       FullMatrix<double> my_restriction(this->dofs_per_cell,
                                         this->dofs_per_cell);
       // distinguish q/q_dg0 case
@@ -1499,6 +1527,8 @@ FE_Q_Base<PolynomialType, dim, spacedim>::get_restriction_matrix(
                      RefinementCase<dim>(refinement_case));
         }
 
+      FETools::store_cached_matrix(cache_key, my_restriction);
+
       // swap the just computed restriction matrix into the
       // element of the vector stored in the base class
       my_restriction.swap(const_cast<FullMatrix<double> &>(
@@ -17,6 +17,10 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/tensor_product_polynomials.h>
+
+#include <deal.II/fe/fe_poly.h>
 #include <deal.II/fe/fe_series.h>
 
 #include <iostream>
@@ -181,6 +185,107 @@ namespace
                             j);
       }
   }
+
+
+  /**
+   * Ensure that the one-dimensional transformation matrix for FiniteElement
+   * index @p fe is calculated if possible, i.e., if the element is a tensor
+   * product of one-dimensional polynomials and the quadrature formula is a
+   * tensor product of identical one-dimensional formulas. Return whether the
+   * coefficients for this element can be computed by sum factorization.
+   */
+  template <int dim, int spacedim>
+  bool
+  ensure_existence_1d(
+    const hp::FECollection<dim, spacedim> &  fe_collection,
+    const hp::QCollection<dim> &             q_collection,
+    const unsigned int                       N,
+    const unsigned int                       fe,
+    std::vector<FullMatrix<double>> &        legendre_transform_matrices_1d,
+    std::vector<double> &                    legendre_transform_scaling_1d,
+    std::vector<std::vector<unsigned int>> &lexicographic_numberings)
+  {
+    AssertIndexRange(fe, fe_collection.size());
+
+    if (legendre_transform_matrices_1d[fe].m() != 0)
+      return true;
+
+    const auto *fe_poly =
+      dynamic_cast<const FE_Poly<TensorProductPolynomials<dim>, dim, spacedim>
+                     *>(&fe_collection[fe]);
+    const Quadrature<dim> &quadrature = q_collection[fe];
+    if (fe_poly == nullptr || !quadrature.is_tensor_product())
+      return false;
+
+    const auto quadratures_1d = quadrature.get_tensor_basis();
+    for (unsigned int d = 1; d < dim; ++d)
+      if (!(quadratures_1d[d] == quadratures_1d[0]))
+        return false;
+    const Quadrature<1> &quadrature_1d = quadratures_1d[0];
+
+    const unsigned int n_1d = fe_poly->degree + 1;
+    if (Utilities::fixed_power<dim>(n_1d) != fe_poly->dofs_per_cell)
+      return false;
+
+    const std::vector<unsigned int> lexicographic_to_dof =
+      fe_poly->get_poly_space_numbering_inverse();
+
+    // The shape functions are products p_{j_0}(x_0)...p_{j_{dim-1}}(x_{dim-1})
+    // of one-dimensional polynomials. Evaluating the ones with
+    // j_1=...=j_{dim-1}=0 on the line x_1=...=x_{dim-1}=c yields the
+    // one-dimensional polynomials up to the factor p_0(c)^{dim-1}. We
+    // compensate for it by scaling the coefficients with the inverse of
+    // p_0(c)^{dim(dim-1)}, and choose c such that p_0(c) is large in
+    // magnitude.
+    const auto point_on_diagonal = [](const double c) {
+      Point<dim> p;
+      for (unsigned int d = 0; d < dim; ++d)
+        p[d] = c;
+      return p;
+    };
+
+    std::vector<double> candidates = {0., 0.5, 1.};
+    for (unsigned int q = 0; q < quadrature_1d.size(); ++q)
+      candidates.push_back(quadrature_1d.point(q)[0]);
+
+    double c = 0., p0_c_dim = 0.;
+    for (const double candidate : candidates)
+      {
+        const double value =
+          fe_poly->shape_value(lexicographic_to_dof[0],
+                               point_on_diagonal(candidate));
+        if (std::abs(value) > std::abs(p0_c_dim))
+          {
+            c        = candidate;
+            p0_c_dim = value;
+          }
+      }
+    if (p0_c_dim == 0.)
+      return false;
+
+    FullMatrix<double> &matrix = legendre_transform_matrices_1d[fe];
+    matrix.reinit(N, n_1d);
+    for (unsigned int k = 0; k < N; ++k)
+      for (unsigned int j = 0; j < n_1d; ++j)
+        {
+          double sum = 0;
+          for (unsigned int q = 0; q < quadrature_1d.size(); ++q)
+            {
+              const Point<1> &x_q = quadrature_1d.point(q);
+              Point<dim>      p   = point_on_diagonal(c);
+              p[0]                = x_q[0];
+              sum += Lh(x_q, TableIndices<1>(k)) *
+                     fe_poly->shape_value(lexicographic_to_dof[j], p) *
+                     quadrature_1d.weight(q);
+            }
+          matrix(k, j) = sum * multiplier(TableIndices<1>(k));
+        }
+
+    legendre_transform_scaling_1d[fe] = 1. / std::pow(p0_c_dim, dim - 1);
+    lexicographic_numberings[fe]      = fe_poly->get_poly_space_numbering();
+
+    return true;
+  }
 } // namespace
 
 
@@ -196,6 +301,9 @@ namespace FESeries
     , fe_collection(&fe_collection)
     , q_collection(&q_collection)
     , legendre_transform_matrices(fe_collection.size())
+    , legendre_transform_matrices_1d(fe_collection.size())
+    , legendre_transform_scaling_1d(fe_collection.size(), 1.)
+    , lexicographic_numberings(fe_collection.size())
     , unrolled_coefficients(Utilities::fixed_power<dim>(N), 0.)
   {}
 
@@ -209,6 +317,70 @@ namespace FESeries
     const unsigned int            cell_active_fe_index,
     Table<dim, CoefficientType> & legendre_coefficients)
   {
+    if (ensure_existence_1d(*fe_collection,
+                            *q_collection,
+                            N,
+                            cell_active_fe_index,
+                            legendre_transform_matrices_1d,
+                            legendre_transform_scaling_1d,
+                            lexicographic_numberings))
+      {
+        const FullMatrix<CoefficientType> &matrix =
+          legendre_transform_matrices_1d[cell_active_fe_index];
+        const std::vector<unsigned int> &numbering =
+          lexicographic_numberings[cell_active_fe_index];
+        const unsigned int n_1d = matrix.n();
+
+        Assert(local_dof_values.size() == numbering.size(),
+               ExcDimensionMismatch(local_dof_values.size(),
+                                    numbering.size()));
+
+        std::vector<CoefficientType> &src = sum_factorization_values[0];
+        std::vector<CoefficientType> &dst = sum_factorization_values[1];
+
+        src.resize(numbering.size());
+        for (unsigned int i = 0; i < numbering.size(); ++i)
+          src[numbering[i]] = local_dof_values[i];
+
+        // Apply the one-dimensional transformation along one direction after
+        // the other. The data is stored in lexicographic order, i.e., with
+        // the index in x-direction running fastest. Directions below d have
+        // already been transformed to N entries, the ones above d still hold
+        // n_1d entries.
+        for (unsigned int d = 0, stride = 1; d < dim; ++d, stride *= N)
+          {
+            const unsigned int n_outer = Utilities::pow(n_1d, dim - 1 - d);
+
+            dst.resize(stride * N * n_outer);
+            for (unsigned int o = 0; o < n_outer; ++o)
+              for (unsigned int k = 0; k < N; ++k)
+                for (unsigned int i = 0; i < stride; ++i)
+                  {
+                    CoefficientType sum = 0.;
+                    for (unsigned int j = 0; j < n_1d; ++j)
+                      sum += matrix(k, j) * src[(o * n_1d + j) * stride + i];
+                    dst[(o * N + k) * stride + i] = sum;
+                  }
+
+            src.swap(dst);
+          }
+
+        // The unrolled coefficients are stored with the last index running
+        // fastest.
+        const CoefficientType scaling =
+          legendre_transform_scaling_1d[cell_active_fe_index];
+        for (unsigned int l = 0; l < src.size(); ++l)
+          {
+            unsigned int unrolled_index = 0;
+            for (unsigned int d = 0, rest = l; d < dim; ++d, rest /= N)
+              unrolled_index += (rest % N) * Utilities::pow(N, dim - 1 - d);
+            unrolled_coefficients[unrolled_index] = scaling * src[l];
+          }
+
+        legendre_coefficients.fill(unrolled_coefficients.begin());
+        return;
+      }
+
     ensure_existence(*fe_collection,
                      *q_collection,
                      N,
@@ -14,10 +14,188 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
+
 #include <deal.II/fe/fe_tools.templates.h>
 
+#include <deal.II/lac/full_matrix.h>
+
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+
 DEAL_II_NAMESPACE_OPEN
 
+namespace FETools
+{
+  namespace
+  {
+    /**
+     * The state of the cache of matrices of finite elements, see
+     * enable_matrix_cache().
+     */
+    struct MatrixCache
+    {
+      MatrixCache()
+        : enabled(false)
+      {}
+
+      bool                                      enabled;
+      std::string                               directory;
+      std::map<std::string, FullMatrix<double>> matrices;
+      std::mutex                                mutex;
+    };
+
+
+
+    MatrixCache &
+    get_matrix_cache()
+    {
+      static MatrixCache cache;
+      return cache;
+    }
+
+
+
+    /**
+     * Return the name of the file in @p directory for the matrix with the
+     * given @p key. Characters of the key that could cause trouble in file
+     * names are replaced, and a hash of the key is appended to keep the
+     * names of different keys distinct.
+     */
+    std::string
+    get_matrix_cache_file_name(const std::string &directory,
+                               const std::string &key)
+    {
+      std::string name = key;
+      for (char &c : name)
+        if (!std::isalnum(static_cast<unsigned char>(c)))
+          c = '_';
+      return directory + "/" + name + "_" +
+             Utilities::to_string(std::hash<std::string>()(key)) + ".matrix";
+    }
+
+
+
+    /**
+     * Return whether the matrix with the given @p key may be cached. This is
+     * not the case for elements whose name does not identify their support
+     * points.
+     */
+    bool
+    is_cacheable(const std::string &key)
+    {
+      return key.find("QUnknownNodes") == std::string::npos;
+    }
+  } // namespace
+
+
+
+  void
+  enable_matrix_cache(const std::string &directory)
+  {
+    MatrixCache &               cache = get_matrix_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.enabled   = true;
+    cache.directory = directory;
+  }
+
+
+
+  void
+  disable_matrix_cache()
+  {
+    MatrixCache &               cache = get_matrix_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.enabled = false;
+    cache.directory.clear();
+    cache.matrices.clear();
+  }
+
+
+
+  bool
+  load_cached_matrix(const std::string &key, FullMatrix<double> &matrix)
+  {
+    MatrixCache &               cache = get_matrix_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.enabled == false || is_cacheable(key) == false)
+      return false;
+
+    const auto entry = cache.matrices.find(key);
+    if (entry != cache.matrices.end())
+      {
+        matrix = entry->second;
+        return true;
+      }
+
+    if (cache.directory.empty())
+      return false;
+
+    std::ifstream file(get_matrix_cache_file_name(cache.directory, key),
+                       std::ios::binary);
+    unsigned int  size[2] = {0, 0};
+    if (!file.read(reinterpret_cast<char *>(size), sizeof(size)) ||
+        size[0] == 0 || size[1] == 0)
+      return false;
+
+    FullMatrix<double> stored(size[0], size[1]);
+    if (!file.read(reinterpret_cast<char *>(&stored(0, 0)),
+                   sizeof(double) * size[0] * size[1]))
+      return false;
+
+    matrix              = stored;
+    cache.matrices[key] = std::move(stored);
+    return true;
+  }
+
+
+
+  void
+  store_cached_matrix(const std::string &key, const FullMatrix<double> &matrix)
+  {
+    MatrixCache &               cache = get_matrix_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.enabled == false || is_cacheable(key) == false ||
+        matrix.m() == 0 || matrix.n() == 0)
+      return;
+
+    cache.matrices[key] = matrix;
+
+    if (cache.directory.empty())
+      return;
+
+    // write to a file with a name unique to this process first and then
+    // move it to its final name, which is atomic on POSIX file systems
+    const std::string file_name =
+      get_matrix_cache_file_name(cache.directory, key);
+    const std::string tmp_file_name =
+      file_name + "." + Utilities::System::get_hostname() + "." +
+      Utilities::to_string(Utilities::MPI::job_supports_mpi() ?
+                             Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) :
+                             0);
+    {
+      std::ofstream      file(tmp_file_name, std::ios::binary);
+      const unsigned int size[2] = {static_cast<unsigned int>(matrix.m()),
+                                    static_cast<unsigned int>(matrix.n())};
+      file.write(reinterpret_cast<const char *>(size), sizeof(size));
+      file.write(reinterpret_cast<const char *>(&matrix(0, 0)),
+                 sizeof(double) * matrix.m() * matrix.n());
+      if (!file)
+        {
+          file.close();
+          std::remove(tmp_file_name.c_str());
+          return;
+        }
+    }
+    std::rename(tmp_file_name.c_str(), file_name.c_str());
+  }
+} // namespace FETools
+
 /*-------------- Explicit Instantiations -------------------------------*/
 #include "fe_tools.inst"
 
@@ -172,6 +172,9 @@ namespace FEValuesViews
             shape_function_to_row_table[i * fe.n_components() + component];
         else
           shape_function_data[i].row_index = numbers::invalid_unsigned_int;
+
+        if (shape_function_data[i].is_nonzero_shape_function_component == true)
+          nonzero_shape_functions.push_back(i);
       }
   }
 
@@ -253,6 +256,9 @@ namespace FEValuesViews
                   break;
                 }
           }
+
+        if (n_nonzero_components > 0)
+          nonzero_shape_functions.push_back(i);
       }
   }
 
@@ -449,6 +455,7 @@ namespace FEValuesViews
       const Table<2, double> & shape_values,
       const std::vector<typename Scalar<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename ProductType<Number, double>::type> &values)
     {
       const unsigned int dofs_per_cell = dof_values.size();
@@ -460,24 +467,21 @@ namespace FEValuesViews
                 values.end(),
                 dealii::internal::NumberType<Number>::value(0.0));
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
-        if (shape_function_data[shape_function]
-              .is_nonzero_shape_function_component)
-          {
-            const Number &value = dof_values[shape_function];
-            // For auto-differentiable numbers, the fact that a DoF value is
-            // zero does not imply that its derivatives are zero as well. So we
-            // can't filter by value for these number types.
-            if (dealii::internal::CheckForZero<Number>::value(value) == true)
-              continue;
-
-            const double *shape_value_ptr =
-              &shape_values(shape_function_data[shape_function].row_index, 0);
-            for (unsigned int q_point = 0; q_point < n_quadrature_points;
-                 ++q_point)
-              values[q_point] += value * (*shape_value_ptr++);
-          }
+      for (const unsigned int shape_function : nonzero_shape_functions)
+        {
+          const Number &value = dof_values[shape_function];
+          // For auto-differentiable numbers, the fact that a DoF value is
+          // zero does not imply that its derivatives are zero as well. So we
+          // can't filter by value for these number types.
+          if (dealii::internal::CheckForZero<Number>::value(value) == true)
+            continue;
+
+          const double *shape_value_ptr =
+            &shape_values(shape_function_data[shape_function].row_index, 0);
+          for (unsigned int q_point = 0; q_point < n_quadrature_points;
+               ++q_point)
+            values[q_point] += value * (*shape_value_ptr++);
+        }
     }
 
 
@@ -491,6 +495,7 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<order, spacedim>> &shape_derivatives,
       const std::vector<typename Scalar<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<
         typename ProductType<Number, dealii::Tensor<order, spacedim>>::type>
         &derivatives)
@@ -505,25 +510,22 @@ namespace FEValuesViews
         derivatives.end(),
         typename ProductType<Number, dealii::Tensor<order, spacedim>>::type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
-        if (shape_function_data[shape_function]
-              .is_nonzero_shape_function_component)
-          {
-            const Number &value = dof_values[shape_function];
-            // For auto-differentiable numbers, the fact that a DoF value is
-            // zero does not imply that its derivatives are zero as well. So we
-            // can't filter by value for these number types.
-            if (dealii::internal::CheckForZero<Number>::value(value) == true)
-              continue;
-
-            const dealii::Tensor<order, spacedim> *shape_derivative_ptr =
-              &shape_derivatives[shape_function_data[shape_function].row_index]
-                                [0];
-            for (unsigned int q_point = 0; q_point < n_quadrature_points;
-                 ++q_point)
-              derivatives[q_point] += value * (*shape_derivative_ptr++);
-          }
+      for (const unsigned int shape_function : nonzero_shape_functions)
+        {
+          const Number &value = dof_values[shape_function];
+          // For auto-differentiable numbers, the fact that a DoF value is
+          // zero does not imply that its derivatives are zero as well. So we
+          // can't filter by value for these number types.
+          if (dealii::internal::CheckForZero<Number>::value(value) == true)
+            continue;
+
+          const dealii::Tensor<order, spacedim> *shape_derivative_ptr =
+            &shape_derivatives[shape_function_data[shape_function].row_index]
+                              [0];
+          for (unsigned int q_point = 0; q_point < n_quadrature_points;
+               ++q_point)
+            derivatives[q_point] += value * (*shape_derivative_ptr++);
+        }
     }
 
 
@@ -535,6 +537,7 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<2, spacedim>> &shape_hessians,
       const std::vector<typename Scalar<dim, spacedim>::ShapeFunctionData>
         &                         shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename Scalar<dim, spacedim>::template OutputType<
         Number>::laplacian_type> &laplacians)
     {
@@ -548,24 +551,21 @@ namespace FEValuesViews
                 typename Scalar<dim, spacedim>::template OutputType<
                   Number>::laplacian_type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
-        if (shape_function_data[shape_function]
-              .is_nonzero_shape_function_component)
-          {
-            const Number &value = dof_values[shape_function];
-            // For auto-differentiable numbers, the fact that a DoF value is
-            // zero does not imply that its derivatives are zero as well. So we
-            // can't filter by value for these number types.
-            if (dealii::internal::CheckForZero<Number>::value(value) == true)
-              continue;
-
-            const dealii::Tensor<2, spacedim> *shape_hessian_ptr =
-              &shape_hessians[shape_function_data[shape_function].row_index][0];
-            for (unsigned int q_point = 0; q_point < n_quadrature_points;
-                 ++q_point)
-              laplacians[q_point] += value * trace(*shape_hessian_ptr++);
-          }
+      for (const unsigned int shape_function : nonzero_shape_functions)
+        {
+          const Number &value = dof_values[shape_function];
+          // For auto-differentiable numbers, the fact that a DoF value is
+          // zero does not imply that its derivatives are zero as well. So we
+          // can't filter by value for these number types.
+          if (dealii::internal::CheckForZero<Number>::value(value) == true)
+            continue;
+
+          const dealii::Tensor<2, spacedim> *shape_hessian_ptr =
+            &shape_hessians[shape_function_data[shape_function].row_index][0];
+          for (unsigned int q_point = 0; q_point < n_quadrature_points;
+               ++q_point)
+            laplacians[q_point] += value * trace(*shape_hessian_ptr++);
+        }
     }
 
 
@@ -579,6 +579,7 @@ namespace FEValuesViews
       const Table<2, double> & shape_values,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<
         typename ProductType<Number, dealii::Tensor<1, spacedim>>::type>
         &values)
@@ -593,16 +594,11 @@ namespace FEValuesViews
         values.end(),
         typename ProductType<Number, dealii::Tensor<1, spacedim>>::type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
 
-          if (snc == -2)
-            // shape function is zero for the selected components
-            continue;
-
           const Number &value = dof_values[shape_function];
           // For auto-differentiable numbers, the fact that a DoF value is zero
           // does not imply that its derivatives are zero as well. So we
@@ -642,6 +638,7 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<order, spacedim>> &shape_derivatives,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<
         typename ProductType<Number, dealii::Tensor<order + 1, spacedim>>::type>
         &derivatives)
@@ -657,16 +654,11 @@ namespace FEValuesViews
         typename ProductType<Number,
                              dealii::Tensor<order + 1, spacedim>>::type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
 
-          if (snc == -2)
-            // shape function is zero for the selected components
-            continue;
-
           const Number &value = dof_values[shape_function];
           // For auto-differentiable numbers, the fact that a DoF value is zero
           // does not imply that its derivatives are zero as well. So we
@@ -709,6 +701,7 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<1, spacedim>> &shape_gradients,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<
         typename ProductType<Number,
                              dealii::SymmetricTensor<2, spacedim>>::type>
@@ -726,16 +719,11 @@ namespace FEValuesViews
         typename ProductType<Number,
                              dealii::SymmetricTensor<2, spacedim>>::type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
 
-          if (snc == -2)
-            // shape function is zero for the selected components
-            continue;
-
           const Number &value = dof_values[shape_function];
           // For auto-differentiable numbers, the fact that a DoF value is zero
           // does not imply that its derivatives are zero as well. So we
@@ -782,6 +770,7 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<1, spacedim>> &shape_gradients,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
         &                          shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename Vector<dim, spacedim>::template OutputType<
         Number>::divergence_type> &divergences)
     {
@@ -795,16 +784,11 @@ namespace FEValuesViews
                 typename Vector<dim, spacedim>::template OutputType<
                   Number>::divergence_type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
 
-          if (snc == -2)
-            // shape function is zero for the selected components
-            continue;
-
           const Number &value = dof_values[shape_function];
           // For auto-differentiable numbers, the fact that a DoF value is zero
           // does not imply that its derivatives are zero as well. So we
@@ -846,6 +830,7 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<1, spacedim>> &shape_gradients,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
         &shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename ProductType<
         Number,
         typename dealii::internal::CurlType<spacedim>::type>::type> &curls)
@@ -873,17 +858,11 @@ namespace FEValuesViews
 
           case 2:
             {
-              for (unsigned int shape_function = 0;
-                   shape_function < dofs_per_cell;
-                   ++shape_function)
+              for (const unsigned int shape_function : nonzero_shape_functions)
                 {
                   const int snc = shape_function_data[shape_function]
                                     .single_nonzero_component;
 
-                  if (snc == -2)
-                    // shape function is zero for the selected components
-                    continue;
-
                   const Number &value = dof_values[shape_function];
                   // For auto-differentiable numbers, the fact that a DoF value
                   // is zero does not imply that its derivatives are zero as
@@ -957,17 +936,11 @@ namespace FEValuesViews
 
           case 3:
             {
-              for (unsigned int shape_function = 0;
-                   shape_function < dofs_per_cell;
-                   ++shape_function)
+              for (const unsigned int shape_function : nonzero_shape_functions)
                 {
                   const int snc = shape_function_data[shape_function]
                                     .single_nonzero_component;
 
-                  if (snc == -2)
-                    // shape function is zero for the selected components
-                    continue;
-
                   const Number &value = dof_values[shape_function];
                   // For auto-differentiable numbers, the fact that a DoF value
                   // is zero does not imply that its derivatives are zero as
@@ -1110,6 +1083,7 @@ namespace FEValuesViews
       const Table<2, dealii::Tensor<2, spacedim>> &shape_hessians,
       const std::vector<typename Vector<dim, spacedim>::ShapeFunctionData>
         &                         shape_function_data,
+      const std::vector<unsigned int> &nonzero_shape_functions,
       std::vector<typename Vector<dim, spacedim>::template OutputType<
         Number>::laplacian_type> &laplacians)
     {
@@ -1123,16 +1097,11 @@ namespace FEValuesViews
                 typename Vector<dim, spacedim>::template OutputType<
                   Number>::laplacian_type());
 
-      for (unsigned int shape_function = 0; shape_function < dofs_per_cell;
-           ++shape_function)
+      for (const unsigned int shape_function : nonzero_shape_functions)
         {
           const int snc =
             shape_function_data[shape_function].single_nonzero_component;
 
-          if (snc == -2)
-            // shape function is zero for the selected components
-            continue;
-
           const Number &value = dof_values[shape_function];
           // For auto-differentiable numbers, the fact that a DoF value is zero
           // does not imply that its derivatives are zero as well. So we
@@ -1597,6 +1566,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_functions,
       values);
   }
 
@@ -1622,6 +1592,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_functions,
       values);
   }
 
@@ -1653,6 +1624,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       gradients);
   }
 
@@ -1678,6 +1650,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       gradients);
   }
 
@@ -1709,6 +1682,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       hessians);
   }
 
@@ -1734,6 +1708,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       hessians);
   }
 
@@ -1765,6 +1740,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       laplacians);
   }
 
@@ -1790,6 +1766,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       laplacians);
   }
 
@@ -1821,6 +1798,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_3rd_derivatives,
       shape_function_data,
+      nonzero_shape_functions,
       third_derivatives);
   }
 
@@ -1845,6 +1823,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_3rd_derivatives,
       shape_function_data,
+      nonzero_shape_functions,
       third_derivatives);
   }
 
@@ -1876,6 +1855,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_functions,
       values);
   }
 
@@ -1901,6 +1881,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_values,
       shape_function_data,
+      nonzero_shape_functions,
       values);
   }
 
@@ -1932,6 +1913,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       gradients);
   }
 
@@ -1957,6 +1939,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       gradients);
   }
 
@@ -1988,6 +1971,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       symmetric_gradients);
   }
 
@@ -2012,6 +1996,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       symmetric_gradients);
   }
 
@@ -2044,6 +2029,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       divergences);
   }
 
@@ -2069,6 +2055,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       divergences);
   }
 
@@ -2100,6 +2087,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       curls);
   }
 
@@ -2125,6 +2113,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_gradients,
       shape_function_data,
+      nonzero_shape_functions,
       curls);
   }
 
@@ -2156,6 +2145,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       hessians);
   }
 
@@ -2181,6 +2171,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       hessians);
   }
 
@@ -2217,6 +2208,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       laplacians);
   }
 
@@ -2245,6 +2237,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_hessians,
       shape_function_data,
+      nonzero_shape_functions,
       laplacians);
   }
 
@@ -2276,6 +2269,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_3rd_derivatives,
       shape_function_data,
+      nonzero_shape_functions,
       third_derivatives);
   }
 
@@ -2300,6 +2294,7 @@ namespace FEValuesViews
       make_array_view(dof_values.begin(), dof_values.end()),
       fe_values->finite_element_output.shape_3rd_derivatives,
       shape_function_data,
+      nonzero_shape_functions,
       third_derivatives);
   }
 
@@ -3091,6 +3086,7 @@ FEValuesBase<dim, spacedim>::FEValuesBase(
   , mapping(&mapping, typeid(*this).name())
   , fe(&fe, typeid(*this).name())
   , cell_similarity(CellSimilarity::Similarity::none)
+  , check_for_cell_similarity_allowed(false)
   , fe_values_views_cache(*this)
 {
   Assert(n_q_points > 0,
@@ -4348,9 +4344,10 @@ FEValuesBase<dim, spacedim>::check_cell_similarity(
   // multithreading is disabled on default, but in many other situations
   // because we rarely explicitly set the number of threads.
   //
-  // TODO: Is it reasonable to introduce a flag "unsafe" in the constructor of
-  // FEValues to re-enable this feature?
-  if (MultithreadInfo::n_threads() > 1)
+  // The check can be re-enabled explicitly through
+  // always_allow_check_for_cell_similarity().
+  if (MultithreadInfo::n_threads() > 1 &&
+      check_for_cell_similarity_allowed == false)
     {
       cell_similarity = CellSimilarity::none;
       return;
@@ -4394,6 +4391,16 @@ FEValuesBase<dim, spacedim>::get_cell_similarity() const
 
 
 
+template <int dim, int spacedim>
+void
+FEValuesBase<dim, spacedim>::always_allow_check_for_cell_similarity(
+  const bool allow)
+{
+  check_for_cell_similarity_allowed = allow;
+}
+
+
+
 template <int dim, int spacedim>
 const unsigned int FEValuesBase<dim, spacedim>::dimension;
 
@@ -122,6 +122,16 @@ template <int dim, int spacedim>
 std::vector<Point<spacedim>>
 MappingQCache<dim, spacedim>::compute_mapping_support_points(
   const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
+{
+  return get_mapping_support_points(cell);
+}
+
+
+
+template <int dim, int spacedim>
+const std::vector<Point<spacedim>> &
+MappingQCache<dim, spacedim>::get_mapping_support_points(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell) const
 {
   Assert(support_point_cache.get() != nullptr,
          ExcMessage("Must call MappingQCache::initialize() before "
@@ -45,6 +45,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <limits>
 #include <memory>
 #include <numeric>
 
@@ -788,6 +789,13 @@ MappingQGeneric<dim, spacedim>::InternalData::initialize(
             }
         }
     }
+
+  // if the quadrature is not a tensor product of identical 1d formulas, the
+  // points might still form tensor-product grids (e.g. for anisotropic
+  // formulas or for the points on faces), which we can exploit as well
+  tensor_product_points.clear();
+  if (dim > 1 && polynomial_degree >= 2 && tensor_product_quadrature == false)
+    initialize_tensor_product_points(q, n_original_q_points);
 }
 
 
@@ -801,22 +809,6 @@ MappingQGeneric<dim, spacedim>::InternalData::initialize_face(
 {
   initialize(update_flags, q, n_original_q_points);
 
-  if (dim > 1 && tensor_product_quadrature)
-    {
-      const unsigned int  facedim = dim > 1 ? dim - 1 : 1;
-      const FE_Q<facedim> fe(polynomial_degree);
-      shape_info.reinit(q.get_tensor_basis()[0], fe);
-
-      const unsigned int n_shape_values = fe.n_dofs_per_cell();
-      const unsigned int n_q_points     = q.size();
-      const unsigned int max_size       = std::max(n_q_points, n_shape_values);
-      const unsigned int vec_length = VectorizedArray<double>::n_array_elements;
-      const unsigned int n_comp     = 1 + (spacedim - 1) / vec_length;
-
-      scratch.resize((dim - 1) * max_size);
-      values_dofs.resize(n_comp * n_shape_values);
-    }
-
   if (dim > 1)
     {
       if (this->update_each &
@@ -952,6 +944,102 @@ MappingQGeneric<3, 3>::InternalData::compute_shape_function_values(
     }
 }
 
+template <int dim, int spacedim>
+void
+MappingQGeneric<dim, spacedim>::InternalData::initialize_tensor_product_points(
+  const Quadrature<dim> &q,
+  const unsigned int     n_points_per_set)
+{
+  tensor_product_points.clear();
+  if (n_points_per_set == 0 || q.size() % n_points_per_set != 0)
+    return;
+
+  const double tolerance = 1e-12;
+  const auto   same_coordinate = [tolerance](const double a, const double b) {
+    return std::abs(a - b) < tolerance;
+  };
+
+  const std::vector<Polynomials::Polynomial<double>> polynomials =
+    Polynomials::generate_complete_Lagrange_basis(
+      line_support_points.get_points());
+
+  const unsigned int               n_sets = q.size() / n_points_per_set;
+  std::vector<TensorProductPoints> sets(n_sets);
+  for (unsigned int s = 0; s < n_sets; ++s)
+    {
+      const Point<dim> *points = q.get_points().data() + s * n_points_per_set;
+
+      // collect the distinct coordinates of the points in each direction
+      std::array<std::vector<double>, dim> coordinates;
+      unsigned int                         n_grid_points = 1;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          coordinates[d].resize(n_points_per_set);
+          for (unsigned int i = 0; i < n_points_per_set; ++i)
+            coordinates[d][i] = points[i][d];
+          std::sort(coordinates[d].begin(), coordinates[d].end());
+          coordinates[d].erase(std::unique(coordinates[d].begin(),
+                                           coordinates[d].end(),
+                                           same_coordinate),
+                               coordinates[d].end());
+          n_grid_points *= coordinates[d].size();
+        }
+
+      // the points form a tensor-product grid if there are as many of them
+      // as grid points and each grid point is hit exactly once
+      if (n_grid_points != n_points_per_set)
+        return;
+
+      TensorProductPoints &set = sets[s];
+      set.tensor_index.resize(n_points_per_set);
+      std::vector<bool> grid_point_used(n_grid_points, false);
+      for (unsigned int i = 0; i < n_points_per_set; ++i)
+        {
+          unsigned int index = 0, stride = 1;
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              const auto position = std::lower_bound(coordinates[d].begin(),
+                                                     coordinates[d].end(),
+                                                     points[i][d] - tolerance);
+              Assert(position != coordinates[d].end() &&
+                       same_coordinate(*position, points[i][d]),
+                     ExcInternalError());
+              index += (position - coordinates[d].begin()) * stride;
+              stride *= coordinates[d].size();
+            }
+          if (grid_point_used[index])
+            return;
+          grid_point_used[index] = true;
+          set.tensor_index[i]    = index;
+        }
+
+      std::vector<double> values(3);
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          for (unsigned int k = 0; k < 3; ++k)
+            set.shape_1d[d][k].reinit(coordinates[d].size(),
+                                      polynomials.size());
+          for (unsigned int i = 0; i < coordinates[d].size(); ++i)
+            for (unsigned int j = 0; j < polynomials.size(); ++j)
+              {
+                polynomials[j].value(coordinates[d][i], values);
+                for (unsigned int k = 0; k < 3; ++k)
+                  set.shape_1d[d][k](i, j) = values[k];
+              }
+        }
+    }
+
+  tensor_product_points.swap(sets);
+  lexicographic_to_hierarchic =
+    FETools::lexicographic_to_hierarchic_numbering(FiniteElementData<dim>(
+      internal::MappingQGenericImplementation::get_dpo_vector<dim>(
+        polynomial_degree),
+      1,
+      polynomial_degree));
+}
+
+
+
 template <int dim, int spacedim>
 void
 MappingQGeneric<dim, spacedim>::InternalData::compute_shape_function_values(
@@ -1386,6 +1474,213 @@ namespace internal
 
 
 
+      /**
+       * Evaluate the position and the Jacobian of the polynomial mapping at
+       * the points @p p_unit, given the mapping support points in
+       * lexicographic order and the 1D support points of the Lagrange basis
+       * with the weights @p lagrange_weights (the inverse of the product of
+       * the differences between each node and all others).
+       */
+      template <int dim, typename Number>
+      void
+      compute_mapped_location_and_jacobian(
+        const std::vector<Point<dim>> & support_points,
+        const std::vector<Point<1>> &   nodes,
+        const std::vector<double> &     lagrange_weights,
+        const Tensor<1, dim, Number> &  p_unit,
+        std::vector<Number> &           values,
+        std::vector<Number> &           derivatives,
+        Tensor<1, dim, Number> &        p_real,
+        Tensor<2, dim, Number> &        jacobian)
+      {
+        const unsigned int n = nodes.size();
+        values.resize(dim * n);
+        derivatives.resize(dim * n);
+
+        // values and derivatives of the 1D Lagrange polynomials, evaluated
+        // by the product formula and the product rule
+        for (unsigned int d = 0; d < dim; ++d)
+          for (unsigned int i = 0; i < n; ++i)
+            {
+              Number value      = lagrange_weights[i];
+              Number derivative = Number();
+              for (unsigned int j = 0; j < n; ++j)
+                if (j != i)
+                  {
+                    const Number factor = p_unit[d] - nodes[j][0];
+                    derivative          = derivative * factor + value;
+                    value *= factor;
+                  }
+              values[d * n + i]      = value;
+              derivatives[d * n + i] = derivative;
+            }
+
+        p_real   = Tensor<1, dim, Number>();
+        jacobian = Tensor<2, dim, Number>();
+        for (unsigned int q = 0; q < support_points.size(); ++q)
+          {
+            unsigned int index[3] = {q % n, (q / n) % n, q / (n * n)};
+            Tensor<1, dim, Number> gradient;
+            Number                 weight = values[index[0]];
+            for (unsigned int d = 1; d < dim; ++d)
+              weight *= values[d * n + index[d]];
+            for (unsigned int e = 0; e < dim; ++e)
+              {
+                gradient[e] = derivatives[e * n + index[e]];
+                for (unsigned int d = 0; d < dim; ++d)
+                  if (d != e)
+                    gradient[e] *= values[d * n + index[d]];
+              }
+            for (unsigned int c = 0; c < dim; ++c)
+              {
+                p_real[c] += support_points[q][c] * weight;
+                for (unsigned int e = 0; e < dim; ++e)
+                  jacobian[c][e] += support_points[q][c] * gradient[e];
+              }
+          }
+      }
+
+
+
+      /**
+       * Implementation of transform_points_real_to_unit_cell for
+       * dim==spacedim. The Newton iteration is run on
+       * VectorizedArray<double>::n_array_elements points at once, starting
+       * from the affine approximation given by @p affine_matrix and
+       * @p affine_offset. The iteration does not use a line search, so the
+       * indices of the points where a lane does not converge or the Jacobian
+       * is not positive are returned in @p failed_points, to be treated by
+       * the more robust scalar algorithm.
+       */
+      template <int dim>
+      void
+      do_transform_points_real_to_unit_cell(
+        const std::vector<Point<dim>> &   support_points,
+        const std::vector<Point<1>> &     nodes,
+        const Tensor<2, dim> &            affine_matrix,
+        const Point<dim> &                affine_offset,
+        const ArrayView<const Point<dim>> &real_points,
+        const ArrayView<Point<dim>> &     unit_points,
+        std::vector<unsigned int> &       failed_points)
+      {
+        using Number                  = VectorizedArray<double>;
+        const unsigned int n_lanes    = Number::n_array_elements;
+        const unsigned int n_points   = real_points.size();
+        const double       eps        = 1.e-11;
+        const unsigned int iter_limit = 20;
+
+        std::vector<double> lagrange_weights(nodes.size(), 1.);
+        for (unsigned int i = 0; i < nodes.size(); ++i)
+          {
+            for (unsigned int j = 0; j < nodes.size(); ++j)
+              if (j != i)
+                lagrange_weights[i] *= nodes[i][0] - nodes[j][0];
+            lagrange_weights[i] = 1. / lagrange_weights[i];
+          }
+
+        std::vector<Number> values, derivatives;
+        for (unsigned int start = 0; start < n_points; start += n_lanes)
+          {
+            const unsigned int n_active = std::min(n_lanes, n_points - start);
+
+            // fill unused lanes with the last point to keep them converging
+            Tensor<1, dim, Number> p, p_unit;
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              for (unsigned int d = 0; d < dim; ++d)
+                p[d][v] = real_points[start + std::min(v, n_active - 1)][d];
+
+            // initial guess from the affine approximation, projected into the
+            // unit cell
+            for (unsigned int d = 0; d < dim; ++d)
+              {
+                p_unit[d] = affine_offset[d];
+                for (unsigned int e = 0; e < dim; ++e)
+                  p_unit[d] += affine_matrix[d][e] * p[e];
+                p_unit[d] =
+                  std::min(std::max(p_unit[d], Number(0.)), Number(1.));
+              }
+
+            bool done[n_lanes];
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              done[v] = (v >= n_active);
+
+            for (unsigned int iteration = 0;; ++iteration)
+              {
+                Tensor<1, dim, Number> p_real;
+                Tensor<2, dim, Number> jacobian;
+                compute_mapped_location_and_jacobian(support_points,
+                                                     nodes,
+                                                     lagrange_weights,
+                                                     p_unit,
+                                                     values,
+                                                     derivatives,
+                                                     p_real,
+                                                     jacobian);
+                const Number det = determinant(jacobian);
+
+                // guard the inversion against lanes with a degenerate Jacobian
+                // that are discarded below anyway
+                Tensor<2, dim, Number> jacobian_safe = jacobian;
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  if (!(det[v] > 0.))
+                    for (unsigned int d = 0; d < dim; ++d)
+                      for (unsigned int e = 0; e < dim; ++e)
+                        jacobian_safe[d][e][v] = (d == e) ? 1. : 0.;
+                const Tensor<1, dim, Number> delta =
+                  invert(jacobian_safe) * (p_real - p);
+
+                bool all_done = true;
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  if (!done[v])
+                    {
+                      double norm_square = 0;
+                      for (unsigned int d = 0; d < dim; ++d)
+                        norm_square += delta[d][v] * delta[d][v];
+                      if (!(det[v] > 0.) || !(norm_square < 1e50))
+                        {
+                          failed_points.push_back(start + v);
+                          done[v] = true;
+                        }
+                      else if (norm_square < eps * eps)
+                        {
+                          for (unsigned int d = 0; d < dim; ++d)
+                            unit_points[start + v][d] = p_unit[d][v];
+                          done[v] = true;
+                        }
+                      else if (iteration == iter_limit)
+                        {
+                          failed_points.push_back(start + v);
+                          done[v] = true;
+                        }
+                      all_done = all_done && done[v];
+                    }
+                if (all_done)
+                  break;
+
+                p_unit -= delta;
+              }
+          }
+      }
+
+
+
+      template <int dim, int spacedim>
+      void
+      do_transform_points_real_to_unit_cell(
+        const std::vector<Point<spacedim>> &,
+        const std::vector<Point<1>> &,
+        const Tensor<2, spacedim> &,
+        const Point<dim> &,
+        const ArrayView<const Point<spacedim>> &,
+        const ArrayView<Point<dim>> &,
+        std::vector<unsigned int> &)
+      {
+        // not used for the codimension one case
+        Assert(false, ExcInternalError());
+      }
+
+
+
       /**
        * Implementation of transform_real_to_unit_cell for dim==spacedim-1
        */
@@ -1676,6 +1971,301 @@ namespace internal
       }
 
 
+      /**
+       * Return whether the cell described by the given @p vertices, i.e.,
+       * the support points of a linear mapping, is a parallelogram or
+       * parallelepiped. In that case, the mapping is affine and its Jacobian
+       * is the same in all points of the cell.
+       */
+      template <int dim, int spacedim>
+      bool
+      is_affine_cell(const std::vector<Point<spacedim>> &vertices)
+      {
+        AssertDimension(vertices.size(), GeometryInfo<dim>::vertices_per_cell);
+
+        Tensor<1, spacedim> edges[dim];
+        double              scale = 0;
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            edges[d] = vertices[1 << d] - vertices[0];
+            scale += edges[d].norm();
+          }
+
+        for (unsigned int v = 1; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          {
+            Point<spacedim> affine_vertex = vertices[0];
+            for (unsigned int d = 0; d < dim; ++d)
+              if (v & (1 << d))
+                affine_vertex += edges[d];
+            if (affine_vertex.distance(vertices[v]) > 1e-12 * scale)
+              return false;
+          }
+        return true;
+      }
+
+
+
+      /**
+       * Compute the quadrature points, the Jacobians and the Jacobian
+       * gradients on a cell for which is_affine_cell() returned true, with
+       * the Jacobian computed only once for the whole cell.
+       */
+      template <int dim, int spacedim>
+      void
+      update_q_points_Jacobians_and_grads_affine(
+        const Quadrature<dim> &quadrature,
+        const typename dealii::MappingQGeneric<dim, spacedim>::InternalData
+          &                                            data,
+        std::vector<Point<spacedim>> &                 quadrature_points,
+        std::vector<DerivativeForm<2, dim, spacedim>> &jacobian_grads)
+      {
+        const UpdateFlags                   update_flags = data.update_each;
+        const std::vector<Point<spacedim>> &vertices =
+          data.mapping_support_points;
+
+        DerivativeForm<1, dim, spacedim> jacobian;
+        for (unsigned int d = 0; d < dim; ++d)
+          for (unsigned int i = 0; i < spacedim; ++i)
+            jacobian[i][d] = vertices[1 << d][i] - vertices[0][i];
+
+        if (update_flags & update_quadrature_points)
+          for (unsigned int point = 0; point < quadrature.size(); ++point)
+            {
+              Point<spacedim> result = vertices[0];
+              for (unsigned int i = 0; i < spacedim; ++i)
+                for (unsigned int d = 0; d < dim; ++d)
+                  result[i] += jacobian[i][d] * quadrature.point(point)[d];
+              quadrature_points[point] = result;
+            }
+
+        if (update_flags & update_contravariant_transformation)
+          std::fill(data.contravariant.begin(),
+                    data.contravariant.end(),
+                    jacobian);
+
+        if (update_flags & update_covariant_transformation)
+          std::fill(data.covariant.begin(),
+                    data.covariant.end(),
+                    jacobian.covariant_form());
+
+        if (update_flags & update_volume_elements)
+          std::fill(data.volume_elements.begin(),
+                    data.volume_elements.end(),
+                    jacobian.determinant());
+
+        if (update_flags & update_jacobian_grads)
+          std::fill(jacobian_grads.begin(),
+                    jacobian_grads.end(),
+                    DerivativeForm<2, dim, spacedim>());
+      }
+
+
+
+      /**
+       * Contract the data @p in, stored on a tensor-product grid, along one
+       * coordinate direction with @p matrix, which maps the @p matrix.n_cols()
+       * entries along this direction to @p matrix.n_rows() entries. The
+       * directions before the current one have @p n_before entries in total,
+       * the ones after it @p n_after.
+       */
+      template <int spacedim>
+      void
+      contract_tensor_direction(const Table<2, double> &   matrix,
+                                const unsigned int         n_before,
+                                const unsigned int         n_after,
+                                const Tensor<1, spacedim> *in,
+                                Tensor<1, spacedim> *      out)
+      {
+        const unsigned int n_in  = matrix.n_cols();
+        const unsigned int n_out = matrix.n_rows();
+        for (unsigned int a = 0; a < n_after; ++a)
+          for (unsigned int j = 0; j < n_out; ++j)
+            for (unsigned int b = 0; b < n_before; ++b)
+              {
+                Tensor<1, spacedim> sum;
+                for (unsigned int i = 0; i < n_in; ++i)
+                  sum += matrix(j, i) * in[(a * n_in + i) * n_before + b];
+                out[(a * n_out + j) * n_before + b] = sum;
+              }
+      }
+
+
+
+      /**
+       * Evaluate the mapping and all its derivatives of an order up to
+       * @p max_order in the tensor-product grid described by @p points, by
+       * contracting the lexicographically ordered support points stored in
+       * the first entry of @p buffers along one direction after the other.
+       * For each combination of derivative orders in the coordinate
+       * directions, @p store is called with these orders and the result.
+       */
+      template <int dim, int spacedim, typename StoreFunction>
+      void
+      contract_tensor_product_points(
+        const typename dealii::MappingQGeneric<dim, spacedim>::InternalData::
+          TensorProductPoints &                               points,
+        const unsigned int                                    n_points_1d,
+        const unsigned int                                    max_order,
+        const unsigned int                                    direction,
+        std::array<unsigned int, dim> &                       orders,
+        std::array<std::vector<Tensor<1, spacedim>>, dim + 1> &buffers,
+        const StoreFunction &                                 store)
+      {
+        if (direction == dim)
+          {
+            store(orders, buffers[dim]);
+            return;
+          }
+
+        unsigned int n_before = 1;
+        for (unsigned int d = 0; d < direction; ++d)
+          n_before *= points.shape_1d[d][0].n_rows();
+        const unsigned int n_after =
+          Utilities::pow(n_points_1d, dim - 1 - direction);
+        buffers[direction + 1].resize(
+          n_before * points.shape_1d[direction][0].n_rows() * n_after);
+
+        for (unsigned int k = 0; k <= max_order; ++k)
+          {
+            orders[direction] = k;
+            contract_tensor_direction(points.shape_1d[direction][k],
+                                      n_before,
+                                      n_after,
+                                      buffers[direction].data(),
+                                      buffers[direction + 1].data());
+            contract_tensor_product_points<dim, spacedim>(points,
+                                                          n_points_1d,
+                                                          max_order - k,
+                                                          direction + 1,
+                                                          orders,
+                                                          buffers,
+                                                          store);
+          }
+      }
+
+
+
+      /**
+       * Compute the quadrature points, the Jacobians and the Jacobian
+       * gradients with sum factorization in case the quadrature points of
+       * the data set @p data_set_index form a tensor-product grid as
+       * described by InternalData::tensor_product_points.
+       */
+      template <int dim, int spacedim>
+      void
+      maybe_update_q_points_Jacobians_and_grads_tensor_product_points(
+        const CellSimilarity::Similarity cell_similarity,
+        const unsigned int               data_set_index,
+        const typename dealii::MappingQGeneric<dim, spacedim>::InternalData
+          &                                            data,
+        std::vector<Point<spacedim>> &                 quadrature_points,
+        std::vector<DerivativeForm<2, dim, spacedim>> &jacobian_grads)
+      {
+        const UpdateFlags update_flags = data.update_each;
+
+        const bool evaluate_values = update_flags & update_quadrature_points;
+        const bool evaluate_gradients =
+          (cell_similarity != CellSimilarity::translation) &&
+          (update_flags & update_contravariant_transformation);
+        const bool evaluate_hessians =
+          (cell_similarity != CellSimilarity::translation) &&
+          (update_flags & update_jacobian_grads);
+
+        AssertIndexRange(data_set_index, data.tensor_product_points.size());
+        const auto &points = data.tensor_product_points[data_set_index];
+        const std::vector<unsigned int> &tensor_index = points.tensor_index;
+        const unsigned int               n_q_points   = tensor_index.size();
+
+        Assert(!evaluate_values || n_q_points == quadrature_points.size(),
+               ExcDimensionMismatch(n_q_points, quadrature_points.size()));
+        Assert(!evaluate_gradients || n_q_points == data.contravariant.size(),
+               ExcDimensionMismatch(n_q_points, data.contravariant.size()));
+        Assert(!evaluate_hessians || n_q_points == jacobian_grads.size(),
+               ExcDimensionMismatch(n_q_points, jacobian_grads.size()));
+
+        if (evaluate_values || evaluate_gradients || evaluate_hessians)
+          {
+            auto &buffers = data.tensor_product_scratch;
+            AssertDimension(data.mapping_support_points.size(),
+                            data.lexicographic_to_hierarchic.size());
+            const std::vector<unsigned int> &renumber =
+              data.lexicographic_to_hierarchic;
+            buffers[0].resize(renumber.size());
+            for (unsigned int i = 0; i < renumber.size(); ++i)
+              buffers[0][i] = data.mapping_support_points[renumber[i]];
+
+            if (evaluate_gradients)
+              std::fill(data.contravariant.begin(),
+                        data.contravariant.end(),
+                        DerivativeForm<1, dim, spacedim>());
+
+            const auto store =
+              [&](const std::array<unsigned int, dim> &   orders,
+                  const std::vector<Tensor<1, spacedim>> &result) {
+                unsigned int order = 0;
+                for (unsigned int d = 0; d < dim; ++d)
+                  order += orders[d];
+
+                if (order == 0 && evaluate_values)
+                  for (unsigned int q = 0; q < n_q_points; ++q)
+                    quadrature_points[q] =
+                      Point<spacedim>(result[tensor_index[q]]);
+                else if (order == 1 && evaluate_gradients)
+                  {
+                    const unsigned int d =
+                      std::find(orders.begin(), orders.end(), 1U) -
+                      orders.begin();
+                    for (unsigned int q = 0; q < n_q_points; ++q)
+                      for (unsigned int i = 0; i < spacedim; ++i)
+                        data.contravariant[q][i][d] =
+                          result[tensor_index[q]][i];
+                  }
+                else if (order == 2 && evaluate_hessians)
+                  {
+                    // the two directions of the derivative, which coincide
+                    // for a second derivative along one direction
+                    unsigned int d1 = 0;
+                    while (orders[d1] == 0)
+                      ++d1;
+                    unsigned int d2 = d1 + (orders[d1] == 1 ? 1 : 0);
+                    while (orders[d2] == 0)
+                      ++d2;
+                    for (unsigned int q = 0; q < n_q_points; ++q)
+                      for (unsigned int i = 0; i < spacedim; ++i)
+                        {
+                          jacobian_grads[q][i][d1][d2] =
+                            result[tensor_index[q]][i];
+                          jacobian_grads[q][i][d2][d1] =
+                            result[tensor_index[q]][i];
+                        }
+                  }
+              };
+
+            std::array<unsigned int, dim> orders;
+            contract_tensor_product_points<dim, spacedim>(
+              points,
+              data.polynomial_degree + 1,
+              evaluate_hessians ? 2 : (evaluate_gradients ? 1 : 0),
+              0,
+              orders,
+              buffers,
+              store);
+          }
+
+        if (update_flags & update_covariant_transformation)
+          if (cell_similarity != CellSimilarity::translation)
+            for (unsigned int point = 0; point < n_q_points; ++point)
+              data.covariant[point] =
+                (data.contravariant[point]).covariant_form();
+
+        if (update_flags & update_volume_elements)
+          if (cell_similarity != CellSimilarity::translation)
+            for (unsigned int point = 0; point < n_q_points; ++point)
+              data.volume_elements[point] =
+                data.contravariant[point].determinant();
+      }
+
+
       /**
        * Compute the locations of quadrature points on the object described by
        * the first argument (and the cell for which the mapping support points
@@ -2662,6 +3252,85 @@ MappingQGeneric<dim, spacedim>::transform_real_to_unit_cell(
 
 
 
+template <int dim, int spacedim>
+void
+MappingQGeneric<dim, spacedim>::transform_points_real_to_unit_cell(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const ArrayView<const Point<spacedim>> &                    real_points,
+  const ArrayView<Point<dim>> &                               unit_points) const
+{
+  AssertDimension(real_points.size(), unit_points.size());
+
+  // the vectorized Newton iteration is only implemented for dim==spacedim,
+  // and it needs the vertices of the cell for the initial guess. Also, a
+  // single point is better served by the scalar function.
+  if (dim != spacedim || this->preserves_vertex_locations() == false ||
+      real_points.size() < 2)
+    {
+      Mapping<dim, spacedim>::transform_points_real_to_unit_cell(cell,
+                                                                 real_points,
+                                                                 unit_points);
+      return;
+    }
+
+  // get the mapping support points in lexicographic order
+  const std::vector<Point<spacedim>> hierarchic_support_points =
+    this->compute_mapping_support_points(cell);
+  const std::vector<unsigned int> renumber(
+    FETools::lexicographic_to_hierarchic_numbering(FiniteElementData<dim>(
+      internal::MappingQGenericImplementation::get_dpo_vector<dim>(
+        polynomial_degree),
+      1,
+      polynomial_degree)));
+  std::vector<Point<spacedim>> support_points(renumber.size());
+  for (unsigned int i = 0; i < renumber.size(); ++i)
+    support_points[i] = hierarchic_support_points[renumber[i]];
+
+  // the affine approximation of the inverse mapping is an affine function,
+  // so we can extract its coefficients by evaluating it at the origin and
+  // the unit vectors
+  const Point<spacedim> origin;
+  const Point<dim>      affine_offset =
+    cell->real_to_unit_cell_affine_approximation(origin);
+  Tensor<2, spacedim> affine_matrix;
+  for (unsigned int e = 0; e < spacedim; ++e)
+    {
+      Point<spacedim> unit_vector;
+      unit_vector[e] = 1.;
+      const Point<dim> image =
+        cell->real_to_unit_cell_affine_approximation(unit_vector);
+      for (unsigned int d = 0; d < dim; ++d)
+        affine_matrix[d][e] = image[d] - affine_offset[d];
+    }
+
+  std::vector<unsigned int> failed_points;
+  internal::MappingQGenericImplementation::
+    do_transform_points_real_to_unit_cell(support_points,
+                                          line_support_points.get_points(),
+                                          affine_matrix,
+                                          affine_offset,
+                                          real_points,
+                                          unit_points,
+                                          failed_points);
+
+  // fall back to the scalar algorithm with line search for the points
+  // where the plain Newton iteration did not succeed
+  for (const unsigned int i : failed_points)
+    {
+      try
+        {
+          unit_points[i] = transform_real_to_unit_cell(cell, real_points[i]);
+        }
+      catch (typename Mapping<dim, spacedim>::ExcTransformationFailed &)
+        {
+          unit_points[i]    = Point<dim>();
+          unit_points[i][0] = std::numeric_limits<double>::infinity();
+        }
+    }
+}
+
+
+
 template <int dim, int spacedim>
 UpdateFlags
 MappingQGeneric<dim, spacedim>::requires_update_flags(
@@ -2807,7 +3476,25 @@ MappingQGeneric<dim, spacedim>::fill_fe_values(
   const CellSimilarity::Similarity computed_cell_similarity =
     (polynomial_degree == 1 ? cell_similarity : CellSimilarity::none);
 
-  if (dim > 1 && data.tensor_product_quadrature)
+  // for a linear mapping on a parallelogram or parallelepiped, the Jacobian
+  // is constant on the cell, so we need to compute it and all quantities
+  // derived from it only once rather than in each quadrature point
+  const bool affine_cell =
+    (polynomial_degree == 1 && dim == spacedim && n_q_points > 0 &&
+     computed_cell_similarity != CellSimilarity::translation &&
+     internal::MappingQGenericImplementation::is_affine_cell<dim, spacedim>(
+       data.mapping_support_points));
+
+  if (affine_cell)
+    {
+      internal::MappingQGenericImplementation::
+        update_q_points_Jacobians_and_grads_affine<dim, spacedim>(
+          quadrature,
+          data,
+          output_data.quadrature_points,
+          output_data.jacobian_grads);
+    }
+  else if (dim > 1 && data.tensor_product_quadrature)
     {
       internal::MappingQGenericImplementation::
         maybe_update_q_points_Jacobians_and_grads_tensor<dim, spacedim>(
@@ -2816,6 +3503,17 @@ MappingQGeneric<dim, spacedim>::fill_fe_values(
           output_data.quadrature_points,
           output_data.jacobian_grads);
     }
+  else if (!data.tensor_product_points.empty())
+    {
+      internal::MappingQGenericImplementation::
+        maybe_update_q_points_Jacobians_and_grads_tensor_product_points<
+          dim,
+          spacedim>(computed_cell_similarity,
+                    0,
+                    data,
+                    output_data.quadrature_points,
+                    output_data.jacobian_grads);
+    }
   else
     {
       internal::MappingQGenericImplementation::maybe_compute_q_points<dim,
@@ -2889,12 +3587,17 @@ MappingQGeneric<dim, spacedim>::fill_fe_values(
                                   n_q_points));
 
 
+      const double affine_det =
+        affine_cell ? data.contravariant[0].determinant() : 0.;
+
       if (computed_cell_similarity != CellSimilarity::translation)
         for (unsigned int point = 0; point < n_q_points; ++point)
           {
             if (dim == spacedim)
               {
-                const double det = data.contravariant[point].determinant();
+                const double det =
+                  affine_cell ? affine_det :
+                                data.contravariant[point].determinant();
 
                 // check for distorted cells.
 
@@ -2981,7 +3684,11 @@ MappingQGeneric<dim, spacedim>::fill_fe_values(
   if (update_flags & update_inverse_jacobians)
     {
       AssertDimension(output_data.inverse_jacobians.size(), n_q_points);
-      if (computed_cell_similarity != CellSimilarity::translation)
+      if (affine_cell)
+        std::fill(output_data.inverse_jacobians.begin(),
+                  output_data.inverse_jacobians.end(),
+                  data.covariant[0].transpose());
+      else if (computed_cell_similarity != CellSimilarity::translation)
         for (unsigned int point = 0; point < n_q_points; ++point)
           output_data.inverse_jacobians[point] =
             data.covariant[point].transpose();
@@ -3192,13 +3899,17 @@ namespace internal
         internal::FEValuesImplementation::MappingRelatedData<dim, spacedim>
           &output_data)
       {
-        if (dim > 1 && data.tensor_product_quadrature)
+        if (!data.tensor_product_points.empty())
           {
-            maybe_update_q_points_Jacobians_and_grads_tensor<dim, spacedim>(
-              CellSimilarity::none,
-              data,
-              output_data.quadrature_points,
-              output_data.jacobian_grads);
+            // the data sets are numbered consecutively with the same number
+            // of points each
+            maybe_update_q_points_Jacobians_and_grads_tensor_product_points<
+              dim,
+              spacedim>(CellSimilarity::none,
+                        data_set / quadrature.size(),
+                        data,
+                        output_data.quadrature_points,
+                        output_data.jacobian_grads);
           }
         else
           {
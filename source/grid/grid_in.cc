@@ -15,6 +15,7 @@
 
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/path_search.h>
 #include <deal.II/base/utilities.h>
 
@@ -26,6 +27,7 @@
 #include <boost/io/ios_state.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <fstream>
 #include <functional>
@@ -1439,8 +1441,16 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       Assert((version >= 2.0) && (version <= 4.1), ExcNotImplemented());
       gmsh_file_format = static_cast<unsigned int>(version * 10);
 
-      Assert(file_type == 0, ExcNotImplemented());
       Assert(data_size == sizeof(double), ExcNotImplemented());
+      if (file_type == 1)
+        {
+          AssertThrow(gmsh_file_format == 41,
+                      ExcMessage("Only binary msh files in version 4.1 of "
+                                 "the format can be read."));
+          read_msh_binary(in);
+          return;
+        }
+      Assert(file_type == 0, ExcNotImplemented());
 
       // read the end of the header and the first line of the nodes description
       // to synch ourselves with the format 1 handling above
@@ -2033,6 +2043,368 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
     assign_1d_boundary_ids(boundary_ids_1d, *tria);
 }
 
+namespace
+{
+  /**
+   * Read @p n values of type T from the binary input stream @p in and append
+   * them to @p values.
+   */
+  template <typename T>
+  void
+  read_binary_values(std::istream &   in,
+                     const std::size_t n,
+                     std::vector<T> &  values)
+  {
+    const std::size_t old_size = values.size();
+    values.resize(old_size + n);
+    if (n > 0)
+      in.read(reinterpret_cast<char *>(values.data() + old_size),
+              n * sizeof(T));
+    AssertThrow(in, ExcIO());
+  }
+
+
+
+  /**
+   * Read a single value of type T from the binary input stream @p in.
+   */
+  template <typename T>
+  T
+  read_binary_value(std::istream &in)
+  {
+    T value;
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    AssertThrow(in, ExcIO());
+    return value;
+  }
+
+
+
+  /**
+   * Return the number of nodes of the Gmsh element type @p cell_type, or
+   * numbers::invalid_unsigned_int for the types that deal.II cannot read.
+   */
+  unsigned int
+  n_nodes_of_gmsh_element(const int cell_type)
+  {
+    switch (cell_type)
+      {
+        case 1:
+          return 2;
+        case 3:
+          return 4;
+        case 5:
+          return 8;
+        case 15:
+          return 1;
+        default:
+          return numbers::invalid_unsigned_int;
+      }
+  }
+} // namespace
+
+
+
+template <int dim, int spacedim>
+void
+GridIn<dim, spacedim>::read_msh_binary(std::istream &in)
+{
+  std::string line;
+
+  // the header is followed by the integer 1 written in binary, which tells
+  // us whether the file was written with the same endianness
+  in.get();
+  AssertThrow(read_binary_value<int>(in) == 1,
+              ExcMessage("The binary msh file was written on a machine with "
+                         "a different endianness, which is not supported."));
+  in >> line;
+  AssertThrow(line == "$EndMeshFormat", ExcInvalidGMSHInput(line));
+
+  // the maps from the entities of each dimension to their physical tags,
+  // as in read_msh()
+  std::array<std::map<int, int>, 4> tag_maps;
+
+  in >> line;
+  if (line == "$PhysicalNames")
+    {
+      do
+        {
+          in >> line;
+        }
+      while (line != "$EndPhysicalNames");
+      in >> line;
+    }
+
+  if (line == "$Entities")
+    {
+      in.get();
+      std::vector<std::size_t> n_entities;
+      read_binary_values(in, 4, n_entities);
+      for (unsigned int d = 0; d < 4; ++d)
+        for (std::size_t i = 0; i < n_entities[d]; ++i)
+          {
+            const int tag = read_binary_value<int>(in);
+            // points only store their location, all other entities their
+            // bounding box
+            std::vector<double> box;
+            read_binary_values(in, d == 0 ? 3 : 6, box);
+
+            const std::size_t n_physicals = read_binary_value<std::size_t>(in);
+            AssertThrow(n_physicals < 2,
+                        ExcMessage("More than one tag is not supported!"));
+            std::vector<int> physical_tags;
+            read_binary_values(in, n_physicals, physical_tags);
+            tag_maps[d][tag] = n_physicals > 0 ? physical_tags[0] : 0;
+
+            // skip the entities bounding this one
+            if (d > 0)
+              {
+                std::vector<int> bounding_tags;
+                read_binary_values(in,
+                                   read_binary_value<std::size_t>(in),
+                                   bounding_tags);
+              }
+          }
+      in >> line;
+      AssertThrow(line == "$EndEntities", ExcInvalidGMSHInput(line));
+      in >> line;
+    }
+
+  if (line == "$PartitionedEntities")
+    {
+      do
+        {
+          in >> line;
+        }
+      while (line != "$EndPartitionedEntities");
+      in >> line;
+    }
+
+  AssertThrow(line == "$Nodes", ExcInvalidGMSHInput(line));
+
+  // read the nodes, block by block. if the node tags form a reasonably
+  // dense range, as is the case for all meshes written by Gmsh itself, we
+  // translate them into vertex indices through a vector, otherwise through
+  // a map
+  in.get();
+  std::vector<std::size_t> nodes_header;
+  read_binary_values(in, 4, nodes_header);
+  const std::size_t n_vertices   = nodes_header[1];
+  const std::size_t min_node_tag = nodes_header[2];
+  const std::size_t max_node_tag = nodes_header[3];
+
+  std::vector<Point<spacedim>>        vertices(n_vertices);
+  std::vector<unsigned int>           tag_to_vertex;
+  std::map<std::size_t, unsigned int> sparse_tag_to_vertex;
+
+  const bool use_dense_tags =
+    n_vertices > 0 && max_node_tag - min_node_tag < 2 * n_vertices + 1024;
+  if (use_dense_tags)
+    tag_to_vertex.resize(max_node_tag - min_node_tag + 1,
+                         numbers::invalid_unsigned_int);
+
+  {
+    std::vector<std::size_t> node_tags;
+    std::vector<double>      coordinates;
+    unsigned int             global_vertex = 0;
+    for (std::size_t block = 0; block < nodes_header[0]; ++block)
+      {
+        std::vector<int> block_header;
+        read_binary_values(in, 3, block_header);
+        const std::size_t n_nodes = read_binary_value<std::size_t>(in);
+
+        // parametric nodes store one parametric coordinate per dimension of
+        // their entity after their location, which we ignore
+        const unsigned int n_values_per_node =
+          3 + (block_header[2] != 0 ? block_header[0] : 0);
+
+        node_tags.clear();
+        coordinates.clear();
+        read_binary_values(in, n_nodes, node_tags);
+        read_binary_values(in, n_nodes * n_values_per_node, coordinates);
+        AssertThrow(global_vertex + n_nodes <= n_vertices,
+                    ExcInvalidGMSHInput("$Nodes"));
+
+        for (std::size_t i = 0; i < n_nodes; ++i)
+          {
+            for (unsigned int d = 0; d < spacedim; ++d)
+              vertices[global_vertex + i](d) =
+                coordinates[i * n_values_per_node + d];
+
+            AssertThrow(node_tags[i] >= min_node_tag &&
+                          node_tags[i] <= max_node_tag,
+                        ExcInvalidGMSHInput("$Nodes"));
+            if (use_dense_tags)
+              tag_to_vertex[node_tags[i] - min_node_tag] = global_vertex + i;
+            else
+              sparse_tag_to_vertex[node_tags[i]] = global_vertex + i;
+          }
+        global_vertex += n_nodes;
+      }
+    AssertDimension(global_vertex, n_vertices);
+  }
+
+  in >> line;
+  AssertThrow(line == "$EndNodes", ExcInvalidGMSHInput(line));
+  in >> line;
+  AssertThrow(line == "$Elements", ExcInvalidGMSHInput(line));
+
+  // return the index of the vertex with the given tag. this function is
+  // called concurrently below, so it must not modify the maps
+  const auto vertex_index = [&](const std::size_t tag) {
+    unsigned int index = numbers::invalid_unsigned_int;
+    if (use_dense_tags)
+      {
+        if (tag >= min_node_tag && tag <= max_node_tag)
+          index = tag_to_vertex[tag - min_node_tag];
+      }
+    else
+      {
+        const auto entry = sparse_tag_to_vertex.find(tag);
+        if (entry != sparse_tag_to_vertex.end())
+          index = entry->second;
+      }
+    AssertThrow(index != numbers::invalid_unsigned_int,
+                ExcInvalidVertexIndex(0, tag));
+    return index;
+  };
+
+  // read the elements, block by block. since all elements of a block have
+  // the same type and physical tag, we read each block at once and then
+  // translate its node tags into the corresponding objects in parallel
+  in.get();
+  std::vector<std::size_t> elements_header;
+  read_binary_values(in, 4, elements_header);
+
+  std::vector<CellData<dim>>                 cells;
+  SubCellData                                subcelldata;
+  std::map<unsigned int, types::boundary_id> boundary_ids_1d;
+
+  {
+    std::vector<std::size_t> element_data;
+    std::size_t              global_cell = 0;
+    for (std::size_t block = 0; block < elements_header[0]; ++block)
+      {
+        std::vector<int> block_header;
+        read_binary_values(in, 3, block_header);
+        const std::size_t n_elements = read_binary_value<std::size_t>(in);
+
+        AssertIndexRange(block_header[0], 4);
+        const int          cell_type = block_header[2];
+        const unsigned int n_nodes   = n_nodes_of_gmsh_element(cell_type);
+        if (n_nodes == numbers::invalid_unsigned_int)
+          {
+            AssertThrow(cell_type != 2,
+                        ExcMessage("Found triangles while reading a file "
+                                   "in gmsh format. deal.II does not "
+                                   "support triangles"));
+            AssertThrow(cell_type != 4 && cell_type != 11,
+                        ExcMessage("Found tetrahedra while reading a file "
+                                   "in gmsh format. deal.II does not "
+                                   "support tetrahedra"));
+            AssertThrow(false, ExcGmshUnsupportedGeometry(cell_type));
+          }
+        const unsigned int material_id =
+          tag_maps[block_header[0]][block_header[1]];
+
+        // each element is given by its tag, which we ignore, followed by
+        // the tags of its nodes
+        element_data.clear();
+        read_binary_values(in, n_elements * (1 + n_nodes), element_data);
+        global_cell += n_elements;
+
+        const auto read_objects = [&](auto &objects) {
+          const std::size_t offset = objects.size();
+          objects.resize(offset + n_elements);
+          parallel::apply_to_subranges(
+            std::size_t(0),
+            n_elements,
+            [&](const std::size_t begin, const std::size_t end) {
+              for (std::size_t i = begin; i < end; ++i)
+                for (unsigned int v = 0; v < n_nodes; ++v)
+                  objects[offset + i].vertices[v] =
+                    vertex_index(element_data[i * (1 + n_nodes) + 1 + v]);
+            },
+            1000);
+        };
+
+        if ((cell_type == 1 && dim == 1) || (cell_type == 3 && dim == 2) ||
+            (cell_type == 5 && dim == 3))
+          {
+            Assert(material_id < numbers::invalid_material_id,
+                   ExcIndexRange(material_id,
+                                 0,
+                                 numbers::invalid_material_id));
+            const std::size_t offset = cells.size();
+            read_objects(cells);
+            for (std::size_t i = offset; i < cells.size(); ++i)
+              cells[i].material_id =
+                static_cast<types::material_id>(material_id);
+          }
+        else if (cell_type == 1 && (dim == 2 || dim == 3))
+          {
+            Assert(material_id < numbers::internal_face_boundary_id,
+                   ExcIndexRange(material_id,
+                                 0,
+                                 numbers::internal_face_boundary_id));
+            const std::size_t offset = subcelldata.boundary_lines.size();
+            read_objects(subcelldata.boundary_lines);
+            for (std::size_t i = offset; i < subcelldata.boundary_lines.size();
+                 ++i)
+              subcelldata.boundary_lines[i].boundary_id =
+                static_cast<types::boundary_id>(material_id);
+          }
+        else if (cell_type == 3 && dim == 3)
+          {
+            Assert(material_id < numbers::internal_face_boundary_id,
+                   ExcIndexRange(material_id,
+                                 0,
+                                 numbers::internal_face_boundary_id));
+            const std::size_t offset = subcelldata.boundary_quads.size();
+            read_objects(subcelldata.boundary_quads);
+            for (std::size_t i = offset; i < subcelldata.boundary_quads.size();
+                 ++i)
+              subcelldata.boundary_quads[i].boundary_id =
+                static_cast<types::boundary_id>(material_id);
+          }
+        else if (cell_type == 15)
+          {
+            // we only care about boundary indicators assigned to individual
+            // vertices in 1d (because otherwise the vertices are not faces)
+            if (dim == 1)
+              for (std::size_t i = 0; i < n_elements; ++i)
+                boundary_ids_1d[vertex_index(element_data[2 * i + 1])] =
+                  material_id;
+          }
+        else
+          AssertThrow(false, ExcGmshUnsupportedGeometry(cell_type));
+      }
+    AssertThrow(global_cell == elements_header[1],
+                ExcInvalidGMSHInput("$Elements"));
+  }
+
+  in >> line;
+  AssertThrow(line == "$EndElements", ExcInvalidGMSHInput(line));
+
+  // check that no forbidden arrays are used
+  Assert(subcelldata.check_consistency(dim), ExcInternalError());
+
+  AssertThrow(in, ExcIO());
+  AssertThrow(cells.size() > 0, ExcGmshNoCellInformation());
+
+  // do the same clean-up as read_msh()
+  GridTools::delete_unused_vertices(vertices, cells, subcelldata);
+  if (dim == spacedim)
+    GridReordering<dim, spacedim>::invert_all_cells_of_negative_grid(vertices,
+                                                                     cells);
+  GridReordering<dim, spacedim>::reorder_cells(cells);
+  tria->create_triangulation_compatibility(vertices, cells, subcelldata);
+
+  if (dim == 1)
+    assign_1d_boundary_ids(boundary_ids_1d, *tria);
+}
+
+
 
 template <>
 void
@@ -32,10 +32,88 @@
 #include <fstream>
 #include <functional>
 #include <numeric>
+#include <tuple>
 
 DEAL_II_NAMESPACE_OPEN
 
 
+namespace
+{
+  /**
+   * Consider the entries of @p values in the order given by @p comp (i.e.,
+   * in descending order for std::greater), and determine how many of the
+   * leading ones have to be summed up until the sum reaches @p target, but
+   * at most values.size()-1. Return this number n along with the n-th and
+   * the (n-1)-st entry in this order, the latter only being meaningful if
+   * n>0.
+   *
+   * The result is the one we would get by summing up the sorted values. We
+   * only sort as much as necessary, though: the range that contains the n-th
+   * entry is repeatedly split with std::nth_element(), and we sum up its part
+   * in front of the pivot, which takes linear time on average. Only the
+   * final short range gets sorted. The order of @p values is changed.
+   */
+  template <typename Number, typename Compare>
+  std::tuple<unsigned int, Number, Number>
+  find_accumulation_point(Vector<Number> &values,
+                          const double    target,
+                          const Compare & comp)
+  {
+    const unsigned int n = values.size();
+    Assert(n > 0, ExcInternalError());
+
+    // the entries in front of 'begin' come first in the order given by
+    // comp, and their sum is 'sum_before', while the ones starting at 'end'
+    // come after the entries within [begin,end)
+    unsigned int begin = 0, end = n;
+    double       sum_before  = 0;
+    Number       last_before = Number();
+
+    const unsigned int max_sort_size = 64;
+    while (end - begin > max_sort_size)
+      {
+        const unsigned int mid = begin + (end - begin) / 2;
+        std::nth_element(values.begin() + begin,
+                         values.begin() + mid,
+                         values.begin() + end,
+                         comp);
+
+        double sum  = sum_before;
+        Number last = values[begin];
+        for (unsigned int i = begin; i < mid; ++i)
+          {
+            sum += values[i];
+            if (comp(last, values[i]))
+              last = values[i];
+          }
+
+        if (sum < target)
+          {
+            begin       = mid;
+            sum_before  = sum;
+            last_before = last;
+          }
+        else
+          end = mid + 1;
+      }
+
+    std::sort(values.begin() + begin, values.begin() + end, comp);
+
+    unsigned int position = begin;
+    for (double sum = sum_before; (sum < target) && (position != n - 1);
+         ++position)
+      sum += values[position];
+    Assert(position < end, ExcInternalError());
+
+    return std::make_tuple(position,
+                           values[position],
+                           position > begin ? values[position - 1] :
+                                              last_before);
+  }
+} // namespace
+
+
+
 template <int dim, typename Number, int spacedim>
 void
 GridRefinement::refine(Triangulation<dim, spacedim> &tria,
@@ -286,23 +364,25 @@ GridRefinement::refine_and_coarsen_fixed_fraction(
   tmp                      = criteria;
   const double total_error = tmp.l1_norm();
 
-  // sort the largest criteria to the
-  // beginning of the vector
-  std::sort(tmp.begin(), tmp.end(), std::greater<double>());
-
-  // compute thresholds
-  typename Vector<Number>::const_iterator pp = tmp.begin();
-  for (double sum = 0;
-       (sum < top_fraction * total_error) && (pp != (tmp.end() - 1));
-       ++pp)
-    sum += *pp;
-  double top_threshold = (pp != tmp.begin() ? (*pp + *(pp - 1)) / 2 : *pp);
-  typename Vector<Number>::const_iterator qq = (tmp.end() - 1);
-  for (double sum = 0;
-       (sum < bottom_fraction * total_error) && (qq != tmp.begin());
-       --qq)
-    sum += *qq;
-  double bottom_threshold = (qq != (tmp.end() - 1) ? (*qq + *(qq + 1)) / 2 : 0);
+  // compute thresholds. rather than sorting
+  // the whole vector, only determine how many
+  // of the largest (smallest) criteria are
+  // needed to reach the respective fraction
+  // of the total error
+  const auto top =
+    find_accumulation_point(tmp, top_fraction * total_error, std::greater<>());
+  const unsigned int refine_cells = std::get<0>(top);
+  double             top_threshold =
+    (refine_cells > 0 ? (std::get<1>(top) + std::get<2>(top)) / 2 :
+                        std::get<1>(top));
+
+  const auto bottom = find_accumulation_point(tmp,
+                                              bottom_fraction * total_error,
+                                              std::less<>());
+  const unsigned int coarsen_cells = std::get<0>(bottom) + 1;
+  double             bottom_threshold =
+    (std::get<0>(bottom) > 0 ? (std::get<1>(bottom) + std::get<2>(bottom)) / 2 :
+                               0);
 
   // we now have an idea how many cells we
   // are going to refine and coarsen. we use
@@ -317,9 +397,6 @@ GridRefinement::refine_and_coarsen_fixed_fraction(
   // isotropic refinement as guess for a mixed
   // refinemnt as well.
   {
-    const unsigned int refine_cells  = pp - tmp.begin(),
-                       coarsen_cells = tmp.end() - qq;
-
     if (static_cast<unsigned int>(
           tria.n_active_cells() +
           refine_cells * (GeometryInfo<dim>::max_children_per_cell - 1) -
@@ -377,7 +454,7 @@ GridRefinement::refine_and_coarsen_fixed_fraction(
 
   // actually flag cells
   if (top_threshold < *minmax_element.second)
-    refine(tria, criteria, top_threshold, pp - tmp.begin());
+    refine(tria, criteria, top_threshold, refine_cells);
 
   if (bottom_threshold > *minmax_element.first)
     coarsen(tria, criteria, bottom_threshold);
@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/timer.h>
 #include <deal.II/base/utilities.h>
 
@@ -21,10 +22,10 @@
 #include <deal.II/grid/grid_tools.h>
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <functional>
 #include <iostream>
-#include <set>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -32,80 +33,135 @@ DEAL_II_NAMESPACE_OPEN
 namespace
 {
   /**
-   * A simple data structure denoting an edge, i.e., the ordered pair
-   * of its vertex indices. This is only used in the is_consistent()
-   * function.
+   * A data structure that groups the edges of all cells of a mesh by
+   * the smaller of their two vertex indices. It corresponds to a hash
+   * table of edges whose hash function is this vertex index, and so
+   * allows to find all instances of an edge in linear time and without
+   * the logarithmic lookups and many small allocations of a std::set.
    */
-  struct CheapEdge
+  struct EdgeBuckets
   {
     /**
-     * Construct an edge from the global indices of its two vertices.
+     * The range of the entries of the edges whose smaller vertex index is
+     * v is given by <code>bucket_starts[v]</code> and
+     * <code>bucket_starts[v+1]</code>.
      */
-    CheapEdge(const unsigned int v0, const unsigned int v1)
-      : v0(v0)
-      , v1(v1)
-    {}
+    std::vector<unsigned int> bucket_starts;
 
     /**
-     * Comparison operator for edges. It compares based on the
-     * lexicographic ordering of the two vertex indices.
+     * For each edge of each cell, the larger of its two vertex indices and
+     * the index <code>cell*lines_per_cell+line</code> of the edge within
+     * the list of all edges of all cells. Within each bucket, the entries
+     * are sorted lexicographically.
      */
-    bool
-    operator<(const CheapEdge &e) const
-    {
-      return ((v0 < e.v0) || ((v0 == e.v0) && (v1 < e.v1)));
-    }
-
-  private:
-    /**
-     * The global indices of the vertices that define the edge.
-     */
-    const unsigned int v0, v1;
+    std::vector<std::pair<unsigned int, unsigned int>> entries;
   };
 
 
+
+  /**
+   * Sort the edges of all cells of the given list into buckets as described
+   * in the documentation of EdgeBuckets. The buckets are sorted in
+   * parallel.
+   */
+  template <int dim>
+  EdgeBuckets
+  build_edge_buckets(const std::vector<CellData<dim>> &cells)
+  {
+    unsigned int n_vertices = 0;
+    for (const auto &cell : cells)
+      for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+        n_vertices = std::max(n_vertices, cell.vertices[v] + 1);
+
+    // count the edges in each bucket, then compute the start of each
+    // bucket and fill it
+    EdgeBuckets buckets;
+    buckets.bucket_starts.resize(n_vertices + 1, 0);
+    for (const auto &cell : cells)
+      for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
+        ++buckets.bucket_starts[std::min(
+            cell.vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 0)],
+            cell.vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 1)]) +
+          1];
+    for (unsigned int v = 0; v < n_vertices; ++v)
+      buckets.bucket_starts[v + 1] += buckets.bucket_starts[v];
+
+    buckets.entries.resize(cells.size() * GeometryInfo<dim>::lines_per_cell);
+    std::vector<unsigned int> next_entry(buckets.bucket_starts.begin(),
+                                         buckets.bucket_starts.end() - 1);
+    for (unsigned int c = 0; c < cells.size(); ++c)
+      for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
+        {
+          const unsigned int v0 =
+            cells[c].vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 0)];
+          const unsigned int v1 =
+            cells[c].vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 1)];
+          buckets.entries[next_entry[std::min(v0, v1)]++] = {
+            std::max(v0, v1), c * GeometryInfo<dim>::lines_per_cell + l};
+        }
+
+    // each bucket only holds the few edges around one vertex, so sorting
+    // them is cheap. do so in parallel
+    parallel::apply_to_subranges(
+      0U,
+      n_vertices,
+      [&buckets](const unsigned int begin, const unsigned int end) {
+        for (unsigned int v = begin; v < end; ++v)
+          std::sort(buckets.entries.begin() + buckets.bucket_starts[v],
+                    buckets.entries.begin() + buckets.bucket_starts[v + 1]);
+      },
+      1000);
+
+    return buckets;
+  }
+
+
   /**
    * A function that determines whether the edges in a mesh are
-   * already consistently oriented. It does so by adding all edges
-   * of all cells into a set (which automatically eliminates
-   * duplicates) but before that checks whether the reverse edge is
-   * already in the set -- which would imply that a neighboring cell
-   * is inconsistently oriented.
+   * already consistently oriented. It does so by grouping all
+   * instances of each edge, and checking whether an edge is used
+   * by one cell in one direction but in the reverse direction by
+   * another (or the same) cell -- which would imply that a
+   * neighboring cell is inconsistently oriented.
    */
   template <int dim>
   bool
   is_consistent(const std::vector<CellData<dim>> &cells)
   {
-    std::set<CheapEdge> edges;
-
-    for (typename std::vector<CellData<dim>>::const_iterator c = cells.begin();
-         c != cells.end();
-         ++c)
-      {
-        // construct the edges in reverse order. for each of them,
-        // ensure that the reverse edge is not yet in the list of
-        // edges (return false if the reverse edge already *is* in
-        // the list) and then add the actual edge to it; std::set
-        // eliminates duplicates automatically
-        for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
-          {
-            const CheapEdge reverse_edge(
-              c->vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 1)],
-              c->vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 0)]);
-            if (edges.find(reverse_edge) != edges.end())
-              return false;
-
-
-            // ok, not. insert edge in correct order
-            const CheapEdge correct_edge(
-              c->vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 0)],
-              c->vertices[GeometryInfo<dim>::line_to_cell_vertices(l, 1)]);
-            edges.insert(correct_edge);
-          }
-      }
+    const EdgeBuckets buckets = build_edge_buckets(cells);
+
+    // for an instance of an edge given by its entry in a bucket, return
+    // whether it goes from the smaller to the larger vertex index
+    const auto points_upward =
+      [&cells](const std::pair<unsigned int, unsigned int> &entry) {
+        const unsigned int c = entry.second / GeometryInfo<dim>::lines_per_cell;
+        const unsigned int l = entry.second % GeometryInfo<dim>::lines_per_cell;
+        return cells[c].vertices[GeometryInfo<dim>::line_to_cell_vertices(
+                 l, 1)] == entry.first;
+      };
+
+    // within each bucket, the instances of the same edge are adjacent. check
+    // that all of them point in the same direction
+    std::atomic<bool> consistent(true);
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(buckets.bucket_starts.size() - 1),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int v = begin; v < end && consistent; ++v)
+          for (unsigned int e = buckets.bucket_starts[v] + 1;
+               e < buckets.bucket_starts[v + 1];
+               ++e)
+            if (buckets.entries[e].first == buckets.entries[e - 1].first &&
+                points_upward(buckets.entries[e]) !=
+                  points_upward(buckets.entries[e - 1]))
+              {
+                consistent = false;
+                break;
+              }
+      },
+      1000);
 
-    // no conflicts found, so return true
-    return true;
+    return consistent;
   }
 
 
@@ -300,6 +356,16 @@ namespace
   class Edge
   {
   public:
+    /**
+     * Default constructor. Create an unoriented edge with invalid
+     * vertex indices.
+     */
+    Edge()
+      : orientation_status(not_oriented)
+    {
+      vertex_indices[0] = vertex_indices[1] = numbers::invalid_unsigned_int;
+    }
+
     /**
      * Constructor. Create the edge based on the information given
      * in @p cell, and selecting the edge with number @p edge_number
@@ -380,26 +446,17 @@ namespace
   struct Cell
   {
     /**
-     * Construct a Cell object from a CellData object. Also take a
-     * (sorted) list of edges and to point the edges of the current
-     * object into this list of edges.
+     * Construct a Cell object from a CellData object. Also take the
+     * indices of the edges of the current object in the (sorted) list
+     * of edges of the mesh.
      */
-    Cell(const CellData<dim> &c, const std::vector<Edge<dim>> &edge_list)
+    Cell(const CellData<dim> &c, const unsigned int *edges_of_cell)
     {
       for (unsigned int i = 0; i < GeometryInfo<dim>::vertices_per_cell; ++i)
         vertex_indices[i] = c.vertices[i];
 
-      // now for each of the edges of this cell, find the location inside the
-      // given edge_list array and store than index
       for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
-        {
-          const Edge<dim> e(c, l);
-          edge_indices[l] =
-            (std::lower_bound(edge_list.begin(), edge_list.end(), e) -
-             edge_list.begin());
-          Assert(edge_indices[l] < edge_list.size(), ExcInternalError());
-          Assert(edge_list[edge_indices[l]] == e, ExcInternalError())
-        }
+        edge_indices[l] = edges_of_cell[l];
     }
 
     /**
@@ -408,8 +465,8 @@ namespace
     unsigned int vertex_indices[GeometryInfo<dim>::vertices_per_cell];
 
     /**
-     * A list of indices into the 'edge_list' array passed to the constructor
-     * for the edges of the current cell.
+     * A list of indices into the list of edges of the mesh for the edges of
+     * the current cell.
      */
     unsigned int edge_indices[GeometryInfo<dim>::lines_per_cell];
   };
@@ -517,38 +574,88 @@ namespace
    *
    * In 3d, this set can have arbitrarily many elements, unlike the
    * 2d case specialized above. Consequently, we simply represent
-   * the data structure with a std::set. Class derivation ensures
-   * that we simply inherit all of the member functions of the
-   * base class.
+   * the data structure with a std::vector. We never insert an edge
+   * twice because edges are only added when they are first oriented,
+   * so the vector does not need to eliminate duplicates the way a
+   * std::set would. Class derivation ensures that we simply inherit
+   * all of the member functions of the base class.
    */
   template <>
-  class EdgeDeltaSet<3> : public std::set<unsigned int>
-  {};
+  class EdgeDeltaSet<3> : public std::vector<unsigned int>
+  {
+  public:
+    /**
+     * Insert one element into the set.
+     */
+    void
+    insert(const unsigned int edge_index)
+    {
+      push_back(edge_index);
+    }
+  };
 
 
 
   /**
    * From a list of cells, build a sorted vector that contains all of the edges
-   * that exist in the mesh.
+   * that exist in the mesh. For each edge of each cell, also store the index
+   * of the edge within this vector in @p edges_of_cells, at position
+   * <code>cell*lines_per_cell+line</code>.
    */
   template <int dim>
   std::vector<Edge<dim>>
-  build_edges(const std::vector<CellData<dim>> &cells)
+  build_edges(const std::vector<CellData<dim>> &cells,
+              std::vector<unsigned int> &       edges_of_cells)
   {
-    // build the edge list for all cells. because each cell has
-    // GeometryInfo<dim>::lines_per_cell edges, the total number
-    // of edges is this many times the number of cells. of course
-    // some of them will be duplicates, and we throw them out below
-    std::vector<Edge<dim>> edge_list;
-    edge_list.reserve(cells.size() * GeometryInfo<dim>::lines_per_cell);
-    for (unsigned int i = 0; i < cells.size(); ++i)
-      for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell; ++l)
-        edge_list.emplace_back(cells[i], l);
-
-    // next sort the edge list and then remove duplicates
-    std::sort(edge_list.begin(), edge_list.end());
-    edge_list.erase(std::unique(edge_list.begin(), edge_list.end()),
-                    edge_list.end());
+    const EdgeBuckets buckets = build_edge_buckets(cells);
+    const unsigned int n_buckets =
+      static_cast<unsigned int>(buckets.bucket_starts.size() - 1);
+
+    // the instances of each edge are adjacent within their bucket, and the
+    // edges are sorted lexicographically if we go through the buckets in
+    // order. first count the distinct edges of each bucket to compute the
+    // index of its first edge in the list of all edges
+    std::vector<unsigned int> first_edge_of_bucket(n_buckets + 1, 0);
+    parallel::apply_to_subranges(
+      0U,
+      n_buckets,
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int v = begin; v < end; ++v)
+          for (unsigned int e = buckets.bucket_starts[v];
+               e < buckets.bucket_starts[v + 1];
+               ++e)
+            if (e == buckets.bucket_starts[v] ||
+                buckets.entries[e].first != buckets.entries[e - 1].first)
+              ++first_edge_of_bucket[v + 1];
+      },
+      1000);
+    for (unsigned int v = 0; v < n_buckets; ++v)
+      first_edge_of_bucket[v + 1] += first_edge_of_bucket[v];
+
+    // then create the edges and let the cells know about them
+    std::vector<Edge<dim>> edge_list(first_edge_of_bucket.back());
+    edges_of_cells.resize(cells.size() * GeometryInfo<dim>::lines_per_cell);
+    parallel::apply_to_subranges(
+      0U,
+      n_buckets,
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int v = begin; v < end; ++v)
+          {
+            unsigned int edge = first_edge_of_bucket[v];
+            for (unsigned int e = buckets.bucket_starts[v];
+                 e < buckets.bucket_starts[v + 1];
+                 ++e)
+              {
+                if (e != buckets.bucket_starts[v] &&
+                    buckets.entries[e].first != buckets.entries[e - 1].first)
+                  ++edge;
+                edge_list[edge].vertex_indices[0] = v;
+                edge_list[edge].vertex_indices[1] = buckets.entries[e].first;
+                edges_of_cells[buckets.entries[e].second] = edge;
+              }
+          }
+      },
+      1000);
 
     return edge_list;
   }
@@ -562,6 +669,7 @@ namespace
   template <int dim>
   std::vector<Cell<dim>>
   build_cells_and_connect_edges(const std::vector<CellData<dim>> &cells,
+                                const std::vector<unsigned int> & edges_of_cells,
                                 std::vector<Edge<dim>> &          edges)
   {
     std::vector<Cell<dim>> cell_list;
@@ -570,7 +678,8 @@ namespace
       {
         // create our own data structure for the cells and let it
         // connect to the edges array
-        cell_list.emplace_back(cells[i], edges);
+        cell_list.emplace_back(
+          cells[i], &edges_of_cells[i * GeometryInfo<dim>::lines_per_cell]);
 
         // then also inform the edges that they are adjacent
         // to the current cell, and where within this cell
@@ -786,10 +895,10 @@ namespace
               }
           }
 
-        // finally copy the new set to the previous one
+        // finally move the new set to the previous one
         // (corresponding to increasing 'k' by one in the
         // algorithm)
-        Delta_k_minus_1 = Delta_k;
+        std::swap(Delta_k_minus_1, Delta_k);
       }
   }
 
@@ -953,9 +1062,10 @@ namespace
   {
     // first build the arrays that connect cells to edges and the other
     // way around
-    std::vector<Edge<dim>> edge_list = build_edges(cells);
-    std::vector<Cell<dim>> cell_list =
-      build_cells_and_connect_edges(cells, edge_list);
+    std::vector<unsigned int> edges_of_cells;
+    std::vector<Edge<dim>>    edge_list = build_edges(cells, edges_of_cells);
+    std::vector<Cell<dim>>    cell_list =
+      build_cells_and_connect_edges(cells, edges_of_cells, edge_list);
 
     // then loop over all cells and start orienting parallel edge sets
     // of cells that still have non-oriented edges
@@ -996,9 +1106,16 @@ namespace
 
     // now that we have oriented all edges, we need to rotate cells
     // so that the edges point in the right direction with the now
-    // rotated coordinate system
-    for (unsigned int c = 0; c < cells.size(); ++c)
-      rotate_cell(cell_list, edge_list, c, cells);
+    // rotated coordinate system. each cell is rotated independently of
+    // all others, so do this in parallel
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(cells.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int c = begin; c < end; ++c)
+          rotate_cell(cell_list, edge_list, c, cells);
+      },
+      1000);
   }
 
 
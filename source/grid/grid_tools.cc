@@ -15,6 +15,7 @@
 
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi.templates.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/thread_management.h>
 
@@ -56,8 +57,10 @@
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_real_distribution.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <list>
 #include <numeric>
@@ -4684,6 +4687,225 @@ namespace GridTools
 
 
 
+  template <int dim, int spacedim>
+#ifndef DOXYGEN
+  std::tuple<
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>,
+    std::vector<std::vector<Point<dim>>>,
+    std::vector<std::vector<unsigned int>>,
+    std::vector<unsigned int>>
+#else
+  return_type
+#endif
+  compute_point_locations_batched(const Cache<dim, spacedim> &        cache,
+                                  const std::vector<Point<spacedim>> &points)
+  {
+    using active_cell_iterator =
+      typename Triangulation<dim, spacedim>::active_cell_iterator;
+    using BoxAndCell = std::pair<BoundingBox<spacedim>, active_cell_iterator>;
+
+    const unsigned int np = points.size();
+
+    std::vector<active_cell_iterator>      cells_out;
+    std::vector<std::vector<Point<dim>>>   qpoints_out;
+    std::vector<std::vector<unsigned int>> maps_out;
+    std::vector<unsigned int>              missing_points_out;
+
+    if (np == 0)
+      return std::make_tuple(std::move(cells_out),
+                             std::move(qpoints_out),
+                             std::move(maps_out),
+                             std::move(missing_points_out));
+
+    // Build the tree before spawning tasks, since the cache is not
+    // thread-safe
+    const auto &b_tree = cache.get_cell_bounding_boxes_rtree();
+    const Mapping<dim, spacedim> &mapping = cache.get_mapping();
+
+    // Sort the points along the Morton curve through the bounding box of
+    // all points, interleaving the bits of the quantized coordinates. With
+    // 21 bits per direction the key fits into 64 bits also in 3D.
+    Point<spacedim> lower = points[0], upper = points[0];
+    for (const auto &p : points)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          lower[d] = std::min(lower[d], p[d]);
+          upper[d] = std::max(upper[d], p[d]);
+        }
+    const unsigned int n_bits  = 21;
+    const double       max_key = (1U << n_bits) - 1;
+
+    std::vector<std::pair<std::uint64_t, unsigned int>> sorted_points(np);
+    for (unsigned int i = 0; i < np; ++i)
+      {
+        std::uint64_t key = 0;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            const double        extent     = upper[d] - lower[d];
+            const std::uint64_t coordinate = static_cast<std::uint64_t>(
+              extent > 0. ? (points[i][d] - lower[d]) / extent * max_key : 0.);
+            for (unsigned int b = 0; b < n_bits; ++b)
+              key |= ((coordinate >> b) & 1U) << (b * spacedim + d);
+          }
+        sorted_points[i] = std::make_pair(key, i);
+      }
+    std::sort(sorted_points.begin(), sorted_points.end());
+
+    // The cell and reference location found for each point. Each entry is
+    // written by exactly one task.
+    std::vector<active_cell_iterator> point_cells(np);
+    std::vector<Point<dim>>           point_unit_locations(np);
+
+    // Search the cells whose bounding box contains the point with index
+    // @p index and return the position of the cell found in @p box_cell, or
+    // -1 if the point is in none of them. As in
+    // find_active_cell_around_point(), a cell where the point is outside
+    // the reference cell by less than 1e-10 is accepted as a backup.
+    const auto locate_point = [&](const unsigned int       index,
+                                  std::vector<BoxAndCell> &box_cell) -> int {
+      box_cell.clear();
+      b_tree.query(boost::geometry::index::intersects(points[index]),
+                   std::back_inserter(box_cell));
+
+      int    best_candidate = -1;
+      double best_distance  = 1e-10;
+      for (unsigned int i = 0; i < box_cell.size(); ++i)
+        {
+          if (box_cell[i].second->is_artificial())
+            continue;
+          try
+            {
+              const Point<dim> p_unit =
+                mapping.transform_real_to_unit_cell(box_cell[i].second,
+                                                    points[index]);
+              if (GeometryInfo<dim>::is_inside_unit_cell(p_unit))
+                {
+                  point_cells[index]          = box_cell[i].second;
+                  point_unit_locations[index] = p_unit;
+                  return i;
+                }
+              const double dist =
+                GeometryInfo<dim>::distance_to_unit_cell(p_unit);
+              if (dist < best_distance)
+                {
+                  best_distance               = dist;
+                  best_candidate              = i;
+                  point_unit_locations[index] = p_unit;
+                }
+            }
+          catch (typename Mapping<dim, spacedim>::ExcTransformationFailed &)
+            {}
+        }
+      if (best_candidate != -1)
+        point_cells[index] = box_cell[best_candidate].second;
+      return best_candidate;
+    };
+
+    // Work on a chunk of the sorted points: locate a point with the tree,
+    // and then transform all subsequent points within the bounding box of
+    // the cell found at once, which succeeds for most of them as the points
+    // are sorted.
+    const auto locate_range = [&](const unsigned int begin,
+                                  const unsigned int end) {
+      std::vector<BoxAndCell>      box_cell;
+      std::vector<Point<spacedim>> batch_points;
+      std::vector<Point<dim>>      batch_unit_points;
+      std::vector<unsigned int>    batch_indices;
+
+      unsigned int i = begin;
+      while (i < end)
+        {
+          const int candidate = locate_point(sorted_points[i].second, box_cell);
+          ++i;
+          if (candidate == -1)
+            continue;
+
+          const BoundingBox<spacedim> box  = box_cell[candidate].first;
+          const active_cell_iterator  cell = box_cell[candidate].second;
+
+          batch_points.clear();
+          batch_indices.clear();
+          for (; i < end && box.point_inside(points[sorted_points[i].second]);
+               ++i)
+            {
+              batch_indices.push_back(sorted_points[i].second);
+              batch_points.push_back(points[sorted_points[i].second]);
+            }
+          if (batch_indices.empty())
+            continue;
+
+          batch_unit_points.resize(batch_points.size());
+          mapping.transform_points_real_to_unit_cell(cell,
+                                                     batch_points,
+                                                     batch_unit_points);
+          for (unsigned int j = 0; j < batch_indices.size(); ++j)
+            if (GeometryInfo<dim>::is_inside_unit_cell(batch_unit_points[j]))
+              {
+                point_cells[batch_indices[j]]          = cell;
+                point_unit_locations[batch_indices[j]] = batch_unit_points[j];
+              }
+            else
+              locate_point(batch_indices[j], box_cell);
+        }
+    };
+
+    parallel::apply_to_subranges(0U, np, locate_range, 512);
+
+    // Points outside the bounding boxes of all cells might still be inside
+    // curved cells, so try the slower search for them
+    for (unsigned int index = 0; index < np; ++index)
+      if (point_cells[index].state() != IteratorState::valid)
+        {
+          try
+            {
+              const auto cell_and_position =
+                GridTools::find_active_cell_around_point(cache, points[index]);
+              if (cell_and_position.first->is_artificial())
+                missing_points_out.push_back(index);
+              else
+                {
+                  point_cells[index]          = cell_and_position.first;
+                  point_unit_locations[index] = cell_and_position.second;
+                }
+            }
+          catch (const GridTools::ExcPointNotFound<spacedim> &)
+            {
+              missing_points_out.push_back(index);
+            }
+        }
+
+    // Group the points by cells in a deterministic order
+    std::vector<unsigned int> found_points;
+    found_points.reserve(np - missing_points_out.size());
+    for (unsigned int index = 0; index < np; ++index)
+      if (point_cells[index].state() == IteratorState::valid)
+        found_points.push_back(index);
+    std::stable_sort(found_points.begin(),
+                     found_points.end(),
+                     [&](const unsigned int a, const unsigned int b) {
+                       return point_cells[a] < point_cells[b];
+                     });
+
+    for (const unsigned int index : found_points)
+      {
+        if (cells_out.empty() || cells_out.back() != point_cells[index])
+          {
+            cells_out.push_back(point_cells[index]);
+            qpoints_out.emplace_back();
+            maps_out.emplace_back();
+          }
+        qpoints_out.back().push_back(point_unit_locations[index]);
+        maps_out.back().push_back(index);
+      }
+
+    return std::make_tuple(std::move(cells_out),
+                           std::move(qpoints_out),
+                           std::move(maps_out),
+                           std::move(missing_points_out));
+  }
+
+
+
   namespace internal
   {
     // Functions are needed for distributed compute point locations
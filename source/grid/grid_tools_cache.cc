@@ -15,6 +15,7 @@
 
 #include <deal.II/base/bounding_box.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/grid/filtered_iterator.h>
 #include <deal.II/grid/grid_tools.h>
@@ -32,18 +33,28 @@ namespace GridTools
     : update_flags(update_all)
     , tria(&tria)
     , mapping(&mapping)
+    , cell_list_is_current(false)
   {
-    tria_signal =
-      tria.signals.any_change.connect([&]() { mark_for_update(update_all); });
+    // Connect to the signals that make up the any_change signal, in order
+    // to distinguish changes of the connectivity from a movement of the
+    // vertices
+    const auto connectivity_changed = [&]() { mark_for_update(update_all); };
+    tria_signals.push_back(tria.signals.create.connect(connectivity_changed));
+    tria_signals.push_back(
+      tria.signals.post_refinement.connect(connectivity_changed));
+    tria_signals.push_back(tria.signals.clear.connect(connectivity_changed));
+    tria_signals.push_back(tria.signals.mesh_movement.connect(
+      [&]() { mark_for_update(update_vertex_locations); }));
   }
 
   template <int dim, int spacedim>
   Cache<dim, spacedim>::~Cache()
   {
-    // Make sure that the signals that was attached to the triangulation
-    // is removed here.
-    if (tria_signal.connected())
-      tria_signal.disconnect();
+    // Make sure that the signals that were attached to the triangulation
+    // are removed here.
+    for (auto &connection : tria_signals)
+      if (connection.connected())
+        connection.disconnect();
   }
 
 
@@ -53,6 +64,9 @@ namespace GridTools
   Cache<dim, spacedim>::mark_for_update(const CacheUpdateFlags &flags)
   {
     update_flags |= flags;
+    // The list of active cells is only kept if the connectivity is unchanged
+    if (flags & update_vertex_to_cell_map)
+      cell_list_is_current = false;
   }
 
 
@@ -114,6 +128,7 @@ namespace GridTools
         for (const auto &it : used_vertices)
           vertices[i++] = std::make_pair(it.second, it.first);
         used_vertices_rtree = pack_rtree(vertices);
+        update_flags        = update_flags & ~update_used_vertices_rtree;
       }
     return used_vertices_rtree;
   }
@@ -128,15 +143,31 @@ namespace GridTools
   {
     if (update_flags & update_cell_bounding_boxes_rtree)
       {
-        std::vector<std::pair<
-          BoundingBox<spacedim>,
-          typename Triangulation<dim, spacedim>::active_cell_iterator>>
-                     boxes(tria->n_active_cells());
-        unsigned int i = 0;
-        for (const auto &cell : tria->active_cell_iterators())
-          boxes[i++] = std::make_pair(mapping->get_bounding_box(cell), cell);
+        // The list of cells only needs to be collected again if the
+        // connectivity of the mesh has changed
+        if (!cell_list_is_current)
+          {
+            cell_bounding_boxes.resize(tria->n_active_cells());
+            unsigned int i = 0;
+            for (const auto &cell : tria->active_cell_iterators())
+              cell_bounding_boxes[i++].second = cell;
+            cell_list_is_current = true;
+          }
 
-        cell_bounding_boxes_rtree = pack_rtree(boxes);
+        // Evaluating the mapping dominates the construction of the tree for
+        // large meshes, so compute the boxes in parallel
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(cell_bounding_boxes.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int c = begin; c < end; ++c)
+              cell_bounding_boxes[c].first =
+                mapping->get_bounding_box(cell_bounding_boxes[c].second);
+          },
+          256);
+
+        cell_bounding_boxes_rtree = pack_rtree(cell_bounding_boxes);
+        update_flags = update_flags & ~update_cell_bounding_boxes_rtree;
       }
     return cell_bounding_boxes_rtree;
   }
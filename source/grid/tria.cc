@@ -16,6 +16,7 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/std_cxx14/memory.h>
 
 #include <deal.II/fe/mapping_q1.h>
@@ -23,6 +24,7 @@
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/magic_numbers.h>
 #include <deal.II/grid/manifold.h>
+#include <deal.II/grid/manifold_lib.h>
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_accessor.h>
 #include <deal.II/grid/tria_faces.h>
@@ -4236,7 +4238,8 @@ namespace internal
           &next_unused_line,
         typename Triangulation<2, spacedim>::raw_cell_iterator
           &                                                 next_unused_cell,
-        typename Triangulation<2, spacedim>::cell_iterator &cell)
+        typename Triangulation<2, spacedim>::cell_iterator &cell,
+        const Point<spacedim> &                             new_center)
       {
         const unsigned int dim = 2;
         // clear refinement flag
@@ -4363,47 +4366,12 @@ namespace internal
 
             new_vertices[8] = next_unused_vertex;
 
-            // if this quad lives
-            // in 2d, then we can
-            // compute the new
-            // central vertex
-            // location just from
-            // the surrounding
-            // ones. If this is
-            // not the case, then
-            // we need to ask a
-            // boundary object
-            if (dim == spacedim)
-              {
-                // triangulation.vertices[next_unused_vertex] = new_point;
-                triangulation.vertices[next_unused_vertex] = cell->center(true);
-
-                // if the user_flag is set, i.e. if the cell is at the
-                // boundary, use a different calculation of the middle vertex
-                // here. this is of advantage if the boundary is strongly
-                // curved (whereas the cell is not) and the cell has a high
-                // aspect ratio.
-                if (cell->user_flag_set())
-                  {
-                    // first reset the user_flag and then refine
-                    cell->clear_user_flag();
-                    triangulation.vertices[next_unused_vertex] =
-                      cell->center(true, true);
-                  }
-              }
-            else
-              {
-                // if this quad lives in a higher dimensional space
-                // then we don't need to worry if it is at the
-                // boundary of the manifold -- we always have to use
-                // the boundary object anyway; so ignore whether the
-                // user flag is set or not
-                cell->clear_user_flag();
-
-                // new vertex is placed on the surface according to
-                // the information stored in the boundary class
-                triangulation.vertices[next_unused_vertex] = cell->center(true);
-              }
+            // the location of the new central vertex has been computed by
+            // the calling function, see execute_refinement(). the user
+            // flag, which is set for cells at the boundary, is not needed
+            // any more
+            cell->clear_user_flag();
+            triangulation.vertices[next_unused_vertex] = new_center;
           }
 
 
@@ -4666,6 +4634,155 @@ namespace internal
 
 
 
+      /**
+       * Return the locations of the vertices to be created when refining
+       * the objects in @p objects, as given by @p compute_point for each of
+       * them.
+       *
+       * Evaluating the manifold descriptions is often the most expensive
+       * part of refinement, but it only depends on the vertices that exist
+       * before new objects are created. So the locations can be computed in
+       * parallel before the sequential loops that create the new objects.
+       */
+      template <int spacedim, typename Iterator, typename Function>
+      static std::vector<Point<spacedim>>
+      compute_new_vertex_locations(const std::vector<Iterator> &objects,
+                                   const Function &             compute_point)
+      {
+        std::vector<Point<spacedim>> points(objects.size());
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(objects.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int i = begin; i < end; ++i)
+              points[i] = compute_point(objects[i]);
+          },
+          32);
+        return points;
+      }
+
+
+
+      /**
+       * Return the midpoints of the lines in @p lines, which are about to be
+       * refined.
+       *
+       * For lines described by a TransfiniteInterpolationManifold, every
+       * single evaluation has to search the coarse cell the points lie in and
+       * to pull back the vertices into its chart. So the new points of all
+       * such lines of a refined cell are computed by a single call to
+       * Manifold::get_new_points() with the vertices of that cell as
+       * surrounding points, which does the search and the pull-backs only
+       * once for all of them. The midpoints of all other lines are computed
+       * one by one via TriaAccessor::center(). All evaluations are done in
+       * parallel.
+       */
+      template <int dim, int spacedim>
+      static std::vector<Point<spacedim>>
+      compute_line_midpoints(
+        const Triangulation<dim, spacedim> &triangulation,
+        const std::vector<
+          typename Triangulation<dim, spacedim>::active_line_iterator> &lines)
+      {
+        const unsigned int vertices_per_cell =
+          GeometryInfo<dim>::vertices_per_cell;
+
+        std::vector<unsigned int> position_of_line(
+          triangulation.n_raw_lines(), numbers::invalid_unsigned_int);
+        for (unsigned int i = 0; i < lines.size(); ++i)
+          position_of_line[lines[i]->index()] = i;
+
+        // assign each line to the first refined cell it is a line of and
+        // that shares its transfinite manifold. the lines of batch b are
+        // batch_lines[batch_ptrs[b]] to batch_lines[batch_ptrs[b+1]-1]
+        std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                  batch_cells;
+        std::vector<unsigned int> batch_ptrs(1, 0);
+        std::vector<unsigned int> batch_lines;
+        std::vector<bool>         line_in_batch(lines.size(), false);
+        for (const auto &cell : triangulation.active_cell_iterators())
+          if (cell->refine_flag_set() &&
+              dynamic_cast<
+                const TransfiniteInterpolationManifold<dim, spacedim> *>(
+                &cell->get_manifold()) != nullptr)
+            {
+              for (unsigned int l = 0;
+                   l < GeometryInfo<dim>::lines_per_cell;
+                   ++l)
+                {
+                  const unsigned int position =
+                    position_of_line[cell->line_index(l)];
+                  if (position != numbers::invalid_unsigned_int &&
+                      line_in_batch[position] == false &&
+                      &lines[position]->get_manifold() ==
+                        &cell->get_manifold())
+                    {
+                      batch_lines.push_back(position);
+                      line_in_batch[position] = true;
+                    }
+                }
+              if (batch_lines.size() > batch_ptrs.back())
+                {
+                  batch_cells.push_back(cell);
+                  batch_ptrs.push_back(batch_lines.size());
+                }
+            }
+
+        std::vector<Point<spacedim>> points(lines.size());
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(batch_cells.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            std::vector<Point<spacedim>> vertices(vertices_per_cell);
+            std::vector<Point<spacedim>> new_points;
+            Table<2, double>             weights;
+            for (unsigned int b = begin; b < end; ++b)
+              {
+                const auto &cell = batch_cells[b];
+                for (unsigned int v = 0; v < vertices_per_cell; ++v)
+                  vertices[v] = cell->vertex(v);
+
+                const unsigned int n_lines = batch_ptrs[b + 1] - batch_ptrs[b];
+                weights.reinit(n_lines, vertices_per_cell);
+                for (unsigned int i = 0; i < n_lines; ++i)
+                  {
+                    const auto &line = lines[batch_lines[batch_ptrs[b] + i]];
+                    for (unsigned int v = 0; v < vertices_per_cell; ++v)
+                      if (cell->vertex_index(v) == line->vertex_index(0) ||
+                          cell->vertex_index(v) == line->vertex_index(1))
+                        weights(i, v) = 0.5;
+                  }
+
+                new_points.resize(n_lines);
+                cell->get_manifold().get_new_points(
+                  make_array_view(vertices),
+                  weights,
+                  make_array_view(new_points));
+                for (unsigned int i = 0; i < n_lines; ++i)
+                  points[batch_lines[batch_ptrs[b] + i]] = new_points[i];
+              }
+          },
+          8);
+
+        std::vector<unsigned int> remaining_lines;
+        for (unsigned int i = 0; i < lines.size(); ++i)
+          if (line_in_batch[i] == false)
+            remaining_lines.push_back(i);
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(remaining_lines.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int i = begin; i < end; ++i)
+              points[remaining_lines[i]] =
+                lines[remaining_lines[i]]->center(true);
+          },
+          32);
+
+        return points;
+      }
+
+
+
       /**
        * A function that performs the
        * refinement of a triangulation in 1d.
@@ -5094,7 +5211,18 @@ namespace internal
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
 
+          // compute the midpoints of all lines to be refined up front
+          std::vector<
+            typename Triangulation<dim, spacedim>::active_line_iterator>
+            lines_to_refine;
           for (; line != endl; ++line)
+            if (line->user_flag_set())
+              lines_to_refine.push_back(line);
+          const std::vector<Point<spacedim>> line_midpoints =
+            compute_line_midpoints(triangulation, lines_to_refine);
+          unsigned int n_refined_lines = 0;
+
+          for (line = triangulation.begin_active_line(); line != endl; ++line)
             if (line->user_flag_set())
               {
                 // this line needs to be refined
@@ -5109,7 +5237,10 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                Assert(n_refined_lines < line_midpoints.size(),
+                       ExcInternalError());
+                triangulation.vertices[next_unused_vertex] =
+                  line_midpoints[n_refined_lines++];
 
                 // now that we created the right point, make up the
                 // two child lines.  To this end, find a pair of
@@ -5204,7 +5335,31 @@ namespace internal
             typename Triangulation<dim, spacedim>::raw_cell_iterator
               next_unused_cell = triangulation.begin_raw(level + 1);
 
+            // compute the central vertices of the cells to be refined
+            // isotropically up front. if the quad lives in 2d and the cell
+            // is at the boundary, the vertex is interpolated from the
+            // surrounding ones. this is of advantage if the boundary is
+            // strongly curved (whereas the cell is not) and the cell has a
+            // high aspect ratio. if the quad lives in a higher dimensional
+            // space, the vertex is always placed on the manifold
+            std::vector<
+              typename Triangulation<dim, spacedim>::active_cell_iterator>
+              cells_to_refine;
             for (; cell != endc; ++cell)
+              if (cell->refine_flag_set() == RefinementCase<dim>::cut_xy)
+                cells_to_refine.push_back(cell);
+            const std::vector<Point<spacedim>> cell_centers =
+              compute_new_vertex_locations<spacedim>(
+                cells_to_refine,
+                [](const typename Triangulation<dim, spacedim>::
+                     active_cell_iterator &cell) {
+                  return (dim == spacedim && cell->at_boundary()) ?
+                           cell->center(true, true) :
+                           cell->center(true);
+                });
+            unsigned int n_isotropically_refined_cells = 0;
+
+            for (cell = triangulation.begin_active(level); cell != endc; ++cell)
               if (cell->refine_flag_set())
                 {
                   // set the user flag to indicate, that at least one
@@ -5216,13 +5371,24 @@ namespace internal
                   if (cell->at_boundary())
                     cell->set_user_flag();
 
+                  Point<spacedim> new_center;
+                  if (cell->refine_flag_set() == RefinementCase<dim>::cut_xy)
+                    {
+                      Assert(n_isotropically_refined_cells <
+                               cell_centers.size(),
+                             ExcInternalError());
+                      new_center =
+                        cell_centers[n_isotropically_refined_cells++];
+                    }
+
                   // actually set up the children and update neighbor
                   // information
                   create_children(triangulation,
                                   next_unused_vertex,
                                   next_unused_line,
                                   next_unused_cell,
-                                  cell);
+                                  cell,
+                                  new_center);
 
                   if ((check_for_distorted_cells == true) &&
                       has_distorted_children(
@@ -5576,7 +5742,18 @@ namespace internal
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
 
+          // compute the midpoints of all lines to be refined up front
+          std::vector<
+            typename Triangulation<dim, spacedim>::active_line_iterator>
+            lines_to_refine;
           for (; line != endl; ++line)
+            if (line->user_flag_set())
+              lines_to_refine.push_back(line);
+          const std::vector<Point<spacedim>> line_midpoints =
+            compute_line_midpoints(triangulation, lines_to_refine);
+          unsigned int n_refined_lines = 0;
+
+          for (line = triangulation.begin_active_line(); line != endl; ++line)
             if (line->user_flag_set())
               {
                 // this line needs to be refined
@@ -5591,7 +5768,10 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                Assert(n_refined_lines < line_midpoints.size(),
+                       ExcInternalError());
+                triangulation.vertices[next_unused_vertex] =
+                  line_midpoints[n_refined_lines++];
 
                 // now that we created the right point, make up the
                 // two child lines (++ takes care of the end of the
@@ -10489,6 +10669,7 @@ Triangulation<dim, spacedim>::copy_triangulation(
       *other_tria.levels[level]));
 
   number_cache = other_tria.number_cache;
+  update_locally_owned_active_cells();
 
   if (dim == 1)
     {
@@ -12117,6 +12298,25 @@ Triangulation<dim, spacedim>::active_cell_iterators_on_level(
 }
 
 
+
+template <int dim, int spacedim>
+const std::vector<std::pair<unsigned int, unsigned int>> &
+Triangulation<dim, spacedim>::get_locally_owned_active_cells() const
+{
+  return locally_owned_active_cells;
+}
+
+
+
+template <int dim, int spacedim>
+internal::TriangulationImplementation::ActiveCellList<dim, spacedim>
+Triangulation<dim, spacedim>::locally_owned_active_cell_iterators() const
+{
+  return internal::TriangulationImplementation::ActiveCellList<dim, spacedim>(
+    this, locally_owned_active_cells);
+}
+
+
 /*------------------------ Face iterator functions ------------------------*/
 
 
@@ -13352,6 +13552,25 @@ Triangulation<dim, spacedim>::reset_active_cell_indices()
       }
 
   Assert(active_cell_index == n_active_cells(), ExcInternalError());
+
+  update_locally_owned_active_cells();
+}
+
+
+
+template <int dim, int spacedim>
+void
+Triangulation<dim, spacedim>::update_locally_owned_active_cells()
+{
+  locally_owned_active_cells.clear();
+  if (levels.size() == 0)
+    return;
+
+  locally_owned_active_cells.reserve(n_active_cells());
+  for (const auto &cell : active_cell_iterators())
+    if (cell->is_locally_owned())
+      locally_owned_active_cells.emplace_back(cell->level(), cell->index());
+  locally_owned_active_cells.shrink_to_fit();
 }
 
 
@@ -13431,6 +13650,7 @@ Triangulation<dim, spacedim>::clear_despite_subscriptions()
   manifold.clear();
 
   number_cache = internal::TriangulationImplementation::NumberCache<dim>();
+  locally_owned_active_cells.clear();
 }
 
 
@@ -15095,6 +15315,7 @@ Triangulation<dim, spacedim>::memory_consumption() const
   mem += sizeof(manifold);
   mem += sizeof(smooth_grid);
   mem += MemoryConsumption::memory_consumption(number_cache);
+  mem += MemoryConsumption::memory_consumption(locally_owned_active_cells);
   mem += sizeof(faces);
   if (faces)
     mem += MemoryConsumption::memory_consumption(*faces);
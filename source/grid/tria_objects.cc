@@ -118,8 +118,11 @@ namespace internal
           boundary_or_material_id.reserve(new_size);
           boundary_or_material_id.resize(new_size);
 
-          user_data.reserve(new_size);
-          user_data.resize(new_size);
+          if (user_data_allocation.allocated)
+            {
+              user_data.reserve(new_size);
+              user_data.resize(new_size);
+            }
 
           manifold_id.reserve(new_size);
           manifold_id.insert(manifold_id.end(),
@@ -205,8 +208,11 @@ namespace internal
                              new_size - manifold_id.size(),
                              numbers::flat_manifold_id);
 
-          user_data.reserve(new_size);
-          user_data.resize(new_size);
+          if (user_data_allocation.allocated)
+            {
+              user_data.reserve(new_size);
+              user_data.resize(new_size);
+            }
 
           face_orientations.reserve(new_size * GeometryInfo<3>::faces_per_cell);
           face_orientations.insert(face_orientations.end(),
@@ -319,7 +325,7 @@ namespace internal
              ExcMemoryInexact(cells.size(), boundary_or_material_id.size()));
       Assert(cells.size() == manifold_id.size(),
              ExcMemoryInexact(cells.size(), manifold_id.size()));
-      Assert(cells.size() == user_data.size(),
+      Assert(user_data.empty() || cells.size() == user_data.size(),
              ExcMemoryInexact(cells.size(), user_data.size()));
     }
 
@@ -340,7 +346,7 @@ namespace internal
              ExcMemoryInexact(cells.size(), boundary_or_material_id.size()));
       Assert(cells.size() == manifold_id.size(),
              ExcMemoryInexact(cells.size(), manifold_id.size()));
-      Assert(cells.size() == user_data.size(),
+      Assert(user_data.empty() || cells.size() == user_data.size(),
              ExcMemoryInexact(cells.size(), user_data.size()));
     }
 
@@ -358,7 +364,7 @@ namespace internal
              ExcMemoryInexact(cells.size(), boundary_or_material_id.size()));
       Assert(cells.size() == manifold_id.size(),
              ExcMemoryInexact(cells.size(), manifold_id.size()));
-      Assert(cells.size() == user_data.size(),
+      Assert(user_data.empty() || cells.size() == user_data.size(),
              ExcMemoryInexact(cells.size(), user_data.size()));
       Assert(cells.size() * GeometryInfo<3>::faces_per_cell ==
                face_orientations.size(),
@@ -401,6 +407,7 @@ namespace internal
       boundary_or_material_id.clear();
       manifold_id.clear();
       user_data.clear();
+      user_data_allocation.allocated = false;
       user_data_type = data_unknown;
     }
 
@@ -287,39 +287,38 @@ namespace internal
           // note that for dof_handler.cells, the situation is simpler
           // than for other (lower dimensional) objects since exactly
           // one finite element is used for it
+          // the interior dofs of a cell are stored at the end of the cache
+          // of the cell, so we only need to know where they start for each
+          // of the finite elements
+          std::vector<DoFLevel::offset_type> first_interior_dof_indices(
+            dof_handler.fe_collection.size());
+          for (unsigned int fe = 0; fe < dof_handler.fe_collection.size(); ++fe)
+            first_interior_dof_indices[fe] =
+              dof_handler.fe_collection[fe].dofs_per_cell -
+              dof_handler.fe_collection[fe].template n_dofs_per_object<dim>();
+
           for (unsigned int level = 0; level < dof_handler.tria->n_levels();
                ++level)
             {
-              dof_handler.levels[level]->dof_offsets =
-                std::vector<DoFLevel::offset_type>(
-                  dof_handler.tria->n_raw_cells(level),
-                  static_cast<DoFLevel::offset_type>(-1));
               dof_handler.levels[level]->cell_cache_offsets =
                 std::vector<DoFLevel::offset_type>(
                   dof_handler.tria->n_raw_cells(level),
                   static_cast<DoFLevel::offset_type>(-1));
+              dof_handler.levels[level]->first_interior_dof_indices =
+                first_interior_dof_indices;
 
-              types::global_dof_index next_free_dof = 0;
-              types::global_dof_index cache_size    = 0;
+              types::global_dof_index cache_size = 0;
               typename HpDoFHandler<dim, spacedim>::active_cell_iterator
                 cell = dof_handler.begin_active(level),
                 endc = dof_handler.end_active(level);
               for (; cell != endc; ++cell)
                 if (!cell->has_children() && !cell->is_artificial())
                   {
-                    dof_handler.levels[level]->dof_offsets[cell->index()] =
-                      next_free_dof;
-                    next_free_dof +=
-                      cell->get_fe().template n_dofs_per_object<dim>();
-
                     dof_handler.levels[level]
                       ->cell_cache_offsets[cell->index()] = cache_size;
                     cache_size += cell->get_fe().dofs_per_cell;
                   }
 
-              dof_handler.levels[level]->dof_indices =
-                std::vector<types::global_dof_index>(
-                  next_free_dof, numbers::invalid_dof_index);
               dof_handler.levels[level]->cell_dof_indices_cache =
                 std::vector<types::global_dof_index>(
                   cache_size, numbers::invalid_dof_index);
@@ -327,7 +326,7 @@ namespace internal
 
             // safety check: make sure that the number of DoFs we
             // allocated is actually correct (above we have also set the
-            // dof_*_offsets field, so we couldn't use this simpler
+            // cell_cache_offsets field, so we couldn't use this simpler
             // algorithm)
 #ifdef DEBUG
           for (unsigned int level = 0; level < dof_handler.tria->n_levels();
@@ -339,23 +338,24 @@ namespace internal
                 endc = dof_handler.end_active(level);
               for (; cell != endc; ++cell)
                 if (!cell->has_children() && !cell->is_artificial())
-                  counter += cell->get_fe().template n_dofs_per_object<dim>();
+                  counter += cell->get_fe().dofs_per_cell;
 
-              Assert(dof_handler.levels[level]->dof_indices.size() == counter,
+              Assert(dof_handler.levels[level]->cell_dof_indices_cache.size() ==
+                       counter,
                      ExcInternalError());
 
               // also check that the number of unassigned slots in the
-              // dof_offsets equals the number of cells on that level minus the
-              // number of active, non-artificial cells (because these are
-              // exactly the cells on which we do something)
+              // cell_cache_offsets equals the number of cells on that level
+              // minus the number of active, non-artificial cells (because
+              // these are exactly the cells on which we do something)
               unsigned int n_active_non_artificial_cells = 0;
               for (cell = dof_handler.begin_active(level); cell != endc; ++cell)
                 if (!cell->has_children() && !cell->is_artificial())
                   ++n_active_non_artificial_cells;
 
               Assert(static_cast<unsigned int>(std::count(
-                       dof_handler.levels[level]->dof_offsets.begin(),
-                       dof_handler.levels[level]->dof_offsets.end(),
+                       dof_handler.levels[level]->cell_cache_offsets.begin(),
+                       dof_handler.levels[level]->cell_cache_offsets.end(),
                        static_cast<DoFLevel::offset_type>(-1))) ==
                        dof_handler.tria->n_raw_cells(level) -
                          n_active_non_artificial_cells,
@@ -1674,17 +1674,6 @@ namespace hp
 
     /////////////////////////////////
 
-    // do some housekeeping: compress indices
-    {
-      Threads::TaskGroup<> tg;
-      for (int level = levels.size() - 1; level >= 0; --level)
-        tg += Threads::new_task(
-          &dealii::internal::hp::DoFLevel::compress_data<dim, spacedim>,
-          *levels[level],
-          fe_collection);
-      tg.join_all();
-    }
-
     // finally restore the user flags
     const_cast<Triangulation<dim, spacedim> &>(*tria).load_user_flags(
       user_flags);
@@ -1840,32 +1829,8 @@ namespace hp
                  "New DoF index is not less than the total number of dofs."));
 #endif
 
-    // uncompress the internal storage scheme of dofs on cells so that
-    // we can access dofs in turns. uncompress in parallel, starting
-    // with the most expensive levels (the highest ones)
-    {
-      Threads::TaskGroup<> tg;
-      for (int level = levels.size() - 1; level >= 0; --level)
-        tg += Threads::new_task(
-          &dealii::internal::hp::DoFLevel::uncompress_data<dim, spacedim>,
-          *levels[level],
-          fe_collection);
-      tg.join_all();
-    }
-
     // do the renumbering
     number_cache = policy->renumber_dofs(new_numbers);
-
-    // now re-compress the dof indices
-    {
-      Threads::TaskGroup<> tg;
-      for (int level = levels.size() - 1; level >= 0; --level)
-        tg += Threads::new_task(
-          &dealii::internal::hp::DoFLevel::compress_data<dim, spacedim>,
-          *levels[level],
-          fe_collection);
-      tg.join_all();
-    }
   }
 
 
@@ -1947,14 +1912,6 @@ namespace hp
                        tria->n_raw_cells(level),
                    ExcInternalError());
           }
-
-        // it may be that the previous table was compressed; in that
-        // case, restore the correct active_fe_index. the fact that
-        // this no longer matches the indices in the table is of no
-        // importance because the current function is called at a
-        // point where we have to recreate the dof_indices tables in
-        // the levels anyway
-        levels[level]->normalize_active_fe_indices();
       }
   }
 
@@ -17,6 +17,8 @@
 
 #include <deal.II/hp/fe_values.h>
 
+#include <numeric>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace internal
@@ -100,6 +102,78 @@ namespace internal
       // now there definitely is one!
       return *fe_values_table(present_fe_values_index);
     }
+
+
+
+    template <int dim, int q_dim, class FEValuesType>
+    void
+    FEValuesBase<dim, q_dim, FEValuesType>::precalculate_fe_values(
+      const std::vector<unsigned int> &fe_indices,
+      const std::vector<unsigned int> &mapping_indices,
+      const std::vector<unsigned int> &q_indices)
+    {
+      AssertDimension(fe_indices.size(), mapping_indices.size());
+      AssertDimension(fe_indices.size(), q_indices.size());
+
+      // each task writes to its own entry of the table, so there is no need
+      // for synchronization. make sure, though, that no two tasks create the
+      // same object
+      dealii::Table<3, bool>       scheduled(fe_values_table.size(0),
+                                             fe_values_table.size(1),
+                                             fe_values_table.size(2));
+      std::vector<TableIndices<3>> indices;
+      for (unsigned int i = 0; i < fe_indices.size(); ++i)
+        {
+          Assert(fe_indices[i] < fe_collection->size(),
+                 ExcIndexRange(fe_indices[i], 0, fe_collection->size()));
+          Assert(mapping_indices[i] < mapping_collection->size(),
+                 ExcIndexRange(mapping_indices[i],
+                               0,
+                               mapping_collection->size()));
+          Assert(q_indices[i] < q_collection.size(),
+                 ExcIndexRange(q_indices[i], 0, q_collection.size()));
+
+          const TableIndices<3> index(fe_indices[i],
+                                      mapping_indices[i],
+                                      q_indices[i]);
+          if (fe_values_table(index).get() == nullptr &&
+              scheduled(index) == false)
+            {
+              scheduled(index) = true;
+              indices.push_back(index);
+            }
+        }
+
+      Threads::TaskGroup<> tasks;
+      for (const TableIndices<3> &index : indices)
+        tasks += Threads::new_task([&, index]() {
+          fe_values_table(index) =
+            std::make_shared<FEValuesType>((*mapping_collection)[index[1]],
+                                           (*fe_collection)[index[0]],
+                                           q_collection[index[2]],
+                                           update_flags);
+        });
+      tasks.join_all();
+    }
+
+
+
+    template <int dim, int q_dim, class FEValuesType>
+    void
+    FEValuesBase<dim, q_dim, FEValuesType>::precalculate_fe_values()
+    {
+      std::vector<unsigned int> fe_indices(fe_collection->size());
+      std::vector<unsigned int> mapping_indices(fe_collection->size(), 0);
+      std::vector<unsigned int> q_indices(fe_collection->size(), 0);
+
+      std::iota(fe_indices.begin(), fe_indices.end(), 0u);
+      if (mapping_collection->size() > 1)
+        mapping_indices = fe_indices;
+      if (q_collection.size() > 1)
+        q_indices = fe_indices;
+
+      precalculate_fe_values(fe_indices, mapping_indices, q_indices);
+    }
   } // namespace hp
 } // namespace internal
 
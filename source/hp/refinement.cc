@@ -15,10 +15,12 @@
 
 
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/distributed/tria_base.h>
 
 #include <deal.II/grid/grid_refinement.h>
+#include <deal.II/grid/grid_tools.h>
 
 #include <deal.II/hp/dof_handler.h>
 #include <deal.II/hp/refinement.h>
@@ -31,6 +33,107 @@ namespace hp
 {
   namespace Refinement
   {
+    namespace
+    {
+      /**
+       * The minimal number of cells that a single task works on when the
+       * decision functions below are run in parallel.
+       */
+      const unsigned int grainsize = 256;
+
+
+
+      /**
+       * Collect iterators to all locally owned active cells, so that the
+       * decision functions of this namespace can split them into chunks
+       * that are processed in parallel.
+       *
+       * Each of these functions only writes to the cell it is currently
+       * working on, and only to data that is stored in one entry per cell
+       * (the future finite element index, or a vector entry indexed by the
+       * active cell index). Refine and coarsen flags are only read, since
+       * coarsen flags are stored in a <code>std::vector@<bool@></code>
+       * whose entries may not be written concurrently.
+       */
+      template <int dim, int spacedim>
+      std::vector<typename hp::DoFHandler<dim, spacedim>::active_cell_iterator>
+      locally_owned_active_cells(
+        const hp::DoFHandler<dim, spacedim> &dof_handler)
+      {
+        std::vector<
+          typename hp::DoFHandler<dim, spacedim>::active_cell_iterator>
+          cells;
+        cells.reserve(dof_handler.get_triangulation().n_active_cells());
+
+        for (const auto &cell : dof_handler.active_cell_iterators())
+          if (cell->is_locally_owned())
+            cells.push_back(cell);
+
+        return cells;
+      }
+
+
+
+      /**
+       * Run @p worker on all locally owned active cells, splitting them into
+       * chunks that are processed in parallel.
+       */
+      template <int dim, int spacedim, typename Worker>
+      void
+      for_each_locally_owned_active_cell(
+        const hp::DoFHandler<dim, spacedim> &dof_handler,
+        const Worker &                       worker)
+      {
+        const auto cells = locally_owned_active_cells(dof_handler);
+
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(cells.size()),
+          [&cells, &worker](const unsigned int begin, const unsigned int end) {
+            for (unsigned int i = begin; i < end; ++i)
+              worker(cells[i]);
+          },
+          grainsize);
+      }
+
+
+
+      /**
+       * Assign the next superordinate or subordinate finite element as the
+       * future one to a cell flagged for refinement or coarsening,
+       * respectively.
+       */
+      template <int dim, int spacedim>
+      void
+      set_p_adaptivity_flag(
+        const typename hp::DoFHandler<dim, spacedim>::active_cell_iterator
+          &cell)
+      {
+        if (cell->refine_flag_set())
+          {
+            const unsigned int super_fe_index =
+              cell->get_dof_handler().get_fe_collection().next_in_hierarchy(
+                cell->active_fe_index());
+
+            // Reject update if already most superordinate element.
+            if (super_fe_index != cell->active_fe_index())
+              cell->set_future_fe_index(super_fe_index);
+          }
+        else if (cell->coarsen_flag_set())
+          {
+            const unsigned int sub_fe_index =
+              cell->get_dof_handler().get_fe_collection().previous_in_hierarchy(
+                cell->active_fe_index());
+
+            // Reject update if already least subordinate element.
+            if (sub_fe_index != cell->active_fe_index())
+              cell->set_future_fe_index(sub_fe_index);
+          }
+      }
+    } // namespace
+
+
+
     /**
      * Setting p adaptivity flags
      */
@@ -54,30 +157,14 @@ namespace hp
       AssertDimension(dof_handler.get_triangulation().n_active_cells(),
                       p_flags.size());
 
-      for (const auto &cell : dof_handler.active_cell_iterators())
-        if (cell->is_locally_owned() && p_flags[cell->active_cell_index()])
-          {
-            if (cell->refine_flag_set())
-              {
-                const unsigned int super_fe_index =
-                  dof_handler.get_fe_collection().next_in_hierarchy(
-                    cell->active_fe_index());
-
-                // Reject update if already most superordinate element.
-                if (super_fe_index != cell->active_fe_index())
-                  cell->set_future_fe_index(super_fe_index);
-              }
-            else if (cell->coarsen_flag_set())
-              {
-                const unsigned int sub_fe_index =
-                  dof_handler.get_fe_collection().previous_in_hierarchy(
-                    cell->active_fe_index());
-
-                // Reject update if already least subordinate element.
-                if (sub_fe_index != cell->active_fe_index())
-                  cell->set_future_fe_index(sub_fe_index);
-              }
-          }
+      for_each_locally_owned_active_cell(
+        dof_handler,
+        [&p_flags](
+          const typename hp::DoFHandler<dim, spacedim>::active_cell_iterator
+            &cell) {
+          if (p_flags[cell->active_cell_index()])
+            set_p_adaptivity_flag<dim, spacedim>(cell);
+        });
     }
 
 
@@ -110,28 +197,50 @@ namespace hp
       Number max_smoothness_coarsen = max_smoothness_refine,
              min_smoothness_coarsen = min_smoothness_refine;
 
-      for (const auto &cell : dof_handler.active_cell_iterators())
-        if (cell->is_locally_owned())
-          {
-            if (cell->refine_flag_set())
-              {
-                max_smoothness_refine =
-                  std::max(max_smoothness_refine,
-                           smoothness_indicators(cell->active_cell_index()));
-                min_smoothness_refine =
-                  std::min(min_smoothness_refine,
-                           smoothness_indicators(cell->active_cell_index()));
-              }
-            else if (cell->coarsen_flag_set())
+      // Each task determines the extremal values on its share of cells, which
+      // are then merged into the global ones.
+      {
+        const auto cells = locally_owned_active_cells(dof_handler);
+
+        Threads::Mutex mutex;
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(cells.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            Number local_max_refine  = max_smoothness_refine,
+                   local_min_refine  = min_smoothness_refine,
+                   local_max_coarsen = max_smoothness_coarsen,
+                   local_min_coarsen = min_smoothness_coarsen;
+
+            for (unsigned int i = begin; i < end; ++i)
               {
-                max_smoothness_coarsen =
-                  std::max(max_smoothness_coarsen,
-                           smoothness_indicators(cell->active_cell_index()));
-                min_smoothness_coarsen =
-                  std::min(min_smoothness_coarsen,
-                           smoothness_indicators(cell->active_cell_index()));
+                const Number smoothness =
+                  smoothness_indicators(cells[i]->active_cell_index());
+
+                if (cells[i]->refine_flag_set())
+                  {
+                    local_max_refine = std::max(local_max_refine, smoothness);
+                    local_min_refine = std::min(local_min_refine, smoothness);
+                  }
+                else if (cells[i]->coarsen_flag_set())
+                  {
+                    local_max_coarsen = std::max(local_max_coarsen, smoothness);
+                    local_min_coarsen = std::min(local_min_coarsen, smoothness);
+                  }
               }
-          }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            max_smoothness_refine =
+              std::max(max_smoothness_refine, local_max_refine);
+            min_smoothness_refine =
+              std::min(min_smoothness_refine, local_min_refine);
+            max_smoothness_coarsen =
+              std::max(max_smoothness_coarsen, local_max_coarsen);
+            min_smoothness_coarsen =
+              std::min(min_smoothness_coarsen, local_min_coarsen);
+          },
+          grainsize);
+      }
 
       if (const parallel::Triangulation<dim, spacedim> *parallel_tria =
             dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
@@ -164,20 +273,18 @@ namespace hp
 
       // We then compare each cell's smoothness indicator with the corresponding
       // threshold.
-      std::vector<bool> p_flags(
-        dof_handler.get_triangulation().n_active_cells(), false);
-
-      for (const auto &cell : dof_handler.active_cell_iterators())
-        if (cell->is_locally_owned() &&
-            ((cell->refine_flag_set() &&
-              (smoothness_indicators(cell->active_cell_index()) >
-               threshold_smoothness_refine)) ||
-             (cell->coarsen_flag_set() &&
-              (smoothness_indicators(cell->active_cell_index()) <
-               threshold_smoothness_coarsen))))
-          p_flags[cell->active_cell_index()] = true;
-
-      p_adaptivity_from_flags(dof_handler, p_flags);
+      for_each_locally_owned_active_cell(
+        dof_handler,
+        [&](const typename hp::DoFHandler<dim, spacedim>::active_cell_iterator
+              &cell) {
+          if ((cell->refine_flag_set() &&
+               (smoothness_indicators(cell->active_cell_index()) >
+                threshold_smoothness_refine)) ||
+              (cell->coarsen_flag_set() &&
+               (smoothness_indicators(cell->active_cell_index()) <
+                threshold_smoothness_coarsen)))
+            set_p_adaptivity_flag<dim, spacedim>(cell);
+        });
     }
 
 
@@ -191,44 +298,47 @@ namespace hp
       AssertDimension(dof_handler.get_triangulation().n_active_cells(),
                       sobolev_indices.size());
 
-      for (const auto &cell : dof_handler.active_cell_iterators())
-        if (cell->is_locally_owned())
-          {
-            if (cell->refine_flag_set())
-              {
-                const unsigned int super_fe_index =
-                  dof_handler.get_fe_collection().next_in_hierarchy(
-                    cell->active_fe_index());
-
-                // Reject update if already most superordinate element.
-                if (super_fe_index != cell->active_fe_index())
-                  {
-                    const unsigned int super_fe_degree =
-                      dof_handler.get_fe_collection()[super_fe_index].degree;
-
-                    if (sobolev_indices[cell->active_cell_index()] >
-                        super_fe_degree)
-                      cell->set_future_fe_index(super_fe_index);
-                  }
-              }
-            else if (cell->coarsen_flag_set())
-              {
-                const unsigned int sub_fe_index =
-                  dof_handler.get_fe_collection().previous_in_hierarchy(
-                    cell->active_fe_index());
-
-                // Reject update if already least subordinate element.
-                if (sub_fe_index != cell->active_fe_index())
-                  {
-                    const unsigned int sub_fe_degree =
-                      dof_handler.get_fe_collection()[sub_fe_index].degree;
-
-                    if (sobolev_indices[cell->active_cell_index()] <
-                        sub_fe_degree)
-                      cell->set_future_fe_index(sub_fe_index);
-                  }
-              }
-          }
+      for_each_locally_owned_active_cell(
+        dof_handler,
+        [&sobolev_indices](
+          const typename hp::DoFHandler<dim, spacedim>::active_cell_iterator
+            &cell) {
+          const hp::FECollection<dim, spacedim> &fe_collection =
+            cell->get_dof_handler().get_fe_collection();
+
+          if (cell->refine_flag_set())
+            {
+              const unsigned int super_fe_index =
+                fe_collection.next_in_hierarchy(cell->active_fe_index());
+
+              // Reject update if already most superordinate element.
+              if (super_fe_index != cell->active_fe_index())
+                {
+                  const unsigned int super_fe_degree =
+                    fe_collection[super_fe_index].degree;
+
+                  if (sobolev_indices[cell->active_cell_index()] >
+                      super_fe_degree)
+                    cell->set_future_fe_index(super_fe_index);
+                }
+            }
+          else if (cell->coarsen_flag_set())
+            {
+              const unsigned int sub_fe_index =
+                fe_collection.previous_in_hierarchy(cell->active_fe_index());
+
+              // Reject update if already least subordinate element.
+              if (sub_fe_index != cell->active_fe_index())
+                {
+                  const unsigned int sub_fe_degree =
+                    fe_collection[sub_fe_index].degree;
+
+                  if (sobolev_indices[cell->active_cell_index()] <
+                      sub_fe_degree)
+                    cell->set_future_fe_index(sub_fe_index);
+                }
+            }
+        });
     }
 
 
@@ -245,17 +355,14 @@ namespace hp
       AssertDimension(dof_handler.get_triangulation().n_active_cells(),
                       predicted_errors.size());
 
-      std::vector<bool> p_flags(
-        dof_handler.get_triangulation().n_active_cells(), false);
-
-      for (const auto &cell : dof_handler.active_cell_iterators())
-        if (cell->is_locally_owned() &&
-            ((cell->refine_flag_set() || cell->coarsen_flag_set()) &&
-             (error_indicators[cell->active_cell_index()] <
-              predicted_errors[cell->active_cell_index()])))
-          p_flags[cell->active_cell_index()] = true;
-
-      p_adaptivity_from_flags(dof_handler, p_flags);
+      for_each_locally_owned_active_cell(
+        dof_handler,
+        [&](const typename hp::DoFHandler<dim, spacedim>::active_cell_iterator
+              &cell) {
+          if (error_indicators[cell->active_cell_index()] <
+              predicted_errors[cell->active_cell_index()])
+            set_p_adaptivity_flag<dim, spacedim>(cell);
+        });
     }
 
 
@@ -281,50 +388,51 @@ namespace hp
       Assert(0 < gamma_h, dealii::GridRefinement::ExcInvalidParameterValue());
       Assert(0 < gamma_n, dealii::GridRefinement::ExcInvalidParameterValue());
 
-      for (const auto &cell : dof_handler.active_cell_iterators())
-        if (cell->is_locally_owned())
-          {
-            const unsigned int active_cell_index = cell->active_cell_index();
-
-            if (cell->future_fe_index_set()) // p adaptation
-              {
-                Assert(!cell->refine_flag_set() && !cell->coarsen_flag_set(),
-                       ExcMessage("Cell has to be either flagged for h or p "
-                                  "adaptation, and not for both!"));
-
-                const int degree_difference =
-                  dof_handler.get_fe_collection()[cell->future_fe_index()]
-                    .degree -
-                  cell->get_fe().degree;
-
-                predicted_errors[active_cell_index] =
-                  error_indicators[active_cell_index] *
-                  std::pow(gamma_p, degree_difference);
-              }
-            else if (cell->refine_flag_set()) // h refinement
-              {
-                Assert(
-                  cell->refine_flag_set() ==
-                    RefinementCase<dim>::isotropic_refinement,
-                  ExcMessage(
-                    "Error prediction is only valid for isotropic refinement!"));
-
-                predicted_errors[active_cell_index] =
-                  error_indicators[active_cell_index] *
-                  (gamma_h * std::pow(.5, dim + cell->get_fe().degree));
-              }
-            else if (cell->coarsen_flag_set()) // h coarsening
-              {
-                predicted_errors[active_cell_index] =
-                  error_indicators[active_cell_index] /
-                  (gamma_h * std::pow(.5, cell->get_fe().degree));
-              }
-            else // no changes
-              {
-                predicted_errors[active_cell_index] =
-                  error_indicators[active_cell_index] * gamma_n;
-              }
-          }
+      for_each_locally_owned_active_cell(
+        dof_handler,
+        [&](const typename hp::DoFHandler<dim, spacedim>::active_cell_iterator
+              &cell) {
+          const unsigned int active_cell_index = cell->active_cell_index();
+
+          if (cell->future_fe_index_set()) // p adaptation
+            {
+              Assert(!cell->refine_flag_set() && !cell->coarsen_flag_set(),
+                     ExcMessage("Cell has to be either flagged for h or p "
+                                "adaptation, and not for both!"));
+
+              const int degree_difference =
+                dof_handler.get_fe_collection()[cell->future_fe_index()]
+                  .degree -
+                cell->get_fe().degree;
+
+              predicted_errors[active_cell_index] =
+                error_indicators[active_cell_index] *
+                std::pow(gamma_p, degree_difference);
+            }
+          else if (cell->refine_flag_set()) // h refinement
+            {
+              Assert(
+                cell->refine_flag_set() ==
+                  RefinementCase<dim>::isotropic_refinement,
+                ExcMessage(
+                  "Error prediction is only valid for isotropic refinement!"));
+
+              predicted_errors[active_cell_index] =
+                error_indicators[active_cell_index] *
+                (gamma_h * std::pow(.5, dim + cell->get_fe().degree));
+            }
+          else if (cell->coarsen_flag_set()) // h coarsening
+            {
+              predicted_errors[active_cell_index] =
+                error_indicators[active_cell_index] /
+                (gamma_h * std::pow(.5, cell->get_fe().degree));
+            }
+          else // no changes
+            {
+              predicted_errors[active_cell_index] =
+                error_indicators[active_cell_index] * gamma_n;
+            }
+        });
     }
 
 
@@ -394,6 +502,176 @@ namespace hp
               }
           }
     }
+
+
+
+    /**
+     * Limit p-level differences
+     */
+    template <int dim, int spacedim>
+    bool
+    limit_p_level_difference(const hp::DoFHandler<dim, spacedim> &dof_handler,
+                             const unsigned int max_difference)
+    {
+      Assert(max_difference > 0,
+             ExcMessage("This function does not serve any purpose for "
+                        "max_difference = 0."));
+
+      const hp::FECollection<dim, spacedim> &fe_collection =
+        dof_handler.get_fe_collection();
+
+      // Determine the level of each finite element within the hierarchy,
+      // i.e., the number of steps it takes to reach the least subordinate
+      // element.
+      std::vector<unsigned int> fe_levels(fe_collection.size(), 0);
+      for (unsigned int fe_index = 0; fe_index < fe_collection.size();
+           ++fe_index)
+        for (unsigned int index = fe_index, previous;
+             (previous = fe_collection.previous_in_hierarchy(index)) != index &&
+             fe_levels[fe_index] < fe_collection.size();
+             index = previous)
+          ++fe_levels[fe_index];
+
+      // Store the level of the future finite element on every active cell
+      // that we know about, including ghost cells.
+      std::vector<unsigned int> cell_levels(
+        dof_handler.get_triangulation().n_active_cells(),
+        numbers::invalid_unsigned_int);
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        if (cell->is_locally_owned())
+          cell_levels[cell->active_cell_index()] =
+            fe_levels[cell->future_fe_index()];
+
+      const parallel::Triangulation<dim, spacedim> *parallel_tria =
+        dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
+          &dof_handler.get_triangulation());
+
+      const auto cells = locally_owned_active_cells(dof_handler);
+      std::vector<unsigned int> future_fe_indices(cells.size());
+      for (unsigned int i = 0; i < cells.size(); ++i)
+        future_fe_indices[i] = cells[i]->future_fe_index();
+
+      bool levels_changed = false;
+      while (true)
+        {
+          if (parallel_tria != nullptr)
+            {
+              auto pack = [&cell_levels](
+                            const typename hp::DoFHandler<dim, spacedim>::
+                              active_cell_iterator &cell) -> unsigned int {
+                return cell_levels[cell->active_cell_index()];
+              };
+
+              auto unpack =
+                [&cell_levels](const typename hp::DoFHandler<dim, spacedim>::
+                                 active_cell_iterator &cell,
+                               const unsigned int      level) -> void {
+                cell_levels[cell->active_cell_index()] = level;
+              };
+
+              GridTools::exchange_cell_data_to_ghosts<
+                unsigned int,
+                hp::DoFHandler<dim, spacedim>>(dof_handler, pack, unpack);
+            }
+
+          // Every cell must not be more than max_difference levels below any
+          // of its neighbors. We raise cells that are too low, and determine
+          // all new levels from the ones of the previous sweep, which makes
+          // the result independent of the order in which cells are processed.
+          std::vector<unsigned int> new_cell_levels(cells.size());
+          parallel::apply_to_subranges(
+            0U,
+            static_cast<unsigned int>(cells.size()),
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int i = begin; i < end; ++i)
+                {
+                  const auto &cell = cells[i];
+
+                  unsigned int max_neighbor_level = 0;
+                  const auto   update_max_neighbor_level =
+                    [&](const typename hp::DoFHandler<dim, spacedim>::
+                          cell_iterator &neighbor) {
+                      const unsigned int level =
+                        cell_levels[neighbor->active_cell_index()];
+                      if (level != numbers::invalid_unsigned_int)
+                        max_neighbor_level =
+                          std::max(max_neighbor_level, level);
+                    };
+
+                  for (unsigned int f = 0;
+                       f < GeometryInfo<dim>::faces_per_cell;
+                       ++f)
+                    if (!cell->at_boundary(f))
+                      {
+                        if (!cell->neighbor(f)->has_children())
+                          update_max_neighbor_level(cell->neighbor(f));
+                        else if (dim == 1)
+                          {
+                            // In 1d, the neighbor's child adjacent to this
+                            // cell is the one on the opposite side.
+                            auto neighbor = cell->neighbor(f);
+                            while (neighbor->has_children())
+                              neighbor = neighbor->child(1 - f);
+                            update_max_neighbor_level(neighbor);
+                          }
+                        else
+                          for (unsigned int sf = 0;
+                               sf < cell->face(f)->n_children();
+                               ++sf)
+                            update_max_neighbor_level(
+                              cell->neighbor_child_on_subface(f, sf));
+                      }
+
+                  unsigned int fe_index = future_fe_indices[i];
+                  while (fe_levels[fe_index] + max_difference <
+                         max_neighbor_level)
+                    {
+                      const unsigned int next_fe_index =
+                        fe_collection.next_in_hierarchy(fe_index);
+                      if (next_fe_index == fe_index)
+                        break;
+                      fe_index = next_fe_index;
+                    }
+
+                  future_fe_indices[i] = fe_index;
+                  new_cell_levels[i]   = fe_levels[fe_index];
+                }
+            },
+            grainsize);
+
+          bool levels_changed_in_sweep = false;
+          for (unsigned int i = 0; i < cells.size(); ++i)
+            {
+              unsigned int &level = cell_levels[cells[i]->active_cell_index()];
+              if (level != new_cell_levels[i])
+                {
+                  level                   = new_cell_levels[i];
+                  levels_changed_in_sweep = true;
+                }
+            }
+
+          if (parallel_tria != nullptr)
+            levels_changed_in_sweep =
+              (Utilities::MPI::max(static_cast<unsigned int>(
+                                     levels_changed_in_sweep),
+                                   parallel_tria->get_communicator()) == 1);
+
+          if (!levels_changed_in_sweep)
+            break;
+          levels_changed = true;
+        }
+
+      for (unsigned int i = 0; i < cells.size(); ++i)
+        if (future_fe_indices[i] != cells[i]->future_fe_index())
+          {
+            if (future_fe_indices[i] == cells[i]->active_fe_index())
+              cells[i]->clear_future_fe_index();
+            else
+              cells[i]->set_future_fe_index(future_fe_indices[i]);
+          }
+
+      return levels_changed;
+    }
   } // namespace Refinement
 } // namespace hp
 
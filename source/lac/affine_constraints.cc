@@ -87,7 +87,13 @@ DEAL_II_NAMESPACE_OPEN
                 const std::vector<AffineConstraints::size_type> &,       \
                 const AffineConstraints<MatrixType::value_type> &,       \
                 const std::vector<AffineConstraints::size_type> &,       \
-                MatrixType &) const
+                MatrixType &) const;                                     \
+  template void                                                          \
+  AffineConstraints<MatrixType::value_type>::distribute_local_to_global< \
+    MatrixType>(                                                         \
+    const std::vector<FullMatrix<MatrixType::value_type>> &,             \
+    const std::vector<std::vector<AffineConstraints::size_type>> &,      \
+    MatrixType &) const
 
 #ifdef DEAL_II_WITH_PETSC
 INSTANTIATE_DLTG_VECTOR(PETScWrappers::MPI::Vector);
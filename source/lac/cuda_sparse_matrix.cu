@@ -23,6 +23,8 @@
 
 #  include <cusparse.h>
 
+#  include <algorithm>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace CUDAWrappers
@@ -230,6 +232,13 @@ namespace CUDAWrappers
   SparseMatrix<Number> &
   SparseMatrix<Number>::operator=(SparseMatrix<Number> &&other)
   {
+    if (descr != nullptr)
+      {
+        const cusparseStatus_t cusparse_error_code =
+          cusparseDestroyMatDescr(descr);
+        AssertCusparse(cusparse_error_code);
+      }
+
     cusparse_handle  = other.cusparse_handle;
     nnz              = other.nnz;
     n_rows           = other.n_rows;
@@ -295,41 +304,94 @@ namespace CUDAWrappers
         column_index[offset + pos - 1] = diag_index;
       }
 
+    setup_device_structure(row_ptr, column_index);
+
     // Copy the elements to the gpu
-    val_dev.reset(Utilities::CUDA::allocate_device_data<Number>(nnz));
-    cudaError_t error_code = cudaMemcpy(val_dev.get(),
-                                        val.data(),
-                                        nnz * sizeof(Number),
-                                        cudaMemcpyHostToDevice);
+    const cudaError_t error_code = cudaMemcpy(val_dev.get(),
+                                              val.data(),
+                                              nnz * sizeof(Number),
+                                              cudaMemcpyHostToDevice);
     AssertCuda(error_code);
+  }
+
+
+
+  template <typename Number>
+  void
+  SparseMatrix<Number>::reinit(Utilities::CUDA::Handle &handle,
+                               const SparsityPattern &  sparsity_pattern)
+  {
+    cusparse_handle = handle.cusparse_handle;
+    nnz             = sparsity_pattern.n_nonzero_elements();
+    n_rows          = sparsity_pattern.n_rows();
+    n_cols          = sparsity_pattern.n_cols();
+
+    std::vector<int> column_index;
+    column_index.reserve(nnz);
+    std::vector<int> row_ptr(n_rows + 1, 0);
+
+    // SparsityPattern stores the diagonal first in each row of square
+    // matrices, so sort the column indices of each row
+    for (int row = 0; row < n_rows; ++row)
+      {
+        for (auto p = sparsity_pattern.begin(row);
+             p != sparsity_pattern.end(row);
+             ++p)
+          column_index.emplace_back(p->column());
+        row_ptr[row + 1] = column_index.size();
+        std::sort(column_index.begin() + row_ptr[row], column_index.end());
+      }
+
+    setup_device_structure(row_ptr, column_index);
+
+    const cudaError_t error_code =
+      cudaMemset(val_dev.get(), 0, nnz * sizeof(Number));
+    AssertCuda(error_code);
+  }
+
+
+
+  template <typename Number>
+  void
+  SparseMatrix<Number>::setup_device_structure(
+    const std::vector<int> &row_ptr,
+    const std::vector<int> &column_index)
+  {
+    AssertDimension(row_ptr.size(), static_cast<std::size_t>(n_rows) + 1);
+    AssertDimension(column_index.size(), static_cast<std::size_t>(nnz));
+
+    val_dev.reset(Utilities::CUDA::allocate_device_data<Number>(nnz));
 
     // Copy the column indices to the gpu
     column_index_dev.reset(Utilities::CUDA::allocate_device_data<int>(nnz));
-    AssertCuda(error_code);
-    error_code = cudaMemcpy(column_index_dev.get(),
-                            column_index.data(),
-                            nnz * sizeof(int),
-                            cudaMemcpyHostToDevice);
+    cudaError_t error_code = cudaMemcpy(column_index_dev.get(),
+                                        column_index.data(),
+                                        nnz * sizeof(int),
+                                        cudaMemcpyHostToDevice);
     AssertCuda(error_code);
 
     // Copy the row pointer to the gpu
-    row_ptr_dev.reset(Utilities::CUDA::allocate_device_data<int>(row_ptr_size));
-    AssertCuda(error_code);
+    row_ptr_dev.reset(
+      Utilities::CUDA::allocate_device_data<int>(row_ptr.size()));
     error_code = cudaMemcpy(row_ptr_dev.get(),
                             row_ptr.data(),
-                            row_ptr_size * sizeof(int),
+                            row_ptr.size() * sizeof(int),
                             cudaMemcpyHostToDevice);
     AssertCuda(error_code);
 
-    // Create the matrix descriptor
-    cusparseStatus_t cusparse_error_code = cusparseCreateMatDescr(&descr);
-    AssertCusparse(cusparse_error_code);
-    cusparse_error_code =
-      cusparseSetMatType(descr, CUSPARSE_MATRIX_TYPE_GENERAL);
-    AssertCusparse(cusparse_error_code);
-    cusparse_error_code =
-      cusparseSetMatIndexBase(descr, CUSPARSE_INDEX_BASE_ZERO);
-    AssertCusparse(cusparse_error_code);
+    // Create the matrix descriptor unless it exists from a previous call,
+    // as the description only depends on the type and the index base
+    if (descr == nullptr)
+      {
+        cusparseStatus_t cusparse_error_code = cusparseCreateMatDescr(&descr);
+        AssertCusparse(cusparse_error_code);
+        cusparse_error_code =
+          cusparseSetMatType(descr, CUSPARSE_MATRIX_TYPE_GENERAL);
+        AssertCusparse(cusparse_error_code);
+        cusparse_error_code =
+          cusparseSetMatIndexBase(descr, CUSPARSE_INDEX_BASE_ZERO);
+        AssertCusparse(cusparse_error_code);
+      }
   }
 
 
@@ -14,12 +14,14 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/sparsity_pattern.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <functional>
 #include <numeric>
@@ -212,6 +214,15 @@ DynamicSparsityPattern::Line::add_entries(ForwardIterator begin,
 }
 
 
+void
+DynamicSparsityPattern::Line::compact()
+{
+  std::sort(entries.begin(), entries.end());
+  entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+}
+
+
+
 DynamicSparsityPattern::size_type
 DynamicSparsityPattern::Line::memory_consumption() const
 {
@@ -221,6 +232,8 @@ DynamicSparsityPattern::Line::memory_consumption() const
 
 DynamicSparsityPattern::DynamicSparsityPattern()
   : have_entries(false)
+  , thread_safe_insertion(false)
+  , lazy_insertion(false)
   , rows(0)
   , cols(0)
   , rowset(0)
@@ -231,6 +244,8 @@ DynamicSparsityPattern::DynamicSparsityPattern()
 DynamicSparsityPattern::DynamicSparsityPattern(const DynamicSparsityPattern &s)
   : Subscriptor()
   , have_entries(false)
+  , thread_safe_insertion(false)
+  , lazy_insertion(false)
   , rows(0)
   , cols(0)
   , rowset(0)
@@ -249,6 +264,8 @@ DynamicSparsityPattern::DynamicSparsityPattern(const size_type m,
                                                const size_type n,
                                                const IndexSet &rowset_)
   : have_entries(false)
+  , thread_safe_insertion(false)
+  , lazy_insertion(false)
   , rows(0)
   , cols(0)
   , rowset(0)
@@ -259,6 +276,8 @@ DynamicSparsityPattern::DynamicSparsityPattern(const size_type m,
 
 DynamicSparsityPattern::DynamicSparsityPattern(const IndexSet &rowset_)
   : have_entries(false)
+  , thread_safe_insertion(false)
+  , lazy_insertion(false)
   , rows(0)
   , cols(0)
   , rowset(0)
@@ -269,6 +288,8 @@ DynamicSparsityPattern::DynamicSparsityPattern(const IndexSet &rowset_)
 
 DynamicSparsityPattern::DynamicSparsityPattern(const size_type n)
   : have_entries(false)
+  , thread_safe_insertion(false)
+  , lazy_insertion(false)
   , rows(0)
   , cols(0)
   , rowset(0)
@@ -302,10 +323,12 @@ DynamicSparsityPattern::reinit(const size_type m,
                                const size_type n,
                                const IndexSet &rowset_)
 {
-  have_entries = false;
-  rows         = m;
-  cols         = n;
-  rowset       = rowset_;
+  have_entries          = false;
+  thread_safe_insertion = false;
+  lazy_insertion        = false;
+  rows                  = m;
+  cols                  = n;
+  rowset                = rowset_;
 
   Assert(rowset.size() == 0 || rowset.size() == m,
          ExcMessage(
@@ -322,9 +345,55 @@ DynamicSparsityPattern::reinit(const size_type m,
 
 
 
+void
+DynamicSparsityPattern::set_thread_safe_insertion(const bool thread_safe)
+{
+  thread_safe_insertion = thread_safe;
+
+  // add() and add_entries() would otherwise all write to this flag at the
+  // same time. setting it unconditionally is safe since it only enables
+  // shortcuts for a pattern without any entries
+  if (thread_safe)
+    have_entries = true;
+}
+
+
+
+std::mutex &
+DynamicSparsityPattern::get_row_mutex(const size_type rowindex)
+{
+  // consecutive rows, as they appear on one cell, get different mutexes
+  static std::array<std::mutex, 1024> row_mutexes;
+  return row_mutexes[rowindex % row_mutexes.size()];
+}
+
+
+
+void
+DynamicSparsityPattern::set_lazy_insertion()
+{
+  lazy_insertion = true;
+}
+
+
+
 void
 DynamicSparsityPattern::compress()
-{}
+{
+  if (!lazy_insertion)
+    return;
+
+  parallel::apply_to_subranges(
+    size_type(0),
+    size_type(lines.size()),
+    [this](const size_type begin, const size_type end) {
+      for (size_type i = begin; i < end; ++i)
+        lines[i].compact();
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
+
+  lazy_insertion = false;
+}
 
 
 
@@ -339,6 +408,8 @@ DynamicSparsityPattern::empty() const
 DynamicSparsityPattern::size_type
 DynamicSparsityPattern::max_entries_per_row() const
 {
+  Assert(!lazy_insertion, ExcLazyInsertion());
+
   if (!have_entries)
     return 0;
 
@@ -356,6 +427,7 @@ DynamicSparsityPattern::max_entries_per_row() const
 bool
 DynamicSparsityPattern::exists(const size_type i, const size_type j) const
 {
+  Assert(!lazy_insertion, ExcLazyInsertion());
   Assert(i < rows, ExcIndexRange(i, 0, rows));
   Assert(j < cols, ExcIndexRange(j, 0, cols));
   Assert(
@@ -385,6 +457,7 @@ DynamicSparsityPattern::exists(const size_type i, const size_type j) const
 void
 DynamicSparsityPattern::symmetrize()
 {
+  Assert(!lazy_insertion, ExcLazyInsertion());
   Assert(rows == cols, ExcNotQuadratic());
 
   // loop over all elements presently
@@ -438,6 +511,8 @@ DynamicSparsityPattern::clear_row(const size_type row)
 DynamicSparsityPattern
 DynamicSparsityPattern::get_view(const IndexSet &rows) const
 {
+  Assert(!lazy_insertion, ExcLazyInsertion());
+
   DynamicSparsityPattern view;
   view.reinit(rows.n_elements(), this->n_cols());
   AssertDimension(rows.size(), this->n_rows());
@@ -531,6 +606,8 @@ DynamicSparsityPattern::compute_mmult_pattern(
 void
 DynamicSparsityPattern::print(std::ostream &out) const
 {
+  Assert(!lazy_insertion, ExcLazyInsertion());
+
   for (size_type row = 0; row < lines.size(); ++row)
     {
       out << '[' << (rowset.size() == 0 ? row : rowset.nth_index_in_set(row));
@@ -549,6 +626,8 @@ DynamicSparsityPattern::print(std::ostream &out) const
 void
 DynamicSparsityPattern::print_gnuplot(std::ostream &out) const
 {
+  Assert(!lazy_insertion, ExcLazyInsertion());
+
   for (size_type row = 0; row < lines.size(); ++row)
     {
       const size_type rowindex =
@@ -572,6 +651,8 @@ DynamicSparsityPattern::print_gnuplot(std::ostream &out) const
 DynamicSparsityPattern::size_type
 DynamicSparsityPattern::bandwidth() const
 {
+  Assert(!lazy_insertion, ExcLazyInsertion());
+
   size_type b = 0;
   for (size_type row = 0; row < lines.size(); ++row)
     {
@@ -592,6 +673,8 @@ DynamicSparsityPattern::bandwidth() const
 DynamicSparsityPattern::size_type
 DynamicSparsityPattern::n_nonzero_elements() const
 {
+  Assert(!lazy_insertion, ExcLazyInsertion());
+
   if (!have_entries)
     return 0;
 
@@ -609,6 +692,8 @@ DynamicSparsityPattern::n_nonzero_elements() const
 IndexSet
 DynamicSparsityPattern::nonempty_cols() const
 {
+  Assert(!lazy_insertion, ExcLazyInsertion());
+
   std::set<types::global_dof_index> cols;
   for (const auto &line : lines)
     cols.insert(line.entries.begin(), line.entries.end());
@@ -623,6 +708,8 @@ DynamicSparsityPattern::nonempty_cols() const
 IndexSet
 DynamicSparsityPattern::nonempty_rows() const
 {
+  Assert(!lazy_insertion, ExcLazyInsertion());
+
   const IndexSet  all_rows            = complete_index_set(this->n_rows());
   const IndexSet &locally_stored_rows = rowset.size() == 0 ? all_rows : rowset;
 
@@ -969,6 +969,274 @@ ScaLAPACKMatrix<NumberType>::copy_to(ScaLAPACKMatrix<NumberType> &dest) const
 
 
 
+namespace internal
+{
+  namespace ScaLAPACKMatrixImplementation
+  {
+    /**
+     * Check that the distributed vectors @p columns match the rows of a
+     * matrix with @p n_rows rows whose process grid is built on
+     * @p communicator, and return the range of locally owned rows of the
+     * vectors on all processes.
+     */
+    template <typename NumberType>
+    std::vector<std::pair<types::global_dof_index, types::global_dof_index>>
+    gather_owned_rows(
+      const std::vector<LinearAlgebra::distributed::Vector<NumberType>>
+        &             columns,
+      const int       n_rows,
+      const MPI_Comm &communicator)
+    {
+      const std::pair<types::global_dof_index, types::global_dof_index>
+        local_range = columns[0].get_partitioner()->local_range();
+      for (const auto &column : columns)
+        {
+          Assert(int(column.size()) == n_rows,
+                 ExcDimensionMismatch(column.size(), n_rows));
+          Assert(column.get_partitioner()->local_range() == local_range,
+                 ExcMessage("All vectors must have the same parallel "
+                            "layout."));
+          (void)column;
+          (void)n_rows;
+        }
+
+#  ifdef DEBUG
+      int result = MPI_UNEQUAL;
+      MPI_Comm_compare(columns[0].get_mpi_communicator(),
+                       communicator,
+                       &result);
+      Assert(result == MPI_IDENT || result == MPI_CONGRUENT,
+             ExcMessage("The vectors must be distributed over the same "
+                        "processes as the process grid of the matrix."));
+#  endif
+
+      const unsigned int n_mpi_processes =
+        Utilities::MPI::n_mpi_processes(communicator);
+      const types::global_dof_index my_range[2] = {local_range.first,
+                                                   local_range.second};
+      std::vector<types::global_dof_index> all_ranges(2 * n_mpi_processes);
+      const int ierr = MPI_Allgather(my_range,
+                                     2,
+                                     DEAL_II_DOF_INDEX_MPI_TYPE,
+                                     all_ranges.data(),
+                                     2,
+                                     DEAL_II_DOF_INDEX_MPI_TYPE,
+                                     communicator);
+      AssertThrowMPI(ierr);
+
+      std::vector<std::pair<types::global_dof_index, types::global_dof_index>>
+        owned_rows(n_mpi_processes);
+      for (unsigned int p = 0; p < n_mpi_processes; ++p)
+        owned_rows[p] =
+          std::make_pair(all_ranges[2 * p], all_ranges[2 * p + 1]);
+      return owned_rows;
+    }
+  } // namespace ScaLAPACKMatrixImplementation
+} // namespace internal
+
+
+
+template <typename NumberType>
+void
+ScaLAPACKMatrix<NumberType>::copy_from(
+  const std::vector<LinearAlgebra::distributed::Vector<NumberType>> &columns)
+{
+  Assert(n_columns == int(columns.size()),
+         ExcDimensionMismatch(n_columns, columns.size()));
+  if (n_rows * n_columns == 0)
+    return;
+
+  const MPI_Comm &   communicator = grid->mpi_communicator;
+  const unsigned int n_mpi_processes =
+    Utilities::MPI::n_mpi_processes(communicator);
+  const auto owned_rows =
+    internal::ScaLAPACKMatrixImplementation::gather_owned_rows(columns,
+                                                               n_rows,
+                                                               communicator);
+  const auto &my_rows =
+    owned_rows[Utilities::MPI::this_mpi_process(communicator)];
+
+  // the process row and column of the grid owning a row or column of the
+  // block-cyclic distribution. the processes of the grid are numbered by
+  // rows, see the constructor of ProcessGrid
+  const auto process_row = [this](const unsigned int i) -> int {
+    return (i / row_block_size + first_process_row) % grid->n_process_rows;
+  };
+  std::vector<int> process_column(n_columns);
+  for (int j = 0; j < n_columns; ++j)
+    process_column[j] =
+      (j / column_block_size + first_process_column) % grid->n_process_columns;
+
+  // count and pack the entries of the locally owned rows by the process
+  // owning them in the matrix
+  std::vector<int> send_counts(n_mpi_processes), send_offsets(n_mpi_processes);
+  for (types::global_dof_index i = my_rows.first; i < my_rows.second; ++i)
+    {
+      const int offset = process_row(i) * grid->n_process_columns;
+      for (int j = 0; j < n_columns; ++j)
+        ++send_counts[offset + process_column[j]];
+    }
+  for (unsigned int p = 1; p < n_mpi_processes; ++p)
+    send_offsets[p] = send_offsets[p - 1] + send_counts[p - 1];
+
+  std::vector<NumberType> send_buffer(send_offsets.back() +
+                                      send_counts.back());
+  {
+    std::vector<int> position(send_offsets);
+    for (types::global_dof_index i = my_rows.first; i < my_rows.second; ++i)
+      {
+        const int offset = process_row(i) * grid->n_process_columns;
+        for (int j = 0; j < n_columns; ++j)
+          send_buffer[position[offset + process_column[j]]++] =
+            columns[j].local_element(i - my_rows.first);
+      }
+  }
+
+  // the receiving processes walk through the rows of the sending processes
+  // in the same order, picking the locally owned columns
+  std::vector<int> recv_counts(n_mpi_processes), recv_offsets(n_mpi_processes);
+  if (grid->mpi_process_is_active)
+    for (unsigned int p = 0; p < n_mpi_processes; ++p)
+      for (types::global_dof_index i = owned_rows[p].first;
+           i < owned_rows[p].second;
+           ++i)
+        if (process_row(i) == grid->this_process_row)
+          recv_counts[p] += n_local_columns;
+  for (unsigned int p = 1; p < n_mpi_processes; ++p)
+    recv_offsets[p] = recv_offsets[p - 1] + recv_counts[p - 1];
+
+  std::vector<NumberType> recv_buffer(recv_offsets.back() +
+                                      recv_counts.back());
+  const int               ierr =
+    MPI_Alltoallv(send_buffer.data(),
+                  send_counts.data(),
+                  send_offsets.data(),
+                  Utilities::MPI::internal::mpi_type_id(send_buffer.data()),
+                  recv_buffer.data(),
+                  recv_counts.data(),
+                  recv_offsets.data(),
+                  Utilities::MPI::internal::mpi_type_id(recv_buffer.data()),
+                  communicator);
+  AssertThrowMPI(ierr);
+
+  if (grid->mpi_process_is_active)
+    {
+      const NumberType *entry = recv_buffer.data();
+      for (unsigned int p = 0; p < n_mpi_processes; ++p)
+        for (types::global_dof_index i = owned_rows[p].first;
+             i < owned_rows[p].second;
+             ++i)
+          if (process_row(i) == grid->this_process_row)
+            {
+              const unsigned int loc_row =
+                (i / row_block_size / grid->n_process_rows) * row_block_size +
+                i % row_block_size;
+              for (int j = 0; j < n_local_columns; ++j)
+                local_el(loc_row, j) = *entry++;
+            }
+    }
+
+  state = LAPACKSupport::matrix;
+}
+
+
+
+template <typename NumberType>
+void
+ScaLAPACKMatrix<NumberType>::copy_to(
+  std::vector<LinearAlgebra::distributed::Vector<NumberType>> &columns) const
+{
+  Assert(n_columns == int(columns.size()),
+         ExcDimensionMismatch(n_columns, columns.size()));
+  if (n_rows * n_columns == 0)
+    return;
+
+  const MPI_Comm &   communicator = grid->mpi_communicator;
+  const unsigned int n_mpi_processes =
+    Utilities::MPI::n_mpi_processes(communicator);
+  const auto owned_rows =
+    internal::ScaLAPACKMatrixImplementation::gather_owned_rows(columns,
+                                                               n_rows,
+                                                               communicator);
+  const auto &my_rows =
+    owned_rows[Utilities::MPI::this_mpi_process(communicator)];
+
+  // this is the inverse of the exchange in copy_from(), with the roles of
+  // the send and receive buffers interchanged
+  const auto process_row = [this](const unsigned int i) -> int {
+    return (i / row_block_size + first_process_row) % grid->n_process_rows;
+  };
+  std::vector<int> process_column(n_columns);
+  for (int j = 0; j < n_columns; ++j)
+    process_column[j] =
+      (j / column_block_size + first_process_column) % grid->n_process_columns;
+
+  std::vector<int> send_counts(n_mpi_processes), send_offsets(n_mpi_processes);
+  if (grid->mpi_process_is_active)
+    for (unsigned int p = 0; p < n_mpi_processes; ++p)
+      for (types::global_dof_index i = owned_rows[p].first;
+           i < owned_rows[p].second;
+           ++i)
+        if (process_row(i) == grid->this_process_row)
+          send_counts[p] += n_local_columns;
+  for (unsigned int p = 1; p < n_mpi_processes; ++p)
+    send_offsets[p] = send_offsets[p - 1] + send_counts[p - 1];
+
+  std::vector<NumberType> send_buffer(send_offsets.back() +
+                                      send_counts.back());
+  if (grid->mpi_process_is_active)
+    {
+      NumberType *entry = send_buffer.data();
+      for (unsigned int p = 0; p < n_mpi_processes; ++p)
+        for (types::global_dof_index i = owned_rows[p].first;
+             i < owned_rows[p].second;
+             ++i)
+          if (process_row(i) == grid->this_process_row)
+            {
+              const unsigned int loc_row =
+                (i / row_block_size / grid->n_process_rows) * row_block_size +
+                i % row_block_size;
+              for (int j = 0; j < n_local_columns; ++j)
+                *entry++ = local_el(loc_row, j);
+            }
+    }
+
+  std::vector<int> recv_counts(n_mpi_processes), recv_offsets(n_mpi_processes);
+  for (types::global_dof_index i = my_rows.first; i < my_rows.second; ++i)
+    {
+      const int offset = process_row(i) * grid->n_process_columns;
+      for (int j = 0; j < n_columns; ++j)
+        ++recv_counts[offset + process_column[j]];
+    }
+  for (unsigned int p = 1; p < n_mpi_processes; ++p)
+    recv_offsets[p] = recv_offsets[p - 1] + recv_counts[p - 1];
+
+  std::vector<NumberType> recv_buffer(recv_offsets.back() +
+                                      recv_counts.back());
+  const int               ierr =
+    MPI_Alltoallv(send_buffer.data(),
+                  send_counts.data(),
+                  send_offsets.data(),
+                  Utilities::MPI::internal::mpi_type_id(send_buffer.data()),
+                  recv_buffer.data(),
+                  recv_counts.data(),
+                  recv_offsets.data(),
+                  Utilities::MPI::internal::mpi_type_id(recv_buffer.data()),
+                  communicator);
+  AssertThrowMPI(ierr);
+
+  std::vector<int> position(recv_offsets);
+  for (types::global_dof_index i = my_rows.first; i < my_rows.second; ++i)
+    {
+      const int offset = process_row(i) * grid->n_process_columns;
+      for (int j = 0; j < n_columns; ++j)
+        columns[j].local_element(i - my_rows.first) =
+          recv_buffer[position[offset + process_column[j]]++];
+    }
+}
+
+
+
 template <typename NumberType>
 void
 ScaLAPACKMatrix<NumberType>::copy_transposed(
@@ -19,6 +19,7 @@
 
 #include <deal.II/lac/solver_control.h>
 
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 
@@ -59,7 +60,12 @@ SolverControl::check(const unsigned int step, const double check_value)
       initial_val = check_value;
     }
 
-  if (m_log_history && ((step % m_log_frequency) == 0))
+  // formatting the output is not for free, so skip it if deallog would
+  // discard it anyway
+  const bool log_output =
+    (m_log_history || m_log_result) && deallog.is_output_enabled();
+
+  if (log_output && m_log_history && ((step % m_log_frequency) == 0))
     deallog << "Check " << step << "\t" << check_value << std::endl;
 
   lstep  = step;
@@ -70,8 +76,16 @@ SolverControl::check(const unsigned int step, const double check_value)
       if (check_failure)
         failure_residual = relative_failure_residual * check_value;
 
-      if (m_log_result)
+      if (log_output && m_log_result)
         deallog << "Starting value " << check_value << std::endl;
+
+      // make room for the entries of a typical solve, such that usually no
+      // memory is allocated during the iteration. maxsteps is often set to
+      // the size of the linear system, so it is only used up to a moderate
+      // bound, and longer histories grow geometrically as usual
+      if (history_data_enabled)
+        history_data.reserve(history_data.size() +
+                             std::min(maxsteps, 1000u) + 1);
     }
 
   if (history_data_enabled)
@@ -79,7 +93,7 @@ SolverControl::check(const unsigned int step, const double check_value)
 
   if (check_value <= tol)
     {
-      if (m_log_result)
+      if (log_output && m_log_result)
         deallog << "Convergence step " << step << " value " << check_value
                 << std::endl;
       lcheck = success;
@@ -89,7 +103,7 @@ SolverControl::check(const unsigned int step, const double check_value)
   if ((step >= maxsteps) || std::isnan(check_value) ||
       (check_failure && (check_value > failure_residual)))
     {
-      if (m_log_result)
+      if (log_output && m_log_result)
         deallog << "Failure step " << step << " value " << check_value
                 << std::endl;
       lcheck = failure;
@@ -272,7 +286,7 @@ ReductionControl::check(const unsigned int step, const double check_value)
   // residual already was zero
   if (check_value <= reduced_tol)
     {
-      if (m_log_result)
+      if (m_log_result && deallog.is_output_enabled())
         deallog << "Convergence step " << step << " value " << check_value
                 << std::endl;
       lstep  = step;
@@ -325,7 +339,7 @@ IterationNumberControl::check(const unsigned int step, const double check_value)
   // success in that case. Otherwise, go on to the check of the base class.
   if (step >= this->maxsteps)
     {
-      if (m_log_result)
+      if (m_log_result && deallog.is_output_enabled())
         deallog << "Convergence step " << step << " value " << check_value
                 << std::endl;
       lstep  = step;
@@ -195,9 +195,20 @@ template <class Matrix>
 void
 SparseDirectUMFPACK::factorize(const Matrix &matrix)
 {
-  Assert(matrix.m() == matrix.n(), ExcNotQuadratic())
+  Assert(matrix.m() == matrix.n(), ExcNotQuadratic());
 
-    clear();
+  // free the previous numeric factorization, but keep the symbolic one
+  // together with the sparsity pattern it was computed for, so that we can
+  // reuse it below if the sparsity pattern has not changed
+  if (numeric_decomposition != nullptr)
+    {
+      umfpack_dl_free_numeric(&numeric_decomposition);
+      numeric_decomposition = nullptr;
+    }
+
+  std::vector<types::suitesparse_index> previous_Ap, previous_Ai;
+  previous_Ap.swap(Ap);
+  previous_Ai.swap(Ai);
 
   _m = matrix.m();
   _n = matrix.n();
@@ -268,17 +279,29 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
   // different function
   sort_arrays(matrix);
 
+  // the symbolic factorization only depends on the sparsity pattern, so
+  // only recompute it if the pattern differs from the previous one
+  if (symbolic_decomposition != nullptr &&
+      (Ap != previous_Ap || Ai != previous_Ai))
+    {
+      umfpack_dl_free_symbolic(&symbolic_decomposition);
+      symbolic_decomposition = nullptr;
+    }
+
   int status;
-  status = umfpack_dl_symbolic(N,
-                               N,
-                               Ap.data(),
-                               Ai.data(),
-                               Ax.data(),
-                               &symbolic_decomposition,
-                               control.data(),
-                               nullptr);
-  AssertThrow(status == UMFPACK_OK,
-              ExcUMFPACKError("umfpack_dl_symbolic", status));
+  if (symbolic_decomposition == nullptr)
+    {
+      status = umfpack_dl_symbolic(N,
+                                   N,
+                                   Ap.data(),
+                                   Ai.data(),
+                                   Ax.data(),
+                                   &symbolic_decomposition,
+                                   control.data(),
+                                   nullptr);
+      AssertThrow(status == UMFPACK_OK,
+                  ExcUMFPACKError("umfpack_dl_symbolic", status));
+    }
 
   status = umfpack_dl_numeric(Ap.data(),
                               Ai.data(),
@@ -289,8 +312,6 @@ SparseDirectUMFPACK::factorize(const Matrix &matrix)
                               nullptr);
   AssertThrow(status == UMFPACK_OK,
               ExcUMFPACKError("umfpack_dl_numeric", status));
-
-  umfpack_dl_free_symbolic(&symbolic_decomposition);
 }
 
 
@@ -342,6 +363,54 @@ SparseDirectUMFPACK::solve(BlockVector<double> &rhs_and_solution,
 
 
 
+void
+SparseDirectUMFPACK::solve(FullMatrix<double> &rhs_and_solution,
+                           bool                transpose /*=false*/) const
+{
+  // make sure that some kind of factorize() call has happened before
+  Assert(Ap.size() != 0, ExcNotInitialized());
+  Assert(Ai.size() != 0, ExcNotInitialized());
+  Assert(Ai.size() == Ax.size(), ExcNotInitialized());
+  AssertDimension(rhs_and_solution.m(), Ap.size() - 1);
+
+  const size_type N = rhs_and_solution.m();
+
+  // umfpack_dl_solve allocates its work arrays in every call, so use the
+  // variant that takes them as arguments and allocate them only once. the
+  // size of W allows for iterative refinement
+  std::vector<types::suitesparse_index> Wi(N);
+  std::vector<double>                   W(5 * N);
+
+  // the columns of a FullMatrix are not contiguous, so copy each right
+  // hand side into a vector of its own
+  Vector<double> rhs(N), solution(N);
+  for (size_type column = 0; column < rhs_and_solution.n(); ++column)
+    {
+      for (size_type i = 0; i < N; ++i)
+        rhs(i) = rhs_and_solution(i, column);
+
+      // see the solve() function above for the choice of UMFPACK_At
+      const int status = umfpack_dl_wsolve(transpose ? UMFPACK_A : UMFPACK_At,
+                                           Ap.data(),
+                                           Ai.data(),
+                                           Ax.data(),
+                                           solution.begin(),
+                                           rhs.begin(),
+                                           numeric_decomposition,
+                                           control.data(),
+                                           nullptr,
+                                           Wi.data(),
+                                           W.data());
+      AssertThrow(status == UMFPACK_OK,
+                  ExcUMFPACKError("umfpack_dl_wsolve", status));
+
+      for (size_type i = 0; i < N; ++i)
+        rhs_and_solution(i, column) = solution(i);
+    }
+}
+
+
+
 template <class Matrix>
 void
 SparseDirectUMFPACK::solve(const Matrix &  matrix,
@@ -413,6 +482,17 @@ SparseDirectUMFPACK::solve(BlockVector<double> &, bool) const
 }
 
 
+
+void
+SparseDirectUMFPACK::solve(FullMatrix<double> &, bool) const
+{
+  AssertThrow(
+    false,
+    ExcMessage(
+      "To call this function you need UMFPACK, but you configured deal.II without passing the necessary switch to 'cmake'. Please consult the installation instructions in doc/readme.html."));
+}
+
+
 template <class Matrix>
 void
 SparseDirectUMFPACK::solve(const Matrix &, Vector<double> &, bool)
@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/std_cxx14/memory.h>
 #include <deal.II/base/utilities.h>
 
@@ -297,11 +298,13 @@ SparsityPattern::reinit(const size_type                      m,
       rowstart = std_cxx14::make_unique<std::size_t[]>(max_dim + 1);
     }
 
-  // allocate memory for the column numbers if necessary
+  // allocate memory for the column numbers if necessary. the array is not
+  // value-initialized here since it is filled below in parallel, which also
+  // distributes the first touch of the memory pages among the threads
   if (vec_len > max_vec_len)
     {
       max_vec_len = vec_len;
-      colnums     = std_cxx14::make_unique<size_type[]>(max_vec_len);
+      colnums.reset(new size_type[max_vec_len]);
     }
 
   // set the rowstart array
@@ -317,14 +320,23 @@ SparsityPattern::reinit(const size_type                      m,
            ((vec_len == 1) && (rowstart[rows] == 0)),
          ExcInternalError());
 
-  // preset the column numbers by a value indicating it is not in use
-  std::fill_n(colnums.get(), vec_len, invalid_entry);
-
-  // if diagonal elements are special: let the first entry in each row be the
+  // preset the column numbers by a value indicating it is not in use. if
+  // diagonal elements are special: let the first entry in each row be the
   // diagonal value
-  if (store_diagonal_first_in_row)
-    for (size_type i = 0; i < rows; ++i)
-      colnums[rowstart[i]] = i;
+  if (rowstart[rows] == 0)
+    colnums[0] = invalid_entry;
+  parallel::apply_to_subranges(
+    size_type(0),
+    rows,
+    [this](const size_type begin, const size_type end) {
+      std::fill(colnums.get() + rowstart[begin],
+                colnums.get() + rowstart[end],
+                invalid_entry);
+      if (store_diagonal_first_in_row)
+        for (size_type i = begin; i < end; ++i)
+          colnums[rowstart[i]] = i;
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
 
   compressed = false;
 }
@@ -484,29 +496,28 @@ SparsityPattern::copy_from(const SparsityPattern &sp)
 // the column_number method to gain faster access to the
 // entries. DynamicSparsityPattern::iterator can show quadratic complexity in
 // case many rows are empty and the begin() method needs to jump to the next
-// free row. Otherwise, the code is exactly the same as above.
+// free row. Otherwise, the code is exactly the same as above, except that
+// both the pass counting the row lengths and the pass filling in the column
+// indices work on the rows in parallel.
 void
 SparsityPattern::copy_from(const DynamicSparsityPattern &dsp)
 {
   const bool  do_diag_optimize = (dsp.n_rows() == dsp.n_cols());
   const auto &row_index_set    = dsp.row_index_set();
 
+  // make sure the index set does not get compressed concurrently by
+  // is_element() below
+  row_index_set.compress();
+
   std::vector<unsigned int> row_lengths(dsp.n_rows());
 
-  if (row_index_set.size() == 0)
-    {
-      for (size_type i = 0; i < dsp.n_rows(); ++i)
-        {
-          row_lengths[i] = dsp.row_length(i);
-          if (do_diag_optimize && !dsp.exists(i, i))
-            ++row_lengths[i];
-        }
-    }
-  else
-    {
-      for (size_type i = 0; i < dsp.n_rows(); ++i)
+  parallel::apply_to_subranges(
+    size_type(0),
+    dsp.n_rows(),
+    [&](const size_type begin, const size_type end) {
+      for (size_type i = begin; i < end; ++i)
         {
-          if (row_index_set.is_element(i))
+          if (row_index_set.size() == 0 || row_index_set.is_element(i))
             {
               row_lengths[i] = dsp.row_length(i);
               if (do_diag_optimize && !dsp.exists(i, i))
@@ -521,21 +532,29 @@ SparsityPattern::copy_from(const DynamicSparsityPattern &dsp)
               row_lengths[i] = do_diag_optimize ? 1 : 0;
             }
         }
-    }
+    },
+    internal::SparseMatrixImplementation::minimum_parallel_grain_size);
   reinit(dsp.n_rows(), dsp.n_cols(), row_lengths);
 
   if (n_rows() != 0 && n_cols() != 0)
-    for (size_type row = 0; row < dsp.n_rows(); ++row)
-      {
-        size_type *cols = &colnums[rowstart[row]] + (do_diag_optimize ? 1 : 0);
-        const unsigned int row_length = dsp.row_length(row);
-        for (unsigned int index = 0; index < row_length; ++index)
+    parallel::apply_to_subranges(
+      size_type(0),
+      dsp.n_rows(),
+      [&](const size_type begin, const size_type end) {
+        for (size_type row = begin; row < end; ++row)
           {
-            const size_type col = dsp.column_number(row, index);
-            if ((col != row) || !do_diag_optimize)
-              *cols++ = col;
+            size_type *cols =
+              &colnums[rowstart[row]] + (do_diag_optimize ? 1 : 0);
+            const unsigned int row_length = dsp.row_length(row);
+            for (unsigned int index = 0; index < row_length; ++index)
+              {
+                const size_type col = dsp.column_number(row, index);
+                if ((col != row) || !do_diag_optimize)
+                  *cols++ = col;
+              }
           }
-      }
+      },
+      internal::SparseMatrixImplementation::minimum_parallel_grain_size);
 
   // do not need to compress the sparsity pattern since we already have
   // allocated the right amount of data, and the SparsityPatternType data is
@@ -27,6 +27,7 @@
 
 #ifdef DEAL_II_WITH_MPI
 #  include <deal.II/base/mpi.h>
+#  include <deal.II/base/parallel.h>
 #  include <deal.II/base/utilities.h>
 
 #  include <deal.II/lac/block_sparsity_pattern.h>
@@ -913,6 +914,125 @@ namespace SparsityTools
 
 #ifdef DEAL_II_WITH_MPI
 
+  namespace internal
+  {
+    /**
+     * The process of the consensus algorithm that sends the rows of a
+     * sparsity pattern to their owners. The rows are packed into one
+     * contiguous buffer per destination in the format
+     * <tt>row, n_entries, column_0, ..., column_{n_entries-1}</tt>. The
+     * requests carry the rows, and the answers are empty.
+     */
+    class SparsityPatternRowExchange
+      : public Utilities::MPI::ConsensusAlgorithmProcess<
+          DynamicSparsityPattern::size_type,
+          unsigned int>
+    {
+    public:
+      using size_type = DynamicSparsityPattern::size_type;
+
+      SparsityPatternRowExchange(
+        std::map<unsigned int, std::vector<size_type>> &send_data)
+        : send_data(send_data)
+      {}
+
+      virtual std::vector<unsigned int>
+      compute_targets() override
+      {
+        std::vector<unsigned int> targets;
+        targets.reserve(send_data.size());
+        for (const auto &data : send_data)
+          targets.push_back(data.first);
+        return targets;
+      }
+
+      virtual void
+      pack_recv_buffer(const int               other_rank,
+                       std::vector<size_type> &send_buffer) override
+      {
+        send_buffer.swap(send_data[other_rank]);
+      }
+
+      virtual void
+      process_request(const unsigned int,
+                      const std::vector<size_type> &buffer_recv,
+                      std::vector<unsigned int> &) override
+      {
+        received_data.push_back(buffer_recv);
+      }
+
+      /**
+       * The buffers received from other processes.
+       */
+      std::vector<std::vector<size_type>> received_data;
+
+    private:
+      std::map<unsigned int, std::vector<size_type>> &send_data;
+    };
+
+
+
+    /**
+     * Add the rows received in the format of SparsityPatternRowExchange to
+     * @p dsp. Several processes may send entries of the same row, so the
+     * rows are sorted first and each row is then filled by a single task,
+     * which allows to insert different rows concurrently.
+     */
+    void
+    add_received_rows(
+      DynamicSparsityPattern &                                 dsp,
+      const std::vector<std::vector<types::global_dof_index>> &received_data)
+    {
+      using size_type = DynamicSparsityPattern::size_type;
+
+      // collect (row, position of the row in the buffers) for all rows
+      std::vector<std::pair<size_type, const size_type *>> rows;
+      for (const auto &recv_buf : received_data)
+        {
+          const size_type *ptr = recv_buf.data();
+          const size_type *end = recv_buf.data() + recv_buf.size();
+          while (ptr != end)
+            {
+              rows.emplace_back(ptr[0], ptr);
+              Assert(ptr + 1 != end, ExcInternalError());
+              Assert(ptr + 2 + ptr[1] <= end, ExcInternalError());
+              ptr += 2 + ptr[1];
+            }
+        }
+      if (rows.empty())
+        return;
+
+      std::sort(rows.begin(),
+                rows.end(),
+                [](const std::pair<size_type, const size_type *> &a,
+                   const std::pair<size_type, const size_type *> &b) {
+                  return a.first < b.first;
+                });
+
+      std::vector<unsigned int> row_starts;
+      for (unsigned int i = 0; i < rows.size(); ++i)
+        if (i == 0 || rows[i].first != rows[i - 1].first)
+          row_starts.push_back(i);
+      row_starts.push_back(rows.size());
+
+      const auto add_rows = [&](const unsigned int begin,
+                                const unsigned int end) {
+        for (unsigned int i = row_starts[begin]; i < row_starts[end]; ++i)
+          dsp.add_entries(rows[i].first,
+                          rows[i].second + 2,
+                          rows[i].second + 2 + rows[i].second[1],
+                          true);
+      };
+
+      // add the first row before spawning tasks, which sets the flag for
+      // entries in dsp that would otherwise be written concurrently
+      add_rows(0, 1);
+      parallel::apply_to_subranges(1U, row_starts.size() - 1, add_rows, 64);
+    }
+  } // namespace internal
+
+
+
   void
   gather_sparsity_pattern(DynamicSparsityPattern &     dsp,
                           const std::vector<IndexSet> &owned,
@@ -1048,6 +1168,24 @@ namespace SparsityTools
 
     map_vec_t send_data;
 
+    // determine the size of the buffer for each destination first, such that
+    // the rows can be packed without reallocation
+    {
+      std::map<unsigned int, DynamicSparsityPattern::size_type> send_sizes;
+      unsigned int dest_cpu = 0;
+      for (const auto &row : myrange_non_owned)
+        {
+          while (row >= start_index[dest_cpu + 1])
+            ++dest_cpu;
+
+          const auto rlen = dsp.row_length(row);
+          if (rlen > 0)
+            send_sizes[dest_cpu] += 2 + rlen;
+        }
+      for (const auto &size : send_sizes)
+        send_data[size.first].reserve(size.second);
+    }
+
     {
       unsigned int dest_cpu = 0;
       for (const auto &row : myrange_non_owned)
@@ -1066,37 +1204,27 @@ namespace SparsityTools
             continue;
 
           // save entries
-          send_data[dest_cpu].push_back(row);  // row index
-          send_data[dest_cpu].push_back(rlen); // number of entries
+          std::vector<DynamicSparsityPattern::size_type> &dst =
+            send_data[dest_cpu];
+          dst.push_back(row);  // row index
+          dst.push_back(rlen); // number of entries
           for (DynamicSparsityPattern::size_type c = 0; c < rlen; ++c)
-            {
-              // columns
-              const auto column = dsp.column_number(row, c);
-              send_data[dest_cpu].push_back(column);
-            }
+            dst.push_back(dsp.column_number(row, c)); // columns
         }
     }
 
-    const auto receive_data = Utilities::MPI::some_to_some(mpi_comm, send_data);
+    // send the rows to their owners. the consensus algorithm finds the
+    // processes that send to us without a collective operation over all
+    // processes
+    internal::SparsityPatternRowExchange process(send_data);
+    Utilities::MPI::ConsensusAlgorithmSelector<
+      DynamicSparsityPattern::size_type,
+      unsigned int>
+      consensus_algorithm(process, mpi_comm);
+    consensus_algorithm.run();
 
     // add what we received
-    for (const auto &data : receive_data)
-      {
-        const auto &recv_buf = data.second;
-        auto        ptr      = recv_buf.begin();
-        const auto  end      = recv_buf.end();
-        while (ptr != end)
-          {
-            const auto row = *(ptr++);
-            Assert(ptr != end, ExcInternalError());
-            const auto n_entries = *(ptr++);
-
-            Assert(ptr + (n_entries - 1) != end, ExcInternalError());
-            dsp.add_entries(row, ptr, ptr + n_entries, true);
-            ptr += n_entries;
-          }
-        Assert(ptr == end, ExcInternalError());
-      }
+    internal::add_received_rows(dsp, process.received_data);
   }
 
   void
@@ -48,7 +48,8 @@ namespace TrilinosWrappers
     const unsigned int                    smoother_overlap,
     const bool                            output_details,
     const char *                          smoother_type,
-    const char *                          coarse_type)
+    const char *                          coarse_type,
+    const bool                            reuse_hierarchy)
     : elliptic(elliptic)
     , higher_order_elements(higher_order_elements)
     , n_cycles(n_cycles)
@@ -60,6 +61,7 @@ namespace TrilinosWrappers
     , output_details(output_details)
     , smoother_type(smoother_type)
     , coarse_type(coarse_type)
+    , reuse_hierarchy(reuse_hierarchy)
   {}
 
 
@@ -114,6 +116,10 @@ namespace TrilinosWrappers
     parameter_list.set("aggregation: threshold", aggregation_threshold);
     parameter_list.set("coarse: max size", 2000);
 
+    // keep the aggregates such that reinit() only needs to recompute the
+    // Galerkin products after a change of the matrix values
+    parameter_list.set("reuse: enable", reuse_hierarchy);
+
     if (output_details)
       parameter_list.set("ML output", 10);
     else
@@ -311,7 +317,11 @@ namespace TrilinosWrappers
   {
     ML_Epetra::MultiLevelPreconditioner *multilevel_operator =
       dynamic_cast<ML_Epetra::MultiLevelPreconditioner *>(preconditioner.get());
-    multilevel_operator->ReComputePreconditioner();
+    Assert(multilevel_operator != nullptr,
+           ExcMessage("The preconditioner needs to be initialized before "
+                      "it can be recomputed."));
+    const int ierr = multilevel_operator->ReComputePreconditioner();
+    AssertThrow(ierr == 0, ExcTrilinosError(ierr));
   }
 
 
@@ -0,0 +1,647 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/vector_snapshot_store.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+#ifdef DEAL_II_WITH_ZLIB
+#  include <zlib.h>
+#endif
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace VectorSnapshotStoreImplementation
+  {
+    /**
+     * The number of bytes of the rearranged data compressed independently
+     * of each other.
+     */
+    const std::size_t block_size = 1 << 20;
+
+
+
+    /**
+     * Return the number of blocks of @p n_bytes bytes of data.
+     */
+    inline std::size_t
+    n_blocks(const std::size_t n_bytes)
+    {
+      return (n_bytes + block_size - 1) / block_size;
+    }
+
+
+
+    /**
+     * Write the bytes of the @p n_values values of @p size bytes each in
+     * @p values to @p shuffled such that byte @p b of all values comes
+     * before byte @p b+1 of all values.
+     */
+    void
+    shuffle_bytes(const char *      values,
+                  const std::size_t n_values,
+                  const std::size_t size,
+                  char *            shuffled)
+    {
+      for (std::size_t i = 0; i < n_values; ++i)
+        for (std::size_t b = 0; b < size; ++b)
+          shuffled[b * n_values + i] = values[i * size + b];
+    }
+
+
+
+    /**
+     * The inverse of shuffle_bytes().
+     */
+    void
+    unshuffle_bytes(const char *      shuffled,
+                    const std::size_t n_values,
+                    const std::size_t size,
+                    char *            values)
+    {
+      for (std::size_t i = 0; i < n_values; ++i)
+        for (std::size_t b = 0; b < size; ++b)
+          values[i * size + b] = shuffled[b * n_values + i];
+    }
+
+
+
+    /**
+     * Compress the blocks of @p data in parallel. The compressed blocks are
+     * written one after the other to @p compressed, and their sizes to
+     * @p block_sizes. Without zlib, the blocks are copied unchanged.
+     */
+    void
+    compress_blocks(const std::vector<char> & data,
+                    std::vector<char> &       compressed,
+                    std::vector<std::size_t> &block_sizes)
+    {
+      const std::size_t n = n_blocks(data.size());
+      std::vector<std::vector<char>> compressed_blocks(n);
+      parallel::apply_to_subranges(
+        std::size_t(0),
+        n,
+        [&](const std::size_t begin, const std::size_t end) {
+          for (std::size_t b = begin; b < end; ++b)
+            {
+              const std::size_t offset = b * block_size;
+              const std::size_t length =
+                std::min(block_size, data.size() - offset);
+#ifdef DEAL_II_WITH_ZLIB
+              uLongf compressed_length = compressBound(length);
+              compressed_blocks[b].resize(compressed_length);
+              const int err =
+                compress2(reinterpret_cast<Bytef *>(
+                            compressed_blocks[b].data()),
+                          &compressed_length,
+                          reinterpret_cast<const Bytef *>(data.data()) +
+                            offset,
+                          length,
+                          Z_BEST_SPEED);
+              (void)err;
+              Assert(err == Z_OK, ExcInternalError());
+              compressed_blocks[b].resize(compressed_length);
+#else
+              compressed_blocks[b].assign(data.begin() + offset,
+                                          data.begin() + offset + length);
+#endif
+            }
+        },
+        1);
+
+      block_sizes.resize(n);
+      std::size_t total_size = 0;
+      for (std::size_t b = 0; b < n; ++b)
+        {
+          block_sizes[b] = compressed_blocks[b].size();
+          total_size += block_sizes[b];
+        }
+      compressed.clear();
+      compressed.reserve(total_size);
+      for (std::size_t b = 0; b < n; ++b)
+        compressed.insert(compressed.end(),
+                          compressed_blocks[b].begin(),
+                          compressed_blocks[b].end());
+    }
+
+
+
+    /**
+     * The inverse of compress_blocks(): decompress the blocks in
+     * @p compressed into @p data, which must already have the size of the
+     * uncompressed data.
+     */
+    void
+    decompress_blocks(const std::vector<char> &       compressed,
+                      const std::vector<std::size_t> &block_sizes,
+                      std::vector<char> &             data)
+    {
+      const std::size_t n = block_sizes.size();
+      AssertDimension(n, n_blocks(data.size()));
+      std::vector<std::size_t> block_offsets(n + 1, 0);
+      for (std::size_t b = 0; b < n; ++b)
+        block_offsets[b + 1] = block_offsets[b] + block_sizes[b];
+      AssertDimension(block_offsets[n], compressed.size());
+
+      parallel::apply_to_subranges(
+        std::size_t(0),
+        n,
+        [&](const std::size_t begin, const std::size_t end) {
+          for (std::size_t b = begin; b < end; ++b)
+            {
+              const std::size_t offset = b * block_size;
+              const std::size_t length =
+                std::min(block_size, data.size() - offset);
+#ifdef DEAL_II_WITH_ZLIB
+              uLongf    uncompressed_length = length;
+              const int err =
+                uncompress(reinterpret_cast<Bytef *>(data.data()) + offset,
+                           &uncompressed_length,
+                           reinterpret_cast<const Bytef *>(
+                             compressed.data()) +
+                             block_offsets[b],
+                           block_sizes[b]);
+              (void)err;
+              Assert(err == Z_OK && uncompressed_length == length,
+                     ExcInternalError());
+#else
+              (void)length;
+              std::copy(compressed.begin() + block_offsets[b],
+                        compressed.begin() + block_offsets[b + 1],
+                        data.begin() + offset);
+#endif
+            }
+        },
+        1);
+    }
+
+
+
+    /**
+     * Round the @p n_values values in @p values to multiples of
+     * @p quantum and write the zigzag-encoded differences between the
+     * resulting integers of neighboring values to @p encoded. Return false
+     * if a value cannot be represented this way.
+     */
+    template <typename Number>
+    bool
+    quantize(const Number *         values,
+             const std::size_t      n_values,
+             const double           quantum,
+             std::vector<uint64_t> &encoded)
+    {
+      const double max_integer = std::ldexp(1., 62);
+      encoded.resize(n_values);
+      std::int64_t previous = 0;
+      for (std::size_t i = 0; i < n_values; ++i)
+        {
+          const double scaled = static_cast<double>(values[i]) / quantum;
+          if (!(std::abs(scaled) < max_integer))
+            return false;
+          const std::int64_t current    = std::llround(scaled);
+          const std::int64_t difference = current - previous;
+          encoded[i] = (static_cast<uint64_t>(difference) << 1) ^
+                       static_cast<uint64_t>(difference >> 63);
+          previous   = current;
+        }
+      return true;
+    }
+
+
+
+    /**
+     * The inverse of quantize().
+     */
+    template <typename Number>
+    void
+    dequantize(const std::vector<uint64_t> &encoded,
+               const double                 quantum,
+               Number *                     values)
+    {
+      std::int64_t current = 0;
+      for (std::size_t i = 0; i < encoded.size(); ++i)
+        {
+          current += static_cast<std::int64_t>(encoded[i] >> 1) ^
+                     -static_cast<std::int64_t>(encoded[i] & 1);
+          values[i] = static_cast<Number>(current * quantum);
+        }
+    }
+
+
+
+    /**
+     * Read the file @p file_name into @p data, which must already have the
+     * size of the file.
+     */
+    void
+    read_file(const std::string &file_name, std::vector<char> &data)
+    {
+      std::ifstream in(file_name, std::ios::binary);
+      AssertThrow(in, ExcFileNotOpen(file_name));
+      in.read(data.data(), data.size());
+      AssertThrow(in, ExcIO());
+    }
+  } // namespace VectorSnapshotStoreImplementation
+} // namespace internal
+
+
+
+template <typename Number>
+VectorSnapshotStore<Number>::AdditionalData::AdditionalData(
+  const double       tolerance,
+  const std::size_t  memory_limit,
+  const std::string &spill_directory)
+  : tolerance(tolerance)
+  , memory_limit(memory_limit)
+  , spill_directory(spill_directory)
+{}
+
+
+
+template <typename Number>
+VectorSnapshotStore<Number>::VectorSnapshotStore(
+  const AdditionalData &additional_data)
+  : additional_data(additional_data)
+  , bytes_in_memory(0)
+{
+  Assert(additional_data.tolerance >= 0.,
+         ExcMessage("The tolerance must not be negative."));
+}
+
+
+
+template <typename Number>
+VectorSnapshotStore<Number>::~VectorSnapshotStore()
+{
+  clear();
+}
+
+
+
+template <typename Number>
+void
+VectorSnapshotStore<Number>::store(
+  const unsigned int                                index,
+  const LinearAlgebra::distributed::Vector<Number> &vector)
+{
+  using namespace internal::VectorSnapshotStoreImplementation;
+
+  remove(index);
+
+  Snapshot &snapshot = snapshots[index];
+  snapshot.n_values  = vector.local_size();
+  snapshot.quantum   = 0.;
+
+  std::vector<char> rearranged;
+  if (additional_data.tolerance > 0.)
+    {
+      std::vector<uint64_t> encoded;
+      if (quantize(vector.begin(),
+                   snapshot.n_values,
+                   2. * additional_data.tolerance,
+                   encoded))
+        {
+          snapshot.quantum = 2. * additional_data.tolerance;
+          rearranged.resize(snapshot.n_values * sizeof(uint64_t));
+          shuffle_bytes(reinterpret_cast<const char *>(encoded.data()),
+                        snapshot.n_values,
+                        sizeof(uint64_t),
+                        rearranged.data());
+        }
+    }
+  if (snapshot.quantum == 0.)
+    {
+      rearranged.resize(snapshot.n_values * sizeof(Number));
+      shuffle_bytes(reinterpret_cast<const char *>(vector.begin()),
+                    snapshot.n_values,
+                    sizeof(Number),
+                    rearranged.data());
+    }
+
+  compress_blocks(rearranged, snapshot.data, snapshot.block_sizes);
+  bytes_in_memory += snapshot.data.size();
+  in_memory_order.push_back(index);
+
+  spill_to_disk();
+}
+
+
+
+template <typename Number>
+void
+VectorSnapshotStore<Number>::load(
+  const unsigned int                          index,
+  LinearAlgebra::distributed::Vector<Number> &vector) const
+{
+  using namespace internal::VectorSnapshotStoreImplementation;
+
+  const auto it = snapshots.find(index);
+  AssertThrow(it != snapshots.end(), ExcNoSnapshot(index));
+  const Snapshot &snapshot = it->second;
+  AssertDimension(snapshot.n_values, vector.local_size());
+
+  std::vector<char> file_data;
+  if (snapshot.file_name.empty() == false)
+    {
+      if (snapshot.write_task.joinable())
+        snapshot.write_task.join();
+      std::size_t file_size = 0;
+      for (const std::size_t size : snapshot.block_sizes)
+        file_size += size;
+      file_data.resize(file_size);
+      read_file(snapshot.file_name, file_data);
+    }
+  const std::vector<char> &compressed =
+    snapshot.file_name.empty() ? snapshot.data : file_data;
+
+  const std::size_t value_size =
+    snapshot.quantum > 0. ? sizeof(uint64_t) : sizeof(Number);
+  std::vector<char> rearranged(snapshot.n_values * value_size);
+  decompress_blocks(compressed, snapshot.block_sizes, rearranged);
+
+  if (snapshot.quantum > 0.)
+    {
+      std::vector<uint64_t> encoded(snapshot.n_values);
+      unshuffle_bytes(rearranged.data(),
+                      snapshot.n_values,
+                      sizeof(uint64_t),
+                      reinterpret_cast<char *>(encoded.data()));
+      dequantize(encoded, snapshot.quantum, vector.begin());
+    }
+  else
+    unshuffle_bytes(rearranged.data(),
+                    snapshot.n_values,
+                    sizeof(Number),
+                    reinterpret_cast<char *>(vector.begin()));
+
+  vector.zero_out_ghosts();
+}
+
+
+
+template <typename Number>
+bool
+VectorSnapshotStore<Number>::has_snapshot(const unsigned int index) const
+{
+  return snapshots.find(index) != snapshots.end();
+}
+
+
+
+template <typename Number>
+void
+VectorSnapshotStore<Number>::remove(const unsigned int index)
+{
+  const auto it = snapshots.find(index);
+  if (it == snapshots.end())
+    return;
+
+  Snapshot &snapshot = it->second;
+  if (snapshot.file_name.empty())
+    {
+      bytes_in_memory -= snapshot.data.size();
+      in_memory_order.remove(index);
+    }
+  else
+    {
+      if (snapshot.write_task.joinable())
+        snapshot.write_task.join();
+      std::remove(snapshot.file_name.c_str());
+    }
+  snapshots.erase(it);
+}
+
+
+
+template <typename Number>
+void
+VectorSnapshotStore<Number>::clear()
+{
+  while (snapshots.empty() == false)
+    remove(snapshots.begin()->first);
+}
+
+
+
+template <typename Number>
+std::size_t
+VectorSnapshotStore<Number>::n_bytes_in_memory() const
+{
+  return bytes_in_memory;
+}
+
+
+
+template <typename Number>
+std::size_t
+VectorSnapshotStore<Number>::n_bytes_uncompressed() const
+{
+  std::size_t n_bytes = 0;
+  for (const auto &snapshot : snapshots)
+    n_bytes += snapshot.second.n_values * sizeof(Number);
+  return n_bytes;
+}
+
+
+
+template <typename Number>
+std::size_t
+VectorSnapshotStore<Number>::memory_consumption() const
+{
+  std::size_t memory = sizeof(*this) + bytes_in_memory +
+                       in_memory_order.size() * 3 * sizeof(unsigned int *);
+  for (const auto &snapshot : snapshots)
+    memory += sizeof(snapshot) +
+              MemoryConsumption::memory_consumption(
+                snapshot.second.block_sizes) +
+              MemoryConsumption::memory_consumption(snapshot.second.file_name);
+  return memory;
+}
+
+
+
+template <typename Number>
+void
+VectorSnapshotStore<Number>::spill_to_disk()
+{
+  if (additional_data.spill_directory.empty())
+    return;
+
+  while (bytes_in_memory > additional_data.memory_limit &&
+         in_memory_order.empty() == false)
+    {
+      const unsigned int index = in_memory_order.front();
+      in_memory_order.pop_front();
+      Snapshot &snapshot = snapshots[index];
+
+      // the file name has to be unique among all processes and all stores
+      // using the same directory
+      std::ostringstream file_name;
+      file_name << additional_data.spill_directory << "/snapshot-"
+                << Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) << '-'
+                << this << '-' << index;
+      snapshot.file_name = file_name.str();
+
+      // hand the data over to a task that writes them, so that the memory
+      // is released as soon as the file is written
+      bytes_in_memory -= snapshot.data.size();
+      const std::shared_ptr<std::vector<char>> data =
+        std::make_shared<std::vector<char>>();
+      data->swap(snapshot.data);
+      const std::string name = snapshot.file_name;
+      snapshot.write_task    = Threads::new_task([data, name]() {
+        std::ofstream out(name, std::ios::binary);
+        AssertThrow(out, ExcFileNotOpen(name));
+        out.write(data->data(), data->size());
+        AssertThrow(out, ExcIO());
+      });
+    }
+}
+
+
+
+BinomialCheckpointSchedule::BinomialCheckpointSchedule(
+  const unsigned int n_steps,
+  const unsigned int n_snapshots)
+  : n_snapshots(n_snapshots)
+{
+  Assert(n_snapshots > 0, ExcMessage("At least one slot is needed."));
+
+  actions.push_back({store, 0, 0});
+  if (n_steps > 0)
+    reverse(0, n_steps, 0, 1);
+}
+
+
+
+const std::vector<BinomialCheckpointSchedule::Action> &
+BinomialCheckpointSchedule::get_actions() const
+{
+  return actions;
+}
+
+
+
+unsigned int
+BinomialCheckpointSchedule::n_forward_steps() const
+{
+  unsigned int n_steps      = 0;
+  unsigned int current_step = 0;
+  for (const Action &action : actions)
+    if (action.type == restore)
+      current_step = action.step;
+    else if (action.type == advance)
+      {
+        n_steps += action.step - current_step;
+        current_step = action.step;
+      }
+  return n_steps;
+}
+
+
+
+namespace
+{
+  /**
+   * The number of steps that can be reversed with @p s snapshots and @p r
+   * forward sweeps, i.e., the binomial coefficient of @p s+r over @p s,
+   * saturated at the largest representable value.
+   */
+  std::uint64_t
+  max_reversible_steps(const unsigned int s, const unsigned int r)
+  {
+    const std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t       result = 1;
+    for (unsigned int i = 1; i <= std::min(s, r); ++i)
+      {
+        // result * (s + r - i + 1) is divisible by i
+        const std::uint64_t factor = s + r - i + 1;
+        if (result > max / factor)
+          return max;
+        result = result * factor / i;
+      }
+    return result;
+  }
+} // namespace
+
+
+
+void
+BinomialCheckpointSchedule::reverse(const unsigned int start,
+                                    const unsigned int end,
+                                    const unsigned int start_slot,
+                                    const unsigned int first_free_slot)
+{
+  const unsigned int invalid = numbers::invalid_unsigned_int;
+  const unsigned int length  = end - start;
+
+  if (length == 1)
+    {
+      actions.push_back({reverse_step, start, invalid});
+      return;
+    }
+
+  const unsigned int n_free = n_snapshots - first_free_slot;
+  if (n_free == 0)
+    {
+      // no slot left: recompute each step from the start
+      for (unsigned int step = end; step > start; --step)
+        {
+          if (step < end)
+            actions.push_back({restore, start, start_slot});
+          if (step - 1 > start)
+            actions.push_back({advance, step - 1, invalid});
+          actions.push_back({reverse_step, step - 1, invalid});
+        }
+      return;
+    }
+
+  // find the smallest number of sweeps that allows to reverse the steps
+  // with the slots available, counting the one holding the start. The
+  // second part of the range then has to be reversed with one slot less,
+  // and the first part with one sweep less since it is swept once on the
+  // way to the second part
+  unsigned int sweeps = 1;
+  while (max_reversible_steps(n_free + 1, sweeps) < length)
+    ++sweeps;
+  const std::uint64_t length_right =
+    std::min<std::uint64_t>(max_reversible_steps(n_free, sweeps), length - 1);
+  const unsigned int middle = end - static_cast<unsigned int>(length_right);
+
+  actions.push_back({advance, middle, invalid});
+  actions.push_back({store, middle, first_free_slot});
+  reverse(middle, end, first_free_slot, first_free_slot + 1);
+  actions.push_back({restore, start, start_slot});
+  reverse(start, middle, start_slot, first_free_slot);
+}
+
+
+
+template class VectorSnapshotStore<float>;
+template class VectorSnapshotStore<double>;
+
+DEAL_II_NAMESPACE_CLOSE
@@ -19,6 +19,7 @@
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/multithread_info.h>
 #include <deal.II/base/parallel.h>
+#include <deal.II/base/tracing.h>
 #include <deal.II/base/utilities.h>
 
 #include <deal.II/matrix_free/task_info.h>
@@ -28,9 +29,11 @@
 #  include <tbb/blocked_range.h>
 #  include <tbb/parallel_for.h>
 #  include <tbb/task.h>
+#  include <tbb/task_group.h>
 #  include <tbb/task_scheduler_init.h>
 #endif
 
+#include <atomic>
 #include <iostream>
 #include <set>
 
@@ -302,6 +305,75 @@ namespace internal
         const bool         is_blocked;
       };
 
+
+
+
+      // Schedules the blocks of all colors at once. A block is run as soon
+      // as all its neighbors of lower colors are done, so threads that finish
+      // early can pick up blocks of the next color without waiting for all
+      // other blocks of the present color.
+      class BlockGraphWork
+      {
+      public:
+        BlockGraphWork(MFWorkerInterface &worker_in,
+                       const TaskInfo &   task_info_in)
+          : worker(worker_in)
+          , task_info(task_info_in)
+          , n_remaining_predecessors(task_info_in.block_n_predecessors.size())
+        {
+          for (unsigned int block = 0; block < n_remaining_predecessors.size();
+               ++block)
+            n_remaining_predecessors[block].store(
+              task_info.block_n_predecessors[block]);
+        }
+
+        void
+        run()
+        {
+          for (unsigned int block = 0; block < n_remaining_predecessors.size();
+               ++block)
+            if (task_info.block_n_predecessors[block] == 0)
+              task_group.run([this, block]() { work_on_block(block); });
+          task_group.wait();
+        }
+
+      private:
+        void
+        work_on_block(unsigned int block)
+        {
+          // continue with one of the blocks that became ready in the same
+          // thread to reuse the cached data of the neighbors, and spawn
+          // tasks for the others
+          while (block != numbers::invalid_unsigned_int)
+            {
+              worker.cell(
+                std::make_pair(task_info.block_cell_start[block],
+                               task_info.block_cell_start[block + 1]));
+
+              unsigned int next_block = numbers::invalid_unsigned_int;
+              for (unsigned int i = task_info.block_successor_start[block];
+                   i < task_info.block_successor_start[block + 1];
+                   ++i)
+                {
+                  const unsigned int successor = task_info.block_successors[i];
+                  if (--n_remaining_predecessors[successor] == 0)
+                    {
+                      if (next_block != numbers::invalid_unsigned_int)
+                        task_group.run(
+                          [this, next_block]() { work_on_block(next_block); });
+                      next_block = successor;
+                    }
+                }
+              block = next_block;
+            }
+        }
+
+        MFWorkerInterface &                    worker;
+        const TaskInfo &                       task_info;
+        std::vector<std::atomic<unsigned int>> n_remaining_predecessors;
+        tbb::task_group                        task_group;
+      };
+
     } // end of namespace color
 
 
@@ -336,6 +408,19 @@ namespace internal
     void
     TaskInfo::loop(MFWorkerInterface &funct) const
     {
+      Tracing::Scope trace("MatrixFree::loop");
+
+      // the operations before and after the loop on vector entries that are
+      // exchanged via MPI are scheduled with the additional index after the
+      // last partition. With threads, the whole range is done at once.
+      unsigned int pre_post_range_index =
+        partition_row_index[partition_row_index.size() - 2];
+#ifdef DEAL_II_WITH_THREADS
+      if (scheme != none)
+        pre_post_range_index = numbers::invalid_unsigned_int;
+#endif
+
+      funct.cell_loop_pre_range(pre_post_range_index);
       funct.vector_update_ghosts_start();
 
 #ifdef DEAL_II_WITH_THREADS
@@ -551,19 +636,24 @@ namespace internal
                   Assert(evens <= 1, ExcInternalError());
                   funct.vector_update_ghosts_finish();
 
-                  for (unsigned int color = 0; color < partition_row_index[1];
-                       ++color)
-                    {
-                      tbb::empty_task *root =
-                        new (tbb::task::allocate_root()) tbb::empty_task;
-                      root->set_ref_count(2);
-                      color::PartitionWork *worker =
-                        new (root->allocate_child())
-                          color::PartitionWork(funct, color, *this, false);
-                      tbb::empty_task::spawn(*worker);
-                      root->wait_for_all();
-                      root->destroy(*root);
-                    }
+                  if (block_successor_start.empty() == false &&
+                      face_partition_data.empty())
+                    color::BlockGraphWork(funct, *this).run();
+                  else
+                    for (unsigned int color = 0;
+                         color < partition_row_index[1];
+                         ++color)
+                      {
+                        tbb::empty_task *root =
+                          new (tbb::task::allocate_root()) tbb::empty_task;
+                        root->set_ref_count(2);
+                        color::PartitionWork *worker =
+                          new (root->allocate_child())
+                            color::PartitionWork(funct, color, *this, false);
+                        tbb::empty_task::spawn(*worker);
+                        root->wait_for_all();
+                        root->destroy(*root);
+                      }
 
                   funct.vector_compress_start();
                 }
@@ -574,9 +664,71 @@ namespace internal
         // serial loop, go through up to three times and do the MPI transfer at
         // the beginning/end of the second part
         {
+          const auto process_range = [&](const unsigned int i) {
+            if (cell_partition_data[i + 1] > cell_partition_data[i])
+              funct.cell(std::make_pair(cell_partition_data[i],
+                                        cell_partition_data[i + 1]));
+
+            if (face_partition_data.empty() == false)
+              {
+                if (face_partition_data[i + 1] > face_partition_data[i])
+                  funct.face(std::make_pair(face_partition_data[i],
+                                            face_partition_data[i + 1]));
+                if (boundary_partition_data[i + 1] > boundary_partition_data[i])
+                  funct.boundary(
+                    std::make_pair(boundary_partition_data[i],
+                                   boundary_partition_data[i + 1]));
+              }
+          };
+
           for (unsigned int part = 0; part < partition_row_index.size() - 2;
                ++part)
             {
+              if (part == 1 && overlap_communication_by_process)
+                {
+                  // work on the ranges at the processor boundary as soon as
+                  // the ghost data they read has arrived. As the ranges are
+                  // not processed in order, the operations before the first
+                  // access to vector entries are done for all ranges before
+                  // and the ones after the last access after all the ranges
+                  const unsigned int begin = partition_row_index[1];
+                  const unsigned int end   = partition_row_index[2];
+                  for (unsigned int i = begin; i < end; ++i)
+                    {
+                      AssertIndexRange(i + 1, cell_partition_data.size());
+                      funct.cell_loop_pre_range(i);
+                      if (cell_partition_data[i + 1] > cell_partition_data[i])
+                        funct.zero_dst_vector_range(i);
+                    }
+
+                  std::vector<bool> range_done(end - begin, false);
+                  unsigned int      n_ranges_done    = 0;
+                  bool              exchange_ongoing = true;
+                  while (n_ranges_done < end - begin)
+                    {
+                      for (unsigned int i = begin; i < end; ++i)
+                        if (range_done[i - begin] == false &&
+                            (exchange_ongoing == false ||
+                             funct.ghost_data_available(i)))
+                          {
+                            process_range(i);
+                            range_done[i - begin] = true;
+                            ++n_ranges_done;
+                          }
+                      if (n_ranges_done < end - begin && exchange_ongoing)
+                        exchange_ongoing =
+                          funct.vector_update_ghosts_wait_any();
+                    }
+                  while (exchange_ongoing)
+                    exchange_ongoing = funct.vector_update_ghosts_wait_any();
+
+                  for (unsigned int i = begin; i < end; ++i)
+                    funct.cell_loop_post_range(i);
+
+                  funct.vector_compress_start();
+                  continue;
+                }
+
               if (part == 1)
                 funct.vector_update_ghosts_finish();
 
@@ -585,24 +737,11 @@ namespace internal
                    ++i)
                 {
                   AssertIndexRange(i + 1, cell_partition_data.size());
+                  funct.cell_loop_pre_range(i);
                   if (cell_partition_data[i + 1] > cell_partition_data[i])
-                    {
-                      funct.zero_dst_vector_range(i);
-                      funct.cell(std::make_pair(cell_partition_data[i],
-                                                cell_partition_data[i + 1]));
-                    }
-
-                  if (face_partition_data.empty() == false)
-                    {
-                      if (face_partition_data[i + 1] > face_partition_data[i])
-                        funct.face(std::make_pair(face_partition_data[i],
-                                                  face_partition_data[i + 1]));
-                      if (boundary_partition_data[i + 1] >
-                          boundary_partition_data[i])
-                        funct.boundary(
-                          std::make_pair(boundary_partition_data[i],
-                                         boundary_partition_data[i + 1]));
-                    }
+                    funct.zero_dst_vector_range(i);
+                  process_range(i);
+                  funct.cell_loop_post_range(i);
                 }
 
               if (part == 1)
@@ -610,6 +749,7 @@ namespace internal
             }
         }
       funct.vector_compress_finish();
+      funct.cell_loop_post_range(pre_post_range_index);
     }
 
 
@@ -643,9 +783,15 @@ namespace internal
       partition_odds.clear();
       partition_n_blocked_workers.clear();
       partition_n_workers.clear();
+      block_cell_start.clear();
+      block_n_predecessors.clear();
+      block_successor_start.clear();
+      block_successors.clear();
       communicator = MPI_COMM_SELF;
       my_pid       = 0;
       n_procs      = 1;
+
+      overlap_communication_by_process = false;
     }
 
 
@@ -678,7 +824,11 @@ namespace internal
         MemoryConsumption::memory_consumption(partition_evens) +
         MemoryConsumption::memory_consumption(partition_odds) +
         MemoryConsumption::memory_consumption(partition_n_blocked_workers) +
-        MemoryConsumption::memory_consumption(partition_n_workers));
+        MemoryConsumption::memory_consumption(partition_n_workers) +
+        MemoryConsumption::memory_consumption(block_cell_start) +
+        MemoryConsumption::memory_consumption(block_n_predecessors) +
+        MemoryConsumption::memory_consumption(block_successor_start) +
+        MemoryConsumption::memory_consumption(block_successors));
     }
 
 
@@ -1210,6 +1360,11 @@ namespace internal
       std::vector<unsigned char> &     irregular_cells,
       const bool                       hp_bool)
     {
+      block_cell_start.clear();
+      block_n_predecessors.clear();
+      block_successor_start.clear();
+      block_successors.clear();
+
       const unsigned int n_macro_cells = *(cell_partition_data.end() - 2);
       if (n_macro_cells == 0)
         return;
@@ -1354,6 +1509,17 @@ namespace internal
           if (block_size_last == 0)
             block_size_last = block_size;
 
+          // with a single partition, the colors can be scheduled dynamically
+          // based on the dependencies between neighboring blocks, so record
+          // the color and the range of cell batches of each block
+          const bool build_block_graph = (partition == 1);
+          std::vector<unsigned int> block_color;
+          if (build_block_graph)
+            {
+              block_color.resize(n_blocks);
+              block_cell_start.resize(n_blocks + 1);
+            }
+
           unsigned int tick = 0;
           for (unsigned int block = 0; block < n_blocks; block++)
             {
@@ -1370,6 +1536,12 @@ namespace internal
               if (cell_partition_data[tick] == block)
                 cell_partition_data[tick++] = counter_macro;
 
+              if (build_block_graph)
+                {
+                  block_color[block]      = tick - 1;
+                  block_cell_start[block] = counter_macro;
+                }
+
               for (unsigned int j = 0; j < this_block_size; j++)
                 irregular[counter_macro++] =
                   irregular_cells[present_block * block_size + j];
@@ -1377,6 +1549,57 @@ namespace internal
           AssertDimension(tick + 1, cell_partition_data.size());
           cell_partition_data.back() = counter_macro;
 
+          if (build_block_graph)
+            {
+              block_cell_start[n_blocks] = counter_macro;
+
+              // Translate the connectivity of the blocks into the new
+              // numbering and only keep the links from lower to higher
+              // colors. Blocks of the same color are never neighbors, so
+              // this gives the dependencies that the barrier between two
+              // colors used to enforce.
+              std::vector<unsigned int> new_block_index(n_blocks);
+              for (unsigned int block = 0; block < n_blocks; ++block)
+                new_block_index[partition_2layers_list[block]] = block;
+              std::vector<std::vector<unsigned int>> successors(n_blocks);
+              for (unsigned int block = 0; block < n_blocks; ++block)
+                for (auto it = connectivity_blocks.begin(
+                       partition_2layers_list[block]);
+                     it != connectivity_blocks.end(
+                             partition_2layers_list[block]);
+                     ++it)
+                  {
+                    const unsigned int neighbor =
+                      new_block_index[it->column()];
+                    Assert(neighbor == block ||
+                             block_color[neighbor] != block_color[block],
+                           ExcInternalError());
+                    if (block_color[neighbor] > block_color[block])
+                      successors[block].push_back(neighbor);
+                    else if (block_color[neighbor] < block_color[block])
+                      successors[neighbor].push_back(block);
+                  }
+
+              block_n_predecessors.clear();
+              block_n_predecessors.resize(n_blocks, 0);
+              block_successor_start.resize(n_blocks + 1);
+              block_successor_start[0] = 0;
+              block_successors.clear();
+              for (unsigned int block = 0; block < n_blocks; ++block)
+                {
+                  std::sort(successors[block].begin(), successors[block].end());
+                  successors[block].erase(std::unique(successors[block].begin(),
+                                                      successors[block].end()),
+                                          successors[block].end());
+                  for (const unsigned int successor : successors[block])
+                    {
+                      block_successors.push_back(successor);
+                      ++block_n_predecessors[successor];
+                    }
+                  block_successor_start[block + 1] = block_successors.size();
+                }
+            }
+
           irregular_cells.swap(irregular);
           AssertDimension(counter, n_active_cells);
           AssertDimension(counter_macro, n_macro_cells);
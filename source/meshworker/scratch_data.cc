@@ -35,6 +35,7 @@ namespace MeshWorker
     , neighbor_cell_update_flags(update_flags)
     , face_update_flags(face_update_flags)
     , neighbor_face_update_flags(face_update_flags)
+    , check_for_cell_similarity_allowed(false)
     , local_dof_indices(fe.dofs_per_cell)
     , neighbor_dof_indices(fe.dofs_per_cell)
   {}
@@ -59,6 +60,7 @@ namespace MeshWorker
     , neighbor_cell_update_flags(neighbor_update_flags)
     , face_update_flags(face_update_flags)
     , neighbor_face_update_flags(neighbor_face_update_flags)
+    , check_for_cell_similarity_allowed(false)
     , local_dof_indices(fe.dofs_per_cell)
     , neighbor_dof_indices(fe.dofs_per_cell)
   {}
@@ -114,6 +116,8 @@ namespace MeshWorker
     , neighbor_cell_update_flags(scratch.neighbor_cell_update_flags)
     , face_update_flags(scratch.face_update_flags)
     , neighbor_face_update_flags(scratch.neighbor_face_update_flags)
+    , check_for_cell_similarity_allowed(
+        scratch.check_for_cell_similarity_allowed)
     , local_dof_indices(scratch.local_dof_indices)
     , neighbor_dof_indices(scratch.neighbor_dof_indices)
     , user_data_storage(scratch.user_data_storage)
@@ -128,8 +132,12 @@ namespace MeshWorker
     const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell)
   {
     if (!fe_values)
-      fe_values = std_cxx14::make_unique<FEValues<dim, spacedim>>(
-        *mapping, *fe, cell_quadrature, cell_update_flags);
+      {
+        fe_values = std_cxx14::make_unique<FEValues<dim, spacedim>>(
+          *mapping, *fe, cell_quadrature, cell_update_flags);
+        fe_values->always_allow_check_for_cell_similarity(
+          check_for_cell_similarity_allowed);
+      }
 
     fe_values->reinit(cell);
     cell->get_dof_indices(local_dof_indices);
@@ -188,8 +196,12 @@ namespace MeshWorker
     const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell)
   {
     if (!neighbor_fe_values)
-      neighbor_fe_values = std_cxx14::make_unique<FEValues<dim, spacedim>>(
-        *mapping, *fe, cell_quadrature, neighbor_cell_update_flags);
+      {
+        neighbor_fe_values = std_cxx14::make_unique<FEValues<dim, spacedim>>(
+          *mapping, *fe, cell_quadrature, neighbor_cell_update_flags);
+        neighbor_fe_values->always_allow_check_for_cell_similarity(
+          check_for_cell_similarity_allowed);
+      }
 
     neighbor_fe_values->reinit(cell);
     cell->get_dof_indices(neighbor_dof_indices);
@@ -241,6 +253,20 @@ namespace MeshWorker
 
 
 
+  template <int dim, int spacedim>
+  void
+  ScratchData<dim, spacedim>::always_allow_check_for_cell_similarity(
+    const bool allow)
+  {
+    check_for_cell_similarity_allowed = allow;
+    if (fe_values)
+      fe_values->always_allow_check_for_cell_similarity(allow);
+    if (neighbor_fe_values)
+      neighbor_fe_values->always_allow_check_for_cell_similarity(allow);
+  }
+
+
+
   template <int dim, int spacedim>
   const FEValuesBase<dim, spacedim> &
   ScratchData<dim, spacedim>::get_current_fe_values() const
@@ -0,0 +1,226 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/cuda_size.h>
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/lac/cuda_atomic.h>
+
+#include <deal.II/multigrid/cuda_mg_transfer_global_coarsening.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace CUDAWrappers
+{
+  namespace internal
+  {
+    template <typename Number>
+    __global__ void
+    prolongate_and_add_kernel(const unsigned int  n_rows,
+                              const unsigned int *row_starts,
+                              const unsigned int *column_indices,
+                              const Number *      values,
+                              const Number *      src,
+                              Number *            dst)
+    {
+      const unsigned int row = threadIdx.x + blockIdx.x * blockDim.x;
+      if (row < n_rows)
+        {
+          Number sum = 0.;
+          for (unsigned int k = row_starts[row]; k < row_starts[row + 1]; ++k)
+            sum += values[k] * src[column_indices[k]];
+          dst[row] += sum;
+        }
+    }
+
+
+
+    template <typename Number>
+    __global__ void
+    restrict_and_add_kernel(const unsigned int  n_rows,
+                            const unsigned int *row_starts,
+                            const unsigned int *column_indices,
+                            const Number *      values,
+                            const Number *      src,
+                            Number *            dst)
+    {
+      const unsigned int row = threadIdx.x + blockIdx.x * blockDim.x;
+      if (row < n_rows)
+        {
+          const Number src_value = src[row];
+          for (unsigned int k = row_starts[row]; k < row_starts[row + 1]; ++k)
+            LinearAlgebra::CUDAWrappers::atomicAdd_wrapper(
+              &dst[column_indices[k]], values[k] * src_value);
+        }
+    }
+  } // namespace internal
+
+
+
+  template <int dim, typename Number>
+  MGTwoLevelTransfer<dim, Number>::MGTwoLevelTransfer()
+    : n_rows(0)
+    , n_entries(0)
+    , row_starts(nullptr, Utilities::CUDA::delete_device_data<unsigned int>)
+    , column_indices(nullptr,
+                     Utilities::CUDA::delete_device_data<unsigned int>)
+    , values(nullptr, Utilities::CUDA::delete_device_data<Number>)
+  {}
+
+
+
+  template <int dim, typename Number>
+  void
+  MGTwoLevelTransfer<dim, Number>::reinit(
+    const dealii::MGTwoLevelTransfer<dim, Number> &transfer)
+  {
+    partitioner_fine           = transfer.partitioner_fine;
+    partitioner_coarse         = transfer.partitioner_coarse;
+    partitioner_coarse_ghosted = transfer.partitioner_coarse_ghosted;
+
+    n_rows =
+      transfer.row_starts.empty() ? 0 : transfer.row_starts.size() - 1;
+    n_entries = transfer.values.size();
+
+    row_starts.reset(Utilities::CUDA::allocate_device_data<unsigned int>(
+      transfer.row_starts.size()));
+    Utilities::CUDA::copy_to_dev(transfer.row_starts, row_starts.get());
+    column_indices.reset(
+      Utilities::CUDA::allocate_device_data<unsigned int>(n_entries));
+    Utilities::CUDA::copy_to_dev(transfer.column_indices,
+                                 column_indices.get());
+    values.reset(Utilities::CUDA::allocate_device_data<Number>(n_entries));
+    Utilities::CUDA::copy_to_dev(transfer.values, values.get());
+
+    vec_coarse.reinit(partitioner_coarse_ghosted);
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  MGTwoLevelTransfer<dim, Number>::prolongate(VectorType &      dst,
+                                              const VectorType &src) const
+  {
+    dst = 0.;
+    prolongate_and_add(dst, src);
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  MGTwoLevelTransfer<dim, Number>::prolongate_and_add(
+    VectorType &      dst,
+    const VectorType &src) const
+  {
+    AssertDimension(dst.local_size(), partitioner_fine->local_size());
+    AssertDimension(src.local_size(), partitioner_coarse->local_size());
+
+    const bool src_inplace =
+      src.get_partitioner().get() == partitioner_coarse_ghosted.get();
+    const bool src_was_ghosted = src_inplace && src.has_ghost_elements();
+
+    if (src_inplace == false)
+      vec_coarse.copy_locally_owned_data_from(src);
+    const VectorType &src_vec = src_inplace ? src : vec_coarse;
+    if (src_was_ghosted == false)
+      src_vec.update_ghost_values();
+
+    if (n_rows > 0)
+      {
+        const int n_blocks = 1 + (n_rows - 1) / block_size;
+        internal::prolongate_and_add_kernel<Number>
+          <<<n_blocks, block_size>>>(n_rows,
+                                     row_starts.get(),
+                                     column_indices.get(),
+                                     values.get(),
+                                     src_vec.get_values(),
+                                     dst.get_values());
+#ifdef DEBUG
+        // Check that the kernel was launched correctly
+        AssertCuda(cudaGetLastError());
+        // Check that there was no problem during the execution of the kernel
+        AssertCuda(cudaDeviceSynchronize());
+#endif
+      }
+
+    if (src_inplace && src_was_ghosted == false)
+      src.zero_out_ghosts();
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  MGTwoLevelTransfer<dim, Number>::restrict_and_add(
+    VectorType &      dst,
+    const VectorType &src) const
+  {
+    AssertDimension(dst.local_size(), partitioner_coarse->local_size());
+    AssertDimension(src.local_size(), partitioner_fine->local_size());
+
+    const bool dst_inplace =
+      dst.get_partitioner().get() == partitioner_coarse_ghosted.get();
+    if (dst_inplace)
+      dst.zero_out_ghosts();
+    else
+      vec_coarse = 0.;
+    VectorType &dst_vec = dst_inplace ? dst : vec_coarse;
+
+    if (n_rows > 0)
+      {
+        const int n_blocks = 1 + (n_rows - 1) / block_size;
+        internal::restrict_and_add_kernel<Number>
+          <<<n_blocks, block_size>>>(n_rows,
+                                     row_starts.get(),
+                                     column_indices.get(),
+                                     values.get(),
+                                     src.get_values(),
+                                     dst_vec.get_values());
+#ifdef DEBUG
+        // Check that the kernel was launched correctly
+        AssertCuda(cudaGetLastError());
+        // Check that there was no problem during the execution of the kernel
+        AssertCuda(cudaDeviceSynchronize());
+#endif
+      }
+
+    dst_vec.compress(VectorOperation::add);
+    if (dst_inplace == false)
+      dst += vec_coarse;
+  }
+
+
+
+  template <int dim, typename Number>
+  std::size_t
+  MGTwoLevelTransfer<dim, Number>::memory_consumption() const
+  {
+    return (n_rows + 1 + n_entries) * sizeof(unsigned int) +
+           n_entries * sizeof(Number) + vec_coarse.memory_consumption();
+  }
+
+
+
+  template class MGTwoLevelTransfer<1, float>;
+  template class MGTwoLevelTransfer<1, double>;
+  template class MGTwoLevelTransfer<2, float>;
+  template class MGTwoLevelTransfer<2, double>;
+  template class MGTwoLevelTransfer<3, float>;
+  template class MGTwoLevelTransfer<3, double>;
+} // namespace CUDAWrappers
+
+DEAL_II_NAMESPACE_CLOSE
@@ -30,6 +30,20 @@
 DEAL_II_NAMESPACE_OPEN
 
 
+template <typename VectorType>
+void
+MGTransferBase<VectorType>::prolongate_and_add(const unsigned int to_level,
+                                               VectorType &       dst,
+                                               const VectorType & src) const
+{
+  VectorType temp;
+  temp.reinit(dst, true);
+  prolongate(to_level, temp, src);
+  dst += temp;
+}
+
+
+
 template <typename VectorType>
 void
 MGSmootherBase<VectorType>::apply(const unsigned int level,
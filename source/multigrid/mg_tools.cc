@@ -15,7 +15,9 @@
 
 #include <deal.II/base/logstream.h>
 #include <deal.II/base/mg_level_object.h>
+#include <deal.II/base/multithread_info.h>
 #include <deal.II/base/thread_management.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/dofs/dof_accessor.h>
 #include <deal.II/dofs/dof_handler.h>
@@ -568,6 +570,104 @@ namespace MGTools
 
 
 
+  namespace internal
+  {
+    namespace
+    {
+      // add the couplings between the degrees of freedom on each of the
+      // locally owned cells of the given level, one cell after the other
+      template <typename DoFHandlerType, typename SparsityPatternType>
+      void
+      add_level_cell_couplings_sequentially(const DoFHandlerType &dof,
+                                            SparsityPatternType & sparsity,
+                                            const unsigned int    level)
+      {
+        const unsigned int dofs_per_cell = dof.get_fe().dofs_per_cell;
+        std::vector<types::global_dof_index>   dofs_on_this_cell(dofs_per_cell);
+        typename DoFHandlerType::cell_iterator cell = dof.begin(level),
+                                               endc = dof.end(level);
+        for (; cell != endc; ++cell)
+          if (dof.get_triangulation().locally_owned_subdomain() ==
+                numbers::invalid_subdomain_id ||
+              cell->level_subdomain_id() ==
+                dof.get_triangulation().locally_owned_subdomain())
+            {
+              cell->get_mg_dof_indices(dofs_on_this_cell);
+              // make sparsity pattern for this cell
+              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                for (unsigned int j = 0; j < dofs_per_cell; ++j)
+                  sparsity.add(dofs_on_this_cell[i], dofs_on_this_cell[j]);
+            }
+      }
+
+
+
+      template <typename DoFHandlerType, typename SparsityPatternType>
+      void
+      add_level_cell_couplings(const DoFHandlerType &dof,
+                               SparsityPatternType & sparsity,
+                               const unsigned int    level)
+      {
+        add_level_cell_couplings_sequentially(dof, sparsity, level);
+      }
+
+
+
+      // DynamicSparsityPattern accepts concurrent insertions, so we can work
+      // on the cells in parallel, like DoFTools::make_sparsity_pattern()
+      // does for the active cells. the indices of a cell are sorted once so
+      // that each row of the cell matrix can be added as a whole
+      template <typename DoFHandlerType>
+      void
+      add_level_cell_couplings(const DoFHandlerType &  dof,
+                               DynamicSparsityPattern &sparsity,
+                               const unsigned int      level)
+      {
+        if (MultithreadInfo::n_threads() == 1)
+          {
+            add_level_cell_couplings_sequentially(dof, sparsity, level);
+            return;
+          }
+
+        using CellIterator = typename DoFHandlerType::level_cell_iterator;
+        using ScratchData  = std::vector<types::global_dof_index>;
+
+        const types::subdomain_id locally_owned_subdomain =
+          dof.get_triangulation().locally_owned_subdomain();
+
+        sparsity.set_thread_safe_insertion(true);
+        WorkStream::run(
+          CellIterator(dof.begin(level)),
+          CellIterator(dof.end(level)),
+          [&](const CellIterator &cell,
+              ScratchData &       dofs_on_this_cell,
+              int &) {
+            if (locally_owned_subdomain == numbers::invalid_subdomain_id ||
+                cell->level_subdomain_id() == locally_owned_subdomain)
+              {
+                dofs_on_this_cell.resize(dof.get_fe().dofs_per_cell);
+                cell->get_mg_dof_indices(dofs_on_this_cell);
+                std::sort(dofs_on_this_cell.begin(), dofs_on_this_cell.end());
+                dofs_on_this_cell.erase(std::unique(dofs_on_this_cell.begin(),
+                                                    dofs_on_this_cell.end()),
+                                        dofs_on_this_cell.end());
+                for (const types::global_dof_index row : dofs_on_this_cell)
+                  sparsity.add_entries(row,
+                                       dofs_on_this_cell.begin(),
+                                       dofs_on_this_cell.end(),
+                                       true);
+              }
+          },
+          std::function<void(const int &)>(),
+          ScratchData(dof.get_fe().dofs_per_cell),
+          0);
+        sparsity.set_thread_safe_insertion(false);
+      }
+    } // namespace
+  }   // namespace internal
+
+
+
   template <typename DoFHandlerType, typename SparsityPatternType>
   void
   make_sparsity_pattern(const DoFHandlerType &dof,
@@ -582,22 +682,7 @@ namespace MGTools
     Assert(sparsity.n_cols() == n_dofs,
            ExcDimensionMismatch(sparsity.n_cols(), n_dofs));
 
-    const unsigned int dofs_per_cell = dof.get_fe().dofs_per_cell;
-    std::vector<types::global_dof_index>   dofs_on_this_cell(dofs_per_cell);
-    typename DoFHandlerType::cell_iterator cell = dof.begin(level),
-                                           endc = dof.end(level);
-    for (; cell != endc; ++cell)
-      if (dof.get_triangulation().locally_owned_subdomain() ==
-            numbers::invalid_subdomain_id ||
-          cell->level_subdomain_id() ==
-            dof.get_triangulation().locally_owned_subdomain())
-        {
-          cell->get_mg_dof_indices(dofs_on_this_cell);
-          // make sparsity pattern for this cell
-          for (unsigned int i = 0; i < dofs_per_cell; ++i)
-            for (unsigned int j = 0; j < dofs_per_cell; ++j)
-              sparsity.add(dofs_on_this_cell[i], dofs_on_this_cell[j]);
-        }
+    internal::add_level_cell_couplings(dof, sparsity, level);
   }
 
 
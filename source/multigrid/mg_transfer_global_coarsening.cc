@@ -0,0 +1,902 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+
+#include <deal.II/fe/fe.h>
+
+#include <deal.II/grid/cell_id.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/identity_matrix.h>
+
+#include <deal.II/multigrid/mg_transfer_global_coarsening.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <set>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace MGTransferGlobalCoarseningImplementation
+  {
+    /**
+     * An entry of the data attached to a cell: the index of a degree of
+     * freedom within the cell, a global index, and a weight. For the coarse
+     * cells of a transfer, the global index and the weight describe how the
+     * degree of freedom is expressed in terms of unconstrained ones.
+     */
+    struct CellEntry
+    {
+      unsigned int            local_index;
+      types::global_dof_index global_index;
+      double                  weight;
+    };
+
+
+
+    /**
+     * The message format for exchanging cells together with their data.
+     */
+    struct CellMessage
+    {
+      /**
+       * The cells in the format of CellId::to_binary(), i.e., four integers
+       * per cell.
+       */
+      std::vector<unsigned int> cells;
+
+      /**
+       * The number of entries of each cell, or numbers::invalid_unsigned_int
+       * if the receiver of a request does not know the cell.
+       */
+      std::vector<unsigned int> n_entries;
+
+      /**
+       * The entries of all cells, one after the other.
+       */
+      std::vector<unsigned int>            local_indices;
+      std::vector<types::global_dof_index> global_indices;
+      std::vector<double>                  weights;
+
+      void
+      add_cell(const CellId::binary_type &cell)
+      {
+        cells.insert(cells.end(), cell.begin(), cell.end());
+      }
+
+      void
+      add_entries(const std::vector<CellEntry> &entries)
+      {
+        n_entries.push_back(entries.size());
+        for (const CellEntry &entry : entries)
+          {
+            local_indices.push_back(entry.local_index);
+            global_indices.push_back(entry.global_index);
+            weights.push_back(entry.weight);
+          }
+      }
+
+      unsigned int
+      n_cells() const
+      {
+        return cells.size() / std::tuple_size<CellId::binary_type>::value;
+      }
+
+      CellId
+      get_cell(const unsigned int c) const
+      {
+        CellId::binary_type binary;
+        std::copy_n(cells.begin() + c * binary.size(),
+                    binary.size(),
+                    binary.begin());
+        return CellId(binary);
+      }
+
+      template <class Archive>
+      void
+      serialize(Archive &ar, const unsigned int /*version*/)
+      {
+        ar &cells &n_entries &local_indices &global_indices &weights;
+      }
+    };
+
+
+
+    /**
+     * Return the rank of the process that collects the information about
+     * the given cell, computed by an FNV-1a hash of its binary
+     * representation.
+     */
+    unsigned int
+    dictionary_rank(const CellId::binary_type &cell,
+                    const unsigned int         n_procs)
+    {
+      std::uint64_t hash = 14695981039346656037ULL;
+      for (const unsigned int word : cell)
+        {
+          hash ^= word;
+          hash *= 1099511628211ULL;
+        }
+      return hash % n_procs;
+    }
+
+
+
+    /**
+     * Send the given messages and return the received ones. In contrast to
+     * Utilities::MPI::some_to_some(), a message to the own rank is allowed.
+     */
+    std::map<unsigned int, CellMessage>
+    exchange(const MPI_Comm &                     comm,
+             std::map<unsigned int, CellMessage> &messages)
+    {
+      const unsigned int my_rank = Utilities::MPI::this_mpi_process(comm);
+
+      CellMessage own_message;
+      const auto  own_entry   = messages.find(my_rank);
+      const bool  has_message = own_entry != messages.end();
+      if (has_message)
+        {
+          own_message = std::move(own_entry->second);
+          messages.erase(own_entry);
+        }
+
+      std::map<unsigned int, CellMessage> received =
+        Utilities::MPI::some_to_some(comm, messages);
+      if (has_message)
+        received[my_rank] = std::move(own_message);
+      return received;
+    }
+
+
+
+    /**
+     * A distributed map from cells to data. The cells are published by the
+     * processes that know them (typically their owners) and can then be
+     * looked up by any process, without knowing which process published
+     * them. Each cell is stored on a process determined by a hash of its
+     * CellId, so both the construction and the lookup only need
+     * point-to-point communication with the processes actually involved.
+     */
+    template <int dim>
+    class CellDictionary
+    {
+    public:
+      /**
+       * Publish @p cells with the entries in @p data, which is either empty
+       * or holds the entries of each cell. Cells may be published by more
+       * than one process, in which case the data of one of them is kept.
+       */
+      CellDictionary(const MPI_Comm &                           comm,
+                     const std::vector<CellId> &                cells,
+                     const std::vector<std::vector<CellEntry>> &data);
+
+      /**
+       * Look up the given cells. For each of them, @p found says whether it
+       * has been published and @p data holds its entries.
+       */
+      void
+      lookup(const std::vector<CellId> &            cells,
+             std::vector<bool> &                    found,
+             std::vector<std::vector<CellEntry>> &data) const;
+
+    private:
+      /**
+       * The communicator.
+       */
+      const MPI_Comm comm;
+
+      /**
+       * The cells this process is responsible for, with their entries.
+       */
+      std::map<CellId, std::vector<CellEntry>> dictionary;
+    };
+
+
+
+    template <int dim>
+    CellDictionary<dim>::CellDictionary(
+      const MPI_Comm &                           comm,
+      const std::vector<CellId> &                cells,
+      const std::vector<std::vector<CellEntry>> &data)
+      : comm(comm)
+    {
+      Assert(data.empty() || data.size() == cells.size(),
+             ExcDimensionMismatch(data.size(), cells.size()));
+      const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+
+      std::map<unsigned int, CellMessage> messages;
+      for (unsigned int c = 0; c < cells.size(); ++c)
+        {
+          const CellId::binary_type binary = cells[c].template to_binary<dim>();
+          CellMessage &message = messages[dictionary_rank(binary, n_procs)];
+          message.add_cell(binary);
+          message.add_entries(data.empty() ? std::vector<CellEntry>() :
+                                             data[c]);
+        }
+
+      for (const auto &received : exchange(comm, messages))
+        {
+          const CellMessage &message = received.second;
+          for (unsigned int c = 0, position = 0; c < message.n_cells(); ++c)
+            {
+              std::vector<CellEntry> &entries =
+                dictionary[message.get_cell(c)];
+              entries.clear();
+              for (unsigned int e = 0; e < message.n_entries[c];
+                   ++e, ++position)
+                entries.push_back(
+                  CellEntry{message.local_indices[position],
+                            message.global_indices[position],
+                            message.weights[position]});
+            }
+        }
+    }
+
+
+
+    template <int dim>
+    void
+    CellDictionary<dim>::lookup(const std::vector<CellId> &cells,
+                                std::vector<bool> &        found,
+                                std::vector<std::vector<CellEntry>> &data) const
+    {
+      const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+
+      // send the requests to the processes responsible for the cells and
+      // remember the order in which we asked for them
+      std::map<unsigned int, CellMessage>               requests;
+      std::map<unsigned int, std::vector<unsigned int>> positions;
+      for (unsigned int c = 0; c < cells.size(); ++c)
+        {
+          const CellId::binary_type binary = cells[c].template to_binary<dim>();
+          const unsigned int        rank   = dictionary_rank(binary, n_procs);
+          requests[rank].add_cell(binary);
+          positions[rank].push_back(c);
+        }
+
+      // answer the requests of other processes
+      std::map<unsigned int, CellMessage> answers;
+      for (const auto &received : exchange(comm, requests))
+        {
+          const CellMessage &request = received.second;
+          CellMessage &      answer  = answers[received.first];
+          for (unsigned int c = 0; c < request.n_cells(); ++c)
+            {
+              const auto entry = dictionary.find(request.get_cell(c));
+              if (entry == dictionary.end())
+                answer.n_entries.push_back(numbers::invalid_unsigned_int);
+              else
+                answer.add_entries(entry->second);
+            }
+        }
+
+      found.clear();
+      found.resize(cells.size(), false);
+      data.clear();
+      data.resize(cells.size());
+      for (const auto &received : exchange(comm, answers))
+        {
+          const CellMessage &              answer = received.second;
+          const std::vector<unsigned int> &my_positions =
+            positions[received.first];
+          AssertDimension(answer.n_entries.size(), my_positions.size());
+          for (unsigned int c = 0, position = 0; c < my_positions.size(); ++c)
+            if (answer.n_entries[c] != numbers::invalid_unsigned_int)
+              {
+                found[my_positions[c]] = true;
+                for (unsigned int e = 0; e < answer.n_entries[c];
+                     ++e, ++position)
+                  data[my_positions[c]].push_back(
+                    CellEntry{answer.local_indices[position],
+                              answer.global_indices[position],
+                              answer.weights[position]});
+              }
+        }
+    }
+
+
+
+    /**
+     * Create the coarse mesh of @p fine in @p coarse and refine it such that
+     * it equals @p fine with the finest level coarsened away. This only uses
+     * the interface of the Triangulation base class and the CellId of the
+     * cells, so @p coarse can be partitioned differently from @p fine.
+     */
+    template <int dim>
+    void
+    create_coarsened_triangulation(const Triangulation<dim> &fine,
+                                   Triangulation<dim> &      coarse,
+                                   const MPI_Comm &          comm)
+    {
+      // create a copy of the coarse mesh, which every process stores in full
+      std::vector<Point<dim>>    vertices = fine.get_vertices();
+      std::vector<CellData<dim>> cells;
+      for (const auto &cell : fine.cell_iterators_on_level(0))
+        {
+          CellData<dim> cell_data;
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            cell_data.vertices[v] = cell->vertex_index(v);
+          cell_data.material_id = cell->material_id();
+          cell_data.manifold_id = cell->manifold_id();
+          cells.push_back(cell_data);
+        }
+      SubCellData subcell_data;
+      GridTools::delete_unused_vertices(vertices, cells, subcell_data);
+      coarse.create_triangulation(vertices, cells, subcell_data);
+
+      for (const auto manifold_id : fine.get_manifold_ids())
+        if (manifold_id != numbers::flat_manifold_id)
+          coarse.set_manifold(manifold_id, fine.get_manifold(manifold_id));
+
+      // the cells keep their order, so we can copy the indicators of the
+      // faces and, in 3D, the lines
+      for (auto cell_fine = fine.begin(0), cell_coarse = coarse.begin(0);
+           cell_fine != fine.end(0);
+           ++cell_fine, ++cell_coarse)
+        {
+          for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+            {
+              if (cell_fine->face(f)->at_boundary())
+                cell_coarse->face(f)->set_boundary_id(
+                  cell_fine->face(f)->boundary_id());
+              cell_coarse->face(f)->set_manifold_id(
+                cell_fine->face(f)->manifold_id());
+            }
+          if (dim == 3)
+            for (unsigned int l = 0; l < GeometryInfo<dim>::lines_per_cell;
+                 ++l)
+              cell_coarse->line(l)->set_manifold_id(
+                cell_fine->line(l)->manifold_id());
+        }
+
+      // A cell is refined in the coarsened mesh if one of its children is
+      // refined in the fine mesh, i.e., if it is the grandparent (or an
+      // earlier ancestor) of an active cell of the fine mesh. Each process
+      // publishes these cells for its locally owned cells, which covers all
+      // of them.
+      std::set<CellId> refined_cells;
+      for (const auto &cell : fine.active_cell_iterators())
+        if (cell->is_locally_owned() && cell->level() > 1)
+          for (auto ancestor = cell->parent()->parent();;
+               ancestor = ancestor->parent())
+            {
+              if (refined_cells.insert(ancestor->id()).second == false)
+                break;
+              if (ancestor->level() == 0)
+                break;
+            }
+      const CellDictionary<dim> dictionary(
+        comm,
+        std::vector<CellId>(refined_cells.begin(), refined_cells.end()),
+        std::vector<std::vector<CellEntry>>());
+
+      // now refine the mesh level by level. Only the cells on the finest
+      // level created so far can be refined further, so only those need to
+      // be looked up
+      for (unsigned int level = 0;; ++level)
+        {
+          std::vector<CellId> candidates;
+          std::vector<typename Triangulation<dim>::cell_iterator>
+            candidate_cells;
+          if (level < coarse.n_levels())
+            for (const auto &cell : coarse.cell_iterators_on_level(level))
+              if (cell->active() && cell->is_locally_owned())
+                {
+                  candidates.push_back(cell->id());
+                  candidate_cells.push_back(cell);
+                }
+
+          std::vector<bool>                   found;
+          std::vector<std::vector<CellEntry>> unused_data;
+          dictionary.lookup(candidates, found, unused_data);
+
+          unsigned int n_flagged = 0;
+          for (unsigned int c = 0; c < candidates.size(); ++c)
+            if (found[c])
+              {
+                candidate_cells[c]->set_refine_flag();
+                ++n_flagged;
+              }
+
+          if (Utilities::MPI::sum(n_flagged, comm) == 0)
+            break;
+          coarse.execute_coarsening_and_refinement();
+        }
+    }
+
+
+    /**
+     * Return the communicator of the triangulation underlying
+     * @p dof_handler, or MPI_COMM_SELF for a serial triangulation.
+     */
+    template <int dim>
+    MPI_Comm
+    get_communicator(const DoFHandler<dim> &dof_handler)
+    {
+      const parallel::Triangulation<dim> *tria =
+        dynamic_cast<const parallel::Triangulation<dim> *>(
+          &dof_handler.get_triangulation());
+      return tria != nullptr ? tria->get_communicator() : MPI_COMM_SELF;
+    }
+
+
+    /**
+     * Return the entries of a coarse cell with the degrees of freedom
+     * @p dof_indices, with constrained degrees of freedom expressed in terms
+     * of the ones they are constrained to.
+     */
+    template <typename Number>
+    std::vector<CellEntry>
+    get_coarse_cell_entries(
+      const std::vector<types::global_dof_index> &dof_indices,
+      const AffineConstraints<Number> &           constraints)
+    {
+      std::vector<CellEntry> entries;
+      for (unsigned int j = 0; j < dof_indices.size(); ++j)
+        {
+          const auto *constraint_entries =
+            constraints.get_constraint_entries(dof_indices[j]);
+          if (constraint_entries == nullptr)
+            entries.push_back(CellEntry{j, dof_indices[j], 1.});
+          else
+            for (const auto &entry : *constraint_entries)
+              entries.push_back(
+                CellEntry{j, entry.first, static_cast<double>(entry.second)});
+        }
+      return entries;
+    }
+
+
+
+    /**
+     * Add the rows of the prolongation for the locally owned and
+     * unconstrained ones among the fine degrees of freedom @p dof_indices of
+     * a cell, given the prolongation matrix on the cell and the entries of
+     * the coarse cell. Since the coarse space is contained in the fine one,
+     * all cells around a degree of freedom give the same row, so rows that
+     * are already set are skipped.
+     */
+    template <typename Number>
+    void
+    add_prolongation_rows(
+      const std::vector<types::global_dof_index> &dof_indices,
+      const FullMatrix<double> &                  prolongation,
+      const std::vector<CellEntry> &              coarse_entries,
+      const IndexSet &                            owned_fine,
+      const AffineConstraints<Number> &           constraint_fine,
+      std::vector<std::vector<std::pair<types::global_dof_index, double>>>
+        &                rows,
+      std::vector<bool> &row_is_set)
+    {
+      for (unsigned int i = 0; i < dof_indices.size(); ++i)
+        {
+          if (owned_fine.is_element(dof_indices[i]) == false ||
+              constraint_fine.is_constrained(dof_indices[i]))
+            continue;
+          const unsigned int row = owned_fine.index_within_set(dof_indices[i]);
+          if (row_is_set[row])
+            continue;
+          row_is_set[row] = true;
+
+          std::vector<std::pair<types::global_dof_index, double>> &entries =
+            rows[row];
+          for (const CellEntry &entry : coarse_entries)
+            {
+              const double value = prolongation(i, entry.local_index);
+              if (value != 0.)
+                entries.emplace_back(entry.global_index, value * entry.weight);
+            }
+
+          // merge duplicate columns, which come from coarse degrees of
+          // freedom that several constrained ones depend on
+          std::sort(entries.begin(), entries.end());
+          unsigned int n_unique = 0;
+          for (unsigned int k = 0; k < entries.size(); ++k)
+            if (n_unique > 0 && entries[n_unique - 1].first == entries[k].first)
+              entries[n_unique - 1].second += entries[k].second;
+            else
+              entries[n_unique++] = entries[k];
+          entries.resize(n_unique);
+        }
+    }
+  } // namespace MGTransferGlobalCoarseningImplementation
+} // namespace internal
+
+
+
+namespace MGTransferGlobalCoarseningTools
+{
+  template <int dim>
+  std::vector<std::shared_ptr<const Triangulation<dim>>>
+  create_geometric_coarsening_sequence(
+    const Triangulation<dim> &fine_triangulation)
+  {
+    const unsigned int n_levels = fine_triangulation.n_global_levels();
+    std::vector<std::shared_ptr<const Triangulation<dim>>>
+      coarse_triangulations(n_levels - 1);
+
+#ifdef DEAL_II_WITH_P4EST
+    if (const auto fine_triangulation_pdt =
+          dynamic_cast<const parallel::distributed::Triangulation<dim> *>(
+            &fine_triangulation))
+      {
+        const MPI_Comm comm = fine_triangulation_pdt->get_communicator();
+        const Triangulation<dim> *finer = &fine_triangulation;
+        for (unsigned int level = n_levels - 1; level > 0; --level)
+          {
+            const auto coarse = std::make_shared<
+              parallel::distributed::Triangulation<dim>>(comm);
+            internal::MGTransferGlobalCoarseningImplementation::
+              create_coarsened_triangulation(*finer, *coarse, comm);
+            coarse_triangulations[level - 1] = coarse;
+            finer                            = coarse.get();
+          }
+        return coarse_triangulations;
+      }
+#endif
+
+    AssertThrow(
+      dynamic_cast<const parallel::Triangulation<dim> *>(
+        &fine_triangulation) == nullptr,
+      ExcMessage("Only serial triangulations and "
+                 "parallel::distributed::Triangulation are supported."));
+
+    const Triangulation<dim> *finer = &fine_triangulation;
+    for (unsigned int level = n_levels - 1; level > 0; --level)
+      {
+        const auto coarse = std::make_shared<Triangulation<dim>>();
+        coarse->copy_triangulation(*finer);
+        for (const auto &cell : coarse->active_cell_iterators())
+          cell->set_coarsen_flag();
+        coarse->execute_coarsening_and_refinement();
+        coarse_triangulations[level - 1] = coarse;
+        finer                            = coarse.get();
+      }
+    return coarse_triangulations;
+  }
+} // namespace MGTransferGlobalCoarseningTools
+
+
+
+template <int dim, typename Number>
+template <typename Number2>
+void
+MGTwoLevelTransfer<dim, Number>::reinit_geometric_transfer(
+  const DoFHandler<dim> &           dof_handler_fine,
+  const DoFHandler<dim> &           dof_handler_coarse,
+  const AffineConstraints<Number2> &constraint_fine,
+  const AffineConstraints<Number2> &constraint_coarse)
+{
+  using namespace internal::MGTransferGlobalCoarseningImplementation;
+
+  const FiniteElement<dim> &fe = dof_handler_fine.get_fe();
+  AssertThrow(fe == dof_handler_coarse.get_fe(),
+              ExcMessage("The geometric transfer needs the same finite "
+                         "element on both levels."));
+  const MPI_Comm comm = get_communicator(dof_handler_fine);
+
+  // publish the locally owned coarse cells together with their degrees of
+  // freedom
+  std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+  std::vector<CellId>                  coarse_cells;
+  std::vector<std::vector<CellEntry>>  coarse_cell_data;
+  for (const auto &cell : dof_handler_coarse.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        cell->get_dof_indices(dof_indices);
+        coarse_cells.push_back(cell->id());
+        coarse_cell_data.push_back(
+          get_coarse_cell_entries(dof_indices, constraint_coarse));
+      }
+  const CellDictionary<dim> dictionary(comm, coarse_cells, coarse_cell_data);
+
+  // the coarse cell of each locally owned fine cell is either the cell
+  // itself or its parent, so ask for both
+  std::vector<CellId> requested_cells;
+  for (const auto &cell : dof_handler_fine.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        requested_cells.push_back(cell->id());
+        if (cell->level() > 0)
+          requested_cells.push_back(cell->parent()->id());
+      }
+  std::vector<bool>                   found;
+  std::vector<std::vector<CellEntry>> coarse_entries;
+  dictionary.lookup(requested_cells, found, coarse_entries);
+
+  const IndexSet &owned_fine = dof_handler_fine.locally_owned_dofs();
+  std::vector<std::vector<std::pair<types::global_dof_index, double>>> rows(
+    owned_fine.n_elements());
+  std::vector<bool> row_is_set(owned_fine.n_elements(), false);
+
+  const FullMatrix<double> identity = IdentityMatrix(fe.dofs_per_cell);
+  unsigned int             request  = 0;
+  for (const auto &cell : dof_handler_fine.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        const bool is_coarse_cell = found[request];
+        const bool parent_is_coarse_cell =
+          cell->level() > 0 && found[request + 1];
+        AssertThrow(is_coarse_cell != parent_is_coarse_cell,
+                    ExcMessage("Each active cell of the fine triangulation "
+                               "must either be an active cell of the coarse "
+                               "triangulation or a child of one."));
+        const std::vector<CellEntry> &entries =
+          coarse_entries[is_coarse_cell ? request : request + 1];
+        request += cell->level() > 0 ? 2 : 1;
+
+        const FullMatrix<double> *prolongation = &identity;
+        if (parent_is_coarse_cell)
+          {
+            const auto parent = cell->parent();
+            AssertThrow(parent->refinement_case() ==
+                          RefinementCase<dim>::isotropic_refinement,
+                        ExcNotImplemented());
+            unsigned int child = 0;
+            while (parent->child(child)->index() != cell->index())
+              ++child;
+            prolongation = &fe.get_prolongation_matrix(
+              child, RefinementCase<dim>::isotropic_refinement);
+          }
+
+        cell->get_dof_indices(dof_indices);
+        add_prolongation_rows(dof_indices,
+                              *prolongation,
+                              entries,
+                              owned_fine,
+                              constraint_fine,
+                              rows,
+                              row_is_set);
+      }
+
+  setup_prolongation(owned_fine,
+                     dof_handler_coarse.locally_owned_dofs(),
+                     comm,
+                     rows);
+}
+
+
+
+template <int dim, typename Number>
+template <typename Number2>
+void
+MGTwoLevelTransfer<dim, Number>::reinit_polynomial_transfer(
+  const DoFHandler<dim> &           dof_handler_fine,
+  const DoFHandler<dim> &           dof_handler_coarse,
+  const AffineConstraints<Number2> &constraint_fine,
+  const AffineConstraints<Number2> &constraint_coarse)
+{
+  using namespace internal::MGTransferGlobalCoarseningImplementation;
+
+  AssertThrow(&dof_handler_fine.get_triangulation() ==
+                &dof_handler_coarse.get_triangulation(),
+              ExcMessage("The polynomial transfer needs both DoFHandler "
+                         "objects on the same triangulation."));
+  const FiniteElement<dim> &fe_fine   = dof_handler_fine.get_fe();
+  const FiniteElement<dim> &fe_coarse = dof_handler_coarse.get_fe();
+  const MPI_Comm            comm      = get_communicator(dof_handler_fine);
+
+  // the coarse space is embedded into the fine one by interpolation, which
+  // is the same matrix on all cells. For FE_Q elements, it is the tensor
+  // product of the 1D embedding matrices
+  FullMatrix<double> prolongation(fe_fine.dofs_per_cell,
+                                  fe_coarse.dofs_per_cell);
+  fe_fine.get_interpolation_matrix(fe_coarse, prolongation);
+
+  const IndexSet &owned_fine = dof_handler_fine.locally_owned_dofs();
+  std::vector<std::vector<std::pair<types::global_dof_index, double>>> rows(
+    owned_fine.n_elements());
+  std::vector<bool> row_is_set(owned_fine.n_elements(), false);
+
+  // both DoFHandler objects live on the same triangulation, so their active
+  // cells come in the same order and have the same owners
+  std::vector<types::global_dof_index> dof_indices_fine(fe_fine.dofs_per_cell);
+  std::vector<types::global_dof_index> dof_indices_coarse(
+    fe_coarse.dofs_per_cell);
+  for (auto cell_fine   = dof_handler_fine.begin_active(),
+            cell_coarse = dof_handler_coarse.begin_active();
+       cell_fine != dof_handler_fine.end();
+       ++cell_fine, ++cell_coarse)
+    if (cell_fine->is_locally_owned())
+      {
+        cell_fine->get_dof_indices(dof_indices_fine);
+        cell_coarse->get_dof_indices(dof_indices_coarse);
+        add_prolongation_rows(
+          dof_indices_fine,
+          prolongation,
+          get_coarse_cell_entries(dof_indices_coarse, constraint_coarse),
+          owned_fine,
+          constraint_fine,
+          rows,
+          row_is_set);
+      }
+
+  setup_prolongation(owned_fine,
+                     dof_handler_coarse.locally_owned_dofs(),
+                     comm,
+                     rows);
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, Number>::setup_prolongation(
+  const IndexSet &owned_fine,
+  const IndexSet &owned_coarse,
+  const MPI_Comm &comm,
+  const std::vector<std::vector<std::pair<types::global_dof_index, double>>>
+    &rows)
+{
+  AssertDimension(rows.size(), owned_fine.n_elements());
+
+  // set up the partitioners and translate the columns to the local numbering
+  // of the ghosted coarse vector
+  partitioner_fine =
+    std::make_shared<Utilities::MPI::Partitioner>(owned_fine, comm);
+  partitioner_coarse =
+    std::make_shared<Utilities::MPI::Partitioner>(owned_coarse, comm);
+
+  std::vector<types::global_dof_index> ghost_indices;
+  for (const auto &row : rows)
+    for (const auto &entry : row)
+      if (owned_coarse.is_element(entry.first) == false)
+        ghost_indices.push_back(entry.first);
+  std::sort(ghost_indices.begin(), ghost_indices.end());
+  IndexSet ghosts(owned_coarse.size());
+  ghosts.add_indices(ghost_indices.begin(),
+                     std::unique(ghost_indices.begin(), ghost_indices.end()));
+  ghosts.compress();
+  partitioner_coarse_ghosted =
+    std::make_shared<Utilities::MPI::Partitioner>(owned_coarse, ghosts, comm);
+
+  row_starts.resize(rows.size() + 1);
+  row_starts[0] = 0;
+  for (unsigned int row = 0; row < rows.size(); ++row)
+    row_starts[row + 1] = row_starts[row] + rows[row].size();
+  column_indices.resize(row_starts.back());
+  values.resize(row_starts.back());
+  for (unsigned int row = 0; row < rows.size(); ++row)
+    for (unsigned int k = 0; k < rows[row].size(); ++k)
+      {
+        column_indices[row_starts[row] + k] =
+          partitioner_coarse_ghosted->global_to_local(rows[row][k].first);
+        values[row_starts[row] + k] = rows[row][k].second;
+      }
+
+  vec_coarse.reinit(partitioner_coarse_ghosted);
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, Number>::prolongate(
+  LinearAlgebra::distributed::Vector<Number> &      dst,
+  const LinearAlgebra::distributed::Vector<Number> &src) const
+{
+  dst = 0.;
+  prolongate_and_add(dst, src);
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, Number>::prolongate_and_add(
+  LinearAlgebra::distributed::Vector<Number> &      dst,
+  const LinearAlgebra::distributed::Vector<Number> &src) const
+{
+  AssertDimension(dst.local_size(), partitioner_fine->local_size());
+  AssertDimension(src.local_size(), partitioner_coarse->local_size());
+
+  // if the source vector has the layout of the ghosted coarse vector, we
+  // import the ghost values into it directly
+  const bool src_inplace =
+    src.get_partitioner().get() == partitioner_coarse_ghosted.get();
+  const bool src_was_ghosted = src_inplace && src.has_ghost_elements();
+
+  if (src_inplace == false)
+    vec_coarse.copy_locally_owned_data_from(src);
+  const LinearAlgebra::distributed::Vector<Number> &src_vec =
+    src_inplace ? src : vec_coarse;
+  if (src_was_ghosted == false)
+    src_vec.update_ghost_values();
+
+  for (unsigned int row = 0; row + 1 < row_starts.size(); ++row)
+    {
+      Number sum = Number();
+      for (unsigned int k = row_starts[row]; k < row_starts[row + 1]; ++k)
+        sum += values[k] * src_vec.local_element(column_indices[k]);
+      dst.local_element(row) += sum;
+    }
+
+  if (src_inplace && src_was_ghosted == false)
+    src.zero_out_ghosts();
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTwoLevelTransfer<dim, Number>::restrict_and_add(
+  LinearAlgebra::distributed::Vector<Number> &      dst,
+  const LinearAlgebra::distributed::Vector<Number> &src) const
+{
+  AssertDimension(dst.local_size(), partitioner_coarse->local_size());
+  AssertDimension(src.local_size(), partitioner_fine->local_size());
+
+  // the ghost entries of the destination collect the contributions to be
+  // sent to their owners by compress(), so they must start out as zero
+  const bool dst_inplace =
+    dst.get_partitioner().get() == partitioner_coarse_ghosted.get();
+  if (dst_inplace)
+    dst.zero_out_ghosts();
+  else
+    vec_coarse = 0.;
+  LinearAlgebra::distributed::Vector<Number> &dst_vec =
+    dst_inplace ? dst : vec_coarse;
+
+  for (unsigned int row = 0; row + 1 < row_starts.size(); ++row)
+    {
+      const Number src_value = src.local_element(row);
+      for (unsigned int k = row_starts[row]; k < row_starts[row + 1]; ++k)
+        dst_vec.local_element(column_indices[k]) += values[k] * src_value;
+    }
+
+  dst_vec.compress(VectorOperation::add);
+  if (dst_inplace == false)
+    dst += vec_coarse;
+}
+
+
+
+template <int dim, typename Number>
+std::size_t
+MGTwoLevelTransfer<dim, Number>::memory_consumption() const
+{
+  std::size_t memory = MemoryConsumption::memory_consumption(row_starts) +
+                       MemoryConsumption::memory_consumption(column_indices) +
+                       MemoryConsumption::memory_consumption(values) +
+                       vec_coarse.memory_consumption();
+  if (partitioner_coarse_ghosted.get() != nullptr)
+    memory += partitioner_coarse_ghosted->memory_consumption();
+  return memory;
+}
+
+
+
+// explicit instantiations
+#include "mg_transfer_global_coarsening.inst"
+
+
+DEAL_II_NAMESPACE_CLOSE
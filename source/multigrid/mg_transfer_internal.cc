@@ -380,12 +380,16 @@ namespace internal
 
 
     // initialize the vectors needed for the transfer (and merge with the
-    // content in copy_indices_global_mine)
+    // content in copy_indices_global_mine). If an external partitioner is
+    // given and its ghost range contains all the indices we need on all
+    // processes, we use it for the vector.
     template <typename Number>
     void
     reinit_ghosted_vector(
-      const IndexSet &                            locally_owned,
-      std::vector<types::global_dof_index> &      ghosted_level_dofs,
+      const IndexSet &                      locally_owned,
+      std::vector<types::global_dof_index> &ghosted_level_dofs,
+      const std::shared_ptr<const Utilities::MPI::Partitioner>
+        &                                         external_partitioner,
       const MPI_Comm &                            communicator,
       LinearAlgebra::distributed::Vector<Number> &ghosted_level_vector,
       std::vector<std::pair<unsigned int, unsigned int>>
@@ -398,19 +402,45 @@ namespace internal
                                            ghosted_level_dofs.end()));
       ghosted_dofs.compress();
 
-      // Add possible ghosts from the previous content in the vector
-      if (ghosted_level_vector.size() == locally_owned.size())
+      // Add possible ghosts from the previous content in the vector. The
+      // copy indices refer to the local numbering of the old partitioner, so
+      // translate them to global indices until the new partitioner is set
+      const bool has_copy_indices =
+        ghosted_level_vector.size() == locally_owned.size();
+      if (has_copy_indices)
         {
-          // shift the local number of the copy indices according to the new
-          // partitioner that we are going to use for the vector
           const auto &part = ghosted_level_vector.get_partitioner();
           ghosted_dofs.add_indices(part->ghost_indices());
           for (auto &indices : copy_indices_global_mine)
-            indices.second = locally_owned.n_elements() +
-                             ghosted_dofs.index_within_set(
-                               part->local_to_global(indices.second));
+            indices.second = part->local_to_global(indices.second);
+        }
+
+      bool use_external_partitioner = false;
+      if (external_partitioner.get() != nullptr)
+        {
+          Assert(external_partitioner->locally_owned_range() == locally_owned,
+                 ExcMessage("The locally owned range of the external "
+                            "partitioner does not match the level degrees "
+                            "of freedom."));
+          IndexSet missing_ghosts = ghosted_dofs;
+          missing_ghosts.subtract_set(external_partitioner->ghost_indices());
+          missing_ghosts.subtract_set(locally_owned);
+          use_external_partitioner =
+            Utilities::MPI::min(missing_ghosts.n_elements() == 0 ? 1U : 0U,
+                                communicator) == 1U;
+        }
+
+      if (use_external_partitioner)
+        ghosted_level_vector.reinit(external_partitioner);
+      else
+        ghosted_level_vector.reinit(locally_owned, ghosted_dofs, communicator);
+
+      if (has_copy_indices)
+        {
+          const auto &part = ghosted_level_vector.get_partitioner();
+          for (auto &indices : copy_indices_global_mine)
+            indices.second = part->global_to_local(indices.second);
         }
-      ghosted_level_vector.reinit(locally_owned, ghosted_dofs, communicator);
     }
 
     // Transform the ghost indices to local index space for the vector
@@ -606,7 +636,9 @@ namespace internal
       std::vector<std::vector<std::pair<unsigned int, unsigned int>>>
         &copy_indices_global_mine,
       MGLevelObject<LinearAlgebra::distributed::Vector<Number>>
-        &ghosted_level_vector)
+        &ghosted_level_vector,
+      const std::vector<std::shared_ptr<const Utilities::MPI::Partitioner>>
+        &external_partitioners)
     {
       level_dof_indices.clear();
       parent_child_connect.clear();
@@ -641,6 +673,9 @@ namespace internal
       // -------------- 2. Extract and match dof indices between child and
       // parent
       const unsigned int n_levels = tria.n_global_levels();
+      Assert(external_partitioners.empty() ||
+               external_partitioners.size() == n_levels,
+             ExcDimensionMismatch(external_partitioners.size(), n_levels));
       level_dof_indices.resize(n_levels);
       parent_child_connect.resize(n_levels - 1);
       n_owned_level_cells.resize(n_levels - 1);
@@ -863,6 +898,9 @@ namespace internal
 
           reinit_ghosted_vector(mg_dof.locally_owned_mg_dofs(level),
                                 ghosted_level_dofs,
+                                external_partitioners.empty() ?
+                                  nullptr :
+                                  external_partitioners[level],
                                 communicator,
                                 ghosted_level_vector[level],
                                 copy_indices_global_mine[level]);
@@ -880,6 +918,9 @@ namespace internal
 
               reinit_ghosted_vector(mg_dof.locally_owned_mg_dofs(0),
                                     ghosted_level_dofs_l0,
+                                    external_partitioners.empty() ?
+                                      nullptr :
+                                      external_partitioners[0],
                                     communicator,
                                     ghosted_level_vector[0],
                                     copy_indices_global_mine[0]);
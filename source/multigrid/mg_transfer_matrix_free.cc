@@ -94,7 +94,10 @@ MGTransferMatrixFree<dim, Number>::clear()
 
 template <int dim, typename Number>
 void
-MGTransferMatrixFree<dim, Number>::build(const DoFHandler<dim, dim> &mg_dof)
+MGTransferMatrixFree<dim, Number>::build(
+  const DoFHandler<dim, dim> &mg_dof,
+  const std::vector<std::shared_ptr<const Utilities::MPI::Partitioner>>
+    &external_partitioners)
 {
   this->fill_and_communicate_copy_indices(mg_dof);
 
@@ -112,7 +115,8 @@ MGTransferMatrixFree<dim, Number>::build(const DoFHandler<dim, dim> &mg_dof)
     dirichlet_indices,
     weights_unvectorized,
     this->copy_indices_global_mine,
-    this->ghosted_level_vector);
+    this->ghosted_level_vector,
+    external_partitioners);
   // unpack element info data
   fe_degree             = elem_info.fe_degree;
   element_is_continuous = elem_info.element_is_continuous;
@@ -159,6 +163,19 @@ MGTransferMatrixFree<dim, Number>::prolongate(
   const unsigned int                                to_level,
   LinearAlgebra::distributed::Vector<Number> &      dst,
   const LinearAlgebra::distributed::Vector<Number> &src) const
+{
+  dst = 0.;
+  prolongate_and_add(to_level, dst, src);
+}
+
+
+
+template <int dim, typename Number>
+void
+MGTransferMatrixFree<dim, Number>::prolongate_and_add(
+  const unsigned int                                to_level,
+  LinearAlgebra::distributed::Vector<Number> &      dst,
+  const LinearAlgebra::distributed::Vector<Number> &src) const
 {
   Assert((to_level >= 1) && (to_level <= level_dof_indices.size()),
          ExcIndexRange(to_level, 1, level_dof_indices.size() + 1));
@@ -168,64 +185,65 @@ MGTransferMatrixFree<dim, Number>::prolongate(
   AssertDimension(this->ghosted_level_vector[to_level - 1].local_size(),
                   src.local_size());
 
-  this->ghosted_level_vector[to_level - 1].copy_locally_owned_data_from(src);
-  this->ghosted_level_vector[to_level - 1].update_ghost_values();
-  this->ghosted_level_vector[to_level] = 0.;
+  // if the vectors use the partitioners of the transfer, we can work on them
+  // directly and skip the copies into the internal ghosted vectors
+  const bool src_inplace =
+    src.get_partitioner().get() ==
+    this->ghosted_level_vector[to_level - 1].get_partitioner().get();
+  const bool dst_inplace =
+    dst.get_partitioner().get() ==
+    this->ghosted_level_vector[to_level].get_partitioner().get();
+  const bool src_was_ghosted = src_inplace && src.has_ghost_elements();
+
+  if (src_inplace == false)
+    this->ghosted_level_vector[to_level - 1].copy_locally_owned_data_from(src);
+  const LinearAlgebra::distributed::Vector<Number> &src_vec =
+    src_inplace ? src : this->ghosted_level_vector[to_level - 1];
+  if (src_was_ghosted == false)
+    src_vec.update_ghost_values();
+
+  // the ghost entries of the destination collect the contributions to be
+  // sent to their owners by compress(), so they must start out as zero
+  if (dst_inplace)
+    dst.zero_out_ghosts();
+  else
+    this->ghosted_level_vector[to_level] = 0.;
+  LinearAlgebra::distributed::Vector<Number> &dst_vec =
+    dst_inplace ? dst : this->ghosted_level_vector[to_level];
 
   // the implementation in do_prolongate_add is templated in the degree of the
   // element (for efficiency reasons), so we need to find the appropriate
   // kernel here...
   if (fe_degree == 0)
-    do_prolongate_add<0>(to_level,
-                         this->ghosted_level_vector[to_level],
-                         this->ghosted_level_vector[to_level - 1]);
+    do_prolongate_add<0>(to_level, dst_vec, src_vec);
   else if (fe_degree == 1)
-    do_prolongate_add<1>(to_level,
-                         this->ghosted_level_vector[to_level],
-                         this->ghosted_level_vector[to_level - 1]);
+    do_prolongate_add<1>(to_level, dst_vec, src_vec);
   else if (fe_degree == 2)
-    do_prolongate_add<2>(to_level,
-                         this->ghosted_level_vector[to_level],
-                         this->ghosted_level_vector[to_level - 1]);
+    do_prolongate_add<2>(to_level, dst_vec, src_vec);
   else if (fe_degree == 3)
-    do_prolongate_add<3>(to_level,
-                         this->ghosted_level_vector[to_level],
-                         this->ghosted_level_vector[to_level - 1]);
+    do_prolongate_add<3>(to_level, dst_vec, src_vec);
   else if (fe_degree == 4)
-    do_prolongate_add<4>(to_level,
-                         this->ghosted_level_vector[to_level],
-                         this->ghosted_level_vector[to_level - 1]);
+    do_prolongate_add<4>(to_level, dst_vec, src_vec);
   else if (fe_degree == 5)
-    do_prolongate_add<5>(to_level,
-                         this->ghosted_level_vector[to_level],
-                         this->ghosted_level_vector[to_level - 1]);
+    do_prolongate_add<5>(to_level, dst_vec, src_vec);
   else if (fe_degree == 6)
-    do_prolongate_add<6>(to_level,
-                         this->ghosted_level_vector[to_level],
-                         this->ghosted_level_vector[to_level - 1]);
+    do_prolongate_add<6>(to_level, dst_vec, src_vec);
   else if (fe_degree == 7)
-    do_prolongate_add<7>(to_level,
-                         this->ghosted_level_vector[to_level],
-                         this->ghosted_level_vector[to_level - 1]);
+    do_prolongate_add<7>(to_level, dst_vec, src_vec);
   else if (fe_degree == 8)
-    do_prolongate_add<8>(to_level,
-                         this->ghosted_level_vector[to_level],
-                         this->ghosted_level_vector[to_level - 1]);
+    do_prolongate_add<8>(to_level, dst_vec, src_vec);
   else if (fe_degree == 9)
-    do_prolongate_add<9>(to_level,
-                         this->ghosted_level_vector[to_level],
-                         this->ghosted_level_vector[to_level - 1]);
+    do_prolongate_add<9>(to_level, dst_vec, src_vec);
   else if (fe_degree == 10)
-    do_prolongate_add<10>(to_level,
-                          this->ghosted_level_vector[to_level],
-                          this->ghosted_level_vector[to_level - 1]);
+    do_prolongate_add<10>(to_level, dst_vec, src_vec);
   else
-    do_prolongate_add<-1>(to_level,
-                          this->ghosted_level_vector[to_level],
-                          this->ghosted_level_vector[to_level - 1]);
+    do_prolongate_add<-1>(to_level, dst_vec, src_vec);
 
-  this->ghosted_level_vector[to_level].compress(VectorOperation::add);
-  dst.copy_locally_owned_data_from(this->ghosted_level_vector[to_level]);
+  dst_vec.compress(VectorOperation::add);
+  if (dst_inplace == false)
+    dst += this->ghosted_level_vector[to_level];
+  if (src_inplace && src_was_ghosted == false)
+    src.zero_out_ghosts();
 }
 
 
@@ -245,62 +263,59 @@ MGTransferMatrixFree<dim, Number>::restrict_and_add(
   AssertDimension(this->ghosted_level_vector[from_level - 1].local_size(),
                   dst.local_size());
 
-  this->ghosted_level_vector[from_level].copy_locally_owned_data_from(src);
-  this->ghosted_level_vector[from_level].update_ghost_values();
-  this->ghosted_level_vector[from_level - 1] = 0.;
+  const bool src_inplace =
+    src.get_partitioner().get() ==
+    this->ghosted_level_vector[from_level].get_partitioner().get();
+  const bool dst_inplace =
+    dst.get_partitioner().get() ==
+    this->ghosted_level_vector[from_level - 1].get_partitioner().get();
+  const bool src_was_ghosted = src_inplace && src.has_ghost_elements();
+
+  if (src_inplace == false)
+    this->ghosted_level_vector[from_level].copy_locally_owned_data_from(src);
+  const LinearAlgebra::distributed::Vector<Number> &src_vec =
+    src_inplace ? src : this->ghosted_level_vector[from_level];
+  if (src_was_ghosted == false)
+    src_vec.update_ghost_values();
+
+  if (dst_inplace)
+    dst.zero_out_ghosts();
+  else
+    this->ghosted_level_vector[from_level - 1] = 0.;
+  LinearAlgebra::distributed::Vector<Number> &dst_vec =
+    dst_inplace ? dst : this->ghosted_level_vector[from_level - 1];
 
   if (fe_degree == 0)
-    do_restrict_add<0>(from_level,
-                       this->ghosted_level_vector[from_level - 1],
-                       this->ghosted_level_vector[from_level]);
+    do_restrict_add<0>(from_level, dst_vec, src_vec);
   else if (fe_degree == 1)
-    do_restrict_add<1>(from_level,
-                       this->ghosted_level_vector[from_level - 1],
-                       this->ghosted_level_vector[from_level]);
+    do_restrict_add<1>(from_level, dst_vec, src_vec);
   else if (fe_degree == 2)
-    do_restrict_add<2>(from_level,
-                       this->ghosted_level_vector[from_level - 1],
-                       this->ghosted_level_vector[from_level]);
+    do_restrict_add<2>(from_level, dst_vec, src_vec);
   else if (fe_degree == 3)
-    do_restrict_add<3>(from_level,
-                       this->ghosted_level_vector[from_level - 1],
-                       this->ghosted_level_vector[from_level]);
+    do_restrict_add<3>(from_level, dst_vec, src_vec);
   else if (fe_degree == 4)
-    do_restrict_add<4>(from_level,
-                       this->ghosted_level_vector[from_level - 1],
-                       this->ghosted_level_vector[from_level]);
+    do_restrict_add<4>(from_level, dst_vec, src_vec);
   else if (fe_degree == 5)
-    do_restrict_add<5>(from_level,
-                       this->ghosted_level_vector[from_level - 1],
-                       this->ghosted_level_vector[from_level]);
+    do_restrict_add<5>(from_level, dst_vec, src_vec);
   else if (fe_degree == 6)
-    do_restrict_add<6>(from_level,
-                       this->ghosted_level_vector[from_level - 1],
-                       this->ghosted_level_vector[from_level]);
+    do_restrict_add<6>(from_level, dst_vec, src_vec);
   else if (fe_degree == 7)
-    do_restrict_add<7>(from_level,
-                       this->ghosted_level_vector[from_level - 1],
-                       this->ghosted_level_vector[from_level]);
+    do_restrict_add<7>(from_level, dst_vec, src_vec);
   else if (fe_degree == 8)
-    do_restrict_add<8>(from_level,
-                       this->ghosted_level_vector[from_level - 1],
-                       this->ghosted_level_vector[from_level]);
+    do_restrict_add<8>(from_level, dst_vec, src_vec);
   else if (fe_degree == 9)
-    do_restrict_add<9>(from_level,
-                       this->ghosted_level_vector[from_level - 1],
-                       this->ghosted_level_vector[from_level]);
+    do_restrict_add<9>(from_level, dst_vec, src_vec);
   else if (fe_degree == 10)
-    do_restrict_add<10>(from_level,
-                        this->ghosted_level_vector[from_level - 1],
-                        this->ghosted_level_vector[from_level]);
+    do_restrict_add<10>(from_level, dst_vec, src_vec);
   else
     // go to the non-templated version of the evaluator
-    do_restrict_add<-1>(from_level,
-                        this->ghosted_level_vector[from_level - 1],
-                        this->ghosted_level_vector[from_level]);
+    do_restrict_add<-1>(from_level, dst_vec, src_vec);
 
-  this->ghosted_level_vector[from_level - 1].compress(VectorOperation::add);
-  dst += this->ghosted_level_vector[from_level - 1];
+  dst_vec.compress(VectorOperation::add);
+  if (dst_inplace == false)
+    dst += this->ghosted_level_vector[from_level - 1];
+  if (src_inplace && src_was_ghosted == false)
+    src.zero_out_ghosts();
 }
 
 
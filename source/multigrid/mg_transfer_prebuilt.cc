@@ -16,6 +16,9 @@
 
 #include <deal.II/base/function.h>
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/dofs/dof_accessor.h>
 #include <deal.II/dofs/dof_tools.h>
@@ -190,79 +193,156 @@ MGTransferPrebuilt<VectorType>::build_matrices(
         new typename internal::MatrixSelector<VectorType>::Matrix);
     }
 
-  // two fields which will store the
-  // indices of the multigrid dofs
-  // for a cell and one of its children
-  std::vector<types::global_dof_index> dof_indices_parent(dofs_per_cell);
-  std::vector<types::global_dof_index> dof_indices_child(dofs_per_cell);
-  std::vector<types::global_dof_index> entries(dofs_per_cell);
-
-  // for each level: first build the sparsity
-  // pattern of the matrices and then build the
-  // matrices themselves. note that we only
-  // need to take care of cells on the coarser
-  // level which have children
+  using CellIterator =
+    typename DoFHandler<dim, spacedim>::level_cell_iterator;
+  using number = typename VectorType::value_type;
+
+  // the indices of the multigrid dofs of a cell and its children, along with
+  // the prolongation matrices from the cell to each child
+  struct CellData
+  {
+    std::vector<types::global_dof_index>              dof_indices_parent;
+    std::vector<std::vector<types::global_dof_index>> dof_indices_children;
+    std::vector<FullMatrix<number>>                   prolongations;
+  };
+
+  const types::subdomain_id locally_owned_subdomain =
+    mg_dof.get_triangulation().locally_owned_subdomain();
+
+  // fill the data of a cell if it is one of the cells on the coarser level
+  // we need to take care of, i.e., a cell with children, and clear it
+  // otherwise. in case the prolongation is used for the actual matrix
+  // entries, the columns of dofs on the refinement edge are zeroed out
+  const auto get_cell_data = [&](const CellIterator &cell,
+                                 const bool          for_matrix,
+                                 CellData &          data) {
+    data.dof_indices_children.clear();
+    data.prolongations.clear();
+    if (!cell->has_children() ||
+        (locally_owned_subdomain != numbers::invalid_subdomain_id &&
+         cell->level_subdomain_id() != locally_owned_subdomain))
+      return;
+
+    const unsigned int level = cell->level();
+    data.dof_indices_parent.resize(dofs_per_cell);
+    cell->get_mg_dof_indices(data.dof_indices_parent);
+
+    replace(this->mg_constrained_dofs, level, data.dof_indices_parent);
+
+    Assert(cell->n_children() == GeometryInfo<dim>::max_children_per_cell,
+           ExcNotImplemented());
+    data.dof_indices_children.resize(
+      cell->n_children(), std::vector<types::global_dof_index>(dofs_per_cell));
+    data.prolongations.resize(cell->n_children());
+    for (unsigned int child = 0; child < cell->n_children(); ++child)
+      {
+        // In the end, the entries in the matrix will only be real valued.
+        // Nevertheless, we have to take the underlying scalar type of the
+        // vector we want to use this class with. The global matrix the
+        // entries of this matrix are copied into has to be able to perform a
+        // matrix-vector multiplication and this is in general only
+        // implemented if the scalar type for matrix and vector is the same.
+        // Furthermore, copying entries between this local object and the
+        // global matrix is only implemented if the objects have the same
+        // scalar type.
+        FullMatrix<number> &prolongation = data.prolongations[child];
+        prolongation = mg_dof.get_fe().get_prolongation_matrix(
+          child, cell->refinement_case());
+
+        Assert(prolongation.n() != 0, ExcNoProlongation());
+
+        if (for_matrix && this->mg_constrained_dofs != nullptr &&
+            this->mg_constrained_dofs->have_boundary_indices())
+          for (unsigned int j = 0; j < dofs_per_cell; ++j)
+            if (this->mg_constrained_dofs->is_boundary_index(
+                  level, data.dof_indices_parent[j]))
+              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                prolongation(i, j) = 0.;
+
+        cell->child(child)->get_mg_dof_indices(
+          data.dof_indices_children[child]);
+
+        replace(this->mg_constrained_dofs,
+                level + 1,
+                data.dof_indices_children[child]);
+      }
+  };
+
+  // first build the sparsity patterns of the matrices on all levels. the
+  // levels are independent of each other, so they are worked on as separate
+  // tasks, and the cells of each level are in turn worked on in parallel,
+  // adding their entries concurrently to the pattern of the level. note that
+  // we only need to take care of cells on the coarser level which have
+  // children
+  //
+  // note that for the number of entries per row, the number of parent dofs
+  // coupling to a child dof is necessary. this, of course, is the number of
+  // degrees of freedom per cell
+  std::vector<DynamicSparsityPattern> dsps(n_levels - 1);
+  {
+    Threads::TaskGroup<> tasks;
+    for (unsigned int level = 0; level < n_levels - 1; ++level)
+      tasks += Threads::new_task([&, level]() {
+        IndexSet level_p1_relevant_dofs;
+        DoFTools::extract_locally_relevant_level_dofs(mg_dof,
+                                                      level + 1,
+                                                      level_p1_relevant_dofs);
+        DynamicSparsityPattern &dsp = dsps[level];
+        dsp.reinit(this->sizes[level + 1],
+                   this->sizes[level],
+                   level_p1_relevant_dofs);
+
+        dsp.set_thread_safe_insertion(MultithreadInfo::n_threads() > 1);
+        WorkStream::run(
+          CellIterator(mg_dof.begin(level)),
+          CellIterator(mg_dof.end(level)),
+          [&](const CellIterator &cell, CellData &data, int &) {
+            get_cell_data(cell, false, data);
+            if (data.dof_indices_children.empty())
+              return;
+
+            // now tag the entries in the matrix which will be used for each
+            // pair of parent/child. the parent dofs are sorted once so that
+            // the entries of each row come out sorted as well
+            std::vector<std::pair<types::global_dof_index, unsigned int>>
+              sorted_parent(dofs_per_cell);
+            for (unsigned int j = 0; j < dofs_per_cell; ++j)
+              sorted_parent[j] = {data.dof_indices_parent[j], j};
+            std::sort(sorted_parent.begin(), sorted_parent.end());
+
+            std::vector<types::global_dof_index> entries;
+            entries.reserve(dofs_per_cell);
+            for (unsigned int child = 0;
+                 child < data.dof_indices_children.size();
+                 ++child)
+              for (unsigned int i = 0; i < dofs_per_cell; ++i)
+                {
+                  entries.resize(0);
+                  for (const auto &parent : sorted_parent)
+                    if (data.prolongations[child](i, parent.second) != 0 &&
+                        (entries.empty() || entries.back() != parent.first))
+                      entries.push_back(parent.first);
+                  dsp.add_entries(data.dof_indices_children[child][i],
+                                  entries.begin(),
+                                  entries.end(),
+                                  true);
+                }
+          },
+          std::function<void(const int &)>(),
+          CellData(),
+          0);
+        dsp.set_thread_safe_insertion(false);
+      });
+    tasks.join_all();
+  }
+
+  // then build the matrices themselves. the setup of the matrices may
+  // involve communication, so the levels are processed one after the other
+  // here, and the sparsity pattern of each level is released as soon as the
+  // matrix has been initialized from it
   for (unsigned int level = 0; level < n_levels - 1; ++level)
     {
-      // reset the dimension of the structure.  note that for the number of
-      // entries per row, the number of parent dofs coupling to a child dof is
-      // necessary. this, of course, is the number of degrees of freedom per
-      // cell
-      //
-      // increment dofs_per_cell since a useless diagonal element will be
-      // stored
-      IndexSet level_p1_relevant_dofs;
-      DoFTools::extract_locally_relevant_level_dofs(mg_dof,
-                                                    level + 1,
-                                                    level_p1_relevant_dofs);
-      DynamicSparsityPattern                  dsp(this->sizes[level + 1],
-                                 this->sizes[level],
-                                 level_p1_relevant_dofs);
-      typename DoFHandler<dim>::cell_iterator cell, endc = mg_dof.end(level);
-      for (cell = mg_dof.begin(level); cell != endc; ++cell)
-        if (cell->has_children() &&
-            (mg_dof.get_triangulation().locally_owned_subdomain() ==
-               numbers::invalid_subdomain_id ||
-             cell->level_subdomain_id() ==
-               mg_dof.get_triangulation().locally_owned_subdomain()))
-          {
-            cell->get_mg_dof_indices(dof_indices_parent);
-
-            replace(this->mg_constrained_dofs, level, dof_indices_parent);
-
-            Assert(cell->n_children() ==
-                     GeometryInfo<dim>::max_children_per_cell,
-                   ExcNotImplemented());
-            for (unsigned int child = 0; child < cell->n_children(); ++child)
-              {
-                // set an alias to the prolongation matrix for this child
-                const FullMatrix<double> &prolongation =
-                  mg_dof.get_fe().get_prolongation_matrix(
-                    child, cell->refinement_case());
-
-                Assert(prolongation.n() != 0, ExcNoProlongation());
-
-                cell->child(child)->get_mg_dof_indices(dof_indices_child);
-
-                replace(this->mg_constrained_dofs,
-                        level + 1,
-                        dof_indices_child);
-
-                // now tag the entries in the
-                // matrix which will be used
-                // for this pair of parent/child
-                for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                  {
-                    entries.resize(0);
-                    for (unsigned int j = 0; j < dofs_per_cell; ++j)
-                      if (prolongation(i, j) != 0)
-                        entries.push_back(dof_indices_parent[j]);
-                    dsp.add_entries(dof_indices_child[i],
-                                    entries.begin(),
-                                    entries.end());
-                  }
-              }
-          }
+      DynamicSparsityPattern &dsp = dsps[level];
 
 #ifdef DEAL_II_WITH_MPI
       if (internal::MatrixSelector<
@@ -314,60 +394,29 @@ MGTransferPrebuilt<VectorType>::build_matrices(
         mg_dof);
       dsp.reinit(0, 0);
 
-      // In the end, the entries in this object will only be real valued.
-      // Nevertheless, we have to take the underlying scalar type of the
-      // vector we want to use this class with. The global matrix the entries
-      // of this matrix are copied into has to be able to perform a
-      // matrix-vector multiplication and this is in general only implemented if
-      // the scalar type for matrix and vector is the same. Furthermore,
-      // copying entries between this local object and the global matrix is only
-      // implemented if the objects have the same scalar type.
-      FullMatrix<typename VectorType::value_type> prolongation;
-
-      // now actually build the matrices
-      for (cell = mg_dof.begin(level); cell != endc; ++cell)
-        if (cell->has_children() &&
-            (mg_dof.get_triangulation().locally_owned_subdomain() ==
-               numbers::invalid_subdomain_id ||
-             cell->level_subdomain_id() ==
-               mg_dof.get_triangulation().locally_owned_subdomain()))
-          {
-            cell->get_mg_dof_indices(dof_indices_parent);
-
-            replace(this->mg_constrained_dofs, level, dof_indices_parent);
-
-            Assert(cell->n_children() ==
-                     GeometryInfo<dim>::max_children_per_cell,
-                   ExcNotImplemented());
-            for (unsigned int child = 0; child < cell->n_children(); ++child)
-              {
-                // set an alias to the prolongation matrix for this child
-                prolongation = mg_dof.get_fe().get_prolongation_matrix(
-                  child, cell->refinement_case());
-
-                if (this->mg_constrained_dofs != nullptr &&
-                    this->mg_constrained_dofs->have_boundary_indices())
-                  for (unsigned int j = 0; j < dofs_per_cell; ++j)
-                    if (this->mg_constrained_dofs->is_boundary_index(
-                          level, dof_indices_parent[j]))
-                      for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                        prolongation(i, j) = 0.;
-
-                cell->child(child)->get_mg_dof_indices(dof_indices_child);
-
-                replace(this->mg_constrained_dofs,
-                        level + 1,
-                        dof_indices_child);
-
-                // now set the entries in the matrix
-                for (unsigned int i = 0; i < dofs_per_cell; ++i)
-                  prolongation_matrices[level]->set(dof_indices_child[i],
-                                                    dofs_per_cell,
-                                                    dof_indices_parent.data(),
-                                                    &prolongation(i, 0),
-                                                    true);
-              }
-          }
+      // now actually build the matrices. the entries of a cell are computed
+      // in parallel, while setting them in the matrix is done sequentially
+      WorkStream::run(
+        CellIterator(mg_dof.begin(level)),
+        CellIterator(mg_dof.end(level)),
+        [&](const CellIterator &cell, int &, CellData &data) {
+          get_cell_data(cell, true, data);
+        },
+        [&](const CellData &data) {
+          // now set the entries in the matrix
+          for (unsigned int child = 0;
+               child < data.dof_indices_children.size();
+               ++child)
+            for (unsigned int i = 0; i < dofs_per_cell; ++i)
+              prolongation_matrices[level]->set(
+                data.dof_indices_children[child][i],
+                dofs_per_cell,
+                data.dof_indices_parent.data(),
+                &data.prolongations[child](i, 0),
+                true);
+        },
+        0,
+        CellData());
       prolongation_matrices[level]->compress(VectorOperation::insert);
     }
 
@@ -14,8 +14,10 @@
 // ---------------------------------------------------------------------
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/work_stream.h>
 
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria.h>
@@ -124,6 +126,165 @@ namespace NonMatching
       }
       return {std::move(points_over_local_cells), std::move(used_cells_ids)};
     }
+
+
+
+    /**
+     * Locate the quadrature points of all cells of the immersed triangulation
+     * in the embedding triangulation of @p cache. For each active cell of the
+     * immersed triangulation (in the order of their active cell indices),
+     * return the embedding cells containing some of its quadrature points,
+     * and, for each of these cells, the reference coordinates of the points
+     * and their indices within the quadrature formula @p quad.
+     */
+    template <int dim0, int dim1, int spacedim>
+    std::tuple<
+      std::vector<std::vector<
+        typename Triangulation<dim0, spacedim>::active_cell_iterator>>,
+      std::vector<std::vector<std::vector<Point<dim0>>>>,
+      std::vector<std::vector<std::vector<unsigned int>>>>
+    compute_coupling_point_locations(
+      const GridTools::Cache<dim0, spacedim> &cache,
+      const DoFHandler<dim1, spacedim> &      immersed_dh,
+      const Quadrature<dim1> &                quad,
+      const Mapping<dim1, spacedim> &         immersed_mapping,
+      const bool                              tria_is_parallel)
+    {
+      const unsigned int n_q_points = quad.size();
+      const unsigned int n_active_c =
+        immersed_dh.get_triangulation().n_active_cells();
+
+      const auto used_cells_data = qpoints_over_locally_owned_cells(
+        cache, immersed_dh, quad, immersed_mapping, tria_is_parallel);
+
+      const auto &points_over_local_cells = std::get<0>(used_cells_data);
+      const auto &used_cells_ids          = std::get<1>(used_cells_data);
+
+      // Get a list of outer cells, qpoints and maps.
+      const auto cpm =
+        GridTools::compute_point_locations(cache, points_over_local_cells);
+      const auto &all_cells   = std::get<0>(cpm);
+      const auto &all_qpoints = std::get<1>(cpm);
+      const auto &all_maps    = std::get<2>(cpm);
+
+      std::vector<std::vector<
+        typename Triangulation<dim0, spacedim>::active_cell_iterator>>
+        cell_container(n_active_c);
+      std::vector<std::vector<std::vector<Point<dim0>>>> qpoints_container(
+        n_active_c);
+      std::vector<std::vector<std::vector<unsigned int>>> maps_container(
+        n_active_c);
+
+      // Cycle over all cells of underling mesh found
+      // call it omesh, elaborating the output
+      for (unsigned int o = 0; o < all_cells.size(); ++o)
+        {
+          for (unsigned int j = 0; j < all_maps[o].size(); ++j)
+            {
+              // Find the index of the "owner" cell and qpoint
+              // with regard to the immersed mesh
+              // Find in which cell of immersed triangulation the point lies
+              unsigned int cell_id;
+              if (tria_is_parallel)
+                cell_id = used_cells_ids[all_maps[o][j] / n_q_points];
+              else
+                cell_id = all_maps[o][j] / n_q_points;
+
+              const unsigned int n_pt = all_maps[o][j] % n_q_points;
+
+              // If there are no cells, we just add our data
+              if (cell_container[cell_id].empty())
+                {
+                  cell_container[cell_id].emplace_back(all_cells[o]);
+                  qpoints_container[cell_id].emplace_back(
+                    std::vector<Point<dim0>>{all_qpoints[o][j]});
+                  maps_container[cell_id].emplace_back(
+                    std::vector<unsigned int>{n_pt});
+                }
+              // If there are already cells, we begin by looking
+              // at the last inserted cell, which is more likely:
+              else if (cell_container[cell_id].back() == all_cells[o])
+                {
+                  qpoints_container[cell_id].back().emplace_back(
+                    all_qpoints[o][j]);
+                  maps_container[cell_id].back().emplace_back(n_pt);
+                }
+              else
+                {
+                  // We don't need to check the last element
+                  const auto cell_p =
+                    std::find(cell_container[cell_id].begin(),
+                              cell_container[cell_id].end() - 1,
+                              all_cells[o]);
+
+                  if (cell_p == cell_container[cell_id].end() - 1)
+                    {
+                      cell_container[cell_id].emplace_back(all_cells[o]);
+                      qpoints_container[cell_id].emplace_back(
+                        std::vector<Point<dim0>>{all_qpoints[o][j]});
+                      maps_container[cell_id].emplace_back(
+                        std::vector<unsigned int>{n_pt});
+                    }
+                  else
+                    {
+                      const unsigned int pos =
+                        cell_p - cell_container[cell_id].begin();
+                      qpoints_container[cell_id][pos].emplace_back(
+                        all_qpoints[o][j]);
+                      maps_container[cell_id][pos].emplace_back(n_pt);
+                    }
+                }
+            }
+        }
+
+      return std::make_tuple(std::move(cell_container),
+                             std::move(qpoints_container),
+                             std::move(maps_container));
+    }
+
+
+
+    /**
+     * Scratch data for the assembly of the coupling mass matrix on the cells
+     * of the immersed triangulation.
+     */
+    template <int dim1, int spacedim>
+    struct CouplingMassMatrixScratchData
+    {
+      CouplingMassMatrixScratchData(const Mapping<dim1, spacedim> &    mapping,
+                                    const FiniteElement<dim1, spacedim> &fe,
+                                    const Quadrature<dim1> &             quad)
+        : fe_v(mapping,
+               fe,
+               quad,
+               update_JxW_values | update_quadrature_points | update_values)
+      {}
+
+      CouplingMassMatrixScratchData(
+        const CouplingMassMatrixScratchData<dim1, spacedim> &scratch)
+        : fe_v(scratch.fe_v.get_mapping(),
+               scratch.fe_v.get_fe(),
+               scratch.fe_v.get_quadrature(),
+               scratch.fe_v.get_update_flags())
+      {}
+
+      FEValues<dim1, spacedim> fe_v;
+    };
+
+
+
+    /**
+     * Copy data for the assembly of the coupling mass matrix: the local
+     * matrices of one immersed cell with each of the locally owned
+     * embedding cells it overlaps.
+     */
+    template <typename Number>
+    struct CouplingMassMatrixCopyData
+    {
+      std::vector<types::global_dof_index>              dofs;
+      std::vector<std::vector<types::global_dof_index>> odofs;
+      std::vector<FullMatrix<Number>>                   cell_matrices;
+    };
   } // namespace internal
 
   template <int dim0,
@@ -373,10 +534,6 @@ namespace NonMatching
     const auto &space_fe    = space_dh.get_fe();
     const auto &immersed_fe = immersed_dh.get_fe();
 
-    // Dof indices
-    std::vector<types::global_dof_index> dofs(immersed_fe.dofs_per_cell);
-    std::vector<types::global_dof_index> odofs(space_fe.dofs_per_cell);
-
     // Take care of components
     const ComponentMask space_c =
       (space_comps.size() == 0 ? ComponentMask(space_fe.n_components(), true) :
@@ -403,115 +560,41 @@ namespace NonMatching
       if (immersed_c[i])
         immersed_gtl[i] = j++;
 
-    FullMatrix<typename Matrix::value_type> cell_matrix(
-      space_dh.get_fe().dofs_per_cell, immersed_dh.get_fe().dofs_per_cell);
-
-    FEValues<dim1, spacedim> fe_v(immersed_mapping,
-                                  immersed_dh.get_fe(),
-                                  quad,
-                                  update_JxW_values | update_quadrature_points |
-                                    update_values);
-
-    const unsigned int n_q_points = quad.size();
-    const unsigned int n_active_c =
-      immersed_dh.get_triangulation().n_active_cells();
-
-    const auto used_cells_data = internal::qpoints_over_locally_owned_cells(
+    // Get, for each immersed cell, the embedding cells overlapping it, the
+    // reference coordinates of the quadrature points in these cells, and the
+    // indices of these quadrature points in the immersed cell.
+    const auto point_data = internal::compute_coupling_point_locations(
       cache, immersed_dh, quad, immersed_mapping, tria_is_parallel);
+    const auto &cell_container    = std::get<0>(point_data);
+    const auto &qpoints_container = std::get<1>(point_data);
+    const auto &maps_container    = std::get<2>(point_data);
+
+    using Number = typename Matrix::value_type;
+
+    // The local matrices of different immersed cells are independent of each
+    // other, so we compute them in parallel and only serialize the
+    // distribution into the global matrix.
+    auto worker =
+      [&](const typename DoFHandler<dim1, spacedim>::active_cell_iterator &cell,
+          internal::CouplingMassMatrixScratchData<dim1, spacedim> &scratch,
+          internal::CouplingMassMatrixCopyData<Number> &           copy) {
+        copy.odofs.clear();
+        copy.cell_matrices.clear();
 
-    const auto &points_over_local_cells = std::get<0>(used_cells_data);
-    const auto &used_cells_ids          = std::get<1>(used_cells_data);
-
-    // Get a list of outer cells, qpoints and maps.
-    const auto cpm =
-      GridTools::compute_point_locations(cache, points_over_local_cells);
-    const auto &all_cells   = std::get<0>(cpm);
-    const auto &all_qpoints = std::get<1>(cpm);
-    const auto &all_maps    = std::get<2>(cpm);
-
-    std::vector<
-      std::vector<typename Triangulation<dim0, spacedim>::active_cell_iterator>>
-                                                       cell_container(n_active_c);
-    std::vector<std::vector<std::vector<Point<dim0>>>> qpoints_container(
-      n_active_c);
-    std::vector<std::vector<std::vector<unsigned int>>> maps_container(
-      n_active_c);
-
-    // Cycle over all cells of underling mesh found
-    // call it omesh, elaborating the output
-    for (unsigned int o = 0; o < all_cells.size(); ++o)
-      {
-        for (unsigned int j = 0; j < all_maps[o].size(); ++j)
-          {
-            // Find the index of the "owner" cell and qpoint
-            // with regard to the immersed mesh
-            // Find in which cell of immersed triangulation the point lies
-            unsigned int cell_id;
-            if (tria_is_parallel)
-              cell_id = used_cells_ids[all_maps[o][j] / n_q_points];
-            else
-              cell_id = all_maps[o][j] / n_q_points;
-
-            const unsigned int n_pt = all_maps[o][j] % n_q_points;
-
-            // If there are no cells, we just add our data
-            if (cell_container[cell_id].empty())
-              {
-                cell_container[cell_id].emplace_back(all_cells[o]);
-                qpoints_container[cell_id].emplace_back(
-                  std::vector<Point<dim0>>{all_qpoints[o][j]});
-                maps_container[cell_id].emplace_back(
-                  std::vector<unsigned int>{n_pt});
-              }
-            // If there are already cells, we begin by looking
-            // at the last inserted cell, which is more likely:
-            else if (cell_container[cell_id].back() == all_cells[o])
-              {
-                qpoints_container[cell_id].back().emplace_back(
-                  all_qpoints[o][j]);
-                maps_container[cell_id].back().emplace_back(n_pt);
-              }
-            else
-              {
-                // We don't need to check the last element
-                const auto cell_p = std::find(cell_container[cell_id].begin(),
-                                              cell_container[cell_id].end() - 1,
-                                              all_cells[o]);
-
-                if (cell_p == cell_container[cell_id].end() - 1)
-                  {
-                    cell_container[cell_id].emplace_back(all_cells[o]);
-                    qpoints_container[cell_id].emplace_back(
-                      std::vector<Point<dim0>>{all_qpoints[o][j]});
-                    maps_container[cell_id].emplace_back(
-                      std::vector<unsigned int>{n_pt});
-                  }
-                else
-                  {
-                    const unsigned int pos =
-                      cell_p - cell_container[cell_id].begin();
-                    qpoints_container[cell_id][pos].emplace_back(
-                      all_qpoints[o][j]);
-                    maps_container[cell_id][pos].emplace_back(n_pt);
-                  }
-              }
-          }
-      }
+        // Get a list of outer cells, qpoints and maps.
+        const unsigned int cell_id = cell->active_cell_index();
+        const auto &       cells   = cell_container[cell_id];
+        const auto &       qpoints = qpoints_container[cell_id];
+        const auto &       maps    = maps_container[cell_id];
 
-    typename DoFHandler<dim1, spacedim>::active_cell_iterator
-      cell = immersed_dh.begin_active(),
-      endc = immersed_dh.end();
+        if (cells.empty())
+          return;
 
-    for (unsigned int j = 0; cell != endc; ++cell, ++j)
-      {
         // Reinitialize the cell and the fe_values
-        fe_v.reinit(cell);
-        cell->get_dof_indices(dofs);
-
-        // Get a list of outer cells, qpoints and maps.
-        const auto &cells   = cell_container[j];
-        const auto &qpoints = qpoints_container[j];
-        const auto &maps    = maps_container[j];
+        const FEValues<dim1, spacedim> &fe_v = scratch.fe_v;
+        scratch.fe_v.reinit(cell);
+        copy.dofs.resize(immersed_fe.dofs_per_cell);
+        cell->get_dof_indices(copy.dofs);
 
         for (unsigned int c = 0; c < cells.size(); ++c)
           {
@@ -529,10 +612,12 @@ namespace NonMatching
                                                 qps,
                                                 update_values);
                 o_fe_v.reinit(ocell);
-                ocell->get_dof_indices(odofs);
+                copy.odofs.emplace_back(space_fe.dofs_per_cell);
+                ocell->get_dof_indices(copy.odofs.back());
 
-                // Reset the matrices.
-                cell_matrix = typename Matrix::value_type();
+                copy.cell_matrices.emplace_back(space_fe.dofs_per_cell,
+                                                immersed_fe.dofs_per_cell);
+                FullMatrix<Number> &cell_matrix = copy.cell_matrices.back();
 
                 for (unsigned int i = 0; i < space_dh.get_fe().dofs_per_cell;
                      ++i)
@@ -561,15 +646,132 @@ namespace NonMatching
                               }
                         }
                   }
-
-                // Now assemble the matrices
-                constraints.distribute_local_to_global(cell_matrix,
-                                                       odofs,
-                                                       dofs,
-                                                       matrix);
               }
           }
+      };
+
+    // Now assemble the matrices
+    auto copier =
+      [&](const internal::CouplingMassMatrixCopyData<Number> &copy) {
+        for (unsigned int c = 0; c < copy.cell_matrices.size(); ++c)
+          constraints.distribute_local_to_global(copy.cell_matrices[c],
+                                                 copy.odofs[c],
+                                                 copy.dofs,
+                                                 matrix);
+      };
+
+    WorkStream::run(
+      immersed_dh.begin_active(),
+      immersed_dh.end(),
+      worker,
+      copier,
+      internal::CouplingMassMatrixScratchData<dim1, spacedim>(immersed_mapping,
+                                                              immersed_fe,
+                                                              quad),
+      internal::CouplingMassMatrixCopyData<Number>());
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  CouplingMassOperator<dim0, dim1, spacedim>::CouplingMassOperator(
+    const GridTools::Cache<dim0, spacedim> &cache,
+    const DoFHandler<dim0, spacedim> &      space_dh,
+    const DoFHandler<dim1, spacedim> &      immersed_dh,
+    const Quadrature<dim1> &                quad,
+    const ComponentMask &                   space_comps,
+    const ComponentMask &                   immersed_comps,
+    const Mapping<dim1, spacedim> &         immersed_mapping)
+    : space_mapping(&cache.get_mapping())
+    , space_dh(&space_dh)
+    , immersed_dh(&immersed_dh)
+    , immersed_mapping(&immersed_mapping)
+    , quadrature(quad)
+  {
+    static_assert(dim1 <= dim0, "This class can only work if dim1 <= dim0");
+    Assert((dynamic_cast<
+              const parallel::distributed::Triangulation<dim1, spacedim> *>(
+              &immersed_dh.get_triangulation()) == nullptr),
+           ExcNotImplemented());
+
+    const bool tria_is_parallel =
+      (dynamic_cast<const parallel::Triangulation<dim1, spacedim> *>(
+         &space_dh.get_triangulation()) != nullptr);
+
+    const auto &space_fe    = space_dh.get_fe();
+    const auto &immersed_fe = immersed_dh.get_fe();
+
+    // Take care of components
+    const ComponentMask space_c =
+      (space_comps.size() == 0 ? ComponentMask(space_fe.n_components(), true) :
+                                 space_comps);
+
+    const ComponentMask immersed_c =
+      (immersed_comps.size() == 0 ?
+         ComponentMask(immersed_fe.n_components(), true) :
+         immersed_comps);
+
+    AssertDimension(space_c.size(), space_fe.n_components());
+    AssertDimension(immersed_c.size(), immersed_fe.n_components());
+
+    space_gtl.resize(space_fe.n_components(), numbers::invalid_unsigned_int);
+    immersed_gtl.resize(immersed_fe.n_components(),
+                        numbers::invalid_unsigned_int);
+
+    unsigned int n_space_components = 0;
+    for (unsigned int i = 0; i < space_gtl.size(); ++i)
+      if (space_c[i])
+        space_gtl[i] = n_space_components++;
+
+    unsigned int n_immersed_components = 0;
+    for (unsigned int i = 0; i < immersed_gtl.size(); ++i)
+      if (immersed_c[i])
+        immersed_gtl[i] = n_immersed_components++;
+
+    // Excess components of either space are ignored
+    n_coupled_components =
+      std::min(n_space_components, n_immersed_components);
+
+    const auto point_data = internal::compute_coupling_point_locations(
+      cache, immersed_dh, quad, immersed_mapping, tria_is_parallel);
+    const auto &cell_container    = std::get<0>(point_data);
+    const auto &qpoints_container = std::get<1>(point_data);
+    const auto &maps_container    = std::get<2>(point_data);
+
+    intersections.resize(cell_container.size());
+    for (unsigned int i = 0; i < cell_container.size(); ++i)
+      for (unsigned int c = 0; c < cell_container[i].size(); ++c)
+        {
+          typename DoFHandler<dim0, spacedim>::active_cell_iterator cell(
+            *cell_container[i][c], &space_dh);
+          // Only locally owned cells contribute
+          if (cell->is_locally_owned())
+            intersections[i].push_back(
+              {cell,
+               Quadrature<dim0>(qpoints_container[i][c]),
+               maps_container[i][c]});
+        }
+  }
+
+
+
+  template <int dim0, int dim1, int spacedim>
+  std::size_t
+  CouplingMassOperator<dim0, dim1, spacedim>::memory_consumption() const
+  {
+    std::size_t memory = sizeof(*this) +
+                         MemoryConsumption::memory_consumption(space_gtl) +
+                         MemoryConsumption::memory_consumption(immersed_gtl) +
+                         quadrature.memory_consumption();
+    for (const auto &cell_intersections : intersections)
+      {
+        memory += cell_intersections.capacity() * sizeof(CellIntersection);
+        for (const auto &intersection : cell_intersections)
+          memory += intersection.quadrature.memory_consumption() +
+                    MemoryConsumption::memory_consumption(
+                      intersection.q_indices);
       }
+    return memory;
   }
 
 #include "coupling.inst"
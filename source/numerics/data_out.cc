@@ -15,6 +15,8 @@
 
 #include <deal.II/base/work_stream.h>
 
+#include <deal.II/distributed/tria_base.h>
+
 #include <deal.II/dofs/dof_accessor.h>
 #include <deal.II/dofs/dof_handler.h>
 
@@ -31,6 +33,7 @@
 
 #include <deal.II/numerics/data_out.h>
 
+#include <algorithm>
 #include <sstream>
 
 DEAL_II_NAMESPACE_OPEN
@@ -59,12 +62,208 @@ namespace internal
                                         update_flags,
                                         false)
       , cell_to_patch_index_map(&cell_to_patch_index_map)
+      , postprocessor_batch_inputs(n_postprocessor_outputs.size())
     {}
   } // namespace DataOutImplementation
 } // namespace internal
 
 
 
+namespace
+{
+  /**
+   * Return whether all active descendants of @p cell are locally owned.
+   */
+  template <typename CellIterator>
+  bool
+  all_descendants_locally_owned(const CellIterator &cell)
+  {
+    if (cell->active())
+      return cell->is_locally_owned();
+
+    for (unsigned int c = 0; c < cell->n_children(); ++c)
+      if (!all_descendants_locally_owned(cell->child(c)))
+        return false;
+    return true;
+  }
+
+
+
+  /**
+   * Copy the values and derivatives of a scalar field at the @p n_points
+   * evaluation points of one cell into @p batch, starting at the point
+   * @p first_point of the batch.
+   */
+  template <int spacedim>
+  void
+  copy_to_batch(const DataPostprocessorInputs::Scalar<spacedim> &inputs,
+                const UpdateFlags                                update_flags,
+                const unsigned int                               n_points,
+                const unsigned int                               first_point,
+                DataPostprocessorInputs::Batch<spacedim> &       batch)
+  {
+    for (unsigned int q = 0; q < n_points; ++q)
+      {
+        if (update_flags & update_values)
+          batch.solution_values(0, first_point + q) = inputs.solution_values[q];
+        if (update_flags & update_gradients)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            batch.solution_gradients(0, d, first_point + q) =
+              inputs.solution_gradients[q][d];
+        if (update_flags & update_hessians)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            for (unsigned int e = 0; e < spacedim; ++e)
+              batch.solution_hessians(0, d, e, first_point + q) =
+                inputs.solution_hessians[q][d][e];
+        if (update_flags & update_quadrature_points)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            batch.evaluation_points(d, first_point + q) =
+              inputs.evaluation_points[q][d];
+      }
+  }
+
+
+
+  /**
+   * Same as above, for a vector-valued field.
+   */
+  template <int spacedim>
+  void
+  copy_to_batch(const DataPostprocessorInputs::Vector<spacedim> &inputs,
+                const UpdateFlags                                update_flags,
+                const unsigned int                               n_points,
+                const unsigned int                               first_point,
+                DataPostprocessorInputs::Batch<spacedim> &       batch)
+  {
+    const unsigned int n_components = batch.solution_values.size(0);
+    for (unsigned int q = 0; q < n_points; ++q)
+      {
+        for (unsigned int c = 0; c < n_components; ++c)
+          {
+            if (update_flags & update_values)
+              batch.solution_values(c, first_point + q) =
+                inputs.solution_values[q](c);
+            if (update_flags & update_gradients)
+              for (unsigned int d = 0; d < spacedim; ++d)
+                batch.solution_gradients(c, d, first_point + q) =
+                  inputs.solution_gradients[q][c][d];
+            if (update_flags & update_hessians)
+              for (unsigned int d = 0; d < spacedim; ++d)
+                for (unsigned int e = 0; e < spacedim; ++e)
+                  batch.solution_hessians(c, d, e, first_point + q) =
+                    inputs.solution_hessians[q][c][d][e];
+          }
+        if (update_flags & update_quadrature_points)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            batch.evaluation_points(d, first_point + q) =
+              inputs.evaluation_points[q][d];
+      }
+  }
+} // namespace
+
+
+
+template <int dim, typename DoFHandlerType>
+DataOut<dim, DoFHandlerType>::DataOut()
+  : max_output_level(numbers::invalid_unsigned_int)
+{}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::build_patch_batch(
+  const cell_batch *batch,
+  internal::DataOutImplementation::ParallelData<DoFHandlerType::dimension,
+                                                DoFHandlerType::space_dimension>
+    &                    scratch_data,
+  const unsigned int     n_subdivisions,
+  const CurvedCellRegion curved_cell_region,
+  const unsigned int     first_patch_index)
+{
+  const unsigned int n_cells = batch->second - batch->first;
+  const unsigned int n_q_points =
+    Utilities::fixed_power<DoFHandlerType::dimension>(n_subdivisions + 1);
+  const unsigned int n_points = n_cells * n_q_points;
+
+  // size the inputs of the postprocessors with batched evaluation. the
+  // tables keep their memory if they become smaller
+  for (unsigned int dataset = 0; dataset < this->dof_data.size(); ++dataset)
+    {
+      const DataPostprocessor<DoFHandlerType::space_dimension> *postprocessor =
+        this->dof_data[dataset]->postprocessor;
+      if (postprocessor == nullptr ||
+          postprocessor->uses_batched_evaluation() == false)
+        continue;
+
+      const UpdateFlags update_flags =
+        postprocessor->get_needed_update_flags();
+      const unsigned int n_components =
+        this->dof_data[dataset]->dof_handler->get_fe(0).n_components();
+      const unsigned int spacedim = DoFHandlerType::space_dimension;
+
+      DataPostprocessorInputs::Batch<DoFHandlerType::space_dimension> &inputs =
+        scratch_data.postprocessor_batch_inputs[dataset];
+      inputs.solution_values.reinit(n_components, n_points, true);
+      if (update_flags & update_gradients)
+        inputs.solution_gradients.reinit(
+          TableIndices<3>(n_components, spacedim, n_points), true);
+      if (update_flags & update_hessians)
+        inputs.solution_hessians.reinit(
+          TableIndices<4>(n_components, spacedim, spacedim, n_points), true);
+      if (update_flags & update_quadrature_points)
+        inputs.evaluation_points.reinit(spacedim, n_points, true);
+    }
+
+  for (unsigned int i = 0; i < n_cells; ++i)
+    build_one_patch(batch->first + i,
+                    scratch_data,
+                    n_subdivisions,
+                    curved_cell_region,
+                    first_patch_index,
+                    i);
+
+  // now evaluate these postprocessors on all points of the batch at once and
+  // distribute the results to the patches
+  unsigned int offset = 0;
+  for (unsigned int dataset = 0; dataset < this->dof_data.size(); ++dataset)
+    {
+      const DataPostprocessor<DoFHandlerType::space_dimension> *postprocessor =
+        this->dof_data[dataset]->postprocessor;
+      const unsigned int n_output_variables =
+        this->dof_data[dataset]->n_output_variables;
+
+      if (postprocessor != nullptr && postprocessor->uses_batched_evaluation())
+        {
+          Table<2, double> &outputs = scratch_data.postprocessor_batch_outputs;
+          outputs.reinit(n_output_variables, n_points, true);
+          postprocessor->evaluate_batch(
+            scratch_data.postprocessor_batch_inputs[dataset], outputs);
+
+          for (unsigned int i = 0; i < n_cells; ++i)
+            {
+              const cell_iterator &cell = batch->first[i].first;
+              ::dealii::DataOutBase::Patch<DoFHandlerType::dimension,
+                                           DoFHandlerType::space_dimension>
+                &patch =
+                  this->patches[(*scratch_data.cell_to_patch_index_map)
+                                  [cell->level()][cell->index()] -
+                                first_patch_index];
+              for (unsigned int component = 0; component < n_output_variables;
+                   ++component)
+                for (unsigned int q = 0; q < n_q_points; ++q)
+                  patch.data(offset + component, q) =
+                    outputs(component, i * n_q_points + q);
+            }
+        }
+
+      offset += n_output_variables *
+                (this->dof_data[dataset]->is_complex_valued() ? 2 : 1);
+    }
+}
+
+
+
 template <int dim, typename DoFHandlerType>
 void
 DataOut<dim, DoFHandlerType>::build_one_patch(
@@ -73,12 +272,25 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
                                                 DoFHandlerType::space_dimension>
     &                    scratch_data,
   const unsigned int     n_subdivisions,
-  const CurvedCellRegion curved_cell_region)
+  const CurvedCellRegion curved_cell_region,
+  const unsigned int     first_patch_index,
+  const unsigned int     index_in_batch)
 {
-  // first create the output object that we will write into
+  // Write directly into the output object of this patch. All of its fields
+  // are overwritten below, and the memory of the data table is reused if
+  // build_patches() has been called before, so that repeated output does not
+  // allocate memory for each patch
+  const unsigned int patch_idx =
+    (*scratch_data.cell_to_patch_index_map)[cell_and_index->first->level()]
+                                           [cell_and_index->first->index()];
+  // did we mess up the indices?
+  Assert(patch_idx >= first_patch_index &&
+           patch_idx - first_patch_index < this->patches.size(),
+         ExcInternalError());
   ::dealii::DataOutBase::Patch<DoFHandlerType::dimension,
-                               DoFHandlerType::space_dimension>
-    patch;
+                               DoFHandlerType::space_dimension> &patch =
+    this->patches[patch_idx - first_patch_index];
+  patch.patch_index    = patch_idx;
   patch.n_subdivisions = n_subdivisions;
 
   // set the vertices of the patch. if the mapping does not preserve locations
@@ -129,7 +341,8 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
 
       patch.data.reinit(scratch_data.n_datasets +
                           DoFHandlerType::space_dimension,
-                        n_q_points);
+                        n_q_points,
+                        /* omit_default_initialization = */ true);
       for (unsigned int i = 0; i < DoFHandlerType::space_dimension; ++i)
         for (unsigned int q = 0; q < n_q_points; ++q)
           patch.data(patch.data.size(0) - DoFHandlerType::space_dimension + i,
@@ -137,7 +350,9 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
     }
   else
     {
-      patch.data.reinit(scratch_data.n_datasets, n_q_points);
+      patch.data.reinit(scratch_data.n_datasets,
+                        n_q_points,
+                        /* omit_default_initialization = */ true);
       patch.points_are_available = false;
     }
 
@@ -192,17 +407,27 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
                     scratch_data.patch_values_scalar.evaluation_points =
                       this_fe_patch_values.get_quadrature_points();
 
-                  const typename DoFHandlerType::active_cell_iterator dh_cell(
-                    &cell_and_index->first->get_triangulation(),
-                    cell_and_index->first->level(),
-                    cell_and_index->first->index(),
-                    this->dof_data[dataset]->dof_handler);
-                  scratch_data.patch_values_scalar
-                    .template set_cell<DoFHandlerType>(dh_cell);
-
-                  postprocessor->evaluate_scalar_field(
-                    scratch_data.patch_values_scalar,
-                    scratch_data.postprocessed_values[dataset]);
+                  if (postprocessor->uses_batched_evaluation())
+                    copy_to_batch(
+                      scratch_data.patch_values_scalar,
+                      update_flags,
+                      n_q_points,
+                      index_in_batch * n_q_points,
+                      scratch_data.postprocessor_batch_inputs[dataset]);
+                  else
+                    {
+                      const typename DoFHandlerType::active_cell_iterator
+                        dh_cell(&cell_and_index->first->get_triangulation(),
+                                cell_and_index->first->level(),
+                                cell_and_index->first->index(),
+                                this->dof_data[dataset]->dof_handler);
+                      scratch_data.patch_values_scalar
+                        .template set_cell<DoFHandlerType>(dh_cell);
+
+                      postprocessor->evaluate_scalar_field(
+                        scratch_data.patch_values_scalar,
+                        scratch_data.postprocessed_values[dataset]);
+                    }
                 }
               else
                 {
@@ -233,25 +458,38 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
                     scratch_data.patch_values_system.evaluation_points =
                       this_fe_patch_values.get_quadrature_points();
 
-                  const typename DoFHandlerType::active_cell_iterator dh_cell(
-                    &cell_and_index->first->get_triangulation(),
-                    cell_and_index->first->level(),
-                    cell_and_index->first->index(),
-                    this->dof_data[dataset]->dof_handler);
-                  scratch_data.patch_values_system
-                    .template set_cell<DoFHandlerType>(dh_cell);
-
-                  postprocessor->evaluate_vector_field(
-                    scratch_data.patch_values_system,
-                    scratch_data.postprocessed_values[dataset]);
+                  if (postprocessor->uses_batched_evaluation())
+                    copy_to_batch(
+                      scratch_data.patch_values_system,
+                      update_flags,
+                      n_q_points,
+                      index_in_batch * n_q_points,
+                      scratch_data.postprocessor_batch_inputs[dataset]);
+                  else
+                    {
+                      const typename DoFHandlerType::active_cell_iterator
+                        dh_cell(&cell_and_index->first->get_triangulation(),
+                                cell_and_index->first->level(),
+                                cell_and_index->first->index(),
+                                this->dof_data[dataset]->dof_handler);
+                      scratch_data.patch_values_system
+                        .template set_cell<DoFHandlerType>(dh_cell);
+
+                      postprocessor->evaluate_vector_field(
+                        scratch_data.patch_values_system,
+                        scratch_data.postprocessed_values[dataset]);
+                    }
                 }
 
-              for (unsigned int q = 0; q < n_q_points; ++q)
-                for (unsigned int component = 0;
-                     component < this->dof_data[dataset]->n_output_variables;
-                     ++component)
-                  patch.data(offset + component, q) =
-                    scratch_data.postprocessed_values[dataset][q](component);
+              // the output of postprocessors with batched evaluation is
+              // written by build_patch_batch()
+              if (postprocessor->uses_batched_evaluation() == false)
+                for (unsigned int q = 0; q < n_q_points; ++q)
+                  for (unsigned int component = 0;
+                       component < this->dof_data[dataset]->n_output_variables;
+                       ++component)
+                    patch.data(offset + component, q) =
+                      scratch_data.postprocessed_values[dataset][q](component);
             }
           else
             // use the given data vector directly, without a postprocessor.
@@ -402,18 +640,6 @@ DataOut<dim, DoFHandlerType>::build_one_patch(
         (*scratch_data
             .cell_to_patch_index_map)[neighbor->level()][neighbor->index()];
     }
-
-  const unsigned int patch_idx =
-    (*scratch_data.cell_to_patch_index_map)[cell_and_index->first->level()]
-                                           [cell_and_index->first->index()];
-  // did we mess up the indices?
-  Assert(patch_idx < this->patches.size(), ExcInternalError());
-  patch.patch_index = patch_idx;
-
-  // Put the patch into the patches vector. instead of copying the data,
-  // simply swap the contents to avoid the penalty of writing into another
-  // processor's memory
-  this->patches[patch_idx].swap(patch);
 }
 
 
@@ -435,8 +661,73 @@ void
 DataOut<dim, DoFHandlerType>::build_patches(
   const Mapping<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
     &                    mapping,
-  const unsigned int     n_subdivisions_,
+  const unsigned int     n_subdivisions,
   const CurvedCellRegion curved_region)
+{
+  build_patches_in_chunks(mapping,
+                          n_subdivisions,
+                          curved_region,
+                          numbers::invalid_unsigned_int,
+                          std::function<void()>());
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::write_vtu_in_chunks(
+  std::ostream &     out,
+  const unsigned int n_patches_per_chunk,
+  const Mapping<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
+    &                    mapping,
+  const unsigned int     n_subdivisions,
+  const CurvedCellRegion curved_region)
+{
+  AssertThrow(n_patches_per_chunk > 0,
+              ExcMessage("The number of patches per chunk must be positive."));
+
+  const DataOutBase::VtkFlags &  flags      = this->get_vtk_flags();
+  const std::vector<std::string> data_names = this->get_dataset_names();
+  const std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+    nonscalar_data_ranges = this->get_nonscalar_data_ranges();
+
+  DataOutBase::write_vtu_header(out, flags);
+  build_patches_in_chunks(mapping,
+                          n_subdivisions,
+                          curved_region,
+                          n_patches_per_chunk,
+                          [&]() {
+                            DataOutBase::write_vtu_main(this->patches,
+                                                        data_names,
+                                                        nonscalar_data_ranges,
+                                                        flags,
+                                                        out);
+                          });
+  DataOutBase::write_vtu_footer(out);
+
+  out << std::flush;
+
+  // release the memory of the last chunk
+  std::vector<DataOutBase::Patch<DoFHandlerType::dimension,
+                                 DoFHandlerType::space_dimension>>()
+    .swap(this->patches);
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::build_patches_in_chunks(
+  const Mapping<DoFHandlerType::dimension, DoFHandlerType::space_dimension>
+    &                          mapping,
+  const unsigned int           n_subdivisions_,
+  const CurvedCellRegion       curved_region,
+  const unsigned int           n_patches_per_chunk,
+  const std::function<void()> &process_chunk)
 {
   // Check consistency of redundant template parameter
   Assert(dim == DoFHandlerType::dimension,
@@ -461,56 +752,48 @@ DataOut<dim, DoFHandlerType>::build_patches(
   // - cell->index: only unique on each level, used in cell_to_patch_index_map
   // - active_index: index for a cell when counting from begin_active() using
   //   ++cell (identical to cell->active_cell_index())
-  // - cell_index: unique index of a cell counted using
-  //   next_locally_owned_cell() starting from first_locally_owned_cell()
+  // - cell_index: the position of a cell in the list returned by
+  //   get_cells_for_output()
   //
   // It turns out that we create one patch for each selected cell, so
   // patch_index==cell_index.
   //
   // Now construct the map such that
   // cell_to_patch_index_map[cell->level][cell->index] = patch_index
+  const std::vector<cell_iterator> selected_cells = get_cells_for_output();
+
   std::vector<std::vector<unsigned int>> cell_to_patch_index_map;
   cell_to_patch_index_map.resize(this->triangulation->n_levels());
-  for (unsigned int l = 0; l < this->triangulation->n_levels(); ++l)
-    {
-      // max_index is the largest cell->index on level l
-      unsigned int max_index = 0;
-      for (cell_iterator cell = first_locally_owned_cell();
-           cell != this->triangulation->end();
-           cell = next_locally_owned_cell(cell))
-        if (static_cast<unsigned int>(cell->level()) == l)
-          max_index =
-            std::max(max_index, static_cast<unsigned int>(cell->index()));
-
+  {
+    // max_index[l] is the largest cell->index on level l, computed in a
+    // single pass over the selected cells
+    std::vector<unsigned int> max_index(this->triangulation->n_levels(), 0);
+    for (const cell_iterator &cell : selected_cells)
+      max_index[cell->level()] =
+        std::max(max_index[cell->level()],
+                 static_cast<unsigned int>(cell->index()));
+
+    for (unsigned int l = 0; l < this->triangulation->n_levels(); ++l)
       cell_to_patch_index_map[l].resize(
-        max_index + 1,
+        max_index[l] + 1,
         dealii::DataOutBase::Patch<
           DoFHandlerType::dimension,
           DoFHandlerType::space_dimension>::no_neighbor);
-    }
+  }
 
   // will be all_cells[patch_index] = pair(cell, active_index)
   std::vector<std::pair<cell_iterator, unsigned int>> all_cells;
+  all_cells.reserve(selected_cells.size());
   {
     // important: we need to compute the active_index of the cell in the range
     // 0..n_active_cells() because this is where we need to look up cell
-    // data from (cell data vectors do not have the length distance computed by
-    // first_locally_owned_cell/next_locally_owned_cell because this might skip
-    // some values (FilteredIterator).
-    active_cell_iterator active_cell  = this->triangulation->begin_active();
-    unsigned int         active_index = 0;
-    cell_iterator        cell         = first_locally_owned_cell();
-    for (; cell != this->triangulation->end();
-         cell = next_locally_owned_cell(cell))
+    // data from (cell data vectors do not have the length of the list of
+    // selected cells because this might skip some values). non-active cells
+    // have no cell data, so their index is not used
+    for (const cell_iterator &cell : selected_cells)
       {
-        // move forward until active_cell points at the cell (cell) we are
-        // looking at to compute the current active_index
-        while (active_cell != this->triangulation->end() && cell->active() &&
-               active_cell_iterator(cell) != active_cell)
-          {
-            ++active_cell;
-            ++active_index;
-          }
+        const unsigned int active_index =
+          cell->active() ? cell->active_cell_index() : 0;
 
         Assert(static_cast<unsigned int>(cell->level()) <
                  cell_to_patch_index_map.size(),
@@ -527,9 +810,6 @@ DataOut<dim, DoFHandlerType>::build_patches(
       }
   }
 
-  this->patches.clear();
-  this->patches.resize(all_cells.size());
-
   // now create a default object for the WorkStream object to work with
   unsigned int n_datasets = 0;
   for (unsigned int i = 0; i < this->cell_data.size(); ++i)
@@ -575,32 +855,103 @@ DataOut<dim, DoFHandlerType>::build_patches(
                 update_flags,
                 cell_to_patch_index_map);
 
-  // now build the patches in parallel
-  if (all_cells.size() > 0)
-    WorkStream::run(
-      all_cells.data(),
-      all_cells.data() + all_cells.size(),
-      std::bind(&DataOut<dim, DoFHandlerType>::build_one_patch,
-                this,
-                std::placeholders::_1,
-                std::placeholders::_2,
-                /* no std::placeholders::_3, since this function doesn't
-                   actually need a copy data object -- it just writes everything
-                   right into the output array */
-                n_subdivisions,
-                curved_cell_region),
-      // no copy-local-to-global function needed here
-      std::function<void(const int)>(),
-      thread_data,
-      /* dummy CopyData object = */ 0,
-      // experimenting shows that we can make things run a bit
-      // faster if we increase the number of cells we work on
-      // per item (i.e., WorkStream's chunk_size argument,
-      // about 10% improvement) and the items in flight at any
-      // given time (another 5% on the testcase discussed in
-      // @ref workstream_paper, on 32 cores) and if
-      8 * MultithreadInfo::n_threads(),
-      64);
+  // the number of cells whose patches are built together by one task
+  const unsigned int cells_per_batch = 64;
+
+  // now build the patches in parallel, one chunk after the other. there is
+  // always at least one chunk, which may be empty
+  std::size_t first_patch_index = 0;
+  do
+    {
+      const std::size_t n_patches_in_chunk =
+        std::min<std::size_t>(n_patches_per_chunk,
+                              all_cells.size() - first_patch_index);
+
+      // do not clear the patches of a previous chunk or call, so that
+      // build_one_patch() can reuse the memory they have already allocated
+      this->patches.resize(n_patches_in_chunk);
+
+      // split the chunk into batches of cells. postprocessors with batched
+      // evaluation are called once per batch
+      const std::pair<cell_iterator, unsigned int> *const chunk_end =
+        all_cells.data() + first_patch_index + n_patches_in_chunk;
+      std::vector<cell_batch> batches;
+      for (const std::pair<cell_iterator, unsigned int> *batch_begin =
+             all_cells.data() + first_patch_index;
+           batch_begin < chunk_end;
+           batch_begin += std::min<std::ptrdiff_t>(cells_per_batch,
+                                                   chunk_end - batch_begin))
+        batches.emplace_back(batch_begin,
+                             batch_begin +
+                               std::min<std::ptrdiff_t>(cells_per_batch,
+                                                        chunk_end -
+                                                          batch_begin));
+
+      if (n_patches_in_chunk > 0)
+        WorkStream::run(
+          batches.data(),
+          batches.data() + batches.size(),
+          std::bind(&DataOut<dim, DoFHandlerType>::build_patch_batch,
+                    this,
+                    std::placeholders::_1,
+                    std::placeholders::_2,
+                    /* no std::placeholders::_3, since this function doesn't
+                       actually need a copy data object -- it just writes
+                       everything right into the output array */
+                    n_subdivisions,
+                    curved_cell_region,
+                    static_cast<unsigned int>(first_patch_index)),
+          // no copy-local-to-global function needed here
+          std::function<void(const int)>(),
+          thread_data,
+          /* dummy CopyData object = */ 0,
+          // experimenting shows that we can make things run a bit
+          // faster if we increase the number of cells we work on
+          // per item (about 10% improvement, here by working on
+          // batches of cells) and the items in flight at any
+          // given time (another 5% on the testcase discussed in
+          // @ref workstream_paper, on 32 cores) and if
+          8 * MultithreadInfo::n_threads(),
+          1);
+
+      if (process_chunk)
+        process_chunk();
+
+      first_patch_index += n_patches_in_chunk;
+    }
+  while (first_patch_index < all_cells.size());
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::set_cell_selection(
+  const std::function<bool(const cell_iterator &)> &predicate)
+{
+  cell_selection = predicate;
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::set_cell_selection(
+  const BoundingBox<DoFHandlerType::space_dimension> &region)
+{
+  cell_selection = [region](const cell_iterator &cell) {
+    return region.get_neighbor_type(cell->bounding_box()) !=
+           NeighborType::not_neighbors;
+  };
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::set_max_output_level(const unsigned int level)
+{
+  max_output_level = level;
 }
 
 
@@ -661,6 +1012,62 @@ DataOut<dim, DoFHandlerType>::next_locally_owned_cell(
 }
 
 
+template <int dim, typename DoFHandlerType>
+std::vector<typename DataOut<dim, DoFHandlerType>::cell_iterator>
+DataOut<dim, DoFHandlerType>::get_cells_for_output()
+{
+  std::vector<cell_iterator> cells;
+  if (!cell_selection && max_output_level == numbers::invalid_unsigned_int)
+    {
+      for (cell_iterator cell = first_locally_owned_cell();
+           cell != this->triangulation->end();
+           cell = next_locally_owned_cell(cell))
+        cells.push_back(cell);
+    }
+  else
+    {
+      // on a parallel triangulation, coarsened cells must not extend over
+      // the subdomains of several processes
+      const bool check_ownership =
+        (dynamic_cast<const parallel::Triangulation<
+           DoFHandlerType::dimension,
+           DoFHandlerType::space_dimension> *>(&*this->triangulation) !=
+         nullptr);
+      for (cell_iterator cell = this->triangulation->begin(0);
+           cell != this->triangulation->end(0);
+           ++cell)
+        collect_cells_for_output(cell, check_ownership, cells);
+    }
+
+  return cells;
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+DataOut<dim, DoFHandlerType>::collect_cells_for_output(
+  const cell_iterator &       cell,
+  const bool                  check_ownership,
+  std::vector<cell_iterator> &cells) const
+{
+  if (cell_selection && !cell_selection(cell))
+    return;
+
+  if (cell->active())
+    {
+      if (cell->is_locally_owned())
+        cells.push_back(cell);
+    }
+  else if (static_cast<unsigned int>(cell->level()) >= max_output_level &&
+           (!check_ownership || all_descendants_locally_owned(cell)))
+    cells.push_back(cell);
+  else
+    for (unsigned int c = 0; c < cell->n_children(); ++c)
+      collect_cells_for_output(cell->child(c), check_ownership, cells);
+}
+
+
 // explicit instantiations
 #include "data_out.inst"
 
@@ -0,0 +1,115 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/hp/dof_handler.h>
+
+#include <deal.II/numerics/data_out_async.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template <int dim, typename DoFHandlerType>
+AsyncDataOut<dim, DoFHandlerType>::AsyncDataOut(
+  const unsigned int max_pending_writes)
+  : max_pending_writes(max_pending_writes)
+{
+  Assert(max_pending_writes > 0,
+         ExcMessage("At least one write needs to be allowed to be pending."));
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+AsyncDataOut<dim, DoFHandlerType>::~AsyncDataOut()
+{
+  wait();
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+AsyncDataOut<dim, DoFHandlerType>::attach_dof_handler(
+  const DoFHandlerType &d)
+{
+  dof_handler = &d;
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+AsyncDataOut<dim, DoFHandlerType>::write(
+  const std::function<void(const DataOut<dim, DoFHandlerType> &)> &writer,
+  const unsigned int n_subdivisions)
+{
+  Assert(dof_handler != nullptr,
+         ExcMessage("You need to attach a DoFHandler before writing."));
+
+  // bound the number of pending writes, and with it the memory held by the
+  // copies of the data vectors
+  while (pending_writes.size() >= max_pending_writes)
+    {
+      pending_writes.front().join();
+      pending_writes.pop_front();
+    }
+
+  // hand the copies of the data vectors over to the task, so that the next
+  // output can be set up while this one is written
+  const DoFHandlerType *const dof = &*dof_handler;
+  std::vector<
+    std::function<void(DataOut<dim, DoFHandlerType> &, const DoFHandlerType &)>>
+    vectors;
+  vectors.swap(data_vectors);
+
+  pending_writes.push_back(
+    Threads::new_task([dof, vectors, writer, n_subdivisions]() {
+      DataOut<dim, DoFHandlerType> data_out;
+      data_out.attach_dof_handler(*dof);
+      for (const auto &add_data_vector : vectors)
+        add_data_vector(data_out, *dof);
+      data_out.build_patches(n_subdivisions);
+
+      writer(data_out);
+    }));
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+void
+AsyncDataOut<dim, DoFHandlerType>::wait()
+{
+  for (const Threads::Task<void> &task : pending_writes)
+    task.join();
+  pending_writes.clear();
+}
+
+
+
+template <int dim, typename DoFHandlerType>
+unsigned int
+AsyncDataOut<dim, DoFHandlerType>::n_pending_writes() const
+{
+  return pending_writes.size();
+}
+
+
+// explicit instantiations
+#include "data_out_async.inst"
+
+DEAL_II_NAMESPACE_CLOSE
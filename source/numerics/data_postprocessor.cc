@@ -43,6 +43,26 @@ DataPostprocessor<dim>::evaluate_vector_field(
 
 
 
+template <int dim>
+bool
+DataPostprocessor<dim>::uses_batched_evaluation() const
+{
+  return false;
+}
+
+
+
+template <int dim>
+void
+DataPostprocessor<dim>::evaluate_batch(
+  const DataPostprocessorInputs::Batch<dim> &,
+  Table<2, double> &) const
+{
+  AssertThrow(false, ExcPureFunctionCalled());
+}
+
+
+
 template <int dim>
 std::vector<DataComponentInterpretation::DataComponentInterpretation>
 DataPostprocessor<dim>::get_data_component_interpretation() const
@@ -735,44 +735,23 @@ namespace DerivativeApproximation
   namespace internal
   {
     /**
-     * Compute the derivative approximation on one cell. This computes the full
-     * derivative tensor.
+     * Compute the derivative approximation on one cell from the centers of
+     * the cell and its active neighbors and the values of the projected
+     * derivative there. @p get_midpoint_data returns both as a pair for a
+     * given cell. This computes the full derivative tensor.
      */
     template <class DerivativeDescription,
               int dim,
               template <int, int> class DoFHandlerType,
-              class InputVector,
-              int spacedim>
+              int spacedim,
+              typename MidpointData>
     void
-    approximate_cell(
-      const Mapping<dim, spacedim> &       mapping,
-      const DoFHandlerType<dim, spacedim> &dof_handler,
-      const InputVector &                  solution,
-      const unsigned int                   component,
+    approximate_cell_from_midpoints(
       const TriaActiveIterator<
         dealii::DoFCellAccessor<DoFHandlerType<dim, spacedim>, false>> &cell,
+      const MidpointData &                        get_midpoint_data,
       typename DerivativeDescription::Derivative &derivative)
     {
-      QMidpoint<dim> midpoint_rule;
-
-      // create collection objects from
-      // single quadratures, mappings,
-      // and finite elements. if we have
-      // an hp DoFHandler,
-      // dof_handler.get_fe() returns a
-      // collection of which we do a
-      // shallow copy instead
-      const hp::QCollection<dim>   q_collection(midpoint_rule);
-      const hp::FECollection<dim> &fe_collection =
-        dof_handler.get_fe_collection();
-      const hp::MappingCollection<dim> mapping_collection(mapping);
-
-      hp::FEValues<dim> x_fe_midpoint_value(
-        mapping_collection,
-        fe_collection,
-        q_collection,
-        DerivativeDescription::update_flags | update_quadrature_points);
-
       // matrix Y=sum_i y_i y_i^T
       Tensor<2, dim> Y;
 
@@ -794,20 +773,13 @@ namespace DerivativeApproximation
       // derivatives
       typename DerivativeDescription::Derivative projected_derivative;
 
-      // reinit fe values object...
-      x_fe_midpoint_value.reinit(cell);
-      const FEValues<dim> &fe_midpoint_value =
-        x_fe_midpoint_value.get_present_fe_values();
-
-      // ...and get the value of the
-      // projected derivative...
+      // get the value of the projected
+      // derivative and the place where
+      // it lives
+      const auto        this_midpoint_data = get_midpoint_data(cell);
+      const Point<dim> &this_center        = this_midpoint_data.first;
       const typename DerivativeDescription::ProjectedDerivative
-        this_midpoint_value =
-          DerivativeDescription::get_projected_derivative(fe_midpoint_value,
-                                                          solution,
-                                                          component);
-      // ...and the place where it lives
-      const Point<dim> this_center = fe_midpoint_value.quadrature_point(0);
+        &this_midpoint_value = this_midpoint_data.second;
 
       // loop over all neighbors and
       // accumulate the difference
@@ -827,30 +799,15 @@ namespace DerivativeApproximation
       // now loop over all active
       // neighbors and collect the
       // data we need
-      typename std::vector<TriaActiveIterator<
-        dealii::DoFCellAccessor<DoFHandlerType<dim, spacedim>, false>>>::
-        const_iterator neighbor_ptr = active_neighbors.begin();
-      for (; neighbor_ptr != active_neighbors.end(); ++neighbor_ptr)
+      for (const auto &neighbor : active_neighbors)
         {
-          const TriaActiveIterator<
-            dealii::DoFCellAccessor<DoFHandlerType<dim, spacedim>, false>>
-            neighbor = *neighbor_ptr;
-
-          // reinit fe values object...
-          x_fe_midpoint_value.reinit(neighbor);
-          const FEValues<dim> &neighbor_fe_midpoint_value =
-            x_fe_midpoint_value.get_present_fe_values();
-
-          // ...and get the value of the
-          // solution...
+          // get the value of the
+          // solution and the place where
+          // it lives
+          const auto neighbor_midpoint_data = get_midpoint_data(neighbor);
+          const Point<dim> &neighbor_center = neighbor_midpoint_data.first;
           const typename DerivativeDescription::ProjectedDerivative
-            neighbor_midpoint_value =
-              DerivativeDescription::get_projected_derivative(
-                neighbor_fe_midpoint_value, solution, component);
-
-          // ...and the place where it lives
-          const Point<dim> neighbor_center =
-            neighbor_fe_midpoint_value.quadrature_point(0);
+            &neighbor_midpoint_value = neighbor_midpoint_data.second;
 
 
           // vector for the
@@ -911,9 +868,9 @@ namespace DerivativeApproximation
 
 
     /**
-     * Compute the derivative approximation on a given cell.  Fill the @p
-     * derivative_norm vector with the norm of the computed derivative tensors
-     * on the cell.
+     * Compute the derivative approximation on one cell, evaluating the
+     * projected derivatives at the midpoints of the cell and its neighbors
+     * with FEValues. This computes the full derivative tensor.
      */
     template <class DerivativeDescription,
               int dim,
@@ -921,15 +878,108 @@ namespace DerivativeApproximation
               class InputVector,
               int spacedim>
     void
+    approximate_cell(
+      const Mapping<dim, spacedim> &       mapping,
+      const DoFHandlerType<dim, spacedim> &dof_handler,
+      const InputVector &                  solution,
+      const unsigned int                   component,
+      const TriaActiveIterator<
+        dealii::DoFCellAccessor<DoFHandlerType<dim, spacedim>, false>> &cell,
+      typename DerivativeDescription::Derivative &derivative)
+    {
+      QMidpoint<dim> midpoint_rule;
+
+      // create collection objects from
+      // single quadratures, mappings,
+      // and finite elements. if we have
+      // an hp DoFHandler,
+      // dof_handler.get_fe() returns a
+      // collection of which we do a
+      // shallow copy instead
+      const hp::QCollection<dim>   q_collection(midpoint_rule);
+      const hp::FECollection<dim> &fe_collection =
+        dof_handler.get_fe_collection();
+      const hp::MappingCollection<dim> mapping_collection(mapping);
+
+      hp::FEValues<dim> x_fe_midpoint_value(
+        mapping_collection,
+        fe_collection,
+        q_collection,
+        DerivativeDescription::update_flags | update_quadrature_points);
+
+      approximate_cell_from_midpoints<DerivativeDescription>(
+        cell,
+        [&](const TriaActiveIterator<
+            dealii::DoFCellAccessor<DoFHandlerType<dim, spacedim>, false>>
+              &midpoint_cell) {
+          x_fe_midpoint_value.reinit(midpoint_cell);
+          const FEValues<dim> &fe_midpoint_value =
+            x_fe_midpoint_value.get_present_fe_values();
+          return std::make_pair(
+            fe_midpoint_value.quadrature_point(0),
+            DerivativeDescription::get_projected_derivative(fe_midpoint_value,
+                                                            solution,
+                                                            component));
+        },
+        derivative);
+    }
+
+
+
+    /**
+     * Scratch data for the evaluation of the projected derivatives at the
+     * cell midpoints.
+     */
+    template <int dim>
+    struct MidpointScratch
+    {
+      MidpointScratch(const hp::MappingCollection<dim> &mapping_collection,
+                      const hp::FECollection<dim> &     fe_collection,
+                      const UpdateFlags                 update_flags)
+        : mapping_collection(mapping_collection)
+        , fe_collection(fe_collection)
+        , q_collection(QMidpoint<dim>())
+        , update_flags(update_flags)
+        , x_fe_midpoint_value(mapping_collection,
+                              fe_collection,
+                              q_collection,
+                              update_flags)
+      {}
+
+      MidpointScratch(const MidpointScratch &scratch)
+        : MidpointScratch(scratch.mapping_collection,
+                          scratch.fe_collection,
+                          scratch.update_flags)
+      {}
+
+      const hp::MappingCollection<dim> &mapping_collection;
+      const hp::FECollection<dim> &     fe_collection;
+      const hp::QCollection<dim>        q_collection;
+      const UpdateFlags                 update_flags;
+      hp::FEValues<dim>                 x_fe_midpoint_value;
+    };
+
+
+
+    /**
+     * Compute the derivative approximation on a given cell from the centers
+     * and projected derivatives of all cells, indexed by their active cell
+     * index. Fill the @p derivative_norm vector with the norm of the computed
+     * derivative tensors on the cell.
+     */
+    template <class DerivativeDescription,
+              int dim,
+              template <int, int> class DoFHandlerType,
+              int spacedim>
+    void
     approximate(
       SynchronousIterators<std::tuple<
         TriaActiveIterator<
           dealii::DoFCellAccessor<DoFHandlerType<dim, spacedim>, false>>,
-        Vector<float>::iterator>> const &  cell,
-      const Mapping<dim, spacedim> &       mapping,
-      const DoFHandlerType<dim, spacedim> &dof_handler,
-      const InputVector &                  solution,
-      const unsigned int                   component)
+        Vector<float>::iterator>> const &cell,
+      const std::vector<Point<dim>> &    centers,
+      const std::vector<typename DerivativeDescription::ProjectedDerivative>
+        &midpoint_values)
     {
       // if the cell is not locally owned, then there is nothing to do
       if (std::get<0>(*cell)->is_locally_owned() == false)
@@ -939,16 +989,16 @@ namespace DerivativeApproximation
           typename DerivativeDescription::Derivative derivative;
           // call the function doing the actual
           // work on this cell
-          approximate_cell<DerivativeDescription,
-                           dim,
-                           DoFHandlerType,
-                           InputVector,
-                           spacedim>(mapping,
-                                     dof_handler,
-                                     solution,
-                                     component,
-                                     std::get<0>(*cell),
-                                     derivative);
+          approximate_cell_from_midpoints<DerivativeDescription>(
+            std::get<0>(*cell),
+            [&](const TriaActiveIterator<
+                dealii::DoFCellAccessor<DoFHandlerType<dim, spacedim>, false>>
+                  &midpoint_cell) {
+              return std::make_pair(
+                centers[midpoint_cell->active_cell_index()],
+                midpoint_values[midpoint_cell->active_cell_index()]);
+            },
+            derivative);
 
           // evaluate the norm and fill the vector
           //*derivative_norm_on_this_cell
@@ -965,6 +1015,11 @@ namespace DerivativeApproximation
      * threads and doing some administration that is independent of the actual
      * derivative to be computed.
      *
+     * The projected derivatives at the cell midpoints are evaluated once per
+     * cell beforehand, rather than once for every cell they are a neighbor
+     * of, so that the second loop only needs to combine the precomputed
+     * values.
+     *
      * The @p component argument denotes which component of the solution vector
      * we are to work on.
      */
@@ -988,10 +1043,48 @@ namespace DerivativeApproximation
       Assert(component < dof_handler.get_fe(0).n_components(),
              ExcIndexRange(component, 0, dof_handler.get_fe(0).n_components()));
 
-      using Iterators = std::tuple<
-        TriaActiveIterator<
-          dealii::DoFCellAccessor<DoFHandlerType<dim, spacedim>, false>>,
-        Vector<float>::iterator>;
+      using active_cell_iterator = TriaActiveIterator<
+        dealii::DoFCellAccessor<DoFHandlerType<dim, spacedim>, false>>;
+
+      // first evaluate the projected derivatives at the midpoints of all
+      // cells whose values are available, i.e., the locally owned and the
+      // ghost cells. every cell writes to its own entries, so there is no
+      // need for a copier
+      const unsigned int n_active_cells =
+        dof_handler.get_triangulation().n_active_cells();
+      std::vector<Point<dim>> centers(n_active_cells);
+      std::vector<typename DerivativeDescription::ProjectedDerivative>
+        midpoint_values(n_active_cells);
+
+      const hp::MappingCollection<dim> mapping_collection(mapping);
+      WorkStream::run(
+        dof_handler.begin_active(),
+        dof_handler.end(),
+        [&](const active_cell_iterator &cell,
+            MidpointScratch<dim> &      scratch,
+            Assembler::CopyData &) {
+          if (cell->is_artificial())
+            return;
+
+          scratch.x_fe_midpoint_value.reinit(cell);
+          const FEValues<dim> &fe_midpoint_value =
+            scratch.x_fe_midpoint_value.get_present_fe_values();
+          centers[cell->active_cell_index()] =
+            fe_midpoint_value.quadrature_point(0);
+          midpoint_values[cell->active_cell_index()] =
+            DerivativeDescription::get_projected_derivative(fe_midpoint_value,
+                                                            solution,
+                                                            component);
+        },
+        std::function<void(internal::Assembler::CopyData const &)>(),
+        MidpointScratch<dim>(mapping_collection,
+                             dof_handler.get_fe_collection(),
+                             DerivativeDescription::update_flags |
+                               update_quadrature_points),
+        internal::Assembler::CopyData());
+
+      using Iterators =
+        std::tuple<active_cell_iterator, Vector<float>::iterator>;
       SynchronousIterators<Iterators> begin(
         Iterators(dof_handler.begin_active(), derivative_norm.begin())),
         end(Iterators(dof_handler.end(), derivative_norm.end()));
@@ -1008,13 +1101,10 @@ namespace DerivativeApproximation
           std::bind(&approximate<DerivativeDescription,
                                  dim,
                                  DoFHandlerType,
-                                 InputVector,
                                  spacedim>,
                     std::placeholders::_1,
-                    std::cref(mapping),
-                    std::cref(dof_handler),
-                    std::cref(solution),
-                    component)),
+                    std::cref(centers),
+                    std::cref(midpoint_values))),
         std::function<void(internal::Assembler::CopyData const &)>(),
         internal::Assembler::Scratch(),
         internal::Assembler::CopyData());
@@ -14,6 +14,8 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/distributed/tria_base.h>
+
 #include <deal.II/lac/block_vector.h>
 #include <deal.II/lac/la_parallel_block_vector.h>
 #include <deal.II/lac/la_parallel_vector.h>
@@ -59,10 +61,11 @@ PointValueHistory<dim>::PointValueHistory(
   const unsigned int n_independent_variables)
   : n_indep(n_independent_variables)
 {
-  closed                = false;
-  cleared               = false;
-  triangulation_changed = false;
-  have_dof_handler      = false;
+  closed                     = false;
+  cleared                    = false;
+  triangulation_changed      = false;
+  have_dof_handler           = false;
+  requested_locations_cached = false;
 
   // make a vector for keys
   dataset_key = std::vector<double>(); // initialize the std::vector
@@ -82,10 +85,11 @@ PointValueHistory<dim>::PointValueHistory(
   : dof_handler(&dof_handler)
   , n_indep(n_independent_variables)
 {
-  closed                = false;
-  cleared               = false;
-  triangulation_changed = false;
-  have_dof_handler      = true;
+  closed                     = false;
+  cleared                    = false;
+  triangulation_changed      = false;
+  have_dof_handler           = true;
+  requested_locations_cached = false;
 
   // make a vector to store keys
   dataset_key = std::vector<double>(); // initialize the std::vector
@@ -122,6 +126,9 @@ PointValueHistory<dim>::PointValueHistory(
   have_dof_handler      = point_value_history.have_dof_handler;
   n_indep               = point_value_history.n_indep;
 
+  // the cached cells and FEValues objects are set up again when needed
+  requested_locations_cached = false;
+
   // What to do with tria_listener?
   // Presume subscribe new instance?
   if (have_dof_handler)
@@ -156,6 +163,9 @@ PointValueHistory<dim>::operator=(const PointValueHistory &point_value_history)
   have_dof_handler      = point_value_history.have_dof_handler;
   n_indep               = point_value_history.n_indep;
 
+  // the cached cells and FEValues objects are set up again when needed
+  requested_locations_cached = false;
+
   // What to do with tria_listener?
   // Presume subscribe new instance?
   if (have_dof_handler)
@@ -570,6 +580,12 @@ PointValueHistory<dim>::clear()
   cleared          = true;
   dof_handler      = nullptr;
   have_dof_handler = false;
+
+  requested_location_cells.clear();
+  requested_location_indices.clear();
+  requested_location_fe_values.clear();
+  requested_location_n_owners.clear();
+  requested_locations_cached = false;
 }
 
 // Need to test that the internal data has a full and complete dataset for
@@ -933,23 +949,46 @@ PointValueHistory<dim>::evaluate_field_at_requested_location(
   unsigned int n_stored =
     mask->second.n_selected_components(dof_handler->get_fe(0).n_components());
 
-  typename std::vector<
-    internal::PointValueHistoryImplementation::PointGeometryData<dim>>::iterator
-                 point = point_geometry_data.begin();
-  Vector<number> value(dof_handler->get_fe(0).n_components());
-  for (unsigned int data_store_index = 0; point != point_geometry_data.end();
-       ++point, ++data_store_index)
+  if (!requested_locations_cached ||
+      (requested_location_fe_values.size() > 0 &&
+       &requested_location_fe_values[0]->get_fe() != &dof_handler->get_fe()))
+    setup_requested_locations();
+
+  // evaluate the solution at all points
+  // of one cell at once, and collect the
+  // values of all points and components
+  // in one array such that they can be
+  // combined over all processes in one
+  // go
+  const unsigned int  n_components = dof_handler->get_fe(0).n_components();
+  std::vector<double> values(point_geometry_data.size() * n_components, 0.);
+  std::vector<Vector<number>> cell_values;
+  for (unsigned int c = 0; c < requested_location_cells.size(); ++c)
     {
-      // Make a Vector <double> for the value
-      // at the point. It will have as many
-      // components as there are in the fe.
-      VectorTools::point_value(*dof_handler,
-                               solution,
-                               point->requested_location,
-                               value);
-
-      // Look up the component_mask and add
-      // in components according to that mask
+      FEValues<dim> &fe_values = *requested_location_fe_values[c];
+      fe_values.reinit(requested_location_cells[c]);
+      cell_values.resize(fe_values.n_quadrature_points,
+                         Vector<number>(n_components));
+      fe_values.get_function_values(solution, cell_values);
+
+      for (unsigned int q = 0; q < fe_values.n_quadrature_points; ++q)
+        for (unsigned int comp = 0; comp < n_components; ++comp)
+          values[requested_location_indices[c][q] * n_components + comp] =
+            cell_values[q](comp);
+    }
+
+  if (const parallel::Triangulation<dim> *parallel_tria =
+        dynamic_cast<const parallel::Triangulation<dim> *>(
+          &dof_handler->get_triangulation()))
+    Utilities::MPI::sum(values, parallel_tria->get_communicator(), values);
+
+  // Look up the component_mask and add
+  // in components according to that mask
+  for (unsigned int data_store_index = 0;
+       data_store_index < point_geometry_data.size();
+       ++data_store_index)
+    {
+      const double scaling = 1. / requested_location_n_owners[data_store_index];
       for (unsigned int store_index = 0, comp = 0; comp < mask->second.size();
            comp++)
         {
@@ -957,7 +996,8 @@ PointValueHistory<dim>::evaluate_field_at_requested_location(
             {
               data_store_field
                 ->second[data_store_index * n_stored + store_index]
-                .push_back(value(comp));
+                .push_back(scaling *
+                           values[data_store_index * n_components + comp]);
               store_index++;
             }
         }
@@ -1510,6 +1550,80 @@ PointValueHistory<dim>::deep_check(const bool strict)
 
 
 
+template <int dim>
+void
+PointValueHistory<dim>::setup_requested_locations()
+{
+  const Mapping<dim> &      mapping = StaticMappingQ1<dim>::mapping;
+  const FiniteElement<dim> &fe      = dof_handler->get_fe();
+
+  const parallel::Triangulation<dim> *parallel_tria =
+    dynamic_cast<const parallel::Triangulation<dim> *>(
+      &dof_handler->get_triangulation());
+
+  // find the cell around each requested
+  // location and sort the locations by
+  // cell. on a parallel triangulation,
+  // only locally owned cells are kept and
+  // the point is skipped if it is not in
+  // the locally stored part of the mesh
+  std::map<typename DoFHandler<dim>::active_cell_iterator,
+           std::pair<std::vector<unsigned int>, std::vector<Point<dim>>>>
+                            points_by_cell;
+  std::vector<unsigned int> n_owners(point_geometry_data.size(), 0);
+  for (unsigned int i = 0; i < point_geometry_data.size(); ++i)
+    {
+      std::pair<typename DoFHandler<dim>::active_cell_iterator, Point<dim>>
+        cell_point;
+      try
+        {
+          cell_point = GridTools::find_active_cell_around_point(
+            mapping, *dof_handler, point_geometry_data[i].requested_location);
+        }
+      catch (const GridTools::ExcPointNotFound<dim> &)
+        {
+          if (parallel_tria == nullptr)
+            throw;
+          continue;
+        }
+
+      if (cell_point.first->is_locally_owned())
+        {
+          auto &cell_data = points_by_cell[cell_point.first];
+          cell_data.first.push_back(i);
+          cell_data.second.push_back(
+            GeometryInfo<dim>::project_to_unit_cell(cell_point.second));
+          n_owners[i] = 1;
+        }
+    }
+
+  if (parallel_tria != nullptr)
+    Utilities::MPI::sum(n_owners, parallel_tria->get_communicator(), n_owners);
+  for (unsigned int i = 0; i < point_geometry_data.size(); ++i)
+    AssertThrow(n_owners[i] > 0,
+                GridTools::ExcPointNotFound<dim>(
+                  point_geometry_data[i].requested_location));
+
+  requested_location_cells.clear();
+  requested_location_indices.clear();
+  requested_location_fe_values.clear();
+  for (auto &cell_data : points_by_cell)
+    {
+      requested_location_cells.push_back(cell_data.first);
+      requested_location_indices.push_back(cell_data.second.first);
+      requested_location_fe_values.emplace_back(
+        new FEValues<dim>(mapping,
+                          fe,
+                          Quadrature<dim>(cell_data.second.second),
+                          update_values));
+    }
+  requested_location_n_owners = n_owners;
+
+  requested_locations_cached = true;
+}
+
+
+
 template <int dim>
 void
 PointValueHistory<dim>::tria_change_listener()
@@ -1526,6 +1640,11 @@ PointValueHistory<dim>::tria_change_listener()
   // this into account next time we
   // evaluate the solution
   triangulation_changed = true;
+
+  // the cells around the requested
+  // locations need to be searched for
+  // again
+  requested_locations_cached = false;
 }
 
 
@@ -172,6 +172,8 @@ namespace Particles
   {
     if (property_pool != nullptr && properties != PropertyPool::invalid_handle)
       property_pool->deallocate_properties_array(properties);
+    else if (properties != PropertyPool::invalid_handle)
+      delete[] properties;
   }
 
 
@@ -274,6 +276,20 @@ namespace Particles
   void
   Particle<dim, spacedim>::set_property_pool(PropertyPool &new_property_pool)
   {
+    // properties that were allocated by load() without a pool
+    if (property_pool == nullptr && properties != PropertyPool::invalid_handle)
+      {
+        const PropertyPool::Handle new_properties =
+          new_property_pool.allocate_properties_array();
+        const ArrayView<double> new_property_values =
+          new_property_pool.get_properties(new_properties);
+        std::copy(properties,
+                  properties + new_property_values.size(),
+                  new_property_values.begin());
+        delete[] properties;
+        properties = new_properties;
+      }
+
     property_pool = &new_property_pool;
   }
 
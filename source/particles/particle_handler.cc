@@ -20,6 +20,8 @@
 
 #include <deal.II/particles/particle_handler.h>
 
+#include <algorithm>
+#include <cstring>
 #include <utility>
 
 DEAL_II_NAMESPACE_OPEN
@@ -33,6 +35,11 @@ namespace Particles
     : triangulation()
     , particles()
     , ghost_particles()
+    , particle_storage()
+    , particle_storage_is_current(false)
+    , ghost_particles_sent()
+    , ghost_particles_received()
+    , ghost_particles_lists_are_current(false)
     , global_number_of_particles(0)
     , global_max_particles_per_cell(0)
     , next_free_particle_index(0)
@@ -54,6 +61,11 @@ namespace Particles
     , mapping(&mapping, typeid(*this).name())
     , particles()
     , ghost_particles()
+    , particle_storage()
+    , particle_storage_is_current(false)
+    , ghost_particles_sent()
+    , ghost_particles_received()
+    , ghost_particles_lists_are_current(false)
     , global_number_of_particles(0)
     , global_max_particles_per_cell(0)
     , next_free_particle_index(0)
@@ -66,6 +78,16 @@ namespace Particles
 
 
 
+  template <int dim, int spacedim>
+  ParticleHandler<dim, spacedim>::~ParticleHandler()
+  {
+    // the particles return their properties to the pool on destruction
+    clear_particles();
+    ghost_particles.clear();
+  }
+
+
+
   template <int dim, int spacedim>
   void
   ParticleHandler<dim, spacedim>::initialize(
@@ -100,6 +122,8 @@ namespace Particles
   ParticleHandler<dim, spacedim>::clear_particles()
   {
     particles.clear();
+    particle_storage_is_current       = false;
+    ghost_particles_lists_are_current = false;
   }
 
 
@@ -157,6 +181,7 @@ namespace Particles
   typename ParticleHandler<dim, spacedim>::particle_iterator
   ParticleHandler<dim, spacedim>::begin()
   {
+    particle_storage_is_current = false;
     return particle_iterator(particles, particles.begin());
   }
 
@@ -244,6 +269,8 @@ namespace Particles
           particle_iterator(ghost_particles, particles_in_cell.second));
       }
 
+    particle_storage_is_current = false;
+
     const auto particles_in_cell = particles.equal_range(level_index);
     return boost::make_iterator_range(
       particle_iterator(particles, particles_in_cell.first),
@@ -258,6 +285,8 @@ namespace Particles
     const ParticleHandler<dim, spacedim>::particle_iterator &particle)
   {
     particles.erase(particle->particle);
+    particle_storage_is_current       = false;
+    ghost_particles_lists_are_current = false;
   }
 
 
@@ -268,6 +297,9 @@ namespace Particles
     const Particle<dim, spacedim> &                                    particle,
     const typename Triangulation<dim, spacedim>::active_cell_iterator &cell)
   {
+    particle_storage_is_current       = false;
+    ghost_particles_lists_are_current = false;
+
     typename std::multimap<internal::LevelInd,
                            Particle<dim, spacedim>>::iterator it =
       particles.insert(
@@ -293,6 +325,9 @@ namespace Particles
       typename Triangulation<dim, spacedim>::active_cell_iterator,
       Particle<dim, spacedim>> &new_particles)
   {
+    particle_storage_is_current       = false;
+    ghost_particles_lists_are_current = false;
+
     for (auto particle = new_particles.begin(); particle != new_particles.end();
          ++particle)
       particles.insert(
@@ -311,6 +346,9 @@ namespace Particles
   ParticleHandler<dim, spacedim>::insert_particles(
     const std::vector<Point<spacedim>> &positions)
   {
+    particle_storage_is_current       = false;
+    ghost_particles_lists_are_current = false;
+
     update_cached_numbers();
 
     // Determine the starting particle index of this process, which
@@ -424,6 +462,76 @@ namespace Particles
 
 
 
+  template <int dim, int spacedim>
+  const ParticleStorage<dim, spacedim> &
+  ParticleHandler<dim, spacedim>::get_particle_storage() const
+  {
+    if (particle_storage_is_current)
+      return particle_storage;
+
+    particle_storage.clear();
+    particle_storage.locations.reserve(particles.size());
+    particle_storage.reference_locations.reserve(particles.size());
+    particle_storage.ids.reserve(particles.size());
+    particle_storage.property_handles.reserve(particles.size());
+
+    // the multimap is sorted by the cells, so we can simply detect the start
+    // of a new cell by comparing to the previous key
+    for (const auto &particle : particles)
+      {
+        if (particle_storage.cells.empty() ||
+            particle_storage.cells.back() != particle.first)
+          {
+            if (!particle_storage.cells.empty())
+              particle_storage.cell_offsets.push_back(
+                particle_storage.locations.size());
+            particle_storage.cells.push_back(particle.first);
+          }
+        particle_storage.locations.push_back(particle.second.get_location());
+        particle_storage.reference_locations.push_back(
+          particle.second.get_reference_location());
+        particle_storage.ids.push_back(particle.second.get_id());
+        particle_storage.property_handles.push_back(
+          particle.second.has_properties() ? particle.second.properties :
+                                             PropertyPool::invalid_handle);
+      }
+    if (!particle_storage.cells.empty())
+      particle_storage.cell_offsets.push_back(
+        particle_storage.locations.size());
+
+    particle_storage_is_current = true;
+    return particle_storage;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::set_particle_positions(
+    const std::vector<Point<spacedim>> &new_positions,
+    const bool                          displace_particles)
+  {
+    AssertDimension(new_positions.size(), particles.size());
+
+    // make sure the particle storage is up to date, so that it can be kept
+    // in sync with the particles below
+    get_particle_storage();
+
+    unsigned int index = 0;
+    for (auto &particle : particles)
+      {
+        Point<spacedim> &location = particle_storage.locations[index];
+        if (displace_particles)
+          location += new_positions[index];
+        else
+          location = new_positions[index];
+        particle.second.set_location(location);
+        ++index;
+      }
+  }
+
+
+
   template <int dim, int spacedim>
   types::particle_index
   ParticleHandler<dim, spacedim>::get_next_free_particle_index() const
@@ -469,6 +577,75 @@ namespace Particles
       // therefore return if the scalar product of a is larger.
       return (scalar_product_a > scalar_product_b);
     }
+
+
+
+#  ifdef DEAL_II_WITH_MPI
+    /**
+     * The process of the ConsensusAlgorithm_NBX used to transfer particles
+     * between processes. The ranks this process sends particles to are
+     * given, and the ranks particles are received from are discovered by
+     * the algorithm. The buffer for a rank is packed by @p pack right before
+     * it is sent, i.e., while the messages to the previous ranks are in
+     * transit, and every received buffer is handed to @p unpack together
+     * with the rank of its sender as soon as it arrives, while the remaining
+     * messages are still in transit. The answers to the messages carry no
+     * payload.
+     */
+    class ParticleTransferProcess
+      : public Utilities::MPI::ConsensusAlgorithmProcess<char, char>
+    {
+    public:
+      ParticleTransferProcess(
+        const std::vector<unsigned int> &targets,
+        const std::function<void(const unsigned int, std::vector<char> &)>
+          &pack,
+        const std::function<void(const unsigned int,
+                                 const std::vector<char> &)> &unpack)
+        : targets(targets)
+        , pack(pack)
+        , unpack(unpack)
+      {}
+
+      virtual std::vector<unsigned int>
+      compute_targets() override
+      {
+        return targets;
+      }
+
+      virtual void
+      pack_recv_buffer(const int          other_rank,
+                       std::vector<char> &send_buffer) override
+      {
+        pack(other_rank, send_buffer);
+      }
+
+      virtual void
+      process_request(const unsigned int       other_rank,
+                      const std::vector<char> &buffer_recv,
+                      std::vector<char> &) override
+      {
+        unpack(other_rank, buffer_recv);
+      }
+
+    private:
+      /**
+       * The ranks particles are sent to.
+       */
+      const std::vector<unsigned int> &targets;
+
+      /**
+       * The function that fills the buffer sent to a rank.
+       */
+      const std::function<void(const unsigned int, std::vector<char> &)> pack;
+
+      /**
+       * The function that processes a received buffer.
+       */
+      const std::function<void(const unsigned int, const std::vector<char> &)>
+        unpack;
+    };
+#  endif
   } // namespace
 
 
@@ -485,34 +662,44 @@ namespace Particles
     // TODO: Extend this function to allow keeping particles on other
     // processes around (with an invalid cell).
 
+    particle_storage_is_current = false;
+
     std::vector<particle_iterator> particles_out_of_cell;
     particles_out_of_cell.reserve(n_locally_owned_particles());
 
-    // Now update the reference locations of the moved particles
-    for (particle_iterator it = begin(); it != end(); ++it)
+    // Now update the reference locations of the moved particles. The
+    // particles are sorted by cells, so we can hand all particles of a cell
+    // to the mapping at once
+    std::vector<Point<spacedim>> real_locations;
+    std::vector<Point<dim>>      reference_locations;
+    for (auto cell_begin = particles.begin(); cell_begin != particles.end();)
       {
-        const typename Triangulation<dim, spacedim>::cell_iterator cell =
-          it->get_surrounding_cell(*triangulation);
+        const internal::LevelInd level_index = cell_begin->first;
+
+        real_locations.clear();
+        auto cell_end = cell_begin;
+        for (; cell_end != particles.end() && cell_end->first == level_index;
+             ++cell_end)
+          real_locations.push_back(cell_end->second.get_location());
+        reference_locations.resize(real_locations.size());
+
+        const typename Triangulation<dim, spacedim>::cell_iterator cell(
+          &*triangulation, level_index.first, level_index.second);
+        mapping->transform_points_real_to_unit_cell(cell,
+                                                    real_locations,
+                                                    reference_locations);
+
+        unsigned int i = 0;
+        for (auto it = cell_begin; it != cell_end; ++it, ++i)
+          if (GeometryInfo<dim>::is_inside_unit_cell(reference_locations[i]))
+            it->second.set_reference_location(reference_locations[i]);
+          else
+            {
+              // The particle has left the cell
+              particles_out_of_cell.push_back(particle_iterator(particles, it));
+            }
 
-        try
-          {
-            const Point<dim> p_unit =
-              mapping->transform_real_to_unit_cell(cell, it->get_location());
-            if (GeometryInfo<dim>::is_inside_unit_cell(p_unit))
-              {
-                it->set_reference_location(p_unit);
-              }
-            else
-              {
-                // The particle has left the cell
-                particles_out_of_cell.push_back(it);
-              }
-          }
-        catch (typename Mapping<dim>::ExcTransformationFailed &)
-          {
-            // The particle has left the cell
-            particles_out_of_cell.push_back(it);
-          }
+        cell_begin = cell_end;
       }
 
     // There are three reasons why a particle is not in its old cell:
@@ -693,7 +880,13 @@ namespace Particles
     for (unsigned int i = 0; i < particles_out_of_cell.size(); ++i)
       remove_particle(particles_out_of_cell[i]);
 
+    // The ghost particles only need to be rebuilt if particles changed their
+    // cells
+    if (!particles_out_of_cell.empty() || !sorted_particles_map.empty())
+      ghost_particles_lists_are_current = false;
+
     particles.insert(sorted_particles_map.begin(), sorted_particles_map.end());
+    sort_property_pool();
     update_cached_numbers();
   }
 
@@ -711,6 +904,7 @@ namespace Particles
 #  ifdef DEAL_II_WITH_MPI
     // First clear the current ghost_particle information
     ghost_particles.clear();
+    ghost_particles_received.clear();
 
     std::map<types::subdomain_id, std::vector<particle_iterator>>
       ghost_particles_by_domain;
@@ -764,7 +958,157 @@ namespace Particles
           }
       }
 
-    send_recv_particles(ghost_particles_by_domain, ghost_particles);
+    send_recv_particles(
+      ghost_particles_by_domain,
+      ghost_particles,
+      std::map<
+        types::subdomain_id,
+        std::vector<
+          typename Triangulation<dim, spacedim>::active_cell_iterator>>(),
+      &ghost_particles_received);
+
+    // Remember the lists for update_ghost_particles()
+    ghost_particles_sent              = std::move(ghost_particles_by_domain);
+    ghost_particles_lists_are_current = true;
+#  endif
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::update_ghost_particles()
+  {
+    // Nothing to do in serial computations
+    if (dealii::Utilities::MPI::n_mpi_processes(
+          triangulation->get_communicator()) == 1)
+      return;
+
+#  ifdef DEAL_II_WITH_MPI
+    // The lists of the last exchange can only be reused if no process has
+    // changed the cells of its particles since then
+    if (Utilities::MPI::min(ghost_particles_lists_are_current ? 1U : 0U,
+                            triangulation->get_communicator()) == 0)
+      {
+        exchange_ghost_particles();
+        return;
+      }
+
+    const unsigned int n_properties = property_pool->n_properties_per_slot();
+    const std::size_t  particle_size =
+      sizeof(Point<spacedim>) + sizeof(Point<dim>) +
+      n_properties * sizeof(double) + (size_callback ? size_callback() : 0);
+
+    // The number of particles exchanged with each process is known from the
+    // last exchange, so all messages can be posted at once
+    const int mpi_tag = 2;
+
+    std::vector<std::vector<char>>                recv_data;
+    std::vector<MPI_Request>                      recv_requests;
+    std::vector<std::vector<particle_iterator> *> recv_particles;
+    recv_data.reserve(ghost_particles_received.size());
+    recv_requests.reserve(ghost_particles_received.size());
+    for (auto &received : ghost_particles_received)
+      if (received.second.size() > 0)
+        {
+          recv_data.emplace_back(received.second.size() * particle_size);
+          recv_requests.emplace_back();
+          recv_particles.push_back(&received.second);
+          const int ierr = MPI_Irecv(recv_data.back().data(),
+                                     recv_data.back().size(),
+                                     MPI_CHAR,
+                                     received.first,
+                                     mpi_tag,
+                                     triangulation->get_communicator(),
+                                     &recv_requests.back());
+          AssertThrowMPI(ierr);
+        }
+
+    std::vector<std::vector<char>> send_data;
+    std::vector<MPI_Request>       send_requests;
+    send_data.reserve(ghost_particles_sent.size());
+    send_requests.reserve(ghost_particles_sent.size());
+    for (const auto &sent : ghost_particles_sent)
+      if (sent.second.size() > 0)
+        {
+          send_data.emplace_back(sent.second.size() * particle_size);
+          void *data = static_cast<void *>(send_data.back().data());
+          for (const auto &particle : sent.second)
+            {
+              std::memcpy(data,
+                          &particle->get_location(),
+                          sizeof(Point<spacedim>));
+              data = static_cast<char *>(data) + sizeof(Point<spacedim>);
+              std::memcpy(data,
+                          &particle->get_reference_location(),
+                          sizeof(Point<dim>));
+              data = static_cast<char *>(data) + sizeof(Point<dim>);
+              if (particle->has_properties())
+                std::memcpy(data,
+                            particle->get_properties().data(),
+                            n_properties * sizeof(double));
+              data = static_cast<char *>(data) + n_properties * sizeof(double);
+              if (store_callback)
+                data = store_callback(particle, data);
+            }
+
+          send_requests.emplace_back();
+          const int ierr = MPI_Isend(send_data.back().data(),
+                                     send_data.back().size(),
+                                     MPI_CHAR,
+                                     sent.first,
+                                     mpi_tag,
+                                     triangulation->get_communicator(),
+                                     &send_requests.back());
+          AssertThrowMPI(ierr);
+        }
+
+    // Update the ghost particles of each process as soon as its message
+    // arrives
+    for (unsigned int i = 0; i < recv_requests.size(); ++i)
+      {
+        int       index;
+        const int ierr = MPI_Waitany(recv_requests.size(),
+                                     recv_requests.data(),
+                                     &index,
+                                     MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+
+        const void *data = static_cast<const void *>(recv_data[index].data());
+        for (auto &particle : *recv_particles[index])
+          {
+            Point<spacedim> location;
+            std::memcpy(&location, data, sizeof(Point<spacedim>));
+            particle->set_location(location);
+            data = static_cast<const char *>(data) + sizeof(Point<spacedim>);
+
+            Point<dim> reference_location;
+            std::memcpy(&reference_location, data, sizeof(Point<dim>));
+            particle->set_reference_location(reference_location);
+            data = static_cast<const char *>(data) + sizeof(Point<dim>);
+
+            if (particle->has_properties())
+              std::memcpy(particle->get_properties().data(),
+                          data,
+                          n_properties * sizeof(double));
+            data =
+              static_cast<const char *>(data) + n_properties * sizeof(double);
+
+            if (load_callback)
+              data = load_callback(particle, data);
+          }
+
+        AssertThrow(data == recv_data[index].data() + recv_data[index].size(),
+                    ExcMessage(
+                      "The amount of data that was read into the ghost "
+                      "particles does not match the amount of data sent "
+                      "around."));
+      }
+
+    const int ierr = MPI_Waitall(send_requests.size(),
+                                 send_requests.data(),
+                                 MPI_STATUSES_IGNORE);
+    AssertThrowMPI(ierr);
 #  endif
   }
 
@@ -781,14 +1125,12 @@ namespace Particles
     const std::map<
       types::subdomain_id,
       std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>>
-      &send_cells)
+      &send_cells,
+    std::map<types::subdomain_id, std::vector<particle_iterator>>
+      *received_particles_by_domain)
   {
-    // Determine the communication pattern
     const std::set<types::subdomain_id> ghost_owners =
       triangulation->ghost_owners();
-    const std::vector<types::subdomain_id> neighbors(ghost_owners.begin(),
-                                                     ghost_owners.end());
-    const unsigned int                     n_neighbors = neighbors.size();
 
     if (send_cells.size() != 0)
       Assert(particles_to_send.size() == send_cells.size(), ExcInternalError());
@@ -807,183 +1149,98 @@ namespace Particles
       Assert(ghost_owners.find(send_particles->first) != ghost_owners.end(),
              ExcNotImplemented());
 
-    unsigned int n_send_particles = 0;
-    for (auto send_particles = particles_to_send.begin();
-         send_particles != particles_to_send.end();
-         ++send_particles)
-      n_send_particles += send_particles->second.size();
+    // Only the processes we actually send particles to are contacted. The
+    // processes we receive particles from are discovered by the consensus
+    // algorithm, so that no data is exchanged with the other neighbors.
+    std::vector<unsigned int> targets;
+    for (const auto &send_particles : particles_to_send)
+      if (send_particles.second.size() > 0)
+        targets.push_back(send_particles.first);
 
     const unsigned int cellid_size = sizeof(CellId::binary_type);
 
-    // Containers for the amount and offsets of data we will send
-    // to other processors and the data itself.
-    std::vector<unsigned int> n_send_data(n_neighbors, 0);
-    std::vector<unsigned int> send_offsets(n_neighbors, 0);
-    std::vector<char>         send_data;
-
-    // Only serialize things if there are particles to be send.
-    // We can not return early even if no particles
-    // are send, because we might receive particles from other processes
-    if (n_send_particles > 0)
-      {
-        // Allocate space for sending particle data
-        const unsigned int particle_size =
-          begin()->serialized_size_in_bytes() + cellid_size +
-          (size_callback ? size_callback() : 0);
-        send_data.resize(n_send_particles * particle_size);
-        void *data = static_cast<void *>(&send_data.front());
-
-        // Serialize the data sorted by receiving process
-        for (unsigned int i = 0; i < n_neighbors; ++i)
-          {
-            send_offsets[i] = reinterpret_cast<std::size_t>(data) -
-                              reinterpret_cast<std::size_t>(&send_data.front());
-
-            for (unsigned int j = 0;
-                 j < particles_to_send.at(neighbors[i]).size();
-                 ++j)
-              {
-                // If no target cells are given, use the iterator information
-                typename Triangulation<dim, spacedim>::active_cell_iterator
-                  cell;
-                if (send_cells.size() == 0)
-                  cell =
-                    particles_to_send.at(neighbors[i])[j]->get_surrounding_cell(
-                      *triangulation);
-                else
-                  cell = send_cells.at(neighbors[i])[j];
-
-                const CellId::binary_type cellid =
-                  cell->id().template to_binary<dim>();
-                memcpy(data, &cellid, cellid_size);
-                data = static_cast<char *>(data) + cellid_size;
-
-                particles_to_send.at(neighbors[i])[j]->write_data(data);
-                if (store_callback)
-                  data =
-                    store_callback(particles_to_send.at(neighbors[i])[j], data);
-              }
-            n_send_data[i] = reinterpret_cast<std::size_t>(data) -
-                             send_offsets[i] -
-                             reinterpret_cast<std::size_t>(&send_data.front());
-          }
-      }
-
-    // Containers for the data we will receive from other processors
-    std::vector<unsigned int> n_recv_data(n_neighbors);
-    std::vector<unsigned int> recv_offsets(n_neighbors);
-
-    // Notify other processors how many particles we will send
-    {
-      std::vector<MPI_Request> n_requests(2 * n_neighbors);
-      for (unsigned int i = 0; i < n_neighbors; ++i)
-        {
-          const int ierr = MPI_Irecv(&(n_recv_data[i]),
-                                     1,
-                                     MPI_UNSIGNED,
-                                     neighbors[i],
-                                     0,
-                                     triangulation->get_communicator(),
-                                     &(n_requests[2 * i]));
-          AssertThrowMPI(ierr);
-        }
-      for (unsigned int i = 0; i < n_neighbors; ++i)
+    // All particles have the same size, so the buffer for each process can
+    // be allocated at once
+    const std::size_t particle_size =
+      (targets.size() > 0 ?
+         particles_to_send.at(targets.front())
+             .front()
+             ->serialized_size_in_bytes() +
+           cellid_size + (size_callback ? size_callback() : 0) :
+         0);
+
+    const auto pack = [&](const unsigned int rank, std::vector<char> &buffer) {
+      const std::vector<particle_iterator> &rank_particles =
+        particles_to_send.at(rank);
+      buffer.resize(rank_particles.size() * particle_size);
+      void *data = static_cast<void *>(buffer.data());
+
+      for (unsigned int j = 0; j < rank_particles.size(); ++j)
         {
-          const int ierr = MPI_Isend(&(n_send_data[i]),
-                                     1,
-                                     MPI_UNSIGNED,
-                                     neighbors[i],
-                                     0,
-                                     triangulation->get_communicator(),
-                                     &(n_requests[2 * i + 1]));
-          AssertThrowMPI(ierr);
-        }
-      const int ierr =
-        MPI_Waitall(2 * n_neighbors, n_requests.data(), MPI_STATUSES_IGNORE);
-      AssertThrowMPI(ierr);
-    }
-
-    // Determine how many particles and data we will receive
-    unsigned int total_recv_data = 0;
-    for (unsigned int neighbor_id = 0; neighbor_id < n_neighbors; ++neighbor_id)
-      {
-        recv_offsets[neighbor_id] = total_recv_data;
-        total_recv_data += n_recv_data[neighbor_id];
-      }
-
-    // Set up the space for the received particle data
-    std::vector<char> recv_data(total_recv_data);
+          // If no target cells are given, use the iterator information
+          typename Triangulation<dim, spacedim>::active_cell_iterator cell;
+          if (send_cells.size() == 0)
+            cell = rank_particles[j]->get_surrounding_cell(*triangulation);
+          else
+            cell = send_cells.at(rank)[j];
 
-    // Exchange the particle data between domains
-    {
-      std::vector<MPI_Request> requests(2 * n_neighbors);
-      unsigned int             send_ops = 0;
-      unsigned int             recv_ops = 0;
+          const CellId::binary_type cellid =
+            cell->id().template to_binary<dim>();
+          memcpy(data, &cellid, cellid_size);
+          data = static_cast<char *>(data) + cellid_size;
 
-      for (unsigned int i = 0; i < n_neighbors; ++i)
-        if (n_recv_data[i] > 0)
-          {
-            const int ierr = MPI_Irecv(&(recv_data[recv_offsets[i]]),
-                                       n_recv_data[i],
-                                       MPI_CHAR,
-                                       neighbors[i],
-                                       1,
-                                       triangulation->get_communicator(),
-                                       &(requests[send_ops]));
-            AssertThrowMPI(ierr);
-            send_ops++;
-          }
+          rank_particles[j]->write_data(data);
+          if (store_callback)
+            data = store_callback(rank_particles[j], data);
+        }
 
-      for (unsigned int i = 0; i < n_neighbors; ++i)
-        if (n_send_data[i] > 0)
-          {
-            const int ierr = MPI_Isend(&(send_data[send_offsets[i]]),
-                                       n_send_data[i],
-                                       MPI_CHAR,
-                                       neighbors[i],
-                                       1,
-                                       triangulation->get_communicator(),
-                                       &(requests[send_ops + recv_ops]));
-            AssertThrowMPI(ierr);
-            recv_ops++;
-          }
-      const int ierr =
-        MPI_Waitall(send_ops + recv_ops, requests.data(), MPI_STATUSES_IGNORE);
-      AssertThrowMPI(ierr);
-    }
+      Assert(data == buffer.data() + buffer.size(), ExcInternalError());
+    };
 
     // Put the received particles into the domain if they are in the
     // triangulation
-    const void *recv_data_it = static_cast<const void *>(recv_data.data());
+    const auto unpack = [&](const unsigned int       rank,
+                            const std::vector<char> &buffer) {
+      const void *recv_data_it = static_cast<const void *>(buffer.data());
 
-    while (reinterpret_cast<std::size_t>(recv_data_it) -
-             reinterpret_cast<std::size_t>(recv_data.data()) <
-           total_recv_data)
-      {
-        CellId::binary_type binary_cellid;
-        memcpy(&binary_cellid, recv_data_it, cellid_size);
-        const CellId id(binary_cellid);
-        recv_data_it = static_cast<const char *>(recv_data_it) + cellid_size;
-
-        const typename Triangulation<dim, spacedim>::active_cell_iterator cell =
-          id.to_cell(*triangulation);
-
-        typename std::multimap<internal::LevelInd,
-                               Particle<dim, spacedim>>::iterator
-          recv_particle = received_particles.insert(std::make_pair(
-            internal::LevelInd(cell->level(), cell->index()),
-            Particle<dim, spacedim>(recv_data_it, property_pool.get())));
-
-        if (load_callback)
-          recv_data_it =
-            load_callback(particle_iterator(received_particles, recv_particle),
-                          recv_data_it);
-      }
+      while (reinterpret_cast<std::size_t>(recv_data_it) -
+               reinterpret_cast<std::size_t>(buffer.data()) <
+             buffer.size())
+        {
+          CellId::binary_type binary_cellid;
+          memcpy(&binary_cellid, recv_data_it, cellid_size);
+          const CellId id(binary_cellid);
+          recv_data_it = static_cast<const char *>(recv_data_it) + cellid_size;
+
+          const typename Triangulation<dim, spacedim>::active_cell_iterator
+            cell = id.to_cell(*triangulation);
+
+          typename std::multimap<internal::LevelInd,
+                                 Particle<dim, spacedim>>::iterator
+            recv_particle = received_particles.insert(std::make_pair(
+              internal::LevelInd(cell->level(), cell->index()),
+              Particle<dim, spacedim>(recv_data_it, property_pool.get())));
+
+          if (received_particles_by_domain != nullptr)
+            (*received_particles_by_domain)[rank].push_back(
+              particle_iterator(received_particles, recv_particle));
+
+          if (load_callback)
+            recv_data_it = load_callback(
+              particle_iterator(received_particles, recv_particle),
+              recv_data_it);
+        }
+
+      AssertThrow(recv_data_it == buffer.data() + buffer.size(),
+                  ExcMessage(
+                    "The amount of data that was read into new particles "
+                    "does not match the amount of data sent around."));
+    };
 
-    AssertThrow(recv_data_it == recv_data.data() + recv_data.size(),
-                ExcMessage(
-                  "The amount of data that was read into new particles "
-                  "does not match the amount of data sent around."));
+    ParticleTransferProcess process(targets, pack, unpack);
+    Utilities::MPI::ConsensusAlgorithm_NBX<char, char> consensus_algorithm(
+      process, triangulation->get_communicator());
+    consensus_algorithm.run();
   }
 #  endif
 
@@ -1004,6 +1261,47 @@ namespace Particles
 
 
 
+  template <int dim, int spacedim>
+  void
+  ParticleHandler<dim, spacedim>::sort_property_pool()
+  {
+    const unsigned int n_properties = property_pool->n_properties_per_slot();
+    if (n_properties == 0)
+      return;
+
+    std::vector<PropertyPool::Handle> handles;
+    handles.reserve(particles.size() + ghost_particles.size());
+    for (const auto &particle : particles)
+      handles.push_back(particle.second.properties);
+    for (const auto &particle : ghost_particles)
+      handles.push_back(particle.second.properties);
+
+    // nothing to do if the properties are already in the right order, which
+    // is the case if no particles have been added or moved since the last
+    // call
+    bool is_sorted = true;
+    for (unsigned int i = 1; i < handles.size(); ++i)
+      if (handles[i] != handles[i - 1] + n_properties)
+        {
+          is_sorted = false;
+          break;
+        }
+    if (is_sorted)
+      return;
+
+    property_pool->sort_memory_slots(handles);
+
+    unsigned int index = 0;
+    for (auto &particle : particles)
+      particle.second.properties = handles[index++];
+    for (auto &particle : ghost_particles)
+      particle.second.properties = handles[index++];
+
+    particle_storage_is_current = false;
+  }
+
+
+
   template <int dim, int spacedim>
   void
   ParticleHandler<dim, spacedim>::register_store_callback_function()
@@ -1019,6 +1317,10 @@ namespace Particles
 
     if (global_max_particles_per_cell > 0)
       {
+        // make the properties of each cell contiguous, so that
+        // store_particles() can copy them at once
+        sort_property_pool();
+
         const std::function<std::vector<char>(
           const typename Triangulation<dim, spacedim>::cell_iterator &,
           const typename Triangulation<dim, spacedim>::CellStatus)>
@@ -1100,90 +1402,141 @@ namespace Particles
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const typename Triangulation<dim, spacedim>::CellStatus     status) const
   {
-    std::vector<Particle<dim, spacedim>> stored_particles_on_cell;
+    // Collect the cells whose particles are stored: the cell itself if it
+    // persists or is refined, and its children if they will be coarsened
+    std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+      stored_cells;
 
     switch (status)
       {
         case parallel::distributed::Triangulation<dim, spacedim>::CELL_PERSIST:
         case parallel::distributed::Triangulation<dim, spacedim>::CELL_REFINE:
-          // If the cell persist or is refined store all particles of the
-          // current cell.
-          {
-            unsigned int n_particles = 0;
-
-            const internal::LevelInd level_index = {cell->level(),
-                                                    cell->index()};
-            const auto               particles_in_cell =
-              (cell->is_ghost() ? ghost_particles.equal_range(level_index) :
-                                  particles.equal_range(level_index));
-
-            n_particles = n_particles_in_cell(cell);
-            stored_particles_on_cell.reserve(n_particles);
-
-            std::for_each(
-              particles_in_cell.first,
-              particles_in_cell.second,
-              [&stored_particles_on_cell](
-                const std::pair<internal::LevelInd, Particle<dim, spacedim>>
-                  &particle) {
-                stored_particles_on_cell.push_back(particle.second);
-              });
-
-            AssertDimension(n_particles, stored_particles_on_cell.size());
-          }
+          stored_cells.push_back(cell);
           break;
 
         case parallel::distributed::Triangulation<dim, spacedim>::CELL_COARSEN:
-          // If this cell is the parent of children that will be coarsened,
-          // collect the particles of all children.
-          {
-            unsigned int n_particles = 0;
+          for (unsigned int child_index = 0;
+               child_index < GeometryInfo<dim>::max_children_per_cell;
+               ++child_index)
+            stored_cells.push_back(cell->child(child_index));
+          break;
 
-            for (unsigned int child_index = 0;
-                 child_index < GeometryInfo<dim>::max_children_per_cell;
-                 ++child_index)
-              {
-                const typename Triangulation<dim, spacedim>::cell_iterator
-                  child = cell->child(child_index);
-                n_particles += n_particles_in_cell(child);
-              }
+        default:
+          Assert(false, ExcInternalError());
+          break;
+      }
 
-            stored_particles_on_cell.reserve(n_particles);
+    unsigned int n_particles = 0;
+    for (const auto &stored_cell : stored_cells)
+      n_particles += n_particles_in_cell(stored_cell);
+
+    // The data consists of the number of particles followed by the arrays
+    // of the ids, locations, reference locations, and properties
+    const unsigned int n_properties = property_pool->n_properties_per_slot();
+    std::vector<char>  buffer(sizeof(unsigned int) +
+                             n_particles *
+                               (sizeof(types::particle_index) +
+                                sizeof(Point<spacedim>) + sizeof(Point<dim>) +
+                                n_properties * sizeof(double)));
+    std::memcpy(buffer.data(), &n_particles, sizeof(unsigned int));
+
+    char *const id_data = buffer.data() + sizeof(unsigned int);
+    char *const location_data =
+      id_data + n_particles * sizeof(types::particle_index);
+    char *const reference_location_data =
+      location_data + n_particles * sizeof(Point<spacedim>);
+    char *const property_data =
+      reference_location_data + n_particles * sizeof(Point<dim>);
+
+    unsigned int index = 0;
+    for (const auto &stored_cell : stored_cells)
+      {
+        const internal::LevelInd level_index = {stored_cell->level(),
+                                                stored_cell->index()};
 
-            for (unsigned int child_index = 0;
-                 child_index < GeometryInfo<dim>::max_children_per_cell;
-                 ++child_index)
+        if (stored_cell->is_ghost())
+          {
+            const auto particles_in_cell =
+              ghost_particles.equal_range(level_index);
+            for (auto particle = particles_in_cell.first;
+                 particle != particles_in_cell.second;
+                 ++particle, ++index)
               {
-                const typename Triangulation<dim, spacedim>::cell_iterator
-                                         child       = cell->child(child_index);
-                const internal::LevelInd level_index = {child->level(),
-                                                        child->index()};
-                const auto               particles_in_cell =
-                  (child->is_ghost() ?
-                     ghost_particles.equal_range(level_index) :
-                     particles.equal_range(level_index));
-
-                std::for_each(
-                  particles_in_cell.first,
-                  particles_in_cell.second,
-                  [&stored_particles_on_cell](
-                    const std::pair<internal::LevelInd, Particle<dim, spacedim>>
-                      &particle) {
-                    stored_particles_on_cell.push_back(particle.second);
-                  });
+                const types::particle_index id = particle->second.get_id();
+                std::memcpy(id_data + index * sizeof(types::particle_index),
+                            &id,
+                            sizeof(types::particle_index));
+                std::memcpy(location_data + index * sizeof(Point<spacedim>),
+                            &particle->second.get_location(),
+                            sizeof(Point<spacedim>));
+                std::memcpy(reference_location_data +
+                              index * sizeof(Point<dim>),
+                            &particle->second.get_reference_location(),
+                            sizeof(Point<dim>));
+                if (particle->second.has_properties())
+                  std::memcpy(property_data +
+                                index * n_properties * sizeof(double),
+                              particle->second.get_properties().data(),
+                              n_properties * sizeof(double));
               }
+            continue;
+          }
 
-            AssertDimension(n_particles, stored_particles_on_cell.size());
+        // For locally owned cells, copy the data of all particles of the
+        // cell at once from the structure-of-arrays representation
+        const ParticleStorage<dim, spacedim> &storage = get_particle_storage();
+        const auto                            found_cell =
+          std::lower_bound(storage.cells.begin(),
+                           storage.cells.end(),
+                           level_index);
+        if (found_cell == storage.cells.end() || *found_cell != level_index)
+          continue;
+
+        const std::pair<unsigned int, unsigned int> range =
+          storage.particle_range(found_cell - storage.cells.begin());
+        const unsigned int n_particles_in_range = range.second - range.first;
+
+        std::memcpy(id_data + index * sizeof(types::particle_index),
+                    &storage.ids[range.first],
+                    n_particles_in_range * sizeof(types::particle_index));
+        std::memcpy(location_data + index * sizeof(Point<spacedim>),
+                    &storage.locations[range.first],
+                    n_particles_in_range * sizeof(Point<spacedim>));
+        std::memcpy(reference_location_data + index * sizeof(Point<dim>),
+                    &storage.reference_locations[range.first],
+                    n_particles_in_range * sizeof(Point<dim>));
+
+        if (n_properties > 0)
+          {
+            // The properties of a cell are contiguous in the property pool
+            // after sort_property_pool(), unless particles were added since
+            const PropertyPool::Handle *handles =
+              &storage.property_handles[range.first];
+            bool is_contiguous = (handles[0] != PropertyPool::invalid_handle);
+            for (unsigned int i = 1; i < n_particles_in_range && is_contiguous;
+                 ++i)
+              is_contiguous = (handles[i] == handles[i - 1] + n_properties);
+
+            char *properties =
+              property_data + index * n_properties * sizeof(double);
+            if (is_contiguous)
+              std::memcpy(properties,
+                          handles[0],
+                          n_particles_in_range * n_properties * sizeof(double));
+            else
+              for (unsigned int i = 0; i < n_particles_in_range; ++i)
+                if (handles[i] != PropertyPool::invalid_handle)
+                  std::memcpy(properties + i * n_properties * sizeof(double),
+                              handles[i],
+                              n_properties * sizeof(double));
           }
-          break;
 
-        default:
-          Assert(false, ExcInternalError());
-          break;
+        index += n_particles_in_range;
       }
 
-    return Utilities::pack(stored_particles_on_cell,
-                           /*allow_compression=*/true);
+    AssertDimension(index, n_particles);
+
+    return buffer;
   }
 
   template <int dim, int spacedim>
@@ -1193,19 +1546,60 @@ namespace Particles
     const typename Triangulation<dim, spacedim>::CellStatus         status,
     const boost::iterator_range<std::vector<char>::const_iterator> &data_range)
   {
+    const unsigned int n_properties = property_pool->n_properties_per_slot();
+    const char *const  data         = &*data_range.begin();
+    unsigned int       n_particles  = 0;
+    std::memcpy(&n_particles, data, sizeof(unsigned int));
+    AssertDimension(data_range.size(),
+                    sizeof(unsigned int) +
+                      n_particles *
+                        (sizeof(types::particle_index) +
+                         sizeof(Point<spacedim>) + sizeof(Point<dim>) +
+                         n_properties * sizeof(double)));
+
+    const char *const id_data = data + sizeof(unsigned int);
+    const char *const location_data =
+      id_data + n_particles * sizeof(types::particle_index);
+    const char *const reference_location_data =
+      location_data + n_particles * sizeof(Point<spacedim>);
+    const char *const property_data =
+      reference_location_data + n_particles * sizeof(Point<dim>);
+
     // We leave this container non-const to be able to `std::move`
-    // its contents directly into the particles multimap later.
-    std::vector<Particle<dim, spacedim>> loaded_particles_on_cell =
-      Utilities::unpack<std::vector<Particle<dim, spacedim>>>(
-        data_range.begin(),
-        data_range.end(),
-        /*allow_compression=*/true);
-
-    // Update the reference to the current property pool for all particles.
-    // This was not stored, because they might be transported across process
-    // domains.
-    for (auto &particle : loaded_particles_on_cell)
-      particle.set_property_pool(*property_pool);
+    // its contents directly into the particles multimap later. The
+    // properties are allocated in the current property pool, because the
+    // particles might be transported across process domains.
+    std::vector<Particle<dim, spacedim>> loaded_particles_on_cell;
+    loaded_particles_on_cell.reserve(n_particles);
+    for (unsigned int i = 0; i < n_particles; ++i)
+      {
+        types::particle_index id;
+        Point<spacedim>       location;
+        Point<dim>            reference_location;
+        std::memcpy(&id,
+                    id_data + i * sizeof(types::particle_index),
+                    sizeof(types::particle_index));
+        std::memcpy(&location,
+                    location_data + i * sizeof(Point<spacedim>),
+                    sizeof(Point<spacedim>));
+        std::memcpy(&reference_location,
+                    reference_location_data + i * sizeof(Point<dim>),
+                    sizeof(Point<dim>));
+
+        loaded_particles_on_cell.emplace_back(location, reference_location, id);
+        Particle<dim, spacedim> &particle = loaded_particles_on_cell.back();
+        particle.set_property_pool(*property_pool);
+        if (n_properties > 0)
+          {
+            particle.properties = property_pool->allocate_properties_array();
+            std::memcpy(particle.properties,
+                        property_data + i * n_properties * sizeof(double),
+                        n_properties * sizeof(double));
+          }
+      }
+
+    particle_storage_is_current       = false;
+    ghost_particles_lists_are_current = false;
 
     switch (status)
       {
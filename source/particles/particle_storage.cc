@@ -0,0 +1,140 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/particles/particle_storage.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Particles
+{
+  template <int dim, int spacedim>
+  ParticleStorage<dim, spacedim>::ParticleStorage()
+    : cell_offsets(1, 0U)
+  {}
+
+
+
+  template <int dim, int spacedim>
+  void
+  ParticleStorage<dim, spacedim>::clear()
+  {
+    cells.clear();
+    cell_offsets.resize(1);
+    cell_offsets[0] = 0;
+    locations.clear();
+    reference_locations.clear();
+    ids.clear();
+    property_handles.clear();
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  ParticleStorage<dim, spacedim>::n_particles() const
+  {
+    return locations.size();
+  }
+
+
+
+  template <int dim, int spacedim>
+  unsigned int
+  ParticleStorage<dim, spacedim>::n_cells() const
+  {
+    return cells.size();
+  }
+
+
+
+  template <int dim, int spacedim>
+  const internal::LevelInd &
+  ParticleStorage<dim, spacedim>::get_cell(const unsigned int c) const
+  {
+    AssertIndexRange(c, cells.size());
+    return cells[c];
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::pair<unsigned int, unsigned int>
+  ParticleStorage<dim, spacedim>::particle_range(const unsigned int c) const
+  {
+    AssertIndexRange(c, cells.size());
+    return std::make_pair(cell_offsets[c], cell_offsets[c + 1]);
+  }
+
+
+
+  template <int dim, int spacedim>
+  ArrayView<const Point<spacedim>>
+  ParticleStorage<dim, spacedim>::get_locations() const
+  {
+    return make_array_view(locations);
+  }
+
+
+
+  template <int dim, int spacedim>
+  ArrayView<const Point<dim>>
+  ParticleStorage<dim, spacedim>::get_reference_locations() const
+  {
+    return make_array_view(reference_locations);
+  }
+
+
+
+  template <int dim, int spacedim>
+  ArrayView<const types::particle_index>
+  ParticleStorage<dim, spacedim>::get_ids() const
+  {
+    return make_array_view(ids);
+  }
+
+
+
+  template <int dim, int spacedim>
+  ArrayView<const PropertyPool::Handle>
+  ParticleStorage<dim, spacedim>::get_property_handles() const
+  {
+    return make_array_view(property_handles);
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::size_t
+  ParticleStorage<dim, spacedim>::memory_consumption() const
+  {
+    return MemoryConsumption::memory_consumption(cells) +
+           MemoryConsumption::memory_consumption(cell_offsets) +
+           MemoryConsumption::memory_consumption(locations) +
+           MemoryConsumption::memory_consumption(reference_locations) +
+           MemoryConsumption::memory_consumption(ids) +
+           MemoryConsumption::memory_consumption(property_handles);
+  }
+} // namespace Particles
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+DEAL_II_NAMESPACE_OPEN
+
+#include "particle_storage.inst"
+
+DEAL_II_NAMESPACE_CLOSE
@@ -14,8 +14,13 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/memory_consumption.h>
+
 #include <deal.II/particles/property_pool.h>
 
+#include <algorithm>
+#include <functional>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace Particles
@@ -25,6 +30,7 @@ namespace Particles
 
   PropertyPool::PropertyPool(const unsigned int n_properties_per_slot)
     : n_properties(n_properties_per_slot)
+    , n_slots(0)
   {}
 
 
@@ -34,7 +40,16 @@ namespace Particles
   {
     PropertyPool::Handle handle = PropertyPool::invalid_handle;
     if (n_properties > 0)
-      handle = new double[n_properties];
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // grow geometrically to keep the number of chunks small
+        if (free_slots.empty())
+          add_chunk(std::max<std::size_t>(64, n_slots / 2));
+
+        handle = free_slots.back();
+        free_slots.pop_back();
+      }
 
     return handle;
   }
@@ -44,7 +59,47 @@ namespace Particles
   void
   PropertyPool::deallocate_properties_array(Handle handle)
   {
-    delete[] handle;
+    if (handle != PropertyPool::invalid_handle)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        free_slots.push_back(handle);
+      }
+  }
+
+
+
+  void
+  PropertyPool::sort_memory_slots(std::vector<Handle> &handles)
+  {
+    if (n_properties == 0)
+      return;
+
+    std::size_t n_valid_handles = 0;
+    for (const Handle handle : handles)
+      if (handle != PropertyPool::invalid_handle)
+        ++n_valid_handles;
+
+    if (n_valid_handles == 0)
+      return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::unique_ptr<double[]> chunk(new double[n_valid_handles * n_properties]);
+    Handle                    next_slot = chunk.get();
+    for (Handle &handle : handles)
+      if (handle != PropertyPool::invalid_handle)
+        {
+          std::copy(handle, handle + n_properties, next_slot);
+          free_slots.push_back(handle);
+          handle = next_slot;
+          next_slot += n_properties;
+        }
+
+    chunks.push_back(std::move(chunk));
+    chunk_n_slots.push_back(n_valid_handles);
+    n_slots += n_valid_handles;
+
+    release_unused_chunks();
   }
 
 
@@ -60,7 +115,9 @@ namespace Particles
   void
   PropertyPool::reserve(const std::size_t size)
   {
-    (void)size;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (n_properties > 0 && size > n_slots)
+      add_chunk(size - n_slots);
   }
 
 
@@ -70,5 +127,107 @@ namespace Particles
   {
     return n_properties;
   }
+
+
+
+  std::size_t
+  PropertyPool::n_allocated_slots() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return n_slots - free_slots.size();
+  }
+
+
+
+  std::size_t
+  PropertyPool::memory_consumption() const
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return sizeof(*this) + n_slots * n_properties * sizeof(double) +
+           MemoryConsumption::memory_consumption(chunk_n_slots) +
+           MemoryConsumption::memory_consumption(free_slots) +
+           chunks.capacity() * sizeof(std::unique_ptr<double[]>);
+  }
+
+
+
+  void
+  PropertyPool::add_chunk(const std::size_t n_new_slots)
+  {
+    chunks.emplace_back(new double[n_new_slots * n_properties]);
+    chunk_n_slots.push_back(n_new_slots);
+    n_slots += n_new_slots;
+
+    // add the slots in reverse order, so that they are handed out with
+    // increasing addresses
+    free_slots.reserve(free_slots.size() + n_new_slots);
+    for (std::size_t i = n_new_slots; i > 0; --i)
+      free_slots.push_back(chunks.back().get() + (i - 1) * n_properties);
+  }
+
+
+
+  void
+  PropertyPool::release_unused_chunks()
+  {
+    // sort the chunks by their address to find the chunk of each free slot
+    // by a binary search
+    std::vector<unsigned int> chunk_order(chunks.size());
+    for (unsigned int c = 0; c < chunks.size(); ++c)
+      chunk_order[c] = c;
+    const std::less<const double *> address_less;
+    std::sort(chunk_order.begin(),
+              chunk_order.end(),
+              [&](const unsigned int a, const unsigned int b) {
+                return address_less(chunks[a].get(), chunks[b].get());
+              });
+
+    const auto find_chunk = [&](const Handle handle) {
+      const auto next_chunk =
+        std::upper_bound(chunk_order.begin(),
+                         chunk_order.end(),
+                         handle,
+                         [&](const Handle h, const unsigned int c) {
+                           return address_less(h, chunks[c].get());
+                         });
+      Assert(next_chunk != chunk_order.begin(), ExcInternalError());
+      return *(next_chunk - 1);
+    };
+
+    std::vector<std::size_t> n_free_slots(chunks.size(), 0);
+    for (const Handle handle : free_slots)
+      ++n_free_slots[find_chunk(handle)];
+
+    std::vector<bool> release_chunk(chunks.size(), false);
+    bool              any_released = false;
+    for (unsigned int c = 0; c < chunks.size(); ++c)
+      if (n_free_slots[c] == chunk_n_slots[c])
+        {
+          release_chunk[c] = true;
+          any_released     = true;
+        }
+    if (!any_released)
+      return;
+
+    free_slots.erase(std::remove_if(free_slots.begin(),
+                                    free_slots.end(),
+                                    [&](const Handle handle) {
+                                      return release_chunk[find_chunk(handle)];
+                                    }),
+                     free_slots.end());
+
+    unsigned int n_kept_chunks = 0;
+    for (unsigned int c = 0; c < chunks.size(); ++c)
+      if (release_chunk[c])
+        n_slots -= chunk_n_slots[c];
+      else
+        {
+          chunks[n_kept_chunks]        = std::move(chunks[c]);
+          chunk_n_slots[n_kept_chunks] = chunk_n_slots[c];
+          ++n_kept_chunks;
+        }
+    chunks.resize(n_kept_chunks);
+    chunk_n_slots.resize(n_kept_chunks);
+  }
 } // namespace Particles
 DEAL_II_NAMESPACE_CLOSE
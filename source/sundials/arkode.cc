@@ -34,6 +34,7 @@
 #  include <deal.II/base/utilities.h>
 
 #  include <deal.II/sundials/copy.h>
+#  include <deal.II/sundials/n_vector.templates.h>
 
 #  include <arkode/arkode_impl.h>
 #  include <sundials/sundials_config.h>
@@ -61,20 +62,12 @@ namespace SUNDIALS
     {
       ARKode<VectorType> &solver =
         *static_cast<ARKode<VectorType> *>(user_data);
-      GrowingVectorMemory<VectorType> mem;
 
-      typename VectorMemory<VectorType>::Pointer src_yy(mem);
-      solver.reinit_vector(*src_yy);
-
-      typename VectorMemory<VectorType>::Pointer dst_yp(mem);
-      solver.reinit_vector(*dst_yp);
-
-      copy(*src_yy, yy);
+      NVectorAccess<VectorType> src_yy(yy, solver.reinit_vector, true, false);
+      NVectorAccess<VectorType> dst_yp(yp, solver.reinit_vector, false, true);
 
       int err = solver.explicit_function(tt, *src_yy, *dst_yp);
 
-      copy(yp, *dst_yp);
-
       return err;
     }
 
@@ -89,20 +82,12 @@ namespace SUNDIALS
     {
       ARKode<VectorType> &solver =
         *static_cast<ARKode<VectorType> *>(user_data);
-      GrowingVectorMemory<VectorType> mem;
-
-      typename VectorMemory<VectorType>::Pointer src_yy(mem);
-      solver.reinit_vector(*src_yy);
 
-      typename VectorMemory<VectorType>::Pointer dst_yp(mem);
-      solver.reinit_vector(*dst_yp);
-
-      copy(*src_yy, yy);
+      NVectorAccess<VectorType> src_yy(yy, solver.reinit_vector, true, false);
+      NVectorAccess<VectorType> dst_yp(yp, solver.reinit_vector, false, true);
 
       int err = solver.implicit_function(tt, *src_yy, *dst_yp);
 
-      copy(yp, *dst_yp);
-
       return err;
     }
 
@@ -121,16 +106,15 @@ namespace SUNDIALS
     {
       ARKode<VectorType> &solver =
         *static_cast<ARKode<VectorType> *>(arkode_mem->ark_user_data);
-      GrowingVectorMemory<VectorType> mem;
-
-      typename VectorMemory<VectorType>::Pointer src_ypred(mem);
-      solver.reinit_vector(*src_ypred);
 
-      typename VectorMemory<VectorType>::Pointer src_fpred(mem);
-      solver.reinit_vector(*src_fpred);
-
-      copy(*src_ypred, ypred);
-      copy(*src_fpred, fpred);
+      NVectorAccess<VectorType> src_ypred(ypred,
+                                          solver.reinit_vector,
+                                          true,
+                                          false);
+      NVectorAccess<VectorType> src_fpred(fpred,
+                                          solver.reinit_vector,
+                                          true,
+                                          false);
 
       // avoid reinterpret_cast
       bool jcurPtr_tmp = false;
@@ -163,31 +147,30 @@ namespace SUNDIALS
     {
       ARKode<VectorType> &solver =
         *static_cast<ARKode<VectorType> *>(arkode_mem->ark_user_data);
-      GrowingVectorMemory<VectorType> mem;
-
-      typename VectorMemory<VectorType>::Pointer src(mem);
-      solver.reinit_vector(*src);
-
-      typename VectorMemory<VectorType>::Pointer src_ycur(mem);
-      solver.reinit_vector(*src_ycur);
-
-      typename VectorMemory<VectorType>::Pointer src_fcur(mem);
-      solver.reinit_vector(*src_fcur);
 
+      // b is both the right hand side and the solution, so the solution
+      // has to go through a separate vector
+      NVectorAccess<VectorType> src(b, solver.reinit_vector, true, true);
+      NVectorAccess<VectorType> src_ycur(ycur,
+                                         solver.reinit_vector,
+                                         true,
+                                         false);
+      NVectorAccess<VectorType> src_fcur(fcur,
+                                         solver.reinit_vector,
+                                         true,
+                                         false);
+
+      GrowingVectorMemory<VectorType>            mem;
       typename VectorMemory<VectorType>::Pointer dst(mem);
       solver.reinit_vector(*dst);
 
-      copy(*src, b);
-      copy(*src_ycur, ycur);
-      copy(*src_fcur, fcur);
-
       int err = solver.solve_jacobian_system(arkode_mem->ark_tn,
                                              arkode_mem->ark_gamma,
                                              *src_ycur,
                                              *src_fcur,
                                              *src,
                                              *dst);
-      copy(b, *dst);
+      *src = *dst;
 
       return err;
     }
@@ -219,18 +202,17 @@ namespace SUNDIALS
     {
       ARKode<VectorType> &solver =
         *static_cast<ARKode<VectorType> *>(arkode_mem->ark_user_data);
-      GrowingVectorMemory<VectorType> mem;
 
-      typename VectorMemory<VectorType>::Pointer src(mem);
-      solver.reinit_vector(*src);
+      // b is both the right hand side and the solution, so the solution
+      // has to go through a separate vector
+      NVectorAccess<VectorType> src(b, solver.reinit_vector, true, true);
 
+      GrowingVectorMemory<VectorType>            mem;
       typename VectorMemory<VectorType>::Pointer dst(mem);
       solver.reinit_vector(*dst);
 
-      copy(*src, b);
-
       int err = solver.solve_mass_system(*src, *dst);
-      copy(b, *dst);
+      *src    = *dst;
 
       return err;
     }
@@ -271,8 +253,6 @@ namespace SUNDIALS
   unsigned int
   ARKode<VectorType>::solve_ode(VectorType &solution)
   {
-    unsigned int system_size = solution.size();
-
     double       t           = data.initial_time;
     double       h           = data.initial_step_size;
     unsigned int step_number = 0;
@@ -280,29 +260,8 @@ namespace SUNDIALS
     int status;
     (void)status;
 
-    // The solution is stored in
-    // solution. Here we take only a
-    // view of it.
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        const IndexSet    is                = solution.locally_owned_elements();
-        const std::size_t local_system_size = is.n_elements();
-
-        yy = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        abs_tolls =
-          N_VNew_Parallel(communicator, local_system_size, system_size);
-      }
-    else
-#  endif
-      {
-        Assert(is_serial_vector<VectorType>::value,
-               ExcInternalError(
-                 "Trying to use a serial code with a parallel vector."));
-        yy        = N_VNew_Serial(system_size);
-        abs_tolls = N_VNew_Serial(system_size);
-      }
+    // The N_Vectors holding the solution and the tolerances are created
+    // in reset().
     reset(data.initial_time, data.initial_step_size, solution);
 
     double next_time = data.initial_time;
@@ -321,7 +280,7 @@ namespace SUNDIALS
         status = ARKodeGetLastStep(arkode_mem, &h);
         AssertARKode(status);
 
-        copy(solution, yy);
+        copy_from_nvector(solution, yy);
 
         while (solver_should_restart(t, solution))
           reset(t, h, solution);
@@ -332,19 +291,11 @@ namespace SUNDIALS
           output_step(t, solution, step_number);
       }
 
-      // Free the vectors which are no longer used.
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        N_VDestroy_Parallel(yy);
-        N_VDestroy_Parallel(abs_tolls);
-      }
-    else
-#  endif
-      {
-        N_VDestroy_Serial(yy);
-        N_VDestroy_Serial(abs_tolls);
-      }
+    // Free the vectors which are no longer used.
+    N_VDestroy(yy);
+    N_VDestroy(abs_tolls);
+    yy        = nullptr;
+    abs_tolls = nullptr;
 
     return step_number;
   }
@@ -355,8 +306,6 @@ namespace SUNDIALS
                             const double      current_time_step,
                             const VectorType &solution)
   {
-    unsigned int system_size;
-
     if (arkode_mem)
       ARKodeFree(&arkode_mem);
 
@@ -365,42 +314,18 @@ namespace SUNDIALS
     // Free the vectors which are no longer used.
     if (yy)
       {
-#  ifdef DEAL_II_WITH_MPI
-        if (is_serial_vector<VectorType>::value == false)
-          {
-            N_VDestroy_Parallel(yy);
-            N_VDestroy_Parallel(abs_tolls);
-          }
-        else
-#  endif
-          {
-            N_VDestroy_Serial(yy);
-            N_VDestroy_Serial(abs_tolls);
-          }
+        N_VDestroy(yy);
+        N_VDestroy(abs_tolls);
       }
 
     int status;
     (void)status;
-    system_size = solution.size();
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        const IndexSet    is                = solution.locally_owned_elements();
-        const std::size_t local_system_size = is.n_elements();
-
-        yy = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        abs_tolls =
-          N_VNew_Parallel(communicator, local_system_size, system_size);
-      }
-    else
-#  endif
-      {
-        yy        = N_VNew_Serial(system_size);
-        abs_tolls = N_VNew_Serial(system_size);
-      }
 
-    copy(yy, solution);
+    // For the vector types that support it, yy is a deal.II vector that
+    // SUNDIALS clones all of its work vectors from, so that the callbacks
+    // below operate on them in place.
+    yy        = create_nvector(solution, communicator);
+    abs_tolls = create_nvector(solution, communicator);
 
     Assert(explicit_function || implicit_function,
            ExcFunctionNotProvided("explicit_function || implicit_function"));
@@ -415,7 +340,7 @@ namespace SUNDIALS
 
     if (get_local_tolerances)
       {
-        copy(abs_tolls, get_local_tolerances());
+        copy_to_nvector(abs_tolls, get_local_tolerances());
         status =
           ARKodeSVtolerances(arkode_mem, data.relative_tolerance, abs_tolls);
         AssertARKode(status);
@@ -505,6 +430,8 @@ namespace SUNDIALS
 
   template class ARKode<Vector<double>>;
   template class ARKode<BlockVector<double>>;
+  template class ARKode<LinearAlgebra::distributed::Vector<double>>;
+  template class ARKode<LinearAlgebra::distributed::BlockVector<double>>;
 
 #  ifdef DEAL_II_WITH_MPI
 
@@ -34,6 +34,7 @@
 #  include <deal.II/base/utilities.h>
 
 #  include <deal.II/sundials/copy.h>
+#  include <deal.II/sundials/n_vector.templates.h>
 
 #  ifdef DEAL_II_SUNDIALS_WITH_IDAS
 #    include <idas/idas_impl.h>
@@ -61,24 +62,16 @@ namespace SUNDIALS
                    void *   user_data)
     {
       IDA<VectorType> &solver = *static_cast<IDA<VectorType> *>(user_data);
-      GrowingVectorMemory<VectorType> mem;
 
-      typename VectorMemory<VectorType>::Pointer src_yy(mem);
-      solver.reinit_vector(*src_yy);
-
-      typename VectorMemory<VectorType>::Pointer src_yp(mem);
-      solver.reinit_vector(*src_yp);
-
-      typename VectorMemory<VectorType>::Pointer residual(mem);
-      solver.reinit_vector(*residual);
-
-      copy(*src_yy, yy);
-      copy(*src_yp, yp);
+      NVectorAccess<VectorType> src_yy(yy, solver.reinit_vector, true, false);
+      NVectorAccess<VectorType> src_yp(yp, solver.reinit_vector, true, false);
+      NVectorAccess<VectorType> residual(rr,
+                                         solver.reinit_vector,
+                                         false,
+                                         true);
 
       int err = solver.residual(tt, *src_yy, *src_yp, *residual);
 
-      copy(rr, *residual);
-
       return err;
     }
 
@@ -100,16 +93,9 @@ namespace SUNDIALS
       (void)resp;
       IDA<VectorType> &solver =
         *static_cast<IDA<VectorType> *>(IDA_mem->ida_user_data);
-      GrowingVectorMemory<VectorType> mem;
-
-      typename VectorMemory<VectorType>::Pointer src_yy(mem);
-      solver.reinit_vector(*src_yy);
-
-      typename VectorMemory<VectorType>::Pointer src_yp(mem);
-      solver.reinit_vector(*src_yp);
 
-      copy(*src_yy, yy);
-      copy(*src_yp, yp);
+      NVectorAccess<VectorType> src_yy(yy, solver.reinit_vector, true, false);
+      NVectorAccess<VectorType> src_yp(yp, solver.reinit_vector, true, false);
 
       int err = solver.setup_jacobian(IDA_mem->ida_tn,
                                       *src_yy,
@@ -135,18 +121,17 @@ namespace SUNDIALS
       (void)resp;
       IDA<VectorType> &solver =
         *static_cast<IDA<VectorType> *>(IDA_mem->ida_user_data);
-      GrowingVectorMemory<VectorType> mem;
 
-      typename VectorMemory<VectorType>::Pointer src(mem);
-      solver.reinit_vector(*src);
+      // b is both the right hand side and the solution, so the solution
+      // has to go through a separate vector
+      NVectorAccess<VectorType> src(b, solver.reinit_vector, true, true);
 
+      GrowingVectorMemory<VectorType>            mem;
       typename VectorMemory<VectorType>::Pointer dst(mem);
       solver.reinit_vector(*dst);
 
-      copy(*src, b);
-
       int err = solver.solve_jacobian_system(*src, *dst);
-      copy(b, *dst);
+      *src    = *dst;
 
       return err;
     }
@@ -189,8 +174,6 @@ namespace SUNDIALS
   unsigned int
   IDA<VectorType>::solve_dae(VectorType &solution, VectorType &solution_dot)
   {
-    unsigned int system_size = solution.size();
-
     double       t           = data.initial_time;
     double       h           = data.initial_step_size;
     unsigned int step_number = 0;
@@ -198,35 +181,8 @@ namespace SUNDIALS
     int status;
     (void)status;
 
-    // The solution is stored in
-    // solution. Here we take only a
-    // view of it.
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        const IndexSet    is                = solution.locally_owned_elements();
-        const std::size_t local_system_size = is.n_elements();
-
-        yy = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        yp = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        diff_id = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        abs_tolls =
-          N_VNew_Parallel(communicator, local_system_size, system_size);
-      }
-    else
-#  endif
-      {
-        Assert(is_serial_vector<VectorType>::value,
-               ExcInternalError(
-                 "Trying to use a serial code with a parallel vector."));
-        yy        = N_VNew_Serial(system_size);
-        yp        = N_VNew_Serial(system_size);
-        diff_id   = N_VNew_Serial(system_size);
-        abs_tolls = N_VNew_Serial(system_size);
-      }
+    // The N_Vectors holding the solution, its time derivative, and the
+    // tolerances are created in reset().
     reset(data.initial_time, data.initial_step_size, solution, solution_dot);
 
     double next_time = data.initial_time;
@@ -243,8 +199,8 @@ namespace SUNDIALS
         status = IDAGetLastStep(ida_mem, &h);
         AssertIDA(status);
 
-        copy(solution, yy);
-        copy(solution_dot, yp);
+        copy_from_nvector(solution, yy);
+        copy_from_nvector(solution_dot, yp);
 
         while (solver_should_restart(t, solution, solution_dot))
           reset(t, h, solution, solution_dot);
@@ -254,23 +210,15 @@ namespace SUNDIALS
         output_step(t, solution, solution_dot, step_number);
       }
 
-      // Free the vectors which are no longer used.
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        N_VDestroy_Parallel(yy);
-        N_VDestroy_Parallel(yp);
-        N_VDestroy_Parallel(abs_tolls);
-        N_VDestroy_Parallel(diff_id);
-      }
-    else
-#  endif
-      {
-        N_VDestroy_Serial(yy);
-        N_VDestroy_Serial(yp);
-        N_VDestroy_Serial(abs_tolls);
-        N_VDestroy_Serial(diff_id);
-      }
+    // Free the vectors which are no longer used.
+    N_VDestroy(yy);
+    N_VDestroy(yp);
+    N_VDestroy(abs_tolls);
+    N_VDestroy(diff_id);
+    yy        = nullptr;
+    yp        = nullptr;
+    abs_tolls = nullptr;
+    diff_id   = nullptr;
 
     return step_number;
   }
@@ -282,8 +230,7 @@ namespace SUNDIALS
                          VectorType & solution,
                          VectorType & solution_dot)
   {
-    unsigned int system_size;
-    bool         first_step = (current_time == data.initial_time);
+    bool first_step = (current_time == data.initial_time);
 
     if (ida_mem)
       IDAFree(&ida_mem);
@@ -294,60 +241,29 @@ namespace SUNDIALS
     // Free the vectors which are no longer used.
     if (yy)
       {
-#  ifdef DEAL_II_WITH_MPI
-        if (is_serial_vector<VectorType>::value == false)
-          {
-            N_VDestroy_Parallel(yy);
-            N_VDestroy_Parallel(yp);
-            N_VDestroy_Parallel(abs_tolls);
-            N_VDestroy_Parallel(diff_id);
-          }
-        else
-#  endif
-          {
-            N_VDestroy_Serial(yy);
-            N_VDestroy_Serial(yp);
-            N_VDestroy_Serial(abs_tolls);
-            N_VDestroy_Serial(diff_id);
-          }
+        N_VDestroy(yy);
+        N_VDestroy(yp);
+        N_VDestroy(abs_tolls);
+        N_VDestroy(diff_id);
       }
 
     int status;
     (void)status;
-    system_size = solution.size();
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        const IndexSet    is                = solution.locally_owned_elements();
-        const std::size_t local_system_size = is.n_elements();
-
-        yy = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        yp = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        diff_id = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        abs_tolls =
-          N_VNew_Parallel(communicator, local_system_size, system_size);
-      }
-    else
-#  endif
-      {
-        yy        = N_VNew_Serial(system_size);
-        yp        = N_VNew_Serial(system_size);
-        diff_id   = N_VNew_Serial(system_size);
-        abs_tolls = N_VNew_Serial(system_size);
-      }
 
-    copy(yy, solution);
-    copy(yp, solution_dot);
+    // For the vector types that support it, yy and yp are deal.II vectors
+    // that SUNDIALS clones all of its work vectors from, so that the
+    // callbacks above operate on them in place.
+    yy        = create_nvector(solution, communicator);
+    yp        = create_nvector(solution_dot, communicator);
+    diff_id   = create_nvector(solution, communicator);
+    abs_tolls = create_nvector(solution, communicator);
 
     status = IDAInit(ida_mem, t_dae_residual<VectorType>, current_time, yy, yp);
     AssertIDA(status);
 
     if (get_local_tolerances)
       {
-        copy(abs_tolls, get_local_tolerances());
+        copy_to_nvector(abs_tolls, get_local_tolerances());
         status = IDASVtolerances(ida_mem, data.relative_tolerance, abs_tolls);
         AssertIDA(status);
       }
@@ -375,7 +291,7 @@ namespace SUNDIALS
         for (auto i = dc.begin(); i != dc.end(); ++i)
           diff_comp_vector[*i] = 1.0;
 
-        copy(diff_id, diff_comp_vector);
+        copy_to_nvector(diff_id, diff_comp_vector);
         status = IDASetId(ida_mem, diff_id);
         AssertIDA(status);
       }
@@ -422,8 +338,8 @@ namespace SUNDIALS
         status = IDAGetConsistentIC(ida_mem, yy, yp);
         AssertIDA(status);
 
-        copy(solution, yy);
-        copy(solution_dot, yp);
+        copy_from_nvector(solution, yy);
+        copy_from_nvector(solution_dot, yp);
       }
     else if (type == AdditionalData::use_y_diff)
       {
@@ -434,8 +350,8 @@ namespace SUNDIALS
         status = IDAGetConsistentIC(ida_mem, yy, yp);
         AssertIDA(status);
 
-        copy(solution, yy);
-        copy(solution_dot, yp);
+        copy_from_nvector(solution, yy);
+        copy_from_nvector(solution_dot, yp);
       }
   }
 
@@ -490,6 +406,8 @@ namespace SUNDIALS
 
   template class IDA<Vector<double>>;
   template class IDA<BlockVector<double>>;
+  template class IDA<LinearAlgebra::distributed::Vector<double>>;
+  template class IDA<LinearAlgebra::distributed::BlockVector<double>>;
 
 #  ifdef DEAL_II_WITH_MPI
 
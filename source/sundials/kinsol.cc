@@ -34,6 +34,7 @@
 #  include <deal.II/base/utilities.h>
 
 #  include <deal.II/sundials/copy.h>
+#  include <deal.II/sundials/n_vector.templates.h>
 
 #  include <sundials/sundials_config.h>
 #  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
@@ -61,15 +62,9 @@ namespace SUNDIALS
     {
       KINSOL<VectorType> &solver =
         *static_cast<KINSOL<VectorType> *>(user_data);
-      GrowingVectorMemory<VectorType> mem;
 
-      typename VectorMemory<VectorType>::Pointer src_yy(mem);
-      solver.reinit_vector(*src_yy);
-
-      typename VectorMemory<VectorType>::Pointer dst_FF(mem);
-      solver.reinit_vector(*dst_FF);
-
-      copy(*src_yy, yy);
+      NVectorAccess<VectorType> src_yy(yy, solver.reinit_vector, true, false);
+      NVectorAccess<VectorType> dst_FF(FF, solver.reinit_vector, false, true);
 
       int err = 0;
       if (solver.residual)
@@ -79,8 +74,6 @@ namespace SUNDIALS
       else
         Assert(false, ExcInternalError());
 
-      copy(FF, *dst_FF);
-
       return err;
     }
 
@@ -92,16 +85,15 @@ namespace SUNDIALS
     {
       KINSOL<VectorType> &solver =
         *static_cast<KINSOL<VectorType> *>(kinsol_mem->kin_user_data);
-      GrowingVectorMemory<VectorType> mem;
-
-      typename VectorMemory<VectorType>::Pointer src_ycur(mem);
-      solver.reinit_vector(*src_ycur);
 
-      typename VectorMemory<VectorType>::Pointer src_fcur(mem);
-      solver.reinit_vector(*src_fcur);
-
-      copy(*src_ycur, kinsol_mem->kin_uu);
-      copy(*src_fcur, kinsol_mem->kin_fval);
+      NVectorAccess<VectorType> src_ycur(kinsol_mem->kin_uu,
+                                         solver.reinit_vector,
+                                         true,
+                                         false);
+      NVectorAccess<VectorType> src_fcur(kinsol_mem->kin_fval,
+                                         solver.reinit_vector,
+                                         true,
+                                         false);
 
       int err = solver.setup_jacobian(*src_ycur, *src_fcur);
       return err;
@@ -119,27 +111,22 @@ namespace SUNDIALS
     {
       KINSOL<VectorType> &solver =
         *static_cast<KINSOL<VectorType> *>(kinsol_mem->kin_user_data);
-      GrowingVectorMemory<VectorType> mem;
-
-      typename VectorMemory<VectorType>::Pointer src_ycur(mem);
-      solver.reinit_vector(*src_ycur);
-
-      typename VectorMemory<VectorType>::Pointer src_fcur(mem);
-      solver.reinit_vector(*src_fcur);
 
-      copy(*src_ycur, kinsol_mem->kin_uu);
-      copy(*src_fcur, kinsol_mem->kin_fval);
+      NVectorAccess<VectorType> src_ycur(kinsol_mem->kin_uu,
+                                         solver.reinit_vector,
+                                         true,
+                                         false);
+      NVectorAccess<VectorType> src_fcur(kinsol_mem->kin_fval,
+                                         solver.reinit_vector,
+                                         true,
+                                         false);
+      NVectorAccess<VectorType> src(b, solver.reinit_vector, true, false);
 
-      typename VectorMemory<VectorType>::Pointer src(mem);
-      solver.reinit_vector(*src);
-
-      typename VectorMemory<VectorType>::Pointer dst(mem);
-      solver.reinit_vector(*dst);
-
-      copy(*src, b);
-
-      int err = solver.solve_jacobian_system(*src_ycur, *src_fcur, *src, *dst);
-      copy(x, *dst);
+      int err = 0;
+      {
+        NVectorAccess<VectorType> dst(x, solver.reinit_vector, false, true);
+        err = solver.solve_jacobian_system(*src_ycur, *src_fcur, *src, *dst);
+      }
 
       *sJpnorm = N_VWL2Norm(b, kinsol_mem->kin_fscale);
       N_VProd(b, kinsol_mem->kin_fscale, b);
@@ -190,11 +177,19 @@ namespace SUNDIALS
   {
     unsigned int system_size = initial_guess_and_solution.size();
 
-    // The solution is stored in
-    // solution. Here we take only a
-    // view of it.
+    if (solve_jacobian_system)
+      {
+        // The linear systems are solved by the user, so for the vector types
+        // that support it SUNDIALS works on deal.II vectors in place. The
+        // dense direct solver used otherwise requires native N_Vectors.
+        solution = create_nvector(initial_guess_and_solution, communicator);
+        u_scale  = create_nvector(initial_guess_and_solution, communicator);
+        N_VConst(1.e0, u_scale);
+        f_scale = create_nvector(initial_guess_and_solution, communicator);
+        N_VConst(1.e0, f_scale);
+      }
 #  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
+    else if (is_serial_vector<VectorType>::value == false)
       {
         const IndexSet is = initial_guess_and_solution.locally_owned_elements();
         const unsigned int local_system_size = is.n_elements();
@@ -208,8 +203,8 @@ namespace SUNDIALS
         f_scale = N_VNew_Parallel(communicator, local_system_size, system_size);
         N_VConst_Parallel(1.e0, f_scale);
       }
-    else
 #  endif
+    else
       {
         Assert(is_serial_vector<VectorType>::value,
                ExcInternalError(
@@ -222,12 +217,12 @@ namespace SUNDIALS
       }
 
     if (get_solution_scaling)
-      copy(u_scale, get_solution_scaling());
+      copy_to_nvector(u_scale, get_solution_scaling());
 
     if (get_function_scaling)
-      copy(f_scale, get_function_scaling());
+      copy_to_nvector(f_scale, get_function_scaling());
 
-    copy(solution, initial_guess_and_solution);
+    copy_to_nvector(solution, initial_guess_and_solution);
 
     if (kinsol_mem)
       KINFree(&kinsol_mem);
@@ -309,23 +304,12 @@ namespace SUNDIALS
     status = KINSol(kinsol_mem, solution, data.strategy, u_scale, f_scale);
     AssertKINSOL(status);
 
-    copy(initial_guess_and_solution, solution);
+    copy_from_nvector(initial_guess_and_solution, solution);
 
     // Free the vectors which are no longer used.
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        N_VDestroy_Parallel(solution);
-        N_VDestroy_Parallel(u_scale);
-        N_VDestroy_Parallel(f_scale);
-      }
-    else
-#  endif
-      {
-        N_VDestroy_Serial(solution);
-        N_VDestroy_Serial(u_scale);
-        N_VDestroy_Serial(f_scale);
-      }
+    N_VDestroy(solution);
+    N_VDestroy(u_scale);
+    N_VDestroy(f_scale);
 
     long nniters;
     status = KINGetNumNonlinSolvIters(kinsol_mem, &nniters);
@@ -351,6 +335,8 @@ namespace SUNDIALS
 
   template class KINSOL<Vector<double>>;
   template class KINSOL<BlockVector<double>>;
+  template class KINSOL<LinearAlgebra::distributed::Vector<double>>;
+  template class KINSOL<LinearAlgebra::distributed::BlockVector<double>>;
 
 #  ifdef DEAL_II_WITH_MPI
 